@@ -27,9 +27,14 @@
 #include <dirent.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include "grpc_client.h"
@@ -129,6 +134,41 @@ Postprocess(
   }
 }
 
+// Collects the results of asynchronous requests, which may complete in
+// any order, and hands them out in the order the requests were
+// submitted. Requests are identified by their submission index.
+class ReorderBuffer {
+ public:
+  // Record the result of the request with submission index 'idx'.
+  void Push(size_t idx, tc::InferResult* result)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      ready_[idx].reset(result);
+    }
+    cv_.notify_all();
+  }
+
+  // Wait for the result of the oldest request that has not been handed
+  // out yet and return it.
+  std::unique_ptr<tc::InferResult> Pop()
+  {
+    std::unique_lock<std::mutex> lk(mtx_);
+    cv_.wait(lk, [this]() { return ready_.find(next_) != ready_.end(); });
+    auto it = ready_.find(next_);
+    std::unique_ptr<tc::InferResult> result = std::move(it->second);
+    ready_.erase(it);
+    next_++;
+    return result;
+  }
+
+ private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::map<size_t, std::unique_ptr<tc::InferResult>> ready_;
+  size_t next_ = 0;
+};
+
 void
 Usage(char** argv, const std::string& msg = std::string())
 {
@@ -143,12 +183,26 @@ Usage(char** argv, const std::string& msg = std::string())
   std::cerr << "\t-i <Protocol used to communicate with inference service>"
             << std::endl;
   std::cerr << "\t-u <URL for inference service>" << std::endl;
+  std::cerr << "\t-w <number of in-flight requests>" << std::endl;
+  std::cerr << "\t-r <number of passes over the images>" << std::endl;
   std::cerr << std::endl;
   std::cerr << "For -c, the <topk> classes will be returned, default is 1."
             << std::endl;
   std::cerr
       << "For -i, available protocols are 'grpc' and 'http'. Default is 'http."
       << std::endl;
+  std::cerr << "For -w, the images are split into batches of the model's"
+            << std::endl
+            << "        maximum batch size and up to this many requests are"
+            << std::endl
+            << "        sent asynchronously at a time. Results are reported in"
+            << std::endl
+            << "        submission order. Default is 1." << std::endl;
+  std::cerr << "For -r, the images are sent this many times and the"
+            << std::endl
+            << "        throughput is reported. Classifications are only"
+            << std::endl
+            << "        printed for the first pass. Default is 1." << std::endl;
 
   exit(1);
 }
@@ -173,10 +227,12 @@ main(int argc, char** argv)
   std::string url("localhost:8000");
   std::string protocol = "http";
   size_t topk = 1;
+  int window = 1;
+  int repeat = 1;
 
   // Parse commandline...
   int opt;
-  while ((opt = getopt(argc, argv, "vi:u:p:c:")) != -1) {
+  while ((opt = getopt(argc, argv, "vi:u:p:c:w:r:")) != -1) {
     switch (opt) {
       case 'v':
         verbose = true;
@@ -190,6 +246,12 @@ main(int argc, char** argv)
       case 'c':
         topk = std::atoi(optarg);
         break;
+      case 'w':
+        window = std::atoi(optarg);
+        break;
+      case 'r':
+        repeat = std::atoi(optarg);
+        break;
       case '?':
         Usage(argv);
         break;
@@ -199,6 +261,12 @@ main(int argc, char** argv)
   if (topk <= 0) {
     Usage(argv, "topk must be > 0");
   }
+  if (window <= 0) {
+    Usage(argv, "number of in-flight requests must be > 0");
+  }
+  if (repeat <= 0) {
+    Usage(argv, "number of passes must be > 0");
+  }
 
   // The ensemble model takes 1 input tensor with shape [ 1 ] and STRING
   // data type and returns 1 output tensor as top k (see '-c' flag)
@@ -276,8 +344,8 @@ main(int argc, char** argv)
     }
   }
 
-  // this client only send one request for simplicity. So the maximum number
-  // of the images to be processed is limited by the maximum batch size
+  // The images are split into requests of at most the maximum batch
+  // size of the model.
   size_t batch_size = 0;
   if (protocol == "http") {
     std::string model_config;
@@ -305,23 +373,11 @@ main(int argc, char** argv)
     batch_size = model_config.config().max_batch_size();
   }
 
-  if (images.size() > batch_size) {
-    std::cerr << "The number of images exceeds maximum batch size, only the"
-              << " first " << batch_size << " images, sorted by name"
-              << " alphabetically, will be processed" << std::endl;
-  }
-  batch_size = (images.size() < batch_size) ? images.size() : batch_size;
-
-  // Initialize the inputs with the data.
-  tc::InferInput* input;
-  std::vector<int64_t> shape{(int64_t)batch_size, 1};
-  err = tc::InferInput::Create(&input, "INPUT", shape, "BYTES");
-  if (!err.IsOk()) {
-    std::cerr << "unable to get input: " << err << std::endl;
+  if (batch_size == 0) {
+    std::cerr << "error: model " << model_name << " does not support batching"
+              << std::endl;
     exit(1);
   }
-  std::shared_ptr<tc::InferInput> input_ptr(input);
-
 
   tc::InferRequestedOutput* output;
   // Set the number of classification expected
@@ -331,35 +387,101 @@ main(int argc, char** argv)
     exit(1);
   }
   std::shared_ptr<tc::InferRequestedOutput> output_ptr(output);
-
-  std::vector<tc::InferInput*> inputs = {input_ptr.get()};
   std::vector<const tc::InferRequestedOutput*> outputs = {output_ptr.get()};
 
+  // Each in-flight request needs its own input since the input data must
+  // stay valid until the request completes. A request reuses the input
+  // of the request 'window' places before it, whose result has already
+  // been handed out of the reorder buffer.
+  std::vector<std::shared_ptr<tc::InferInput>> input_ptrs;
+  for (int i = 0; i < window; i++) {
+    tc::InferInput* input;
+    std::vector<int64_t> shape{(int64_t)batch_size, 1};
+    err = tc::InferInput::Create(&input, "INPUT", shape, "BYTES");
+    if (!err.IsOk()) {
+      std::cerr << "unable to get input: " << err << std::endl;
+      exit(1);
+    }
+    input_ptrs.emplace_back(input);
+  }
+
   tc::InferOptions options(model_name);
 
-  FAIL_IF_ERR(input_ptr->Reset(), "unable to reset INPUT");
+  const size_t batch_count = (images.size() + batch_size - 1) / batch_size;
+  const size_t request_count = batch_count * repeat;
+  ReorderBuffer reorder_buffer;
+
+  // Check, and for the first pass print, the result of request 'idx'.
+  auto handle_result = [&](size_t idx,
+                           std::unique_ptr<tc::InferResult> result) {
+    const size_t batch_idx = idx % batch_count;
+    const size_t first = batch_idx * batch_size;
+    const size_t count = std::min(batch_size, images.size() - first);
+    if (idx < batch_count) {
+      std::vector<std::string> filenames(
+          image_filenames.begin() + first,
+          image_filenames.begin() + first + count);
+      Postprocess(std::move(result), filenames, count, topk);
+    } else {
+      FAIL_IF_ERR(result->RequestStatus(), "inference failed");
+    }
+  };
 
-  for (size_t i = 0; i < batch_size; i++) {
-    FAIL_IF_ERR(
-        input_ptr->AppendFromString(images[i]), "unable to set data for INPUT");
-  }
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t idx = 0; idx < request_count; idx++) {
+    // Keep at most 'window' requests outstanding.
+    if (idx >= (size_t)window) {
+      handle_result(idx - window, reorder_buffer.Pop());
+    }
 
-  // Send inference request to the inference server.
-  tc::InferResult* results;
-  if (protocol == "http") {
-    FAIL_IF_ERR(
-        triton_client.http_client_->Infer(&results, options, inputs, outputs),
-        "unable to run model");
-  } else {
+    const size_t batch_idx = idx % batch_count;
+    const size_t first = batch_idx * batch_size;
+    const size_t count = std::min(batch_size, images.size() - first);
+    tc::InferInput* input = input_ptrs[idx % window].get();
+    FAIL_IF_ERR(input->Reset(), "unable to reset INPUT");
     FAIL_IF_ERR(
-        triton_client.grpc_client_->Infer(&results, options, inputs, outputs),
-        "unable to run model");
+        input->SetShape({(int64_t)count, 1}), "unable to set shape for INPUT");
+    for (size_t i = first; i < first + count; i++) {
+      FAIL_IF_ERR(
+          input->AppendFromString(images[i]), "unable to set data for INPUT");
+    }
+
+    std::vector<tc::InferInput*> inputs = {input};
+    options.request_id_ = std::to_string(idx);
+    auto callback = [&reorder_buffer, idx](tc::InferResult* result) {
+      reorder_buffer.Push(idx, result);
+    };
+
+    // Send inference request to the inference server.
+    if (protocol == "http") {
+      FAIL_IF_ERR(
+          triton_client.http_client_->AsyncInfer(
+              callback, options, inputs, outputs),
+          "unable to run model");
+    } else {
+      FAIL_IF_ERR(
+          triton_client.grpc_client_->AsyncInfer(
+              callback, options, inputs, outputs),
+          "unable to run model");
+    }
   }
-  std::unique_ptr<tc::InferResult> results_ptr;
-  results_ptr.reset(results);
 
-  // Print classification results
-  Postprocess(std::move(results_ptr), image_filenames, batch_size, topk);
+  // Drain the remaining requests in submission order.
+  const size_t outstanding = std::min(request_count, (size_t)window);
+  for (size_t idx = request_count - outstanding; idx < request_count; idx++) {
+    handle_result(idx, reorder_buffer.Pop());
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  if (repeat > 1) {
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Completed " << request_count << " requests ("
+              << images.size() * repeat << " images) with " << window
+              << " in flight in " << seconds << " sec: "
+              << request_count / seconds << " infer/sec, "
+              << images.size() * repeat / seconds << " images/sec"
+              << std::endl;
+  }
 
   return 0;
 }
@@ -31,16 +31,26 @@
 #include <unistd.h>
 #include <algorithm>
 #include <condition_variable>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
+#include <vector>
 #include "grpc_client.h"
 #include "http_client.h"
 #include "json_utils.h"
 
+#ifdef TRITON_ENABLE_GPU
+#include <cuda_runtime_api.h>
+#include <npp.h>
+#include <nvjpeg.h>
+#endif  // TRITON_ENABLE_GPU
+
 #include <opencv2/core/version.hpp>
 #if CV_MAJOR_VERSION == 2
 #include <opencv2/core/core.hpp>
@@ -60,6 +70,40 @@
 
 namespace tc = triton::client;
 
+#ifdef TRITON_ENABLE_GPU
+#define FAIL_IF_CUDA_ERR(FUNC)                                     \
+  {                                                                \
+    const cudaError_t result = FUNC;                               \
+    if (result != cudaSuccess) {                                   \
+      std::cerr << "CUDA exception (line " << __LINE__             \
+                << "): " << cudaGetErrorName(result) << " ("       \
+                << cudaGetErrorString(result) << ")" << std::endl; \
+      exit(1);                                                     \
+    }                                                              \
+  }
+
+#define FAIL_IF_NVJPEG_ERR(FUNC)                                    \
+  {                                                                 \
+    const nvjpegStatus_t result = FUNC;                             \
+    if (result != NVJPEG_STATUS_SUCCESS) {                          \
+      std::cerr << "nvJPEG error " << result << " (line " << __LINE__ \
+                << ")" << std::endl;                                \
+      exit(1);                                                      \
+    }                                                               \
+  }
+
+// NPP reports warnings with positive status codes
+#define FAIL_IF_NPP_ERR(FUNC)                                          \
+  {                                                                    \
+    const NppStatus result = FUNC;                                     \
+    if (result < NPP_NO_ERROR) {                                       \
+      std::cerr << "NPP error " << result << " (line " << __LINE__ << ")" \
+                << std::endl;                                          \
+      exit(1);                                                         \
+    }                                                                  \
+  }
+#endif  // TRITON_ENABLE_GPU
+
 namespace {
 
 enum ScaleType { NONE = 0, VGG = 1, INCEPTION = 2 };
@@ -81,11 +125,15 @@ struct ModelInfo {
   int max_batch_size_;
 };
 
+// Convert 'img' into the layout and datatype expected by the model and
+// write the result directly into 'dst', which must hold exactly
+// 'dst_byte_size' bytes. 'dst' is typically a slice of the batch buffer
+// that is handed to the InferInput, so no intermediate copy is made.
 void
 Preprocess(
     const cv::Mat& img, const std::string& format, int img_type1, int img_type3,
     size_t img_channels, const cv::Size& img_size, const ScaleType scale,
-    std::vector<uint8_t>* input_data)
+    uint8_t* dst, size_t dst_byte_size)
 {
   // Image channels are in BGR order. Currently model configuration
   // data doesn't provide any information as to the expected channel
@@ -117,73 +165,62 @@ Preprocess(
     sample_resized = sample;
   }
 
-  cv::Mat sample_type;
-  sample_resized.convertTo(
-      sample_type, (img_channels == 3) ? img_type3 : img_type1);
+  const int img_type = (img_channels == 3) ? img_type3 : img_type1;
+  const size_t img_byte_size = img_size.area() * CV_ELEM_SIZE(img_type);
+  if (img_byte_size != dst_byte_size) {
+    std::cerr << "unexpected total size of image " << img_byte_size
+              << ", expecting " << dst_byte_size << std::endl;
+    exit(1);
+  }
 
+  // For NHWC format the converted image has the same layout as the
+  // input tensor, so the conversion writes straight into 'dst'. For
+  // NCHW the converted image is split into channel planes below.
+  const bool nhwc = (format.compare("FORMAT_NHWC") == 0);
   cv::Mat sample_final;
+  if (nhwc) {
+    sample_final = cv::Mat(img_size, img_type, dst);
+  }
+
+  // The type conversion and the scaling are done in a single vectorized
+  // pass: convertTo computes 'alpha * x + beta' and cv::subtract
+  // converts to the requested depth while subtracting the mean.
   if (scale == ScaleType::INCEPTION) {
-    if (img_channels == 1) {
-      sample_final = sample_type.mul(cv::Scalar(1 / 127.5));
-      sample_final = sample_final - cv::Scalar(1.0);
-    } else {
-      sample_final =
-          sample_type.mul(cv::Scalar(1 / 127.5, 1 / 127.5, 1 / 127.5));
-      sample_final = sample_final - cv::Scalar(1.0, 1.0, 1.0);
-    }
+    sample_resized.convertTo(sample_final, img_type, 1 / 127.5, -1.0);
   } else if (scale == ScaleType::VGG) {
-    if (img_channels == 1) {
-      sample_final = sample_type - cv::Scalar(128);
-    } else {
-      sample_final = sample_type - cv::Scalar(123, 117, 104);
-    }
+    const cv::Scalar mean =
+        (img_channels == 1) ? cv::Scalar(128) : cv::Scalar(123, 117, 104);
+    cv::subtract(
+        sample_resized, mean, sample_final, cv::noArray(),
+        CV_MAT_DEPTH(img_type));
   } else {
-    sample_final = sample_type;
+    sample_resized.convertTo(sample_final, img_type);
   }
 
-  // Allocate a buffer to hold all image elements.
-  size_t img_byte_size = sample_final.total() * sample_final.elemSize();
-  size_t pos = 0;
-  input_data->resize(img_byte_size);
-
-  // For NHWC format Mat is already in the correct order but need to
-  // handle both cases of data being contigious or not.
-  if (format.compare("FORMAT_NHWC") == 0) {
-    if (sample_final.isContinuous()) {
-      memcpy(&((*input_data)[0]), sample_final.datastart, img_byte_size);
-      pos = img_byte_size;
-    } else {
-      size_t row_byte_size = sample_final.cols * sample_final.elemSize();
-      for (int r = 0; r < sample_final.rows; ++r) {
-        memcpy(
-            &((*input_data)[pos]), sample_final.ptr<uint8_t>(r), row_byte_size);
-        pos += row_byte_size;
-      }
+  if (nhwc) {
+    if (sample_final.data != dst) {
+      std::cerr << "unexpected reallocation of preprocessed image"
+                << std::endl;
+      exit(1);
     }
   } else {
     // (format.compare("FORMAT_NCHW") == 0)
     //
     // For CHW formats must split out each channel from the matrix and
     // order them as BBBB...GGGG...RRRR. To do this split the channels
-    // of the image directly into 'input_data'. The BGR channels are
-    // backed by the 'input_data' vector so that ends up with CHW
-    // order of the data.
+    // of the image directly into 'dst'. The BGR channels are backed by
+    // 'dst' so that ends up with CHW order of the data.
+    size_t pos = 0;
     std::vector<cv::Mat> input_bgr_channels;
     for (size_t i = 0; i < img_channels; ++i) {
       input_bgr_channels.emplace_back(
-          img_size.height, img_size.width, img_type1, &((*input_data)[pos]));
+          img_size.height, img_size.width, img_type1, dst + pos);
       pos += input_bgr_channels.back().total() *
              input_bgr_channels.back().elemSize();
     }
 
     cv::split(sample_final, input_bgr_channels);
   }
-
-  if (pos != img_byte_size) {
-    std::cerr << "unexpected total size of channels " << pos << ", expecting "
-              << img_byte_size << std::endl;
-    exit(1);
-  }
 }
 
 
@@ -299,6 +336,8 @@ Usage(char** argv, const std::string& msg = std::string())
   std::cerr << "\t-i <Protocol used to communicate with inference service>"
             << std::endl;
   std::cerr << "\t-H <HTTP header>" << std::endl;
+  std::cerr << "\t-j <preprocessing threads>" << std::endl;
+  std::cerr << "\t--gpu-decode" << std::endl;
   std::cerr << std::endl;
   std::cerr << "If -a is specified then asynchronous client API will be used. "
             << "Default is to use the synchronous API." << std::endl;
@@ -334,6 +373,24 @@ Usage(char** argv, const std::string& msg = std::string())
          "requests). The header must be specified as 'Header:Value'. -H may be "
          "specified multiple times to add multiple headers."
       << std::endl;
+  std::cerr
+      << "For -j, the number of threads used to decode and preprocess images."
+      << std::endl
+      << "        Preprocessing of the next batch overlaps with inference of"
+      << std::endl
+      << "        the current one. Default is the number of hardware threads."
+      << std::endl;
+  std::cerr
+      << "For --gpu-decode, JPEG images are decoded and preprocessed on GPU 0"
+      << std::endl
+      << "        with nvJPEG and NPP, straight into CUDA shared memory that"
+      << std::endl
+      << "        the server reads the input from, so the server must run on"
+      << std::endl
+      << "        the same machine. Requires a model input of 3 channels and"
+      << std::endl
+      << "        of UINT8 or FP32 datatype, and a build with GPU support."
+      << std::endl;
   std::cerr << std::endl;
 
   exit(1);
@@ -710,13 +767,9 @@ ParseModelHttp(
   }
 }
 
-void
-FileToInputData(
-    const std::string& filename, size_t c, size_t h, size_t w,
-    const std::string& format, int type1, int type3, ScaleType scale,
-    std::vector<uint8_t>* input_data)
+std::vector<char>
+ReadImageFile(const std::string& filename)
 {
-  // Load the specified image.
   std::ifstream file(filename);
   std::vector<char> data;
   file >> std::noskipws;
@@ -727,6 +780,17 @@ FileToInputData(
     std::cerr << "error: unable to read image file " << filename << std::endl;
     exit(1);
   }
+  return data;
+}
+
+void
+FileToInputData(
+    const std::string& filename, size_t c, size_t h, size_t w,
+    const std::string& format, int type1, int type3, ScaleType scale,
+    uint8_t* dst, size_t dst_byte_size)
+{
+  // Load the specified image.
+  std::vector<char> data = ReadImageFile(filename);
 
   cv::Mat img = imdecode(cv::Mat(data), 1);
   if (img.empty()) {
@@ -735,9 +799,282 @@ FileToInputData(
   }
 
   // Pre-process the image to match input size expected by the model.
-  Preprocess(img, format, type1, type3, c, cv::Size(w, h), scale, input_data);
+  Preprocess(
+      img, format, type1, type3, c, cv::Size(w, h), scale, dst, dst_byte_size);
 }
 
+// Fixed-size pool of worker threads that run queued tasks in FIFO
+// order. Used to decode and preprocess the images of a batch in
+// parallel.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t thread_count)
+  {
+    for (size_t i = 0; i < thread_count; ++i) {
+      workers_.emplace_back(&ThreadPool::Worker, this);
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      exiting_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Enqueue(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      tasks_.push(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  void Worker()
+  {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait(lk, [this]() { return exiting_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::queue<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+  bool exiting_ = false;
+};
+
+#ifdef TRITON_ENABLE_GPU
+// Decodes batches of JPEG images with nvJPEG and preprocesses them with
+// NPP, the same way Preprocess() does, into device memory. Only inputs
+// of 3 channels and of UINT8 or FP32 datatype are supported, and UINT8
+// inputs can't be scaled. A single batch is decoded at a time.
+class GpuImageDecoder {
+ public:
+  GpuImageDecoder(
+      int device_id, size_t h, size_t w, const std::string& format,
+      const std::string& datatype, ScaleType scale)
+      : size_{static_cast<int>(w), static_cast<int>(h)},
+        nchw_(format.compare("FORMAT_NCHW") == 0),
+        fp32_(datatype.compare("FP32") == 0), scale_(scale)
+  {
+    FAIL_IF_CUDA_ERR(cudaSetDevice(device_id));
+    FAIL_IF_CUDA_ERR(
+        cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+    FAIL_IF_NVJPEG_ERR(nvjpegCreateSimple(&handle_));
+    FAIL_IF_NVJPEG_ERR(nvjpegJpegStateCreate(handle_, &state_));
+
+    cudaDeviceProp props;
+    FAIL_IF_CUDA_ERR(cudaGetDeviceProperties(&props, device_id));
+    npp_ctx_.hStream = stream_;
+    npp_ctx_.nCudaDeviceId = device_id;
+    npp_ctx_.nMultiProcessorCount = props.multiProcessorCount;
+    npp_ctx_.nMaxThreadsPerMultiProcessor = props.maxThreadsPerMultiProcessor;
+    npp_ctx_.nMaxThreadsPerBlock = props.maxThreadsPerBlock;
+    npp_ctx_.nSharedMemPerBlock = props.sharedMemPerBlock;
+    npp_ctx_.nCudaDevAttrComputeCapabilityMajor = props.major;
+    npp_ctx_.nCudaDevAttrComputeCapabilityMinor = props.minor;
+    FAIL_IF_CUDA_ERR(cudaStreamGetFlags(stream_, &npp_ctx_.nStreamFlags));
+
+    FAIL_IF_CUDA_ERR(cudaMalloc((void**)&resized_, h * w * 3));
+    if (fp32_) {
+      FAIL_IF_CUDA_ERR(
+          cudaMalloc((void**)&converted_, h * w * 3 * sizeof(float)));
+    }
+  }
+
+  ~GpuImageDecoder()
+  {
+    for (auto& decoded : decoded_) {
+      cudaFree(decoded.first);
+    }
+    cudaFree(resized_);
+    cudaFree(converted_);
+    nvjpegJpegStateDestroy(state_);
+    nvjpegDestroy(handle_);
+    cudaStreamDestroy(stream_);
+  }
+
+  // Decode and preprocess the first 'unique_count' images of 'filenames'
+  // into consecutive images of 'img_byte_size' bytes at 'dst', in device
+  // memory, and repeat them for the rest of 'filenames'. Returns once
+  // the batch is ready.
+  void DecodeBatch(
+      const std::vector<std::string>& filenames, size_t unique_count,
+      uint8_t* dst, size_t img_byte_size)
+  {
+    std::vector<std::vector<char>> data(unique_count);
+    std::vector<const unsigned char*> data_ptrs(unique_count);
+    std::vector<size_t> lengths(unique_count);
+    std::vector<nvjpegImage_t> images(unique_count);
+    std::vector<NppiSize> sizes(unique_count);
+    if (decoded_.size() < unique_count) {
+      decoded_.resize(unique_count, {nullptr, 0});
+    }
+    for (size_t idx = 0; idx < unique_count; ++idx) {
+      data[idx] = ReadImageFile(filenames[idx]);
+      data_ptrs[idx] =
+          reinterpret_cast<const unsigned char*>(data[idx].data());
+      lengths[idx] = data[idx].size();
+      int components;
+      nvjpegChromaSubsampling_t subsampling;
+      int widths[NVJPEG_MAX_COMPONENT];
+      int heights[NVJPEG_MAX_COMPONENT];
+      if (nvjpegGetImageInfo(
+              handle_, data_ptrs[idx], lengths[idx], &components,
+              &subsampling, widths, heights) != NVJPEG_STATUS_SUCCESS) {
+        std::cerr << "error: unable to decode image " << filenames[idx]
+                  << " on the GPU, only JPEG images are supported"
+                  << std::endl;
+        exit(1);
+      }
+      sizes[idx] = NppiSize{widths[0], heights[0]};
+
+      // The decoded images are interleaved RGB
+      const size_t byte_size = 3 * widths[0] * heights[0];
+      auto& decoded = decoded_[idx];
+      if (decoded.second < byte_size) {
+        FAIL_IF_CUDA_ERR(cudaFree(decoded.first));
+        decoded.first = nullptr;
+        FAIL_IF_CUDA_ERR(cudaMalloc((void**)&decoded.first, byte_size));
+        decoded.second = byte_size;
+      }
+      images[idx] = nvjpegImage_t{};
+      images[idx].channel[0] = decoded.first;
+      images[idx].pitch[0] = 3 * widths[0];
+    }
+
+    if (batch_size_ != unique_count) {
+      FAIL_IF_NVJPEG_ERR(nvjpegDecodeBatchedInitialize(
+          handle_, state_, unique_count, 1 /* max_cpu_threads */,
+          NVJPEG_OUTPUT_RGBI));
+      batch_size_ = unique_count;
+    }
+    FAIL_IF_NVJPEG_ERR(nvjpegDecodeBatched(
+        handle_, state_, data_ptrs.data(), lengths.data(), images.data(),
+        stream_));
+    for (size_t idx = 0; idx < unique_count; ++idx) {
+      PreprocessImage(
+          images[idx].channel[0], sizes[idx], dst + idx * img_byte_size);
+    }
+    for (size_t idx = unique_count; idx < filenames.size(); ++idx) {
+      FAIL_IF_CUDA_ERR(cudaMemcpyAsync(
+          dst + idx * img_byte_size,
+          dst + (idx % unique_count) * img_byte_size, img_byte_size,
+          cudaMemcpyDeviceToDevice, stream_));
+    }
+    FAIL_IF_CUDA_ERR(cudaStreamSynchronize(stream_));
+  }
+
+ private:
+  // Resize, convert and scale the decoded image 'src' of 'src_size' into
+  // the input layout at 'dst'.
+  void PreprocessImage(
+      const uint8_t* src, const NppiSize& src_size, uint8_t* dst)
+  {
+    const NppiRect src_roi{0, 0, src_size.width, src_size.height};
+    const NppiRect roi{0, 0, size_.width, size_.height};
+    const size_t plane_size = size_.width * size_.height;
+
+    // A UINT8 NHWC input is the resized image itself
+    uint8_t* resized = (!fp32_ && !nchw_) ? dst : resized_;
+    FAIL_IF_NPP_ERR(nppiResize_8u_C3R_Ctx(
+        src, 3 * src_size.width, src_size, src_roi, resized,
+        3 * size_.width, size_, roi, NPPI_INTER_LINEAR, npp_ctx_));
+    if (!fp32_) {
+      if (nchw_) {
+        Npp8u* const planes[3] = {
+            dst, dst + plane_size, dst + 2 * plane_size};
+        FAIL_IF_NPP_ERR(nppiCopy_8u_C3P3R_Ctx(
+            resized_, 3 * size_.width, planes, size_.width, size_,
+            npp_ctx_));
+      }
+      return;
+    }
+
+    float* converted = nchw_ ? converted_ : reinterpret_cast<float*>(dst);
+    const int converted_step = 3 * size_.width * sizeof(float);
+    FAIL_IF_NPP_ERR(nppiConvert_8u32f_C3R_Ctx(
+        resized_, 3 * size_.width, converted, converted_step, size_,
+        npp_ctx_));
+    if (scale_ == ScaleType::INCEPTION) {
+      const Npp32f factor[3] = {1 / 127.5f, 1 / 127.5f, 1 / 127.5f};
+      const Npp32f offset[3] = {1.0f, 1.0f, 1.0f};
+      FAIL_IF_NPP_ERR(nppiMulC_32f_C3IR_Ctx(
+          factor, converted, converted_step, size_, npp_ctx_));
+      FAIL_IF_NPP_ERR(nppiSubC_32f_C3IR_Ctx(
+          offset, converted, converted_step, size_, npp_ctx_));
+    } else if (scale_ == ScaleType::VGG) {
+      const Npp32f mean[3] = {123.0f, 117.0f, 104.0f};
+      FAIL_IF_NPP_ERR(nppiSubC_32f_C3IR_Ctx(
+          mean, converted, converted_step, size_, npp_ctx_));
+    }
+    if (nchw_) {
+      float* dst_float = reinterpret_cast<float*>(dst);
+      Npp32f* const planes[3] = {
+          dst_float, dst_float + plane_size, dst_float + 2 * plane_size};
+      FAIL_IF_NPP_ERR(nppiCopy_32f_C3P3R_Ctx(
+          converted_, converted_step, planes, size_.width * sizeof(float),
+          size_, npp_ctx_));
+    }
+  }
+
+  const NppiSize size_;
+  const bool nchw_;
+  const bool fp32_;
+  const ScaleType scale_;
+  cudaStream_t stream_ = nullptr;
+  NppStreamContext npp_ctx_{};
+  nvjpegHandle_t handle_ = nullptr;
+  nvjpegJpegState_t state_ = nullptr;
+  // The batch size the batched decoder was initialized for
+  size_t batch_size_ = 0;
+  // The device buffer and its byte size each image of a batch is decoded
+  // into, grown as needed
+  std::vector<std::pair<uint8_t*, size_t>> decoded_;
+  uint8_t* resized_ = nullptr;
+  float* converted_ = nullptr;
+};
+
+// The device the images are decoded on with --gpu-decode
+constexpr int kGpuDeviceId = 0;
+#endif  // TRITON_ENABLE_GPU
+
+// Batch buffer that is cycled between preprocessing and inference.
+// 'pending' counts the images still being preprocessed into 'data' and
+// 'in_flight' is set while a request that reads from 'data' has not
+// completed. With --gpu-decode the batch is in 'device_data' instead,
+// which the server reads from the CUDA shared memory region
+// 'region_name'.
+struct BatchSlot {
+  std::vector<uint8_t> data;
+  uint8_t* device_data = nullptr;
+  std::string region_name;
+  size_t pending = 0;
+  bool in_flight = false;
+};
+
+// Number of batch buffers. Preprocessing of batch N+1 overlaps with the
+// inference of batch N.
+constexpr size_t kPipelineDepth = 2;
+
 union TritonClient {
   TritonClient()
   {
@@ -759,24 +1096,32 @@ main(int argc, char** argv)
   bool streaming = false;
   int batch_size = 1;
   int topk = 1;
+  int preprocess_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
   ScaleType scale = ScaleType::NONE;
   std::string preprocess_output_filename;
   std::string model_name;
   std::string model_version = "";
   std::string url("localhost:8000");
   ProtocolType protocol = ProtocolType::HTTP;
+  bool gpu_decode = false;
   tc::Headers http_headers;
 
-  static struct option long_options[] = {{"streaming", 0, 0, 0}, {0, 0, 0, 0}};
+  static struct option long_options[] = {
+      {"streaming", 0, 0, 0}, {"gpu-decode", 0, 0, 1}, {0, 0, 0, 0}};
 
   // Parse commandline...
   int opt;
   while ((opt = getopt_long(
-              argc, argv, "vau:m:x:b:c:s:p:i:H:", long_options, NULL)) != -1) {
+              argc, argv, "vau:m:x:b:c:s:p:i:H:j:", long_options, NULL)) !=
+         -1) {
     switch (opt) {
       case 0:
         streaming = true;
         break;
+      case 1:
+        gpu_decode = true;
+        break;
       case 'v':
         verbose = true;
         break;
@@ -813,6 +1158,9 @@ main(int argc, char** argv)
         http_headers[header] = arg.substr(header.size() + 1);
         break;
       }
+      case 'j':
+        preprocess_threads = std::atoi(optarg);
+        break;
       case '?':
         Usage(argv);
         break;
@@ -828,6 +1176,9 @@ main(int argc, char** argv)
   if (topk <= 0) {
     Usage(argv, "topk must be > 0");
   }
+  if (preprocess_threads <= 0) {
+    Usage(argv, "preprocessing threads must be > 0");
+  }
   if (optind >= argc) {
     Usage(argv, "image file or image folder must be specified");
   }
@@ -842,6 +1193,11 @@ main(int argc, char** argv)
                  "using non-HTTP protocol."
               << std::endl;
   }
+#ifndef TRITON_ENABLE_GPU
+  if (gpu_decode) {
+    Usage(argv, "--gpu-decode requires a build with GPU support");
+  }
+#endif  // TRITON_ENABLE_GPU
 
   // Create the inference client for the server. From it
   // extract and validate that the model meets the requirements for
@@ -903,6 +1259,25 @@ main(int argc, char** argv)
     }
     ParseModelGrpc(model_metadata, model_config, batch_size, &model_info);
   }
+  if (gpu_decode) {
+    if (model_info.input_c_ != 3) {
+      std::cerr << "--gpu-decode expects an input of 3 channels, model '"
+                << model_name << "' input has " << model_info.input_c_
+                << std::endl;
+      exit(1);
+    }
+    if ((model_info.input_datatype_.compare("UINT8") != 0) &&
+        (model_info.input_datatype_.compare("FP32") != 0)) {
+      std::cerr << "--gpu-decode expects an input datatype of UINT8 or FP32, "
+                << "model '" << model_name << "' input type is '"
+                << model_info.input_datatype_ << "'" << std::endl;
+      exit(1);
+    }
+    if ((model_info.input_datatype_.compare("UINT8") == 0) &&
+        (scale != ScaleType::NONE)) {
+      Usage(argv, "--gpu-decode can't scale an input of UINT8 datatype");
+    }
+  }
 
   // Collect the names of the image(s).
   std::vector<std::string> image_filenames;
@@ -933,23 +1308,6 @@ main(int argc, char** argv)
   // (readdir does not guarantee any particular order).
   std::sort(image_filenames.begin(), image_filenames.end());
 
-  // Preprocess the images into input data according to model
-  // requirements
-  std::vector<std::vector<uint8_t>> image_data;
-  for (const auto& fn : image_filenames) {
-    image_data.emplace_back();
-    FileToInputData(
-        fn, model_info.input_c_, model_info.input_h_, model_info.input_w_,
-        model_info.input_format_, model_info.type1_, model_info.type3_, scale,
-        &(image_data.back()));
-
-    if ((image_data.size() == 1) && !preprocess_output_filename.empty()) {
-      std::ofstream output_file(preprocess_output_filename);
-      std::ostream_iterator<uint8_t> output_iterator(output_file);
-      std::copy(image_data[0].begin(), image_data[0].end(), output_iterator);
-    }
-  }
-
   std::vector<int64_t> shape;
   // Include the batch dimension if required
   if (model_info.max_batch_size_ != 0) {
@@ -998,61 +1356,215 @@ main(int argc, char** argv)
   // the first images until the batch is filled.
   //
   // Number of requests sent = ceil(number of images / batch_size)
-  std::vector<std::unique_ptr<tc::InferResult>> results;
-  std::vector<std::vector<std::string>> result_filenames;
-  size_t image_idx = 0;
+  //
+  // Each batch is decoded and preprocessed by the thread pool directly
+  // into one of 'kPipelineDepth' batch buffers, and the next batch is
+  // preprocessed while the current one is being inferred.
+  const size_t image_count = image_filenames.size();
+  const size_t request_count = (image_count + batch_size - 1) / batch_size;
+  const size_t img_byte_size = model_info.input_c_ * model_info.input_h_ *
+                               model_info.input_w_ *
+                               CV_ELEM_SIZE(model_info.type1_);
+
+  std::vector<std::unique_ptr<tc::InferResult>> results(request_count);
+  std::vector<std::vector<std::string>> result_filenames(request_count);
+  for (size_t request_idx = 0; request_idx < request_count; ++request_idx) {
+    for (int idx = 0; idx < batch_size; ++idx) {
+      result_filenames[request_idx].push_back(
+          image_filenames[(request_idx * batch_size + idx) % image_count]);
+    }
+  }
+
   size_t done_cnt = 0;
-  size_t sent_count = 0;
-  bool last_request = false;
   std::mutex mtx;
   std::condition_variable cv;
+  std::vector<BatchSlot> slots(kPipelineDepth);
+  if (!gpu_decode) {
+    for (auto& slot : slots) {
+      slot.data.resize(batch_size * img_byte_size);
+    }
+  }
+#ifdef TRITON_ENABLE_GPU
+  // With --gpu-decode each batch buffer is a CUDA shared memory region
+  // registered with the server, so the input never leaves the GPU.
+  std::unique_ptr<GpuImageDecoder> gpu_decoder;
+  if (gpu_decode) {
+    gpu_decoder.reset(new GpuImageDecoder(
+        kGpuDeviceId, model_info.input_h_, model_info.input_w_,
+        model_info.input_format_, model_info.input_datatype_, scale));
+    for (size_t slot_idx = 0; slot_idx < slots.size(); ++slot_idx) {
+      BatchSlot& slot = slots[slot_idx];
+      FAIL_IF_CUDA_ERR(cudaMalloc(
+          (void**)&slot.device_data, batch_size * img_byte_size));
+      cudaIpcMemHandle_t cuda_handle;
+      FAIL_IF_CUDA_ERR(cudaIpcGetMemHandle(&cuda_handle, slot.device_data));
+      slot.region_name = "image_client_batch_" + std::to_string(slot_idx);
+      if (protocol == ProtocolType::HTTP) {
+        err = triton_client.http_client_->RegisterCudaSharedMemory(
+            slot.region_name, cuda_handle, kGpuDeviceId,
+            batch_size * img_byte_size, http_headers);
+      } else {
+        err = triton_client.grpc_client_->RegisterCudaSharedMemory(
+            slot.region_name, cuda_handle, kGpuDeviceId,
+            batch_size * img_byte_size, http_headers);
+      }
+      if (!err.IsOk()) {
+        std::cerr << "unable to register CUDA shared memory: " << err
+                  << std::endl;
+        exit(1);
+      }
+    }
+  }
+#endif  // TRITON_ENABLE_GPU
+  ThreadPool preprocess_pool(preprocess_threads);
+
+  // Preprocess the images of request 'request_idx' into its batch
+  // buffer. If there are fewer images than 'batch_size' the batch
+  // repeats images, which are preprocessed once and then copied.
+  auto preprocess_batch = [&](size_t request_idx) {
+    BatchSlot* slot = &slots[request_idx % kPipelineDepth];
+    const size_t unique_count =
+        std::min(static_cast<size_t>(batch_size), image_count);
+#ifdef TRITON_ENABLE_GPU
+    // The GPU decodes the whole batch at once
+    if (gpu_decoder != nullptr) {
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+        slot->pending = 1;
+      }
+      preprocess_pool.Enqueue([&, slot, request_idx, unique_count]() {
+        gpu_decoder->DecodeBatch(
+            result_filenames[request_idx], unique_count, slot->device_data,
+            img_byte_size);
+        {
+          std::lock_guard<std::mutex> lk(mtx);
+          slot->pending--;
+        }
+        cv.notify_all();
+      });
+      return;
+    }
+#endif  // TRITON_ENABLE_GPU
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      slot->pending = unique_count;
+    }
+    for (size_t idx = 0; idx < unique_count; ++idx) {
+      preprocess_pool.Enqueue([&, slot, request_idx, idx]() {
+        uint8_t* dst = slot->data.data() + idx * img_byte_size;
+        FileToInputData(
+            result_filenames[request_idx][idx], model_info.input_c_,
+            model_info.input_h_, model_info.input_w_,
+            model_info.input_format_, model_info.type1_, model_info.type3_,
+            scale, dst, img_byte_size);
+        for (size_t copy_idx = idx + image_count;
+             copy_idx < static_cast<size_t>(batch_size);
+             copy_idx += image_count) {
+          memcpy(
+              slot->data.data() + copy_idx * img_byte_size, dst,
+              img_byte_size);
+        }
+        {
+          std::lock_guard<std::mutex> lk(mtx);
+          slot->pending--;
+        }
+        cv.notify_all();
+      });
+    }
+  };
 
-  auto callback_func = [&](tc::InferResult* result) {
+  // Record the result of request 'request_idx' and release its batch
+  // buffer for the preprocessing of a later batch.
+  auto complete_request = [&](size_t request_idx, tc::InferResult* result) {
     {
-      // Defer the response retrieval to main thread
       std::lock_guard<std::mutex> lk(mtx);
-      results.emplace_back(result);
+      results[request_idx].reset(result);
+      slots[request_idx % kPipelineDepth].in_flight = false;
       done_cnt++;
     }
     cv.notify_all();
   };
 
   if (streaming) {
+    // Stream responses are matched to their request by the request id.
+    auto stream_callback_func = [&](tc::InferResult* result) {
+      std::string request_id;
+      tc::Error id_err = result->Id(&request_id);
+      if (!id_err.IsOk() || request_id.empty()) {
+        std::cerr << "received stream response without request id"
+                  << std::endl;
+        exit(1);
+      }
+      complete_request(std::stoul(request_id), result);
+    };
     err = triton_client.grpc_client_->StartStream(
-        callback_func, true /* enable_stats */, 0 /* stream_timeout */,
+        stream_callback_func, true /* enable_stats */, 0 /* stream_timeout */,
         http_headers);
     if (!err.IsOk()) {
       std::cerr << "failed to establish the stream: " << err << std::endl;
     }
   }
 
-  while (!last_request) {
-    // Reset the input for new request.
-    err = input_ptr->Reset();
-    if (!err.IsOk()) {
-      std::cerr << "failed resetting input: " << err << std::endl;
-      exit(1);
+  preprocess_batch(0);
+  for (size_t request_idx = 0; request_idx < request_count; ++request_idx) {
+    BatchSlot& slot = slots[request_idx % kPipelineDepth];
+    {
+      std::unique_lock<std::mutex> lk(mtx);
+      cv.wait(lk, [&]() { return slot.pending == 0; });
     }
 
-    // Set input to be the next 'batch_size' images (preprocessed).
-    std::vector<std::string> input_filenames;
-    for (int idx = 0; idx < batch_size; ++idx) {
-      input_filenames.push_back(image_filenames[image_idx]);
-      err = input_ptr->AppendRaw(image_data[image_idx]);
-      if (!err.IsOk()) {
-        std::cerr << "failed setting input: " << err << std::endl;
-        exit(1);
+    if ((request_idx == 0) && !preprocess_output_filename.empty()) {
+      const uint8_t* img_data = slot.data.data();
+#ifdef TRITON_ENABLE_GPU
+      std::vector<uint8_t> host_data;
+      if (gpu_decode) {
+        host_data.resize(img_byte_size);
+        FAIL_IF_CUDA_ERR(cudaMemcpy(
+            host_data.data(), slot.device_data, img_byte_size,
+            cudaMemcpyDeviceToHost));
+        img_data = host_data.data();
       }
+#endif  // TRITON_ENABLE_GPU
+      std::ofstream output_file(preprocess_output_filename);
+      output_file.write(
+          reinterpret_cast<const char*>(img_data), img_byte_size);
+    }
 
-      image_idx = (image_idx + 1) % image_data.size();
-      if (image_idx == 0) {
-        last_request = true;
+    // Start preprocessing the next batch so that it overlaps with the
+    // inference of this one. Its buffer must first be released by the
+    // request that used it last.
+    if (request_idx + 1 < request_count) {
+      BatchSlot& next_slot = slots[(request_idx + 1) % kPipelineDepth];
+      {
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait(lk, [&]() { return !next_slot.in_flight; });
       }
+      preprocess_batch(request_idx + 1);
     }
 
-    result_filenames.emplace_back(std::move(input_filenames));
+    // Reset the input for new request and set it to the preprocessed
+    // batch.
+    err = input_ptr->Reset();
+    if (!err.IsOk()) {
+      std::cerr << "failed resetting input: " << err << std::endl;
+      exit(1);
+    }
+    if (gpu_decode) {
+      err = input_ptr->SetSharedMemory(
+          slot.region_name, batch_size * img_byte_size);
+    } else {
+      err = input_ptr->AppendRaw(slot.data);
+    }
+    if (!err.IsOk()) {
+      std::cerr << "failed setting input: " << err << std::endl;
+      exit(1);
+    }
 
-    options.request_id_ = std::to_string(sent_count);
+    options.request_id_ = std::to_string(request_idx);
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      slot.in_flight = true;
+    }
 
     // Send request.
     if (!async) {
@@ -1069,12 +1581,16 @@ main(int argc, char** argv)
                   << std::endl;
         exit(1);
       }
-      results.emplace_back(result);
+      complete_request(request_idx, result);
     } else {
       if (streaming) {
         err = triton_client.grpc_client_->AsyncStreamInfer(
             options, inputs, outputs);
       } else {
+        auto callback_func = [&complete_request,
+                              request_idx](tc::InferResult* result) {
+          complete_request(request_idx, result);
+        };
         if (protocol == ProtocolType::HTTP) {
           err = triton_client.http_client_->AsyncInfer(
               callback_func, options, inputs, outputs, http_headers);
@@ -1089,22 +1605,12 @@ main(int argc, char** argv)
         exit(1);
       }
     }
-    sent_count++;
   }
 
-  // For async, retrieve results according to the send order
+  // For async, wait until all callbacks are invoked
   if (async) {
-    // Wait until all callbacks are invoked
-    {
-      std::unique_lock<std::mutex> lk(mtx);
-      cv.wait(lk, [&]() {
-        if (done_cnt >= sent_count) {
-          return true;
-        } else {
-          return false;
-        }
-      });
-    }
+    std::unique_lock<std::mutex> lk(mtx);
+    cv.wait(lk, [&]() { return done_cnt >= request_count; });
   }
 
   // Post-process the results to make prediction(s)
@@ -1116,5 +1622,25 @@ main(int argc, char** argv)
         model_info.output_name_, topk, model_info.max_batch_size_ != 0);
   }
 
+#ifdef TRITON_ENABLE_GPU
+  for (auto& slot : slots) {
+    if (slot.device_data == nullptr) {
+      continue;
+    }
+    if (protocol == ProtocolType::HTTP) {
+      err = triton_client.http_client_->UnregisterCudaSharedMemory(
+          slot.region_name, http_headers);
+    } else {
+      err = triton_client.grpc_client_->UnregisterCudaSharedMemory(
+          slot.region_name, http_headers);
+    }
+    if (!err.IsOk()) {
+      std::cerr << "unable to unregister CUDA shared memory: " << err
+                << std::endl;
+    }
+    FAIL_IF_CUDA_ERR(cudaFree(slot.device_data));
+  }
+#endif  // TRITON_ENABLE_GPU
+
   return 0;
 }
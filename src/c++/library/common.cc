@@ -26,6 +26,19 @@
 
 #include "common.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !_WIN32
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "tensor_convert.h"
+
 namespace triton { namespace client {
 
 //==============================================================================
@@ -45,15 +58,47 @@ operator<<(std::ostream& out, const Error& err)
 
 //==============================================================================
 
+namespace {
+
+// The names of the datatypes, in the order of DataType
+const char* const kDataTypeStrings[] = {
+    "INVALID", "BOOL",  "UINT8", "UINT16", "UINT32", "UINT64", "INT8", "INT16",
+    "INT32",   "INT64", "FP16",  "FP32",   "FP64",   "BYTES",  "BF16"};
+
+}  // namespace
+
+DataType
+StringToDataType(const char* datatype, size_t length)
+{
+  for (size_t i = static_cast<size_t>(DataType::BOOL);
+       i <= static_cast<size_t>(DataType::BF16); ++i) {
+    if ((strlen(kDataTypeStrings[i]) == length) &&
+        (memcmp(kDataTypeStrings[i], datatype, length) == 0)) {
+      return static_cast<DataType>(i);
+    }
+  }
+  return DataType::INVALID;
+}
+
+const char*
+DataTypeString(DataType type)
+{
+  return kDataTypeStrings[static_cast<size_t>(type)];
+}
+
+//==============================================================================
+
 Error
 InferenceServerClient::ClientInferStat(InferStat* infer_stat) const
 {
+  std::lock_guard<std::mutex> lock(infer_stat_mutex_);
   *infer_stat = infer_stat_;
   return Error::Success;
 }
 
 Error
-InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
+InferenceServerClient::UpdateInferStat(
+    const RequestTimers& timer, const size_t response_count)
 {
   const uint64_t request_time_ns = timer.Duration(
       RequestTimers::Kind::REQUEST_START, RequestTimers::Kind::REQUEST_END);
@@ -97,11 +142,562 @@ InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
              : ""));
   }
 
+  // The phases below are not captured by every protocol and transport, so
+  // the ones that are missing are counted as zero
+  const auto optional_duration = [&timer](
+                                     RequestTimers::Kind start,
+                                     RequestTimers::Kind end) -> uint64_t {
+    const uint64_t duration = timer.Duration(start, end);
+    return (duration == std::numeric_limits<uint64_t>::max()) ? 0 : duration;
+  };
+
+  std::lock_guard<std::mutex> lock(infer_stat_mutex_);
   infer_stat_.completed_request_count++;
   infer_stat_.cumulative_total_request_time_ns += request_time_ns;
   infer_stat_.cumulative_send_time_ns += send_time_ns;
   infer_stat_.cumulative_receive_time_ns += recv_time_ns;
+  infer_stat_.cumulative_serialize_time_ns += optional_duration(
+      RequestTimers::Kind::SERIALIZE_START, RequestTimers::Kind::SERIALIZE_END);
+  infer_stat_.cumulative_send_queue_time_ns += optional_duration(
+      RequestTimers::Kind::SERIALIZE_END, RequestTimers::Kind::TRANSPORT_START);
+  infer_stat_.cumulative_deserialize_time_ns += optional_duration(
+      RequestTimers::Kind::DESERIALIZE_START,
+      RequestTimers::Kind::DESERIALIZE_END);
+  infer_stat_.completed_response_count += response_count;
+  const uint64_t first_response_time_ns = timer.Duration(
+      RequestTimers::Kind::REQUEST_START, RequestTimers::Kind::FIRST_RESPONSE);
+  infer_stat_.cumulative_first_response_time_ns +=
+      (first_response_time_ns == std::numeric_limits<uint64_t>::max())
+          ? request_time_ns
+          : first_response_time_ns;
+
+  return Error::Success;
+}
+
+void
+InferenceServerClient::UpdateCacheStat(const bool hit)
+{
+  std::lock_guard<std::mutex> lock(infer_stat_mutex_);
+  if (hit) {
+    infer_stat_.cache_hit_count++;
+  } else {
+    infer_stat_.cache_miss_count++;
+  }
+}
+
+void
+InferenceServerClient::UpdateMetrics(
+    const std::string& model_name, const bool in_flight,
+    const RequestTimers& timer, const bool failed, const size_t bytes_sent,
+    const size_t bytes_received)
+{
+  if (metrics_ == nullptr) {
+    return;
+  }
+  uint64_t latency_ns = timer.Duration(
+      RequestTimers::Kind::REQUEST_START, RequestTimers::Kind::REQUEST_END);
+  if (latency_ns == std::numeric_limits<uint64_t>::max()) {
+    latency_ns = 0;
+  }
+  metrics_->RequestCompleted(
+      model_name, in_flight, latency_ns, failed, bytes_sent, bytes_received);
+}
+
+void
+InferenceServerClient::UpdateCompressionStat(
+    const bool compressed, const size_t input_byte_size,
+    const size_t saved_byte_size)
+{
+  std::lock_guard<std::mutex> lock(infer_stat_mutex_);
+  if (compressed) {
+    infer_stat_.compressed_request_count++;
+    infer_stat_.compressed_input_byte_size += input_byte_size;
+    infer_stat_.estimated_compression_saved_byte_size += saved_byte_size;
+  } else {
+    infer_stat_.uncompressed_request_count++;
+  }
+}
+
+void
+InferenceServerClient::UpdateByteStat(
+    const size_t request_byte_size, const size_t uncompressed_request_byte_size,
+    const size_t response_byte_size,
+    const size_t uncompressed_response_byte_size)
+{
+  std::lock_guard<std::mutex> lock(infer_stat_mutex_);
+  infer_stat_.cumulative_request_byte_size += request_byte_size;
+  infer_stat_.cumulative_uncompressed_request_byte_size +=
+      uncompressed_request_byte_size;
+  infer_stat_.cumulative_response_byte_size += response_byte_size;
+  infer_stat_.cumulative_uncompressed_response_byte_size +=
+      uncompressed_response_byte_size;
+}
+
+void
+InferenceServerClient::SetCompletionExecutor(Executor executor)
+{
+  completion_executor_ = std::move(executor);
+}
+
+void
+InferenceServerClient::EnableMetrics(
+    const std::vector<uint64_t>& latency_buckets_us)
+{
+  metrics_ = std::make_shared<ClientMetrics>(latency_buckets_us);
+}
+
+void
+InferenceServerClient::RunCompletion(
+    OnCompleteFn callback, InferResult* result)
+{
+  if (completion_executor_) {
+    completion_executor_(
+        [callback, result]() { callback(result); });
+  } else {
+    callback(result);
+  }
+}
+
+InferenceServerClient::OnCompleteFn
+InferenceServerClient::PromiseCallback(std::future<InferResult*>* future)
+{
+  std::shared_ptr<std::promise<InferResult*>> promise =
+      std::make_shared<std::promise<InferResult*>>();
+  *future = promise->get_future();
+  return [promise](InferResult* result) { promise->set_value(result); };
+}
+
+void
+InferenceServerClient::ReleaseOutstanding()
+{
+  if (outstanding_limiter_ != nullptr) {
+    outstanding_limiter_->Release();
+  }
+}
+
+namespace {
+
+constexpr char kBusyMessage[] =
+    "too many requests in flight, see 'max_outstanding_requests'";
+
+}  // namespace
+
+size_t
+InferenceServerClient::OutstandingRequestCount() const
+{
+  return (outstanding_limiter_ == nullptr)
+             ? 0
+             : outstanding_limiter_->Outstanding();
+}
+
+void
+InferenceServerClient::SetCapacityCallback(std::function<void()> on_capacity)
+{
+  if (outstanding_limiter_ != nullptr) {
+    outstanding_limiter_->SetOnCapacity(std::move(on_capacity));
+  }
+}
+
+bool
+InferenceServerClient::IsBusy(const Error& err)
+{
+  return err.Message() == kBusyMessage;
+}
+
+//==============================================================================
+
+OutstandingLimiter::OutstandingLimiter(
+    const size_t max_outstanding, const OutstandingOverload overload)
+    : max_outstanding_(max_outstanding), overload_(overload),
+      outstanding_(0), rejected_(false)
+{
+}
+
+Error
+OutstandingLimiter::Acquire()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (outstanding_ >= max_outstanding_) {
+    if (overload_ == OutstandingOverload::REJECT) {
+      rejected_ = true;
+      return Error(kBusyMessage);
+    }
+    cv_.wait(lock, [this] { return outstanding_ < max_outstanding_; });
+  }
+  outstanding_++;
+  return Error::Success;
+}
+
+void
+OutstandingLimiter::Release()
+{
+  std::function<void()> on_capacity;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    outstanding_--;
+    if (rejected_ && on_capacity_) {
+      rejected_ = false;
+      on_capacity = on_capacity_;
+    }
+  }
+  cv_.notify_one();
+  if (on_capacity) {
+    on_capacity();
+  }
+}
+
+size_t
+OutstandingLimiter::Outstanding() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return outstanding_;
+}
+
+void
+OutstandingLimiter::SetOnCapacity(std::function<void()> on_capacity)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  on_capacity_ = std::move(on_capacity);
+}
+
+//==============================================================================
+
+const std::vector<uint64_t> ClientMetrics::kDefaultLatencyBucketsUs{
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000,
+    500000, 1000000};
+
+ClientMetrics::ClientMetrics(const std::vector<uint64_t>& latency_buckets_us)
+    : latency_buckets_us_(latency_buckets_us)
+{
+}
+
+void
+ClientMetrics::RequestStarted(const std::string& model_name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  models_[model_name].in_flight_++;
+}
+
+void
+ClientMetrics::RequestCompleted(
+    const std::string& model_name, const bool in_flight,
+    const uint64_t latency_ns, const bool failed, const size_t bytes_sent,
+    const size_t bytes_received)
+{
+  // The buckets are counted cumulatively on export, so only the first
+  // bucket the latency falls in is counted here.
+  const size_t bucket =
+      std::lower_bound(
+          latency_buckets_us_.begin(), latency_buckets_us_.end(),
+          (latency_ns + 999) / 1000) -
+      latency_buckets_us_.begin();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ModelMetrics& metrics = models_[model_name];
+  if (metrics.bucket_counts_.empty()) {
+    metrics.bucket_counts_.resize(latency_buckets_us_.size() + 1, 0);
+  }
+  metrics.bucket_counts_[bucket]++;
+  metrics.request_count_++;
+  metrics.latency_sum_ns_ += latency_ns;
+  if (in_flight) {
+    metrics.in_flight_--;
+  }
+  if (failed) {
+    metrics.failure_count_++;
+  }
+  metrics.bytes_sent_ += bytes_sent;
+  metrics.bytes_received_ += bytes_received;
+}
+
+std::string
+ClientMetrics::PrometheusText() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> labels;
+  for (const auto& model : models_) {
+    std::string label = "model=\"";
+    for (const char c : model.first) {
+      if (c == '\n') {
+        label += "\\n";
+      } else {
+        if ((c == '\\') || (c == '"')) {
+          label += '\\';
+        }
+        label += c;
+      }
+    }
+    labels.emplace_back(label + "\"");
+  }
+
+  std::string text;
+  auto append_metric = [&](const char* name, const char* type,
+                           const char* help,
+                           uint64_t (*value)(const ModelMetrics&)) {
+    text += std::string("# HELP ") + name + " " + help + "\n";
+    text += std::string("# TYPE ") + name + " " + type + "\n";
+    size_t index = 0;
+    for (const auto& model : models_) {
+      text += std::string(name) + "{" + labels[index++] + "} " +
+              std::to_string(value(model.second)) + "\n";
+    }
+  };
+
+  text +=
+      "# HELP triton_client_request_duration_us Latency of the inference "
+      "requests\n";
+  text += "# TYPE triton_client_request_duration_us histogram\n";
+  size_t index = 0;
+  for (const auto& model : models_) {
+    const ModelMetrics& metrics = model.second;
+    uint64_t count = 0;
+    for (size_t bucket = 0; bucket < metrics.bucket_counts_.size(); ++bucket) {
+      count += metrics.bucket_counts_[bucket];
+      const std::string bound =
+          (bucket < latency_buckets_us_.size())
+              ? std::to_string(latency_buckets_us_[bucket])
+              : "+Inf";
+      text += "triton_client_request_duration_us_bucket{" + labels[index] +
+              ",le=\"" + bound + "\"} " + std::to_string(count) + "\n";
+    }
+    text += "triton_client_request_duration_us_sum{" + labels[index] + "} " +
+            std::to_string(metrics.latency_sum_ns_ / 1000) + "\n";
+    text += "triton_client_request_duration_us_count{" + labels[index] +
+            "} " + std::to_string(metrics.request_count_) + "\n";
+    index++;
+  }
+  append_metric(
+      "triton_client_requests_in_flight", "gauge",
+      "Asynchronous inference requests in flight",
+      [](const ModelMetrics& metrics) {
+        return static_cast<uint64_t>(std::max<int64_t>(0, metrics.in_flight_));
+      });
+  append_metric(
+      "triton_client_request_failure_total", "counter",
+      "Failed inference requests",
+      [](const ModelMetrics& metrics) { return metrics.failure_count_; });
+  append_metric(
+      "triton_client_request_bytes_total", "counter",
+      "Bytes of the inference requests sent",
+      [](const ModelMetrics& metrics) { return metrics.bytes_sent_; });
+  append_metric(
+      "triton_client_response_bytes_total", "counter",
+      "Bytes of the inference responses received",
+      [](const ModelMetrics& metrics) { return metrics.bytes_received_; });
+  return text;
+}
+
+//==============================================================================
+
+ModelMetadataCache::ModelMetadataCache(const uint64_t refresh_interval_us)
+    : refresh_interval_(refresh_interval_us)
+{
+}
+
+std::shared_ptr<ModelMetadataCache>
+ModelMetadataCache::Shared()
+{
+  static std::shared_ptr<ModelMetadataCache> cache =
+      std::make_shared<ModelMetadataCache>();
+  return cache;
+}
+
+bool
+ModelMetadataCache::Lookup(
+    const std::string& server, const std::string& kind,
+    const std::string& model_name, const std::string& model_version,
+    std::string* value)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto server_it = servers_.find(server);
+  if (server_it == servers_.end()) {
+    return false;
+  }
+  auto model_it = server_it->second.entries_.find(model_name);
+  if (model_it == server_it->second.entries_.end()) {
+    return false;
+  }
+  auto entry_it = model_it->second.find(kind + "/" + model_version);
+  if (entry_it == model_it->second.end()) {
+    return false;
+  }
+  *value = entry_it->second;
+  return true;
+}
+
+void
+ModelMetadataCache::Insert(
+    const std::string& server, const std::string& kind,
+    const std::string& model_name, const std::string& model_version,
+    const std::string& value)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  servers_[server].entries_[model_name][kind + "/" + model_version] = value;
+}
+
+void
+ModelMetadataCache::InvalidateModel(
+    const std::string& server, const std::string& model_name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto server_it = servers_.find(server);
+  if (server_it != servers_.end()) {
+    server_it->second.entries_.erase(model_name);
+  }
+}
+
+void
+ModelMetadataCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  servers_.clear();
+}
+
+bool
+ModelMetadataCache::RefreshDue(const std::string& server)
+{
+  if (refresh_interval_.count() == 0) {
+    return false;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ServerState& state = servers_[server];
+  if (state.indexed_ && (now < state.next_refresh_)) {
+    return false;
+  }
+  // The other clients keep using the entries meanwhile
+  state.indexed_ = true;
+  state.next_refresh_ = now + refresh_interval_;
+  return true;
+}
+
+void
+ModelMetadataCache::UpdateIndex(
+    const std::string& server,
+    const std::map<std::string, std::string>& models)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ServerState& state = servers_[server];
+  for (const auto& model : state.models_) {
+    auto it = models.find(model.first);
+    if ((it == models.end()) || (it->second != model.second)) {
+      state.entries_.erase(model.first);
+    }
+  }
+  // The entries of a model missing from the previous index were cached
+  // before the model was listed, so they may be stale too.
+  for (const auto& model : models) {
+    if (state.models_.find(model.first) == state.models_.end()) {
+      state.entries_.erase(model.first);
+    }
+  }
+  state.models_ = models;
+}
+
+//==============================================================================
+
+CompletionThreadPool::CompletionThreadPool(const size_t thread_count)
+{
+  for (size_t i = 0; i < std::max<size_t>(1, thread_count); ++i) {
+    workers_.emplace_back(new Worker());
+    workers_.back()->thread_ = std::thread(Run, workers_.back().get());
+  }
+}
+
+CompletionThreadPool::~CompletionThreadPool()
+{
+  for (auto& worker : workers_) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex_);
+      worker->exiting_ = true;
+    }
+    worker->cv_.notify_one();
+  }
+  for (auto& worker : workers_) {
+    worker->thread_.join();
+  }
+}
+
+void
+CompletionThreadPool::Submit(const uint64_t key, std::function<void()> task)
+{
+  Worker* worker = workers_[key % workers_.size()].get();
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex_);
+    worker->tasks_.emplace_back(std::move(task));
+  }
+  worker->cv_.notify_one();
+}
+
+void
+CompletionThreadPool::Run(Worker* worker)
+{
+  std::deque<std::function<void()>> tasks;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker->mutex_);
+      worker->cv_.wait(lock, [worker] {
+        return worker->exiting_ || !worker->tasks_.empty();
+      });
+      if (worker->tasks_.empty()) {
+        return;
+      }
+      tasks.swap(worker->tasks_);
+    }
+    for (auto& task : tasks) {
+      task();
+    }
+    tasks.clear();
+  }
+}
+
+//==============================================================================
+
+Error
+PreparedInferRequest::RecordInputs(const std::vector<InferInput*>& inputs)
+{
+  inputs_.clear();
+  for (const auto input : inputs) {
+    size_t byte_size = 0;
+    if (!input->IsSharedMemory()) {
+      Error err = input->ByteSize(&byte_size);
+      if (!err.IsOk()) {
+        return err;
+      }
+    }
+    inputs_.emplace_back(input->IsSharedMemory(), byte_size);
+  }
+  return Error::Success;
+}
 
+Error
+PreparedInferRequest::CheckInputs(const std::vector<InferInput*>& inputs) const
+{
+  if (inputs.size() != inputs_.size()) {
+    return Error(
+        "The request was prepared with " + std::to_string(inputs_.size()) +
+        " inputs, got " + std::to_string(inputs.size()) + ".");
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i]->IsSharedMemory() != inputs_[i].first) {
+      return Error(
+          "The input '" + inputs[i]->Name() +
+          "' must use shared memory as when the request was prepared.");
+    }
+    if (!inputs_[i].first) {
+      size_t byte_size;
+      Error err = inputs[i]->ByteSize(&byte_size);
+      if (!err.IsOk()) {
+        return err;
+      }
+      if (byte_size != inputs_[i].second) {
+        return Error(
+            "The input '" + inputs[i]->Name() + "' has " +
+            std::to_string(byte_size) + " bytes, the request was prepared " +
+            "for " + std::to_string(inputs_[i].second) + ".");
+      }
+    }
+  }
   return Error::Success;
 }
 
@@ -129,6 +725,7 @@ InferInput::Reset()
   bufs_.clear();
   buf_byte_sizes_.clear();
   str_bufs_.clear();
+  shared_bufs_.clear();
   bufs_idx_ = 0;
   byte_size_ = 0;
   io_type_ = NONE;
@@ -153,6 +750,142 @@ InferInput::AppendRaw(const uint8_t* input, size_t input_byte_size)
   return Error::Success;
 }
 
+Error
+InferInput::AppendShared(
+    std::shared_ptr<const uint8_t> input, size_t input_byte_size)
+{
+  if ((input == nullptr) && (input_byte_size != 0)) {
+    return Error("the shared buffer of input '" + name_ + "' is null");
+  }
+  Error err = AppendRaw(input.get(), input_byte_size);
+  if (err.IsOk()) {
+    shared_bufs_.emplace_back(std::move(input));
+  }
+  return err;
+}
+
+Error
+InferInput::AppendSlice(
+    const InferInput& source, size_t offset, size_t byte_size)
+{
+  if (source.io_type_ == SHARED_MEMORY) {
+    return Error(
+        "input '" + source.name_ +
+        "' uses shared memory, its values can't be appended");
+  }
+  if ((offset > source.byte_size_) ||
+      (byte_size > source.byte_size_ - offset)) {
+    return Error(
+        "the range appended to input '" + name_ +
+        "' extends past the end of the values of input '" + source.name_ +
+        "'");
+  }
+  for (size_t i = 0; (i < source.bufs_.size()) && (byte_size > 0); ++i) {
+    const size_t buf_byte_size = source.buf_byte_sizes_[i];
+    if (offset >= buf_byte_size) {
+      offset -= buf_byte_size;
+      continue;
+    }
+    const size_t count = std::min(buf_byte_size - offset, byte_size);
+    AppendRaw(source.bufs_[i] + offset, count);
+    offset = 0;
+    byte_size -= count;
+  }
+  shared_bufs_.insert(
+      shared_bufs_.end(), source.shared_bufs_.begin(),
+      source.shared_bufs_.end());
+  return Error::Success;
+}
+
+Error
+InferInput::AppendFromFile(
+    const std::string& path, size_t offset, size_t byte_size)
+{
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return Error(
+        "failed to open file '" + path + "' for input '" + name_ + "'");
+  }
+  const size_t file_size = file.tellg();
+  if ((offset > file_size) || (byte_size > file_size - offset)) {
+    return Error(
+        "the range of file '" + path + "' for input '" + name_ +
+        "' extends past the end of the file");
+  }
+  if (byte_size == 0) {
+    byte_size = file_size - offset;
+  }
+  std::shared_ptr<uint8_t> data(
+      new uint8_t[byte_size], std::default_delete<uint8_t[]>());
+  file.seekg(offset);
+  if (!file.read(reinterpret_cast<char*>(data.get()), byte_size)) {
+    return Error(
+        "failed to read file '" + path + "' for input '" + name_ + "'");
+  }
+  return AppendShared(std::move(data), byte_size);
+#else
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return Error(
+        "failed to open file '" + path + "' for input '" + name_ +
+        "': " + std::strerror(errno));
+  }
+  Error err = AppendFromFile(fd, offset, byte_size);
+  close(fd);
+  return err;
+#endif  // _WIN32
+}
+
+Error
+InferInput::AppendFromFile(int fd, size_t offset, size_t byte_size)
+{
+#ifdef _WIN32
+  return Error(
+      "appending input '" + name_ +
+      "' from a file descriptor is not supported on Windows");
+#else
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    return Error(
+        "failed to stat the file of input '" + name_ +
+        "': " + std::strerror(errno));
+  }
+  const size_t file_size = file_stat.st_size;
+  if ((offset > file_size) || (byte_size > file_size - offset)) {
+    return Error(
+        "the file range of input '" + name_ +
+        "' extends past the end of the file");
+  }
+  if (byte_size == 0) {
+    byte_size = file_size - offset;
+    if (byte_size == 0) {
+      return AppendRaw(nullptr, 0);
+    }
+  }
+
+  // Mappings start at a page boundary
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  const size_t page_offset = offset % page_size;
+  const size_t map_size = page_offset + byte_size;
+  void* map =
+      mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, offset - page_offset);
+  if (map == MAP_FAILED) {
+    return Error(
+        "failed to map the file of input '" + name_ +
+        "': " + std::strerror(errno));
+  }
+  madvise(map, map_size, MADV_SEQUENTIAL);
+  std::shared_ptr<const uint8_t> mapping(
+      static_cast<const uint8_t*>(map), [map_size](const uint8_t* addr) {
+        munmap(const_cast<uint8_t*>(addr), map_size);
+      });
+  return AppendShared(
+      std::shared_ptr<const uint8_t>(mapping, mapping.get() + page_offset),
+      byte_size);
+#endif  // _WIN32
+}
+
 Error
 InferInput::SetSharedMemory(
     const std::string& name, size_t byte_size, size_t offset)
@@ -171,8 +904,13 @@ InferInput::AppendFromString(const std::vector<std::string>& input)
   // Serialize the strings into a "raw" buffer. The first 4-bytes are
   // the length of the string length. Next are the actual string
   // characters. There is *not* a null-terminator on the string.
+  size_t byte_size = 0;
+  for (const auto& str : input) {
+    byte_size += sizeof(uint32_t) + str.size();
+  }
   str_bufs_.emplace_back();
   std::string& sbuf = str_bufs_.back();
+  sbuf.reserve(byte_size);
   for (const auto& str : input) {
     uint32_t len = str.size();
     sbuf.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
@@ -182,6 +920,77 @@ InferInput::AppendFromString(const std::vector<std::string>& input)
   return AppendRaw(reinterpret_cast<const uint8_t*>(&sbuf[0]), sbuf.size());
 }
 
+Error
+InferInput::AppendFromFloat(
+    const float* input, size_t count, float scale, int32_t zero_point)
+{
+  if ((type_ != DataType::FP32) && (type_ != DataType::FP16) &&
+      (type_ != DataType::BF16) && (type_ != DataType::INT8)) {
+    return Error(
+        "FP32 values can't be converted to input '" + name_ +
+        "' with datatype " + datatype_);
+  }
+  if ((type_ == DataType::INT8) && (scale == 0.0f)) {
+    return Error("the quantization scale of input '" + name_ + "' is 0");
+  }
+
+  const size_t byte_size = count * DataTypeByteSize(type_);
+  str_bufs_.emplace_back(byte_size, '\0');
+  uint8_t* buf = reinterpret_cast<uint8_t*>(&str_bufs_.back()[0]);
+  switch (type_) {
+    case DataType::FP16:
+      ConvertFp32ToFp16(input, count, reinterpret_cast<uint16_t*>(buf));
+      break;
+    case DataType::BF16:
+      ConvertFp32ToBf16(input, count, reinterpret_cast<uint16_t*>(buf));
+      break;
+    case DataType::INT8:
+      QuantizeFp32ToInt8(
+          input, count, scale, zero_point, reinterpret_cast<int8_t*>(buf));
+      break;
+    default:
+      memcpy(buf, input, byte_size);
+      break;
+  }
+
+  return AppendRaw(buf, byte_size);
+}
+
+Error
+InferInput::AppendFromStringBuffer(
+    const char* data, const std::vector<size_t>& offsets)
+{
+  if (offsets.empty()) {
+    return Error(
+        "the offsets of the strings of input '" + name_ +
+        "' must end with the end of the last string");
+  }
+  const size_t element_count = offsets.size() - 1;
+  for (size_t i = 0; i < element_count; ++i) {
+    if ((offsets[i + 1] < offsets[i]) ||
+        (offsets[i + 1] - offsets[i] > UINT32_MAX)) {
+      return Error(
+          "invalid offsets for string " + std::to_string(i) + " of input '" +
+          name_ + "'");
+    }
+  }
+
+  // Same layout as AppendFromString(), written in place
+  str_bufs_.emplace_back();
+  std::string& sbuf = str_bufs_.back();
+  sbuf.resize(
+      element_count * sizeof(uint32_t) + (offsets.back() - offsets.front()));
+  char* dst = &sbuf[0];
+  for (size_t i = 0; i < element_count; ++i) {
+    const uint32_t len = offsets[i + 1] - offsets[i];
+    std::memcpy(dst, &len, sizeof(uint32_t));
+    std::memcpy(dst + sizeof(uint32_t), data + offsets[i], len);
+    dst += sizeof(uint32_t) + len;
+  }
+
+  return AppendRaw(reinterpret_cast<const uint8_t*>(sbuf.data()), sbuf.size());
+}
+
 Error
 InferInput::ByteSize(size_t* byte_size) const
 {
@@ -192,7 +1001,8 @@ InferInput::ByteSize(size_t* byte_size) const
 InferInput::InferInput(
     const std::string& name, const std::vector<int64_t>& shape,
     const std::string& datatype)
-    : name_(name), shape_(shape), datatype_(datatype), byte_size_(0),
+    : name_(name), shape_(shape), datatype_(datatype),
+      type_(StringToDataType(datatype)), byte_size_(0),
       bufs_idx_(0), buf_pos_(0), io_type_(NONE), shm_name_(""), shm_offset_(0)
 {
 }
@@ -269,6 +1079,77 @@ InferInput::GetNext(
 
 //==============================================================================
 
+Error
+InferResult::Type(const std::string& output_name, DataType* type) const
+{
+  std::string datatype;
+  Error err = Datatype(output_name, &datatype);
+  if (!err.IsOk()) {
+    return err;
+  }
+  *type = StringToDataType(datatype);
+  return Error::Success;
+}
+
+Error
+InferResult::StringDataRefs(
+    const std::string& output_name,
+    std::vector<std::pair<const char*, size_t>>* string_result) const
+{
+  DataType type;
+  Error err = Type(output_name, &type);
+  if (!err.IsOk()) {
+    return err;
+  }
+  if (type != DataType::BYTES) {
+    return Error(
+        "This function supports tensors with datatype 'BYTES', requested "
+        "output tensor '" +
+        output_name + "' with datatype '" + DataTypeString(type) + "'");
+  }
+
+  const uint8_t* buf;
+  size_t byte_size;
+  err = RawData(output_name, &buf, &byte_size);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  // Each element is its 4-byte length followed by its characters. The
+  // lengths have to be read one after the other, but the shape tells how
+  // many elements there are.
+  string_result->clear();
+  std::vector<int64_t> shape;
+  if (Shape(output_name, &shape).IsOk()) {
+    int64_t element_count = 1;
+    for (const int64_t dim : shape) {
+      element_count *= (dim > 0) ? dim : 0;
+    }
+    string_result->reserve(element_count);
+  }
+  size_t buf_offset = 0;
+  while (byte_size > buf_offset) {
+    uint32_t element_size;
+    if (byte_size - buf_offset < sizeof(element_size)) {
+      return Error(
+          "unexpected end of the data of output tensor '" + output_name + "'");
+    }
+    std::memcpy(&element_size, buf + buf_offset, sizeof(element_size));
+    buf_offset += sizeof(element_size);
+    if (byte_size - buf_offset < element_size) {
+      return Error(
+          "unexpected end of the data of output tensor '" + output_name + "'");
+    }
+    string_result->emplace_back(
+        reinterpret_cast<const char*>(buf + buf_offset), element_size);
+    buf_offset += element_size;
+  }
+
+  return Error::Success;
+}
+
+//==============================================================================
+
 Error
 InferRequestedOutput::Create(
     InferRequestedOutput** infer_output, const std::string& name,
@@ -303,7 +1184,8 @@ InferRequestedOutput::UnsetSharedMemory()
 
 InferRequestedOutput::InferRequestedOutput(
     const std::string& name, const size_t class_count)
-    : name_(name), class_count_(class_count), io_type_(NONE)
+    : name_(name), class_count_(class_count), io_type_(NONE),
+      user_buffer_(nullptr), user_buffer_byte_size_(0)
 {
 }
 
@@ -322,6 +1204,187 @@ InferRequestedOutput::SharedMemoryInfo(
   return Error::Success;
 }
 
+Error
+InferRequestedOutput::SetUserBuffer(void* buf, const size_t byte_size)
+{
+  if (buf == nullptr) {
+    return Error(
+        "The user buffer of output '" + name_ + "' must not be null.");
+  }
+  user_buffer_ = reinterpret_cast<uint8_t*>(buf);
+  user_buffer_byte_size_ = byte_size;
+  io_type_ = USER_BUFFER;
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::UnsetUserBuffer()
+{
+  user_buffer_ = nullptr;
+  user_buffer_byte_size_ = 0;
+  if (io_type_ == USER_BUFFER) {
+    io_type_ = NONE;
+  }
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::UserBufferInfo(uint8_t** buf, size_t* byte_size) const
+{
+  if (io_type_ != USER_BUFFER) {
+    return Error("The output has not been set with a user buffer.");
+  }
+
+  *buf = user_buffer_;
+  *byte_size = user_buffer_byte_size_;
+
+  return Error::Success;
+}
+
+//==============================================================================
+
+namespace {
+
+// Hash 'byte_size' bytes at 'data', continuing from 'hash'. The bytes are
+// mixed in 8 at a time and the result is finalized with the MurmurHash3
+// 64-bit finalizer.
+uint64_t
+HashBytes(const uint8_t* data, const size_t byte_size, uint64_t hash)
+{
+  constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= byte_size; offset += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + offset, sizeof(word));
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 29;
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, data + offset, byte_size - offset);
+  hash = (hash ^ tail ^ byte_size) * kMultiplier;
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+void
+AppendBytes(const void* value, const size_t byte_size, std::string* key)
+{
+  key->append(reinterpret_cast<const char*>(value), byte_size);
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(const size_t max_byte_size, const uint64_t ttl_us)
+    : max_byte_size_(max_byte_size), ttl_(ttl_us), byte_size_(0)
+{
+}
+
+bool
+ResponseCache::Key(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs, std::string* key)
+{
+  if ((options.sequence_id_ != 0) || !options.sequence_id_str_.empty()) {
+    return false;
+  }
+  for (const auto output : outputs) {
+    if (output->IsSharedMemory() || output->IsUserBuffer()) {
+      return false;
+    }
+  }
+
+  // The strings are followed by a NUL so that the fields can't run into
+  // each other.
+  key->clear();
+  key->append(options.model_name_).push_back('\0');
+  key->append(options.model_version_).push_back('\0');
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      return false;
+    }
+    key->append(input->Name()).push_back('\0');
+    key->append(input->Datatype()).push_back('\0');
+    const uint64_t rank = input->Shape().size();
+    AppendBytes(&rank, sizeof(rank), key);
+    AppendBytes(input->Shape().data(), rank * sizeof(int64_t), key);
+
+    uint64_t hash = 0;
+    uint64_t byte_size = 0;
+    input->PrepareForRequest();
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      if ((buf != nullptr) && (buf_size != 0)) {
+        hash = HashBytes(buf, buf_size, hash);
+        byte_size += buf_size;
+      }
+    }
+    AppendBytes(&byte_size, sizeof(byte_size), key);
+    AppendBytes(&hash, sizeof(hash), key);
+  }
+  for (const auto output : outputs) {
+    key->append(output->Name()).push_back('\0');
+    const uint64_t class_count = output->ClassificationCount();
+    AppendBytes(&class_count, sizeof(class_count), key);
+  }
+  return true;
+}
+
+std::shared_ptr<void>
+ResponseCache::Lookup(const std::string& key)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if ((ttl_.count() != 0) &&
+      (std::chrono::steady_clock::now() >= it->second->expiry_)) {
+    Erase(it->second);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->response_;
+}
+
+void
+ResponseCache::Insert(
+    const std::string& key, const std::shared_ptr<void>& response,
+    const size_t byte_size)
+{
+  if (byte_size > max_byte_size_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Erase(it->second);
+  }
+  while (byte_size_ + byte_size > max_byte_size_) {
+    Erase(std::prev(entries_.end()));
+  }
+  entries_.emplace_front(
+      key, response, byte_size, std::chrono::steady_clock::now() + ttl_);
+  index_.emplace(key, entries_.begin());
+  byte_size_ += byte_size;
+}
+
+void
+ResponseCache::Erase(std::list<Entry>::iterator it)
+{
+  byte_size_ -= it->byte_size_;
+  index_.erase(it->key_);
+  entries_.erase(it);
+}
+
 //==============================================================================
 
 }}  // namespace triton::client
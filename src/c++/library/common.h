@@ -30,16 +30,28 @@
 #include <algorithm>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <cstring>
+#include <deque>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define TRITON_CLIENT_HAS_COROUTINES 1
+#endif
+#endif
+
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
 namespace triton { namespace perfanalyzer { namespace clientbackend {
 namespace tritoncapi {
@@ -53,9 +65,12 @@ constexpr char kInferHeaderContentLengthHTTPHeader[] =
     "Inference-Header-Content-Length";
 constexpr int MAX_GRPC_MESSAGE_SIZE = INT32_MAX;
 
+class InferInput;
 class InferResult;
 class InferRequest;
 class RequestTimers;
+class ResponseCache;
+class SharedMemoryRing;
 //==============================================================================
 /// Error status reported by client API.
 ///
@@ -83,6 +98,110 @@ class Error {
   std::string msg_;
 };
 
+//==============================================================================
+/// The datatypes of the tensors, resolved once from their names so that
+/// the code handling every request switches on them instead of comparing
+/// strings. The values are in the order of TRITONSERVER_DataType.
+///
+enum class DataType : uint8_t {
+  INVALID,
+  BOOL,
+  UINT8,
+  UINT16,
+  UINT32,
+  UINT64,
+  INT8,
+  INT16,
+  INT32,
+  INT64,
+  FP16,
+  FP32,
+  FP64,
+  BYTES,
+  BF16
+};
+
+/// The size in bytes of an element of each datatype, in the order of
+/// DataType. 0 for the datatypes without a fixed size.
+constexpr size_t kDataTypeByteSizes[] = {0, 1, 1, 2, 4, 8, 1, 2,
+                                         4, 8, 2, 4, 8, 0, 2};
+
+/// \param type The datatype.
+/// \return The size in bytes of an element of 'type', or 0 if its elements
+/// don't have a fixed size.
+constexpr size_t
+DataTypeByteSize(DataType type)
+{
+  return kDataTypeByteSizes[static_cast<size_t>(type)];
+}
+
+/// \param datatype The name of the datatype, such as "FP32".
+/// \param length The length of the name.
+/// \return The datatype, or DataType::INVALID for an unknown name.
+DataType StringToDataType(const char* datatype, size_t length);
+
+/// \param datatype The name of the datatype, such as "FP32".
+/// \return The datatype, or DataType::INVALID for an unknown name.
+inline DataType
+StringToDataType(const std::string& datatype)
+{
+  return StringToDataType(datatype.data(), datatype.size());
+}
+
+/// \param type The datatype.
+/// \return The name of 'type', such as "FP32".
+const char* DataTypeString(DataType type);
+
+/// The datatype of the elements of C++ type T, for the typed accessors of
+/// InferInput and InferResult. FP16 and BF16 have no C++ type.
+template <typename T>
+struct DataTypeOf;
+
+template <>
+struct DataTypeOf<bool> {
+  static constexpr DataType value = DataType::BOOL;
+};
+template <>
+struct DataTypeOf<uint8_t> {
+  static constexpr DataType value = DataType::UINT8;
+};
+template <>
+struct DataTypeOf<uint16_t> {
+  static constexpr DataType value = DataType::UINT16;
+};
+template <>
+struct DataTypeOf<uint32_t> {
+  static constexpr DataType value = DataType::UINT32;
+};
+template <>
+struct DataTypeOf<uint64_t> {
+  static constexpr DataType value = DataType::UINT64;
+};
+template <>
+struct DataTypeOf<int8_t> {
+  static constexpr DataType value = DataType::INT8;
+};
+template <>
+struct DataTypeOf<int16_t> {
+  static constexpr DataType value = DataType::INT16;
+};
+template <>
+struct DataTypeOf<int32_t> {
+  static constexpr DataType value = DataType::INT32;
+};
+template <>
+struct DataTypeOf<int64_t> {
+  static constexpr DataType value = DataType::INT64;
+};
+template <>
+struct DataTypeOf<float> {
+  static constexpr DataType value = DataType::FP32;
+};
+template <>
+struct DataTypeOf<double> {
+  static constexpr DataType value = DataType::FP64;
+};
+
 //==============================================================================
 /// Cumulative inference statistics.
 ///
@@ -106,14 +225,276 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Time spent building the request from the inputs and options.
+  uint64_t cumulative_serialize_time_ns;
+
+  /// Time from the request being built until the transport starts sending
+  /// its body. Not measured for GRPC protocol.
+  uint64_t cumulative_send_queue_time_ns;
+
+  /// Time spent parsing the response into the result.
+  uint64_t cumulative_deserialize_time_ns;
+
+  /// Total number of responses of the completed requests. Larger than
+  /// completed_request_count when requests on a stream to a decoupled model
+  /// get several responses each.
+  size_t completed_response_count;
+
+  /// Time from the request start until its first response is received.
+  /// Equal to the total request time for requests with a single response.
+  uint64_t cumulative_first_response_time_ns;
+
+  /// Number of Infer() calls answered from the client-side response cache,
+  /// which are not counted as completed requests.
+  size_t cache_hit_count;
+
+  /// Number of cacheable Infer() calls that were not found in the cache.
+  size_t cache_miss_count;
+
+  /// Number of requests for which the adaptive compression of the client
+  /// chose to compress the request. Only counted for GRPC protocol.
+  size_t compressed_request_count;
+
+  /// Byte size of the inputs of the requests counted in
+  /// 'compressed_request_count'.
+  uint64_t compressed_input_byte_size;
+
+  /// Estimated number of bytes the compression of these requests saved,
+  /// from the byte entropy of a sample of their inputs.
+  uint64_t estimated_compression_saved_byte_size;
+
+  /// Number of requests the adaptive compression sent uncompressed, either
+  /// too small or not compressible enough.
+  size_t uncompressed_request_count;
+
+  /// Byte size of the request and response bodies of the completed requests,
+  /// as sent on the wire and before compression. Protocol headers are not
+  /// counted. For GRPC protocol both are the size of the messages, as they
+  /// are compressed by the transport, and the responses on a stream are not
+  /// counted.
+  uint64_t cumulative_request_byte_size;
+  uint64_t cumulative_uncompressed_request_byte_size;
+  uint64_t cumulative_response_byte_size;
+  uint64_t cumulative_uncompressed_response_byte_size;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cumulative_serialize_time_ns(0), cumulative_send_queue_time_ns(0),
+        cumulative_deserialize_time_ns(0), completed_response_count(0),
+        cumulative_first_response_time_ns(0), cache_hit_count(0),
+        cache_miss_count(0), compressed_request_count(0),
+        compressed_input_byte_size(0),
+        estimated_compression_saved_byte_size(0), uncompressed_request_count(0),
+        cumulative_request_byte_size(0),
+        cumulative_uncompressed_request_byte_size(0),
+        cumulative_response_byte_size(0),
+        cumulative_uncompressed_response_byte_size(0)
   {
   }
 };
 
+//==============================================================================
+/// What AsyncInfer() does with a request when the client already has its
+/// maximum number of requests in flight, see the 'max_outstanding_requests'
+/// option of the clients.
+///
+enum class OutstandingOverload {
+  /// Wait for a request in flight to complete. Must not be used when
+  /// AsyncInfer() is called from the callback of another request.
+  BLOCK,
+  /// Fail with an error for which InferenceServerClient::IsBusy() is true.
+  REJECT
+};
+
+//==============================================================================
+/// An OutstandingLimiter caps the number of asynchronous requests of a
+/// client that are in flight.
+///
+class OutstandingLimiter {
+ public:
+  /// \param max_outstanding The maximum number of requests in flight.
+  /// \param overload What Acquire() does when they are all in flight.
+  OutstandingLimiter(
+      const size_t max_outstanding, const OutstandingOverload overload);
+
+  /// Take a slot for a new request, waiting for one to free up or failing
+  /// as set by the overload mode.
+  /// \return Error object indicating success or failure.
+  Error Acquire();
+
+  /// Free the slot of a completed request.
+  void Release();
+
+  /// \return The number of requests in flight.
+  size_t Outstanding() const;
+
+  /// Set the function invoked when a slot frees up after Acquire() has
+  /// failed, from the thread completing the request.
+  void SetOnCapacity(std::function<void()> on_capacity);
+
+ private:
+  const size_t max_outstanding_;
+  const OutstandingOverload overload_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t outstanding_;
+  // Whether Acquire() has failed since the last call of 'on_capacity_'
+  bool rejected_;
+  std::function<void()> on_capacity_;
+};
+
+//==============================================================================
+/// A CompletionThreadPool runs the callbacks of asynchronous requests on its
+/// own threads, so that a slow callback doesn't hold up the transfers of the
+/// client. The callbacks submitted with the same key run on the same thread
+/// in the order they are submitted.
+///
+class CompletionThreadPool {
+ public:
+  /// \param thread_count The number of threads, at least 1.
+  explicit CompletionThreadPool(const size_t thread_count);
+
+  /// Run the callbacks already submitted and stop the threads.
+  ~CompletionThreadPool();
+
+  /// Queue 'task' on the thread selected by 'key'.
+  /// \param key The key ordering the task after the tasks with the same key.
+  /// \param task The function to run.
+  void Submit(const uint64_t key, std::function<void()> task);
+
+ private:
+  struct Worker {
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool exiting_{false};
+    std::thread thread_;
+  };
+
+  static void Run(Worker* worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+//==============================================================================
+/// ClientMetrics collects per-model metrics of the inference requests of a
+/// client: a latency histogram, the asynchronous requests in flight, the
+/// failed requests and the bytes sent and received. They are exported in
+/// the Prometheus text format, see InferenceServerClient::EnableMetrics().
+///
+class ClientMetrics {
+ public:
+  /// \param latency_buckets_us The upper bounds of the buckets of the
+  /// latency histogram, in microseconds and increasing order.
+  explicit ClientMetrics(const std::vector<uint64_t>& latency_buckets_us);
+
+  /// Count an asynchronous request to 'model_name' as in flight.
+  void RequestStarted(const std::string& model_name);
+
+  /// Record a completed request to 'model_name'.
+  /// \param in_flight Whether the request was counted by RequestStarted().
+  /// \param latency_ns The time from the request start to its end.
+  /// \param failed Whether the request failed.
+  /// \param bytes_sent The byte size of the request sent.
+  /// \param bytes_received The byte size of the response received.
+  void RequestCompleted(
+      const std::string& model_name, const bool in_flight,
+      const uint64_t latency_ns, const bool failed, const size_t bytes_sent,
+      const size_t bytes_received);
+
+  /// \return The metrics in the Prometheus text exposition format.
+  std::string PrometheusText() const;
+
+  /// The default upper bounds of the latency buckets, from 100 usec to 1
+  /// sec.
+  static const std::vector<uint64_t> kDefaultLatencyBucketsUs;
+
+ private:
+  struct ModelMetrics {
+    std::vector<uint64_t> bucket_counts_;
+    uint64_t request_count_{0};
+    uint64_t latency_sum_ns_{0};
+    int64_t in_flight_{0};
+    uint64_t failure_count_{0};
+    uint64_t bytes_sent_{0};
+    uint64_t bytes_received_{0};
+  };
+
+  const std::vector<uint64_t> latency_buckets_us_;
+  mutable std::mutex mutex_;
+  std::map<std::string, ModelMetrics> models_;
+};
+
+//==============================================================================
+/// ModelMetadataCache keeps the model metadata and configurations fetched
+/// by the clients using it, keyed by server, model name and version, so
+/// that clients asking for them again don't contact the server. A model's
+/// entries are dropped when a client using the cache loads or unloads the
+/// model, and when the versions or states of the model listed in the
+/// repository index of the server change. The clients check the index
+/// before a lookup once per refresh interval. It may be shared by the
+/// clients of several threads, see InferenceServerClient::SetModelCache().
+///
+class ModelMetadataCache {
+ public:
+  /// \param refresh_interval_us How often the repository index of a server
+  /// is checked for reloaded models, in microseconds. 0 disables the checks.
+  /// The default value is 1 sec.
+  explicit ModelMetadataCache(const uint64_t refresh_interval_us = 1000000);
+
+  /// \return The cache shared by the clients of the process.
+  static std::shared_ptr<ModelMetadataCache> Shared();
+
+  /// Get the cached entry of 'kind', such as "metadata" or "config", of a
+  /// model version of 'server'.
+  /// \return Whether the entry was found.
+  bool Lookup(
+      const std::string& server, const std::string& kind,
+      const std::string& model_name, const std::string& model_version,
+      std::string* value);
+
+  /// Cache an entry, see Lookup().
+  void Insert(
+      const std::string& server, const std::string& kind,
+      const std::string& model_name, const std::string& model_version,
+      const std::string& value);
+
+  /// Drop the entries of the model 'model_name' of 'server'.
+  void InvalidateModel(
+      const std::string& server, const std::string& model_name);
+
+  /// Drop all the entries.
+  void Clear();
+
+  /// \return Whether the repository index of 'server' is to be checked
+  /// now, in which case it isn't due again before the refresh interval.
+  bool RefreshDue(const std::string& server);
+
+  /// Record the repository index of 'server' and drop the entries of the
+  /// models that changed since the previous index.
+  /// \param models The state of each model in the index, such as its
+  /// versions and their states, compared as an opaque string.
+  void UpdateIndex(
+      const std::string& server,
+      const std::map<std::string, std::string>& models);
+
+ private:
+  struct ServerState {
+    bool indexed_{false};
+    std::chrono::steady_clock::time_point next_refresh_;
+    std::map<std::string, std::string> models_;
+    // The entries of each model, keyed by kind and version
+    std::map<std::string, std::map<std::string, std::string>> entries_;
+  };
+
+  const std::chrono::microseconds refresh_interval_;
+  std::mutex mutex_;
+  std::map<std::string, ServerState> servers_;
+};
+
 //==============================================================================
 /// The base class for InferenceServerClients
 ///
@@ -121,6 +502,8 @@ class InferenceServerClient {
  public:
   using OnCompleteFn = std::function<void(InferResult*)>;
   using OnMultiCompleteFn = std::function<void(std::vector<InferResult*>)>;
+  // Runs the given task, on a thread of its choice.
+  using Executor = std::function<void(std::function<void()>)>;
 
   explicit InferenceServerClient(bool verbose)
       : verbose_(verbose), exiting_(false)
@@ -134,9 +517,89 @@ class InferenceServerClient {
   /// \return Error object indicating success or failure.
   Error ClientInferStat(InferStat* infer_stat) const;
 
+  /// \return The number of asynchronous inference requests in flight. Only
+  /// counted when the 'max_outstanding_requests' option of the client is
+  /// set, 0 otherwise.
+  size_t OutstandingRequestCount() const;
+
+  /// Set the function invoked once a request in flight completes after
+  /// AsyncInfer() rejected a request for the 'max_outstanding_requests'
+  /// limit, so that the caller can submit again. It is invoked from the
+  /// thread completing the request, before the callback of the request.
+  /// \param on_capacity The function to invoke.
+  void SetCapacityCallback(std::function<void()> on_capacity);
+
+  /// \param err An error returned by AsyncInfer().
+  /// \return Whether the request was rejected because the client already
+  /// had its maximum number of requests in flight.
+  static bool IsBusy(const Error& err);
+
+  /// Set the executor to which the callbacks of AsyncInfer(), and so the
+  /// futures and coroutines waiting for asynchronous inferences, are handed
+  /// instead of running on the thread completing the requests. InferMulti()
+  /// waits for such callbacks, so the executor must not run them on the
+  /// thread calling it. Must be set before any request is sent.
+  /// \param executor The executor, empty to run the callbacks directly.
+  void SetCompletionExecutor(Executor executor);
+
+  /// Start collecting the metrics of the inference requests of the client,
+  /// see ClientMetrics. Must be called before any request is sent.
+  /// \param latency_buckets_us The upper bounds of the buckets of the
+  /// latency histogram, in microseconds and increasing order.
+  void EnableMetrics(
+      const std::vector<uint64_t>& latency_buckets_us =
+          ClientMetrics::kDefaultLatencyBucketsUs);
+
+  /// \return The metrics of the client, null unless EnableMetrics() has
+  /// been called.
+  std::shared_ptr<ClientMetrics> Metrics() const { return metrics_; }
+
+  /// Keep the results of ModelMetadata() and ModelConfig() in 'cache', see
+  /// ModelMetadataCache. The calls with query parameters are not cached.
+  /// Must be called before any request is sent.
+  /// \param cache The cache, by default the one shared by the clients of
+  /// the process. Null stops the caching.
+  void SetModelCache(
+      std::shared_ptr<ModelMetadataCache> cache =
+          ModelMetadataCache::Shared())
+  {
+    model_cache_ = std::move(cache);
+  }
+
  protected:
-  // Update the infer stat with the given timer
-  Error UpdateInferStat(const RequestTimers& timer);
+  // Update the infer stat with the given timer of a completed request that
+  // got 'response_count' responses.
+  Error UpdateInferStat(
+      const RequestTimers& timer, const size_t response_count = 1);
+  // Count a lookup in the response cache.
+  void UpdateCacheStat(const bool hit);
+  // Record a completed request to 'model_name' in 'metrics_', if enabled.
+  // 'in_flight' tells whether it was counted as started.
+  void UpdateMetrics(
+      const std::string& model_name, const bool in_flight,
+      const RequestTimers& timer, const bool failed, const size_t bytes_sent,
+      const size_t bytes_received);
+  // Count a request whose compression was chosen by the client, with the
+  // byte size of its inputs and the bytes its compression is estimated to
+  // save, if compressed.
+  void UpdateCompressionStat(
+      const bool compressed, const size_t input_byte_size,
+      const size_t saved_byte_size);
+  // Count the bytes of a completed request and its response, on the wire
+  // and before compression.
+  void UpdateByteStat(
+      const size_t request_byte_size,
+      const size_t uncompressed_request_byte_size,
+      const size_t response_byte_size,
+      const size_t uncompressed_response_byte_size);
+  // Free the 'outstanding_limiter_' slot of an asynchronous request that
+  // completed or failed to be sent.
+  void ReleaseOutstanding();
+  // Invoke 'callback' with the 'result' of an asynchronous request, through
+  // 'completion_executor_' if set.
+  void RunCompletion(OnCompleteFn callback, InferResult* result);
+  // Return a callback that fulfills the future set in 'future'.
+  static OnCompleteFn PromiseCallback(std::future<InferResult*>* future);
   // Enables verbose operation in the client.
   bool verbose_;
 
@@ -149,8 +612,141 @@ class InferenceServerClient {
   // signal for worker thread to stop
   bool exiting_;
 
-  // The inference statistic of the current client
+  // The inference statistic of the current client, updated from the
+  // threads completing requests.
+  mutable std::mutex infer_stat_mutex_;
   InferStat infer_stat_;
+
+  // Caps the asynchronous requests in flight, null without a limit. Set by
+  // the constructor of the client.
+  std::unique_ptr<OutstandingLimiter> outstanding_limiter_;
+
+  // Runs the callbacks of asynchronous requests when set.
+  Executor completion_executor_;
+
+  // The metrics of the requests, null unless enabled.
+  std::shared_ptr<ClientMetrics> metrics_;
+
+  // The cache of the model metadata and configurations, null unless set.
+  std::shared_ptr<ModelMetadataCache> model_cache_;
+};
+
+#ifdef TRITON_CLIENT_HAS_COROUTINES
+//==============================================================================
+/// An InferAwaitable is returned by AsyncInferAwait() of the clients and
+/// lets a C++20 coroutine wait for an asynchronous inference:
+///
+/// \code
+///   InferResult* result;
+///   Error err = co_await client->AsyncInferAwait(&result, options, inputs);
+/// \endcode
+///
+/// The request is sent when the coroutine suspends, and the coroutine is
+/// resumed from the callback of the request, so on the executor set by
+/// InferenceServerClient::SetCompletionExecutor() if any. The result is
+/// only set when the returned error is success, and must then be deleted
+/// by the caller.
+///
+class InferAwaitable {
+ public:
+  using StartFn = std::function<Error(InferenceServerClient::OnCompleteFn)>;
+
+  InferAwaitable(StartFn start, InferResult** result)
+      : start_(std::move(start)), result_(result)
+  {
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    // Once sent, the request may complete and resume the coroutine, which
+    // destroys this object, before 'start' returns.
+    StartFn start = std::move(start_);
+    InferResult** result = result_;
+    Error err = start([result, handle](InferResult* infer_result) {
+      *result = infer_result;
+      handle.resume();
+    });
+    if (!err.IsOk()) {
+      err_ = err;
+      return false;
+    }
+    return true;
+  }
+
+  Error await_resume() const { return err_; }
+
+ private:
+  StartFn start_;
+  InferResult** result_;
+  Error err_;
+};
+#endif  // TRITON_CLIENT_HAS_COROUTINES
+
+//==============================================================================
+/// A PreparedInferRequest holds the parts of an inference request that
+/// don't change from one call to the next, already serialized in the form
+/// sent by the client that prepared it, see PrepareInfer() of
+/// InferenceServerGrpcClient and InferenceServerHttpClient. Set in
+/// InferOptions::prepared_request_, it lets the client skip building the
+/// request from the options, inputs and outputs, and only fill in the
+/// request id and the input data.
+///
+class PreparedInferRequest {
+ public:
+  virtual ~PreparedInferRequest() = default;
+
+ protected:
+  PreparedInferRequest() = default;
+
+  /// Record the inputs the request is prepared for.
+  /// \param inputs The inputs of the request, with their data set.
+  /// \return Error object indicating success or failure.
+  Error RecordInputs(const std::vector<InferInput*>& inputs);
+
+  /// Check that the inputs of a call match the ones recorded. Only the
+  /// number of inputs, where their data is and its byte size are checked.
+  /// \param inputs The inputs of the call.
+  /// \return Error object indicating success or failure.
+  Error CheckInputs(const std::vector<InferInput*>& inputs) const;
+
+ private:
+  // Whether each input is in shared memory, and the byte size of the data
+  // of the others.
+  std::vector<std::pair<bool, size_t>> inputs_;
+};
+
+//==============================================================================
+/// A CompressedInferInputs holds the data of the inputs of a request
+/// already compressed by the client that compressed it, see
+/// CompressInputs() of InferenceServerHttpClient. Set in
+/// InferOptions::compressed_inputs_, it lets the client only compress the
+/// JSON header of a request whose input data is sent again.
+///
+class CompressedInferInputs {
+ public:
+  virtual ~CompressedInferInputs() = default;
+
+ protected:
+  CompressedInferInputs() = default;
+};
+
+//==============================================================================
+/// An AsyncRequestHandle is returned by the AsyncInfer() overloads of
+/// InferenceServerGrpcClient and InferenceServerHttpClient that take one, to
+/// cancel the request while it is in flight.
+///
+class AsyncRequestHandle {
+ public:
+  virtual ~AsyncRequestHandle() = default;
+
+  /// Cancel the request if it has not completed yet. Its callback is still
+  /// invoked, with a result holding an error unless the request completed
+  /// first. A gRPC request is cancelled on the server too, which drops it if
+  /// it has not been executed yet. An HTTP request stops its transfer within
+  /// about a second and closes its connection.
+  virtual void Cancel() = 0;
 };
 
 //==============================================================================
@@ -161,7 +757,8 @@ struct InferOptions {
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
         sequence_end_(false), priority_(0), server_timeout_(0),
-        client_timeout_(0)
+        client_timeout_(0), triton_enable_empty_final_response_(false),
+        prepared_request_(nullptr), compressed_inputs_(nullptr)
   {
   }
   /// The name of the model to run inference.
@@ -217,6 +814,29 @@ struct InferOptions {
   // requests. Instead see 'stream_timeout' argument in
   // InferenceServerGrpcClient::StartStream().
   uint64_t client_timeout_;
+  /// Whether the server should send an empty final response to a request
+  /// of a decoupled model once it has sent all the others, so that the
+  /// client can tell when the request is complete. Only respected by the
+  /// streaming API of the gRPC client.
+  bool triton_enable_empty_final_response_;
+  /// The request prepared by PrepareInfer() of the client running the
+  /// inference. If set, the request sent is the prepared one with
+  /// 'request_id_' as its id. Of the other options only 'client_timeout_'
+  /// and, by the HTTP client, the model name and version are read, and the
+  /// requested outputs only provide their user buffers. The inputs must be
+  /// the ones the request was prepared with, in the same order, and their
+  /// data must keep the byte size it had then. The default value is
+  /// nullptr which means the request is built from the options, inputs and
+  /// outputs.
+  std::shared_ptr<PreparedInferRequest> prepared_request_;
+  /// The input data compressed by CompressInputs() of the HTTP client
+  /// running the inference. If set, the data of the inputs is not read and
+  /// the request is sent with this data, so the request compression
+  /// algorithm of the call must be the one the data was compressed with.
+  /// The data of the inputs must keep the byte size it had then. Ignored by
+  /// the gRPC client. The default value is nullptr which means the input
+  /// data of a compressed request is compressed with the request.
+  std::shared_ptr<CompressedInferInputs> compressed_inputs_;
 };
 
 //==============================================================================
@@ -243,6 +863,12 @@ class InferInput {
   /// \return The datatype of the tensor.
   const std::string& Datatype() const { return datatype_; }
 
+  /// Gets datatype of the associated input tensor, resolved when the input
+  /// is created.
+  /// \return The datatype of the tensor, DataType::INVALID if its name is
+  /// unknown.
+  DataType Type() const { return type_; }
+
   /// Gets the shape of the input tensor.
   /// \return The shape of the tensor.
   const std::vector<int64_t>& Shape() const { return shape_; }
@@ -281,6 +907,91 @@ class InferInput {
   /// \return Error object indicating success or failure.
   Error AppendRaw(const uint8_t* input, size_t input_byte_size);
 
+  /// Append tensor values for this input from a shared buffer. Like
+  /// AppendRaw() the buffer is not copied, but this input holds a
+  /// reference to it until Reset() is called or the input is destroyed,
+  /// and the HTTP requests made with the input hold their own reference
+  /// until their results are released. So the same buffer can back any number
+  /// of inputs and in-flight requests, and is released by its deleter when
+  /// the last of them is done with it. The buffer must not be modified
+  /// while it is referenced.
+  /// \param input The shared pointer to the array holding the tensor
+  /// values, an aliasing or custom deleter shared pointer can be used for
+  /// buffers not allocated by new.
+  /// \param input_byte_size The size of the array in bytes.
+  /// \return Error object indicating success or failure.
+  Error AppendShared(
+      std::shared_ptr<const uint8_t> input, size_t input_byte_size);
+
+  /// Append tensor values for this input from a range of a file, such as
+  /// an encoded image. The range is memory mapped rather than read, so the
+  /// bytes go from the page cache straight to the transport and are never
+  /// copied into a buffer of their own. The mapping is held like a buffer
+  /// given to AppendShared(), so it lives until this input and the requests
+  /// made with it are done with it, and the file must not be truncated
+  /// until then. The values are sent as they are, so a BYTES input must be
+  /// given the serialization AppendFromString() would make. On Windows the
+  /// range is read into a buffer instead.
+  /// \param path The path of the file.
+  /// \param offset The offset in the file of the first byte to append.
+  /// \param byte_size The number of bytes to append, 0 to append up to the
+  /// end of the file.
+  /// \return Error object indicating success or failure.
+  Error AppendFromFile(
+      const std::string& path, size_t offset = 0, size_t byte_size = 0);
+
+  /// Append tensor values for this input from a range of an open file, see
+  /// AppendFromFile(const std::string&, size_t, size_t). The descriptor can
+  /// be closed once this returns. Not supported on Windows.
+  /// \param fd The file descriptor of the file, opened for reading.
+  /// \param offset The offset in the file of the first byte to append.
+  /// \param byte_size The number of bytes to append, 0 to append up to the
+  /// end of the file.
+  /// \return Error object indicating success or failure.
+  Error AppendFromFile(int fd, size_t offset = 0, size_t byte_size = 0);
+
+  /// Append tensor values for this input from a range of the values added
+  /// to another input, such as the samples of a sub-batch. The buffers of
+  /// 'source' are referenced rather than copied: the buffers given to its
+  /// AppendShared() are held by this input too, and the others, including
+  /// the values 'source' holds itself, must stay valid as with AppendRaw().
+  /// \param source The input holding the values, which must not use shared
+  /// memory.
+  /// \param offset The offset in bytes in the values of 'source' of the
+  /// first byte to append.
+  /// \param byte_size The number of bytes to append.
+  /// \return Error object indicating success or failure.
+  Error AppendSlice(const InferInput& source, size_t offset, size_t byte_size);
+
+  /// Append tensor values for this input from an array of the C++ type of
+  /// its datatype, like AppendRaw() the array is not copied. The datatype
+  /// is checked against the type of the array without comparing strings.
+  /// \param values The pointer to the array holding the tensor values.
+  /// \param count The number of values in the array.
+  /// \return Error object indicating success or failure.
+  template <typename T>
+  Error AppendTyped(const T* values, size_t count)
+  {
+    if (type_ != DataTypeOf<T>::value) {
+      return Error(
+          "input '" + name_ + "' has datatype " + datatype_ +
+          ", the values appended are " +
+          DataTypeString(DataTypeOf<T>::value));
+    }
+    return AppendRaw(
+        reinterpret_cast<const uint8_t*>(values), count * sizeof(T));
+  }
+
+  /// Append tensor values for this input from a vector of the C++ type of
+  /// its datatype, see AppendTyped(const T*, size_t).
+  /// \param values The vector holding the tensor values.
+  /// \return Error object indicating success or failure.
+  template <typename T>
+  Error AppendTyped(const std::vector<T>& values)
+  {
+    return AppendTyped(values.data(), values.size());
+  }
+
   /// Set tensor values for this input by reference into a shared memory
   /// region. The values are not copied and so the shared memory region and
   /// its contents must not be modified or destroyed until this input is no
@@ -323,6 +1034,31 @@ class InferInput {
   /// \return Error object indicating success or failure.
   Error AppendFromString(const std::vector<std::string>& input);
 
+  /// Append tensor values for this input from strings held back to back
+  /// in one buffer, as BYTES tensors are often kept by tokenizers. The
+  /// values are copied into this input in one allocation.
+  /// \param data The buffer holding the characters of the strings.
+  /// \param offsets The offset in 'data' of each string, followed by the
+  /// end of the last string, so that string 'i' spans from 'offsets[i]' to
+  /// 'offsets[i + 1]'.
+  /// \return Error object indicating success or failure.
+  Error AppendFromStringBuffer(
+      const char* data, const std::vector<size_t>& offsets);
+
+  /// Append tensor values for this input converted from FP32 values, for
+  /// the inputs with FP32, FP16, BF16 or INT8 datatype. INT8 values are
+  /// quantized as round(value / scale) + zero_point, see the conversions
+  /// of tensor_convert.h. The converted values are held by this input, so
+  /// 'input' does not need to be preserved as with AppendRaw().
+  /// \param input The pointer to the FP32 values.
+  /// \param count The number of values.
+  /// \param scale The quantization scale of INT8 inputs.
+  /// \param zero_point The quantized value of 0 of INT8 inputs.
+  /// \return Error object indicating success or failure.
+  Error AppendFromFloat(
+      const float* input, size_t count, float scale = 1.0f,
+      int32_t zero_point = 0);
+
   /// Gets the size of data added into this input in bytes.
   /// \param byte_size The size of data added in bytes.
   /// \return Error object indicating success or failure.
@@ -332,6 +1068,8 @@ class InferInput {
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
 #endif
+  friend class SharedMemoryRing;
+  friend class ResponseCache;
   InferInput(
       const std::string& name, const std::vector<int64_t>& dims,
       const std::string& datatype);
@@ -344,19 +1082,24 @@ class InferInput {
   std::string name_;
   std::vector<int64_t> shape_;
   std::string datatype_;
+  DataType type_;
   size_t byte_size_;
 
   size_t bufs_idx_, buf_pos_;
   std::vector<const uint8_t*> bufs_;
   std::vector<size_t> buf_byte_sizes_;
 
-  // Used only for STRING type tensors set with SetFromString(). Hold
-  // the "raw" serialization of the string values for each index
-  // that are then referenced by 'bufs_'. A std::list is used to avoid
-  // reallocs that could invalidate the pointer references into the
-  // std::string objects.
+  // Used only for STRING type tensors set with SetFromString() and for the
+  // values converted by AppendFromFloat(). Hold the "raw" serialization of
+  // the values for each index that are then referenced by 'bufs_'. A
+  // std::list is used to avoid reallocs that could invalidate the pointer
+  // references into the std::string objects.
   std::list<std::string> str_bufs_;
 
+  // The references to the buffers set with AppendShared(), their data is
+  // also referenced by 'bufs_'.
+  std::vector<std::shared_ptr<const uint8_t>> shared_bufs_;
+
   // Used only if working with Shared Memory
   enum IOType { NONE, RAW, SHARED_MEMORY };
   IOType io_type_;
@@ -423,6 +1166,34 @@ class InferRequestedOutput {
   Error SharedMemoryInfo(
       std::string* name, size_t* byte_size, size_t* offset) const;
 
+  /// Set the output tensor data to be written to a caller-owned buffer in
+  /// host memory when the response is received. Unlike shared memory, the
+  /// data is still transferred in the response, but the client writes it to
+  /// 'buf' instead of its own storage and InferResult::RawData() returns
+  /// 'buf'. If the output is larger than 'byte_size' it is returned in the
+  /// client's storage as usual. The buffer must stay valid until the result
+  /// of the request is released.
+  /// \param buf The destination buffer.
+  /// \param byte_size The size of the buffer in bytes.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error SetUserBuffer(void* buf, const size_t byte_size);
+
+  /// Clears the buffer set by the last call to
+  /// InferRequestedOutput::SetUserBuffer().
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error UnsetUserBuffer();
+
+  /// \return true if this output is being written to a user buffer.
+  bool IsUserBuffer() const { return (io_type_ == USER_BUFFER); }
+
+  /// Get information about the user buffer being used for this output.
+  /// \param buf Returns the destination buffer.
+  /// \param byte_size Returns the size, in bytes, of the buffer.
+  /// \return Error object indicating success or failure.
+  Error UserBufferInfo(uint8_t** buf, size_t* byte_size) const;
+
  private:
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
@@ -435,11 +1206,15 @@ class InferRequestedOutput {
   size_t class_count_;
 
   // Used only if working with Shared Memory
-  enum IOType { NONE, RAW, SHARED_MEMORY };
+  enum IOType { NONE, RAW, SHARED_MEMORY, USER_BUFFER };
   IOType io_type_;
   std::string shm_name_;
   size_t shm_byte_size_;
   size_t shm_offset_;
+
+  // Used only if working with a user buffer
+  uint8_t* user_buffer_;
+  size_t user_buffer_byte_size_;
 };
 
 //==============================================================================
@@ -479,6 +1254,14 @@ class InferResult {
   virtual Error Datatype(
       const std::string& output_name, std::string* datatype) const = 0;
 
+  /// Get the datatype of output result returned in the response as a
+  /// DataType. The default implementation resolves the string returned by
+  /// Datatype().
+  /// \param output_name The name of the ouput to get datatype.
+  /// \param type Returns the datatype of result for specified output name.
+  /// \return Error object indicating success or failure.
+  virtual Error Type(const std::string& output_name, DataType* type) const;
+
   /// Get access to the buffer holding raw results of specified output
   /// returned by the server. Note the buffer is owned by InferResult
   /// instance. Users can copy out the data if required to extend the
@@ -505,6 +1288,53 @@ class InferResult {
       const std::string& output_name,
       std::vector<std::string>* string_result) const = 0;
 
+  /// Get access to the raw results of specified output as elements of the
+  /// C++ type of its datatype, which is checked without comparing strings.
+  /// Like RawData() the elements are owned by InferResult instance, and
+  /// they must be suitably aligned for T on platforms that require it.
+  /// \param output_name The name of the output to get result data.
+  /// \param data Returns the pointer to the first element.
+  /// \param count Returns the number of elements.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  template <typename T>
+  Error RawDataAs(
+      const std::string& output_name, const T** data, size_t* count) const
+  {
+    DataType type;
+    Error err = Type(output_name, &type);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if (type != DataTypeOf<T>::value) {
+      return Error(
+          "output '" + output_name + "' has datatype " +
+          DataTypeString(type) + ", the elements requested are " +
+          DataTypeString(DataTypeOf<T>::value));
+    }
+    const uint8_t* buf;
+    size_t byte_size;
+    err = RawData(output_name, &buf, &byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    *data = reinterpret_cast<const T*>(buf);
+    *count = byte_size / sizeof(T);
+    return Error::Success;
+  }
+
+  /// Get the elements of the result data of a 'BYTES' output without
+  /// copying them. Each element is returned as the address and the length
+  /// of its characters in the response, which stay valid as long as this
+  /// InferResult instance.
+  /// \param output_name The name of the output to get result data.
+  /// \param string_result Returns the elements in the row-major order.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  virtual Error StringDataRefs(
+      const std::string& output_name,
+      std::vector<std::pair<const char*, size_t>>* string_result) const;
+
   /// Returns the complete response as a user friendly string.
   /// \return The string describing the complete response.
   virtual std::string DebugString() const = 0;
@@ -513,6 +1343,18 @@ class InferResult {
   /// \return Error object indicating the success or failure of the
   /// request.
   virtual Error RequestStatus() const = 0;
+
+  /// Get whether this is the last response of the request. Only a
+  /// decoupled model can send more than one response to a request.
+  /// \param is_final_response Returns true if this is the last response.
+  /// \return Error object indicating success or failure.
+  virtual Error IsFinalResponse(bool* is_final_response) const = 0;
+
+  /// Get whether this response is the empty final response that only marks
+  /// the completion of the request.
+  /// \param is_null_response Returns true if the response is empty.
+  /// \return Error object indicating success or failure.
+  virtual Error IsNullResponse(bool* is_null_response) const = 0;
 };
 
 //==============================================================================
@@ -544,6 +1386,27 @@ class RequestTimers {
     /// byte).
     RECV_END,
 
+    /// The start of building the request from the inputs and options.
+    SERIALIZE_START,
+
+    /// The end of building the request.
+    SERIALIZE_END,
+
+    /// The transport starting to send the body of the request, which may be
+    /// later than SEND_START when the request waits for a connection or for
+    /// the transfer thread.
+    TRANSPORT_START,
+
+    /// The start of parsing the response into the result.
+    DESERIALIZE_START,
+
+    /// The end of parsing the response.
+    DESERIALIZE_END,
+
+    /// The arrival of the first response of a request that may get several
+    /// responses, as on a stream to a decoupled model.
+    FIRST_RESPONSE,
+
     COUNT__
   };
 
@@ -616,6 +1479,10 @@ class InferRequest {
 
   RequestTimers& Timer() { return timer_; }
 
+  // The model of the request, only set when the client collects metrics.
+  const std::string& ModelName() const { return model_name_; }
+  void SetModelName(const std::string& model_name) { model_name_ = model_name; }
+
  protected:
   InferenceServerClient::OnCompleteFn callback_;
   const bool verbose_;
@@ -623,6 +1490,77 @@ class InferRequest {
  private:
   // The timers for infer request.
   RequestTimers timer_;
+  std::string model_name_;
+};
+
+//==============================================================================
+/// A ResponseCache keeps the responses to recent Infer() calls so that a
+/// client can answer a repeated call without sending it, see
+/// 'response_cache_byte_size' in HttpClientOptions and GrpcClientOptions.
+/// Calls are the same when they have the same model, inputs and requested
+/// outputs, the input data being compared by a 64-bit hash. The least
+/// recently used responses are evicted to stay within the byte size, and
+/// responses expire after the time to live.
+///
+class ResponseCache {
+ public:
+  /// \param max_byte_size The total byte size of the cached responses.
+  /// \param ttl_us How long a response stays valid, in microseconds. 0
+  /// means responses don't expire.
+  ResponseCache(const size_t max_byte_size, const uint64_t ttl_us);
+
+  /// Build the key of a call.
+  /// \param options The options of the call.
+  /// \param inputs The inputs of the call.
+  /// \param outputs The requested outputs of the call.
+  /// \param key Returns the key.
+  /// \return Whether the call can be cached. Calls belonging to a sequence
+  /// or using shared memory or user buffers can't.
+  static bool Key(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      std::string* key);
+
+  /// \param key The key of a call.
+  /// \return The cached response of the call, nullptr if there is none.
+  std::shared_ptr<void> Lookup(const std::string& key);
+
+  /// Cache the response of a call.
+  /// \param key The key of the call.
+  /// \param response The response, not modified once cached.
+  /// \param byte_size The byte size of the response.
+  void Insert(
+      const std::string& key, const std::shared_ptr<void>& response,
+      const size_t byte_size);
+
+ private:
+  struct Entry {
+    Entry(
+        const std::string& key, const std::shared_ptr<void>& response,
+        const size_t byte_size,
+        const std::chrono::steady_clock::time_point& expiry)
+        : key_(key), response_(response), byte_size_(byte_size),
+          expiry_(expiry)
+    {
+    }
+
+    std::string key_;
+    std::shared_ptr<void> response_;
+    size_t byte_size_;
+    std::chrono::steady_clock::time_point expiry_;
+  };
+
+  // Remove the entry at 'it', with 'mutex_' held.
+  void Erase(std::list<Entry>::iterator it);
+
+  const size_t max_byte_size_;
+  const std::chrono::microseconds ttl_;
+
+  std::mutex mutex_;
+  // The entries, most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t byte_size_;
 };
 
 
@@ -0,0 +1,239 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "cuda_memory_pool.h"
+
+namespace triton { namespace client {
+
+namespace {
+
+constexpr size_t kBlockAlignment = 256;
+
+// Runs the CUDA calls of a scope on a device, restoring the device of the
+// calling thread afterwards.
+class ScopedDevice {
+ public:
+  explicit ScopedDevice(const int device_id)
+  {
+    cudaGetDevice(&previous_device_);
+    err_ = cudaSetDevice(device_id);
+  }
+  ~ScopedDevice() { cudaSetDevice(previous_device_); }
+
+  cudaError_t Err() const { return err_; }
+
+ private:
+  int previous_device_{0};
+  cudaError_t err_;
+};
+
+Error
+CudaError(const std::string& msg, const cudaError_t err)
+{
+  return Error(msg + ": " + std::string(cudaGetErrorString(err)));
+}
+
+}  // namespace
+
+//==============================================================================
+
+CudaMemoryPool::CudaMemoryPool(
+    const std::string& name, const int device_id, const size_t block_byte_size,
+    const size_t block_count)
+    : name_(name), device_id_(device_id),
+      block_byte_size_(
+          (block_byte_size + kBlockAlignment - 1) / kBlockAlignment *
+          kBlockAlignment),
+      byte_size_(block_byte_size_ * block_count)
+{
+}
+
+CudaMemoryPool::~CudaMemoryPool()
+{
+  ScopedDevice device(device_id_);
+  for (cudaEvent_t event : events_) {
+    cudaEventDestroy(event);
+  }
+  if (base_addr_ != nullptr) {
+    cudaFree(base_addr_);
+  }
+}
+
+Error
+CudaMemoryPool::Create(
+    std::unique_ptr<CudaMemoryPool>* pool, const std::string& name,
+    const int device_id, const size_t block_byte_size,
+    const size_t block_count)
+{
+  if ((block_byte_size == 0) || (block_count == 0)) {
+    return Error(
+        "invalid block size or count for CUDA memory pool '" + name + "'");
+  }
+
+  std::unique_ptr<CudaMemoryPool> new_pool(
+      new CudaMemoryPool(name, device_id, block_byte_size, block_count));
+  ScopedDevice device(device_id);
+  if (device.Err() != cudaSuccess) {
+    return CudaError(
+        "unable to set device " + std::to_string(device_id), device.Err());
+  }
+  cudaError_t err = cudaMalloc(&new_pool->base_addr_, new_pool->byte_size_);
+  if (err != cudaSuccess) {
+    new_pool->base_addr_ = nullptr;
+    return CudaError(
+        "unable to allocate CUDA memory pool '" + name + "'", err);
+  }
+  err = cudaIpcGetMemHandle(&new_pool->ipc_handle_, new_pool->base_addr_);
+  if (err != cudaSuccess) {
+    return CudaError(
+        "unable to get the CUDA IPC handle of CUDA memory pool '" + name +
+            "'",
+        err);
+  }
+  for (size_t i = 0; i < block_count; ++i) {
+    cudaEvent_t event;
+    err = cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+    if (err != cudaSuccess) {
+      return CudaError(
+          "unable to create the events of CUDA memory pool '" + name + "'",
+          err);
+    }
+    new_pool->events_.push_back(event);
+    new_pool->free_blocks_.push_back(i);
+  }
+
+  *pool = std::move(new_pool);
+  return Error::Success;
+}
+
+Error
+CudaMemoryPool::Acquire(Block* block)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ScopedDevice device(device_id_);
+  // The blocks given back first are the most likely to be done
+  for (auto it = free_blocks_.begin(); it != free_blocks_.end(); ++it) {
+    const cudaError_t err = cudaEventQuery(events_[*it]);
+    if (err == cudaErrorNotReady) {
+      continue;
+    }
+    if (err != cudaSuccess) {
+      return CudaError(
+          "unable to query a block of CUDA memory pool '" + name_ + "'", err);
+    }
+    block->index = *it;
+    block->offset = *it * block_byte_size_;
+    block->addr = reinterpret_cast<uint8_t*>(base_addr_) + block->offset;
+    free_blocks_.erase(it);
+    return Error::Success;
+  }
+  return Error("no free block in CUDA memory pool '" + name_ + "'");
+}
+
+Error
+CudaMemoryPool::Release(const Block& block, cudaStream_t stream)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ScopedDevice device(device_id_);
+  const cudaError_t err = cudaEventRecord(events_[block.index], stream);
+  free_blocks_.push_back(block.index);
+  if (err != cudaSuccess) {
+    return CudaError(
+        "unable to record the release of a block of CUDA memory pool '" +
+            name_ + "'",
+        err);
+  }
+  return Error::Success;
+}
+
+//==============================================================================
+
+CudaIpcHandleCache::~CudaIpcHandleCache()
+{
+  for (const auto& opened : opened_) {
+    ScopedDevice device(opened.second.second);
+    cudaIpcCloseMemHandle(opened.second.first);
+  }
+}
+
+CudaIpcHandleCache&
+CudaIpcHandleCache::Instance()
+{
+  static CudaIpcHandleCache cache;
+  return cache;
+}
+
+std::string
+CudaIpcHandleCache::HandleKey(const cudaIpcMemHandle_t& handle)
+{
+  return std::string(
+      reinterpret_cast<const char*>(&handle), sizeof(cudaIpcMemHandle_t));
+}
+
+Error
+CudaIpcHandleCache::Open(
+    const cudaIpcMemHandle_t& handle, const int device_id, void** addr)
+{
+  const std::string key = HandleKey(handle);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = opened_.find(key);
+  if (it != opened_.end()) {
+    *addr = it->second.first;
+    return Error::Success;
+  }
+
+  ScopedDevice device(device_id);
+  if (device.Err() != cudaSuccess) {
+    return CudaError(
+        "unable to set device " + std::to_string(device_id), device.Err());
+  }
+  const cudaError_t err =
+      cudaIpcOpenMemHandle(addr, handle, cudaIpcMemLazyEnablePeerAccess);
+  if (err != cudaSuccess) {
+    return CudaError("unable to open CUDA IPC handle", err);
+  }
+  opened_.emplace(key, std::make_pair(*addr, device_id));
+  return Error::Success;
+}
+
+Error
+CudaIpcHandleCache::Close(const cudaIpcMemHandle_t& handle)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = opened_.find(HandleKey(handle));
+  if (it == opened_.end()) {
+    return Error("CUDA IPC handle is not open");
+  }
+  ScopedDevice device(it->second.second);
+  const cudaError_t err = cudaIpcCloseMemHandle(it->second.first);
+  opened_.erase(it);
+  if (err != cudaSuccess) {
+    return CudaError("unable to close CUDA IPC handle", err);
+  }
+  return Error::Success;
+}
+
+}}  // namespace triton::client
@@ -0,0 +1,192 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A CudaMemoryPool owns one device allocation, exported as a CUDA IPC
+/// handle once and registered with the server once, and recycles
+/// fixed-size blocks of it across requests. A block given back is only
+/// handed out again once the work recorded on it has completed, as tracked
+/// by a CUDA event per block.
+///
+/// \code
+///   std::unique_ptr<CudaMemoryPool> pool;
+///   CudaMemoryPool::Create(&pool, "pool", 0, 1 << 20, 16);
+///   pool->Register(client);
+///   CudaMemoryPool::Block block;
+///   pool->Acquire(&block);
+///   cudaMemcpyAsync(block.addr, data, byte_size, kind, stream);
+///   input->SetSharedMemory(pool->Name(), byte_size, block.offset);
+///   ...
+///   pool->Release(block, stream);
+/// \endcode
+///
+class CudaMemoryPool {
+ public:
+  /// A block of the pool.
+  struct Block {
+    // The index of the block in the pool
+    size_t index{0};
+    // The offset of the block from the start of the allocation
+    size_t offset{0};
+    // The device address of the block
+    void* addr{nullptr};
+  };
+
+  /// Frees the allocation. The pool must be unregistered from the server
+  /// beforehand.
+  ~CudaMemoryPool();
+
+  /// Create a pool and its device allocation.
+  /// \param pool Returns the new pool.
+  /// \param name The name to register the allocation with.
+  /// \param device_id The GPU device to allocate on.
+  /// \param block_byte_size The size in bytes of each block. It is rounded
+  /// up to a multiple of 256 bytes, the alignment of device allocations.
+  /// \param block_count The number of blocks of the pool.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<CudaMemoryPool>* pool, const std::string& name,
+      const int device_id, const size_t block_byte_size,
+      const size_t block_count);
+
+  /// Register the allocation of the pool with the server.
+  /// \param client The InferenceServerHttpClient or
+  /// InferenceServerGrpcClient to register the allocation with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Register(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->RegisterCudaSharedMemory(
+        name_, ipc_handle_, device_id_, byte_size_, headers);
+  }
+
+  /// Unregister the allocation of the pool from the server.
+  /// \param client The client the allocation was registered with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Unregister(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->UnregisterCudaSharedMemory(name_, headers);
+  }
+
+  /// Take a free block whose earlier work has completed. Does not wait when
+  /// there is none.
+  /// \param block Returns the block.
+  /// \return Error object indicating success or failure.
+  Error Acquire(Block* block);
+
+  /// Give a block back to the pool. It is handed out again once the work
+  /// submitted to 'stream' so far has completed.
+  /// \param block The block returned by Acquire().
+  /// \param stream The stream of the last work using the block.
+  /// \return Error object indicating success or failure.
+  Error Release(const Block& block, cudaStream_t stream = 0);
+
+  /// \return The name the allocation is registered with.
+  const std::string& Name() const { return name_; }
+
+  /// \return The CUDA IPC handle of the allocation, exported once.
+  const cudaIpcMemHandle_t& IpcHandle() const { return ipc_handle_; }
+
+  /// \return The size in bytes of each block.
+  size_t BlockByteSize() const { return block_byte_size_; }
+
+ private:
+  CudaMemoryPool(
+      const std::string& name, const int device_id,
+      const size_t block_byte_size, const size_t block_count);
+
+  const std::string name_;
+  const int device_id_;
+  const size_t block_byte_size_;
+  const size_t byte_size_;
+  void* base_addr_{nullptr};
+  cudaIpcMemHandle_t ipc_handle_;
+
+  std::mutex mutex_;
+  // The event recorded when each block was given back
+  std::vector<cudaEvent_t> events_;
+  // The blocks given back, oldest first
+  std::vector<size_t> free_blocks_;
+};
+
+//==============================================================================
+/// A CudaIpcHandleCache opens each CUDA IPC handle it is given once per
+/// process and keeps it open, so that the processes using the allocations
+/// of another process do not pay for opening a handle per request.
+///
+class CudaIpcHandleCache {
+ public:
+  /// Closes all the handles opened.
+  ~CudaIpcHandleCache();
+
+  /// \return The cache shared by the whole process.
+  static CudaIpcHandleCache& Instance();
+
+  /// Get the address of an allocation of another process, opening its
+  /// handle the first time.
+  /// \param handle The CUDA IPC handle of the allocation.
+  /// \param device_id The GPU device of the allocation.
+  /// \param addr Returns the device address of the allocation in this
+  /// process.
+  /// \return Error object indicating success or failure.
+  Error Open(
+      const cudaIpcMemHandle_t& handle, const int device_id, void** addr);
+
+  /// Close a handle opened by Open(), once the allocation is no longer
+  /// used by this process.
+  /// \param handle The CUDA IPC handle of the allocation.
+  /// \return Error object indicating success or failure.
+  Error Close(const cudaIpcMemHandle_t& handle);
+
+ private:
+  static std::string HandleKey(const cudaIpcMemHandle_t& handle);
+
+  std::mutex mutex_;
+  // The opened addresses and their device, by handle bytes
+  std::map<std::string, std::pair<void*, int>> opened_;
+};
+
+}}  // namespace triton::client
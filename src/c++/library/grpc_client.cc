@@ -28,13 +28,22 @@
 #define TRITON_INFERENCE_SERVER_CLIENT_CLASS InferenceServerGrpcClient
 #include "common.h"
 
+#include <grpc/grpc_security.h>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <future>
+#include <map>
 #include <iostream>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 #include "grpc_client.h"
 
 namespace triton { namespace client {
@@ -75,11 +84,66 @@ ReadFile(const std::string& filename, std::string& data)
   }
 }
 
+// The number of TLS sessions kept for resumption by the SSL channels
+constexpr size_t kSslSessionCacheSize = 64;
+
+std::shared_ptr<grpc::Channel>
+CreateChannel(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const grpc::ChannelArguments& channel_args)
+{
+  // Start with a copy of channel_args param, then modify our copy as needed.
+  grpc::ChannelArguments arguments(channel_args);
+
+  static std::atomic<int> channel_count{0};
+  // Explicitly avoid channel re-use
+  // "channels must have different channel args to prevent re-use
+  // so define a use-specific channel arg such as channel number"
+  // https://grpc.io/docs/guides/performance/
+  // NOTE: The argument name "triton_client_channel_idx" is arbitrary.
+  arguments.SetInt("triton_client_channel_idx", channel_count.fetch_add(1));
+  std::shared_ptr<grpc::ChannelCredentials> credentials;
+  if (use_ssl) {
+    // The channels with the same certificates share their credentials, so
+    // the files are read and the TLS context is built once, and all the SSL
+    // channels resume their TLS sessions from one cache, so a new channel
+    // to a known server skips the full handshake. Both live for the process.
+    static std::mutex ssl_mtx;
+    static std::map<
+        std::tuple<std::string, std::string, std::string>,
+        std::shared_ptr<grpc::ChannelCredentials>>
+        ssl_credentials;
+    static grpc_ssl_session_cache* ssl_session_cache =
+        grpc_ssl_session_cache_create_lru(kSslSessionCacheSize);
+    {
+      std::lock_guard<std::mutex> lock(ssl_mtx);
+      auto& cached = ssl_credentials[std::make_tuple(
+          ssl_options.root_certificates, ssl_options.private_key,
+          ssl_options.certificate_chain)];
+      if (cached == nullptr) {
+        std::string root;
+        std::string key;
+        std::string cert;
+        ReadFile(ssl_options.root_certificates, root);
+        ReadFile(ssl_options.private_key, key);
+        ReadFile(ssl_options.certificate_chain, cert);
+        grpc::SslCredentialsOptions opts = {root, key, cert};
+        cached = grpc::SslCredentials(opts);
+      }
+      credentials = cached;
+    }
+    arguments.SetPointer(GRPC_SSL_SESSION_CACHE_ARG, ssl_session_cache);
+  } else {
+    credentials = grpc::InsecureChannelCredentials();
+  }
+  return grpc::CreateCustomChannel(url, credentials, arguments);
+}
+
 std::shared_ptr<inference::GRPCInferenceService::Stub>
 GetStub(
     const std::string& url, bool use_ssl, const SslOptions& ssl_options,
     const grpc::ChannelArguments& channel_args, const bool use_cached_channel,
-    bool verbose)
+    bool verbose, std::shared_ptr<grpc::Channel>* stub_channel = nullptr)
 {
   std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
 
@@ -98,6 +162,9 @@ GetStub(
     const auto& shared_count = std::get<0>(channel_itr->second);
     if (shared_count % max_share_count != 0) {
       std::get<0>(channel_itr->second)++;
+      if (stub_channel != nullptr) {
+        *stub_channel = std::get<1>(channel_itr->second);
+      }
       return std::get<2>(channel_itr->second);
     }
   }
@@ -106,31 +173,8 @@ GetStub(
     std::cout << "Creating new channel with url:" << url << std::endl;
   }
 
-  // Start with a copy of channel_args param, then modify our copy as needed.
-  grpc::ChannelArguments arguments(channel_args);
-
-  static std::atomic<int> channel_count{0};
-  // Explicitly avoid channel re-use
-  // "channels must have different channel args to prevent re-use
-  // so define a use-specific channel arg such as channel number"
-  // https://grpc.io/docs/guides/performance/
-  // NOTE: The argument name "triton_client_channel_idx" is arbitrary.
-  arguments.SetInt("triton_client_channel_idx", channel_count.fetch_add(1));
-  std::shared_ptr<grpc::ChannelCredentials> credentials;
-  if (use_ssl) {
-    std::string root;
-    std::string key;
-    std::string cert;
-    ReadFile(ssl_options.root_certificates, root);
-    ReadFile(ssl_options.private_key, key);
-    ReadFile(ssl_options.certificate_chain, cert);
-    grpc::SslCredentialsOptions opts = {root, key, cert};
-    credentials = grpc::SslCredentials(opts);
-  } else {
-    credentials = grpc::InsecureChannelCredentials();
-  }
   std::shared_ptr<grpc::Channel> channel =
-      grpc::CreateCustomChannel(url, credentials, arguments);
+      CreateChannel(url, use_ssl, ssl_options, channel_args);
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
       inference::GRPCInferenceService::NewStub(channel);
   // Replace if channel / stub have been in the map
@@ -140,14 +184,130 @@ GetStub(
     grpc_channel_stub_map_.insert(
         std::make_pair(url, std::make_tuple(1, channel, stub)));
   }
+  if (stub_channel != nullptr) {
+    *stub_channel = channel;
+  }
 
   return stub;
 }
 }  // namespace
 
+//==============================================================================
+// The user buffers of the requested outputs, see
+// InferRequestedOutput::SetUserBuffer().
+using UserBufferMap = std::map<std::string, std::pair<uint8_t*, size_t>>;
+
+void
+CollectUserBuffers(
+    const std::vector<const InferRequestedOutput*>& outputs,
+    UserBufferMap* user_buffers)
+{
+  for (const auto output : outputs) {
+    if (output->IsUserBuffer()) {
+      uint8_t* buf;
+      size_t byte_size;
+      output->UserBufferInfo(&buf, &byte_size);
+      user_buffers->emplace(output->Name(), std::make_pair(buf, byte_size));
+    }
+  }
+}
+
+//==============================================================================
+// A GrpcArenaInferRequest is a ModelInferRequest allocated on its own
+// protobuf arena. The message is reused across requests so the submessages
+// and the raw input content strings keep their allocations, and the arena is
+// only reset once the space it accumulated exceeds 'kMaxArenaSpaceUsed'.
+//
+class GrpcArenaInferRequest {
+ public:
+  GrpcArenaInferRequest() { Reset(); }
+
+  inference::ModelInferRequest* Request() { return request_; }
+
+  // The id of the prepared request the message was last filled from, 0 if
+  // none.
+  uint64_t* PreparedId() { return &prepared_id_; }
+
+  // Reset the arena if it has grown too large since the last reset.
+  void Recycle()
+  {
+    if (arena_.SpaceUsed() > kMaxArenaSpaceUsed) {
+      Reset();
+    }
+  }
+
+ private:
+  void Reset()
+  {
+    arena_.Reset();
+    request_ =
+        google::protobuf::Arena::CreateMessage<inference::ModelInferRequest>(
+            &arena_);
+    prepared_id_ = 0;
+  }
+
+  static constexpr uint64_t kMaxArenaSpaceUsed = 1 << 20;
+
+  google::protobuf::Arena arena_;
+  // Owned by 'arena_'.
+  inference::ModelInferRequest* request_;
+  uint64_t prepared_id_;
+};
+
+//==============================================================================
+// A GrpcPreparedInferRequest holds a request message with everything but the
+// id and the raw input contents set. A message reused for several calls with
+// the same prepared request only has those two filled in again, the message
+// records the 'id_' of the prepared request it was last copied from.
+//
+class GrpcPreparedInferRequest : public PreparedInferRequest {
+ public:
+  GrpcPreparedInferRequest() : id_(next_id_++), fixed_byte_size_(0) {}
+
+  friend InferenceServerGrpcClient;
+
+ private:
+  static std::atomic<uint64_t> next_id_;
+
+  const uint64_t id_;
+  inference::ModelInferRequest request_;
+  // The serialized byte size of 'request_'.
+  size_t fixed_byte_size_;
+};
+
+std::atomic<uint64_t> GrpcPreparedInferRequest::next_id_(1);
+
 //==============================================================================
 // An GrpcInferRequest represents an inflght inference request on gRPC.
 //
+// The state shared by an asynchronous request and its handle, see
+// AsyncRequestHandle. 'context_' is null once the request has completed.
+struct GrpcCancelState {
+  std::mutex mu_;
+  grpc::ClientContext* context_{nullptr};
+};
+
+class GrpcAsyncRequestHandle : public AsyncRequestHandle {
+ public:
+  explicit GrpcAsyncRequestHandle(const std::shared_ptr<GrpcCancelState>& state)
+      : state_(state)
+  {
+  }
+
+  void Cancel() override
+  {
+    std::lock_guard<std::mutex> lock(state_->mu_);
+    if (state_->context_ != nullptr) {
+      // The call completes with a CANCELLED status, and the cancellation is
+      // sent to the server.
+      state_->context_->TryCancel();
+    }
+  }
+
+ private:
+  std::shared_ptr<GrpcCancelState> state_;
+};
+
 class GrpcInferRequest : public InferRequest {
  public:
   GrpcInferRequest(InferenceServerClient::OnCompleteFn callback = nullptr)
@@ -156,6 +316,14 @@ class GrpcInferRequest : public InferRequest {
   {
   }
 
+  ~GrpcInferRequest()
+  {
+    if (cancel_state_ != nullptr) {
+      std::lock_guard<std::mutex> lock(cancel_state_->mu_);
+      cancel_state_->context_ = nullptr;
+    }
+  }
+
   friend InferenceServerGrpcClient;
 
  private:
@@ -163,8 +331,352 @@ class GrpcInferRequest : public InferRequest {
   grpc::ClientContext grpc_context_;
   grpc::Status grpc_status_;
   std::shared_ptr<inference::ModelInferResponse> grpc_response_;
+  // The request message of an asynchronous request, must be kept alive until
+  // the call completes.
+  std::unique_ptr<GrpcArenaInferRequest> arena_request_;
+  UserBufferMap user_buffers_;
+  // The response of a request sent on the generic stub, parsed into
+  // 'grpc_response_' once the call completes, and the shared buffers of the
+  // inputs that the request references until then.
+  std::unique_ptr<grpc::ByteBuffer> response_buffer_;
+  std::vector<std::shared_ptr<const uint8_t>> input_refs_;
+  // The byte size of the request sent.
+  size_t request_byte_size_{0};
+  // The channel of the pool of the client running the request.
+  size_t channel_index_{0};
+  // Shared with the handle of the request, if it has one.
+  std::shared_ptr<GrpcCancelState> cancel_state_;
+};
+
+//==============================================================================
+// A GrpcChannelPool owns a fixed number of channels to one server, each with
+// its own HTTP/2 connection, and picks one of them for every inference RPC.
+// A channel found in TRANSIENT_FAILURE when picked is replaced by a new
+// channel, at most once per 'kMinReplaceInterval'.
+//
+class GrpcChannelPool {
+ public:
+  GrpcChannelPool(
+      const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+      const grpc::ChannelArguments& channel_args, const size_t channel_count,
+      const GrpcClientOptions::ChannelSelection selection, bool verbose)
+      : url_(url), use_ssl_(use_ssl), ssl_options_(ssl_options),
+        channel_args_(channel_args), selection_(selection), verbose_(verbose),
+        next_channel_(0)
+  {
+    for (size_t i = 0; i < channel_count; ++i) {
+      slots_.emplace_back(new Slot());
+      Connect(slots_.back().get());
+    }
+  }
+
+  // Pick a channel for an RPC and count the RPC as outstanding on it.
+  // Returns the stub of the channel and sets 'channel_index' to the channel
+  // to release once the RPC completes.
+  std::shared_ptr<inference::GRPCInferenceService::Stub> Acquire(
+      size_t* channel_index)
+  {
+    size_t index = next_channel_.fetch_add(1, std::memory_order_relaxed) %
+                   slots_.size();
+    if (selection_ ==
+        GrpcClientOptions::ChannelSelection::LEAST_OUTSTANDING) {
+      for (size_t i = 1; i < slots_.size(); ++i) {
+        const size_t candidate = (index + i) % slots_.size();
+        if (slots_[candidate]->outstanding_.load(std::memory_order_relaxed) <
+            slots_[index]->outstanding_.load(std::memory_order_relaxed)) {
+          index = candidate;
+        }
+      }
+    }
+
+    Slot* slot = slots_[index].get();
+    slot->outstanding_.fetch_add(1, std::memory_order_relaxed);
+    *channel_index = index;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((slot->channel_->GetState(false /* try_to_connect */) ==
+         GRPC_CHANNEL_TRANSIENT_FAILURE) &&
+        (std::chrono::steady_clock::now() - slot->connect_time_ >=
+         kMinReplaceInterval)) {
+      if (verbose_) {
+        std::cout << "Replacing failed channel " << index << " with url:"
+                  << url_ << std::endl;
+      }
+      Connect(slot);
+    }
+    return slot->stub_;
+  }
+
+  void Release(const size_t channel_index)
+  {
+    slots_[channel_index]->outstanding_.fetch_sub(
+        1, std::memory_order_relaxed);
+  }
+
+  std::shared_ptr<grpc::GenericStub> GenericStub(const size_t channel_index)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_[channel_index]->generic_stub_;
+  }
+
+  // The channels of the pool, in order.
+  std::vector<std::shared_ptr<grpc::Channel>> Channels()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<grpc::Channel>> channels;
+    for (const auto& slot : slots_) {
+      channels.push_back(slot->channel_);
+    }
+    return channels;
+  }
+
+  // The stub of the first channel, for the RPCs other than inferences.
+  std::shared_ptr<inference::GRPCInferenceService::Stub> DefaultStub()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_[0]->stub_;
+  }
+
+ private:
+  struct Slot {
+    Slot() : outstanding_(0) {}
+
+    std::shared_ptr<grpc::Channel> channel_;
+    std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
+    std::shared_ptr<grpc::GenericStub> generic_stub_;
+    std::chrono::steady_clock::time_point connect_time_;
+    std::atomic<size_t> outstanding_;
+  };
+
+  void Connect(Slot* slot)
+  {
+    slot->channel_ = CreateChannel(url_, use_ssl_, ssl_options_, channel_args_);
+    slot->stub_ = inference::GRPCInferenceService::NewStub(slot->channel_);
+    slot->generic_stub_ = std::make_shared<grpc::GenericStub>(slot->channel_);
+    slot->connect_time_ = std::chrono::steady_clock::now();
+  }
+
+  static constexpr std::chrono::seconds kMinReplaceInterval{1};
+
+  const std::string url_;
+  const bool use_ssl_;
+  const SslOptions ssl_options_;
+  const grpc::ChannelArguments channel_args_;
+  const GrpcClientOptions::ChannelSelection selection_;
+  const bool verbose_;
+  std::atomic<size_t> next_channel_;
+  // Protects the channels and stubs of the slots, which are replaced when
+  // their channel fails. RPCs in progress keep their stub alive.
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Slot>> slots_;
+};
+
+constexpr std::chrono::seconds GrpcChannelPool::kMinReplaceInterval;
+
+//==============================================================================
+// A StreamResponsePool recycles the response messages read from a stream.
+// A message is handed out in a shared_ptr whose deleter clears it and gives
+// it back once the result holding it is released, so that the following
+// reads parse into messages that keep the allocations of earlier responses.
+// The deleters share ownership of the pool, so results may outlive the
+// stream and the client.
+//
+class StreamResponsePool
+    : public std::enable_shared_from_this<StreamResponsePool> {
+ public:
+  std::shared_ptr<inference::ModelStreamInferResponse> Acquire()
+  {
+    inference::ModelStreamInferResponse* response = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_.empty()) {
+        response = free_.back().release();
+        free_.pop_back();
+      }
+    }
+    if (response == nullptr) {
+      response = new inference::ModelStreamInferResponse();
+    }
+    std::shared_ptr<StreamResponsePool> pool = shared_from_this();
+    return std::shared_ptr<inference::ModelStreamInferResponse>(
+        response, [pool](inference::ModelStreamInferResponse* response) {
+          pool->Release(response);
+        });
+  }
+
+ private:
+  void Release(inference::ModelStreamInferResponse* response)
+  {
+    // Messages that grew large are not kept, so that one large response
+    // doesn't pin its memory for the life of the stream.
+    size_t byte_size = 0;
+    for (const auto& content :
+         response->infer_response().raw_output_contents()) {
+      byte_size += content.capacity();
+    }
+    std::unique_ptr<inference::ModelStreamInferResponse> owned(response);
+    if (byte_size > kMaxPooledResponseByteSize) {
+      return;
+    }
+    owned->Clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() < kMaxPooledResponses) {
+      free_.emplace_back(std::move(owned));
+    }
+  }
+
+  static constexpr size_t kMaxPooledResponses = 64;
+  static constexpr size_t kMaxPooledResponseByteSize = 1 << 20;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<inference::ModelStreamInferResponse>> free_;
+};
+
+//==============================================================================
+// The timer of a request sent on a stream and the number of responses
+// received for it so far.
+//
+struct StreamRequestTimer {
+  explicit StreamRequestTimer(std::unique_ptr<RequestTimers>&& t)
+      : timer(std::move(t)), response_count(0)
+  {
+  }
+
+  std::unique_ptr<RequestTimers> timer;
+  size_t response_count;
+};
+
+//==============================================================================
+// A GrpcStream is one bi-directional stream of a client, the thread
+// reading its responses and the thread writing its requests. Requests are
+// queued by AsyncStreamInfer() and the writer sends all the queued requests
+// at once, hinting gRPC to buffer all but the last one so that they are
+// coalesced into as few writes to the socket as possible.
+//
+class GrpcStream {
+ public:
+  friend InferenceServerGrpcClient;
+
+ private:
+  grpc::ClientContext grpc_context_;
+  std::shared_ptr<grpc::ClientReaderWriter<
+      inference::ModelInferRequest, inference::ModelStreamInferResponse>>
+      grpc_stream_;
+  std::thread worker_;
+  std::thread writer_;
+  std::shared_ptr<StreamResponsePool> response_pool_;
+  // The channel of the pool of the client the stream runs on.
+  size_t channel_index_{0};
+  // Protects the write queue and the flags below.
+  std::mutex write_mutex_;
+  std::condition_variable write_cv_;
+  std::deque<std::unique_ptr<GrpcArenaInferRequest>> write_queue_;
+  // Set by StopStream() once no more requests will be queued.
+  bool writes_done_{false};
+  // Set by the writer when the stream refused a write.
+  bool closed_{false};
+  // The timers of the requests waiting for their responses. Requests with
+  // an id are matched to their responses by id, which holds for decoupled
+  // models sending any number of responses per request. Requests without
+  // an id are assumed to get exactly one response each, in send order.
+  std::mutex timers_mutex_;
+  std::unordered_map<std::string, StreamRequestTimer> request_timers_by_id_;
+  std::queue<std::unique_ptr<RequestTimers>> ongoing_request_timers_;
+};
+
+//==============================================================================
+// A GrpcResponseBuffer holds a received ModelInferResponse as one slice and
+// the views of its 'raw_output_contents' into it, by output index.
+struct GrpcResponseBuffer {
+  grpc::Slice slice_;
+  std::vector<std::pair<const uint8_t*, size_t>> raw_outputs_;
 };
 
+// Parse the response in 'buffer' into 'response', except for its
+// 'raw_output_contents' which are left in 'aliased' as views into the
+// received bytes.
+grpc::Status
+ParseAliasedResponse(
+    grpc::ByteBuffer* buffer, inference::ModelInferResponse* response,
+    GrpcResponseBuffer* aliased)
+{
+  if (!buffer->TrySingleSlice(&aliased->slice_).ok()) {
+    grpc::Status status = buffer->DumpToSingleSlice(&aliased->slice_);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  buffer->Clear();
+
+  // Walk the fields of the message, the other fields are gathered to be
+  // parsed by protobuf.
+  const uint8_t* pos = aliased->slice_.begin();
+  const uint8_t* const end = aliased->slice_.end();
+  auto read_varint = [&pos, end](uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; (shift < 64) && (pos < end); shift += 7) {
+      const uint8_t byte = *pos++;
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+  const grpc::Status malformed(
+      grpc::StatusCode::INTERNAL, "Failed to parse the inference response");
+  std::string fields;
+  while (pos < end) {
+    const uint8_t* const field_start = pos;
+    uint64_t tag;
+    uint64_t value;
+    if (!read_varint(&tag)) {
+      return malformed;
+    }
+    switch (tag & 0x7) {
+      case 0:
+        if (!read_varint(&value)) {
+          return malformed;
+        }
+        break;
+      case 1:
+        if ((end - pos) < 8) {
+          return malformed;
+        }
+        pos += 8;
+        break;
+      case 2:
+        if (!read_varint(&value) ||
+            (value > static_cast<uint64_t>(end - pos))) {
+          return malformed;
+        }
+        if ((tag >> 3) == static_cast<uint64_t>(
+                              inference::ModelInferResponse::
+                                  kRawOutputContentsFieldNumber)) {
+          aliased->raw_outputs_.emplace_back(pos, value);
+          pos += value;
+          continue;
+        }
+        pos += value;
+        break;
+      case 5:
+        if ((end - pos) < 4) {
+          return malformed;
+        }
+        pos += 4;
+        break;
+      default:
+        return malformed;
+    }
+    fields.append(
+        reinterpret_cast<const char*>(field_start), pos - field_start);
+  }
+  if (!response->ParseFromString(fields)) {
+    return malformed;
+  }
+  return grpc::Status::OK;
+}
+
 //==============================================================================
 
 class InferResultGrpc : public InferResult {
@@ -172,7 +684,8 @@ class InferResultGrpc : public InferResult {
   static Error Create(
       InferResult** infer_result,
       std::shared_ptr<inference::ModelInferResponse> response,
-      Error& request_status);
+      Error& request_status, const UserBufferMap* user_buffers = nullptr,
+      std::shared_ptr<GrpcResponseBuffer> aliased_outputs = nullptr);
   static Error Create(
       InferResult** infer_result,
       std::shared_ptr<inference::ModelStreamInferResponse> response);
@@ -185,28 +698,46 @@ class InferResultGrpc : public InferResult {
       const override;
   Error Datatype(
       const std::string& output_name, std::string* datatype) const override;
+  Error Type(const std::string& output_name, DataType* type) const override;
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
   Error StringData(
       const std::string& output_name,
       std::vector<std::string>* string_result) const override;
+  Error StringDataRefs(
+      const std::string& output_name,
+      std::vector<std::pair<const char*, size_t>>* string_result)
+      const override;
   std::string DebugString() const override { return response_->DebugString(); }
+  Error IsFinalResponse(bool* is_final_response) const override;
+  Error IsNullResponse(bool* is_null_response) const override;
 
  private:
   InferResultGrpc(
       std::shared_ptr<inference::ModelInferResponse> response,
-      Error& request_status);
+      Error& request_status, const UserBufferMap* user_buffers,
+      std::shared_ptr<GrpcResponseBuffer> aliased_outputs);
   InferResultGrpc(
       std::shared_ptr<inference::ModelStreamInferResponse> response);
 
-  std::map<std::string, const inference::ModelInferResponse::InferOutputTensor*>
-      output_name_to_tensor_map_;
-  std::map<std::string, std::pair<const uint8_t*, const uint32_t>>
-      output_name_to_buffer_map_;
+  // Return the index of the output named 'output_name' in the response,
+  // or -1 if the response doesn't have it. A model has few outputs, so a
+  // linear scan finds them faster than building maps keyed by copies of
+  // their names for every response.
+  int FindOutput(const std::string& output_name) const;
+  // The data received for the output at 'index', false if there is none.
+  bool RawOutput(int index, const uint8_t** buf, size_t* byte_size) const;
+
+  // The user buffers the outputs were copied to, by output index, empty
+  // unless the request has user buffers.
+  std::vector<const uint8_t*> user_buffer_outputs_;
 
   std::shared_ptr<inference::ModelInferResponse> response_;
   std::shared_ptr<inference::ModelStreamInferResponse> stream_response_;
+  // The received response the output data points into, if the outputs are
+  // not copied into 'response_'.
+  std::shared_ptr<GrpcResponseBuffer> aliased_outputs_;
   Error request_status_;
 };
 
@@ -214,10 +745,11 @@ Error
 InferResultGrpc::Create(
     InferResult** infer_result,
     std::shared_ptr<inference::ModelInferResponse> response,
-    Error& request_status)
+    Error& request_status, const UserBufferMap* user_buffers,
+    std::shared_ptr<GrpcResponseBuffer> aliased_outputs)
 {
-  *infer_result = reinterpret_cast<InferResult*>(
-      new InferResultGrpc(response, request_status));
+  *infer_result = reinterpret_cast<InferResult*>(new InferResultGrpc(
+      response, request_status, user_buffers, aliased_outputs));
   return Error::Success;
 }
 
@@ -257,14 +789,44 @@ InferResultGrpc::Id(std::string* id) const
   return Error::Success;
 }
 
+Error
+InferResultGrpc::IsFinalResponse(bool* is_final_response) const
+{
+  // Responses without the parameter come from a server that was not asked
+  // for the final response, so each of them completes its request
+  const auto& parameters = response_->parameters();
+  const auto it = parameters.find("triton_final_response");
+  *is_final_response = (it == parameters.end()) || it->second.bool_param();
+  return Error::Success;
+}
+
+Error
+InferResultGrpc::IsNullResponse(bool* is_null_response) const
+{
+  *is_null_response = response_->outputs().empty();
+  return Error::Success;
+}
+
+int
+InferResultGrpc::FindOutput(const std::string& output_name) const
+{
+  const auto& outputs = response_->outputs();
+  for (int i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].name() == output_name) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 Error
 InferResultGrpc::Shape(
     const std::string& output_name, std::vector<int64_t>* shape) const
 {
   shape->clear();
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    for (const auto dim : it->second->shape()) {
+  const int index = FindOutput(output_name);
+  if (index != -1) {
+    for (const auto dim : response_->outputs(index).shape()) {
       shape->push_back(dim);
     }
   } else {
@@ -279,9 +841,23 @@ Error
 InferResultGrpc::Datatype(
     const std::string& output_name, std::string* datatype) const
 {
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    *datatype = it->second->datatype();
+  const int index = FindOutput(output_name);
+  if (index != -1) {
+    *datatype = response_->outputs(index).datatype();
+  } else {
+    return Error(
+        "The response does not contain datatype for output name '" +
+        output_name + "'");
+  }
+  return Error::Success;
+}
+
+Error
+InferResultGrpc::Type(const std::string& output_name, DataType* type) const
+{
+  const int index = FindOutput(output_name);
+  if (index != -1) {
+    *type = StringToDataType(response_->outputs(index).datatype());
   } else {
     return Error(
         "The response does not contain datatype for output name '" +
@@ -296,10 +872,12 @@ InferResultGrpc::RawData(
     const std::string& output_name, const uint8_t** buf,
     size_t* byte_size) const
 {
-  auto it = output_name_to_buffer_map_.find(output_name);
-  if (it != output_name_to_buffer_map_.end()) {
-    *buf = it->second.first;
-    *byte_size = it->second.second;
+  const int index = FindOutput(output_name);
+  if ((index != -1) && RawOutput(index, buf, byte_size)) {
+    if ((index < static_cast<int>(user_buffer_outputs_.size())) &&
+        (user_buffer_outputs_[index] != nullptr)) {
+      *buf = user_buffer_outputs_[index];
+    }
   } else {
     return Error(
         "The response does not contain results for output name '" +
@@ -309,62 +887,103 @@ InferResultGrpc::RawData(
   return Error::Success;
 }
 
+bool
+InferResultGrpc::RawOutput(
+    int index, const uint8_t** buf, size_t* byte_size) const
+{
+  if (aliased_outputs_ != nullptr) {
+    if (index >= static_cast<int>(aliased_outputs_->raw_outputs_.size())) {
+      return false;
+    }
+    *buf = aliased_outputs_->raw_outputs_[index].first;
+    *byte_size = aliased_outputs_->raw_outputs_[index].second;
+    return true;
+  }
+  if (index >= response_->raw_output_contents_size()) {
+    return false;
+  }
+  const std::string& contents = response_->raw_output_contents(index);
+  *buf = reinterpret_cast<const uint8_t*>(contents.data());
+  *byte_size = contents.size();
+  return true;
+}
+
 Error
 InferResultGrpc::StringData(
     const std::string& output_name,
     std::vector<std::string>* string_result) const
 {
-  std::string datatype;
-  Error err = Datatype(output_name, &datatype);
+  std::vector<std::pair<const char*, size_t>> elements;
+  Error err = StringDataRefs(output_name, &elements);
   if (!err.IsOk()) {
     return err;
   }
-  if (datatype.compare("BYTES") != 0) {
-    return Error(
-        "This function supports tensors with datatype 'BYTES', requested "
-        "output tensor '" +
-        output_name + "' with datatype '" + datatype + "'");
+  string_result->clear();
+  string_result->reserve(elements.size());
+  for (const auto& element : elements) {
+    string_result->emplace_back(element.first, element.second);
   }
 
-  const uint8_t* buf;
-  size_t byte_size;
-  err = RawData(output_name, &buf, &byte_size);
-  string_result->clear();
-  if (byte_size != 0) {
-    size_t buf_offset = 0;
-    while (byte_size > buf_offset) {
-      const uint32_t element_size =
-          *(reinterpret_cast<const uint32_t*>(buf + buf_offset));
-      string_result->emplace_back(
-          reinterpret_cast<const char*>(
-              buf + buf_offset + sizeof(element_size)),
-          element_size);
-      buf_offset += (sizeof(element_size) + element_size);
-    }
-  } else {
-    auto it = output_name_to_tensor_map_.find(output_name);
-    for (const auto& element : it->second->contents().bytes_contents()) {
-      string_result->push_back(element);
+  return Error::Success;
+}
+
+Error
+InferResultGrpc::StringDataRefs(
+    const std::string& output_name,
+    std::vector<std::pair<const char*, size_t>>* string_result) const
+{
+  // The elements may be sent in the tensor contents instead of the raw
+  // output contents
+  const int index = FindOutput(output_name);
+  if (index != -1) {
+    const auto& output = response_->outputs(index);
+    const auto& contents = output.contents();
+    if (contents.bytes_contents_size() != 0) {
+      const std::string& datatype = output.datatype();
+      if (StringToDataType(datatype) != DataType::BYTES) {
+        return Error(
+            "This function supports tensors with datatype 'BYTES', requested "
+            "output tensor '" +
+            output_name + "' with datatype '" + datatype + "'");
+      }
+      string_result->clear();
+      string_result->reserve(contents.bytes_contents_size());
+      for (const auto& element : contents.bytes_contents()) {
+        string_result->emplace_back(element.data(), element.size());
+      }
+      return Error::Success;
     }
   }
 
-  return Error::Success;
+  return InferResult::StringDataRefs(output_name, string_result);
 }
 
 InferResultGrpc::InferResultGrpc(
     std::shared_ptr<inference::ModelInferResponse> response,
-    Error& request_status)
-    : response_(response), request_status_(request_status)
-{
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
+    Error& request_status, const UserBufferMap* user_buffers,
+    std::shared_ptr<GrpcResponseBuffer> aliased_outputs)
+    : response_(response), aliased_outputs_(aliased_outputs),
+      request_status_(request_status)
+{
+  // The response message owns the output data once it is deserialized,
+  // so the data is copied to the user buffer here, on the thread
+  // receiving the response.
+  if ((user_buffers == nullptr) || user_buffers->empty()) {
+    return;
+  }
+  const int output_count = response_->outputs_size();
+  user_buffer_outputs_.resize(output_count, nullptr);
+  for (int index = 0; index < output_count; ++index) {
+    const uint8_t* contents;
+    size_t contents_size;
+    if (!RawOutput(index, &contents, &contents_size)) {
+      break;
+    }
+    auto it = user_buffers->find(response_->outputs(index).name());
+    if ((it != user_buffers->end()) && (it->second.second >= contents_size)) {
+      memcpy(it->second.first, contents, contents_size);
+      user_buffer_outputs_[index] = it->second.first;
+    }
   }
 }
 
@@ -376,16 +995,6 @@ InferResultGrpc::InferResultGrpc(
   response_.reset(
       stream_response->mutable_infer_response(),
       [](inference::ModelInferResponse*) {});
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
-  }
 }
 
 //==============================================================================
@@ -399,11 +1008,11 @@ InferenceServerGrpcClient::Create(
     std::unique_ptr<InferenceServerGrpcClient>* client,
     const std::string& server_url, const grpc::ChannelArguments& channel_args,
     bool verbose, bool use_ssl, const SslOptions& ssl_options,
-    const bool use_cached_channel)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
 {
   client->reset(new InferenceServerGrpcClient(
       server_url, verbose, use_ssl, ssl_options, channel_args,
-      use_cached_channel));
+      use_cached_channel, client_options));
   return Error::Success;
 }
 
@@ -414,7 +1023,7 @@ InferenceServerGrpcClient::Create(
     std::unique_ptr<InferenceServerGrpcClient>* client,
     const std::string& server_url, bool verbose, bool use_ssl,
     const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options,
-    const bool use_cached_channel)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
 {
   // Construct channel channel_args specific to Triton
   grpc::ChannelArguments channel_args;
@@ -436,10 +1045,42 @@ InferenceServerGrpcClient::Create(
 
   client->reset(new InferenceServerGrpcClient(
       server_url, verbose, use_ssl, ssl_options, channel_args,
-      use_cached_channel));
+      use_cached_channel, client_options));
   return Error::Success;
 }
 
+Error
+InferenceServerGrpcClient::Warmup(
+    const size_t connection_count, const uint64_t timeout_us)
+{
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  if (channel_pool_ != nullptr) {
+    channels = channel_pool_->Channels();
+    if ((connection_count != 0) && (connection_count < channels.size())) {
+      channels.resize(connection_count);
+    }
+  } else {
+    channels.push_back(channel_);
+  }
+
+  const auto deadline = std::chrono::system_clock::now() +
+                        std::chrono::microseconds(timeout_us);
+  for (const auto& channel : channels) {
+    if (!channel->WaitForConnected(deadline)) {
+      return Error(
+          "failed to connect to the server within " +
+          std::to_string(timeout_us) + " usec");
+    }
+  }
+
+  bool live;
+  Error err = IsServerLive(&live);
+  if (err.IsOk() && !live) {
+    err = Error("the server is not live");
+  }
+  return err;
+}
+
 Error
 InferenceServerGrpcClient::IsServerLive(bool* live, const Headers& headers)
 {
@@ -564,9 +1205,19 @@ InferenceServerGrpcClient::ModelMetadata(
   model_metadata->Clear();
   Error err;
 
-  inference::ModelMetadataRequest request;
-  grpc::ClientContext context;
-
+  std::string cached;
+  if (model_cache_ != nullptr) {
+    RefreshModelCache(headers);
+    if (model_cache_->Lookup(
+            url_, "metadata", model_name, model_version, &cached) &&
+        model_metadata->ParseFromString(cached)) {
+      return err;
+    }
+  }
+
+  inference::ModelMetadataRequest request;
+  grpc::ClientContext context;
+
   for (const auto& it : headers) {
     context.AddMetadata(it.first, it.second);
   }
@@ -579,6 +1230,11 @@ InferenceServerGrpcClient::ModelMetadata(
     if (verbose_) {
       std::cout << model_metadata->DebugString() << std::endl;
     }
+    if (model_cache_ != nullptr) {
+      model_cache_->Insert(
+          url_, "metadata", model_name, model_version,
+          model_metadata->SerializeAsString());
+    }
   } else {
     err = Error(grpc_status.error_message());
   }
@@ -595,6 +1251,16 @@ InferenceServerGrpcClient::ModelConfig(
   model_config->Clear();
   Error err;
 
+  std::string cached;
+  if (model_cache_ != nullptr) {
+    RefreshModelCache(headers);
+    if (model_cache_->Lookup(
+            url_, "config", model_name, model_version, &cached) &&
+        model_config->ParseFromString(cached)) {
+      return err;
+    }
+  }
+
   inference::ModelConfigRequest request;
   grpc::ClientContext context;
 
@@ -610,6 +1276,11 @@ InferenceServerGrpcClient::ModelConfig(
     if (verbose_) {
       std::cout << model_config->DebugString() << std::endl;
     }
+    if (model_cache_ != nullptr) {
+      model_cache_->Insert(
+          url_, "config", model_name, model_version,
+          model_config->SerializeAsString());
+    }
   } else {
     err = Error(grpc_status.error_message());
   }
@@ -617,6 +1288,25 @@ InferenceServerGrpcClient::ModelConfig(
   return err;
 }
 
+void
+InferenceServerGrpcClient::RefreshModelCache(const Headers& headers)
+{
+  if (!model_cache_->RefreshDue(url_)) {
+    return;
+  }
+  inference::RepositoryIndexResponse index;
+  if (!ModelRepositoryIndex(&index, headers).IsOk()) {
+    return;
+  }
+  // A model changes with the versions listed and their states
+  std::map<std::string, std::string> models;
+  for (const auto& model_index : index.models()) {
+    std::string& model = models[model_index.name()];
+    model += model_index.version() + ":" + model_index.state() + ";";
+  }
+  model_cache_->UpdateIndex(url_, models);
+}
+
 Error
 InferenceServerGrpcClient::ModelRepositoryIndex(
     inference::RepositoryIndexResponse* repository_index,
@@ -671,6 +1361,9 @@ InferenceServerGrpcClient::LoadModel(
   }
   grpc::Status grpc_status =
       stub_->RepositoryModelLoad(&context, request, &response);
+  if (model_cache_ != nullptr) {
+    model_cache_->InvalidateModel(url_, model_name);
+  }
   if (!grpc_status.ok()) {
     err = Error(grpc_status.error_message());
   } else {
@@ -699,6 +1392,9 @@ InferenceServerGrpcClient::UnloadModel(
   request.set_model_name(model_name);
   grpc::Status grpc_status =
       stub_->RepositoryModelUnload(&context, request, &response);
+  if (model_cache_ != nullptr) {
+    model_cache_->InvalidateModel(url_, model_name);
+  }
   if (!grpc_status.ok()) {
     err = Error(grpc_status.error_message());
   } else {
@@ -1013,6 +1709,22 @@ InferenceServerGrpcClient::Infer(
 {
   Error err;
 
+  std::string cache_key;
+  if ((response_cache_ != nullptr) &&
+      ResponseCache::Key(options, inputs, outputs, &cache_key)) {
+    std::shared_ptr<void> cached = response_cache_->Lookup(cache_key);
+    UpdateCacheStat(cached != nullptr);
+    if (cached != nullptr) {
+      InferResultGrpc::Create(
+          result,
+          std::static_pointer_cast<inference::ModelInferResponse>(cached),
+          err);
+      return Error::Success;
+    }
+  } else {
+    cache_key.clear();
+  }
+
   grpc::ClientContext context;
 
   std::shared_ptr<GrpcInferRequest> sync_request(new GrpcInferRequest());
@@ -1030,23 +1742,44 @@ InferenceServerGrpcClient::Infer(
                     std::chrono::microseconds(options.client_timeout_);
     context.set_deadline(deadline);
   }
-  context.set_compression_algorithm(compression_algorithm);
-
-  err = PreRunProcessing(options, inputs, outputs);
+  context.set_compression_algorithm(
+      ChooseCompression(inputs, compression_algorithm));
+
+  // Each call fills a request message of the pool, so that concurrent
+  // calls don't share any state.
+  std::unique_ptr<GrpcArenaInferRequest> arena_request = AcquireArenaRequest();
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  err = PreRunProcessing(
+      options, inputs, outputs, arena_request->Request(),
+      arena_request->PreparedId());
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   if (!err.IsOk()) {
+    ReleaseArenaRequest(std::move(arena_request));
     return err;
   }
   sync_request->grpc_response_->Clear();
-  sync_request->grpc_status_ = stub_->ModelInfer(
-      &context, infer_request_, sync_request->grpc_response_.get());
+  size_t channel_index;
+  std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
+      AcquireInferStub(&channel_index);
+  sync_request->grpc_status_ = stub->ModelInfer(
+      &context, *arena_request->Request(), sync_request->grpc_response_.get());
+  ReleaseInferStub(channel_index);
+  sync_request->request_byte_size_ = arena_request->Request()->ByteSizeLong();
+  ReleaseArenaRequest(std::move(arena_request));
 
   if (!sync_request->grpc_status_.ok()) {
     err = Error(sync_request->grpc_status_.error_message());
   }
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
-  InferResultGrpc::Create(result, sync_request->grpc_response_, err);
+  CollectUserBuffers(outputs, &sync_request->user_buffers_);
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
+  InferResultGrpc::Create(
+      result, sync_request->grpc_response_, err, &sync_request->user_buffers_);
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
@@ -1055,11 +1788,25 @@ InferenceServerGrpcClient::Infer(
   if (!err.IsOk()) {
     std::cerr << "Failed to update context stat: " << err << std::endl;
   }
+  const size_t response_byte_size =
+      sync_request->grpc_response_->ByteSizeLong();
+  UpdateByteStat(
+      sync_request->request_byte_size_, sync_request->request_byte_size_,
+      response_byte_size, response_byte_size);
+  UpdateMetrics(
+      options.model_name_, false /* in_flight */, sync_request->Timer(),
+      !sync_request->grpc_status_.ok(), sync_request->request_byte_size_,
+      response_byte_size);
 
   if (sync_request->grpc_status_.ok()) {
     if (verbose_) {
       std::cout << sync_request->grpc_response_->DebugString() << std::endl;
     }
+    if (!cache_key.empty()) {
+      response_cache_->Insert(
+          cache_key, sync_request->grpc_response_,
+          sync_request->grpc_response_->SpaceUsedLong());
+    }
   }
 
   return (*result)->RequestStatus();
@@ -1071,13 +1818,31 @@ InferenceServerGrpcClient::AsyncInfer(
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  return AsyncInfer(
+      nullptr, std::move(callback), options, inputs, outputs, headers,
+      compression_algorithm);
+}
+
+Error
+InferenceServerGrpcClient::AsyncInfer(
+    std::shared_ptr<AsyncRequestHandle>* handle, OnCompleteFn callback,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
   if (callback == nullptr) {
     return Error(
         "Callback function must be provided along with AsyncInfer() call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
+  if (!client_options_.use_callback_api) {
+    StartAsyncWorkers();
+  }
+  if (outstanding_limiter_ != nullptr) {
+    Error err = outstanding_limiter_->Acquire();
+    if (!err.IsOk()) {
+      return err;
+    }
   }
 
   GrpcInferRequest* async_request;
@@ -1094,27 +1859,115 @@ InferenceServerGrpcClient::AsyncInfer(
                     std::chrono::microseconds(options.client_timeout_);
     async_request->grpc_context_.set_deadline(deadline);
   }
-  async_request->grpc_context_.set_compression_algorithm(compression_algorithm);
-
-  Error err = PreRunProcessing(options, inputs, outputs);
+  async_request->grpc_context_.set_compression_algorithm(
+      ChooseCompression(inputs, compression_algorithm));
+
+  async_request->arena_request_ = AcquireArenaRequest();
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  // The requests serialized by the client and those whose response is
+  // parsed by the client are sent on the generic stub.
+  const bool zero_copy = UseZeroCopy(options, inputs);
+  const bool generic = zero_copy || client_options_.alias_output_contents;
+  grpc::ByteBuffer request_buffer;
+  Error err = PreRunProcessing(
+      options, inputs, outputs, async_request->arena_request_->Request(),
+      async_request->arena_request_->PreparedId(), zero_copy);
+  if (err.IsOk() && zero_copy) {
+    err = SerializeZeroCopy(
+        *async_request->arena_request_->Request(), inputs, &request_buffer,
+        &async_request->input_refs_);
+  } else if (err.IsOk() && generic) {
+    bool own_buffer;
+    grpc::Status status =
+        grpc::SerializationTraits<inference::ModelInferRequest>::Serialize(
+            *async_request->arena_request_->Request(), &request_buffer,
+            &own_buffer);
+    if (!status.ok()) {
+      err = Error(status.error_message());
+    }
+  }
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
   if (!err.IsOk()) {
+    ReleaseArenaRequest(std::move(async_request->arena_request_));
     delete async_request;
+    ReleaseOutstanding();
     return err;
   }
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+  CollectUserBuffers(outputs, &async_request->user_buffers_);
+  async_request->request_byte_size_ =
+      generic ? request_buffer.Length()
+              : async_request->arena_request_->Request()->ByteSizeLong();
+  if (metrics_ != nullptr) {
+    async_request->SetModelName(options.model_name_);
+    metrics_->RequestStarted(options.model_name_);
+  }
+  if (handle != nullptr) {
+    async_request->cancel_state_ = std::make_shared<GrpcCancelState>();
+    async_request->cancel_state_->context_ = &async_request->grpc_context_;
+    handle->reset(new GrpcAsyncRequestHandle(async_request->cancel_state_));
+  }
 
-  std::unique_ptr<
-      grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
-      rpc(stub_->PrepareAsyncModelInfer(
-          &async_request->grpc_context_, infer_request_,
-          &async_request_completion_queue_));
+  std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
+      AcquireInferStub(&async_request->channel_index_);
+  if (generic) {
+    // The generic stub has no callback API, so the request always completes
+    // on the completion queues.
+    StartAsyncWorkers();
+    async_request->response_buffer_.reset(new grpc::ByteBuffer());
+    std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+        InferGenericStub(async_request->channel_index_)
+            ->PrepareUnaryCall(
+                &async_request->grpc_context_,
+                "/inference.GRPCInferenceService/ModelInfer", request_buffer,
+                async_request_completion_queues_
+                    [next_completion_queue_++ %
+                     async_request_completion_queues_.size()]
+                        .get()));
+
+    rpc->StartCall();
+
+    rpc->Finish(
+        async_request->response_buffer_.get(), &async_request->grpc_status_,
+        (void*)async_request);
+  } else if (client_options_.use_callback_api) {
+    // The completion runs on a thread of the gRPC library. The client
+    // waits in its destructor for the completions still to come.
+    {
+      std::lock_guard<std::mutex> lock(callback_rpc_mutex_);
+      callback_rpc_count_++;
+    }
+    stub->async()->ModelInfer(
+        &async_request->grpc_context_,
+        async_request->arena_request_->Request(),
+        async_request->grpc_response_.get(),
+        [this, async_request](grpc::Status status) {
+          async_request->grpc_status_ = std::move(status);
+          CompleteAsyncRequest(async_request);
+          std::lock_guard<std::mutex> lock(callback_rpc_mutex_);
+          if (--callback_rpc_count_ == 0) {
+            callback_rpc_cv_.notify_all();
+          }
+        });
+  } else {
+    std::unique_ptr<
+        grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
+        rpc(stub->PrepareAsyncModelInfer(
+            &async_request->grpc_context_,
+            *async_request->arena_request_->Request(),
+            async_request_completion_queues_
+                [next_completion_queue_++ %
+                 async_request_completion_queues_.size()]
+                    .get()));
 
-  rpc->StartCall();
+    rpc->StartCall();
 
-  rpc->Finish(
-      async_request->grpc_response_.get(), &async_request->grpc_status_,
-      (void*)async_request);
+    rpc->Finish(
+        async_request->grpc_response_.get(), &async_request->grpc_status_,
+        (void*)async_request);
+  }
 
   if (verbose_) {
     std::cout << "Sent request";
@@ -1127,6 +1980,23 @@ InferenceServerGrpcClient::AsyncInfer(
   return Error::Success;
 }
 
+Error
+InferenceServerGrpcClient::AsyncInferFuture(
+    std::future<InferResult*>* result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  std::future<InferResult*> future;
+  Error err = AsyncInfer(
+      PromiseCallback(&future), options, inputs, outputs, headers,
+      compression_algorithm);
+  if (err.IsOk()) {
+    *result = std::move(future);
+  }
+  return err;
+}
+
 Error
 InferenceServerGrpcClient::InferMulti(
     std::vector<InferResult*>* results,
@@ -1135,8 +2005,6 @@ InferenceServerGrpcClient::InferMulti(
     const std::vector<std::vector<const InferRequestedOutput*>>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
-  Error err;
-
   // Sanity check
   if ((inputs.size() != options.size()) && (options.size() != 1)) {
     return Error(
@@ -1148,6 +2016,28 @@ InferenceServerGrpcClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
+  // The requests are sent asynchronously with at most
+  // 'infer_multi_max_in_flight' of them waiting for their responses, the
+  // results are collected in the order of the requests. A request that
+  // belongs to a sequence is not sent until the previous request of the same
+  // sequence has completed, so that the sequence reaches the server in order.
+  struct MultiState {
+    std::mutex mu;
+    std::condition_variable cv;
+    size_t in_flight = 0;
+    std::set<std::string> sequences;
+  };
+  std::shared_ptr<MultiState> state = std::make_shared<MultiState>();
+  size_t max_in_flight =
+      std::max<size_t>(1, client_options_.infer_multi_max_in_flight);
+  if (client_options_.max_outstanding_requests > 0) {
+    max_in_flight = std::min(
+        max_in_flight, client_options_.max_outstanding_requests);
+  }
+
+  const size_t first_result = results->size();
+  results->resize(first_result + inputs.size(), nullptr);
+
   int64_t max_option_idx = options.size() - 1;
   // value of '-1' means no output is specified
   int64_t max_output_idx = outputs.size() - 1;
@@ -1157,10 +2047,54 @@ InferenceServerGrpcClient::InferMulti(
     const auto& request_output = (max_output_idx == -1)
                                      ? empty_outputs
                                      : outputs[std::min(max_output_idx, i)];
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
+    InferResult** result = &(*results)[first_result + i];
+    std::string sequence;
+    if (request_options.sequence_id_ != 0) {
+      sequence = "id:" + std::to_string(request_options.sequence_id_);
+    } else if (!request_options.sequence_id_str_.empty()) {
+      sequence = "str:" + request_options.sequence_id_str_;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(state->mu);
+      state->cv.wait(lock, [&state, &sequence, max_in_flight] {
+        return (state->in_flight < max_in_flight) &&
+               (sequence.empty() || (state->sequences.count(sequence) == 0));
+      });
+      state->in_flight++;
+      if (!sequence.empty()) {
+        state->sequences.insert(sequence);
+      }
+    }
+
+    OnCompleteFn cb = [state, result, sequence](InferResult* infer_result) {
+      std::lock_guard<std::mutex> lock(state->mu);
+      *result = infer_result;
+      state->in_flight--;
+      if (!sequence.empty()) {
+        state->sequences.erase(sequence);
+      }
+      state->cv.notify_all();
+    };
+    Error err = AsyncInfer(
+        cb, request_options, inputs[i], request_output, headers,
         compression_algorithm);
+    if (!err.IsOk()) {
+      std::shared_ptr<inference::ModelInferResponse> empty_response(
+          new inference::ModelInferResponse());
+      InferResult* err_result;
+      InferResultGrpc::Create(&err_result, empty_response, err);
+      cb(err_result);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(state->mu);
+    state->cv.wait(lock, [&state] { return state->in_flight == 0; });
+  }
+
+  for (size_t i = first_result; i < results->size(); ++i) {
+    Error err = (*results)[i]->RequestStatus();
     if (!err.IsOk()) {
       return err;
     }
@@ -1190,9 +2124,7 @@ InferenceServerGrpcClient::AsyncInferMulti(
         "Callback function must be provided along with AsyncInferMulti() "
         "call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
-  }
+  StartAsyncWorkers();
 
   int64_t max_option_idx = options.size() - 1;
   // value of '-1' means no output is specified
@@ -1242,7 +2174,18 @@ InferenceServerGrpcClient::StartStream(
     OnCompleteFn callback, bool enable_stats, uint32_t stream_timeout,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
-  if (stream_worker_.joinable()) {
+  return StartStreams(
+      1, callback, enable_stats, stream_timeout, headers,
+      compression_algorithm);
+}
+
+Error
+InferenceServerGrpcClient::StartStreams(
+    size_t stream_count, OnCompleteFn callback, bool enable_stats,
+    uint32_t stream_timeout, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm)
+{
+  if (!streams_.empty()) {
     return Error(
         "cannot start another stream with one already running. "
         "'InferenceServerClient' supports only a single active "
@@ -1254,26 +2197,42 @@ InferenceServerGrpcClient::StartStream(
         "Callback function must be provided along with StartStream() call.");
   }
 
+  if (stream_count == 0) {
+    return Error("stream_count must be > 0");
+  }
+
   stream_callback_ = callback;
   enable_stream_stats_ = enable_stats;
+  next_stream_ = 0;
 
-  for (const auto& it : headers) {
-    grpc_context_.AddMetadata(it.first, it.second);
-  }
+  for (size_t i = 0; i < stream_count; ++i) {
+    std::unique_ptr<GrpcStream> stream(new GrpcStream());
+    stream->response_pool_ = std::make_shared<StreamResponsePool>();
+    for (const auto& it : headers) {
+      stream->grpc_context_.AddMetadata(it.first, it.second);
+    }
 
-  if (stream_timeout != 0) {
-    auto deadline = std::chrono::system_clock::now() +
-                    std::chrono::microseconds(stream_timeout);
-    grpc_context_.set_deadline(deadline);
-  }
-  grpc_context_.set_compression_algorithm(compression_algorithm);
+    if (stream_timeout != 0) {
+      auto deadline = std::chrono::system_clock::now() +
+                      std::chrono::microseconds(stream_timeout);
+      stream->grpc_context_.set_deadline(deadline);
+    }
+    stream->grpc_context_.set_compression_algorithm(compression_algorithm);
 
-  grpc_stream_ = stub_->ModelStreamInfer(&grpc_context_);
-  stream_worker_ =
-      std::thread(&InferenceServerGrpcClient::AsyncStreamTransfer, this);
+    std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
+        AcquireInferStub(&stream->channel_index_);
+    stream->grpc_stream_ = stub->ModelStreamInfer(&stream->grpc_context_);
+    stream->worker_ = std::thread(
+        &InferenceServerGrpcClient::AsyncStreamTransfer, this, stream.get());
+    stream->writer_ = std::thread(
+        &InferenceServerGrpcClient::AsyncStreamWrite, this, stream.get());
+    streams_.emplace_back(std::move(stream));
+  }
 
   if (verbose_) {
-    std::cout << "Started stream..." << std::endl;
+    std::cout << "Started " << stream_count
+              << ((stream_count == 1) ? " stream..." : " streams...")
+              << std::endl;
   }
 
   return Error::Success;
@@ -1282,10 +2241,25 @@ InferenceServerGrpcClient::StartStream(
 Error
 InferenceServerGrpcClient::StopStream()
 {
-  if (stream_worker_.joinable()) {
-    grpc_stream_->WritesDone();
-    // The reader thread will drain the stream properly
-    stream_worker_.join();
+  if (!streams_.empty()) {
+    // The writer threads send the queued requests before closing the
+    // writing side of the streams
+    for (auto& stream : streams_) {
+      {
+        std::lock_guard<std::mutex> lock(stream->write_mutex_);
+        stream->writes_done_ = true;
+      }
+      stream->write_cv_.notify_one();
+    }
+    for (auto& stream : streams_) {
+      stream->writer_.join();
+    }
+    // The reader threads will drain the streams properly
+    for (auto& stream : streams_) {
+      stream->worker_.join();
+      ReleaseInferStub(stream->channel_index_);
+    }
+    streams_.clear();
     if (verbose_) {
       std::cout << "Stopped stream..." << std::endl;
     }
@@ -1299,84 +2273,190 @@ InferenceServerGrpcClient::AsyncStreamInfer(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
+  // Keep the requests of a sequence on one stream so that they reach the
+  // server in order.
+  size_t stream_key;
+  if (streams_.size() <= 1) {
+    stream_key = 0;
+  } else if (options.sequence_id_ != 0) {
+    stream_key = options.sequence_id_;
+  } else if (!options.sequence_id_str_.empty()) {
+    stream_key = std::hash<std::string>()(options.sequence_id_str_);
+  } else {
+    stream_key = next_stream_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return AsyncStreamInfer(stream_key, options, inputs, outputs);
+}
+
+Error
+InferenceServerGrpcClient::AsyncStreamInfer(
+    size_t stream_key, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (streams_.empty()) {
+    return Error("Stream has not been started.");
+  }
+  GrpcStream* stream = streams_[stream_key % streams_.size()].get();
+
   std::unique_ptr<RequestTimers> timer;
   if (enable_stream_stats_) {
     timer.reset(new RequestTimers());
     timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
     timer->CaptureTimestamp(RequestTimers::Kind::SEND_START);
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_START);
   }
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  std::unique_ptr<GrpcArenaInferRequest> request = AcquireArenaRequest();
+  Error err = PreRunProcessing(
+      options, inputs, outputs, request->Request(), request->PreparedId());
   if (!err.IsOk()) {
+    ReleaseArenaRequest(std::move(request));
     return err;
   }
 
   if (enable_stream_stats_) {
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
     timer->CaptureTimestamp(RequestTimers::Kind::SEND_END);
   }
 
-  if (enable_stream_stats_) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    ongoing_stream_request_timers_.push(std::move(timer));
+  {
+    // The timers must be queued in the order the requests are written.
+    std::lock_guard<std::mutex> write_lock(stream->write_mutex_);
+    if (stream->closed_ || stream->writes_done_) {
+      ReleaseArenaRequest(std::move(request));
+      return Error("Stream has been closed.");
+    }
+    if (enable_stream_stats_) {
+      std::lock_guard<std::mutex> lock(stream->timers_mutex_);
+      if (options.request_id_.empty()) {
+        stream->ongoing_request_timers_.push(std::move(timer));
+      } else {
+        // A request whose id is already in flight on the stream is not
+        // timed, as its responses can't be told apart.
+        stream->request_timers_by_id_.emplace(
+            options.request_id_, StreamRequestTimer(std::move(timer)));
+      }
+    }
+    stream->write_queue_.emplace_back(std::move(request));
   }
-  bool ok = grpc_stream_->Write(infer_request_);
+  stream->write_cv_.notify_one();
 
-  if (ok) {
-    if (verbose_) {
-      std::cout << "Sent request";
-      if (options.request_id_.size() != 0) {
-        std::cout << " '" << options.request_id_ << "'";
-      }
-      std::cout << " to the stream" << std::endl;
+  if (verbose_) {
+    std::cout << "Queued request";
+    if (options.request_id_.size() != 0) {
+      std::cout << " '" << options.request_id_ << "'";
     }
-    return Error::Success;
-  } else {
-    return Error("Stream has been closed.");
+    std::cout << " to the stream" << std::endl;
   }
+  return Error::Success;
+}
+
+size_t
+InferenceServerGrpcClient::CopyInputContents(
+    InferInput* input, std::string* raw_contents)
+{
+  // Reserving the size up front avoids the reallocations of the appends,
+  // and unlike resize() doesn't zero-fill bytes that are overwritten anyway.
+  bool end_of_input = false;
+  size_t content_size;
+  input->ByteSize(&content_size);
+  raw_contents->clear();
+  raw_contents->reserve(content_size);
+  while (!end_of_input) {
+    const uint8_t* buf;
+    size_t buf_size;
+    input->GetNext(&buf, &buf_size, &end_of_input);
+    if ((buf != nullptr) && (buf_size != 0)) {
+      raw_contents->append(reinterpret_cast<const char*>(buf), buf_size);
+    }
+  }
+  return raw_contents->size();
 }
 
 Error
-InferenceServerGrpcClient::PreRunProcessing(
+InferenceServerGrpcClient::PrepareInfer(
+    std::shared_ptr<PreparedInferRequest>* prepared,
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
+  std::shared_ptr<GrpcPreparedInferRequest> grpc_prepared(
+      new GrpcPreparedInferRequest());
+  Error err = grpc_prepared->RecordInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  InferOptions fixed_options(options);
+  fixed_options.request_id_.clear();
+  fixed_options.prepared_request_.reset();
+  uint64_t prepared_id;
+  err = PreRunProcessing(
+      fixed_options, inputs, outputs, &grpc_prepared->request_, &prepared_id);
+  if (!err.IsOk()) {
+    return err;
+  }
+  grpc_prepared->request_.mutable_raw_input_contents()->Clear();
+  grpc_prepared->fixed_byte_size_ = grpc_prepared->request_.ByteSizeLong();
+
+  *prepared = std::move(grpc_prepared);
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::PreRunProcessing(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    inference::ModelInferRequest* infer_request, uint64_t* prepared_id,
+    const bool skip_raw_contents)
+{
+  if (options.prepared_request_ != nullptr) {
+    return FillPreparedRequest(options, inputs, infer_request, prepared_id);
+  }
+  *prepared_id = 0;
+
   // Populate the request protobuf
-  infer_request_.set_model_name(options.model_name_);
-  infer_request_.set_model_version(options.model_version_);
-  infer_request_.set_id(options.request_id_);
+  infer_request->set_model_name(options.model_name_);
+  infer_request->set_model_version(options.model_version_);
+  infer_request->set_id(options.request_id_);
 
-  infer_request_.mutable_parameters()->clear();
+  infer_request->mutable_parameters()->clear();
   if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
     if (options.sequence_id_ != 0) {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_int64_param(
+      (*infer_request->mutable_parameters())["sequence_id"].set_int64_param(
           options.sequence_id_);
     } else {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_string_param(
+      (*infer_request->mutable_parameters())["sequence_id"].set_string_param(
           options.sequence_id_str_);
     }
-    (*infer_request_.mutable_parameters())["sequence_start"].set_bool_param(
+    (*infer_request->mutable_parameters())["sequence_start"].set_bool_param(
         options.sequence_start_);
-    (*infer_request_.mutable_parameters())["sequence_end"].set_bool_param(
+    (*infer_request->mutable_parameters())["sequence_end"].set_bool_param(
         options.sequence_end_);
   }
   if (options.priority_ != 0) {
-    (*infer_request_.mutable_parameters())["priority"].set_int64_param(
+    (*infer_request->mutable_parameters())["priority"].set_int64_param(
         options.priority_);
   }
 
   if (options.server_timeout_ != 0) {
-    (*infer_request_.mutable_parameters())["timeout"].set_int64_param(
+    (*infer_request->mutable_parameters())["timeout"].set_int64_param(
         options.server_timeout_);
   }
 
+  if (options.triton_enable_empty_final_response_) {
+    (*infer_request->mutable_parameters())["triton_enable_empty_final_response"]
+        .set_bool_param(true);
+  }
+
   int index = 0;
-  infer_request_.mutable_raw_input_contents()->Clear();
+  infer_request->mutable_raw_input_contents()->Clear();
   for (const auto input : inputs) {
     // Add new InferInputTensor submessages only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_input = (infer_request_.inputs().size() <= index)
-                          ? infer_request_.add_inputs()
-                          : infer_request_.mutable_inputs()->Mutable(index);
+    auto grpc_input = (infer_request->inputs().size() <= index)
+                          ? infer_request->add_inputs()
+                          : infer_request->mutable_inputs()->Mutable(index);
 
     if (input->IsSharedMemory()) {
       // The input contents must be cleared when using shared memory.
@@ -1406,38 +2486,25 @@ InferenceServerGrpcClient::PreRunProcessing(
         (*grpc_input->mutable_parameters())["shared_memory_offset"]
             .set_int64_param(offset);
       }
-    } else {
-      bool end_of_input = false;
-      std::string* raw_contents = infer_request_.add_raw_input_contents();
-      size_t content_size;
-      input->ByteSize(&content_size);
-      raw_contents->reserve(content_size);
-      raw_contents->clear();
-      while (!end_of_input) {
-        const uint8_t* buf;
-        size_t buf_size;
-        input->GetNext(&buf, &buf_size, &end_of_input);
-        if (buf != nullptr) {
-          raw_contents->append(reinterpret_cast<const char*>(buf), buf_size);
-        }
-      }
+    } else if (!skip_raw_contents) {
+      CopyInputContents(input, infer_request->add_raw_input_contents());
     }
     index++;
   }
 
   // Remove extra InferInputTensor submessages, that are not required for
   // this request.
-  while (index < infer_request_.inputs().size()) {
-    infer_request_.mutable_inputs()->RemoveLast();
+  while (index < infer_request->inputs().size()) {
+    infer_request->mutable_inputs()->RemoveLast();
   }
 
   index = 0;
   for (const auto routput : outputs) {
     // Add new InferRequestedOutputTensor submessage only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_output = (infer_request_.outputs().size() <= index)
-                           ? infer_request_.add_outputs()
-                           : infer_request_.mutable_outputs()->Mutable(index);
+    auto grpc_output = (infer_request->outputs().size() <= index)
+                           ? infer_request->add_outputs()
+                           : infer_request->mutable_outputs()->Mutable(index);
     grpc_output->Clear();
     grpc_output->set_name(routput->Name());
     size_t class_count = routput->ClassificationCount();
@@ -1464,13 +2531,64 @@ InferenceServerGrpcClient::PreRunProcessing(
 
   // Remove extra InferRequestedOutputTensor submessages, that are not required
   // for this request.
-  while (index < infer_request_.outputs().size()) {
-    infer_request_.mutable_outputs()->RemoveLast();
+  while (index < infer_request->outputs().size()) {
+    infer_request->mutable_outputs()->RemoveLast();
+  }
+
+  if (infer_request->ByteSizeLong() > INT_MAX) {
+    size_t request_size = infer_request->ByteSizeLong();
+    infer_request->Clear();
+    return Error(
+        "Request has byte size " + std::to_string(request_size) +
+        " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
+        ".");
+  }
+
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::FillPreparedRequest(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    inference::ModelInferRequest* infer_request, uint64_t* prepared_id)
+{
+  const GrpcPreparedInferRequest* prepared =
+      dynamic_cast<const GrpcPreparedInferRequest*>(
+          options.prepared_request_.get());
+  if (prepared == nullptr) {
+    return Error("The request was not prepared by a gRPC client.");
+  }
+  Error err = prepared->CheckInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
   }
 
-  if (infer_request_.ByteSizeLong() > INT_MAX) {
-    size_t request_size = infer_request_.ByteSizeLong();
-    infer_request_.Clear();
+  if (*prepared_id != prepared->id_) {
+    infer_request->CopyFrom(prepared->request_);
+    *prepared_id = prepared->id_;
+  }
+  infer_request->set_id(options.request_id_);
+
+  // The number of raw input contents is the same for every call with the
+  // prepared request, so the strings of the previous call are reused.
+  size_t request_size = prepared->fixed_byte_size_ + options.request_id_.size();
+  int index = 0;
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+    input->PrepareForRequest();
+    std::string* raw_contents =
+        (index < infer_request->raw_input_contents_size())
+            ? infer_request->mutable_raw_input_contents(index)
+            : infer_request->add_raw_input_contents();
+    request_size += CopyInputContents(input, raw_contents);
+    index++;
+  }
+
+  if (request_size > INT_MAX) {
+    *prepared_id = 0;
+    infer_request->Clear();
     return Error(
         "Request has byte size " + std::to_string(request_size) +
         " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
@@ -1480,16 +2598,226 @@ InferenceServerGrpcClient::PreRunProcessing(
   return Error::Success;
 }
 
+grpc_compression_algorithm
+InferenceServerGrpcClient::ChooseCompression(
+    const std::vector<InferInput*>& inputs,
+    const grpc_compression_algorithm requested)
+{
+  if (!client_options_.adaptive_compression) {
+    return requested;
+  }
+
+  size_t input_byte_size = 0;
+  for (const auto input : inputs) {
+    size_t byte_size;
+    if (!input->IsSharedMemory() && input->ByteSize(&byte_size).IsOk()) {
+      input_byte_size += byte_size;
+    }
+  }
+  if (input_byte_size < client_options_.adaptive_compression_min_byte_size) {
+    UpdateCompressionStat(false, input_byte_size, 0);
+    return GRPC_COMPRESS_NONE;
+  }
+
+  // The byte histogram of evenly spaced samples of the input buffers
+  // estimates how well the request compresses, at a small fraction of the
+  // cost of compressing it.
+  constexpr size_t kSampleCount = 4096;
+  const size_t stride = std::max<size_t>(1, input_byte_size / kSampleCount);
+  size_t histogram[256] = {0};
+  size_t sample_count = 0;
+  size_t offset = 0;
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+    input->PrepareForRequest();
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      for (; (buf != nullptr) && (offset < buf_size); offset += stride) {
+        histogram[buf[offset]]++;
+        sample_count++;
+      }
+      offset -= std::min(offset, buf_size);
+    }
+  }
+  double entropy = 0;
+  for (const size_t count : histogram) {
+    if (count != 0) {
+      const double p = static_cast<double>(count) / sample_count;
+      entropy -= p * std::log2(p);
+    }
+  }
+
+  if ((sample_count == 0) ||
+      (entropy > client_options_.adaptive_compression_max_entropy)) {
+    UpdateCompressionStat(false, input_byte_size, 0);
+    return GRPC_COMPRESS_NONE;
+  }
+  UpdateCompressionStat(
+      true, input_byte_size,
+      static_cast<size_t>(input_byte_size * (1.0 - entropy / 8)));
+  return (requested == GRPC_COMPRESS_NONE) ? GRPC_COMPRESS_DEFLATE : requested;
+}
+
+bool
+InferenceServerGrpcClient::UseZeroCopy(
+    const InferOptions& options, const std::vector<InferInput*>& inputs)
+{
+  if ((client_options_.zero_copy_input_threshold == 0) ||
+      (options.prepared_request_ != nullptr)) {
+    return false;
+  }
+  for (const auto input : inputs) {
+    size_t byte_size;
+    if (!input->IsSharedMemory() && input->ByteSize(&byte_size).IsOk() &&
+        (byte_size >= client_options_.zero_copy_input_threshold)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Error
+InferenceServerGrpcClient::SerializeZeroCopy(
+    const inference::ModelInferRequest& infer_request,
+    const std::vector<InferInput*>& inputs, grpc::ByteBuffer* buffer,
+    std::vector<std::shared_ptr<const uint8_t>>* input_refs)
+{
+  // A repeated field may be split over the message, so every
+  // 'raw_input_contents' is appended after the rest of the message, in the
+  // order of the inputs, as its tag and length followed by the input data.
+  std::vector<grpc::Slice> slices;
+  std::string header;
+  infer_request.SerializeToString(&header);
+  size_t request_size = header.size();
+  slices.emplace_back(header);
+
+  const uint32_t tag =
+      (inference::ModelInferRequest::kRawInputContentsFieldNumber << 3) |
+      2 /* length-delimited */;
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+    size_t content_size;
+    input->ByteSize(&content_size);
+    uint8_t prefix[2 * 10];
+    size_t prefix_size = 0;
+    for (uint64_t value : {static_cast<uint64_t>(tag),
+                           static_cast<uint64_t>(content_size)}) {
+      while (value >= 0x80) {
+        prefix[prefix_size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+      }
+      prefix[prefix_size++] = static_cast<uint8_t>(value);
+    }
+    slices.emplace_back(prefix, prefix_size);
+    request_size += prefix_size + content_size;
+
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      if ((buf != nullptr) && (buf_size != 0)) {
+        slices.emplace_back(buf, buf_size, grpc::Slice::STATIC_SLICE);
+      }
+    }
+    input_refs->insert(
+        input_refs->end(), input->shared_bufs_.begin(),
+        input->shared_bufs_.end());
+  }
+
+  if (request_size > INT_MAX) {
+    input_refs->clear();
+    return Error(
+        "Request has byte size " + std::to_string(request_size) +
+        " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
+        ".");
+  }
+  *buffer = grpc::ByteBuffer(slices.data(), slices.size());
+  return Error::Success;
+}
+
+std::unique_ptr<GrpcArenaInferRequest>
+InferenceServerGrpcClient::AcquireArenaRequest()
+{
+  {
+    std::lock_guard<std::mutex> lock(arena_pool_mutex_);
+    if (!arena_pool_.empty()) {
+      std::unique_ptr<GrpcArenaInferRequest> request =
+          std::move(arena_pool_.back());
+      arena_pool_.pop_back();
+      return request;
+    }
+  }
+  return std::unique_ptr<GrpcArenaInferRequest>(new GrpcArenaInferRequest());
+}
+
+void
+InferenceServerGrpcClient::ReleaseArenaRequest(
+    std::unique_ptr<GrpcArenaInferRequest>&& request)
+{
+  if (request == nullptr) {
+    return;
+  }
+  request->Recycle();
+  std::lock_guard<std::mutex> lock(arena_pool_mutex_);
+  arena_pool_.emplace_back(std::move(request));
+}
+
+std::shared_ptr<inference::GRPCInferenceService::Stub>
+InferenceServerGrpcClient::AcquireInferStub(size_t* channel_index)
+{
+  if (channel_pool_ == nullptr) {
+    *channel_index = 0;
+    return stub_;
+  }
+  return channel_pool_->Acquire(channel_index);
+}
+
 void
-InferenceServerGrpcClient::AsyncTransfer()
+InferenceServerGrpcClient::ReleaseInferStub(const size_t channel_index)
+{
+  if (channel_pool_ != nullptr) {
+    channel_pool_->Release(channel_index);
+  }
+}
+
+std::shared_ptr<grpc::GenericStub>
+InferenceServerGrpcClient::InferGenericStub(const size_t channel_index)
+{
+  if (channel_pool_ == nullptr) {
+    return generic_stub_;
+  }
+  return channel_pool_->GenericStub(channel_index);
+}
+
+void
+InferenceServerGrpcClient::StartAsyncWorkers()
+{
+  std::call_once(async_request_workers_started_, [this] {
+    for (auto& completion_queue : async_request_completion_queues_) {
+      async_request_workers_.emplace_back(
+          &InferenceServerGrpcClient::AsyncTransfer, this,
+          completion_queue.get());
+    }
+  });
+}
+
+void
+InferenceServerGrpcClient::AsyncTransfer(
+    grpc::CompletionQueue* completion_queue)
 {
   while (!exiting_) {
     // GRPC async APIs are thread-safe https://github.com/grpc/grpc/issues/4486
     GrpcInferRequest* raw_async_request;
     bool ok = true;
-    bool status =
-        async_request_completion_queue_.Next((void**)(&raw_async_request), &ok);
-    std::shared_ptr<GrpcInferRequest> async_request;
+    bool status = completion_queue->Next((void**)(&raw_async_request), &ok);
     if (!ok) {
       fprintf(stderr, "Unexpected not ok on client side.\n");
     }
@@ -1500,66 +2828,189 @@ InferenceServerGrpcClient::AsyncTransfer()
     } else if (raw_async_request == nullptr) {
       fprintf(stderr, "Unexpected null tag received at client.\n");
     } else {
-      async_request.reset(raw_async_request);
-      InferResult* async_result;
-      Error err;
-      if (!async_request->grpc_status_.ok()) {
-        err = Error(async_request->grpc_status_.error_message());
+      CompleteAsyncRequest(raw_async_request);
+    }
+  }
+}
+
+void
+InferenceServerGrpcClient::CompleteAsyncRequest(
+    GrpcInferRequest* raw_async_request)
+{
+  std::shared_ptr<GrpcInferRequest> async_request(raw_async_request);
+  ReleaseInferStub(async_request->channel_index_);
+  ReleaseArenaRequest(std::move(async_request->arena_request_));
+  async_request->input_refs_.clear();
+  InferResult* async_result;
+  Error err;
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
+  std::shared_ptr<GrpcResponseBuffer> aliased_outputs;
+  size_t response_byte_size = 0;
+  if (async_request->response_buffer_ != nullptr) {
+    response_byte_size = async_request->response_buffer_->Length();
+  } else if (metrics_ != nullptr) {
+    response_byte_size = async_request->grpc_response_->ByteSizeLong();
+  }
+  if (async_request->grpc_status_.ok() &&
+      (async_request->response_buffer_ != nullptr)) {
+    if (client_options_.alias_output_contents) {
+      aliased_outputs = std::make_shared<GrpcResponseBuffer>();
+      async_request->grpc_status_ = ParseAliasedResponse(
+          async_request->response_buffer_.get(),
+          async_request->grpc_response_.get(), aliased_outputs.get());
+    } else {
+      async_request->grpc_status_ =
+          grpc::SerializationTraits<inference::ModelInferResponse>::
+              Deserialize(
+                  async_request->response_buffer_.get(),
+                  async_request->grpc_response_.get());
+    }
+  }
+  if (!async_request->grpc_status_.ok()) {
+    err = Error(async_request->grpc_status_.error_message());
+  }
+  InferResultGrpc::Create(
+      &async_result, async_request->grpc_response_, err,
+      &async_request->user_buffers_, aliased_outputs);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+  err = UpdateInferStat(async_request->Timer());
+  if (!err.IsOk()) {
+    std::cerr << "Failed to update context stat: " << err << std::endl;
+  }
+  UpdateByteStat(
+      async_request->request_byte_size_, async_request->request_byte_size_,
+      response_byte_size, response_byte_size);
+  UpdateMetrics(
+      async_request->ModelName(), true /* in_flight */,
+      async_request->Timer(), !async_request->grpc_status_.ok(),
+      async_request->request_byte_size_, response_byte_size);
+  if (async_request->grpc_status_.ok()) {
+    if (verbose_) {
+      std::cout << async_request->grpc_response_->DebugString() << std::endl;
+    }
+  }
+  ReleaseOutstanding();
+  RunCompletion(async_request->callback_, async_result);
+}
+
+void
+InferenceServerGrpcClient::AsyncStreamWrite(GrpcStream* stream)
+{
+  std::deque<std::unique_ptr<GrpcArenaInferRequest>> requests;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(stream->write_mutex_);
+      stream->write_cv_.wait(lock, [stream] {
+        return stream->writes_done_ || !stream->write_queue_.empty();
+      });
+      if (stream->write_queue_.empty()) {
+        break;
       }
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
-      InferResultGrpc::Create(
-          &async_result, async_request->grpc_response_, err);
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
-      err = UpdateInferStat(async_request->Timer());
-      if (!err.IsOk()) {
-        std::cerr << "Failed to update context stat: " << err << std::endl;
+      requests.swap(stream->write_queue_);
+    }
+
+    // Only the last write of the batch flushes the buffered messages.
+    bool ok = true;
+    for (size_t i = 0; ok && (i < requests.size()); ++i) {
+      grpc::WriteOptions write_options;
+      if (i + 1 < requests.size()) {
+        write_options.set_buffer_hint();
       }
-      if (async_request->grpc_status_.ok()) {
-        if (verbose_) {
-          std::cout << async_request->grpc_response_->DebugString()
-                    << std::endl;
-        }
+      ok = stream->grpc_stream_->Write(
+          *requests[i]->Request(), write_options);
+    }
+    for (auto& request : requests) {
+      ReleaseArenaRequest(std::move(request));
+    }
+    requests.clear();
+
+    if (!ok) {
+      std::lock_guard<std::mutex> lock(stream->write_mutex_);
+      stream->closed_ = true;
+      for (auto& request : stream->write_queue_) {
+        ReleaseArenaRequest(std::move(request));
       }
-      async_request->callback_(async_result);
+      stream->write_queue_.clear();
+      if (verbose_) {
+        std::cout << "Stream has been closed." << std::endl;
+      }
+      break;
     }
   }
+  stream->grpc_stream_->WritesDone();
 }
 
 void
-InferenceServerGrpcClient::AsyncStreamTransfer()
+InferenceServerGrpcClient::AsyncStreamTransfer(GrpcStream* stream)
 {
   std::shared_ptr<inference::ModelStreamInferResponse> response =
-      std::make_shared<inference::ModelStreamInferResponse>();
+      stream->response_pool_->Acquire();
   // End loop if Read() returns false
   // (stream ended and all responses are drained)
-  while (grpc_stream_->Read(response.get())) {
+  while (stream->grpc_stream_->Read(response.get())) {
     if (exiting_) {
       continue;
     }
 
+    // The timer is only taken out once the final response of its request
+    // has arrived.
     std::unique_ptr<RequestTimers> timer;
+    size_t response_count = 1;
     if (enable_stream_stats_) {
-      std::lock_guard<std::mutex> lock(stream_mutex_);
-      if (!ongoing_stream_request_timers_.empty()) {
-        timer = std::move(ongoing_stream_request_timers_.front());
-        ongoing_stream_request_timers_.pop();
+      const auto& infer_response = response->infer_response();
+      bool final_response = true;
+      const auto final_itr =
+          infer_response.parameters().find("triton_final_response");
+      if (final_itr != infer_response.parameters().end()) {
+        final_response = final_itr->second.bool_param();
+      }
+      // The empty final response of a decoupled request only flags that
+      // the request is complete.
+      const bool empty_response = response->error_message().empty() &&
+                                  (infer_response.outputs_size() == 0);
+
+      std::lock_guard<std::mutex> lock(stream->timers_mutex_);
+      auto timer_itr = stream->request_timers_by_id_.end();
+      if (!infer_response.id().empty()) {
+        timer_itr = stream->request_timers_by_id_.find(infer_response.id());
+      }
+      if (timer_itr != stream->request_timers_by_id_.end()) {
+        StreamRequestTimer& request_timer = timer_itr->second;
+        if (!empty_response) {
+          if (request_timer.response_count == 0) {
+            request_timer.timer->CaptureTimestamp(
+                RequestTimers::Kind::FIRST_RESPONSE);
+          }
+          request_timer.response_count++;
+        }
+        if (final_response || !response->error_message().empty()) {
+          timer = std::move(request_timer.timer);
+          response_count = request_timer.response_count;
+          stream->request_timers_by_id_.erase(timer_itr);
+        }
+      } else if (
+          infer_response.id().empty() &&
+          !stream->ongoing_request_timers_.empty()) {
+        timer = std::move(stream->ongoing_request_timers_.front());
+        stream->ongoing_request_timers_.pop();
       }
     }
 
     InferResult* stream_result;
-    // FIXME, DLIS-1263 there is no 1:1 mapping between
-    // requests and response for decoupled streaming case
-    // hence, this method will record incorrect statistics
-    // for decoupled case.
     if (timer.get() != nullptr) {
       timer->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
     }
     InferResultGrpc::Create(&stream_result, response);
     if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
       timer->CaptureTimestamp(RequestTimers::Kind::RECV_END);
       timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
-      Error err = UpdateInferStat(*timer);
+      Error err = UpdateInferStat(*timer, response_count);
       if (!err.IsOk()) {
         std::cerr << "Failed to update context stat: " << err << std::endl;
       }
@@ -1568,43 +3019,79 @@ InferenceServerGrpcClient::AsyncStreamTransfer()
       std::cout << response->DebugString() << std::endl;
     }
     stream_callback_(stream_result);
-    response = std::make_shared<inference::ModelStreamInferResponse>();
+    response = stream->response_pool_->Acquire();
   }
-  grpc_stream_->Finish();
+  stream->grpc_stream_->Finish();
 }
 
 InferenceServerGrpcClient::InferenceServerGrpcClient(
     const std::string& url, bool verbose, bool use_ssl,
     const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
-    const bool use_cached_channel)
-    : InferenceServerClient(verbose)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
+    : InferenceServerClient(verbose), url_(url),
+      client_options_(client_options), next_completion_queue_(0),
+      callback_rpc_count_(0), next_stream_(0), enable_stream_stats_(false)
 {
-  stub_ = GetStub(
-      url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose);
+  if (client_options.response_cache_byte_size > 0) {
+    response_cache_.reset(new ResponseCache(
+        client_options.response_cache_byte_size,
+        client_options.response_cache_ttl_us));
+  }
+  if (client_options.max_outstanding_requests > 0) {
+    outstanding_limiter_.reset(new OutstandingLimiter(
+        client_options.max_outstanding_requests,
+        client_options.outstanding_overload));
+  }
+  if (client_options.channel_pool_size > 0) {
+    channel_pool_.reset(new GrpcChannelPool(
+        url, use_ssl, ssl_options, channel_args,
+        client_options.channel_pool_size, client_options.channel_selection,
+        verbose));
+    stub_ = channel_pool_->DefaultStub();
+  } else {
+    stub_ = GetStub(
+        url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose,
+        &channel_);
+    generic_stub_ = std::make_shared<grpc::GenericStub>(channel_);
+  }
+  const size_t completion_queue_count =
+      std::max<size_t>(1, client_options.completion_queue_count);
+  for (size_t i = 0; i < completion_queue_count; ++i) {
+    async_request_completion_queues_.emplace_back(new grpc::CompletionQueue());
+  }
 }
 
 InferenceServerGrpcClient::~InferenceServerGrpcClient()
 {
+  {
+    std::unique_lock<std::mutex> lock(callback_rpc_mutex_);
+    callback_rpc_cv_.wait(lock, [this] { return callback_rpc_count_ == 0; });
+  }
+
   exiting_ = true;
-  // Close complete queue and wait for the worker thread to return
-  async_request_completion_queue_.Shutdown();
+  // Close complete queues and wait for the worker threads to return
+  for (auto& completion_queue : async_request_completion_queues_) {
+    completion_queue->Shutdown();
+  }
 
-  // thread not joinable if AsyncInfer() is not called
-  // (it is default constructed thread before the first AsyncInfer() call)
-  if (worker_.joinable()) {
-    worker_.join();
+  // no worker threads if AsyncInfer() is not called
+  for (auto& worker : async_request_workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
   }
 
-  bool has_next = true;
-  GrpcInferRequest* async_request;
-  bool ok;
-  do {
-    has_next =
-        async_request_completion_queue_.Next((void**)&async_request, &ok);
-    if (has_next && async_request != nullptr) {
-      delete async_request;
-    }
-  } while (has_next);
+  for (auto& completion_queue : async_request_completion_queues_) {
+    bool has_next = true;
+    GrpcInferRequest* async_request;
+    bool ok;
+    do {
+      has_next = completion_queue->Next((void**)&async_request, &ok);
+      if (has_next && async_request != nullptr) {
+        delete async_request;
+      }
+    } while (has_next);
+  }
 
   StopStream();
 }
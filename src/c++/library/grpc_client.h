@@ -27,8 +27,13 @@
 
 /// \file
 
+#include <grpcpp/generic/generic_stub.h>
 #include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <mutex>
 #include <queue>
+#include <thread>
+#include <vector>
 #include "common.h"
 #include "grpc_service.grpc.pb.h"
 #include "ipc.h"
@@ -40,6 +45,11 @@ namespace triton { namespace client {
 /// metadata
 typedef std::map<std::string, std::string> Headers;
 
+class GrpcArenaInferRequest;
+class GrpcChannelPool;
+class GrpcInferRequest;
+class GrpcStream;
+
 struct SslOptions {
   explicit SslOptions() {}
   // File containing the PEM encoding of the server root certificates.
@@ -81,12 +91,119 @@ struct KeepAliveOptions {
   int http2_max_pings_without_data;
 };
 
+// The options for configuring how the client handles asynchronous requests.
+struct GrpcClientOptions {
+  // How the channel of each inference is chosen among the channels of the
+  // pool, see 'channel_pool_size'.
+  enum class ChannelSelection {
+    // The channels are used in turn.
+    ROUND_ROBIN,
+    // The channel with the fewest RPCs in progress is used.
+    LEAST_OUTSTANDING
+  };
+
+  explicit GrpcClientOptions()
+      : completion_queue_count(1), infer_multi_max_in_flight(64),
+        channel_pool_size(0),
+        channel_selection(ChannelSelection::LEAST_OUTSTANDING),
+        use_callback_api(false), response_cache_byte_size(0),
+        response_cache_ttl_us(0), max_outstanding_requests(0),
+        outstanding_overload(OutstandingOverload::BLOCK),
+        zero_copy_input_threshold(0), alias_output_contents(false),
+        adaptive_compression(false),
+        adaptive_compression_min_byte_size(64 * 1024),
+        adaptive_compression_max_entropy(6.0)
+  {
+  }
+  // The number of completion queues used by AsyncInfer(), each drained by its
+  // own thread. Requests are assigned to the queues in round-robin order, so
+  // with more than one queue the callbacks may be invoked concurrently from
+  // different threads and must be thread-safe. The default value is 1.
+  size_t completion_queue_count;
+  // The maximum number of requests of an InferMulti() call that are sent to
+  // the server without having received their responses. The default value
+  // is 64.
+  size_t infer_multi_max_in_flight;
+  // The number of channels, each with its own HTTP/2 connection, that the
+  // client opens to the server for its inferences. When non-zero, every
+  // Infer(), AsyncInfer() and stream picks one of these channels according
+  // to 'channel_selection', and a channel found in TRANSIENT_FAILURE is
+  // replaced by a new one. The channels are not shared with other clients.
+  // The default value 0 uses a single channel, shared with other clients
+  // as set by 'use_cached_channel'.
+  size_t channel_pool_size;
+  ChannelSelection channel_selection;
+  // Whether AsyncInfer() uses the gRPC callback API instead of the
+  // completion queues. The callbacks then run directly on the threads of
+  // the gRPC library, which saves a thread switch per request, and must be
+  // thread-safe. 'completion_queue_count' is ignored. The default value is
+  // false.
+  bool use_callback_api;
+  // The total byte size of the responses kept by the client-side response
+  // cache. When non-zero, Infer() calls with the same model, inputs and
+  // requested outputs as a recent successful call get its cached result
+  // without contacting the server, including its request id. Calls in a
+  // sequence or using shared memory or user buffers are not cached. Hits
+  // and misses are counted in InferStat. The default value 0 disables the
+  // cache.
+  size_t response_cache_byte_size;
+  // How long a cached response is used, in microseconds. The default value
+  // 0 keeps responses until they are evicted.
+  uint64_t response_cache_ttl_us;
+  // The maximum number of AsyncInfer() requests of the client in flight,
+  // see OutstandingRequestCount(). A request beyond it waits for another to
+  // complete or fails as set by 'outstanding_overload'. 0 means there is no
+  // limit. The default value is 0.
+  size_t max_outstanding_requests;
+  // What AsyncInfer() does when 'max_outstanding_requests' requests are in
+  // flight. With OutstandingOverload::REJECT it fails with an error for
+  // which IsBusy() is true, and the function set by SetCapacityCallback()
+  // is invoked once a request completes. The default value is
+  // OutstandingOverload::BLOCK, which must not be used when AsyncInfer() is
+  // called from the callback of another request.
+  OutstandingOverload outstanding_overload;
+  // The byte size from which an input of an AsyncInfer() request is sent
+  // without being copied into the request message. When an input not in
+  // shared memory is at least this large, the request is serialized by the
+  // client: the message without its input data, followed by slices that
+  // reference the buffers of the inputs. The buffers added with
+  // InferInput::AppendRaw() must then stay valid until the callback of the
+  // request is invoked, buffers added with InferInput::AppendShared() are
+  // kept alive by the request. Prepared requests are always copied. The
+  // default value 0 disables the zero-copy path.
+  size_t zero_copy_input_threshold;
+  // Whether the results of AsyncInfer() return the output data as views
+  // into the received response instead of copies of it. The response is
+  // then parsed by the client, which keeps the received message alive as
+  // long as the result. A response received in several pieces is gathered
+  // into one buffer first. The default value is false.
+  bool alias_output_contents;
+  // Whether the client chooses the compression of each Infer() and
+  // AsyncInfer() request instead of using the algorithm passed to the call.
+  // A request is compressed when its inputs not in shared memory are at
+  // least 'adaptive_compression_min_byte_size' bytes and a sample of them
+  // has at most 'adaptive_compression_max_entropy' bits of entropy per
+  // byte, as sparse or low-precision tensors have. It is then compressed
+  // with the algorithm passed to the call, or GRPC_COMPRESS_DEFLATE if that
+  // is GRPC_COMPRESS_NONE. The choices are counted in InferStat. The
+  // default value is false.
+  bool adaptive_compression;
+  // The default value is 64 KB.
+  size_t adaptive_compression_min_byte_size;
+  // The default value is 6.0, for an expected size reduction of 25%.
+  double adaptive_compression_max_entropy;
+};
+
 //==============================================================================
 /// An InferenceServerGrpcClient object is used to perform any kind of
 /// communication with the InferenceServer using gRPC protocol.  Most
-/// of the methods are thread-safe except Infer, AsyncInfer, StartStream
-/// StopStream and AsyncStreamInfer. Calling these functions from different
-/// threads will cause undefined behavior.
+/// of the methods are thread-safe except StartStream, StopStream and
+/// AsyncStreamInfer. Calling these functions from different threads will
+/// cause undefined behavior. Infer and AsyncInfer may be called from many
+/// threads at once, which then share the channels of the client. The
+/// exception is that
+/// AsyncStreamInfer calls that go to different streams of the streams
+/// started by StartStreams() may be made concurrently.
 ///
 /// \code
 ///   std::unique_ptr<InferenceServerGrpcClient> client;
@@ -105,7 +222,8 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// This is the expected method for most users to create a GRPC client with
   /// the options directly exposed Triton.
   /// \param client Returns a new InferenceServerGrpcClient object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// 'unix://<socket-path>' for a server listening on a Unix domain socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param use_ssl If true use encrypted channel to the server.
@@ -116,13 +234,16 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param use_cached_channel If false, a new channel is created for each
   /// new client instance. When true, re-use old channels from cache for new
   /// client instances. The default value is true.
+  /// \param client_options Specifies the options for handling asynchronous
+  /// requests, see GrpcClientOptions.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerGrpcClient>* client,
       const std::string& server_url, bool verbose = false, bool use_ssl = false,
       const SslOptions& ssl_options = SslOptions(),
       const KeepAliveOptions& keepalive_options = KeepAliveOptions(),
-      const bool use_cached_channel = true);
+      const bool use_cached_channel = true,
+      const GrpcClientOptions& client_options = GrpcClientOptions());
 
   /// Create a client that can be used to communicate with the server.
   /// This method is available for advanced users who need to specify custom
@@ -133,7 +254,8 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// to this method are correct and complete, and are set at the user's
   /// own risk. For example, GRPC KeepAlive options may be specified directly
   /// in this argument rather than passing a KeepAliveOptions object.
-  /// \param server_url The inference server name and port.
+  /// \param server_url The inference server name and port, or
+  /// 'unix://<socket-path>' for a server listening on a Unix domain socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param use_ssl If true use encrypted channel to the server.
@@ -142,13 +264,27 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param use_cached_channel If false, a new channel is created for each
   /// new client instance. When true, re-use old channels from cache for new
   /// client instances. The default value is true.
+  /// \param client_options Specifies the options for handling asynchronous
+  /// requests, see GrpcClientOptions.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerGrpcClient>* client,
       const std::string& server_url, const grpc::ChannelArguments& channel_args,
       bool verbose = false, bool use_ssl = false,
       const SslOptions& ssl_options = SslOptions(),
-      const bool use_cached_channel = true);
+      const bool use_cached_channel = true,
+      const GrpcClientOptions& client_options = GrpcClientOptions());
+
+  /// Connect the channels of the client to the server ahead of the first
+  /// requests, so that they don't pay for the name resolution and the
+  /// TCP, TLS and HTTP/2 setup, and check that the server answers.
+  /// \param connection_count The number of channels of the pool to connect,
+  /// 0 for all of them. See GrpcClientOptions::channel_pool_size.
+  /// \param timeout_us The time to wait for the connections, in microseconds.
+  /// \return Error object indicating success or failure.
+  Error Warmup(
+      const size_t connection_count = 0,
+      const uint64_t timeout_us = 10000000);
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -389,6 +525,25 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   Error UnregisterCudaSharedMemory(
       const std::string& name = "", const Headers& headers = Headers());
 
+  /// Prepare a request to be run several times, only changing its id and
+  /// the data of its inputs, see InferOptions::prepared_request_. The
+  /// parameters, inputs and requested outputs are serialized once instead
+  /// of on every call.
+  /// \param prepared Returns the prepared request.
+  /// \param options The options of the request, its 'request_id_' is
+  /// ignored.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// The data of the inputs must be set, with the byte size it will have
+  /// in every call.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \return Error object indicating success or failure.
+  Error PrepareInfer(
+      std::shared_ptr<PreparedInferRequest>* prepared,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
   /// Run synchronous inference on server.
   /// \param result Returns the result of inference.
   /// \param options The options for inference request.
@@ -437,7 +592,81 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const Headers& headers = Headers(),
       grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
 
-  /// Run multiple synchronous inferences on server.
+  /// Run asynchronous inference on server, as the AsyncInfer() above, and
+  /// return a handle to cancel the request while it is in flight.
+  /// \param handle Returns the handle of the request.
+  /// \param callback The callback function to be invoked on request
+  /// completion.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      std::shared_ptr<AsyncRequestHandle>* handle, OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Run asynchronous inference on server, as the AsyncInfer() above, and
+  /// return a future for its result instead of invoking a callback. The
+  /// caller owns the InferResult obtained from the future and must delete
+  /// it.
+  /// \param result Returns the future of the result, only set when the
+  /// request is sent.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInferFuture(
+      std::future<InferResult*>* result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+#ifdef TRITON_CLIENT_HAS_COROUTINES
+  /// Run asynchronous inference on server, as the AsyncInfer() above, from
+  /// a C++20 coroutine, see InferAwaitable. The inputs and outputs are
+  /// sent when the returned object is awaited.
+  /// \param result Returns the result of the request.
+  /// \return The object to await for the error of the request.
+  InferAwaitable AsyncInferAwait(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE)
+  {
+    return InferAwaitable(
+        [=](OnCompleteFn callback) {
+          return AsyncInfer(
+              std::move(callback), options, inputs, outputs, headers,
+              compression_algorithm);
+        },
+        result);
+  }
+#endif  // TRITON_CLIENT_HAS_COROUTINES
+
+  /// Run multiple synchronous inferences on server. The requests are sent
+  /// concurrently, with at most GrpcClientOptions::infer_multi_max_in_flight
+  /// of them waiting for their responses at a time, and the results are
+  /// returned in the order of the requests. The requests that share a
+  /// sequence ID are sent one after another, each once the previous one of
+  /// the sequence has completed, so that they reach the server in order.
   /// \param results Returns the results of the inferences.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
@@ -515,14 +744,46 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       uint32_t stream_timeout = 0, const Headers& headers = Headers(),
       grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
 
-  /// Stops an active grpc bi-directional stream, if one available.
+  /// Starts several grpc bi-directional streams to send streaming
+  /// inferences. Each stream has its own flow control window and its own
+  /// thread reading the responses, so spreading requests over the streams
+  /// raises the throughput of a single client.
+  /// \param stream_count The number of streams to start.
+  /// \param callback The callback function to be invoked on receiving a
+  /// response at any of the streams. It may be invoked concurrently from the
+  /// reader threads of different streams.
+  /// \param enable_stats Indicates whether client library should record the
+  /// the client-side statistics for inference requests on the streams or
+  /// not. See StartStream().
+  /// \param stream_timeout Specifies the end-to-end timeout for each
+  /// streaming connection in microseconds. The default value is 0 which
+  /// means that there is no limitation on deadline.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure of the request.
+  Error StartStreams(
+      size_t stream_count, OnCompleteFn callback, bool enable_stats = true,
+      uint32_t stream_timeout = 0, const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Stops the active grpc bi-directional streams, if any.
   /// \return Error object indicating success or failure of the request.
   Error StopStream();
 
+  /// \return The number of active streams.
+  size_t StreamCount() const { return streams_.size(); }
+
   /// Runs an asynchronous inference over gRPC bi-directional streaming
   /// API. A stream must be established with a call to StartStream()
   /// before calling this function. All the results will be provided to the
-  /// callback function provided when starting the stream.
+  /// callback function provided when starting the stream. The request is
+  /// serialized and queued, and a writer thread of the stream sends it, so
+  /// the call does not wait on the network. When several streams are
+  /// active, the requests of a sequence all go to the stream selected by
+  /// their sequence id and other requests are spread over the streams in
+  /// turn.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
   /// \param outputs Optional vector of InferRequestedOutput describing how the
@@ -534,39 +795,124 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const std::vector<const InferRequestedOutput*>& outputs =
           std::vector<const InferRequestedOutput*>());
 
+  /// Runs an asynchronous inference over the stream selected by a key, so
+  /// that requests with the same key keep their order on one stream.
+  /// \param stream_key The key of the request. The request goes to stream
+  /// 'stream_key' modulo the number of active streams.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how the
+  /// output must be returned. If not provided then all the outputs in the model
+  /// config will be returned as default settings.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncStreamInfer(
+      size_t stream_key, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
  private:
   InferenceServerGrpcClient(
       const std::string& url, bool verbose, bool use_ssl,
       const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
-      const bool use_cached_channel);
+      const bool use_cached_channel, const GrpcClientOptions& client_options);
 
+  // Fill 'infer_request' for a call. 'prepared_id' records the prepared
+  // request the message was last filled from, so that a message reused
+  // with the same prepared request only needs its id and input data set.
+  // With 'skip_raw_contents' the data of the inputs not in shared memory is
+  // left out of the message, see SerializeZeroCopy().
   Error PreRunProcessing(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
-  void AsyncTransfer();
-  void AsyncStreamTransfer();
-
-  // The producer-consumer queue used to communicate asynchronously with
-  // the GRPC runtime.
-  grpc::CompletionQueue async_request_completion_queue_;
-
-  // Required to support the grpc bi-directional streaming API.
+      const std::vector<const InferRequestedOutput*>& outputs,
+      inference::ModelInferRequest* infer_request, uint64_t* prepared_id,
+      const bool skip_raw_contents = false);
+  // The compression of a request with 'inputs' when 'requested' is passed
+  // to the call, see GrpcClientOptions::adaptive_compression.
+  grpc_compression_algorithm ChooseCompression(
+      const std::vector<InferInput*>& inputs,
+      const grpc_compression_algorithm requested);
+  // Whether the inputs of an AsyncInfer() call are sent without being
+  // copied, see GrpcClientOptions::zero_copy_input_threshold.
+  bool UseZeroCopy(
+      const InferOptions& options, const std::vector<InferInput*>& inputs);
+  // Serialize 'infer_request', filled without its input data, into
+  // 'buffer' followed by the data of 'inputs' as slices referencing their
+  // buffers. The shared buffers of the inputs are added to 'input_refs'.
+  static Error SerializeZeroCopy(
+      const inference::ModelInferRequest& infer_request,
+      const std::vector<InferInput*>& inputs, grpc::ByteBuffer* buffer,
+      std::vector<std::shared_ptr<const uint8_t>>* input_refs);
+  // Copy the data of 'input' into 'raw_contents', reusing the capacity the
+  // string has from a previous request. Return the byte size copied.
+  static size_t CopyInputContents(InferInput* input, std::string* raw_contents);
+  Error FillPreparedRequest(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      inference::ModelInferRequest* infer_request, uint64_t* prepared_id);
+  std::unique_ptr<GrpcArenaInferRequest> AcquireArenaRequest();
+  void ReleaseArenaRequest(std::unique_ptr<GrpcArenaInferRequest>&& request);
+  void StartAsyncWorkers();
+  void AsyncTransfer(grpc::CompletionQueue* completion_queue);
+  // Build the result of a completed AsyncInfer() request, invoke its
+  // callback and free it.
+  void CompleteAsyncRequest(GrpcInferRequest* async_request);
+  // Pick the stub to run an inference RPC with. 'channel_index' returns
+  // the channel of the pool to give back once the RPC completes.
+  std::shared_ptr<inference::GRPCInferenceService::Stub> AcquireInferStub(
+      size_t* channel_index);
+  void ReleaseInferStub(const size_t channel_index);
+  // The generic stub of the channel returned by AcquireInferStub().
+  std::shared_ptr<grpc::GenericStub> InferGenericStub(
+      const size_t channel_index);
+  void AsyncStreamTransfer(GrpcStream* stream);
+  void AsyncStreamWrite(GrpcStream* stream);
+  // Check the repository index for the models changed since the entries
+  // of 'model_cache_' were cached, when it is due.
+  void RefreshModelCache(const Headers& headers);
+
+  // The server url, which keys the entries of the client in 'model_cache_'
+  const std::string url_;
+  // The options for handling asynchronous requests.
+  GrpcClientOptions client_options_;
+
+  // The producer-consumer queues used to communicate asynchronously with
+  // the GRPC runtime, each one is drained by the worker thread at the same
+  // index. The workers are started on the first asynchronous request.
+  std::vector<std::unique_ptr<grpc::CompletionQueue>>
+      async_request_completion_queues_;
+  std::vector<std::thread> async_request_workers_;
+  std::once_flag async_request_workers_started_;
+  std::atomic<size_t> next_completion_queue_;
+
+  // The number of AsyncInfer() requests sent with the callback API that
+  // have not completed, waited for by the destructor.
+  std::mutex callback_rpc_mutex_;
+  std::condition_variable callback_rpc_cv_;
+  size_t callback_rpc_count_;
+
+  // Required to support the grpc bi-directional streaming API. Each
+  // active stream has its own reader thread.
   InferenceServerClient::OnCompleteFn stream_callback_;
-  std::thread stream_worker_;
-  std::shared_ptr<grpc::ClientReaderWriter<
-      inference::ModelInferRequest, inference::ModelStreamInferResponse>>
-      grpc_stream_;
-  grpc::ClientContext grpc_context_;
-
+  std::vector<std::unique_ptr<GrpcStream>> streams_;
+  std::atomic<size_t> next_stream_;
   bool enable_stream_stats_;
-  std::queue<std::unique_ptr<RequestTimers>> ongoing_stream_request_timers_;
-  std::mutex stream_mutex_;
 
   // GRPC end point.
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
-  // request for GRPC call, one request object can be used for multiple calls
-  // since it can be overwritten as soon as the GRPC send finishes.
-  inference::ModelInferRequest infer_request_;
+  // The channel of 'stub_', null if the client has its own pool.
+  std::shared_ptr<grpc::Channel> channel_;
+  // The stub sending the requests serialized by SerializeZeroCopy(), on the
+  // channel of 'stub_'.
+  std::shared_ptr<grpc::GenericStub> generic_stub_;
+  // The channels used for inferences, if the client has its own pool.
+  std::unique_ptr<GrpcChannelPool> channel_pool_;
+  // The client-side response cache, if enabled.
+  std::unique_ptr<ResponseCache> response_cache_;
+  // Arena-backed requests for Infer() and AsyncInfer(). Each in-flight
+  // request owns one, and it is returned here once the response is received
+  // so that its allocations are reused by the following requests.
+  std::mutex arena_pool_mutex_;
+  std::vector<std::unique_ptr<GrpcArenaInferRequest>> arena_pool_;
 };
 
 
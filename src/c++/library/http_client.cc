@@ -31,11 +31,28 @@
 #include <curl/curl.h>
 #include <zlib.h>
 #include <atomic>
+#include <cerrno>
 #include <climits>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <iostream>
+#include <set>
 #include "http_client.h"
+#include "io_uring_poller.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif  // !_WIN32
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif  // __linux__
 
 extern "C" {
 #include "cencode.h"
@@ -46,6 +63,11 @@ extern "C" {
 #define TRITONJSON_STATUSSUCCESS triton::client::Error::Success
 #include "triton/common/triton_json.h"
 
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 #ifdef _WIN32
 #define strncasecmp(x, y, z) _strnicmp(x, y, z)
 #undef min  // NOMINMAX did not resolve std::min compile error
@@ -116,6 +138,28 @@ GetQueryString(const Headers& query_params)
   return query_string;
 }
 
+// Append 's' to 'json' as a JSON string, with the characters that need it
+// escaped.
+void
+AppendJsonString(const std::string& s, std::string* json)
+{
+  static const char kHexDigits[] = "0123456789abcdef";
+  json->push_back('"');
+  for (const char c : s) {
+    if ((c == '"') || (c == '\\')) {
+      json->push_back('\\');
+      json->push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      json->append("\\u00");
+      json->push_back(kHexDigits[(c >> 4) & 0xf]);
+      json->push_back(kHexDigits[c & 0xf]);
+    } else {
+      json->push_back(c);
+    }
+  }
+  json->push_back('"');
+}
+
 // Encodes the contents of the provided buffer into base64 string. Note the
 // string is not guaranteed to be null-terminated. Must rely on the returned
 // encoded size to get the right contents.
@@ -212,6 +256,180 @@ CompressData(
   return Error::Success;
 }
 
+// Compress 'byte_size' bytes of 'source' starting at 'offset' into raw
+// deflate data in 'chunk', computing the checksum of the data for the
+// format of 'type'. The data ends on a byte boundary so that chunks compressed
+// independently can be concatenated, and the last chunk ends the stream.
+Error
+CompressChunk(
+    const InferenceServerHttpClient::CompressionType type,
+    const std::deque<std::pair<uint8_t*, size_t>>& source, const size_t offset,
+    const size_t byte_size, const bool last_chunk,
+    std::pair<std::unique_ptr<char[]>, size_t>* chunk, uLong* checksum)
+{
+  const bool gzip = (type == InferenceServerHttpClient::CompressionType::GZIP);
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  if (deflateInit2(
+          &stream, Z_DEFAULT_COMPRESSION /* level */, Z_DEFLATED /* method */,
+          -15 /* windowBits, raw deflate */, 8 /* memLevel */,
+          Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
+    return Error("failed to initialize state for data compression");
+  }
+  std::unique_ptr<z_stream, decltype(&deflateEnd)> managed_stream(
+      &stream, deflateEnd);
+
+  // Room for the worst case and the empty block of the sync flush.
+  const size_t reserved_byte_size = deflateBound(&stream, byte_size) + 16;
+  chunk->first.reset(new char[reserved_byte_size]);
+  stream.next_out = reinterpret_cast<unsigned char*>(chunk->first.get());
+  stream.avail_out = reserved_byte_size;
+
+  *checksum = gzip ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+  size_t source_offset = 0;
+  size_t remaining_byte_size = byte_size;
+  for (auto it = source.begin();
+       (it != source.end()) && (remaining_byte_size > 0); ++it) {
+    if ((source_offset + it->second) <= offset) {
+      source_offset += it->second;
+      continue;
+    }
+    const size_t begin =
+        (offset > source_offset) ? (offset - source_offset) : 0;
+    const size_t length = std::min(it->second - begin, remaining_byte_size);
+    source_offset += it->second;
+    remaining_byte_size -= length;
+
+    stream.next_in = reinterpret_cast<unsigned char*>(it->first + begin);
+    stream.avail_in = length;
+    *checksum = gzip ? crc32(*checksum, stream.next_in, length)
+                     : adler32(*checksum, stream.next_in, length);
+    if (deflate(&stream, Z_NO_FLUSH) == Z_STREAM_ERROR) {
+      return Error("encountered inconsistent stream state during compression");
+    }
+  }
+
+  const int ret = deflate(&stream, last_chunk ? Z_FINISH : Z_SYNC_FLUSH);
+  if ((ret == Z_STREAM_ERROR) || (stream.avail_in != 0) ||
+      (last_chunk && (ret != Z_STREAM_END))) {
+    return Error("encountered inconsistent stream state during compression");
+  }
+  chunk->second = reserved_byte_size - stream.avail_out;
+  return Error::Success;
+}
+
+// Append the gzip (RFC 1952) or zlib (RFC 1950) header with the default
+// settings of the format of 'type' to 'compressed_data'.
+void
+AppendCompressionHeader(
+    const InferenceServerHttpClient::CompressionType type,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  std::unique_ptr<char[]> header(new char[10]);
+  size_t header_byte_size = 0;
+  if (type == InferenceServerHttpClient::CompressionType::GZIP) {
+    const unsigned char gzip_header[10] = {0x1f, 0x8b, 8, 0, 0,
+                                           0,    0,    0, 0, 0xff};
+    memcpy(header.get(), gzip_header, sizeof(gzip_header));
+    header_byte_size = sizeof(gzip_header);
+  } else {
+    header[0] = 0x78;
+    header[1] = static_cast<char>(0x9c);
+    header_byte_size = 2;
+  }
+  compressed_data->emplace_back(std::move(header), header_byte_size);
+}
+
+// Append the trailer of the format of 'type' for 'source_byte_size' bytes of
+// data with 'checksum' to 'compressed_data'.
+void
+AppendCompressionTrailer(
+    const InferenceServerHttpClient::CompressionType type, const uLong checksum,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  // gzip trailer is CRC-32 and input size in little endian, zlib trailer is
+  // Adler-32 in big endian.
+  std::unique_ptr<char[]> trailer(new char[8]);
+  if (type == InferenceServerHttpClient::CompressionType::GZIP) {
+    const uint32_t input_byte_size = static_cast<uint32_t>(source_byte_size);
+    for (size_t i = 0; i < 4; ++i) {
+      trailer[i] = static_cast<char>((checksum >> (8 * i)) & 0xff);
+      trailer[4 + i] = static_cast<char>((input_byte_size >> (8 * i)) & 0xff);
+    }
+    compressed_data->emplace_back(std::move(trailer), 8);
+  } else {
+    for (size_t i = 0; i < 4; ++i) {
+      trailer[i] = static_cast<char>((checksum >> (8 * (3 - i))) & 0xff);
+    }
+    compressed_data->emplace_back(std::move(trailer), 4);
+  }
+}
+
+// Compress 'source' in chunks of 'chunk_byte_size' bytes using up to
+// 'thread_count' threads. The chunks are concatenated between the header and
+// the trailer of the format of 'type', whose checksum is combined from the
+// checksums of the chunks.
+Error
+CompressDataParallel(
+    const InferenceServerHttpClient::CompressionType type,
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size, const size_t chunk_byte_size,
+    const size_t thread_count,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  const bool gzip = (type == InferenceServerHttpClient::CompressionType::GZIP);
+  if (type == InferenceServerHttpClient::CompressionType::NONE) {
+    return Error("can't compress data with NONE type");
+  }
+
+  const size_t chunk_count =
+      (source_byte_size + chunk_byte_size - 1) / chunk_byte_size;
+  std::vector<std::pair<std::unique_ptr<char[]>, size_t>> chunks(chunk_count);
+  std::vector<uLong> checksums(chunk_count);
+  std::vector<Error> errors(chunk_count);
+  std::atomic<size_t> next_chunk(0);
+  auto compress_chunks = [&]() {
+    size_t idx;
+    while ((idx = next_chunk++) < chunk_count) {
+      const size_t offset = idx * chunk_byte_size;
+      errors[idx] = CompressChunk(
+          type, source, offset,
+          std::min(chunk_byte_size, source_byte_size - offset),
+          (idx + 1) == chunk_count, &chunks[idx], &checksums[idx]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < std::min(thread_count, chunk_count); ++i) {
+    workers.emplace_back(compress_chunks);
+  }
+  compress_chunks();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  uLong checksum = gzip ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+  for (size_t idx = 0; idx < chunk_count; ++idx) {
+    if (!errors[idx].IsOk()) {
+      return errors[idx];
+    }
+    const z_off_t byte_size =
+        std::min(chunk_byte_size, source_byte_size - idx * chunk_byte_size);
+    checksum = gzip ? crc32_combine(checksum, checksums[idx], byte_size)
+                    : adler32_combine(checksum, checksums[idx], byte_size);
+  }
+
+  AppendCompressionHeader(type, compressed_data);
+  for (auto& chunk : chunks) {
+    compressed_data->emplace_back(std::move(chunk));
+  }
+  AppendCompressionTrailer(type, checksum, source_byte_size, compressed_data);
+
+  return Error::Success;
+}
+
 Error
 ParseSslCertType(
     HttpSslOptions::CERTTYPE cert_type, std::string* curl_cert_type)
@@ -279,8 +497,460 @@ SetSSLCurlOptions(CURL** curl, const HttpSslOptions& ssl_options)
   return Error::Success;
 }
 
+// Select the HTTP version of the transfer according to 'client_options'.
+// HTTP/2 is negotiated with ALPN for 'https://', plaintext requests use
+// HTTP/2 with prior knowledge (h2c) as there is no upgrade for POST bodies.
+void
+SetHttpVersionCurlOptions(
+    CURL* curl, const std::string& url, const HttpClientOptions& client_options)
+{
+  if (!client_options.http2) {
+    return;
+  }
+  const bool tls = (url.size() > 8) && !strncasecmp(url.c_str(), "https://", 8);
+  curl_easy_setopt(
+      curl, CURLOPT_HTTP_VERSION,
+      tls ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+  // Wait for an existing connection to be available for multiplexing
+  // rather than opening a new one.
+  curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+}
+
+// The path of the socket of a 'unix://<path>' or 'unix:<path>' server url,
+// or an empty string for other urls. The requests are then sent to
+// 'localhost' over the socket.
+std::string
+UnixSocketPath(const std::string& url)
+{
+  if (strncasecmp(url.c_str(), "unix:", 5) != 0) {
+    return "";
+  }
+  std::string path = url.substr(5);
+  if (path.compare(0, 2, "//") == 0) {
+    path.erase(0, 2);
+  }
+  return path;
+}
+
+// The transfer rate limits of the inference requests, which libcurl keeps by
+// pausing the transfer rather than blocking in the callbacks
+void
+SetTransferRateCurlOptions(
+    CURL* curl, const HttpClientOptions& client_options)
+{
+  if (client_options.max_send_bytes_per_second != 0) {
+    curl_easy_setopt(
+        curl, CURLOPT_MAX_SEND_SPEED_LARGE,
+        static_cast<curl_off_t>(client_options.max_send_bytes_per_second));
+  }
+  if (client_options.max_recv_bytes_per_second != 0) {
+    curl_easy_setopt(
+        curl, CURLOPT_MAX_RECV_SPEED_LARGE,
+        static_cast<curl_off_t>(client_options.max_recv_bytes_per_second));
+  }
+}
+
+void
+SetUnixSocketCurlOptions(CURL* curl, const std::string& unix_socket_path)
+{
+  if (!unix_socket_path.empty()) {
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, unix_socket_path.c_str());
+  }
+}
+
+// Lock callbacks of the share handle of a client, 'userp' points to one
+// mutex per kind of shared data.
+void
+ShareLock(CURL* curl, curl_lock_data data, curl_lock_access access, void* userp)
+{
+  reinterpret_cast<std::mutex*>(userp)[data].lock();
+}
+
+void
+ShareUnlock(CURL* curl, curl_lock_data data, void* userp)
+{
+  reinterpret_cast<std::mutex*>(userp)[data].unlock();
+}
+
+// Make 'curl' use the share handle of the client, if any. The connection
+// cache is not shared so that the asynchronous requests keep the connection
+// limit and the HTTP/2 multiplexing of the multi handle.
+void
+SetShareCurlOptions(CURL* curl, void* share_handle)
+{
+  if (share_handle != nullptr) {
+    curl_easy_setopt(curl, CURLOPT_SHARE, share_handle);
+  }
+}
+
+#ifndef _WIN32
+// Helpers for the zero-copy transfer. The request is written with sendmsg()
+// on the socket of a libcurl 'CURLOPT_CONNECT_ONLY' connection and the
+// response is read back from the same socket. libcurl sockets are
+// non-blocking so all the operations poll() the socket while waiting.
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif  // !MSG_NOSIGNAL
+
+constexpr char kTransferEncodingHTTPHeader[] = "Transfer-Encoding";
+constexpr char kConnectionHTTPHeader[] = "Connection";
+constexpr size_t kZeroCopyRecvChunkSize = 64 * 1024;
+
+uint64_t
+SteadyNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Wait until 'fd' is ready for 'events'. 'timed_out' is set if
+// 'deadline_ns' is reached first, a 'deadline_ns' of 0 means no deadline.
+Error
+WaitSocket(
+    const int fd, const short events, const uint64_t deadline_ns,
+    bool* timed_out)
+{
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = events;
+  while (true) {
+    int timeout_ms = -1;
+    if (deadline_ns != 0) {
+      const uint64_t now_ns = SteadyNowNs();
+      timeout_ms =
+          (now_ns >= deadline_ns)
+              ? 0
+              : (int)std::min<uint64_t>(
+                    (deadline_ns - now_ns + 999999) / 1000000, INT_MAX);
+    }
+    pfd.revents = 0;
+    const int rc = poll(&pfd, 1, timeout_ms);
+    if (rc > 0) {
+      return Error::Success;
+    } else if (rc == 0) {
+      *timed_out = true;
+      return Error::Success;
+    } else if (errno != EINTR) {
+      return Error(
+          "failed to poll connection: " + std::string(strerror(errno)));
+    }
+  }
+}
+
+// Write all the buffers described by 'iovs' to 'fd'. 'iovs' is modified to
+// track the progress of partial writes.
+Error
+SendAll(
+    const int fd, std::vector<struct iovec>* iovs, const uint64_t deadline_ns,
+    bool* timed_out)
+{
+  size_t idx = 0;
+  while (idx < iovs->size()) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iovs->data() + idx;
+    msg.msg_iovlen = std::min<size_t>(iovs->size() - idx, IOV_MAX);
+    const ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      } else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        Error err = WaitSocket(fd, POLLOUT, deadline_ns, timed_out);
+        if (!err.IsOk() || *timed_out) {
+          return err;
+        }
+        continue;
+      }
+      return Error(
+          "failed to send inference request: " + std::string(strerror(errno)));
+    }
+
+    // Skip the buffers that are completely sent and advance into the
+    // partially sent one.
+    size_t remaining = sent;
+    while ((idx < iovs->size()) && (remaining >= (*iovs)[idx].iov_len)) {
+      remaining -= (*iovs)[idx].iov_len;
+      ++idx;
+    }
+    if (remaining > 0) {
+      (*iovs)[idx].iov_base =
+          reinterpret_cast<char*>((*iovs)[idx].iov_base) + remaining;
+      (*iovs)[idx].iov_len -= remaining;
+    }
+  }
+  return Error::Success;
+}
+
+// Receive up to 'size' bytes into 'buf'. 'received' is set to 0 if the
+// connection is closed by the server.
+Error
+RecvSome(
+    const int fd, char* buf, const size_t size, const uint64_t deadline_ns,
+    size_t* received, bool* timed_out)
+{
+  while (true) {
+    const ssize_t rc = recv(fd, buf, size, 0);
+    if (rc >= 0) {
+      *received = rc;
+      return Error::Success;
+    } else if (errno == EINTR) {
+      continue;
+    } else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+      Error err = WaitSocket(fd, POLLIN, deadline_ns, timed_out);
+      if (!err.IsOk() || *timed_out) {
+        return err;
+      }
+      continue;
+    }
+    return Error(
+        "failed to receive inference response: " +
+        std::string(strerror(errno)));
+  }
+}
+
+// Reads a HTTP/1.1 response from 'fd'. The body is stored in 'body' and the
+// values of the relevant headers are returned. The timer captures
+// RECV_START on the first received byte and RECV_END once the body is
+// complete. 'received_any' indicates whether any byte of the response has
+// been received, which is used to decide if the request can be retried on a
+// new connection.
+class ZeroCopyResponseReader {
+ public:
+  ZeroCopyResponseReader(
+      const int fd, const uint64_t deadline_ns, RequestTimers* timer)
+      : fd_(fd), deadline_ns_(deadline_ns), timer_(timer), timed_out_(false),
+        received_any_(false)
+  {
+  }
+
+  Error Read(
+      long* http_code, size_t* json_size, std::string* body, bool* keep_alive);
+
+  bool TimedOut() const { return timed_out_; }
+  bool ReceivedAny() const { return received_any_; }
+
+ private:
+  // Receive more bytes at the end of 'pending_'.
+  Error Fill();
+  Error ReadChunked(std::string* body);
+
+  const int fd_;
+  const uint64_t deadline_ns_;
+  RequestTimers* timer_;
+  bool timed_out_;
+  bool received_any_;
+  // Bytes that are received but not yet consumed
+  std::string pending_;
+};
+
+Error
+ZeroCopyResponseReader::Fill()
+{
+  char buf[kZeroCopyRecvChunkSize];
+  size_t received = 0;
+  Error err =
+      RecvSome(fd_, buf, sizeof(buf), deadline_ns_, &received, &timed_out_);
+  if (!err.IsOk() || timed_out_) {
+    return err;
+  }
+  if (received == 0) {
+    return Error("connection closed by server");
+  }
+  if (!received_any_) {
+    received_any_ = true;
+    timer_->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  }
+  pending_.append(buf, received);
+  return Error::Success;
+}
+
+Error
+ZeroCopyResponseReader::Read(
+    long* http_code, size_t* json_size, std::string* body, bool* keep_alive)
+{
+  size_t content_length = 0;
+  bool has_content_length = false;
+  bool chunked = false;
+  *json_size = 0;
+  *keep_alive = true;
+
+  // Read the status line and headers, skipping any informational (1xx)
+  // response.
+  do {
+    size_t header_end;
+    while ((header_end = pending_.find("\r\n\r\n")) == std::string::npos) {
+      Error err = Fill();
+      if (!err.IsOk() || timed_out_) {
+        return err;
+      }
+    }
+
+    size_t line_end = pending_.find("\r\n");
+    const size_t code_start = pending_.find(' ');
+    if ((pending_.compare(0, 5, "HTTP/") != 0) || (code_start > line_end)) {
+      return Error("received malformed HTTP response");
+    }
+    *http_code = std::strtol(pending_.c_str() + code_start + 1, nullptr, 10);
+    if (pending_.compare(0, 8, "HTTP/1.0") == 0) {
+      *keep_alive = false;
+    }
+
+    while (line_end < header_end) {
+      const size_t line_start = line_end + 2;
+      line_end = pending_.find("\r\n", line_start);
+      const size_t colon = pending_.find(':', line_start);
+      if (colon >= line_end) {
+        continue;
+      }
+      const char* name = pending_.c_str() + line_start;
+      const size_t name_len = colon - line_start;
+      size_t value_start = colon + 1;
+      while ((value_start < line_end) && (pending_[value_start] == ' ')) {
+        ++value_start;
+      }
+      const std::string value =
+          pending_.substr(value_start, line_end - value_start);
+      if ((name_len == strlen(kInferHeaderContentLengthHTTPHeader)) &&
+          !strncasecmp(name, kInferHeaderContentLengthHTTPHeader, name_len)) {
+        *json_size = std::stoul(value);
+      } else if (
+          (name_len == strlen(kContentLengthHTTPHeader)) &&
+          !strncasecmp(name, kContentLengthHTTPHeader, name_len)) {
+        content_length = std::stoul(value);
+        has_content_length = true;
+      } else if (
+          (name_len == strlen(kTransferEncodingHTTPHeader)) &&
+          !strncasecmp(name, kTransferEncodingHTTPHeader, name_len)) {
+        chunked = (value.find("chunked") != std::string::npos);
+      } else if (
+          (name_len == strlen(kConnectionHTTPHeader)) &&
+          !strncasecmp(name, kConnectionHTTPHeader, name_len)) {
+        if (!strncasecmp(value.c_str(), "close", 5)) {
+          *keep_alive = false;
+        } else if (!strncasecmp(value.c_str(), "keep-alive", 10)) {
+          *keep_alive = true;
+        }
+      }
+    }
+    pending_.erase(0, header_end + 4);
+  } while ((*http_code >= 100) && (*http_code < 200));
+
+  if (chunked) {
+    Error err = ReadChunked(body);
+    if (!err.IsOk() || timed_out_) {
+      return err;
+    }
+  } else if (has_content_length) {
+    // Receive the rest of the body directly into its final storage.
+    size_t filled = std::min(pending_.size(), content_length);
+    body->resize(content_length);
+    std::copy(pending_.begin(), pending_.begin() + filled, body->begin());
+    pending_.clear();
+    while (filled < content_length) {
+      size_t received = 0;
+      Error err = RecvSome(
+          fd_, &(*body)[filled], content_length - filled, deadline_ns_,
+          &received, &timed_out_);
+      if (!err.IsOk() || timed_out_) {
+        return err;
+      }
+      if (received == 0) {
+        return Error("connection closed by server");
+      }
+      filled += received;
+    }
+  } else {
+    // The body is delimited by the end of the connection.
+    *keep_alive = false;
+    while (true) {
+      char buf[kZeroCopyRecvChunkSize];
+      size_t received = 0;
+      Error err =
+          RecvSome(fd_, buf, sizeof(buf), deadline_ns_, &received, &timed_out_);
+      if (!err.IsOk() || timed_out_) {
+        return err;
+      }
+      if (received == 0) {
+        break;
+      }
+      pending_.append(buf, received);
+    }
+    body->swap(pending_);
+  }
+
+  timer_->CaptureTimestamp(RequestTimers::Kind::RECV_END);
+  return Error::Success;
+}
+
+Error
+ZeroCopyResponseReader::ReadChunked(std::string* body)
+{
+  body->clear();
+  while (true) {
+    size_t line_end;
+    while ((line_end = pending_.find("\r\n")) == std::string::npos) {
+      Error err = Fill();
+      if (!err.IsOk() || timed_out_) {
+        return err;
+      }
+    }
+    const size_t chunk_size = std::strtoul(pending_.c_str(), nullptr, 16);
+    if (chunk_size == 0) {
+      // Consume the optional trailers up to the terminating empty line.
+      while (pending_.find("\r\n\r\n", line_end) == std::string::npos) {
+        Error err = Fill();
+        if (!err.IsOk() || timed_out_) {
+          return err;
+        }
+      }
+      pending_.clear();
+      return Error::Success;
+    }
+    while (pending_.size() < (line_end + 2 + chunk_size + 2)) {
+      Error err = Fill();
+      if (!err.IsOk() || timed_out_) {
+        return err;
+      }
+    }
+    body->append(pending_, line_end + 2, chunk_size);
+    pending_.erase(0, line_end + 2 + chunk_size + 2);
+  }
+}
+#endif  // !_WIN32
+
 }  // namespace
 
+//==============================================================================
+// An HttpPreparedInferRequest holds the JSON header of a prepared request,
+// without the request id.
+//
+class HttpPreparedInferRequest : public PreparedInferRequest {
+ private:
+  friend class InferenceServerHttpClient;
+  friend class HttpInferRequest;
+
+  std::string header_;
+};
+
+//==============================================================================
+// An HttpCompressedInferInputs holds the input data of a request compressed
+// into raw deflate data that ends the stream, with the checksum of the data
+// for the format of 'type_', so that it can follow the compressed JSON
+// header of any request.
+//
+class HttpCompressedInferInputs : public CompressedInferInputs {
+ private:
+  friend class InferenceServerHttpClient;
+  friend class HttpInferRequest;
+
+  InferenceServerHttpClient::CompressionType type_;
+  size_t byte_size_;
+  uLong checksum_;
+  std::pair<std::unique_ptr<char[]>, size_t> data_;
+};
+
 //==============================================================================
 
 class HttpInferRequest : public InferRequest {
@@ -295,6 +965,12 @@ class HttpInferRequest : public InferRequest {
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs);
 
+  // Initialize the request for a generate_stream transfer, whose body is
+  // the JSON object of the generate extension, see
+  // InferenceServerHttpClient::AsyncStreamInfer().
+  Error InitializeStreamRequest(
+      const InferOptions& options, const std::vector<InferInput*>& inputs);
+
   // Adds the input data to be delivered to the server
   Error AddInput(uint8_t* buf, size_t byte_size);
 
@@ -302,16 +978,91 @@ class HttpInferRequest : public InferRequest {
   // actual amount copied in 'input_bytes'.
   Error GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes);
 
-  Error CompressInput(const InferenceServerHttpClient::CompressionType type);
+  // Compress the input data, in parallel chunks if 'chunk_byte_size' and
+  // 'thread_count' allow more than one, see
+  // HttpClientOptions::compression_thread_count.
+  Error CompressInput(
+      const InferenceServerHttpClient::CompressionType type,
+      const size_t chunk_byte_size = 0, const size_t thread_count = 1);
+
+  // Compress only the JSON header of the request, which must be the only
+  // data added, and send it followed by the input data already compressed
+  // in 'compressed_inputs'. 'inputs' must hold data of the byte size that
+  // was compressed.
+  Error UseCompressedInputs(
+      const InferenceServerHttpClient::CompressionType type,
+      const std::shared_ptr<CompressedInferInputs>& compressed_inputs,
+      const std::vector<InferInput*>& inputs);
+
+  // Prepare a pooled request object to be used for another request.
+  void Reuse(InferenceServerClient::OnCompleteFn callback);
+
+  // Ask for the transfer of the request to be aborted, see
+  // AsyncRequestHandle::Cancel().
+  void RequestCancel() { cancel_requested_ = true; }
+  bool CancelRequested() const { return cancel_requested_; }
+
+  // Consume the next part of the response body when the response is parsed
+  // incrementally, see HttpClientOptions::stream_response_outputs.
+  Error ParseResponseChunk(const char* buf, size_t byte_size);
+
+  // The byte size of the response body received.
+  size_t ResponseByteSize() const;
+
+  // The byte size of the request body before compression.
+  size_t UncompressedRequestByteSize() const
+  {
+    return (uncompressed_input_byte_size_ != 0) ? uncompressed_input_byte_size_
+                                                : total_input_byte_size_;
+  }
+
+  // Record the byte size of the response body as received on the wire,
+  // before 'curl' decompressed it.
+  void CaptureWireResponseByteSize(CURL* curl);
+
+  // The byte size of the response body as received on the wire.
+  size_t WireResponseByteSize() const
+  {
+    return (wire_response_byte_size_ != 0) ? wire_response_byte_size_
+                                           : ResponseByteSize();
+  }
 
  private:
   friend class InferenceServerHttpClient;
   friend class InferResultHttp;
+  friend class HttpInferRequestPool;
 
-  Error PrepareRequestJson(
+  // Build the JSON header of the request, with the request id only if
+  // 'add_id' is true.
+  static Error PrepareRequestJson(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs,
-      triton::common::TritonJson::Value* request_json);
+      triton::common::TritonJson::Value* request_json,
+      const bool add_id = true);
+
+  // Use the JSON header of 'options.prepared_request_' with the request id
+  // of 'options'.
+  Error SetPreparedJson(
+      const InferOptions& options, const std::vector<InferInput*>& inputs);
+
+  // The JSON header of the request.
+  const char* RequestJsonBase() const
+  {
+    return (prepared_json_ != nullptr) ? prepared_json_->data()
+                                       : request_json_.Base();
+  }
+  size_t RequestJsonSize() const
+  {
+    return (prepared_json_ != nullptr) ? prepared_json_->size()
+                                       : request_json_.Size();
+  }
+
+  // Record the binary outputs listed in the JSON header of the response.
+  Error PrepareStreamedOutputs();
+
+  // Parse the JSON header of the response into 'response_document_', on
+  // the first call only.
+  Error ParseResponseJson();
 
   // Pointer to the list of the HTTP request header, keep it such that it will
   // be valid during the transfer and can be freed once transfer is completed.
@@ -320,28 +1071,127 @@ class HttpInferRequest : public InferRequest {
   // HTTP response code for the inference request
   long http_code_;
 
+  // Whether the request was asked to be cancelled, and whether its transfer
+  // was aborted because of it
+  std::atomic<bool> cancel_requested_{false};
+  bool cancelled_{false};
+
+  // Selects the thread of HttpClientOptions::callback_thread_count that
+  // runs the callback.
+  uint64_t callback_key_{0};
+
   size_t total_input_byte_size_;
+  // The byte size of the request body before compression, 0 if the body is
+  // not compressed
+  size_t uncompressed_input_byte_size_{0};
+  // The byte size of the response body on the wire, 0 if not known
+  size_t wire_response_byte_size_{0};
 
   triton::common::TritonJson::WriteBuffer request_json_;
 
+  // The JSON header when the request was prepared, either the header of
+  // 'prepared_request_' or 'patched_json_' holding it with the request id.
+  // 'prepared_request_' keeps the header alive until the request is sent.
+  // The body of a generate_stream request is 'stream_body_'.
+  std::shared_ptr<PreparedInferRequest> prepared_request_;
+  std::string patched_json_;
+  std::string stream_body_;
+  const std::string* prepared_json_;
+
   // Buffer that accumulates the response body.
   std::unique_ptr<std::string> infer_response_buffer_;
 
   // The pointers to the input data.
   std::deque<std::pair<uint8_t*, size_t>> data_buffers_;
 
+  // The references to the shared input buffers in 'data_buffers_', held
+  // until the request is released.
+  std::vector<std::shared_ptr<const uint8_t>> shared_inputs_;
+
   // Placeholder for the compressed data
   std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data_;
 
+  // The input data compressed beforehand, kept alive until the request is
+  // sent.
+  std::shared_ptr<CompressedInferInputs> compressed_inputs_;
+
   size_t response_json_size_;
+
+  // The JSON header of the response, parsed in place in
+  // 'infer_response_buffer_' so that its strings point into the buffer
+  // instead of being copied. The results of response cache hits share it
+  // with the first result of the request.
+  rapidjson::Document response_document_;
+  bool response_json_parsed_{false};
+  Error response_json_status_;
+
+  // The state of the incremental response parsing. 'infer_response_buffer_'
+  // only holds the JSON header, the binary output data is kept in
+  // 'streamed_outputs_' in the order listed in the header.
+  struct StreamedOutput {
+    std::string name_;
+    size_t byte_size_;
+    size_t received_byte_size_;
+    // Where the data is written, either the user buffer of the output or
+    // 'data_'. nullptr if the data is passed to 'output_data_callback_'.
+    uint8_t* buffer_;
+    std::unique_ptr<uint8_t[]> data_;
+  };
+  bool stream_response_outputs_;
+  const HttpClientOptions::OnOutputDataFn* output_data_callback_;
+  std::string request_id_;
+  bool response_header_parsed_;
+  std::vector<StreamedOutput> streamed_outputs_;
+  size_t next_streamed_output_;
+
+  // The user buffers of the requested outputs, see
+  // InferRequestedOutput::SetUserBuffer().
+  std::map<std::string, std::pair<uint8_t*, size_t>> user_buffers_;
+
+  // The state of a generate_stream request, whose response is a stream of
+  // server-sent events. 'event_buffer_' holds the received part of the
+  // stream not parsed yet, 'event_data_' the data of the event being
+  // received.
+  bool event_stream_{false};
+  InferenceServerHttpClient* event_stream_client_{nullptr};
+  bool event_stream_stats_{false};
+  bool event_error_delivered_{false};
+  size_t event_byte_size_{0};
+  std::string event_buffer_;
+  std::string event_data_;
 };
 
 
 HttpInferRequest::HttpInferRequest(
     InferenceServerClient::OnCompleteFn callback, const bool verbose)
     : InferRequest(callback, verbose), header_list_(nullptr),
-      total_input_byte_size_(0), response_json_size_(0)
+      total_input_byte_size_(0), prepared_json_(nullptr),
+      response_json_size_(0), stream_response_outputs_(false),
+      output_data_callback_(nullptr),
+      response_header_parsed_(false), next_streamed_output_(0)
+{
+}
+
+size_t
+HttpInferRequest::ResponseByteSize() const
+{
+  size_t byte_size =
+      (infer_response_buffer_ != nullptr) ? infer_response_buffer_->size() : 0;
+  byte_size += event_byte_size_;
+  for (const auto& output : streamed_outputs_) {
+    byte_size += output.received_byte_size_;
+  }
+  return byte_size;
+}
+
+void
+HttpInferRequest::CaptureWireResponseByteSize(CURL* curl)
 {
+  curl_off_t byte_size = 0;
+  if (curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &byte_size) ==
+      CURLE_OK) {
+    wire_response_byte_size_ = static_cast<size_t>(byte_size);
+  }
 }
 
 HttpInferRequest::~HttpInferRequest()
@@ -357,25 +1207,266 @@ HttpInferRequest::InitializeRequest(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  data_buffers_ = {};
+  data_buffers_.clear();
+  shared_inputs_.clear();
   total_input_byte_size_ = 0;
+  uncompressed_input_byte_size_ = 0;
+  wire_response_byte_size_ = 0;
   http_code_ = 400;
 
-  triton::common::TritonJson::Value request_json(
-      triton::common::TritonJson::ValueType::OBJECT);
-  Error err = PrepareRequestJson(options, inputs, outputs, &request_json);
-  if (!err.IsOk()) {
-    return err;
-  }
-
-  request_json_.Clear();
-  request_json.Write(&request_json_);
-
+  if (options.prepared_request_ != nullptr) {
+    Error err = SetPreparedJson(options, inputs);
+    if (!err.IsOk()) {
+      return err;
+    }
+  } else {
+    prepared_request_.reset();
+    prepared_json_ = nullptr;
+
+    triton::common::TritonJson::Value request_json(
+        triton::common::TritonJson::ValueType::OBJECT);
+    Error err = PrepareRequestJson(options, inputs, outputs, &request_json);
+    if (!err.IsOk()) {
+      return err;
+    }
+
+    request_json_.Clear();
+    request_json.Write(&request_json_);
+  }
+
   // Add the buffer holding the json to be delivered first
-  AddInput((uint8_t*)request_json_.Base(), request_json_.Size());
+  AddInput((uint8_t*)RequestJsonBase(), RequestJsonSize());
+
+  // Prepare buffer to record the response, the buffer of a reused request
+  // keeps its capacity.
+  if (infer_response_buffer_ == nullptr) {
+    infer_response_buffer_.reset(new std::string());
+  } else {
+    infer_response_buffer_->clear();
+  }
+  request_id_ = options.request_id_;
+  response_header_parsed_ = false;
+  response_json_parsed_ = false;
+  streamed_outputs_.clear();
+  next_streamed_output_ = 0;
+
+  user_buffers_.clear();
+  for (const auto output : outputs) {
+    if (output->IsUserBuffer()) {
+      uint8_t* buf;
+      size_t byte_size;
+      output->UserBufferInfo(&buf, &byte_size);
+      user_buffers_.emplace(output->Name(), std::make_pair(buf, byte_size));
+    }
+  }
+
+  return Error::Success;
+}
+
+namespace {
+
+template <typename T>
+T
+ReadElement(const char* data)
+{
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+// Write the data of 'input' to 'writer' as the JSON value of the generate
+// extension, a scalar for an input of one element and an array otherwise.
+Error
+WriteGenerateInput(
+    InferInput* input, rapidjson::Writer<rapidjson::StringBuffer>* writer)
+{
+  if (input->IsSharedMemory()) {
+    return Error(
+        "input '" + input->Name() +
+        "' in shared memory can't be sent on a stream");
+  }
+  const DataType type = StringToDataType(input->Datatype());
+  if ((type == DataType::INVALID) || (type == DataType::FP16) ||
+      (type == DataType::BF16)) {
+    return Error(
+        "input '" + input->Name() + "' of datatype " + input->Datatype() +
+        " can't be sent on a stream");
+  }
+
+  Error err = input->PrepareForRequest();
+  if (!err.IsOk()) {
+    return err;
+  }
+  std::string data;
+  bool end_of_input = false;
+  while (!end_of_input) {
+    const uint8_t* buf;
+    size_t buf_size;
+    input->GetNext(&buf, &buf_size, &end_of_input);
+    if (buf != nullptr) {
+      data.append(reinterpret_cast<const char*>(buf), buf_size);
+    }
+  }
+
+  // The offsets of the elements, with the length of each BYTES element
+  std::vector<std::pair<size_t, size_t>> elements;
+  if (type == DataType::BYTES) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+      uint32_t length;
+      if ((data.size() - offset) < sizeof(length)) {
+        return Error(
+            "unexpected end of the data of input '" + input->Name() + "'");
+      }
+      memcpy(&length, data.data() + offset, sizeof(length));
+      offset += sizeof(length);
+      if ((data.size() - offset) < length) {
+        return Error(
+            "unexpected end of the data of input '" + input->Name() + "'");
+      }
+      elements.emplace_back(offset, length);
+      offset += length;
+    }
+  } else {
+    const size_t element_size = DataTypeByteSize(type);
+    for (size_t offset = 0; (offset + element_size) <= data.size();
+         offset += element_size) {
+      elements.emplace_back(offset, element_size);
+    }
+  }
+
+  const bool is_array = (elements.size() != 1);
+  if (is_array) {
+    writer->StartArray();
+  }
+  for (const auto& element : elements) {
+    const char* value = data.data() + element.first;
+    switch (type) {
+      case DataType::BOOL:
+        writer->Bool(*value != 0);
+        break;
+      case DataType::UINT8:
+        writer->Uint64(ReadElement<uint8_t>(value));
+        break;
+      case DataType::UINT16:
+        writer->Uint64(ReadElement<uint16_t>(value));
+        break;
+      case DataType::UINT32:
+        writer->Uint64(ReadElement<uint32_t>(value));
+        break;
+      case DataType::UINT64:
+        writer->Uint64(ReadElement<uint64_t>(value));
+        break;
+      case DataType::INT8:
+        writer->Int64(ReadElement<int8_t>(value));
+        break;
+      case DataType::INT16:
+        writer->Int64(ReadElement<int16_t>(value));
+        break;
+      case DataType::INT32:
+        writer->Int64(ReadElement<int32_t>(value));
+        break;
+      case DataType::INT64:
+        writer->Int64(ReadElement<int64_t>(value));
+        break;
+      case DataType::FP32:
+        writer->Double(ReadElement<float>(value));
+        break;
+      case DataType::FP64:
+        writer->Double(ReadElement<double>(value));
+        break;
+      default:
+        writer->String(value, element.second);
+        break;
+    }
+  }
+  if (is_array) {
+    writer->EndArray();
+  }
+
+  return Error::Success;
+}
+
+}  // namespace
+
+Error
+HttpInferRequest::InitializeStreamRequest(
+    const InferOptions& options, const std::vector<InferInput*>& inputs)
+{
+  data_buffers_.clear();
+  shared_inputs_.clear();
+  total_input_byte_size_ = 0;
+  uncompressed_input_byte_size_ = 0;
+  wire_response_byte_size_ = 0;
+  http_code_ = 400;
+  prepared_request_.reset();
+
+  // The inputs are the members named after them, the other members are
+  // the request id and parameters.
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  if (!options.request_id_.empty()) {
+    writer.Key("id");
+    writer.String(options.request_id_.c_str(), options.request_id_.size());
+  }
+  for (const auto input : inputs) {
+    writer.Key(input->Name().c_str(), input->Name().size());
+    Error err = WriteGenerateInput(input, &writer);
+    if (!err.IsOk()) {
+      return err;
+    }
+  }
+  if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "") ||
+      (options.priority_ != 0) || (options.server_timeout_ != 0)) {
+    writer.Key("parameters");
+    writer.StartObject();
+    if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
+      writer.Key("sequence_id");
+      if (options.sequence_id_ != 0) {
+        writer.Uint64(options.sequence_id_);
+      } else {
+        writer.String(
+            options.sequence_id_str_.c_str(), options.sequence_id_str_.size());
+      }
+      writer.Key("sequence_start");
+      writer.Bool(options.sequence_start_);
+      writer.Key("sequence_end");
+      writer.Bool(options.sequence_end_);
+    }
+    if (options.priority_ != 0) {
+      writer.Key("priority");
+      writer.Uint64(options.priority_);
+    }
+    if (options.server_timeout_ != 0) {
+      writer.Key("timeout");
+      writer.Uint64(options.server_timeout_);
+    }
+    writer.EndObject();
+  }
+  writer.EndObject();
+
+  stream_body_.assign(buffer.GetString(), buffer.GetSize());
+  prepared_json_ = &stream_body_;
+  AddInput((uint8_t*)stream_body_.data(), stream_body_.size());
 
-  // Prepare buffer to record the response
-  infer_response_buffer_.reset(new std::string());
+  if (infer_response_buffer_ == nullptr) {
+    infer_response_buffer_.reset(new std::string());
+  } else {
+    infer_response_buffer_->clear();
+  }
+  request_id_ = options.request_id_;
+  response_header_parsed_ = false;
+  response_json_parsed_ = false;
+  streamed_outputs_.clear();
+  next_streamed_output_ = 0;
+  user_buffers_.clear();
+
+  event_stream_ = true;
+  event_error_delivered_ = false;
+  event_byte_size_ = 0;
+  event_buffer_.clear();
+  event_data_.clear();
 
   return Error::Success;
 }
@@ -384,12 +1475,14 @@ Error
 HttpInferRequest::PrepareRequestJson(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
-    triton::common::TritonJson::Value* request_json)
+    triton::common::TritonJson::Value* request_json, const bool add_id)
 {
   // Can use string-ref because json is serialized before end of
   // 'options', 'inputs' and 'outputs' lifetime.
-  request_json->AddStringRef(
-      "id", options.request_id_.c_str(), options.request_id_.size());
+  if (add_id) {
+    request_json->AddStringRef(
+        "id", options.request_id_.c_str(), options.request_id_.size());
+  }
 
   if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "") ||
       (options.priority_ != 0) || (options.server_timeout_ != 0) ||
@@ -521,6 +1614,39 @@ HttpInferRequest::PrepareRequestJson(
   return Error::Success;
 }
 
+Error
+HttpInferRequest::SetPreparedJson(
+    const InferOptions& options, const std::vector<InferInput*>& inputs)
+{
+  const HttpPreparedInferRequest* prepared =
+      dynamic_cast<const HttpPreparedInferRequest*>(
+          options.prepared_request_.get());
+  if (prepared == nullptr) {
+    return Error("The request was not prepared by an HTTP client.");
+  }
+  Error err = prepared->CheckInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  prepared_request_ = options.prepared_request_;
+  if (options.request_id_.empty()) {
+    prepared_json_ = &prepared->header_;
+  } else {
+    // The id goes first, followed by the members of the prepared header
+    // if it has any.
+    patched_json_.clear();
+    patched_json_.append("{\"id\":");
+    AppendJsonString(options.request_id_, &patched_json_);
+    if (prepared->header_.size() > 2) {
+      patched_json_.push_back(',');
+    }
+    patched_json_.append(prepared->header_, 1, std::string::npos);
+    prepared_json_ = &patched_json_;
+  }
+  return Error::Success;
+}
+
 Error
 HttpInferRequest::AddInput(uint8_t* buf, size_t byte_size)
 {
@@ -533,6 +1659,9 @@ Error
 HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
 {
   *input_bytes = 0;
+  if (Timer().Timestamp(RequestTimers::Kind::TRANSPORT_START) == 0) {
+    Timer().CaptureTimestamp(RequestTimers::Kind::TRANSPORT_START);
+  }
 
   while (!data_buffers_.empty() && size > 0) {
     const size_t csz = std::min(data_buffers_.front().second, size);
@@ -562,13 +1691,24 @@ HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
 
 Error
 HttpInferRequest::CompressInput(
-    const InferenceServerHttpClient::CompressionType type)
+    const InferenceServerHttpClient::CompressionType type,
+    const size_t chunk_byte_size, const size_t thread_count)
 {
-  auto err = CompressData(
-      type, data_buffers_, total_input_byte_size_, &compressed_data_);
+  compressed_data_.clear();
+  Error err;
+  if ((thread_count > 1) && (chunk_byte_size != 0) &&
+      (total_input_byte_size_ > chunk_byte_size)) {
+    err = CompressDataParallel(
+        type, data_buffers_, total_input_byte_size_, chunk_byte_size,
+        thread_count, &compressed_data_);
+  } else {
+    err = CompressData(
+        type, data_buffers_, total_input_byte_size_, &compressed_data_);
+  }
   if (!err.IsOk()) {
     return err;
   }
+  uncompressed_input_byte_size_ = total_input_byte_size_;
   data_buffers_.clear();
   total_input_byte_size_ = 0;
   for (const auto& data : compressed_data_) {
@@ -579,6 +1719,369 @@ HttpInferRequest::CompressInput(
   return Error::Success;
 }
 
+Error
+HttpInferRequest::UseCompressedInputs(
+    const InferenceServerHttpClient::CompressionType type,
+    const std::shared_ptr<CompressedInferInputs>& compressed_inputs,
+    const std::vector<InferInput*>& inputs)
+{
+  const HttpCompressedInferInputs* compressed =
+      dynamic_cast<const HttpCompressedInferInputs*>(compressed_inputs.get());
+  if (compressed == nullptr) {
+    return Error("The input data was not compressed by an HTTP client.");
+  }
+  if (compressed->type_ != type) {
+    return Error(
+        "The input data was not compressed with the request compression "
+        "algorithm.");
+  }
+  size_t input_byte_size = 0;
+  for (const auto input : inputs) {
+    if (!input->IsSharedMemory()) {
+      size_t byte_size;
+      Error err = input->ByteSize(&byte_size);
+      if (!err.IsOk()) {
+        return err;
+      }
+      input_byte_size += byte_size;
+    }
+  }
+  if (input_byte_size != compressed->byte_size_) {
+    return Error(
+        "The byte size of the input data, " +
+        std::to_string(input_byte_size) +
+        ", doesn't match the byte size of the compressed input data, " +
+        std::to_string(compressed->byte_size_) + ".");
+  }
+
+  // The JSON header is compressed into data that doesn't end the stream,
+  // the checksum of the body is combined with the one of the input data.
+  std::pair<std::unique_ptr<char[]>, size_t> header_data;
+  uLong checksum;
+  Error err = CompressChunk(
+      type, data_buffers_, 0, total_input_byte_size_, false /* last_chunk */,
+      &header_data, &checksum);
+  if (!err.IsOk()) {
+    return err;
+  }
+  checksum =
+      (type == InferenceServerHttpClient::CompressionType::GZIP)
+          ? crc32_combine(checksum, compressed->checksum_, input_byte_size)
+          : adler32_combine(checksum, compressed->checksum_, input_byte_size);
+
+  compressed_data_.clear();
+  AppendCompressionHeader(type, &compressed_data_);
+  compressed_data_.emplace_back(std::move(header_data));
+  AppendCompressionTrailer(
+      type, checksum, total_input_byte_size_ + input_byte_size,
+      &compressed_data_);
+  compressed_inputs_ = compressed_inputs;
+
+  uncompressed_input_byte_size_ = total_input_byte_size_ + input_byte_size;
+  data_buffers_.clear();
+  total_input_byte_size_ = 0;
+  for (size_t i = 0; i < compressed_data_.size(); ++i) {
+    if ((i + 1) == compressed_data_.size()) {
+      AddInput(
+          reinterpret_cast<uint8_t*>(compressed->data_.first.get()),
+          compressed->data_.second);
+    }
+    AddInput(
+        reinterpret_cast<uint8_t*>(compressed_data_[i].first.get()),
+        compressed_data_[i].second);
+  }
+  return Error::Success;
+}
+
+Error
+HttpInferRequest::ParseResponseChunk(const char* buf, size_t byte_size)
+{
+  if (!response_header_parsed_) {
+    const size_t header_byte_size = std::min(
+        byte_size, response_json_size_ - infer_response_buffer_->size());
+    infer_response_buffer_->append(buf, header_byte_size);
+    buf += header_byte_size;
+    byte_size -= header_byte_size;
+    if (infer_response_buffer_->size() < response_json_size_) {
+      return Error::Success;
+    }
+
+    response_header_parsed_ = true;
+    Error err = PrepareStreamedOutputs();
+    if (!err.IsOk()) {
+      return err;
+    }
+  }
+
+  while (byte_size > 0) {
+    // Skip the outputs without data
+    while ((next_streamed_output_ < streamed_outputs_.size()) &&
+           (streamed_outputs_[next_streamed_output_].received_byte_size_ ==
+            streamed_outputs_[next_streamed_output_].byte_size_)) {
+      ++next_streamed_output_;
+    }
+    if (next_streamed_output_ == streamed_outputs_.size()) {
+      return Error(
+          "received more binary data than specified in the inference "
+          "response header");
+    }
+
+    auto& output = streamed_outputs_[next_streamed_output_];
+    const size_t output_byte_size =
+        std::min(byte_size, output.byte_size_ - output.received_byte_size_);
+    if (output.buffer_ != nullptr) {
+      memcpy(
+          output.buffer_ + output.received_byte_size_, buf, output_byte_size);
+    } else {
+      (*output_data_callback_)(
+          request_id_, output.name_, reinterpret_cast<const uint8_t*>(buf),
+          output_byte_size, output.received_byte_size_,
+          (output.received_byte_size_ + output_byte_size) ==
+              output.byte_size_);
+    }
+    output.received_byte_size_ += output_byte_size;
+    buf += output_byte_size;
+    byte_size -= output_byte_size;
+  }
+
+  return Error::Success;
+}
+
+namespace {
+
+// Return the member 'name' of the JSON object 'object', nullptr if there is
+// no such member.
+const rapidjson::Value*
+FindMember(const rapidjson::Value& object, const char* name)
+{
+  if (!object.IsObject()) {
+    return nullptr;
+  }
+  const auto it = object.FindMember(name);
+  return (it == object.MemberEnd()) ? nullptr : &it->value;
+}
+
+// Set 'str' and 'len' to the string member 'name' of the JSON object
+// 'object', which the string points into.
+Error
+MemberAsString(
+    const rapidjson::Value& object, const char* name, const char** str,
+    size_t* len)
+{
+  const rapidjson::Value* value = FindMember(object, name);
+  if ((value == nullptr) || !value->IsString()) {
+    return Error(
+        "attempt to access JSON non-string as string for member '" +
+        std::string(name) + "'");
+  }
+  *str = value->GetString();
+  *len = value->GetStringLength();
+  return Error::Success;
+}
+
+// Read the 'binary_data_size' parameter of the output 'output_json' into
+// 'data_size', false if the output has no parameters.
+bool
+BinaryDataSize(
+    const rapidjson::Value& output_json, uint64_t* data_size, Error* err)
+{
+  const rapidjson::Value* param_json = FindMember(output_json, "parameters");
+  if (param_json == nullptr) {
+    return false;
+  }
+  const rapidjson::Value* size_json =
+      FindMember(*param_json, "binary_data_size");
+  if ((size_json == nullptr) || !size_json->IsUint64()) {
+    *err = Error(
+        "attempt to access JSON non-unsigned-integer as unsigned-integer for "
+        "member 'binary_data_size'");
+  } else {
+    *data_size = size_json->GetUint64();
+    *err = Error::Success;
+  }
+  return true;
+}
+
+}  // namespace
+
+Error
+HttpInferRequest::ParseResponseJson()
+{
+  if (response_json_parsed_) {
+    return response_json_status_;
+  }
+  response_json_parsed_ = true;
+
+  std::string& buffer = *infer_response_buffer_;
+  if (verbose_) {
+    std::cout << "inference response: "
+              << ((response_json_size_ != 0)
+                      ? buffer.substr(0, response_json_size_)
+                      : buffer)
+              << std::endl;
+  }
+  // Drop the values of the previous response of a reused request.
+  response_document_.SetNull();
+  response_document_.GetAllocator().Clear();
+  // The binary data of the outputs may follow the header, so the parsing
+  // stops at the end of the JSON value.
+  const unsigned int parse_flags = rapidjson::kParseInsituFlag |
+                                   rapidjson::kParseStopWhenDoneFlag |
+                                   rapidjson::kParseNanAndInfFlag;
+  response_document_.ParseInsitu<parse_flags>(&buffer[0]);
+  if (response_document_.HasParseError()) {
+    response_json_status_ = Error(
+        "failed to parse the response JSON at " +
+        std::to_string(response_document_.GetErrorOffset()) + ": " +
+        std::string(GetParseError_En(response_document_.GetParseError())));
+  } else if (!response_document_.IsObject()) {
+    response_json_status_ = Error("the response JSON is not an object");
+  } else {
+    response_json_status_ = Error::Success;
+  }
+  return response_json_status_;
+}
+
+Error
+HttpInferRequest::PrepareStreamedOutputs()
+{
+  Error err = ParseResponseJson();
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  const bool use_callback =
+      (output_data_callback_ != nullptr) && *output_data_callback_;
+  const rapidjson::Value* outputs_json =
+      FindMember(response_document_, "outputs");
+  if ((outputs_json != nullptr) && outputs_json->IsArray()) {
+    for (const auto& output_json : outputs_json->GetArray()) {
+      uint64_t data_size = 0;
+      if (!BinaryDataSize(output_json, &data_size, &err)) {
+        continue;
+      }
+      if (!err.IsOk()) {
+        return err;
+      }
+
+      const char* name_str;
+      size_t name_strlen;
+      err = MemberAsString(output_json, "name", &name_str, &name_strlen);
+      if (!err.IsOk()) {
+        return err;
+      }
+
+      streamed_outputs_.emplace_back();
+      auto& output = streamed_outputs_.back();
+      output.name_.assign(name_str, name_strlen);
+      output.byte_size_ = data_size;
+      output.received_byte_size_ = 0;
+      output.buffer_ = nullptr;
+      auto it = user_buffers_.find(output.name_);
+      if ((it != user_buffers_.end()) && (it->second.second >= data_size)) {
+        output.buffer_ = it->second.first;
+      } else if (!use_callback) {
+        output.data_.reset(new uint8_t[std::max<size_t>(data_size, 1)]);
+        output.buffer_ = output.data_.get();
+      }
+    }
+  }
+
+  return Error::Success;
+}
+
+void
+HttpInferRequest::Reuse(InferenceServerClient::OnCompleteFn callback)
+{
+  callback_ = std::move(callback);
+  Timer().Reset();
+  if (header_list_ != nullptr) {
+    curl_slist_free_all(header_list_);
+    header_list_ = nullptr;
+  }
+  compressed_data_.clear();
+  compressed_inputs_.reset();
+  response_json_size_ = 0;
+  stream_response_outputs_ = false;
+  output_data_callback_ = nullptr;
+  cancel_requested_ = false;
+  cancelled_ = false;
+  event_stream_ = false;
+  event_byte_size_ = 0;
+}
+
+//==============================================================================
+// An HttpInferRequestPool holds the idle HttpInferRequest objects of a
+// client. The objects it hands out return to it when their last reference,
+// usually held by the InferResult, is released.
+//
+class HttpInferRequestPool
+    : public std::enable_shared_from_this<HttpInferRequestPool> {
+ public:
+  HttpInferRequestPool(const size_t max_size, const bool verbose)
+      : max_size_(max_size), verbose_(verbose)
+  {
+  }
+
+  ~HttpInferRequestPool()
+  {
+    for (auto request : requests_) {
+      delete request;
+    }
+  }
+
+  std::shared_ptr<HttpInferRequest> Acquire(
+      InferenceServerClient::OnCompleteFn callback)
+  {
+    HttpInferRequest* request = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!requests_.empty()) {
+        request = requests_.back();
+        requests_.pop_back();
+      }
+    }
+    if (request == nullptr) {
+      request = new HttpInferRequest(std::move(callback), verbose_);
+    } else {
+      request->Reuse(std::move(callback));
+    }
+
+    std::weak_ptr<HttpInferRequestPool> weak_pool = shared_from_this();
+    return std::shared_ptr<HttpInferRequest>(
+        request, [weak_pool](HttpInferRequest* request) {
+          auto pool = weak_pool.lock();
+          if (pool != nullptr) {
+            pool->Release(request);
+          } else {
+            delete request;
+          }
+        });
+  }
+
+ private:
+  void Release(HttpInferRequest* request)
+  {
+    // Drop the callback and the shared inputs now as they may hold
+    // resources of the caller.
+    request->callback_ = nullptr;
+    request->shared_inputs_.clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (requests_.size() < max_size_) {
+        requests_.push_back(request);
+        return;
+      }
+    }
+    delete request;
+  }
+
+  const size_t max_size_;
+  const bool verbose_;
+  std::mutex mutex_;
+  std::vector<HttpInferRequest*> requests_;
+};
+
 //==============================================================================
 
 class InferResultHttp : public InferResult {
@@ -597,6 +2100,7 @@ class InferResultHttp : public InferResult {
       const override;
   Error Datatype(
       const std::string& output_name, std::string* datatype) const override;
+  Error Type(const std::string& output_name, DataType* type) const override;
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
@@ -604,18 +2108,34 @@ class InferResultHttp : public InferResult {
       const std::string& output_name,
       std::vector<std::string>* string_result) const override;
   std::string DebugString() const override;
+  Error IsFinalResponse(bool* is_final_response) const override;
+  Error IsNullResponse(bool* is_null_response) const override;
 
  private:
   InferResultHttp(std::shared_ptr<HttpInferRequest> infer_request);
   InferResultHttp(const Error err) : status_(err) {}
 
-  std::map<std::string, triton::common::TritonJson::Value>
-      output_name_to_result_map_;
-  std::map<std::string, std::pair<const uint8_t*, const size_t>>
-      output_name_to_buffer_map_;
+  // An output of the response. The name points into the response buffer,
+  // and 'buf_' is null for an output without binary data.
+  struct Output {
+    const char* name_;
+    size_t name_len_;
+    const rapidjson::Value* json_;
+    const uint8_t* buf_;
+    size_t byte_size_;
+  };
+
+  // Return the output named 'output_name', or nullptr if the response
+  // doesn't have it.
+  const Output* FindOutput(const std::string& output_name) const;
 
   Error status_;
-  triton::common::TritonJson::Value response_json_;
+  // The JSON header of the response, owned by 'infer_request_'.
+  const rapidjson::Value* response_json_{nullptr};
+  // The outputs in the order of the response. A model has few outputs, so
+  // a linear scan finds them faster than building maps keyed by copies of
+  // their names for every response.
+  std::vector<Output> outputs_;
   std::shared_ptr<HttpInferRequest> infer_request_;
 };
 
@@ -649,7 +2169,7 @@ InferResultHttp::ModelName(std::string* name) const
   const char* name_str;
   size_t name_strlen;
   Error err =
-      response_json_.MemberAsString("model_name", &name_str, &name_strlen);
+      MemberAsString(*response_json_, "model_name", &name_str, &name_strlen);
   if (!err.IsOk()) {
     return Error("model name was not returned in the response");
   }
@@ -667,8 +2187,8 @@ InferResultHttp::ModelVersion(std::string* version) const
 
   const char* version_str;
   size_t version_strlen;
-  Error err = response_json_.MemberAsString(
-      "model_version", &version_str, &version_strlen);
+  Error err = MemberAsString(
+      *response_json_, "model_version", &version_str, &version_strlen);
   if (!err.IsOk()) {
     return Error("model version was not returned in the response");
   }
@@ -686,7 +2206,7 @@ InferResultHttp::Id(std::string* id) const
 
   const char* id_str;
   size_t id_strlen;
-  Error err = response_json_.MemberAsString("id", &id_str, &id_strlen);
+  Error err = MemberAsString(*response_json_, "id", &id_str, &id_strlen);
   if (!err.IsOk()) {
     return Error("model id was not returned in the response");
   }
@@ -695,29 +2215,41 @@ InferResultHttp::Id(std::string* id) const
   return Error::Success;
 }
 
+Error
+InferResultHttp::IsFinalResponse(bool* is_final_response) const
+{
+  // HTTP requests receive a single response
+  *is_final_response = true;
+  return Error::Success;
+}
+
+Error
+InferResultHttp::IsNullResponse(bool* is_null_response) const
+{
+  *is_null_response = false;
+  return Error::Success;
+}
+
 namespace {
 
 Error
 ShapeHelper(
-    const std::string& result_name,
-    const triton::common::TritonJson::Value& result_json,
+    const std::string& result_name, const rapidjson::Value& result_json,
     std::vector<int64_t>* shape)
 {
-  triton::common::TritonJson::Value shape_json;
-  if (!const_cast<triton::common::TritonJson::Value&>(result_json)
-           .Find("shape", &shape_json)) {
+  const rapidjson::Value* shape_json = FindMember(result_json, "shape");
+  if ((shape_json == nullptr) || !shape_json->IsArray()) {
     return Error(
         "The response does not contain shape for output name " + result_name);
   }
 
-  for (size_t i = 0; i < shape_json.ArraySize(); i++) {
-    int64_t dim;
-    Error err = shape_json.IndexAsInt(i, &dim);
-    if (!err.IsOk()) {
-      return err;
+  shape->reserve(shape_json->Size());
+  for (const auto& dim : shape_json->GetArray()) {
+    if (!dim.IsInt64()) {
+      return Error("attempt to access JSON non-signed-integer as int");
     }
 
-    shape->push_back(dim);
+    shape->push_back(dim.GetInt64());
   }
 
   return Error::Success;
@@ -725,6 +2257,18 @@ ShapeHelper(
 
 }  // namespace
 
+const InferResultHttp::Output*
+InferResultHttp::FindOutput(const std::string& output_name) const
+{
+  for (const auto& output : outputs_) {
+    if ((output.name_len_ == output_name.size()) &&
+        (memcmp(output.name_, output_name.data(), output.name_len_) == 0)) {
+      return &output;
+    }
+  }
+  return nullptr;
+}
+
 Error
 InferResultHttp::Shape(
     const std::string& output_name, std::vector<int64_t>* shape) const
@@ -734,13 +2278,13 @@ InferResultHttp::Shape(
   }
 
   shape->clear();
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
-  return ShapeHelper(output_name, itr->second, shape);
+  return ShapeHelper(output_name, *output->json_, shape);
 }
 
 Error
@@ -750,15 +2294,16 @@ InferResultHttp::Datatype(
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
   const char* dtype_str;
   size_t dtype_strlen;
-  Error err = itr->second.MemberAsString("datatype", &dtype_str, &dtype_strlen);
+  Error err =
+      MemberAsString(*output->json_, "datatype", &dtype_str, &dtype_strlen);
   if (!err.IsOk()) {
     return Error(
         "The response does not contain datatype for output name " +
@@ -770,57 +2315,69 @@ InferResultHttp::Datatype(
 }
 
 Error
-InferResultHttp::RawData(
-    const std::string& output_name, const uint8_t** buf,
-    size_t* byte_size) const
+InferResultHttp::Type(const std::string& output_name, DataType* type) const
 {
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_buffer_map_.find(output_name);
-  if (itr != output_name_to_buffer_map_.end()) {
-    *buf = itr->second.first;
-    *byte_size = itr->second.second;
-  } else {
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
-  return Error::Success;
-}
-
-Error
-InferResultHttp::StringData(
-    const std::string& output_name,
-    std::vector<std::string>* string_result) const
-{
+  // Resolved from the name in the response, without copying it
+  const char* dtype_str;
+  size_t dtype_strlen;
+  Error err =
+      MemberAsString(*output->json_, "datatype", &dtype_str, &dtype_strlen);
+  if (!err.IsOk()) {
+    return Error(
+        "The response does not contain datatype for output name " +
+        output_name);
+  }
+
+  *type = StringToDataType(dtype_str, dtype_strlen);
+  return Error::Success;
+}
+
+Error
+InferResultHttp::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
   if (!status_.IsOk()) {
     return status_;
   }
-  std::string datatype;
-  Error err = Datatype(output_name, &datatype);
-  if (!err.IsOk()) {
-    return err;
-  }
-  if (datatype.compare("BYTES") != 0) {
+  const Output* output = FindOutput(output_name);
+  if ((output != nullptr) && (output->buf_ != nullptr)) {
+    *buf = output->buf_;
+    *byte_size = output->byte_size_;
+  } else {
     return Error(
-        "This function supports tensors with datatype 'BYTES', requested "
-        "output tensor '" +
-        output_name + "' with datatype '" + datatype + "'");
+        "The response does not contain results for output name " + output_name);
   }
 
-  const uint8_t* buf;
-  size_t byte_size;
-  err = RawData(output_name, &buf, &byte_size);
+  return Error::Success;
+}
+
+Error
+InferResultHttp::StringData(
+    const std::string& output_name,
+    std::vector<std::string>* string_result) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  std::vector<std::pair<const char*, size_t>> elements;
+  Error err = StringDataRefs(output_name, &elements);
+  if (!err.IsOk()) {
+    return err;
+  }
   string_result->clear();
-  size_t buf_offset = 0;
-  while (byte_size > buf_offset) {
-    const uint32_t element_size =
-        *(reinterpret_cast<const uint32_t*>(buf + buf_offset));
-    string_result->emplace_back(
-        reinterpret_cast<const char*>(buf + buf_offset + sizeof(element_size)),
-        element_size);
-    buf_offset += (sizeof(element_size) + element_size);
+  string_result->reserve(elements.size());
+  for (const auto& element : elements) {
+    string_result->emplace_back(element.first, element.second);
   }
 
   return Error::Success;
@@ -833,13 +2390,13 @@ InferResultHttp::DebugString() const
     return status_.Message();
   }
 
-  triton::common::TritonJson::WriteBuffer buffer;
-  Error err = response_json_.Write(&buffer);
-  if (!err.IsOk()) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  if (!response_json_->Accept(writer)) {
     return "<failed>";
   }
 
-  return buffer.Contents();
+  return std::string(buffer.GetString(), buffer.GetSize());
 }
 
 Error
@@ -855,23 +2412,11 @@ InferResultHttp::InferResultHttp(
   size_t offset = infer_request->response_json_size_;
   if (infer_request->http_code_ == 499) {
     status_ = Error("Deadline Exceeded");
+  } else if (infer_request->cancelled_) {
+    status_ = Error("Request cancelled");
   } else {
-    if (offset != 0) {
-      if (infer_request->verbose_) {
-        std::cout << "inference response: "
-                  << infer_request->infer_response_buffer_->substr(0, offset)
-                  << std::endl;
-      }
-      status_ = response_json_.Parse(
-          (char*)infer_request->infer_response_buffer_.get()->c_str(), offset);
-    } else {
-      if (infer_request->verbose_) {
-        std::cout << "inference response: "
-                  << *infer_request->infer_response_buffer_ << std::endl;
-      }
-      status_ = response_json_.Parse(
-          (char*)infer_request->infer_response_buffer_.get()->c_str());
-    }
+    status_ = infer_request->ParseResponseJson();
+    response_json_ = &infer_request->response_document_;
   }
 
   // There should be a valid JSON response in all cases. Either the
@@ -880,56 +2425,407 @@ InferResultHttp::InferResultHttp(
     if (infer_request->http_code_ != 200) {
       const char* err_str;
       size_t err_strlen;
-      if (!response_json_.MemberAsString("error", &err_str, &err_strlen)
+      if (!MemberAsString(*response_json_, "error", &err_str, &err_strlen)
                .IsOk()) {
         status_ = Error("inference failed with unknown error");
       } else {
         status_ = Error(std::string(err_str, err_strlen));
       }
     } else {
-      triton::common::TritonJson::Value outputs_json;
-      if (response_json_.Find("outputs", &outputs_json)) {
-        for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
-          triton::common::TritonJson::Value output_json;
-          status_ = outputs_json.IndexAsObject(i, &output_json);
-          if (!status_.IsOk()) {
-            break;
-          }
-
-          const char* name_str;
-          size_t name_strlen;
-          status_ = output_json.MemberAsString("name", &name_str, &name_strlen);
+      size_t streamed_output_idx = 0;
+      const rapidjson::Value* outputs_json =
+          FindMember(*response_json_, "outputs");
+      if ((outputs_json != nullptr) && outputs_json->IsArray()) {
+        outputs_.reserve(outputs_json->Size());
+        for (const auto& output_json : outputs_json->GetArray()) {
+          Output output{nullptr, 0, &output_json, nullptr, 0};
+          status_ = MemberAsString(
+              output_json, "name", &output.name_, &output.name_len_);
           if (!status_.IsOk()) {
             break;
           }
 
-          std::string output_name(name_str, name_strlen);
-
-          triton::common::TritonJson::Value param_json;
-          if (output_json.Find("parameters", &param_json)) {
-            uint64_t data_size = 0;
-            status_ = param_json.MemberAsUInt("binary_data_size", &data_size);
+          uint64_t data_size = 0;
+          if (BinaryDataSize(output_json, &data_size, &status_)) {
             if (!status_.IsOk()) {
               break;
             }
 
-            output_name_to_buffer_map_.emplace(
-                output_name,
-                std::pair<const uint8_t*, const size_t>(
-                    (uint8_t*)(infer_request->infer_response_buffer_.get()
-                                   ->c_str()) +
-                        offset,
-                    data_size));
-            offset += data_size;
+            if (infer_request->response_header_parsed_) {
+              // The binary data was separated from the header as it was
+              // received, the outputs are listed in the same order.
+              if (streamed_output_idx <
+                  infer_request->streamed_outputs_.size()) {
+                const auto& streamed_output =
+                    infer_request->streamed_outputs_[streamed_output_idx++];
+                output.buf_ = streamed_output.buffer_;
+                output.byte_size_ = streamed_output.byte_size_;
+              }
+            } else {
+              const uint8_t* buf =
+                  (uint8_t*)(infer_request->infer_response_buffer_.get()
+                                 ->c_str()) +
+                  offset;
+              // The body was received in full, copy the output to its user
+              // buffer if there is one.
+              if (!infer_request->user_buffers_.empty()) {
+                auto it = infer_request->user_buffers_.find(
+                    std::string(output.name_, output.name_len_));
+                if ((it != infer_request->user_buffers_.end()) &&
+                    (it->second.second >= data_size)) {
+                  memcpy(it->second.first, buf, data_size);
+                  buf = it->second.first;
+                }
+              }
+              output.buf_ = buf;
+              output.byte_size_ = data_size;
+              offset += data_size;
+            }
           }
 
-          output_name_to_result_map_[output_name] = std::move(output_json);
+          outputs_.push_back(output);
+        }
+      }
+    }
+  }
+}
+
+//==============================================================================
+// An InferResultHttpEvent holds a response of a generate_stream request,
+// received as the data of a server-sent event. The members of the event
+// other than the model name, version, id and parameters are the outputs,
+// whose datatype follows from their JSON values and whose shape is their
+// element count. A request ends with a null final response.
+//
+class InferResultHttpEvent : public InferResult {
+ public:
+  static void Create(
+      InferResult** infer_result, const std::string& event,
+      const std::string& request_id);
+  static void CreateFinal(
+      InferResult** infer_result, const std::string& request_id);
+
+  Error RequestStatus() const override;
+  Error ModelName(std::string* name) const override;
+  Error ModelVersion(std::string* version) const override;
+  Error Id(std::string* id) const override;
+  Error Shape(const std::string& output_name, std::vector<int64_t>* shape)
+      const override;
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override;
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override;
+  std::string DebugString() const override;
+  Error IsFinalResponse(bool* is_final_response) const override;
+  Error IsNullResponse(bool* is_null_response) const override;
+
+ private:
+  InferResultHttpEvent(
+      const std::string& event, const std::string& request_id,
+      const bool final_response);
+
+  // An output of the response. The elements of a BYTES output are each
+  // preceded by their 4-byte length in 'data_'.
+  struct Output {
+    std::string name_;
+    std::string datatype_;
+    std::vector<int64_t> shape_;
+    std::string data_;
+  };
+
+  const Output* FindOutput(const std::string& output_name) const;
+  static Error ParseOutput(const rapidjson::Value& value, Output* output);
+
+  Error status_;
+  std::string event_;
+  std::string model_name_;
+  std::string model_version_;
+  std::string id_;
+  bool final_response_;
+  std::vector<Output> outputs_;
+};
+
+void
+InferResultHttpEvent::Create(
+    InferResult** infer_result, const std::string& event,
+    const std::string& request_id)
+{
+  *infer_result = new InferResultHttpEvent(event, request_id, false);
+}
+
+void
+InferResultHttpEvent::CreateFinal(
+    InferResult** infer_result, const std::string& request_id)
+{
+  *infer_result = new InferResultHttpEvent("", request_id, true);
+}
+
+InferResultHttpEvent::InferResultHttpEvent(
+    const std::string& event, const std::string& request_id,
+    const bool final_response)
+    : event_(event), id_(request_id), final_response_(final_response)
+{
+  if (final_response_) {
+    return;
+  }
+
+  rapidjson::Document document;
+  document.Parse(event_.c_str());
+  if (document.HasParseError() || !document.IsObject()) {
+    status_ = Error(
+        "failed to parse the response event: " +
+        std::string(GetParseError_En(document.GetParseError())));
+    return;
+  }
+  const char* err_str;
+  size_t err_strlen;
+  if (MemberAsString(document, "error", &err_str, &err_strlen).IsOk()) {
+    status_ = Error(std::string(err_str, err_strlen));
+    return;
+  }
+
+  for (auto member = document.MemberBegin(); member != document.MemberEnd();
+       ++member) {
+    std::string name(
+        member->name.GetString(), member->name.GetStringLength());
+    if ((name == "model_name") || (name == "model_version") ||
+        (name == "id")) {
+      if (member->value.IsString()) {
+        std::string value(
+            member->value.GetString(), member->value.GetStringLength());
+        if (name == "model_name") {
+          model_name_ = std::move(value);
+        } else if (name == "model_version") {
+          model_version_ = std::move(value);
+        } else {
+          id_ = std::move(value);
         }
       }
+      continue;
+    }
+    if (name == "parameters") {
+      continue;
+    }
+
+    outputs_.emplace_back();
+    outputs_.back().name_ = std::move(name);
+    status_ = ParseOutput(member->value, &outputs_.back());
+    if (!status_.IsOk()) {
+      return;
     }
   }
 }
 
+Error
+InferResultHttpEvent::ParseOutput(
+    const rapidjson::Value& value, Output* output)
+{
+  std::vector<const rapidjson::Value*> elements;
+  if (value.IsArray()) {
+    for (const auto& element : value.GetArray()) {
+      elements.push_back(&element);
+    }
+  } else {
+    elements.push_back(&value);
+  }
+  output->shape_.assign(1, static_cast<int64_t>(elements.size()));
+
+  bool all_string = true;
+  bool all_bool = true;
+  bool all_number = true;
+  bool all_int = true;
+  for (const auto element : elements) {
+    all_string = all_string && element->IsString();
+    all_bool = all_bool && element->IsBool();
+    all_number = all_number && element->IsNumber();
+    all_int = all_int && element->IsInt64();
+  }
+
+  if (all_string) {
+    output->datatype_ = "BYTES";
+    for (const auto element : elements) {
+      const uint32_t length = element->GetStringLength();
+      output->data_.append(
+          reinterpret_cast<const char*>(&length), sizeof(length));
+      output->data_.append(element->GetString(), length);
+    }
+  } else if (all_bool) {
+    output->datatype_ = "BOOL";
+    for (const auto element : elements) {
+      output->data_.push_back(element->GetBool() ? 1 : 0);
+    }
+  } else if (all_number && all_int) {
+    output->datatype_ = "INT64";
+    for (const auto element : elements) {
+      const int64_t number = element->GetInt64();
+      output->data_.append(
+          reinterpret_cast<const char*>(&number), sizeof(number));
+    }
+  } else if (all_number) {
+    output->datatype_ = "FP64";
+    for (const auto element : elements) {
+      const double number = element->GetDouble();
+      output->data_.append(
+          reinterpret_cast<const char*>(&number), sizeof(number));
+    }
+  } else {
+    return Error(
+        "unsupported value of output '" + output->name_ +
+        "' in the response event");
+  }
+
+  return Error::Success;
+}
+
+const InferResultHttpEvent::Output*
+InferResultHttpEvent::FindOutput(const std::string& output_name) const
+{
+  for (const auto& output : outputs_) {
+    if (output.name_ == output_name) {
+      return &output;
+    }
+  }
+  return nullptr;
+}
+
+Error
+InferResultHttpEvent::RequestStatus() const
+{
+  return status_;
+}
+
+Error
+InferResultHttpEvent::ModelName(std::string* name) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  if (model_name_.empty()) {
+    return Error("model name was not returned in the response");
+  }
+  *name = model_name_;
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::ModelVersion(std::string* version) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  if (model_version_.empty()) {
+    return Error("model version was not returned in the response");
+  }
+  *version = model_version_;
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::Id(std::string* id) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  *id = id_;
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::Shape(
+    const std::string& output_name, std::vector<int64_t>* shape) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
+    return Error(
+        "The response does not contain results for output name " + output_name);
+  }
+  *shape = output->shape_;
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::Datatype(
+    const std::string& output_name, std::string* datatype) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
+    return Error(
+        "The response does not contain results for output name " + output_name);
+  }
+  *datatype = output->datatype_;
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  if (!status_.IsOk()) {
+    return status_;
+  }
+  const Output* output = FindOutput(output_name);
+  if (output == nullptr) {
+    return Error(
+        "The response does not contain results for output name " + output_name);
+  }
+  *buf = reinterpret_cast<const uint8_t*>(output->data_.data());
+  *byte_size = output->data_.size();
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::StringData(
+    const std::string& output_name,
+    std::vector<std::string>* string_result) const
+{
+  std::vector<std::pair<const char*, size_t>> elements;
+  Error err = StringDataRefs(output_name, &elements);
+  if (!err.IsOk()) {
+    return err;
+  }
+  string_result->clear();
+  string_result->reserve(elements.size());
+  for (const auto& element : elements) {
+    string_result->emplace_back(element.first, element.second);
+  }
+  return Error::Success;
+}
+
+std::string
+InferResultHttpEvent::DebugString() const
+{
+  if (!status_.IsOk()) {
+    return status_.Message();
+  }
+  return event_;
+}
+
+Error
+InferResultHttpEvent::IsFinalResponse(bool* is_final_response) const
+{
+  // A request ends with its first error
+  *is_final_response = final_response_ || !status_.IsOk();
+  return Error::Success;
+}
+
+Error
+InferResultHttpEvent::IsNullResponse(bool* is_null_response) const
+{
+  *is_null_response = final_response_;
+  return Error::Success;
+}
+
 //==============================================================================
 
 Error
@@ -962,7 +2858,7 @@ InferenceServerHttpClient::GenerateRequestBody(
     }
   }
 
-  *header_length = infer_request->request_json_.Size();
+  *header_length = infer_request->RequestJsonSize();
   *request_body = std::vector<char>(infer_request->total_input_byte_size_);
   size_t remaining_bytes = infer_request->total_input_byte_size_;
   size_t actual_copied_bytes = 0;
@@ -1000,23 +2896,121 @@ InferenceServerHttpClient::ParseResponseBody(
   return Error::Success;
 }
 
+//==============================================================================
+// An HttpAsyncRequestHandle cancels an asynchronous request by having the
+// progress callback of its transfer abort it. The request may already have
+// completed, or even have been returned to the request pool, once the handle
+// is used, so it is only referenced weakly.
+//
+class HttpAsyncRequestHandle : public AsyncRequestHandle {
+ public:
+  explicit HttpAsyncRequestHandle(
+      const std::shared_ptr<HttpInferRequest>& request)
+      : request_(request)
+  {
+  }
+
+  void Cancel() override
+  {
+    std::shared_ptr<HttpInferRequest> request = request_.lock();
+    if (request != nullptr) {
+      request->RequestCancel();
+    }
+  }
+
+ private:
+  std::weak_ptr<HttpInferRequest> request_;
+};
+
+namespace {
+
+int
+InferProgressHandler(
+    void* userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal,
+    curl_off_t ulnow)
+{
+  // A non-zero value aborts the transfer with CURLE_ABORTED_BY_CALLBACK
+  return reinterpret_cast<HttpInferRequest*>(userp)->CancelRequested() ? 1
+                                                                        : 0;
+}
+
+}  // namespace
+
+//==============================================================================
+
 Error
 InferenceServerHttpClient::Create(
     std::unique_ptr<InferenceServerHttpClient>* client,
     const std::string& server_url, bool verbose,
-    const HttpSslOptions& ssl_options)
+    const HttpSslOptions& ssl_options, const HttpClientOptions& client_options)
 {
-  client->reset(
-      new InferenceServerHttpClient(server_url, verbose, ssl_options));
+  client->reset(new InferenceServerHttpClient(
+      server_url, verbose, ssl_options, client_options));
+  if (client_options.event_driven_async) {
+    Error err = (*client)->InitEventLoop();
+    if (!err.IsOk()) {
+      client->reset();
+      return err;
+    }
+  }
   return Error::Success;
 }
 
 InferenceServerHttpClient::InferenceServerHttpClient(
-    const std::string& url, bool verbose, const HttpSslOptions& ssl_options)
-    : InferenceServerClient(verbose), url_(url), ssl_options_(ssl_options),
+    const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+    const HttpClientOptions& client_options)
+    : InferenceServerClient(verbose),
+      url_(UnixSocketPath(url).empty() ? url : "http://localhost"),
+      unix_socket_path_(UnixSocketPath(url)), ssl_options_(ssl_options),
+      client_options_(client_options),
       easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
-      multi_handle_(curl_multi_init())
+      zero_copy_handle_(nullptr), multi_handle_(curl_multi_init()),
+      share_handle_(curl_share_init()), share_mutexes_(CURL_LOCK_DATA_LAST),
+      epoll_fd_(-1), wakeup_fd_(-1), timer_deadline_ns_(0),
+      timer_pending_(false)
 {
+  if (client_options_.request_pool_size > 0) {
+    request_pool_ = std::make_shared<HttpInferRequestPool>(
+        client_options_.request_pool_size, verbose);
+  }
+  if (client_options_.response_cache_byte_size > 0) {
+    response_cache_.reset(new ResponseCache(
+        client_options_.response_cache_byte_size,
+        client_options_.response_cache_ttl_us));
+  }
+  if (client_options_.max_outstanding_requests > 0) {
+    outstanding_limiter_.reset(new OutstandingLimiter(
+        client_options_.max_outstanding_requests,
+        client_options_.outstanding_overload));
+  }
+  if (client_options_.callback_thread_count > 0) {
+    callback_pool_.reset(
+        new CompletionThreadPool(client_options_.callback_thread_count));
+  }
+  if (share_handle_ != nullptr) {
+    CURLSH* share = reinterpret_cast<CURLSH*>(share_handle_);
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, ShareLock);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, share_mutexes_.data());
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  }
+  if ((multi_handle_ != nullptr) &&
+      (client_options_.max_host_connections > 0)) {
+    curl_multi_setopt(
+        multi_handle_, CURLMOPT_MAX_HOST_CONNECTIONS,
+        static_cast<long>(client_options_.max_host_connections));
+  }
+  if ((multi_handle_ != nullptr) && client_options_.http2) {
+    curl_multi_setopt(multi_handle_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#if LIBCURL_VERSION_NUM >= 0x074300
+    if (client_options_.http2_max_concurrent_streams > 0) {
+      curl_multi_setopt(
+          multi_handle_, CURLMOPT_MAX_CONCURRENT_STREAMS,
+          client_options_.http2_max_concurrent_streams);
+    }
+#endif  // LIBCURL_VERSION_NUM >= 0x074300
+  }
 }
 
 InferenceServerHttpClient::~InferenceServerHttpClient()
@@ -1027,6 +3021,13 @@ InferenceServerHttpClient::~InferenceServerHttpClient()
   // (it is default constructed thread before the first AsyncInfer() call)
   if (worker_.joinable()) {
     cv_.notify_all();
+#ifdef __linux__
+    if (wakeup_fd_ != -1) {
+      uint64_t value = 1;
+      ssize_t written = write(wakeup_fd_, &value, sizeof(value));
+      (void)written;
+    }
+#endif  // __linux__
     worker_.join();
   }
 
@@ -1034,14 +3035,37 @@ InferenceServerHttpClient::~InferenceServerHttpClient()
     curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
   }
 
+  ZeroCopyDisconnect();
+
   if (multi_handle_ != nullptr) {
     for (auto& request : ongoing_async_requests_) {
       CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
       curl_multi_remove_handle(multi_handle_, easy_handle);
       curl_easy_cleanup(easy_handle);
     }
+    for (auto& request : pending_async_requests_) {
+      curl_easy_cleanup(reinterpret_cast<CURL*>(request.first));
+    }
     curl_multi_cleanup(multi_handle_);
   }
+
+  for (auto easy_handle : easy_handle_pool_) {
+    curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle));
+  }
+
+  // Only once no easy handle uses it anymore
+  if (share_handle_ != nullptr) {
+    curl_share_cleanup(reinterpret_cast<CURLSH*>(share_handle_));
+  }
+
+#ifdef __linux__
+  if (epoll_fd_ != -1) {
+    close(epoll_fd_);
+  }
+  if (wakeup_fd_ != -1) {
+    close(wakeup_fd_);
+  }
+#endif  // __linux__
 }
 
 Error
@@ -1062,10 +3086,86 @@ InferenceServerHttpClient::IsServerLive(
 }
 
 Error
-InferenceServerHttpClient::IsServerReady(
-    bool* ready, const Headers& headers, const Parameters& query_params)
+InferenceServerHttpClient::Warmup(
+    const size_t connection_count, const uint64_t timeout_us)
 {
-  Error err;
+  if (!CurlGlobal::Get().Status().IsOk()) {
+    return CurlGlobal::Get().Status();
+  }
+
+  // A liveness request is sent on each handle from its own thread so that
+  // the handles open their connections at once. A handle keeps its
+  // connection alive for the following requests, which a multi handle
+  // wouldn't do once it is cleaned up.
+  std::lock_guard<std::mutex> easy_handle_lock(easy_handle_mutex_);
+  const std::string request_uri(url_ + "/v2/health/live");
+  std::vector<CURL*> handles{reinterpret_cast<CURL*>(easy_handle_)};
+  for (size_t i = 0; i < connection_count; ++i) {
+    handles.push_back(reinterpret_cast<CURL*>(AcquireEasyHandle()));
+  }
+  std::vector<std::string> responses(handles.size());
+  std::vector<Error> errors(handles.size());
+  auto warmup = [&](const size_t i) {
+    CURL* curl = handles[i];
+    if (curl == nullptr) {
+      errors[i] = Error("failed to initialize HTTP client");
+      return;
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(
+        curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout_us / 1000));
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, ResponseHandler);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responses[i]);
+    errors[i] = SetSSLCurlOptions(&curl, ssl_options_);
+    if (!errors[i].IsOk()) {
+      return;
+    }
+    SetHttpVersionCurlOptions(curl, request_uri, client_options_);
+    SetShareCurlOptions(curl, share_handle_);
+    SetUnixSocketCurlOptions(curl, unix_socket_path_);
+
+    CURLcode res = curl_easy_perform(curl);
+    long http_code = 0;
+    if (res != CURLE_OK) {
+      errors[i] =
+          Error("HTTP client failed: " + std::string(curl_easy_strerror(res)));
+    } else if (
+        (curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code) !=
+         CURLE_OK) ||
+        (http_code != 200)) {
+      errors[i] = Error("the server is not live");
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < handles.size(); ++i) {
+    workers.emplace_back(warmup, i);
+  }
+  warmup(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  curl_easy_reset(handles[0]);
+  for (size_t i = 1; i < handles.size(); ++i) {
+    if (handles[i] != nullptr) {
+      ReleaseEasyHandle(handles[i]);
+    }
+  }
+  for (const auto& err : errors) {
+    if (!err.IsOk()) {
+      return err;
+    }
+  }
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::IsServerReady(
+    bool* ready, const Headers& headers, const Parameters& query_params)
+{
+  Error err;
 
   std::string request_uri(url_ + "/v2/health/live");
 
@@ -1118,12 +3218,26 @@ InferenceServerHttpClient::ModelMetadata(
     const std::string& model_version, const Headers& headers,
     const Parameters& query_params)
 {
+  const bool cached = (model_cache_ != nullptr) && query_params.empty();
+  if (cached) {
+    RefreshModelCache(headers);
+    if (model_cache_->Lookup(
+            url_, "metadata", model_name, model_version, model_metadata)) {
+      return Error::Success;
+    }
+  }
+
   std::string request_uri(url_ + "/v2/models/" + model_name);
   if (!model_version.empty()) {
     request_uri = request_uri + "/versions/" + model_version;
   }
 
-  return Get(request_uri, headers, query_params, model_metadata);
+  Error err = Get(request_uri, headers, query_params, model_metadata);
+  if (cached && err.IsOk()) {
+    model_cache_->Insert(
+        url_, "metadata", model_name, model_version, *model_metadata);
+  }
+  return err;
 }
 
 
@@ -1133,13 +3247,63 @@ InferenceServerHttpClient::ModelConfig(
     const std::string& model_version, const Headers& headers,
     const Parameters& query_params)
 {
+  const bool cached = (model_cache_ != nullptr) && query_params.empty();
+  if (cached) {
+    RefreshModelCache(headers);
+    if (model_cache_->Lookup(
+            url_, "config", model_name, model_version, model_config)) {
+      return Error::Success;
+    }
+  }
+
   std::string request_uri(url_ + "/v2/models/" + model_name);
   if (!model_version.empty()) {
     request_uri = request_uri + "/versions/" + model_version;
   }
   request_uri = request_uri + "/config";
 
-  return Get(request_uri, headers, query_params, model_config);
+  Error err = Get(request_uri, headers, query_params, model_config);
+  if (cached && err.IsOk()) {
+    model_cache_->Insert(
+        url_, "config", model_name, model_version, *model_config);
+  }
+  return err;
+}
+
+void
+InferenceServerHttpClient::RefreshModelCache(const Headers& headers)
+{
+  if (!model_cache_->RefreshDue(url_)) {
+    return;
+  }
+  std::string index;
+  if (!ModelRepositoryIndex(&index, headers).IsOk()) {
+    return;
+  }
+  rapidjson::Document document;
+  document.Parse(index.c_str());
+  if (document.HasParseError() || !document.IsArray()) {
+    return;
+  }
+  // A model changes with the versions listed and their states
+  std::map<std::string, std::string> models;
+  for (const auto& model_json : document.GetArray()) {
+    const char* str;
+    size_t len;
+    if (!MemberAsString(model_json, "name", &str, &len).IsOk()) {
+      continue;
+    }
+    std::string& model = models[std::string(str, len)];
+    if (MemberAsString(model_json, "version", &str, &len).IsOk()) {
+      model.append(str, len);
+    }
+    model += ':';
+    if (MemberAsString(model_json, "state", &str, &len).IsOk()) {
+      model.append(str, len);
+    }
+    model += ';';
+  }
+  model_cache_->UpdateIndex(url_, models);
 }
 
 
@@ -1197,7 +3361,11 @@ InferenceServerHttpClient::LoadModel(
   }
 
   std::string response;
-  return Post(request_uri, buffer.Contents(), headers, query_params, &response);
+  err = Post(request_uri, buffer.Contents(), headers, query_params, &response);
+  if (model_cache_ != nullptr) {
+    model_cache_->InvalidateModel(url_, model_name);
+  }
+  return err;
 }
 
 Error
@@ -1210,7 +3378,11 @@ InferenceServerHttpClient::UnloadModel(
 
   std::string request;  // empty request body
   std::string response;
-  return Post(request_uri, request, headers, query_params, &response);
+  Error err = Post(request_uri, request, headers, query_params, &response);
+  if (model_cache_ != nullptr) {
+    model_cache_->InvalidateModel(url_, model_name);
+  }
+  return err;
 }
 
 
@@ -1434,8 +3606,25 @@ InferenceServerHttpClient::Infer(
   }
   request_uri = request_uri + "/infer";
 
-  std::shared_ptr<HttpInferRequest> sync_request(
-      new HttpInferRequest(nullptr /* callback */, verbose_));
+  // The outputs passed to 'output_data_callback' are not kept in the
+  // response, so it can't be cached.
+  std::string cache_key;
+  if ((response_cache_ != nullptr) &&
+      (client_options_.output_data_callback == nullptr) &&
+      ResponseCache::Key(options, inputs, outputs, &cache_key)) {
+    std::shared_ptr<void> cached = response_cache_->Lookup(cache_key);
+    UpdateCacheStat(cached != nullptr);
+    if (cached != nullptr) {
+      InferResultHttp::Create(
+          result, std::static_pointer_cast<HttpInferRequest>(cached));
+      return (*result)->RequestStatus();
+    }
+  } else {
+    cache_key.clear();
+  }
+
+  std::shared_ptr<HttpInferRequest> sync_request =
+      NewInferRequest(nullptr /* callback */);
 
   sync_request->Timer().Reset();
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
@@ -1444,37 +3633,87 @@ InferenceServerHttpClient::Infer(
     return CurlGlobal::Get().Status();
   }
 
-  err = PreRunProcessing(
-      easy_handle_, request_uri, options, inputs, outputs, headers,
-      query_params, request_compression_algorithm,
-      response_compression_algorithm, sync_request);
-  if (!err.IsOk()) {
-    return err;
-  }
+  // The calls made while another thread uses the handles of the client
+  // take a handle from the pool, and don't use the zero-copy transfer.
+  std::unique_lock<std::mutex> zero_copy_lock(
+      zero_copy_mutex_, std::defer_lock);
+  if (UseZeroCopySend(
+          request_uri, request_compression_algorithm,
+          response_compression_algorithm) &&
+      zero_copy_lock.try_lock()) {
+    sync_request->Timer().CaptureTimestamp(
+        RequestTimers::Kind::SERIALIZE_START);
+    err = PrepareRequestData(
+        options, inputs, outputs, request_compression_algorithm, sync_request);
+    sync_request->Timer().CaptureTimestamp(
+        RequestTimers::Kind::SERIALIZE_END);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if (!query_params.empty()) {
+      request_uri = request_uri + "?" + GetQueryString(query_params);
+    }
+
+    // SEND_START, SEND_END, RECV_START and RECV_END are set during this call.
+    err = ZeroCopyTransfer(request_uri, options, headers, sync_request);
+    if (!err.IsOk()) {
+      InferResultHttp::Create(result, err);
+      return err;
+    }
+  } else {
+    std::unique_lock<std::mutex> easy_handle_lock(
+        easy_handle_mutex_, std::try_to_lock);
+    void* easy_handle =
+        easy_handle_lock.owns_lock() ? easy_handle_ : AcquireEasyHandle();
+    sync_request->Timer().CaptureTimestamp(
+        RequestTimers::Kind::SERIALIZE_START);
+    err = PreRunProcessing(
+        easy_handle, request_uri, options, inputs, outputs, headers,
+        query_params, request_compression_algorithm,
+        response_compression_algorithm, sync_request);
+    sync_request->Timer().CaptureTimestamp(
+        RequestTimers::Kind::SERIALIZE_END);
+    if (!err.IsOk()) {
+      if (!easy_handle_lock.owns_lock()) {
+        ReleaseEasyHandle(easy_handle);
+      }
+      return err;
+    }
 
-  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+    sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
 
-  // Set SEND_END when content length is 0 (because
-  // CURLOPT_READFUNCTION will not be called). In that case, we can't
-  // measure SEND_END properly (send ends after sending request
-  // header).
-  if (sync_request->total_input_byte_size_ == 0) {
-    sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
-  }
+    // Set SEND_END when content length is 0 (because
+    // CURLOPT_READFUNCTION will not be called). In that case, we can't
+    // measure SEND_END properly (send ends after sending request
+    // header).
+    if (sync_request->total_input_byte_size_ == 0) {
+      sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    }
 
-  // During this call SEND_END (except in above case), RECV_START, and
-  // RECV_END will be set.
-  auto curl_status = curl_easy_perform(easy_handle_);
-  if (curl_status == CURLE_OPERATION_TIMEDOUT) {
-    sync_request->http_code_ = 499;
-  } else if (curl_status != CURLE_OK) {
-    sync_request->http_code_ = 400;
-  } else {
-    curl_easy_getinfo(
-        easy_handle_, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
+    // During this call SEND_END (except in above case), RECV_START, and
+    // RECV_END will be set.
+    auto curl_status = curl_easy_perform(easy_handle);
+    if (curl_status == CURLE_OPERATION_TIMEDOUT) {
+      sync_request->http_code_ = 499;
+    } else if (curl_status != CURLE_OK) {
+      sync_request->http_code_ = 400;
+    } else {
+      curl_easy_getinfo(
+          easy_handle, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
+      sync_request->CaptureWireResponseByteSize(easy_handle);
+      long new_connections = 0;
+      curl_easy_getinfo(easy_handle, CURLINFO_NUM_CONNECTS, &new_connections);
+      UpdateConnectionStat(new_connections == 0);
+    }
+    if (!easy_handle_lock.owns_lock()) {
+      ReleaseEasyHandle(easy_handle);
+    }
   }
 
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
   InferResultHttp::Create(result, sync_request);
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
 
@@ -1482,8 +3721,26 @@ InferenceServerHttpClient::Infer(
   if (!err.IsOk()) {
     std::cerr << "Failed to update context stat: " << err << std::endl;
   }
+  UpdateByteStat(
+      sync_request->total_input_byte_size_,
+      sync_request->UncompressedRequestByteSize(),
+      sync_request->WireResponseByteSize(), sync_request->ResponseByteSize());
 
   err = (*result)->RequestStatus();
+  UpdateMetrics(
+      options.model_name_, false /* in_flight */, sync_request->Timer(),
+      !err.IsOk(), sync_request->total_input_byte_size_,
+      sync_request->ResponseByteSize());
+  if (err.IsOk() && !cache_key.empty()) {
+    // The request holds the response, and is not reused while cached.
+    size_t byte_size = sync_request->infer_response_buffer_->capacity();
+    for (const auto& output : sync_request->streamed_outputs_) {
+      if (output.data_ != nullptr) {
+        byte_size += output.byte_size_;
+      }
+    }
+    response_cache_->Insert(cache_key, sync_request, byte_size);
+  }
 
   return err;
 }
@@ -1497,6 +3754,21 @@ InferenceServerHttpClient::AsyncInfer(
     const Headers& headers, const Parameters& query_params,
     const CompressionType request_compression_algorithm,
     const CompressionType response_compression_algorithm)
+{
+  return AsyncInfer(
+      nullptr, std::move(callback), options, inputs, outputs, headers,
+      query_params, request_compression_algorithm,
+      response_compression_algorithm);
+}
+
+Error
+InferenceServerHttpClient::AsyncInfer(
+    std::shared_ptr<AsyncRequestHandle>* handle, OnCompleteFn callback,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
 {
   if (callback == nullptr) {
     return Error(
@@ -1506,8 +3778,13 @@ InferenceServerHttpClient::AsyncInfer(
   std::shared_ptr<HttpInferRequest> async_request;
   if (!multi_handle_) {
     return Error("failed to start HTTP asynchronous client");
-  } else if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerHttpClient::AsyncTransfer, this);
+  }
+  StartAsyncWorker();
+  if (outstanding_limiter_ != nullptr) {
+    Error err = outstanding_limiter_->Acquire();
+    if (!err.IsOk()) {
+      return err;
+    }
   }
 
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
@@ -1516,47 +3793,149 @@ InferenceServerHttpClient::AsyncInfer(
   }
   request_uri = request_uri + "/infer";
 
-  HttpInferRequest* raw_async_request =
-      new HttpInferRequest(std::move(callback), verbose_);
-  async_request.reset(raw_async_request);
+  async_request = NewInferRequest(std::move(callback));
+  if (callback_pool_ != nullptr) {
+    async_request->callback_key_ = CallbackKey(options);
+  }
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
 
-  CURL* multi_easy_handle = curl_easy_init();
+  CURL* multi_easy_handle = reinterpret_cast<CURL*>(AcquireEasyHandle());
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
   Error err = PreRunProcessing(
       reinterpret_cast<void*>(multi_easy_handle), request_uri, options, inputs,
       outputs, headers, query_params, request_compression_algorithm,
       response_compression_algorithm, async_request);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
   if (!err.IsOk()) {
-    curl_easy_cleanup(multi_easy_handle);
+    ReleaseEasyHandle(multi_easy_handle);
+    ReleaseOutstanding();
     return err;
   }
+  if (handle != nullptr) {
+    // The transfer is aborted from its progress callback, which libcurl
+    // calls as data moves and about once per second otherwise.
+    curl_easy_setopt(multi_easy_handle, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(
+        multi_easy_handle, CURLOPT_XFERINFOFUNCTION, InferProgressHandler);
+    curl_easy_setopt(
+        multi_easy_handle, CURLOPT_XFERINFODATA, async_request.get());
+    handle->reset(new HttpAsyncRequestHandle(async_request));
+  }
+  if (metrics_ != nullptr) {
+    async_request->SetModelName(options.model_name_);
+    metrics_->RequestStarted(options.model_name_);
+  }
+
+  return SubmitAsyncRequest(multi_easy_handle, async_request);
+}
+
+void
+InferenceServerHttpClient::StartAsyncWorker()
+{
+  std::call_once(worker_started_, [this] {
+    if (client_options_.event_driven_async) {
+      worker_ =
+          std::thread(&InferenceServerHttpClient::AsyncEventTransfer, this);
+    } else {
+      worker_ = std::thread(&InferenceServerHttpClient::AsyncTransfer, this);
+    }
+  });
+}
+
+uint64_t
+InferenceServerHttpClient::CallbackKey(const InferOptions& options)
+{
+  // The requests of a sequence share a key so that their callbacks run in
+  // order, the other requests are spread over the threads.
+  if (options.sequence_id_ != 0) {
+    return options.sequence_id_;
+  } else if (!options.sequence_id_str_.empty()) {
+    return std::hash<std::string>()(options.sequence_id_str_);
+  }
+  return next_callback_key_++;
+}
+
+Error
+InferenceServerHttpClient::SubmitAsyncRequest(
+    void* easy_handle, const std::shared_ptr<HttpInferRequest>& request)
+{
+  if (client_options_.event_driven_async) {
+    // The handle is added to 'multi_handle_' by the event loop thread.
+    bool wakeup_needed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+      if (request->total_input_byte_size_ == 0) {
+        request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+      }
+      // The event loop takes all the pending requests at once, so only the
+      // request that finds the queue empty has to wake it up. The requests
+      // sent meanwhile are submitted in the same batch without a system
+      // call each.
+      wakeup_needed = pending_async_requests_.empty();
+      pending_async_requests_.emplace_back(
+          reinterpret_cast<uintptr_t>(easy_handle), request);
+    }
+#ifdef __linux__
+    if (wakeup_needed) {
+      uint64_t value = 1;
+      ssize_t written = write(wakeup_fd_, &value, sizeof(value));
+      (void)written;
+    }
+#else
+    (void)wakeup_needed;
+#endif  // __linux__
+    return Error::Success;
+  }
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
 
     auto insert_result = ongoing_async_requests_.emplace(std::make_pair(
-        reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
+        reinterpret_cast<uintptr_t>(easy_handle), request));
     if (!insert_result.second) {
-      curl_easy_cleanup(multi_easy_handle);
+      ReleaseEasyHandle(easy_handle);
+      ReleaseOutstanding();
       return Error("Failed to insert new asynchronous request context.");
     }
 
-    async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
-    if (async_request->total_input_byte_size_ == 0) {
+    request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+    if (request->total_input_byte_size_ == 0) {
       // Set SEND_END here because CURLOPT_READFUNCTION will not be called if
       // content length is 0. In that case, we can't measure SEND_END properly
       // (send ends after sending request header).
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+      request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
     }
 
-    curl_multi_add_handle(multi_handle_, multi_easy_handle);
+    curl_multi_add_handle(multi_handle_, easy_handle);
   }
 
   cv_.notify_all();
   return Error::Success;
 }
 
+Error
+InferenceServerHttpClient::AsyncInferFuture(
+    std::future<InferResult*>* result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  std::future<InferResult*> future;
+  Error err = AsyncInfer(
+      PromiseCallback(&future), options, inputs, outputs, headers,
+      query_params, request_compression_algorithm,
+      response_compression_algorithm);
+  if (err.IsOk()) {
+    *result = std::move(future);
+  }
+  return err;
+}
+
 Error
 InferenceServerHttpClient::InferMulti(
     std::vector<InferResult*>* results,
@@ -1580,6 +3959,28 @@ InferenceServerHttpClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
+  // The requests are sent asynchronously with at most
+  // 'infer_multi_max_in_flight' of them waiting for their responses, the
+  // results are collected in the order of the requests. A request that
+  // belongs to a sequence is not sent until the previous request of the same
+  // sequence has completed, so that the sequence reaches the server in order.
+  struct MultiState {
+    std::mutex mu;
+    std::condition_variable cv;
+    size_t in_flight = 0;
+    std::set<std::string> sequences;
+  };
+  std::shared_ptr<MultiState> state = std::make_shared<MultiState>();
+  size_t max_in_flight =
+      std::max<size_t>(1, client_options_.infer_multi_max_in_flight);
+  if (client_options_.max_outstanding_requests > 0) {
+    max_in_flight = std::min(
+        max_in_flight, client_options_.max_outstanding_requests);
+  }
+
+  const size_t first_result = results->size();
+  results->resize(first_result + inputs.size(), nullptr);
+
   int64_t max_option_idx = options.size() - 1;
   // value of '-1' means no output is specified
   int64_t max_output_idx = outputs.size() - 1;
@@ -1589,12 +3990,56 @@ InferenceServerHttpClient::InferMulti(
     const auto& request_output = (max_output_idx == -1)
                                      ? empty_outputs
                                      : outputs[std::min(max_output_idx, i)];
+    InferResult** result = &(*results)[first_result + i];
+    std::string sequence;
+    if (request_options.sequence_id_ != 0) {
+      sequence = "id:" + std::to_string(request_options.sequence_id_);
+    } else if (!request_options.sequence_id_str_.empty()) {
+      sequence = "str:" + request_options.sequence_id_str_;
+    }
 
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
-        query_params, request_compression_algorithm,
-        response_compression_algorithm);
+    {
+      std::unique_lock<std::mutex> lock(state->mu);
+      state->cv.wait(lock, [&state, &sequence, max_in_flight] {
+        return (state->in_flight < max_in_flight) &&
+               (sequence.empty() || (state->sequences.count(sequence) == 0));
+      });
+      state->in_flight++;
+      if (!sequence.empty()) {
+        state->sequences.insert(sequence);
+      }
+    }
+
+    OnCompleteFn cb = [state, result, sequence](InferResult* infer_result) {
+      std::lock_guard<std::mutex> lock(state->mu);
+      *result = infer_result;
+      state->in_flight--;
+      if (!sequence.empty()) {
+        state->sequences.erase(sequence);
+      }
+      state->cv.notify_all();
+    };
+    err = AsyncInfer(
+        cb, request_options, inputs[i], request_output, headers, query_params,
+        request_compression_algorithm, response_compression_algorithm);
+    if (!err.IsOk()) {
+      InferResult* err_result;
+      Error create_err = InferResultHttp::Create(&err_result, err);
+      if (!create_err.IsOk()) {
+        std::cerr << "Failed to create result for error: "
+                  << create_err.Message() << std::endl;
+      }
+      cb(err_result);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(state->mu);
+    state->cv.wait(lock, [&state] { return state->in_flight == 0; });
+  }
+
+  for (size_t i = first_result; i < results->size(); ++i) {
+    err = (*results)[i]->RequestStatus();
     if (!err.IsOk()) {
       return err;
     }
@@ -1669,6 +4114,118 @@ InferenceServerHttpClient::AsyncInferMulti(
   return Error::Success;
 }
 
+Error
+InferenceServerHttpClient::StartStream(
+    OnCompleteFn callback, bool enable_stats, uint32_t stream_timeout,
+    const Headers& headers)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with StartStream() call.");
+  }
+
+  std::lock_guard<std::mutex> lock(stream_mutex_);
+  if (stream_callback_ != nullptr) {
+    return Error(
+        "cannot start another stream with one already running. "
+        "'InferenceServerClient' supports only a single active "
+        "stream at a given time.");
+  }
+  stream_callback_ = std::move(callback);
+  stream_enable_stats_ = enable_stats;
+  stream_timeout_ = stream_timeout;
+  stream_headers_ = headers;
+
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::StopStream()
+{
+  std::unique_lock<std::mutex> lock(stream_mutex_);
+  stream_cv_.wait(lock, [this] { return stream_in_flight_ == 0; });
+  stream_callback_ = nullptr;
+  stream_headers_.clear();
+
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (!multi_handle_) {
+    return Error("failed to start HTTP asynchronous client");
+  }
+
+  OnCompleteFn callback;
+  bool enable_stats;
+  uint32_t stream_timeout;
+  Headers headers;
+  {
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    if (stream_callback_ == nullptr) {
+      return Error(
+          "stream not available, use StartStream() to make one available.");
+    }
+    callback = stream_callback_;
+    enable_stats = stream_enable_stats_;
+    stream_timeout = stream_timeout_;
+    headers = stream_headers_;
+    ++stream_in_flight_;
+  }
+
+  StartAsyncWorker();
+  if (outstanding_limiter_ != nullptr) {
+    Error err = outstanding_limiter_->Acquire();
+    if (!err.IsOk()) {
+      EndStreamRequest();
+      return err;
+    }
+  }
+
+  std::string request_uri(url_ + "/v2/models/" + options.model_name_);
+  if (!options.model_version_.empty()) {
+    request_uri = request_uri + "/versions/" + options.model_version_;
+  }
+  request_uri = request_uri + "/generate_stream";
+
+  std::shared_ptr<HttpInferRequest> async_request =
+      NewInferRequest(std::move(callback));
+  if (callback_pool_ != nullptr) {
+    async_request->callback_key_ = CallbackKey(options);
+  }
+  async_request->event_stream_client_ = this;
+  async_request->event_stream_stats_ = enable_stats;
+
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+
+  CURL* multi_easy_handle = reinterpret_cast<CURL*>(AcquireEasyHandle());
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  Error err = PrepareStreamTransfer(
+      reinterpret_cast<void*>(multi_easy_handle), request_uri, options,
+      inputs, stream_timeout, headers, async_request);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
+  if (!err.IsOk()) {
+    ReleaseEasyHandle(multi_easy_handle);
+    ReleaseOutstanding();
+    EndStreamRequest();
+    return err;
+  }
+  if (metrics_ != nullptr) {
+    async_request->SetModelName(options.model_name_);
+    metrics_->RequestStarted(options.model_name_);
+  }
+
+  err = SubmitAsyncRequest(multi_easy_handle, async_request);
+  if (!err.IsOk()) {
+    EndStreamRequest();
+  }
+  return err;
+}
+
 size_t
 InferenceServerHttpClient::InferRequestProvider(
     void* contents, size_t size, size_t nmemb, void* userp)
@@ -1683,287 +4240,1254 @@ InferenceServerHttpClient::InferRequestProvider(
     return CURL_READFUNC_ABORT;
   }
 
-  return input_bytes;
+  return input_bytes;
+}
+
+size_t
+InferenceServerHttpClient::InferResponseHeaderHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t byte_size = size * nmemb;
+
+  size_t idx = strlen(kInferHeaderContentLengthHTTPHeader);
+  size_t length_idx = strlen(kContentLengthHTTPHeader);
+  if ((idx < byte_size) &&
+      !strncasecmp(buf, kInferHeaderContentLengthHTTPHeader, idx)) {
+    while ((idx < byte_size) && (buf[idx] != ':')) {
+      ++idx;
+    }
+
+    if (idx < byte_size) {
+      std::string hdr(buf + idx + 1, byte_size - idx - 1);
+      request->response_json_size_ = std::stoi(hdr);
+    }
+  } else if (
+      (length_idx < byte_size) &&
+      !strncasecmp(buf, kContentLengthHTTPHeader, length_idx)) {
+    while ((length_idx < byte_size) && (buf[length_idx] != ':')) {
+      ++length_idx;
+    }
+
+    if (length_idx < byte_size) {
+      std::string hdr(buf + length_idx + 1, byte_size - length_idx - 1);
+      request->infer_response_buffer_->reserve(std::stoi(hdr));
+    }
+  }
+
+  return byte_size;
+}
+
+size_t
+InferenceServerHttpClient::InferResponseHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  if (request->Timer().Timestamp(RequestTimers::Kind::RECV_START) == 0) {
+    request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  }
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t result_bytes = size * nmemb;
+  if (request->stream_response_outputs_ &&
+      (request->response_json_size_ != 0)) {
+    Error err = request->ParseResponseChunk(buf, result_bytes);
+    if (!err.IsOk()) {
+      std::cerr << "ResponseHandler: " << err << std::endl;
+      return 0;
+    }
+  } else {
+    request->infer_response_buffer_->append(buf, result_bytes);
+  }
+
+  // InferResponseHandler may be called multiple times so we overwrite
+  // RECV_END so that we always have the time of the last.
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
+
+  return result_bytes;
+}
+
+size_t
+InferenceServerHttpClient::StreamResponseHeaderHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t byte_size = size * nmemb;
+
+  // The status line tells whether the body is the event stream or an error
+  static const char kStatusLinePrefix[] = "HTTP/";
+  const size_t prefix_size = sizeof(kStatusLinePrefix) - 1;
+  if ((byte_size > prefix_size) &&
+      !strncmp(buf, kStatusLinePrefix, prefix_size)) {
+    std::string line(buf, byte_size);
+    size_t code_idx = line.find(' ');
+    if (code_idx != std::string::npos) {
+      request->http_code_ = std::strtol(line.c_str() + code_idx, nullptr, 10);
+    }
+  }
+
+  return byte_size;
+}
+
+size_t
+InferenceServerHttpClient::StreamResponseHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  if (request->Timer().Timestamp(RequestTimers::Kind::RECV_START) == 0) {
+    request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  }
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t result_bytes = size * nmemb;
+  if (request->http_code_ != 200) {
+    // The error of the request, parsed once it is complete
+    request->infer_response_buffer_->append(buf, result_bytes);
+  } else {
+    request->event_byte_size_ += result_bytes;
+    request->event_buffer_.append(buf, result_bytes);
+    request->event_stream_client_->DispatchStreamEvents(
+        request, false /* end_of_stream */);
+  }
+
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
+
+  return result_bytes;
+}
+
+Error
+InferenceServerHttpClient::PrepareInfer(
+    std::shared_ptr<PreparedInferRequest>* prepared,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::shared_ptr<HttpPreparedInferRequest> http_prepared(
+      new HttpPreparedInferRequest());
+  Error err = http_prepared->RecordInputs(inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  triton::common::TritonJson::Value request_json(
+      triton::common::TritonJson::ValueType::OBJECT);
+  err = HttpInferRequest::PrepareRequestJson(
+      options, inputs, outputs, &request_json, false /* add_id */);
+  if (!err.IsOk()) {
+    return err;
+  }
+  triton::common::TritonJson::WriteBuffer buffer;
+  request_json.Write(&buffer);
+  http_prepared->header_ = buffer.Contents();
+
+  *prepared = std::move(http_prepared);
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::CompressInputs(
+    std::shared_ptr<CompressedInferInputs>* compressed,
+    const std::vector<InferInput*>& inputs, const CompressionType type)
+{
+  if (type == CompressionType::NONE) {
+    return Error("can't compress data with NONE type");
+  }
+
+  std::deque<std::pair<uint8_t*, size_t>> source;
+  size_t source_byte_size = 0;
+  for (const auto this_input : inputs) {
+    if (!this_input->IsSharedMemory()) {
+      Error err = this_input->PrepareForRequest();
+      if (!err.IsOk()) {
+        return err;
+      }
+      bool end_of_input = false;
+      while (!end_of_input) {
+        const uint8_t* buf;
+        size_t buf_size;
+        this_input->GetNext(&buf, &buf_size, &end_of_input);
+        if (buf != nullptr) {
+          source.emplace_back(const_cast<uint8_t*>(buf), buf_size);
+          source_byte_size += buf_size;
+        }
+      }
+    }
+  }
+
+  std::shared_ptr<HttpCompressedInferInputs> http_compressed(
+      new HttpCompressedInferInputs());
+  http_compressed->type_ = type;
+  http_compressed->byte_size_ = source_byte_size;
+  Error err = CompressChunk(
+      type, source, 0, source_byte_size, true /* last_chunk */,
+      &http_compressed->data_, &http_compressed->checksum_);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  *compressed = std::move(http_compressed);
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::PrepareRequestData(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const CompressionType request_compression_algorithm,
+    std::shared_ptr<HttpInferRequest>& http_request)
+{
+  // Prepare the request object to provide the data for inference.
+  Error err = http_request->InitializeRequest(options, inputs, outputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  // The input data compressed beforehand follows the JSON header
+  if (options.compressed_inputs_ != nullptr) {
+    if (request_compression_algorithm == CompressionType::NONE) {
+      return Error(
+          "The input data is compressed but the request is not compressed.");
+    }
+    return http_request->UseCompressedInputs(
+        request_compression_algorithm, options.compressed_inputs_, inputs);
+  }
+
+  // Add the buffers holding input tensor data
+  for (const auto this_input : inputs) {
+    if (!this_input->IsSharedMemory()) {
+      this_input->PrepareForRequest();
+      bool end_of_input = false;
+      while (!end_of_input) {
+        const uint8_t* buf;
+        size_t buf_size;
+        this_input->GetNext(&buf, &buf_size, &end_of_input);
+        if (buf != nullptr) {
+          http_request->AddInput(const_cast<uint8_t*>(buf), buf_size);
+        }
+      }
+      http_request->shared_inputs_.insert(
+          http_request->shared_inputs_.end(),
+          this_input->shared_bufs_.begin(), this_input->shared_bufs_.end());
+    }
+  }
+
+  // Compress data if requested
+  switch (request_compression_algorithm) {
+    case CompressionType::NONE:
+      break;
+    case CompressionType::DEFLATE:
+    case CompressionType::GZIP:
+      http_request->CompressInput(
+          request_compression_algorithm,
+          client_options_.compression_chunk_byte_size,
+          client_options_.compression_thread_count);
+      break;
+  }
+
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::PreRunProcessing(
+    void* vcurl, std::string& request_uri, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm,
+    std::shared_ptr<HttpInferRequest>& http_request)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+
+  Error err = PrepareRequestData(
+      options, inputs, outputs, request_compression_algorithm, http_request);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  // Prepare curl
+  if (!query_params.empty()) {
+    request_uri = request_uri + "?" + GetQueryString(query_params);
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  curl_easy_setopt(curl, CURLOPT_POST, 1L);
+  curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+
+  if (options.client_timeout_ != 0) {
+    uint64_t timeout_ms = (options.client_timeout_ / 1000);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+  }
+
+  if (verbose_) {
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+  }
+
+  const long buffer_byte_size = 16 * 1024 * 1024;
+  curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, buffer_byte_size);
+  curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, buffer_byte_size);
+
+  // request data provided by InferRequestProvider()
+  curl_easy_setopt(curl, CURLOPT_READFUNCTION, InferRequestProvider);
+  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
+
+  // response headers handled by InferResponseHeaderHandler()
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, InferResponseHeaderHandler);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
+
+  // response data handled by InferResponseHandler()
+  http_request->stream_response_outputs_ =
+      client_options_.stream_response_outputs ||
+      !http_request->user_buffers_.empty();
+  http_request->output_data_callback_ = &client_options_.output_data_callback;
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, InferResponseHandler);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
+
+  const curl_off_t post_byte_size = http_request->total_input_byte_size_;
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
+
+  err = SetSSLCurlOptions(&curl, ssl_options_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  SetHttpVersionCurlOptions(curl, request_uri, client_options_);
+  SetTransferRateCurlOptions(curl, client_options_);
+  SetShareCurlOptions(curl, share_handle_);
+  SetUnixSocketCurlOptions(curl, unix_socket_path_);
+
+  struct curl_slist* list = nullptr;
+
+  std::string infer_hdr{std::string(kInferHeaderContentLengthHTTPHeader) +
+                        ": " +
+                        std::to_string(http_request->RequestJsonSize())};
+  list = curl_slist_append(list, infer_hdr.c_str());
+  list = curl_slist_append(list, "Expect:");
+  list = curl_slist_append(list, "Content-Type: application/octet-stream");
+  for (const auto& pr : headers) {
+    std::string hdr = pr.first + ": " + pr.second;
+    list = curl_slist_append(list, hdr.c_str());
+  }
+
+  // Compress data if requested
+  switch (request_compression_algorithm) {
+    case CompressionType::NONE:
+      break;
+    case CompressionType::DEFLATE:
+      list = curl_slist_append(list, "Content-Encoding: deflate");
+      break;
+    case CompressionType::GZIP:
+      list = curl_slist_append(list, "Content-Encoding: gzip");
+      break;
+  }
+  switch (response_compression_algorithm) {
+    case CompressionType::NONE:
+      break;
+    case CompressionType::DEFLATE:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
+      break;
+    case CompressionType::GZIP:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
+      break;
+  }
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+
+  // The list will be freed when the request is destructed
+  http_request->header_list_ = list;
+
+  if (verbose_) {
+    std::cout << "inference request: "
+              << std::string(
+                     http_request->RequestJsonBase(),
+                     http_request->RequestJsonSize())
+              << std::endl;
+  }
+
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::PrepareStreamTransfer(
+    void* vcurl, const std::string& request_uri, const InferOptions& options,
+    const std::vector<InferInput*>& inputs, const uint32_t stream_timeout,
+    const Headers& headers, std::shared_ptr<HttpInferRequest>& http_request)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+
+  Error err = http_request->InitializeStreamRequest(options, inputs);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  curl_easy_setopt(curl, CURLOPT_POST, 1L);
+  curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+
+  const uint64_t timeout_us =
+      (options.client_timeout_ != 0) ? options.client_timeout_ : stream_timeout;
+  if (timeout_us != 0) {
+    uint64_t timeout_ms = (timeout_us / 1000);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+  }
+
+  if (verbose_) {
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+  }
+
+  // The request body is provided by InferRequestProvider(), the events are
+  // handled by StreamResponseHandler() as they are received.
+  curl_easy_setopt(curl, CURLOPT_READFUNCTION, InferRequestProvider);
+  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, StreamResponseHeaderHandler);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, StreamResponseHandler);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
+
+  const curl_off_t post_byte_size = http_request->total_input_byte_size_;
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
+
+  err = SetSSLCurlOptions(&curl, ssl_options_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  SetHttpVersionCurlOptions(curl, request_uri, client_options_);
+  SetTransferRateCurlOptions(curl, client_options_);
+  SetShareCurlOptions(curl, share_handle_);
+  SetUnixSocketCurlOptions(curl, unix_socket_path_);
+
+  struct curl_slist* list = nullptr;
+  list = curl_slist_append(list, "Expect:");
+  list = curl_slist_append(list, "Content-Type: application/json");
+  list = curl_slist_append(list, "Accept: text/event-stream");
+  for (const auto& pr : headers) {
+    std::string hdr = pr.first + ": " + pr.second;
+    list = curl_slist_append(list, hdr.c_str());
+  }
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+
+  // The list will be freed when the request is destructed
+  http_request->header_list_ = list;
+
+  if (verbose_) {
+    std::cout << "stream request: " << http_request->stream_body_
+              << std::endl;
+  }
+
+  return Error::Success;
+}
+
+void
+InferenceServerHttpClient::AsyncTransfer()
+{
+  int place_holder = 0;
+  do {
+    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+
+    // sleep if no work is available
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+      if (this->exiting_) {
+        return true;
+      }
+      // wake up if an async request has been generated
+      return !this->ongoing_async_requests_.empty();
+    });
+
+    CURLMcode mc = curl_multi_perform(multi_handle_, &place_holder);
+    int numfds;
+    if (mc == CURLM_OK) {
+      // Wait for activity. If there are no descripters in the multi_handle_
+      // then curl_multi_wait will return immediately
+      mc = curl_multi_wait(multi_handle_, NULL, 0, INT_MAX, &numfds);
+      if (mc == CURLM_OK) {
+        CollectCompletedAsyncRequests(&request_list);
+      } else {
+        std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                  << std::endl;
+      }
+    } else {
+      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                << std::endl;
+    }
+    lock.unlock();
+
+    for (auto& this_request : request_list) {
+      CompleteAsyncRequest(this_request);
+    }
+  } while (!exiting_);
+}
+
+void
+InferenceServerHttpClient::CollectCompletedAsyncRequests(
+    std::vector<std::shared_ptr<HttpInferRequest>>* completed_requests)
+{
+  int place_holder = 0;
+  CURLMsg* msg = nullptr;
+  while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
+    uintptr_t identifier = reinterpret_cast<uintptr_t>(msg->easy_handle);
+    auto itr = ongoing_async_requests_.find(identifier);
+    // This shouldn't happen
+    if (itr == ongoing_async_requests_.end()) {
+      std::cerr << "Unexpected error: received completed request that is not "
+                   "in the list of asynchronous requests"
+                << std::endl;
+      curl_multi_remove_handle(multi_handle_, msg->easy_handle);
+      curl_easy_cleanup(msg->easy_handle);
+      continue;
+    }
+
+    long http_code = 400;
+    if (msg->data.result == CURLE_OK) {
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
+      itr->second->CaptureWireResponseByteSize(msg->easy_handle);
+      long new_connections = 0;
+      curl_easy_getinfo(
+          msg->easy_handle, CURLINFO_NUM_CONNECTS, &new_connections);
+      UpdateConnectionStat(new_connections == 0);
+    } else if (msg->data.result == CURLE_OPERATION_TIMEDOUT) {
+      http_code = 499;
+    }
+
+    completed_requests->emplace_back(itr->second);
+    ongoing_async_requests_.erase(itr);
+    curl_multi_remove_handle(multi_handle_, msg->easy_handle);
+    ReleaseEasyHandle(msg->easy_handle);
+
+    std::shared_ptr<HttpInferRequest> async_request =
+        completed_requests->back();
+    async_request->http_code_ = http_code;
+    async_request->cancelled_ =
+        (msg->data.result == CURLE_ABORTED_BY_CALLBACK);
+
+    if (msg->msg != CURLMSG_DONE) {
+      // Something wrong happened.
+      std::cerr << "Unexpected error: received CURLMsg=" << msg->msg
+                << std::endl;
+    }
+  }
+}
+
+void
+InferenceServerHttpClient::CompleteAsyncRequest(
+    const std::shared_ptr<HttpInferRequest>& request)
+{
+  if (request->event_stream_) {
+    CompleteStreamRequest(request);
+    return;
+  }
+
+  // The response is parsed outside of the lock, but before the end of the
+  // request so that the parsing is part of the request statistics
+  InferResult* result;
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
+  InferResultHttp::Create(&result, request);
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Error err = UpdateInferStat(request->Timer());
+    if (!err.IsOk()) {
+      std::cerr << "Failed to update context stat: " << err << std::endl;
+    }
+  }
+  UpdateByteStat(
+      request->total_input_byte_size_, request->UncompressedRequestByteSize(),
+      request->WireResponseByteSize(), request->ResponseByteSize());
+  UpdateMetrics(
+      request->ModelName(), true /* in_flight */, request->Timer(),
+      !result->RequestStatus().IsOk(), request->total_input_byte_size_,
+      request->ResponseByteSize());
+  ReleaseOutstanding();
+  if (callback_pool_ != nullptr) {
+    OnCompleteFn callback = request->callback_;
+    callback_pool_->Submit(
+        request->callback_key_, [callback, result]() { callback(result); });
+  } else {
+    RunCompletion(request->callback_, result);
+  }
+}
+
+void
+InferenceServerHttpClient::DispatchStreamEvents(
+    HttpInferRequest* request, bool end_of_stream)
+{
+  // An event is made of lines ended by an empty line. Only its 'data'
+  // fields are used, the other fields and the comments are ignored.
+  auto dispatch_event = [this, request]() {
+    std::string& data = request->event_data_;
+    if (data.empty()) {
+      return;
+    }
+    // Without the newline following the last data line
+    data.pop_back();
+    InferResult* result;
+    InferResultHttpEvent::Create(&result, data, request->request_id_);
+    data.clear();
+    if (!result->RequestStatus().IsOk()) {
+      request->event_error_delivered_ = true;
+    }
+    DeliverStreamResult(request, result);
+  };
+
+  const std::string& buffer = request->event_buffer_;
+  size_t line_start = 0;
+  while (line_start < buffer.size()) {
+    size_t line_end = buffer.find('\n', line_start);
+    if (line_end == std::string::npos) {
+      if (!end_of_stream) {
+        break;
+      }
+      line_end = buffer.size();
+    }
+    size_t line_size = line_end - line_start;
+    if ((line_size > 0) && (buffer[line_end - 1] == '\r')) {
+      --line_size;
+    }
+
+    if (line_size == 0) {
+      dispatch_event();
+    } else if (
+        (line_size >= 5) && (buffer.compare(line_start, 5, "data:") == 0)) {
+      size_t value_start = line_start + 5;
+      if ((value_start < (line_start + line_size)) &&
+          (buffer[value_start] == ' ')) {
+        ++value_start;
+      }
+      request->event_data_.append(
+          buffer, value_start, line_start + line_size - value_start);
+      request->event_data_.push_back('\n');
+    }
+    line_start = std::min(line_end + 1, buffer.size());
+  }
+  request->event_buffer_.erase(0, line_start);
+
+  if (end_of_stream) {
+    dispatch_event();
+  }
+}
+
+void
+InferenceServerHttpClient::DeliverStreamResult(
+    HttpInferRequest* request, InferResult* result)
+{
+  if (callback_pool_ != nullptr) {
+    OnCompleteFn callback = request->callback_;
+    callback_pool_->Submit(
+        request->callback_key_, [callback, result]() { callback(result); });
+  } else {
+    RunCompletion(request->callback_, result);
+  }
+}
+
+void
+InferenceServerHttpClient::CompleteStreamRequest(
+    const std::shared_ptr<HttpInferRequest>& request)
+{
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
+  Error status;
+  if (request->http_code_ == 499) {
+    status = Error("Deadline Exceeded");
+  } else if (request->cancelled_) {
+    status = Error("Request cancelled");
+  } else if (request->http_code_ != 200) {
+    status = Error("inference failed with unknown error");
+    rapidjson::Document document;
+    document.Parse(request->infer_response_buffer_->c_str());
+    const char* err_str;
+    size_t err_strlen;
+    if (!document.HasParseError() &&
+        MemberAsString(document, "error", &err_str, &err_strlen).IsOk()) {
+      status = Error(std::string(err_str, err_strlen));
+    }
+  } else {
+    // The last event may not be followed by its empty line
+    DispatchStreamEvents(request.get(), true /* end_of_stream */);
+  }
+
+  // The request ends with its error, or with a null final response if the
+  // server did not report one among the events.
+  InferResult* result = nullptr;
+  if (!status.IsOk()) {
+    InferResultHttp::Create(&result, status);
+  } else if (!request->event_error_delivered_) {
+    InferResultHttpEvent::CreateFinal(&result, request->request_id_);
+  }
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
+  request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+  if (request->event_stream_stats_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Error err = UpdateInferStat(request->Timer());
+    if (!err.IsOk()) {
+      std::cerr << "Failed to update context stat: " << err << std::endl;
+    }
+    UpdateByteStat(
+        request->total_input_byte_size_, request->UncompressedRequestByteSize(),
+        request->WireResponseByteSize(), request->ResponseByteSize());
+  }
+  UpdateMetrics(
+      request->ModelName(), true /* in_flight */, request->Timer(),
+      !status.IsOk() || request->event_error_delivered_,
+      request->total_input_byte_size_, request->ResponseByteSize());
+  ReleaseOutstanding();
+  if (result != nullptr) {
+    DeliverStreamResult(request.get(), result);
+  }
+  EndStreamRequest();
+}
+
+void
+InferenceServerHttpClient::EndStreamRequest()
+{
+  std::lock_guard<std::mutex> lock(stream_mutex_);
+  if (--stream_in_flight_ == 0) {
+    stream_cv_.notify_all();
+  }
+}
+
+#ifdef __linux__
+Error
+InferenceServerHttpClient::InitEventLoop()
+{
+  if (multi_handle_ == nullptr) {
+    return Error("failed to start HTTP asynchronous client");
+  }
+  wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wakeup_fd_ == -1) {
+    return Error(
+        "failed to create eventfd for the HTTP event loop: " +
+        std::string(strerror(errno)));
+  }
+  curl_multi_setopt(multi_handle_, CURLMOPT_SOCKETFUNCTION, MultiSocketHandler);
+  curl_multi_setopt(multi_handle_, CURLMOPT_SOCKETDATA, this);
+  curl_multi_setopt(multi_handle_, CURLMOPT_TIMERFUNCTION, MultiTimerHandler);
+  curl_multi_setopt(multi_handle_, CURLMOPT_TIMERDATA, this);
+
+  // Fall back to epoll when the build or the kernel doesn't support
+  // io_uring.
+  constexpr unsigned kIoUringEntries = 256;
+  if (IoUringPoller::Create(&io_uring_poller_, kIoUringEntries).IsOk()) {
+    io_uring_poller_->Set(wakeup_fd_, EPOLLIN);
+    return Error::Success;
+  }
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ == -1) {
+    return Error(
+        "failed to create epoll instance: " + std::string(strerror(errno)));
+  }
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = wakeup_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event) == -1) {
+    return Error(
+        "failed to register eventfd for the HTTP event loop: " +
+        std::string(strerror(errno)));
+  }
+  return Error::Success;
+}
+
+int
+InferenceServerHttpClient::MultiSocketHandler(
+    void* easy_handle, int socket, int what, void* userp, void* socketp)
+{
+  InferenceServerHttpClient* client =
+      reinterpret_cast<InferenceServerHttpClient*>(userp);
+  if (client->io_uring_poller_ != nullptr) {
+    if (what == CURL_POLL_REMOVE) {
+      client->io_uring_poller_->Remove(socket);
+      return 0;
+    }
+    // A socket number reused after a close without CURL_POLL_REMOVE is
+    // still watched for the closed socket, which is replaced.
+    if (socketp == nullptr) {
+      client->io_uring_poller_->Remove(socket);
+      curl_multi_assign(client->multi_handle_, socket, client);
+    }
+    uint32_t events = 0;
+    if (what & CURL_POLL_IN) {
+      events |= EPOLLIN;
+    }
+    if (what & CURL_POLL_OUT) {
+      events |= EPOLLOUT;
+    }
+    client->io_uring_poller_->Set(socket, events);
+    return 0;
+  }
+
+  if (what == CURL_POLL_REMOVE) {
+    // The socket may already be closed, in which case it has been removed
+    // from the epoll set by the kernel.
+    epoll_ctl(client->epoll_fd_, EPOLL_CTL_DEL, socket, nullptr);
+    client->socket_events_.erase(socket);
+    return 0;
+  }
+
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.data.fd = socket;
+  if (what & CURL_POLL_IN) {
+    event.events |= EPOLLIN;
+  }
+  if (what & CURL_POLL_OUT) {
+    event.events |= EPOLLOUT;
+  }
+  // 'socketp' is set once the socket is registered to the epoll set. A
+  // socket number reused after a close without CURL_POLL_REMOVE is still in
+  // the epoll set, so fall back to modifying it.
+  if (socketp == nullptr) {
+    if ((epoll_ctl(client->epoll_fd_, EPOLL_CTL_ADD, socket, &event) == -1) &&
+        (errno == EEXIST)) {
+      epoll_ctl(client->epoll_fd_, EPOLL_CTL_MOD, socket, &event);
+    }
+    curl_multi_assign(client->multi_handle_, socket, client);
+  } else {
+    // A kept-alive connection is handed the same events again for each
+    // request it carries, which needs no change to the epoll set.
+    auto it = client->socket_events_.find(socket);
+    if ((it != client->socket_events_.end()) &&
+        (it->second == event.events)) {
+      return 0;
+    }
+    epoll_ctl(client->epoll_fd_, EPOLL_CTL_MOD, socket, &event);
+  }
+  client->socket_events_[socket] = event.events;
+  return 0;
+}
+
+int
+InferenceServerHttpClient::MultiTimerHandler(
+    void* multi_handle, long timeout_ms, void* userp)
+{
+  InferenceServerHttpClient* client =
+      reinterpret_cast<InferenceServerHttpClient*>(userp);
+  if (timeout_ms < 0) {
+    client->timer_pending_ = false;
+  } else {
+    client->timer_pending_ = true;
+    client->timer_deadline_ns_ =
+        SteadyNowNs() + static_cast<uint64_t>(timeout_ms) * 1000 * 1000;
+  }
+  return 0;
+}
+
+void
+InferenceServerHttpClient::AddPendingAsyncRequests()
+{
+  std::vector<std::pair<uintptr_t, std::shared_ptr<HttpInferRequest>>>
+      pending_requests;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_requests.swap(pending_async_requests_);
+  }
+  for (auto& request : pending_requests) {
+    auto insert_result = ongoing_async_requests_.emplace(request);
+    if (!insert_result.second) {
+      std::cerr << "Failed to insert new asynchronous request context."
+                << std::endl;
+      ReleaseEasyHandle(reinterpret_cast<void*>(request.first));
+      ReleaseOutstanding();
+      continue;
+    }
+    curl_multi_add_handle(
+        multi_handle_, reinterpret_cast<CURL*>(request.first));
+  }
+}
+
+void
+InferenceServerHttpClient::AsyncEventTransfer()
+{
+  constexpr int kMaxEvents = 64;
+  struct epoll_event events[kMaxEvents];
+  int running_handles = 0;
+  while (!exiting_) {
+    int timeout_ms = -1;
+    if (timer_pending_) {
+      const uint64_t now_ns = SteadyNowNs();
+      timeout_ms = (timer_deadline_ns_ <= now_ns)
+                       ? 0
+                       : std::min<uint64_t>(
+                             (timer_deadline_ns_ - now_ns + 999999) / 1000000,
+                             INT_MAX);
+    }
+
+    const int event_count =
+        (io_uring_poller_ != nullptr)
+            ? io_uring_poller_->Wait(events, kMaxEvents, timeout_ms)
+            : epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+    if (event_count == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "Unexpected error: waiting for socket events failed: "
+                << strerror(errno) << std::endl;
+      break;
+    }
+
+    for (int i = 0; i < event_count; ++i) {
+      if (events[i].data.fd == wakeup_fd_) {
+        uint64_t value;
+        ssize_t bytes = read(wakeup_fd_, &value, sizeof(value));
+        (void)bytes;
+        AddPendingAsyncRequests();
+        continue;
+      }
+      int action = 0;
+      if (events[i].events & EPOLLIN) {
+        action |= CURL_CSELECT_IN;
+      }
+      if (events[i].events & EPOLLOUT) {
+        action |= CURL_CSELECT_OUT;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        action |= CURL_CSELECT_ERR;
+      }
+      CURLMcode mc = curl_multi_socket_action(
+          multi_handle_, events[i].data.fd, action, &running_handles);
+      if (mc != CURLM_OK) {
+        std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                  << std::endl;
+      }
+    }
+
+    // Handle the libcurl timeout, which is also how newly added handles are
+    // started.
+    if (timer_pending_ && (timer_deadline_ns_ <= SteadyNowNs())) {
+      timer_pending_ = false;
+      CURLMcode mc = curl_multi_socket_action(
+          multi_handle_, CURL_SOCKET_TIMEOUT, 0, &running_handles);
+      if (mc != CURLM_OK) {
+        std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                  << std::endl;
+      }
+    }
+
+    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+    CollectCompletedAsyncRequests(&request_list);
+    for (auto& this_request : request_list) {
+      CompleteAsyncRequest(this_request);
+    }
+  }
+}
+#else
+Error
+InferenceServerHttpClient::InitEventLoop()
+{
+  return Error("event driven asynchronous transfer is only supported on Linux");
+}
+
+void
+InferenceServerHttpClient::AsyncEventTransfer()
+{
 }
 
-size_t
-InferenceServerHttpClient::InferResponseHeaderHandler(
-    void* contents, size_t size, size_t nmemb, void* userp)
+void
+InferenceServerHttpClient::AddPendingAsyncRequests()
 {
-  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+}
 
-  char* buf = reinterpret_cast<char*>(contents);
-  size_t byte_size = size * nmemb;
+int
+InferenceServerHttpClient::MultiSocketHandler(
+    void* easy_handle, int socket, int what, void* userp, void* socketp)
+{
+  return 0;
+}
 
-  size_t idx = strlen(kInferHeaderContentLengthHTTPHeader);
-  size_t length_idx = strlen(kContentLengthHTTPHeader);
-  if ((idx < byte_size) &&
-      !strncasecmp(buf, kInferHeaderContentLengthHTTPHeader, idx)) {
-    while ((idx < byte_size) && (buf[idx] != ':')) {
-      ++idx;
-    }
+int
+InferenceServerHttpClient::MultiTimerHandler(
+    void* multi_handle, long timeout_ms, void* userp)
+{
+  return 0;
+}
+#endif  // __linux__
 
-    if (idx < byte_size) {
-      std::string hdr(buf + idx + 1, byte_size - idx - 1);
-      request->response_json_size_ = std::stoi(hdr);
-    }
-  } else if (
-      (length_idx < byte_size) &&
-      !strncasecmp(buf, kContentLengthHTTPHeader, length_idx)) {
-    while ((length_idx < byte_size) && (buf[length_idx] != ':')) {
-      ++length_idx;
+void*
+InferenceServerHttpClient::AcquireEasyHandle()
+{
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (!easy_handle_pool_.empty()) {
+      void* easy_handle = easy_handle_pool_.back();
+      easy_handle_pool_.pop_back();
+      return easy_handle;
     }
+  }
+  return reinterpret_cast<void*>(curl_easy_init());
+}
 
-    if (length_idx < byte_size) {
-      std::string hdr(buf + length_idx + 1, byte_size - length_idx - 1);
-      request->infer_response_buffer_->reserve(std::stoi(hdr));
+void
+InferenceServerHttpClient::ReleaseEasyHandle(void* easy_handle)
+{
+  CURL* curl = reinterpret_cast<CURL*>(easy_handle);
+  // Resetting the options keeps the connection and DNS caches of the handle.
+  curl_easy_reset(curl);
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (easy_handle_pool_.size() < client_options_.easy_handle_pool_size) {
+      easy_handle_pool_.push_back(easy_handle);
+      return;
     }
   }
-
-  return byte_size;
+  curl_easy_cleanup(curl);
 }
 
-size_t
-InferenceServerHttpClient::InferResponseHandler(
-    void* contents, size_t size, size_t nmemb, void* userp)
+std::shared_ptr<HttpInferRequest>
+InferenceServerHttpClient::NewInferRequest(OnCompleteFn callback)
 {
-  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
-
-  if (request->Timer().Timestamp(RequestTimers::Kind::RECV_START) == 0) {
-    request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  if (request_pool_ != nullptr) {
+    return request_pool_->Acquire(std::move(callback));
   }
+  return std::shared_ptr<HttpInferRequest>(
+      new HttpInferRequest(std::move(callback), verbose_));
+}
 
-  char* buf = reinterpret_cast<char*>(contents);
-  size_t result_bytes = size * nmemb;
-  request->infer_response_buffer_->append(buf, result_bytes);
-
-  // InferResponseHandler may be called multiple times so we overwrite
-  // RECV_END so that we always have the time of the last.
-  request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
-
-  return result_bytes;
+void
+InferenceServerHttpClient::UpdateConnectionStat(bool reused_connection)
+{
+  std::lock_guard<std::mutex> lock(connection_stat_mutex_);
+  connection_stat_.completed_request_count++;
+  if (reused_connection) {
+    connection_stat_.reused_connection_count++;
+  } else {
+    connection_stat_.new_connection_count++;
+  }
 }
 
 Error
-InferenceServerHttpClient::PreRunProcessing(
-    void* vcurl, std::string& request_uri, const InferOptions& options,
-    const std::vector<InferInput*>& inputs,
-    const std::vector<const InferRequestedOutput*>& outputs,
-    const Headers& headers, const Parameters& query_params,
+InferenceServerHttpClient::ClientConnectionStat(
+    HttpConnectionStat* connection_stat) const
+{
+  std::lock_guard<std::mutex> lock(connection_stat_mutex_);
+  *connection_stat = connection_stat_;
+  return Error::Success;
+}
+
+bool
+InferenceServerHttpClient::UseZeroCopySend(
+    const std::string& request_uri,
     const CompressionType request_compression_algorithm,
-    const CompressionType response_compression_algorithm,
-    std::shared_ptr<HttpInferRequest>& http_request)
+    const CompressionType response_compression_algorithm) const
 {
-  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+#ifdef _WIN32
+  return false;
+#else
+  if (!client_options_.zero_copy_send || client_options_.http2 ||
+      (client_options_.max_send_bytes_per_second != 0) ||
+      (client_options_.max_recv_bytes_per_second != 0) ||
+      (request_compression_algorithm != CompressionType::NONE) ||
+      (response_compression_algorithm != CompressionType::NONE)) {
+    return false;
+  }
+  // Only plaintext HTTP, the url defaults to 'http://' without a scheme.
+  const size_t scheme_end = request_uri.find("://");
+  return (scheme_end == std::string::npos) ||
+         ((scheme_end == 4) && !strncasecmp(request_uri.c_str(), "http", 4));
+#endif  // _WIN32
+}
 
-  // Prepare the request object to provide the data for inference.
-  Error err = http_request->InitializeRequest(options, inputs, outputs);
-  if (!err.IsOk()) {
-    return err;
+void
+InferenceServerHttpClient::ZeroCopyDisconnect()
+{
+  if (zero_copy_handle_ != nullptr) {
+    curl_easy_cleanup(reinterpret_cast<CURL*>(zero_copy_handle_));
+    zero_copy_handle_ = nullptr;
   }
+}
 
-  // Add the buffers holding input tensor data
-  for (const auto this_input : inputs) {
-    if (!this_input->IsSharedMemory()) {
-      this_input->PrepareForRequest();
-      bool end_of_input = false;
-      while (!end_of_input) {
-        const uint8_t* buf;
-        size_t buf_size;
-        this_input->GetNext(&buf, &buf_size, &end_of_input);
-        if (buf != nullptr) {
-          http_request->AddInput(const_cast<uint8_t*>(buf), buf_size);
-        }
+#ifdef _WIN32
+Error
+InferenceServerHttpClient::ZeroCopyConnect(
+    const std::string& request_uri, const uint64_t timeout_us, int* fd,
+    bool* reused)
+{
+  return Error("zero-copy transfer is not supported on Windows");
+}
+
+Error
+InferenceServerHttpClient::ZeroCopyTransfer(
+    const std::string& request_uri, const InferOptions& options,
+    const Headers& headers, std::shared_ptr<HttpInferRequest>& http_request)
+{
+  return Error("zero-copy transfer is not supported on Windows");
+}
+#else
+Error
+InferenceServerHttpClient::ZeroCopyConnect(
+    const std::string& request_uri, const uint64_t timeout_us, int* fd,
+    bool* reused)
+{
+  CURL* curl = reinterpret_cast<CURL*>(zero_copy_handle_);
+  if (curl != nullptr) {
+    curl_socket_t sockfd = CURL_SOCKET_BAD;
+    if ((curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &sockfd) ==
+         CURLE_OK) &&
+        (sockfd != CURL_SOCKET_BAD)) {
+      // An idle connection that is readable has been closed by the server
+      // (or is in unexpected state), a new connection is needed in both
+      // cases.
+      struct pollfd pfd;
+      pfd.fd = sockfd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (poll(&pfd, 1, 0) == 0) {
+        *fd = sockfd;
+        *reused = true;
+        return Error::Success;
       }
     }
+    ZeroCopyDisconnect();
   }
 
-  // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-    case CompressionType::GZIP:
-      http_request->CompressInput(request_compression_algorithm);
-      break;
-  }
-
-  // Prepare curl
-  if (!query_params.empty()) {
-    request_uri = request_uri + "?" + GetQueryString(query_params);
+  curl = curl_easy_init();
+  if (!curl) {
+    return Error("failed to initialize HTTP client");
   }
-
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
-  curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
-  curl_easy_setopt(curl, CURLOPT_POST, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
-
-  if (options.client_timeout_ != 0) {
-    uint64_t timeout_ms = (options.client_timeout_ / 1000);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+  SetUnixSocketCurlOptions(curl, unix_socket_path_);
+  // The request is written in origin-form so it must go to the server
+  // directly.
+  curl_easy_setopt(curl, CURLOPT_NOPROXY, "*");
+  if (timeout_us != 0) {
+    curl_easy_setopt(
+        curl, CURLOPT_CONNECTTIMEOUT_MS, (long)(timeout_us / 1000));
   }
-
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
   }
 
-  const long buffer_byte_size = 16 * 1024 * 1024;
-  curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, buffer_byte_size);
-  curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, buffer_byte_size);
-
-  // request data provided by InferRequestProvider()
-  curl_easy_setopt(curl, CURLOPT_READFUNCTION, InferRequestProvider);
-  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
-
-  // response headers handled by InferResponseHeaderHandler()
-  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, InferResponseHeaderHandler);
-  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
-
-  // response data handled by InferResponseHandler()
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, InferResponseHandler);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
-
-  const curl_off_t post_byte_size = http_request->total_input_byte_size_;
-  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
-
-  err = SetSSLCurlOptions(&curl, ssl_options_);
-  if (!err.IsOk()) {
-    return err;
+  CURLcode res = curl_easy_perform(curl);
+  curl_socket_t sockfd = CURL_SOCKET_BAD;
+  if (res == CURLE_OK) {
+    res = curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &sockfd);
+  }
+  if ((res != CURLE_OK) || (sockfd == CURL_SOCKET_BAD)) {
+    curl_easy_cleanup(curl);
+    return Error(
+        "HTTP client failed to connect: " +
+        std::string(curl_easy_strerror(res)));
   }
 
-  struct curl_slist* list = nullptr;
+  zero_copy_handle_ = curl;
+  *fd = sockfd;
+  *reused = false;
+  return Error::Success;
+}
 
-  std::string infer_hdr{std::string(kInferHeaderContentLengthHTTPHeader) +
-                        ": " +
-                        std::to_string(http_request->request_json_.Size())};
-  list = curl_slist_append(list, infer_hdr.c_str());
-  list = curl_slist_append(list, "Expect:");
-  list = curl_slist_append(list, "Content-Type: application/octet-stream");
+Error
+InferenceServerHttpClient::ZeroCopyTransfer(
+    const std::string& request_uri, const InferOptions& options,
+    const Headers& headers, std::shared_ptr<HttpInferRequest>& http_request)
+{
+  // Split the uri into the authority for the 'Host' header and the path of
+  // the request line.
+  size_t authority_start = request_uri.find("://");
+  authority_start =
+      (authority_start == std::string::npos) ? 0 : authority_start + 3;
+  const size_t path_start = request_uri.find('/', authority_start);
+  const std::string host =
+      request_uri.substr(authority_start, path_start - authority_start);
+  const std::string path = (path_start == std::string::npos)
+                               ? std::string("/")
+                               : request_uri.substr(path_start);
+
+  std::string request_header =
+      "POST " + path + " HTTP/1.1\r\nHost: " + host +
+      "\r\nUser-Agent: libcurl-agent/1.0\r\n"
+      "Content-Type: application/octet-stream\r\n" +
+      kInferHeaderContentLengthHTTPHeader + ": " +
+      std::to_string(http_request->RequestJsonSize()) + "\r\n" +
+      kContentLengthHTTPHeader + ": " +
+      std::to_string(http_request->total_input_byte_size_) + "\r\n";
   for (const auto& pr : headers) {
-    std::string hdr = pr.first + ": " + pr.second;
-    list = curl_slist_append(list, hdr.c_str());
-  }
-
-  // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      list = curl_slist_append(list, "Content-Encoding: deflate");
-      break;
-    case CompressionType::GZIP:
-      list = curl_slist_append(list, "Content-Encoding: gzip");
-      break;
-  }
-  switch (response_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
-      break;
-    case CompressionType::GZIP:
-      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
-      break;
+    request_header += pr.first + ": " + pr.second + "\r\n";
   }
-  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
-
-  // The list will be freed when the request is destructed
-  http_request->header_list_ = list;
+  request_header += "\r\n";
 
   if (verbose_) {
-    std::cout << "inference request: " << http_request->request_json_.Contents()
+    std::cout << "inference request: "
+              << std::string(
+                     http_request->RequestJsonBase(),
+                     http_request->RequestJsonSize())
               << std::endl;
   }
 
-  return Error::Success;
-}
-
-void
-InferenceServerHttpClient::AsyncTransfer()
-{
-  int place_holder = 0;
-  CURLMsg* msg = nullptr;
-  do {
-    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
-
-    // sleep if no work is available
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] {
-      if (this->exiting_) {
-        return true;
-      }
-      // wake up if an async request has been generated
-      return !this->ongoing_async_requests_.empty();
-    });
-
-    CURLMcode mc = curl_multi_perform(multi_handle_, &place_holder);
-    int numfds;
-    if (mc == CURLM_OK) {
-      // Wait for activity. If there are no descripters in the multi_handle_
-      // then curl_multi_wait will return immediately
-      mc = curl_multi_wait(multi_handle_, NULL, 0, INT_MAX, &numfds);
-      if (mc == CURLM_OK) {
-        while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
-          uintptr_t identifier = reinterpret_cast<uintptr_t>(msg->easy_handle);
-          auto itr = ongoing_async_requests_.find(identifier);
-          // This shouldn't happen
-          if (itr == ongoing_async_requests_.end()) {
-            std::cerr
-                << "Unexpected error: received completed request that is not "
-                   "in the list of asynchronous requests"
-                << std::endl;
-            curl_multi_remove_handle(multi_handle_, msg->easy_handle);
-            curl_easy_cleanup(msg->easy_handle);
-            continue;
-          }
-
-          long http_code = 400;
-          if (msg->data.result == CURLE_OK) {
-            curl_easy_getinfo(
-                msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
-          } else if (msg->data.result == CURLE_OPERATION_TIMEDOUT) {
-            http_code = 499;
-          }
+  const uint64_t deadline_ns =
+      (options.client_timeout_ == 0)
+          ? 0
+          : SteadyNowNs() + options.client_timeout_ * 1000;
 
-          request_list.emplace_back(itr->second);
-          ongoing_async_requests_.erase(itr);
-          curl_multi_remove_handle(multi_handle_, msg->easy_handle);
-          curl_easy_cleanup(msg->easy_handle);
+  // A reused connection may have been closed by the server after it was
+  // checked, so the request is retried once on a new connection if it fails
+  // before any part of the response is received.
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    int fd;
+    bool reused;
+    Error err =
+        ZeroCopyConnect(request_uri, options.client_timeout_, &fd, &reused);
+    if (!err.IsOk()) {
+      return err;
+    }
 
-          std::shared_ptr<HttpInferRequest> async_request = request_list.back();
-          async_request->http_code_ = http_code;
+    // The buffers are referenced, not copied. The first holds the HTTP
+    // request header followed by the buffers of the inference header and
+    // the input tensors.
+    std::vector<struct iovec> iovs;
+    iovs.reserve(http_request->data_buffers_.size() + 1);
+    iovs.push_back(
+        {const_cast<char*>(request_header.data()), request_header.size()});
+    for (const auto& buffer : http_request->data_buffers_) {
+      iovs.push_back({buffer.first, buffer.second});
+    }
 
-          if (msg->msg != CURLMSG_DONE) {
-            // Something wrong happened.
-            std::cerr << "Unexpected error: received CURLMsg=" << msg->msg
-                      << std::endl;
-          } else {
-            async_request->Timer().CaptureTimestamp(
-                RequestTimers::Kind::REQUEST_END);
-            Error err = UpdateInferStat(async_request->Timer());
-            if (!err.IsOk()) {
-              std::cerr << "Failed to update context stat: " << err
-                        << std::endl;
-            }
-          }
+    bool timed_out = false;
+    http_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+    http_request->Timer().CaptureTimestamp(
+        RequestTimers::Kind::TRANSPORT_START);
+    err = SendAll(fd, &iovs, deadline_ns, &timed_out);
+    if (err.IsOk() && !timed_out) {
+      http_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+
+      ZeroCopyResponseReader reader(fd, deadline_ns, &http_request->Timer());
+      bool keep_alive = true;
+      err = reader.Read(
+          &http_request->http_code_, &http_request->response_json_size_,
+          http_request->infer_response_buffer_.get(), &keep_alive);
+      timed_out = reader.TimedOut();
+      if (err.IsOk() && !timed_out) {
+        UpdateConnectionStat(reused);
+        if (!keep_alive) {
+          ZeroCopyDisconnect();
         }
-      } else {
-        std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
-                  << std::endl;
+        return Error::Success;
       }
-    } else {
-      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
-                << std::endl;
+      if (!err.IsOk() && reused && !reader.ReceivedAny()) {
+        ZeroCopyDisconnect();
+        continue;
+      }
+    } else if (!err.IsOk() && reused) {
+      ZeroCopyDisconnect();
+      continue;
     }
-    lock.unlock();
 
-    for (auto& this_request : request_list) {
-      InferResult* result;
-      InferResultHttp::Create(&result, this_request);
-      this_request->callback_(result);
+    // The connection is left with partial request or response.
+    ZeroCopyDisconnect();
+    if (timed_out) {
+      http_request->http_code_ = 499;
+      return Error::Success;
     }
-  } while (!exiting_);
+    return err;
+  }
+
+  return Error("HTTP client failed to send inference request");
 }
+#endif  // _WIN32
 
 size_t
 InferenceServerHttpClient::ResponseHandler(
@@ -2011,7 +5535,10 @@ InferenceServerHttpClient::Get(
     return CurlGlobal::Get().Status();
   }
 
-  CURL* curl = curl_easy_init();
+  // The handle comes from the pool shared with the asynchronous requests,
+  // so that its connection is kept alive for the next call instead of
+  // connecting to the server again.
+  CURL* curl = reinterpret_cast<CURL*>(AcquireEasyHandle());
   if (!curl) {
     return Error("failed to initialize HTTP client");
   }
@@ -2031,8 +5558,12 @@ InferenceServerHttpClient::Get(
 
   Error err = SetSSLCurlOptions(&curl, ssl_options_);
   if (!err.IsOk()) {
+    ReleaseEasyHandle(curl);
     return err;
   }
+  SetHttpVersionCurlOptions(curl, request_uri, client_options_);
+  SetShareCurlOptions(curl, share_handle_);
+  SetUnixSocketCurlOptions(curl, unix_socket_path_);
 
   // Add user provided headers...
   struct curl_slist* header_list = nullptr;
@@ -2048,7 +5579,7 @@ InferenceServerHttpClient::Get(
   CURLcode res = curl_easy_perform(curl);
   if (res != CURLE_OK) {
     curl_slist_free_all(header_list);
-    curl_easy_cleanup(curl);
+    ReleaseEasyHandle(curl);
     return Error("HTTP client failed: " + std::string(curl_easy_strerror(res)));
   }
 
@@ -2056,7 +5587,7 @@ InferenceServerHttpClient::Get(
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &lhttp_code);
 
   curl_slist_free_all(header_list);
-  curl_easy_cleanup(curl);
+  ReleaseEasyHandle(curl);
 
   if (verbose_) {
     std::cout << *response << std::endl;
@@ -2087,7 +5618,10 @@ InferenceServerHttpClient::Post(
     return CurlGlobal::Get().Status();
   }
 
-  CURL* curl = curl_easy_init();
+  // The handle comes from the pool shared with the asynchronous requests,
+  // so that its connection is kept alive for the next call instead of
+  // connecting to the server again.
+  CURL* curl = reinterpret_cast<CURL*>(AcquireEasyHandle());
   if (!curl) {
     return Error("failed to initialize HTTP client");
   }
@@ -2109,8 +5643,12 @@ InferenceServerHttpClient::Post(
 
   Error err = SetSSLCurlOptions(&curl, ssl_options_);
   if (!err.IsOk()) {
+    ReleaseEasyHandle(curl);
     return err;
   }
+  SetHttpVersionCurlOptions(curl, request_uri, client_options_);
+  SetShareCurlOptions(curl, share_handle_);
+  SetUnixSocketCurlOptions(curl, unix_socket_path_);
 
   // Add user provided headers...
   struct curl_slist* header_list = nullptr;
@@ -2126,7 +5664,7 @@ InferenceServerHttpClient::Post(
   CURLcode res = curl_easy_perform(curl);
   if (res != CURLE_OK) {
     curl_slist_free_all(header_list);
-    curl_easy_cleanup(curl);
+    ReleaseEasyHandle(curl);
     return Error("HTTP client failed: " + std::string(curl_easy_strerror(res)));
   }
 
@@ -2134,7 +5672,7 @@ InferenceServerHttpClient::Post(
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
 
   curl_slist_free_all(header_list);
-  curl_easy_cleanup(curl);
+  ReleaseEasyHandle(curl);
 
   if (verbose_) {
     std::cout << *response << std::endl;
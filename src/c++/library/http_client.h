@@ -27,14 +27,20 @@
 
 /// \file
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "common.h"
 #include "ipc.h"
 
 namespace triton { namespace client {
 
 class HttpInferRequest;
+class IoUringPoller;
+class HttpInferRequestPool;
 
 /// The key-value map type to be included in the request
 /// as custom headers.
@@ -86,13 +92,174 @@ struct HttpSslOptions {
   std::string key;
 };
 
+// The options for configuring how the client transfers inference requests.
+struct HttpClientOptions {
+  explicit HttpClientOptions()
+      : zero_copy_send(false), event_driven_async(false),
+        max_host_connections(0), easy_handle_pool_size(64), http2(false),
+        http2_max_concurrent_streams(100), stream_response_outputs(false),
+        request_pool_size(0), compression_thread_count(1),
+        compression_chunk_byte_size(1 << 20), response_cache_byte_size(0),
+        response_cache_ttl_us(0), infer_multi_max_in_flight(64),
+        max_outstanding_requests(0),
+        outstanding_overload(OutstandingOverload::BLOCK),
+        callback_thread_count(0), max_send_bytes_per_second(0),
+        max_recv_bytes_per_second(0)
+  {
+  }
+
+  // The function invoked with the binary data of an output tensor as it is
+  // received, see 'output_data_callback'. 'offset' is the position of 'data'
+  // within the output and 'complete' is true for the last part.
+  using OnOutputDataFn = std::function<void(
+      const std::string& request_id, const std::string& output_name,
+      const uint8_t* data, size_t byte_size, size_t offset, bool complete)>;
+  // If true, synchronous inference requests are written to the socket with
+  // a single scatter/gather write that references the request header and
+  // the InferInput buffers directly, instead of copying the input data into
+  // the libcurl upload buffer. The option only applies to requests without
+  // request or response compression sent to an 'http://' endpoint, other
+  // requests use the regular libcurl transfer. It is not supported on
+  // Windows. The default value is false.
+  bool zero_copy_send;
+  // If true, asynchronous inference requests are driven by an epoll event
+  // loop with 'curl_multi_socket_action' instead of repeatedly calling
+  // 'curl_multi_perform' and 'curl_multi_wait'. New requests are handed to
+  // the event loop through a short queue, so AsyncInfer() does not contend
+  // with the transfers in progress. It is only supported on Linux. In
+  // builds with TRITON_ENABLE_IO_URING, the loop waits with io_uring
+  // instead of epoll when the kernel supports it, Linux 5.11 and later, so
+  // that the changes of the watched sockets are submitted with the wait in
+  // one system call. The default value is false.
+  bool event_driven_async;
+  // The maximum number of connections to the server that asynchronous
+  // requests may use at the same time. Requests beyond the limit wait for a
+  // connection to become available. 0 means there is no limit. The default
+  // value is 0.
+  long max_host_connections;
+  // The maximum number of idle curl easy handles kept for reuse by
+  // asynchronous requests and by the control-plane calls, such as the
+  // metadata and statistics requests, which then reuse the connections of
+  // the handles. The synchronous requests made while the handle of the
+  // client is used by another thread also take their handles from it. The
+  // default value is 64.
+  size_t easy_handle_pool_size;
+  // If true, requests are sent with HTTP/2 so that concurrent asynchronous
+  // requests are multiplexed over a single connection. HTTP/2 is negotiated
+  // during the TLS handshake for 'https://' endpoints, and used with prior
+  // knowledge (h2c) otherwise, so the server or the proxy in front of it
+  // must accept plaintext HTTP/2 connections. It requires libcurl built with
+  // HTTP/2 support and disables 'zero_copy_send'. The default value is
+  // false.
+  bool http2;
+  // The maximum number of concurrent streams on one HTTP/2 connection,
+  // requests beyond it open another connection. Only used when 'http2' is
+  // set. The default value is 100.
+  long http2_max_concurrent_streams;
+  // If true, the response of an inference request sent with libcurl is
+  // parsed as it is received. Once the JSON header, whose size is given by
+  // the 'Inference-Header-Content-Length' response header, has arrived the
+  // binary data of each output is written to its own buffer instead of
+  // accumulating the whole body. Responses without binary outputs are not
+  // affected. It is always enabled for requests with outputs set by
+  // InferRequestedOutput::SetUserBuffer(), which then receive the data
+  // directly. The default value is false.
+  bool stream_response_outputs;
+  // If set together with 'stream_response_outputs', the binary data of the
+  // outputs is passed to this function as it is received, from the thread
+  // doing the transfer, and is not kept by the client. RawData() is then
+  // not available for these outputs. The default value is empty.
+  OnOutputDataFn output_data_callback;
+  // The maximum number of idle inference request objects kept for reuse.
+  // A request object, together with its request and response buffers, is
+  // returned to the pool once its InferResult is deleted, so later requests
+  // reuse the allocations instead of making new ones. Each pooled object
+  // keeps the capacity of the largest response it has received. 0 disables
+  // the pooling. The default value is 0.
+  size_t request_pool_size;
+  // The number of threads used to compress a request body with DEFLATE or
+  // GZIP. With more than one thread, bodies larger than
+  // 'compression_chunk_byte_size' are split into chunks that are compressed
+  // independently and concatenated into a single valid stream, at the cost
+  // of a slightly lower compression ratio. The default value is 1.
+  size_t compression_thread_count;
+  // The size in bytes of the chunks compressed in parallel, see
+  // 'compression_thread_count'. The default value is 1 MB.
+  size_t compression_chunk_byte_size;
+  // The total byte size of the responses kept by the client-side response
+  // cache. When non-zero, Infer() calls with the same model, inputs and
+  // requested outputs as a recent successful call get its cached result
+  // without contacting the server, including its request id. Calls in a
+  // sequence or using shared memory or user buffers are not cached. Hits
+  // and misses are counted in InferStat. The default value 0 disables the
+  // cache.
+  size_t response_cache_byte_size;
+  // How long a cached response is used, in microseconds. The default value
+  // 0 keeps responses until they are evicted.
+  uint64_t response_cache_ttl_us;
+  // The maximum number of requests of an InferMulti() call that are sent to
+  // the server without having received their responses. They go through
+  // the asynchronous transfer, over as many connections as
+  // 'max_host_connections' allows or multiplexed with 'http2', so they are
+  // not looked up in the response cache. The default value is 64.
+  size_t infer_multi_max_in_flight;
+  // The maximum number of AsyncInfer() requests of the client in flight,
+  // see OutstandingRequestCount(). A request beyond it waits for another to
+  // complete or fails as set by 'outstanding_overload'. 0 means there is no
+  // limit. The default value is 0.
+  size_t max_outstanding_requests;
+  // What AsyncInfer() does when 'max_outstanding_requests' requests are in
+  // flight. With OutstandingOverload::REJECT it fails with an error for
+  // which IsBusy() is true, and the function set by SetCapacityCallback()
+  // is invoked once a request completes. The default value is
+  // OutstandingOverload::BLOCK, which must not be used when AsyncInfer() is
+  // called from the callback of another request.
+  OutstandingOverload outstanding_overload;
+  // The number of threads running the callbacks of AsyncInfer() requests.
+  // When non-zero, the callbacks are run by a CompletionThreadPool instead
+  // of the thread transferring the requests, and the callbacks of the
+  // requests of a sequence run on the same thread in completion order. It
+  // takes precedence over SetCompletionExecutor(). The default value 0 runs
+  // the callbacks on the transfer thread.
+  size_t callback_thread_count;
+  // The maximum rate at which each inference request uploads its body, in
+  // bytes per second, to emulate clients on slow networks. The transfer
+  // holds back the body rather than blocking the thread, so the server sees
+  // a slowly arriving request on an open connection. It disables
+  // 'zero_copy_send'. 0 means there is no limit. The default value is 0.
+  uint64_t max_send_bytes_per_second;
+  // The maximum rate at which each inference request reads its response, in
+  // bytes per second. Once the socket buffers fill up the server has to
+  // hold the rest of the response. It disables 'zero_copy_send'. 0 means
+  // there is no limit. The default value is 0.
+  uint64_t max_recv_bytes_per_second;
+};
+
+// Statistics of the connections used by the inference requests of a client.
+struct HttpConnectionStat {
+  // Total number of requests completed.
+  size_t completed_request_count;
+  // Number of completed requests that opened a new connection.
+  size_t new_connection_count;
+  // Number of completed requests that reused a kept-alive connection.
+  size_t reused_connection_count;
+
+  HttpConnectionStat()
+      : completed_request_count(0), new_connection_count(0),
+        reused_connection_count(0)
+  {
+  }
+};
+
 //==============================================================================
 /// An InferenceServerHttpClient object is used to perform any kind of
-/// communication with the InferenceServer using HTTP protocol. None
-/// of the methods of InferenceServerHttpClient are thread safe. The
-/// class is intended to be used by a single thread and simultaneously
-/// calling different methods with different threads is not supported
-/// and will cause undefined behavior.
+/// communication with the InferenceServer using HTTP protocol. The
+/// inference and control-plane methods may be called concurrently from
+/// several threads, which then share the connections and the transfer
+/// thread of the client. A synchronous call that finds the handle of the
+/// client in use by another thread is transferred with a handle of the
+/// pool, see HttpClientOptions::easy_handle_pool_size. The methods that
+/// change the client, such as the statistics resets, are not thread safe.
 ///
 /// \code
 ///   std::unique_ptr<InferenceServerHttpClient> client;
@@ -141,7 +308,8 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// \param client Returns a new InferenceServerHttpClient object.
   /// \param server_url The inference server name, port, optional
   /// scheme and optional base path in the following format:
-  /// <scheme://>host:port/<base-path>.
+  /// <scheme://>host:port/<base-path>. Or 'unix://<socket-path>' to
+  /// connect to a server listening on a Unix domain socket.
   /// \param verbose If true generate verbose output when contacting
   /// the inference server.
   /// \param ssl_options Specifies the settings for configuring
@@ -150,11 +318,14 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// The use of SSL/TLS depends entirely on the server endpoint.
   /// These options will be ignored if the server_url does not
   /// expose `https://` scheme.
+  /// \param client_options Specifies the settings for transferring
+  /// inference requests. See HttpClientOptions for details.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerHttpClient>* client,
       const std::string& server_url, bool verbose = false,
-      const HttpSslOptions& ssl_options = HttpSslOptions());
+      const HttpSslOptions& ssl_options = HttpSslOptions(),
+      const HttpClientOptions& client_options = HttpClientOptions());
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -165,6 +336,21 @@ class InferenceServerHttpClient : public InferenceServerClient {
       bool* live, const Headers& headers = Headers(),
       const Parameters& query_params = Parameters());
 
+  /// Open connections to the server ahead of the first requests, so that
+  /// they don't pay for the name resolution and the TCP and TLS setup, and
+  /// check that the server answers. The connections are opened at once and
+  /// kept by the handle of the synchronous requests and by handles of the
+  /// pool, see HttpClientOptions::easy_handle_pool_size. The asynchronous
+  /// requests open their own connections, reusing the resolved address and
+  /// the TLS sessions.
+  /// \param connection_count The number of connections to open in addition
+  /// to the one of the synchronous requests.
+  /// \param timeout_us The time to wait for the connections, in microseconds.
+  /// \return Error object indicating success or failure.
+  Error Warmup(
+      const size_t connection_count = 1,
+      const uint64_t timeout_us = 10000000);
+
   /// Contact the inference server and get its readiness.
   /// \param ready Returns whether the server is ready or not.
   /// \param headers Optional map specifying additional HTTP headers to include
@@ -441,6 +627,37 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const std::string& name = "", const Headers& headers = Headers(),
       const Parameters& query_params = Parameters());
 
+  /// Prepare a request to be run several times, only changing its id and
+  /// the data of its inputs, see InferOptions::prepared_request_. The JSON
+  /// header of the request is built once instead of on every call.
+  /// \param prepared Returns the prepared request.
+  /// \param options The options of the request, its 'request_id_' is
+  /// ignored.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// The data of the inputs must be set, with the byte size it will have
+  /// in every call.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \return Error object indicating success or failure.
+  Error PrepareInfer(
+      std::shared_ptr<PreparedInferRequest>* prepared,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Compress the data of inputs to be sent several times, see
+  /// InferOptions::compressed_inputs_. The requests sending it only
+  /// compress their JSON header instead of all of their body.
+  /// \param compressed Returns the compressed input data.
+  /// \param inputs The vector of InferInput describing the model inputs,
+  /// with their data set. The data in shared memory is not sent in the
+  /// request body, so it is not compressed.
+  /// \param type The compression algorithm, DEFLATE or GZIP.
+  /// \return Error object indicating success or failure.
+  Error CompressInputs(
+      std::shared_ptr<CompressedInferInputs>* compressed,
+      const std::vector<InferInput*>& inputs, const CompressionType type);
+
   /// Run synchronous inference on server.
   /// \param result Returns the result of inference.
   /// \param options The options for inference request.
@@ -518,8 +735,106 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType response_compression_algorithm =
           CompressionType::NONE);
 
-  /// Run multiple synchronous inferences on server.
-  /// \param results Returns the results of the inferences.
+  /// Run asynchronous inference on server, as the AsyncInfer() above, and
+  /// return a handle to cancel the request while it is in flight.
+  /// \param handle Returns the handle of the request.
+  /// \param callback The callback function to be invoked on request
+  /// completion.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in request.
+  /// \param query_params Optional map specifying parameters that must be
+  /// included with URL query.
+  /// \param request_compression_algorithm Optional HTTP compression
+  /// algorithm to use for the request body on client side.
+  /// \param response_compression_algorithm Optional HTTP compression
+  /// algorithm to request for the response body.
+  /// \return Error object indicating success
+  /// or failure of the request.
+  Error AsyncInfer(
+      std::shared_ptr<AsyncRequestHandle>* handle, OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Run asynchronous inference on server, as the AsyncInfer() above, and
+  /// return a future for its result instead of invoking a callback. The
+  /// caller owns the InferResult obtained from the future and must delete
+  /// it.
+  /// \param result Returns the future of the result, only set when the
+  /// request is sent.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the output must be returned.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in request.
+  /// \param query_params Optional map specifying parameters that must be
+  /// included with URL query.
+  /// \param request_compression_algorithm Optional HTTP compression
+  /// algorithm to use for the request body on client side.
+  /// \param response_compression_algorithm Optional HTTP compression
+  /// algorithm to request for the response body.
+  /// \return Error object indicating success
+  /// or failure of the request.
+  Error AsyncInferFuture(
+      std::future<InferResult*>* result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+#ifdef TRITON_CLIENT_HAS_COROUTINES
+  /// Run asynchronous inference on server, as the AsyncInfer() above, from
+  /// a C++20 coroutine, see InferAwaitable. The inputs and outputs are
+  /// sent when the returned object is awaited.
+  /// \param result Returns the result of the request.
+  /// \return The object to await for the error of the request.
+  InferAwaitable AsyncInferAwait(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE)
+  {
+    return InferAwaitable(
+        [=](OnCompleteFn callback) {
+          return AsyncInfer(
+              std::move(callback), options, inputs, outputs, headers,
+              query_params, request_compression_algorithm,
+              response_compression_algorithm);
+        },
+        result);
+  }
+#endif  // TRITON_CLIENT_HAS_COROUTINES
+
+  /// Run multiple synchronous inferences on server. The requests are sent
+  /// concurrently, with at most HttpClientOptions::infer_multi_max_in_flight
+  /// of them waiting for their responses at a time, and the results are
+  /// returned in the order of the requests. The requests that share a
+  /// sequence ID are sent one after another, each once the previous one of
+  /// the sequence has completed, so that they reach the server in order.
+  /// \param results Returns the results of the inferences, in the order of
+  /// the requests.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
   /// \param inputs The vector of InferInput objects describing the model inputs
@@ -541,7 +856,7 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
   /// is used.
   /// \return Error object indicating success or failure of the
-  /// request.
+  /// requests, the first error if any of them failed.
   Error InferMulti(
       std::vector<InferResult*>* results,
       const std::vector<InferOptions>& options,
@@ -603,10 +918,67 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType response_compression_algorithm =
           CompressionType::NONE);
 
+  /// Starts a stream of inference requests whose responses are received as
+  /// server-sent events, so that the responses of a model sending several
+  /// of them per request, such as a decoupled model, are passed to the
+  /// callback as they arrive instead of once the response body is
+  /// complete. Each request of the stream is sent by AsyncStreamInfer() to
+  /// the generate_stream endpoint of the model. Only one stream may be
+  /// active at a time.
+  /// \param callback The callback function to be invoked with each response
+  /// of the requests of the stream. A request ends with an empty final
+  /// response, see InferResult::IsNullResponse(), or with an error.
+  /// \param enable_stats Indicates whether client library should record the
+  /// client-side statistics of the requests of the stream, measured from
+  /// the start of a request to its final response.
+  /// \param stream_timeout The timeout of each request of the stream in
+  /// microseconds, used when InferOptions::client_timeout_ is not set. The
+  /// default value is 0 which means that there is no limitation on deadline.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the requests of the stream.
+  /// \return Error object indicating success or failure.
+  Error StartStream(
+      OnCompleteFn callback, bool enable_stats = true,
+      uint32_t stream_timeout = 0, const Headers& headers = Headers());
+
+  /// Stops the active stream, if any, once the requests sent on it have
+  /// received their final response.
+  /// \return Error object indicating success or failure.
+  Error StopStream();
+
+  /// Runs an asynchronous inference on the stream started by StartStream().
+  /// The inputs are sent as the JSON values of the generate extension, so
+  /// they can't be in shared memory or of FP16 or BF16 datatype. The outputs
+  /// of a response are read from the JSON values of its event: strings are
+  /// BYTES, booleans BOOL, integers INT64 and other numbers FP64, each with
+  /// the shape [element count].
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Not used, the generate extension returns all the
+  /// outputs of the model.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Obtain the cumulative statistics of the connections used by the
+  /// inference requests of the client.
+  /// \param connection_stat Returns the HttpConnectionStat object holding
+  /// the current statistics.
+  /// \return Error object indicating success or failure.
+  Error ClientConnectionStat(HttpConnectionStat* connection_stat) const;
+
  private:
   InferenceServerHttpClient(
-      const std::string& url, bool verbose, const HttpSslOptions& ssl_options);
+      const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+      const HttpClientOptions& client_options);
 
+  Error PrepareRequestData(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const CompressionType request_compression_algorithm,
+      std::shared_ptr<HttpInferRequest>& request);
   Error PreRunProcessing(
       void* curl, std::string& request_uri, const InferOptions& options,
       const std::vector<InferInput*>& inputs,
@@ -615,7 +987,74 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType request_compression_algorithm,
       const CompressionType response_compression_algorithm,
       std::shared_ptr<HttpInferRequest>& request);
+  // Start 'worker_' with the first asynchronous request.
+  void StartAsyncWorker();
+  // Hand the transfer of 'request' with 'easy_handle' to 'worker_'.
+  Error SubmitAsyncRequest(
+      void* easy_handle, const std::shared_ptr<HttpInferRequest>& request);
+  // The key of the callback thread of a request, see
+  // HttpClientOptions::callback_thread_count.
+  uint64_t CallbackKey(const InferOptions& options);
   void AsyncTransfer();
+  // Move the completed transfers out of 'multi_handle_' and
+  // 'ongoing_async_requests_' into 'completed_requests'.
+  void CollectCompletedAsyncRequests(
+      std::vector<std::shared_ptr<HttpInferRequest>>* completed_requests);
+  // Parse the response of a completed asynchronous request, record its
+  // statistics and invoke its callback. Must be called without holding
+  // 'mutex_'.
+  void CompleteAsyncRequest(const std::shared_ptr<HttpInferRequest>& request);
+
+  // Support for the stream started by StartStream().
+  Error PrepareStreamTransfer(
+      void* curl, const std::string& request_uri, const InferOptions& options,
+      const std::vector<InferInput*>& inputs, const uint32_t stream_timeout,
+      const Headers& headers, std::shared_ptr<HttpInferRequest>& request);
+  // Pass the events received completely by 'request' to its callback, and
+  // the last one without its terminating empty line if 'end_of_stream'.
+  void DispatchStreamEvents(HttpInferRequest* request, bool end_of_stream);
+  void DeliverStreamResult(HttpInferRequest* request, InferResult* result);
+  void CompleteStreamRequest(const std::shared_ptr<HttpInferRequest>& request);
+  void EndStreamRequest();
+
+  // Support for HttpClientOptions::event_driven_async.
+  Error InitEventLoop();
+  void AsyncEventTransfer();
+  void AddPendingAsyncRequests();
+  static int MultiSocketHandler(
+      void* easy_handle, int socket, int what, void* userp, void* socketp);
+  static int MultiTimerHandler(
+      void* multi_handle, long timeout_ms, void* userp);
+
+  // Take an easy handle from 'easy_handle_pool_' or create a new one, and
+  // return it to the pool once the transfer is completed.
+  void* AcquireEasyHandle();
+  void ReleaseEasyHandle(void* easy_handle);
+  void UpdateConnectionStat(bool reused_connection);
+
+  // Get an inference request object, from 'request_pool_' if enabled.
+  std::shared_ptr<HttpInferRequest> NewInferRequest(OnCompleteFn callback);
+
+  // Whether the request to 'request_uri' should be sent with the zero-copy
+  // transfer, see HttpClientOptions::zero_copy_send.
+  bool UseZeroCopySend(
+      const std::string& request_uri,
+      const CompressionType request_compression_algorithm,
+      const CompressionType response_compression_algorithm) const;
+  // Return the socket of the connection used for zero-copy transfer,
+  // connecting to the server if there is no usable connection.
+  Error ZeroCopyConnect(
+      const std::string& request_uri, const uint64_t timeout_us, int* fd,
+      bool* reused);
+  void ZeroCopyDisconnect();
+  Error ZeroCopyTransfer(
+      const std::string& request_uri, const InferOptions& options,
+      const Headers& headers, std::shared_ptr<HttpInferRequest>& request);
+
+  // Check the repository index for the models changed since the entries
+  // of 'model_cache_' were cached, when it is due.
+  void RefreshModelCache(const Headers& headers);
+
   Error Get(
       std::string& request_uri, const Headers& headers,
       const Parameters& query_params, std::string* response,
@@ -633,20 +1072,86 @@ class InferenceServerHttpClient : public InferenceServerClient {
       void* contents, size_t size, size_t nmemb, void* userp);
   static size_t InferResponseHandler(
       void* contents, size_t size, size_t nmemb, void* userp);
+  static size_t StreamResponseHeaderHandler(
+      void* contents, size_t size, size_t nmemb, void* userp);
+  static size_t StreamResponseHandler(
+      void* contents, size_t size, size_t nmemb, void* userp);
 
   // The server url
   const std::string url_;
+  // The path of the Unix domain socket the requests are sent to, if the
+  // server url is 'unix://<path>'
+  const std::string unix_socket_path_;
   // The options for authorizing and authenticating SSL/TLS connections
   HttpSslOptions ssl_options_;
+  // The options for transferring inference requests
+  HttpClientOptions client_options_;
 
   using AsyncReqMap = std::map<uintptr_t, std::shared_ptr<HttpInferRequest>>;
   // curl easy handle shared for all synchronous requests
   void* easy_handle_;
+  // curl easy handle that owns the connection of the zero-copy transfer
+  void* zero_copy_handle_;
   // curl multi handle for processing asynchronous requests
   void* multi_handle_;
+  // curl share handle through which all the easy handles of the client
+  // resume TLS sessions and reuse DNS lookups, and the locks of the shared
+  // data indexed by 'curl_lock_data'
+  void* share_handle_;
+  std::vector<std::mutex> share_mutexes_;
   // map to record ongoing asynchronous requests with pointer to easy handle
   // or tag id as key
   AsyncReqMap ongoing_async_requests_;
+  // idle easy handles for asynchronous requests
+  std::mutex easy_handle_pool_mutex_;
+  std::vector<void*> easy_handle_pool_;
+
+  // Event loop state when HttpClientOptions::event_driven_async is set.
+  // 'pending_async_requests_' is protected by 'mutex_', everything else is
+  // only accessed by the event loop thread once it is started.
+  int epoll_fd_;
+  int wakeup_fd_;
+  uint64_t timer_deadline_ns_;
+  bool timer_pending_;
+  // The epoll events each socket of 'multi_handle_' is registered for
+  std::unordered_map<int, uint32_t> socket_events_;
+  // Used instead of 'epoll_fd_' when io_uring is available
+  std::unique_ptr<IoUringPoller> io_uring_poller_;
+  std::vector<std::pair<uintptr_t, std::shared_ptr<HttpInferRequest>>>
+      pending_async_requests_;
+
+  mutable std::mutex connection_stat_mutex_;
+  HttpConnectionStat connection_stat_;
+
+  // Held by the synchronous call using 'easy_handle_' and the one using
+  // 'zero_copy_handle_', the calls made meanwhile take other handles.
+  std::mutex easy_handle_mutex_;
+  std::mutex zero_copy_mutex_;
+  // Starts 'worker_' with the first asynchronous request.
+  std::once_flag worker_started_;
+
+  // Idle inference request objects, see HttpClientOptions::request_pool_size.
+  // It is shared with the request objects in use so that they can be
+  // returned to it even if they outlive the client.
+  std::shared_ptr<HttpInferRequestPool> request_pool_;
+  // The client-side response cache, if enabled.
+  std::unique_ptr<ResponseCache> response_cache_;
+  // Runs the callbacks, see HttpClientOptions::callback_thread_count.
+  // Destroyed, and so drained, once the transfer thread has stopped.
+  std::unique_ptr<CompletionThreadPool> callback_pool_;
+  // The key of the next request not in a sequence.
+  std::atomic<uint64_t> next_callback_key_{0};
+
+  // The stream started by StartStream(), 'stream_callback_' is empty when
+  // there is none. 'stream_in_flight_' counts its requests waiting for
+  // their final response.
+  std::mutex stream_mutex_;
+  std::condition_variable stream_cv_;
+  OnCompleteFn stream_callback_;
+  bool stream_enable_stats_{false};
+  uint32_t stream_timeout_{0};
+  Headers stream_headers_;
+  size_t stream_in_flight_{0};
 };
 
 }}  // namespace triton::client
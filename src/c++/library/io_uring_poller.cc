@@ -0,0 +1,325 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "io_uring_poller.h"
+
+#if defined(__linux__) && defined(TRITON_ENABLE_IO_URING)
+#include <endian.h>
+#include <linux/io_uring.h>
+#include <linux/swab.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#endif  // __linux__ && TRITON_ENABLE_IO_URING
+
+namespace triton { namespace client {
+
+#if defined(__linux__) && defined(TRITON_ENABLE_IO_URING)
+namespace {
+
+// The user data of the completions of the removals, which are not reported
+constexpr uint64_t kRemoveUserData = UINT64_MAX;
+
+uint64_t
+PollUserData(const int fd, const uint32_t generation)
+{
+  return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+}  // namespace
+
+IoUringPoller::~IoUringPoller()
+{
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (ring_ != nullptr) {
+    munmap(ring_, ring_size_);
+  }
+  if (ring_fd_ != -1) {
+    close(ring_fd_);
+  }
+}
+
+Error
+IoUringPoller::Create(std::unique_ptr<IoUringPoller>* poller, unsigned entries)
+{
+  std::unique_ptr<IoUringPoller> new_poller(new IoUringPoller());
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  new_poller->ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+  if (new_poller->ring_fd_ == -1) {
+    return Error(
+        "failed to create io_uring instance: " + std::string(strerror(errno)));
+  }
+  // The wait timeout is passed with IORING_ENTER_EXT_ARG, from Linux 5.11,
+  // which also maps both rings at once.
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+    return Error("io_uring instance does not support wait timeouts");
+  }
+
+  new_poller->ring_size_ = std::max(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+  void* ring = mmap(
+      nullptr, new_poller->ring_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, new_poller->ring_fd_, IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED) {
+    return Error(
+        "failed to map io_uring rings: " + std::string(strerror(errno)));
+  }
+  new_poller->ring_ = ring;
+  new_poller->sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(
+      nullptr, new_poller->sqes_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, new_poller->ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return Error(
+        "failed to map io_uring submission entries: " +
+        std::string(strerror(errno)));
+  }
+  new_poller->sqes_ = reinterpret_cast<struct io_uring_sqe*>(sqes);
+
+  char* base = reinterpret_cast<char*>(ring);
+  new_poller->sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+  new_poller->sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+  new_poller->sq_mask_ =
+      *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+  new_poller->sq_entries_ = params.sq_entries;
+  new_poller->sq_queued_tail_ = *new_poller->sq_tail_;
+  // The slots are used in order, so each index of the submission ring
+  // refers to the entry of the same index.
+  unsigned* sq_array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+  for (unsigned i = 0; i < params.sq_entries; ++i) {
+    sq_array[i] = i;
+  }
+  new_poller->cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+  new_poller->cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+  new_poller->cq_mask_ =
+      *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+  new_poller->cqes_ =
+      reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+
+  poller->swap(new_poller);
+  return Error::Success;
+}
+
+void
+IoUringPoller::Set(int fd, uint32_t events)
+{
+  Watch& watch = watches_[fd];
+  if (watch.armed && (watch.events == events)) {
+    return;
+  }
+  if (watch.armed) {
+    Disarm(fd, &watch);
+  }
+  watch.events = events;
+  Arm(fd, &watch);
+}
+
+void
+IoUringPoller::Remove(int fd)
+{
+  auto it = watches_.find(fd);
+  if (it == watches_.end()) {
+    return;
+  }
+  // The poll request holds the file, so it must be removed for the file to
+  // be released when 'fd' is closed.
+  if (it->second.armed) {
+    Disarm(fd, &it->second);
+  }
+  watches_.erase(it);
+}
+
+int
+IoUringPoller::Wait(struct epoll_event* events, int max_events, int timeout_ms)
+{
+  // The poll requests are one-shot, so the ones that completed are armed
+  // again, reporting the events again while they hold.
+  for (const int fd : rearm_) {
+    auto it = watches_.find(fd);
+    if ((it != watches_.end()) && !it->second.armed) {
+      Arm(fd, &it->second);
+    }
+  }
+  rearm_.clear();
+
+  // The queued changes are submitted in the same call as the wait, which
+  // is skipped when completions are already there to be reported.
+  const bool completed =
+      (__atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) != *cq_head_);
+  if ((to_submit_ != 0) || !completed) {
+    const unsigned min_complete = (completed || (timeout_ms == 0)) ? 0 : 1;
+    // A timeout or a full completion ring still leaves the completions to
+    // be reported.
+    if ((Enter(min_complete, timeout_ms) == -1) && (errno != ETIME) &&
+        (errno != EBUSY)) {
+      return -1;
+    }
+  }
+
+  int event_count = 0;
+  unsigned head = *cq_head_;
+  const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while ((head != tail) && (event_count < max_events)) {
+    const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    ++head;
+    if (cqe.user_data == kRemoveUserData) {
+      continue;
+    }
+    // The completions of the requests replaced or removed since are
+    // dropped.
+    const int fd = static_cast<int>(static_cast<uint32_t>(cqe.user_data));
+    auto it = watches_.find(fd);
+    if ((it == watches_.end()) || !it->second.armed ||
+        (it->second.generation != (cqe.user_data >> 32))) {
+      continue;
+    }
+    it->second.armed = false;
+    rearm_.push_back(fd);
+    events[event_count].data.fd = fd;
+    events[event_count].events =
+        (cqe.res < 0) ? EPOLLERR : static_cast<uint32_t>(cqe.res);
+    ++event_count;
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return event_count;
+}
+
+void
+IoUringPoller::Arm(int fd, Watch* watch)
+{
+  struct io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    // Retried with the next wait
+    rearm_.push_back(fd);
+    return;
+  }
+  watch->generation = ++last_generation_;
+  uint32_t events = watch->events;
+#if __BYTE_ORDER == __BIG_ENDIAN
+  events = __swahw32(events);
+#endif  // __BIG_ENDIAN
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->user_data = PollUserData(fd, watch->generation);
+  watch->armed = true;
+}
+
+void
+IoUringPoller::Disarm(int fd, Watch* watch)
+{
+  // If the removal can't be queued, the completion of the request is
+  // dropped when it comes.
+  watch->armed = false;
+  struct io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = PollUserData(fd, watch->generation);
+  sqe->user_data = kRemoveUserData;
+}
+
+struct io_uring_sqe*
+IoUringPoller::NextSqe()
+{
+  if ((sq_queued_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) ==
+      sq_entries_) {
+    if ((Enter(0 /* min_complete */, 0 /* timeout_ms */) == -1) ||
+        ((sq_queued_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) ==
+         sq_entries_)) {
+      return nullptr;
+    }
+  }
+  struct io_uring_sqe* sqe = &sqes_[sq_queued_tail_ & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  ++sq_queued_tail_;
+  ++to_submit_;
+  return sqe;
+}
+
+int
+IoUringPoller::Enter(unsigned min_complete, int timeout_ms)
+{
+  __atomic_store_n(sq_tail_, sq_queued_tail_, __ATOMIC_RELEASE);
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  unsigned flags = IORING_ENTER_EXT_ARG;
+  if (min_complete != 0) {
+    flags |= IORING_ENTER_GETEVENTS;
+    if (timeout_ms >= 0) {
+      ts.tv_sec = timeout_ms / 1000;
+      ts.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000 * 1000;
+      arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+  }
+  const long submitted = syscall(
+      __NR_io_uring_enter, ring_fd_, to_submit_, min_complete, flags, &arg,
+      sizeof(arg));
+  if (submitted == -1) {
+    return -1;
+  }
+  to_submit_ -= std::min<unsigned>(submitted, to_submit_);
+  return 0;
+}
+#else
+IoUringPoller::~IoUringPoller() {}
+
+Error
+IoUringPoller::Create(std::unique_ptr<IoUringPoller>* poller, unsigned entries)
+{
+  return Error("io_uring is not supported by this build");
+}
+
+void
+IoUringPoller::Set(int fd, uint32_t events)
+{
+}
+
+void
+IoUringPoller::Remove(int fd)
+{
+}
+
+int
+IoUringPoller::Wait(struct epoll_event* events, int max_events, int timeout_ms)
+{
+  return -1;
+}
+#endif  // __linux__ && TRITON_ENABLE_IO_URING
+
+}}  // namespace triton::client
@@ -0,0 +1,120 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+
+struct epoll_event;
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace triton { namespace client {
+
+//==============================================================================
+// An IoUringPoller waits for the readiness of file descriptors like an
+// epoll set, with one-shot poll requests of an io_uring instead. The
+// changes of the watched events are queued and submitted together with the
+// next wait, in a single system call, where epoll needs one epoll_ctl()
+// call per change. The events are the epoll ones and are reported while
+// the condition holds, as epoll does without EPOLLET.
+//
+// It is only available on Linux 5.11 and later, in builds with
+// TRITON_ENABLE_IO_URING. Create() fails otherwise, so that the caller can
+// fall back to epoll.
+//
+class IoUringPoller {
+ public:
+  ~IoUringPoller();
+
+  // Create a poller whose ring has 'entries' submission slots.
+  static Error Create(std::unique_ptr<IoUringPoller>* poller, unsigned entries);
+
+  // Watch 'fd' for 'events', replacing the events it was watched for.
+  void Set(int fd, uint32_t events);
+
+  // Stop watching 'fd'. Must be called before 'fd' is closed.
+  void Remove(int fd);
+
+  // Submit the queued changes and wait up to 'timeout_ms', -1 for no
+  // limit, for events. Returns the number of events stored in 'events', or
+  // -1 with errno set on failure.
+  int Wait(struct epoll_event* events, int max_events, int timeout_ms);
+
+ private:
+  // The poll request of a watched file descriptor. Its generation tells
+  // the completions of the current request from the ones of the requests
+  // it replaced, including the ones of a file descriptor number reused.
+  struct Watch {
+    uint32_t events{0};
+    uint32_t generation{0};
+    bool armed{false};
+  };
+
+  IoUringPoller() = default;
+
+  // Queue a new poll request for 'fd'.
+  void Arm(int fd, Watch* watch);
+  // Queue the removal of the poll request armed for 'fd'.
+  void Disarm(int fd, Watch* watch);
+  // Returns the next free submission slot, submitting the queued ones
+  // first if the ring is full. Returns nullptr on failure.
+  struct io_uring_sqe* NextSqe();
+  // Submit the queued slots and wait for 'min_complete' completions, for
+  // up to 'timeout_ms'. Returns -1 with errno set on failure.
+  int Enter(unsigned min_complete, int timeout_ms);
+
+  int ring_fd_{-1};
+  void* ring_{nullptr};
+  size_t ring_size_{0};
+  struct io_uring_sqe* sqes_{nullptr};
+  size_t sqes_size_{0};
+  unsigned* sq_head_{nullptr};
+  unsigned* sq_tail_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned sq_entries_{0};
+  unsigned* cq_head_{nullptr};
+  unsigned* cq_tail_{nullptr};
+  unsigned cq_mask_{0};
+  struct io_uring_cqe* cqes_{nullptr};
+  // The tail of the submission ring including the queued slots, which
+  // are published to the kernel by Enter().
+  unsigned sq_queued_tail_{0};
+  // The slots queued since the last call to io_uring_enter().
+  unsigned to_submit_{0};
+
+  uint32_t last_generation_{0};
+  std::unordered_map<int, Watch> watches_;
+  // The watched file descriptors whose poll request completed, to arm
+  // again with the next wait.
+  std::vector<int> rearm_;
+};
+
+}}  // namespace triton::client
@@ -0,0 +1,544 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A BatchSliceInferResult is the part of the result of a batched request
+/// that belongs to one of the samples of the batch, see
+/// InferenceRequestBatcher. The first dimension of every output of the
+/// batched result is split evenly between the samples.
+///
+class BatchSliceInferResult : public InferResult {
+ public:
+  BatchSliceInferResult(
+      const std::shared_ptr<InferResult>& batch_result, const size_t index,
+      const size_t batch_size)
+      : batch_result_(batch_result), index_(index), batch_size_(batch_size)
+  {
+  }
+
+  /// Create the result of a sample whose batch could not be sent.
+  explicit BatchSliceInferResult(const Error& status)
+      : status_(status), index_(0), batch_size_(1)
+  {
+  }
+
+  Error ModelName(std::string* name) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    return batch_result_->ModelName(name);
+  }
+
+  Error ModelVersion(std::string* version) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    return batch_result_->ModelVersion(version);
+  }
+
+  Error Id(std::string* id) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    return batch_result_->Id(id);
+  }
+
+  Error Shape(
+      const std::string& output_name,
+      std::vector<int64_t>* shape) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    Error err = batch_result_->Shape(output_name, shape);
+    if (!err.IsOk()) {
+      return err;
+    }
+    if (!shape->empty()) {
+      (*shape)[0] /= batch_size_;
+    }
+    return Error::Success;
+  }
+
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    return batch_result_->Datatype(output_name, datatype);
+  }
+
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    Error err = batch_result_->RawData(output_name, buf, byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    *byte_size /= batch_size_;
+    *buf += index_ * *byte_size;
+    return Error::Success;
+  }
+
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override
+  {
+    std::vector<std::pair<const char*, size_t>> refs;
+    Error err = StringDataRefs(output_name, &refs);
+    if (!err.IsOk()) {
+      return err;
+    }
+    string_result->clear();
+    for (const auto& ref : refs) {
+      string_result->emplace_back(ref.first, ref.second);
+    }
+    return Error::Success;
+  }
+
+  Error StringDataRefs(
+      const std::string& output_name,
+      std::vector<std::pair<const char*, size_t>>* string_result)
+      const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    std::vector<std::pair<const char*, size_t>> refs;
+    Error err = batch_result_->StringDataRefs(output_name, &refs);
+    if (!err.IsOk()) {
+      return err;
+    }
+    const size_t count = refs.size() / batch_size_;
+    string_result->assign(
+        refs.begin() + index_ * count, refs.begin() + (index_ + 1) * count);
+    return Error::Success;
+  }
+
+  std::string DebugString() const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_.Message();
+    }
+    return "sample " + std::to_string(index_) + " of " +
+           std::to_string(batch_size_) + " of " +
+           batch_result_->DebugString();
+  }
+
+  Error RequestStatus() const override
+  {
+    if (batch_result_ == nullptr) {
+      return status_;
+    }
+    return batch_result_->RequestStatus();
+  }
+
+  Error IsFinalResponse(bool* is_final_response) const override
+  {
+    if (batch_result_ == nullptr) {
+      *is_final_response = true;
+      return Error::Success;
+    }
+    return batch_result_->IsFinalResponse(is_final_response);
+  }
+
+  Error IsNullResponse(bool* is_null_response) const override
+  {
+    if (batch_result_ == nullptr) {
+      *is_null_response = false;
+      return Error::Success;
+    }
+    return batch_result_->IsNullResponse(is_null_response);
+  }
+
+ private:
+  std::shared_ptr<InferResult> batch_result_;
+  Error status_;
+  const size_t index_;
+  const size_t batch_size_;
+};
+
+//==============================================================================
+/// An InferenceRequestBatcher coalesces single-sample inferences to a model
+/// into batched requests sent by an InferenceServerHttpClient or an
+/// InferenceServerGrpcClient, and splits the result of every batch back to
+/// the callers. It saves the per-request cost of the network and the
+/// server when that cost is large compared to the computation of the
+/// model.
+///
+/// The data of the samples is concatenated along the first dimension. A
+/// batch is sent when it is full, when no batch is in flight, or when its
+/// first sample has waited 'max_delay_us', provided fewer than
+/// 'max_in_flight' batches are in flight. A lightly loaded batcher thus
+/// sends every sample right away and batches grow with the load.
+///
+/// \code
+///   std::unique_ptr<InferenceRequestBatcher<InferenceServerGrpcClient>>
+///       batcher;
+///   InferenceRequestBatcher<InferenceServerGrpcClient>::Create(
+///       &batcher, client.get(), InferOptions("tabular"), {input0},
+///       {output0}, 64 /* max_batch_size */, 500 /* max_delay_us */);
+///   batcher->AsyncInfer(callback, {sample_data});
+/// \endcode
+///
+template <typename Client>
+class InferenceRequestBatcher {
+ public:
+  /// Create a batcher.
+  /// \param batcher Returns the new batcher.
+  /// \param client The client sending the batches, which must outlive the
+  /// batcher.
+  /// \param options The options of the batched requests. The id and the
+  /// sequence of the options are not supported.
+  /// \param inputs The inputs of the model for one sample: their names,
+  /// datatypes and shapes with a first dimension of 1. Their data is not
+  /// used. BYTES inputs are not supported.
+  /// \param outputs The outputs requested in the batched requests, which
+  /// must outlive the batcher and not use shared memory.
+  /// \param max_batch_size The maximum number of samples in a batch.
+  /// \param max_delay_us The longest time a sample waits for a batch to
+  /// fill while another batch is in flight, in microseconds.
+  /// \param max_in_flight The maximum number of batches in flight.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<InferenceRequestBatcher>* batcher, Client* client,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const size_t max_batch_size, const uint64_t max_delay_us,
+      const size_t max_in_flight = 1)
+  {
+    if (max_batch_size == 0) {
+      return Error("max_batch_size must be > 0");
+    }
+    if (max_in_flight == 0) {
+      return Error("max_in_flight must be > 0");
+    }
+    if ((options.sequence_id_ != 0) || !options.sequence_id_str_.empty()) {
+      return Error("sequence requests can't be batched");
+    }
+
+    std::vector<InputSpec> specs;
+    for (const auto input : inputs) {
+      InputSpec spec;
+      spec.name_ = input->Name();
+      spec.datatype_ = input->Datatype();
+      spec.shape_ = input->Shape();
+      if (spec.shape_.empty() || (spec.shape_[0] != 1)) {
+        return Error(
+            "the first dimension of input '" + spec.name_ + "' must be 1");
+      }
+      spec.byte_size_ = DataTypeByteSize(input->Type());
+      if (spec.byte_size_ == 0) {
+        return Error(
+            "input '" + spec.name_ + "' has unsupported datatype " +
+            spec.datatype_);
+      }
+      for (const auto dim : spec.shape_) {
+        if (dim < 0) {
+          return Error(
+              "the shape of input '" + spec.name_ + "' must be fixed");
+        }
+        spec.byte_size_ *= dim;
+      }
+      specs.emplace_back(std::move(spec));
+    }
+    for (const auto output : outputs) {
+      if (output->IsSharedMemory()) {
+        return Error(
+            "output '" + output->Name() + "' can't use shared memory");
+      }
+    }
+
+    batcher->reset(new InferenceRequestBatcher(
+        client, options, std::move(specs), outputs, max_batch_size,
+        max_delay_us, max_in_flight));
+    return Error::Success;
+  }
+
+  /// Send the samples waiting for a batch, and wait for the batches in
+  /// flight to complete.
+  ~InferenceRequestBatcher()
+  {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      exiting_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+    std::unique_lock<std::mutex> lk(mtx_);
+    cv_.wait(lk, [this]() { return in_flight_ == 0; });
+  }
+
+  /// Queue one sample for inference. Its data is copied, so the buffers
+  /// can be reused as soon as the call returns.
+  /// \param callback The function called with the result of the sample,
+  /// which the callback owns. It is called on the thread completing the
+  /// batch, or on the batcher thread if the batch could not be sent.
+  /// \param input_data The data of each input, in the order of the inputs
+  /// given to Create(), of the byte size of one sample.
+  /// \return Error object indicating success or failure.
+  Error AsyncInfer(
+      InferenceServerClient::OnCompleteFn callback,
+      const std::vector<const uint8_t*>& input_data)
+  {
+    if (callback == nullptr) {
+      return Error(
+          "Callback function must be provided along with AsyncInfer() call.");
+    }
+    if (input_data.size() != inputs_.size()) {
+      return Error(
+          "expected data for " + std::to_string(inputs_.size()) +
+          " inputs, got " + std::to_string(input_data.size()));
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      if (batches_.empty() ||
+          (batches_.back()->callbacks_.size() == max_batch_size_)) {
+        batches_.emplace_back(new Batch(inputs_, max_batch_size_));
+      }
+      Batch* batch = batches_.back().get();
+      for (size_t i = 0; i < inputs_.size(); ++i) {
+        batch->data_[i].insert(
+            batch->data_[i].end(), input_data[i],
+            input_data[i] + inputs_[i].byte_size_);
+      }
+      batch->callbacks_.emplace_back(std::move(callback));
+    }
+    cv_.notify_all();
+    return Error::Success;
+  }
+
+  /// Run the inference of one sample, waiting for its batch to complete.
+  /// \param result Returns the result of the sample.
+  /// \param input_data The data of each input, see AsyncInfer().
+  /// \return Error object indicating success or failure of the request.
+  Error Infer(
+      InferResult** result, const std::vector<const uint8_t*>& input_data)
+  {
+    std::promise<InferResult*> promise;
+    std::future<InferResult*> future = promise.get_future();
+    Error err = AsyncInfer(
+        [&promise](InferResult* result) { promise.set_value(result); },
+        input_data);
+    if (!err.IsOk()) {
+      return err;
+    }
+    *result = future.get();
+    return (*result)->RequestStatus();
+  }
+
+  /// \return The number of batches sent.
+  uint64_t BatchCount() const
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return batch_count_;
+  }
+
+  /// \return The number of samples sent in the batches.
+  uint64_t SampleCount() const
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return sample_count_;
+  }
+
+ private:
+  struct InputSpec {
+    std::string name_;
+    std::string datatype_;
+    std::vector<int64_t> shape_;
+    // The byte size of the data of one sample.
+    size_t byte_size_;
+  };
+
+  struct Batch {
+    Batch(const std::vector<InputSpec>& inputs, const size_t max_batch_size)
+        : data_(inputs.size()), start_(std::chrono::steady_clock::now())
+    {
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        data_[i].reserve(inputs[i].byte_size_ * max_batch_size);
+      }
+      callbacks_.reserve(max_batch_size);
+    }
+
+    // The concatenated data of each input, referenced by 'inputs_' until
+    // the request completes.
+    std::vector<std::vector<uint8_t>> data_;
+    std::vector<InferenceServerClient::OnCompleteFn> callbacks_;
+    std::vector<std::unique_ptr<InferInput>> inputs_;
+    // When the first sample was added.
+    const std::chrono::steady_clock::time_point start_;
+  };
+
+  InferenceRequestBatcher(
+      Client* client, const InferOptions& options,
+      std::vector<InputSpec>&& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const size_t max_batch_size, const uint64_t max_delay_us,
+      const size_t max_in_flight)
+      : client_(client), options_(options), inputs_(std::move(inputs)),
+        outputs_(outputs), max_batch_size_(max_batch_size),
+        max_delay_(std::chrono::microseconds(max_delay_us)),
+        max_in_flight_(max_in_flight), in_flight_(0), batch_count_(0),
+        sample_count_(0), exiting_(false)
+  {
+    options_.request_id_.clear();
+    worker_ = std::thread(&InferenceRequestBatcher::Dispatch, this);
+  }
+
+  // Whether the first queued batch can be sent now, with 'mtx_' held.
+  bool Ready(const std::chrono::steady_clock::time_point& now) const
+  {
+    if (batches_.empty() || (in_flight_ >= max_in_flight_)) {
+      return false;
+    }
+    const Batch& batch = *batches_.front();
+    return exiting_ || (in_flight_ == 0) ||
+           (batch.callbacks_.size() == max_batch_size_) ||
+           (now >= batch.start_ + max_delay_);
+  }
+
+  // The loop of 'worker_', sending the batches as they become ready.
+  void Dispatch()
+  {
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (true) {
+      const auto now = std::chrono::steady_clock::now();
+      if (Ready(now)) {
+        std::unique_ptr<Batch> batch(std::move(batches_.front()));
+        batches_.pop_front();
+        in_flight_++;
+        batch_count_++;
+        sample_count_ += batch->callbacks_.size();
+        lk.unlock();
+        Send(std::move(batch));
+        lk.lock();
+      } else if (exiting_ && batches_.empty()) {
+        return;
+      } else if (!batches_.empty() && (in_flight_ < max_in_flight_)) {
+        cv_.wait_until(lk, batches_.front()->start_ + max_delay_);
+      } else {
+        cv_.wait(lk);
+      }
+    }
+  }
+
+  void Send(std::unique_ptr<Batch>&& batch)
+  {
+    const size_t batch_size = batch->callbacks_.size();
+    std::vector<InferInput*> inputs;
+    Error err;
+    for (size_t i = 0; err.IsOk() && (i < inputs_.size()); ++i) {
+      std::vector<int64_t> shape(inputs_[i].shape_);
+      shape[0] = batch_size;
+      InferInput* input;
+      err = InferInput::Create(
+          &input, inputs_[i].name_, shape, inputs_[i].datatype_);
+      if (err.IsOk()) {
+        batch->inputs_.emplace_back(input);
+        inputs.push_back(input);
+        err = input->AppendRaw(batch->data_[i]);
+      }
+    }
+
+    // The batch is kept alive by the callback since the HTTP client reads
+    // the input data while the request is sent.
+    std::shared_ptr<Batch> shared_batch(std::move(batch));
+    if (err.IsOk()) {
+      err = client_->AsyncInfer(
+          [this, shared_batch](InferResult* result) {
+            std::shared_ptr<InferResult> batch_result(result);
+            const size_t batch_size = shared_batch->callbacks_.size();
+            for (size_t i = 0; i < batch_size; ++i) {
+              shared_batch->callbacks_[i](
+                  new BatchSliceInferResult(batch_result, i, batch_size));
+            }
+            Complete();
+          },
+          options_, inputs, outputs_);
+    }
+    if (!err.IsOk()) {
+      for (auto& callback : shared_batch->callbacks_) {
+        callback(new BatchSliceInferResult(err));
+      }
+      Complete();
+    }
+  }
+
+  void Complete()
+  {
+    // Notified with the lock held, as the destructor may return as soon as
+    // the last batch completes.
+    std::lock_guard<std::mutex> lk(mtx_);
+    in_flight_--;
+    cv_.notify_all();
+  }
+
+  Client* client_;
+  InferOptions options_;
+  const std::vector<InputSpec> inputs_;
+  const std::vector<const InferRequestedOutput*> outputs_;
+  const size_t max_batch_size_;
+  const std::chrono::microseconds max_delay_;
+  const size_t max_in_flight_;
+
+  // Protects the members below.
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Batch>> batches_;
+  size_t in_flight_;
+  uint64_t batch_count_;
+  uint64_t sample_count_;
+  bool exiting_;
+  std::thread worker_;
+};
+
+}}  // namespace triton::client
@@ -0,0 +1,509 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A SplitInferResult is the result of a request split into sub-batches by
+/// InferenceRequestSplitter. Every output is the outputs of the sub-batches
+/// concatenated along their first dimension, in the order of the samples.
+///
+class SplitInferResult : public InferResult {
+ public:
+  /// \param results The results of the sub-batches, in order. Null for the
+  /// sub-batches that could not be sent.
+  /// \param status The error of the sub-batches that could not be sent.
+  SplitInferResult(
+      std::vector<std::unique_ptr<InferResult>>&& results, const Error& status)
+      : results_(std::move(results)), status_(status)
+  {
+    for (size_t i = 0; status_.IsOk() && (i < results_.size()); ++i) {
+      status_ = results_[i]->RequestStatus();
+    }
+  }
+
+  Error ModelName(std::string* name) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    return results_[0]->ModelName(name);
+  }
+
+  Error ModelVersion(std::string* version) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    return results_[0]->ModelVersion(version);
+  }
+
+  Error Id(std::string* id) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    return results_[0]->Id(id);
+  }
+
+  Error Shape(
+      const std::string& output_name,
+      std::vector<int64_t>* shape) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    Error err = results_[0]->Shape(output_name, shape);
+    for (size_t i = 1; err.IsOk() && (i < results_.size()); ++i) {
+      std::vector<int64_t> sub_shape;
+      err = results_[i]->Shape(output_name, &sub_shape);
+      if (err.IsOk() && !shape->empty() && !sub_shape.empty()) {
+        (*shape)[0] += sub_shape[0];
+      }
+    }
+    return err;
+  }
+
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    return results_[0]->Datatype(output_name, datatype);
+  }
+
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    if (results_.size() == 1) {
+      return results_[0]->RawData(output_name, buf, byte_size);
+    }
+
+    // The outputs are concatenated the first time they are read
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto it = outputs_.find(output_name);
+    if (it == outputs_.end()) {
+      std::vector<uint8_t> data;
+      for (const auto& result : results_) {
+        const uint8_t* sub_buf;
+        size_t sub_byte_size;
+        Error err = result->RawData(output_name, &sub_buf, &sub_byte_size);
+        if (!err.IsOk()) {
+          return err;
+        }
+        data.insert(data.end(), sub_buf, sub_buf + sub_byte_size);
+      }
+      it = outputs_.emplace(output_name, std::move(data)).first;
+    }
+    *buf = it->second.data();
+    *byte_size = it->second.size();
+    return Error::Success;
+  }
+
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override
+  {
+    std::vector<std::pair<const char*, size_t>> refs;
+    Error err = StringDataRefs(output_name, &refs);
+    if (!err.IsOk()) {
+      return err;
+    }
+    string_result->clear();
+    for (const auto& ref : refs) {
+      string_result->emplace_back(ref.first, ref.second);
+    }
+    return Error::Success;
+  }
+
+  Error StringDataRefs(
+      const std::string& output_name,
+      std::vector<std::pair<const char*, size_t>>* string_result)
+      const override
+  {
+    if (!status_.IsOk()) {
+      return status_;
+    }
+    string_result->clear();
+    for (const auto& result : results_) {
+      std::vector<std::pair<const char*, size_t>> refs;
+      Error err = result->StringDataRefs(output_name, &refs);
+      if (!err.IsOk()) {
+        return err;
+      }
+      string_result->insert(string_result->end(), refs.begin(), refs.end());
+    }
+    return Error::Success;
+  }
+
+  std::string DebugString() const override
+  {
+    if (!status_.IsOk()) {
+      return status_.Message();
+    }
+    std::string debug_string;
+    for (size_t i = 0; i < results_.size(); ++i) {
+      debug_string += "sub-batch " + std::to_string(i) + " of " +
+                      std::to_string(results_.size()) + ": " +
+                      results_[i]->DebugString() + "\n";
+    }
+    return debug_string;
+  }
+
+  Error RequestStatus() const override { return status_; }
+
+  Error IsFinalResponse(bool* is_final_response) const override
+  {
+    *is_final_response = true;
+    return Error::Success;
+  }
+
+  Error IsNullResponse(bool* is_null_response) const override
+  {
+    *is_null_response = false;
+    return Error::Success;
+  }
+
+ private:
+  std::vector<std::unique_ptr<InferResult>> results_;
+  Error status_;
+  // The concatenated outputs read so far, by name.
+  mutable std::mutex mtx_;
+  mutable std::map<std::string, std::vector<uint8_t>> outputs_;
+};
+
+//==============================================================================
+/// An InferenceRequestSplitter splits a request with a large batch into
+/// sub-batches sent concurrently by one or more InferenceServerHttpClient
+/// or InferenceServerGrpcClient objects, and joins their results back into
+/// one, see SplitInferResult. It is the inverse of InferenceRequestBatcher:
+/// it cuts the latency of a large batch when the server has idle model
+/// instances to run the sub-batches on, at the cost of more requests.
+///
+/// The sub-batches are spread over the clients in turn, possibly to
+/// different servers, and the sub-batches of a client are sent together
+/// with AsyncInferMulti(), so that they are pipelined over its connection.
+///
+/// \code
+///   std::unique_ptr<InferenceRequestSplitter<InferenceServerGrpcClient>>
+///       splitter;
+///   InferenceRequestSplitter<InferenceServerGrpcClient>::Create(
+///       &splitter, {client0.get(), client1.get()}, 4 /* sub_batch_count */);
+///   splitter->AsyncInfer(callback, InferOptions("resnet50"), {input0});
+/// \endcode
+///
+template <typename Client>
+class InferenceRequestSplitter {
+ public:
+  /// Create a splitter.
+  /// \param splitter Returns the new splitter.
+  /// \param clients The clients sending the sub-batches, which must outlive
+  /// the splitter.
+  /// \param sub_batch_count The number of sub-batches a request is split
+  /// into. A request with a smaller batch is split into one sample per
+  /// sub-batch.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<InferenceRequestSplitter>* splitter,
+      const std::vector<Client*>& clients, const size_t sub_batch_count)
+  {
+    if (clients.empty()) {
+      return Error("at least one client must be given");
+    }
+    if (sub_batch_count == 0) {
+      return Error("sub_batch_count must be > 0");
+    }
+    splitter->reset(new InferenceRequestSplitter(clients, sub_batch_count));
+    return Error::Success;
+  }
+
+  /// Run an asynchronous inference, split into sub-batches. The data of the
+  /// inputs is referenced by the sub-batches, so it must not be modified or
+  /// destroyed until the callback is called.
+  /// \param callback The function called with the joined result, which the
+  /// callback owns. It is called on the thread completing the last
+  /// sub-batch.
+  /// \param options The options of the request. The sequence of the options
+  /// is not supported.
+  /// \param inputs The inputs of the request, which all have the batch as
+  /// their first dimension. BYTES inputs are not supported.
+  /// \param outputs The outputs requested, which must not use shared memory
+  /// or user buffers.
+  /// \return Error object indicating success or failure. The callback is
+  /// not called if an error is returned.
+  Error AsyncInfer(
+      InferenceServerClient::OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>())
+  {
+    if (callback == nullptr) {
+      return Error(
+          "Callback function must be provided along with AsyncInfer() call.");
+    }
+    if ((options.sequence_id_ != 0) || !options.sequence_id_str_.empty()) {
+      return Error("sequence requests can't be split");
+    }
+    if (inputs.empty() || inputs[0]->Shape().empty()) {
+      return Error("the inputs must have a batch dimension");
+    }
+    const int64_t batch_size = inputs[0]->Shape()[0];
+    if (batch_size <= 0) {
+      return Error("the batch of the inputs must be > 0");
+    }
+    for (const auto input : inputs) {
+      if (input->Shape().empty() || (input->Shape()[0] != batch_size)) {
+        return Error(
+            "the first dimension of input '" + input->Name() + "' must be " +
+            std::to_string(batch_size));
+      }
+      if (DataTypeByteSize(input->Type()) == 0) {
+        return Error(
+            "input '" + input->Name() + "' has unsupported datatype " +
+            input->Datatype());
+      }
+    }
+    for (const auto output : outputs) {
+      if (output->IsSharedMemory() || output->IsUserBuffer()) {
+        return Error(
+            "output '" + output->Name() +
+            "' can't use shared memory or a user buffer");
+      }
+    }
+
+    auto split = std::make_shared<Split>();
+    split->callback_ = std::move(callback);
+    const size_t sub_batch_count =
+        std::min<size_t>(sub_batch_count_, batch_size);
+    Error err = split->Build(inputs, batch_size, sub_batch_count);
+    if (!err.IsOk()) {
+      return err;
+    }
+    split->results_.resize(sub_batch_count);
+
+    // The sub-batches of each client, in order
+    const size_t client_count = std::min(clients_.size(), sub_batch_count);
+    std::vector<std::vector<size_t>> client_sub_batches(client_count);
+    for (size_t i = 0; i < sub_batch_count; ++i) {
+      client_sub_batches[i % client_count].push_back(i);
+    }
+    split->pending_ = client_count;
+    const size_t first_client = first_client_++;
+
+    for (size_t c = 0; c < client_count; ++c) {
+      const std::vector<size_t>& sub_batches = client_sub_batches[c];
+      std::vector<InferOptions> sub_options(sub_batches.size(), options);
+      std::vector<std::vector<InferInput*>> sub_inputs;
+      std::vector<std::vector<const InferRequestedOutput*>> sub_outputs(
+          sub_batches.size(), outputs);
+      for (const auto i : sub_batches) {
+        sub_inputs.emplace_back(split->InputsOf(i));
+      }
+      Client* client = clients_[(first_client + c) % clients_.size()];
+      err = client->AsyncInferMulti(
+          [split, sub_batches](std::vector<InferResult*> results) {
+            for (size_t j = 0; j < results.size(); ++j) {
+              split->results_[sub_batches[j]].reset(results[j]);
+            }
+            split->Complete();
+          },
+          sub_options, sub_inputs, sub_outputs);
+      if (!err.IsOk()) {
+        if (c == 0) {
+          // Nothing was sent, so the callback is not called
+          return err;
+        }
+        split->Fail(err);
+      }
+    }
+    return Error::Success;
+  }
+
+  /// Run a synchronous inference, split into sub-batches, see
+  /// AsyncInfer().
+  /// \param result Returns the joined result.
+  /// \param options The options of the request.
+  /// \param inputs The inputs of the request.
+  /// \param outputs The outputs requested.
+  /// \return Error object indicating success or failure of the request.
+  Error Infer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>())
+  {
+    std::promise<InferResult*> promise;
+    std::future<InferResult*> future = promise.get_future();
+    Error err = AsyncInfer(
+        [&promise](InferResult* result) { promise.set_value(result); },
+        options, inputs, outputs);
+    if (!err.IsOk()) {
+      return err;
+    }
+    *result = future.get();
+    return (*result)->RequestStatus();
+  }
+
+ private:
+  // The state of a split request, kept alive by the callbacks of its
+  // sub-batches.
+  struct Split {
+    // Create the inputs of the sub-batches, each sub-batch having the same
+    // number of samples give or take one.
+    Error Build(
+        const std::vector<InferInput*>& inputs, const int64_t batch_size,
+        const size_t sub_batch_count)
+    {
+      input_count_ = inputs.size();
+      size_t start = 0;
+      for (size_t i = 0; i < sub_batch_count; ++i) {
+        const size_t count = (batch_size / sub_batch_count) +
+                             ((i < batch_size % sub_batch_count) ? 1 : 0);
+        for (const auto input : inputs) {
+          std::vector<int64_t> shape(input->Shape());
+          shape[0] = count;
+          InferInput* sub_input;
+          Error err = InferInput::Create(
+              &sub_input, input->Name(), shape, input->Datatype());
+          if (!err.IsOk()) {
+            return err;
+          }
+          inputs_.emplace_back(sub_input);
+          err = Slice(*input, batch_size, start, count, sub_input);
+          if (!err.IsOk()) {
+            return err;
+          }
+        }
+        start += count;
+      }
+      return Error::Success;
+    }
+
+    // Set the data of the samples ['start', 'start' + 'count') of 'input'
+    // to 'sub_input'.
+    static Error Slice(
+        const InferInput& input, const int64_t batch_size, const size_t start,
+        const size_t count, InferInput* sub_input)
+    {
+      if (input.IsSharedMemory()) {
+        std::string name;
+        size_t byte_size, offset;
+        Error err = input.SharedMemoryInfo(&name, &byte_size, &offset);
+        if (!err.IsOk()) {
+          return err;
+        }
+        const size_t sample_byte_size = byte_size / batch_size;
+        return sub_input->SetSharedMemory(
+            name, sample_byte_size * count, offset + sample_byte_size * start);
+      }
+      size_t byte_size;
+      Error err = input.ByteSize(&byte_size);
+      if (!err.IsOk()) {
+        return err;
+      }
+      const size_t sample_byte_size = byte_size / batch_size;
+      return sub_input->AppendSlice(
+          input, sample_byte_size * start, sample_byte_size * count);
+    }
+
+    std::vector<InferInput*> InputsOf(const size_t sub_batch) const
+    {
+      std::vector<InferInput*> inputs;
+      for (size_t i = 0; i < input_count_; ++i) {
+        inputs.push_back(inputs_[sub_batch * input_count_ + i].get());
+      }
+      return inputs;
+    }
+
+    // Record that the sub-batches of a client could not be sent.
+    void Fail(const Error& err)
+    {
+      {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (status_.IsOk()) {
+          status_ = err;
+        }
+      }
+      Complete();
+    }
+
+    // Called once the sub-batches of a client have completed, the last
+    // call joins the results.
+    void Complete()
+    {
+      if (--pending_ != 0) {
+        return;
+      }
+      Error status;
+      {
+        std::lock_guard<std::mutex> lk(mtx_);
+        status = status_;
+      }
+      callback_(new SplitInferResult(std::move(results_), status));
+    }
+
+    InferenceServerClient::OnCompleteFn callback_;
+    // The inputs of the sub-batches, 'input_count_' per sub-batch.
+    std::vector<std::unique_ptr<InferInput>> inputs_;
+    size_t input_count_{0};
+    std::vector<std::unique_ptr<InferResult>> results_;
+    // The number of clients whose sub-batches have not completed.
+    std::atomic<size_t> pending_{0};
+    std::mutex mtx_;
+    Error status_;
+  };
+
+  InferenceRequestSplitter(
+      const std::vector<Client*>& clients, const size_t sub_batch_count)
+      : clients_(clients), sub_batch_count_(sub_batch_count)
+  {
+  }
+
+  const std::vector<Client*> clients_;
+  const size_t sub_batch_count_;
+  // The client sending the first sub-batch of the next request, so that
+  // requests with fewer sub-batches than clients are spread too.
+  std::atomic<size_t> first_client_{0};
+};
+
+}}  // namespace triton::client
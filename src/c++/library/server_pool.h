@@ -0,0 +1,609 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// An InferenceServerPool spreads inferences over several servers. It keeps
+/// a pool of connections, that is of InferenceServerHttpClient or
+/// InferenceServerGrpcClient objects, to each server and routes every
+/// request with the power of two choices: two servers are drawn at random
+/// and the one with the lower load is used. The load of a server is either
+/// its number of outstanding requests or that number weighted by an
+/// exponentially weighted moving average (EWMA) of its request latency.
+///
+/// \code
+///   std::unique_ptr<InferenceServerPool<InferenceServerGrpcClient>> pool;
+///   InferenceServerPool<InferenceServerGrpcClient>::Create(
+///       &pool, {"server0:8001", "server1:8001"},
+///       [](const std::string& url,
+///          std::unique_ptr<InferenceServerGrpcClient>* client) {
+///         return InferenceServerGrpcClient::Create(
+///             client, url, false /* verbose */, false /* use_ssl */,
+///             SslOptions(), KeepAliveOptions(),
+///             false /* use_cached_channel */);
+///       },
+///       4 /* connections_per_server */);
+///   pool->AsyncInfer(callback, options, inputs, outputs);
+/// \endcode
+///
+/// Asynchronous inferences can also be hedged, see EnableHedging(): a
+/// request still running after a delay is sent again to another server,
+/// and the first of the two responses is returned. A server that keeps
+/// failing can be taken out of the routing for a while, see
+/// EnableEviction().
+///
+template <typename Client>
+class InferenceServerPool {
+ public:
+  /// How the load of a server is measured when routing a request.
+  enum class RoutingPolicy {
+    // The number of requests sent to the server that have not completed.
+    LEAST_OUTSTANDING,
+    // The EWMA latency of the server multiplied by its number of
+    // outstanding requests plus one.
+    EWMA_LATENCY
+  };
+
+  /// Creates a connection to a server.
+  using ClientFactory =
+      std::function<Error(const std::string&, std::unique_ptr<Client>*)>;
+
+  /// Create a pool of connections to the servers.
+  /// \param pool Returns the new pool.
+  /// \param server_urls The URLs of the servers.
+  /// \param factory The function creating each connection. For gRPC, the
+  /// channel of each connection is only separate when the factory creates
+  /// the client with 'use_cached_channel' set to false.
+  /// \param connections_per_server The number of connections to each
+  /// server. A synchronous inference holds a connection for its duration,
+  /// asynchronous inferences are spread over the connections of the server.
+  /// \param policy How the load of the servers is compared.
+  /// \param ewma_weight The weight of the latest latency in the EWMA.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<InferenceServerPool>* pool,
+      const std::vector<std::string>& server_urls,
+      const ClientFactory& factory, const size_t connections_per_server = 1,
+      const RoutingPolicy policy = RoutingPolicy::LEAST_OUTSTANDING,
+      const double ewma_weight = 0.2)
+  {
+    if (server_urls.empty()) {
+      return Error("at least one server url must be given");
+    }
+    if (connections_per_server == 0) {
+      return Error("connections_per_server must be > 0");
+    }
+    if ((ewma_weight <= 0) || (ewma_weight > 1)) {
+      return Error("ewma_weight must be in (0, 1]");
+    }
+
+    std::unique_ptr<InferenceServerPool> new_pool(
+        new InferenceServerPool(policy, ewma_weight));
+    for (const auto& url : server_urls) {
+      std::unique_ptr<Server> server(new Server(url));
+      for (size_t i = 0; i < connections_per_server; ++i) {
+        std::unique_ptr<Client> client;
+        Error err = factory(url, &client);
+        if (!err.IsOk()) {
+          return Error(
+              "failed to connect to '" + url + "': " + err.Message());
+        }
+        server->clients_.emplace_back(std::move(client));
+        server->idle_.push_back(i);
+      }
+      new_pool->servers_.emplace_back(std::move(server));
+    }
+    *pool = std::move(new_pool);
+    return Error::Success;
+  }
+
+  /// Run a synchronous inference on the least loaded of two servers. Takes
+  /// the arguments of the Infer() function of the client after the inputs.
+  /// \return Error object indicating success or failure of the request.
+  template <typename... Args>
+  Error Infer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs, Args&&... args)
+  {
+    Server* server = Route();
+    const size_t connection = server->Acquire();
+    const auto start = std::chrono::steady_clock::now();
+    Error err = server->clients_[connection]->Infer(
+        result, options, inputs, std::forward<Args>(args)...);
+    Complete(server, start, err.IsOk());
+    server->Release(connection);
+    return err;
+  }
+
+  ~InferenceServerPool()
+  {
+    if (hedge_worker_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lk(hedge_mtx_);
+        exiting_ = true;
+      }
+      hedge_cv_.notify_all();
+      hedge_worker_.join();
+    }
+  }
+
+  /// Run an asynchronous inference on the least loaded of two servers.
+  /// Takes the arguments of the AsyncInfer() function of the client after
+  /// the inputs.
+  /// \return Error object indicating success or failure.
+  template <typename... Args>
+  Error AsyncInfer(
+      InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      Args&&... args)
+  {
+    if (!hedging_ || (servers_.size() < 2)) {
+      return Send(
+          Route(), std::move(callback), options, inputs,
+          std::forward<Args>(args)...);
+    }
+
+    std::shared_ptr<Hedge> hedge(new Hedge(std::move(callback)));
+    hedge->primary_ = Route();
+    hedge->send_ = [this, options, inputs, args...](
+                       Server* server,
+                       InferenceServerClient::OnCompleteFn callback) {
+      return Send(server, std::move(callback), options, inputs, args...);
+    };
+    Error err = hedge->send_(hedge->primary_, [hedge](InferResult* result) {
+      hedge->Finish(result);
+    });
+    if (!err.IsOk()) {
+      return err;
+    }
+    {
+      std::lock_guard<std::mutex> lk(hedge_mtx_);
+      hedge_timers_.emplace(
+          std::chrono::steady_clock::now() + hedge_delay_, hedge);
+    }
+    hedge_cv_.notify_one();
+    return Error::Success;
+  }
+
+  /// Hedge the asynchronous inferences: a request without a response after
+  /// a delay is sent again to the least loaded other server, and the first
+  /// response is passed to the callback. The other request can't be
+  /// cancelled through the clients, so it runs to completion and its
+  /// response is dropped. An HTTP client may still read the input data of
+  /// that request after the callback, the data must then be overwritten
+  /// rather than freed until the pool is idle. Must be called before the
+  /// pool is used, and only takes effect with two servers or more.
+  /// \param delay_us The delay before hedging a request, in microseconds.
+  /// \param latency_quantile If in (0, 1), the delay follows that quantile
+  /// of the latency of the recent requests instead, 'delay_us' being used
+  /// until enough requests have completed. For example 0.95 hedges about
+  /// one request in twenty.
+  void EnableHedging(const uint64_t delay_us, const double latency_quantile = 0)
+  {
+    hedging_ = true;
+    hedge_delay_ = std::chrono::microseconds(delay_us);
+    latency_quantile_ = latency_quantile;
+    hedge_worker_ = std::thread(&InferenceServerPool::HedgeLoop, this);
+  }
+
+  /// Evict the failing servers: a server whose last 'failure_count'
+  /// requests failed, either to be sent or with an error result, is not
+  /// routed to for 'readmit_delay_us' microseconds, after which it is
+  /// admitted again. The requests are spread over all the servers when
+  /// they are all evicted. Must be called before the pool is used.
+  /// \param failure_count The number of consecutive failures evicting a
+  /// server, 0 to never evict.
+  /// \param readmit_delay_us The time a server stays evicted, in
+  /// microseconds.
+  void EnableEviction(
+      const size_t failure_count, const uint64_t readmit_delay_us)
+  {
+    eviction_failure_count_ = failure_count;
+    readmit_delay_ = std::chrono::microseconds(readmit_delay_us);
+  }
+
+  /// \param server The index of the server.
+  /// \return Whether the server is evicted, see EnableEviction().
+  bool Evicted(const size_t server) const
+  {
+    return IsEvicted(*servers_[server], std::chrono::steady_clock::now());
+  }
+
+  /// \return The number of requests sent again to another server.
+  uint64_t HedgedCount() const
+  {
+    return hedged_count_.load(std::memory_order_relaxed);
+  }
+
+  /// \return The number of servers of the pool.
+  size_t ServerCount() const { return servers_.size(); }
+
+  /// \param server The index of the server, in the order of the URLs given
+  /// to Create().
+  /// \return The URL of the server.
+  const std::string& ServerUrl(const size_t server) const
+  {
+    return servers_[server]->url_;
+  }
+
+  /// \param server The index of the server.
+  /// \return The number of requests sent to the server that have not
+  /// completed.
+  size_t Outstanding(const size_t server) const
+  {
+    return servers_[server]->outstanding_.load(std::memory_order_relaxed);
+  }
+
+  /// \param server The index of the server.
+  /// \return The EWMA of the request latency of the server in
+  /// microseconds, 0 before the first request completes.
+  double EwmaLatencyUs(const size_t server) const
+  {
+    std::lock_guard<std::mutex> lk(servers_[server]->mtx_);
+    return servers_[server]->ewma_latency_us_;
+  }
+
+  /// Give access to a connection to a server, for example to load models
+  /// or register shared memory on every server. The connection must not be
+  /// used for synchronous inferences while the pool is in use.
+  /// \param server The index of the server.
+  /// \param connection The index of the connection to the server.
+  /// \return The client of the connection.
+  Client* Connection(const size_t server, const size_t connection = 0)
+  {
+    return servers_[server]->clients_[connection].get();
+  }
+
+ private:
+  struct Server {
+    explicit Server(const std::string& url)
+        : url_(url), outstanding_(0), next_connection_(0)
+    {
+    }
+
+    // Take an idle connection, waiting for one when all connections are
+    // running a synchronous inference.
+    size_t Acquire()
+    {
+      std::unique_lock<std::mutex> lk(mtx_);
+      idle_cv_.wait(lk, [this]() { return !idle_.empty(); });
+      const size_t connection = idle_.back();
+      idle_.pop_back();
+      return connection;
+    }
+
+    void Release(const size_t connection)
+    {
+      {
+        std::lock_guard<std::mutex> lk(mtx_);
+        idle_.push_back(connection);
+      }
+      idle_cv_.notify_one();
+    }
+
+    const std::string url_;
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::atomic<size_t> outstanding_;
+    std::atomic<size_t> next_connection_;
+
+    // Protects the members below.
+    mutable std::mutex mtx_;
+    std::condition_variable idle_cv_;
+    std::vector<size_t> idle_;
+    double ewma_latency_us_{0};
+    // The number of requests that failed in a row, and until when the
+    // server is evicted.
+    size_t consecutive_failures_{0};
+    std::chrono::steady_clock::time_point evicted_until_;
+  };
+
+  // An asynchronous inference that may be sent to a second server.
+  struct Hedge {
+    explicit Hedge(InferenceServerClient::OnCompleteFn&& callback)
+        : callback_(std::move(callback)), done_(false)
+    {
+    }
+
+    // Pass the first response to the callback and drop the other one.
+    void Finish(InferResult* result)
+    {
+      {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (done_) {
+          delete result;
+          return;
+        }
+        done_ = true;
+      }
+      callback_(result);
+    }
+
+    InferenceServerClient::OnCompleteFn callback_;
+    // Sends the request to a server with the given completion callback.
+    std::function<Error(Server*, InferenceServerClient::OnCompleteFn)> send_;
+    Server* primary_;
+    // Held while the hedge is sent so that the callback, which may free
+    // the inputs, only runs once the second request has read them.
+    std::mutex mtx_;
+    bool done_;
+  };
+
+  // The number of recent latencies the hedge delay is computed from, and
+  // the number of completions between two computations.
+  static constexpr size_t kLatencyWindow = 1024;
+  static constexpr size_t kDelayUpdateInterval = 64;
+
+  InferenceServerPool(const RoutingPolicy policy, const double ewma_weight)
+      : policy_(policy), ewma_weight_(ewma_weight),
+        eviction_failure_count_(0), readmit_delay_(0), hedging_(false),
+        latency_quantile_(0), hedged_count_(0), hedge_delay_(0),
+        completed_count_(0), exiting_(false)
+  {
+  }
+
+  template <typename... Args>
+  Error Send(
+      Server* server, InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      Args&&... args)
+  {
+    const size_t connection =
+        server->next_connection_.fetch_add(1, std::memory_order_relaxed) %
+        server->clients_.size();
+    const auto start = std::chrono::steady_clock::now();
+    Error err = server->clients_[connection]->AsyncInfer(
+        [this, server, start, callback](InferResult* result) {
+          Complete(
+              server, start,
+              (result != nullptr) && result->RequestStatus().IsOk());
+          callback(result);
+        },
+        options, inputs, std::forward<Args>(args)...);
+    if (!err.IsOk()) {
+      server->outstanding_.fetch_sub(1, std::memory_order_relaxed);
+      RecordOutcome(server, false, std::chrono::steady_clock::now());
+    }
+    return err;
+  }
+
+  // The loop of 'hedge_worker_', sending the hedges once their delay
+  // expires.
+  void HedgeLoop()
+  {
+    std::unique_lock<std::mutex> lk(hedge_mtx_);
+    while (!exiting_) {
+      if (hedge_timers_.empty()) {
+        hedge_cv_.wait(lk);
+        continue;
+      }
+      const auto deadline = hedge_timers_.begin()->first;
+      if (std::chrono::steady_clock::now() < deadline) {
+        hedge_cv_.wait_until(lk, deadline);
+        continue;
+      }
+      std::shared_ptr<Hedge> hedge = std::move(hedge_timers_.begin()->second);
+      hedge_timers_.erase(hedge_timers_.begin());
+      lk.unlock();
+      std::lock_guard<std::mutex> hedge_lk(hedge->mtx_);
+      if (!hedge->done_) {
+        Server* server = LeastLoaded(hedge->primary_);
+        server->outstanding_.fetch_add(1, std::memory_order_relaxed);
+        hedged_count_.fetch_add(1, std::memory_order_relaxed);
+        // A failure to send leaves the request to the first server.
+        hedge->send_(server, [hedge](InferResult* result) {
+          hedge->Finish(result);
+        });
+      }
+      lk.lock();
+    }
+  }
+
+  // The least loaded server other than 'excluded', evicted servers only
+  // being used when all the others are.
+  Server* LeastLoaded(const Server* excluded) const
+  {
+    const auto now = std::chrono::steady_clock::now();
+    Server* least = nullptr;
+    double least_load = 0;
+    bool least_evicted = true;
+    for (const auto& server : servers_) {
+      if (server.get() == excluded) {
+        continue;
+      }
+      const bool evicted = IsEvicted(*server, now);
+      const double load = Load(*server);
+      if ((least == nullptr) || (least_evicted && !evicted) ||
+          ((least_evicted == evicted) && (load < least_load))) {
+        least = server.get();
+        least_load = load;
+        least_evicted = evicted;
+      }
+    }
+    return least;
+  }
+
+  bool IsEvicted(
+      const Server& server,
+      const std::chrono::steady_clock::time_point& now) const
+  {
+    if (eviction_failure_count_ == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lk(server.mtx_);
+    return now < server.evicted_until_;
+  }
+
+  // Count a request of 'server' that succeeded or failed, evicting the
+  // server after 'eviction_failure_count_' failures in a row.
+  void RecordOutcome(
+      Server* server, const bool ok,
+      const std::chrono::steady_clock::time_point& now)
+  {
+    if (eviction_failure_count_ == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lk(server->mtx_);
+    if (ok) {
+      server->consecutive_failures_ = 0;
+    } else if (++server->consecutive_failures_ >= eviction_failure_count_) {
+      server->consecutive_failures_ = 0;
+      server->evicted_until_ = now + readmit_delay_;
+    }
+  }
+
+  double Load(const Server& server) const
+  {
+    const double outstanding = static_cast<double>(
+        server.outstanding_.load(std::memory_order_relaxed));
+    if (policy_ == RoutingPolicy::LEAST_OUTSTANDING) {
+      return outstanding;
+    }
+    std::lock_guard<std::mutex> lk(server.mtx_);
+    return server.ewma_latency_us_ * (outstanding + 1);
+  }
+
+  // Pick the less loaded of two distinct servers drawn at random among the
+  // servers not evicted, and count the request as outstanding on it.
+  Server* Route()
+  {
+    std::vector<Server*> admitted;
+    if (eviction_failure_count_ > 0) {
+      const auto now = std::chrono::steady_clock::now();
+      for (const auto& server : servers_) {
+        if (!IsEvicted(*server, now)) {
+          admitted.push_back(server.get());
+        }
+      }
+    }
+    const size_t count = admitted.empty() ? servers_.size() : admitted.size();
+    auto candidate = [this, &admitted](const size_t i) {
+      return admitted.empty() ? servers_[i].get() : admitted[i];
+    };
+
+    Server* server = candidate(0);
+    if (count > 1) {
+      static thread_local std::minstd_rand rng(std::random_device{}());
+      std::uniform_int_distribution<size_t> first_dist(0, count - 1);
+      std::uniform_int_distribution<size_t> second_dist(0, count - 2);
+      const size_t first = first_dist(rng);
+      size_t second = second_dist(rng);
+      if (second >= first) {
+        second++;
+      }
+      server = candidate(first);
+      if (Load(*candidate(second)) < Load(*server)) {
+        server = candidate(second);
+      }
+    }
+    server->outstanding_.fetch_add(1, std::memory_order_relaxed);
+    return server;
+  }
+
+  void Complete(
+      Server* server, const std::chrono::steady_clock::time_point& start,
+      const bool ok)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const double latency_us =
+        std::chrono::duration<double, std::micro>(now - start).count();
+    RecordOutcome(server, ok, now);
+    {
+      std::lock_guard<std::mutex> lk(server->mtx_);
+      server->ewma_latency_us_ =
+          (server->ewma_latency_us_ == 0)
+              ? latency_us
+              : (ewma_weight_ * latency_us +
+                 (1 - ewma_weight_) * server->ewma_latency_us_);
+    }
+    server->outstanding_.fetch_sub(1, std::memory_order_relaxed);
+    if (hedging_ && (latency_quantile_ > 0) && (latency_quantile_ < 1)) {
+      UpdateHedgeDelay(latency_us);
+    }
+  }
+
+  // Record the latency of a completed request and, every
+  // 'kDelayUpdateInterval' completions once the window is full, set the
+  // hedge delay to the quantile of the latencies in the window.
+  void UpdateHedgeDelay(const double latency_us)
+  {
+    std::lock_guard<std::mutex> lk(hedge_mtx_);
+    const size_t count = completed_count_++;
+    if (latencies_us_.size() < kLatencyWindow) {
+      latencies_us_.push_back(latency_us);
+    } else {
+      latencies_us_[count % kLatencyWindow] = latency_us;
+    }
+    if ((latencies_us_.size() == kLatencyWindow) &&
+        ((count % kDelayUpdateInterval) == 0)) {
+      std::vector<double> sorted(latencies_us_);
+      const size_t index =
+          static_cast<size_t>(latency_quantile_ * (sorted.size() - 1));
+      std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+      hedge_delay_ = std::chrono::microseconds(
+          static_cast<std::chrono::microseconds::rep>(sorted[index]));
+    }
+  }
+
+  const RoutingPolicy policy_;
+  const double ewma_weight_;
+  std::vector<std::unique_ptr<Server>> servers_;
+
+  size_t eviction_failure_count_;
+  std::chrono::microseconds readmit_delay_;
+
+  bool hedging_;
+  double latency_quantile_;
+  std::atomic<uint64_t> hedged_count_;
+  std::thread hedge_worker_;
+  // Protects the members below.
+  std::mutex hedge_mtx_;
+  std::condition_variable hedge_cv_;
+  std::multimap<std::chrono::steady_clock::time_point, std::shared_ptr<Hedge>>
+      hedge_timers_;
+  std::chrono::microseconds hedge_delay_;
+  std::vector<double> latencies_us_;
+  size_t completed_count_;
+  bool exiting_;
+};
+
+}}  // namespace triton::client
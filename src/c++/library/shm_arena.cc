@@ -0,0 +1,146 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "shm_arena.h"
+
+#include <limits>
+
+namespace triton { namespace client {
+
+namespace {
+
+constexpr size_t kSliceAlignment = 64;
+constexpr uint32_t kNoSlice = std::numeric_limits<uint32_t>::max();
+
+uint64_t
+PackHead(const uint64_t head, const uint32_t index)
+{
+  return (((head >> 32) + 1) << 32) | index;
+}
+
+}  // namespace
+
+SharedMemoryArena::SharedMemoryArena(
+    const std::string& name, const std::string& key,
+    const size_t slice_byte_size, const size_t slice_count)
+    : name_(name), key_(key),
+      slice_byte_size_(
+          (slice_byte_size + kSliceAlignment - 1) / kSliceAlignment *
+          kSliceAlignment),
+      slice_count_(slice_count), byte_size_(slice_byte_size_ * slice_count),
+      free_head_(0), next_free_(new std::atomic<uint32_t>[slice_count])
+{
+  for (size_t i = 0; i < slice_count_; ++i) {
+    next_free_[i].store(
+        (i + 1 < slice_count_) ? (i + 1) : kNoSlice,
+        std::memory_order_relaxed);
+  }
+}
+
+SharedMemoryArena::~SharedMemoryArena()
+{
+  if (base_addr_ != nullptr) {
+    UnmapSharedMemory(base_addr_, byte_size_);
+  }
+  if (shm_fd_ != -1) {
+    CloseSharedMemory(shm_fd_);
+    UnlinkSharedMemoryRegion(key_);
+  }
+}
+
+Error
+SharedMemoryArena::Create(
+    std::unique_ptr<SharedMemoryArena>* arena, const std::string& name,
+    const std::string& key, const size_t slice_byte_size,
+    const size_t slice_count, const SharedMemoryOptions& options)
+{
+  if ((slice_byte_size == 0) || (slice_count == 0) ||
+      (slice_count >= kNoSlice)) {
+    return Error(
+        "invalid slice size or count for shared memory arena '" + name + "'");
+  }
+
+  std::unique_ptr<SharedMemoryArena> new_arena(
+      new SharedMemoryArena(name, key, slice_byte_size, slice_count));
+  Error err = CreateSharedMemoryRegion(
+      key, new_arena->byte_size_, &new_arena->shm_fd_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  err = MapSharedMemory(
+      new_arena->shm_fd_, 0, new_arena->byte_size_, options,
+      &new_arena->base_addr_);
+  if (!err.IsOk()) {
+    new_arena->base_addr_ = nullptr;
+    return err;
+  }
+
+  *arena = std::move(new_arena);
+  return Error::Success;
+}
+
+Error
+SharedMemoryArena::Allocate(const size_t byte_size, Slice* slice)
+{
+  if (byte_size > slice_byte_size_) {
+    return Error(
+        "unable to allocate " + std::to_string(byte_size) +
+        " bytes from shared memory arena '" + name_ + "' of " +
+        std::to_string(slice_byte_size_) + "-byte slices");
+  }
+
+  uint64_t head = free_head_.load(std::memory_order_acquire);
+  while (true) {
+    const uint32_t index = static_cast<uint32_t>(head);
+    if (index == kNoSlice) {
+      return Error("no free slice in shared memory arena '" + name_ + "'");
+    }
+    const uint32_t next = next_free_[index].load(std::memory_order_relaxed);
+    if (free_head_.compare_exchange_weak(
+            head, PackHead(head, next), std::memory_order_acquire,
+            std::memory_order_acquire)) {
+      slice->offset = index * slice_byte_size_;
+      slice->byte_size = byte_size;
+      slice->addr = reinterpret_cast<uint8_t*>(base_addr_) + slice->offset;
+      return Error::Success;
+    }
+  }
+}
+
+void
+SharedMemoryArena::Release(const Slice& slice)
+{
+  const uint32_t index = slice.offset / slice_byte_size_;
+  uint64_t head = free_head_.load(std::memory_order_relaxed);
+  do {
+    next_free_[index].store(
+        static_cast<uint32_t>(head), std::memory_order_relaxed);
+  } while (!free_head_.compare_exchange_weak(
+      head, PackHead(head, index), std::memory_order_release,
+      std::memory_order_relaxed));
+}
+
+}}  // namespace triton::client
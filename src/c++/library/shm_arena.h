@@ -0,0 +1,175 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "common.h"
+#include "shm_utils.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A SharedMemoryArena owns one system shared memory region, registered with
+/// the server once, and hands out fixed-size slices of it to the inputs and
+/// outputs of requests. Slices are taken from and given back to a lock-free
+/// free list, so that concurrent requests can share the arena without
+/// registering a region each.
+///
+/// \code
+///   std::unique_ptr<SharedMemoryArena> arena;
+///   SharedMemoryArena::Create(&arena, "arena", "/arena", 1 << 20, 64);
+///   arena->Register(client);
+///   SharedMemoryArena::Slice slice;
+///   arena->Allocate(input_byte_size, &slice);
+///   memcpy(slice.addr, input_data, input_byte_size);
+///   arena->SetSharedMemory(input, slice);
+///   ...
+///   arena->Release(slice);
+/// \endcode
+///
+class SharedMemoryArena {
+ public:
+  /// A slice of the region of the arena.
+  struct Slice {
+    // The offset of the slice from the start of the region
+    size_t offset{0};
+    // The size in bytes asked for the slice
+    size_t byte_size{0};
+    // The address of the slice in this process
+    void* addr{nullptr};
+  };
+
+  /// Unmaps and destroys the region. The region must be unregistered from
+  /// the server beforehand.
+  ~SharedMemoryArena();
+
+  /// Create an arena and its shared memory region.
+  /// \param arena Returns the new arena.
+  /// \param name The name to register the region with.
+  /// \param key The key of the shared memory region.
+  /// \param slice_byte_size The size in bytes of each slice. It is rounded up
+  /// to a multiple of 64 bytes so that slices do not share cache lines.
+  /// \param slice_count The number of slices of the arena.
+  /// \param options The placement of the pages of the region.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<SharedMemoryArena>* arena, const std::string& name,
+      const std::string& key, const size_t slice_byte_size,
+      const size_t slice_count,
+      const SharedMemoryOptions& options = SharedMemoryOptions());
+
+  /// Register the region of the arena with the server.
+  /// \param client The InferenceServerHttpClient or
+  /// InferenceServerGrpcClient to register the region with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Register(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->RegisterSystemSharedMemory(
+        name_, key_, byte_size_, 0 /* offset */, headers);
+  }
+
+  /// Unregister the region of the arena from the server.
+  /// \param client The client the region was registered with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Unregister(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->UnregisterSystemSharedMemory(name_, headers);
+  }
+
+  /// Take a free slice of the arena. Does not wait for a slice to be
+  /// released when none is free.
+  /// \param byte_size The size in bytes needed, which must not be larger
+  /// than the slice size of the arena.
+  /// \param slice Returns the slice.
+  /// \return Error object indicating success or failure.
+  Error Allocate(const size_t byte_size, Slice* slice);
+
+  /// Give a slice back to the arena, once the requests using it have
+  /// completed.
+  /// \param slice The slice returned by Allocate().
+  void Release(const Slice& slice);
+
+  /// Set the values of an input to be read from a slice.
+  /// \param input The input to set.
+  /// \param slice The slice holding the values of the input.
+  /// \return Error object indicating success or failure.
+  Error SetSharedMemory(InferInput* input, const Slice& slice) const
+  {
+    return input->SetSharedMemory(name_, slice.byte_size, slice.offset);
+  }
+
+  /// Set an output to be written to a slice.
+  /// \param output The output to set.
+  /// \param slice The slice to write the output to.
+  /// \return Error object indicating success or failure.
+  Error SetSharedMemory(InferRequestedOutput* output, const Slice& slice) const
+  {
+    return output->SetSharedMemory(name_, slice.byte_size, slice.offset);
+  }
+
+  /// \return The name the region is registered with.
+  const std::string& Name() const { return name_; }
+
+  /// \return The size in bytes of each slice.
+  size_t SliceByteSize() const { return slice_byte_size_; }
+
+  /// \return The number of slices of the arena.
+  size_t SliceCount() const { return slice_count_; }
+
+ private:
+  SharedMemoryArena(
+      const std::string& name, const std::string& key,
+      const size_t slice_byte_size, const size_t slice_count);
+
+  const std::string name_;
+  const std::string key_;
+  const size_t slice_byte_size_;
+  const size_t slice_count_;
+  const size_t byte_size_;
+  int shm_fd_{-1};
+  void* base_addr_{nullptr};
+
+  // The free list is a stack of slice indices. Its head packs the index of
+  // the top slice in the low 32 bits with a count of the changes to the head
+  // in the high 32 bits, so that a slice taken and given back between the
+  // read and the update of the head by another thread is detected.
+  std::atomic<uint64_t> free_head_;
+  std::unique_ptr<std::atomic<uint32_t>[]> next_free_;
+};
+
+}}  // namespace triton::client
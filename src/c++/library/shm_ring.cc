@@ -0,0 +1,187 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "shm_ring.h"
+
+#include <cstring>
+
+namespace triton { namespace client {
+
+namespace {
+
+// The inputs start on a cache line of their own
+constexpr size_t kInputAlignment = 64;
+
+size_t
+AlignInput(const size_t byte_size)
+{
+  return (byte_size + kInputAlignment - 1) / kInputAlignment *
+         kInputAlignment;
+}
+
+}  // namespace
+
+SharedMemoryRing::SharedMemoryRing(
+    const std::string& name, const std::string& key, const size_t byte_size)
+    : name_(name), key_(key), byte_size_(byte_size)
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+  if (base_addr_ != nullptr) {
+    UnmapSharedMemory(base_addr_, byte_size_);
+  }
+  if (shm_fd_ != -1) {
+    CloseSharedMemory(shm_fd_);
+    UnlinkSharedMemoryRegion(key_);
+  }
+}
+
+Error
+SharedMemoryRing::Create(
+    std::unique_ptr<SharedMemoryRing>* ring, const std::string& name,
+    const std::string& key, const size_t byte_size,
+    const SharedMemoryOptions& options)
+{
+  if ((byte_size == 0) || ((byte_size % kInputAlignment) != 0)) {
+    return Error(
+        "the size of shared memory ring '" + name +
+        "' must be a multiple of " + std::to_string(kInputAlignment) +
+        " bytes");
+  }
+
+  std::unique_ptr<SharedMemoryRing> new_ring(
+      new SharedMemoryRing(name, key, byte_size));
+  Error err = CreateSharedMemoryRegion(key, byte_size, &new_ring->shm_fd_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  err = MapSharedMemory(
+      new_ring->shm_fd_, 0, byte_size, options, &new_ring->base_addr_);
+  if (!err.IsOk()) {
+    new_ring->base_addr_ = nullptr;
+    return err;
+  }
+
+  *ring = std::move(new_ring);
+  return Error::Success;
+}
+
+Error
+SharedMemoryRing::Stage(const std::vector<InferInput*>& inputs, Lease* lease)
+{
+  // Size the inputs that have raw data
+  std::vector<size_t> input_byte_sizes;
+  size_t total_byte_size = 0;
+  for (InferInput* input : inputs) {
+    size_t input_byte_size = 0;
+    const uint8_t* buf;
+    size_t buf_byte_size;
+    bool end_of_input = false;
+    input->PrepareForRequest();
+    while (!end_of_input) {
+      input->GetNext(&buf, &buf_byte_size, &end_of_input);
+      input_byte_size += buf_byte_size;
+    }
+    input_byte_sizes.push_back(input_byte_size);
+    total_byte_size += AlignInput(input_byte_size);
+  }
+  if (total_byte_size > byte_size_) {
+    return Error(
+        "the inputs of " + std::to_string(total_byte_size) +
+        " bytes do not fit in shared memory ring '" + name_ + "' of " +
+        std::to_string(byte_size_) + " bytes");
+  }
+
+  if (total_byte_size == 0) {
+    *lease = Lease();
+    return Error::Success;
+  }
+
+  // Take the next bytes of the ring, skipping the end of the region when
+  // the inputs do not fit before it.
+  uint64_t start;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      const size_t head_offset = head_ % byte_size_;
+      start = head_;
+      if (head_offset + total_byte_size > byte_size_) {
+        start += byte_size_ - head_offset;
+      }
+      if (start + total_byte_size - tail_ <= byte_size_) {
+        break;
+      }
+      released_cv_.wait(lock);
+    }
+    lease->start = head_;
+    lease->end = start + total_byte_size;
+    head_ = lease->end;
+  }
+
+  size_t offset = start % byte_size_;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (input_byte_sizes[i] == 0) {
+      continue;
+    }
+    InferInput* input = inputs[i];
+    size_t copied_byte_size;
+    bool end_of_input;
+    input->PrepareForRequest();
+    input->GetNext(
+        reinterpret_cast<uint8_t*>(base_addr_) + offset, input_byte_sizes[i],
+        &copied_byte_size, &end_of_input);
+    input->SetSharedMemory(name_, input_byte_sizes[i], offset);
+    offset += AlignInput(input_byte_sizes[i]);
+  }
+
+  return Error::Success;
+}
+
+void
+SharedMemoryRing::Release(const Lease& lease)
+{
+  if (lease.start == lease.end) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (lease.start != tail_) {
+      released_.emplace(lease.start, lease.end);
+      return;
+    }
+    tail_ = lease.end;
+    for (auto it = released_.begin();
+         (it != released_.end()) && (it->first == tail_);
+         it = released_.erase(it)) {
+      tail_ = it->second;
+    }
+  }
+  released_cv_.notify_all();
+}
+
+}}  // namespace triton::client
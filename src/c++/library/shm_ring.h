@@ -0,0 +1,191 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "shm_utils.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// A SharedMemoryRing sends the raw inputs of requests through one system
+/// shared memory region, registered with the server once. Each request
+/// copies its inputs to the next free bytes of the ring and references them
+/// by region and offset, so only the request header goes over the network.
+/// The bytes are given back when the response arrives, and the space of
+/// the oldest requests is reused first.
+///
+/// \code
+///   std::unique_ptr<SharedMemoryRing> ring;
+///   SharedMemoryRing::Create(&ring, "ring", "/ring", 64 << 20);
+///   ring->Register(client);
+///   ring->AsyncInfer(client, callback, options, inputs, outputs);
+/// \endcode
+///
+class SharedMemoryRing {
+ public:
+  /// The bytes of the ring held by one request.
+  struct Lease {
+    uint64_t start{0};
+    uint64_t end{0};
+  };
+
+  /// Unmaps and destroys the region. The region must be unregistered from
+  /// the server beforehand.
+  ~SharedMemoryRing();
+
+  /// Create a ring and its shared memory region.
+  /// \param ring Returns the new ring.
+  /// \param name The name to register the region with.
+  /// \param key The key of the shared memory region.
+  /// \param byte_size The size in bytes of the ring. Must hold the inputs
+  /// of the largest request.
+  /// \param options The placement of the pages of the region.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<SharedMemoryRing>* ring, const std::string& name,
+      const std::string& key, const size_t byte_size,
+      const SharedMemoryOptions& options = SharedMemoryOptions());
+
+  /// Register the region of the ring with the server.
+  /// \param client The InferenceServerHttpClient or
+  /// InferenceServerGrpcClient to register the region with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Register(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->RegisterSystemSharedMemory(
+        name_, key_, byte_size_, 0 /* offset */, headers);
+  }
+
+  /// Unregister the region of the ring from the server.
+  /// \param client The client the region was registered with.
+  /// \param headers Optional map specifying additional HTTP headers to
+  /// include in the request.
+  /// \return Error object indicating success or failure.
+  template <typename Client>
+  Error Unregister(
+      Client* client, const std::map<std::string, std::string>& headers = {})
+  {
+    return client->UnregisterSystemSharedMemory(name_, headers);
+  }
+
+  /// Copy the raw data of the inputs to the ring and make the inputs refer
+  /// to their copy. Inputs without raw data, such as inputs already in
+  /// shared memory, are left as they are. Waits for earlier requests to
+  /// give back their bytes when the ring is full.
+  /// \param inputs The inputs of the request.
+  /// \param lease Returns the bytes held by the request, to give back with
+  /// Release() once its response has arrived.
+  /// \return Error object indicating success or failure.
+  Error Stage(const std::vector<InferInput*>& inputs, Lease* lease);
+
+  /// Give back the bytes held by a request.
+  /// \param lease The lease returned by Stage().
+  void Release(const Lease& lease);
+
+  /// Run a synchronous inference through the ring. Takes the arguments of
+  /// the Infer() function of the client after the result.
+  /// \return Error object indicating success or failure.
+  template <typename Client, typename... Args>
+  Error Infer(
+      Client* client, InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs, Args&&... args)
+  {
+    Lease lease;
+    Error err = Stage(inputs, &lease);
+    if (!err.IsOk()) {
+      return err;
+    }
+    err = client->Infer(result, options, inputs, std::forward<Args>(args)...);
+    Release(lease);
+    return err;
+  }
+
+  /// Run an asynchronous inference through the ring. The bytes of the
+  /// request are given back before the callback is called. Takes the
+  /// arguments of the AsyncInfer() function of the client after the
+  /// callback.
+  /// \return Error object indicating success or failure.
+  template <typename Client, typename... Args>
+  Error AsyncInfer(
+      Client* client, InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      Args&&... args)
+  {
+    Lease lease;
+    Error err = Stage(inputs, &lease);
+    if (!err.IsOk()) {
+      return err;
+    }
+    err = client->AsyncInfer(
+        [this, lease, callback](InferResult* result) {
+          Release(lease);
+          callback(result);
+        },
+        options, inputs, std::forward<Args>(args)...);
+    if (!err.IsOk()) {
+      Release(lease);
+    }
+    return err;
+  }
+
+  /// \return The name the region is registered with.
+  const std::string& Name() const { return name_; }
+
+ private:
+  SharedMemoryRing(
+      const std::string& name, const std::string& key,
+      const size_t byte_size);
+
+  const std::string name_;
+  const std::string key_;
+  const size_t byte_size_;
+  int shm_fd_{-1};
+  void* base_addr_{nullptr};
+
+  // The ring positions only grow, the offset in the region being the
+  // position modulo the size. 'head_' is the end of the last lease and
+  // 'tail_' the start of the oldest one not given back yet.
+  std::mutex mutex_;
+  std::condition_variable released_cv_;
+  uint64_t head_{0};
+  uint64_t tail_{0};
+  // The leases given back before an older one, by start
+  std::map<uint64_t, uint64_t> released_;
+};
+
+}}  // namespace triton::client
@@ -26,14 +26,60 @@
 
 #include "shm_utils.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace triton { namespace client {
 
+namespace {
+
+// From linux/mempolicy.h, which is not always installed
+constexpr int kMpolBind = 2;
+
+Error
+BindToNumaNode(void* addr, size_t byte_size, int node)
+{
+  constexpr size_t kBitsPerWord = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> node_mask(node / kBitsPerWord + 1, 0);
+  node_mask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  // The kernel drops the last bit of the mask size it is given
+  if (syscall(
+          SYS_mbind, addr, byte_size, kMpolBind, node_mask.data(),
+          node_mask.size() * kBitsPerWord + 1, 0) != 0) {
+    return Error(
+        "unable to bind shared memory region to NUMA node " +
+        std::to_string(node) + ": " + std::string(strerror(errno)));
+  }
+
+  return Error::Success;
+}
+
+void
+Prefault(void* addr, size_t byte_size)
+{
+#ifdef MADV_POPULATE_WRITE
+  if (madvise(addr, byte_size, MADV_POPULATE_WRITE) == 0) {
+    return;
+  }
+#endif
+  // Reading a page of a shared memory object allocates it, without changing
+  // the content other processes may have written.
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const volatile char* bytes = reinterpret_cast<const volatile char*>(addr);
+  for (size_t i = 0; i < byte_size; i += page_size) {
+    (void)bytes[i];
+  }
+}
+
+}  // namespace
+
 Error
 CreateSharedMemoryRegion(std::string shm_key, size_t byte_size, int* shm_fd)
 {
@@ -70,6 +116,48 @@ MapSharedMemory(int shm_fd, size_t offset, size_t byte_size, void** shm_addr)
   return Error::Success;
 }
 
+Error
+MapSharedMemory(
+    int shm_fd, size_t offset, size_t byte_size,
+    const SharedMemoryOptions& options, void** shm_addr)
+{
+  // The placement of the pages must be set before they are faulted in, so
+  // only let mmap populate the region when there is none to set.
+  const bool place_pages = options.huge_pages || (options.numa_node >= 0);
+  int flags = MAP_SHARED;
+  if (options.prefault && !place_pages) {
+    flags |= MAP_POPULATE;
+  }
+  *shm_addr =
+      mmap(NULL, byte_size, PROT_READ | PROT_WRITE, flags, shm_fd, offset);
+  if (*shm_addr == MAP_FAILED) {
+    return Error(
+        "unable to process address space or shared-memory descriptor: " +
+        std::to_string(shm_fd));
+  }
+
+  Error err;
+  if (options.huge_pages &&
+      (madvise(*shm_addr, byte_size, MADV_HUGEPAGE) != 0)) {
+    err = Error(
+        "unable to use huge pages for shared-memory descriptor " +
+        std::to_string(shm_fd) + ": " + std::string(strerror(errno)));
+  }
+  if (err.IsOk() && (options.numa_node >= 0)) {
+    err = BindToNumaNode(*shm_addr, byte_size, options.numa_node);
+  }
+  if (!err.IsOk()) {
+    munmap(*shm_addr, byte_size);
+    *shm_addr = nullptr;
+    return err;
+  }
+  if (options.prefault && place_pages) {
+    Prefault(*shm_addr, byte_size);
+  }
+
+  return Error::Success;
+}
+
 Error
 CloseSharedMemory(int shm_fd)
 {
@@ -29,6 +29,19 @@
 
 namespace triton { namespace client {
 
+// Options for mapping a system shared memory region, to avoid taking page
+// faults on the regions while requests are sent.
+struct SharedMemoryOptions {
+  // Back the region with transparent huge pages. Needs the shmem_enabled
+  // setting of transparent huge pages to be "advise" or "always".
+  bool huge_pages = false;
+  // Fault in all the pages of the region when it is mapped, instead of on
+  // first access.
+  bool prefault = false;
+  // The NUMA node to allocate the pages of the region from, if not negative.
+  int numa_node = -1;
+};
+
 // Create a shared memory region of the size 'byte_size' and return the unique
 // identifier.
 // \param shm_key The string identifier of the shared memory region
@@ -49,6 +62,21 @@ Error CreateSharedMemoryRegion(
 Error MapSharedMemory(
     int shm_fd, size_t offset, size_t byte_size, void** shm_addr);
 
+// Mmap the shared memory region with the given 'offset' and 'byte_size' and
+// return the base address of the region. The pages of the region are placed
+// according to 'options', which only apply to the pages not allocated yet.
+// \param shm_fd The int descriptor of the created shared memory region
+// \param offset The offset of the shared memory block from the start of the
+// shared memory region
+// \param byte_size The size in bytes of the shared memory region
+// \param options The options for the pages of the region
+// \param shm_addr Returns the base address of the shared memory region
+// \return error Returns an error if unable to mmap shared memory region or
+// to apply the options.
+Error MapSharedMemory(
+    int shm_fd, size_t offset, size_t byte_size,
+    const SharedMemoryOptions& options, void** shm_addr);
+
 // Close the shared memory descriptor.
 // \param shm_fd The int descriptor of the created shared memory region
 // \return error Returns an error if unable to close shared memory descriptor.
@@ -0,0 +1,195 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "tensor_convert.h"
+
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define TRITON_CLIENT_F16C_DISPATCH 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define TRITON_CLIENT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace triton { namespace client {
+
+namespace {
+
+uint32_t
+FloatBits(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float
+BitsFloat(uint32_t bits)
+{
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Rounds to nearest even with the FP32 addition instead of branching on the
+// exponent, as done by the FP16 library of Marat Dukhan, so that compilers
+// vectorize the loops calling it.
+uint16_t
+Fp32ToFp16(float value)
+{
+  // 2^112 and 2^-110 scale the values too large for FP16 to infinity
+  const float scale_to_inf = BitsFloat(0x77800000u);
+  const float scale_to_zero = BitsFloat(0x08800000u);
+  float base = (std::fabs(value) * scale_to_inf) * scale_to_zero;
+
+  const uint32_t w = FloatBits(value);
+  const uint32_t shl1_w = w + w;
+  const uint32_t sign = w & 0x80000000u;
+  uint32_t bias = shl1_w & 0xFF000000u;
+  bias = (bias < 0x71000000u) ? 0x71000000u : bias;
+
+  base = BitsFloat((bias >> 1) + 0x07800000u) + base;
+  const uint32_t bits = FloatBits(base);
+  const uint32_t exp_bits = (bits >> 13) & 0x00007C00u;
+  const uint32_t mantissa_bits = bits & 0x00000FFFu;
+  const uint32_t nonsign = exp_bits + mantissa_bits;
+  return static_cast<uint16_t>(
+      (sign >> 16) | ((shl1_w > 0xFF000000u) ? 0x7E00u : nonsign));
+}
+
+void
+ConvertFp32ToFp16Portable(const float* src, size_t count, uint16_t* dst)
+{
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = Fp32ToFp16(src[i]);
+  }
+}
+
+#ifdef TRITON_CLIENT_F16C_DISPATCH
+__attribute__((target("avx,f16c"))) void
+ConvertFp32ToFp16F16c(const float* src, size_t count, uint16_t* dst)
+{
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i half =
+        _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+  }
+  ConvertFp32ToFp16Portable(src + i, count - i, dst + i);
+}
+#endif  // TRITON_CLIENT_F16C_DISPATCH
+
+}  // namespace
+
+void
+ConvertFp32ToFp16(const float* src, size_t count, uint16_t* dst)
+{
+#if defined(TRITON_CLIENT_F16C_DISPATCH)
+  static const bool has_f16c =
+      __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+  if (has_f16c) {
+    ConvertFp32ToFp16F16c(src, count, dst);
+    return;
+  }
+#elif defined(TRITON_CLIENT_NEON)
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+  src += i;
+  dst += i;
+  count -= i;
+#endif
+  ConvertFp32ToFp16Portable(src, count, dst);
+}
+
+void
+ConvertFp32ToBf16(const float* src, size_t count, uint16_t* dst)
+{
+  // Integer rounding that compilers vectorize on every target
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t bits = FloatBits(src[i]);
+    const uint32_t rounded = (bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16;
+    const bool is_nan = (bits & 0x7FFFFFFFu) > 0x7F800000u;
+    dst[i] = static_cast<uint16_t>(is_nan ? ((bits >> 16) | 0x0040u) : rounded);
+  }
+}
+
+void
+QuantizeFp32ToInt8(
+    const float* src, size_t count, float scale, int32_t zero_point,
+    int8_t* dst)
+{
+  const float offset = static_cast<float>(zero_point);
+  size_t i = 0;
+#if defined(TRITON_CLIENT_F16C_DISPATCH) && defined(__SSE2__)
+  const __m128 scale4 = _mm_set1_ps(scale);
+  const __m128 offset4 = _mm_set1_ps(offset);
+  const __m128 max4 = _mm_set1_ps(127.0f);
+  for (; i + 16 <= count; i += 16) {
+    __m128i quantized[4];
+    for (size_t j = 0; j < 4; ++j) {
+      const __m128 value = _mm_add_ps(
+          _mm_div_ps(_mm_loadu_ps(src + i + 4 * j), scale4), offset4);
+      // Only the values above 127 need clamping, the values below -128 and
+      // NaNs convert to INT32_MIN, and the packing saturates
+      quantized[j] = _mm_cvtps_epi32(_mm_min_ps(max4, value));
+    }
+    const __m128i low = _mm_packs_epi32(quantized[0], quantized[1]);
+    const __m128i high = _mm_packs_epi32(quantized[2], quantized[3]);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(low, high));
+  }
+#elif defined(TRITON_CLIENT_NEON)
+  const float32x4_t scale4 = vdupq_n_f32(scale);
+  const float32x4_t offset4 = vdupq_n_f32(offset);
+  for (; i + 8 <= count; i += 8) {
+    const float32x4_t low =
+        vaddq_f32(vdivq_f32(vld1q_f32(src + i), scale4), offset4);
+    const float32x4_t high =
+        vaddq_f32(vdivq_f32(vld1q_f32(src + i + 4), scale4), offset4);
+    const int16x8_t narrowed = vcombine_s16(
+        vqmovn_s32(vcvtnq_s32_f32(low)), vqmovn_s32(vcvtnq_s32_f32(high)));
+    vst1_s8(dst + i, vqmovn_s16(narrowed));
+  }
+#endif
+  // Adding and subtracting 1.5 * 2^23 rounds the saturated values to
+  // nearest even without a call to nearbyint()
+  const float round_magic = 12582912.0f;
+  for (; i < count; ++i) {
+    float value = src[i] / scale + offset;
+    value = (value >= -128.0f) ? value : -128.0f;
+    value = (value <= 127.0f) ? value : 127.0f;
+    value = (value + round_magic) - round_magic;
+    dst[i] = static_cast<int8_t>(static_cast<int32_t>(value));
+  }
+}
+
+}}  // namespace triton::client
@@ -0,0 +1,74 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// Conversions of FP32 tensor data to the reduced precision datatypes, to
+/// send features computed in FP32 to models with FP16, BF16 or INT8 inputs
+/// at a fraction of the payload. They write into any buffer, such as the
+/// buffer of an input or a shared memory region, and use the F16C, SSE2 or
+/// NEON conversion instructions when the CPU has them.
+///
+/// \code
+///   std::vector<uint16_t> half(features.size());
+///   ConvertFp32ToFp16(features.data(), features.size(), half.data());
+///   input->AppendRaw(
+///       reinterpret_cast<const uint8_t*>(half.data()), half.size() * 2);
+/// \endcode
+///
+
+/// Converts FP32 values to IEEE half precision, rounding to nearest even.
+/// Values out of range become infinities, NaNs stay NaNs.
+/// \param src The values to convert.
+/// \param count The number of values.
+/// \param dst Returns the FP16 values, 'count' of them.
+void ConvertFp32ToFp16(const float* src, size_t count, uint16_t* dst);
+
+/// Converts FP32 values to bfloat16, rounding to nearest even. NaNs stay
+/// NaNs.
+/// \param src The values to convert.
+/// \param count The number of values.
+/// \param dst Returns the BF16 values, 'count' of them.
+void ConvertFp32ToBf16(const float* src, size_t count, uint16_t* dst);
+
+/// Quantizes FP32 values to INT8 as round(value / scale) + zero_point,
+/// rounding to nearest even and saturating to [-128, 127]. The value NaNs
+/// are quantized to is unspecified.
+/// \param src The values to quantize.
+/// \param count The number of values.
+/// \param scale The quantization scale, must not be 0.
+/// \param zero_point The quantized value of 0.
+/// \param dst Returns the INT8 values, 'count' of them.
+void QuantizeFp32ToInt8(
+    const float* src, size_t count, float scale, int32_t zero_point,
+    int8_t* dst);
+
+}}  // namespace triton::client
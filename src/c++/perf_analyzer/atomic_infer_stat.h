@@ -0,0 +1,136 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "client_backend/client_backend.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The client stats of all the contexts of a worker thread, kept in relaxed
+/// atomics so that the profiler sums them without blocking the thread or its
+/// callbacks. The contexts add what their stats grew by whenever they read
+/// them from their client backend.
+///
+/// The updates must be serialized, which the worker thread and its
+/// callbacks do by holding ThreadStat::mu_, so they are plain loads and
+/// stores rather than read-modify-writes. A concurrent read may see a
+/// request counted before its times, which is at most one request off.
+///
+class alignas(64) AtomicInferStat {
+ public:
+  /// Adds the difference between two stats of the same context.
+  /// \param previous The stats of the context when last added.
+  /// \param current The current stats of the context.
+  void Add(const cb::InferStat& previous, const cb::InferStat& current)
+  {
+    AddDelta(
+        completed_request_count_, previous.completed_request_count,
+        current.completed_request_count);
+    AddDelta(
+        cumulative_total_request_time_ns_,
+        previous.cumulative_total_request_time_ns,
+        current.cumulative_total_request_time_ns);
+    AddDelta(
+        cumulative_send_time_ns_, previous.cumulative_send_time_ns,
+        current.cumulative_send_time_ns);
+    AddDelta(
+        cumulative_receive_time_ns_, previous.cumulative_receive_time_ns,
+        current.cumulative_receive_time_ns);
+    AddDelta(
+        cumulative_first_byte_time_ns_, previous.cumulative_first_byte_time_ns,
+        current.cumulative_first_byte_time_ns);
+    AddDelta(
+        response_chunk_interval_count_, previous.response_chunk_interval_count,
+        current.response_chunk_interval_count);
+    AddDelta(
+        cumulative_response_chunk_interval_ns_,
+        previous.cumulative_response_chunk_interval_ns,
+        current.cumulative_response_chunk_interval_ns);
+    AddDelta(
+        cumulative_serialize_time_ns_, previous.cumulative_serialize_time_ns,
+        current.cumulative_serialize_time_ns);
+    AddDelta(
+        cumulative_send_queue_time_ns_, previous.cumulative_send_queue_time_ns,
+        current.cumulative_send_queue_time_ns);
+    AddDelta(
+        cumulative_deserialize_time_ns_,
+        previous.cumulative_deserialize_time_ns,
+        current.cumulative_deserialize_time_ns);
+  }
+
+  /// Adds the stats to 'stat'. May be called from any thread.
+  void AccumulateInto(cb::InferStat* stat) const
+  {
+    stat->completed_request_count += Load(completed_request_count_);
+    stat->cumulative_total_request_time_ns +=
+        Load(cumulative_total_request_time_ns_);
+    stat->cumulative_send_time_ns += Load(cumulative_send_time_ns_);
+    stat->cumulative_receive_time_ns += Load(cumulative_receive_time_ns_);
+    stat->cumulative_first_byte_time_ns +=
+        Load(cumulative_first_byte_time_ns_);
+    stat->response_chunk_interval_count +=
+        Load(response_chunk_interval_count_);
+    stat->cumulative_response_chunk_interval_ns +=
+        Load(cumulative_response_chunk_interval_ns_);
+    stat->cumulative_serialize_time_ns += Load(cumulative_serialize_time_ns_);
+    stat->cumulative_send_queue_time_ns +=
+        Load(cumulative_send_queue_time_ns_);
+    stat->cumulative_deserialize_time_ns +=
+        Load(cumulative_deserialize_time_ns_);
+  }
+
+ private:
+  static void AddDelta(
+      std::atomic<uint64_t>& counter, uint64_t previous, uint64_t current)
+  {
+    if (current != previous) {
+      counter.store(
+          counter.load(std::memory_order_relaxed) + (current - previous),
+          std::memory_order_relaxed);
+    }
+  }
+
+  static uint64_t Load(const std::atomic<uint64_t>& counter)
+  {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> completed_request_count_{0};
+  std::atomic<uint64_t> cumulative_total_request_time_ns_{0};
+  std::atomic<uint64_t> cumulative_send_time_ns_{0};
+  std::atomic<uint64_t> cumulative_receive_time_ns_{0};
+  std::atomic<uint64_t> cumulative_first_byte_time_ns_{0};
+  std::atomic<uint64_t> response_chunk_interval_count_{0};
+  std::atomic<uint64_t> cumulative_response_chunk_interval_ns_{0};
+  std::atomic<uint64_t> cumulative_serialize_time_ns_{0};
+  std::atomic<uint64_t> cumulative_send_queue_time_ns_{0};
+  std::atomic<uint64_t> cumulative_deserialize_time_ns_{0};
+};
+
+}}  // namespace triton::perfanalyzer
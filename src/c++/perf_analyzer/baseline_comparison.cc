@@ -0,0 +1,419 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "baseline_comparison.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "constants.h"
+#include "request_record_writer.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The resamples are drawn the same way on every run, so that comparing the
+// same results twice gives the same answer
+constexpr uint64_t BOOTSTRAP_SEED = 0x5eed;
+
+std::vector<std::string>
+Split(const std::string& s, char delimiter)
+{
+  std::vector<std::string> parts;
+  std::stringstream stream(s);
+  std::string part;
+  while (std::getline(stream, part, delimiter)) {
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+// The index of the load level, the number of levels if there is none
+size_t
+FindLevel(const std::vector<BaselineLevel>& levels, const double load_level)
+{
+  size_t i = 0;
+  for (; i < levels.size(); i++) {
+    if (std::abs(levels[i].load_level - load_level) <=
+        1e-9 * std::max(1.0, std::abs(load_level))) {
+      break;
+    }
+  }
+  return i;
+}
+
+cb::Error
+ReadRecordBaseline(const std::string& path, std::vector<BaselineLevel>* levels)
+{
+  std::vector<RequestRecordBlock> blocks;
+  RETURN_IF_ERROR(ReadRequestRecords(path, &blocks));
+  for (const auto& block : blocks) {
+    // Only the measurement windows have a throughput
+    if (block.infer_per_sec <= 0) {
+      continue;
+    }
+    const size_t i = FindLevel(*levels, block.load_level);
+    if (i == levels->size()) {
+      levels->emplace_back();
+      levels->back().load_level = block.load_level;
+    }
+    BaselineLevel& level = (*levels)[i];
+    level.window_infer_per_sec.push_back(block.infer_per_sec);
+    for (const uint64_t latency_ns : block.latency_ns) {
+      level.latency_histogram.Record(latency_ns);
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ReadCsvBaseline(const std::string& path, std::vector<BaselineLevel>* levels)
+{
+  std::ifstream report(path);
+  std::string line;
+  if (!std::getline(report, line)) {
+    return cb::Error("baseline file " + path + " is empty", pa::OPTION_ERROR);
+  }
+  const auto header = Split(line, ',');
+  const auto throughput_it =
+      std::find(header.begin(), header.end(), "Inferences/Second");
+  if (header.empty() ||
+      ((header[0] != "Concurrency") && (header[0] != "Request Rate")) ||
+      (throughput_it == header.end())) {
+    return cb::Error(
+        "baseline file " + path +
+            " is neither a CSV report nor a request record file",
+        pa::OPTION_ERROR);
+  }
+  const size_t throughput_idx = throughput_it - header.begin();
+  // The columns of the latency percentiles, in usec
+  std::map<size_t, size_t> percentile_idx;
+  for (size_t i = 0; i < header.size(); i++) {
+    const std::string& column = header[i];
+    const std::string suffix = " latency";
+    if ((column.size() > suffix.size() + 1) && (column[0] == 'p') &&
+        (column.compare(
+             column.size() - suffix.size(), suffix.size(), suffix) == 0)) {
+      const std::string percentile =
+          column.substr(1, column.size() - suffix.size() - 1);
+      if (percentile.find_first_not_of("0123456789") == std::string::npos) {
+        percentile_idx[std::stoul(percentile)] = i;
+      }
+    }
+  }
+
+  // The measurements end at the first empty line
+  while (std::getline(report, line) && !line.empty()) {
+    const auto fields = Split(line, ',');
+    if (fields.size() <= throughput_idx) {
+      break;
+    }
+    levels->emplace_back();
+    BaselineLevel& level = levels->back();
+    level.load_level = std::strtod(fields[0].c_str(), nullptr);
+    level.window_infer_per_sec.push_back(
+        std::strtod(fields[throughput_idx].c_str(), nullptr));
+    for (const auto& percentile : percentile_idx) {
+      if (percentile.second < fields.size()) {
+        level.percentile_latency_ns[percentile.first] =
+            std::strtoull(fields[percentile.second].c_str(), nullptr, 10) *
+            1000;
+      }
+    }
+  }
+  return cb::Error::Success;
+}
+
+// The value at the percentile of a resample of the buckets of a histogram
+uint64_t
+ValueAtPercentile(
+    const std::vector<std::pair<uint64_t, uint64_t>>& buckets,
+    const std::vector<uint64_t>& counts, const uint64_t total_count,
+    const double percentile)
+{
+  // The same nearest rank as LatencyHistogram::ValueAtPercentile()
+  const uint64_t rank =
+      static_cast<uint64_t>((percentile / 100.0) * (total_count - 1) + 0.5) +
+      1;
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    cumulative_count += counts[i];
+    if (cumulative_count >= rank) {
+      return buckets[i].first;
+    }
+  }
+  return buckets.back().first;
+}
+
+// Draws the percentiles of resamples of the recorded latencies, returns the
+// draws of each percentile
+std::map<size_t, std::vector<double>>
+BootstrapPercentiles(
+    const LatencyHistogram& histogram, const std::vector<size_t>& percentiles,
+    const size_t resample_count, std::mt19937_64& rng)
+{
+  std::map<size_t, std::vector<double>> draws;
+  const auto buckets = histogram.Buckets();
+  const uint64_t total_count = histogram.TotalCount();
+  std::vector<uint64_t> counts(buckets.size());
+  for (size_t r = 0; r < resample_count; r++) {
+    // A resample of the requests only changes the count of each bucket, which
+    // follows a multinomial distribution drawn as one binomial per bucket
+    uint64_t remaining_count = total_count;
+    uint64_t remaining_weight = total_count;
+    for (size_t i = 0; i < buckets.size(); i++) {
+      if (remaining_weight == buckets[i].second) {
+        counts[i] = remaining_count;
+      } else {
+        std::binomial_distribution<uint64_t> distribution(
+            remaining_count,
+            static_cast<double>(buckets[i].second) / remaining_weight);
+        counts[i] = distribution(rng);
+      }
+      remaining_count -= counts[i];
+      remaining_weight -= buckets[i].second;
+    }
+    for (const size_t percentile : percentiles) {
+      draws[percentile].push_back(
+          ValueAtPercentile(buckets, counts, total_count, percentile));
+    }
+  }
+  return draws;
+}
+
+// Draws the mean of resamples of the values
+std::vector<double>
+BootstrapMean(
+    const std::vector<double>& values, const size_t resample_count,
+    std::mt19937_64& rng)
+{
+  std::vector<double> draws;
+  std::uniform_int_distribution<size_t> pick(0, values.size() - 1);
+  for (size_t r = 0; r < resample_count; r++) {
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      sum += values[pick(rng)];
+    }
+    draws.push_back(sum / values.size());
+  }
+  return draws;
+}
+
+double
+Mean(const std::vector<double>& values)
+{
+  double sum = 0;
+  for (const double value : values) {
+    sum += value;
+  }
+  return values.empty() ? 0 : sum / values.size();
+}
+
+// Compares the metric given its point values and their bootstrap draws. A
+// single draw stands for an exact value.
+MetricComparison
+CompareMetric(
+    const std::string& name, const double baseline, const double current,
+    const std::vector<double>& baseline_draws,
+    const std::vector<double>& current_draws, const bool higher_is_better,
+    const double threshold)
+{
+  MetricComparison comparison;
+  comparison.name = name;
+  comparison.baseline = baseline;
+  comparison.current = current;
+  comparison.change = current / baseline - 1;
+
+  const size_t resample_count =
+      std::max(baseline_draws.size(), current_draws.size());
+  std::vector<double> changes;
+  for (size_t r = 0; r < resample_count; r++) {
+    const double baseline_draw =
+        baseline_draws[std::min(r, baseline_draws.size() - 1)];
+    const double current_draw =
+        current_draws[std::min(r, current_draws.size() - 1)];
+    if (baseline_draw > 0) {
+      changes.push_back(current_draw / baseline_draw - 1);
+    }
+  }
+  if (changes.empty()) {
+    changes.push_back(comparison.change);
+  }
+  std::sort(changes.begin(), changes.end());
+  comparison.change_low = changes[0.025 * (changes.size() - 1)];
+  comparison.change_high = changes[0.975 * (changes.size() - 1)];
+
+  comparison.regressed = higher_is_better
+                             ? (comparison.change_high < -threshold)
+                             : (comparison.change_low > threshold);
+  return comparison;
+}
+
+std::string
+FormatChange(const double change)
+{
+  std::stringstream ss;
+  ss << std::showpos << std::fixed << std::setprecision(1) << (change * 100)
+     << "%";
+  return ss.str();
+}
+
+}  // namespace
+
+cb::Error
+ReadBaseline(const std::string& path, std::vector<BaselineLevel>* levels)
+{
+  std::ifstream file(path, std::ifstream::binary);
+  if (!file.is_open()) {
+    return cb::Error("failed to open baseline file " + path, pa::OPTION_ERROR);
+  }
+  char magic[sizeof(RequestRecordWriter::kMagic)] = {};
+  file.read(magic, sizeof(magic));
+  file.close();
+
+  levels->clear();
+  if (std::memcmp(magic, RequestRecordWriter::kMagic, sizeof(magic)) == 0) {
+    RETURN_IF_ERROR(ReadRecordBaseline(path, levels));
+  } else {
+    RETURN_IF_ERROR(ReadCsvBaseline(path, levels));
+  }
+  if (levels->empty()) {
+    return cb::Error(
+        "baseline file " + path + " has no measurements", pa::OPTION_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+std::vector<LevelComparison>
+CompareWithBaseline(
+    const std::vector<BaselineLevel>& baseline,
+    const std::vector<PerfStatus>& statuses, const bool target_concurrency,
+    const double threshold, const size_t resample_count)
+{
+  std::vector<LevelComparison> comparisons;
+  for (const auto& status : statuses) {
+    comparisons.emplace_back();
+    LevelComparison& comparison = comparisons.back();
+    comparison.load_level =
+        target_concurrency ? status.concurrency : status.request_rate;
+    const size_t i = FindLevel(baseline, comparison.load_level);
+    if (i == baseline.size()) {
+      continue;
+    }
+    const BaselineLevel* level = &baseline[i];
+    comparison.has_baseline = true;
+    std::mt19937_64 rng(BOOTSTRAP_SEED);
+
+    const auto& stats = status.client_stats;
+    const double baseline_throughput = Mean(level->window_infer_per_sec);
+    if (baseline_throughput > 0) {
+      const std::vector<double> current_windows =
+          status.window_infer_per_sec.empty()
+              ? std::vector<double>{stats.infer_per_sec}
+              : status.window_infer_per_sec;
+      comparison.metrics.push_back(CompareMetric(
+          "throughput", baseline_throughput, stats.infer_per_sec,
+          BootstrapMean(level->window_infer_per_sec, resample_count, rng),
+          BootstrapMean(current_windows, resample_count, rng), true,
+          threshold));
+    }
+
+    std::vector<size_t> percentiles;
+    for (const auto& percentile : stats.percentile_latency_ns) {
+      if ((level->latency_histogram.TotalCount() != 0) ||
+          (level->percentile_latency_ns.count(percentile.first) != 0)) {
+        percentiles.push_back(percentile.first);
+      }
+    }
+    if (percentiles.empty() || (stats.latency_histogram.TotalCount() == 0)) {
+      continue;
+    }
+    std::map<size_t, std::vector<double>> baseline_draws;
+    if (level->latency_histogram.TotalCount() != 0) {
+      baseline_draws = BootstrapPercentiles(
+          level->latency_histogram, percentiles, resample_count, rng);
+    }
+    const auto current_draws = BootstrapPercentiles(
+        stats.latency_histogram, percentiles, resample_count, rng);
+    for (const size_t percentile : percentiles) {
+      double baseline_latency_ns = 0;
+      if (level->latency_histogram.TotalCount() != 0) {
+        baseline_latency_ns =
+            level->latency_histogram.ValueAtPercentile(percentile);
+      } else {
+        baseline_latency_ns = level->percentile_latency_ns.at(percentile);
+        baseline_draws[percentile] = {baseline_latency_ns};
+      }
+      if (baseline_latency_ns <= 0) {
+        continue;
+      }
+      comparison.metrics.push_back(CompareMetric(
+          "p" + std::to_string(percentile) + " latency", baseline_latency_ns,
+          stats.percentile_latency_ns.at(percentile),
+          baseline_draws[percentile], current_draws.at(percentile), false,
+          threshold));
+    }
+  }
+  return comparisons;
+}
+
+bool
+ReportBaselineComparison(
+    const std::vector<LevelComparison>& comparisons,
+    const bool target_concurrency, const double threshold, std::ostream& out)
+{
+  bool regressed = false;
+  out << "Comparison with the baseline (regression threshold "
+      << (threshold * 100) << "%):" << std::endl;
+  for (const auto& comparison : comparisons) {
+    out << "  " << (target_concurrency ? "Concurrency: " : "Request Rate: ")
+        << comparison.load_level << std::endl;
+    if (!comparison.has_baseline) {
+      out << "    No baseline measurement" << std::endl;
+      continue;
+    }
+    for (const auto& metric : comparison.metrics) {
+      const bool is_throughput = (metric.name == "throughput");
+      const double scale = is_throughput ? 1 : 1000;
+      out << "    " << metric.name << ": " << (metric.baseline / scale)
+          << " -> " << (metric.current / scale)
+          << (is_throughput ? " infer/sec, " : " usec, ")
+          << FormatChange(metric.change) << " (95% CI "
+          << FormatChange(metric.change_low) << " to "
+          << FormatChange(metric.change_high) << ")"
+          << (metric.regressed ? ", REGRESSION" : "") << std::endl;
+      regressed |= metric.regressed;
+    }
+  }
+  return regressed;
+}
+
+}}  // namespace triton::perfanalyzer
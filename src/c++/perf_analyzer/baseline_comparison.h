@@ -0,0 +1,112 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "inference_profiler.h"
+#include "latency_histogram.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The measurement of one load level in the run to compare against.
+struct BaselineLevel {
+  // The concurrency or request rate
+  double load_level{0.0};
+  // The throughput in infer/sec of each measurement window. A CSV report only
+  // has the throughput of the whole measurement.
+  std::vector<double> window_infer_per_sec;
+  // The latencies of the measured requests, empty for a CSV report
+  LatencyHistogram latency_histogram;
+  // The latencies in nsec at the percentiles of a CSV report
+  std::map<size_t, uint64_t> percentile_latency_ns;
+};
+
+/// The comparison of one metric at one load level with the baseline.
+struct MetricComparison {
+  // "throughput" or "pN latency"
+  std::string name;
+  // In infer/sec for the throughput, in nsec for the latencies
+  double baseline{0.0};
+  double current{0.0};
+  // The relative change from the baseline and its 95% confidence interval
+  double change{0.0};
+  double change_low{0.0};
+  double change_high{0.0};
+  // Whether the metric is worse than the baseline by more than the
+  // threshold over the whole confidence interval
+  bool regressed{false};
+};
+
+/// The comparison of one load level with the baseline.
+struct LevelComparison {
+  double load_level{0.0};
+  // False when the baseline has no measurement of the load level
+  bool has_baseline{false};
+  std::vector<MetricComparison> metrics;
+};
+
+/// Reads the results of a previous run, either the CSV report written with
+/// -f or a request record file written with --request-record-file. Only the
+/// measurement windows of a request record file are kept.
+/// \param path The path of the file.
+/// \param levels Returns the measurement of each load level of the file.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadBaseline(
+    const std::string& path, std::vector<BaselineLevel>* levels);
+
+/// Compares the throughput and latency percentiles of each load level with
+/// the baseline. Their confidence intervals are bootstrapped by resampling
+/// the measurement windows for the throughput and the latency histograms
+/// for the percentiles. The values of a CSV report are taken as exact.
+/// \param baseline The load levels of the baseline.
+/// \param statuses The results of the current run.
+/// \param target_concurrency Whether the load levels are concurrencies rather
+/// than request rates.
+/// \param threshold The relative worsening from which a metric regressed,
+/// e.g. 0.05 for 5%.
+/// \param resample_count The number of bootstrap resamples.
+/// \return The comparison of each load level of the current run.
+std::vector<LevelComparison> CompareWithBaseline(
+    const std::vector<BaselineLevel>& baseline,
+    const std::vector<PerfStatus>& statuses, const bool target_concurrency,
+    const double threshold, const size_t resample_count = 1000);
+
+/// Prints the comparisons with the baseline.
+/// \param comparisons The comparison of each load level.
+/// \param target_concurrency Whether the load levels are concurrencies.
+/// \param threshold The relative worsening from which a metric regressed.
+/// \param out The stream to print to.
+/// \return Whether any metric regressed.
+bool ReportBaselineComparison(
+    const std::vector<LevelComparison>& comparisons,
+    const bool target_concurrency, const double threshold, std::ostream& out);
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,324 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "capacity_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "inference_profiler.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The relative error of a prediction, capped so that a single load level
+// does not outweigh the others
+double
+RelativeError(const double predicted, const double measured)
+{
+  return std::min(std::abs(predicted - measured) / measured, 1.0);
+}
+
+// The grid the model is fitted over: the latency without queueing goes from
+// half the lowest latency measured up to it, and the saturation throughput
+// from the highest throughput measured up to a hundred times it, 1% apart.
+constexpr size_t kBaseLatencySteps = 25;
+constexpr double kSaturationGrowth = 1.01;
+constexpr double kMaxSaturationRatio = 100.0;
+
+// The deviation from Little's law that is reported
+constexpr double kLittlesLawTolerance = 0.1;
+
+}  // namespace
+
+CapacitySample
+ToCapacitySample(const PerfStatus& status, const bool target_concurrency)
+{
+  CapacitySample sample;
+  sample.load = target_concurrency ? static_cast<double>(status.concurrency)
+                                   : status.request_rate;
+  sample.throughput = status.client_stats.infer_per_sec /
+                      std::max<size_t>(status.batch_size, 1);
+  sample.latency_ns = status.client_stats.avg_latency_ns;
+  const ServerSideStats& server_stats = status.server_stats;
+  if (server_stats.queue_count != 0) {
+    sample.queue_ns = static_cast<double>(server_stats.queue_time_ns) /
+                      server_stats.queue_count;
+  }
+  if (server_stats.compute_infer_count != 0) {
+    sample.compute_ns = static_cast<double>(
+                            server_stats.compute_input_time_ns +
+                            server_stats.compute_infer_time_ns +
+                            server_stats.compute_output_time_ns) /
+                        server_stats.compute_infer_count;
+  }
+  return sample;
+}
+
+double
+LittlesLawDeviation(const CapacitySample& sample)
+{
+  if (sample.load == 0.0) {
+    return 0.0;
+  }
+  return (sample.throughput * sample.latency_ns / NANOS_PER_SECOND -
+          sample.load) /
+         sample.load;
+}
+
+cb::Error
+CapacityModel::Fit(
+    const std::vector<CapacitySample>& samples, const bool closed,
+    CapacityModel* model)
+{
+  std::vector<CapacitySample> measured;
+  for (const auto& sample : samples) {
+    if ((sample.load > 0.0) && (sample.throughput > 0.0) &&
+        (sample.latency_ns > 0.0)) {
+      measured.push_back(sample);
+    }
+  }
+  if (measured.size() < 2) {
+    return cb::Error(
+        "at least two load levels with completed requests are needed to fit "
+        "the capacity model",
+        pa::GENERIC_ERROR);
+  }
+  // The closed system is solved in order of concurrency
+  std::sort(
+      measured.begin(), measured.end(),
+      [](const CapacitySample& a, const CapacitySample& b) {
+        return a.load < b.load;
+      });
+
+  double max_throughput = 0.0;
+  double min_latency_ns = std::numeric_limits<double>::max();
+  for (const auto& sample : measured) {
+    max_throughput = std::max(max_throughput, sample.throughput);
+    min_latency_ns = std::min(min_latency_ns, sample.latency_ns);
+  }
+
+  CapacityModel candidate;
+  candidate.closed_ = closed;
+  double min_error = std::numeric_limits<double>::max();
+  for (size_t i = 0; i <= kBaseLatencySteps; i++) {
+    candidate.base_latency_ns_ =
+        min_latency_ns * (0.5 + 0.5 * i / kBaseLatencySteps);
+    for (double saturation = max_throughput * kSaturationGrowth;
+         saturation <= max_throughput * kMaxSaturationRatio;
+         saturation *= kSaturationGrowth) {
+      candidate.saturation_throughput_ = saturation;
+      const double error = candidate.SquaredError(measured);
+      if (error < min_error) {
+        min_error = error;
+        *model = candidate;
+      }
+    }
+  }
+  model->fit_error_ = std::sqrt(min_error / (2 * measured.size()));
+
+  // The compute time grows with the batches the server forms under load, so
+  // it is taken at the lowest load
+  for (const auto& sample : measured) {
+    if (sample.compute_ns > 0.0) {
+      model->service_time_ns_ = sample.compute_ns;
+      break;
+    }
+  }
+  return cb::Error::Success;
+}
+
+void
+CapacityModel::Predict(
+    double load, double* throughput, double* latency_ns) const
+{
+  // The single server of Seidmann's approximation and the delay around it
+  const double service_ns = NANOS_PER_SECOND / saturation_throughput_;
+  const double delay_ns = std::max(base_latency_ns_ - service_ns, 0.0);
+  if (closed_) {
+    // Mean value analysis, adding one request in flight at a time
+    const size_t concurrency = std::llround(std::max(load, 0.0));
+    double queue_length = 0.0;
+    double residence_ns = service_ns;
+    double requests_per_ns = 0.0;
+    for (size_t n = 1; n <= concurrency; n++) {
+      residence_ns = service_ns * (1.0 + queue_length);
+      requests_per_ns = n / (residence_ns + delay_ns);
+      queue_length = requests_per_ns * residence_ns;
+    }
+    *throughput = requests_per_ns * NANOS_PER_SECOND;
+    *latency_ns = residence_ns + delay_ns;
+  } else {
+    const double utilization = load / saturation_throughput_;
+    if (utilization >= 1.0) {
+      *throughput = saturation_throughput_;
+      *latency_ns = std::numeric_limits<double>::infinity();
+    } else {
+      *throughput = load;
+      *latency_ns = delay_ns + service_ns / (1.0 - utilization);
+    }
+  }
+}
+
+double
+CapacityModel::SquaredError(const std::vector<CapacitySample>& samples) const
+{
+  double error = 0.0;
+  for (const auto& sample : samples) {
+    double throughput, latency_ns;
+    Predict(sample.load, &throughput, &latency_ns);
+    const double throughput_error =
+        RelativeError(throughput, sample.throughput);
+    const double latency_error = RelativeError(latency_ns, sample.latency_ns);
+    error +=
+        throughput_error * throughput_error + latency_error * latency_error;
+  }
+  return error;
+}
+
+double
+NextCapacitySearchLoad(
+    const CapacityModel& model, const double highest, const double step,
+    const double end)
+{
+  const double target = model.Closed()
+                            ? 2.0 * model.KneeConcurrency()
+                            : 0.9 * model.SaturationThroughput();
+  const double max_next =
+      std::max((model.Closed() ? 4.0 : 2.0) * highest, highest + step);
+  double next = std::min(std::max(target, highest + step), max_next);
+  if (model.Closed()) {
+    next = std::ceil(next);
+  }
+  if (end != static_cast<double>(NO_LIMIT)) {
+    next = std::min(next, end);
+  }
+  return next;
+}
+
+void
+ReportCapacity(
+    const std::vector<CapacitySample>& samples, const CapacityModel& model,
+    const size_t batch_size, std::ostream& out)
+{
+  const bool closed = model.Closed();
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1);
+  auto load_string = [closed](const double load) {
+    std::stringstream load_ss;
+    if (closed) {
+      load_ss << "concurrency " << static_cast<uint64_t>(load);
+    } else {
+      load_ss << "request rate " << std::fixed << std::setprecision(1) << load;
+    }
+    return load_ss.str();
+  };
+  ss << "Capacity estimate from " << samples.size()
+     << " load levels (fit error " << model.FitError() * 100 << "%):"
+     << std::endl;
+  ss << "  Saturation throughput: "
+     << model.SaturationThroughput() * batch_size << " infer/sec" << std::endl;
+  ss << "  Latency without queueing: "
+     << static_cast<uint64_t>(model.BaseLatencyNs() / 1000) << " usec"
+     << std::endl;
+  if (model.ServiceTimeNs() > 0.0) {
+    ss << "  Server compute time: "
+       << static_cast<uint64_t>(model.ServiceTimeNs() / 1000)
+       << " usec per request, parallelism " << model.Parallelism()
+       << std::endl;
+  }
+  if (closed) {
+    ss << "  Requests queue from concurrency "
+       << static_cast<uint64_t>(std::ceil(model.KneeConcurrency()))
+       << std::endl;
+  }
+
+  // A few load levels around saturation that were not measured
+  double max_load = 0.0;
+  for (const auto& sample : samples) {
+    max_load = std::max(max_load, sample.load);
+  }
+  std::vector<double> loads;
+  if (closed) {
+    loads = {
+        std::ceil(model.KneeConcurrency()),
+        std::ceil(2.0 * model.KneeConcurrency()), 2.0 * max_load};
+  } else {
+    for (const double fraction : {0.5, 0.8, 0.95}) {
+      loads.push_back(fraction * model.SaturationThroughput());
+    }
+  }
+  std::sort(loads.begin(), loads.end());
+  loads.erase(std::unique(loads.begin(), loads.end()), loads.end());
+  for (const double load : loads) {
+    const bool measured = std::any_of(
+        samples.begin(), samples.end(),
+        [load](const CapacitySample& sample) { return sample.load == load; });
+    if (measured || (load <= 0.0)) {
+      continue;
+    }
+    double throughput, latency_ns;
+    model.Predict(load, &throughput, &latency_ns);
+    ss << "  Predicted at " << load_string(load) << ": throughput "
+       << throughput * batch_size << " infer/sec, latency "
+       << static_cast<uint64_t>(latency_ns / 1000) << " usec" << std::endl;
+  }
+
+  if (closed) {
+    bool holds = true;
+    for (const auto& sample : samples) {
+      const double deviation = LittlesLawDeviation(sample);
+      if (std::abs(deviation) > kLittlesLawTolerance) {
+        holds = false;
+        ss << "  WARNING: at " << load_string(sample.load)
+           << ", throughput x latency is " << std::showpos << deviation * 100
+           << std::noshowpos
+           << "% off the concurrency. Time outside the measured latency, "
+              "such as client overhead, or an unstable measurement skews the "
+              "model."
+           << std::endl;
+      }
+    }
+    if (holds) {
+      ss << "  Throughput x latency matches the concurrency within "
+         << kLittlesLawTolerance * 100 << "% (Little's law)" << std::endl;
+    }
+  } else {
+    for (const auto& sample : samples) {
+      if (sample.throughput < 0.95 * sample.load) {
+        ss << "  The server did not keep up with "
+           << load_string(sample.load) << std::endl;
+      }
+    }
+  }
+  out << ss.str();
+}
+
+}}  // namespace triton::perfanalyzer
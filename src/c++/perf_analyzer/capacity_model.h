@@ -0,0 +1,167 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+struct PerfStatus;
+
+/// What the capacity model takes from the measurement of one load level.
+struct CapacitySample {
+  // The concurrency, or the request rate in requests/sec
+  double load{0.0};
+  // The completed requests per second, a batch counting as one request
+  double throughput{0.0};
+  // The average latency of the requests in nsec
+  double latency_ns{0.0};
+  // The average time a request was queued and computed on the server in
+  // nsec, 0 without server side statistics
+  double queue_ns{0.0};
+  double compute_ns{0.0};
+};
+
+/// \param status The measurement of a load level.
+/// \param target_concurrency Whether the load level is a concurrency rather
+/// than a request rate.
+/// \return What the capacity model takes from the measurement.
+CapacitySample ToCapacitySample(
+    const PerfStatus& status, const bool target_concurrency);
+
+/// \param sample The measurement of a concurrency.
+/// \return How far throughput x latency is from the concurrency, relative to
+/// the concurrency. By Little's law they are equal when the measured latency
+/// covers all the time a context holds its concurrency slot, so a large
+/// deviation points at time the latency does not see, such as the client
+/// falling behind, or at an unstable measurement.
+double LittlesLawDeviation(const CapacitySample& sample);
+
+/// A queueing model of the server fitted to a few load levels of a sweep,
+/// which predicts the throughput and latency of the load levels that were
+/// not measured and where the server saturates.
+///
+/// The server is a station of m parallel servers with a service time S, and
+/// the rest of the latency a fixed delay. Following Seidmann's
+/// approximation, the station is a single server with a service time S / m
+/// followed by a delay of S (m - 1) / m. The model is then set by two
+/// parameters: the saturation throughput m / S and the latency without
+/// queueing. A concurrency sweep is a closed system solved with mean value
+/// analysis, and a request rate sweep an open system where the single
+/// server is an M/M/1 queue. The service time and the parallelism are told
+/// apart with the compute time in the server side statistics, when there
+/// are any.
+///
+class CapacityModel {
+ public:
+  /// Fits the model to the measurements of a sweep.
+  /// \param samples The measurements of the load levels of the sweep.
+  /// \param closed Whether the load levels are concurrencies rather than
+  /// request rates.
+  /// \param model Returns the fitted model.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Fit(
+      const std::vector<CapacitySample>& samples, const bool closed,
+      CapacityModel* model);
+
+  /// Predicts the throughput and latency of a load level.
+  /// \param load The concurrency, or the request rate in requests/sec.
+  /// \param throughput Returns the completed requests per second.
+  /// \param latency_ns Returns the average latency in nsec, infinite for a
+  /// request rate the server can't keep up with.
+  void Predict(double load, double* throughput, double* latency_ns) const;
+
+  /// \return The highest throughput the server sustains, in requests/sec.
+  double SaturationThroughput() const { return saturation_throughput_; }
+
+  /// \return The latency of a request that does not queue, in nsec.
+  double BaseLatencyNs() const { return base_latency_ns_; }
+
+  /// \return The time the server computes a request for, in nsec, 0 without
+  /// server side statistics.
+  double ServiceTimeNs() const { return service_time_ns_; }
+
+  /// \return The number of requests the server computes at once, 0 without
+  /// server side statistics.
+  double Parallelism() const
+  {
+    return service_time_ns_ * saturation_throughput_ / NANOS_PER_SECOND;
+  }
+
+  /// \return The concurrency from which requests queue, where the
+  /// throughput of the latency without queueing reaches the saturation
+  /// throughput.
+  double KneeConcurrency() const
+  {
+    return saturation_throughput_ * base_latency_ns_ / NANOS_PER_SECOND;
+  }
+
+  /// \return The root mean square of the relative errors of the fitted
+  /// throughputs and latencies.
+  double FitError() const { return fit_error_; }
+
+  /// \return Whether the load levels are concurrencies.
+  bool Closed() const { return closed_; }
+
+ private:
+  // The relative error of the model fitted to 'samples', squared and summed
+  double SquaredError(const std::vector<CapacitySample>& samples) const;
+
+  bool closed_{true};
+  double saturation_throughput_{0.0};
+  double base_latency_ns_{0.0};
+  double service_time_ns_{0.0};
+  double fit_error_{0.0};
+};
+
+/// Picks the next load level of a capacity search: past the knee of a
+/// concurrency sweep, where the throughput levels off, or just below the
+/// saturation throughput of a request rate sweep. The load grows by at least
+/// 'step' and at most fourfold for a concurrency, twofold for a request
+/// rate.
+/// \param model The model fitted to the load levels measured so far.
+/// \param highest The highest load level measured so far.
+/// \param step The smallest increase of the load level.
+/// \param end The highest load level to measure, or NO_LIMIT.
+/// \return The next load level to measure.
+double NextCapacitySearchLoad(
+    const CapacityModel& model, const double highest, const double step,
+    const double end);
+
+/// Prints the fitted model, its predictions at load levels that were not
+/// measured and the load levels that do not follow Little's law.
+/// \param samples The measurements the model was fitted to.
+/// \param model The fitted model.
+/// \param batch_size The batch size of the requests, to report inferences.
+/// \param out The stream to print to.
+void ReportCapacity(
+    const std::vector<CapacitySample>& samples, const CapacityModel& model,
+    const size_t batch_size, std::ostream& out);
+
+}}  // namespace triton::perfanalyzer
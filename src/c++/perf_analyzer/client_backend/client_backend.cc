@@ -40,6 +40,9 @@
 #include "torchserve/torchserve_client_backend.h"
 #endif  // TRITON_ENABLE_PERF_ANALYZER_TS
 
+#include "http_json/http_json_client_backend.h"
+#include "null_server/null_server_client_backend.h"
+
 namespace triton { namespace perfanalyzer { namespace clientbackend {
 
 //================================================
@@ -86,6 +89,12 @@ BackendKindToString(const BackendKind kind)
     case TRITON_C_API:
       return std::string("TRITON_C_API");
       break;
+    case HTTP_JSON:
+      return std::string("HTTP_JSON");
+      break;
+    case NULL_SERVER:
+      return std::string("NULL_SERVER");
+      break;
     default:
       return std::string("UNKNOWN");
       break;
@@ -118,14 +127,23 @@ ClientBackendFactory::Create(
     const GrpcCompressionAlgorithm compression_algorithm,
     std::shared_ptr<Headers> http_headers,
     const std::string& triton_server_path,
-    const std::string& model_repository_path, const bool verbose,
+    const std::string& model_repository_path,
+    const OutputMemoryPolicy& output_memory_policy, const bool lazy_model_load,
+    const bool server_request_trace, const bool verbose,
     const std::string& metrics_url,
+    const std::vector<std::string>& metrics_allowlist,
+    const std::string& request_template,
+    const NullServerOptions& null_server_options,
+    const TransferRateLimits& transfer_rate_limits,
+    const TfServingOptions& tfserving_options,
     std::shared_ptr<ClientBackendFactory>* factory)
 {
   factory->reset(new ClientBackendFactory(
       kind, url, protocol, ssl_options, trace_options, compression_algorithm,
-      http_headers, triton_server_path, model_repository_path, verbose,
-      metrics_url));
+      http_headers, triton_server_path, model_repository_path,
+      output_memory_policy, lazy_model_load, server_request_trace, verbose,
+      metrics_url, metrics_allowlist, request_template, null_server_options,
+      transfer_rate_limits, tfserving_options));
   return Error::Success;
 }
 
@@ -136,7 +154,24 @@ ClientBackendFactory::CreateClientBackend(
   RETURN_IF_CB_ERROR(ClientBackend::Create(
       kind_, url_, protocol_, ssl_options_, trace_options_,
       compression_algorithm_, http_headers_, verbose_, triton_server_path,
-      model_repository_path_, metrics_url_, client_backend));
+      model_repository_path_, output_memory_policy_, lazy_model_load_,
+      server_request_trace_, metrics_url_, metrics_allowlist_,
+      request_template_, null_server_options_, transfer_rate_limits_,
+      tfserving_options_, client_backend));
+  return Error::Success;
+}
+
+Error
+ClientBackendFactory::CreateEndpointClientBackend(
+    const std::string& url, std::unique_ptr<ClientBackend>* client_backend)
+{
+  RETURN_IF_CB_ERROR(ClientBackend::Create(
+      kind_, url, protocol_, ssl_options_, trace_options_,
+      compression_algorithm_, http_headers_, verbose_, triton_server_path,
+      model_repository_path_, output_memory_policy_, lazy_model_load_,
+      server_request_trace_, metrics_url_, metrics_allowlist_,
+      request_template_, null_server_options_, transfer_rate_limits_,
+      tfserving_options_, client_backend));
   return Error::Success;
 }
 
@@ -157,21 +192,29 @@ ClientBackend::Create(
     const GrpcCompressionAlgorithm compression_algorithm,
     std::shared_ptr<Headers> http_headers, const bool verbose,
     const std::string& triton_server_path,
-    const std::string& model_repository_path, const std::string& metrics_url,
+    const std::string& model_repository_path,
+    const OutputMemoryPolicy& output_memory_policy, const bool lazy_model_load,
+    const bool server_request_trace, const std::string& metrics_url,
+    const std::vector<std::string>& metrics_allowlist,
+    const std::string& request_template,
+    const NullServerOptions& null_server_options,
+    const TransferRateLimits& transfer_rate_limits,
+    const TfServingOptions& tfserving_options,
     std::unique_ptr<ClientBackend>* client_backend)
 {
   std::unique_ptr<ClientBackend> local_backend;
   if (kind == TRITON) {
     RETURN_IF_CB_ERROR(tritonremote::TritonClientBackend::Create(
         url, protocol, ssl_options, trace_options,
-        BackendToGrpcType(compression_algorithm), http_headers, verbose,
-        metrics_url, &local_backend));
+        BackendToGrpcType(compression_algorithm),
+        (compression_algorithm == COMPRESS_ADAPTIVE), http_headers, verbose,
+        metrics_url, metrics_allowlist, transfer_rate_limits, &local_backend));
   }
 #ifdef TRITON_ENABLE_PERF_ANALYZER_TFS
   else if (kind == TENSORFLOW_SERVING) {
     RETURN_IF_CB_ERROR(tfserving::TFServeClientBackend::Create(
         url, protocol, BackendToGrpcType(compression_algorithm), http_headers,
-        verbose, &local_backend));
+        verbose, tfserving_options, &local_backend));
   }
 #endif  // TRITON_ENABLE_PERF_ANALYZER_TFS
 #ifdef TRITON_ENABLE_PERF_ANALYZER_TS
@@ -183,9 +226,19 @@ ClientBackend::Create(
 #ifdef TRITON_ENABLE_PERF_ANALYZER_C_API
   else if (kind == TRITON_C_API) {
     RETURN_IF_CB_ERROR(tritoncapi::TritonCApiClientBackend::Create(
-        triton_server_path, model_repository_path, verbose, &local_backend));
+        triton_server_path, model_repository_path, output_memory_policy,
+        lazy_model_load, server_request_trace, verbose, &local_backend));
   }
 #endif  // TRITON_ENABLE_PERF_ANALYZER_C_API
+  else if (kind == HTTP_JSON) {
+    RETURN_IF_CB_ERROR(httpjson::HttpJsonClientBackend::Create(
+        url, protocol, request_template, http_headers, verbose,
+        &local_backend));
+  }
+  else if (kind == NULL_SERVER) {
+    RETURN_IF_CB_ERROR(nullserver::NullServerClientBackend::Create(
+        null_server_options, &local_backend));
+  }
   else {
     return Error("unsupported client backend requested", pa::GENERIC_ERROR);
   }
@@ -226,6 +279,40 @@ ClientBackend::ModelConfig(
       pa::GENERIC_ERROR);
 }
 
+Error
+ClientBackend::Warmup(const size_t connection_count)
+{
+  return Error::Success;
+}
+
+Error
+ClientBackend::LoadModel(
+    const std::string& model_name, const std::string& config)
+{
+  return Error(
+      "client backend of kind " + BackendKindToString(kind_) +
+          " does not support LoadModel API",
+      pa::GENERIC_ERROR);
+}
+
+Error
+ClientBackend::UnloadModel(const std::string& model_name)
+{
+  return Error(
+      "client backend of kind " + BackendKindToString(kind_) +
+          " does not support UnloadModel API",
+      pa::GENERIC_ERROR);
+}
+
+Error
+ClientBackend::ModelReady(
+    bool* ready, const std::string& model_name,
+    const std::string& model_version)
+{
+  *ready = true;
+  return Error::Success;
+}
+
 Error
 ClientBackend::Infer(
     InferResult** result, const InferOptions& options,
@@ -299,6 +386,15 @@ ClientBackend::Metrics(triton::perfanalyzer::Metrics& metrics)
       pa::GENERIC_ERROR);
 }
 
+Error
+ClientBackend::ServerRequestTimings(std::vector<ServerRequestTiming>* timings)
+{
+  return Error(
+      "client backend of kind " + BackendKindToString(kind_) +
+          " does not support ServerRequestTimings API",
+      pa::GENERIC_ERROR);
+}
+
 Error
 ClientBackend::UnregisterAllSharedMemory()
 {
@@ -318,6 +414,25 @@ ClientBackend::RegisterSystemSharedMemory(
       pa::GENERIC_ERROR);
 }
 
+Error
+ClientBackend::UnregisterSystemSharedMemory(const std::string& name)
+{
+  return Error(
+      "client backend of kind " + BackendKindToString(kind_) +
+          " does not support UnregisterSystemSharedMemory API",
+      pa::GENERIC_ERROR);
+}
+
+Error
+ClientBackend::SystemSharedMemoryStatus(
+    std::map<std::string, SystemSharedMemoryRegion>* regions)
+{
+  return Error(
+      "client backend of kind " + BackendKindToString(kind_) +
+          " does not support SystemSharedMemoryStatus API",
+      pa::GENERIC_ERROR);
+}
+
 Error
 ClientBackend::RegisterCudaSharedMemory(
     const std::string& name, const cudaIpcMemHandle_t& handle,
@@ -365,7 +480,8 @@ ClientBackend::CreateSharedMemoryRegion(
 
 Error
 ClientBackend::MapSharedMemory(
-    int shm_fd, size_t offset, size_t byte_size, void** shm_addr)
+    int shm_fd, size_t offset, size_t byte_size,
+    const SharedMemoryOptions& options, void** shm_addr)
 {
   return Error(
       "client backend of kind " + BackendKindToString(kind_) +
@@ -434,6 +550,14 @@ InferInput::Create(
         infer_input, name, dims, datatype));
   }
 #endif  // TRITON_ENABLE_PERF_ANALYZER_C_API
+  else if (kind == HTTP_JSON) {
+    RETURN_IF_CB_ERROR(httpjson::HttpJsonInferInput::Create(
+        infer_input, name, dims, datatype));
+  }
+  else if (kind == NULL_SERVER) {
+    RETURN_IF_CB_ERROR(nullserver::NullServerInferInput::Create(
+        infer_input, name, dims, datatype));
+  }
   else {
     return Error(
         "unsupported client backend provided to create InferInput object",
@@ -484,7 +608,8 @@ InferInput::SetSharedMemory(
 InferInput::InferInput(
     const BackendKind kind, const std::string& name,
     const std::string& datatype)
-    : kind_(kind), name_(name), datatype_(datatype)
+    : kind_(kind), name_(name), datatype_(datatype),
+      type_(ParseDataType(datatype))
 {
 }
 
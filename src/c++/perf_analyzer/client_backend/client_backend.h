@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "../constants.h"
+#include "../datatype.h"
 #include "../metrics.h"
 #include "../perf_analyzer_exception.h"
 #include "ipc.h"
@@ -135,16 +136,91 @@ enum BackendKind {
   TRITON = 0,
   TENSORFLOW_SERVING = 1,
   TORCHSERVE = 2,
-  TRITON_C_API = 3
+  TRITON_C_API = 3,
+  HTTP_JSON = 4,
+  NULL_SERVER = 5
 };
 enum ProtocolType { HTTP = 0, GRPC = 1, UNKNOWN = 2 };
 enum GrpcCompressionAlgorithm {
   COMPRESS_NONE = 0,
   COMPRESS_DEFLATE = 1,
-  COMPRESS_GZIP = 2
+  COMPRESS_GZIP = 2,
+  // The client compresses with deflate the requests large and compressible
+  // enough, see tc::GrpcClientOptions::adaptive_compression.
+  COMPRESS_ADAPTIVE = 3
 };
 typedef std::map<std::string, std::string> Headers;
 
+/// Where the C API backend allocates the outputs that are not in shared
+/// memory
+enum OutputMemoryKind {
+  OUTPUT_MEMORY_CPU = 0,
+  OUTPUT_MEMORY_CPU_PINNED = 1,
+  OUTPUT_MEMORY_GPU = 2,
+  // The memory that the server asks for
+  OUTPUT_MEMORY_PREFERRED = 3
+};
+
+struct OutputMemoryPolicy {
+  OutputMemoryKind kind{OUTPUT_MEMORY_CPU};
+  // The device of OUTPUT_MEMORY_GPU
+  int64_t device_id{0};
+};
+
+/// The placement of the pages of a system shared memory region
+struct SharedMemoryOptions {
+  // Back the region with transparent huge pages
+  bool huge_pages{false};
+  // Fault in the pages of the region when it is mapped
+  bool prefault{false};
+  // The NUMA node to allocate the pages from, if not negative
+  int numa_node{-1};
+  // Leave the regions registered and in place when the run ends, for the
+  // next run to reuse, see InferDataManagerShm
+  bool persistent{false};
+};
+
+/// A system shared memory region registered with the server
+struct SystemSharedMemoryRegion {
+  // The key of the shared memory object
+  std::string key;
+  size_t byte_size{0};
+};
+
+/// The behavior of the server simulated by the null server backend
+struct NullServerOptions {
+  // The time each batch takes to execute, in microseconds
+  uint64_t latency_us{0};
+  // The largest batch formed from the queued requests, 0 to run each request
+  // on its own
+  size_t max_batch_size{0};
+  // How long the oldest request waits for its batch to fill, in microseconds
+  uint64_t batch_delay_us{0};
+  // The number of batches executed at once, 0 for no limit
+  size_t instance_count{0};
+};
+
+/// The rates a client transfers its requests at, to emulate clients on slow
+/// networks
+struct TransferRateLimits {
+  // How fast each request uploads its body, in bytes per second, 0 for no
+  // limit
+  uint64_t send_bytes_per_sec{0};
+  // How fast each request reads its response, in bytes per second, 0 for no
+  // limit
+  uint64_t recv_bytes_per_sec{0};
+};
+
+/// How the TensorFlow Serving clients send their gRPC requests
+struct TfServingOptions {
+  // The number of completion queues shared by all the clients, each drained
+  // by a thread of its own, 0 for a queue and a thread per client
+  size_t completion_queue_count{0};
+  // The number of channels, each with its own connection, that the clients
+  // of a server take in turn, 0 for a channel per client
+  size_t channel_count{1};
+};
+
 using OnCompleteFn = std::function<void(InferResult*)>;
 using ModelIdentifier = std::pair<std::string, std::string>;
 
@@ -163,10 +239,42 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Time from the request start until the first byte of the response is
+  /// received. Only measured by the HTTP JSON backend.
+  uint64_t cumulative_first_byte_time_ns;
+
+  /// Number of intervals between consecutive chunks of the streamed
+  /// responses, and their total duration. Only measured by the HTTP JSON
+  /// backend.
+  size_t response_chunk_interval_count;
+  uint64_t cumulative_response_chunk_interval_ns;
+
+  /// Time spent building the requests, waiting for the transport to start
+  /// sending them, and parsing the responses. Only measured by the Triton
+  /// backend, which does not measure the wait for GRPC protocol.
+  uint64_t cumulative_serialize_time_ns;
+  uint64_t cumulative_send_queue_time_ns;
+  uint64_t cumulative_deserialize_time_ns;
+
+  /// Byte size of the request and response bodies, as sent on the wire and
+  /// before compression. Only counted by the Triton backend, for which the
+  /// compression of GRPC protocol is not seen.
+  uint64_t cumulative_request_byte_size;
+  uint64_t cumulative_uncompressed_request_byte_size;
+  uint64_t cumulative_response_byte_size;
+  uint64_t cumulative_uncompressed_response_byte_size;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cumulative_first_byte_time_ns(0), response_chunk_interval_count(0),
+        cumulative_response_chunk_interval_ns(0),
+        cumulative_serialize_time_ns(0), cumulative_send_queue_time_ns(0),
+        cumulative_deserialize_time_ns(0), cumulative_request_byte_size(0),
+        cumulative_uncompressed_request_byte_size(0),
+        cumulative_response_byte_size(0),
+        cumulative_uncompressed_response_byte_size(0)
   {
   }
 };
@@ -191,6 +299,15 @@ struct ModelStatistics {
   uint64_t cache_miss_time_ns_;
 };
 
+// The time one request spent in each phase on the server, from the
+// timestamps that the server traced for it
+struct ServerRequestTiming {
+  uint64_t queue_ns{0};
+  uint64_t compute_input_ns{0};
+  uint64_t compute_infer_ns{0};
+  uint64_t compute_output_ns{0};
+};
+
 //==============================================================================
 /// Structure to hold options for Inference Request.
 ///
@@ -198,7 +315,9 @@ struct InferOptions {
   explicit InferOptions(const std::string& model_name)
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
-        sequence_end_(false)
+        sequence_end_(false), priority_(0), server_timeout_(0),
+        triton_enable_empty_final_response_(false), data_stream_id_(-1),
+        data_step_id_(-1)
   {
   }
   /// The name of the model to run inference.
@@ -227,6 +346,22 @@ struct InferOptions {
   /// sequence. Default value is False. This argument is ignored if
   /// 'sequence_id' is 0.
   bool sequence_end_;
+  /// The priority of the request on the server. Default value is 0 which
+  /// means the default priority of the model.
+  uint64_t priority_;
+  /// How long the server may keep the request before rejecting it, in
+  /// microseconds. Default value is 0 which means the default timeout of
+  /// the model.
+  uint64_t server_timeout_;
+  /// Whether the server should send an empty final response to a request
+  /// of a decoupled model, which marks that the request is complete.
+  bool triton_enable_empty_final_response_;
+  /// The data stream and step the input data of the request comes from.
+  /// Requests with the same stream and step send the same input data, so a
+  /// client backend may reuse work done on it, e.g. its compression. The
+  /// default value is -1 which means the input data is not identified.
+  int64_t data_stream_id_;
+  int64_t data_step_id_;
 };
 
 struct SslOptionsBase {
@@ -255,7 +390,8 @@ class ClientBackendFactory {
   /// \param protocol The protocol type used.
   /// \param ssl_options The SSL options used with client backend.
   /// \param compression_algorithm The compression algorithm to be used
-  /// on the grpc requests.
+  /// on the grpc requests, or on the bodies of the HTTP requests of the
+  /// Triton backend.
   /// \param http_headers Map of HTTP headers. The map key/value
   /// indicates the header name/value. The headers will be included
   /// with all the requests made to server using this client.
@@ -264,8 +400,24 @@ class ClientBackendFactory {
   /// /opt/tritonserver) Must contain libtritonserver.so.
   /// \param model_repository_path Only for C api backend. Path to model
   /// repository which contains the desired model.
+  /// \param output_memory_policy Only for C api backend. Where the outputs
+  /// are allocated.
+  /// \param lazy_model_load Only for C api backend. Whether only the models
+  /// that are used are loaded instead of the whole model repository.
+  /// \param server_request_trace Only for C api backend. Whether the server
+  /// traces the timestamps of every request.
   /// \param verbose Enables the verbose mode.
   /// \param metrics_url The inference server metrics url and port.
+  /// \param metrics_allowlist The metric families to collect beyond the GPU
+  /// ones.
+  /// \param request_template Only for HTTP JSON backend. Path to the JSON
+  /// template of the request body.
+  /// \param null_server_options Only for null server backend. The behavior
+  /// of the simulated server.
+  /// \param transfer_rate_limits Only for Triton backend with HTTP
+  /// protocol. How fast the requests are transferred.
+  /// \param tfserving_options Only for TensorFlow Serving backend. How the
+  /// clients send their gRPC requests.
   /// \param factory Returns a new ClientBackend object.
   /// \return Error object indicating success or failure.
   static Error Create(
@@ -275,8 +427,15 @@ class ClientBackendFactory {
       const GrpcCompressionAlgorithm compression_algorithm,
       std::shared_ptr<Headers> http_headers,
       const std::string& triton_server_path,
-      const std::string& model_repository_path, const bool verbose,
-      const std::string& metrics_url,
+      const std::string& model_repository_path,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
+      const bool verbose, const std::string& metrics_url,
+      const std::vector<std::string>& metrics_allowlist,
+      const std::string& request_template,
+      const NullServerOptions& null_server_options,
+      const TransferRateLimits& transfer_rate_limits,
+      const TfServingOptions& tfserving_options,
       std::shared_ptr<ClientBackendFactory>* factory);
 
   const BackendKind& Kind();
@@ -285,6 +444,13 @@ class ClientBackendFactory {
   /// \param backend Returns a new Client backend object.
   virtual Error CreateClientBackend(std::unique_ptr<ClientBackend>* backend);
 
+  /// Create a ClientBackend that communicates with another server, with the
+  /// same options otherwise.
+  /// \param url The url and port of the server.
+  /// \param backend Returns a new Client backend object.
+  virtual Error CreateEndpointClientBackend(
+      const std::string& url, std::unique_ptr<ClientBackend>* backend);
+
  private:
   ClientBackendFactory(
       const BackendKind kind, const std::string& url,
@@ -293,14 +459,28 @@ class ClientBackendFactory {
       const GrpcCompressionAlgorithm compression_algorithm,
       const std::shared_ptr<Headers> http_headers,
       const std::string& triton_server_path,
-      const std::string& model_repository_path, const bool verbose,
-      const std::string& metrics_url)
+      const std::string& model_repository_path,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
+      const bool verbose, const std::string& metrics_url,
+      const std::vector<std::string>& metrics_allowlist,
+      const std::string& request_template,
+      const NullServerOptions& null_server_options,
+      const TransferRateLimits& transfer_rate_limits,
+      const TfServingOptions& tfserving_options)
       : kind_(kind), url_(url), protocol_(protocol), ssl_options_(ssl_options),
         trace_options_(trace_options),
         compression_algorithm_(compression_algorithm),
         http_headers_(http_headers), triton_server_path(triton_server_path),
-        model_repository_path_(model_repository_path), verbose_(verbose),
-        metrics_url_(metrics_url)
+        model_repository_path_(model_repository_path),
+        output_memory_policy_(output_memory_policy),
+        lazy_model_load_(lazy_model_load),
+        server_request_trace_(server_request_trace), verbose_(verbose),
+        metrics_url_(metrics_url), metrics_allowlist_(metrics_allowlist),
+        request_template_(request_template),
+        null_server_options_(null_server_options),
+        transfer_rate_limits_(transfer_rate_limits),
+        tfserving_options_(tfserving_options)
   {
   }
 
@@ -313,9 +493,16 @@ class ClientBackendFactory {
   std::shared_ptr<Headers> http_headers_;
   std::string triton_server_path;
   std::string model_repository_path_;
+  const OutputMemoryPolicy output_memory_policy_;
+  const bool lazy_model_load_;
+  const bool server_request_trace_;
   const bool verbose_;
   const std::string metrics_url_{""};
-
+  const std::vector<std::string> metrics_allowlist_;
+  const std::string request_template_;
+  const NullServerOptions null_server_options_;
+  const TransferRateLimits transfer_rate_limits_;
+  const TfServingOptions tfserving_options_;
 
 #ifndef DOCTEST_CONFIG_DISABLE
  protected:
@@ -323,7 +510,9 @@ class ClientBackendFactory {
       : kind_(BackendKind()), url_(""), protocol_(ProtocolType()),
         ssl_options_(SslOptionsBase()),
         trace_options_(std::map<std::string, std::vector<std::string>>()),
-        compression_algorithm_(GrpcCompressionAlgorithm()), verbose_(false)
+        compression_algorithm_(GrpcCompressionAlgorithm()),
+        lazy_model_load_(false), server_request_trace_(false),
+        verbose_(false)
   {
   }
 #endif
@@ -341,7 +530,14 @@ class ClientBackend {
       const GrpcCompressionAlgorithm compression_algorithm,
       std::shared_ptr<Headers> http_headers, const bool verbose,
       const std::string& library_directory, const std::string& model_repository,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
       const std::string& metrics_url,
+      const std::vector<std::string>& metrics_allowlist,
+      const std::string& request_template,
+      const NullServerOptions& null_server_options,
+      const TransferRateLimits& transfer_rate_limits,
+      const TfServingOptions& tfserving_options,
       std::unique_ptr<ClientBackend>* client_backend);
 
   /// Destructor for the client backend object
@@ -365,6 +561,36 @@ class ClientBackend {
       rapidjson::Document* model_config, const std::string& model_name,
       const std::string& model_version);
 
+  /// Requests the server to load or reload a model.
+  /// \param model_name The name of the model.
+  /// \param config If not empty, the JSON model config to load the model
+  /// with, overriding the one of the model repository.
+  /// \return Error object indicating success or failure.
+  virtual Error LoadModel(
+      const std::string& model_name, const std::string& config = "");
+
+  /// Requests the server to unload a model.
+  /// \param model_name The name of the model.
+  /// \return Error object indicating success or failure.
+  virtual Error UnloadModel(const std::string& model_name);
+
+  /// Checks whether the model is ready for inference. The backends that can
+  /// not tell report it as ready.
+  /// \param ready Returns whether the model is ready.
+  /// \param model_name The name of the model.
+  /// \param model_version The version of the model, empty for the one that
+  /// the server picks.
+  /// \return Error object indicating success or failure.
+  virtual Error ModelReady(
+      bool* ready, const std::string& model_name,
+      const std::string& model_version);
+
+  /// Opens the connections to the server ahead of the first requests. The
+  /// backends without connections to set up do nothing.
+  /// \param connection_count The number of connections to open.
+  /// \return Error object indicating success or failure.
+  virtual Error Warmup(const size_t connection_count);
+
   /// Issues a synchronous inference request to the server.
   virtual Error Infer(
       InferResult** result, const InferOptions& options,
@@ -399,6 +625,12 @@ class ClientBackend {
   /// \return Error object indicating success or failure.
   virtual Error Metrics(Metrics& metrics);
 
+  /// Takes the server timings of the requests that completed since the last
+  /// call. Only the C API backend traces them, when enabled.
+  /// \param timings Returns the timings of the requests.
+  /// \return Error object indicating success or failure.
+  virtual Error ServerRequestTimings(std::vector<ServerRequestTiming>* timings);
+
   /// Unregisters all the shared memory from the server
   virtual Error UnregisterAllSharedMemory();
 
@@ -406,6 +638,15 @@ class ClientBackend {
   virtual Error RegisterSystemSharedMemory(
       const std::string& name, const std::string& key, const size_t byte_size);
 
+  /// Unregisters a system shared memory region from the server.
+  virtual Error UnregisterSystemSharedMemory(const std::string& name);
+
+  /// Gets the system shared memory regions registered with the server.
+  /// \param regions Returns the regions by name.
+  /// \return Error object indicating success or failure.
+  virtual Error SystemSharedMemoryStatus(
+      std::map<std::string, SystemSharedMemoryRegion>* regions);
+
   /// Registers cuda shared memory to the server.
   virtual Error RegisterCudaSharedMemory(
       const std::string& name, const cudaIpcMemHandle_t& handle,
@@ -434,10 +675,12 @@ class ClientBackend {
   // \param offset The offset of the shared memory block from the start of the
   // shared memory region
   // \param byte_size The size in bytes of the shared memory region
+  // \param options The placement of the pages of the region
   // \param shm_addr Returns the base address of the shared memory region
   // \return error Returns an error if unable to mmap shared memory region.
   virtual Error MapSharedMemory(
-      int shm_fd, size_t offset, size_t byte_size, void** shm_addr);
+      int shm_fd, size_t offset, size_t byte_size,
+      const SharedMemoryOptions& options, void** shm_addr);
 
   // Close the shared memory descriptor.
   // \param shm_fd The int descriptor of the created shared memory region
@@ -492,6 +735,11 @@ class InferInput {
   /// \return The datatype of the tensor.
   const std::string& Datatype() const { return datatype_; }
 
+  /// Gets datatype of the associated input tensor, resolved when the input
+  /// is created.
+  /// \return The datatype of the tensor.
+  DataType Type() const { return type_; }
+
   /// Gets the shape of the input tensor.
   /// \return The shape of the tensor.
   virtual const std::vector<int64_t>& Shape() const = 0;
@@ -535,6 +783,7 @@ class InferInput {
   const BackendKind kind_;
   const std::string name_;
   const std::string datatype_;
+  const DataType type_;
 };
 
 
@@ -603,6 +852,26 @@ class InferResult {
   virtual Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const = 0;
+
+  /// Get whether this is the last response of the request. Only the
+  /// requests of decoupled models can receive more than one response.
+  /// \param is_final_response Returns true if this is the last response.
+  /// \return Error object indicating success or failure.
+  virtual Error IsFinalResponse(bool* is_final_response) const
+  {
+    *is_final_response = true;
+    return Error::Success;
+  }
+
+  /// Get whether this response is empty and only marks the completion of
+  /// the request.
+  /// \param is_null_response Returns true if the response is empty.
+  /// \return Error object indicating success or failure.
+  virtual Error IsNullResponse(bool* is_null_response) const
+  {
+    *is_null_response = false;
+    return Error::Success;
+  }
 };
 
 }}}  // namespace triton::perfanalyzer::clientbackend
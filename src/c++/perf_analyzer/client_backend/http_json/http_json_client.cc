@@ -0,0 +1,635 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "http_json_client.h"
+
+#include <rapidjson/document.h>
+#include <strings.h>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+namespace {
+
+constexpr char kContentLengthHTTPHeader[] = "Content-Length";
+constexpr char kContentTypeHTTPHeader[] = "Content-Type";
+
+//==============================================================================
+
+// Global initialization for libcurl. Libcurl requires global
+// initialization before any other threads are created and before any
+// curl methods are used. The curl_global static object is used to
+// perform this initialization.
+class CurlGlobal {
+ public:
+  CurlGlobal();
+  ~CurlGlobal();
+
+  const Error& Status() const { return err_; }
+
+ private:
+  Error err_;
+};
+
+CurlGlobal::CurlGlobal() : err_(Error::Success)
+{
+  if (curl_global_init(CURL_GLOBAL_ALL) != 0) {
+    err_ = Error("global initialization failed");
+  }
+}
+
+CurlGlobal::~CurlGlobal()
+{
+  curl_global_cleanup();
+}
+
+static CurlGlobal curl_global;
+
+bool
+IsInputNameChar(const char c)
+{
+  return std::isalnum(static_cast<unsigned char>(c)) || (c == '_') ||
+         (c == '-') || (c == '.');
+}
+
+// Appends 'value' escaped so that it can be placed inside a JSON string
+void
+AppendJsonEscaped(const std::string& value, std::string* out)
+{
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '\r':
+        out->append("\\r");
+        break;
+      case '\t':
+        out->append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out->append(escaped);
+        } else {
+          out->push_back(c);
+        }
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+//==============================================================================
+
+Error
+RequestTemplate::Parse(
+    const std::string& text, RequestTemplate* request_template)
+{
+  rapidjson::Document document;
+  document.Parse(text.c_str());
+  if (document.HasParseError()) {
+    return Error(
+        "request template is not valid JSON, error at offset " +
+        std::to_string(document.GetErrorOffset()));
+  }
+
+  RequestTemplate parsed;
+  size_t pos = 0;
+  while (true) {
+    const size_t start = text.find("{{", pos);
+    const size_t end =
+        (start == std::string::npos) ? start : text.find("}}", start + 2);
+    if (end == std::string::npos) {
+      parsed.literals_.emplace_back(text.substr(pos));
+      break;
+    }
+    const std::string name = text.substr(start + 2, end - start - 2);
+    if (name.empty() ||
+        !std::all_of(name.begin(), name.end(), IsInputNameChar)) {
+      return Error(
+          "invalid placeholder '" + text.substr(start, end - start + 2) +
+          "' in request template");
+    }
+    parsed.literals_.emplace_back(text.substr(pos, start - pos));
+    auto it = std::find(
+        parsed.input_names_.begin(), parsed.input_names_.end(), name);
+    parsed.placeholders_.push_back(it - parsed.input_names_.begin());
+    if (it == parsed.input_names_.end()) {
+      parsed.input_names_.push_back(name);
+    }
+    pos = end + 2;
+  }
+
+  *request_template = std::move(parsed);
+  return Error::Success;
+}
+
+void
+RequestTemplate::Render(
+    const std::vector<std::string>& input_data, std::string* body) const
+{
+  size_t body_size = 0;
+  for (const auto& literal : literals_) {
+    body_size += literal.size();
+  }
+  for (const auto placeholder : placeholders_) {
+    body_size += input_data[placeholder].size();
+  }
+
+  body->clear();
+  body->reserve(body_size);
+  for (size_t i = 0; i < placeholders_.size(); i++) {
+    body->append(literals_[i]);
+    AppendJsonEscaped(input_data[placeholders_[i]], body);
+  }
+  body->append(literals_.back());
+}
+
+//==============================================================================
+
+size_t
+ServerSentEventParser::Feed(const char* data, size_t size)
+{
+  size_t events = 0;
+  const char* end = data + size;
+  while (data < end) {
+    const char* newline =
+        static_cast<const char*>(memchr(data, '\n', end - data));
+    const char* line_end = (newline == nullptr) ? end : newline;
+    if (line_end != data) {
+      const size_t prefix_size = std::min(
+          MAX_LINE_PREFIX - line_prefix_.size(), (size_t)(line_end - data));
+      line_prefix_.append(data, prefix_size);
+      line_size_ += line_end - data;
+      line_last_ = *(line_end - 1);
+    }
+    if (newline == nullptr) {
+      break;
+    }
+    if (EndLine()) {
+      events++;
+    }
+    data = newline + 1;
+  }
+  return events;
+}
+
+bool
+ServerSentEventParser::EndLine()
+{
+  const size_t size = line_size_ - ((line_last_ == '\r') ? 1 : 0);
+  const std::string line = line_prefix_.substr(0, size);
+  line_prefix_.clear();
+  line_size_ = 0;
+  line_last_ = '\0';
+
+  if (size == 0) {
+    const bool completed = event_has_data_ && !event_is_done_;
+    event_has_data_ = false;
+    event_is_done_ = false;
+    return completed;
+  }
+  if (line.compare(0, 5, "data:") == 0) {
+    event_has_data_ = true;
+    event_is_done_ |= (size == line.size()) &&
+                      ((line == "data: [DONE]") || (line == "data:[DONE]"));
+  }
+  return false;
+}
+
+//==============================================================================
+
+HttpInferRequest::HttpInferRequest(
+    std::string&& body, HttpJsonOnCompleteFn callback)
+    : body_(std::move(body)), callback_(std::move(callback))
+{
+}
+
+HttpInferRequest::~HttpInferRequest()
+{
+  if (header_list_ != nullptr) {
+    curl_slist_free_all(static_cast<curl_slist*>(header_list_));
+    header_list_ = nullptr;
+  }
+}
+
+//==============================================================================
+
+Error
+HttpJsonClient::Create(
+    std::unique_ptr<HttpJsonClient>* client, const std::string& url,
+    bool verbose)
+{
+  client->reset(new HttpJsonClient(url, verbose));
+  return Error::Success;
+}
+
+Error
+HttpJsonClient::Infer(
+    InferResult** result, std::string&& body, const Headers& headers)
+{
+  if (!curl_global.Status().IsOk()) {
+    return curl_global.Status();
+  }
+
+  std::shared_ptr<HttpInferRequest> sync_request(
+      new HttpInferRequest(std::move(body)));
+
+  sync_request->Timer().CaptureTimestamp(
+      tc::RequestTimers::Kind::REQUEST_START);
+
+  RETURN_IF_CB_ERROR(PreRunProcessing(easy_handle_, headers, sync_request));
+
+  sync_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::SEND_START);
+
+  // During this call SEND_END, RECV_START, and RECV_END will be set.
+  auto curl_status = curl_easy_perform(reinterpret_cast<CURL*>(easy_handle_));
+  if (curl_status == CURLE_OK) {
+    curl_easy_getinfo(
+        reinterpret_cast<CURL*>(easy_handle_), CURLINFO_RESPONSE_CODE,
+        &sync_request->http_code_);
+  }
+
+  sync_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_END);
+  UpdateStat(sync_request);
+
+  InferResult::Create(result, sync_request);
+  return (*result)->RequestStatus();
+}
+
+Error
+HttpJsonClient::AsyncInfer(
+    HttpJsonOnCompleteFn callback, std::string&& body, const Headers& headers)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with AsyncInfer() call.");
+  }
+
+  if (multi_handle_ == nullptr) {
+    return Error("failed to start HTTP asynchronous client");
+  } else if (!worker_.joinable()) {
+    worker_ = std::thread(&HttpJsonClient::AsyncTransfer, this);
+  }
+
+  if (!curl_global.Status().IsOk()) {
+    return curl_global.Status();
+  }
+
+  std::shared_ptr<HttpInferRequest> async_request(
+      new HttpInferRequest(std::move(body), std::move(callback)));
+
+  async_request->Timer().CaptureTimestamp(
+      tc::RequestTimers::Kind::REQUEST_START);
+
+  CURL* multi_easy_handle = curl_easy_init();
+  Error err = PreRunProcessing(
+      reinterpret_cast<void*>(multi_easy_handle), headers, async_request);
+  if (!err.IsOk()) {
+    curl_easy_cleanup(multi_easy_handle);
+    return err;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto insert_result = ongoing_async_requests_.emplace(std::make_pair(
+        reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
+    if (!insert_result.second) {
+      curl_easy_cleanup(multi_easy_handle);
+      return Error("Failed to insert new asynchronous request context.");
+    }
+
+    async_request->Timer().CaptureTimestamp(
+        tc::RequestTimers::Kind::SEND_START);
+    curl_multi_add_handle(
+        reinterpret_cast<CURLM*>(multi_handle_), multi_easy_handle);
+  }
+
+  cv_.notify_all();
+  return Error::Success;
+}
+
+Error
+HttpJsonClient::ClientResponseStat(ResponseStat* response_stat) const
+{
+  std::lock_guard<std::mutex> lock(stat_mutex_);
+  *response_stat = response_stat_;
+  return Error::Success;
+}
+
+void
+HttpJsonClient::AsyncTransfer()
+{
+  CURLM* multi_handle = reinterpret_cast<CURLM*>(multi_handle_);
+  int place_holder = 0;
+  do {
+    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+
+    // sleep if no work is available
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+      if (this->exiting_) {
+        return true;
+      }
+      // wake up if an async request has been generated
+      return !this->ongoing_async_requests_.empty();
+    });
+
+    CURLMcode mc = curl_multi_perform(multi_handle, &place_holder);
+    int numfds;
+    if (mc == CURLM_OK) {
+      // Wait for activity. If there are no descripters in the multi_handle
+      // then curl_multi_wait will return immediately
+      mc = curl_multi_wait(multi_handle, NULL, 0, INT_MAX, &numfds);
+    }
+    if (mc != CURLM_OK) {
+      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                << std::endl;
+    }
+
+    CURLMsg* msg = nullptr;
+    while ((msg = curl_multi_info_read(multi_handle, &place_holder))) {
+      auto itr = ongoing_async_requests_.find(
+          reinterpret_cast<uintptr_t>(msg->easy_handle));
+      if (itr != ongoing_async_requests_.end()) {
+        std::shared_ptr<HttpInferRequest> async_request = itr->second;
+        ongoing_async_requests_.erase(itr);
+        if (msg->data.result == CURLE_OK) {
+          curl_easy_getinfo(
+              msg->easy_handle, CURLINFO_RESPONSE_CODE,
+              &async_request->http_code_);
+        }
+        async_request->Timer().CaptureTimestamp(
+            tc::RequestTimers::Kind::REQUEST_END);
+        UpdateStat(async_request);
+        request_list.emplace_back(std::move(async_request));
+      } else {
+        // This shouldn't happen
+        std::cerr << "Unexpected error: received completed request that is "
+                     "not in the list of asynchronous requests"
+                  << std::endl;
+      }
+      curl_multi_remove_handle(multi_handle, msg->easy_handle);
+      curl_easy_cleanup(msg->easy_handle);
+    }
+    lock.unlock();
+
+    for (auto& this_request : request_list) {
+      InferResult* result;
+      InferResult::Create(&result, this_request);
+      this_request->callback_(result);
+    }
+  } while (!exiting_);
+}
+
+void
+HttpJsonClient::UpdateStat(const std::shared_ptr<HttpInferRequest>& request)
+{
+  tc::Error err = UpdateInferStat(request->Timer());
+  if (!err.IsOk()) {
+    std::cerr << "Failed to update context stat: " << err << std::endl;
+  }
+
+  std::lock_guard<std::mutex> lock(stat_mutex_);
+  if (request->Timer().Timestamp(tc::RequestTimers::Kind::RECV_START) != 0) {
+    response_stat_.cumulative_first_byte_time_ns += request->Timer().Duration(
+        tc::RequestTimers::Kind::REQUEST_START,
+        tc::RequestTimers::Kind::RECV_START);
+  }
+  if (request->event_count_ > 1) {
+    response_stat_.chunk_interval_count += request->event_count_ - 1;
+    response_stat_.cumulative_chunk_interval_ns +=
+        request->last_event_ns_ - request->first_event_ns_;
+  }
+}
+
+size_t
+HttpJsonClient::ReadCallback(
+    char* buffer, size_t size, size_t nitems, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+  size_t input_bytes =
+      std::min(size * nitems, request->body_.size() - request->body_pos_);
+  memcpy(buffer, request->body_.data() + request->body_pos_, input_bytes);
+  request->body_pos_ += input_bytes;
+  if (request->body_pos_ == request->body_.size()) {
+    request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
+  }
+  return input_bytes;
+}
+
+size_t
+HttpJsonClient::ResponseHeaderHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t byte_size = size * nmemb;
+
+  size_t idx = strlen(kContentLengthHTTPHeader);
+  if ((idx < byte_size) && !strncasecmp(buf, kContentLengthHTTPHeader, idx)) {
+    while ((idx < byte_size) && (buf[idx] != ':')) {
+      ++idx;
+    }
+
+    if (idx < byte_size) {
+      std::string hdr(buf + idx + 1, byte_size - idx - 1);
+      request->response_buffer_.reserve(std::stoi(hdr));
+    }
+  }
+
+  idx = strlen(kContentTypeHTTPHeader);
+  if ((idx < byte_size) && !strncasecmp(buf, kContentTypeHTTPHeader, idx)) {
+    std::string hdr(buf + idx, byte_size - idx);
+    request->is_event_stream_ =
+        (hdr.find("text/event-stream") != std::string::npos);
+  }
+
+  return byte_size;
+}
+
+size_t
+HttpJsonClient::ResponseHandler(
+    void* contents, size_t size, size_t nmemb, void* userp)
+{
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+
+  if (request->Timer().Timestamp(tc::RequestTimers::Kind::RECV_START) == 0) {
+    request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::RECV_START);
+  }
+
+  char* buf = reinterpret_cast<char*>(contents);
+  size_t result_bytes = size * nmemb;
+  request->response_buffer_.append(buf, result_bytes);
+
+  // ResponseHandler may be called multiple times so we overwrite
+  // RECV_END so that we always have the time of the last.
+  const uint64_t now =
+      request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::RECV_END);
+
+  if (request->is_event_stream_) {
+    const size_t events = request->event_parser_.Feed(buf, result_bytes);
+    if (events != 0) {
+      if (request->event_count_ == 0) {
+        request->first_event_ns_ = now;
+      }
+      request->last_event_ns_ = now;
+      request->event_count_ += events;
+    }
+  }
+
+  return result_bytes;
+}
+
+Error
+HttpJsonClient::PreRunProcessing(
+    void* vcurl, const Headers& headers,
+    std::shared_ptr<HttpInferRequest>& http_request)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+
+  curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
+  curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+  curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  curl_easy_setopt(curl, CURLOPT_POST, 1L);
+
+  if (verbose_) {
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
+  }
+
+  // request data provided by ReadCallback()
+  curl_easy_setopt(curl, CURLOPT_READFUNCTION, ReadCallback);
+  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
+  curl_easy_setopt(
+      curl, CURLOPT_POSTFIELDSIZE_LARGE,
+      (curl_off_t)http_request->body_.size());
+
+  // response headers handled by ResponseHeaderHandler()
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, ResponseHeaderHandler);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
+
+  // response data handled by ResponseHandler()
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, ResponseHandler);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
+
+  // Skip the 'Expect: 100-continue' round trip for large bodies
+  struct curl_slist* list = nullptr;
+  list = curl_slist_append(list, "Expect:");
+  list = curl_slist_append(list, "Content-Type: application/json");
+  for (const auto& pr : headers) {
+    std::string hdr = pr.first + ": " + pr.second;
+    list = curl_slist_append(list, hdr.c_str());
+  }
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+
+  // The list will be freed when the request is destructed
+  http_request->header_list_ = list;
+
+  if (verbose_) {
+    std::cout << "request : " << http_request->body_ << std::endl;
+  }
+
+  return Error::Success;
+}
+
+HttpJsonClient::HttpJsonClient(const std::string& url, bool verbose)
+    : InferenceServerClient(verbose), url_(url),
+      easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
+      multi_handle_(reinterpret_cast<void*>(curl_multi_init()))
+{
+}
+
+HttpJsonClient::~HttpJsonClient()
+{
+  exiting_ = true;
+
+  // thread not joinable if AsyncInfer() is not called
+  if (worker_.joinable()) {
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  if (easy_handle_ != nullptr) {
+    curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
+  }
+
+  if (multi_handle_ != nullptr) {
+    CURLM* multi_handle = reinterpret_cast<CURLM*>(multi_handle_);
+    for (auto& request : ongoing_async_requests_) {
+      CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
+      curl_multi_remove_handle(multi_handle, easy_handle);
+      curl_easy_cleanup(easy_handle);
+    }
+    curl_multi_cleanup(multi_handle);
+  }
+}
+
+//======================================================================
+
+Error
+InferResult::Create(
+    InferResult** infer_result, std::shared_ptr<HttpInferRequest> infer_request)
+{
+  *infer_result = new InferResult(infer_request);
+  return Error::Success;
+}
+
+Error
+InferResult::RequestStatus() const
+{
+  return status_;
+}
+
+InferResult::InferResult(std::shared_ptr<HttpInferRequest> infer_request)
+    : infer_request_(infer_request)
+{
+  if (infer_request->http_code_ != 200) {
+    status_ = Error(
+        "request failed with error code " +
+        std::to_string(infer_request->http_code_));
+  }
+}
+
+//======================================================================
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
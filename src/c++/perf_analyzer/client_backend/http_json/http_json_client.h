@@ -0,0 +1,250 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <curl/curl.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../client_backend.h"
+#include "common.h"
+
+
+namespace tc = triton::client;
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+class InferResult;
+class HttpInferRequest;
+
+using HttpJsonOnCompleteFn = std::function<void(InferResult*)>;
+
+//==============================================================================
+/// The body of the requests, given as a JSON template. Each '{{NAME}}'
+/// placeholder in the template is replaced by the data of the input NAME,
+/// escaped so that it can be placed inside a JSON string.
+///
+class RequestTemplate {
+ public:
+  /// Parses the template.
+  /// \param text The JSON text of the template.
+  /// \param request_template Returns the parsed template.
+  /// \return Error object indicating success or failure.
+  static Error Parse(
+      const std::string& text, RequestTemplate* request_template);
+
+  /// \return The names of the inputs of the template, in the order of their
+  /// first placeholder.
+  const std::vector<std::string>& InputNames() const { return input_names_; }
+
+  /// Renders the body of a request.
+  /// \param input_data The data of each input, in the order of InputNames().
+  /// \param body Returns the body.
+  void Render(
+      const std::vector<std::string>& input_data, std::string* body) const;
+
+ private:
+  // The text before each placeholder, followed by the text after the last one
+  std::vector<std::string> literals_;
+  // The index in input_names_ of each placeholder
+  std::vector<size_t> placeholders_;
+  std::vector<std::string> input_names_;
+};
+
+//==============================================================================
+/// Counts the events of a server-sent event stream as it arrives. An event
+/// ends with an empty line. The '[DONE]' event that ends OpenAI streams
+/// carries no response, so it is not counted.
+///
+class ServerSentEventParser {
+ public:
+  /// Parses the next chunk of the stream.
+  /// \return The number of events that the chunk completes.
+  size_t Feed(const char* data, size_t size);
+
+ private:
+  // Only the start of a line is needed to tell what it holds
+  static constexpr size_t MAX_LINE_PREFIX = 16;
+
+  /// \return Whether the line completes an event.
+  bool EndLine();
+
+  std::string line_prefix_;
+  size_t line_size_{0};
+  char line_last_{'\0'};
+  bool event_has_data_{false};
+  bool event_is_done_{false};
+};
+
+//==============================================================================
+/// The cumulative timing of the responses beyond the statistics of
+/// tc::InferStat.
+///
+struct ResponseStat {
+  /// Time from the request start until the first byte of the response is
+  /// received.
+  uint64_t cumulative_first_byte_time_ns{0};
+  /// Number of intervals between consecutive events of the streamed
+  /// responses.
+  size_t chunk_interval_count{0};
+  /// Total duration of these intervals.
+  uint64_t cumulative_chunk_interval_ns{0};
+};
+
+//==============================================================================
+/// An HttpJsonClient object posts JSON requests to an HTTP endpoint using
+/// libcurl. Responses sent as server-sent events are timed event by event.
+/// None of the functions are thread safe, except that the callbacks of
+/// asynchronous requests are invoked on a separate worker thread.
+///
+class HttpJsonClient : public tc::InferenceServerClient {
+ public:
+  ~HttpJsonClient();
+
+  /// Create a client that can be used to communicate with the server.
+  /// \param client Returns a new HttpJsonClient object.
+  /// \param url The URL of the endpoint the requests are posted to.
+  /// \param verbose If true generate verbose output when contacting
+  /// the server.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<HttpJsonClient>* client, const std::string& url,
+      const bool verbose);
+
+  /// Run a synchronous request.
+  /// \param result Returns the result of the request.
+  /// \param body The JSON body of the request.
+  /// \param headers Additional HTTP headers to include in the request.
+  /// \return Error object indicating success or failure of the request.
+  Error Infer(InferResult** result, std::string&& body, const Headers& headers);
+
+  /// Run an asynchronous request. Once the request is completed, the
+  /// InferResult pointer will be passed to the provided 'callback' function,
+  /// which then owns the InferResult object.
+  /// \param callback The callback function to be invoked on request
+  /// completion.
+  /// \param body The JSON body of the request.
+  /// \param headers Additional HTTP headers to include in the request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      HttpJsonOnCompleteFn callback, std::string&& body,
+      const Headers& headers);
+
+  /// Obtain the cumulative response timing of the client.
+  /// \param response_stat Returns the current timing.
+  /// \return Error object indicating success or failure.
+  Error ClientResponseStat(ResponseStat* response_stat) const;
+
+ private:
+  HttpJsonClient(const std::string& url, bool verbose);
+  Error PreRunProcessing(
+      void* curl, const Headers& headers,
+      std::shared_ptr<HttpInferRequest>& request);
+  void AsyncTransfer();
+  // Update the statistics with the completed request
+  void UpdateStat(const std::shared_ptr<HttpInferRequest>& request);
+
+  static size_t ReadCallback(
+      char* buffer, size_t size, size_t nitems, void* userp);
+  static size_t ResponseHeaderHandler(
+      void* contents, size_t size, size_t nmemb, void* userp);
+  static size_t ResponseHandler(
+      void* contents, size_t size, size_t nmemb, void* userp);
+
+  // The URL of the endpoint
+  const std::string url_;
+  // curl easy handle shared for all synchronous requests.
+  void* easy_handle_;
+  // curl multi handle for processing asynchronous requests.
+  void* multi_handle_;
+  // Asynchronous requests being processed keyed by their easy handle.
+  std::map<uintptr_t, std::shared_ptr<HttpInferRequest>>
+      ongoing_async_requests_;
+  // The response timing of the client, protected by stat_mutex_
+  ResponseStat response_stat_;
+  mutable std::mutex stat_mutex_;
+};
+
+//======================================================================
+
+class HttpInferRequest {
+ public:
+  HttpInferRequest(std::string&& body, HttpJsonOnCompleteFn callback = nullptr);
+  ~HttpInferRequest();
+  tc::RequestTimers& Timer() { return timer_; }
+  const std::string& Response() const { return response_buffer_; }
+  friend HttpJsonClient;
+  friend InferResult;
+
+ private:
+  // The body of the request and the position of the next byte to send.
+  const std::string body_;
+  size_t body_pos_{0};
+  // Pointer to the list of the HTTP request header, keep it such that it will
+  // be valid during the transfer and can be freed once transfer is completed.
+  struct curl_slist* header_list_{nullptr};
+  // HTTP response code for the request
+  long http_code_{400};
+  // Buffer that accumulates the response body.
+  std::string response_buffer_;
+  // The timers for the request.
+  tc::RequestTimers timer_;
+  // Whether the response is a stream of server-sent events
+  bool is_event_stream_{false};
+  ServerSentEventParser event_parser_;
+  // The number of events received, and the time of the first and last ones
+  size_t event_count_{0};
+  uint64_t first_event_ns_{0};
+  uint64_t last_event_ns_{0};
+  // The callback of an asynchronous request.
+  HttpJsonOnCompleteFn callback_;
+};
+
+//======================================================================
+
+class InferResult {
+ public:
+  static Error Create(
+      InferResult** infer_result,
+      std::shared_ptr<HttpInferRequest> infer_request);
+  Error RequestStatus() const;
+  const std::string& Response() const { return infer_request_->Response(); }
+
+ private:
+  InferResult(std::shared_ptr<HttpInferRequest> infer_request);
+
+  // The status of the request
+  Error status_;
+  // The pointer to the HttpInferRequest object
+  std::shared_ptr<HttpInferRequest> infer_request_;
+};
+
+//======================================================================
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
@@ -0,0 +1,233 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "http_json_client_backend.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+namespace {
+
+void
+AppendJsonString(const std::string& str, std::string* json)
+{
+  json->push_back('"');
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      json->push_back('\\');
+    }
+    json->push_back(c);
+  }
+  json->push_back('"');
+}
+
+}  // namespace
+
+//==============================================================================
+
+Error
+HttpJsonClientBackend::Create(
+    const std::string& url, const ProtocolType protocol,
+    const std::string& request_template,
+    std::shared_ptr<Headers> http_headers, const bool verbose,
+    std::unique_ptr<ClientBackend>* client_backend)
+{
+  if (protocol == ProtocolType::GRPC) {
+    return Error(
+        "perf_analyzer does not support gRPC protocol with the HTTP JSON "
+        "service kind");
+  }
+
+  std::ifstream in(request_template);
+  if (!in) {
+    return Error(
+        "failed to open request template '" + request_template + "'",
+        pa::GENERIC_ERROR);
+  }
+  std::stringstream template_text;
+  template_text << in.rdbuf();
+
+  std::unique_ptr<HttpJsonClientBackend> http_json_client_backend(
+      new HttpJsonClientBackend(http_headers));
+  RETURN_IF_CB_ERROR(RequestTemplate::Parse(
+      template_text.str(), &(http_json_client_backend->request_template_)));
+  RETURN_IF_CB_ERROR(hj::HttpJsonClient::Create(
+      &(http_json_client_backend->http_client_), url, verbose));
+  *client_backend = std::move(http_json_client_backend);
+  return Error::Success;
+}
+
+Error
+HttpJsonClientBackend::ModelMetadata(
+    rapidjson::Document* model_metadata, const std::string& model_name,
+    const std::string& model_version)
+{
+  std::string metadata = "{\"name\":";
+  AppendJsonString(model_name, &metadata);
+  metadata += ",\"platform\":\"http_json\",\"inputs\":[";
+  const auto& input_names = request_template_.InputNames();
+  for (size_t i = 0; i < input_names.size(); i++) {
+    if (i != 0) {
+      metadata.push_back(',');
+    }
+    metadata += "{\"name\":";
+    AppendJsonString(input_names[i], &metadata);
+    metadata += ",\"datatype\":\"BYTES\",\"shape\":[1]}";
+  }
+  metadata += "],\"outputs\":[]}";
+
+  model_metadata->Parse(metadata.c_str(), metadata.size());
+  if (model_metadata->HasParseError()) {
+    return Error(
+        "failed to build the metadata of the request template",
+        pa::GENERIC_ERROR);
+  }
+  return Error::Success;
+}
+
+Error
+HttpJsonClientBackend::Infer(
+    cb::InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::string body;
+  RETURN_IF_CB_ERROR(RenderBody(inputs, &body));
+  hj::InferResult* http_json_result;
+  RETURN_IF_CB_ERROR(
+      http_client_->Infer(&http_json_result, std::move(body), *http_headers_));
+  *result = new HttpJsonInferResult(http_json_result);
+  return Error::Success;
+}
+
+Error
+HttpJsonClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  auto wrapped_callback = [callback](hj::InferResult* client_result) {
+    cb::InferResult* result = new HttpJsonInferResult(client_result);
+    callback(result);
+  };
+
+  std::string body;
+  RETURN_IF_CB_ERROR(RenderBody(inputs, &body));
+  RETURN_IF_CB_ERROR(http_client_->AsyncInfer(
+      wrapped_callback, std::move(body), *http_headers_));
+
+  return Error::Success;
+}
+
+Error
+HttpJsonClientBackend::ClientInferStat(InferStat* infer_stat)
+{
+  // Reusing the common library utilities to collect and report the
+  // client side statistics.
+  tc::InferStat client_infer_stat;
+  tc::Error err = http_client_->ClientInferStat(&client_infer_stat);
+  if (!err.IsOk()) {
+    return Error(err.Message(), pa::GENERIC_ERROR);
+  }
+  ResponseStat response_stat;
+  RETURN_IF_CB_ERROR(http_client_->ClientResponseStat(&response_stat));
+
+  infer_stat->completed_request_count =
+      client_infer_stat.completed_request_count;
+  infer_stat->cumulative_total_request_time_ns =
+      client_infer_stat.cumulative_total_request_time_ns;
+  infer_stat->cumulative_send_time_ns =
+      client_infer_stat.cumulative_send_time_ns;
+  infer_stat->cumulative_receive_time_ns =
+      client_infer_stat.cumulative_receive_time_ns;
+  infer_stat->cumulative_first_byte_time_ns =
+      response_stat.cumulative_first_byte_time_ns;
+  infer_stat->response_chunk_interval_count =
+      response_stat.chunk_interval_count;
+  infer_stat->cumulative_response_chunk_interval_ns =
+      response_stat.cumulative_chunk_interval_ns;
+  return Error::Success;
+}
+
+Error
+HttpJsonClientBackend::RenderBody(
+    const std::vector<InferInput*>& inputs, std::string* body)
+{
+  const auto& input_names = request_template_.InputNames();
+  std::vector<std::string> input_data(input_names.size());
+  for (const auto input : inputs) {
+    const auto it =
+        std::find(input_names.begin(), input_names.end(), input->Name());
+    if (it == input_names.end()) {
+      return Error(
+          "input '" + input->Name() + "' is not in the request template",
+          pa::GENERIC_ERROR);
+    }
+    RETURN_IF_CB_ERROR(dynamic_cast<HttpJsonInferInput*>(input)->Text(
+        &input_data[it - input_names.begin()]));
+  }
+  request_template_.Render(input_data, body);
+  return Error::Success;
+}
+
+//==============================================================================
+
+HttpJsonInferResult::HttpJsonInferResult(hj::InferResult* result)
+{
+  result_.reset(result);
+}
+
+Error
+HttpJsonInferResult::Id(std::string* id) const
+{
+  id->clear();
+  return Error::Success;
+}
+
+Error
+HttpJsonInferResult::RequestStatus() const
+{
+  RETURN_IF_CB_ERROR(result_->RequestStatus());
+  return Error::Success;
+}
+
+Error
+HttpJsonInferResult::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  return Error(
+      "Output retrieval is not currently supported for HTTP JSON client "
+      "backend");
+}
+
+//==============================================================================
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
@@ -0,0 +1,120 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <string>
+#include "../../perf_utils.h"
+#include "../client_backend.h"
+#include "http_json_client.h"
+#include "http_json_infer_input.h"
+
+namespace tc = triton::client;
+namespace cb = triton::perfanalyzer::clientbackend;
+namespace hj = triton::perfanalyzer::clientbackend::httpjson;
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+
+//==============================================================================
+/// HttpJsonClientBackend is used to generate load on any HTTP endpoint that
+/// accepts JSON requests, such as an OpenAI-compatible server. The body of
+/// each request is rendered from a template with the data of the inputs.
+///
+class HttpJsonClientBackend : public ClientBackend {
+ public:
+  /// Create an HTTP JSON client backend which can be used to interact with
+  /// the server.
+  /// \param url The URL of the endpoint the requests are posted to.
+  /// \param protocol The protocol type used.
+  /// \param request_template Path to the JSON template of the request body.
+  /// \param http_headers Map of HTTP headers. The map key/value indicates
+  /// the header name/value.
+  /// \param verbose Enables the verbose mode.
+  /// \param client_backend Returns a new HttpJsonClientBackend object.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      const std::string& url, const ProtocolType protocol,
+      const std::string& request_template,
+      std::shared_ptr<Headers> http_headers, const bool verbose,
+      std::unique_ptr<ClientBackend>* client_backend);
+
+  /// See ClientBackend::ModelMetadata(). The inputs of the model are the
+  /// placeholders of the request template.
+  Error ModelMetadata(
+      rapidjson::Document* model_metadata, const std::string& model_name,
+      const std::string& model_version) override;
+
+  /// See ClientBackend::Infer()
+  Error Infer(
+      cb::InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::AsyncInfer()
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::ClientInferStat()
+  Error ClientInferStat(InferStat* infer_stat) override;
+
+ private:
+  HttpJsonClientBackend(std::shared_ptr<Headers> http_headers)
+      : ClientBackend(BackendKind::HTTP_JSON), http_headers_(http_headers)
+  {
+  }
+
+  /// Renders the body of a request from the data of the inputs.
+  Error RenderBody(const std::vector<InferInput*>& inputs, std::string* body);
+
+  std::unique_ptr<hj::HttpJsonClient> http_client_;
+  std::shared_ptr<Headers> http_headers_;
+  RequestTemplate request_template_;
+};
+
+//==============================================================
+/// HttpJsonInferResult is a wrapper around InferResult object of
+/// the HTTP JSON client.
+///
+class HttpJsonInferResult : public cb::InferResult {
+ public:
+  explicit HttpJsonInferResult(hj::InferResult* result);
+  /// See InferResult::Id()
+  Error Id(std::string* id) const override;
+  /// See InferResult::RequestStatus()
+  Error RequestStatus() const override;
+  /// See InferResult::RawData()
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+
+ private:
+  std::unique_ptr<hj::InferResult> result_;
+};
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
@@ -0,0 +1,116 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "http_json_infer_input.h"
+
+#include <cstring>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+
+Error
+HttpJsonInferInput::Create(
+    InferInput** infer_input, const std::string& name,
+    const std::vector<int64_t>& dims, const std::string& datatype)
+{
+  HttpJsonInferInput* local_infer_input =
+      new HttpJsonInferInput(name, dims, datatype);
+  *infer_input = local_infer_input;
+  return Error::Success;
+}
+
+Error
+HttpJsonInferInput::SetShape(const std::vector<int64_t>& shape)
+{
+  shape_ = shape;
+  return Error::Success;
+}
+
+Error
+HttpJsonInferInput::Reset()
+{
+  bufs_.clear();
+  buf_byte_sizes_.clear();
+  byte_size_ = 0;
+  return Error::Success;
+}
+
+Error
+HttpJsonInferInput::AppendRaw(const uint8_t* input, size_t input_byte_size)
+{
+  byte_size_ += input_byte_size;
+  bufs_.push_back(input);
+  buf_byte_sizes_.push_back(input_byte_size);
+  return Error::Success;
+}
+
+Error
+HttpJsonInferInput::ByteSize(size_t* byte_size) const
+{
+  *byte_size = byte_size_;
+  return Error::Success;
+}
+
+Error
+HttpJsonInferInput::Text(std::string* text) const
+{
+  text->clear();
+  if (Type() != DataType::BYTES) {
+    for (size_t i = 0; i < bufs_.size(); i++) {
+      text->append(
+          reinterpret_cast<const char*>(bufs_[i]), buf_byte_sizes_[i]);
+    }
+    return Error::Success;
+  }
+
+  // Each element is serialized as its 4-byte length followed by its bytes,
+  // and the buffers hold whole elements
+  for (size_t i = 0; i < bufs_.size(); i++) {
+    const char* buf = reinterpret_cast<const char*>(bufs_[i]);
+    size_t pos = 0;
+    while (pos + sizeof(uint32_t) <= buf_byte_sizes_[i]) {
+      uint32_t element_size;
+      memcpy(&element_size, buf + pos, sizeof(uint32_t));
+      pos += sizeof(uint32_t);
+      if (pos + element_size > buf_byte_sizes_[i]) {
+        return Error("malformed BYTES data for input '" + Name() + "'");
+      }
+      text->append(buf + pos, element_size);
+      pos += element_size;
+    }
+  }
+  return Error::Success;
+}
+
+HttpJsonInferInput::HttpJsonInferInput(
+    const std::string& name, const std::vector<int64_t>& dims,
+    const std::string& datatype)
+    : InferInput(BackendKind::HTTP_JSON, name, datatype), shape_(dims)
+{
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
@@ -0,0 +1,133 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+#include <vector>
+#include "../../doctest.h"
+#include "http_json_client.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace httpjson {
+
+TEST_CASE("RequestTemplate: rendering the inputs")
+{
+  RequestTemplate request_template;
+
+  SUBCASE("placeholders in strings")
+  {
+    REQUIRE(RequestTemplate::Parse(
+                "{\"model\": \"m\", \"prompt\": \"{{PROMPT}} and {{SUFFIX}}\", "
+                "\"echo\": \"{{PROMPT}}\"}",
+                &request_template)
+                .IsOk());
+    CHECK(
+        request_template.InputNames() ==
+        std::vector<std::string>{"PROMPT", "SUFFIX"});
+
+    std::string body;
+    request_template.Render({"say \"hi\"\n", "a\\b"}, &body);
+    CHECK(
+        body ==
+        "{\"model\": \"m\", \"prompt\": \"say \\\"hi\\\"\\n and a\\\\b\", "
+        "\"echo\": \"say \\\"hi\\\"\\n\"}");
+  }
+
+  SUBCASE("no placeholders")
+  {
+    REQUIRE(RequestTemplate::Parse("{\"a\": 1}", &request_template).IsOk());
+    CHECK(request_template.InputNames().empty());
+
+    std::string body;
+    request_template.Render({}, &body);
+    CHECK(body == "{\"a\": 1}");
+  }
+
+  SUBCASE("control characters")
+  {
+    REQUIRE(
+        RequestTemplate::Parse("{\"a\": \"{{IN}}\"}", &request_template)
+            .IsOk());
+
+    std::string body;
+    request_template.Render({std::string("\t\x01", 2)}, &body);
+    CHECK(body == "{\"a\": \"\\t\\u0001\"}");
+  }
+
+  SUBCASE("invalid JSON")
+  {
+    CHECK_FALSE(
+        RequestTemplate::Parse("{\"a\": {{IN}}", &request_template).IsOk());
+  }
+
+  SUBCASE("invalid placeholder")
+  {
+    CHECK_FALSE(
+        RequestTemplate::Parse("{\"a\": \"{{I N}}\"}", &request_template)
+            .IsOk());
+    CHECK_FALSE(
+        RequestTemplate::Parse("{\"a\": \"{{}}\"}", &request_template).IsOk());
+  }
+}
+
+TEST_CASE("ServerSentEventParser: counting the events")
+{
+  ServerSentEventParser parser;
+
+  SUBCASE("whole events")
+  {
+    CHECK(parser.Feed("data: {\"a\": 1}\n\n", 16) == 1);
+    const std::string events = "data: {\"b\": 2}\r\n\r\ndata: {\"c\": 3}\n\n";
+    CHECK(parser.Feed(events.data(), events.size()) == 2);
+  }
+
+  SUBCASE("events split across chunks")
+  {
+    const std::string stream =
+        "event: message\ndata: {\"a\": 1}\ndata: {\"b\": 2}\n\n"
+        "data: {\"c\": 3}\n\n";
+    size_t events = 0;
+    for (const char c : stream) {
+      events += parser.Feed(&c, 1);
+    }
+    CHECK(events == 2);
+  }
+
+  SUBCASE("comments and done")
+  {
+    const std::string stream =
+        ": keep-alive\n\ndata: {\"a\": 1}\n\ndata: [DONE]\n\n";
+    CHECK(parser.Feed(stream.data(), stream.size()) == 1);
+  }
+
+  SUBCASE("long data line starting like done")
+  {
+    const std::string stream =
+        "data: [DONE] " + std::string(100, 'x') + "\n\n";
+    CHECK(parser.Feed(stream.data(), stream.size()) == 1);
+  }
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::httpjson
@@ -512,7 +512,8 @@ class MockClientBackend : public ClientBackend {
   }
 
   Error MapSharedMemory(
-      int shm_fd, size_t offset, size_t byte_size, void** shm_addr) override
+      int shm_fd, size_t offset, size_t byte_size,
+      const SharedMemoryOptions& options, void** shm_addr) override
   {
     stats_->memory_stats.num_map_shared_memory_calls++;
     return Error::Success;
@@ -576,6 +577,12 @@ class MockClientBackendFactory : public ClientBackendFactory {
     return Error::Success;
   }
 
+  Error CreateEndpointClientBackend(
+      const std::string& url, std::unique_ptr<ClientBackend>* backend) override
+  {
+    return CreateClientBackend(backend);
+  }
+
  private:
   std::shared_ptr<MockClientStats> stats_;
 };
@@ -0,0 +1,155 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "null_server.h"
+
+#include <algorithm>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullserver {
+
+std::shared_ptr<NullServer>
+NullServer::Get(const NullServerOptions& options)
+{
+  static std::mutex mutex;
+  static std::weak_ptr<NullServer> instance;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<NullServer> server = instance.lock();
+  if (server == nullptr) {
+    server = std::make_shared<NullServer>(options);
+    instance = server;
+  }
+  return server;
+}
+
+NullServer::NullServer(const NullServerOptions& options) : options_(options)
+{
+  scheduler_ = std::thread(&NullServer::Schedule, this);
+}
+
+NullServer::~NullServer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_one();
+  scheduler_.join();
+}
+
+void
+NullServer::Enqueue(size_t batch_size, std::function<void()> complete)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(Request{batch_size, Clock::now(), std::move(complete)});
+  }
+  cv_.notify_one();
+}
+
+bool
+NullServer::FormBatch(
+    const Clock::time_point& now, std::vector<Request>* batch,
+    Clock::time_point* wake)
+{
+  size_t count = 1;
+  if (options_.max_batch_size != 0) {
+    // Add requests while they fit, a request larger than the maximum
+    // batch size runs on its own
+    size_t batch_size = pending_.front().batch_size;
+    while ((count < pending_.size()) &&
+           (batch_size + pending_[count].batch_size <=
+            options_.max_batch_size)) {
+      batch_size += pending_[count].batch_size;
+      count++;
+    }
+    const bool full =
+        (count < pending_.size()) || (batch_size >= options_.max_batch_size);
+    const Clock::time_point deadline =
+        pending_.front().enqueue_time +
+        std::chrono::microseconds(options_.batch_delay_us);
+    if (!full && (now < deadline)) {
+      *wake = std::min(*wake, deadline);
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    batch->push_back(std::move(pending_.front()));
+    pending_.pop_front();
+  }
+  return true;
+}
+
+void
+NullServer::Schedule()
+{
+  const std::chrono::microseconds latency(options_.latency_us);
+  std::vector<Request> completed;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!exiting_) {
+    const Clock::time_point now = Clock::now();
+    while (!running_.empty() && (running_.begin()->first <= now)) {
+      for (auto& request : running_.begin()->second) {
+        completed.push_back(std::move(request));
+      }
+      running_.erase(running_.begin());
+    }
+
+    Clock::time_point wake = Clock::time_point::max();
+    while (!pending_.empty() && ((options_.instance_count == 0) ||
+                                 (running_.size() < options_.instance_count))) {
+      std::vector<Request> batch;
+      if (!FormBatch(now, &batch, &wake)) {
+        break;
+      }
+      running_.emplace(now + latency, std::move(batch));
+    }
+
+    if (!completed.empty()) {
+      lock.unlock();
+      for (auto& request : completed) {
+        request.complete();
+      }
+      completed.clear();
+      lock.lock();
+      continue;
+    }
+
+    if (!running_.empty()) {
+      wake = std::min(wake, running_.begin()->first);
+    }
+    if (wake == Clock::time_point::max()) {
+      cv_.wait(lock);
+    } else if (wake > now) {
+      cv_.wait_until(lock, wake);
+    }
+  }
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullserver
@@ -0,0 +1,98 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../client_backend.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullserver {
+
+//==============================================================================
+/// NullServer simulates an inference server in the process of perf_analyzer.
+/// Requests are batched like the dynamic batcher of Triton, and each batch
+/// completes after the configured latency. A single thread schedules the
+/// batches and runs the completions, so the load generator can be measured
+/// without a network or a server in the way.
+///
+class NullServer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Returns the server shared by all the backends of the process, creating
+  /// it on first use.
+  /// \param options The behavior of the simulated server. Only the options
+  /// of the backend that creates the server are used.
+  /// \return The shared server.
+  static std::shared_ptr<NullServer> Get(const NullServerOptions& options);
+
+  explicit NullServer(const NullServerOptions& options);
+  ~NullServer();
+
+  /// Queues a request.
+  /// \param batch_size The number of samples of the request.
+  /// \param complete The function called on the scheduler thread once the
+  /// batch of the request has completed.
+  void Enqueue(size_t batch_size, std::function<void()> complete);
+
+  const NullServerOptions& Options() const { return options_; }
+
+ private:
+  struct Request {
+    size_t batch_size;
+    Clock::time_point enqueue_time;
+    std::function<void()> complete;
+  };
+
+  void Schedule();
+
+  /// Moves the pending requests that can be run now into a batch. Returns
+  /// false if the requests should wait for the batch to fill, and sets
+  /// 'wake' to the time the oldest request stops waiting.
+  bool FormBatch(
+      const Clock::time_point& now, std::vector<Request>* batch,
+      Clock::time_point* wake);
+
+  const NullServerOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> pending_;
+  // The batches being executed, by completion time
+  std::multimap<Clock::time_point, std::vector<Request>> running_;
+  bool exiting_{false};
+  std::thread scheduler_;
+};
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullserver
@@ -0,0 +1,225 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "null_server_client_backend.h"
+
+#include <chrono>
+#include <future>
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullserver {
+
+namespace {
+
+// The number of elements of the input of the simulated model
+constexpr int64_t kInputElementCount = 16;
+
+Error
+ParseJson(
+    const std::string& json, const std::string& what,
+    rapidjson::Document* document)
+{
+  document->Parse(json.c_str(), json.size());
+  if (document->HasParseError()) {
+    return Error(
+        "failed to build the " + what + " of the null server model",
+        pa::GENERIC_ERROR);
+  }
+  return Error::Success;
+}
+
+}  // namespace
+
+//==============================================================================
+
+Error
+NullServerClientBackend::Create(
+    const NullServerOptions& options,
+    std::unique_ptr<ClientBackend>* client_backend)
+{
+  client_backend->reset(
+      new NullServerClientBackend(NullServer::Get(options)));
+  return Error::Success;
+}
+
+NullServerClientBackend::~NullServerClientBackend()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return in_flight_count_ == 0; });
+}
+
+Error
+NullServerClientBackend::ModelMetadata(
+    rapidjson::Document* model_metadata, const std::string& model_name,
+    const std::string& model_version)
+{
+  const bool batching = (server_->Options().max_batch_size != 0);
+  const std::string metadata =
+      "{\"name\":\"" + model_name +
+      "\",\"versions\":[\"1\"],\"platform\":\"null_server\","
+      "\"inputs\":[{\"name\":\"INPUT0\",\"datatype\":\"INT32\",\"shape\":[" +
+      (batching ? "-1," : "") + std::to_string(kInputElementCount) +
+      "]}],\"outputs\":[]}";
+  return ParseJson(metadata, "metadata", model_metadata);
+}
+
+Error
+NullServerClientBackend::ModelConfig(
+    rapidjson::Document* model_config, const std::string& model_name,
+    const std::string& model_version)
+{
+  const size_t max_batch_size = server_->Options().max_batch_size;
+  std::string config = "{\"name\":\"" + model_name +
+                       "\",\"platform\":\"null_server\",\"max_batch_size\":" +
+                       std::to_string(max_batch_size) +
+                       ",\"input\":[{\"name\":\"INPUT0\",\"data_type\":"
+                       "\"TYPE_INT32\",\"dims\":[" +
+                       std::to_string(kInputElementCount) + "]}]";
+  if (max_batch_size != 0) {
+    config += ",\"dynamic_batching\":{}";
+  }
+  config += "}";
+  return ParseJson(config, "config", model_config);
+}
+
+Error
+NullServerClientBackend::Infer(
+    InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  auto promise = std::make_shared<std::promise<InferResult*>>();
+  std::future<InferResult*> future = promise->get_future();
+  Send(options, inputs, [promise](InferResult* completed_result) {
+    promise->set_value(completed_result);
+  });
+  *result = future.get();
+  return Error::Success;
+}
+
+Error
+NullServerClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  Send(options, inputs, callback);
+  return Error::Success;
+}
+
+Error
+NullServerClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
+{
+  stream_callback_ = callback;
+  return Error::Success;
+}
+
+Error
+NullServerClientBackend::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (!stream_callback_) {
+    return Error("stream not started", pa::GENERIC_ERROR);
+  }
+  Send(options, inputs, stream_callback_);
+  return Error::Success;
+}
+
+Error
+NullServerClientBackend::ClientInferStat(InferStat* infer_stat)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  *infer_stat = infer_stat_;
+  return Error::Success;
+}
+
+void
+NullServerClientBackend::Send(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    OnCompleteFn callback)
+{
+  // The batch dimension is the first one of every input
+  size_t batch_size = 1;
+  if ((server_->Options().max_batch_size != 0) && !inputs.empty() &&
+      !inputs[0]->Shape().empty()) {
+    batch_size = inputs[0]->Shape()[0];
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_count_++;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::string id = options.request_id_;
+  server_->Enqueue(batch_size, [this, start, id, callback]() {
+    const uint64_t request_time_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      infer_stat_.completed_request_count++;
+      infer_stat_.cumulative_total_request_time_ns += request_time_ns;
+    }
+
+    callback(new NullServerInferResult(id));
+
+    // Notifies while holding the lock, the backend may be destroyed as soon
+    // as the count drops to zero
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_count_--;
+    cv_.notify_all();
+  });
+}
+
+//==============================================================================
+
+Error
+NullServerInferResult::Id(std::string* id) const
+{
+  *id = id_;
+  return Error::Success;
+}
+
+Error
+NullServerInferResult::RequestStatus() const
+{
+  return Error::Success;
+}
+
+Error
+NullServerInferResult::RawData(
+    const std::string& output_name, const uint8_t** buf,
+    size_t* byte_size) const
+{
+  return Error("the null server model has no outputs", pa::GENERIC_ERROR);
+}
+
+//==============================================================================
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullserver
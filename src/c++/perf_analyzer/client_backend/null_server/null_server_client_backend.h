@@ -0,0 +1,134 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include "../../perf_utils.h"
+#include "../client_backend.h"
+#include "null_server.h"
+#include "null_server_infer_input.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullserver {
+
+//==============================================================================
+/// NullServerClientBackend sends the requests to a NullServer in the same
+/// process instead of an inference server. It measures the ceiling of the
+/// load generator itself: the throughput it can sustain, how closely it
+/// follows the schedule and its overhead per request.
+///
+/// The simulated model has a single INT32 input INPUT0 of 16 elements and
+/// no outputs.
+///
+class NullServerClientBackend : public ClientBackend {
+ public:
+  /// Create a null server client backend.
+  /// \param options The behavior of the simulated server.
+  /// \param client_backend Returns a new NullServerClientBackend object.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      const NullServerOptions& options,
+      std::unique_ptr<ClientBackend>* client_backend);
+
+  /// Waits for the requests in flight to complete.
+  ~NullServerClientBackend();
+
+  /// See ClientBackend::ModelMetadata()
+  Error ModelMetadata(
+      rapidjson::Document* model_metadata, const std::string& model_name,
+      const std::string& model_version) override;
+
+  /// See ClientBackend::ModelConfig()
+  Error ModelConfig(
+      rapidjson::Document* model_config, const std::string& model_name,
+      const std::string& model_version) override;
+
+  /// See ClientBackend::Infer()
+  Error Infer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::AsyncInfer()
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::StartStream()
+  Error StartStream(OnCompleteFn callback, bool enable_stats) override;
+
+  /// See ClientBackend::AsyncStreamInfer()
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::ClientInferStat()
+  Error ClientInferStat(InferStat* infer_stat) override;
+
+ private:
+  explicit NullServerClientBackend(std::shared_ptr<NullServer> server)
+      : ClientBackend(BackendKind::NULL_SERVER), server_(server)
+  {
+  }
+
+  /// Queues a request on the server, 'callback' is called with its result.
+  void Send(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      OnCompleteFn callback);
+
+  std::shared_ptr<NullServer> server_;
+  OnCompleteFn stream_callback_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t in_flight_count_{0};
+  InferStat infer_stat_;
+};
+
+//==============================================================
+/// NullServerInferResult is the result of a request to the null
+/// server, which carries no output.
+///
+class NullServerInferResult : public InferResult {
+ public:
+  explicit NullServerInferResult(const std::string& id) : id_(id) {}
+  /// See InferResult::Id()
+  Error Id(std::string* id) const override;
+  /// See InferResult::RequestStatus()
+  Error RequestStatus() const override;
+  /// See InferResult::RawData()
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override;
+
+ private:
+  const std::string id_;
+};
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullserver
@@ -0,0 +1,156 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "../../doctest.h"
+#include "null_server.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace nullserver {
+
+namespace {
+
+// Records the order the requests complete in
+class CompletionRecorder {
+ public:
+  std::function<void()> Complete(size_t request)
+  {
+    return [this, request]() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_.push_back(request);
+      times_.push_back(NullServer::Clock::now());
+      cv_.notify_all();
+    };
+  }
+
+  void WaitFor(size_t count)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this, count] { return completed_.size() >= count; });
+  }
+
+  std::vector<size_t> completed_;
+  std::vector<NullServer::Clock::time_point> times_;
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace
+
+TEST_CASE("NullServer: completing the requests")
+{
+  CompletionRecorder recorder;
+
+  SUBCASE("no latency")
+  {
+    NullServer server(NullServerOptions{});
+    for (size_t i = 0; i < 100; i++) {
+      server.Enqueue(1, recorder.Complete(i));
+    }
+    recorder.WaitFor(100);
+    for (size_t i = 0; i < 100; i++) {
+      CHECK(recorder.completed_[i] == i);
+    }
+  }
+
+  SUBCASE("latency")
+  {
+    NullServerOptions options;
+    options.latency_us = 20000;
+    NullServer server(options);
+    const auto start = NullServer::Clock::now();
+    server.Enqueue(1, recorder.Complete(0));
+    recorder.WaitFor(1);
+    CHECK(
+        recorder.times_[0] - start >= std::chrono::microseconds(20000));
+  }
+
+  SUBCASE("one instance runs the batches one after another")
+  {
+    NullServerOptions options;
+    options.latency_us = 10000;
+    options.instance_count = 1;
+    NullServer server(options);
+    const auto start = NullServer::Clock::now();
+    for (size_t i = 0; i < 3; i++) {
+      server.Enqueue(1, recorder.Complete(i));
+    }
+    recorder.WaitFor(3);
+    CHECK(recorder.completed_ == std::vector<size_t>{0, 1, 2});
+    CHECK(
+        recorder.times_[2] - start >= std::chrono::microseconds(30000));
+  }
+}
+
+TEST_CASE("NullServer: batching the requests")
+{
+  CompletionRecorder recorder;
+  NullServerOptions options;
+  options.latency_us = 10000;
+  options.max_batch_size = 4;
+  options.instance_count = 1;
+
+  SUBCASE("full batches run at once")
+  {
+    options.batch_delay_us = 1000000;
+    NullServer server(options);
+    const auto start = NullServer::Clock::now();
+    for (size_t i = 0; i < 8; i++) {
+      server.Enqueue(1, recorder.Complete(i));
+    }
+    recorder.WaitFor(8);
+    // Two batches of 4 on one instance, without waiting for the delay
+    CHECK(recorder.times_[7] - start < std::chrono::microseconds(1000000));
+    CHECK(recorder.times_[3] - start >= std::chrono::microseconds(10000));
+    CHECK(recorder.times_[7] - start >= std::chrono::microseconds(20000));
+  }
+
+  SUBCASE("partial batch waits for the delay")
+  {
+    options.batch_delay_us = 50000;
+    NullServer server(options);
+    const auto start = NullServer::Clock::now();
+    server.Enqueue(2, recorder.Complete(0));
+    server.Enqueue(1, recorder.Complete(1));
+    recorder.WaitFor(2);
+    CHECK(recorder.times_[1] - start >= std::chrono::microseconds(60000));
+  }
+
+  SUBCASE("request larger than the batch runs on its own")
+  {
+    NullServer server(options);
+    server.Enqueue(16, recorder.Complete(0));
+    recorder.WaitFor(1);
+    CHECK(recorder.completed_ == std::vector<size_t>{0});
+  }
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::nullserver
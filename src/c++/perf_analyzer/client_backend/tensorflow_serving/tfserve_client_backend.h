@@ -60,6 +60,8 @@ class TFServeClientBackend : public ClientBackend {
   /// \param http_headers Map of HTTP headers. The map key/value indicates
   /// the header name/value.
   /// \param verbose Enables the verbose mode.
+  /// \param tfserving_options The completion queues and the channels the
+  /// client shares with the other clients.
   /// \param client_backend Returns a new TFServeClientBackend
   /// object.
   /// \return Error object indicating success or failure.
@@ -67,6 +69,7 @@ class TFServeClientBackend : public ClientBackend {
       const std::string& url, const ProtocolType protocol,
       const grpc_compression_algorithm compression_algorithm,
       std::shared_ptr<Headers> http_headers, const bool verbose,
+      const TfServingOptions& tfserving_options,
       std::unique_ptr<ClientBackend>* client_backend);
 
   /// See ClientBackend::ModelMetadata()
@@ -26,6 +26,7 @@
 
 #include "tfserve_grpc_client.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
@@ -43,44 +44,53 @@ namespace tfserving {
 
 namespace {
 
-// Use map to keep track of GRPC channels. <key, value> : <url, Channel*>
-// If context is created on url that has established Channel, then reuse it.
-std::map<std::string, std::shared_ptr<grpc::Channel>> grpc_channel_map_;
+// The GRPC channels to a url, which the clients created on the url take in
+// turn.
+struct ChannelPool {
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  size_t next{0};
+};
+
+// Use map to keep track of GRPC channels. <key, value> : <url, ChannelPool>
+// If context is created on url that has established Channels, then reuse
+// them.
+std::map<std::string, ChannelPool> grpc_channel_map_;
 std::mutex grpc_channel_map_mtx_;
 
-void
-GetTensorFlowDataType(const std::string& datatype, tensorflow::DataType* dtype)
+tensorflow::DataType
+GetTensorFlowDataType(DataType type)
 {
-  if (datatype == "FP16") {
-    *dtype = tensorflow::DataType::DT_HALF;
-  } else if (datatype == "BF16") {
-    *dtype = tensorflow::DataType::DT_BFLOAT16;
-  } else if (datatype == "FP32") {
-    *dtype = tensorflow::DataType::DT_FLOAT;
-  } else if (datatype == "FP64") {
-    *dtype = tensorflow::DataType::DT_DOUBLE;
-  } else if (datatype == "INT32") {
-    *dtype = tensorflow::DataType::DT_INT32;
-  } else if (datatype == "INT16") {
-    *dtype = tensorflow::DataType::DT_INT16;
-  } else if (datatype == "UINT16") {
-    *dtype = tensorflow::DataType::DT_UINT16;
-  } else if (datatype == "INT8") {
-    *dtype = tensorflow::DataType::DT_INT8;
-  } else if (datatype == "UINT8") {
-    *dtype = tensorflow::DataType::DT_UINT8;
-  } else if (datatype == "BYTES") {
-    *dtype = tensorflow::DataType::DT_STRING;
-  } else if (datatype == "INT64") {
-    *dtype = tensorflow::DataType::DT_INT64;
-  } else if (datatype == "BOOL") {
-    *dtype = tensorflow::DataType::DT_BOOL;
-  } else if (datatype == "UINT32") {
-    *dtype = tensorflow::DataType::DT_UINT32;
-  } else if (datatype == "UINT64") {
-    *dtype = tensorflow::DataType::DT_UINT64;
-  } else {
-    *dtype = tensorflow::DT_INVALID;
+  switch (type) {
+    case DataType::FP16:
+      return tensorflow::DataType::DT_HALF;
+    case DataType::BF16:
+      return tensorflow::DataType::DT_BFLOAT16;
+    case DataType::FP32:
+      return tensorflow::DataType::DT_FLOAT;
+    case DataType::FP64:
+      return tensorflow::DataType::DT_DOUBLE;
+    case DataType::INT32:
+      return tensorflow::DataType::DT_INT32;
+    case DataType::INT16:
+      return tensorflow::DataType::DT_INT16;
+    case DataType::UINT16:
+      return tensorflow::DataType::DT_UINT16;
+    case DataType::INT8:
+      return tensorflow::DataType::DT_INT8;
+    case DataType::UINT8:
+      return tensorflow::DataType::DT_UINT8;
+    case DataType::BYTES:
+      return tensorflow::DataType::DT_STRING;
+    case DataType::INT64:
+      return tensorflow::DataType::DT_INT64;
+    case DataType::BOOL:
+      return tensorflow::DataType::DT_BOOL;
+    case DataType::UINT32:
+      return tensorflow::DataType::DT_UINT32;
+    case DataType::UINT64:
+      return tensorflow::DataType::DT_UINT64;
+    default:
+      return tensorflow::DT_INVALID;
   }
 }
 
@@ -100,55 +110,117 @@ ReadFile(const std::string& filename, std::string& data)
 }
 
 std::shared_ptr<grpc::Channel>
-GetChannel(const std::string& url, bool use_ssl, const SslOptions& ssl_options)
+CreateChannel(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options)
+{
+  grpc::ChannelArguments arguments;
+  arguments.SetMaxSendMessageSize(tc::MAX_GRPC_MESSAGE_SIZE);
+  arguments.SetMaxReceiveMessageSize(tc::MAX_GRPC_MESSAGE_SIZE);
+  // Channels with the same arguments share one connection, so each channel
+  // gets a distinct argument to open a connection of its own.
+  // NOTE: The argument name "tfserve_client_channel_idx" is arbitrary.
+  static std::atomic<int> channel_count{0};
+  arguments.SetInt("tfserve_client_channel_idx", channel_count.fetch_add(1));
+  std::shared_ptr<grpc::ChannelCredentials> credentials;
+  if (use_ssl) {
+    std::string root;
+    std::string key;
+    std::string cert;
+    ReadFile(ssl_options.root_certificates, root);
+    ReadFile(ssl_options.private_key, key);
+    ReadFile(ssl_options.certificate_chain, cert);
+    grpc::SslCredentialsOptions opts = {root, key, cert};
+    credentials = grpc::SslCredentials(opts);
+  } else {
+    credentials = grpc::InsecureChannelCredentials();
+  }
+  return grpc::CreateCustomChannel(url, credentials, arguments);
+}
+
+// Returns the next of the 'channel_count' channels to 'url', or a new channel
+// of its own if 'channel_count' is 0.
+std::shared_ptr<grpc::Channel>
+GetChannel(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    size_t channel_count)
 {
+  if (channel_count == 0) {
+    return CreateChannel(url, use_ssl, ssl_options);
+  }
+
   std::lock_guard<std::mutex> lock(grpc_channel_map_mtx_);
 
-  const auto& channel_itr = grpc_channel_map_.find(url);
-  if (channel_itr != grpc_channel_map_.end()) {
-    return channel_itr->second;
-  } else {
-    grpc::ChannelArguments arguments;
-    arguments.SetMaxSendMessageSize(tc::MAX_GRPC_MESSAGE_SIZE);
-    arguments.SetMaxReceiveMessageSize(tc::MAX_GRPC_MESSAGE_SIZE);
-    std::shared_ptr<grpc::ChannelCredentials> credentials;
-    if (use_ssl) {
-      std::string root;
-      std::string key;
-      std::string cert;
-      ReadFile(ssl_options.root_certificates, root);
-      ReadFile(ssl_options.private_key, key);
-      ReadFile(ssl_options.certificate_chain, cert);
-      grpc::SslCredentialsOptions opts = {root, key, cert};
-      credentials = grpc::SslCredentials(opts);
-    } else {
-      credentials = grpc::InsecureChannelCredentials();
-    }
-    std::shared_ptr<grpc::Channel> channel =
-        grpc::CreateCustomChannel(url, credentials, arguments);
-    grpc_channel_map_.insert(std::make_pair(url, channel));
-    return channel;
+  ChannelPool& pool = grpc_channel_map_[url];
+  const size_t index = pool.next++ % channel_count;
+  if (index >= pool.channels.size()) {
+    pool.channels.emplace_back(CreateChannel(url, use_ssl, ssl_options));
   }
+  return pool.channels[index];
 }
 
 }  // namespace
 
+//==============================================================================
+// A GrpcArenaPredictRequest is a PredictRequest allocated on its own protobuf
+// arena. The message is reused across requests so the input submessages and
+// their content strings keep their allocations, and the arena is only reset
+// once the space it accumulated exceeds 'kMaxArenaSpaceUsed'.
+//
+class GrpcArenaPredictRequest {
+ public:
+  GrpcArenaPredictRequest() { Reset(); }
+
+  tensorflow::serving::PredictRequest* Request() { return request_; }
+
+  // A buffer to hold the serialized data of BYTES inputs.
+  std::string* StringBuffer() { return &string_buffer_; }
+
+  // Reset the arena if it has grown too large since the last reset.
+  void Recycle()
+  {
+    if (arena_.SpaceUsed() > kMaxArenaSpaceUsed) {
+      Reset();
+    }
+  }
+
+ private:
+  void Reset()
+  {
+    arena_.Reset();
+    request_ = google::protobuf::Arena::CreateMessage<
+        tensorflow::serving::PredictRequest>(&arena_);
+  }
+
+  static constexpr uint64_t kMaxArenaSpaceUsed = 1 << 20;
+
+  google::protobuf::Arena arena_;
+  // Owned by 'arena_'.
+  tensorflow::serving::PredictRequest* request_;
+  std::string string_buffer_;
+};
+
 //==============================================================================
 // An GrpcInferRequest represents an inflght inference request on gRPC.
 //
 class GrpcInferRequest {
  public:
-  GrpcInferRequest(TFServeOnCompleteFn callback = nullptr)
-      : callback_(callback), grpc_status_(),
+  GrpcInferRequest(
+      TFServeOnCompleteFn callback = nullptr, GrpcClient* client = nullptr)
+      : callback_(callback), client_(client), grpc_status_(),
         grpc_response_(std::make_shared<tensorflow::serving::PredictResponse>())
   {
   }
 
   tc::RequestTimers& Timer() { return timer_; }
   friend GrpcClient;
+  friend CompletionQueuePool;
 
  private:
   TFServeOnCompleteFn callback_;
+  // The client which sent the request.
+  GrpcClient* client_;
+  // The request message, held until the call is finished.
+  std::unique_ptr<GrpcArenaPredictRequest> arena_request_;
   // Variables for GRPC call
   grpc::ClientContext grpc_context_;
   grpc::Status grpc_status_;
@@ -157,14 +229,86 @@ class GrpcInferRequest {
   tc::RequestTimers timer_;
 };
 
+//==============================================================================
+// A CompletionQueuePool holds the completion queues shared by the clients,
+// each drained by a thread of its own. The pool lives as long as a client
+// holds it, the first client sets the number of queues.
+//
+class CompletionQueuePool {
+ public:
+  static std::shared_ptr<CompletionQueuePool> Get(size_t count)
+  {
+    static std::mutex mtx;
+    static std::weak_ptr<CompletionQueuePool> instance;
+    std::lock_guard<std::mutex> lock(mtx);
+    std::shared_ptr<CompletionQueuePool> pool = instance.lock();
+    if (pool == nullptr) {
+      pool.reset(new CompletionQueuePool(count));
+      instance = pool;
+    }
+    return pool;
+  }
+
+  ~CompletionQueuePool()
+  {
+    for (auto& queue : queues_) {
+      queue->Shutdown();
+    }
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Returns the queue for the next request, the queues are taken in turn.
+  grpc::CompletionQueue* Next()
+  {
+    return queues_[next_.fetch_add(1) % queues_.size()].get();
+  }
+
+ private:
+  explicit CompletionQueuePool(size_t count)
+  {
+    for (size_t i = 0; i < count; i++) {
+      queues_.emplace_back(new grpc::CompletionQueue());
+    }
+    for (auto& queue : queues_) {
+      threads_.emplace_back(&CompletionQueuePool::Drain, queue.get());
+    }
+  }
+
+  static void Drain(grpc::CompletionQueue* queue)
+  {
+    // The clients wait for their requests before they release the pool, so
+    // the queue is empty by the time it is shut down.
+    GrpcInferRequest* async_request;
+    bool ok = true;
+    while (queue->Next((void**)(&async_request), &ok)) {
+      if (!ok) {
+        fprintf(stderr, "Unexpected not ok on client side.\n");
+      }
+      if (async_request == nullptr) {
+        fprintf(stderr, "Unexpected null tag received at client.\n");
+      } else {
+        async_request->client_->CompleteAsyncRequest(async_request);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<grpc::CompletionQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_{0};
+};
+
 //==============================================================================
 
 Error
 GrpcClient::Create(
     std::unique_ptr<GrpcClient>* client, const std::string& server_url,
-    bool verbose, bool use_ssl, const SslOptions& ssl_options)
+    bool verbose, bool use_ssl, const SslOptions& ssl_options,
+    const TfServingOptions& tfserving_options)
 {
-  client->reset(new GrpcClient(server_url, verbose, use_ssl, ssl_options));
+  client->reset(new GrpcClient(
+      server_url, verbose, use_ssl, ssl_options, tfserving_options));
   return Error::Success;
 }
 
@@ -226,14 +370,21 @@ GrpcClient::Infer(
   }
   context.set_compression_algorithm(compression_algorithm);
 
-  err = PreRunProcessing(options, inputs, outputs);
+  std::unique_ptr<GrpcArenaPredictRequest> arena_request =
+      AcquireArenaRequest();
+  err = PreRunProcessing(
+      options, inputs, outputs, arena_request->Request(),
+      arena_request->StringBuffer());
   sync_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
   if (!err.IsOk()) {
+    ReleaseArenaRequest(std::move(arena_request));
     return err;
   }
   sync_request->grpc_response_->Clear();
   sync_request->grpc_status_ = stub_->Predict(
-      &context, infer_request_, sync_request->grpc_response_.get());
+      &context, *arena_request->Request(),
+      sync_request->grpc_response_.get());
+  ReleaseArenaRequest(std::move(arena_request));
 
   if (!sync_request->grpc_status_.ok()) {
     err = Error(sync_request->grpc_status_.error_message());
@@ -271,12 +422,18 @@ GrpcClient::AsyncInfer(
     return Error(
         "Callback function must be provided along with AsyncInfer() call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&GrpcClient::AsyncTransfer, this);
+  grpc::CompletionQueue* completion_queue;
+  if (completion_queue_pool_ != nullptr) {
+    completion_queue = completion_queue_pool_->Next();
+  } else {
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&GrpcClient::AsyncTransfer, this);
+    }
+    completion_queue = &async_request_completion_queue_;
   }
 
   GrpcInferRequest* async_request;
-  async_request = new GrpcInferRequest(std::move(callback));
+  async_request = new GrpcInferRequest(std::move(callback), this);
 
   async_request->Timer().CaptureTimestamp(
       tc::RequestTimers::Kind::REQUEST_START);
@@ -286,19 +443,28 @@ GrpcClient::AsyncInfer(
   }
   async_request->grpc_context_.set_compression_algorithm(compression_algorithm);
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  async_request->arena_request_ = AcquireArenaRequest();
+  Error err = PreRunProcessing(
+      options, inputs, outputs, async_request->arena_request_->Request(),
+      async_request->arena_request_->StringBuffer());
   if (!err.IsOk()) {
+    ReleaseArenaRequest(std::move(async_request->arena_request_));
     delete async_request;
     return err;
   }
 
   async_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
 
+  if (completion_queue_pool_ != nullptr) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_requests_.insert(async_request);
+  }
+
   std::unique_ptr<
       grpc::ClientAsyncResponseReader<tensorflow::serving::PredictResponse>>
       rpc(stub_->PrepareAsyncPredict(
-          &async_request->grpc_context_, infer_request_,
-          &async_request_completion_queue_));
+          &async_request->grpc_context_,
+          *async_request->arena_request_->Request(), completion_queue));
 
   rpc->StartCall();
 
@@ -326,7 +492,6 @@ GrpcClient::AsyncTransfer()
     bool ok = true;
     bool status =
         async_request_completion_queue_.Next((void**)(&raw_async_request), &ok);
-    std::shared_ptr<GrpcInferRequest> async_request;
     if (!ok) {
       fprintf(stderr, "Unexpected not ok on client side.\n");
     }
@@ -337,55 +502,83 @@ GrpcClient::AsyncTransfer()
     } else if (raw_async_request == nullptr) {
       fprintf(stderr, "Unexpected null tag received at client.\n");
     } else {
-      async_request.reset(raw_async_request);
-      InferResult* async_result;
-      Error err;
-      if (!async_request->grpc_status_.ok()) {
-        err = Error(async_request->grpc_status_.error_message());
-      }
-      async_request->Timer().CaptureTimestamp(
-          tc::RequestTimers::Kind::RECV_START);
-      InferResult::Create(&async_result, async_request->grpc_response_, err);
-      async_request->Timer().CaptureTimestamp(
-          tc::RequestTimers::Kind::RECV_END);
-      async_request->Timer().CaptureTimestamp(
-          tc::RequestTimers::Kind::REQUEST_END);
-      tc::Error update_err = UpdateInferStat(async_request->Timer());
-      if (!update_err.IsOk()) {
-        std::cerr << "Failed to update context stat: " << update_err
+      CompleteAsyncRequest(raw_async_request);
+    }
+  }
+}
+
+void
+GrpcClient::CompleteAsyncRequest(GrpcInferRequest* raw_async_request)
+{
+  std::shared_ptr<GrpcInferRequest> async_request(raw_async_request);
+  ReleaseArenaRequest(std::move(async_request->arena_request_));
+
+  bool exiting;
+  if (completion_queue_pool_ != nullptr) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    exiting = exiting_;
+  } else {
+    exiting = exiting_;
+  }
+
+  // The requests cancelled by the destructor are dropped without a callback.
+  if (!exiting) {
+    InferResult* async_result;
+    Error err;
+    if (!async_request->grpc_status_.ok()) {
+      err = Error(async_request->grpc_status_.error_message());
+    }
+    async_request->Timer().CaptureTimestamp(
+        tc::RequestTimers::Kind::RECV_START);
+    InferResult::Create(&async_result, async_request->grpc_response_, err);
+    async_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::RECV_END);
+    async_request->Timer().CaptureTimestamp(
+        tc::RequestTimers::Kind::REQUEST_END);
+    tc::Error update_err = UpdateInferStat(async_request->Timer());
+    if (!update_err.IsOk()) {
+      std::cerr << "Failed to update context stat: " << update_err
+                << std::endl;
+    }
+    if (async_request->grpc_status_.ok()) {
+      if (verbose_) {
+        std::cout << async_request->grpc_response_->DebugString()
                   << std::endl;
       }
-      if (async_request->grpc_status_.ok()) {
-        if (verbose_) {
-          std::cout << async_request->grpc_response_->DebugString()
-                    << std::endl;
-        }
-      }
-      async_request->callback_(async_result);
     }
+    async_request->callback_(async_result);
+  }
+
+  // The client may be destroyed as soon as its last pending request is
+  // removed, so this is the last access to it.
+  if (completion_queue_pool_ != nullptr) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_requests_.erase(raw_async_request);
+    pending_cv_.notify_all();
   }
 }
 
 Error
 GrpcClient::PreRunProcessing(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
-    const std::vector<const InferRequestedOutput*>& outputs)
+    const std::vector<const InferRequestedOutput*>& outputs,
+    tensorflow::serving::PredictRequest* infer_request,
+    std::string* string_buffer)
 {
   // Populate the request protobuf
 
   // Describing model name and signature from remote server.
-  infer_request_.mutable_model_spec()->set_name(options.model_name_);
+  infer_request->mutable_model_spec()->set_name(options.model_name_);
   if (!options.model_version_.empty()) {
-    infer_request_.mutable_model_spec()->set_version_label(
+    infer_request->mutable_model_spec()->set_version_label(
         options.model_version_);
   }
   if (!options.model_signature_name_.empty()) {
-    infer_request_.mutable_model_spec()->set_signature_name(
+    infer_request->mutable_model_spec()->set_signature_name(
         options.model_signature_name_);
   }
 
   // Describing remote model inputs shape.
-  StringKeyedProtos& keyed_proto_inputs = *infer_request_.mutable_inputs();
+  StringKeyedProtos& keyed_proto_inputs = *infer_request->mutable_inputs();
   std::set<std::string> request_inputs;
 
   for (const auto input : inputs) {
@@ -403,40 +596,41 @@ GrpcClient::PreRunProcessing(
     }
 
     // Set datatype
-    tensorflow::DataType tf_dtype = tensorflow::DT_INVALID;
-    GetTensorFlowDataType(raw_input->Datatype(), &tf_dtype);
+    const tensorflow::DataType tf_dtype =
+        GetTensorFlowDataType(raw_input->Type());
     itr->second.set_dtype(tf_dtype);
     if (tf_dtype == tensorflow::DT_INVALID) {
       return Error(
           "failed to retrieve the TF datatype for " + raw_input->Name());
     }
 
-    // Populate the shape
-    itr->second.mutable_tensor_shape()->Clear();
-    for (const auto dim : raw_input->Shape()) {
-      itr->second.mutable_tensor_shape()->add_dim()->set_size(dim);
+    // Populate the shape, reusing the dimensions of the previous request
+    auto* tensor_shape = itr->second.mutable_tensor_shape();
+    const auto& shape = raw_input->Shape();
+    while (tensor_shape->dim_size() > static_cast<int>(shape.size())) {
+      tensor_shape->mutable_dim()->RemoveLast();
+    }
+    for (size_t i = 0; i < shape.size(); i++) {
+      auto* dim = (static_cast<int>(i) < tensor_shape->dim_size())
+                      ? tensor_shape->mutable_dim(i)
+                      : tensor_shape->add_dim();
+      dim->set_size(shape[i]);
     }
 
-    raw_input->PrepareForRequest();
-    // There is an extra copy into the buffer to collect all the input
-    // batches. This is a room for improvement for later.
-    bool end_of_input = false;
-
-    // auto* raw_contents = itr->second.mutable_float_val()->mutable_data();
-    size_t content_size;
-    raw_input->ByteSize(&content_size);
-    temp_buffer_.clear();
-    temp_buffer_.reserve(content_size);
-    while (!end_of_input) {
-      const uint8_t* buf;
-      size_t buf_size;
-      raw_input->GetNext(&buf, &buf_size, &end_of_input);
-      if (buf != nullptr) {
-        temp_buffer_.append(reinterpret_cast<const char*>(buf), buf_size);
-      }
+    if (tf_dtype == tensorflow::DT_STRING) {
+      // Strings can't be sent as raw bytes, they are unpacked into the
+      // 'string_val' field one element at a time.
+      itr->second.mutable_tensor_content()->clear();
+      RETURN_IF_CB_ERROR(CopyInputData(raw_input, string_buffer));
+      RETURN_IF_CB_ERROR(PopulateStrVal(*string_buffer, &itr->second));
+    } else {
+      // Fixed-size types are sent as raw bytes in 'tensor_content', which
+      // is filled straight from the input buffers. Its capacity is kept
+      // from the previous request so no reallocation is needed.
+      itr->second.mutable_string_val()->Clear();
+      RETURN_IF_CB_ERROR(
+          CopyInputData(raw_input, itr->second.mutable_tensor_content()));
     }
-    ClearAllInputFields(&itr->second);
-    PopulateInputData(raw_input, &itr->second);
   }
 
   // Remove extra tensor protos, if any.
@@ -450,9 +644,9 @@ GrpcClient::PreRunProcessing(
     keyed_proto_inputs.erase(extra_input);
   }
 
-  if (infer_request_.ByteSizeLong() > INT_MAX) {
-    size_t request_size = infer_request_.ByteSizeLong();
-    infer_request_.Clear();
+  if (infer_request->ByteSizeLong() > INT_MAX) {
+    size_t request_size = infer_request->ByteSizeLong();
+    infer_request->Clear();
     return Error(
         "Request has byte size " + std::to_string(request_size) +
         " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
@@ -463,130 +657,20 @@ GrpcClient::PreRunProcessing(
 }
 
 Error
-GrpcClient::ClearAllInputFields(tensorflow::TensorProto* input_tensor_proto)
-{
-  input_tensor_proto->mutable_half_val()->Clear();
-  input_tensor_proto->mutable_float_val()->Clear();
-  input_tensor_proto->mutable_double_val()->Clear();
-  input_tensor_proto->mutable_int_val()->Clear();
-  input_tensor_proto->mutable_string_val()->Clear();
-  input_tensor_proto->mutable_int64_val()->Clear();
-  input_tensor_proto->mutable_bool_val()->Clear();
-  input_tensor_proto->mutable_uint32_val()->Clear();
-  input_tensor_proto->mutable_uint64_val()->Clear();
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateInputData(
-    TFServeInferInput* input, tensorflow::TensorProto* input_tensor_proto)
-{
-  if (input->Datatype() == "FP16") {
-    RETURN_IF_CB_ERROR(PopulateHalfVal(input_tensor_proto));
-  } else if (input->Datatype() == "BF16") {
-    return Error(
-        "BF16 datatype not currently supported for populating input data.");
-  } else if (input->Datatype() == "FP32") {
-    RETURN_IF_CB_ERROR(PopulateFloatVal(input_tensor_proto));
-  } else if (input->Datatype() == "FP64") {
-    RETURN_IF_CB_ERROR(PopulateDoubleVal(input_tensor_proto));
-  } else if (input->Datatype() == "INT32") {
-    RETURN_IF_CB_ERROR(PopulateIntVal(input_tensor_proto));
-  } else if (input->Datatype() == "INT16") {
-    RETURN_IF_CB_ERROR(PopulateIntVal(input_tensor_proto, 2));
-  } else if (input->Datatype() == "UINT16") {
-    RETURN_IF_CB_ERROR(PopulateIntVal(input_tensor_proto, 2));
-  } else if (input->Datatype() == "INT8") {
-    RETURN_IF_CB_ERROR(PopulateIntVal(input_tensor_proto, 1));
-  } else if (input->Datatype() == "UINT8") {
-    RETURN_IF_CB_ERROR(PopulateIntVal(input_tensor_proto, 1));
-  } else if (input->Datatype() == "BYTES") {
-    RETURN_IF_CB_ERROR(PopulateStrVal(input_tensor_proto));
-  } else if (input->Datatype() == "INT64") {
-    RETURN_IF_CB_ERROR(PopulateInt64Val(input_tensor_proto));
-  } else if (input->Datatype() == "BOOL") {
-    RETURN_IF_CB_ERROR(PopulateBoolVal(input_tensor_proto));
-  } else if (input->Datatype() == "UINT32") {
-    RETURN_IF_CB_ERROR(PopulateUintVal(input_tensor_proto));
-  } else if (input->Datatype() == "UINT64") {
-    RETURN_IF_CB_ERROR(PopulateUint64Val(input_tensor_proto));
-  } else {
-    return Error("unsupported datatype for populating input data");
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateHalfVal(tensorflow::TensorProto* input_tensor_proto)
-{
-  // Building FP16 one by one. Note that since protobuf has no int16 type, we'll
-  // have some pointless zero padding for each value here.
-  input_tensor_proto->mutable_half_val()->Reserve(2 * temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    int32_t elem;
-    memcpy(&elem, (temp_buffer_.c_str() + copied_byte_size), 2);
-    input_tensor_proto->add_half_val(elem);
-    copied_byte_size += 2;
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateFloatVal(tensorflow::TensorProto* input_tensor_proto)
-{
-  input_tensor_proto->mutable_float_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_float_val(
-        *(float*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(float);
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateDoubleVal(tensorflow::TensorProto* input_tensor_proto)
-{
-  input_tensor_proto->mutable_double_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_double_val(
-        *(double*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(double);
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateIntVal(
-    tensorflow::TensorProto* input_tensor_proto, size_t step_size)
+GrpcClient::CopyInputData(TFServeInferInput* input, std::string* content)
 {
-  if (step_size == 4) {
-    input_tensor_proto->mutable_int_val()->Reserve(temp_buffer_.size());
-    uint64_t copied_byte_size = 0;
-    while (copied_byte_size < temp_buffer_.size()) {
-      input_tensor_proto->add_int_val(
-          *(int*)(temp_buffer_.c_str() + copied_byte_size));
-      copied_byte_size += sizeof(int);
-    }
-  } else {
-    // Note that since protobuf has no int16/int8 type, we'll
-    // have some pointless zero padding for each value here and
-    // need to build the tensor one element at a time
-    input_tensor_proto->mutable_int_val()->Reserve(
-        temp_buffer_.size() * (4 / step_size));
-    uint64_t copied_byte_size = 0;
-    while (copied_byte_size < temp_buffer_.size()) {
-      int32_t elem;
-      memcpy(&elem, (temp_buffer_.c_str() + copied_byte_size), step_size);
-      input_tensor_proto->add_int_val(elem);
-      copied_byte_size += step_size;
+  size_t content_size;
+  RETURN_IF_CB_ERROR(input->ByteSize(&content_size));
+  content->clear();
+  content->reserve(content_size);
+  RETURN_IF_CB_ERROR(input->PrepareForRequest());
+  bool end_of_input = false;
+  while (!end_of_input) {
+    const uint8_t* buf;
+    size_t buf_size;
+    RETURN_IF_CB_ERROR(input->GetNext(&buf, &buf_size, &end_of_input));
+    if (buf != nullptr) {
+      content->append(reinterpret_cast<const char*>(buf), buf_size);
     }
   }
 
@@ -594,87 +678,77 @@ GrpcClient::PopulateIntVal(
 }
 
 Error
-GrpcClient::PopulateStrVal(tensorflow::TensorProto* input_tensor_proto)
+GrpcClient::PopulateStrVal(
+    const std::string& string_buffer,
+    tensorflow::TensorProto* input_tensor_proto)
 {
-  input_tensor_proto->mutable_string_val()->Reserve(temp_buffer_.size());
+  input_tensor_proto->mutable_string_val()->Clear();
   uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    int32_t string_length = *((int*)(temp_buffer_.c_str() + copied_byte_size));
+  while (copied_byte_size < string_buffer.size()) {
+    int32_t string_length =
+        *((int*)(string_buffer.c_str() + copied_byte_size));
     input_tensor_proto->add_string_val(std::string(
-        (temp_buffer_.c_str() + copied_byte_size + 4), string_length));
+        (string_buffer.c_str() + copied_byte_size + 4), string_length));
     copied_byte_size += (string_length + 4);
   }
 
   return Error::Success;
 }
 
-Error
-GrpcClient::PopulateBoolVal(tensorflow::TensorProto* input_tensor_proto)
-{
-  input_tensor_proto->mutable_bool_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_bool_val(
-        *(bool*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(bool);
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateInt64Val(tensorflow::TensorProto* input_tensor_proto)
-{
-  input_tensor_proto->mutable_int64_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_bool_val(
-        *(int64_t*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(int64_t);
-  }
-
-  return Error::Success;
-}
-
-Error
-GrpcClient::PopulateUintVal(tensorflow::TensorProto* input_tensor_proto)
+std::unique_ptr<GrpcArenaPredictRequest>
+GrpcClient::AcquireArenaRequest()
 {
-  input_tensor_proto->mutable_uint32_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_uint32_val(
-        *(uint32_t*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(uint32_t);
+  {
+    std::lock_guard<std::mutex> lock(arena_pool_mutex_);
+    if (!arena_pool_.empty()) {
+      std::unique_ptr<GrpcArenaPredictRequest> request =
+          std::move(arena_pool_.back());
+      arena_pool_.pop_back();
+      return request;
+    }
   }
-
-  return Error::Success;
+  return std::unique_ptr<GrpcArenaPredictRequest>(
+      new GrpcArenaPredictRequest());
 }
 
-Error
-GrpcClient::PopulateUint64Val(tensorflow::TensorProto* input_tensor_proto)
+void
+GrpcClient::ReleaseArenaRequest(
+    std::unique_ptr<GrpcArenaPredictRequest>&& request)
 {
-  input_tensor_proto->mutable_uint64_val()->Reserve(temp_buffer_.size());
-  uint64_t copied_byte_size = 0;
-  while (copied_byte_size < temp_buffer_.size()) {
-    input_tensor_proto->add_uint64_val(
-        *(uint64_t*)(temp_buffer_.c_str() + copied_byte_size));
-    copied_byte_size += sizeof(uint64_t);
+  if (request == nullptr) {
+    return;
   }
-
-  return Error::Success;
+  request->Recycle();
+  std::lock_guard<std::mutex> lock(arena_pool_mutex_);
+  arena_pool_.emplace_back(std::move(request));
 }
 
 GrpcClient::GrpcClient(
     const std::string& url, bool verbose, bool use_ssl,
-    const SslOptions& ssl_options)
+    const SslOptions& ssl_options, const TfServingOptions& tfserving_options)
     : InferenceServerClient(verbose),
-      stub_(tensorflow::serving::PredictionService::NewStub(
-          GetChannel(url, use_ssl, ssl_options)))
+      stub_(tensorflow::serving::PredictionService::NewStub(GetChannel(
+          url, use_ssl, ssl_options, tfserving_options.channel_count)))
 {
+  if (tfserving_options.completion_queue_count != 0) {
+    completion_queue_pool_ =
+        CompletionQueuePool::Get(tfserving_options.completion_queue_count);
+  }
 }
 
 GrpcClient::~GrpcClient()
 {
+  if (completion_queue_pool_ != nullptr) {
+    // Cancel the pending requests and wait for the shared completion queues
+    // to return them.
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    exiting_ = true;
+    for (auto async_request : pending_requests_) {
+      async_request->grpc_context_.TryCancel();
+    }
+    pending_cv_.wait(lock, [this] { return pending_requests_.empty(); });
+  }
+
   exiting_ = true;
   // Close complete queue and wait for the worker thread to return
   async_request_completion_queue_.Shutdown();
@@ -26,6 +26,12 @@
 #pragma once
 
 #include <grpc++/grpc++.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <vector>
+
 #include "../client_backend.h"
 #include "common.h"
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
@@ -55,6 +61,9 @@ struct SslOptions {
 };
 
 class InferResult;
+class GrpcInferRequest;
+class GrpcArenaPredictRequest;
+class CompletionQueuePool;
 
 using TFServeOnCompleteFn = std::function<void(InferResult*)>;
 
@@ -82,11 +91,14 @@ class GrpcClient : public tc::InferenceServerClient {
   /// \param use_ssl If true use encrypted channel to the server.
   /// \param ssl_options Specifies the files required for
   /// SSL encryption and authorization.
+  /// \param tfserving_options The completion queues and the channels the
+  /// client shares with the other clients.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<GrpcClient>* client, const std::string& server_url,
       bool verbose = false, bool use_ssl = false,
-      const SslOptions& ssl_options = SslOptions());
+      const SslOptions& ssl_options = SslOptions(),
+      const TfServingOptions& tfserving_options = TfServingOptions());
 
   /// Contact the inference server and get the metadata of specified model.
   /// \param model_metadata Returns model metadata as ModelMetadataResponse
@@ -154,41 +166,51 @@ class GrpcClient : public tc::InferenceServerClient {
           GRPC_COMPRESS_NONE);
 
  private:
+  friend CompletionQueuePool;
+
   GrpcClient(
       const std::string& url, bool verbose, bool use_ssl,
-      const SslOptions& ssl_options);
+      const SslOptions& ssl_options,
+      const TfServingOptions& tfserving_options);
   Error PreRunProcessing(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
+      const std::vector<const InferRequestedOutput*>& outputs,
+      tensorflow::serving::PredictRequest* infer_request,
+      std::string* string_buffer);
   void AsyncTransfer();
-  Error ClearAllInputFields(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateInputData(
-      TFServeInferInput* input, tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateHalfVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateFloatVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateDoubleVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateIntVal(
-      tensorflow::TensorProto* input_tensor_proto, size_t step_size = 4);
-  Error PopulateStrVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateBoolVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateInt64Val(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateUintVal(tensorflow::TensorProto* input_tensor_proto);
-  Error PopulateUint64Val(tensorflow::TensorProto* input_tensor_proto);
+  // Reports the completed 'async_request' and releases it.
+  void CompleteAsyncRequest(GrpcInferRequest* async_request);
+  // Copies all the data of the input into 'content'.
+  Error CopyInputData(TFServeInferInput* input, std::string* content);
+  Error PopulateStrVal(
+      const std::string& string_buffer,
+      tensorflow::TensorProto* input_tensor_proto);
+  std::unique_ptr<GrpcArenaPredictRequest> AcquireArenaRequest();
+  void ReleaseArenaRequest(std::unique_ptr<GrpcArenaPredictRequest>&& request);
 
   // The producer-consumer queue used to communicate asynchronously with
-  // the GRPC runtime.
+  // the GRPC runtime, unused when the client shares the completion queues
+  // of 'completion_queue_pool_'.
   grpc::CompletionQueue async_request_completion_queue_;
 
+  // The completion queues shared with the other clients, nullptr for the
+  // client's own queue.
+  std::shared_ptr<CompletionQueuePool> completion_queue_pool_;
+  // The asynchronous requests sent to the shared completion queues which are
+  // yet to complete, the client waits for them when it is destroyed.
+  std::set<GrpcInferRequest*> pending_requests_;
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+
   bool enable_stream_stats_;
   std::mutex stream_mutex_;
 
   // GRPC end point.
   std::unique_ptr<tensorflow::serving::PredictionService::Stub> stub_;
-  // request for GRPC call, one request object can be used for multiple calls
-  // since it can be overwritten as soon as the GRPC send finishes.
-  tensorflow::serving::PredictRequest infer_request_;
-  // A temporary buffer to hold serialized data
-  std::string temp_buffer_;
+  // The arena allocated requests for GRPC calls, each one is reused for
+  // another call once the one it was sent with is finished.
+  std::vector<std::unique_ptr<GrpcArenaPredictRequest>> arena_pool_;
+  std::mutex arena_pool_mutex_;
 };
 
 //======================================================================
@@ -65,6 +65,23 @@ TorchServeClientBackend::Infer(
   return Error::Success;
 }
 
+Error
+TorchServeClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  auto wrapped_callback = [callback](ts::InferResult* client_result) {
+    cb::InferResult* result = new TorchServeInferResult(client_result);
+    callback(result);
+  };
+
+  RETURN_IF_CB_ERROR(http_client_->AsyncInfer(
+      wrapped_callback, options, inputs, outputs, *http_headers_));
+
+  return Error::Success;
+}
+
 Error
 TorchServeClientBackend::ClientInferStat(InferStat* infer_stat)
 {
@@ -26,8 +26,13 @@
 
 #include "torchserve_http_client.h"
 
+#include <algorithm>
 #include <chrono>
+#include <climits>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include "torchserve_client_backend.h"
 
 namespace triton { namespace perfanalyzer { namespace clientbackend {
@@ -73,9 +78,9 @@ static CurlGlobal curl_global;
 
 //==============================================================================
 
-HttpInferRequest::HttpInferRequest()
-    : header_list_(nullptr),
-      file_ptr_(std::unique_ptr<FILE, Deleter>(nullptr, Deleter()))
+HttpInferRequest::HttpInferRequest(TorchServeOnCompleteFn callback)
+    : header_list_(nullptr), mime_handle_(nullptr), payload_pos_(0),
+      callback_(std::move(callback))
 {
 }
 
@@ -85,6 +90,10 @@ HttpInferRequest::~HttpInferRequest()
     curl_slist_free_all(static_cast<curl_slist*>(header_list_));
     header_list_ = nullptr;
   }
+  if (mime_handle_ != nullptr) {
+    curl_mime_free(mime_handle_);
+    mime_handle_ = nullptr;
+  }
 }
 
 Error
@@ -96,32 +105,11 @@ HttpInferRequest::InitializeRequest()
   return Error::Success;
 }
 
-Error
-HttpInferRequest::OpenFileData(std::string& file_path)
-{
-  FILE* pFile = fopen(file_path.c_str(), "rb");
-  if (pFile == nullptr) {
-    return Error("Failed to open the specified file `" + file_path + "`");
-  }
-  file_ptr_.reset(pFile);
-  return Error::Success;
-}
-
-long
-HttpInferRequest::FileSize()
-{
-  long size;
-  fseek(file_ptr_.get(), 0, SEEK_END);
-  size = ftell(file_ptr_.get());
-  rewind(file_ptr_.get());
-  return size;
-}
-
-Error
-HttpInferRequest::CloseFileData()
+void
+HttpInferRequest::SetPayload(std::shared_ptr<const std::string> payload)
 {
-  file_ptr_.reset(nullptr);
-  return Error::Success;
+  payload_ = std::move(payload);
+  payload_pos_ = 0;
 }
 
 
@@ -145,10 +133,7 @@ HttpClient::Infer(
 {
   Error err;
 
-  std::string request_uri(url_ + "/predictions/" + options.model_name_);
-  if (!options.model_version_.empty()) {
-    request_uri += "/" + options.model_version_;
-  }
+  std::string request_uri(RequestUri(options));
 
   std::shared_ptr<HttpInferRequest> sync_request(new HttpInferRequest());
 
@@ -179,9 +164,6 @@ HttpClient::Infer(
         easy_handle_, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
   }
 
-  sync_request->CloseFileData();
-  curl_mime_free(mime_handle_);
-
   InferResult::Create(result, sync_request);
 
   sync_request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_END);
@@ -196,26 +178,195 @@ HttpClient::Infer(
   return err;
 }
 
+Error
+HttpClient::AsyncInfer(
+    TorchServeOnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with AsyncInfer() call.");
+  }
+
+  if (multi_handle_ == nullptr) {
+    return Error("failed to start HTTP asynchronous client");
+  } else if (!worker_.joinable()) {
+    worker_ = std::thread(&HttpClient::AsyncTransfer, this);
+  }
+
+  if (!curl_global.Status().IsOk()) {
+    return curl_global.Status();
+  }
+
+  std::string request_uri(RequestUri(options));
+
+  std::shared_ptr<HttpInferRequest> async_request(
+      new HttpInferRequest(std::move(callback)));
+
+  async_request->Timer().Reset();
+  async_request->Timer().CaptureTimestamp(
+      tc::RequestTimers::Kind::REQUEST_START);
+
+  CURL* multi_easy_handle = curl_easy_init();
+  Error err = PreRunProcessing(
+      reinterpret_cast<void*>(multi_easy_handle), request_uri, options, inputs,
+      outputs, headers, async_request);
+  if (!err.IsOk()) {
+    curl_easy_cleanup(multi_easy_handle);
+    return err;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto insert_result = ongoing_async_requests_.emplace(std::make_pair(
+        reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
+    if (!insert_result.second) {
+      curl_easy_cleanup(multi_easy_handle);
+      return Error("Failed to insert new asynchronous request context.");
+    }
+
+    async_request->Timer().CaptureTimestamp(
+        tc::RequestTimers::Kind::SEND_START);
+    curl_multi_add_handle(
+        reinterpret_cast<CURLM*>(multi_handle_), multi_easy_handle);
+  }
+
+  cv_.notify_all();
+  return Error::Success;
+}
+
+void
+HttpClient::AsyncTransfer()
+{
+  CURLM* multi_handle = reinterpret_cast<CURLM*>(multi_handle_);
+  int place_holder = 0;
+  do {
+    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
+
+    // sleep if no work is available
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] {
+      if (this->exiting_) {
+        return true;
+      }
+      // wake up if an async request has been generated
+      return !this->ongoing_async_requests_.empty();
+    });
+
+    CURLMcode mc = curl_multi_perform(multi_handle, &place_holder);
+    int numfds;
+    if (mc == CURLM_OK) {
+      // Wait for activity. If there are no descripters in the multi_handle
+      // then curl_multi_wait will return immediately
+      mc = curl_multi_wait(multi_handle, NULL, 0, INT_MAX, &numfds);
+    }
+    if (mc != CURLM_OK) {
+      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                << std::endl;
+    }
+
+    CURLMsg* msg = nullptr;
+    while ((msg = curl_multi_info_read(multi_handle, &place_holder))) {
+      auto itr = ongoing_async_requests_.find(
+          reinterpret_cast<uintptr_t>(msg->easy_handle));
+      if (itr != ongoing_async_requests_.end()) {
+        std::shared_ptr<HttpInferRequest> async_request = itr->second;
+        ongoing_async_requests_.erase(itr);
+        if (msg->data.result == CURLE_OK) {
+          curl_easy_getinfo(
+              msg->easy_handle, CURLINFO_RESPONSE_CODE,
+              &async_request->http_code_);
+        }
+        async_request->Timer().CaptureTimestamp(
+            tc::RequestTimers::Kind::REQUEST_END);
+        tc::Error err = UpdateInferStat(async_request->Timer());
+        if (!err.IsOk()) {
+          std::cerr << "Failed to update context stat: " << err << std::endl;
+        }
+        request_list.emplace_back(std::move(async_request));
+      } else {
+        // This shouldn't happen
+        std::cerr << "Unexpected error: received completed request that is "
+                     "not in the list of asynchronous requests"
+                  << std::endl;
+      }
+      curl_multi_remove_handle(multi_handle, msg->easy_handle);
+      curl_easy_cleanup(msg->easy_handle);
+    }
+    lock.unlock();
+
+    for (auto& this_request : request_list) {
+      InferResult* result;
+      InferResult::Create(&result, this_request);
+      this_request->callback_(result);
+    }
+  } while (!exiting_);
+}
+
+std::string
+HttpClient::RequestUri(const InferOptions& options) const
+{
+  std::string request_uri(url_ + "/predictions/" + options.model_name_);
+  if (!options.model_version_.empty()) {
+    request_uri += "/" + options.model_version_;
+  }
+  return request_uri;
+}
+
+Error
+HttpClient::GetPayload(
+    const std::string& file_path, std::shared_ptr<const std::string>* payload)
+{
+  auto it = payloads_.find(file_path);
+  if (it == payloads_.end()) {
+    std::ifstream file(file_path, std::ios::in | std::ios::binary);
+    if (!file) {
+      return Error("Failed to open the specified file `" + file_path + "`");
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    it = payloads_
+             .emplace(
+                 file_path, std::make_shared<const std::string>(content.str()))
+             .first;
+  }
+  *payload = it->second;
+  return Error::Success;
+}
+
 size_t
 HttpClient::ReadCallback(char* buffer, size_t size, size_t nitems, void* userp)
 {
-  size_t retcode =
-      fread(buffer, size, nitems, ((HttpInferRequest*)userp)->FilePtr());
-  if (retcode == 0) {
-    ((HttpInferRequest*)userp)
-        ->Timer()
-        .CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+  size_t input_bytes = std::min(
+      size * nitems, request->payload_->size() - request->payload_pos_);
+  memcpy(buffer, request->payload_->data() + request->payload_pos_, input_bytes);
+  request->payload_pos_ += input_bytes;
+  if (request->payload_pos_ == request->payload_->size()) {
+    request->Timer().CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
   }
-  return retcode;
+  return input_bytes;
 }
 
 int
 HttpClient::SeekCallback(void* userp, curl_off_t offset, int origin)
 {
-  if (fseek(((HttpInferRequest*)userp)->FilePtr(), offset, origin) == 0)
-    return CURL_SEEKFUNC_OK;
-  else
+  HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
+  curl_off_t base = 0;
+  if (origin == SEEK_CUR) {
+    base = request->payload_pos_;
+  } else if (origin == SEEK_END) {
+    base = request->payload_->size();
+  }
+  if ((base + offset < 0) ||
+      (base + offset > (curl_off_t)request->payload_->size())) {
     return CURL_SEEKFUNC_FAIL;
+  }
+  request->payload_pos_ = base + offset;
+  return CURL_SEEKFUNC_OK;
 }
 
 size_t
@@ -292,8 +443,6 @@ HttpClient::PreRunProcessing(
   curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, buffer_byte_size);
   curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, buffer_byte_size);
 
-  // request data provided by InferRequestProvider()
-  mime_handle_ = curl_mime_init(easy_handle_);
   // Add the buffers holding input tensor data
   for (const auto input : inputs) {
     TorchServeInferInput* this_input =
@@ -304,27 +453,34 @@ HttpClient::PreRunProcessing(
       const uint8_t* buf;
       size_t buf_size;
       this_input->GetNext(&buf, &buf_size, &end_of_input);
-      std::string file_path(
-          reinterpret_cast<const char*>(buf) + 4, buf_size - 4);
       if (buf != nullptr) {
-        Error err = http_request->OpenFileData(file_path);
+        std::string file_path(
+            reinterpret_cast<const char*>(buf) + 4, buf_size - 4);
+        std::shared_ptr<const std::string> payload;
+        Error err = GetPayload(file_path, &payload);
         if (!err.IsOk()) {
           return err;
         }
+        http_request->SetPayload(std::move(payload));
         if (verbose_) {
           input_filepaths.push_back(file_path);
         }
       }
     }
   }
+  if (http_request->payload_ == nullptr) {
+    return Error("no input file provided for the TorchServe request");
+  }
 
-  long file_size = http_request->FileSize();
-  curl_mimepart* part = curl_mime_addpart((curl_mime*)mime_handle_);
+  // request data provided by ReadCallback()
+  http_request->mime_handle_ = curl_mime_init(curl);
+  curl_mimepart* part = curl_mime_addpart(http_request->mime_handle_);
   curl_mime_data_cb(
-      part, file_size, ReadCallback, SeekCallback, NULL, http_request.get());
+      part, http_request->PayloadSize(), ReadCallback, SeekCallback, NULL,
+      http_request.get());
   curl_mime_name(part, "data");
 
-  curl_easy_setopt(easy_handle_, CURLOPT_MIMEPOST, (curl_mime*)mime_handle_);
+  curl_easy_setopt(curl, CURLOPT_MIMEPOST, http_request->mime_handle_);
 
   // response headers handled by InferResponseHeaderHandler()
   curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, InferResponseHeaderHandler);
@@ -363,7 +519,8 @@ HttpClient::PreRunProcessing(
 
 HttpClient::HttpClient(const std::string& url, bool verbose)
     : InferenceServerClient(verbose), url_(url),
-      easy_handle_(reinterpret_cast<void*>(curl_easy_init()))
+      easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
+      multi_handle_(reinterpret_cast<void*>(curl_multi_init()))
 {
 }
 
@@ -371,9 +528,25 @@ HttpClient::~HttpClient()
 {
   exiting_ = true;
 
+  // thread not joinable if AsyncInfer() is not called
+  if (worker_.joinable()) {
+    cv_.notify_all();
+    worker_.join();
+  }
+
   if (easy_handle_ != nullptr) {
     curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
   }
+
+  if (multi_handle_ != nullptr) {
+    CURLM* multi_handle = reinterpret_cast<CURLM*>(multi_handle_);
+    for (auto& request : ongoing_async_requests_) {
+      CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
+      curl_multi_remove_handle(multi_handle, easy_handle);
+      curl_easy_cleanup(easy_handle);
+    }
+    curl_multi_cleanup(multi_handle);
+  }
 }
 
 //======================================================================
@@ -28,6 +28,8 @@
 #include <curl/curl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <map>
+#include <unordered_map>
 #include "../client_backend.h"
 #include "common.h"
 #include "torchserve_infer_input.h"
@@ -46,7 +48,8 @@ using TorchServeOnCompleteFn = std::function<void(InferResult*)>;
 //==============================================================================
 /// An HttpClient object is used to perform any kind of communication with the
 /// torchserve service using libcurl. None of the functions are thread
-/// safe.
+/// safe, except that the callbacks of asynchronous requests are invoked on a
+/// separate worker thread.
 ///
 /// \code
 ///   std::unique_ptr<HttpClient> client;
@@ -87,6 +90,31 @@ class HttpClient : public tc::InferenceServerClient {
           std::vector<const InferRequestedOutput*>(),
       const Headers& headers = Headers());
 
+  /// Run asynchronous inference on server.
+  /// Once the request is completed, the InferResult pointer will be passed to
+  /// the provided 'callback' function. Upon the invocation of callback
+  /// function, the ownership of InferResult object is transfered to the
+  /// function caller. It is then the caller's choice on either retrieving the
+  /// results inside the callback function or deferring it to a different
+  /// thread so that the client is unblocked. In order to prevent memory leak,
+  /// user must ensure this object gets deleted.
+  /// \param callback The callback function to be invoked on request
+  /// completion.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how the
+  /// output must be returned. If not provided then all the outputs in the model
+  /// config will be returned as default settings.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in the metadata of the request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      TorchServeOnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers());
+
  private:
   HttpClient(const std::string& url, bool verbose);
   Error PreRunProcessing(
@@ -94,6 +122,12 @@ class HttpClient : public tc::InferenceServerClient {
       const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs,
       const Headers& headers, std::shared_ptr<HttpInferRequest>& request);
+  // Returns the content of the file, reading it only on its first use.
+  Error GetPayload(
+      const std::string& file_path,
+      std::shared_ptr<const std::string>* payload);
+  std::string RequestUri(const InferOptions& options) const;
+  void AsyncTransfer();
 
   static size_t ReadCallback(
       char* buffer, size_t size, size_t nitems, void* userp);
@@ -107,32 +141,29 @@ class HttpClient : public tc::InferenceServerClient {
   const std::string url_;
   // curl easy handle shared for all synchronous requests.
   void* easy_handle_;
-  // The handle to interact with mime API.
-  curl_mime* mime_handle_;
+  // curl multi handle for processing asynchronous requests.
+  void* multi_handle_;
+  // The content of the input files keyed by their path. The files are read
+  // once and then sent from memory, so that no file I/O is done while
+  // issuing requests.
+  std::unordered_map<std::string, std::shared_ptr<const std::string>>
+      payloads_;
+  // Asynchronous requests being processed keyed by their easy handle.
+  std::map<uintptr_t, std::shared_ptr<HttpInferRequest>>
+      ongoing_async_requests_;
 };
 
 //======================================================================
 
 class HttpInferRequest {
  public:
-  struct Deleter {
-    void operator()(FILE* file)
-    {
-      if (file != nullptr) {
-        fclose(file);
-      }
-    }
-  };
-
-  HttpInferRequest();
+  HttpInferRequest(TorchServeOnCompleteFn callback = nullptr);
   ~HttpInferRequest();
   Error InitializeRequest();
-  Error OpenFileData(std::string& file_path);
-  long FileSize();
-  Error CloseFileData();
+  void SetPayload(std::shared_ptr<const std::string> payload);
+  size_t PayloadSize() const { return payload_->size(); }
   tc::RequestTimers& Timer() { return timer_; }
   std::string& DebugString() { return *infer_response_buffer_; }
-  FILE* FilePtr() { return file_ptr_.get(); }
   friend HttpClient;
   friend InferResult;
 
@@ -140,13 +171,20 @@ class HttpInferRequest {
   // Pointer to the list of the HTTP request header, keep it such that it will
   // be valid during the transfer and can be freed once transfer is completed.
   struct curl_slist* header_list_;
-  std::unique_ptr<FILE, Deleter> file_ptr_;
+  // The handle to interact with mime API, freed with the request.
+  curl_mime* mime_handle_;
+  // The content of the file to upload and the position of the next byte to
+  // send.
+  std::shared_ptr<const std::string> payload_;
+  size_t payload_pos_;
   // HTTP response code for the inference request
   long http_code_;
   // Buffer that accumulates the response body.
   std::unique_ptr<std::string> infer_response_buffer_;
   // The timers for infer request.
   tc::RequestTimers timer_;
+  // The callback of an asynchronous request.
+  TorchServeOnCompleteFn callback_;
 };
 
 //======================================================================
@@ -26,7 +26,9 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include "../../doctest.h"
 #include "triton_client_backend.h"
 
@@ -35,17 +37,49 @@ namespace tritonremote {
 
 class TestTritonClientBackend : public TritonClientBackend {
  public:
-  template <typename T>
-  void ParseAndStoreMetric(
-      const std::string& metrics_endpoint_text, const std::string metric_id,
-      std::map<std::string, T>& metric_per_gpu)
+  void ParseAndStoreMetrics(
+      const std::string& metrics_endpoint_text,
+      triton::perfanalyzer::Metrics& metrics)
   {
-    TritonClientBackend::ParseAndStoreMetric<T>(
-        metrics_endpoint_text, metric_id, metric_per_gpu);
+    TritonClientBackend::ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+  }
+
+  const tc::InferOptions& TritonOptions(const InferOptions& options)
+  {
+    return TritonClientBackend::TritonOptions(options);
+  }
+
+  // Set up the HTTP client with request compression, the client does not
+  // connect to the server until a request is sent.
+  void CreateHttpClient(
+      const tc::InferenceServerHttpClient::CompressionType compression)
+  {
+    REQUIRE(tc::InferenceServerHttpClient::Create(
+                &client_.http_client_, "localhost:8000")
+                .IsOk());
+    http_compression_algorithm_ = compression;
+  }
+
+  void ResetHttpClient() { client_.http_client_.reset(); }
+
+  Error SetCompressedInputs(
+      const InferOptions& options,
+      const std::vector<tc::InferInput*>& triton_inputs)
+  {
+    return TritonClientBackend::SetCompressedInputs(options, triton_inputs);
+  }
+
+  void ParseStatistics(
+      const std::string& infer_stat_text,
+      std::map<ModelIdentifier, ModelStatistics>* model_stats)
+  {
+    rapidjson::Document infer_stat;
+    infer_stat.Parse(infer_stat_text.c_str());
+    TritonClientBackend::ParseStatistics(infer_stat, model_stats);
   }
 };
 
-TEST_CASE("testing the ParseAndStoreMetric function")
+TEST_CASE("testing the ParseAndStoreMetrics function")
 {
   TestTritonClientBackend ttcb{};
 
@@ -57,11 +91,10 @@ TEST_CASE("testing the ParseAndStoreMetric function")
 nv_gpu_utilization{gpu_uuid="GPU-00000000-0000-0000-0000-000000000000"} 0.41
 nv_gpu_utilization{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 0.77
     )"};
-    const std::string metric_id{"nv_gpu_utilization"};
-    std::map<std::string, double> gpu_utilization_per_gpu{};
+    Metrics metrics{};
 
-    ttcb.ParseAndStoreMetric<double>(
-        metrics_endpoint_text, metric_id, gpu_utilization_per_gpu);
+    ttcb.ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+    auto& gpu_utilization_per_gpu = metrics.gpu_utilization_per_gpu;
     CHECK(gpu_utilization_per_gpu.size() == 2);
     CHECK(
         gpu_utilization_per_gpu["GPU-00000000-0000-0000-0000-000000000000"] ==
@@ -79,11 +112,10 @@ nv_gpu_utilization{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 0.77
 nv_gpu_power_usage{gpu_uuid="GPU-00000000-0000-0000-0000-000000000000"} 81.619
 nv_gpu_power_usage{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 99.217
     )"};
-    const std::string metric_id{"nv_gpu_power_usage"};
-    std::map<std::string, double> gpu_power_usage_per_gpu{};
+    Metrics metrics{};
 
-    ttcb.ParseAndStoreMetric<double>(
-        metrics_endpoint_text, metric_id, gpu_power_usage_per_gpu);
+    ttcb.ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+    auto& gpu_power_usage_per_gpu = metrics.gpu_power_usage_per_gpu;
     CHECK(gpu_power_usage_per_gpu.size() == 2);
     CHECK(
         gpu_power_usage_per_gpu["GPU-00000000-0000-0000-0000-000000000000"] ==
@@ -101,11 +133,10 @@ nv_gpu_power_usage{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 99.217
 nv_gpu_memory_used_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000000"} 50000000
 nv_gpu_memory_used_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 75000000
     )"};
-    const std::string metric_id{"nv_gpu_memory_used_bytes"};
-    std::map<std::string, uint64_t> gpu_memory_used_bytes_per_gpu{};
+    Metrics metrics{};
 
-    ttcb.ParseAndStoreMetric<uint64_t>(
-        metrics_endpoint_text, metric_id, gpu_memory_used_bytes_per_gpu);
+    ttcb.ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+    auto& gpu_memory_used_bytes_per_gpu = metrics.gpu_memory_used_bytes_per_gpu;
     CHECK(gpu_memory_used_bytes_per_gpu.size() == 2);
     CHECK(
         gpu_memory_used_bytes_per_gpu
@@ -123,11 +154,11 @@ nv_gpu_memory_used_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 75
 nv_gpu_memory_total_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000000"} 1000000000
 nv_gpu_memory_total_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 2000000000
     )"};
-    const std::string metric_id{"nv_gpu_memory_total_bytes"};
-    std::map<std::string, uint64_t> gpu_memory_total_bytes_per_gpu{};
+    Metrics metrics{};
 
-    ttcb.ParseAndStoreMetric<uint64_t>(
-        metrics_endpoint_text, metric_id, gpu_memory_total_bytes_per_gpu);
+    ttcb.ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+    auto& gpu_memory_total_bytes_per_gpu =
+        metrics.gpu_memory_total_bytes_per_gpu;
     CHECK(gpu_memory_total_bytes_per_gpu.size() == 2);
     CHECK(
         gpu_memory_total_bytes_per_gpu
@@ -138,4 +169,138 @@ nv_gpu_memory_total_bytes{gpu_uuid="GPU-00000000-0000-0000-0000-000000000001"} 2
   }
 }
 
+TEST_CASE("testing the TritonOptions function")
+{
+  TestTritonClientBackend ttcb{};
+
+  InferOptions options("my_model");
+  options.model_version_ = "2";
+  options.sequence_id_ = 7;
+  options.sequence_start_ = true;
+  const tc::InferOptions* triton_options = &ttcb.TritonOptions(options);
+  CHECK(triton_options->model_name_ == "my_model");
+  CHECK(triton_options->model_version_ == "2");
+  CHECK(triton_options->sequence_id_ == 7);
+  CHECK(triton_options->sequence_start_);
+
+  SUBCASE("reused for a request without sequence")
+  {
+    InferOptions next_options("my_model");
+    next_options.model_version_ = "2";
+    CHECK(&ttcb.TritonOptions(next_options) == triton_options);
+    CHECK(triton_options->sequence_id_ == 0);
+    CHECK(triton_options->sequence_id_str_ == "");
+    CHECK(!triton_options->sequence_start_);
+    CHECK(!triton_options->sequence_end_);
+  }
+
+  SUBCASE("replaced for another model")
+  {
+    InferOptions next_options("other_model");
+    CHECK(ttcb.TritonOptions(next_options).model_name_ == "other_model");
+    CHECK(ttcb.TritonOptions(next_options).model_version_ == "");
+  }
+}
+
+TEST_CASE("testing the SetCompressedInputs function")
+{
+  TestTritonClientBackend ttcb{};
+  ttcb.CreateHttpClient(tc::InferenceServerHttpClient::CompressionType::GZIP);
+
+  tc::InferInput* input;
+  REQUIRE(tc::InferInput::Create(&input, "INPUT", {4}, "INT32").IsOk());
+  std::unique_ptr<tc::InferInput> input_holder(input);
+  std::vector<int32_t> data{1, 2, 3, 4};
+  REQUIRE(input
+              ->AppendRaw(
+                  reinterpret_cast<uint8_t*>(data.data()),
+                  data.size() * sizeof(int32_t))
+              .IsOk());
+  const std::vector<tc::InferInput*> triton_inputs{input};
+
+  InferOptions options("my_model");
+  options.data_stream_id_ = 0;
+  options.data_step_id_ = 1;
+  const tc::InferOptions& triton_options = ttcb.TritonOptions(options);
+  REQUIRE(ttcb.SetCompressedInputs(options, triton_inputs).IsOk());
+  const auto compressed = triton_options.compressed_inputs_;
+  CHECK(compressed != nullptr);
+
+  SUBCASE("reused for the same step")
+  {
+    REQUIRE(ttcb.SetCompressedInputs(options, triton_inputs).IsOk());
+    CHECK(triton_options.compressed_inputs_ == compressed);
+  }
+
+  SUBCASE("compressed again for another step")
+  {
+    options.data_step_id_ = 2;
+    REQUIRE(ttcb.SetCompressedInputs(options, triton_inputs).IsOk());
+    CHECK(triton_options.compressed_inputs_ != nullptr);
+    CHECK(triton_options.compressed_inputs_ != compressed);
+  }
+
+  SUBCASE("not set without a step")
+  {
+    options.data_step_id_ = -1;
+    REQUIRE(ttcb.SetCompressedInputs(options, triton_inputs).IsOk());
+    CHECK(triton_options.compressed_inputs_ == nullptr);
+  }
+
+  ttcb.ResetHttpClient();
+}
+
+TEST_CASE("testing the ParseStatistics function")
+{
+  TestTritonClientBackend ttcb{};
+
+  auto model_stat_text = [](const std::string& name, uint64_t count) {
+    const std::string duration{
+        R"({"count":)" + std::to_string(count) + R"(,"ns":)" +
+        std::to_string(count * 10) + "}"};
+    return R"({"name":")" + name + R"(","version":"1","inference_count":)" +
+           std::to_string(count) + R"(,"execution_count":)" +
+           std::to_string(count) + R"(,"inference_stats":{"success":)" +
+           duration + R"(,"queue":)" + duration + R"(,"compute_input":)" +
+           duration + R"(,"compute_infer":)" + duration +
+           R"(,"compute_output":)" + duration + R"(,"cache_hit":)" + duration +
+           R"(,"cache_miss":)" + duration + "}}";
+  };
+
+  std::map<ModelIdentifier, ModelStatistics> model_stats;
+  ttcb.ParseStatistics(
+      R"({"model_stats":[)" + model_stat_text("a", 1) + "," +
+          model_stat_text("b", 2) + "]}",
+      &model_stats);
+  REQUIRE(model_stats.size() == 2);
+  const ModelStatistics* a_stats = &model_stats[{"a", "1"}];
+  CHECK(a_stats->success_count_ == 1);
+  CHECK(a_stats->cumm_time_ns_ == 10);
+
+  SUBCASE("entries updated in place")
+  {
+    ttcb.ParseStatistics(
+        R"({"model_stats":[)" + model_stat_text("a", 3) + "," +
+            model_stat_text("b", 4) + "]}",
+        &model_stats);
+    REQUIRE(model_stats.size() == 2);
+    CHECK(&model_stats[{"a", "1"}] == a_stats);
+    CHECK(a_stats->success_count_ == 3);
+    CHECK(a_stats->cache_miss_time_ns_ == 30);
+    CHECK(model_stats[{"b", "1"}].inference_count_ == 4);
+  }
+
+  SUBCASE("models no longer reported removed")
+  {
+    ttcb.ParseStatistics(
+        R"({"model_stats":[)" + model_stat_text("a", 3) + "," +
+            model_stat_text("c", 5) + "]}",
+        &model_stats);
+    REQUIRE(model_stats.size() == 2);
+    CHECK(model_stats.find({"b", "1"}) == model_stats.end());
+    CHECK(model_stats[{"a", "1"}].success_count_ == 3);
+    CHECK(model_stats[{"c", "1"}].success_count_ == 5);
+  }
+}
+
 }}}}  // namespace triton::perfanalyzer::clientbackend::tritonremote
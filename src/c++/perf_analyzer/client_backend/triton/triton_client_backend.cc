@@ -27,7 +27,7 @@
 #include "triton_client_backend.h"
 
 #include <curl/curl.h>
-#include <regex>
+#include <set>
 #include <stdexcept>
 #include "../../constants.h"
 #include "../../perf_analyzer_exception.h"
@@ -80,6 +80,42 @@ ParseGrpcSslOptions(
   return std::pair<bool, triton::client::SslOptions>{use_ssl, grpc_ssl_options};
 }
 
+using ModelIdentifier = triton::perfanalyzer::clientbackend::ModelIdentifier;
+using ModelStatistics = triton::perfanalyzer::clientbackend::ModelStatistics;
+
+// Returns the statistics of the model, adding them if the model was not
+// reported before. Updating the entries in place avoids rebuilding the map on
+// every query of the same models.
+ModelStatistics&
+FindOrAddStatistics(
+    std::map<ModelIdentifier, ModelStatistics>* model_stats,
+    ModelIdentifier&& model_identifier)
+{
+  auto it = model_stats->find(model_identifier);
+  if (it == model_stats->end()) {
+    it = model_stats
+             ->emplace(std::move(model_identifier), ModelStatistics())
+             .first;
+  }
+  return it->second;
+}
+
+// Removes the statistics of the models that are no longer reported, e.g.
+// after they were unloaded
+void
+EraseUnreportedStatistics(
+    const std::set<ModelIdentifier>& reported,
+    std::map<ModelIdentifier, ModelStatistics>* model_stats)
+{
+  for (auto it = model_stats->begin(); it != model_stats->end();) {
+    if (reported.find(it->first) == reported.end()) {
+      it = model_stats->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 }  // namespace
 
 namespace triton { namespace perfanalyzer { namespace clientbackend {
@@ -92,19 +128,39 @@ TritonClientBackend::Create(
     const SslOptionsBase& ssl_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const grpc_compression_algorithm compression_algorithm,
-    std::shared_ptr<Headers> http_headers, const bool verbose,
-    const std::string& metrics_url,
+    const bool adaptive_compression, std::shared_ptr<Headers> http_headers,
+    const bool verbose, const std::string& metrics_url,
+    const std::vector<std::string>& metrics_allowlist,
+    const TransferRateLimits& transfer_rate_limits,
     std::unique_ptr<ClientBackend>* client_backend)
 {
   std::unique_ptr<TritonClientBackend> triton_client_backend(
       new TritonClientBackend(
-          protocol, compression_algorithm, http_headers, metrics_url));
+          protocol, compression_algorithm, http_headers, metrics_url,
+          metrics_allowlist));
   if (protocol == ProtocolType::HTTP) {
     triton::client::HttpSslOptions http_ssl_options =
         ParseHttpSslOptions(ssl_options);
+    tc::HttpClientOptions client_options;
+    client_options.max_send_bytes_per_second =
+        transfer_rate_limits.send_bytes_per_sec;
+    client_options.max_recv_bytes_per_second =
+        transfer_rate_limits.recv_bytes_per_sec;
     RETURN_IF_TRITON_ERROR(tc::InferenceServerHttpClient::Create(
         &(triton_client_backend->client_.http_client_), url, verbose,
-        http_ssl_options));
+        http_ssl_options, client_options));
+    switch (compression_algorithm) {
+      case GRPC_COMPRESS_DEFLATE:
+        triton_client_backend->http_compression_algorithm_ =
+            tc::InferenceServerHttpClient::CompressionType::DEFLATE;
+        break;
+      case GRPC_COMPRESS_GZIP:
+        triton_client_backend->http_compression_algorithm_ =
+            tc::InferenceServerHttpClient::CompressionType::GZIP;
+        break;
+      default:
+        break;
+    }
     if (!trace_options.empty()) {
       std::string response;
       RETURN_IF_TRITON_ERROR(
@@ -116,9 +172,12 @@ TritonClientBackend::Create(
         ParseGrpcSslOptions(ssl_options);
     bool use_ssl = grpc_ssl_options_pair.first;
     triton::client::SslOptions grpc_ssl_options = grpc_ssl_options_pair.second;
+    tc::GrpcClientOptions client_options;
+    client_options.adaptive_compression = adaptive_compression;
     RETURN_IF_TRITON_ERROR(tc::InferenceServerGrpcClient::Create(
         &(triton_client_backend->client_.grpc_client_), url, verbose, use_ssl,
-        grpc_ssl_options));
+        grpc_ssl_options, tc::KeepAliveOptions(), true /* use_cached_channel */,
+        client_options));
     if (!trace_options.empty()) {
       inference::TraceSettingResponse response;
       RETURN_IF_TRITON_ERROR(
@@ -221,20 +280,68 @@ TritonClientBackend::ModelConfig(
   return Error::Success;
 }
 
+Error
+TritonClientBackend::LoadModel(
+    const std::string& model_name, const std::string& config)
+{
+  if (protocol_ == ProtocolType::HTTP) {
+    RETURN_IF_TRITON_ERROR(client_.http_client_->LoadModel(
+        model_name, *http_headers_, tc::Parameters(), config));
+  } else {
+    RETURN_IF_TRITON_ERROR(
+        client_.grpc_client_->LoadModel(model_name, *http_headers_, config));
+  }
+  return Error::Success;
+}
+
+Error
+TritonClientBackend::Warmup(const size_t connection_count)
+{
+  if (protocol_ == ProtocolType::HTTP) {
+    RETURN_IF_TRITON_ERROR(client_.http_client_->Warmup(connection_count));
+  } else {
+    RETURN_IF_TRITON_ERROR(client_.grpc_client_->Warmup(connection_count));
+  }
+  return Error::Success;
+}
+
+Error
+TritonClientBackend::UnloadModel(const std::string& model_name)
+{
+  if (protocol_ == ProtocolType::HTTP) {
+    RETURN_IF_TRITON_ERROR(
+        client_.http_client_->UnloadModel(model_name, *http_headers_));
+  } else {
+    RETURN_IF_TRITON_ERROR(
+        client_.grpc_client_->UnloadModel(model_name, *http_headers_));
+  }
+  return Error::Success;
+}
+
+Error
+TritonClientBackend::ModelReady(
+    bool* ready, const std::string& model_name,
+    const std::string& model_version)
+{
+  if (protocol_ == ProtocolType::HTTP) {
+    RETURN_IF_TRITON_ERROR(client_.http_client_->IsModelReady(
+        ready, model_name, model_version, *http_headers_));
+  } else {
+    RETURN_IF_TRITON_ERROR(client_.grpc_client_->IsModelReady(
+        ready, model_name, model_version, *http_headers_));
+  }
+  return Error::Success;
+}
+
 Error
 TritonClientBackend::Infer(
     InferResult** result, const InferOptions& options,
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  std::vector<tc::InferInput*> triton_inputs;
-  ParseInferInputToTriton(inputs, &triton_inputs);
-
-  std::vector<const tc::InferRequestedOutput*> triton_outputs;
-  ParseInferRequestedOutputToTriton(outputs, &triton_outputs);
-
-  tc::InferOptions triton_options(options.model_name_);
-  ParseInferOptionsToTriton(options, &triton_options);
+  const auto& triton_inputs = TritonInputs(inputs);
+  const auto& triton_outputs = TritonOutputs(outputs);
+  const auto& triton_options = TritonOptions(options);
 
   tc::InferResult* triton_result;
 
@@ -243,9 +350,10 @@ TritonClientBackend::Infer(
         &triton_result, triton_options, triton_inputs, triton_outputs,
         *http_headers_, compression_algorithm_));
   } else {
+    RETURN_IF_ERROR(SetCompressedInputs(options, triton_inputs));
     RETURN_IF_TRITON_ERROR(client_.http_client_->Infer(
         &triton_result, triton_options, triton_inputs, triton_outputs,
-        *http_headers_));
+        *http_headers_, tc::Parameters(), http_compression_algorithm_));
   }
 
   *result = new TritonInferResult(triton_result);
@@ -264,23 +372,19 @@ TritonClientBackend::AsyncInfer(
     callback(result);
   };
 
-  std::vector<tc::InferInput*> triton_inputs;
-  ParseInferInputToTriton(inputs, &triton_inputs);
-
-  std::vector<const tc::InferRequestedOutput*> triton_outputs;
-  ParseInferRequestedOutputToTriton(outputs, &triton_outputs);
-
-  tc::InferOptions triton_options(options.model_name_);
-  ParseInferOptionsToTriton(options, &triton_options);
+  const auto& triton_inputs = TritonInputs(inputs);
+  const auto& triton_outputs = TritonOutputs(outputs);
+  const auto& triton_options = TritonOptions(options);
 
   if (protocol_ == ProtocolType::GRPC) {
     RETURN_IF_TRITON_ERROR(client_.grpc_client_->AsyncInfer(
         wrapped_callback, triton_options, triton_inputs, triton_outputs,
         *http_headers_, compression_algorithm_));
   } else {
+    RETURN_IF_ERROR(SetCompressedInputs(options, triton_inputs));
     RETURN_IF_TRITON_ERROR(client_.http_client_->AsyncInfer(
         wrapped_callback, triton_options, triton_inputs, triton_outputs,
-        *http_headers_));
+        *http_headers_, tc::Parameters(), http_compression_algorithm_));
   }
 
   return Error::Success;
@@ -299,7 +403,9 @@ TritonClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
         wrapped_callback, enable_stats, 0 /* stream_timeout */, *http_headers_,
         compression_algorithm_));
   } else {
-    return Error("HTTP does not support starting streams", pa::GENERIC_ERROR);
+    RETURN_IF_TRITON_ERROR(client_.http_client_->StartStream(
+        wrapped_callback, enable_stats, 0 /* stream_timeout */,
+        *http_headers_));
   }
 
   return Error::Success;
@@ -310,21 +416,16 @@ TritonClientBackend::AsyncStreamInfer(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  std::vector<tc::InferInput*> triton_inputs;
-  ParseInferInputToTriton(inputs, &triton_inputs);
-
-  std::vector<const tc::InferRequestedOutput*> triton_outputs;
-  ParseInferRequestedOutputToTriton(outputs, &triton_outputs);
-
-  tc::InferOptions triton_options(options.model_name_);
-  ParseInferOptionsToTriton(options, &triton_options);
+  const auto& triton_inputs = TritonInputs(inputs);
+  const auto& triton_outputs = TritonOutputs(outputs);
+  const auto& triton_options = TritonOptions(options);
 
   if (protocol_ == ProtocolType::GRPC) {
     RETURN_IF_TRITON_ERROR(client_.grpc_client_->AsyncStreamInfer(
         triton_options, triton_inputs, triton_outputs));
   } else {
-    return Error(
-        "HTTP does not support streaming inferences", pa::GENERIC_ERROR);
+    RETURN_IF_TRITON_ERROR(client_.http_client_->AsyncStreamInfer(
+        triton_options, triton_inputs, triton_outputs));
   }
 
   return Error::Success;
@@ -373,9 +474,9 @@ Error
 TritonClientBackend::Metrics(triton::perfanalyzer::Metrics& metrics)
 {
   try {
-    std::string metrics_endpoint_text{""};
-    AccessMetricsEndpoint(metrics_endpoint_text);
-    ParseAndStoreMetrics(metrics_endpoint_text, metrics);
+    metrics_parser_.Start(&metrics);
+    AccessMetricsEndpoint();
+    metrics_parser_.Finish();
   }
   catch (const PerfAnalyzerException& e) {
     return Error(e.what(), pa::GENERIC_ERROR);
@@ -384,7 +485,7 @@ TritonClientBackend::Metrics(triton::perfanalyzer::Metrics& metrics)
 }
 
 void
-TritonClientBackend::AccessMetricsEndpoint(std::string& metrics_endpoint_text)
+TritonClientBackend::AccessMetricsEndpoint()
 {
   CURL* curl{curl_easy_init()};
   if (curl == nullptr) {
@@ -392,18 +493,19 @@ TritonClientBackend::AccessMetricsEndpoint(std::string& metrics_endpoint_text)
         "Error calling curl_easy_init()", triton::perfanalyzer::GENERIC_ERROR);
   }
 
+  // The response is parsed as it arrives rather than gathered first
   const auto metrics_response_handler{
-      [](char* ptr, size_t size, size_t nmemb, std::string* userdata) {
-        userdata->append(ptr, size * nmemb);
+      [](char* ptr, size_t size, size_t nmemb, PrometheusParser* userdata) {
+        userdata->Feed(ptr, size * nmemb);
         return size * nmemb;
       }};
 
   curl_easy_setopt(curl, CURLOPT_URL, metrics_url_.c_str());
   curl_easy_setopt(
       curl, CURLOPT_WRITEFUNCTION,
-      static_cast<size_t (*)(char*, size_t, size_t, std::string*)>(
+      static_cast<size_t (*)(char*, size_t, size_t, PrometheusParser*)>(
           metrics_response_handler));
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &metrics_endpoint_text);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &metrics_parser_);
 
   CURLcode res{curl_easy_perform(curl)};
 
@@ -430,18 +532,10 @@ TritonClientBackend::ParseAndStoreMetrics(
     const std::string& metrics_endpoint_text,
     triton::perfanalyzer::Metrics& metrics)
 {
-  ParseAndStoreMetric<double>(
-      metrics_endpoint_text, "nv_gpu_utilization",
-      metrics.gpu_utilization_per_gpu);
-  ParseAndStoreMetric<double>(
-      metrics_endpoint_text, "nv_gpu_power_usage",
-      metrics.gpu_power_usage_per_gpu);
-  ParseAndStoreMetric<uint64_t>(
-      metrics_endpoint_text, "nv_gpu_memory_used_bytes",
-      metrics.gpu_memory_used_bytes_per_gpu);
-  ParseAndStoreMetric<uint64_t>(
-      metrics_endpoint_text, "nv_gpu_memory_total_bytes",
-      metrics.gpu_memory_total_bytes_per_gpu);
+  metrics_parser_.Start(&metrics);
+  metrics_parser_.Feed(
+      metrics_endpoint_text.data(), metrics_endpoint_text.size());
+  metrics_parser_.Finish();
 }
 
 Error
@@ -478,6 +572,57 @@ TritonClientBackend::RegisterSystemSharedMemory(
   return Error::Success;
 }
 
+Error
+TritonClientBackend::UnregisterSystemSharedMemory(const std::string& name)
+{
+  if (protocol_ == ProtocolType::GRPC) {
+    RETURN_IF_TRITON_ERROR(client_.grpc_client_->UnregisterSystemSharedMemory(
+        name, *http_headers_));
+  } else {
+    RETURN_IF_TRITON_ERROR(client_.http_client_->UnregisterSystemSharedMemory(
+        name, *http_headers_));
+  }
+
+  return Error::Success;
+}
+
+Error
+TritonClientBackend::SystemSharedMemoryStatus(
+    std::map<std::string, SystemSharedMemoryRegion>* regions)
+{
+  regions->clear();
+  if (protocol_ == ProtocolType::GRPC) {
+    inference::SystemSharedMemoryStatusResponse status;
+    RETURN_IF_TRITON_ERROR(client_.grpc_client_->SystemSharedMemoryStatus(
+        &status, "", *http_headers_));
+    for (const auto& region : status.regions()) {
+      (*regions)[region.second.name()] = {
+          region.second.key(), region.second.byte_size()};
+    }
+  } else {
+    std::string status;
+    RETURN_IF_TRITON_ERROR(client_.http_client_->SystemSharedMemoryStatus(
+        &status, "", *http_headers_));
+    rapidjson::Document status_json;
+    RETURN_IF_TRITON_ERROR(tc::ParseJson(&status_json, status));
+    if (!status_json.IsArray()) {
+      return Error(
+          "unexpected system shared memory status: " + status,
+          pa::GENERIC_ERROR);
+    }
+    for (const auto& region : status_json.GetArray()) {
+      if (!region.IsObject() || !region.HasMember("name") ||
+          !region.HasMember("key") || !region.HasMember("byte_size")) {
+        continue;
+      }
+      (*regions)[region["name"].GetString()] = {
+          region["key"].GetString(), region["byte_size"].GetUint64()};
+    }
+  }
+
+  return Error::Success;
+}
+
 Error
 TritonClientBackend::RegisterCudaSharedMemory(
     const std::string& name, const cudaIpcMemHandle_t& handle,
@@ -511,10 +656,15 @@ TritonClientBackend::CreateSharedMemoryRegion(
 
 Error
 TritonClientBackend::MapSharedMemory(
-    int shm_fd, size_t offset, size_t byte_size, void** shm_addr)
+    int shm_fd, size_t offset, size_t byte_size,
+    const SharedMemoryOptions& options, void** shm_addr)
 {
-  RETURN_IF_TRITON_ERROR(
-      tc::MapSharedMemory(shm_fd, offset, byte_size, shm_addr));
+  tc::SharedMemoryOptions triton_options;
+  triton_options.huge_pages = options.huge_pages;
+  triton_options.prefault = options.prefault;
+  triton_options.numa_node = options.numa_node;
+  RETURN_IF_TRITON_ERROR(tc::MapSharedMemory(
+      shm_fd, offset, byte_size, triton_options, shm_addr));
 
   return Error::Success;
 }
@@ -544,6 +694,62 @@ TritonClientBackend::UnmapSharedMemory(void* shm_addr, size_t byte_size)
   return Error::Success;
 }
 
+const std::vector<tc::InferInput*>&
+TritonClientBackend::TritonInputs(const std::vector<InferInput*>& inputs)
+{
+  if (inputs != inputs_) {
+    inputs_ = inputs;
+    triton_inputs_.clear();
+    ParseInferInputToTriton(inputs, &triton_inputs_);
+  }
+  return triton_inputs_;
+}
+
+const std::vector<const tc::InferRequestedOutput*>&
+TritonClientBackend::TritonOutputs(
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (outputs != outputs_) {
+    outputs_ = outputs;
+    triton_outputs_.clear();
+    ParseInferRequestedOutputToTriton(outputs, &triton_outputs_);
+  }
+  return triton_outputs_;
+}
+
+const tc::InferOptions&
+TritonClientBackend::TritonOptions(const InferOptions& options)
+{
+  if ((triton_options_ == nullptr) ||
+      (triton_options_->model_name_ != options.model_name_)) {
+    triton_options_.reset(new tc::InferOptions(options.model_name_));
+  }
+  ParseInferOptionsToTriton(options, triton_options_.get());
+  return *triton_options_;
+}
+
+Error
+TritonClientBackend::SetCompressedInputs(
+    const InferOptions& options,
+    const std::vector<tc::InferInput*>& triton_inputs)
+{
+  triton_options_->compressed_inputs_.reset();
+  if ((http_compression_algorithm_ ==
+       tc::InferenceServerHttpClient::CompressionType::NONE) ||
+      (options.data_stream_id_ < 0) || (options.data_step_id_ < 0)) {
+    return Error::Success;
+  }
+
+  auto& compressed = compressed_inputs_[std::make_pair(
+      options.data_stream_id_, options.data_step_id_)];
+  if (compressed == nullptr) {
+    RETURN_IF_TRITON_ERROR(client_.http_client_->CompressInputs(
+        &compressed, triton_inputs, http_compression_algorithm_));
+  }
+  triton_options_->compressed_inputs_ = compressed;
+  return Error::Success;
+}
+
 void
 TritonClientBackend::ParseInferInputToTriton(
     const std::vector<InferInput*>& inputs,
@@ -579,7 +785,17 @@ TritonClientBackend::ParseInferOptionsToTriton(
     }
     triton_options->sequence_start_ = options.sequence_start_;
     triton_options->sequence_end_ = options.sequence_end_;
+  } else {
+    // The options may be reused from a request of a sequence
+    triton_options->sequence_id_ = 0;
+    triton_options->sequence_id_str_.clear();
+    triton_options->sequence_start_ = false;
+    triton_options->sequence_end_ = false;
   }
+  triton_options->priority_ = options.priority_;
+  triton_options->server_timeout_ = options.server_timeout_;
+  triton_options->triton_enable_empty_final_response_ =
+      options.triton_enable_empty_final_response_;
 }
 
 
@@ -588,39 +804,39 @@ TritonClientBackend::ParseStatistics(
     const inference::ModelStatisticsResponse& infer_stat,
     std::map<ModelIdentifier, ModelStatistics>* model_stats)
 {
-  model_stats->clear();
   for (const auto& this_stat : infer_stat.model_stats()) {
-    auto it = model_stats
-                  ->emplace(
-                      std::make_pair(this_stat.name(), this_stat.version()),
-                      ModelStatistics())
-                  .first;
-    it->second.inference_count_ = this_stat.inference_count();
-    it->second.execution_count_ = this_stat.execution_count();
-    it->second.success_count_ = this_stat.inference_stats().success().count();
-    it->second.queue_count_ = this_stat.inference_stats().queue().count();
-    it->second.compute_input_count_ =
+    auto& stats = FindOrAddStatistics(
+        model_stats, std::make_pair(this_stat.name(), this_stat.version()));
+    stats.inference_count_ = this_stat.inference_count();
+    stats.execution_count_ = this_stat.execution_count();
+    stats.success_count_ = this_stat.inference_stats().success().count();
+    stats.queue_count_ = this_stat.inference_stats().queue().count();
+    stats.compute_input_count_ =
         this_stat.inference_stats().compute_input().count();
-    it->second.compute_infer_count_ =
+    stats.compute_infer_count_ =
         this_stat.inference_stats().compute_infer().count();
-    it->second.compute_output_count_ =
+    stats.compute_output_count_ =
         this_stat.inference_stats().compute_output().count();
-    it->second.cumm_time_ns_ = this_stat.inference_stats().success().ns();
-    it->second.queue_time_ns_ = this_stat.inference_stats().queue().ns();
-    it->second.compute_input_time_ns_ =
+    stats.cumm_time_ns_ = this_stat.inference_stats().success().ns();
+    stats.queue_time_ns_ = this_stat.inference_stats().queue().ns();
+    stats.compute_input_time_ns_ =
         this_stat.inference_stats().compute_input().ns();
-    it->second.compute_infer_time_ns_ =
+    stats.compute_infer_time_ns_ =
         this_stat.inference_stats().compute_infer().ns();
-    it->second.compute_output_time_ns_ =
+    stats.compute_output_time_ns_ =
         this_stat.inference_stats().compute_output().ns();
-    it->second.cache_hit_count_ =
-        this_stat.inference_stats().cache_hit().count();
-    it->second.cache_hit_time_ns_ =
-        this_stat.inference_stats().cache_hit().ns();
-    it->second.cache_miss_count_ =
-        this_stat.inference_stats().cache_miss().count();
-    it->second.cache_miss_time_ns_ =
-        this_stat.inference_stats().cache_miss().ns();
+    stats.cache_hit_count_ = this_stat.inference_stats().cache_hit().count();
+    stats.cache_hit_time_ns_ = this_stat.inference_stats().cache_hit().ns();
+    stats.cache_miss_count_ = this_stat.inference_stats().cache_miss().count();
+    stats.cache_miss_time_ns_ = this_stat.inference_stats().cache_miss().ns();
+  }
+
+  if (model_stats->size() > (size_t)infer_stat.model_stats_size()) {
+    std::set<ModelIdentifier> reported;
+    for (const auto& this_stat : infer_stat.model_stats()) {
+      reported.emplace(this_stat.name(), this_stat.version());
+    }
+    EraseUnreportedStatistics(reported, model_stats);
   }
 }
 
@@ -629,46 +845,52 @@ TritonClientBackend::ParseStatistics(
     const rapidjson::Document& infer_stat,
     std::map<ModelIdentifier, ModelStatistics>* model_stats)
 {
-  model_stats->clear();
-  for (const auto& this_stat : infer_stat["model_stats"].GetArray()) {
-    auto it = model_stats
-                  ->emplace(
-                      std::make_pair(
-                          this_stat["name"].GetString(),
-                          this_stat["version"].GetString()),
-                      ModelStatistics())
-                  .first;
-    it->second.inference_count_ = this_stat["inference_count"].GetUint64();
-    it->second.execution_count_ = this_stat["execution_count"].GetUint64();
-    it->second.success_count_ =
+  const auto& all_stats = infer_stat["model_stats"];
+  for (const auto& this_stat : all_stats.GetArray()) {
+    auto& stats = FindOrAddStatistics(
+        model_stats, std::make_pair(
+                         this_stat["name"].GetString(),
+                         this_stat["version"].GetString()));
+    stats.inference_count_ = this_stat["inference_count"].GetUint64();
+    stats.execution_count_ = this_stat["execution_count"].GetUint64();
+    stats.success_count_ =
         this_stat["inference_stats"]["success"]["count"].GetUint64();
-    it->second.queue_count_ =
+    stats.queue_count_ =
         this_stat["inference_stats"]["queue"]["count"].GetUint64();
-    it->second.compute_input_count_ =
+    stats.compute_input_count_ =
         this_stat["inference_stats"]["compute_input"]["count"].GetUint64();
-    it->second.compute_infer_count_ =
+    stats.compute_infer_count_ =
         this_stat["inference_stats"]["compute_infer"]["count"].GetUint64();
-    it->second.compute_output_count_ =
+    stats.compute_output_count_ =
         this_stat["inference_stats"]["compute_output"]["count"].GetUint64();
-    it->second.cumm_time_ns_ =
+    stats.cumm_time_ns_ =
         this_stat["inference_stats"]["success"]["ns"].GetUint64();
-    it->second.queue_time_ns_ =
+    stats.queue_time_ns_ =
         this_stat["inference_stats"]["queue"]["ns"].GetUint64();
-    it->second.compute_input_time_ns_ =
+    stats.compute_input_time_ns_ =
         this_stat["inference_stats"]["compute_input"]["ns"].GetUint64();
-    it->second.compute_infer_time_ns_ =
+    stats.compute_infer_time_ns_ =
         this_stat["inference_stats"]["compute_infer"]["ns"].GetUint64();
-    it->second.compute_output_time_ns_ =
+    stats.compute_output_time_ns_ =
         this_stat["inference_stats"]["compute_output"]["ns"].GetUint64();
-    it->second.cache_hit_count_ =
+    stats.cache_hit_count_ =
         this_stat["inference_stats"]["cache_hit"]["count"].GetUint64();
-    it->second.cache_hit_time_ns_ =
+    stats.cache_hit_time_ns_ =
         this_stat["inference_stats"]["cache_hit"]["ns"].GetUint64();
-    it->second.cache_miss_count_ =
+    stats.cache_miss_count_ =
         this_stat["inference_stats"]["cache_miss"]["count"].GetUint64();
-    it->second.cache_miss_time_ns_ =
+    stats.cache_miss_time_ns_ =
         this_stat["inference_stats"]["cache_miss"]["ns"].GetUint64();
   }
+
+  if (model_stats->size() > all_stats.Size()) {
+    std::set<ModelIdentifier> reported;
+    for (const auto& this_stat : all_stats.GetArray()) {
+      reported.emplace(
+          this_stat["name"].GetString(), this_stat["version"].GetString());
+    }
+    EraseUnreportedStatistics(reported, model_stats);
+  }
 }
 
 void
@@ -683,6 +905,20 @@ TritonClientBackend::ParseInferStat(
       triton_infer_stat.cumulative_send_time_ns;
   infer_stat->cumulative_receive_time_ns =
       triton_infer_stat.cumulative_receive_time_ns;
+  infer_stat->cumulative_serialize_time_ns =
+      triton_infer_stat.cumulative_serialize_time_ns;
+  infer_stat->cumulative_send_queue_time_ns =
+      triton_infer_stat.cumulative_send_queue_time_ns;
+  infer_stat->cumulative_deserialize_time_ns =
+      triton_infer_stat.cumulative_deserialize_time_ns;
+  infer_stat->cumulative_request_byte_size =
+      triton_infer_stat.cumulative_request_byte_size;
+  infer_stat->cumulative_uncompressed_request_byte_size =
+      triton_infer_stat.cumulative_uncompressed_request_byte_size;
+  infer_stat->cumulative_response_byte_size =
+      triton_infer_stat.cumulative_response_byte_size;
+  infer_stat->cumulative_uncompressed_response_byte_size =
+      triton_infer_stat.cumulative_uncompressed_response_byte_size;
 }
 
 //==============================================================================
@@ -810,6 +1046,20 @@ TritonInferResult::RawData(
   return Error::Success;
 }
 
+Error
+TritonInferResult::IsFinalResponse(bool* is_final_response) const
+{
+  RETURN_IF_TRITON_ERROR(result_->IsFinalResponse(is_final_response));
+  return Error::Success;
+}
+
+Error
+TritonInferResult::IsNullResponse(bool* is_null_response) const
+{
+  RETURN_IF_TRITON_ERROR(result_->IsNullResponse(is_null_response));
+  return Error::Success;
+}
+
 //==============================================================================
 
 }}}}  // namespace triton::perfanalyzer::clientbackend::tritonremote
@@ -27,12 +27,11 @@
 
 #include <cstdint>
 #include <map>
-#include <regex>
 #include <string>
-#include <type_traits>
 #include "../../constants.h"
 #include "../../metrics.h"
 #include "../../perf_utils.h"
+#include "../../prometheus_parser.h"
 #include "../client_backend.h"
 #include "grpc_client.h"
 #include "http_client.h"
@@ -79,6 +78,10 @@ class TritonClientBackend : public ClientBackend {
   /// the header name/value.
   /// \param verbose Enables the verbose mode.
   /// \param metrics_url The inference server metrics url and port.
+  /// \param metrics_allowlist The metric families to collect beyond the GPU
+  /// ones.
+  /// \param transfer_rate_limits How fast the requests are transferred, only
+  /// for HTTP protocol.
   /// \param client_backend Returns a new TritonClientBackend object.
   /// \return Error object indicating success or failure.
   static Error Create(
@@ -86,8 +89,11 @@ class TritonClientBackend : public ClientBackend {
       const SslOptionsBase& ssl_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const grpc_compression_algorithm compression_algorithm,
+      const bool adaptive_compression,
       std::shared_ptr<tc::Headers> http_headers, const bool verbose,
       const std::string& metrics_url,
+      const std::vector<std::string>& metrics_allowlist,
+      const TransferRateLimits& transfer_rate_limits,
       std::unique_ptr<ClientBackend>* client_backend);
 
   /// See ClientBackend::ServerExtensions()
@@ -103,6 +109,21 @@ class TritonClientBackend : public ClientBackend {
       rapidjson::Document* model_config, const std::string& model_name,
       const std::string& model_version) override;
 
+  /// See ClientBackend::LoadModel()
+  Error LoadModel(
+      const std::string& model_name, const std::string& config) override;
+
+  /// See ClientBackend::UnloadModel()
+  Error UnloadModel(const std::string& model_name) override;
+
+  /// See ClientBackend::ModelReady()
+  Error ModelReady(
+      bool* ready, const std::string& model_name,
+      const std::string& model_version) override;
+
+  /// See ClientBackend::Warmup()
+  Error Warmup(const size_t connection_count) override;
+
   /// See ClientBackend::Infer()
   Error Infer(
       InferResult** result, const InferOptions& options,
@@ -143,6 +164,13 @@ class TritonClientBackend : public ClientBackend {
       const std::string& name, const std::string& key,
       const size_t byte_size) override;
 
+  /// See ClientBackend::UnregisterSystemSharedMemory()
+  Error UnregisterSystemSharedMemory(const std::string& name) override;
+
+  /// See ClientBackend::SystemSharedMemoryStatus()
+  Error SystemSharedMemoryStatus(
+      std::map<std::string, SystemSharedMemoryRegion>* regions) override;
+
   /// See ClientBackend::RegisterCudaSharedMemory()
   Error RegisterCudaSharedMemory(
       const std::string& name, const cudaIpcMemHandle_t& handle,
@@ -154,7 +182,8 @@ class TritonClientBackend : public ClientBackend {
 
   /// See ClientBackend::MapSharedMemory()
   Error MapSharedMemory(
-      int shm_fd, size_t offset, size_t byte_size, void** shm_addr) override;
+      int shm_fd, size_t offset, size_t byte_size,
+      const SharedMemoryOptions& options, void** shm_addr) override;
 
   /// See ClientBackend::CloseSharedMemory()
   Error CloseSharedMemory(int shm_fd) override;
@@ -169,13 +198,32 @@ class TritonClientBackend : public ClientBackend {
   TritonClientBackend(
       const ProtocolType protocol,
       const grpc_compression_algorithm compression_algorithm,
-      std::shared_ptr<tc::Headers> http_headers, const std::string& metrics_url)
+      std::shared_ptr<tc::Headers> http_headers, const std::string& metrics_url,
+      const std::vector<std::string>& metrics_allowlist)
       : ClientBackend(BackendKind::TRITON), protocol_(protocol),
         compression_algorithm_(compression_algorithm),
-        http_headers_(http_headers), metrics_url_(metrics_url)
+        http_headers_(http_headers), metrics_url_(metrics_url),
+        metrics_parser_(metrics_allowlist)
   {
   }
 
+  /// \return The client library inputs of 'inputs'. The translation of the
+  /// previous request is reused while the inputs stay the same.
+  const std::vector<tc::InferInput*>& TritonInputs(
+      const std::vector<InferInput*>& inputs);
+  /// \return The client library outputs of 'outputs'. The translation of the
+  /// previous request is reused while the outputs stay the same.
+  const std::vector<const tc::InferRequestedOutput*>& TritonOutputs(
+      const std::vector<const InferRequestedOutput*>& outputs);
+  /// \return The client library options of 'options', filled in place of
+  /// those of the previous request.
+  const tc::InferOptions& TritonOptions(const InferOptions& options);
+  /// Set the input data of 'triton_inputs' compressed in the client library
+  /// options of the request, compressing it on the first request of its
+  /// data stream and step, see InferOptions::data_stream_id_.
+  Error SetCompressedInputs(
+      const InferOptions& options,
+      const std::vector<tc::InferInput*>& triton_inputs);
   void ParseInferInputToTriton(
       const std::vector<InferInput*>& inputs,
       std::vector<tc::InferInput*>* triton_inputs);
@@ -192,36 +240,11 @@ class TritonClientBackend : public ClientBackend {
       std::map<ModelIdentifier, ModelStatistics>* model_stats);
   void ParseInferStat(
       const tc::InferStat& triton_infer_stat, InferStat* infer_stat);
-  void AccessMetricsEndpoint(std::string& metrics_endpoint_text);
+  void AccessMetricsEndpoint();
   void ParseAndStoreMetrics(
       const std::string& metrics_endpoint_text,
       triton::perfanalyzer::Metrics& metrics);
 
-  template <typename T>
-  void ParseAndStoreMetric(
-      const std::string& metrics_endpoint_text, const std::string metric_id,
-      std::map<std::string, T>& metric_per_gpu)
-  {
-    std::regex metric_regex(
-        R"(\n)" + metric_id + R"(\{gpu_uuid\=\"([^"]+)\"\} (\d+\.?\d*))");
-    std::sregex_iterator metric_regex_match_begin{std::sregex_iterator(
-        metrics_endpoint_text.begin(), metrics_endpoint_text.end(),
-        metric_regex)};
-
-    for (std::sregex_iterator i{metric_regex_match_begin};
-         i != std::sregex_iterator(); i++) {
-      const std::smatch& match{*i};
-      const std::string& gpu_uuid{match[1].str()};
-      T metric{};
-      if (std::is_same<T, double>::value) {
-        metric = std::stod(match[2].str());
-      } else if (std::is_same<T, uint64_t>::value) {
-        metric = static_cast<uint64_t>(std::stod(match[2].str()));
-      }
-      metric_per_gpu[gpu_uuid] = metric;
-    }
-  }
-
   /// Union to represent the underlying triton client belonging to one of
   /// the protocols
   union TritonClient {
@@ -239,6 +262,24 @@ class TritonClientBackend : public ClientBackend {
   const grpc_compression_algorithm compression_algorithm_{GRPC_COMPRESS_NONE};
   std::shared_ptr<tc::Headers> http_headers_;
   const std::string metrics_url_{""};
+  PrometheusParser metrics_parser_{std::vector<std::string>{}};
+
+  // The translation of the last request. A backend serves one inference
+  // context, so requests are not translated concurrently, and the client
+  // library is done with them once the infer call returns.
+  std::vector<InferInput*> inputs_;
+  std::vector<tc::InferInput*> triton_inputs_;
+  std::vector<const InferRequestedOutput*> outputs_;
+  std::vector<const tc::InferRequestedOutput*> triton_outputs_;
+  std::unique_ptr<tc::InferOptions> triton_options_;
+
+  // The compression of the bodies of HTTP requests, and the input data of
+  // the requests compressed by data stream and step.
+  tc::InferenceServerHttpClient::CompressionType http_compression_algorithm_{
+      tc::InferenceServerHttpClient::CompressionType::NONE};
+  std::map<
+      std::pair<int64_t, int64_t>, std::shared_ptr<tc::CompressedInferInputs>>
+      compressed_inputs_;
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestTritonClientBackend;
@@ -316,6 +357,10 @@ class TritonInferResult : public InferResult {
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
+  /// See InferResult::IsFinalResponse()
+  Error IsFinalResponse(bool* is_final_response) const override;
+  /// See InferResult::IsNullResponse()
+  Error IsNullResponse(bool* is_null_response) const override;
 
  private:
   std::unique_ptr<tc::InferResult> result_;
@@ -0,0 +1,159 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "output_buffer_pool.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#ifdef TRITON_ENABLE_GPU
+#include <cuda_runtime_api.h>
+#endif  // TRITON_ENABLE_GPU
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace tritoncapi {
+
+namespace {
+
+// The smallest size class, smaller outputs share its buffers
+constexpr size_t kMinClassShift = 6;
+
+}  // namespace
+
+OutputBufferPool::OutputBufferPool(
+    const TRITONSERVER_MemoryType memory_type, const int64_t memory_type_id,
+    const size_t max_free_per_class)
+    : memory_type_(memory_type), memory_type_id_(memory_type_id),
+      max_free_per_class_(max_free_per_class)
+{
+}
+
+OutputBufferPool::~OutputBufferPool()
+{
+  for (auto& size_class : free_buffers_) {
+    for (void* buffer : size_class) {
+      Free(buffer);
+    }
+  }
+}
+
+size_t
+OutputBufferPool::SizeClass(const size_t byte_size)
+{
+  size_t size_class = 0;
+  while ((size_t{1} << (size_class + kMinClassShift)) < byte_size) {
+    size_class++;
+  }
+  return size_class;
+}
+
+void*
+OutputBufferPool::Acquire(const size_t byte_size)
+{
+  const size_t size_class = SizeClass(byte_size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((size_class < free_buffers_.size()) &&
+        !free_buffers_[size_class].empty()) {
+      void* buffer = free_buffers_[size_class].back();
+      free_buffers_[size_class].pop_back();
+      return buffer;
+    }
+  }
+  return Allocate(size_t{1} << (size_class + kMinClassShift));
+}
+
+void
+OutputBufferPool::Release(void* buffer, const size_t byte_size)
+{
+  if (buffer == nullptr) {
+    return;
+  }
+  const size_t size_class = SizeClass(byte_size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size_class >= free_buffers_.size()) {
+      free_buffers_.resize(size_class + 1);
+    }
+    if (free_buffers_[size_class].size() < max_free_per_class_) {
+      free_buffers_[size_class].push_back(buffer);
+      return;
+    }
+  }
+  Free(buffer);
+}
+
+void*
+OutputBufferPool::Allocate(const size_t byte_size)
+{
+#ifdef TRITON_ENABLE_GPU
+  void* buffer = nullptr;
+  if (memory_type_ == TRITONSERVER_MEMORY_CPU_PINNED) {
+    cudaError_t err = cudaHostAlloc(&buffer, byte_size, cudaHostAllocPortable);
+    if (err != cudaSuccess) {
+      std::cerr << "failed to allocate pinned memory: "
+                << cudaGetErrorString(err) << std::endl;
+      return nullptr;
+    }
+    return buffer;
+  } else if (memory_type_ == TRITONSERVER_MEMORY_GPU) {
+    // Allocations run on the threads of the server, which keep their device
+    int current_device;
+    cudaError_t err = cudaGetDevice(&current_device);
+    if (err == cudaSuccess) {
+      err = cudaSetDevice(memory_type_id_);
+    }
+    if (err == cudaSuccess) {
+      err = cudaMalloc(&buffer, byte_size);
+      cudaSetDevice(current_device);
+    }
+    if (err != cudaSuccess) {
+      std::cerr << "failed to allocate memory on GPU " << memory_type_id_
+                << ": " << cudaGetErrorString(err) << std::endl;
+      return nullptr;
+    }
+    return buffer;
+  }
+#endif  // TRITON_ENABLE_GPU
+  return malloc(byte_size);
+}
+
+void
+OutputBufferPool::Free(void* buffer)
+{
+#ifdef TRITON_ENABLE_GPU
+  if (memory_type_ == TRITONSERVER_MEMORY_CPU_PINNED) {
+    cudaFreeHost(buffer);
+    return;
+  } else if (memory_type_ == TRITONSERVER_MEMORY_GPU) {
+    cudaFree(buffer);
+    return;
+  }
+#endif  // TRITON_ENABLE_GPU
+  free(buffer);
+}
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::tritoncapi
@@ -0,0 +1,80 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "triton/core/tritonserver.h"
+
+namespace triton { namespace perfanalyzer { namespace clientbackend {
+namespace tritoncapi {
+
+/// Recycles the buffers that the responses are written into, all in the
+/// same kind of memory. Buffers are grouped in power of two size classes so
+/// that a buffer released by one response can be handed to the next
+/// response of a similar size. Thread-safe, the responses are allocated and
+/// released on the threads of the server.
+class OutputBufferPool {
+ public:
+  /// \param memory_type The memory to allocate the buffers in. Pinned and
+  /// GPU memory require TRITON_ENABLE_GPU.
+  /// \param memory_type_id The device of GPU memory.
+  /// \param max_free_per_class The number of released buffers kept in each
+  /// size class, buffers released beyond that are freed.
+  OutputBufferPool(
+      const TRITONSERVER_MemoryType memory_type = TRITONSERVER_MEMORY_CPU,
+      const int64_t memory_type_id = 0,
+      const size_t max_free_per_class = 256);
+  ~OutputBufferPool();
+
+  /// \param byte_size The size of the buffer to acquire, must be non-zero.
+  /// \return A buffer of at least 'byte_size' bytes, or nullptr when it
+  /// could not be allocated.
+  void* Acquire(const size_t byte_size);
+
+  /// \param buffer The buffer to release, returned by Acquire.
+  /// \param byte_size The size that the buffer was acquired with.
+  void Release(void* buffer, const size_t byte_size);
+
+  TRITONSERVER_MemoryType MemoryType() const { return memory_type_; }
+  int64_t MemoryTypeId() const { return memory_type_id_; }
+
+ private:
+  static size_t SizeClass(const size_t byte_size);
+
+  void* Allocate(const size_t byte_size);
+  void Free(void* buffer);
+
+  const TRITONSERVER_MemoryType memory_type_;
+  const int64_t memory_type_id_;
+  const size_t max_free_per_class_;
+  std::mutex mutex_;
+  std::vector<std::vector<void*>> free_buffers_;
+};
+
+}}}}  // namespace triton::perfanalyzer::clientbackend::tritoncapi
@@ -42,26 +42,54 @@ SharedMemoryManager::~SharedMemoryManager()
   UnregisterAll(TRITONSERVER_MEMORY_GPU);
 }
 
+uint64_t
+SharedMemoryManager::NextVersion()
+{
+  static std::atomic<uint64_t> next_version{1};
+  return next_version++;
+}
+
+SharedMemoryManager::SharedMemoryStateMap
+SharedMemoryManager::CopyRegions() const
+{
+  // Only called while holding 'mu_', so the map is not replaced meanwhile
+  return *shared_memory_map_;
+}
+
+void
+SharedMemoryManager::PublishRegions(SharedMemoryStateMap&& regions)
+{
+  std::atomic_store(
+      &shared_memory_map_, std::shared_ptr<const SharedMemoryStateMap>(
+                               std::make_shared<SharedMemoryStateMap>(
+                                   std::move(regions))));
+  // The lookups that see the new version load the new map
+  version_.store(NextVersion(), std::memory_order_release);
+}
+
 #ifdef TRITON_ENABLE_GPU
 Error
 SharedMemoryManager::RegisterCUDAMemory(
     const std::string& name, void* dev_ptr, const size_t byte_size,
     const int device_id)
 {
-  // Serialize all operations that write/read current shared memory regions
+  // Serialize all operations that write current shared memory regions
   std::lock_guard<std::mutex> lock(mu_);
 
   // If name is already in shared_memory_map_ then return error saying already
   // registered
-  if (shared_memory_map_.find(name) != shared_memory_map_.end()) {
+  if (shared_memory_map_->find(name) != shared_memory_map_->end()) {
     return Error(
         std::string("shared memory region '" + name + "' already in manager"));
   }
 
-  shared_memory_map_.insert(std::make_pair(
-      name, std::unique_ptr<MemoryInfo>(new MemoryInfo(
-                name, 0 /* offset */, byte_size, dev_ptr,
-                TRITONSERVER_MEMORY_GPU, device_id))));
+  SharedMemoryStateMap regions = CopyRegions();
+  regions.emplace(
+      std::piecewise_construct, std::forward_as_tuple(name),
+      std::forward_as_tuple(
+          name, 0 /* offset */, byte_size, dev_ptr, TRITONSERVER_MEMORY_GPU,
+          device_id));
+  PublishRegions(std::move(regions));
   return Error::Success;
 }
 #endif  // TRITON_ENABLE_GPU
@@ -70,19 +98,22 @@ Error
 SharedMemoryManager::RegisterSystemMemory(
     const std::string& name, void* ptr, const size_t byte_size)
 {
-  // Serialize all operations that write/read current shared memory regions
+  // Serialize all operations that write current shared memory regions
   std::lock_guard<std::mutex> lock(mu_);
 
   // If name is already in shared_memory_map_ then return error saying already
   // registered
-  if (shared_memory_map_.find(name) != shared_memory_map_.end()) {
+  if (shared_memory_map_->find(name) != shared_memory_map_->end()) {
     return Error("shared memory region '" + name + "' already in manager");
   }
 
-  shared_memory_map_.insert(std::make_pair(
-      name, std::make_unique<MemoryInfo>(
-                name, 0 /* offset */, byte_size, ptr, TRITONSERVER_MEMORY_CPU,
-                0 /* device id */)));
+  SharedMemoryStateMap regions = CopyRegions();
+  regions.emplace(
+      std::piecewise_construct, std::forward_as_tuple(name),
+      std::forward_as_tuple(
+          name, 0 /* offset */, byte_size, ptr, TRITONSERVER_MEMORY_CPU,
+          0 /* device id */));
+  PublishRegions(std::move(regions));
 
   return Error::Success;
 }
@@ -92,23 +123,35 @@ SharedMemoryManager::GetMemoryInfo(
     const std::string& name, size_t offset, void** shm_mapped_addr,
     TRITONSERVER_MemoryType* memory_type, int64_t* device_id)
 {
-  // protect shared_memory_map_ from concurrent access
-  std::lock_guard<std::mutex> lock(mu_);
+  // Each thread keeps the last map it loaded and only loads the map again
+  // once its version changed, so that the lookups of the inferences neither
+  // take 'mu_' nor touch the reference count of the shared map.
+  struct CachedRegions {
+    uint64_t version_{0};
+    std::shared_ptr<const SharedMemoryStateMap> regions_;
+  };
+  thread_local CachedRegions cached;
+  const uint64_t version = version_.load(std::memory_order_acquire);
+  if (cached.version_ != version) {
+    cached.regions_ = std::atomic_load(&shared_memory_map_);
+    cached.version_ = version;
+  }
 
-  auto it = shared_memory_map_.find(name);
-  if (it == shared_memory_map_.end()) {
+  auto it = cached.regions_->find(name);
+  if (it == cached.regions_->end()) {
     return Error(
         std::string("Unable to find shared memory region: '" + name + "'"));
   }
-  if (it->second->kind_ == TRITONSERVER_MEMORY_CPU) {
+  const MemoryInfo& info = it->second;
+  if (info.kind_ == TRITONSERVER_MEMORY_CPU) {
     *shm_mapped_addr =
-        (void*)((uint8_t*)it->second->mapped_addr_ + it->second->offset_ + offset);
+        (void*)((uint8_t*)info.mapped_addr_ + info.offset_ + offset);
   } else {
-    *shm_mapped_addr = (void*)((uint8_t*)it->second->mapped_addr_ + offset);
+    *shm_mapped_addr = (void*)((uint8_t*)info.mapped_addr_ + offset);
   }
 
-  *memory_type = it->second->kind_;
-  *device_id = it->second->device_id_;
+  *memory_type = info.kind_;
+  *device_id = info.device_id_;
 
   return Error::Success;
 }
@@ -118,41 +161,41 @@ Error
 SharedMemoryManager::Unregister(
     const std::string& name, TRITONSERVER_MemoryType memory_type)
 {
-  // Serialize all operations that write/read current shared memory regions
+  // Serialize all operations that write current shared memory regions
   std::lock_guard<std::mutex> lock(mu_);
 
-  return UnregisterHelper(name, memory_type);
+  SharedMemoryStateMap regions = CopyRegions();
+  RETURN_IF_ERROR(UnregisterHelper(name, memory_type, &regions));
+  PublishRegions(std::move(regions));
+  return Error::Success;
 }
 
 Error
 SharedMemoryManager::UnregisterAll(TRITONSERVER_MemoryType memory_type)
 {
-  // Serialize all operations that write/read current shared memory regions
+  // Serialize all operations that write current shared memory regions
   std::lock_guard<std::mutex> lock(mu_);
   std::string error_message = "Failed to unregister the following ";
   std::vector<std::string> unregister_fails;
 
   if (memory_type == TRITONSERVER_MEMORY_CPU) {
     error_message += "system shared memory regions: ";
-    for (auto& it : shared_memory_map_) {
-      if (it.second->kind_ == TRITONSERVER_MEMORY_CPU) {
-        Error err = UnregisterHelper(it.first, memory_type);
-        if (!err.IsOk()) {
-          unregister_fails.push_back(it.first);
-        }
-      }
-    }
   } else if (memory_type == TRITONSERVER_MEMORY_GPU) {
     error_message += "cuda shared memory regions: ";
-    for (auto& it : shared_memory_map_) {
-      if (it.second->kind_ == TRITONSERVER_MEMORY_GPU) {
-        Error err = UnregisterHelper(it.first, memory_type);
-        if (!err.IsOk()) {
-          unregister_fails.push_back(it.first);
-        }
+  }
+  // The regions are removed from a copy, not from the map being iterated
+  SharedMemoryStateMap regions = CopyRegions();
+  for (const auto& it : *shared_memory_map_) {
+    if (it.second.kind_ == memory_type) {
+      Error err = UnregisterHelper(it.first, memory_type, &regions);
+      if (!err.IsOk()) {
+        unregister_fails.push_back(it.first);
       }
     }
   }
+  if (regions.size() != shared_memory_map_->size()) {
+    PublishRegions(std::move(regions));
+  }
 
   if (!unregister_fails.empty()) {
     for (auto unreg_fail : unregister_fails) {
@@ -166,17 +209,18 @@ SharedMemoryManager::UnregisterAll(TRITONSERVER_MemoryType memory_type)
 
 Error
 SharedMemoryManager::UnregisterHelper(
-    const std::string& name, TRITONSERVER_MemoryType memory_type)
+    const std::string& name, TRITONSERVER_MemoryType memory_type,
+    SharedMemoryStateMap* regions)
 {
-  // Must hold the lock on register_mu_ while calling this function.
-  auto it = shared_memory_map_.find(name);
+  // Must hold the lock on mu_ while calling this function.
+  auto it = regions->find(name);
 
-  if (it == shared_memory_map_.end()) {
+  if (it == regions->end()) {
     return Error("Shared memory region " + name + " doesn't exist.");
   }
 
-  // Remove region information from shared_memory_map_
-  shared_memory_map_.erase(it);
+  // Remove region information from the regions
+  regions->erase(it);
 
   return Error::Success;
 }
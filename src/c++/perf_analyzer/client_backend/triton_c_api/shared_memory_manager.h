@@ -26,10 +26,12 @@
 #pragma once
 
 #include <triton/core/tritonserver.h>
+#include <atomic>
 #include <cstring>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include "../client_backend.h"
 
 #ifdef TRITON_ENABLE_GPU
@@ -69,7 +71,9 @@ class SharedMemoryManager {
       const std::string& name, void* ptr, const size_t byte_size);
 
   /// Get the access information for the shared memory block with the specified
-  /// name. Return an Error if named block doesn't exist.
+  /// name. Return an Error if named block doesn't exist. The lookup doesn't
+  /// take a lock, it reads the regions registered when the calling thread
+  /// last saw a change of them.
   /// \param name The name of the shared memory block to get.
   /// \param offset The offset in the block
   /// \param shm_mapped_addr Returns the pointer to the shared
@@ -98,11 +102,6 @@ class SharedMemoryManager {
   Error UnregisterAll(TRITONSERVER_MemoryType memory_type);
 
  private:
-  /// A helper function to remove the named shared memory blocks of
-  /// specified type
-  Error UnregisterHelper(
-      const std::string& name, TRITONSERVER_MemoryType memory_type);
-
   /// A struct that records the shared memory regions registered by the shared
   /// memory manager.
   struct MemoryInfo {
@@ -123,14 +122,32 @@ class SharedMemoryManager {
     int64_t device_id_;
   };
 
-  using SharedMemoryStateMap =
-      std::map<std::string, std::unique_ptr<MemoryInfo>>;
+  using SharedMemoryStateMap = std::unordered_map<std::string, MemoryInfo>;
+
+  /// A helper function to remove the named shared memory blocks of
+  /// specified type from 'regions'
+  Error UnregisterHelper(
+      const std::string& name, TRITONSERVER_MemoryType memory_type,
+      SharedMemoryStateMap* regions);
+
+  /// Copy the current regions for a change.
+  SharedMemoryStateMap CopyRegions() const;
+
+  /// Make 'regions' the regions seen by the lookups.
+  void PublishRegions(SharedMemoryStateMap&& regions);
+
+  // A map between the name and the details of the associated shared memory
+  // block. It is never modified once published, a change publishes a new
+  // map that the lookups pick up when they see the new version.
+  std::shared_ptr<const SharedMemoryStateMap> shared_memory_map_{
+      std::make_shared<SharedMemoryStateMap>()};
 
-  // A map between the name and the details of the associated
-  // shared memory block
-  SharedMemoryStateMap shared_memory_map_;
+  // The version of 'shared_memory_map_', unique across managers so that a
+  // map cached by a thread is never mistaken for the map of another one.
+  std::atomic<uint64_t> version_{NextVersion()};
+  static uint64_t NextVersion();
 
-  // A mutex to protect the concurrent access to shared_memory_map_
+  // A mutex to serialize the changes of shared_memory_map_
   std::mutex mu_;
 };
 }}}}  // namespace triton::perfanalyzer::clientbackend::tritoncapi
@@ -38,7 +38,9 @@ namespace tritoncapi {
 Error
 TritonCApiClientBackend::Create(
     const std::string& triton_server_path,
-    const std::string& model_repository_path, const bool verbose,
+    const std::string& model_repository_path,
+    const OutputMemoryPolicy& output_memory_policy, const bool lazy_model_load,
+    const bool server_request_trace, const bool verbose,
     std::unique_ptr<ClientBackend>* client_backend)
 {
   if (triton_server_path.empty()) {
@@ -55,7 +57,9 @@ TritonCApiClientBackend::Create(
 
   std::unique_ptr<TritonCApiClientBackend> triton_client_backend(
       new TritonCApiClientBackend());
-  TritonLoader::Create(triton_server_path, model_repository_path, verbose);
+  TritonLoader::Create(
+      triton_server_path, model_repository_path, output_memory_policy,
+      lazy_model_load, server_request_trace, verbose);
   *client_backend = std::move(triton_client_backend);
   return Error::Success;
 }
@@ -77,10 +81,11 @@ TritonCApiClientBackend::ModelMetadata(
     rapidjson::Document* model_metadata, const std::string& model_name,
     const std::string& model_version)
 {
-  if (!triton_loader_->ModelIsLoaded()) {
-    triton_loader_->LoadModel(model_name, model_version);
+  if (!triton_loader_->ModelIsLoaded(model_name, model_version)) {
+    RETURN_IF_ERROR(triton_loader_->LoadModel(model_name, model_version));
   }
-  RETURN_IF_ERROR(triton_loader_->ModelMetadata(model_metadata));
+  RETURN_IF_ERROR(triton_loader_->ModelMetadata(
+      model_metadata, model_name, model_version));
   return Error::Success;
 }
 
@@ -89,8 +94,8 @@ TritonCApiClientBackend::ModelConfig(
     rapidjson::Document* model_config, const std::string& model_name,
     const std::string& model_version)
 {
-  if (!triton_loader_->ModelIsLoaded()) {
-    triton_loader_->LoadModel(model_name, model_version);
+  if (!triton_loader_->ModelIsLoaded(model_name, model_version)) {
+    RETURN_IF_ERROR(triton_loader_->LoadModel(model_name, model_version));
   }
   RETURN_IF_ERROR(
       triton_loader_->ModelConfig(model_config, model_name, model_version));
@@ -120,6 +125,64 @@ TritonCApiClientBackend::Infer(
   return Error::Success;
 }
 
+Error
+TritonCApiClientBackend::AsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  return SendAsync(callback, true /* enable_stats */, options, inputs, outputs);
+}
+
+Error
+TritonCApiClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
+{
+  stream_callback_ = callback;
+  stream_enable_stats_ = enable_stats;
+  return Error::Success;
+}
+
+Error
+TritonCApiClientBackend::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  if (stream_callback_ == nullptr) {
+    return Error(
+        "stream must be started before sending streaming inferences",
+        pa::GENERIC_ERROR);
+  }
+  return SendAsync(
+      stream_callback_, stream_enable_stats_, options, inputs, outputs);
+}
+
+Error
+TritonCApiClientBackend::SendAsync(
+    OnCompleteFn callback, const bool enable_stats,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  auto wrapped_callback = [callback](capi::InferResult* triton_result) {
+    cb::InferResult* result = new TritonCApiInferResult(triton_result);
+    callback(result);
+  };
+
+  std::vector<tc::InferInput*> triton_inputs;
+  ParseInferInputToTriton(inputs, &triton_inputs);
+
+  std::vector<const tc::InferRequestedOutput*> triton_outputs;
+  ParseInferRequestedOutputToTriton(outputs, &triton_outputs);
+
+  tc::InferOptions triton_options(options.model_name_);
+  ParseInferOptionsToTriton(options, &triton_options);
+
+  RETURN_IF_ERROR(triton_loader_->AsyncInfer(
+      wrapped_callback, triton_options, triton_inputs, triton_outputs,
+      enable_stats));
+
+  return Error::Success;
+}
+
 
 Error
 TritonCApiClientBackend::ClientInferStat(InferStat* infer_stat)
@@ -131,6 +194,13 @@ TritonCApiClientBackend::ClientInferStat(InferStat* infer_stat)
   return Error::Success;
 }
 
+Error
+TritonCApiClientBackend::ServerRequestTimings(
+    std::vector<ServerRequestTiming>* timings)
+{
+  return triton_loader_->TakeServerRequestTimings(timings);
+}
+
 Error
 TritonCApiClientBackend::ModelInferenceStatistics(
     std::map<ModelIdentifier, ModelStatistics>* model_stats,
@@ -206,6 +276,8 @@ TritonCApiClientBackend::ParseInferOptionsToTriton(
     triton_options->sequence_start_ = options.sequence_start_;
     triton_options->sequence_end_ = options.sequence_end_;
   }
+  triton_options->priority_ = options.priority_;
+  triton_options->server_timeout_ = options.server_timeout_;
 }
 
 void
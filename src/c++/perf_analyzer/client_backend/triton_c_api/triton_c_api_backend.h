@@ -67,14 +67,22 @@ class TritonCApiClientBackend : public ClientBackend {
   /// \param triton_server_path Tritonserver library that contains
   /// lib/libtritonserver.so.
   /// \param model_repository_path The model repository.
+  /// \param output_memory_policy Where the outputs that are not in shared
+  /// memory are allocated.
+  /// \param lazy_model_load Whether the server loads only the models that
+  /// are used instead of the whole model repository.
+  /// \param server_request_trace Whether the server traces the timestamps of
+  /// every request.
   /// \param verbose Enables the verbose mode of TritonServer.
   /// \param client_backend Returns a new TritonCApiClientBackend object.
   /// \return Error object indicating success
   /// or failure.
   static Error Create(
       const std::string& triton_server_path,
-      const std::string& model_repository_path, const bool verbose,
-      std::unique_ptr<ClientBackend>* client_backend);
+      const std::string& model_repository_path,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
+      const bool verbose, std::unique_ptr<ClientBackend>* client_backend);
 
   ~TritonCApiClientBackend() { triton_loader_->Delete(); }
 
@@ -97,6 +105,22 @@ class TritonCApiClientBackend : public ClientBackend {
       const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs) override;
 
+  /// See ClientBackend::AsyncInfer()
+  Error AsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
+  /// See ClientBackend::StartStream()
+  /// The server is in-process, so a stream only sets the callback and
+  /// whether client statistics are tracked for the requests sent to it.
+  Error StartStream(OnCompleteFn callback, bool enable_stats) override;
+
+  /// See ClientBackend::AsyncStreamInfer()
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs) override;
+
   /// See ClientBackend::ClientInferStat()
   Error ClientInferStat(InferStat* infer_stat) override;
 
@@ -106,6 +130,10 @@ class TritonCApiClientBackend : public ClientBackend {
       const std::string& model_name = "",
       const std::string& model_version = "") override;
 
+  /// See ClientBackend::ServerRequestTimings()
+  Error ServerRequestTimings(
+      std::vector<ServerRequestTiming>* timings) override;
+
 #ifdef TRITON_ENABLE_GPU
   /// See ClientBackend::RegisterCudaMemory
   Error RegisterCudaMemory(
@@ -138,7 +166,14 @@ class TritonCApiClientBackend : public ClientBackend {
       std::map<ModelIdentifier, ModelStatistics>* model_stats);
   void ParseInferStat(
       const tc::InferStat& triton_infer_stat, InferStat* infer_stat);
+  Error SendAsync(
+      OnCompleteFn callback, const bool enable_stats,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs);
   TritonLoader* triton_loader_;
+
+  OnCompleteFn stream_callback_{nullptr};
+  bool stream_enable_stats_{true};
 };
 
 //==============================================================
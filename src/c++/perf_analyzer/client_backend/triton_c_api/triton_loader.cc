@@ -32,6 +32,7 @@
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <sys/stat.h>
+#include <atomic>
 #include <future>
 #include <sstream>
 #include <string>
@@ -89,16 +90,13 @@ ResponseAlloc(
   *actual_memory_type = preferred_memory_type;
   *actual_memory_type_id = preferred_memory_type_id;
 
-  // This variable indicates whether the buffer should be freed or not.
-  bool* should_free = new bool;
-  *buffer_userp = should_free;
-  *should_free = false;
+  // The pool that the buffer is returned to, if any
+  *buffer_userp = nullptr;
 
   // If 'byte_size' is zero just return 'buffer' == nullptr, we don't
   // need to do any other book-keeping.
   if (byte_size == 0) {
     *buffer = nullptr;
-    *buffer_userp = nullptr;
     if (helper_verbose) {
       std::cout << "allocated " << byte_size << " bytes for result tensor "
                 << tensor_name << std::endl;
@@ -107,15 +105,21 @@ ResponseAlloc(
     AllocPayload* alloc_payload = reinterpret_cast<AllocPayload*>(userp);
     auto output_map_it = alloc_payload->output_map_.find(tensor_name);
     if (output_map_it == alloc_payload->output_map_.end()) {
-      void* allocated_ptr = nullptr;
-      *actual_memory_type = TRITONSERVER_MEMORY_CPU;
-      *actual_memory_type_id = 0;
-      allocated_ptr = malloc(byte_size);
-      *should_free = true;
-
-      if (allocated_ptr != nullptr) {
-        *buffer = allocated_ptr;
+      OutputBufferPool* buffer_pool =
+          TritonLoader::GetSingleton()->OutputBuffers(
+              preferred_memory_type, preferred_memory_type_id);
+      *actual_memory_type = buffer_pool->MemoryType();
+      *actual_memory_type_id = buffer_pool->MemoryTypeId();
+      *buffer = buffer_pool->Acquire(byte_size);
+      if (*buffer == nullptr) {
+        return TritonLoader::GetSingleton()->ErrorNew(
+            TRITONSERVER_ERROR_INTERNAL,
+            std::string(
+                "failed to allocate " + std::to_string(byte_size) +
+                " bytes for output '" + std::string(tensor_name) + "'")
+                .c_str());
       }
+      *buffer_userp = buffer_pool;
     } else {
       // It is in shared memory
       AllocPayload::OutputInfo* output_info = output_map_it->second;
@@ -146,16 +150,11 @@ ResponseRelease(
     size_t byte_size, TRITONSERVER_MemoryType memory_type,
     int64_t memory_type_id)
 {
-  bool* should_free = reinterpret_cast<bool*>(buffer_userp);
-  switch (memory_type) {
-    case TRITONSERVER_MEMORY_CPU:
-      if (*should_free) {
-        free(buffer);
-      }
-      break;
+  // Shared memory buffers have no pool, they are owned by the client
+  if (buffer_userp != nullptr) {
+    reinterpret_cast<OutputBufferPool*>(buffer_userp)
+        ->Release(buffer, byte_size);
   }
-
-  free(should_free);
   return nullptr;  // Success
 }
 
@@ -163,23 +162,13 @@ void
 InferRequestComplete(
     TRITONSERVER_InferenceRequest* request, const uint32_t flags, void* userp)
 {
-  TritonLoader::GetSingleton()->DeleteInferRequest(request);
-}
-
-
-void
-InferResponseComplete(
-    TRITONSERVER_InferenceResponse* response, const uint32_t flags, void* userp)
-{
-  if (response != nullptr) {
-    // Send 'response' to the future.
-    std::promise<TRITONSERVER_InferenceResponse*>* p =
-        reinterpret_cast<std::promise<TRITONSERVER_InferenceResponse*>*>(userp);
-    p->set_value(response);
-    delete p;
+  if ((flags & TRITONSERVER_REQUEST_RELEASE_ALL) != 0) {
+    TritonLoader::GetSingleton()->RecycleInferRequest(
+        request, reinterpret_cast<TritonLoader::RequestPool*>(userp));
   }
 }
 
+
 Error
 GetModelVersionFromString(const std::string& version_string, int64_t* version)
 {
@@ -220,17 +209,47 @@ FolderExists(const std::string& path)
     return Error("Unable to find filepath: " + path);
   }
 }
+
+// How often and how many times the readiness of the server and of the models
+// is polled, checking often keeps the startup short
+constexpr std::chrono::milliseconds kReadinessPollInterval{50};
+constexpr size_t kReadinessPollCount{100};
 }  // namespace
 
+/// A request in flight. The response callback owns it once the server
+/// accepted the request, until the final response.
+struct TritonLoader::AsyncRequest {
+  OnCompleteFn callback_;
+  bool enable_stats_{true};
+  bool first_response_{true};
+  std::string id_;
+  AllocPayload alloc_payload_;
+  tc::RequestTimers timer_;
+};
+
+/// The timestamps traced for a request, owned by its trace. Composing models
+/// of ensembles trace into child traces, only the top-level one is kept.
+struct TritonLoader::RequestTrace {
+  TRITONSERVER_InferenceTrace* trace_{nullptr};
+  uint64_t queue_start_ns_{0};
+  uint64_t compute_start_ns_{0};
+  uint64_t compute_input_end_ns_{0};
+  uint64_t compute_output_start_ns_{0};
+  uint64_t compute_end_ns_{0};
+};
+
 Error
 TritonLoader::Create(
     const std::string& triton_server_path,
-    const std::string& model_repository_path, bool verbose)
+    const std::string& model_repository_path,
+    const OutputMemoryPolicy& output_memory_policy, const bool lazy_model_load,
+    const bool server_request_trace, bool verbose)
 {
   if (!GetSingleton()->ServerIsReady()) {
     GetSingleton()->ClearHandles();
     RETURN_IF_ERROR(GetSingleton()->PopulateInternals(
-        triton_server_path, model_repository_path, verbose));
+        triton_server_path, model_repository_path, output_memory_policy,
+        lazy_model_load, server_request_trace, verbose));
     RETURN_IF_ERROR(GetSingleton()->LoadServerLibrary());
     RETURN_IF_ERROR(GetSingleton()->StartTriton());
   }
@@ -244,6 +263,14 @@ TritonLoader::Delete()
   if (server_ != nullptr) {
     server_is_ready_ = false;
     model_is_loaded_ = false;
+    loaded_models_.clear();
+    model_snapshots_.clear();
+    ClearRequestPool(false /* reopen */);
+    if (response_allocator_ != nullptr) {
+      REPORT_TRITONSERVER_ERROR(
+          response_allocator_delete_fn_(response_allocator_));
+      response_allocator_ = nullptr;
+    }
     server_.reset();
   }
   return Error::Success;
@@ -252,13 +279,18 @@ TritonLoader::Delete()
 Error
 TritonLoader::PopulateInternals(
     const std::string& triton_server_path,
-    const std::string& model_repository_path, bool verbose)
+    const std::string& model_repository_path,
+    const OutputMemoryPolicy& output_memory_policy, const bool lazy_model_load,
+    const bool server_request_trace, bool verbose)
 {
   RETURN_IF_ERROR(FolderExists(triton_server_path));
   RETURN_IF_ERROR(FolderExists(model_repository_path));
 
   triton_server_path_ = triton_server_path;
   model_repository_path_ = model_repository_path;
+  output_memory_policy_ = output_memory_policy;
+  lazy_model_load_ = lazy_model_load;
+  server_request_trace_ = server_request_trace;
   verbose_ = verbose;
   verbose_level_ = verbose_ ? 1 : 0;
   return Error::Success;
@@ -289,6 +321,13 @@ TritonLoader::StartTriton()
       options_set_model_repo_path_fn_(
           server_options, model_repository_path_.c_str()),
       "setting model repository path");
+  if (lazy_model_load_) {
+    // Nothing is loaded until LoadModel() asks for it
+    RETURN_IF_TRITONSERVER_ERROR(
+        set_model_control_mode_fn_(
+            server_options, TRITONSERVER_MODEL_CONTROL_EXPLICIT),
+        "setting model control mode");
+  }
   RETURN_IF_TRITONSERVER_ERROR(
       set_cuda_memory_pool_byte_size_(server_options, 0, 1073741824),
       "setting cuda memory pool byte size failed.");
@@ -339,11 +378,11 @@ TritonLoader::StartTriton()
       break;
     }
 
-    if (++health_iters >= 10) {
+    if (++health_iters >= kReadinessPollCount) {
       return Error("failed to find healthy inference server");
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    std::this_thread::sleep_for(kReadinessPollInterval);
   }
   // Print status of the server.
   if (verbose_) {
@@ -363,6 +402,29 @@ TritonLoader::StartTriton()
         "deleting status metadata");
   }
 
+  ClearRequestPool(true /* reopen */);
+  RETURN_IF_ERROR(CreateResponseAllocator());
+
+  return Error::Success;
+}
+
+Error
+TritonLoader::CreateResponseAllocator()
+{
+  if (response_allocator_ != nullptr) {
+    return Error::Success;
+  }
+  RETURN_IF_TRITONSERVER_ERROR(
+      response_allocator_new_fn_(
+          &response_allocator_,
+          reinterpret_cast<
+              TRITONSERVER_Error* (*)(TRITONSERVER_ResponseAllocator * allocator, const char* tensor_name, size_t byte_size, TRITONSERVER_MemoryType memory_type, int64_t memory_type_id, void* userp, void** buffer, void** buffer_userp, TRITONSERVER_MemoryType* actual_memory_type, int64_t* actual_memory_type_id)>(
+              ResponseAlloc),
+          reinterpret_cast<
+              TRITONSERVER_Error* (*)(TRITONSERVER_ResponseAllocator * allocator, void* buffer, void* buffer_userp, size_t byte_size, TRITONSERVER_MemoryType memory_type, int64_t memory_type_id)>(
+              ResponseRelease),
+          nullptr /* start_fn */),
+      "creating response allocator");
   return Error::Success;
 }
 
@@ -401,47 +463,102 @@ TritonLoader::LoadModel(
   if (!ServerIsReady()) {
     return Error("server is not ready, abort!");
   }
-  model_name_ = model_name;
-
-  RETURN_IF_ERROR(GetModelVersionFromString(model_version, &model_version_));
-  // Wait for the model to become available.
-  bool is_ready = false;
-  size_t health_iters = 0;
+  int64_t requested_model_version;
+  RETURN_IF_ERROR(
+      GetModelVersionFromString(model_version, &requested_model_version));
 
   // some error handling
   if (model_repository_path_.empty()) {
     return Error("Need to specify model repository");
   }
+
+  const ModelSnapshot snapshot = SnapshotModel(model_name);
+  auto snapshot_it = model_snapshots_.find(model_name);
+  const bool unchanged = (snapshot_it != model_snapshots_.end()) &&
+                         (snapshot_it->second == snapshot);
+  if (unchanged && ModelIsLoaded(model_name, model_version)) {
+    return Error::Success;
+  }
+  if (lazy_model_load_ && !unchanged) {
+    // Loading a model that the server already has loads it again
+    RETURN_IF_TRITONSERVER_ERROR(
+        load_model_fn_(server_.get(), model_name.c_str()),
+        "unable to load model '" + model_name + "'");
+  }
+
+  // Wait for the model to become available.
+  bool is_ready = false;
+  size_t health_iters = 0;
   while (!is_ready) {
     RETURN_IF_TRITONSERVER_ERROR(
         model_is_ready_fn_(
-            server_.get(), model_name_.c_str(), model_version_, &is_ready),
+            server_.get(), model_name.c_str(), requested_model_version,
+            &is_ready),
         "unable to get model readiness");
     if (!is_ready) {
-      if (++health_iters >= 10) {
-        return Error("model failed to be ready in 10 iterations");
+      if (++health_iters >= kReadinessPollCount) {
+        return Error(
+            "model failed to be ready in " +
+            std::to_string(kReadinessPollCount) + " iterations");
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      std::this_thread::sleep_for(kReadinessPollInterval);
       continue;
     }
   }
   // flag to confirm model is correct and loaded
+  model_snapshots_[model_name] = snapshot;
+  loaded_models_.emplace(model_name, requested_model_version);
   model_is_loaded_ = true;
   return Error::Success;
 }
 
+TritonLoader::ModelSnapshot
+TritonLoader::SnapshotModel(const std::string& model_name)
+{
+  ModelSnapshot snapshot;
+  const std::string model_path = model_repository_path_ + "/" + model_name;
+  struct stat buffer;
+  if (!stat((model_path + "/config.pbtxt").c_str(), &buffer)) {
+    snapshot.config_mtime = buffer.st_mtime;
+    snapshot.config_size = buffer.st_size;
+  }
+  // Adding or removing a version directory changes the model directory
+  if (!stat(model_path.c_str(), &buffer)) {
+    snapshot.directory_mtime = buffer.st_mtime;
+  }
+  return snapshot;
+}
+
+bool
+TritonLoader::ModelIsLoaded(
+    const std::string& model_name, const std::string& model_version)
+{
+  int64_t requested_model_version;
+  if (!GetModelVersionFromString(model_version, &requested_model_version)
+           .IsOk()) {
+    return false;
+  }
+  return loaded_models_.find(std::make_pair(
+             model_name, requested_model_version)) != loaded_models_.end();
+}
+
 Error
-TritonLoader::ModelMetadata(rapidjson::Document* model_metadata)
+TritonLoader::ModelMetadata(
+    rapidjson::Document* model_metadata, const std::string& model_name,
+    const std::string& model_version)
 {
-  if (!ModelIsLoaded() || !ServerIsReady()) {
+  if (!ModelIsLoaded(model_name, model_version) || !ServerIsReady()) {
     return Error("Model is not loaded and/or server is not ready");
   }
+  int64_t requested_model_version;
+  RETURN_IF_ERROR(
+      GetModelVersionFromString(model_version, &requested_model_version));
   TRITONSERVER_Message* model_metadata_message;
 
   // get model metadata
   RETURN_IF_TRITONSERVER_ERROR(
       model_metadata_fn_(
-          server_.get(), model_name_.c_str(), model_version_,
+          server_.get(), model_name.c_str(), requested_model_version,
           &model_metadata_message),
       "unable to get model metadata message");
   const char* buffer;
@@ -462,15 +579,16 @@ TritonLoader::ModelMetadata(rapidjson::Document* model_metadata)
   RETURN_IF_TRITONSERVER_ERROR(
       message_delete_fn_(model_metadata_message), "deleting status protobuf");
 
-  if (strcmp((*model_metadata)["name"].GetString(), model_name_.c_str())) {
+  if (strcmp((*model_metadata)["name"].GetString(), model_name.c_str())) {
     return Error("unable to find metadata for model");
   }
 
   bool found_version = false;
   if (model_metadata->HasMember("versions")) {
     for (const auto& version : (*model_metadata)["versions"].GetArray()) {
-      if (strcmp(version.GetString(), std::to_string(model_version_).c_str()) ==
-          0) {
+      if (strcmp(
+              version.GetString(),
+              std::to_string(requested_model_version).c_str()) == 0) {
         found_version = true;
         break;
       }
@@ -478,7 +596,8 @@ TritonLoader::ModelMetadata(rapidjson::Document* model_metadata)
   }
   if (!found_version) {
     std::string msg = "unable to find version " +
-                      std::to_string(model_version_) + " status for model";
+                      std::to_string(requested_model_version) +
+                      " status for model";
     return Error(msg);
   }
   return Error::Success;
@@ -489,15 +608,18 @@ TritonLoader::ModelConfig(
     rapidjson::Document* model_config, const std::string& model_name,
     const std::string& model_version)
 {
-  if (!ModelIsLoaded() || !ServerIsReady()) {
+  if (!ModelIsLoaded(model_name, model_version) || !ServerIsReady()) {
     return Error("Model is not loaded and/or server is not ready");
   }
+  int64_t requested_model_version;
+  RETURN_IF_ERROR(
+      GetModelVersionFromString(model_version, &requested_model_version));
   TRITONSERVER_Message* model_config_message;
   uint32_t config_version = 1;
   RETURN_IF_TRITONSERVER_ERROR(
       model_config_fn_(
-          (server_).get(), model_name.c_str(), model_version_, config_version,
-          &model_config_message),
+          (server_).get(), model_name.c_str(), requested_model_version,
+          config_version, &model_config_message),
       "unable to get model config message");
   const char* buffer;
   size_t byte_size;
@@ -586,10 +708,16 @@ TritonLoader::LoadServerLibrary()
   TritonServerRequestIdFn_t ridfn;
   TritonServerRequestDeleteFn_t rdfn;
   TritonServerModelStatisticsFn_t msfn;
+  TritonServerRequestRemoveAllInputsFn_t rraifn;
+  TritonServerRequestRemoveAllRequestedOutputsFn_t rrarofn;
 
   TritonSeverUnloadModelFn_t umfn;
+  TritonServerLoadModelFn_t lmfn;
+  TritonServerSetModelControlModeFn_t smcmfn;
   TritonSeverSetLogInfoFn_t slifn;
   TritonServerSetCudaMemoryPoolByteSizeFn_t scmpbsfn;
+  TritonServerInferenceTraceNewFn_t itnfn;
+  TritonServerInferenceTraceDeleteFn_t itdfn;
 
   RETURN_IF_ERROR(GetEntrypoint(
       dlhandle_, "TRITONSERVER_ApiVersion", false /* optional */,
@@ -749,13 +877,31 @@ TritonLoader::LoadServerLibrary()
   RETURN_IF_ERROR(GetEntrypoint(
       dlhandle_, "TRITONSERVER_ServerModelStatistics", false /* optional */,
       reinterpret_cast<void**>(&msfn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_InferenceRequestRemoveAllInputs",
+      false /* optional */, reinterpret_cast<void**>(&rraifn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_InferenceRequestRemoveAllRequestedOutputs",
+      false /* optional */, reinterpret_cast<void**>(&rrarofn)));
 
   RETURN_IF_ERROR(GetEntrypoint(
       dlhandle_, "TRITONSERVER_ServerUnloadModel", false /* optional */,
       reinterpret_cast<void**>(&umfn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_ServerLoadModel", false /* optional */,
+      reinterpret_cast<void**>(&lmfn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_ServerOptionsSetModelControlMode",
+      false /* optional */, reinterpret_cast<void**>(&smcmfn)));
   RETURN_IF_ERROR(GetEntrypoint(
       dlhandle_, "TRITONSERVER_ServerOptionsSetLogInfo", false /* optional */,
       reinterpret_cast<void**>(&slifn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_InferenceTraceNew", false /* optional */,
+      reinterpret_cast<void**>(&itnfn)));
+  RETURN_IF_ERROR(GetEntrypoint(
+      dlhandle_, "TRITONSERVER_InferenceTraceDelete", false /* optional */,
+      reinterpret_cast<void**>(&itdfn)));
 
 
   api_version_fn_ = apifn;
@@ -817,10 +963,16 @@ TritonLoader::LoadServerLibrary()
   request_id_fn_ = ridfn;
   request_delete_fn_ = rdfn;
   model_statistics_fn_ = msfn;
+  request_remove_all_inputs_fn_ = rraifn;
+  request_remove_all_requested_outputs_fn_ = rrarofn;
 
   unload_model_fn_ = umfn;
+  load_model_fn_ = lmfn;
+  set_model_control_mode_fn_ = smcmfn;
   set_log_info_fn_ = slifn;
   set_cuda_memory_pool_byte_size_ = scmpbsfn;
+  trace_new_fn_ = itnfn;
+  trace_delete_fn_ = itdfn;
 
   return Error::Success;
 }
@@ -889,8 +1041,14 @@ TritonLoader::ClearHandles()
   request_id_fn_ = nullptr;
   request_delete_fn_ = nullptr;
   model_statistics_fn_ = nullptr;
+  request_remove_all_inputs_fn_ = nullptr;
+  request_remove_all_requested_outputs_fn_ = nullptr;
   unload_model_fn_ = nullptr;
+  load_model_fn_ = nullptr;
+  set_model_control_mode_fn_ = nullptr;
   set_log_info_fn_ = nullptr;
+  trace_new_fn_ = nullptr;
+  trace_delete_fn_ = nullptr;
 }
 
 Error
@@ -911,26 +1069,75 @@ TritonLoader::Infer(
     const std::vector<const tc::InferRequestedOutput*>& outputs,
     InferResult** result)
 {
-  Error error = Error::Success;
+  // Only the first response is waited for, a decoupled model can send more
+  auto first_result = std::make_shared<std::promise<InferResult*>>();
+  auto first_response = std::make_shared<std::atomic<bool>>(true);
+  std::future<InferResult*> completed = first_result->get_future();
+  RETURN_IF_ERROR(SendRequest(
+      options, inputs, outputs,
+      [first_result, first_response](InferResult* response_result) {
+        if (first_response->exchange(false)) {
+          first_result->set_value(response_result);
+        } else {
+          delete response_result;
+        }
+      },
+      true /* enable_stats */));
+
+  // Wait for the inference to complete.
+  *result = completed.get();
+
+  tc::Error status = (*result)->RequestStatus();
+  if (!status.IsOk()) {
+    delete *result;
+    *result = nullptr;
+    return Error(status.Message());
+  }
+  return Error::Success;
+}
+
+Error
+TritonLoader::AsyncInfer(
+    OnCompleteFn callback, const tc::InferOptions& options,
+    const std::vector<tc::InferInput*>& inputs,
+    const std::vector<const tc::InferRequestedOutput*>& outputs,
+    const bool enable_stats)
+{
+  return SendRequest(options, inputs, outputs, callback, enable_stats);
+}
+
+Error
+TritonLoader::SendRequest(
+    const tc::InferOptions& options, const std::vector<tc::InferInput*>& inputs,
+    const std::vector<const tc::InferRequestedOutput*>& outputs,
+    OnCompleteFn callback, const bool enable_stats)
+{
   if (!ServerIsReady() || !ModelIsLoaded()) {
     return Error("Server is not ready and/or requested model is not loaded");
   }
 
-  TRITONSERVER_ResponseAllocator* allocator = nullptr;
+  std::unique_ptr<AsyncRequest> request(new AsyncRequest());
+  request->callback_ = std::move(callback);
+  request->enable_stats_ = enable_stats;
+  request->timer_.Reset();
+  request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_START);
+
+  // Everything belongs to the server once it accepts the request
   TRITONSERVER_InferenceRequest* irequest = nullptr;
-  TRITONSERVER_InferenceResponse* completed_response = nullptr;
-  tc::RequestTimers timer;
-  timer.Reset();
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_START);
-
-  RETURN_IF_ERROR(InitializeRequest(options, outputs, &allocator, &irequest));
-  ScopedDefer error_handler([&error, &completed_response, &allocator, this] {
-    error = CleanUp(completed_response, allocator);
+  RequestTrace* request_trace = nullptr;
+  ScopedDefer error_handler([&request, &irequest, &request_trace, this] {
+    if (irequest != nullptr) {
+      REPORT_TRITONSERVER_ERROR(request_delete_fn_(irequest));
+    }
+    if (request_trace != nullptr) {
+      REPORT_TRITONSERVER_ERROR(trace_delete_fn_(request_trace->trace_));
+      delete request_trace;
+    }
   });
+  RETURN_IF_ERROR(InitializeRequest(options, outputs, &irequest));
   RETURN_IF_ERROR(AddInputs(inputs, irequest));
   RETURN_IF_ERROR(AddOutputs(outputs, irequest));
 
-  AllocPayload alloc_payload;
   for (auto& output : outputs) {
     if (output->IsSharedMemory()) {
       std::string shm_name;
@@ -945,7 +1152,7 @@ TritonLoader::Infer(
       RETURN_IF_ERROR(shm_manager_->GetMemoryInfo(
           shm_name, offset, &buf, &memory_type, &memory_type_id));
 
-      alloc_payload.output_map_.emplace(
+      request->alloc_payload_.output_map_.emplace(
           std::piecewise_construct, std::forward_as_tuple(output->Name()),
           std::forward_as_tuple(new AllocPayload::OutputInfo(
               buf, shm_byte_size, memory_type, memory_type_id)));
@@ -955,58 +1162,156 @@ TritonLoader::Infer(
   const char* cid = nullptr;
   RETURN_IF_TRITONSERVER_ERROR(
       request_id_fn_(irequest, &cid), "Failed to get request id");
-  std::string id = cid;
+  request->id_ = cid;
+
+  if (server_request_trace_) {
+    std::unique_ptr<RequestTrace> new_trace(new RequestTrace());
+    RETURN_IF_TRITONSERVER_ERROR(
+        trace_new_fn_(
+            &new_trace->trace_, TRITONSERVER_TRACE_LEVEL_TIMESTAMPS,
+            0 /* parent_id */, TraceActivity, TraceRelease, new_trace.get()),
+        "creating request trace");
+    request_trace = new_trace.release();
+  }
 
   // Perform inference...
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::SEND_START);
-  auto p = new std::promise<TRITONSERVER_InferenceResponse*>();
-  std::future<TRITONSERVER_InferenceResponse*> completed = p->get_future();
+  request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::SEND_START);
   RETURN_IF_TRITONSERVER_ERROR(
       inference_request_set_response_callback_fn_(
-          irequest, allocator, &alloc_payload /* response_allocator_userp */,
-          InferResponseComplete, reinterpret_cast<void*>(p)),
+          irequest, response_allocator_,
+          &request->alloc_payload_ /* response_allocator_userp */,
+          AsyncResponseComplete, reinterpret_cast<void*>(request.get())),
       "setting response callback");
+  // The response can complete before the call below returns, so the send is
+  // over once the request is handed to the server
+  request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
   RETURN_IF_TRITONSERVER_ERROR(
-      infer_async_fn_((server_).get(), irequest, nullptr /* trace */),
+      infer_async_fn_(
+          (server_).get(), irequest,
+          (request_trace != nullptr) ? request_trace->trace_ : nullptr),
       "running inference");
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::SEND_END);
 
-  // Wait for the inference to complete.
-  completed_response = completed.get();
+  irequest = nullptr;
+  request_trace = nullptr;
+  request.release();
+  error_handler.Complete();
 
-  RETURN_IF_TRITONSERVER_ERROR(
-      inference_response_error_fn_(completed_response),
-      "inference response error");
+  return Error::Success;
+}
 
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::RECV_START);
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::RECV_END);
-  timer.CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_END);
+void
+TritonLoader::AsyncResponseComplete(
+    TRITONSERVER_InferenceResponse* response, const uint32_t flags, void* userp)
+{
+  TritonLoader* loader = GetSingleton();
+  AsyncRequest* request = reinterpret_cast<AsyncRequest*>(userp);
+
+  if (response != nullptr) {
+    tc::Error status = tc::Error::Success;
+    TRITONSERVER_Error* response_err =
+        loader->inference_response_error_fn_(response);
+    if (response_err != nullptr) {
+      status = tc::Error(
+          "inference response error: " +
+          std::string(loader->error_message_fn_(response_err)));
+      loader->error_delete_fn_(response_err);
+    } else if (request->first_response_ && request->enable_stats_) {
+      request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::RECV_START);
+      request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::RECV_END);
+      request->timer_.CaptureTimestamp(tc::RequestTimers::Kind::REQUEST_END);
+
+      std::lock_guard<std::mutex> lock(loader->infer_stat_mutex_);
+      tc::Error err = loader->UpdateInferStat(request->timer_);
+      if (!err.IsOk()) {
+        std::cerr << "Failed to update context stat: " << err << std::endl;
+      }
+    }
+    request->first_response_ = false;
+
+    // Releases the output buffers of the response
+    REPORT_TRITONSERVER_ERROR(loader->inference_response_delete_fn_(response));
 
-  tc::Error err = UpdateInferStat(timer);
-  if (!err.IsOk()) {
-    std::cerr << "Failed to update context stat: " << err << std::endl;
+    InferResult* result;
+    InferResult::Create(&result, status, request->id_);
+    request->callback_(result);
   }
 
-  InferResult::Create(result, err, id);
+  if ((flags & TRITONSERVER_RESPONSE_COMPLETE_FINAL) != 0) {
+    delete request;
+  }
+}
 
-  // CleanUp the response allocators
-  error_handler.Complete();
+void
+TritonLoader::TraceActivity(
+    TRITONSERVER_InferenceTrace* trace,
+    TRITONSERVER_InferenceTraceActivity activity, uint64_t timestamp_ns,
+    void* userp)
+{
+  RequestTrace* request_trace = reinterpret_cast<RequestTrace*>(userp);
+  if (trace != request_trace->trace_) {
+    return;
+  }
+  switch (activity) {
+    case TRITONSERVER_TRACE_QUEUE_START:
+      request_trace->queue_start_ns_ = timestamp_ns;
+      break;
+    case TRITONSERVER_TRACE_COMPUTE_START:
+      request_trace->compute_start_ns_ = timestamp_ns;
+      break;
+    case TRITONSERVER_TRACE_COMPUTE_INPUT_END:
+      request_trace->compute_input_end_ns_ = timestamp_ns;
+      break;
+    case TRITONSERVER_TRACE_COMPUTE_OUTPUT_START:
+      request_trace->compute_output_start_ns_ = timestamp_ns;
+      break;
+    case TRITONSERVER_TRACE_COMPUTE_END:
+      request_trace->compute_end_ns_ = timestamp_ns;
+      break;
+    default:
+      break;
+  }
+}
 
-  return error;
+void
+TritonLoader::TraceRelease(TRITONSERVER_InferenceTrace* trace, void* userp)
+{
+  TritonLoader* loader = GetSingleton();
+  RequestTrace* request_trace = reinterpret_cast<RequestTrace*>(userp);
+  REPORT_TRITONSERVER_ERROR(loader->trace_delete_fn_(trace));
+  if (trace != request_trace->trace_) {
+    return;
+  }
+
+  // Requests that failed or were not computed, like the top-level request of
+  // an ensemble, miss some of the timestamps
+  const RequestTrace& t = *request_trace;
+  if ((t.queue_start_ns_ != 0) && (t.compute_start_ns_ >= t.queue_start_ns_) &&
+      (t.compute_input_end_ns_ >= t.compute_start_ns_) &&
+      (t.compute_output_start_ns_ >= t.compute_input_end_ns_) &&
+      (t.compute_end_ns_ >= t.compute_output_start_ns_)) {
+    ServerRequestTiming timing;
+    timing.queue_ns = t.compute_start_ns_ - t.queue_start_ns_;
+    timing.compute_input_ns = t.compute_input_end_ns_ - t.compute_start_ns_;
+    timing.compute_infer_ns =
+        t.compute_output_start_ns_ - t.compute_input_end_ns_;
+    timing.compute_output_ns = t.compute_end_ns_ - t.compute_output_start_ns_;
+
+    std::lock_guard<std::mutex> lock(loader->server_request_timings_mutex_);
+    loader->server_request_timings_.push_back(timing);
+  }
+  delete request_trace;
 }
 
 Error
-TritonLoader::CleanUp(
-    TRITONSERVER_InferenceResponse* completed_response,
-    TRITONSERVER_ResponseAllocator* allocator)
+TritonLoader::TakeServerRequestTimings(
+    std::vector<ServerRequestTiming>* timings)
 {
-  TRITONSERVER_Error* response_err = nullptr;
-  if (completed_response != nullptr) {
-    response_err = inference_response_delete_fn_(completed_response);
+  if (!server_request_trace_) {
+    return Error("the requests are not traced, see --server-request-trace");
   }
-  TRITONSERVER_Error* allocator_err = response_allocator_delete_fn_(allocator);
-  RETURN_IF_TRITONSERVER_ERROR(response_err, "deleting inference response");
-  RETURN_IF_TRITONSERVER_ERROR(allocator_err, "deleting response allocator");
+  timings->clear();
+  std::lock_guard<std::mutex> lock(server_request_timings_mutex_);
+  timings->swap(server_request_timings_);
   return Error::Success;
 }
 
@@ -1014,36 +1319,33 @@ Error
 TritonLoader::InitializeRequest(
     const tc::InferOptions& options,
     const std::vector<const tc::InferRequestedOutput*>& outputs,
-    TRITONSERVER_ResponseAllocator** allocator,
     TRITONSERVER_InferenceRequest** irequest)
 {
-  // Create the allocator that will be used to allocate buffers for
-  // the result tensors.
-  RETURN_IF_TRITONSERVER_ERROR(
-      GetSingleton()
-          ->response_allocator_new_fn_(
-              allocator,
-              reinterpret_cast<
-                  TRITONSERVER_Error* (*)(TRITONSERVER_ResponseAllocator * allocator, const char* tensor_name, size_t byte_size, TRITONSERVER_MemoryType memory_type, int64_t memory_type_id, void* userp, void** buffer, void** buffer_userp, TRITONSERVER_MemoryType* actual_memory_type, int64_t* actual_memory_type_id)>(
-                  ResponseAlloc),
-              reinterpret_cast<
-                  TRITONSERVER_Error* (*)(TRITONSERVER_ResponseAllocator * allocator, void* buffer, void* buffer_userp, size_t byte_size, TRITONSERVER_MemoryType memory_type, int64_t memory_type_id)>(
-                  ResponseRelease),
-              nullptr /* start_fn */),
-      "creating response allocator");
-
-  // set up inference request
-  RETURN_IF_TRITONSERVER_ERROR(
-      inference_request_new_fn_(
-          irequest, (server_).get(), model_name_.c_str(), model_version_),
-      "creating inference request");
+  int64_t requested_model_version;
+  RETURN_IF_ERROR(GetModelVersionFromString(
+      options.model_version_, &requested_model_version));
+
+  // set up inference request, a released one keeps the options it was sent
+  // with so they are all set again
+  RequestPool* request_pool = nullptr;
+  RETURN_IF_ERROR(ReuseInferRequest(
+      options.model_name_, requested_model_version, &request_pool, irequest));
+  const bool reused = (*irequest != nullptr);
+  if (!reused) {
+    RETURN_IF_TRITONSERVER_ERROR(
+        inference_request_new_fn_(
+            irequest, (server_).get(), options.model_name_.c_str(),
+            requested_model_version),
+        "creating inference request");
+  }
   RETURN_IF_TRITONSERVER_ERROR(
       inference_request_set_id_fn_(*irequest, options.request_id_.c_str()),
       "setting ID for the request");
-  if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "") ||
-      (options.priority_ != 0) || (options.server_timeout_ != 0) ||
-      outputs.empty()) {
-    if (options.sequence_id_ != 0) {
+  if (reused || (options.sequence_id_ != 0) ||
+      (options.sequence_id_str_ != "") || (options.priority_ != 0) ||
+      (options.server_timeout_ != 0) || outputs.empty()) {
+    if ((options.sequence_id_ != 0) ||
+        (reused && (options.sequence_id_str_ == ""))) {
       RETURN_IF_TRITONSERVER_ERROR(
           set_correlation_id_fn_(*irequest, options.sequence_id_),
           "setting sequence ID for the request");
@@ -1064,32 +1366,144 @@ TritonLoader::InitializeRequest(
         set_flags_fn_(*irequest, flags),
         "setting inference flags for the request");
   }
-  if (options.priority_ != 0) {
+  if (reused || (options.priority_ != 0)) {
     RETURN_IF_TRITONSERVER_ERROR(
         set_priority_fn_(*irequest, options.priority_),
         "setting priority for the request");
   }
-  if (options.server_timeout_ != 0) {
+  if (reused || (options.server_timeout_ != 0)) {
     RETURN_IF_TRITONSERVER_ERROR(
         set_timeout_ms_fn_(*irequest, options.server_timeout_),
         "setting timeout for the request");
   }
-  RETURN_IF_TRITONSERVER_ERROR(
-      inference_request_set_release_callback_fn_(
-          *irequest, InferRequestComplete, nullptr /* request_release_userp */),
-      "setting request release callback");
+  if (!reused) {
+    RETURN_IF_TRITONSERVER_ERROR(
+        inference_request_set_release_callback_fn_(
+            *irequest, InferRequestComplete,
+            request_pool /* request_release_userp */),
+        "setting request release callback");
+  }
   return Error::Success;
 }
 
+Error
+TritonLoader::ReuseInferRequest(
+    const std::string& model_name, const int64_t model_version,
+    RequestPool** request_pool, TRITONSERVER_InferenceRequest** irequest)
+{
+  *irequest = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(request_pool_mutex_);
+    RequestPool& pool =
+        free_requests_[std::make_pair(model_name, model_version)];
+    *request_pool = &pool;
+    if (pool.empty()) {
+      return Error::Success;
+    }
+    *irequest = pool.back();
+    pool.pop_back();
+  }
+
+  TRITONSERVER_Error* err = request_remove_all_inputs_fn_(*irequest);
+  if (err == nullptr) {
+    err = request_remove_all_requested_outputs_fn_(*irequest);
+  }
+  if (err != nullptr) {
+    REPORT_TRITONSERVER_ERROR(err);
+    REPORT_TRITONSERVER_ERROR(request_delete_fn_(*irequest));
+    *irequest = nullptr;
+  }
+  return Error::Success;
+}
+
+void
+TritonLoader::RecycleInferRequest(
+    TRITONSERVER_InferenceRequest* irequest, RequestPool* request_pool)
+{
+  {
+    std::lock_guard<std::mutex> lock(request_pool_mutex_);
+    if (request_pool_open_ && (request_pool != nullptr)) {
+      request_pool->push_back(irequest);
+      return;
+    }
+  }
+  REPORT_TRITONSERVER_ERROR(request_delete_fn_(irequest));
+}
+
+OutputBufferPool*
+TritonLoader::OutputBuffers(
+    const TRITONSERVER_MemoryType preferred_memory_type,
+    const int64_t preferred_memory_type_id)
+{
+  TRITONSERVER_MemoryType memory_type = TRITONSERVER_MEMORY_CPU;
+  int64_t memory_type_id = 0;
+  switch (output_memory_policy_.kind) {
+    case OUTPUT_MEMORY_CPU_PINNED:
+      memory_type = TRITONSERVER_MEMORY_CPU_PINNED;
+      break;
+    case OUTPUT_MEMORY_GPU:
+      memory_type = TRITONSERVER_MEMORY_GPU;
+      memory_type_id = output_memory_policy_.device_id;
+      break;
+    case OUTPUT_MEMORY_PREFERRED:
+      memory_type = preferred_memory_type;
+      memory_type_id = preferred_memory_type_id;
+      break;
+    default:
+      break;
+  }
+#ifndef TRITON_ENABLE_GPU
+  // Only host memory can be allocated without CUDA
+  memory_type = TRITONSERVER_MEMORY_CPU;
+  memory_type_id = 0;
+#endif  // TRITON_ENABLE_GPU
+  if (memory_type != TRITONSERVER_MEMORY_GPU) {
+    memory_type_id = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(output_buffer_pools_mutex_);
+  auto& pool =
+      output_buffer_pools_[std::make_pair(memory_type, memory_type_id)];
+  if (pool == nullptr) {
+    pool.reset(new OutputBufferPool(memory_type, memory_type_id));
+  }
+  return pool.get();
+}
+
+void
+TritonLoader::ClearRequestPool(const bool reopen)
+{
+  RequestPool requests;
+  {
+    std::lock_guard<std::mutex> lock(request_pool_mutex_);
+    for (auto& pool : free_requests_) {
+      requests.insert(requests.end(), pool.second.begin(), pool.second.end());
+      pool.second.clear();
+    }
+    request_pool_open_ = reopen;
+  }
+  for (auto irequest : requests) {
+    REPORT_TRITONSERVER_ERROR(request_delete_fn_(irequest));
+  }
+}
+
 Error
 TritonLoader::AddInputs(
     const std::vector<tc::InferInput*>& inputs,
     TRITONSERVER_InferenceRequest* irequest)
 {
+  // The datatype of an input was resolved when it was created, and the
+  // values of tc::DataType are those of TRITONSERVER_DataType
+  static_assert(
+      static_cast<int>(tc::DataType::BYTES) == TRITONSERVER_TYPE_BYTES,
+      "tc::DataType must match TRITONSERVER_DataType");
+  static_assert(
+      static_cast<int>(tc::DataType::BF16) == TRITONSERVER_TYPE_BF16,
+      "tc::DataType must match TRITONSERVER_DataType");
   for (auto io : inputs) {
     const char* input_name = io->Name().c_str();
-    const char* datatype = io->Datatype().c_str();
-    const TRITONSERVER_DataType dtype = string_to_datatype_fn_(datatype);
+    const TRITONSERVER_DataType dtype =
+        static_cast<TRITONSERVER_DataType>(io->Type());
     std::vector<int64_t> shape_vec;
     for (const int64_t dim : io->Shape()) {  // this is a vector, just use it
       shape_vec.push_back(dim);
@@ -29,12 +29,18 @@
 #include <rapidjson/error/en.h>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "../client_backend.h"
 #include "common.h"
+#include "output_buffer_pool.h"
 #include "shared_library.h"
 #include "shared_memory_manager.h"
 #include "triton/core/tritonserver.h"
@@ -88,15 +94,24 @@ class TritonLoader : public tc::InferenceServerClient {
 
   static Error Create(
       const std::string& triton_server_path,
-      const std::string& model_repository_path, bool verbose);
+      const std::string& model_repository_path,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
+      bool verbose);
 
   Error Delete();
   Error StartTriton();
 
+  /// Waits for a model to be ready. Several models can be loaded, each
+  /// request goes to the model named in its options. The server stays
+  /// resident across backends, a model that is already loaded is only
+  /// reloaded if its files in the model repository changed.
   Error LoadModel(
       const std::string& model_name, const std::string& model_version);
 
-  Error ModelMetadata(rapidjson::Document* model_metadata);
+  Error ModelMetadata(
+      rapidjson::Document* model_metadata, const std::string& model_name,
+      const std::string& model_version);
 
   Error ModelConfig(
       rapidjson::Document* model_config, const std::string& model_name,
@@ -104,15 +119,23 @@ class TritonLoader : public tc::InferenceServerClient {
 
   Error ServerMetaData(rapidjson::Document* server_metadata);
 
+  /// Invoked with the result of each response. Decoupled models can send
+  /// several responses per request.
+  using OnCompleteFn = std::function<void(InferResult*)>;
+
   Error Infer(
       const tc::InferOptions& options,
       const std::vector<tc::InferInput*>& inputs,
       const std::vector<const tc::InferRequestedOutput*>& outputs,
       InferResult** result);
 
-  Error CleanUp(
-      TRITONSERVER_InferenceResponse* completed_response,
-      TRITONSERVER_ResponseAllocator* allocator);
+  /// Sends a request without waiting for its responses. The callback runs on
+  /// the threads of the server.
+  Error AsyncInfer(
+      OnCompleteFn callback, const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs,
+      const std::vector<const tc::InferRequestedOutput*>& outputs,
+      const bool enable_stats);
 
   Error ModelInferenceStatistics(
       const std::string& model_name, const std::string& model_version,
@@ -120,10 +143,15 @@ class TritonLoader : public tc::InferenceServerClient {
 
   Error ClientInferStat(tc::InferStat* infer_stat)
   {
+    std::lock_guard<std::mutex> lock(infer_stat_mutex_);
     *infer_stat = infer_stat_;
     return Error::Success;
   }
 
+  /// Takes the server timings of the requests whose traces were released
+  /// since the last call. Fails unless the requests are traced.
+  Error TakeServerRequestTimings(std::vector<ServerRequestTiming>* timings);
+
 #ifdef TRITON_ENABLE_GPU
   Error RegisterCudaMemory(
       const std::string& name, void* handle, const size_t byte_size);
@@ -138,6 +166,8 @@ class TritonLoader : public tc::InferenceServerClient {
       TRITONSERVER_Error_Code code, const char* message);
 
   bool ModelIsLoaded() { return model_is_loaded_; }
+  bool ModelIsLoaded(
+      const std::string& model_name, const std::string& model_version);
   bool ServerIsReady() { return server_is_ready_; }
 
   TRITONSERVER_Error* DeleteInferRequest(
@@ -145,6 +175,19 @@ class TritonLoader : public tc::InferenceServerClient {
   {
     return request_delete_fn_(irequest);
   }
+
+  using RequestPool = std::vector<TRITONSERVER_InferenceRequest*>;
+
+  /// Keeps a request that the server released for the next inference of its
+  /// model, the request is deleted if the pools are closed.
+  void RecycleInferRequest(
+      TRITONSERVER_InferenceRequest* irequest, RequestPool* request_pool);
+
+  /// \return The pool to allocate an output from according to the output
+  /// memory policy, given the memory that the server prefers.
+  OutputBufferPool* OutputBuffers(
+      const TRITONSERVER_MemoryType preferred_memory_type,
+      const int64_t preferred_memory_type_id);
   static TritonLoader* GetSingleton();
 
   // TRITONSERVER_ApiVersion
@@ -367,6 +410,15 @@ class TritonLoader : public tc::InferenceServerClient {
   typedef TRITONSERVER_Error* (*TritonServerRequestIdFn_t)(
       TRITONSERVER_InferenceRequest* inference_request, const char** id);
 
+  // TRITONSERVER_InferenceRequestRemoveAllInputs
+  typedef TRITONSERVER_Error* (*TritonServerRequestRemoveAllInputsFn_t)(
+      TRITONSERVER_InferenceRequest* inference_request);
+
+  // TRITONSERVER_InferenceRequestRemoveAllRequestedOutputs
+  typedef TRITONSERVER_Error* (
+      *TritonServerRequestRemoveAllRequestedOutputsFn_t)(
+      TRITONSERVER_InferenceRequest* inference_request);
+
   // TRITONSERVER_InferenceRequestDelete
   typedef TRITONSERVER_Error* (*TritonServerRequestDeleteFn_t)(
       TRITONSERVER_InferenceRequest* inference_request);
@@ -380,6 +432,14 @@ class TritonLoader : public tc::InferenceServerClient {
   typedef TRITONSERVER_Error* (*TritonSeverUnloadModelFn_t)(
       TRITONSERVER_Server* server, const char* model_name);
 
+  // TRITONSERVER_ServerLoadModel
+  typedef TRITONSERVER_Error* (*TritonServerLoadModelFn_t)(
+      TRITONSERVER_Server* server, const char* model_name);
+
+  // TRITONSERVER_ServerOptionsSetModelControlMode
+  typedef TRITONSERVER_Error* (*TritonServerSetModelControlModeFn_t)(
+      TRITONSERVER_ServerOptions* options, TRITONSERVER_ModelControlMode mode);
+
   // TRITONSERVER_ServerOptionsSetLogInfo
   typedef TRITONSERVER_Error* (*TritonSeverSetLogInfoFn_t)(
       TRITONSERVER_ServerOptions* options, bool log);
@@ -388,6 +448,17 @@ class TritonLoader : public tc::InferenceServerClient {
   typedef TRITONSERVER_Error* (*TritonServerSetCudaMemoryPoolByteSizeFn_t)(
       TRITONSERVER_ServerOptions* options, int gpu_device, uint64_t size);
 
+  // TRITONSERVER_InferenceTraceNew
+  typedef TRITONSERVER_Error* (*TritonServerInferenceTraceNewFn_t)(
+      TRITONSERVER_InferenceTrace** trace,
+      TRITONSERVER_InferenceTraceLevel level, uint64_t parent_id,
+      TRITONSERVER_InferenceTraceActivityFn_t activity_fn,
+      TRITONSERVER_InferenceTraceReleaseFn_t release_fn, void* trace_userp);
+
+  // TRITONSERVER_InferenceTraceDelete
+  typedef TRITONSERVER_Error* (*TritonServerInferenceTraceDeleteFn_t)(
+      TRITONSERVER_InferenceTrace* trace);
+
  private:
   TritonLoader()
       : InferenceServerClient(
@@ -403,7 +474,10 @@ class TritonLoader : public tc::InferenceServerClient {
 
   Error PopulateInternals(
       const std::string& triton_server_path,
-      const std::string& model_repository_path, bool verbose);
+      const std::string& model_repository_path,
+      const OutputMemoryPolicy& output_memory_policy,
+      const bool lazy_model_load, const bool server_request_trace,
+      bool verbose);
 
   /// Load all tritonserver.h functions onto triton_loader
   /// internal handles
@@ -411,6 +485,24 @@ class TritonLoader : public tc::InferenceServerClient {
 
   void ClearHandles();
 
+  /// What the model repository holds for a model when it was loaded. A
+  /// change of the configuration or of the versions means that the server
+  /// must load the model again.
+  struct ModelSnapshot {
+    int64_t config_mtime{-1};
+    int64_t config_size{-1};
+    int64_t directory_mtime{-1};
+
+    bool operator==(const ModelSnapshot& other) const
+    {
+      return (config_mtime == other.config_mtime) &&
+             (config_size == other.config_size) &&
+             (directory_mtime == other.directory_mtime);
+    }
+  };
+
+  ModelSnapshot SnapshotModel(const std::string& model_name);
+
   /// Check if file exists in the current directory
   /// \param filepath Path of library to check
   /// \return perfanalyzer::clientbackend::Error
@@ -419,9 +511,23 @@ class TritonLoader : public tc::InferenceServerClient {
   Error InitializeRequest(
       const tc::InferOptions& options,
       const std::vector<const tc::InferRequestedOutput*>& outputs,
-      TRITONSERVER_ResponseAllocator** allocator,
       TRITONSERVER_InferenceRequest** irequest);
 
+  /// Creates the allocator shared by all the requests, the state of each
+  /// request is passed to it through the allocator user pointer
+  Error CreateResponseAllocator();
+
+  /// Takes a released request of the model and clears its inputs and
+  /// outputs, 'irequest' is nullptr if none is available. 'request_pool'
+  /// returns the pool of the model.
+  Error ReuseInferRequest(
+      const std::string& model_name, const int64_t model_version,
+      RequestPool** request_pool, TRITONSERVER_InferenceRequest** irequest);
+
+  /// Deletes the released requests of all the models. Requests released
+  /// afterwards are deleted instead of kept unless 'reopen' is true.
+  void ClearRequestPool(const bool reopen);
+
   Error AddInputs(
       const std::vector<tc::InferInput*>& inputs,
       TRITONSERVER_InferenceRequest* irequest);
@@ -430,6 +536,31 @@ class TritonLoader : public tc::InferenceServerClient {
       const std::vector<const tc::InferRequestedOutput*>& outputs,
       TRITONSERVER_InferenceRequest* irequest);
 
+  struct AsyncRequest;
+
+  /// Builds a request and hands it to the server, 'callback' is invoked with
+  /// the result of each of its responses
+  Error SendRequest(
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs,
+      const std::vector<const tc::InferRequestedOutput*>& outputs,
+      OnCompleteFn callback, const bool enable_stats);
+
+  /// Response callback of all the requests, 'userp' is their AsyncRequest
+  static void AsyncResponseComplete(
+      TRITONSERVER_InferenceResponse* response, const uint32_t flags,
+      void* userp);
+
+  struct RequestTrace;
+
+  /// Trace callbacks of the requests, 'userp' is their RequestTrace. The
+  /// timings are kept when the server releases the trace.
+  static void TraceActivity(
+      TRITONSERVER_InferenceTrace* trace,
+      TRITONSERVER_InferenceTraceActivity activity, uint64_t timestamp_ns,
+      void* userp);
+  static void TraceRelease(TRITONSERVER_InferenceTrace* trace, void* userp);
+
   void* dlhandle_;
   TritonServerApiVersionFn_t api_version_fn_;
   TritonServerOptionsNewFn_t options_new_fn_;
@@ -497,10 +628,17 @@ class TritonLoader : public tc::InferenceServerClient {
   TritonServerRequestIdFn_t request_id_fn_;
   TritonServerRequestDeleteFn_t request_delete_fn_;
   TritonServerModelStatisticsFn_t model_statistics_fn_;
+  TritonServerRequestRemoveAllInputsFn_t request_remove_all_inputs_fn_;
+  TritonServerRequestRemoveAllRequestedOutputsFn_t
+      request_remove_all_requested_outputs_fn_;
 
   TritonSeverUnloadModelFn_t unload_model_fn_;
+  TritonServerLoadModelFn_t load_model_fn_;
+  TritonServerSetModelControlModeFn_t set_model_control_mode_fn_;
   TritonSeverSetLogInfoFn_t set_log_info_fn_;
   TritonServerSetCudaMemoryPoolByteSizeFn_t set_cuda_memory_pool_byte_size_;
+  TritonServerInferenceTraceNewFn_t trace_new_fn_;
+  TritonServerInferenceTraceDeleteFn_t trace_delete_fn_;
 
   std::shared_ptr<TRITONSERVER_Server> server_{nullptr};
   std::string triton_server_path_{};
@@ -509,11 +647,34 @@ class TritonLoader : public tc::InferenceServerClient {
   TRITONSERVER_MemoryType requested_memory_type_{TRITONSERVER_MEMORY_CPU};
   bool enforce_memory_type_{false};
   std::string model_repository_path_{""};
-  std::string model_name_{""};
-  int64_t model_version_{-1};
+  std::set<std::pair<std::string, int64_t>> loaded_models_;
+  // Models are loaded on first use rather than at the start of the server
+  bool lazy_model_load_{false};
+  // Every request is traced, the timings of the released traces wait in
+  // 'server_request_timings_' to be taken
+  bool server_request_trace_{false};
+  std::mutex server_request_timings_mutex_;
+  std::vector<ServerRequestTiming> server_request_timings_;
+  std::map<std::string, ModelSnapshot> model_snapshots_;
   bool model_is_loaded_{false};
   bool server_is_ready_{false};
   std::unique_ptr<SharedMemoryManager> shm_manager_{nullptr};
+  // Responses of asynchronous requests complete on the threads of the server
+  std::mutex infer_stat_mutex_;
+  // Shared by all the requests instead of created for each of them
+  TRITONSERVER_ResponseAllocator* response_allocator_{nullptr};
+  OutputMemoryPolicy output_memory_policy_;
+  // The output buffers of each memory type and device
+  std::mutex output_buffer_pools_mutex_;
+  std::map<
+      std::pair<TRITONSERVER_MemoryType, int64_t>,
+      std::unique_ptr<OutputBufferPool>>
+      output_buffer_pools_;
+  // Requests released by the server, ready to be sent again, by model. The
+  // pools are never erased, requests point to theirs while in flight.
+  std::mutex request_pool_mutex_;
+  std::map<std::pair<std::string, int64_t>, RequestPool> free_requests_;
+  bool request_pool_open_{true};
 };
 
 }}}}  // namespace triton::perfanalyzer::clientbackend::tritoncapi
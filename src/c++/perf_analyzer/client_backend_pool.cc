@@ -0,0 +1,73 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "client_backend_pool.h"
+
+namespace triton { namespace perfanalyzer {
+
+ClientBackendPool::ClientBackendPool(
+    const std::shared_ptr<cb::ClientBackendFactory>& factory,
+    const size_t size)
+    : factory_(factory)
+{
+  for (size_t i = 0; i < size; i++) {
+    entries_.emplace_back(new Entry());
+  }
+}
+
+cb::Error
+ClientBackendPool::Take(
+    std::shared_ptr<cb::ClientBackend>* backend, size_t* index)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  Entry& entry = *entries_[next_];
+  if (entry.backend_ == nullptr) {
+    std::unique_ptr<cb::ClientBackend> new_backend;
+    RETURN_IF_ERROR(factory_->CreateClientBackend(&new_backend));
+    // The connection is set up once for all the contexts sharing the
+    // backend, before their first request
+    RETURN_IF_ERROR(new_backend->Warmup(1));
+    entry.backend_ = std::move(new_backend);
+  }
+  *backend = entry.backend_;
+  *index = next_;
+  next_ = (next_ + 1) % entries_.size();
+  return cb::Error::Success;
+}
+
+cb::Error
+ClientBackendPool::ReadClientStat(
+    const size_t index, cb::InferStat* previous, cb::InferStat* current)
+{
+  Entry& entry = *entries_[index];
+  std::lock_guard<std::mutex> lock(entry.mu_);
+  *previous = entry.stat_;
+  cb::Error err = entry.backend_->ClientInferStat(&entry.stat_);
+  *current = entry.stat_;
+  return err;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,83 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "client_backend/client_backend.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A fixed number of client backends that the contexts of all the worker
+/// threads share in round robin, rather than creating a backend, and so a
+/// set of connections to the server, each. The backends are created and
+/// warmed up as the contexts first take them, and must be safe to use from
+/// several threads at once.
+class ClientBackendPool {
+ public:
+  /// \param factory The factory the backends are created by.
+  /// \param size The number of backends of the pool.
+  ClientBackendPool(
+      const std::shared_ptr<cb::ClientBackendFactory>& factory,
+      const size_t size);
+
+  /// Takes the backend of a new context, the next one in round robin.
+  /// \param backend Returns the backend, shared with the other contexts
+  /// that took it.
+  /// \param index Returns the index of the backend in the pool.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Take(std::shared_ptr<cb::ClientBackend>* backend, size_t* index);
+
+  /// Reads the client side statistics of a backend since they were last
+  /// read by any of the contexts sharing it, so that the requests of every
+  /// context are counted once.
+  /// \param index The index of the backend in the pool.
+  /// \param previous Returns the statistics when last read.
+  /// \param current Returns the current statistics.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ReadClientStat(
+      const size_t index, cb::InferStat* previous, cb::InferStat* current);
+
+  size_t Size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::shared_ptr<cb::ClientBackend> backend_;
+    // The statistics of the backend when last read. Protected by mu_.
+    cb::InferStat stat_;
+    std::mutex mu_;
+  };
+
+  std::shared_ptr<cb::ClientBackendFactory> factory_;
+  std::vector<std::unique_ptr<Entry>> entries_;
+  // Protects next_ and the creation of the backends
+  std::mutex mu_;
+  size_t next_{0};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,137 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace triton { namespace perfanalyzer {
+
+/// The stages of the client side handling of a request.
+enum ClientStage {
+  // Updating the inputs of the request and preparing its shared memory
+  CLIENT_STAGE_DATA_PREP,
+  // The call into the client backend that sends the request, which covers
+  // the serialization and the transport. For synchronous requests it also
+  // covers the wait for the response.
+  CLIENT_STAGE_SEND,
+  // The response callback of an asynchronous request
+  CLIENT_STAGE_CALLBACK,
+  // The validation of the outputs against the expected ones
+  CLIENT_STAGE_VALIDATION,
+  CLIENT_STAGE_COUNT
+};
+
+/// The time spent in each client stage over a number of requests.
+struct ClientStageTimes {
+  // The number of requests sent
+  uint64_t request_count{0};
+  std::array<uint64_t, CLIENT_STAGE_COUNT> total_ns{};
+
+  void Merge(const ClientStageTimes& other)
+  {
+    request_count += other.request_count;
+    for (size_t i = 0; i < CLIENT_STAGE_COUNT; i++) {
+      total_ns[i] += other.total_ns[i];
+    }
+  }
+
+  /// \return The average time of the stage per request sent.
+  uint64_t AvgNs(ClientStage stage) const
+  {
+    return (request_count == 0) ? 0 : total_ns[stage] / request_count;
+  }
+};
+
+/// Accumulates the time a worker thread and its callbacks spend in each
+/// client stage. Recording only adds to relaxed atomic counters, so the
+/// worker thread, the callback threads and the profiler do not contend on a
+/// lock. Does nothing unless enabled.
+class ClientStageTimer {
+ public:
+  /// Times one stage for as long as it is in scope.
+  class Scope {
+   public:
+    Scope(ClientStageTimer& timer, ClientStage stage)
+        : timer_(timer.enabled_ ? &timer : nullptr), stage_(stage)
+    {
+      if (timer_ != nullptr) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if (timer_ != nullptr) {
+        timer_->Record(
+            stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_)
+                        .count());
+      }
+    }
+
+   private:
+    ClientStageTimer* timer_;
+    ClientStage stage_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  /// Must be called before the thread starts.
+  void Enable() { enabled_ = true; }
+
+  bool IsEnabled() const { return enabled_; }
+
+  void RecordRequest()
+  {
+    if (enabled_) {
+      request_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void Record(ClientStage stage, uint64_t ns)
+  {
+    total_ns_[stage].fetch_add(ns, std::memory_order_relaxed);
+  }
+
+  /// Adds the times recorded since the last call to 'times' and resets them.
+  void CollectAndReset(ClientStageTimes* times)
+  {
+    times->request_count +=
+        request_count_.exchange(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < CLIENT_STAGE_COUNT; i++) {
+      times->total_ns[i] += total_ns_[i].exchange(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  bool enabled_{false};
+  std::atomic<uint64_t> request_count_{0};
+  std::array<std::atomic<uint64_t>, CLIENT_STAGE_COUNT> total_ns_{};
+};
+
+}}  // namespace triton::perfanalyzer
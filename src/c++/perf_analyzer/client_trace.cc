@@ -0,0 +1,139 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "client_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Chrome trace timestamps are in microseconds
+void
+WriteMicros(std::ostream& out, uint64_t ns)
+{
+  out << (ns / 1000) << '.' << std::setw(3) << std::setfill('0')
+      << (ns % 1000) << std::setfill(' ');
+}
+
+}  // namespace
+
+ClientTracer::ClientTracer(uint64_t sample_every, size_t capacity)
+    : sample_every_(std::max<uint64_t>(sample_every, 1)),
+      spans_(std::max<size_t>(capacity, 1))
+{
+}
+
+void
+ClientTracer::Record(const ClientTraceSpan& span)
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  spans_[recorded_ % spans_.size()] = span;
+  recorded_++;
+}
+
+std::vector<ClientTraceSpan>
+ClientTracer::Spans() const
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  std::vector<ClientTraceSpan> spans;
+  const uint64_t count = std::min<uint64_t>(recorded_, spans_.size());
+  spans.reserve(count);
+  for (uint64_t i = recorded_ - count; i < recorded_; i++) {
+    spans.push_back(spans_[i % spans_.size()]);
+  }
+  return spans;
+}
+
+uint64_t
+ClientTracer::RecordedCount() const
+{
+  std::lock_guard<std::mutex> lock(mu_);
+  return recorded_;
+}
+
+const char*
+ClientTracer::SpanName(ClientTraceSpanKind kind)
+{
+  switch (kind) {
+    case CLIENT_SPAN_DATA_PREP:
+      return "data prep";
+    case CLIENT_SPAN_SEND:
+      return "send";
+    case CLIENT_SPAN_WAIT:
+      return "wait";
+    case CLIENT_SPAN_CALLBACK:
+      return "callback";
+    case CLIENT_SPAN_VALIDATION:
+      return "validation";
+    default:
+      return "unknown";
+  }
+}
+
+void
+ClientTracer::WriteChromeTrace(std::ostream& out) const
+{
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& span : Spans()) {
+    if (!first) {
+      out << ',';
+    }
+    first = false;
+    out << "\n{\"name\":\"" << SpanName(span.kind)
+        << "\",\"cat\":\"client\",\"ph\":\"X\",\"ts\":";
+    WriteMicros(out, span.start_ns);
+    out << ",\"dur\":";
+    WriteMicros(
+        out, (span.end_ns > span.start_ns) ? span.end_ns - span.start_ns : 0);
+    out << ",\"pid\":" << span.context_id << ",\"tid\":" << span.trace_id
+        << ",\"args\":{\"request_id\":\"" << RequestId(span.trace_id)
+        << "\"}}";
+  }
+  out << "\n]}\n";
+}
+
+cb::Error
+ClientTracer::WriteChromeTrace(const std::string& path) const
+{
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    return cb::Error(
+        "failed to open client trace file " + path, pa::GENERIC_ERROR);
+  }
+  WriteChromeTrace(file);
+  if (!file.good()) {
+    return cb::Error(
+        "failed to write to client trace file " + path, pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
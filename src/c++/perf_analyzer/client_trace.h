@@ -0,0 +1,177 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "client_backend/client_backend.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The spans the client records for a traced request.
+enum ClientTraceSpanKind {
+  // Preparing the inputs and the shared memory of the request
+  CLIENT_SPAN_DATA_PREP,
+  // The call into the client backend that serializes and sends the request.
+  // For synchronous requests it also covers the wait for the response, the
+  // client backends do not expose them separately.
+  CLIENT_SPAN_SEND,
+  // From the return of the send call until the first response callback of
+  // an asynchronous request
+  CLIENT_SPAN_WAIT,
+  // The response callbacks of an asynchronous request
+  CLIENT_SPAN_CALLBACK,
+  // The validation of the outputs against the expected ones
+  CLIENT_SPAN_VALIDATION,
+  CLIENT_SPAN_COUNT
+};
+
+/// One span of a traced request.
+struct ClientTraceSpan {
+  uint64_t trace_id{0};
+  ClientTraceSpanKind kind{CLIENT_SPAN_DATA_PREP};
+  // The id of the context that sent the request
+  uint32_t context_id{0};
+  // In nanoseconds since the epoch
+  uint64_t start_ns{0};
+  uint64_t end_ns{0};
+};
+
+//==============================================================================
+/// ClientTracer samples one in every N requests and records the client side
+/// spans of the sampled requests in a ring buffer that keeps the most recent
+/// ones. A sampled request is sent with the request id returned by
+/// RequestId(), which the server traces record, so that the client and the
+/// server spans of a request can be joined.
+///
+/// The requests that are not sampled only pay for the check in ShouldSample,
+/// and the sampled ones are rare enough for the spans to be recorded under a
+/// lock.
+///
+class ClientTracer {
+ public:
+  /// \param sample_every Trace one in every 'sample_every' requests.
+  /// \param capacity The number of spans kept.
+  ClientTracer(uint64_t sample_every, size_t capacity);
+
+  /// \param context_id The id of the context sending the request.
+  /// \param request_number The number of requests sent by the context so
+  /// far.
+  /// \return Whether the request is traced.
+  bool ShouldSample(uint32_t context_id, uint64_t request_number) const
+  {
+    return ((request_number + context_id) % sample_every_) == 0;
+  }
+
+  /// \return A new trace id, never 0.
+  uint64_t NewTraceId()
+  {
+    return next_trace_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// \return The request id that a request is sent with to be joined with
+  /// its trace.
+  static std::string RequestId(uint64_t trace_id)
+  {
+    return "pa-trace-" + std::to_string(trace_id);
+  }
+
+  void Record(const ClientTraceSpan& span);
+
+  /// \return The spans kept, from the oldest to the most recent.
+  std::vector<ClientTraceSpan> Spans() const;
+
+  /// \return The number of spans recorded, including the overwritten ones.
+  uint64_t RecordedCount() const;
+
+  /// Writes the spans kept in the Chrome trace event format, which can be
+  /// opened by chrome://tracing and Perfetto. Each context is a process and
+  /// each request a thread, with the request id in the arguments.
+  void WriteChromeTrace(std::ostream& out) const;
+
+  /// \param path The path of the file to write the Chrome trace to.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error WriteChromeTrace(const std::string& path) const;
+
+  static const char* SpanName(ClientTraceSpanKind kind);
+
+  /// \return The time since the epoch in nanoseconds, the clock of the
+  /// spans.
+  static uint64_t NowNs()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /// Records one span of a traced request for as long as it is in scope.
+  /// Does nothing if the tracer is null or the trace id is 0.
+  class Scope {
+   public:
+    Scope(
+        ClientTracer* tracer, uint64_t trace_id, ClientTraceSpanKind kind,
+        uint32_t context_id)
+        : tracer_((trace_id == 0) ? nullptr : tracer)
+    {
+      if (tracer_ != nullptr) {
+        span_.trace_id = trace_id;
+        span_.kind = kind;
+        span_.context_id = context_id;
+        span_.start_ns = NowNs();
+      }
+    }
+
+    ~Scope()
+    {
+      if (tracer_ != nullptr) {
+        span_.end_ns = NowNs();
+        tracer_->Record(span_);
+      }
+    }
+
+   private:
+    ClientTracer* tracer_;
+    ClientTraceSpan span_;
+  };
+
+ private:
+  const uint64_t sample_every_;
+  std::atomic<uint64_t> next_trace_id_{1};
+
+  mutable std::mutex mu_;
+  std::vector<ClientTraceSpan> spans_;
+  // The number of spans recorded, the next one goes to
+  // spans_[recorded_ % spans_.size()]
+  uint64_t recorded_{0};
+};
+
+}}  // namespace triton::perfanalyzer
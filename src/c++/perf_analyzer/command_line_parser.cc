@@ -31,8 +31,11 @@
 
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include "cpu_affinity.h"
+#include "distributed_load.h"
 #include "perf_analyzer_exception.h"
 
 namespace triton { namespace perfanalyzer {
@@ -72,11 +75,17 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "Usage: " << argv_[0] << " [options]" << std::endl;
   std::cerr << "==== SYNOPSIS ====\n \n";
   std::cerr << "\t--service-kind "
-               "<\"triton\"|\"tfserving\"|\"torchserve\"|\"triton_c_api\">"
+               "<\"triton\"|\"tfserving\"|\"torchserve\"|\"triton_c_api\"|"
+               "\"http_json\"|\"null_server\">"
             << std::endl;
   std::cerr << "\t-m <model name>" << std::endl;
   std::cerr << "\t-x <model version>" << std::endl;
   std::cerr << "\t--model-signature-name <model signature name>" << std::endl;
+  std::cerr << "\t--request-template <path>" << std::endl;
+  std::cerr << "\t--null-server <setting>=<value>[,...]" << std::endl;
+  std::cerr << "\t--tfserving-client <setting>=<value>[,...]" << std::endl;
+  std::cerr << "\t--client-network <setting>=<value>[,...]" << std::endl;
+  std::cerr << "\t--client-connections <number of clients>" << std::endl;
   std::cerr << "\t-v" << std::endl;
   std::cerr << std::endl;
   std::cerr << "I. MEASUREMENT PARAMETERS: " << std::endl;
@@ -86,24 +95,41 @@ CLParser::Usage(const std::string& msg)
             << std::endl;
   std::cerr << "\t--concurrency-range <start:end:step>" << std::endl;
   std::cerr << "\t--request-rate-range <start:end:step>" << std::endl;
-  std::cerr << "\t--request-distribution <\"poisson\"|\"constant\">"
+  std::cerr << "\t--request-distribution <\"poisson\"|\"constant\"|\"bursty\"|"
+               "\"mmpp\"|\"diurnal\">[:<setting>=<value>,...]"
             << std::endl;
+  std::cerr << "\t--schedule-plugin <path to shared library>" << std::endl;
+  std::cerr << "\t--schedule-plugin-config <config>" << std::endl;
   std::cerr << "\t--request-intervals <path to file containing time intervals "
                "in microseconds>"
             << std::endl;
+  std::cerr << "\t--request-trace <path to file containing request timestamps "
+               "in microseconds>"
+            << std::endl;
+  std::cerr << "\t--schedule-record-file <path>" << std::endl;
+  std::cerr << "\t--schedule-replay-file <path>" << std::endl;
+  std::cerr << "\t--precise-scheduling" << std::endl;
+  std::cerr << "\t--dispatcher-threads <number of threads>" << std::endl;
+  std::cerr << "\t--max-inflight-requests <number of requests>" << std::endl;
+  std::cerr << "\t--inflight-overload <drop|queue>" << std::endl;
   std::cerr << "\t--binary-search" << std::endl;
+  std::cerr << "\t--adaptive-search" << std::endl;
+  std::cerr << "\t--capacity-search" << std::endl;
   std::cerr << "\t--num-of-sequences <number of concurrent sequences>"
             << std::endl;
   std::cerr << "\t--latency-threshold (-l) <latency threshold (in msec)>"
             << std::endl;
-  std::cerr << "\t--max-threads <thread counts>" << std::endl;
+  std::cerr << "\t--max-threads <thread counts|auto>" << std::endl;
   std::cerr << "\t--stability-percentage (-s) <deviation threshold for stable "
                "measurement (in percentage)>"
             << std::endl;
+  std::cerr << "\t--early-convergence" << std::endl;
   std::cerr << "\t--max-trials (-r)  <maximum number of measurements for each "
                "profiling>"
             << std::endl;
   std::cerr << "\t--percentile <percentile>" << std::endl;
+  std::cerr << "\t--model-load-iterations <n>" << std::endl;
+  std::cerr << "\t--model-load-config <path>" << std::endl;
   std::cerr << "\tDEPRECATED OPTIONS" << std::endl;
   std::cerr << "\t-t <number of concurrent requests>" << std::endl;
   std::cerr << "\t-c <maximum concurrency>" << std::endl;
@@ -112,9 +138,30 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "II. INPUT DATA OPTIONS: " << std::endl;
   std::cerr << "\t-b <batch size>" << std::endl;
   std::cerr << "\t--input-data <\"zero\"|\"random\"|<path>>" << std::endl;
+  std::cerr << "\t--write-input-corpus <path>" << std::endl;
   std::cerr << "\t--shared-memory <\"system\"|\"cuda\"|\"none\">" << std::endl;
   std::cerr << "\t--output-shared-memory-size <size in bytes>" << std::endl;
+  std::cerr << "\t--shared-memory-pool-size <number of regions>" << std::endl;
+  std::cerr << "\t--output-shared-memory-slots <number of slots>" << std::endl;
+  std::cerr << "\t--shared-memory-huge-pages" << std::endl;
+  std::cerr << "\t--shared-memory-prefault" << std::endl;
+  std::cerr << "\t--shared-memory-persist" << std::endl;
+  std::cerr << "\t--output-memory "
+               "<\"cpu\"|\"cpu_pinned\"|\"gpu[:<device id>]\"|\"preferred\">"
+            << std::endl;
+  std::cerr << "\t--lazy-model-load" << std::endl;
+  std::cerr << "\t--server-request-trace" << std::endl;
+  std::cerr << "\t--model-config-cache <path>" << std::endl;
+  std::cerr << "\t--prestage-inputs" << std::endl;
+  std::cerr << "\t--data-prefetch-steps <n>" << std::endl;
+  std::cerr << "\t--output-tolerance <absolute>[,<relative>]" << std::endl;
+  std::cerr << "\t--validation-threads <n>" << std::endl;
   std::cerr << "\t--shape <name:shape>" << std::endl;
+  std::cerr << "\t--input-shape-distribution "
+               "<name:dimension:min:max[:distribution]>"
+            << std::endl;
+  std::cerr << "\t--input-shape-count <number of shapes>" << std::endl;
+  std::cerr << "\t--experiment-file <path>" << std::endl;
   std::cerr << "\t--sequence-length <length>" << std::endl;
   std::cerr << "\t--sequence-length-variation <variation>" << std::endl;
   std::cerr << "\t--sequence-id-range <start:end>" << std::endl;
@@ -144,8 +191,11 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "\t-f <filename for storing report in csv format>" << std::endl;
   std::cerr << "\t-H <HTTP header>" << std::endl;
   std::cerr << "\t--streaming" << std::endl;
+  std::cerr << "\t--http-streaming-endpoint <generate_stream>" << std::endl;
   std::cerr << "\t--grpc-compression-algorithm <compression_algorithm>"
             << std::endl;
+  std::cerr << "\t--http-compression-algorithm <compression_algorithm>"
+            << std::endl;
   std::cerr << "\t--trace-file" << std::endl;
   std::cerr << "\t--trace-level" << std::endl;
   std::cerr << "\t--trace-rate" << std::endl;
@@ -154,6 +204,46 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "\t--collect-metrics" << std::endl;
   std::cerr << "\t--metrics-url" << std::endl;
   std::cerr << "\t--metrics-interval" << std::endl;
+  std::cerr << "\t--metrics-allowlist <family,...>" << std::endl;
+  std::cerr << "\t--time-series-file <path>" << std::endl;
+  std::cerr << "\t--time-series-interval <interval in msec>" << std::endl;
+  std::cerr << "\t--request-record-file <path>" << std::endl;
+  std::cerr << "\t--slowest-requests <count>" << std::endl;
+  std::cerr << "\t--client-stage-times" << std::endl;
+  std::cerr << "\t--client-trace-file <path>" << std::endl;
+  std::cerr << "\t--client-trace-rate <rate>" << std::endl;
+  std::cerr << "\t--client-cpus <CPU list>" << std::endl;
+  std::cerr << "\t--worker-cpus <CPU list>" << std::endl;
+  std::cerr << "\t--share-nothing" << std::endl;
+  std::cerr << "\t--numa-node <NUMA node>" << std::endl;
+  std::cerr << "\t--async-continuations" << std::endl;
+  std::cerr << "\t--warm-ramp" << std::endl;
+  std::cerr << "\t--sequences-per-context <number of sequences>" << std::endl;
+  std::cerr << "\t--sequence-length-distribution <distribution>" << std::endl;
+  std::cerr << "\t--sequence-think-time <distribution>" << std::endl;
+  std::cerr << "\t--mpi-distributed-load" << std::endl;
+  std::cerr << "\t--mpi-rank-weights <weight,...>" << std::endl;
+  std::cerr << "\t--window-alignment <window alignment (in msec)>"
+            << std::endl;
+  std::cerr << "\t--window-start-time <seconds since epoch>" << std::endl;
+  std::cerr << "\t--settle-window <settle window (in msec)>" << std::endl;
+  std::cerr << "\t--warmup-request-count <number of requests>" << std::endl;
+  std::cerr << "\t--latency-outlier-factor <multiple of the median latency>"
+            << std::endl;
+  std::cerr << "\t--latency-buckets <stream|shape|model>" << std::endl;
+  std::cerr << "\t--model-mix <name[:version][=weight][@stream],...|file>"
+            << std::endl;
+  std::cerr << "\t--request-classes <name[:priority[:timeout_us]][=weight],...>"
+            << std::endl;
+  std::cerr << "\t--baseline <path>" << std::endl;
+  std::cerr << "\t--regression-threshold <percentage>" << std::endl;
+  std::cerr << "\t--checkpoint-file <path>" << std::endl;
+  std::cerr << "\t--endpoints <url[=weight],...>" << std::endl;
+  std::cerr << "\t--endpoint-policy <round_robin|affinity|weighted>"
+            << std::endl;
+  std::cerr << "\t--input-repeat-ratio <ratio>" << std::endl;
+  std::cerr << "\t--input-popularity-skew <exponent>" << std::endl;
+  std::cerr << "\t--batch-size-range <start:end[:step]>" << std::endl;
   std::cerr << std::endl;
   std::cerr << "==== OPTIONS ==== \n \n";
 
@@ -161,14 +251,20 @@ CLParser::Usage(const std::string& msg)
       << FormatMessage(
              " --service-kind: Describes the kind of service perf_analyzer to "
              "generate load for. The options are \"triton\", \"triton_c_api\", "
-             "\"tfserving\" and \"torchserve\". Default value is \"triton\". "
+             "\"tfserving\", \"torchserve\", \"http_json\" and "
+             "\"null_server\". Default value is \"triton\". "
              "Note in order to use \"torchserve\" backend --input-data option "
              "must point to a json file holding data in the following format "
              "{\"data\" : [{\"TORCHSERVE_INPUT\" : [\"<complete path to the "
              "content file>\"]}, {...}...]}. The type of file here will depend "
              "on the model. In order to use \"triton_c_api\" you must specify "
              "the Triton server install path and the model repository "
-             "path via the --library-name and --model-repo flags",
+             "path via the --library-name and --model-repo flags. In order to "
+             "use \"http_json\" you must specify the template of the request "
+             "body via the --request-template flag and the URL of the endpoint "
+             "via the -u flag. \"null_server\" sends the requests to a server "
+             "simulated in the process, configured with the --null-server "
+             "flag, to measure the limits of perf_analyzer itself",
              18)
       << std::endl;
 
@@ -193,6 +289,72 @@ CLParser::Usage(const std::string& msg)
                    "\"tfserving\".",
                    18)
             << std::endl;
+  std::cerr << FormatMessage(
+                   " --request-template: The path to the JSON template of the "
+                   "request body. Each '{{NAME}}' placeholder is replaced by "
+                   "the data of the input NAME from --input-data, escaped as "
+                   "the content of a JSON string. Responses streamed as "
+                   "server-sent events also report the time to first byte "
+                   "and the latency between events. This option will be "
+                   "ignored if --service-kind is not \"http_json\".",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --null-server: The behavior of the server simulated by "
+                   "the \"null_server\" service kind, as a comma separated "
+                   "list of settings. 'latency_us' is the time each batch "
+                   "takes to execute. 'max_batch_size' batches the queued "
+                   "requests up to that size, the oldest one waiting at most "
+                   "'batch_delay_us' for the batch to fill. 'instance_count' "
+                   "limits the number of batches executed at once. All the "
+                   "settings default to 0, that is no latency, no batching "
+                   "and no limit. The simulated model has a single INT32 "
+                   "input INPUT0 of 16 elements and no outputs. This option "
+                   "will be ignored if --service-kind is not \"null_server\".",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --tfserving-client: How the clients of the "
+                   "\"tfserving\" service kind send their requests, as a "
+                   "comma separated list of settings. 'completion_queues' "
+                   "is the number of gRPC completion queues shared by all "
+                   "the clients, each drained by a thread of its own, "
+                   "instead of a queue and a thread per client, which is the "
+                   "default of 0. 'channels' is the number of gRPC channels, "
+                   "each with a connection of its own, that the clients take "
+                   "in turn, 0 for a channel per client. It defaults to 1, "
+                   "that is all the clients share one connection. This "
+                   "option will be ignored if --service-kind is not "
+                   "\"tfserving\".",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --client-network: Simulates slow clients, such as "
+                   "mobile ones, as a comma separated list of settings. "
+                   "'upload_bytes_per_sec' limits the rate each request is "
+                   "sent at and 'download_bytes_per_sec' the rate each "
+                   "response is read at, which leaves the connections and "
+                   "buffers of the server busy for longer. 'send_delay_us' "
+                   "delays every request by that long before it is sent, "
+                   "and counts towards its latency. All the settings default "
+                   "to 0, that is no limit and no delay. The rate limits "
+                   "only apply to the HTTP protocol of the \"triton\" "
+                   "service kind.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --client-connections: The number of clients, each with "
+                   "its own connections to the server, that the concurrent "
+                   "requests are sent through. The clients are shared in "
+                   "round robin by the contexts of all the threads, so that "
+                   "the number of connections can be studied apart from the "
+                   "concurrency. A gRPC client opens a single connection, "
+                   "while an HTTP client opens one per request in flight. "
+                   "Default is 0, that is a client for each concurrent "
+                   "request. Only applies to the \"triton\" service kind, "
+                   "without --streaming.",
+                   18)
+            << std::endl;
   std::cerr << std::setw(9) << std::left
             << " -v: " << FormatMessage("Enables verbose mode.", 9)
             << std::endl;
@@ -281,12 +443,43 @@ CLParser::Usage(const std::string& msg)
       << std::endl;
   std::cerr
       << FormatMessage(
-             " --request-distribution <\"poisson\"|\"constant\">: Specifies "
+             " --request-distribution <\"poisson\"|\"constant\"|\"bursty\"|"
+             "\"mmpp\"|\"diurnal\">: Specifies "
              "the time interval distribution between dispatching inference "
              "requests to the server. Poisson distribution closely mimics the "
-             "real-world work load on a server. This option is ignored if not "
-             "using --request-rate-range. By default, this option is set to be "
-             "constant.",
+             "real-world work load on a server. The other distributions are "
+             "Poisson arrivals whose rate varies over time while averaging to "
+             "the requested rate, and can be tuned with comma separated "
+             "<setting>=<value> pairs after a colon. \"bursty\" only sends "
+             "during the first on_ms (default 100) of every on_ms + off_ms "
+             "(default 900) milliseconds. \"mmpp\" switches between a low "
+             "and a high rate that is burst_factor (default 10) times higher, "
+             "staying on average low_ms (default 900) and high_ms (default "
+             "100) milliseconds in each. \"diurnal\" follows a sine wave "
+             "with a period of period_s (default 60) seconds and an amplitude "
+             "of amplitude (default 0.5) times the requested rate. For "
+             "example, \"bursty:on_ms=50,off_ms=450\". This option is "
+             "ignored if not using --request-rate-range. By default, this "
+             "option is set to be constant.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --schedule-plugin: Specifies a path to a shared library that "
+             "generates the schedule of the requests instead of "
+             "--request-distribution, following the C interface of "
+             "schedule_plugin_api.h. For each request rate, the plugin makes "
+             "a schedule per worker thread, which the thread reads one "
+             "request at a time: when to send it and the input data stream "
+             "to send it with. The input data stream ids are ignored for "
+             "sequence models. Only applies to --request-rate-range.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --schedule-plugin-config: A string passed as is to each "
+             "schedule made by --schedule-plugin, such as the path to the "
+             "parameters of its traffic model.",
              18)
       << std::endl;
   std::cerr
@@ -302,6 +495,90 @@ CLParser::Usage(const std::string& msg)
              "--request-rate-range or --concurrency-range.",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --request-trace: Specifies a path to a request trace to "
+             "replay, such as one extracted from production logs. Each line "
+             "holds the time a request was received in microseconds, "
+             "optionally followed by whitespace and the id of the input data "
+             "stream to send it with. Lines starting with '#' are ignored. "
+             "The requests are sent at the same offsets from the start of the "
+             "run as they have from the first request of the trace, and the "
+             "trace loops if the run outlasts it. The input data stream ids "
+             "are ignored for sequence models. This option can not be used "
+             "with --request-intervals, --request-rate-range or "
+             "--concurrency-range.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --schedule-record-file: Records every request sent in the "
+             "request rate modes to the given file in a compact binary "
+             "format: when it was scheduled, the worker thread that sent it, "
+             "the input data stream and step it was sent with and its "
+             "sequence id and flags. The file can be given to "
+             "--schedule-replay-file to send exactly the same traffic again, "
+             "for example to compare two builds of the server.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --schedule-replay-file: Specifies a path to a schedule "
+             "recorded by --schedule-record-file to replay. Each request is "
+             "sent at its recorded offset from the start of the run, by the "
+             "worker thread that sent it, with the same input data and "
+             "sequence, and the schedule loops if the run outlasts it. Use "
+             "at most as many threads as the recording did. This option can "
+             "not be used with --request-intervals, --request-trace, "
+             "--request-rate-range or --concurrency-range.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --precise-scheduling: Waits for the scheduled send time of "
+             "each request with an absolute-deadline sleep followed by a "
+             "short, self-calibrating spin instead of a plain sleep. This "
+             "keeps send times within a few microseconds of the schedule at "
+             "the cost of some CPU. The schedule error (actual minus planned "
+             "send time) is reported for each measurement. This option is "
+             "ignored if not using --request-rate-range or "
+             "--request-intervals.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --dispatcher-threads: The number of threads that follow the "
+             "request schedule and hand each request to whichever worker "
+             "thread is free, instead of every worker following its own "
+             "share of the schedule. A slow response then only occupies one "
+             "worker rather than delaying the requests scheduled after it, "
+             "which allows much higher open-loop rates. --max-threads sets "
+             "the number of worker threads. Default is 0, which disables the "
+             "dispatchers. This option is ignored if not using "
+             "--request-rate-range or --request-intervals.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --max-inflight-requests: Caps the number of requests in "
+             "flight across all the worker threads while following the "
+             "request schedule, like the admission control of a gateway. "
+             "What happens to the requests over the cap is set by "
+             "--inflight-overload. The dropped requests and the queueing "
+             "delay are reported separately from the latencies. Default is "
+             "0, which does not cap the requests. Only applies to "
+             "--request-rate-range and --request-intervals.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --inflight-overload: What to do with a request scheduled "
+             "while --max-inflight-requests requests are in flight. 'drop' "
+             "skips it, except the requests that end a sequence, which "
+             "wait. 'queue' sends it as soon as a request completes, "
+             "delaying the requests scheduled after it. Default is 'drop'.",
+             18)
+      << std::endl;
   std::cerr
       << FormatMessage(
              "--binary-search: Enables the binary search on the specified "
@@ -313,6 +590,33 @@ CLParser::Usage(const std::string& msg)
              "By default, linear search is used.",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             "--adaptive-search: Searches for the highest concurrency or "
+             "request rate whose latency stays below --latency-threshold. The "
+             "load grows along the measured latency curve, at most doubling "
+             "per step, until the threshold is crossed and the crossing is "
+             "then bisected. 'step' in --concurrency-range or "
+             "--request-rate-range is the precision of the search and an "
+             "'end' of 0 searches without an upper bound. Combine with "
+             "--percentile to target a percentile latency, such as p99.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             "--capacity-search: Measures the few concurrencies or request "
+             "rates that pin down the capacity of the server. A queueing "
+             "model fitted to the load levels measured so far picks the next "
+             "one, until the saturation throughput it predicts settles. The "
+             "report then gives the saturation throughput, the latency "
+             "without queueing, the predicted throughput and latency of load "
+             "levels that were not measured, and the concurrencies whose "
+             "throughput x latency is off the concurrency (Little's law). "
+             "'step' in --concurrency-range or --request-rate-range is the "
+             "smallest increase of the load and an 'end' of 0 searches "
+             "without an upper bound.",
+             18)
+      << std::endl;
 
   std::cerr << FormatMessage(
                    "--num-of-sequences: Sets the number of concurrent "
@@ -339,7 +643,13 @@ CLParser::Usage(const std::string& msg)
              "in synchronous mode with concurrency-range having explicit 'end' "
              "specification,"
              "this value will be ignored. Default is 4 if --request-rate-range "
-             "is specified otherwise default is 16.",
+             "is specified otherwise default is 16. With 'auto', which only "
+             "applies to --request-rate-range, perf_analyzer starts with 4 "
+             "threads and doubles them, up to 256, whenever more than 1% of "
+             "the requests of a measurement fall behind schedule, measuring "
+             "the request rate again each time. It stops growing once more "
+             "threads no longer reduce the delays and reports the number of "
+             "threads used.",
              18)
       << std::endl;
   std::cerr
@@ -352,6 +662,16 @@ CLParser::Usage(const std::string& msg)
              "10(%).",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --early-convergence: Also accepts a single measurement as "
+             "stable when it pins down the result on its own. The measurement "
+             "is split into 10 sub-windows, and it is stable if the 95% "
+             "confidence intervals of the mean infer per second and latency "
+             "across them are narrower than the stability percentage. This "
+             "lets stable configurations finish after fewer measurements.",
+             18)
+      << std::endl;
   std::cerr << FormatMessage(
                    " --max-trials (-r): Indicates the maximum number of "
                    "measurements for each concurrency level visited during "
@@ -372,6 +692,28 @@ CLParser::Usage(const std::string& msg)
              "that the average latency is used to determine stability",
              18)
       << std::endl;
+  std::cerr << FormatMessage(
+                   " --model-load-iterations: Measures the cold start of the "
+                   "model instead of profiling its inferences. The model is "
+                   "unloaded and loaded this many times, reporting how long "
+                   "the unloads and the loads took, and the time from each "
+                   "load to the response of a request of zeros sent right "
+                   "after it. With --collect-metrics, the change of the GPU "
+                   "memory used is also reported, waiting --metrics-interval "
+                   "before each scrape. The server must allow models to be "
+                   "loaded and unloaded, such as with "
+                   "--model-control-mode=explicit. Only supported with the "
+                   "triton service kind.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --model-load-config: A JSON model config that the model "
+                   "is loaded with, in place of the one of the model "
+                   "repository, before it is profiled or by each load of "
+                   "--model-load-iterations. The server must allow models to "
+                   "be loaded. Only supported with the triton service kind.",
+                   18)
+            << std::endl;
   std::cerr << std::endl;
   std::cerr << "II. INPUT DATA OPTIONS: " << std::endl;
   std::cerr << std::setw(9) << std::left
@@ -398,10 +740,21 @@ CLParser::Usage(const std::string& msg)
              "round-robin fashion for every new sequence. Muliple json files "
              "can also be provided (--input-data json_file1 --input-data "
              "json-file2 and so on) and the analyzer will append data streams "
-             "from each file. When using --service-kind=torchserve make sure "
+             "from each file. The path can also be a binary input corpus "
+             "written by --write-input-corpus, which is memory mapped instead "
+             "of parsed. When using --service-kind=torchserve make sure "
              "this option points to a json file. Default is \"random\".",
              18)
       << std::endl;
+  std::cerr << FormatMessage(
+                   " --write-input-corpus: Reads the data given with "
+                   "--input-data, writes it to a binary input corpus at the "
+                   "given path and exits. Passing the corpus as --input-data "
+                   "to later runs maps it instead of parsing it, which makes "
+                   "large data sets load instantly and lets processes on the "
+                   "same host share its pages.",
+                   18)
+            << std::endl;
   std::cerr << FormatMessage(
                    " --shared-memory <\"system\"|\"cuda\"|\"none\">: Specifies "
                    "the type of the shared memory to use for input and output "
@@ -421,6 +774,97 @@ CLParser::Usage(const std::string& msg)
              "batch_size. Defaults to 100KB.",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --shared-memory-pool-size: The number of shared memory regions "
+             "to register per input. The data steps are copied into free "
+             "regions ahead of the requests that use them, instead of "
+             "registering one region per input and data step, so that data "
+             "sets larger than the shared memory available can be used. "
+             "Must be larger than the maximum number of requests in flight, "
+             "and about twice that keeps the copies ahead of the requests. "
+             "Default is 0, which registers a region per data step.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --output-shared-memory-slots: The number of shared memory "
+             "regions to register per output. Every request writes its "
+             "outputs to a free slot and holds it until it completes, and "
+             "requests wait for a slot when they are all in use. Outputs in "
+             "shared memory are validated in place. Default is 0, which "
+             "shares one region per output among all requests, so validating "
+             "outputs is only reliable with one request in flight.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --shared-memory-huge-pages: Backs the system shared memory "
+             "regions with transparent huge pages, which needs the "
+             "shmem_enabled setting of transparent huge pages to be "
+             "\"advise\" or \"always\".",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --shared-memory-prefault: Faults in all the pages of the "
+             "system shared memory regions when they are created, so that the "
+             "first requests do not take the page faults. The regions are "
+             "also placed on the node of --numa-node, if given.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --shared-memory-persist: Leaves the system shared memory "
+             "regions registered with the server and in place when the run "
+             "ends, and reuses the regions left by earlier runs. The input "
+             "regions are named by a hash of their data, so the next run "
+             "with the same data skips creating, filling and registering "
+             "them. Only for --shared-memory system with "
+             "service-kind=triton, and not with --shared-memory-pool-size. "
+             "The regions are removed by a run without this option, which "
+             "unregisters all the regions, and by removing their objects "
+             "from /dev/shm.",
+             18)
+      << std::endl;
+  std::cerr << FormatMessage(
+                   " --prestage-inputs: Builds the inputs of every data step "
+                   "once per context instead of copying the input data into "
+                   "every request. Each context keeps its own copy of the "
+                   "whole data set, so this is meant for small data sets sent "
+                   "to small models at high request rates. Cannot be used "
+                   "with --shared-memory.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --data-prefetch-steps: Reads the --input-data directory "
+                   "as one subdirectory per step, in the order of their "
+                   "names, each holding a file per input. The steps are read "
+                   "by background threads while the requests are sent, this "
+                   "many steps ahead of them, so data sets larger than the "
+                   "memory can be sent without repeating data. The inputs "
+                   "must have static shapes and the outputs are not "
+                   "validated. Cannot be used with --shared-memory or "
+                   "--prestage-inputs.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --output-tolerance: How far the floating point elements "
+                   "of the outputs may be from the expected outputs of "
+                   "--input-data. An element matches when its absolute error "
+                   "is at most the absolute tolerance plus the relative "
+                   "tolerance times the expected value. Other data types "
+                   "must match exactly. Mismatches are counted and reported "
+                   "rather than failing the run. Default is 0,0.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --validation-threads: The number of threads comparing "
+                   "the outputs with the expected outputs, off the threads "
+                   "sending the requests. 0 compares them on the sending "
+                   "threads. Default is 1.",
+                   18)
+            << std::endl;
 
   std::cerr << FormatMessage(
                    " --shape: The shape used for the specified input. The "
@@ -431,6 +875,54 @@ CLParser::Usage(const std::string& msg)
                    "shapes for different inputs.",
                    18)
             << std::endl;
+  std::cerr << FormatMessage(
+                   " --input-shape-distribution: Varies a dimension of the "
+                   "shape of a generated input from request to request, "
+                   "such as the sequence length of a model with dynamic "
+                   "shapes. The argument is "
+                   "'name:dimension:min:max[:distribution]', where the "
+                   "dimension is its index in the shape given by --shape or "
+                   "the model, without the batch dimension, and the "
+                   "distribution is given as for "
+                   "--sequence-length-distribution, uniform between the "
+                   "bounds by default and with a mean defaulting to the "
+                   "middle of the bounds. Drawn values are clamped to the "
+                   "bounds. For example 'input_ids:0:16:512:lognormal'. May "
+                   "be specified multiple times. The data of all the shapes "
+                   "is served from a single buffer sized for the largest. "
+                   "Only applies to generated data of non-BYTES inputs.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --input-shape-count: The number of shapes drawn with "
+                   "--input-shape-distribution, which the requests go "
+                   "through in turn. Default is 64.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --experiment-file: Runs a matrix of configurations one "
+                   "after the other in this process, from a JSON file with "
+                   "the 'arguments' common to all of them, a 'matrix' of "
+                   "options and their values, such as [{\"name\": \"-b\", "
+                   "\"values\": [1, 8]}, {\"name\": \"--async\", "
+                   "\"values\": [true, false]}], and an optional "
+                   "'cache_directory', 'perf_analyzer_cache' by default. The "
+                   "other options of the command line come first in every "
+                   "configuration. The CSV report of each configuration is "
+                   "written to the cache directory under a hash of its "
+                   "command line, and configurations that already have a "
+                   "report there are skipped, so an interrupted matrix "
+                   "resumes where it stopped. Entries of the matrix with a "
+                   "'config' instead of a 'name', such as "
+                   "{\"config\": \"dynamic_batching.max_queue_delay_"
+                   "microseconds\", \"values\": [0, 100]}, set that field "
+                   "in a copy of the optional 'model_config' object of the "
+                   "file, which each configuration loads the model with "
+                   "through --model-load-config. The Pareto frontier of "
+                   "throughput vs. p99 latency over all the configurations "
+                   "is printed at the end.",
+                   18)
+            << std::endl;
   std::cerr << FormatMessage(
                    " --sequence-length: Indicates the base length of a "
                    "sequence used for sequence models. A sequence with length "
@@ -488,7 +980,9 @@ CLParser::Usage(const std::string& msg)
                    "Specify URL to the server. When using triton default is "
                    "\"localhost:8000\" if using HTTP and \"localhost:8001\" "
                    "if using gRPC. When using tfserving default is "
-                   "\"localhost:8500\". ",
+                   "\"localhost:8500\". Use \"unix://<path>\" to connect to "
+                   "a triton server over a Unix domain socket with either "
+                   "protocol. ",
                    38)
             << std::endl;
   std::cerr << std::setw(38) << std::left << " -i: "
@@ -590,7 +1084,21 @@ CLParser::Usage(const std::string& msg)
   std::cerr
       << FormatMessage(
              " --streaming: Enables the use of streaming API. This flag is "
-             "only valid with gRPC protocol. By default, it is set false.",
+             "only valid with gRPC protocol or the triton_c_api service "
+             "kind, or with HTTP protocol when --http-streaming-endpoint is "
+             "specified. By default, it is set false.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --http-streaming-endpoint: The endpoint the requests of "
+             "--streaming are sent to with HTTP protocol and the triton "
+             "service kind. The only supported endpoint is generate_stream, "
+             "whose responses are received as server-sent events. It speaks "
+             "the JSON format of the generate extension, so the inputs can't "
+             "be in shared memory or of FP16 or BF16 datatype, the requested "
+             "outputs are ignored because all the outputs are returned, and "
+             "the datatype of an output follows from its JSON value.",
              18)
       << std::endl;
 
@@ -598,7 +1106,20 @@ CLParser::Usage(const std::string& msg)
                    " --grpc-compression-algorithm: The compression algorithm "
                    "to be used by gRPC when sending request. Only supported "
                    "when grpc protocol is being used. The supported values are "
-                   "none, gzip, and deflate. Default value is none.",
+                   "none, gzip, deflate and adaptive. With adaptive, requests "
+                   "of 64 KB or more whose data looks compressible are "
+                   "compressed with deflate, the others are not. Default "
+                   "value is none.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --http-compression-algorithm: The compression algorithm "
+                   "of the bodies of the HTTP requests. The input data of "
+                   "each data step is compressed once and reused, so only "
+                   "the JSON header of a request is compressed when it is "
+                   "sent. Only supported by the triton service kind with the "
+                   "http protocol. The supported values are none, gzip, and "
+                   "deflate. Default value is none.",
                    18)
             << std::endl;
 
@@ -658,6 +1179,49 @@ CLParser::Usage(const std::string& msg)
              "eg:--model-repository=/tmp/host/docker-data/model_unit_test.",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --output-memory: Where the C API backend allocates the outputs "
+             "that are not in shared memory. \"cpu\" allocates host memory, "
+             "\"cpu_pinned\" pinned host memory and \"gpu\" the memory of "
+             "the given device, 0 if not given. \"preferred\" allocates the "
+             "memory that the server asks for, so GPU models can skip the copy "
+             "to the host. Only used when C API is used "
+             "(--service-kind=triton_c_api). Default is \"cpu\".",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --lazy-model-load: Starts the in-process server without "
+             "loading the model repository, the models that are profiled are "
+             "loaded when they are first used. A model that is already loaded "
+             "is only loaded again if its configuration or versions changed. "
+             "Models that the profiled models call, e.g. through BLS, must "
+             "also be listed in --model-mix to be loaded. Only used when C "
+             "API is used (--service-kind=triton_c_api).",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --server-request-trace: Traces the timestamps of every request "
+             "in the in-process server and reports the distributions of the "
+             "queue and compute input, infer and output times of the "
+             "requests, instead of only their averages from the server "
+             "statistics. Only used when C API is used "
+             "(--service-kind=triton_c_api).",
+             18)
+      << std::endl;
+  std::cerr << FormatMessage(
+                   " --model-config-cache: The directory to keep the configs "
+                   "of the composing models of ensembles in, so that later "
+                   "runs against the same server do not fetch them again. "
+                   "Only the composing models with an explicit version in "
+                   "the ensemble config are cached, as the config of the "
+                   "latest version may change from run to run. The "
+                   "directory must be cleared when a model changes without "
+                   "a new version.",
+                   18)
+            << std::endl;
   std::cerr << FormatMessage(
                    " --verbose-csv: The csv files generated by perf analyzer "
                    "will include additional information.",
@@ -681,116 +1245,585 @@ CLParser::Usage(const std::string& msg)
                    "inference server metrics. Default is 1000.",
                    18)
             << std::endl;
-  exit(GENERIC_ERROR);
-}
-
-void
-CLParser::ParseCommandLine(int argc, char** argv)
-{
-  argc_ = argc;
-  argv_ = argv;
-
-  // {name, has_arg, *flag, val}
-  static struct option long_options[] = {
-      {"streaming", no_argument, 0, 0},
-      {"max-threads", required_argument, 0, 1},
-      {"sequence-length", required_argument, 0, 2},
-      {"percentile", required_argument, 0, 3},
-      {"data-directory", required_argument, 0, 4},
-      {"shape", required_argument, 0, 5},
-      {"measurement-interval", required_argument, 0, 6},
-      {"concurrency-range", required_argument, 0, 7},
-      {"latency-threshold", required_argument, 0, 8},
-      {"stability-percentage", required_argument, 0, 9},
-      {"max-trials", required_argument, 0, 10},
-      {"input-data", required_argument, 0, 11},
-      {"string-length", required_argument, 0, 12},
-      {"string-data", required_argument, 0, 13},
-      {"async", no_argument, 0, 14},
-      {"sync", no_argument, 0, 15},
-      {"request-rate-range", required_argument, 0, 16},
-      {"num-of-sequences", required_argument, 0, 17},
-      {"binary-search", no_argument, 0, 18},
-      {"request-distribution", required_argument, 0, 19},
-      {"request-intervals", required_argument, 0, 20},
-      {"shared-memory", required_argument, 0, 21},
-      {"output-shared-memory-size", required_argument, 0, 22},
-      {"service-kind", required_argument, 0, 23},
-      {"model-signature-name", required_argument, 0, 24},
-      {"grpc-compression-algorithm", required_argument, 0, 25},
-      {"measurement-mode", required_argument, 0, 26},
-      {"measurement-request-count", required_argument, 0, 27},
-      {"triton-server-directory", required_argument, 0, 28},
-      {"model-repository", required_argument, 0, 29},
-      {"sequence-id-range", required_argument, 0, 30},
-      {"ssl-grpc-use-ssl", no_argument, 0, 31},
-      {"ssl-grpc-root-certifications-file", required_argument, 0, 32},
-      {"ssl-grpc-private-key-file", required_argument, 0, 33},
-      {"ssl-grpc-certificate-chain-file", required_argument, 0, 34},
-      {"ssl-https-verify-peer", required_argument, 0, 35},
-      {"ssl-https-verify-host", required_argument, 0, 36},
-      {"ssl-https-ca-certificates-file", required_argument, 0, 37},
-      {"ssl-https-client-certificate-file", required_argument, 0, 38},
-      {"ssl-https-client-certificate-type", required_argument, 0, 39},
-      {"ssl-https-private-key-file", required_argument, 0, 40},
-      {"ssl-https-private-key-type", required_argument, 0, 41},
-      {"verbose-csv", no_argument, 0, 42},
-      {"enable-mpi", no_argument, 0, 43},
-      {"trace-file", required_argument, 0, 44},
-      {"trace-level", required_argument, 0, 45},
-      {"trace-rate", required_argument, 0, 46},
-      {"trace-count", required_argument, 0, 47},
-      {"log-frequency", required_argument, 0, 48},
-      {"collect-metrics", no_argument, 0, 49},
-      {"metrics-url", required_argument, 0, 50},
-      {"metrics-interval", required_argument, 0, 51},
-      {"sequence-length-variation", required_argument, 0, 52},
-      {0, 0, 0, 0}};
-
-  // Parse commandline...
-  int opt;
-  while ((opt = getopt_long(
-              argc, argv, "vdazc:u:m:x:b:t:p:i:H:l:r:s:f:", long_options,
-              NULL)) != -1) {
-    switch (opt) {
-      case 0:
-        params_->streaming = true;
-        break;
-      case 1:
-        params_->max_threads = std::atoi(optarg);
-        params_->max_threads_specified = true;
-        break;
-      case 2:
-        params_->sequence_length = std::atoi(optarg);
-        params_->sequence_length_specified = true;
-        break;
-      case 3:
-        params_->percentile = std::atoi(optarg);
-        break;
-      case 4:
-        params_->user_data.push_back(optarg);
-        break;
-      case 5: {
-        std::string arg = optarg;
-        auto colon_pos = arg.rfind(":");
-        if (colon_pos == std::string::npos) {
-          Usage(
-              "failed to parse input shape. There must be a colon after input "
-              "name.");
-        }
-        std::string name = arg.substr(0, colon_pos);
-        std::string shape_str = arg.substr(name.size() + 1);
-        size_t pos = 0;
-        std::vector<int64_t> shape;
-        try {
-          while (pos != std::string::npos) {
-            size_t comma_pos = shape_str.find(",", pos);
-            int64_t dim;
-            if (comma_pos == std::string::npos) {
-              dim = std::stoll(shape_str.substr(pos, comma_pos));
-              pos = comma_pos;
-            } else {
-              dim = std::stoll(shape_str.substr(pos, comma_pos - pos));
+  std::cerr << FormatMessage(
+                   " --metrics-allowlist: The comma separated metric families "
+                   "to collect beyond the GPU ones. Gauges are averaged and "
+                   "counters report their increase over the measurement "
+                   "windows. Default is 'nv_inference_queue_duration_us,"
+                   "nv_inference_pending_request_count,"
+                   "nv_inference_request_success,nv_inference_count,"
+                   "nv_cpu_utilization,nv_cpu_memory_used_bytes'.",
+                   18)
+            << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --time-series-file: Writes a sample of the load every "
+             "--time-series-interval for the whole run, independent of the "
+             "measurement windows. Each sample has the throughput, the "
+             "average, p50, p90, p95 and p99 latencies, the number of "
+             "requests in flight and, for Triton, the average server queue "
+             "and compute times. The samples are appended to the file as "
+             "csv, unless it ends in '.prom', in which case the file is "
+             "replaced with the latest sample in the Prometheus text format "
+             "for the textfile collector of the node exporter.",
+             18)
+      << std::endl;
+  std::cerr << FormatMessage(
+                   " --time-series-interval: The interval in milliseconds "
+                   "of the samples written to --time-series-file. Default is "
+                   "1000.",
+                   18)
+            << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --request-record-file: Streams the record of every completed "
+             "request to a binary columnar file during the run: its send "
+             "time, latency, time to the first response, number of "
+             "responses, and whether it ended a sequence or was sent late. "
+             "See the README for the layout of the file.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --slowest-requests: Reports the given number of slowest "
+             "requests of each load level with what identifies them: the "
+             "worker thread and context that sent them, their input data "
+             "stream and step, their sequence id, their endpoint, and when "
+             "they were sent and received their first and last responses. "
+             "They are printed with the results and written to a "
+             "'slow_requests.' prefixed copy of the csv file. Each worker "
+             "thread keeps its slowest requests of a measurement window, "
+             "which are merged when the window is collected.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --client-stage-times: Times where the client spends its time "
+             "on each request: preparing the input data, in the call that "
+             "sends the request, in the response callback and validating the "
+             "outputs. The averages per request are reported with the "
+             "results and added to the csv file. Use it to find which stage "
+             "to scale when the client host is the bottleneck.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --client-trace-file: Traces a sample of the requests on the "
+             "client and writes the spans of the most recent ones to the "
+             "given file in the Chrome trace format, which chrome://tracing "
+             "and Perfetto open. The spans are the input data preparation, "
+             "the call that sends the request, the wait for the response, "
+             "the response callback and the output validation. A traced "
+             "request is sent with the request id \"pa-trace-<trace id>\", "
+             "which the server traces record, so that the client and the "
+             "server spans of a request can be joined.",
+             18)
+      << std::endl;
+  std::cerr << FormatMessage(
+                   " --client-trace-rate: Trace one in every <rate> requests "
+                   "of each context with --client-trace-file. Default is "
+                   "1000.",
+                   18)
+            << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --client-cpus: The CPUs perf_analyzer runs on, in the format "
+             "of the Linux cpulist files, such as \"0-7,16-23\". Covers all "
+             "of its threads, including the client transport and callback "
+             "threads. Defaults to the CPUs of --numa-node if it is given, "
+             "and to any CPU otherwise.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --worker-cpus: The CPUs of the threads generating the load, in "
+             "the same format as --client-cpus. Each worker thread is pinned "
+             "to one CPU of the list, taken in turn. Defaults to the CPUs of "
+             "--client-cpus.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --share-nothing: Makes each worker thread generate its load "
+             "on a CPU of its own without sharing state with the other "
+             "threads: each thread owns its request data, its sequences and "
+             "its clients, and counts its completed requests on its own. The "
+             "threads are pinned to the CPUs of --worker-cpus, or else to "
+             "the CPUs perf_analyzer may run on, and --max-threads defaults "
+             "to the number of these CPUs. The input data is read once and "
+             "shared read only. Not supported with shared memory, "
+             "--client-connections or --dispatcher-threads.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --numa-node: The NUMA node to allocate memory from, including "
+             "the input data and the shared memory regions. Also restricts "
+             "perf_analyzer to the CPUs of the node unless --client-cpus is "
+             "given. Default is to allocate from any node.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --async-continuations: In asynchronous concurrency mode, makes "
+             "the callback of each request send the next request itself, "
+             "instead of waking up a worker thread to do it. A few threads "
+             "can then keep thousands of requests in flight. The client "
+             "overhead reported only covers the worker threads, not the "
+             "requests sent from the callbacks. Shared memory pools and "
+             "output slots must have more entries than requests in flight.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --warm-ramp: When moving to the next concurrency level, adds "
+             "or retires contexts while the other contexts keep sending, "
+             "instead of pausing all the workers. Sequences of the retired "
+             "contexts are ended early. Combine with --settle-window to leave "
+             "the transition out of the measurement.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --sequences-per-context: In concurrency mode on sequence "
+             "models, makes each context drive the given number of "
+             "sequences, sending a step of each of them in turn. Each step "
+             "is still its own request, and a sequence only gets its next "
+             "step once the previous one is answered, but the server's "
+             "sequence batcher can batch the steps of concurrency times as "
+             "many live sequences. Default is 1.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --sequence-length-distribution: The distribution of the "
+             "lengths of the sequences, in the format "
+             "\"<kind>[:<setting>=<value>,...]\". The kinds are 'uniform', "
+             "the default, which varies the lengths by "
+             "--sequence-length-variation, 'constant', 'exponential' and "
+             "'lognormal', whose 'mean' setting defaults to "
+             "--sequence-length and where 'lognormal' also takes a 'sigma' "
+             "setting for the spread, 0.5 by default, and 'histogram', which "
+             "takes a 'file' setting naming a file with one \"<length> "
+             "<weight>\" pair per line. For example "
+             "\"lognormal:mean=20,sigma=1\".",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --sequence-think-time: In concurrency mode on sequence models, "
+             "makes each context wait between the response to a step of a "
+             "sequence and its next step, like a user reading a reply before "
+             "the next turn. The wait in msec is drawn from the given "
+             "distribution, in the format of "
+             "--sequence-length-distribution with no default mean. A context "
+             "does not wait before the first step of a sequence.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --mpi-distributed-load: With --enable-mpi, makes all the MPI "
+             "ranks share the load on the same model, for deployments that "
+             "a single client host cannot saturate. The concurrency or "
+             "request rate of each step is the total of all the ranks, rank "
+             "0 assigns the share of each rank, the measurement windows "
+             "start together on the clock of rank 0, and the throughput "
+             "and latency histograms of the ranks are merged into a single "
+             "report written by rank 0. The data streams of --input-data are "
+             "split over the ranks, unless there are fewer streams than "
+             "ranks. The clocks of the hosts must be synchronized, e.g. by "
+             "NTP.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --mpi-rank-weights: The share of each MPI rank in a "
+             "distributed load, as a comma separated list with one weight "
+             "per rank, such as \"2,1,1\". Default is equal shares.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --window-alignment: Aligns the measurement windows to "
+             "boundaries of the wall clock spaced by this interval in msec, "
+             "so that separate perf_analyzer instances measure over the same "
+             "spans of time. The first window starts on the next boundary "
+             "and the length of the windows is rounded up to a whole number "
+             "of boundaries. With --enable-mpi the clocks of the other ranks "
+             "are corrected by their measured offset to rank 0, otherwise "
+             "the clocks of the hosts must be synchronized, e.g. by NTP. "
+             "Only supports --measurement-mode=time_windows. Default is 0, "
+             "not aligned.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --window-start-time: A window boundary, in seconds since the "
+             "epoch, before which no measurement starts. Requires "
+             "--window-alignment. Default is 0, the boundaries being "
+             "multiples of the alignment since the epoch.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --settle-window: The time interval in msec to let the load "
+             "settle after each change of load level. Requests completing "
+             "in it are not measured. Default is 0.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --warmup-request-count: The number of requests to let "
+             "complete after each change of load level, and after the "
+             "settle window if any, before measuring. Covers start-up costs "
+             "that take a number of requests rather than an amount of time, "
+             "such as filling caches. Default is 0.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --latency-outlier-factor: Requests whose latency exceeds this "
+             "multiple of the median latency of their measurement window, "
+             "such as the first launch of a JIT compiled or autotuned model, "
+             "are left out of the latency statistics and reported separately. "
+             "They still count in the throughput. Default is 0, which keeps "
+             "all the requests.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --latency-buckets: Breaks the client latencies down by the "
+             "input data stream a request was built from ('stream'), by "
+             "the shapes of its inputs ('shape') or by the model of the "
+             "--model-mix it went to ('model'), and reports the "
+             "throughput and latency percentiles of each bucket. The buckets "
+             "are also written to a 'latency_buckets.' prefixed copy of the "
+             "-f file. Only the requests of the local rank are bucketed when "
+             "running under MPI. Default is 'model' with --model-mix and no "
+             "breakdown otherwise.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --model-mix: Spreads the requests over several models loaded "
+             "in the same server, each getting a share of the requests "
+             "proportional to its weight. The weight defaults to 1. The model "
+             "given with -m is part of the mix with a weight of 1 unless it "
+             "is listed. All the models must take the inputs of the -m model, "
+             "whose statistics are the server side statistics reported. The "
+             "requests of a sequence all go to the same model. Only used with "
+             "the \"triton\" and \"triton_c_api\" service kinds, the C API "
+             "loads all the models in the same server. A model may be given "
+             "the index of a data stream of the --input-data files after "
+             "'@', to which its requests are then sent with, for models "
+             "whose inputs differ in shape or content. The argument may also "
+             "name a workload file listing one model per line in the same "
+             "format, where '#' starts a comment. The latencies of each "
+             "model are reported besides the totals unless "
+             "--latency-buckets says otherwise. "
+             "eg:--model-mix=resnet50=3,densenet:1@2.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --request-classes: Spreads the requests over classes of "
+             "requests, each getting a share of the requests proportional to "
+             "its weight and sent with the priority and the server timeout "
+             "in microseconds of its class. The weight defaults to 1 and a "
+             "priority or timeout of 0 leaves it to the model. The "
+             "throughput, latencies and the requests the server rejected "
+             "for timing out are reported for each class, and written to a "
+             "'request_classes.' prefixed copy of the -f file. A request of "
+             "a class with a timeout that the server rejects for timing out "
+             "is counted rather than failing the run. Only the requests of "
+             "the local rank are reported when running under MPI. Only used "
+             "with the \"triton\" and \"triton_c_api\" service kinds. "
+             "eg:--request-classes=premium:1=1,bulk:2:50000=4.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --baseline: Compares the throughput and latency percentiles of "
+             "each load level with those of a previous run, read from its -f "
+             "CSV file or its --request-record-file. Each difference is "
+             "reported with its 95% confidence interval, bootstrapped from "
+             "the measurement windows and the latencies of the requests. The "
+             "values of a CSV file are taken as exact. perf_analyzer exits "
+             "with status 4 if any metric regressed.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --regression-threshold: The percentage by which the "
+             "throughput must be lower or a latency percentile higher than "
+             "in the --baseline run, over the whole confidence interval, to "
+             "be a regression. Default is 5.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --checkpoint-file: Keeps the results of each load level of "
+             "the sweep in the given file as soon as the level completes. "
+             "If the file holds levels of a sweep that stopped midway, "
+             "e.g. because perf_analyzer or the server crashed, the sweep "
+             "resumes after them once the model is ready again, rather than "
+             "measuring them again. The file is removed once the sweep "
+             "finishes. A file written for another model, batch size or "
+             "kind of load is an error. Not supported with --enable-mpi.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --endpoints: Spreads the requests over several servers serving "
+             "the same model, such as the replicas behind a load balancer, "
+             "instead of sending them all to the -u url. Each context talks "
+             "to every server with a client of its own. The weight defaults "
+             "to 1. The throughput and latencies are reported for each "
+             "server as well as for the whole, along with the server side "
+             "statistics of each server, their sum and how much busier the "
+             "busiest server is than an even share. They are written to an "
+             "'endpoints.' prefixed copy of the -f file. The model is read "
+             "from the first server. Cannot be used with -u or with the "
+             "\"triton_c_api\" service kind. "
+             "eg:--endpoints=replica-0:8001=2,replica-1:8001.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --endpoint-policy: How the requests are spread over the "
+             "--endpoints. \"round_robin\" sends the requests of each context "
+             "to the servers in turn, ignoring the weights. \"affinity\" "
+             "binds each worker thread to one server, the worker threads "
+             "being spread over the servers by weight. \"weighted\" sends "
+             "each request to a server drawn by weight. The requests of a "
+             "sequence always go to the same server, drawn by weight. Default "
+             "is \"round_robin\".",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --input-repeat-ratio: The share of the requests, in [0, 1), "
+             "that repeat an input sent before, to benchmark the response "
+             "cache of the server. The steps of the --input-data are the "
+             "pool of unique inputs, each batch of steps being one input. "
+             "The other requests send the next input never sent, until the "
+             "pool runs out. Repeats are picked by index, so the input data "
+             "is not copied. Does not apply to the requests of sequences. "
+             "Default is 0, which sends the steps in turn.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --input-popularity-skew: The exponent of the Zipf popularity "
+             "of the inputs repeated by --input-repeat-ratio, the first "
+             "input sent being the most popular one. 0 repeats every input "
+             "sent so far as often. Default is 1.",
+             18)
+      << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --batch-size-range: Sweeps the batch sizes from 'start' to "
+             "'end' by 'step' within the run instead of using the -b batch "
+             "size, running the whole concurrency or request rate sweep for "
+             "each batch size. The model, the input data and the client "
+             "backends are kept from one batch size to the next. The results "
+             "of all the batch sizes are reported together, with a batch "
+             "size column in the -f file. 'step' defaults to 1. Cannot be "
+             "used with -b, --baseline, --checkpoint-file, "
+             "--time-series-file, --data-prefetch-steps or "
+             "--input-shape-distribution.",
+             18)
+      << std::endl;
+  exit(GENERIC_ERROR);
+}
+
+void
+CLParser::ParseCommandLine(int argc, char** argv)
+{
+  argc_ = argc;
+  argv_ = argv;
+
+  // {name, has_arg, *flag, val}
+  static struct option long_options[] = {
+      {"streaming", no_argument, 0, 0},
+      {"max-threads", required_argument, 0, 1},
+      {"sequence-length", required_argument, 0, 2},
+      {"percentile", required_argument, 0, 3},
+      {"data-directory", required_argument, 0, 4},
+      {"shape", required_argument, 0, 5},
+      {"measurement-interval", required_argument, 0, 6},
+      {"concurrency-range", required_argument, 0, 7},
+      {"latency-threshold", required_argument, 0, 8},
+      {"stability-percentage", required_argument, 0, 9},
+      {"max-trials", required_argument, 0, 10},
+      {"input-data", required_argument, 0, 11},
+      {"string-length", required_argument, 0, 12},
+      {"string-data", required_argument, 0, 13},
+      {"async", no_argument, 0, 14},
+      {"sync", no_argument, 0, 15},
+      {"request-rate-range", required_argument, 0, 16},
+      {"num-of-sequences", required_argument, 0, 17},
+      {"binary-search", no_argument, 0, 18},
+      {"request-distribution", required_argument, 0, 19},
+      {"request-intervals", required_argument, 0, 20},
+      {"shared-memory", required_argument, 0, 21},
+      {"output-shared-memory-size", required_argument, 0, 22},
+      {"service-kind", required_argument, 0, 23},
+      {"model-signature-name", required_argument, 0, 24},
+      {"grpc-compression-algorithm", required_argument, 0, 25},
+      {"measurement-mode", required_argument, 0, 26},
+      {"measurement-request-count", required_argument, 0, 27},
+      {"triton-server-directory", required_argument, 0, 28},
+      {"model-repository", required_argument, 0, 29},
+      {"sequence-id-range", required_argument, 0, 30},
+      {"ssl-grpc-use-ssl", no_argument, 0, 31},
+      {"ssl-grpc-root-certifications-file", required_argument, 0, 32},
+      {"ssl-grpc-private-key-file", required_argument, 0, 33},
+      {"ssl-grpc-certificate-chain-file", required_argument, 0, 34},
+      {"ssl-https-verify-peer", required_argument, 0, 35},
+      {"ssl-https-verify-host", required_argument, 0, 36},
+      {"ssl-https-ca-certificates-file", required_argument, 0, 37},
+      {"ssl-https-client-certificate-file", required_argument, 0, 38},
+      {"ssl-https-client-certificate-type", required_argument, 0, 39},
+      {"ssl-https-private-key-file", required_argument, 0, 40},
+      {"ssl-https-private-key-type", required_argument, 0, 41},
+      {"verbose-csv", no_argument, 0, 42},
+      {"enable-mpi", no_argument, 0, 43},
+      {"trace-file", required_argument, 0, 44},
+      {"trace-level", required_argument, 0, 45},
+      {"trace-rate", required_argument, 0, 46},
+      {"trace-count", required_argument, 0, 47},
+      {"log-frequency", required_argument, 0, 48},
+      {"collect-metrics", no_argument, 0, 49},
+      {"metrics-url", required_argument, 0, 50},
+      {"metrics-interval", required_argument, 0, 51},
+      {"sequence-length-variation", required_argument, 0, 52},
+      {"precise-scheduling", no_argument, 0, 53},
+      {"dispatcher-threads", required_argument, 0, 54},
+      {"request-trace", required_argument, 0, 55},
+      {"adaptive-search", no_argument, 0, 56},
+      {"early-convergence", no_argument, 0, 57},
+      {"time-series-file", required_argument, 0, 58},
+      {"time-series-interval", required_argument, 0, 59},
+      {"write-input-corpus", required_argument, 0, 60},
+      {"prestage-inputs", no_argument, 0, 61},
+      {"shared-memory-pool-size", required_argument, 0, 62},
+      // 63 is '?', which getopt_long() returns for unknown options
+      {"output-shared-memory-slots", required_argument, 0, 64},
+      {"client-cpus", required_argument, 0, 65},
+      {"worker-cpus", required_argument, 0, 66},
+      {"numa-node", required_argument, 0, 67},
+      {"async-continuations", no_argument, 0, 68},
+      {"warm-ramp", no_argument, 0, 69},
+      {"settle-window", required_argument, 0, 70},
+      {"output-memory", required_argument, 0, 71},
+      // 72 is 'H', the short form of -H
+      {"model-mix", required_argument, 0, 73},
+      {"lazy-model-load", no_argument, 0, 74},
+      {"sequences-per-context", required_argument, 0, 75},
+      {"sequence-length-distribution", required_argument, 0, 76},
+      {"sequence-think-time", required_argument, 0, 77},
+      {"mpi-distributed-load", no_argument, 0, 78},
+      {"mpi-rank-weights", required_argument, 0, 79},
+      {"window-alignment", required_argument, 0, 80},
+      {"window-start-time", required_argument, 0, 81},
+      {"metrics-allowlist", required_argument, 0, 82},
+      {"request-template", required_argument, 0, 83},
+      {"request-record-file", required_argument, 0, 84},
+      {"client-stage-times", no_argument, 0, 85},
+      {"shared-memory-huge-pages", no_argument, 0, 86},
+      {"shared-memory-prefault", no_argument, 0, 87},
+      {"null-server", required_argument, 0, 88},
+      {"warmup-request-count", required_argument, 0, 89},
+      {"latency-outlier-factor", required_argument, 0, 90},
+      {"latency-buckets", required_argument, 0, 91},
+      {"input-shape-distribution", required_argument, 0, 92},
+      {"input-shape-count", required_argument, 0, 93},
+      {"experiment-file", required_argument, 0, 94},
+      {"model-config-cache", required_argument, 0, 95},
+      {"client-trace-file", required_argument, 0, 96},
+      // 97 to 122 are the values of the short options
+      {"client-trace-rate", required_argument, 0, 123},
+      {"max-inflight-requests", required_argument, 0, 124},
+      {"inflight-overload", required_argument, 0, 125},
+      {"server-request-trace", no_argument, 0, 126},
+      {"data-prefetch-steps", required_argument, 0, 127},
+      {"http-compression-algorithm", required_argument, 0, 128},
+      {"output-tolerance", required_argument, 0, 129},
+      {"validation-threads", required_argument, 0, 130},
+      {"model-load-iterations", required_argument, 0, 131},
+      {"model-load-config", required_argument, 0, 132},
+      {"request-classes", required_argument, 0, 133},
+      {"baseline", required_argument, 0, 134},
+      {"regression-threshold", required_argument, 0, 135},
+      {"checkpoint-file", required_argument, 0, 136},
+      {"endpoints", required_argument, 0, 137},
+      {"endpoint-policy", required_argument, 0, 138},
+      {"input-repeat-ratio", required_argument, 0, 139},
+      {"input-popularity-skew", required_argument, 0, 140},
+      {"batch-size-range", required_argument, 0, 141},
+      {"shared-memory-persist", no_argument, 0, 142},
+      {"schedule-record-file", required_argument, 0, 143},
+      {"schedule-replay-file", required_argument, 0, 144},
+      {"client-network", required_argument, 0, 145},
+      {"client-connections", required_argument, 0, 146},
+      {"capacity-search", no_argument, 0, 147},
+      {"share-nothing", no_argument, 0, 148},
+      {"schedule-plugin", required_argument, 0, 149},
+      {"schedule-plugin-config", required_argument, 0, 150},
+      {"tfserving-client", required_argument, 0, 151},
+      {"slowest-requests", required_argument, 0, 152},
+      {"http-streaming-endpoint", required_argument, 0, 153},
+      {0, 0, 0, 0}};
+
+  // Parse commandline...
+  int opt;
+  while ((opt = getopt_long(
+              argc, argv, "vdazc:u:m:x:b:t:p:i:H:l:r:s:f:", long_options,
+              NULL)) != -1) {
+    switch (opt) {
+      case 0:
+        params_->streaming = true;
+        break;
+      case 1:
+        if (std::string(optarg) == "auto") {
+          params_->auto_max_threads = true;
+        } else {
+          params_->max_threads = std::atoi(optarg);
+          params_->max_threads_specified = true;
+        }
+        break;
+      case 2:
+        params_->sequence_length = std::atoi(optarg);
+        params_->sequence_length_specified = true;
+        break;
+      case 3:
+        params_->percentile = std::atoi(optarg);
+        break;
+      case 4:
+        params_->user_data.push_back(optarg);
+        break;
+      case 5: {
+        std::string arg = optarg;
+        auto colon_pos = arg.rfind(":");
+        if (colon_pos == std::string::npos) {
+          Usage(
+              "failed to parse input shape. There must be a colon after input "
+              "name.");
+        }
+        std::string name = arg.substr(0, colon_pos);
+        std::string shape_str = arg.substr(name.size() + 1);
+        size_t pos = 0;
+        std::vector<int64_t> shape;
+        try {
+          while (pos != std::string::npos) {
+            size_t comma_pos = shape_str.find(",", pos);
+            int64_t dim;
+            if (comma_pos == std::string::npos) {
+              dim = std::stoll(shape_str.substr(pos, comma_pos));
+              pos = comma_pos;
+            } else {
+              dim = std::stoll(shape_str.substr(pos, comma_pos - pos));
               pos = comma_pos + 1;
             }
             if (dim <= 0) {
@@ -930,16 +1963,7 @@ CLParser::ParseCommandLine(int argc, char** argv)
         break;
       }
       case 19: {
-        std::string arg = optarg;
-        if (arg.compare("poisson") == 0) {
-          params_->request_distribution = Distribution::POISSON;
-        } else if (arg.compare("constant") == 0) {
-          params_->request_distribution = Distribution::CONSTANT;
-        } else {
-          Usage(
-              "unsupported request distribution provided " +
-              std::string(optarg));
-        }
+        ParseRequestDistribution(optarg);
         break;
       }
       case 20:
@@ -980,6 +2004,10 @@ CLParser::ParseCommandLine(int argc, char** argv)
           params_->kind = cb::TORCHSERVE;
         } else if (arg.compare("triton_c_api") == 0) {
           params_->kind = cb::TRITON_C_API;
+        } else if (arg.compare("http_json") == 0) {
+          params_->kind = cb::HTTP_JSON;
+        } else if (arg.compare("null_server") == 0) {
+          params_->kind = cb::NULL_SERVER;
         } else {
           Usage("unsupported --service-kind specified");
         }
@@ -997,6 +2025,8 @@ CLParser::ParseCommandLine(int argc, char** argv)
           params_->compression_algorithm = cb::COMPRESS_DEFLATE;
         } else if (arg.compare("gzip") == 0) {
           params_->compression_algorithm = cb::COMPRESS_GZIP;
+        } else if (arg.compare("adaptive") == 0) {
+          params_->compression_algorithm = cb::COMPRESS_ADAPTIVE;
         } else {
           Usage("unsupported --grpc-compression-algorithm specified");
         }
@@ -1193,12 +2223,470 @@ CLParser::ParseCommandLine(int argc, char** argv)
         params_->sequence_length_variation = std::stod(optarg);
         break;
       }
-      case 'v':
-        params_->extra_verbose = params_->verbose;
-        params_->verbose = true;
+      case 53: {
+        params_->precise_scheduling = true;
         break;
-      case 'z':
-        params_->zero_input = true;
+      }
+      case 54: {
+        params_->num_dispatcher_threads = std::stoull(optarg);
+        break;
+      }
+      case 55: {
+        params_->using_custom_intervals = true;
+        params_->request_trace_file = optarg;
+        break;
+      }
+      case 56: {
+        params_->search_mode = SearchMode::ADAPTIVE;
+        break;
+      }
+      case 57: {
+        params_->early_convergence = true;
+        break;
+      }
+      case 58: {
+        params_->time_series_file = optarg;
+        break;
+      }
+      case 59: {
+        params_->time_series_interval_ms = std::stoull(optarg);
+        break;
+      }
+      case 60: {
+        params_->input_corpus_file = optarg;
+        break;
+      }
+      case 61: {
+        params_->prestage_inputs = true;
+        break;
+      }
+      case 62: {
+        params_->shm_pool_size = std::stoull(optarg);
+        break;
+      }
+      case 64: {
+        params_->output_shm_slots = std::stoull(optarg);
+        break;
+      }
+      case 65: {
+        cb::Error err = ParseCpuList(optarg, &params_->client_cpus);
+        if (!err.IsOk()) {
+          Usage("failed to parse --client-cpus: " + err.Message());
+        }
+        break;
+      }
+      case 66: {
+        cb::Error err = ParseCpuList(optarg, &params_->worker_cpus);
+        if (!err.IsOk()) {
+          Usage("failed to parse --worker-cpus: " + err.Message());
+        }
+        break;
+      }
+      case 67: {
+        params_->numa_node = std::stoi(optarg);
+        if (params_->numa_node < 0) {
+          Usage("--numa-node must be >= 0");
+        }
+        break;
+      }
+      case 68: {
+        params_->async_continuations = true;
+        break;
+      }
+      case 69: {
+        params_->warm_ramp = true;
+        break;
+      }
+      case 70: {
+        params_->settle_window_ms = std::stoull(optarg);
+        break;
+      }
+      case 71: {
+        ParseOutputMemory(optarg);
+        break;
+      }
+      case 73: {
+        cb::Error err = IsFile(optarg)
+                            ? ReadModelMixFile(optarg, &params_->model_mix)
+                            : ParseModelMix(optarg, &params_->model_mix);
+        if (!err.IsOk()) {
+          Usage("failed to parse --model-mix: " + err.Message());
+        }
+        break;
+      }
+      case 74: {
+        params_->lazy_model_load = true;
+        break;
+      }
+      case 75: {
+        int64_t sequences = std::stoll(optarg);
+        if (sequences < 1) {
+          Usage("--sequences-per-context must be > 0");
+        }
+        params_->sequences_per_context = sequences;
+        break;
+      }
+      case 76: {
+        cb::Error err = ParseSequenceDistribution(
+            optarg, &params_->sequence_length_distribution);
+        if (!err.IsOk()) {
+          Usage(
+              "failed to parse --sequence-length-distribution: " +
+              err.Message());
+        }
+        break;
+      }
+      case 77: {
+        cb::Error err =
+            ParseSequenceDistribution(optarg, &params_->sequence_think_time);
+        if (!err.IsOk()) {
+          Usage("failed to parse --sequence-think-time: " + err.Message());
+        }
+        params_->using_sequence_think_time = true;
+        break;
+      }
+      case 78: {
+        params_->mpi_distributed_load = true;
+        break;
+      }
+      case 79: {
+        cb::Error err = ParseRankWeights(optarg, &params_->mpi_rank_weights);
+        if (!err.IsOk()) {
+          Usage("failed to parse --mpi-rank-weights: " + err.Message());
+        }
+        break;
+      }
+      case 80: {
+        params_->window_alignment_ms = std::stoull(optarg);
+        break;
+      }
+      case 81: {
+        params_->window_start_time = std::stod(optarg);
+        if (params_->window_start_time < 0) {
+          Usage("--window-start-time cannot be negative.");
+        }
+        break;
+      }
+      case 82: {
+        params_->metrics_allowlist.clear();
+        std::stringstream families(optarg);
+        std::string family;
+        while (std::getline(families, family, ',')) {
+          if (!family.empty()) {
+            params_->metrics_allowlist.push_back(family);
+          }
+        }
+        params_->metrics_allowlist_specified = true;
+        break;
+      }
+      case 83: {
+        params_->request_template = optarg;
+        break;
+      }
+      case 84: {
+        params_->request_record_file = optarg;
+        break;
+      }
+      case 85: {
+        params_->client_stage_times = true;
+        break;
+      }
+      case 86: {
+        params_->shm_huge_pages = true;
+        break;
+      }
+      case 87: {
+        params_->shm_prefault = true;
+        break;
+      }
+      case 88: {
+        ParseNullServerOptions(optarg);
+        break;
+      }
+      case 89: {
+        params_->warmup_request_count = std::stoull(optarg);
+        break;
+      }
+      case 90: {
+        params_->latency_outlier_factor = std::stod(optarg);
+        if (params_->latency_outlier_factor != 0 &&
+            params_->latency_outlier_factor <= 1) {
+          Usage("--latency-outlier-factor must be 0 or greater than 1.");
+        }
+        break;
+      }
+      case 91: {
+        std::string arg = optarg;
+        if (arg == "stream") {
+          params_->latency_bucketing = BUCKET_DATA_STREAM;
+        } else if (arg == "shape") {
+          params_->latency_bucketing = BUCKET_INPUT_SHAPE;
+        } else if (arg == "model") {
+          params_->latency_bucketing = BUCKET_MODEL;
+        } else {
+          Usage("--latency-buckets must be 'stream', 'shape' or 'model'.");
+        }
+        break;
+      }
+      case 92: {
+        ShapeDistributionSettings distribution;
+        cb::Error err = ParseShapeDistribution(optarg, &distribution);
+        if (!err.IsOk()) {
+          Usage(
+              "failed to parse --input-shape-distribution: " + err.Message());
+        }
+        params_->input_shape_distributions.push_back(distribution);
+        break;
+      }
+      case 93: {
+        params_->input_shape_count = std::stoull(optarg);
+        if (params_->input_shape_count == 0) {
+          Usage("--input-shape-count must be greater than 0.");
+        }
+        break;
+      }
+      case 94: {
+        params_->experiment_file = optarg;
+        break;
+      }
+      case 95: {
+        params_->model_config_cache = optarg;
+        break;
+      }
+      case 96: {
+        params_->client_trace_file = optarg;
+        break;
+      }
+      case 123: {
+        params_->client_trace_rate = std::stoull(optarg);
+        if (params_->client_trace_rate == 0) {
+          Usage("--client-trace-rate must be greater than 0.");
+        }
+        break;
+      }
+      case 124: {
+        params_->max_inflight_requests = std::stoull(optarg);
+        break;
+      }
+      case 125: {
+        std::string arg = optarg;
+        if (arg == "drop") {
+          params_->inflight_overload = OVERLOAD_DROP;
+        } else if (arg == "queue") {
+          params_->inflight_overload = OVERLOAD_QUEUE;
+        } else {
+          Usage("--inflight-overload must be 'drop' or 'queue'.");
+        }
+        break;
+      }
+      case 126: {
+        params_->server_request_trace = true;
+        break;
+      }
+      case 127: {
+        params_->data_prefetch_steps = std::stoull(optarg);
+        break;
+      }
+      case 128: {
+        params_->using_http_compression = true;
+        std::string arg = optarg;
+        if (arg.compare("none") == 0) {
+          params_->compression_algorithm = cb::COMPRESS_NONE;
+        } else if (arg.compare("deflate") == 0) {
+          params_->compression_algorithm = cb::COMPRESS_DEFLATE;
+        } else if (arg.compare("gzip") == 0) {
+          params_->compression_algorithm = cb::COMPRESS_GZIP;
+        } else {
+          Usage("unsupported --http-compression-algorithm specified");
+        }
+        break;
+      }
+      case 129: {
+        std::string arg = optarg;
+        size_t comma_pos = arg.find(',');
+        params_->output_tolerance_absolute =
+            std::stod(arg.substr(0, comma_pos));
+        if (comma_pos != std::string::npos) {
+          params_->output_tolerance_relative =
+              std::stod(arg.substr(comma_pos + 1));
+        }
+        if ((params_->output_tolerance_absolute < 0) ||
+            (params_->output_tolerance_relative < 0)) {
+          Usage("--output-tolerance must not be negative.");
+        }
+        break;
+      }
+      case 130: {
+        params_->validation_threads = std::stoull(optarg);
+        break;
+      }
+      case 131: {
+        params_->model_load_iterations = std::stoull(optarg);
+        break;
+      }
+      case 132: {
+        params_->model_load_config_file = optarg;
+        break;
+      }
+      case 133: {
+        cb::Error err = ParseRequestClasses(optarg, &params_->request_classes);
+        if (!err.IsOk()) {
+          Usage("failed to parse --request-classes: " + err.Message());
+        }
+        break;
+      }
+      case 134: {
+        params_->baseline_file = optarg;
+        break;
+      }
+      case 135: {
+        params_->regression_threshold = std::stod(optarg);
+        if (params_->regression_threshold < 0) {
+          Usage("--regression-threshold must not be negative.");
+        }
+        break;
+      }
+      case 136: {
+        params_->checkpoint_file = optarg;
+        break;
+      }
+      case 137: {
+        cb::Error err = ParseEndpoints(optarg, &params_->endpoints);
+        if (!err.IsOk()) {
+          Usage("failed to parse --endpoints: " + err.Message());
+        }
+        break;
+      }
+      case 138: {
+        std::string arg = optarg;
+        if (arg == "round_robin") {
+          params_->endpoint_policy = ENDPOINT_ROUND_ROBIN;
+        } else if (arg == "affinity") {
+          params_->endpoint_policy = ENDPOINT_AFFINITY;
+        } else if (arg == "weighted") {
+          params_->endpoint_policy = ENDPOINT_WEIGHTED;
+        } else {
+          Usage(
+              "--endpoint-policy must be 'round_robin', 'affinity' or "
+              "'weighted'.");
+        }
+        break;
+      }
+      case 139: {
+        params_->input_repeat_ratio = std::stod(optarg);
+        if ((params_->input_repeat_ratio < 0) ||
+            (params_->input_repeat_ratio >= 1)) {
+          Usage("--input-repeat-ratio must be in [0, 1).");
+        }
+        break;
+      }
+      case 140: {
+        params_->input_popularity_skew = std::stod(optarg);
+        if (params_->input_popularity_skew < 0) {
+          Usage("--input-popularity-skew must not be negative.");
+        }
+        break;
+      }
+      case 141: {
+        std::vector<uint64_t> values;
+        std::stringstream range(optarg);
+        std::string value;
+        try {
+          while (std::getline(range, value, ':')) {
+            values.push_back(std::stoull(value));
+          }
+        }
+        catch (const std::exception&) {
+          values.clear();
+        }
+        if ((values.size() < 2) || (values.size() > 3)) {
+          Usage(
+              "failed to parse --batch-size-range: " + std::string(optarg));
+        }
+        params_->batch_size_range.start = values[0];
+        params_->batch_size_range.end = values[1];
+        params_->batch_size_range.step = (values.size() == 3) ? values[2] : 1;
+        if ((params_->batch_size_range.start == 0) ||
+            (params_->batch_size_range.end < params_->batch_size_range.start) ||
+            (params_->batch_size_range.step == 0) ||
+            (params_->batch_size_range.end > INT32_MAX)) {
+          Usage(
+              "--batch-size-range must have 0 < start <= end and step > "
+              "0.");
+        }
+        params_->using_batch_size_range = true;
+        params_->batch_size = params_->batch_size_range.start;
+        break;
+      }
+      case 142: {
+        params_->shm_persist = true;
+        break;
+      }
+      case 143: {
+        params_->schedule_record_file = optarg;
+        break;
+      }
+      case 144: {
+        params_->using_custom_intervals = true;
+        params_->schedule_replay_file = optarg;
+        break;
+      }
+      case 145: {
+        ParseClientNetworkOptions(optarg);
+        break;
+      }
+      case 146: {
+        int64_t connections = std::stoll(optarg);
+        if (connections < 1) {
+          Usage("--client-connections must be > 0");
+        }
+        params_->client_connections = connections;
+        break;
+      }
+      case 147: {
+        params_->search_mode = SearchMode::CAPACITY;
+        break;
+      }
+      case 148: {
+        params_->share_nothing = true;
+        break;
+      }
+      case 149: {
+        params_->schedule_plugin = optarg;
+        break;
+      }
+      case 150: {
+        params_->schedule_plugin_config = optarg;
+        break;
+      }
+      case 151: {
+        ParseTfServingOptions(optarg);
+        break;
+      }
+      case 152: {
+        int64_t count = std::stoll(optarg);
+        if (count < 1) {
+          Usage("--slowest-requests must be > 0");
+        }
+        params_->slowest_request_count = count;
+        break;
+      }
+      case 153: {
+        std::string endpoint{optarg};
+        if (endpoint != "generate_stream") {
+          Usage(
+              "unsupported --http-streaming-endpoint '" + endpoint +
+              "', the only supported endpoint is generate_stream");
+        }
+        params_->http_streaming_endpoint = endpoint;
+        break;
+      }
+      case 'v':
+        params_->extra_verbose = params_->verbose;
+        params_->verbose = true;
+        break;
+      case 'z':
+        params_->zero_input = true;
         break;
       case 'd':
         params_->using_old_options = true;
@@ -1263,6 +2751,15 @@ CLParser::ParseCommandLine(int argc, char** argv)
       std::make_shared<triton::perfanalyzer::MPIDriver>(params_->enable_mpi)};
   params_->mpi_driver->MPIInit(&argc, &argv);
 
+  if (!params_->endpoints.empty()) {
+    if (params_->url_specified) {
+      Usage("Cannot specify both -u and --endpoints.");
+    }
+    // The model and the server extensions are read from the first endpoint
+    params_->url = params_->endpoints.front().url;
+    params_->url_specified = true;
+  }
+
   if (!params_->url_specified &&
       (params_->protocol == cb::ProtocolType::GRPC)) {
     if (params_->kind == cb::BackendKind::TRITON) {
@@ -1277,15 +2774,262 @@ CLParser::ParseCommandLine(int argc, char** argv)
     params_->max_threads = 16;
   }
 
+  // Without sharing, a thread per CPU the load is generated on
+  if (params_->share_nothing && !params_->max_threads_specified &&
+      !params_->auto_max_threads) {
+    std::vector<int> cpus(params_->worker_cpus);
+    if (cpus.empty()) {
+      cpus = params_->client_cpus;
+    }
+    if (!cpus.empty() || ProcessCpus(&cpus).IsOk()) {
+      params_->max_threads = cpus.size();
+    }
+  }
+
   if (params_->using_custom_intervals) {
     // Will be using user-provided time intervals, hence no control variable.
     params_->search_mode = SearchMode::NONE;
   }
 }
 
+void
+CLParser::ParseRequestDistribution(const std::string& arg)
+{
+  const size_t settings_start = arg.find(':');
+  const std::string name = arg.substr(0, settings_start);
+  if (name.compare("poisson") == 0) {
+    params_->request_distribution = Distribution::POISSON;
+  } else if (name.compare("constant") == 0) {
+    params_->request_distribution = Distribution::CONSTANT;
+  } else if (name.compare("bursty") == 0) {
+    params_->request_distribution = Distribution::BURSTY;
+  } else if (name.compare("mmpp") == 0) {
+    params_->request_distribution = Distribution::MMPP;
+  } else if (name.compare("diurnal") == 0) {
+    params_->request_distribution = Distribution::DIURNAL;
+  } else {
+    Usage("unsupported request distribution provided " + arg);
+    return;
+  }
+  if (settings_start == std::string::npos) {
+    return;
+  }
+
+  RateProfileSettings& settings = params_->rate_profile_settings;
+  std::stringstream settings_stream(arg.substr(settings_start + 1));
+  std::string setting;
+  while (std::getline(settings_stream, setting, ',')) {
+    const size_t separator = setting.find('=');
+    const std::string key = setting.substr(0, separator);
+    double* value = nullptr;
+    if (params_->request_distribution == Distribution::BURSTY) {
+      if (key.compare("on_ms") == 0) {
+        value = &settings.burst_on_ms;
+      } else if (key.compare("off_ms") == 0) {
+        value = &settings.burst_off_ms;
+      }
+    } else if (params_->request_distribution == Distribution::MMPP) {
+      if (key.compare("burst_factor") == 0) {
+        value = &settings.mmpp_burst_factor;
+      } else if (key.compare("low_ms") == 0) {
+        value = &settings.mmpp_low_ms;
+      } else if (key.compare("high_ms") == 0) {
+        value = &settings.mmpp_high_ms;
+      }
+    } else if (params_->request_distribution == Distribution::DIURNAL) {
+      if (key.compare("period_s") == 0) {
+        value = &settings.diurnal_period_s;
+      } else if (key.compare("amplitude") == 0) {
+        value = &settings.diurnal_amplitude;
+      }
+    }
+    if ((value == nullptr) || (separator == std::string::npos)) {
+      Usage(
+          "unsupported setting '" + setting + "' for request distribution " +
+          name);
+      return;
+    }
+    *value = std::stod(setting.substr(separator + 1));
+  }
+
+  if ((settings.burst_on_ms <= 0) || (settings.burst_off_ms < 0) ||
+      (settings.mmpp_burst_factor < 1) || (settings.mmpp_low_ms <= 0) ||
+      (settings.mmpp_high_ms <= 0) || (settings.diurnal_period_s <= 0) ||
+      (settings.diurnal_amplitude < 0) || (settings.diurnal_amplitude > 1)) {
+    Usage("invalid settings for request distribution " + name);
+  }
+}
+
+void
+CLParser::ParseNullServerOptions(const std::string& arg)
+{
+  cb::NullServerOptions& options = params_->null_server_options;
+  std::stringstream settings_stream(arg);
+  std::string setting;
+  while (std::getline(settings_stream, setting, ',')) {
+    const size_t separator = setting.find('=');
+    const std::string key = setting.substr(0, separator);
+    if (separator == std::string::npos) {
+      Usage("unsupported setting '" + setting + "' for --null-server");
+      return;
+    }
+    int64_t value;
+    try {
+      value = std::stoll(setting.substr(separator + 1));
+    }
+    catch (const std::exception&) {
+      Usage("invalid value in setting '" + setting + "' for --null-server");
+      return;
+    }
+    if (value < 0) {
+      Usage("invalid value in setting '" + setting + "' for --null-server");
+      return;
+    }
+    if (key.compare("latency_us") == 0) {
+      options.latency_us = value;
+    } else if (key.compare("max_batch_size") == 0) {
+      options.max_batch_size = value;
+    } else if (key.compare("batch_delay_us") == 0) {
+      options.batch_delay_us = value;
+    } else if (key.compare("instance_count") == 0) {
+      options.instance_count = value;
+    } else {
+      Usage("unsupported setting '" + setting + "' for --null-server");
+      return;
+    }
+  }
+}
+
+void
+CLParser::ParseTfServingOptions(const std::string& arg)
+{
+  cb::TfServingOptions& options = params_->tfserving_options;
+  std::stringstream settings_stream(arg);
+  std::string setting;
+  while (std::getline(settings_stream, setting, ',')) {
+    const size_t separator = setting.find('=');
+    const std::string key = setting.substr(0, separator);
+    if (separator == std::string::npos) {
+      Usage("unsupported setting '" + setting + "' for --tfserving-client");
+      return;
+    }
+    int64_t value;
+    try {
+      value = std::stoll(setting.substr(separator + 1));
+    }
+    catch (const std::exception&) {
+      Usage(
+          "invalid value in setting '" + setting + "' for --tfserving-client");
+      return;
+    }
+    if (value < 0) {
+      Usage(
+          "invalid value in setting '" + setting + "' for --tfserving-client");
+      return;
+    }
+    if (key.compare("completion_queues") == 0) {
+      options.completion_queue_count = value;
+    } else if (key.compare("channels") == 0) {
+      options.channel_count = value;
+    } else {
+      Usage("unsupported setting '" + setting + "' for --tfserving-client");
+      return;
+    }
+  }
+}
+
+void
+CLParser::ParseClientNetworkOptions(const std::string& arg)
+{
+  std::stringstream settings_stream(arg);
+  std::string setting;
+  while (std::getline(settings_stream, setting, ',')) {
+    const size_t separator = setting.find('=');
+    const std::string key = setting.substr(0, separator);
+    if (separator == std::string::npos) {
+      Usage("unsupported setting '" + setting + "' for --client-network");
+      return;
+    }
+    int64_t value;
+    try {
+      value = std::stoll(setting.substr(separator + 1));
+    }
+    catch (const std::exception&) {
+      Usage(
+          "invalid value in setting '" + setting + "' for --client-network");
+      return;
+    }
+    if (value < 0) {
+      Usage(
+          "invalid value in setting '" + setting + "' for --client-network");
+      return;
+    }
+    if (key.compare("upload_bytes_per_sec") == 0) {
+      params_->transfer_rate_limits.send_bytes_per_sec = value;
+    } else if (key.compare("download_bytes_per_sec") == 0) {
+      params_->transfer_rate_limits.recv_bytes_per_sec = value;
+    } else if (key.compare("send_delay_us") == 0) {
+      params_->client_send_delay_us = value;
+    } else {
+      Usage("unsupported setting '" + setting + "' for --client-network");
+      return;
+    }
+  }
+}
+
+void
+CLParser::ParseOutputMemory(const std::string& arg)
+{
+  const size_t device_start = arg.find(':');
+  const std::string name = arg.substr(0, device_start);
+  cb::OutputMemoryPolicy& policy = params_->output_memory_policy;
+  if (name.compare("cpu") == 0) {
+    policy.kind = cb::OUTPUT_MEMORY_CPU;
+  } else if (name.compare("cpu_pinned") == 0) {
+    policy.kind = cb::OUTPUT_MEMORY_CPU_PINNED;
+  } else if (name.compare("gpu") == 0) {
+    policy.kind = cb::OUTPUT_MEMORY_GPU;
+  } else if (name.compare("preferred") == 0) {
+    policy.kind = cb::OUTPUT_MEMORY_PREFERRED;
+  } else {
+    Usage(
+        "unsupported --output-memory type provided: '" + arg +
+        "'. Choices are 'cpu', 'cpu_pinned', 'gpu[:<device id>]' or "
+        "'preferred'.");
+    return;
+  }
+#ifndef TRITON_ENABLE_GPU
+  if ((policy.kind == cb::OUTPUT_MEMORY_CPU_PINNED) ||
+      (policy.kind == cb::OUTPUT_MEMORY_GPU)) {
+    Usage(
+        "--output-memory=" + name +
+        " is not supported when TRITON_ENABLE_GPU=0");
+    return;
+  }
+#endif  // TRITON_ENABLE_GPU
+  if (device_start == std::string::npos) {
+    return;
+  }
+  if (policy.kind != cb::OUTPUT_MEMORY_GPU) {
+    Usage("only --output-memory=gpu takes a device id: '" + arg + "'.");
+    return;
+  }
+  const std::string device = arg.substr(device_start + 1);
+  if (device.empty() ||
+      (device.find_first_not_of("0123456789") != std::string::npos)) {
+    Usage("invalid device id for --output-memory: '" + arg + "'.");
+    return;
+  }
+  policy.device_id = std::stoll(device);
+}
+
 void
 CLParser::VerifyOptions()
 {
+  // The options are verified for each configuration of the experiment
+  if (!params_->experiment_file.empty()) {
+    return;
+  }
   if (params_->model_name.empty()) {
     Usage("-m flag must be specified");
   }
@@ -1308,13 +3052,38 @@ CLParser::VerifyOptions()
   if (params_->protocol == cb::ProtocolType::UNKNOWN) {
     Usage("protocol should be either HTTP or gRPC");
   }
-  if (params_->streaming && (params_->protocol != cb::ProtocolType::GRPC)) {
+  if (params_->streaming && (params_->protocol != cb::ProtocolType::GRPC) &&
+      (params_->kind != cb::BackendKind::TRITON_C_API) &&
+      params_->http_streaming_endpoint.empty()) {
     Usage("streaming is only allowed with gRPC protocol");
   }
+  if (!params_->http_streaming_endpoint.empty()) {
+    if (!params_->streaming) {
+      Usage("--http-streaming-endpoint requires --streaming");
+    }
+    if ((params_->protocol != cb::ProtocolType::HTTP) ||
+        (params_->kind != cb::BackendKind::TRITON)) {
+      Usage(
+          "--http-streaming-endpoint only applies to HTTP protocol with "
+          "service-kind=triton");
+    }
+    if (params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+      Usage(
+          "--http-streaming-endpoint does not support --shared-memory, the "
+          "inputs are sent as JSON values");
+    }
+  }
   if (params_->using_grpc_compression &&
       (params_->protocol != cb::ProtocolType::GRPC)) {
     Usage("compression is only allowed with gRPC protocol");
   }
+  if (params_->using_http_compression &&
+      ((params_->protocol != cb::ProtocolType::HTTP) ||
+       (params_->kind != cb::BackendKind::TRITON))) {
+    Usage(
+        "--http-compression-algorithm is only allowed with the triton "
+        "service kind and the HTTP protocol");
+  }
   if (params_->max_threads == 0) {
     Usage("maximum number of threads must be > 0");
   }
@@ -1340,6 +3109,12 @@ CLParser::VerifyOptions()
   if (params_->zero_input && !params_->user_data.empty()) {
     Usage("zero input can't be set when data directory is provided");
   }
+  if (!params_->input_shape_distributions.empty() &&
+      !params_->user_data.empty()) {
+    Usage(
+        "--input-shape-distribution only applies to generated data, not to "
+        "--input-data files.");
+  }
   if (params_->async && params_->forced_sync) {
     Usage("Both --async and --sync can not be specified simultaneously.");
   }
@@ -1364,6 +3139,7 @@ CLParser::VerifyOptions()
   }
 
   if (params_->using_request_rate_range && params_->mpi_driver->IsMPIRun() &&
+      !params_->mpi_distributed_load &&
       (params_->request_rate_range[SEARCH_RANGE::kEND] != 1.0 ||
        params_->request_rate_range[SEARCH_RANGE::kSTEP] != 1.0)) {
     Usage("cannot use request rate range with multi-model mode");
@@ -1373,6 +3149,45 @@ CLParser::VerifyOptions()
     Usage("can not use deprecated options with --request-intervals");
   }
 
+  if (!params_->request_intervals_file.empty() &&
+      !params_->request_trace_file.empty()) {
+    Usage("can not use --request-intervals along with --request-trace");
+  }
+
+  if (!params_->schedule_plugin.empty() &&
+      !params_->using_request_rate_range) {
+    Usage("--schedule-plugin only applies to --request-rate-range.");
+  }
+
+  if (!params_->schedule_plugin_config.empty() &&
+      params_->schedule_plugin.empty()) {
+    Usage("--schedule-plugin-config requires --schedule-plugin.");
+  }
+
+  if (!params_->schedule_replay_file.empty() &&
+      (!params_->request_intervals_file.empty() ||
+       !params_->request_trace_file.empty())) {
+    Usage(
+        "can not use --schedule-replay-file along with --request-intervals "
+        "or --request-trace");
+  }
+
+  if (((params_->transfer_rate_limits.send_bytes_per_sec != 0) ||
+       (params_->transfer_rate_limits.recv_bytes_per_sec != 0)) &&
+      ((params_->kind != cb::BackendKind::TRITON) ||
+       (params_->protocol != cb::ProtocolType::HTTP))) {
+    Usage(
+        "the upload and download rates of --client-network are only "
+        "allowed with the triton service kind and the HTTP protocol");
+  }
+
+  if (!params_->schedule_record_file.empty() &&
+      params_->targeting_concurrency()) {
+    Usage(
+        "--schedule-record-file only applies to --request-rate-range, "
+        "--request-intervals, --request-trace and --schedule-replay-file.");
+  }
+
   if ((params_->using_custom_intervals) &&
       (params_->using_request_rate_range || params_->using_concurrency_range)) {
     Usage(
@@ -1381,15 +3196,18 @@ CLParser::VerifyOptions()
   }
 
   if (params_->using_concurrency_range && params_->mpi_driver->IsMPIRun() &&
+      !params_->mpi_distributed_load &&
       (params_->concurrency_range.end != 1 ||
        params_->concurrency_range.step != 1)) {
     Usage("cannot use concurrency range with multi-model mode");
   }
 
+  // The capacity search stops on its own, when its model settles
   if (((params_->concurrency_range.end == NO_LIMIT) ||
        (params_->request_rate_range[SEARCH_RANGE::kEND] ==
         static_cast<double>(NO_LIMIT))) &&
-      (params_->latency_threshold_ms == NO_LIMIT)) {
+      (params_->latency_threshold_ms == NO_LIMIT) &&
+      (params_->search_mode != SearchMode::CAPACITY)) {
     Usage(
         "The end of the search range and the latency limit can not be both 0 "
         "(or 0.0) simultaneously");
@@ -1407,6 +3225,11 @@ CLParser::VerifyOptions()
     Usage("The latency threshold can not be 0 for binary search mode.");
   }
 
+  if ((params_->search_mode == SearchMode::ADAPTIVE) &&
+      (params_->latency_threshold_ms == NO_LIMIT)) {
+    Usage("The latency threshold can not be 0 for adaptive search mode.");
+  }
+
   if (((params_->concurrency_range.end < params_->concurrency_range.start) ||
        (params_->request_rate_range[SEARCH_RANGE::kEND] <
         params_->request_rate_range[SEARCH_RANGE::kSTART])) &&
@@ -1433,6 +3256,16 @@ CLParser::VerifyOptions()
           "--input-data should be provided with a json file with "
           "input data for torchserve");
     }
+  } else if (params_->kind == cb::HTTP_JSON) {
+    if (params_->request_template.empty()) {
+      Usage(
+          "--request-template should be provided when using "
+          "service-kind=http_json.");
+    } else if (params_->protocol != cb::ProtocolType::HTTP) {
+      Usage("perf_analyzer supports only http protocol for HTTP JSON.");
+    } else if (params_->streaming) {
+      Usage("perf_analyzer does not support streaming for HTTP JSON.");
+    }
   }
 
   if (params_->kind == cb::BackendKind::TRITON_C_API) {
@@ -1448,12 +3281,6 @@ CLParser::VerifyOptions()
           "service-kind=triton_c_api.");
     }
 
-    if (params_->async) {
-      Usage(
-          "Async mode is not supported by triton_c_api service "
-          "kind.");
-    }
-
     params_->protocol = cb::ProtocolType::UNKNOWN;
   }
 
@@ -1477,9 +3304,277 @@ CLParser::VerifyOptions()
         "option.");
   }
 
+  if (params_->metrics_allowlist_specified &&
+      params_->should_collect_metrics == false) {
+    Usage(
+        "Must specify --collect-metrics when using the --metrics-allowlist "
+        "option.");
+  }
+
   if (params_->metrics_interval_ms == 0) {
     Usage("Metrics interval must be larger than 0 milliseconds.");
   }
+
+  if (params_->time_series_interval_ms == 0) {
+    Usage("Time series interval must be larger than 0 milliseconds.");
+  }
+
+  if (!params_->input_corpus_file.empty() && params_->user_data.empty()) {
+    Usage(
+        "Must specify --input-data with a directory or json file when using "
+        "the --write-input-corpus option.");
+  }
+
+  if (params_->prestage_inputs &&
+      params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+    Usage("Cannot use --prestage-inputs with --shared-memory.");
+  }
+
+  if (params_->data_prefetch_steps != 0) {
+    if (params_->user_data.size() != 1) {
+      Usage(
+          "Must specify --input-data with a single directory when using "
+          "the --data-prefetch-steps option.");
+    }
+    if (params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+      Usage("Cannot use --data-prefetch-steps with --shared-memory.");
+    }
+    if (params_->prestage_inputs) {
+      Usage("Cannot use --data-prefetch-steps with --prestage-inputs.");
+    }
+    if (!params_->input_corpus_file.empty()) {
+      Usage("Cannot use --data-prefetch-steps with --write-input-corpus.");
+    }
+  }
+
+  if (params_->shm_pool_size != 0 &&
+      params_->shared_memory_type == SharedMemoryType::NO_SHARED_MEMORY) {
+    Usage(
+        "Must specify --shared-memory when using the "
+        "--shared-memory-pool-size option.");
+  }
+
+  if (params_->output_shm_slots != 0 &&
+      params_->shared_memory_type == SharedMemoryType::NO_SHARED_MEMORY) {
+    Usage(
+        "Must specify --shared-memory when using the "
+        "--output-shared-memory-slots option.");
+  }
+
+  if ((params_->shm_huge_pages || params_->shm_prefault) &&
+      params_->shared_memory_type != SharedMemoryType::SYSTEM_SHARED_MEMORY) {
+    Usage(
+        "Must specify --shared-memory system when using the "
+        "--shared-memory-huge-pages or --shared-memory-prefault options.");
+  }
+
+  if (params_->shm_persist) {
+    if ((params_->shared_memory_type !=
+         SharedMemoryType::SYSTEM_SHARED_MEMORY) ||
+        (params_->kind != cb::BackendKind::TRITON)) {
+      Usage(
+          "--shared-memory-persist only applies to --shared-memory system "
+          "with service-kind=triton.");
+    }
+    if (params_->shm_pool_size != 0) {
+      Usage(
+          "--shared-memory-persist can not be used with "
+          "--shared-memory-pool-size.");
+    }
+  }
+
+  if (params_->async_continuations && params_->forced_sync) {
+    Usage("Cannot use --async-continuations with --sync.");
+  }
+
+  if (params_->async_continuations && !params_->targeting_concurrency()) {
+    Usage("--async-continuations only applies to --concurrency-range.");
+  }
+
+  if ((params_->max_inflight_requests != 0) &&
+      params_->targeting_concurrency()) {
+    Usage(
+        "--max-inflight-requests only applies to --request-rate-range and "
+        "--request-intervals.");
+  }
+
+  if (params_->auto_max_threads) {
+    if (!params_->using_request_rate_range) {
+      Usage("--max-threads=auto only applies to --request-rate-range.");
+    } else if (params_->mpi_distributed_load) {
+      Usage(
+          "--max-threads=auto cannot be combined with "
+          "--mpi-distributed-load.");
+    }
+  }
+
+  if (params_->warm_ramp && !params_->targeting_concurrency()) {
+    Usage("--warm-ramp only applies to --concurrency-range.");
+  }
+
+  if (params_->sequences_per_context > 1) {
+    if (!params_->targeting_concurrency()) {
+      Usage("--sequences-per-context only applies to --concurrency-range.");
+    }
+    if (params_->warm_ramp) {
+      Usage("--sequences-per-context cannot be combined with --warm-ramp.");
+    }
+  }
+
+  if (params_->mpi_distributed_load) {
+    if (!params_->enable_mpi) {
+      Usage("--mpi-distributed-load requires --enable-mpi.");
+    } else if (params_->using_custom_intervals) {
+      Usage(
+          "--mpi-distributed-load cannot be combined with "
+          "--request-intervals.");
+    } else if (params_->measurement_mode != MeasurementMode::TIME_WINDOWS) {
+      Usage(
+          "--mpi-distributed-load only supports "
+          "--measurement-mode=time_windows.");
+    }
+  }
+
+  if (!params_->mpi_rank_weights.empty()) {
+    if (!params_->mpi_distributed_load) {
+      Usage("--mpi-rank-weights only applies to --mpi-distributed-load.");
+    } else if (
+        params_->mpi_driver->IsMPIRun() &&
+        (params_->mpi_rank_weights.size() !=
+         static_cast<size_t>(params_->mpi_driver->MPICommSizeWorld()))) {
+      Usage("--mpi-rank-weights needs one weight per MPI rank.");
+    }
+  }
+
+  if ((params_->window_alignment_ms > 0) &&
+      (params_->measurement_mode != MeasurementMode::TIME_WINDOWS)) {
+    Usage(
+        "--window-alignment only supports --measurement-mode=time_windows.");
+  } else if (
+      (params_->window_start_time > 0) && (params_->window_alignment_ms == 0)) {
+    Usage("--window-start-time requires --window-alignment.");
+  }
+
+  if (params_->using_sequence_think_time) {
+    const auto& think_time = params_->sequence_think_time;
+    if (think_time.kind == SequenceDistributionSettings::UNIFORM) {
+      Usage("--sequence-think-time does not support uniform distributions.");
+    } else if (
+        (think_time.kind != SequenceDistributionSettings::HISTOGRAM) &&
+        (think_time.mean <= 0)) {
+      Usage(
+          "--sequence-think-time needs a mean, such as "
+          "\"constant:mean=100\".");
+    }
+    if (!params_->targeting_concurrency()) {
+      Usage("--sequence-think-time only applies to --concurrency-range.");
+    }
+    if (params_->async_continuations) {
+      Usage(
+          "--sequence-think-time cannot be combined with "
+          "--async-continuations.");
+    }
+  }
+
+  if ((params_->output_memory_policy.kind != cb::OUTPUT_MEMORY_CPU) &&
+      (params_->kind != cb::BackendKind::TRITON_C_API)) {
+    Usage("--output-memory only applies to service-kind=triton_c_api.");
+  }
+
+  if (params_->lazy_model_load &&
+      (params_->kind != cb::BackendKind::TRITON_C_API)) {
+    Usage("--lazy-model-load only applies to service-kind=triton_c_api.");
+  }
+
+  if (params_->server_request_trace &&
+      (params_->kind != cb::BackendKind::TRITON_C_API)) {
+    Usage("--server-request-trace only applies to service-kind=triton_c_api.");
+  }
+
+  if ((params_->model_load_iterations != 0) &&
+      (params_->kind != cb::BackendKind::TRITON)) {
+    Usage("--model-load-iterations only applies to service-kind=triton.");
+  }
+
+  if (!params_->model_load_config_file.empty() &&
+      (params_->kind != cb::BackendKind::TRITON)) {
+    Usage("--model-load-config only applies to service-kind=triton.");
+  }
+
+  if (!params_->model_mix.empty() &&
+      (params_->kind != cb::BackendKind::TRITON) &&
+      (params_->kind != cb::BackendKind::TRITON_C_API)) {
+    Usage(
+        "--model-mix only applies to service-kind=triton and "
+        "service-kind=triton_c_api.");
+  }
+
+  if (!params_->request_classes.empty() &&
+      (params_->kind != cb::BackendKind::TRITON) &&
+      (params_->kind != cb::BackendKind::TRITON_C_API)) {
+    Usage(
+        "--request-classes only applies to service-kind=triton and "
+        "service-kind=triton_c_api.");
+  }
+
+  if (!params_->endpoints.empty() &&
+      (params_->kind == cb::BackendKind::TRITON_C_API)) {
+    Usage("--endpoints does not apply to service-kind=triton_c_api.");
+  }
+
+  if (params_->client_connections > 0) {
+    if (params_->kind != cb::BackendKind::TRITON) {
+      Usage("--client-connections only applies to service-kind=triton.");
+    }
+    if (params_->streaming) {
+      Usage("--client-connections is not supported with --streaming.");
+    }
+    if (params_->endpoints.size() > 1) {
+      Usage("--client-connections is not supported with several --endpoints.");
+    }
+  }
+
+  if (params_->share_nothing) {
+    if (params_->shared_memory_type != SharedMemoryType::NO_SHARED_MEMORY) {
+      Usage("--share-nothing is not supported with shared memory.");
+    }
+    if (params_->client_connections > 0) {
+      Usage("--share-nothing is not supported with --client-connections.");
+    }
+    if (params_->num_dispatcher_threads > 0) {
+      Usage("--share-nothing is not supported with --dispatcher-threads.");
+    }
+  }
+
+  if (!params_->checkpoint_file.empty() && params_->enable_mpi) {
+    Usage("--checkpoint-file is not supported with --enable-mpi.");
+  }
+
+  if (params_->using_batch_size_range) {
+    if (params_->using_batch_size) {
+      Usage("Cannot specify both -b and --batch-size-range.");
+    }
+    if ((params_->kind != cb::BackendKind::TRITON) &&
+        (params_->kind != cb::BackendKind::TRITON_C_API)) {
+      Usage(
+          "--batch-size-range only applies to service-kind=triton and "
+          "service-kind=triton_c_api.");
+    }
+    // Their files and data hold one batch size
+    if (!params_->baseline_file.empty() ||
+        !params_->checkpoint_file.empty() ||
+        !params_->time_series_file.empty()) {
+      Usage(
+          "--batch-size-range can not be used with --baseline, "
+          "--checkpoint-file or --time-series-file.");
+    }
+    if ((params_->data_prefetch_steps != 0) ||
+        !params_->input_shape_distributions.empty()) {
+      Usage(
+          "--batch-size-range can not be used with --data-prefetch-steps or "
+          "--input-shape-distribution.");
+    }
+  }
 }
 
 }}  // namespace triton::perfanalyzer
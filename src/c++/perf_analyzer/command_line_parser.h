@@ -31,8 +31,14 @@
 #include <unordered_map>
 #include <vector>
 #include "constants.h"
+#include "endpoint_mix.h"
+#include "model_mix.h"
+#include "request_class.h"
 #include "mpi_utils.h"
 #include "perf_utils.h"
+#include "rate_profile.h"
+#include "sequence_distribution.h"
+#include "shape_distribution.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -45,19 +51,38 @@ struct PerfAnalyzerParameters {
   bool verbose = false;
   bool extra_verbose = false;
   bool streaming = false;
+  // The HTTP endpoint the requests are sent to with --streaming, empty when
+  // streaming is not used over HTTP
+  std::string http_streaming_endpoint{""};
   size_t max_threads = 4;
   bool max_threads_specified = false;
+  // Whether to grow the worker threads from max_threads while requests fall
+  // behind their schedule
+  bool auto_max_threads = false;
   size_t sequence_length = 20;  // average length of a sentence
   bool sequence_length_specified = false;
   double sequence_length_variation = 20.0;
   int32_t percentile = -1;
   std::vector<std::string> user_data;
+  // If set, the user data is written to this binary input corpus instead of
+  // profiling
+  std::string input_corpus_file{""};
+  // If set, the configurations of this experiment file are run instead of
+  // the one of the command line
+  std::string experiment_file{""};
+  // If not zero, the model is unloaded and loaded this many times to measure
+  // its cold start instead of profiling its inferences
+  size_t model_load_iterations = 0;
+  // If set, the model is loaded with the model config of this file, before
+  // it is profiled or by each load of --model-load-iterations
+  std::string model_load_config_file{""};
   std::unordered_map<std::string, std::vector<int64_t>> input_shapes;
   uint64_t measurement_window_ms = 5000;
   bool using_concurrency_range = false;
   Range<uint64_t> concurrency_range{1, 1, 1};
   uint64_t latency_threshold_ms = NO_LIMIT;
   double stability_threshold = 0.1;
+  bool early_convergence = false;
   size_t max_trials = 10;
   bool zero_input = false;
   size_t string_length = 128;
@@ -69,19 +94,121 @@ struct PerfAnalyzerParameters {
   uint32_t num_of_sequences = 4;
   SearchMode search_mode = SearchMode::LINEAR;
   Distribution request_distribution = Distribution::CONSTANT;
+  RateProfileSettings rate_profile_settings;
   bool using_custom_intervals = false;
   std::string request_intervals_file{""};
+  std::string request_trace_file{""};
+  // The shared library that generates the request rate schedules, empty to
+  // use request_distribution
+  std::string schedule_plugin{""};
+  std::string schedule_plugin_config{""};
+  // The path to write the requests sent on a schedule to, empty to not
+  // record them
+  std::string schedule_record_file{""};
+  // The path of a recorded schedule to replay, empty to not replay one
+  std::string schedule_replay_file{""};
+  bool precise_scheduling = false;
+  size_t num_dispatcher_threads = 0;
+  // The cap on the requests in flight in the request rate modes, 0 for none,
+  // and what happens to the requests over it
+  size_t max_inflight_requests = 0;
+  InflightOverload inflight_overload = OVERLOAD_DROP;
   SharedMemoryType shared_memory_type = NO_SHARED_MEMORY;
   size_t output_shm_size = 100 * 1024;
+  // Whether every context builds the inputs of all data steps up front
+  bool prestage_inputs = false;
+  // If not zero, the --input-data directory holds a subdirectory per step,
+  // read this many steps ahead of the requests
+  size_t data_prefetch_steps = 0;
+  // How far floating point outputs may be from the expected outputs, and the
+  // number of threads comparing them
+  double output_tolerance_absolute = 0.0;
+  double output_tolerance_relative = 0.0;
+  size_t validation_threads = 1;
+  // If not zero, the number of pooled shared memory regions per input
+  size_t shm_pool_size = 0;
+  // If not zero, the number of time-sliced shared memory regions per output
+  size_t output_shm_slots = 0;
+  // Whether the system shared memory regions are backed by huge pages and
+  // faulted in when they are created
+  bool shm_huge_pages = false;
+  bool shm_prefault = false;
+  // Whether the system shared memory regions are kept registered after the
+  // run for the next run to reuse
+  bool shm_persist = false;
+  // The CPUs of the perf_analyzer threads and of the load worker threads, if
+  // not empty
+  std::vector<int> client_cpus;
+  std::vector<int> worker_cpus;
+  // The NUMA node to allocate memory from, if not negative
+  int numa_node = -1;
+  // Whether async callbacks send the next request of their context
+  bool async_continuations = false;
+  // Whether concurrency changes add or retire contexts without pausing the
+  // workers
+  bool warm_ramp = false;
+  // The number of sequences that each context sends the steps of in turn
+  size_t sequences_per_context = 1;
+  // The distribution of the lengths of new sequences
+  SequenceDistributionSettings sequence_length_distribution;
+  // The distribution of the think times in msec between the steps of a
+  // sequence, if using_sequence_think_time
+  SequenceDistributionSettings sequence_think_time;
+  bool using_sequence_think_time = false;
+  // The time in msec to let the load settle before measuring each level
+  uint64_t settle_window_ms = 0;
+  // The number of requests to let complete before measuring each level
+  uint64_t warmup_request_count = 0;
+  // Requests slower than this multiple of the median latency of their window
+  // are left out of the latencies, 0 to keep all the requests
+  double latency_outlier_factor = 0.0;
+  // How to break the client latencies down, if at all
+  LatencyBucketing latency_bucketing = BUCKET_NONE;
+  // The distributions of the dimensions of the generated inputs to vary
+  std::vector<ShapeDistributionSettings> input_shape_distributions;
+  // The number of shapes drawn from input_shape_distributions
+  size_t input_shape_count = 64;
   clientbackend::BackendKind kind = clientbackend::BackendKind::TRITON;
   std::string model_signature_name{"serving_default"};
   bool using_grpc_compression = false;
+  bool using_http_compression = false;
+  // The compression of the gRPC requests or of the HTTP request bodies
   clientbackend::GrpcCompressionAlgorithm compression_algorithm =
       clientbackend::GrpcCompressionAlgorithm::COMPRESS_NONE;
   MeasurementMode measurement_mode = MeasurementMode::TIME_WINDOWS;
   uint64_t measurement_request_count = 50;
   std::string triton_server_path = "/opt/tritonserver";
   std::string model_repository_path;
+  // Where the C API backend allocates the outputs
+  clientbackend::OutputMemoryPolicy output_memory_policy;
+  // Whether the C API backend loads only the models that are profiled
+  bool lazy_model_load = false;
+  // Whether the C API backend traces the server timestamps of every request
+  bool server_request_trace = false;
+  // Where the configs of the composing models of ensembles are kept across
+  // runs, empty to always fetch them
+  std::string model_config_cache{""};
+  // The models that the requests are spread over besides the target model
+  std::vector<ModelMixEntry> model_mix;
+  // The request classes that the requests are spread over, empty to send
+  // every request with the default priority and timeout
+  std::vector<RequestClassEntry> request_classes;
+  // The results of a previous run to compare against, empty to not compare
+  std::string baseline_file{""};
+  // The worsening in percent from which a metric regressed from the baseline
+  double regression_threshold{5.0};
+  // Where the results of each completed load level are kept to resume the
+  // sweep from, empty to not keep them
+  std::string checkpoint_file{""};
+  // The servers that the requests are spread over, empty to send every
+  // request to the -u url, and how they are spread
+  std::vector<EndpointEntry> endpoints;
+  EndpointPolicy endpoint_policy = ENDPOINT_ROUND_ROBIN;
+  // The share of the requests that repeat an input sent before, 0 to send
+  // the steps of the input data in turn, and the Zipf exponent of the
+  // popularity of the repeated inputs
+  double input_repeat_ratio{0.0};
+  double input_popularity_skew{1.0};
   uint64_t start_sequence_id = 1;
   uint64_t sequence_id_range = UINT32_MAX;
   clientbackend::SslOptionsBase ssl_options;  // gRPC and HTTP SSL options
@@ -91,6 +218,16 @@ struct PerfAnalyzerParameters {
 
   // Enable MPI option for using MPI functionality with multi-model mode.
   bool enable_mpi = false;
+  // Whether the MPI ranks share the load on the same model instead of each
+  // profiling a model of its own
+  bool mpi_distributed_load = false;
+  // The weight of each MPI rank in a distributed load, equal if empty
+  std::vector<double> mpi_rank_weights;
+  // The spacing of the measurement window boundaries on the wall clock, 0 to
+  // not align the windows
+  uint64_t window_alignment_ms = 0;
+  // The first window boundary in seconds since the epoch
+  double window_start_time = 0;
   std::map<std::string, std::vector<std::string>> trace_options;
   bool using_old_options = false;
   bool dynamic_concurrency_mode = false;
@@ -100,6 +237,9 @@ struct PerfAnalyzerParameters {
   std::string model_version;
   int32_t batch_size = 1;
   bool using_batch_size = false;
+  // The batch sizes swept within the run, batch_size being the first one
+  bool using_batch_size_range = false;
+  Range<uint64_t> batch_size_range{1, 1, 1};
   int32_t concurrent_request_count = 1;
   clientbackend::ProtocolType protocol = clientbackend::ProtocolType::HTTP;
   std::shared_ptr<clientbackend::Headers> http_headers{
@@ -121,6 +261,52 @@ struct PerfAnalyzerParameters {
   uint64_t metrics_interval_ms{1000};
   bool metrics_interval_ms_specified{false};
 
+  // The metric families to collect beyond the GPU ones.
+  std::vector<std::string> metrics_allowlist{
+      "nv_inference_queue_duration_us", "nv_inference_pending_request_count",
+      "nv_inference_request_success",   "nv_inference_count",
+      "nv_cpu_utilization",             "nv_cpu_memory_used_bytes"};
+  bool metrics_allowlist_specified{false};
+
+  // The path to the JSON template of the request body of the HTTP JSON
+  // service kind.
+  std::string request_template{""};
+
+  // The behavior of the server simulated by the null server service kind
+  clientbackend::NullServerOptions null_server_options;
+
+  // How the clients of the TensorFlow Serving service kind send their
+  // requests
+  clientbackend::TfServingOptions tfserving_options;
+
+  // The impaired network simulated for the client: the bandwidth of each
+  // request and response transfer and the delay before each request is sent
+  clientbackend::TransferRateLimits transfer_rate_limits;
+  uint64_t client_send_delay_us{0};
+  // The number of client backends shared by all the contexts, 0 for a
+  // backend per context
+  size_t client_connections{0};
+  // Whether the worker threads share no state while generating the load
+  bool share_nothing{false};
+  std::string time_series_file{""};
+  uint64_t time_series_interval_ms{1000};
+
+  // The path of the binary file the record of every request is written to
+  std::string request_record_file{""};
+
+  // The number of slowest requests of each load level that are reported,
+  // 0 for none
+  size_t slowest_request_count{0};
+
+  // Whether to time the client side stages of the requests
+  bool client_stage_times{false};
+
+  // The path of the Chrome trace of the sampled requests, empty to not
+  // trace them
+  std::string client_trace_file{""};
+  // Trace one in every client_trace_rate requests of each context
+  uint64_t client_trace_rate{1000};
+
   // Return true if targeting concurrency
   //
   bool targeting_concurrency() const
@@ -156,6 +342,11 @@ class CLParser {
   std::string FormatMessage(std::string str, int offset) const;
   virtual void Usage(const std::string& msg = std::string());
   void ParseCommandLine(int argc, char** argv);
+  void ParseRequestDistribution(const std::string& arg);
+  void ParseNullServerOptions(const std::string& arg);
+  void ParseTfServingOptions(const std::string& arg);
+  void ParseClientNetworkOptions(const std::string& arg);
+  void ParseOutputMemory(const std::string& arg);
   void VerifyOptions();
 };
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,85 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+namespace triton { namespace perfanalyzer {
+
+/// Counts the requests completed by all the worker threads, and wakes up a
+/// waiter as soon as the count reaches its target.
+///
+/// Increment() is one atomic add plus one atomic load unless it is the
+/// increment that reaches the target, which is the only one that takes the
+/// lock. Only one thread may wait at a time.
+///
+class CompletionCounter {
+ public:
+  /// Count a completed request.
+  void Increment()
+  {
+    const uint64_t count = count_.fetch_add(1) + 1;
+    // The waiter checks the count under the lock after setting the target,
+    // so either it sees this increment or this sees its target
+    if (count == target_.load()) {
+      { std::lock_guard<std::mutex> lk(mu_); }
+      cv_.notify_all();
+    }
+  }
+
+  /// \return The number of requests completed so far.
+  uint64_t Count() const { return count_.load(); }
+
+  /// Wait until the count reaches 'target' or the timeout passes.
+  /// \return Whether the count reached the target.
+  bool WaitFor(uint64_t target, std::chrono::nanoseconds timeout)
+  {
+    target_.store(target);
+    bool reached;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      reached = cv_.wait_for(
+          lk, timeout, [this, target] { return count_.load() >= target; });
+    }
+    target_.store(NO_TARGET);
+    return reached;
+  }
+
+ private:
+  static constexpr uint64_t NO_TARGET = std::numeric_limits<uint64_t>::max();
+
+  alignas(64) std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> target_{NO_TARGET};
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+
+}}  // namespace triton::perfanalyzer
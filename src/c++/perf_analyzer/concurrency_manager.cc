@@ -25,6 +25,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "concurrency_manager.h"
+#include <algorithm>
 #include <queue>
 
 namespace triton { namespace perfanalyzer {
@@ -72,7 +73,8 @@ void
 ConcurrencyManager::InitManagerFinalize()
 {
   if (on_sequence_model_) {
-    sequence_manager_->InitSequenceStatuses(max_concurrency_);
+    sequence_manager_->InitSequenceStatuses(
+        max_concurrency_ * sequences_per_context_);
   }
 }
 
@@ -80,14 +82,82 @@ cb::Error
 ConcurrencyManager::ChangeConcurrencyLevel(
     const size_t concurrent_request_count)
 {
-  PauseSequenceWorkers();
-  ReconfigThreads(concurrent_request_count);
-  ResumeSequenceWorkers();
+  // The connections of the new contexts are set up while the current level
+  // keeps running, so that the new level starts sending at once
+  std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>> backends;
+  RETURN_IF_ERROR(PrepareContexts(concurrent_request_count, &backends));
+
+  if (warm_ramp_) {
+    // The workers add or retire contexts themselves while the others keep
+    // sending
+    ReconfigThreads(concurrent_request_count, &backends);
+    WakeWorkers();
+  } else {
+    PauseSequenceWorkers();
+    ReconfigThreads(concurrent_request_count, &backends);
+    ResumeSequenceWorkers();
+  }
 
   std::cout << "Request concurrency: " << concurrent_request_count << std::endl;
   return cb::Error::Success;
 }
 
+size_t
+ConcurrencyManager::ThreadCountFor(const size_t concurrent_request_count) const
+{
+  size_t thread_count = concurrent_request_count;
+  if (warm_ramp_ && on_sequence_model_) {
+    thread_count = std::max(thread_count, max_concurrency_);
+  }
+  return std::min(std::max(thread_count, threads_.size()), max_threads_);
+}
+
+cb::Error
+ConcurrencyManager::PrepareContexts(
+    const size_t concurrent_request_count,
+    std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>>* backends)
+{
+  const size_t thread_count = ThreadCountFor(concurrent_request_count);
+  backends->clear();
+  backends->resize(thread_count);
+  if (threads_ctx_count_.size() < thread_count) {
+    threads_ctx_count_.resize(thread_count, 0);
+  }
+  // The contexts of a shared pool take its backends instead, and threads
+  // sharing nothing set up their own backends on their own CPU
+  if ((factory_ == nullptr) || (backend_pool_ != nullptr) || share_nothing_ ||
+      (thread_count == 0)) {
+    return cb::Error::Success;
+  }
+
+  // Same split of the concurrency as in ReconfigThreads(), where a thread of
+  // a non-sequence model needs a single context
+  const size_t avg_concurrency = concurrent_request_count / thread_count;
+  const size_t threads_add_one = concurrent_request_count % thread_count;
+  std::vector<size_t> missing(thread_count, 0);
+  size_t total_missing = 0;
+  for (size_t i = 0; i < thread_count; i++) {
+    const size_t concurrency = avg_concurrency + (i < threads_add_one ? 1 : 0);
+    const size_t ctx_count =
+        on_sequence_model_ ? concurrency : std::min<size_t>(concurrency, 1);
+    if (ctx_count > threads_ctx_count_[i]) {
+      missing[i] = ctx_count - threads_ctx_count_[i];
+      total_missing += missing[i];
+    }
+  }
+
+  std::vector<std::unique_ptr<cb::ClientBackend>> prepared;
+  RETURN_IF_ERROR(PrepareClientBackends(total_missing, &prepared));
+  size_t next = 0;
+  for (size_t i = 0; i < thread_count; i++) {
+    for (size_t j = 0; j < missing[i]; j++) {
+      (*backends)[i].push_back(std::move(prepared[next++]));
+    }
+    threads_ctx_count_[i] += missing[i];
+  }
+  return cb::Error::Success;
+}
+
 void
 ConcurrencyManager::PauseSequenceWorkers()
 {
@@ -103,7 +173,9 @@ ConcurrencyManager::PauseSequenceWorkers()
 }
 
 void
-ConcurrencyManager::ReconfigThreads(const size_t concurrent_request_count)
+ConcurrencyManager::ReconfigThreads(
+    const size_t concurrent_request_count,
+    std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>>* backends)
 {
   // Always prefer to create new threads if the maximum limit has not been met
   //
@@ -111,10 +183,29 @@ ConcurrencyManager::ReconfigThreads(const size_t concurrent_request_count)
   // request at a time, hence the number of worker threads should be equal to
   // the requested concurrency levels.
   //
-  while ((concurrent_request_count > threads_.size()) &&
-         (threads_.size() < max_threads_)) {
+  // Warm ramps on sequence models interleave the sequence statuses over the
+  // threads, so all the threads ever needed are created up front.
+  //
+  // Hands a worker thread the backends prepared for it
+  auto hand_backends = [backends](size_t index, ThreadStat& thread_stat) {
+    if (index >= backends->size()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(thread_stat.mu_);
+    for (auto& backend : (*backends)[index]) {
+      thread_stat.prepared_backends_.push_back(std::move(backend));
+    }
+  };
+
+  for (size_t i = 0; i < threads_stat_.size(); i++) {
+    hand_backends(i, *threads_stat_[i]);
+  }
+
+  const size_t thread_count = ThreadCountFor(concurrent_request_count);
+  while (thread_count > threads_.size()) {
     // Launch new thread for inferencing
-    threads_stat_.emplace_back(new ThreadStat());
+    AddThreadStat();
+    hand_backends(threads_stat_.size() - 1, *threads_stat_.back());
     threads_config_.emplace_back(
         new ConcurrencyWorker::ThreadConfig(threads_config_.size()));
 
@@ -122,6 +213,7 @@ ConcurrencyManager::ReconfigThreads(const size_t concurrent_request_count)
         MakeWorker(threads_stat_.back(), threads_config_.back()));
 
     threads_.emplace_back(&IWorker::Infer, workers_.back());
+    PinNewWorkerThread();
   }
 
   {
@@ -157,6 +249,21 @@ ConcurrencyManager::ResumeSequenceWorkers()
   wake_signal_.notify_all();
 }
 
+void
+ConcurrencyManager::WakeWorkers()
+{
+  // Workers without concurrency wait on the wake signal, the others for
+  // their responses
+  wake_signal_.notify_all();
+  for (auto& worker : workers_) {
+    auto concurrency_worker =
+        std::dynamic_pointer_cast<ConcurrencyWorker>(worker);
+    if (concurrency_worker != nullptr) {
+      concurrency_worker->WakeUp();
+    }
+  }
+}
+
 std::shared_ptr<IWorker>
 ConcurrencyManager::MakeWorker(
     std::shared_ptr<ThreadStat> thread_stat,
@@ -168,7 +275,9 @@ ConcurrencyManager::MakeWorker(
       id, thread_stat, thread_config, parser_, data_loader_, factory_,
       on_sequence_model_, async_, max_concurrency_, using_json_data_,
       streaming_, batch_size_, threads_config_, wake_signal_, wake_mutex_,
-      active_threads_, execute_, infer_data_manager_, sequence_manager_);
+      active_threads_, execute_, WorkerInferDataManager(),
+      WorkerSequenceManager(), async_continuations_, warm_ramp_,
+      sequences_per_context_, sequence_think_time_);
 }
 
 }}  // namespace triton::perfanalyzer
@@ -105,19 +105,40 @@ class ConcurrencyManager : public LoadManager {
 
   void InitManagerFinalize() override;
 
+  // Returns the number of worker threads once the concurrency is
+  // 'concurrent_request_count'
+  //
+  size_t ThreadCountFor(size_t concurrent_request_count) const;
+
+  // Create and connect in parallel the backends of the contexts that the
+  // worker threads will be missing at the new concurrent request count, one
+  // list per worker thread
+  //
+  cb::Error PrepareContexts(
+      size_t concurrent_request_count,
+      std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>>* backends);
+
   // Pause all worker threads that are working on sequences
   //
   void PauseSequenceWorkers();
 
   // Create new threads (if necessary), and then reconfigure all worker threads
-  // to handle the new concurrent request count
+  // to handle the new concurrent request count. The worker threads are handed
+  // the backends prepared for them.
   //
-  void ReconfigThreads(size_t concurrent_request_count);
+  void ReconfigThreads(
+      size_t concurrent_request_count,
+      std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>>* backends);
 
   // Restart all worker threads that were working on sequences
   //
   void ResumeSequenceWorkers();
 
+  // Make all worker threads pick up their new concurrency without pausing
+  // them
+  //
+  void WakeWorkers();
+
   // The number of worker threads with non-zero concurrencies
   size_t active_threads_;
 
@@ -125,6 +146,9 @@ class ConcurrencyManager : public LoadManager {
 
   size_t max_concurrency_;
   std::vector<std::shared_ptr<ConcurrencyWorker::ThreadConfig>> threads_config_;
+  // The number of contexts that each worker thread has created or has been
+  // prepared for
+  std::vector<size_t> threads_ctx_count_;
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestConcurrencyManager;
@@ -25,6 +25,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
+#include <thread>
 
 #include "client_backend/client_backend.h"
 #include "concurrency_worker.h"
@@ -111,11 +112,24 @@ ConcurrencyWorker::HandleExecuteOff()
   thread_config_->is_paused_ = false;
 }
 
+void
+ConcurrencyWorker::WakeUp()
+{
+  completed_ctx_ids_.Notify();
+}
+
 bool
 ConcurrencyWorker::HandleNoConcurrency()
 {
   // Only interact with synchronous mechanism if the worker should wait
   if (thread_config_->concurrency_ == 0) {
+    if (warm_ramp_) {
+      // Keep going until the requests left by a warm ramp are retired
+      DrainCompletedCtxIds();
+      if (HasLiveRequests()) {
+        return false;
+      }
+    }
     // Wait if no request should be sent and it is not exiting
     std::unique_lock<std::mutex> lock(wake_mutex_);
     wake_signal_.wait(lock, [this]() {
@@ -140,7 +154,12 @@ ConcurrencyWorker::CreateContextsAsNecessary()
     while (active_ctx_cnt > ctxs_.size()) {
       CreateContext();
     }
-    ResetFreeCtxIds();
+    if (!warm_ramp_) {
+      ResetFreeCtxIds();
+    }
+  }
+  if (warm_ramp_) {
+    AdjustFreeCtxIds();
   }
 
   // TODO REFACTOR TMA-1043 -- this shouldn't be handled here
@@ -152,55 +171,173 @@ ConcurrencyWorker::CreateContextsAsNecessary()
 void
 ConcurrencyWorker::SendInferRequests()
 {
+  // Contexts done thinking go first, they have waited the longest
+  const auto now = std::chrono::steady_clock::now();
+  while (!thinking_ctx_ids_.empty() && execute_ && !ShouldExit()) {
+    auto earliest = std::min_element(
+        thinking_ctx_ids_.begin(), thinking_ctx_ids_.end());
+    if (earliest->first > now) {
+      break;
+    }
+    const uint32_t ctx_id = earliest->second;
+    thinking_ctx_ids_.erase(earliest);
+    SendOnContext(ctx_id, true);
+  }
+
+  DrainCompletedCtxIds();
   while (free_ctx_ids_.size() && execute_ && !ShouldExit()) {
-    uint32_t ctx_id = GetCtxId();
-    SendInferRequest(ctx_id);
-    RestoreFreeCtxId(ctx_id);
+    SendOnContext(GetCtxId(), false);
   }
 }
 
+void
+ConcurrencyWorker::SendOnContext(uint32_t ctx_id, bool thought)
+{
+  const bool retiring = warm_ramp_ && on_sequence_model_ && IsRetiring(ctx_id);
+  if (retiring && RetireContext(ctx_id)) {
+    return;
+  }
+  if (!retiring && !thought && StartThinking(ctx_id)) {
+    return;
+  }
+  auto send = [this, ctx_id, retiring]() {
+    if (retiring) {
+      ctxs_[ctx_id]->CompleteOngoingSequence(GetSeqStatIndex(ctx_id));
+    } else {
+      SendInferRequest(ctx_id);
+    }
+  };
+  if (async_continuations_) {
+    // Wait for a callback that is sending, rather than handing the request
+    // it is done with back to this thread
+    while (sending_.exchange(true)) {
+      std::this_thread::yield();
+    }
+    send();
+    sending_ = false;
+  } else {
+    send();
+  }
+  RestoreFreeCtxId(ctx_id);
+}
+
+bool
+ConcurrencyWorker::StartThinking(uint32_t ctx_id)
+{
+  if (think_time_ == nullptr || !on_sequence_model_) {
+    return false;
+  }
+  // The first step of a sequence follows no response to think about
+  const size_t seq_stat_index =
+      GetSeqStatIndex(ctx_id) + next_sequence_slots_[ctx_id];
+  if (sequence_manager_->GetRemainingQueries(seq_stat_index) == 0) {
+    return false;
+  }
+  const double think_time_ms =
+      std::max(0.0, think_time_->Draw(think_time_rng_));
+  thinking_ctx_ids_.emplace_back(
+      std::chrono::steady_clock::now() +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double, std::milli>(think_time_ms)),
+      ctx_id);
+  return true;
+}
+
 void
 ConcurrencyWorker::RestoreFreeCtxId(uint32_t ctx_id)
 {
   if (!async_) {
-    {
-      std::lock_guard<std::mutex> lock(cb_mtx_);
-      free_ctx_ids_.push(ctx_id);
-    }
+    ReleaseCtxId(ctx_id);
+  }
+}
+
+void
+ConcurrencyWorker::ReleaseCtxId(uint32_t ctx_id)
+{
+  if (warm_ramp_ && !on_sequence_model_ && retiring_slots_ > 0) {
+    retiring_slots_--;
+    live_slots_--;
+    return;
+  }
+  free_ctx_ids_.push(ctx_id);
+}
+
+void
+ConcurrencyWorker::DrainCompletedCtxIds()
+{
+  uint32_t ctx_id;
+  while (completed_ctx_ids_.TryPop(&ctx_id)) {
+    ReleaseCtxId(ctx_id);
   }
 }
 
 void
 ConcurrencyWorker::WaitForResponses()
 {
-  if (async_) {
-    {
-      // If async, then wait for signal from callback.
-      std::unique_lock<std::mutex> lk(cb_mtx_);
+  if (!thinking_ctx_ids_.empty()) {
+    // Wake up for the response of a request or for the first context done
+    // thinking, whichever comes first
+    const auto until = std::min_element(
+                           thinking_ctx_ids_.begin(), thinking_ctx_ids_.end())
+                           ->first;
+    if (async_) {
       thread_stat_->idle_timer.Start();
-      cb_cv_.wait(lk, [this] {
-        if (notified_) {
-          notified_ = false;
-          return true;
-        }
-        return false;
-      });
+      completed_ctx_ids_.WaitUntil(until);
+      thread_stat_->idle_timer.Stop();
+      DrainCompletedCtxIds();
+    } else if (free_ctx_ids_.empty()) {
+      thread_stat_->idle_timer.Start();
+      std::this_thread::sleep_until(until);
       thread_stat_->idle_timer.Stop();
     }
+    return;
+  }
+
+  if (async_) {
+    // Nothing would notify a worker whose requests were all retired
+    DrainCompletedCtxIds();
+    if (warm_ramp_ && !HasLiveRequests()) {
+      return;
+    }
+    // If async, then wait for a context handed back by a callback.
+    thread_stat_->idle_timer.Start();
+    completed_ctx_ids_.Wait();
+    thread_stat_->idle_timer.Stop();
+    DrainCompletedCtxIds();
   }
 }
 
 void
 ConcurrencyWorker::AsyncCallbackFinalize(uint32_t ctx_id)
 {
-  // avoid competition over 'cb_mtx_'
-  {
-    std::lock_guard<std::mutex> lk(cb_mtx_);
-    free_ctx_ids_.push(ctx_id);
-    notified_ = true;
+  if (async_continuations_ && ContinueOnCallback(ctx_id)) {
+    return;
   }
 
-  cb_cv_.notify_all();
+  // Hand the context back without waiting on the worker's thread, which
+  // releases it once it is done sending
+  completed_ctx_ids_.Push(ctx_id);
+}
+
+bool
+ConcurrencyWorker::ContinueOnCallback(uint32_t ctx_id)
+{
+  if (warm_ramp_ && IsRetiring(ctx_id)) {
+    return false;
+  }
+  // The callback of a request sent from a continuation can also run before
+  // the send returns, in which case the flag is already taken
+  if (sending_.exchange(true)) {
+    return false;
+  }
+  bool continued = false;
+  if (execute_ && !ShouldExit()) {
+    SendInferRequest(ctx_id);
+    // A failed send leaves nothing in flight to wake up the worker's thread
+    continued = !ShouldExit();
+  }
+  sending_ = false;
+  return continued;
 }
 
 void
@@ -208,8 +345,10 @@ ConcurrencyWorker::CompleteOngoingSequences()
 {
   if (on_sequence_model_) {
     for (size_t ctx_id = 0; ctx_id < ctxs_.size(); ++ctx_id) {
-      size_t seq_stat_index = GetSeqStatIndex(ctx_id);
-      ctxs_[ctx_id]->CompleteOngoingSequence(seq_stat_index);
+      for (size_t slot = 0; slot < sequences_per_context_; ++slot) {
+        size_t seq_stat_index = GetSeqStatIndex(ctx_id) + slot;
+        ctxs_[ctx_id]->CompleteOngoingSequence(seq_stat_index);
+      }
     }
   }
 }
@@ -217,8 +356,12 @@ ConcurrencyWorker::CompleteOngoingSequences()
 void
 ConcurrencyWorker::ResetFreeCtxIds()
 {
-  std::lock_guard<std::mutex> lock(cb_mtx_);
+  // The contexts handed back so far are all queued again below
+  uint32_t ctx_id;
+  while (completed_ctx_ids_.TryPop(&ctx_id)) {
+  }
   free_ctx_ids_ = std::queue<int>();
+  thinking_ctx_ids_.clear();
 
   for (size_t i = 0; i < thread_config_->concurrency_; ++i) {
     if (on_sequence_model_) {
@@ -229,30 +372,111 @@ ConcurrencyWorker::ResetFreeCtxIds()
   }
 }
 
+void
+ConcurrencyWorker::AdjustFreeCtxIds()
+{
+  const size_t concurrency = thread_config_->concurrency_;
+  DrainCompletedCtxIds();
+
+  if (on_sequence_model_) {
+    // Contexts over the concurrency are retired as they come back
+    ctx_in_use_.resize(ctxs_.size(), false);
+    for (size_t i = 0; i < concurrency; ++i) {
+      if (!ctx_in_use_[i]) {
+        ctx_in_use_[i] = true;
+        free_ctx_ids_.push(i);
+      }
+    }
+    return;
+  }
+
+  const size_t active_slots = live_slots_ - retiring_slots_;
+  if (concurrency > active_slots) {
+    // Slots still in flight are kept instead of being replaced
+    const size_t kept =
+        std::min<size_t>(retiring_slots_, concurrency - active_slots);
+    retiring_slots_ -= kept;
+    for (size_t i = active_slots + kept; i < concurrency; ++i) {
+      free_ctx_ids_.push(0);
+      live_slots_++;
+    }
+  } else {
+    retiring_slots_ += active_slots - concurrency;
+    // Queued slots can go right away
+    while (retiring_slots_ > 0 && !free_ctx_ids_.empty()) {
+      free_ctx_ids_.pop();
+      retiring_slots_--;
+      live_slots_--;
+    }
+  }
+}
+
+bool
+ConcurrencyWorker::IsRetiring(uint32_t ctx_id)
+{
+  if (on_sequence_model_) {
+    return ctx_id >= thread_config_->concurrency_;
+  }
+  return retiring_slots_ > 0;
+}
+
+bool
+ConcurrencyWorker::RetireContext(uint32_t ctx_id)
+{
+  if (sequence_manager_->GetRemainingQueries(GetSeqStatIndex(ctx_id)) == 0) {
+    ctx_in_use_[ctx_id] = false;
+    return true;
+  }
+  return false;
+}
+
+bool
+ConcurrencyWorker::HasLiveRequests()
+{
+  if (on_sequence_model_) {
+    return std::find(ctx_in_use_.begin(), ctx_in_use_.end(), true) !=
+           ctx_in_use_.end();
+  }
+  return live_slots_ > 0;
+}
+
 uint32_t
 ConcurrencyWorker::GetSeqStatIndex(uint32_t ctx_id)
 {
+  if (warm_ramp_) {
+    // Interleaving keeps the statuses of this thread in place whatever the
+    // share of the other threads
+    return (ctx_id * threads_config_.size() + thread_config_->thread_id_) *
+           sequences_per_context_;
+  }
+
   size_t offset = 0;
   for (size_t i = 0; i < thread_config_->thread_id_; i++) {
     offset += threads_config_[i]->concurrency_;
   }
 
-  return (offset + ctx_id);
+  return (offset + ctx_id) * sequences_per_context_;
+}
+
+uint32_t
+ConcurrencyWorker::NextSeqStatIndex(uint32_t ctx_id)
+{
+  // A context has a single request in flight, so each of its sequences has
+  // its previous step answered before the next one is sent
+  const size_t slot = next_sequence_slots_[ctx_id];
+  next_sequence_slots_[ctx_id] = (slot + 1) % sequences_per_context_;
+  return GetSeqStatIndex(ctx_id) + slot;
 }
 
 uint32_t
 ConcurrencyWorker::GetCtxId()
 {
-  uint32_t ctx_id;
   // Find the next available context id to use for this request
-  std::lock_guard<std::mutex> lk(cb_mtx_);
-  {
-    if (free_ctx_ids_.size() < 1) {
-      throw std::runtime_error("free ctx id list is empty");
-    }
-    ctx_id = free_ctx_ids_.front();
-    free_ctx_ids_.pop();
+  if (free_ctx_ids_.size() < 1) {
+    throw std::runtime_error("free ctx id list is empty");
   }
+  uint32_t ctx_id = free_ctx_ids_.front();
+  free_ctx_ids_.pop();
   return ctx_id;
 }
 
@@ -26,10 +26,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <queue>
 #include <random>
 
+#include "ctx_id_queue.h"
 #include "load_worker.h"
 #include "sequence_manager.h"
 
@@ -79,18 +81,29 @@ class ConcurrencyWorker : public LoadWorker {
       std::condition_variable& wake_signal, std::mutex& wake_mutex,
       size_t& active_threads, bool& execute,
       const std::shared_ptr<IInferDataManager>& infer_data_manager,
-      std::shared_ptr<SequenceManager> sequence_manager)
+      std::shared_ptr<SequenceManager> sequence_manager,
+      const bool async_continuations = false, const bool warm_ramp = false,
+      const size_t sequences_per_context = 1,
+      std::shared_ptr<const SequenceDistribution> think_time = nullptr)
       : LoadWorker(
             id, thread_stat, parser, data_loader, factory, on_sequence_model,
             async, streaming, batch_size, using_json_data, wake_signal,
             wake_mutex, execute, infer_data_manager, sequence_manager),
         thread_config_(thread_config), max_concurrency_(max_concurrency),
-        threads_config_(threads_config), active_threads_(active_threads)
+        threads_config_(threads_config), active_threads_(active_threads),
+        async_continuations_(async && async_continuations),
+        warm_ramp_(warm_ramp), sequences_per_context_(sequences_per_context),
+        next_sequence_slots_(max_concurrency, 0), think_time_(think_time),
+        think_time_rng_(id), completed_ctx_ids_(max_concurrency)
   {
   }
 
   void Infer() override;
 
+  /// Wakes up the worker waiting for responses so that it picks up a change
+  /// of its concurrency
+  void WakeUp();
+
  private:
   const size_t max_concurrency_;
   // TODO REFACTOR TMA-1020 can we decouple this thread from the total count of
@@ -99,17 +112,58 @@ class ConcurrencyWorker : public LoadWorker {
   // TODO REFACTOR TMA-1020 can we decouple this thread from every other thread?
   std::vector<std::shared_ptr<ThreadConfig>>& threads_config_;
 
+  // The contexts or slots ready to send on. Only accessed from the worker's
+  // thread.
   std::queue<int> free_ctx_ids_;
 
   std::shared_ptr<ThreadConfig> thread_config_;
 
-  // Variables used to signal async request completion
-  bool notified_ = false;
-  std::mutex cb_mtx_;
-  std::condition_variable cb_cv_;
+  // Whether the callback of a request sends the next request of its context
+  // itself, instead of handing the context back to this worker's thread
+  const bool async_continuations_;
+  // Set while a thread sends on the contexts of this worker, when
+  // continuations are enabled
+  std::atomic<bool> sending_{false};
+
+  // Whether concurrency changes are applied while the contexts keep sending.
+  // Sequence statuses are then interleaved over all the threads, because the
+  // share of the other threads changes under this one.
+  const bool warm_ramp_;
+  // With warm ramps on non-sequence models, the request slots of the context
+  // that are queued or in flight, and how many of them are dropped instead of
+  // being queued again when they come back. Only changed from the worker's
+  // thread, callbacks read 'retiring_slots_' to skip continuations.
+  size_t live_slots_{0};
+  std::atomic<size_t> retiring_slots_{0};
+  // With warm ramps on sequence models, whether each context is queued or in
+  // flight. Only accessed from the worker's thread.
+  std::vector<bool> ctx_in_use_;
+
+  // The number of sequence statuses that each context sends the steps of in
+  // turn, and which of them the next request of each context goes to. Sized
+  // for all the contexts up front, callbacks read it while contexts are added.
+  const size_t sequences_per_context_;
+  std::vector<size_t> next_sequence_slots_;
+
+  // The think time in msec between the response to a step of a sequence and
+  // its next step, if any, and the contexts that wait for the end of theirs.
+  // Only accessed from the worker's thread.
+  std::shared_ptr<const SequenceDistribution> think_time_;
+  std::mt19937 think_time_rng_;
+  std::vector<std::pair<std::chrono::steady_clock::time_point, uint32_t>>
+      thinking_ctx_ids_;
+
+  // The contexts handed back by the async callbacks, which the worker's
+  // thread moves to 'free_ctx_ids_'
+  CtxIdQueue completed_ctx_ids_;
 
   void AsyncCallbackFinalize(uint32_t ctx_id);
 
+  // Sends the next request of a context from the callback of its previous
+  // one. Returns false if the context has to go back to the worker's thread
+  // instead, which is also the case when another thread is already sending.
+  bool ContinueOnCallback(uint32_t ctx_id);
+
   void CompleteOngoingSequences() override;
 
   // Reserve vector size for contexts
@@ -128,13 +182,48 @@ class ConcurrencyWorker : public LoadWorker {
   // Send out the desired concurrency of requests
   void SendInferRequests();
 
+  // Sends the next request of a context that is done with its previous one.
+  // A context that ended its think time does not start another one.
+  void SendOnContext(uint32_t ctx_id, bool thought);
+
+  // Makes a context wait for a think time if its next request continues a
+  // sequence. Returns true if it waits.
+  bool StartThinking(uint32_t ctx_id);
+
   void WaitForResponses();
 
   void RestoreFreeCtxId(uint32_t ctx_id);
   void ResetFreeCtxIds();
 
+  // Queues a context id that is done with its request. With warm ramps on
+  // non-sequence models, retiring slots are dropped instead.
+  void ReleaseCtxId(uint32_t ctx_id);
+
+  // Releases the contexts handed back by the async callbacks so far
+  void DrainCompletedCtxIds();
+
+  // Warm ramp counterpart of ResetFreeCtxIds(): queues the contexts or slots
+  // the concurrency is missing and retires the ones over it, leaving the
+  // requests in flight alone
+  void AdjustFreeCtxIds();
+
+  // Whether the given context is over the concurrency of a warm ramp
+  bool IsRetiring(uint32_t ctx_id);
+
+  // Ends the sequence of a context over the concurrency of a warm ramp.
+  // Returns true once the context is given up, and false when the last
+  // request of its sequence still has to be sent.
+  bool RetireContext(uint32_t ctx_id);
+
+  // Whether a warm ramp left requests queued or in flight. Only accurate
+  // once the completed contexts are drained.
+  bool HasLiveRequests();
+
+  // The first of the sequence statuses of a context
   uint32_t GetSeqStatIndex(uint32_t ctx_id) override;
 
+  uint32_t NextSeqStatIndex(uint32_t ctx_id) override;
+
   uint32_t GetCtxId();
 
   void CreateContextFinalize(std::shared_ptr<InferContext> ctx) override
@@ -142,6 +231,11 @@ class ConcurrencyWorker : public LoadWorker {
     ctx->RegisterAsyncCallbackFinalize(std::bind(
         &ConcurrencyWorker::AsyncCallbackFinalize, this,
         std::placeholders::_1));
+    if (async_continuations_) {
+      // Continued sends happen while this thread waits, which is already
+      // counted as idle time
+      ctx->DisableSendIdleTime();
+    }
   }
 
 #ifndef DOCTEST_CONFIG_DISABLE
@@ -35,6 +35,7 @@ constexpr static const uint32_t SUCCESS = 0;
 
 constexpr static const uint32_t STABILITY_ERROR = 2;
 constexpr static const uint32_t OPTION_ERROR = 3;
+constexpr static const uint32_t REGRESSION_ERROR = 4;
 
 constexpr static const uint32_t GENERIC_ERROR = 99;
 
@@ -0,0 +1,185 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "cpu_affinity.h"
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// From <numaif.h>, which would otherwise make libnuma a dependency
+constexpr int kMpolBind = 2;
+
+}  // namespace
+
+cb::Error
+ParseCpuList(const std::string& list, std::vector<int>* cpus)
+{
+  std::vector<int> parsed;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    size_t dash = range.find('-');
+    try {
+      size_t used = 0;
+      int first = std::stoi(range.substr(0, dash), &used);
+      if (used != range.substr(0, dash).size()) {
+        throw std::invalid_argument(range);
+      }
+      int last = first;
+      if (dash != std::string::npos) {
+        std::string end = range.substr(dash + 1);
+        last = std::stoi(end, &used);
+        if (used != end.size()) {
+          throw std::invalid_argument(range);
+        }
+      }
+      if (first < 0 || last < first) {
+        throw std::invalid_argument(range);
+      }
+      for (int cpu = first; cpu <= last; cpu++) {
+        parsed.push_back(cpu);
+      }
+    }
+    catch (const std::exception&) {
+      return cb::Error(
+          "invalid CPU range '" + range + "' in CPU list '" + list + "'",
+          pa::GENERIC_ERROR);
+    }
+  }
+  if (parsed.empty()) {
+    return cb::Error("empty CPU list", pa::GENERIC_ERROR);
+  }
+  *cpus = std::move(parsed);
+  return cb::Error::Success;
+}
+
+cb::Error
+NumaNodeCpus(const int node, std::vector<int>* cpus)
+{
+  const std::string path(
+      "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  std::ifstream file(path);
+  std::string list;
+  if (!file || !std::getline(file, list)) {
+    return cb::Error(
+        "unable to read the CPUs of NUMA node " + std::to_string(node) +
+            " from " + path,
+        pa::GENERIC_ERROR);
+  }
+  return ParseCpuList(list, cpus);
+}
+
+cb::Error
+ProcessCpus(std::vector<int>* cpus)
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return cb::Error(
+        "unable to get the CPU affinity of the process: " +
+            std::string(strerror(errno)),
+        pa::GENERIC_ERROR);
+  }
+  std::vector<int> allowed;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      allowed.push_back(cpu);
+    }
+  }
+  if (allowed.empty()) {
+    return cb::Error("the process may not run on any CPU", pa::GENERIC_ERROR);
+  }
+  *cpus = std::move(allowed);
+  return cb::Error::Success;
+}
+
+cb::Error
+SetThreadAffinity(pthread_t thread, const std::vector<int>& cpus)
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const int cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      return cb::Error(
+          "CPU " + std::to_string(cpu) + " is out of range",
+          pa::GENERIC_ERROR);
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  int err = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return cb::Error(
+        "unable to set the CPU affinity of a thread: " +
+            std::string(strerror(err)),
+        pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+SetThreadName(pthread_t thread, const std::string& name)
+{
+  int err = pthread_setname_np(thread, name.substr(0, 15).c_str());
+  if (err != 0) {
+    return cb::Error(
+        "unable to name thread '" + name + "': " + std::string(strerror(err)),
+        pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+BindMemoryToNumaNode(const int node)
+{
+  if (node < 0) {
+    return cb::Error(
+        "invalid NUMA node " + std::to_string(node), pa::GENERIC_ERROR);
+  }
+  constexpr size_t kBitsPerWord = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> node_mask(node / kBitsPerWord + 1, 0);
+  node_mask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  // The kernel drops the last bit of the mask size it is given
+  if (syscall(
+          SYS_set_mempolicy, kMpolBind, node_mask.data(),
+          node_mask.size() * kBitsPerWord + 1) != 0) {
+    return cb::Error(
+        "unable to bind memory to NUMA node " + std::to_string(node) + ": " +
+            std::string(strerror(errno)),
+        pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,79 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Parses a list of CPUs in the format of the Linux cpulist files, such as
+/// "0-3,8,10-11".
+/// \param list The list to parse.
+/// \param cpus Returns the CPUs of the list, in the order given. Left
+/// unchanged if the list is invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseCpuList(const std::string& list, std::vector<int>* cpus);
+
+/// Looks up the CPUs of a NUMA node.
+/// \param node The NUMA node.
+/// \param cpus Returns the CPUs of the node.
+/// \return cb::Error object indicating success or failure.
+cb::Error NumaNodeCpus(const int node, std::vector<int>* cpus);
+
+/// Looks up the CPUs the calling process may run on, such as those left to
+/// it by taskset or by the CPU set of its container.
+/// \param cpus Returns the CPUs of the process, in increasing order.
+/// \return cb::Error object indicating success or failure.
+cb::Error ProcessCpus(std::vector<int>* cpus);
+
+/// Restricts a thread to run on the given CPUs. Threads created by the
+/// thread afterwards inherit the restriction.
+/// \param thread The thread to restrict.
+/// \param cpus The CPUs the thread may run on.
+/// \return cb::Error object indicating success or failure.
+cb::Error SetThreadAffinity(pthread_t thread, const std::vector<int>& cpus);
+
+/// Names a thread, as shown by top and in the per thread CPU usage of the
+/// client. Linux keeps the first 15 characters of the name.
+/// \param thread The thread to name.
+/// \param name The name of the thread.
+/// \return cb::Error object indicating success or failure.
+cb::Error SetThreadName(pthread_t thread, const std::string& name);
+
+/// Makes the memory allocated by the calling thread, and by the threads it
+/// creates afterwards, come from the given NUMA node. The pages are placed
+/// when they are first touched, so this covers the data loader buffers and
+/// the shared memory regions filled by these threads.
+/// \param node The NUMA node.
+/// \return cb::Error object indicating success or failure.
+cb::Error BindMemoryToNumaNode(const int node);
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,227 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace triton { namespace perfanalyzer {
+
+/// Bounded lock-free queue that hands the ids of contexts done with their
+/// requests from the async callbacks back to the worker thread that owns
+/// them.
+///
+/// Any number of callback threads may push, but only the owning thread pops
+/// and waits. Pushes never take a lock unless the owner is parked, so a
+/// callback never waits on the owner sending requests. The owner spins for
+/// a short while before it parks, which catches the common case of a
+/// response arriving right behind the last send without a wake-up.
+///
+/// Ids that do not fit in the ring spill into an overflow vector instead of
+/// making the callback wait. Only that rare path takes a lock.
+///
+class CtxIdQueue {
+ public:
+  static constexpr size_t SPIN_COUNT = 64;
+
+  /// \param capacity The number of ids that can be queued. Rounded up to a
+  /// power of 2.
+  explicit CtxIdQueue(size_t capacity)
+  {
+    capacity_ = 2;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    mask_ = capacity_ - 1;
+    slots_.reset(new Slot[capacity_]);
+    for (size_t i = 0; i < capacity_; i++) {
+      slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  CtxIdQueue(const CtxIdQueue&) = delete;
+  CtxIdQueue& operator=(const CtxIdQueue&) = delete;
+
+  /// Add an id to the queue, waking up the owner if it is parked.
+  void Push(uint32_t ctx_id)
+  {
+    if (!TryPush(ctx_id)) {
+      std::lock_guard<std::mutex> lk(spill_mtx_);
+      spill_.push_back(ctx_id);
+      spilled_.store(true, std::memory_order_release);
+    }
+    Unpark();
+  }
+
+  /// Wake up the owner without queueing an id. The next Wait() returns
+  /// right away if the owner is not waiting yet.
+  void Notify()
+  {
+    notified_.store(true, std::memory_order_release);
+    Unpark();
+  }
+
+  /// Add an id to the ring without waking up the owner.
+  /// \return False if the ring is full.
+  bool TryPush(uint32_t ctx_id)
+  {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          slot.ctx_id_ = ctx_id;
+          slot.sequence_.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Take the oldest id from the queue. Owner side only.
+  /// \return False if the queue is empty.
+  bool TryPop(uint32_t* ctx_id)
+  {
+    Slot& slot = slots_[head_ & mask_];
+    if (slot.sequence_.load(std::memory_order_acquire) != head_ + 1) {
+      return TryPopSpilled(ctx_id);
+    }
+    *ctx_id = slot.ctx_id_;
+    slot.sequence_.store(head_ + capacity_, std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+  /// Wait until an id is queued or Notify() is called. Owner side only.
+  void Wait()
+  {
+    WaitUntil(std::chrono::steady_clock::time_point::max());
+  }
+
+  /// Wait until an id is queued, Notify() is called or the deadline passes.
+  /// Owner side only.
+  void WaitUntil(const std::chrono::steady_clock::time_point& deadline)
+  {
+    for (size_t i = 0; i < SPIN_COUNT; i++) {
+      if (Ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    // Pairs with the fence in Unpark(): either the pusher sees the owner
+    // parked, or the owner sees what was pushed before it parks
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+      std::unique_lock<std::mutex> lk(park_mtx_);
+      if (deadline == std::chrono::steady_clock::time_point::max()) {
+        park_cv_.wait(lk, [this] { return Ready(); });
+      } else {
+        park_cv_.wait_until(lk, deadline, [this] { return Ready(); });
+      }
+    }
+    parked_.store(false, std::memory_order_relaxed);
+  }
+
+  /// \return The number of ids the queue can hold.
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence_;
+    uint32_t ctx_id_;
+  };
+
+  bool Ready()
+  {
+    if (notified_.exchange(false, std::memory_order_acquire)) {
+      return true;
+    }
+    return slots_[head_ & mask_].sequence_.load(std::memory_order_acquire) ==
+               head_ + 1 ||
+           spilled_.load(std::memory_order_acquire);
+  }
+
+  bool TryPopSpilled(uint32_t* ctx_id)
+  {
+    if (!spilled_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lk(spill_mtx_);
+    if (spill_.empty()) {
+      return false;
+    }
+    *ctx_id = spill_.back();
+    spill_.pop_back();
+    spilled_.store(!spill_.empty(), std::memory_order_release);
+    return true;
+  }
+
+  void Unpark()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      // Taking the lock orders the push before the owner's last check
+      { std::lock_guard<std::mutex> lk(park_mtx_); }
+      park_cv_.notify_one();
+    }
+  }
+
+  size_t capacity_;
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Only touched by the owner
+  size_t head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+
+  alignas(64) std::atomic<bool> parked_{false};
+  std::atomic<bool> notified_{false};
+  std::mutex park_mtx_;
+  std::condition_variable park_cv_;
+
+  std::atomic<bool> spilled_{false};
+  std::mutex spill_mtx_;
+  std::vector<uint32_t> spill_;
+};
+
+}}  // namespace triton::perfanalyzer
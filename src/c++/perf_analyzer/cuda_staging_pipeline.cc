@@ -0,0 +1,176 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "cuda_staging_pipeline.h"
+
+#ifdef TRITON_ENABLE_GPU
+
+#include <cstring>
+#include <iostream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+cb::Error
+CudaError(const std::string& what, cudaError_t cuda_err)
+{
+  return cb::Error(
+      what + ": " + std::string(cudaGetErrorString(cuda_err)),
+      pa::GENERIC_ERROR);
+}
+
+}  // namespace
+
+CudaStagingPipeline::CudaStagingPipeline(size_t lane_count, int device_id)
+    : device_id_(device_id), lanes_(lane_count)
+{
+}
+
+CudaStagingPipeline::~CudaStagingPipeline()
+{
+  for (auto& lane : lanes_) {
+    if (lane.stream_ != nullptr) {
+      cudaStreamSynchronize(lane.stream_);
+      cudaStreamDestroy(lane.stream_);
+    }
+    if (lane.pinned_ != nullptr) {
+      cudaError_t cuda_err = cudaFreeHost(lane.pinned_);
+      if (cuda_err != cudaSuccess) {
+        std::cerr << "Unable to free pinned staging buffer of "
+                  << lane.pinned_size_
+                  << " bytes, Details: " << cudaGetErrorString(cuda_err)
+                  << std::endl;
+      }
+    }
+  }
+}
+
+cb::Error
+CudaStagingPipeline::Init()
+{
+  cudaError_t cuda_err = cudaSetDevice(device_id_);
+  if (cuda_err != cudaSuccess) {
+    return CudaError("unable to set the staging device", cuda_err);
+  }
+  for (size_t i = 0; i < lanes_.size(); i++) {
+    cuda_err =
+        cudaStreamCreateWithFlags(&lanes_[i].stream_, cudaStreamNonBlocking);
+    if (cuda_err != cudaSuccess) {
+      return CudaError("unable to create a staging stream", cuda_err);
+    }
+    free_lanes_.push_back(i);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+CudaStagingPipeline::Stage(const std::vector<CudaStagingCopy>& copies)
+{
+  size_t lane_index;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !free_lanes_.empty(); });
+    lane_index = free_lanes_.back();
+    free_lanes_.pop_back();
+  }
+
+  cb::Error err = StageOnLane(lanes_[lane_index], copies);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_lanes_.push_back(lane_index);
+  }
+  cv_.notify_one();
+  return err;
+}
+
+cb::Error
+CudaStagingPipeline::ReserveLane(Lane& lane, size_t byte_size)
+{
+  if (lane.pinned_size_ >= byte_size) {
+    return cb::Error::Success;
+  }
+  if (lane.pinned_ != nullptr) {
+    cudaFreeHost(lane.pinned_);
+    lane.pinned_ = nullptr;
+    lane.pinned_size_ = 0;
+  }
+  cudaError_t cuda_err = cudaHostAlloc(
+      reinterpret_cast<void**>(&lane.pinned_), byte_size,
+      cudaHostAllocDefault);
+  if (cuda_err != cudaSuccess) {
+    return CudaError(
+        "unable to allocate " + std::to_string(byte_size) +
+            " bytes of pinned staging memory",
+        cuda_err);
+  }
+  lane.pinned_size_ = byte_size;
+  return cb::Error::Success;
+}
+
+cb::Error
+CudaStagingPipeline::StageOnLane(
+    Lane& lane, const std::vector<CudaStagingCopy>& copies)
+{
+  // Each copy gets its own part of the pinned buffer, so that it does not
+  // have to wait for the DMA of the previous one before being packed
+  size_t total_size = 0;
+  for (const auto& copy : copies) {
+    for (const auto size : copy.byte_sizes_) {
+      total_size += size;
+    }
+  }
+  RETURN_IF_ERROR(ReserveLane(lane, total_size));
+
+  size_t pinned_offset = 0;
+  for (const auto& copy : copies) {
+    size_t copy_size = 0;
+    for (size_t i = 0; i < copy.data_ptrs_.size(); i++) {
+      memcpy(
+          lane.pinned_ + pinned_offset + copy_size, copy.data_ptrs_[i],
+          copy.byte_sizes_[i]);
+      copy_size += copy.byte_sizes_[i];
+    }
+    cudaError_t cuda_err = cudaMemcpyAsync(
+        copy.device_ptr_, lane.pinned_ + pinned_offset, copy_size,
+        cudaMemcpyHostToDevice, lane.stream_);
+    if (cuda_err != cudaSuccess) {
+      cudaStreamSynchronize(lane.stream_);
+      return CudaError("unable to queue a staging copy", cuda_err);
+    }
+    pinned_offset += copy_size;
+  }
+
+  cudaError_t cuda_err = cudaStreamSynchronize(lane.stream_);
+  if (cuda_err != cudaSuccess) {
+    return CudaError("failed to stage data to cuda shared memory", cuda_err);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
+
+#endif  // TRITON_ENABLE_GPU
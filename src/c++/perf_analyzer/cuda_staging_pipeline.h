@@ -0,0 +1,100 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#ifdef TRITON_ENABLE_GPU
+
+#include <cuda_runtime_api.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A copy of a batch of host data into a contiguous device buffer.
+struct CudaStagingCopy {
+  // The device buffer to fill
+  uint8_t* device_ptr_{nullptr};
+  // The host data of each batch entry, copied back to back
+  std::vector<const uint8_t*> data_ptrs_;
+  std::vector<size_t> byte_sizes_;
+};
+
+/// Stages host data into device memory through pinned host buffers.
+///
+/// Each lane pairs a pinned buffer with a CUDA stream of its own. A Stage()
+/// call takes a free lane, packs each copy into the pinned buffer and
+/// queues it on the stream with cudaMemcpyAsync(), so that packing the next
+/// copy overlaps with the DMA of the previous one. Calls from different
+/// threads use different lanes and so different streams, which lets the
+/// shared memory pool refresh device regions in the background while
+/// requests run against other slots. Stage() returns once its copies have
+/// completed, so the device data is ready to be used by a request.
+class CudaStagingPipeline {
+ public:
+  /// \param lane_count The number of lanes, ie the number of Stage() calls
+  /// that can be in progress at once.
+  /// \param device_id The device the streams are created on.
+  CudaStagingPipeline(size_t lane_count, int device_id = 0);
+
+  ~CudaStagingPipeline();
+
+  /// Creates the streams of the lanes. Must be called before Stage().
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Init();
+
+  /// Copies the host data of each copy into its device buffer. Blocks while
+  /// all lanes are in use.
+  /// \param copies The copies to make.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Stage(const std::vector<CudaStagingCopy>& copies);
+
+ private:
+  struct Lane {
+    cudaStream_t stream_{nullptr};
+    uint8_t* pinned_{nullptr};
+    size_t pinned_size_{0};
+  };
+
+  /// Grows the pinned buffer of a lane to hold at least byte_size bytes.
+  cb::Error ReserveLane(Lane& lane, size_t byte_size);
+
+  cb::Error StageOnLane(Lane& lane, const std::vector<CudaStagingCopy>& copies);
+
+  int device_id_;
+  std::vector<Lane> lanes_;
+  std::vector<size_t> free_lanes_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}}  // namespace triton::perfanalyzer
+
+#endif  // TRITON_ENABLE_GPU
@@ -34,17 +34,22 @@ cb::Error
 CustomLoadManager::Create(
     const bool async, const bool streaming,
     const uint64_t measurement_window_ms, const size_t max_trials,
-    const std::string& request_intervals_file, const int32_t batch_size,
+    const std::string& request_intervals_file,
+    const std::string& request_trace_file,
+    const std::string& schedule_replay_file, const int32_t batch_size,
     const size_t max_threads, const uint32_t num_of_sequences,
+    const bool precise_scheduling, const size_t num_dispatcher_threads,
     const SharedMemoryType shared_memory_type, const size_t output_shm_size,
     const std::shared_ptr<ModelParser>& parser,
     const std::shared_ptr<cb::ClientBackendFactory>& factory,
     std::unique_ptr<LoadManager>* manager)
 {
   std::unique_ptr<CustomLoadManager> local_manager(new CustomLoadManager(
-      async, streaming, request_intervals_file, batch_size,
-      measurement_window_ms, max_trials, max_threads, num_of_sequences,
-      shared_memory_type, output_shm_size, parser, factory));
+      async, streaming, request_intervals_file, request_trace_file,
+      schedule_replay_file, batch_size, measurement_window_ms, max_trials,
+      max_threads, num_of_sequences, precise_scheduling,
+      num_dispatcher_threads, shared_memory_type, output_shm_size, parser,
+      factory));
 
   *manager = std::move(local_manager);
 
@@ -53,17 +58,24 @@ CustomLoadManager::Create(
 
 CustomLoadManager::CustomLoadManager(
     const bool async, const bool streaming,
-    const std::string& request_intervals_file, int32_t batch_size,
+    const std::string& request_intervals_file,
+    const std::string& request_trace_file,
+    const std::string& schedule_replay_file, int32_t batch_size,
     const uint64_t measurement_window_ms, const size_t max_trials,
     const size_t max_threads, const uint32_t num_of_sequences,
+    const bool precise_scheduling, const size_t num_dispatcher_threads,
     const SharedMemoryType shared_memory_type, const size_t output_shm_size,
     const std::shared_ptr<ModelParser>& parser,
     const std::shared_ptr<cb::ClientBackendFactory>& factory)
     : RequestRateManager(
-          async, streaming, Distribution::CUSTOM, batch_size,
-          measurement_window_ms, max_trials, max_threads, num_of_sequences,
-          shared_memory_type, output_shm_size, parser, factory),
-      request_intervals_file_(request_intervals_file)
+          async, streaming, Distribution::CUSTOM, RateProfileSettings{},
+          batch_size, measurement_window_ms, max_trials, max_threads,
+          num_of_sequences,
+          precise_scheduling, num_dispatcher_threads, shared_memory_type,
+          output_shm_size, parser, factory),
+      request_intervals_file_(request_intervals_file),
+      request_trace_file_(request_trace_file),
+      schedule_replay_file_(schedule_replay_file)
 {
 }
 
@@ -79,6 +91,30 @@ CustomLoadManager::InitCustomIntervals()
 cb::Error
 CustomLoadManager::GenerateSchedule()
 {
+  if (!schedule_replay_file_.empty()) {
+    std::vector<RateSchedulePtr_t> worker_schedules;
+    RETURN_IF_ERROR(CreateReplayWorkerSchedules(&worker_schedules));
+    GiveSchedulesToWorkers(worker_schedules);
+    return cb::Error::Success;
+  }
+
+  if (!request_trace_file_.empty()) {
+    RETURN_IF_ERROR(RequestTrace::Open(request_trace_file_, &request_trace_));
+    if (request_trace_->MaxDataStreamId() >=
+        data_loader_->GetDataStreamsCount()) {
+      return cb::Error(
+          "request trace '" + request_trace_file_ +
+              "' uses input data stream " +
+              std::to_string(request_trace_->MaxDataStreamId()) +
+              " but only " +
+              std::to_string(data_loader_->GetDataStreamsCount()) +
+              " streams were provided",
+          pa::GENERIC_ERROR);
+    }
+    GiveSchedulesToWorkers(CreateTraceWorkerSchedules());
+    return cb::Error::Success;
+  }
+
   if (request_intervals_file_.empty()) {
     return cb::Error::Success;
   }
@@ -97,7 +133,7 @@ CustomLoadManager::CreateWorkerSchedules()
   std::vector<RateSchedulePtr_t> worker_schedules =
       CreateEmptyWorkerSchedules();
 
-  size_t num_workers = workers_.size();
+  size_t num_workers = worker_schedules.size();
   size_t num_loops_through_intervals = 0;
   size_t worker_index = 0;
   size_t intervals_index = 0;
@@ -112,7 +148,7 @@ CustomLoadManager::CreateWorkerSchedules()
     next_timestamp += custom_intervals_[intervals_index];
     worker_schedules[worker_index]->intervals.emplace_back(next_timestamp);
 
-    worker_index = (worker_index + 1) % workers_.size();
+    worker_index = (worker_index + 1) % num_workers;
     intervals_index = (intervals_index + 1) % custom_intervals_.size();
     if (intervals_index == 0) {
       num_loops_through_intervals++;
@@ -124,9 +160,88 @@ CustomLoadManager::CreateWorkerSchedules()
   return worker_schedules;
 }
 
+std::vector<RateSchedulePtr_t>
+CustomLoadManager::CreateTraceWorkerSchedules()
+{
+  std::vector<RateSchedulePtr_t> worker_schedules =
+      CreateEmptyWorkerSchedules();
+  for (size_t i = 0; i < worker_schedules.size(); i++) {
+    worker_schedules[i]->trace = std::make_shared<RequestTrace::Cursor>(
+        request_trace_, i, worker_schedules.size());
+  }
+  return worker_schedules;
+}
+
+cb::Error
+CustomLoadManager::CreateReplayWorkerSchedules(
+    std::vector<RateSchedulePtr_t>* worker_schedules)
+{
+  RETURN_IF_ERROR(
+      ScheduleRecorder::Read(schedule_replay_file_, &replay_records_));
+  if (replay_records_.size() < 2) {
+    return cb::Error(
+        "schedule '" + schedule_replay_file_ +
+            "' must hold at least two requests",
+        pa::GENERIC_ERROR);
+  }
+  const std::chrono::nanoseconds span = replay_records_.back().timestamp_;
+  if (span.count() == 0) {
+    return cb::Error(
+        "requests in '" + schedule_replay_file_ +
+            "' must span a non-zero amount of time",
+        pa::GENERIC_ERROR);
+  }
+  // Loop after a pause equal to the mean gap between the requests, like a
+  // request trace
+  replay_duration_ = span + span / (replay_records_.size() - 1);
+
+  for (const auto& record : replay_records_) {
+    if ((record.data_stream_id_ >= data_loader_->GetDataStreamsCount()) ||
+        (record.data_step_id_ >=
+         data_loader_->GetTotalSteps(record.data_stream_id_))) {
+      return cb::Error(
+          "schedule '" + schedule_replay_file_ + "' uses step " +
+              std::to_string(record.data_step_id_) + " of input data stream " +
+              std::to_string(record.data_stream_id_) +
+              ", which the input data does not have",
+          pa::GENERIC_ERROR);
+    }
+  }
+
+  *worker_schedules = CreateEmptyWorkerSchedules();
+  const size_t num_schedules = worker_schedules->size();
+  for (const auto& record : replay_records_) {
+    (*worker_schedules)[record.worker_ % num_schedules]->replay.push_back(
+        record);
+  }
+  for (size_t i = 0; i < num_schedules; i++) {
+    if ((*worker_schedules)[i]->replay.empty()) {
+      return cb::Error(
+          "schedule '" + schedule_replay_file_ +
+              "' has no requests for worker " + std::to_string(i) + " of " +
+              std::to_string(num_schedules) +
+              ", replay it with fewer worker or dispatcher threads",
+          pa::GENERIC_ERROR);
+    }
+    (*worker_schedules)[i]->duration = replay_duration_;
+  }
+  return cb::Error::Success;
+}
+
 cb::Error
 CustomLoadManager::GetCustomRequestRate(double* request_rate)
 {
+  if (!replay_records_.empty()) {
+    *request_rate = (replay_records_.size() * NANOS_PER_SECOND) /
+                    static_cast<double>(replay_duration_.count());
+    return cb::Error::Success;
+  }
+
+  if (request_trace_ != nullptr) {
+    *request_rate = request_trace_->RequestRate();
+    return cb::Error::Success;
+  }
+
   if (custom_intervals_.empty()) {
     return cb::Error("The custom intervals vector is empty", pa::GENERIC_ERROR);
   }
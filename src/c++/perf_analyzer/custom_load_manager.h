@@ -42,6 +42,10 @@ class TestCustomLoadManager;
 /// inference server in accordance with  user provided time intervals. This
 /// load manager can be used to model certain patterns of interest.
 ///
+/// It can also replay a timestamped request trace, for example one taken
+/// from production logs, including the input data stream of every request,
+/// or replay a schedule recorded by an earlier run exactly.
+///
 class CustomLoadManager : public RequestRateManager {
  public:
   ~CustomLoadManager() = default;
@@ -55,10 +59,20 @@ class CustomLoadManager : public RequestRateManager {
   /// \param max_trials The maximum number of windows that will be measured
   /// \param request_intervals_file The path to the file to use to pick up the
   /// time intervals between the successive requests.
+  /// \param request_trace_file The path to a timestamped request trace to
+  /// replay. Takes precedence over request_intervals_file if set.
+  /// \param schedule_replay_file The path to a schedule recorded by
+  /// ScheduleRecorder to replay. Takes precedence over the other files if
+  /// set.
   /// \param batch_size The batch size used for each request.
   /// \param max_threads The maximum number of working threads to be spawned.
   /// \param num_of_sequences The number of concurrent sequences that must be
   /// maintained on the server.
+  /// \param precise_scheduling Whether to wait for each scheduled send time
+  /// with a calibrated sleep and spin instead of a plain sleep.
+  /// \param num_dispatcher_threads The number of threads that follow the
+  /// schedule and release requests to whichever worker is free. If 0, each
+  /// worker follows its own share of the schedule.
   /// \param zero_input Whether to fill the input tensors with zero.
   /// \param input_shapes The shape of the input tensors.
   /// \param user_data The vector containing path/paths to user-provided data
@@ -74,8 +88,11 @@ class CustomLoadManager : public RequestRateManager {
   static cb::Error Create(
       const bool async, const bool streaming,
       const uint64_t measurement_window_ms, const size_t max_trials,
-      const std::string& request_intervals_file, const int32_t batch_size,
+      const std::string& request_intervals_file,
+      const std::string& request_trace_file,
+      const std::string& schedule_replay_file, const int32_t batch_size,
       const size_t max_threads, const uint32_t num_of_sequences,
+      const bool precise_scheduling, const size_t num_dispatcher_threads,
       const SharedMemoryType shared_memory_type, const size_t output_shm_size,
       const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
@@ -86,8 +103,8 @@ class CustomLoadManager : public RequestRateManager {
   /// \return cb::Error object indicating success or failure.
   cb::Error InitCustomIntervals();
 
-  /// Computes the request rate from the time interval file. Fails with an error
-  /// if the file is not present or is empty.
+  /// Computes the request rate from the time interval file or the request
+  /// trace. Fails with an error if the file is not present or is empty.
   /// \param request_rate Returns request rate as computed from the time
   /// interval file.
   /// \return cb::Error object indicating success or failure.
@@ -96,9 +113,12 @@ class CustomLoadManager : public RequestRateManager {
  private:
   CustomLoadManager(
       const bool async, const bool streaming,
-      const std::string& request_intervals_file, const int32_t batch_size,
+      const std::string& request_intervals_file,
+      const std::string& request_trace_file,
+      const std::string& schedule_replay_file, const int32_t batch_size,
       const uint64_t measurement_window_ms, const size_t max_trials,
       const size_t max_threads, const uint32_t num_of_sequences,
+      const bool precise_scheduling, const size_t num_dispatcher_threads,
       const SharedMemoryType shared_memory_type, const size_t output_shm_size,
       const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory);
@@ -107,6 +127,16 @@ class CustomLoadManager : public RequestRateManager {
 
   std::vector<RateSchedulePtr_t> CreateWorkerSchedules();
 
+  // Creates schedules that read every N-th request of the request trace,
+  // where N is the number of schedules
+  std::vector<RateSchedulePtr_t> CreateTraceWorkerSchedules();
+
+  // Creates schedules that replay the requests of the recorded schedule,
+  // each request on the schedule of the worker that sent it, modulo the
+  // number of schedules
+  cb::Error CreateReplayWorkerSchedules(
+      std::vector<RateSchedulePtr_t>* worker_schedules);
+
   /// Reads the time intervals file and stores intervals in vector
   /// \param path Filesystem path of the time intervals file.
   /// \param contents Output intervals vector.
@@ -116,6 +146,12 @@ class CustomLoadManager : public RequestRateManager {
 
   std::string request_intervals_file_;
   NanoIntervals custom_intervals_;
+  std::string request_trace_file_;
+  std::shared_ptr<RequestTrace> request_trace_;
+  std::string schedule_replay_file_;
+  std::vector<ScheduleRecord> replay_records_;
+  // The time after which the recorded schedule loops
+  std::chrono::nanoseconds replay_duration_{0};
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestCustomLoadManager;
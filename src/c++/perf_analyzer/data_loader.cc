@@ -26,12 +26,26 @@
 
 #include "data_loader.h"
 
-#include <b64/decode.h>
 #include <rapidjson/filereadstream.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <random>
+#include <thread>
 
 namespace triton { namespace perfanalyzer {
 
+namespace {
+
+// The threads reading the steps of a directory ahead of the requests. The
+// reads are mostly waiting on the storage, more threads keep more of them
+// in flight.
+constexpr size_t kDirectoryIoThreadCount{8};
+// The size of the pattern that deferred generated data repeats
+constexpr size_t kGeneratedPatternSize{1 << 20};
+
+}  // namespace
+
 DataLoader::DataLoader(const size_t batch_size)
     : batch_size_(batch_size), data_stream_cnt_(0)
 {
@@ -43,6 +57,17 @@ DataLoader::ReadDataFromDir(
     const std::shared_ptr<ModelTensorMap>& outputs,
     const std::string& data_directory)
 {
+  if (prefetch_steps_ != 0) {
+    // Validation outputs are not read from the steps
+    RETURN_IF_ERROR(DirectoryDataset::Open(
+        data_directory, *inputs, prefetch_steps_,
+        std::min(prefetch_steps_, kDirectoryIoThreadCount),
+        &directory_dataset_));
+    data_stream_cnt_ = 1;
+    step_num_.push_back(directory_dataset_->StepCount());
+    return cb::Error::Success;
+  }
+
   // Directory structure supports only a single data stream and step
   data_stream_cnt_ = 1;
   step_num_.push_back(1);
@@ -120,6 +145,8 @@ DataLoader::ReadDataFromDir(
       SerializeStringTensor(output_string_data, &it->second);
     }
   }
+
+  BuildIndexes(inputs, outputs);
   return cb::Error::Success;
 }
 
@@ -180,6 +207,9 @@ DataLoader::ParseData(
     }
   }
 
+  // Only the layout of the data is read here, the tensors of every step are
+  // read afterwards so that they can be decoded in parallel
+  std::vector<TensorReadJob> jobs;
   int count = streams.Size();
 
   data_stream_cnt_ += count;
@@ -191,7 +221,7 @@ DataLoader::ParseData(
     if (steps.IsArray()) {
       step_num_.push_back(steps.Size());
       for (size_t k = 0; k < step_num_[i]; k++) {
-        RETURN_IF_ERROR(ReadTensorData(steps[k], inputs, i, k, true));
+        jobs.push_back({&steps[k], (int)i, (int)k, true});
       }
 
       if (output_steps != nullptr) {
@@ -203,8 +233,7 @@ DataLoader::ParseData(
               pa::GENERIC_ERROR);
         }
         for (size_t k = 0; k < step_num_[i]; k++) {
-          RETURN_IF_ERROR(
-              ReadTensorData((*output_steps)[k], outputs, i, k, false));
+          jobs.push_back({&(*output_steps)[k], (int)i, (int)k, false});
         }
       }
     } else {
@@ -219,33 +248,233 @@ DataLoader::ParseData(
       }
       data_stream_cnt_ = 1;
       for (size_t k = offset; k < step_num_[0]; k++) {
-        RETURN_IF_ERROR(
-            ReadTensorData(streams[k - offset], inputs, 0, k, true));
+        jobs.push_back({&streams[k - offset], 0, (int)k, true});
       }
 
       if (out_streams != nullptr) {
         for (size_t k = offset; k < step_num_[0]; k++) {
-          RETURN_IF_ERROR(
-              ReadTensorData((*out_streams)[k - offset], outputs, 0, k, false));
+          jobs.push_back({&(*out_streams)[k - offset], 0, (int)k, false});
         }
       }
       break;
     }
   }
 
+  return ReadTensorDataInParallel(jobs, inputs, outputs);
+}
+
+cb::Error
+DataLoader::ReadTensorDataInParallel(
+    const std::vector<TensorReadJob>& jobs,
+    const std::shared_ptr<ModelTensorMap>& inputs,
+    const std::shared_ptr<ModelTensorMap>& outputs)
+{
+  const size_t thread_count = std::max<size_t>(
+      1, std::min<size_t>(std::thread::hardware_concurrency(), jobs.size()));
+
+  // Every thread reads a contiguous range of the steps into maps of its own,
+  // so the first error of the first thread that failed is the first error in
+  // the document
+  std::vector<TensorDataMaps> input_maps(thread_count);
+  std::vector<TensorDataMaps> output_maps(thread_count);
+  std::vector<cb::Error> errors(thread_count, cb::Error::Success);
+  auto read_range = [&](size_t t) {
+    const size_t end = jobs.size() * (t + 1) / thread_count;
+    for (size_t j = jobs.size() * t / thread_count; j < end; j++) {
+      const TensorReadJob& job = jobs[j];
+      errors[t] = ReadTensorData(
+          *job.step_, job.is_input_ ? inputs : outputs, job.stream_index_,
+          job.step_index_, job.is_input_ ? &input_maps[t] : &output_maps[t]);
+      if (!errors[t].IsOk()) {
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < thread_count; t++) {
+    threads.emplace_back(read_range, t);
+  }
+  read_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < thread_count; t++) {
+    RETURN_IF_ERROR(errors[t]);
+  }
+  for (size_t t = 0; t < thread_count; t++) {
+    input_data_.merge(input_maps[t].data_);
+    input_shapes_.merge(input_maps[t].shapes_);
+    output_data_.merge(output_maps[t].data_);
+    output_shapes_.merge(output_maps[t].shapes_);
+  }
 
+  BuildIndexes(inputs, outputs);
   return cb::Error::Success;
 }
 
+void
+DataLoader::BuildIndexes(
+    const std::shared_ptr<ModelTensorMap>& inputs,
+    const std::shared_ptr<ModelTensorMap>& outputs)
+{
+  stream_first_step_.clear();
+  size_t total_steps = 0;
+  for (size_t i = 0; i < data_stream_cnt_; i++) {
+    stream_first_step_.push_back(total_steps);
+    total_steps += step_num_[i];
+  }
+
+  BuildIndex(*inputs, input_data_, input_shapes_, &input_index_);
+  if (outputs != nullptr) {
+    BuildIndex(*outputs, output_data_, output_shapes_, &output_index_);
+  }
+}
+
+void
+DataLoader::BuildIndex(
+    const ModelTensorMap& tensors,
+    const std::unordered_map<std::string, std::vector<char>>& tensor_data,
+    const std::unordered_map<std::string, std::vector<int64_t>>& tensor_shape,
+    TensorIndex* index)
+{
+  index->ids_.clear();
+  index->entries_.clear();
+  if (tensor_data.empty() && tensor_shape.empty()) {
+    return;
+  }
+
+  for (const auto& tensor : tensors) {
+    index->ids_.emplace(tensor.first, index->entries_.size());
+    index->entries_.emplace_back();
+    auto& entries = index->entries_.back();
+    for (size_t i = 0; i < data_stream_cnt_; i++) {
+      for (size_t k = 0; k < step_num_[i]; k++) {
+        std::string key_name(
+            tensor.first + "_" + std::to_string(i) + "_" + std::to_string(k));
+        TensorEntry entry;
+        auto it = tensor_data.find(key_name);
+        if (it != tensor_data.end()) {
+          entry.data_ = (const uint8_t*)it->second.data();
+          entry.byte_size_ = it->second.size();
+          entry.has_data_ = true;
+        }
+        auto shape_it = tensor_shape.find(key_name);
+        if (shape_it != tensor_shape.end()) {
+          entry.shape_ = &shape_it->second;
+        }
+        entries.push_back(entry);
+      }
+    }
+  }
+}
+
+const DataLoader::TensorEntry*
+DataLoader::FindEntry(
+    const TensorIndex& index, const std::string& name, const int stream_id,
+    const int step_id) const
+{
+  if ((stream_id < 0) || ((size_t)stream_id >= stream_first_step_.size()) ||
+      (step_id < 0) || ((size_t)step_id >= step_num_[stream_id])) {
+    return nullptr;
+  }
+  auto it = index.ids_.find(name);
+  if (it == index.ids_.end()) {
+    return nullptr;
+  }
+  return &index.entries_[it->second][stream_first_step_[stream_id] + step_id];
+}
+
+cb::Error
+DataLoader::ReadDataFromCorpus(
+    const std::shared_ptr<ModelTensorMap>& inputs,
+    const std::shared_ptr<ModelTensorMap>& outputs,
+    const std::string& corpus_file)
+{
+  RETURN_IF_ERROR(InputCorpus::Open(corpus_file, &corpus_));
+
+  data_stream_cnt_ = corpus_->StreamCount();
+  step_num_.clear();
+  for (size_t i = 0; i < data_stream_cnt_; i++) {
+    step_num_.push_back(corpus_->StepCount(i));
+  }
+
+  // Only the entry table is read here, the data itself is paged in as the
+  // requests use it
+  for (const auto& input : *inputs) {
+    for (size_t i = 0; i < data_stream_cnt_; i++) {
+      for (size_t k = 0; k < step_num_[i]; k++) {
+        InputCorpusTensor tensor;
+        if (!corpus_->Find(input.first, true, i, k, &tensor)) {
+          if (input.second.is_optional_ == false) {
+            return cb::Error(
+                "missing tensor " + input.first +
+                    " ( Location stream id: " + std::to_string(i) +
+                    ", step id: " + std::to_string(k) + ")",
+                pa::GENERIC_ERROR);
+          }
+          continue;
+        }
+        if (!tensor.has_shape_ && ElementCount(input.second.shape_) < 0) {
+          return cb::Error(
+              "The variable-sized tensor \"" + input.second.name_ +
+                  "\" is missing shape, see --shape option.",
+              pa::GENERIC_ERROR);
+        }
+      }
+    }
+  }
+
+  return cb::Error::Success;
+}
+
+cb::Error
+DataLoader::WriteCorpus(
+    const std::shared_ptr<ModelTensorMap>& inputs,
+    const std::shared_ptr<ModelTensorMap>& outputs,
+    const std::string& corpus_file)
+{
+  std::vector<std::pair<std::string, bool>> tensors;
+  for (const auto& input : *inputs) {
+    tensors.emplace_back(input.first, true);
+  }
+  for (const auto& output : *outputs) {
+    tensors.emplace_back(output.first, false);
+  }
+
+  auto lookup = [this](
+                    size_t stream_index, size_t step_index,
+                    const std::string& name, bool is_input,
+                    const std::vector<char>** data,
+                    const std::vector<int64_t>** shape) {
+    const auto& tensor_data = is_input ? input_data_ : output_data_;
+    const auto& tensor_shape = is_input ? input_shapes_ : output_shapes_;
+    std::string key_name(
+        name + "_" + std::to_string(stream_index) + "_" +
+        std::to_string(step_index));
+    auto it = tensor_data.find(key_name);
+    if (it == tensor_data.end()) {
+      return false;
+    }
+    *data = &it->second;
+    auto shape_it = tensor_shape.find(key_name);
+    *shape = (shape_it == tensor_shape.end()) ? nullptr : &shape_it->second;
+    return true;
+  };
+
+  return InputCorpus::Write(corpus_file, tensors, step_num_, lookup);
+}
+
 cb::Error
 DataLoader::GenerateData(
     std::shared_ptr<ModelTensorMap> inputs, const bool zero_input,
     const size_t string_length, const std::string& string_data)
 {
-  // Data generation supports only a single data stream and step
-  // Not supported for inputs with dynamic shapes
+  // Data generation supports only a single data stream. It has a single
+  // step too, unless the shapes of the inputs are drawn from distributions,
+  // and is not supported for inputs with dynamic shapes otherwise.
   data_stream_cnt_ = 1;
-  step_num_.push_back(1);
 
   // Validate the absence of shape tensors
   for (const auto& input : *inputs) {
@@ -257,21 +486,44 @@ DataLoader::GenerateData(
     }
   }
 
+  // The tensors of a batch must have the same shape, so each drawn shape is
+  // kept for as many steps as there are requests in a batch
+  const size_t batch_steps = std::max<size_t>(batch_size_, 1);
+  if (shape_distributions_.empty()) {
+    step_num_.push_back(1);
+  } else {
+    RETURN_IF_ERROR(DrawShapes(inputs, batch_steps));
+    step_num_.push_back(shape_count_ * batch_steps);
+  }
+
   uint64_t max_input_byte_size = 0;
+  // Random strings are seeded by the position of their input, so the data
+  // is the same from run to run
+  uint64_t seed = 0;
   for (const auto& input : *inputs) {
+    seed++;
     if (input.second.datatype_.compare("BYTES") != 0) {
-      int64_t byte_size = ByteSize(input.second.shape_, input.second.datatype_);
-      if (byte_size < 0) {
-        return cb::Error(
-            "input " + input.second.name_ +
-                " contains dynamic shape, provide shapes to send along with "
-                "the request",
-            pa::GENERIC_ERROR);
+      // All the steps are served from the start of the same buffer, which
+      // must hold the largest of them
+      for (size_t step = 0; step < step_num_[0]; step++) {
+        const auto shape_it = input_shapes_.find(
+            input.second.name_ + "_0_" + std::to_string(step));
+        int64_t byte_size = ByteSize(
+            (shape_it != input_shapes_.end()) ? shape_it->second
+                                              : input.second.shape_,
+            input.second.datatype_);
+        if (byte_size < 0) {
+          return cb::Error(
+              "input " + input.second.name_ +
+                  " contains dynamic shape, provide shapes to send along "
+                  "with the request",
+              pa::GENERIC_ERROR);
+        }
+        max_input_byte_size =
+            std::max(max_input_byte_size, (size_t)byte_size);
       }
-      max_input_byte_size = std::max(max_input_byte_size, (size_t)byte_size);
     } else {
       // Generate string input and store it into map
-      std::vector<std::string> input_string_data;
       int64_t batch1_num_strings = ElementCount(input.second.shape_);
       if (batch1_num_strings == -1) {
         return cb::Error(
@@ -280,22 +532,28 @@ DataLoader::GenerateData(
                 "the request",
             pa::GENERIC_ERROR);
       }
-      input_string_data.resize(batch1_num_strings);
-      if (!string_data.empty()) {
-        for (size_t i = 0; i < batch1_num_strings; i++) {
-          input_string_data[i] = string_data;
-        }
-      } else {
-        for (size_t i = 0; i < batch1_num_strings; i++) {
-          input_string_data[i] = GetRandomString(string_length);
-        }
-      }
 
       std::string key_name(
           input.second.name_ + "_" + std::to_string(0) + "_" +
           std::to_string(0));
       auto it = input_data_.emplace(key_name, std::vector<char>()).first;
-      SerializeStringTensor(input_string_data, &it->second);
+      if (!string_data.empty()) {
+        std::vector<std::string> input_string_data(
+            batch1_num_strings, string_data);
+        SerializeStringTensor(input_string_data, &it->second);
+      } else {
+        // The strings are generated in place in their serialized form, the
+        // length prefixes overwriting the characters drawn for them
+        const size_t element_size = sizeof(uint32_t) + string_length;
+        std::vector<char>& serialized = it->second;
+        serialized.resize(batch1_num_strings * element_size);
+        FillRandomCharacters(seed, serialized.data(), serialized.size());
+        const uint32_t len = string_length;
+        for (size_t i = 0; i < batch1_num_strings; i++) {
+          std::memcpy(
+              serialized.data() + i * element_size, &len, sizeof(uint32_t));
+        }
+      }
     }
   }
 
@@ -303,51 +561,139 @@ DataLoader::GenerateData(
   // initialized buffer that is large enough to provide the largest
   // needed input. We (re)use this buffer for all non-string input values.
   if (max_input_byte_size > 0) {
+    const size_t buf_size =
+        defer_generated_data_
+            ? std::min<size_t>(max_input_byte_size, kGeneratedPatternSize)
+            : max_input_byte_size;
     if (zero_input) {
-      input_buf_.resize(max_input_byte_size, 0);
+      input_buf_.resize(buf_size, 0);
     } else {
-      input_buf_.resize(max_input_byte_size);
-      for (auto& byte : input_buf_) {
-        byte = rand();
+      input_buf_.resize(buf_size);
+      FillRandomBytes(
+          0, reinterpret_cast<char*>(input_buf_.data()), input_buf_.size());
+    }
+  }
+
+  BuildIndexes(inputs, nullptr);
+
+  // The generated strings are the same in every step, so the steps share
+  // those of the first one
+  for (auto& entries : input_index_.entries_) {
+    for (size_t step = 1; step < entries.size(); step++) {
+      if (!entries[step].has_data_) {
+        entries[step].data_ = entries[0].data_;
+        entries[step].byte_size_ = entries[0].byte_size_;
+        entries[step].has_data_ = entries[0].has_data_;
       }
     }
   }
+  return cb::Error::Success;
+}
 
+cb::Error
+DataLoader::DrawShapes(
+    const std::shared_ptr<ModelTensorMap>& inputs, const size_t batch_steps)
+{
+  for (const auto& distribution : shape_distributions_) {
+    const auto input_it = inputs->find(distribution->InputName());
+    if (input_it == inputs->end()) {
+      return cb::Error(
+          "can not draw the shape of unknown input '" +
+              distribution->InputName() + "'",
+          pa::GENERIC_ERROR);
+    }
+    if (input_it->second.datatype_.compare("BYTES") == 0) {
+      return cb::Error(
+          "can not draw the shape of BYTES input '" +
+              distribution->InputName() + "'",
+          pa::GENERIC_ERROR);
+    }
+    if (distribution->Dimension() >= input_it->second.shape_.size()) {
+      return cb::Error(
+          "input '" + distribution->InputName() + "' has no dimension " +
+              std::to_string(distribution->Dimension()),
+          pa::GENERIC_ERROR);
+    }
+  }
+
+  // A fixed seed, so that every run sends the same shapes
+  std::mt19937 rng(0);
+  for (size_t shape = 0; shape < shape_count_; shape++) {
+    std::unordered_map<std::string, std::vector<int64_t>> drawn;
+    for (const auto& distribution : shape_distributions_) {
+      const std::string& name = distribution->InputName();
+      auto& dims = drawn.emplace(name, (*inputs)[name].shape_).first->second;
+      dims[distribution->Dimension()] = distribution->Draw(rng);
+    }
+    for (const auto& input_shape : drawn) {
+      for (size_t i = 0; i < batch_steps; i++) {
+        input_shapes_[input_shape.first + "_0_" +
+                      std::to_string(shape * batch_steps + i)] =
+            input_shape.second;
+      }
+    }
+  }
   return cb::Error::Success;
 }
 
 cb::Error
 DataLoader::GetInputData(
     const ModelTensor& input, const int stream_id, const int step_id,
-    const uint8_t** data_ptr, size_t* batch1_size)
+    const uint8_t** data_ptr, size_t* batch1_size,
+    DirectoryDataset::TensorData* holder)
 {
   bool data_found = false;
 
+  if (directory_dataset_ != nullptr) {
+    RETURN_IF_ERROR(ValidateIndexes(stream_id, step_id));
+    if (holder == nullptr) {
+      return cb::Error(
+          "the input data is streamed from the data directory and can not be "
+          "staged, e.g. in shared memory",
+          pa::GENERIC_ERROR);
+    }
+
+    RETURN_IF_ERROR(directory_dataset_->Get(input.name_, step_id, holder));
+    if (*holder != nullptr) {
+      *batch1_size = (*holder)->size();
+      *data_ptr = reinterpret_cast<const uint8_t*>((*holder)->data());
+      data_found = true;
+    }
+  }
+
+  if (corpus_ != nullptr) {
+    RETURN_IF_ERROR(ValidateIndexes(stream_id, step_id));
+
+    InputCorpusTensor tensor;
+    if (corpus_->Find(
+            input.name_, true, CorpusStream(stream_id), step_id, &tensor)) {
+      *batch1_size = tensor.byte_size_;
+      *data_ptr = tensor.data_;
+      data_found = true;
+    }
+  }
+
   // If json data is available then try to retrieve the data from there
-  if (!input_data_.empty()) {
+  if (!input_index_.entries_.empty()) {
     RETURN_IF_ERROR(ValidateIndexes(stream_id, step_id));
 
-    std::string key_name(
-        input.name_ + "_" + std::to_string(stream_id) + "_" +
-        std::to_string(step_id));
     // Get the data and the corresponding byte-size
-    auto it = input_data_.find(key_name);
-    if (it != input_data_.end()) {
-      if (input.datatype_.compare("BYTES") != 0) {
-        *batch1_size = it->second.size();
-      } else {
-        std::vector<char>* string_data;
-        string_data = &it->second;
-        *batch1_size = string_data->size();
-      }
-      *data_ptr = (const uint8_t*)&((it->second)[0]);
+    const TensorEntry* entry =
+        FindEntry(input_index_, input.name_, stream_id, step_id);
+    if ((entry != nullptr) && entry->has_data_) {
+      *batch1_size = entry->byte_size_;
+      *data_ptr = entry->data_;
       data_found = true;
     }
   }
 
   if (!data_found) {
     if ((input.datatype_.compare("BYTES") != 0) && (input_buf_.size() != 0)) {
-      int64_t byte_size = ByteSize(input.shape_, input.datatype_);
+      // The generated data of a step is the start of the shared buffer, as
+      // much of it as the shape of the step needs
+      std::vector<int64_t> shape;
+      RETURN_IF_ERROR(GetInputShape(input, stream_id, step_id, &shape));
+      int64_t byte_size = ByteSize(shape, input.datatype_);
       if (byte_size < 0) {
         return cb::Error(
             "failed to get correct byte size for '" + input.name_ + "'.",
@@ -375,23 +721,64 @@ DataLoader::GetOutputData(
 {
   *data_ptr = nullptr;
   *batch1_size = 0;
+  if (corpus_ != nullptr) {
+    RETURN_IF_ERROR(ValidateIndexes(stream_id, step_id));
+
+    InputCorpusTensor tensor;
+    if (corpus_->Find(
+            output_name, false, CorpusStream(stream_id), step_id, &tensor)) {
+      *batch1_size = tensor.byte_size_;
+      *data_ptr = tensor.data_;
+    }
+    return cb::Error::Success;
+  }
+
   // If json data is available then try to retrieve the data from there
-  if (!output_data_.empty()) {
+  if (!output_index_.entries_.empty()) {
     RETURN_IF_ERROR(ValidateIndexes(stream_id, step_id));
 
-    std::string key_name(
-        output_name + "_" + std::to_string(stream_id) + "_" +
-        std::to_string(step_id));
     // Get the data and the corresponding byte-size
-    auto it = output_data_.find(key_name);
-    if (it != output_data_.end()) {
-      *batch1_size = it->second.size();
-      *data_ptr = (const uint8_t*)&((it->second)[0]);
+    const TensorEntry* entry =
+        FindEntry(output_index_, output_name, stream_id, step_id);
+    if ((entry != nullptr) && entry->has_data_) {
+      *batch1_size = entry->byte_size_;
+      *data_ptr = entry->data_;
     }
   }
   return cb::Error::Success;
 }
 
+cb::Error
+DataLoader::ShardStreams(const size_t shard_index, const size_t shard_count)
+{
+  if ((directory_dataset_ != nullptr) || (shard_index >= shard_count) ||
+      (shard_count > data_stream_cnt_)) {
+    return cb::Error(
+        "can not split " + std::to_string(data_stream_cnt_) +
+            " data streams into " + std::to_string(shard_count) + " shards",
+        pa::GENERIC_ERROR);
+  }
+
+  // The json data stays where it is, only the streams that index it change
+  std::vector<size_t> step_num;
+  std::vector<size_t> stream_first_step;
+  std::vector<size_t> corpus_streams;
+  for (size_t i = shard_index; i < data_stream_cnt_; i += shard_count) {
+    step_num.push_back(step_num_[i]);
+    if (!stream_first_step_.empty()) {
+      stream_first_step.push_back(stream_first_step_[i]);
+    }
+    if (corpus_ != nullptr) {
+      corpus_streams.push_back(CorpusStream(i));
+    }
+  }
+  data_stream_cnt_ = step_num.size();
+  step_num_ = std::move(step_num);
+  stream_first_step_ = std::move(stream_first_step);
+  corpus_streams_ = std::move(corpus_streams);
+  return cb::Error::Success;
+}
+
 cb::Error
 DataLoader::ValidateIndexes(int stream_id, int step_id)
 {
@@ -418,17 +805,25 @@ DataLoader::GetInputShape(
     const ModelTensor& input, const int stream_id, const int step_id,
     std::vector<int64_t>* provided_shape)
 {
-  std::string key_name(
-      input.name_ + "_" + std::to_string(stream_id) + "_" +
-      std::to_string(step_id));
-
   provided_shape->clear();
 
+  if (corpus_ != nullptr) {
+    InputCorpusTensor tensor;
+    if (corpus_->Find(
+            input.name_, true, CorpusStream(stream_id), step_id, &tensor) &&
+        tensor.has_shape_) {
+      provided_shape->assign(
+          tensor.shape_, tensor.shape_ + tensor.shape_rank_);
+      return cb::Error::Success;
+    }
+  }
+
   // Prefer the values read from file over the ones provided from
   // CLI
-  auto it = input_shapes_.find(key_name);
-  if (it != input_shapes_.end()) {
-    *provided_shape = it->second;
+  const TensorEntry* entry =
+      FindEntry(input_index_, input.name_, stream_id, step_id);
+  if ((entry != nullptr) && (entry->shape_ != nullptr)) {
+    *provided_shape = *entry->shape_;
   } else {
     *provided_shape = input.shape_;
   }
@@ -439,10 +834,10 @@ cb::Error
 DataLoader::ReadTensorData(
     const rapidjson::Value& step,
     const std::shared_ptr<ModelTensorMap>& tensors, const int stream_index,
-    const int step_index, const bool is_input)
+    const int step_index, TensorDataMaps* maps)
 {
-  auto& tensor_data = is_input ? input_data_ : output_data_;
-  auto& tensor_shape = is_input ? input_shapes_ : output_shapes_;
+  auto& tensor_data = maps->data_;
+  auto& tensor_shape = maps->shapes_;
   for (const auto& io : *tensors) {
     if (step.HasMember(io.first.c_str())) {
       std::string key_name(
@@ -491,16 +886,13 @@ DataLoader::ReadTensorData(
 
       if (content->IsArray()) {
         RETURN_IF_ERROR(SerializeExplicitTensor(
-            *content, io.second.datatype_, &it->second));
+            *content, ParseDataType(io.second.datatype_), &it->second));
       } else {
         if (content->HasMember("b64")) {
           if ((*content)["b64"].IsString()) {
-            const std::string& encoded = (*content)["b64"].GetString();
-            it->second.resize(encoded.length());
-            base64::decoder D;
-            int size =
-                D.decode(encoded.c_str(), encoded.length(), &it->second[0]);
-            it->second.resize(size);
+            const rapidjson::Value& encoded = (*content)["b64"];
+            DecodeBase64(
+                encoded.GetString(), encoded.GetStringLength(), &it->second);
 
             int64_t batch1_byte;
             auto shape_it = tensor_shape.find(key_name);
@@ -26,8 +26,11 @@
 #pragma once
 
 #include <fstream>
+#include "directory_dataset.h"
+#include "input_corpus.h"
 #include "model_parser.h"
 #include "perf_utils.h"
+#include "shape_distribution.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -53,7 +56,9 @@ class DataLoader {
     return 0;
   }
 
-  /// Reads the input data from the specified data directory.
+  /// Reads the input data from the specified data directory. With
+  /// prefetching, see SetPrefetchSteps(), the directory holds a subdirectory
+  /// per step that is read while the requests are sent.
   /// \param inputs The pointer to the map holding the information about
   /// input tensors of a model
   /// \param data_directory The path to the directory containing the data
@@ -73,6 +78,91 @@ class DataLoader {
       const std::shared_ptr<ModelTensorMap>& outputs,
       const std::string& json_file);
 
+  /// Maps the input data from the specified binary input corpus. The data
+  /// is served from the mapping instead of being copied.
+  /// \param inputs The pointer to the map holding the information about
+  /// input tensors of a model
+  /// \param outputs The pointer to the map holding the information about
+  /// output tensors of a model
+  /// \param corpus_file The input corpus file, see InputCorpus.
+  /// Returns error object indicating status
+  cb::Error ReadDataFromCorpus(
+      const std::shared_ptr<ModelTensorMap>& inputs,
+      const std::shared_ptr<ModelTensorMap>& outputs,
+      const std::string& corpus_file);
+
+  /// Writes the data that has been read to a binary input corpus, so that
+  /// later runs can map it with ReadDataFromCorpus.
+  /// \param inputs The pointer to the map holding the information about
+  /// input tensors of a model
+  /// \param outputs The pointer to the map holding the information about
+  /// output tensors of a model
+  /// \param corpus_file The input corpus file to write.
+  /// Returns error object indicating status
+  cb::Error WriteCorpus(
+      const std::shared_ptr<ModelTensorMap>& inputs,
+      const std::shared_ptr<ModelTensorMap>& outputs,
+      const std::string& corpus_file);
+
+  /// Makes GenerateData() draw the shapes of some inputs from the given
+  /// distributions, instead of sending the same shape in every request.
+  /// Must be called before GenerateData().
+  /// \param distributions The distributions of the dimensions to vary.
+  /// \param shape_count The number of shapes to draw. Each is a data step
+  /// that the requests go through in turn.
+  void SetShapeDistributions(
+      const std::vector<std::shared_ptr<const ShapeDistribution>>&
+          distributions,
+      const size_t shape_count)
+  {
+    shape_distributions_ = distributions;
+    shape_count_ = shape_count;
+  }
+
+  /// Makes ReadDataFromDir() read a directory with a subdirectory per step,
+  /// only the given number of steps ahead of the requests instead of all of
+  /// them upfront. Must be called before ReadDataFromDir().
+  /// \param prefetch_steps The number of steps to read ahead, 0 to read the
+  /// single step directory layout.
+  void SetPrefetchSteps(const size_t prefetch_steps)
+  {
+    prefetch_steps_ = prefetch_steps;
+  }
+  size_t PrefetchSteps() const { return prefetch_steps_; }
+
+  /// Keeps only the data streams of one shard, so that the clients sharing
+  /// a load send different data. Stream i of the shard is stream
+  /// 'shard_index + i * shard_count' of the data. Must be called after the
+  /// data is read, from json files or an input corpus.
+  /// \param shard_index The shard to keep.
+  /// \param shard_count The number of shards, at most the number of data
+  /// streams.
+  /// \return Error object indicating status.
+  cb::Error ShardStreams(const size_t shard_index, const size_t shard_count);
+
+  /// \return Whether the input data is read while the requests are sent,
+  /// in which case GetInputData() hands out the buffers of the data.
+  bool IsStreamed() const { return directory_dataset_ != nullptr; }
+
+  /// Makes GenerateData() only generate the start of the non-string data,
+  /// which the rest of the data repeats, for users that fill the data in
+  /// themselves, such as on the GPU, rather than copy it from the host.
+  /// GetInputData() then returns this pattern, which may be shorter than
+  /// the data, see IsDeferredData(). Must be called before GenerateData().
+  void DeferGeneratedData() { defer_generated_data_ = true; }
+
+  /// \param data_ptr Data returned by GetInputData().
+  /// \return Whether the data is the pattern of generated data that its user
+  /// must repeat to the size of the data, see DeferGeneratedData().
+  bool IsDeferredData(const uint8_t* data_ptr) const
+  {
+    return defer_generated_data_ && !input_buf_.empty() &&
+           (data_ptr == input_buf_.data());
+  }
+
+  /// \return The pattern that deferred generated data repeats.
+  const std::vector<uint8_t>& GeneratedPattern() const { return input_buf_; }
+
   /// Generates the input data to use with the inference requests
   /// \param inputs The pointer to the map holding the information about
   /// input tensors of a model
@@ -93,10 +183,14 @@ class DataLoader {
   /// \param step_id The data step_id to use for retrieving input data.
   /// \param data Returns the pointer to the data for the requested input.
   /// \param batch1_size Returns the size of the input data in bytes.
+  /// \param holder Returns the buffer of the data when it is streamed, which
+  /// must be kept for as long as the data is used. Streamed data can not be
+  /// retrieved without it.
   /// Returns error object indicating status
   cb::Error GetInputData(
       const ModelTensor& input, const int stream_id, const int step_id,
-      const uint8_t** data_ptr, size_t* batch1_size);
+      const uint8_t** data_ptr, size_t* batch1_size,
+      DirectoryDataset::TensorData* holder = nullptr);
 
   /// Helper function to get the shape values to the input
   /// \param input The target model input tensor
@@ -136,17 +230,96 @@ class DataLoader {
       const std::shared_ptr<ModelTensorMap>& outputs);
 
  private:
+  // Tensor data and shapes, keyed by "<name>_<stream>_<step>"
+  struct TensorDataMaps {
+    std::unordered_map<std::string, std::vector<char>> data_;
+    std::unordered_map<std::string, std::vector<int64_t>> shapes_;
+  };
+
+  // A step of the json document to read the tensors of
+  struct TensorReadJob {
+    const rapidjson::Value* step_;
+    int stream_index_;
+    int step_index_;
+    bool is_input_;
+  };
+
+  // A tensor of one step of the user provided data
+  struct TensorEntry {
+    const uint8_t* data_{nullptr};
+    size_t byte_size_{0};
+    bool has_data_{false};
+    // Null if the shape was not provided with the data
+    const std::vector<int64_t>* shape_{nullptr};
+  };
+
+  // Dense index of the user provided data of either inputs or outputs
+  struct TensorIndex {
+    std::unordered_map<std::string, size_t> ids_;
+    // The entries by tensor id, then by the position of the step across all
+    // streams
+    std::vector<std::vector<TensorEntry>> entries_;
+  };
+
+  /// Resolves the user provided data into the dense indexes, so that it can
+  /// be served without building and hashing string keys. Must be called
+  /// whenever data has been added.
+  /// \param inputs The input tensors of a model
+  /// \param outputs The output tensors of a model, may be null
+  void BuildIndexes(
+      const std::shared_ptr<ModelTensorMap>& inputs,
+      const std::shared_ptr<ModelTensorMap>& outputs);
+
+  void BuildIndex(
+      const ModelTensorMap& tensors,
+      const std::unordered_map<std::string, std::vector<char>>& tensor_data,
+      const std::unordered_map<std::string, std::vector<int64_t>>&
+          tensor_shape,
+      TensorIndex* index);
+
+  /// \return The entry of a tensor in a step, or null if there is none.
+  const TensorEntry* FindEntry(
+      const TensorIndex& index, const std::string& name, const int stream_id,
+      const int step_id) const;
+
+  /// Draws the shapes of the steps of the generated data from the shape
+  /// distributions into input_shapes_.
+  /// \param inputs The input tensors of a model
+  /// \param batch_steps The number of steps of each drawn shape.
+  /// Returns error object indicating status
+  /// \return The stream of the input corpus that holds a data stream.
+  size_t CorpusStream(const int stream_id) const
+  {
+    return ((stream_id < 0) || ((size_t)stream_id >= corpus_streams_.size()))
+               ? stream_id
+               : corpus_streams_[stream_id];
+  }
+
+  cb::Error DrawShapes(
+      const std::shared_ptr<ModelTensorMap>& inputs, const size_t batch_steps);
+
+  /// Reads the tensors of the steps on as many threads as there are cores
+  /// \param jobs The steps to read, in document order.
+  /// \param inputs The input tensors of a model
+  /// \param outputs The output tensors of a model
+  /// Returns error object indicating status
+  cb::Error ReadTensorDataInParallel(
+      const std::vector<TensorReadJob>& jobs,
+      const std::shared_ptr<ModelTensorMap>& inputs,
+      const std::shared_ptr<ModelTensorMap>& outputs);
+
   /// Helper function to read data for the specified input from json
   /// \param step the DOM for current step
   /// \param inputs The pointer to the map holding the information about
   /// input tensors of a model
   /// \param stream_index the stream index the data should be exported to.
   /// \param step_index the step index the data should be exported to.
+  /// \param maps The maps to add the data and shapes to.
   /// Returns error object indicating status
   cb::Error ReadTensorData(
       const rapidjson::Value& step,
       const std::shared_ptr<ModelTensorMap>& tensors, const int stream_index,
-      const int step_index, const bool is_input);
+      const int step_index, TensorDataMaps* maps);
 
   // The batch_size_ for the data
   size_t batch_size_{1};
@@ -164,9 +337,33 @@ class DataLoader {
   std::unordered_map<std::string, std::vector<char>> output_data_;
   std::unordered_map<std::string, std::vector<int64_t>> output_shapes_;
 
+  // The data of the maps above, resolved by BuildIndexes()
+  TensorIndex input_index_;
+  TensorIndex output_index_;
+  // The position of the first step of every stream across all streams
+  std::vector<size_t> stream_first_step_;
+
+  // User provided data mapped from an input corpus, used instead of the maps
+  // above
+  std::shared_ptr<InputCorpus> corpus_;
+  // The stream of the input corpus of every stream of the shard kept by
+  // ShardStreams(), empty if the streams are not sharded
+  std::vector<size_t> corpus_streams_;
+
+  // User provided input data read from a directory while the requests are
+  // sent, used instead of the maps above
+  size_t prefetch_steps_{0};
+  std::shared_ptr<DirectoryDataset> directory_dataset_;
+
   // Placeholder for generated input data, which will be used for all inputs
-  // except string
+  // except string. Only the pattern of the data when it is deferred.
   std::vector<uint8_t> input_buf_;
+  bool defer_generated_data_{false};
+
+  // The distributions of the shapes of the generated inputs, see
+  // SetShapeDistributions()
+  std::vector<std::shared_ptr<const ShapeDistribution>> shape_distributions_;
+  size_t shape_count_{0};
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend NaggyMockDataLoader;
@@ -0,0 +1,103 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace triton { namespace perfanalyzer {
+
+/// The datatypes of the tensors. Their names are resolved once per tensor
+/// so that the code preparing and checking every request switches on them
+/// instead of comparing strings. The values are in the order of
+/// TRITONSERVER_DataType.
+enum class DataType : uint8_t {
+  INVALID,
+  BOOL,
+  UINT8,
+  UINT16,
+  UINT32,
+  UINT64,
+  INT8,
+  INT16,
+  INT32,
+  INT64,
+  FP16,
+  FP32,
+  FP64,
+  BYTES,
+  BF16
+};
+
+namespace detail {
+
+struct DataTypeInfo {
+  const char* name_;
+  size_t byte_size_;
+};
+
+// The name and the element size of each datatype, in the order of DataType.
+// The datatypes without a fixed element size have a size of 0.
+inline constexpr DataTypeInfo kDataTypeInfos[] = {
+    {"INVALID", 0}, {"BOOL", 1},  {"UINT8", 1}, {"UINT16", 2}, {"UINT32", 4},
+    {"UINT64", 8},  {"INT8", 1},  {"INT16", 2}, {"INT32", 4},  {"INT64", 8},
+    {"FP16", 2},    {"FP32", 4},  {"FP64", 8},  {"BYTES", 0},  {"BF16", 2}};
+
+}  // namespace detail
+
+/// \param type The datatype.
+/// \return The size in bytes of an element of 'type', 0 if its elements
+/// do not have a fixed size.
+constexpr size_t
+DataTypeByteSize(DataType type)
+{
+  return detail::kDataTypeInfos[static_cast<size_t>(type)].byte_size_;
+}
+
+/// \param type The datatype.
+/// \return The name of 'type', such as "FP32".
+constexpr const char*
+DataTypeName(DataType type)
+{
+  return detail::kDataTypeInfos[static_cast<size_t>(type)].name_;
+}
+
+/// \param datatype The name of the datatype, such as "FP32".
+/// \return The datatype, DataType::INVALID for an unknown name.
+inline DataType
+ParseDataType(const std::string& datatype)
+{
+  for (size_t i = 1; i < std::size(detail::kDataTypeInfos); i++) {
+    if (datatype.compare(detail::kDataTypeInfos[i].name_) == 0) {
+      return static_cast<DataType>(i);
+    }
+  }
+  return DataType::INVALID;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,262 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "directory_dataset.h"
+
+#include <dirent.h>
+
+#include <algorithm>
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+DirectoryDataset::Open(
+    const std::string& directory, const ModelTensorMap& inputs,
+    const size_t prefetch_steps, const size_t io_thread_count,
+    std::shared_ptr<DirectoryDataset>* dataset)
+{
+  if (prefetch_steps == 0 || io_thread_count == 0) {
+    return cb::Error(
+        "the steps of a directory dataset must be read ahead by at least one "
+        "thread",
+        pa::GENERIC_ERROR);
+  }
+
+  std::shared_ptr<DirectoryDataset> local(new DirectoryDataset());
+  local->directory_ = directory;
+  local->prefetch_steps_ = prefetch_steps;
+  for (const auto& input : inputs) {
+    const bool is_bytes = (input.second.datatype_.compare("BYTES") == 0);
+    if ((is_bytes ? ElementCount(input.second.shape_)
+                  : ByteSize(input.second.shape_, input.second.datatype_)) <
+        0) {
+      return cb::Error(
+          "input " + input.second.name_ +
+              " contains dynamic shape, provide shapes to send along with "
+              "the request",
+          pa::GENERIC_ERROR);
+    }
+    local->input_ids_[input.first] = local->inputs_.size();
+    local->inputs_.push_back(input.second);
+  }
+
+  // Only the names are listed, the files of a step are not looked at until
+  // the step is read
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return cb::Error(
+        "failed to open data directory " + directory, pa::GENERIC_ERROR);
+  }
+  for (struct dirent* entry = readdir(dir); entry != nullptr;
+       entry = readdir(dir)) {
+    const std::string name(entry->d_name);
+    if (name.empty() || name[0] == '.') {
+      continue;
+    }
+    if ((entry->d_type == DT_DIR) ||
+        ((entry->d_type == DT_UNKNOWN) &&
+         IsDirectory(directory + "/" + name))) {
+      local->step_names_.push_back(name);
+    }
+  }
+  closedir(dir);
+  if (local->step_names_.empty()) {
+    return cb::Error(
+        "data directory " + directory + " has no step subdirectories",
+        pa::GENERIC_ERROR);
+  }
+  std::sort(local->step_names_.begin(), local->step_names_.end());
+
+  for (size_t i = 0; i < io_thread_count; i++) {
+    local->io_threads_.emplace_back(&DirectoryDataset::IoThread, local.get());
+  }
+  {
+    std::lock_guard<std::mutex> lock(local->mutex_);
+    local->MoveWindow(0);
+  }
+  *dataset = std::move(local);
+  return cb::Error::Success;
+}
+
+DirectoryDataset::~DirectoryDataset()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& io_thread : io_threads_) {
+    io_thread.join();
+  }
+}
+
+cb::Error
+DirectoryDataset::Get(
+    const std::string& name, const size_t step, TensorData* data)
+{
+  const auto id = input_ids_.find(name);
+  if (id == input_ids_.end()) {
+    return cb::Error(
+        "no input named '" + name + "' in the data directory",
+        pa::GENERIC_ERROR);
+  }
+  if (step >= StepCount()) {
+    return cb::Error(
+        "step " + std::to_string(step) + " is out of the " +
+            std::to_string(StepCount()) + " steps of the data directory",
+        pa::GENERIC_ERROR);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  MoveWindow(step);
+  // A step far behind the others is read again
+  Schedule(step);
+  // Steps being waited for are not released, so the reference stays valid
+  Step& entry = steps_[step];
+  entry.waiters_++;
+  ready_cv_.wait(lock, [&entry] { return entry.ready_; });
+  entry.waiters_--;
+  RETURN_IF_ERROR(entry.status_);
+  *data = entry.tensors_[id->second];
+  return cb::Error::Success;
+}
+
+void
+DirectoryDataset::MoveWindow(const size_t step)
+{
+  const size_t ahead = Distance(window_step_, step);
+  if (window_started_ && ((ahead == 0) || (ahead > StepCount() / 2))) {
+    return;
+  }
+  window_step_ = step;
+  window_started_ = true;
+
+  for (auto it = steps_.begin(); it != steps_.end();) {
+    const Step& entry = it->second;
+    if (entry.ready_ && (entry.waiters_ == 0) &&
+        (Distance(it->first, window_step_) > prefetch_steps_) &&
+        (Distance(window_step_, it->first) >= prefetch_steps_)) {
+      it = steps_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  const size_t count = std::min(prefetch_steps_, StepCount());
+  for (size_t i = 0; i < count; i++) {
+    Schedule((window_step_ + i) % StepCount());
+  }
+}
+
+void
+DirectoryDataset::Schedule(const size_t step)
+{
+  if (steps_.find(step) != steps_.end()) {
+    return;
+  }
+  steps_.emplace(step, Step());
+  queue_.push_back(step);
+  queue_cv_.notify_one();
+}
+
+void
+DirectoryDataset::IoThread()
+{
+  while (true) {
+    size_t step;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_cv_.wait(lock, [this] { return exiting_ || !queue_.empty(); });
+      if (exiting_) {
+        return;
+      }
+      step = queue_.front();
+      queue_.pop_front();
+    }
+
+    std::vector<TensorData> tensors;
+    cb::Error status = ReadStep(step, &tensors);
+
+    {
+      // Steps are only released once read, so the step is still there
+      std::lock_guard<std::mutex> lock(mutex_);
+      Step& entry = steps_[step];
+      entry.status_ = status;
+      entry.tensors_ = std::move(tensors);
+      entry.ready_ = true;
+    }
+    ready_cv_.notify_all();
+  }
+}
+
+cb::Error
+DirectoryDataset::ReadStep(const size_t step, std::vector<TensorData>* tensors)
+{
+  const std::string step_directory = directory_ + "/" + step_names_[step];
+  for (const auto& input : inputs_) {
+    const std::string file_path = step_directory + "/" + input.name_;
+    if (!IsFile(file_path)) {
+      if (input.is_optional_) {
+        tensors->emplace_back();
+        continue;
+      }
+      return cb::Error(
+          "no data for input " + input.name_ + " in " + step_directory,
+          pa::GENERIC_ERROR);
+    }
+
+    std::shared_ptr<std::vector<char>> data(new std::vector<char>());
+    if (input.datatype_.compare("BYTES") != 0) {
+      RETURN_IF_ERROR(ReadFile(file_path, data.get()));
+      const int64_t byte_size = ByteSize(input.shape_, input.datatype_);
+      if (data->size() != (size_t)byte_size) {
+        return cb::Error(
+            "provided data for input " + input.name_ + " in " +
+                step_directory + " has byte size " +
+                std::to_string(data->size()) + ", expect " +
+                std::to_string(byte_size),
+            pa::GENERIC_ERROR);
+      }
+    } else {
+      std::vector<std::string> string_data;
+      RETURN_IF_ERROR(ReadTextFile(file_path, &string_data));
+      const int64_t batch1_num_strings = ElementCount(input.shape_);
+      if (string_data.size() != (size_t)batch1_num_strings) {
+        return cb::Error(
+            "provided data for input " + input.name_ + " in " +
+                step_directory + " has " +
+                std::to_string(string_data.size()) +
+                " byte elements, expect " +
+                std::to_string(batch1_num_strings),
+            pa::GENERIC_ERROR);
+      }
+      SerializeStringTensor(string_data, data.get());
+    }
+    tensors->push_back(std::move(data));
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
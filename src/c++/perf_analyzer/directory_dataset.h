@@ -0,0 +1,137 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "model_parser.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Input data in a directory with one subdirectory per step, each holding a
+/// file per input in the same format as a single step directory. The steps
+/// are only indexed when the dataset is opened. They are read by a pool of
+/// I/O threads, ahead of the steps that are requested, into a bounded window
+/// of steps, so that datasets far larger than the memory can be sent without
+/// repeating data.
+///
+/// The steps are in the order of the names of their subdirectories. The data
+/// of a step is released once the requests are far enough past it, buffers
+/// that are still in use stay alive through the references to them.
+///
+class DirectoryDataset {
+ public:
+  using TensorData = std::shared_ptr<const std::vector<char>>;
+
+  /// Index the steps of a directory and start reading the first ones.
+  /// \param directory The directory with the subdirectories of the steps.
+  /// \param inputs The input tensors of the model, their shapes must be
+  /// static.
+  /// \param prefetch_steps The number of steps read ahead of the latest step
+  /// requested, as many steps behind it are also kept.
+  /// \param io_thread_count The number of threads reading the steps.
+  /// \param dataset Returns the dataset.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Open(
+      const std::string& directory, const ModelTensorMap& inputs,
+      const size_t prefetch_steps, const size_t io_thread_count,
+      std::shared_ptr<DirectoryDataset>* dataset);
+
+  ~DirectoryDataset();
+
+  /// \return The number of steps of the dataset.
+  size_t StepCount() const { return step_names_.size(); }
+
+  /// Get the data of an input in a step, waiting for the step to be read if
+  /// it is not yet. The steps after it are read ahead.
+  /// \param name The name of the input.
+  /// \param step The index of the step.
+  /// \param data Returns the data of the input, null if the step has no
+  /// file for an optional input.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Get(const std::string& name, const size_t step, TensorData* data);
+
+ private:
+  // A step that is read or being read
+  struct Step {
+    bool ready_{false};
+    // The requests waiting for the step, which is not released until then
+    size_t waiters_{0};
+    cb::Error status_;
+    // By input, in the order of 'inputs_'
+    std::vector<TensorData> tensors_;
+  };
+
+  DirectoryDataset() = default;
+
+  /// Slides the window of steps to 'step' if it is ahead of it, releasing
+  /// the steps that fall out of it and queuing the ones that come in. Must
+  /// be called with 'mutex_' held.
+  void MoveWindow(const size_t step);
+
+  /// Queues a step to be read if it is not. Must be called with 'mutex_'
+  /// held.
+  void Schedule(const size_t step);
+
+  /// \return How many steps 'to' is after 'from', wrapping around the end.
+  size_t Distance(const size_t from, const size_t to) const
+  {
+    return (to + step_names_.size() - from) % step_names_.size();
+  }
+
+  void IoThread();
+
+  cb::Error ReadStep(const size_t step, std::vector<TensorData>* tensors);
+
+  std::string directory_;
+  std::vector<std::string> step_names_;
+  std::vector<ModelTensor> inputs_;
+  std::unordered_map<std::string, size_t> input_ids_;
+  size_t prefetch_steps_{0};
+
+  std::mutex mutex_;
+  // Signaled when a step is read
+  std::condition_variable ready_cv_;
+  // Signaled when a step is queued or the dataset is closing
+  std::condition_variable queue_cv_;
+  std::deque<size_t> queue_;
+  std::unordered_map<size_t, Step> steps_;
+  // The latest step requested, the window extends on both sides of it
+  size_t window_step_{0};
+  bool window_started_{false};
+  bool exiting_{false};
+  std::vector<std::thread> io_threads_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,214 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "distributed_load.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+ParseRankWeights(const std::string& list, std::vector<double>* weights)
+{
+  std::vector<double> parsed;
+  std::stringstream list_stream(list);
+  std::string entry;
+  while (std::getline(list_stream, entry, ',')) {
+    size_t parsed_chars = 0;
+    double weight = 0;
+    try {
+      weight = std::stod(entry, &parsed_chars);
+    }
+    catch (const std::exception&) {
+      parsed_chars = 0;
+    }
+    if ((parsed_chars == 0) || (parsed_chars != entry.size()) ||
+        !(weight > 0)) {
+      return cb::Error(
+          "invalid rank weight '" + entry +
+              "', weights must be positive numbers",
+          pa::GENERIC_ERROR);
+    }
+    parsed.push_back(weight);
+  }
+  if (parsed.empty() || (!list.empty() && list.back() == ',')) {
+    return cb::Error(
+        "invalid rank weights '" + list + "'", pa::GENERIC_ERROR);
+  }
+  *weights = parsed;
+  return cb::Error::Success;
+}
+
+std::vector<double>
+SplitRequestRate(const double request_rate, const std::vector<double>& weights)
+{
+  const double total_weight =
+      std::accumulate(weights.begin(), weights.end(), 0.0);
+  std::vector<double> request_rates;
+  for (const double weight : weights) {
+    request_rates.push_back(request_rate * weight / total_weight);
+  }
+  return request_rates;
+}
+
+cb::Error
+SplitConcurrency(
+    const size_t concurrency, const std::vector<double>& weights,
+    std::vector<size_t>* concurrencies)
+{
+  if (concurrency < weights.size()) {
+    return cb::Error(
+        "concurrency " + std::to_string(concurrency) +
+            " is below the number of MPI ranks " +
+            std::to_string(weights.size()) + " sharing the load",
+        pa::GENERIC_ERROR);
+  }
+
+  // One request in flight per rank, the rest by largest remainder
+  const double total_weight =
+      std::accumulate(weights.begin(), weights.end(), 0.0);
+  const size_t spread = concurrency - weights.size();
+  std::vector<size_t> shares(weights.size(), 1);
+  std::vector<std::pair<double, size_t>> remainders;
+  size_t assigned = 0;
+  for (size_t i = 0; i < weights.size(); i++) {
+    const double share = spread * weights[i] / total_weight;
+    const size_t whole = static_cast<size_t>(share);
+    shares[i] += whole;
+    assigned += whole;
+    remainders.emplace_back(share - whole, i);
+  }
+  // Ties go to the lower ranks so that all the ranks agree
+  std::stable_sort(
+      remainders.begin(), remainders.end(),
+      [](const std::pair<double, size_t>& a,
+         const std::pair<double, size_t>& b) { return a.first > b.first; });
+  for (size_t i = 0; assigned < spread; i++, assigned++) {
+    shares[remainders[i].second]++;
+  }
+
+  *concurrencies = shares;
+  return cb::Error::Success;
+}
+
+int64_t
+EstimateClockOffsetNs(MPIDriver& mpi_driver)
+{
+  const int rank = mpi_driver.MPICommRankWorld();
+  const int size = mpi_driver.MPICommSizeWorld();
+  auto now_ns = []() -> uint64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  };
+
+  // Each round, rank 0 broadcasts its time and every rank notes when it got
+  // it. The midpoint of the round trip on rank 0 is its best guess of when
+  // the others took their time.
+  const size_t rounds = 8;
+  std::vector<uint64_t> offsets(size, 0);
+  uint64_t best_round_trip_ns = UINT64_MAX;
+  for (size_t round = 0; round < rounds; round++) {
+    mpi_driver.MPIBarrierWorld();
+    uint64_t sent_ns = now_ns();
+    mpi_driver.MPIBcastUint64World(&sent_ns, 1, 0);
+    const uint64_t received_ns = now_ns();
+    std::vector<uint64_t> received(size);
+    mpi_driver.MPIAllgatherUint64World(&received_ns, 1, received.data());
+    const uint64_t round_trip_ns = now_ns() - sent_ns;
+    if ((rank == 0) && (round_trip_ns < best_round_trip_ns)) {
+      best_round_trip_ns = round_trip_ns;
+      const uint64_t midpoint_ns = sent_ns + round_trip_ns / 2;
+      for (int i = 1; i < size; i++) {
+        offsets[i] = received[i] - midpoint_ns;
+      }
+    }
+  }
+
+  // The offsets travel as their two's complement
+  mpi_driver.MPIBcastUint64World(offsets.data(), size, 0);
+  return static_cast<int64_t>(offsets[rank]);
+}
+
+
+DistributedLoad::DistributedLoad(
+    std::shared_ptr<MPIDriver> mpi_driver,
+    const std::vector<double>& rank_weights)
+    : mpi_driver_(mpi_driver), rank_(mpi_driver->MPICommRankWorld())
+{
+  weights_ = rank_weights;
+  weights_.resize(mpi_driver_->MPICommSizeWorld(), 1.0);
+  mpi_driver_->MPIBcastDoubleWorld(weights_.data(), weights_.size(), 0);
+}
+
+double
+DistributedLoad::LocalRequestRate(const double request_rate) const
+{
+  return SplitRequestRate(request_rate, weights_)[rank_];
+}
+
+cb::Error
+DistributedLoad::LocalConcurrency(
+    const size_t concurrency, size_t* local_concurrency) const
+{
+  std::vector<size_t> concurrencies;
+  RETURN_IF_ERROR(SplitConcurrency(concurrency, weights_, &concurrencies));
+  *local_concurrency = concurrencies[rank_];
+  return cb::Error::Success;
+}
+
+uint64_t
+DistributedLoad::SharedStartNs(const uint64_t lead_ns)
+{
+  uint64_t start_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count() +
+      lead_ns;
+  mpi_driver_->MPIBcastUint64World(&start_ns, 1, 0);
+  return start_ns;
+}
+
+std::vector<std::vector<uint64_t>>
+DistributedLoad::Allgather(const std::vector<uint64_t>& values)
+{
+  std::vector<uint64_t> gathered(values.size() * weights_.size());
+  mpi_driver_->MPIAllgatherUint64World(
+      values.data(), values.size(), gathered.data());
+
+  std::vector<std::vector<uint64_t>> values_per_rank;
+  for (size_t rank = 0; rank < weights_.size(); rank++) {
+    values_per_rank.emplace_back(
+        gathered.begin() + rank * values.size(),
+        gathered.begin() + (rank + 1) * values.size());
+  }
+  return values_per_rank;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,119 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mpi_utils.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Parses the weights of the MPI ranks in a distributed load, such as
+/// "2,1,1".
+/// \param list The comma separated weights, one per rank.
+/// \param weights Returns the weights. Left unchanged if the list is invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseRankWeights(
+    const std::string& list, std::vector<double>* weights);
+
+/// Splits a request rate over ranks in proportion to their weights.
+/// \param request_rate The request rate of all the ranks together.
+/// \param weights The weight of each rank.
+/// \return The request rate of each rank.
+std::vector<double> SplitRequestRate(
+    const double request_rate, const std::vector<double>& weights);
+
+/// Splits a concurrency over ranks in proportion to their weights. Each rank
+/// gets at least one request in flight, and the shares add up to the
+/// concurrency.
+/// \param concurrency The concurrency of all the ranks together.
+/// \param weights The weight of each rank.
+/// \param concurrencies Returns the concurrency of each rank.
+/// \return cb::Error object indicating success or failure.
+cb::Error SplitConcurrency(
+    const size_t concurrency, const std::vector<double>& weights,
+    std::vector<size_t>* concurrencies);
+
+/// Estimates how far the clock of this rank runs ahead of the clock of rank
+/// 0, from the round of broadcasts with the shortest round trip. The error is
+/// at most half of that round trip. Collective.
+/// \param mpi_driver The driver of an MPI run.
+/// \return The offset in nanoseconds, 0 on rank 0.
+int64_t EstimateClockOffsetNs(MPIDriver& mpi_driver);
+
+/// Spreads the load of one profile over the ranks of an MPI world, all
+/// running the same model against the same deployment, so that the load is
+/// not limited by what a single client host can send. Rank 0 is the
+/// coordinator: its weights assign the share of the load of each rank and
+/// its clock sets the start of the measurement windows. Collective calls
+/// must be made by all the ranks in the same order.
+class DistributedLoad {
+ public:
+  /// Broadcasts the rank weights of the coordinator. Collective.
+  /// \param mpi_driver The driver of an MPI run.
+  /// \param rank_weights The weight of each rank, equal weights if empty.
+  /// Only the weights of the coordinator are used.
+  DistributedLoad(
+      std::shared_ptr<MPIDriver> mpi_driver,
+      const std::vector<double>& rank_weights);
+
+  /// \return The share of the request rate that this rank sends.
+  double LocalRequestRate(const double request_rate) const;
+
+  /// \param concurrency The concurrency of all the ranks together.
+  /// \param local_concurrency Returns the share of this rank.
+  /// \return cb::Error object indicating success or failure. Fails on all
+  /// the ranks alike.
+  cb::Error LocalConcurrency(
+      const size_t concurrency, size_t* local_concurrency) const;
+
+  /// Agrees on the start of a measurement window on the clock of the
+  /// coordinator, the given lead after its current time. Collective.
+  /// \param lead_ns The time to leave the ranks to receive the start time.
+  /// \return The start time in nanoseconds since the epoch.
+  uint64_t SharedStartNs(const uint64_t lead_ns);
+
+  /// Gathers the values of all the ranks. Collective.
+  /// \param values The values of this rank. All the ranks must give the same
+  /// number of values.
+  /// \return The values of each rank, in rank order.
+  std::vector<std::vector<uint64_t>> Allgather(
+      const std::vector<uint64_t>& values);
+
+  int Rank() const { return rank_; }
+  bool IsCoordinator() const { return rank_ == 0; }
+
+ private:
+  std::shared_ptr<MPIDriver> mpi_driver_;
+  int rank_;
+  std::vector<double> weights_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,128 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "endpoint_mix.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+ParseEndpoints(const std::string& spec, std::vector<EndpointEntry>* entries)
+{
+  std::vector<EndpointEntry> parsed;
+  std::stringstream spec_stream(spec);
+  std::string item;
+  while (std::getline(spec_stream, item, ',')) {
+    EndpointEntry entry;
+    const size_t weight_start = item.find('=');
+    if (weight_start != std::string::npos) {
+      const std::string weight = item.substr(weight_start + 1);
+      size_t parsed_chars = 0;
+      try {
+        entry.weight = std::stod(weight, &parsed_chars);
+      }
+      catch (const std::exception&) {
+        parsed_chars = 0;
+      }
+      if ((parsed_chars == 0) || (parsed_chars != weight.size()) ||
+          !(entry.weight > 0)) {
+        return cb::Error(
+            "invalid weight in endpoints: '" + item +
+                "', weights must be positive numbers",
+            pa::GENERIC_ERROR);
+      }
+    }
+    entry.url = item.substr(0, weight_start);
+    if (entry.url.empty()) {
+      return cb::Error(
+          "missing url in endpoints: '" + item + "'", pa::GENERIC_ERROR);
+    }
+    for (const auto& other : parsed) {
+      if (other.url == entry.url) {
+        return cb::Error(
+            "duplicate url in endpoints: '" + entry.url + "'",
+            pa::GENERIC_ERROR);
+      }
+    }
+    parsed.push_back(entry);
+  }
+
+  if (parsed.empty()) {
+    return cb::Error("endpoints are empty", pa::GENERIC_ERROR);
+  }
+  *entries = std::move(parsed);
+  return cb::Error::Success;
+}
+
+EndpointMix::EndpointMix(
+    const std::vector<EndpointEntry>& entries, const EndpointPolicy policy)
+    : entries_(entries), policy_(policy)
+{
+  double total_weight = 0;
+  for (const auto& entry : entries_) {
+    total_weight += entry.weight;
+  }
+  double cumulative_weight = 0;
+  for (const auto& entry : entries_) {
+    cumulative_weight += entry.weight;
+    cumulative_shares_.push_back(cumulative_weight / total_weight);
+  }
+  // Rounding must not leave draws close to 1 without an endpoint
+  if (!cumulative_shares_.empty()) {
+    cumulative_shares_.back() = 1.0;
+  }
+}
+
+size_t
+EndpointMix::WorkerEndpoint(const size_t worker) const
+{
+  // The bits of the index reversed behind the binary point spread any number
+  // of first workers evenly over [0, 1)
+  double draw = 0;
+  double scale = 0.5;
+  for (size_t rest = worker; rest != 0; rest >>= 1) {
+    if ((rest & 1) != 0) {
+      draw += scale;
+    }
+    scale /= 2;
+  }
+  return Pick(draw);
+}
+
+size_t
+EndpointMix::Pick(const double draw) const
+{
+  auto it = std::upper_bound(
+      cumulative_shares_.begin(), cumulative_shares_.end(), draw);
+  if (it == cumulative_shares_.end()) {
+    return entries_.size() - 1;
+  }
+  return it - cumulative_shares_.begin();
+}
+
+}}  // namespace triton::perfanalyzer
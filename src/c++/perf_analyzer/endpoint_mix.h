@@ -0,0 +1,96 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// How the requests are spread over the endpoints
+enum EndpointPolicy {
+  // Each context sends its requests to the endpoints in turn
+  ENDPOINT_ROUND_ROBIN = 0,
+  // Each worker thread sends all its requests to one endpoint, the worker
+  // threads being spread over the endpoints by weight
+  ENDPOINT_AFFINITY = 1,
+  // Each request goes to an endpoint drawn by weight
+  ENDPOINT_WEIGHTED = 2
+};
+
+/// A server that takes part in the load
+struct EndpointEntry {
+  std::string url;
+  double weight{1.0};
+};
+
+/// Parses endpoints in the format "url[=weight],...", such as
+/// "replica-0:8001=2,replica-1:8001". The weight defaults to 1.
+/// \param spec The endpoints to parse.
+/// \param entries Returns the endpoints, in the order given. Left unchanged
+/// if the endpoints are invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseEndpoints(
+    const std::string& spec, std::vector<EndpointEntry>* entries);
+
+/// Spreads the requests over several endpoints serving the same model.
+class EndpointMix {
+ public:
+  /// \param entries The endpoints, with positive weights.
+  /// \param policy How the requests are spread over the endpoints.
+  EndpointMix(
+      const std::vector<EndpointEntry>& entries, const EndpointPolicy policy);
+
+  /// \param worker The index of a worker thread.
+  /// \return The endpoint that the worker thread is bound to. The first
+  /// worker threads cover the endpoints in proportion to their weights
+  /// whatever their number.
+  size_t WorkerEndpoint(const size_t worker) const;
+
+  /// \param draw A number drawn uniformly from [0, 1).
+  /// \return The index of the endpoint that the draw falls on by weight.
+  size_t Pick(const double draw) const;
+
+  const EndpointEntry& Entry(const size_t index) const
+  {
+    return entries_[index];
+  }
+
+  size_t Size() const { return entries_.size(); }
+
+  EndpointPolicy Policy() const { return policy_; }
+
+ private:
+  std::vector<EndpointEntry> entries_;
+  EndpointPolicy policy_;
+  // The end of the share of each endpoint, the last one is 1
+  std::vector<double> cumulative_shares_;
+};
+
+}}  // namespace triton::perfanalyzer
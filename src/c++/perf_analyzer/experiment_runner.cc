@@ -0,0 +1,480 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "experiment_runner.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The fields of the model config that a configuration sets, and their values
+// as JSON
+using ConfigFields = std::vector<std::pair<std::string, std::string>>;
+
+std::string
+Serialize(const rapidjson::Value& value)
+{
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  value.Accept(writer);
+  return buffer.GetString();
+}
+
+// FNV-1a over the strings, each terminated so that ["ab"] and ["a", "b"]
+// differ, in hexadecimal
+std::string
+Hash(const std::vector<std::string>& strings)
+{
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const auto& s : strings) {
+    for (const char c : s) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    hash = (hash ^ 0) * 0x100000001b3;
+  }
+  std::stringstream hex;
+  hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return hex.str();
+}
+
+std::vector<std::string>
+Split(const std::string& s, char delimiter)
+{
+  std::vector<std::string> parts;
+  std::stringstream stream(s);
+  std::string part;
+  while (std::getline(stream, part, delimiter)) {
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+// Sets the fields in the model config, creating the objects on their path
+// that it does not have yet
+std::string
+SetConfigFields(const std::string& model_config, const ConfigFields& fields)
+{
+  rapidjson::Document document;
+  document.Parse(model_config.c_str());
+  auto& allocator = document.GetAllocator();
+  for (const auto& field : fields) {
+    const auto names = Split(field.first, '.');
+    rapidjson::Value* object = &document;
+    for (size_t i = 0; i + 1 < names.size(); i++) {
+      auto member = object->FindMember(names[i].c_str());
+      if (member == object->MemberEnd()) {
+        rapidjson::Value name(names[i].c_str(), allocator);
+        rapidjson::Value child(rapidjson::kObjectType);
+        object->AddMember(name, child, allocator);
+        member = object->FindMember(names[i].c_str());
+      } else if (!member->value.IsObject()) {
+        member->value.SetObject();
+      }
+      object = &member->value;
+    }
+
+    rapidjson::Document parsed;
+    parsed.Parse(field.second.c_str());
+    rapidjson::Value value(parsed, allocator);
+    auto member = object->FindMember(names.back().c_str());
+    if (member == object->MemberEnd()) {
+      rapidjson::Value name(names.back().c_str(), allocator);
+      object->AddMember(name, value, allocator);
+    } else {
+      member->value = value;
+    }
+  }
+  return Serialize(document);
+}
+
+cb::Error
+ParseValue(
+    const std::string& name, const rapidjson::Value& value,
+    std::vector<std::string>* args)
+{
+  args->clear();
+  if (value.IsBool()) {
+    if (value.GetBool()) {
+      args->push_back(name);
+    }
+  } else if (value.IsString()) {
+    args->push_back(name);
+    args->push_back(value.GetString());
+  } else if (value.IsInt64()) {
+    args->push_back(name);
+    args->push_back(std::to_string(value.GetInt64()));
+  } else if (value.IsNumber()) {
+    std::stringstream number;
+    number << value.GetDouble();
+    args->push_back(name);
+    args->push_back(number.str());
+  } else {
+    return cb::Error(
+        "the values of '" + name +
+            "' in the experiment matrix must be strings, numbers or "
+            "booleans",
+        pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+cb::Error
+ExperimentRunner::Create(
+    const std::string& path, const std::vector<std::string>& base_args,
+    std::unique_ptr<ExperimentRunner>* runner)
+{
+  std::ifstream file(path);
+  if (!file) {
+    return cb::Error(
+        "failed to open experiment file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return CreateFromString(contents.str(), base_args, runner);
+}
+
+cb::Error
+ExperimentRunner::CreateFromString(
+    const std::string& json, const std::vector<std::string>& base_args,
+    std::unique_ptr<ExperimentRunner>* runner)
+{
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+  if (document.HasParseError() || !document.IsObject()) {
+    return cb::Error(
+        "the experiment file is not a valid JSON object", pa::GENERIC_ERROR);
+  }
+
+  std::unique_ptr<ExperimentRunner> local(new ExperimentRunner());
+  local->arguments_ = base_args;
+  for (auto it = document.MemberBegin(); it != document.MemberEnd(); ++it) {
+    const std::string key = it->name.GetString();
+    const rapidjson::Value& value = it->value;
+    if (key == "arguments") {
+      if (!value.IsArray()) {
+        return cb::Error(
+            "the 'arguments' of the experiment file must be an array",
+            pa::GENERIC_ERROR);
+      }
+      for (const auto& argument : value.GetArray()) {
+        if (!argument.IsString()) {
+          return cb::Error(
+              "the 'arguments' of the experiment file must be strings",
+              pa::GENERIC_ERROR);
+        }
+        local->arguments_.push_back(argument.GetString());
+      }
+    } else if (key == "matrix") {
+      if (!value.IsArray()) {
+        return cb::Error(
+            "the 'matrix' of the experiment file must be an array",
+            pa::GENERIC_ERROR);
+      }
+      for (const auto& entry : value.GetArray()) {
+        const char* key_name =
+            (entry.IsObject() && entry.HasMember("config")) ? "config"
+                                                            : "name";
+        if (!entry.IsObject() || !entry.HasMember(key_name) ||
+            !entry[key_name].IsString() || !entry.HasMember("values") ||
+            !entry["values"].IsArray() || entry["values"].Empty()) {
+          return cb::Error(
+              "the entries of the 'matrix' of the experiment file must have "
+              "a 'name' or a 'config' and a non-empty array of 'values'",
+              pa::GENERIC_ERROR);
+        }
+        ExperimentDimension dimension;
+        if (std::string(key_name) == "config") {
+          dimension.config_field = entry["config"].GetString();
+          const auto names = Split(dimension.config_field, '.');
+          if (dimension.config_field.empty() ||
+              (dimension.config_field.back() == '.') ||
+              std::any_of(
+                  names.begin(), names.end(),
+                  [](const std::string& name) { return name.empty(); })) {
+            return cb::Error(
+                "invalid model config field '" + dimension.config_field +
+                    "' in the experiment matrix",
+                pa::GENERIC_ERROR);
+          }
+          for (const auto& field_value : entry["values"].GetArray()) {
+            dimension.config_values.push_back(Serialize(field_value));
+          }
+        } else {
+          dimension.name = entry["name"].GetString();
+          for (const auto& option_value : entry["values"].GetArray()) {
+            std::vector<std::string> args;
+            RETURN_IF_ERROR(ParseValue(dimension.name, option_value, &args));
+            dimension.values.push_back(args);
+          }
+        }
+        local->matrix_.push_back(dimension);
+      }
+    } else if (key == "cache_directory") {
+      if (!value.IsString() || (value.GetStringLength() == 0)) {
+        return cb::Error(
+            "the 'cache_directory' of the experiment file must be a path",
+            pa::GENERIC_ERROR);
+      }
+      local->cache_directory_ = value.GetString();
+    } else if (key == "model_config") {
+      if (!value.IsObject()) {
+        return cb::Error(
+            "the 'model_config' of the experiment file must be an object",
+            pa::GENERIC_ERROR);
+      }
+      local->model_config_ = Serialize(value);
+    } else {
+      return cb::Error(
+          "unknown key '" + key + "' in the experiment file",
+          pa::GENERIC_ERROR);
+    }
+  }
+
+  *runner = std::move(local);
+  return cb::Error::Success;
+}
+
+void
+ExperimentRunner::Expand(
+    std::vector<std::vector<std::string>>* configurations,
+    std::vector<std::string>* model_configs) const
+{
+  std::vector<std::pair<std::vector<std::string>, ConfigFields>> expanded{
+      {arguments_, {}}};
+  bool sets_config = false;
+  for (const auto& dimension : matrix_) {
+    std::vector<std::pair<std::vector<std::string>, ConfigFields>> next;
+    for (const auto& configuration : expanded) {
+      if (dimension.config_field.empty()) {
+        for (const auto& value : dimension.values) {
+          next.push_back(configuration);
+          next.back().first.insert(
+              next.back().first.end(), value.begin(), value.end());
+        }
+      } else {
+        sets_config = true;
+        for (const auto& value : dimension.config_values) {
+          next.push_back(configuration);
+          next.back().second.emplace_back(dimension.config_field, value);
+        }
+      }
+    }
+    expanded = std::move(next);
+  }
+
+  configurations->clear();
+  model_configs->clear();
+  for (auto& configuration : expanded) {
+    std::string model_config;
+    if (sets_config) {
+      // Named after its contents, so that the command line tells the config
+      // apart in the hash of the report
+      model_config = SetConfigFields(model_config_, configuration.second);
+      configuration.first.push_back("--model-load-config");
+      configuration.first.push_back(
+          cache_directory_ + "/" + Hash({model_config}) + ".json");
+    }
+    configurations->push_back(std::move(configuration.first));
+    model_configs->push_back(std::move(model_config));
+  }
+}
+
+std::vector<std::vector<std::string>>
+ExperimentRunner::Configurations() const
+{
+  std::vector<std::vector<std::string>> configurations;
+  std::vector<std::string> model_configs;
+  Expand(&configurations, &model_configs);
+  return configurations;
+}
+
+std::string
+ExperimentRunner::ReportPath(const std::vector<std::string>& args) const
+{
+  return cache_directory_ + "/" + Hash(args) + ".csv";
+}
+
+cb::Error
+ExperimentRunner::Run(const RunFn& run) const
+{
+  if (!IsDirectory(cache_directory_) &&
+      (mkdir(cache_directory_.c_str(), 0755) != 0)) {
+    return cb::Error(
+        "failed to create the cache directory '" + cache_directory_ + "'",
+        pa::GENERIC_ERROR);
+  }
+
+  std::vector<std::vector<std::string>> configurations;
+  std::vector<std::string> model_configs;
+  Expand(&configurations, &model_configs);
+  for (size_t i = 0; i < configurations.size(); i++) {
+    const auto& args = configurations[i];
+    const std::string report = ReportPath(args);
+    std::cout << "*** Experiment " << (i + 1) << " of "
+              << configurations.size() << ":";
+    for (const auto& arg : args) {
+      std::cout << " " << arg;
+    }
+    std::cout << std::endl;
+    if (IsFile(report)) {
+      std::cout << "  Cached in " << report << std::endl;
+      continue;
+    }
+
+    // The command line is kept next to the report, to tell what it holds
+    std::ofstream args_file(report.substr(0, report.size() - 4) + ".args");
+    for (const auto& arg : args) {
+      args_file << arg << std::endl;
+    }
+    args_file.close();
+
+    if (!model_configs[i].empty()) {
+      // The path of the model config ends the command line
+      std::ofstream config_file(args.back());
+      config_file << model_configs[i];
+      config_file.close();
+      if (!config_file) {
+        return cb::Error(
+            "failed to write the model config '" + args.back() + "'",
+            pa::GENERIC_ERROR);
+      }
+    }
+
+    std::vector<std::string> run_args(args);
+    run_args.push_back("-f");
+    run_args.push_back(report);
+    if (!run(run_args)) {
+      // An interrupted configuration is run again next time
+      std::remove(report.c_str());
+      return cb::Error(
+          "the experiment was interrupted after " + std::to_string(i) +
+              " of " + std::to_string(configurations.size()) +
+              " configurations",
+          pa::GENERIC_ERROR);
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ExperimentRunner::Points(std::vector<ExperimentPoint>* points) const
+{
+  points->clear();
+  for (const auto& args : Configurations()) {
+    const std::string path = ReportPath(args);
+    std::ifstream report(path);
+    std::string line;
+    if (!std::getline(report, line)) {
+      // Not run yet
+      continue;
+    }
+    const auto header = Split(line, ',');
+    const auto throughput_it =
+        std::find(header.begin(), header.end(), "Inferences/Second");
+    const auto p99_it = std::find(header.begin(), header.end(), "p99 latency");
+    if ((throughput_it == header.end()) || (p99_it == header.end())) {
+      std::cerr << "WARNING: skipping the report '" << path
+                << "' without throughput or p99 latency" << std::endl;
+      continue;
+    }
+    const size_t throughput_idx = throughput_it - header.begin();
+    const size_t p99_idx = p99_it - header.begin();
+
+    // The measurements end at the first empty line
+    while (std::getline(report, line) && !line.empty()) {
+      const auto fields = Split(line, ',');
+      if (fields.size() <= std::max(throughput_idx, p99_idx)) {
+        break;
+      }
+      ExperimentPoint point;
+      point.args = args;
+      point.load_name = header[0];
+      point.load = std::strtod(fields[0].c_str(), nullptr);
+      point.throughput = std::strtod(fields[throughput_idx].c_str(), nullptr);
+      point.p99_latency_us = std::strtod(fields[p99_idx].c_str(), nullptr);
+      points->push_back(std::move(point));
+    }
+  }
+  return cb::Error::Success;
+}
+
+std::vector<ExperimentPoint>
+ExperimentRunner::ParetoFrontier(const std::vector<ExperimentPoint>& points)
+{
+  std::vector<ExperimentPoint> sorted(points);
+  std::sort(
+      sorted.begin(), sorted.end(),
+      [](const ExperimentPoint& a, const ExperimentPoint& b) {
+        return (a.throughput != b.throughput)
+                   ? (a.throughput > b.throughput)
+                   : (a.p99_latency_us < b.p99_latency_us);
+      });
+  // Going down in throughput, a point is only worth it with a lower latency
+  // than all of the points before it
+  std::vector<ExperimentPoint> frontier;
+  for (const auto& point : sorted) {
+    if (frontier.empty() ||
+        (point.p99_latency_us < frontier.back().p99_latency_us)) {
+      frontier.push_back(point);
+    }
+  }
+  return frontier;
+}
+
+cb::Error
+ExperimentRunner::ReportParetoFrontier(std::ostream& out) const
+{
+  std::vector<ExperimentPoint> points;
+  RETURN_IF_ERROR(Points(&points));
+  out << "*** Pareto frontier of throughput vs. p99 latency ***" << std::endl;
+  for (const auto& point : ParetoFrontier(points)) {
+    out << "  " << point.throughput << " infer/sec, p99 latency "
+        << point.p99_latency_us << " usec, " << point.load_name << " "
+        << point.load << ":";
+    for (const auto& arg : point.args) {
+      out << " " << arg;
+    }
+    out << std::endl;
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,164 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// An option or a model config field that takes several values across the
+/// experiments of a matrix
+struct ExperimentDimension {
+  // The option, such as "-b" or "--shared-memory"
+  std::string name;
+  // The arguments that each value adds to the command line, empty for a
+  // value that leaves the option out
+  std::vector<std::vector<std::string>> values;
+  // If not empty, the dimension sets this field of the model config instead
+  // of an option, such as "dynamic_batching.max_queue_delay_microseconds",
+  // to each of 'config_values', serialized as JSON
+  std::string config_field;
+  std::vector<std::string> config_values;
+};
+
+/// A measurement of a configuration of an experiment
+struct ExperimentPoint {
+  // The command line of the configuration
+  std::vector<std::string> args;
+  // The concurrency or request rate of the measurement, as the first column
+  // of the report names it
+  std::string load_name;
+  double load{0};
+  double throughput{0};
+  // The p99 latency in usec
+  double p99_latency_us{0};
+};
+
+/// Runs the matrix of configurations of an experiment file in one process,
+/// skipping those whose results are already in the cache directory. The file
+/// is a JSON document such as
+///
+///   {
+///     "arguments": ["-m", "resnet50", "-i", "grpc"],
+///     "matrix": [
+///       {"name": "-b", "values": [1, 8]},
+///       {"name": "--shared-memory", "values": ["none", "system"]},
+///       {"name": "--async", "values": [true, false]}
+///     ],
+///     "cache_directory": "perf_analyzer_cache"
+///   }
+///
+/// where a value of true passes the option alone and false leaves it out.
+/// The results of each configuration are the CSV report of its command line,
+/// stored under a hash of the command line.
+///
+/// Entries of the matrix can instead name a field of the model config, such
+/// as {"config": "dynamic_batching.max_queue_delay_microseconds", "values":
+/// [0, 100]}, with values of any JSON type. The fields are set in a copy of
+/// the optional "model_config" object of the file, which is written to the
+/// cache directory and passed with --model-load-config, so that each
+/// configuration loads the model with its own config before profiling it.
+class ExperimentRunner {
+ public:
+  /// Runs a configuration.
+  /// \param args The command line of the configuration, without the program
+  /// name, with "-f" pointing to the report to write.
+  /// \return Whether the matrix should go on with the next configurations.
+  using RunFn = std::function<bool(const std::vector<std::string>& args)>;
+
+  /// \param path The experiment file to read.
+  /// \param base_args Arguments given to every configuration before those of
+  /// the file.
+  /// \param runner Returns the runner of the experiment file.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const std::string& path, const std::vector<std::string>& base_args,
+      std::unique_ptr<ExperimentRunner>* runner);
+
+  /// \param json The experiment file contents to parse.
+  /// \param base_args Arguments given to every configuration before those of
+  /// the file.
+  /// \param runner Returns the runner of the experiment.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error CreateFromString(
+      const std::string& json, const std::vector<std::string>& base_args,
+      std::unique_ptr<ExperimentRunner>* runner);
+
+  /// \return The command lines of all the configurations of the matrix, the
+  /// last dimension varying fastest, without the "-f" of the report.
+  std::vector<std::vector<std::string>> Configurations() const;
+
+  /// \param args The command line of a configuration.
+  /// \return The path of the report of the configuration in the cache.
+  std::string ReportPath(const std::vector<std::string>& args) const;
+
+  /// Runs the configurations that have no report in the cache yet, in order.
+  /// \param run Runs a configuration.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Run(const RunFn& run) const;
+
+  /// Reads the measurements of every configuration from the reports in the
+  /// cache. The reports without throughput or p99 latency are skipped.
+  /// \param points Returns the measurements.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Points(std::vector<ExperimentPoint>* points) const;
+
+  /// \param points The measurements of the configurations.
+  /// \return The measurements that no other one beats on both throughput
+  /// and p99 latency, by decreasing throughput.
+  static std::vector<ExperimentPoint> ParetoFrontier(
+      const std::vector<ExperimentPoint>& points);
+
+  /// Prints the Pareto frontier of throughput versus p99 latency over the
+  /// measurements of all the configurations.
+  /// \param out The stream to print to.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ReportParetoFrontier(std::ostream& out) const;
+
+ private:
+  ExperimentRunner() = default;
+
+  // Expands the matrix into the command line of each configuration and the
+  // model config it loads, empty if the matrix sets no model config field
+  void Expand(
+      std::vector<std::vector<std::string>>* configurations,
+      std::vector<std::string>* model_configs) const;
+
+  std::vector<std::string> arguments_;
+  std::vector<ExperimentDimension> matrix_;
+  std::string cache_directory_{"perf_analyzer_cache"};
+  // The model config that the config fields of the matrix are set in, as
+  // JSON
+  std::string model_config_{"{}"};
+};
+
+}}  // namespace triton::perfanalyzer
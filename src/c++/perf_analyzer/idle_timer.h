@@ -24,9 +24,8 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
-#include <chrono>
-#include <mutex>
-#include <stdexcept>
+#include <cstdint>
+#include "thread_timer.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -35,77 +34,14 @@ class TestLoadManager;
 #endif
 
 
-/// Class to track idle periods of time
+/// Class to track idle periods of time of a worker thread
 ///
-class IdleTimer {
+class IdleTimer : public ThreadTimer {
  public:
-  void Start()
-  {
-    std::lock_guard<std::mutex> lk(mtx_);
-    StartImpl();
-  }
-
-  void Stop()
-  {
-    std::lock_guard<std::mutex> lk(mtx_);
-    StopImpl();
-  }
-
-  /// Reset the time counter, and restart the timer if it is active
-  ///
-  void Reset()
-  {
-    Restart();
-    idle_ns_ = 0;
-  }
-
   /// Returns the number of nanoseconds this timer has counted as being idle
-  /// If the timer was already active, then it will first stop (and count the
-  /// pending time), and then start back up
+  /// since it was last reset, including the pending time if it is active
   ///
-  uint64_t GetIdleTime()
-  {
-    Restart();
-    return idle_ns_;
-  }
-
- private:
-  std::mutex mtx_;
-  uint64_t idle_ns_{0};
-  bool is_idle_{false};
-  std::chrono::_V2::steady_clock::time_point start_time_;
-
-  void Restart()
-  {
-    std::lock_guard<std::mutex> lk(mtx_);
-    if (is_idle_) {
-      StopImpl();
-      StartImpl();
-    }
-  }
-
-  void StartImpl()
-  {
-    if (is_idle_) {
-      throw std::runtime_error("Can't start a timer that is already active\n");
-    }
-
-    is_idle_ = true;
-    start_time_ = std::chrono::steady_clock::now();
-  }
-
-  void StopImpl()
-  {
-    if (!is_idle_) {
-      throw std::runtime_error("Can't stop a timer that isn't active\n");
-    }
-
-    is_idle_ = false;
-    auto end = std::chrono::steady_clock::now();
-    auto duration = end - start_time_;
-    idle_ns_ += duration.count();
-  }
-
+  uint64_t GetIdleTime() { return GetTime(); }
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestLoadManager;
@@ -30,6 +30,7 @@
 #include "data_loader.h"
 #include "infer_data.h"
 #include "model_parser.h"
+#include "output_validator.h"
 #include "perf_utils.h"
 
 namespace triton { namespace perfanalyzer {
@@ -56,6 +57,26 @@ class IInferDataManager {
   /// \return cb::Error object indicating success or failure.
   virtual cb::Error UpdateInferData(
       int stream_index, int step_index, InferData& infer_data) = 0;
+
+  /// Prepares the target InferData object for sending a request
+  /// \param infer_data The target InferData object
+  /// \param slots Returns the shared memory slots the request holds until
+  /// it is given to CompleteRequest()
+  /// \return cb::Error object indicating success or failure.
+  virtual cb::Error PrepareRequest(
+      InferData& infer_data, SharedMemorySlots* slots) = 0;
+
+  /// Finishes a request sent after PrepareRequest(). Gives back its shared
+  /// memory slots, after validating the outputs it wrote to shared memory
+  /// if asked to.
+  /// \param infer_data The InferData object the request was sent with
+  /// \param slots The shared memory slots of the request
+  /// \param validator The validator of the outputs of the request, nullptr
+  /// to not validate them
+  /// \return cb::Error object indicating success or failure.
+  virtual cb::Error CompleteRequest(
+      const InferData& infer_data, const SharedMemorySlots& slots,
+      OutputValidator* validator) = 0;
 };
 
 }}  // namespace triton::perfanalyzer
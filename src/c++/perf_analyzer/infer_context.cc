@@ -26,32 +26,80 @@
 
 #include "infer_context.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace triton { namespace perfanalyzer {
 
 void
 InferContext::Init()
 {
+  // The connection is set up before the first request so that its cost is
+  // not measured. The pool sets up the connections of its backends, and the
+  // prepared backends are already connected.
+  if ((infer_backend_ != nullptr) && !backend_prepared_ &&
+      (thread_stat_->backend_pool_ == nullptr)) {
+    thread_stat_->status_ = infer_backend_->Warmup(1);
+    if (!thread_stat_->status_.IsOk()) {
+      return;
+    }
+  }
+  const auto& endpoints = thread_stat_->endpoints_;
+  for (size_t i = 1; (endpoints != nullptr) && (i < endpoints->Size()); i++) {
+    endpoint_backends_.emplace_back();
+    endpoint_client_stats_.emplace_back();
+    thread_stat_->status_ = factory_->CreateEndpointClientBackend(
+        endpoints->Entry(i).url, &endpoint_backends_.back());
+    if (thread_stat_->status_.IsOk()) {
+      thread_stat_->status_ = endpoint_backends_.back()->Warmup(1);
+    }
+    if (!thread_stat_->status_.IsOk()) {
+      return;
+    }
+  }
   thread_stat_->status_ = infer_data_manager_->InitInferData(infer_data_);
   if (!thread_stat_->status_.IsOk()) {
     return;
   }
+  if (!using_json_data_) {
+    // The input data set here is the one of every request
+    infer_data_.options_->data_stream_id_ = 0;
+    infer_data_.options_->data_step_id_ = 0;
+  }
 
   if (streaming_) {
+    // The final response tells when all the responses of a request of a
+    // decoupled model have been received
+    infer_data_.options_->triton_enable_empty_final_response_ =
+        parser_->IsDecoupled();
     // Decoupled models should not collect client side statistics
     thread_stat_->status_ = infer_backend_->StartStream(
         async_callback_func_, (!parser_->IsDecoupled()));
     if (!thread_stat_->status_.IsOk()) {
       return;
     }
+    for (auto& backend : endpoint_backends_) {
+      thread_stat_->status_ = backend->StartStream(
+          async_callback_func_, (!parser_->IsDecoupled()));
+      if (!thread_stat_->status_.IsOk()) {
+        return;
+      }
+    }
   }
 }
 
 void
-InferContext::SendInferRequest(bool delayed)
+InferContext::SendInferRequest(bool delayed, uint64_t data_stream_id)
 {
+  // The model is picked first, as it may have input data of its own
+  const ModelMixEntry* model = PickMixModel();
+  if ((model != nullptr) && (model->data_stream >= 0)) {
+    data_stream_id = model->data_stream;
+  }
+
   // Update the inputs if required
   if (using_json_data_) {
-    UpdateJsonData();
+    UpdateJsonData(data_stream_id);
   }
   SendRequest(request_id_++, delayed);
 }
@@ -74,6 +122,7 @@ InferContext::SendSequenceInferRequest(uint32_t seq_stat_index, bool delayed)
 
     sequence_manager_->DecrementRemainingQueries(seq_stat_index);
 
+    PickMixModel();
     SendRequest(request_id_++, delayed);
   }
 }
@@ -94,21 +143,150 @@ InferContext::CompleteOngoingSequence(uint32_t seq_stat_index)
     }
     sequence_manager_->DecrementRemainingQueries(seq_stat_index);
 
+    PickMixModel();
     bool is_delayed = false;
     SendRequest(request_id_++, is_delayed);
   }
 }
 
+void
+InferContext::SendReplayedRequest(const ScheduleRecord& record, bool delayed)
+{
+  if (on_sequence_model_) {
+    infer_data_.options_->sequence_id_ = record.sequence_id_;
+    infer_data_.options_->sequence_start_ = record.sequence_start_;
+    infer_data_.options_->sequence_end_ = record.sequence_end_;
+  }
+  if (using_json_data_) {
+    ClientStageTimer::Scope data_prep_scope(
+        thread_stat_->stage_timer_, CLIENT_STAGE_DATA_PREP);
+    data_stream_id_ = record.data_stream_id_;
+    infer_data_.options_->data_stream_id_ = record.data_stream_id_;
+    infer_data_.options_->data_step_id_ = record.data_step_id_;
+    thread_stat_->status_ = infer_data_manager_->UpdateInferData(
+        record.data_stream_id_, record.data_step_id_, infer_data_);
+  }
+
+  PickMixModel();
+  SendRequest(request_id_++, delayed);
+}
+
+const ModelMixEntry*
+InferContext::PickMixModel()
+{
+  if (model_mix_ == nullptr) {
+    return nullptr;
+  }
+
+  double draw;
+  if (on_sequence_model_) {
+    // The steps of a sequence can be sent by different contexts
+    draw = SequenceDraw();
+  } else {
+    draw = std::uniform_real_distribution<double>(0.0, 1.0)(model_mix_rng_);
+  }
+
+  const ModelMixEntry& model = model_mix_->Entry(model_mix_->Pick(draw));
+  infer_data_.options_->model_name_ = model.model_name;
+  infer_data_.options_->model_version_ = model.model_version;
+  return &model;
+}
+
+double
+InferContext::SequenceDraw() const
+{
+  uint64_t hash = infer_data_.options_->sequence_id_ + 0x9e3779b97f4a7c15;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+  hash = hash ^ (hash >> 31);
+  return static_cast<double>(hash >> 11) / (uint64_t{1} << 53);
+}
+
+void
+InferContext::PickRequestClass()
+{
+  const auto& request_classes = thread_stat_->request_classes_;
+  if (request_classes == nullptr) {
+    return;
+  }
+
+  const double draw =
+      std::uniform_real_distribution<double>(0.0, 1.0)(request_class_rng_);
+  request_class_ = request_classes->Pick(draw);
+  const RequestClassEntry& entry = request_classes->Entry(request_class_);
+  infer_data_.options_->priority_ = entry.priority;
+  infer_data_.options_->server_timeout_ = entry.server_timeout_us;
+}
+
+void
+InferContext::PickEndpoint(const uint64_t request_id)
+{
+  const auto& endpoints = thread_stat_->endpoints_;
+  if (endpoints == nullptr) {
+    return;
+  }
+
+  if (on_sequence_model_) {
+    // Whatever the policy, a sequence can only be served where it started
+    endpoint_ = endpoints->Pick(SequenceDraw());
+  } else if (endpoints->Policy() == ENDPOINT_AFFINITY) {
+    endpoint_ = endpoints->WorkerEndpoint(thread_stat_->worker_index_);
+  } else if (endpoints->Policy() == ENDPOINT_ROUND_ROBIN) {
+    // The contexts start apart so that they do not move over the endpoints
+    // in step
+    endpoint_ =
+        (endpoints->WorkerEndpoint(thread_stat_->worker_index_) + id_ +
+         request_id) %
+        endpoints->Size();
+  } else {
+    endpoint_ = endpoints->Pick(
+        std::uniform_real_distribution<double>(0.0, 1.0)(endpoint_rng_));
+  }
+}
+
 void
 InferContext::SendRequest(const uint64_t request_id, const bool delayed)
 {
   if (!thread_stat_->status_.IsOk()) {
     return;
   }
+  InflightLimiter* limiter = thread_stat_->inflight_limiter_.get();
+  if ((limiter != nullptr) && !AdmitRequest(limiter)) {
+    return;
+  }
+  PickRequestClass();
+  PickEndpoint(request_id);
+  cb::ClientBackend* backend = EndpointBackend(endpoint_);
 
+  ClientTracer* tracer = thread_stat_->tracer_.get();
+  const uint64_t trace_id = SampleTrace(request_id);
+  SharedMemorySlots shm_slots;
+  {
+    ClientStageTimer::Scope data_prep_scope(
+        thread_stat_->stage_timer_, CLIENT_STAGE_DATA_PREP);
+    ClientTracer::Scope data_prep_span(
+        tracer, trace_id, CLIENT_SPAN_DATA_PREP, id_);
+    thread_stat_->status_ =
+        infer_data_manager_->PrepareRequest(infer_data_, &shm_slots);
+  }
+  if (!thread_stat_->status_.IsOk()) {
+    ReleaseInflightSlot();
+    return;
+  }
+
+  if ((thread_stat_->schedule_recorder_ != nullptr) &&
+      has_intended_send_time_) {
+    RecordSchedule();
+  }
+  thread_stat_->stage_timer_.RecordRequest();
   thread_stat_->num_sent_requests_++;
+  thread_stat_->num_inflight_requests_++;
   if (async_) {
-    infer_data_.options_->request_id_ = std::to_string(request_id);
+    // A traced request is sent with the id that joins it to its trace
+    infer_data_.options_->request_id_ = (trace_id == 0)
+                                            ? std::to_string(request_id)
+                                            : ClientTracer::RequestId(trace_id);
+    std::string latency_bucket = LatencyBucket();
     {
       std::lock_guard<std::mutex> lock(thread_stat_->mu_);
       auto it =
@@ -117,53 +295,153 @@ InferContext::SendRequest(const uint64_t request_id, const bool delayed)
                   infer_data_.options_->request_id_, AsyncRequestProperties())
               .first;
       it->second.start_time_ = std::chrono::system_clock::now();
+      it->second.schedule_lag_ns_ = TakeScheduleLag();
       it->second.sequence_end_ = infer_data_.options_->sequence_end_;
       it->second.delayed_ = delayed;
+      it->second.shm_slots_ = shm_slots;
+      it->second.latency_bucket_ = std::move(latency_bucket);
+      it->second.trace_id_ = trace_id;
+      it->second.request_class_ = request_class_;
+      it->second.endpoint_ = endpoint_;
+      SetRequestIds(&it->second);
     }
 
-    thread_stat_->idle_timer.Start();
-    if (streaming_) {
-      thread_stat_->status_ = infer_backend_->AsyncStreamInfer(
-          *(infer_data_.options_), infer_data_.valid_inputs_,
-          infer_data_.outputs_);
-    } else {
-      thread_stat_->status_ = infer_backend_->AsyncInfer(
-          async_callback_func_, *(infer_data_.options_),
-          infer_data_.valid_inputs_, infer_data_.outputs_);
+    if (track_send_idle_time_) {
+      thread_stat_->idle_timer.Start();
+    }
+    DelaySend();
+    {
+      ClientStageTimer::Scope send_scope(
+          thread_stat_->stage_timer_, CLIENT_STAGE_SEND);
+      ClientTracer::Scope send_span(tracer, trace_id, CLIENT_SPAN_SEND, id_);
+      if (streaming_) {
+        thread_stat_->status_ = backend->AsyncStreamInfer(
+            *(infer_data_.options_), infer_data_.valid_inputs_,
+            infer_data_.outputs_);
+      } else if (thread_stat_->request_classes_ != nullptr) {
+        // The callback is told which request it completes, in case the
+        // request is rejected
+        const std::string sent_request_id = infer_data_.options_->request_id_;
+        thread_stat_->status_ = backend->AsyncInfer(
+            [this, sent_request_id](cb::InferResult* result) {
+              AsyncCallbackFuncImpl(result, sent_request_id);
+            },
+            *(infer_data_.options_), infer_data_.valid_inputs_,
+            infer_data_.outputs_);
+      } else {
+        thread_stat_->status_ = backend->AsyncInfer(
+            async_callback_func_, *(infer_data_.options_),
+            infer_data_.valid_inputs_, infer_data_.outputs_);
+      }
+    }
+    if (track_send_idle_time_) {
+      thread_stat_->idle_timer.Stop();
+    }
+    if (trace_id != 0) {
+      // The wait for the response starts here, unless the response came
+      // first and the request is already done
+      std::lock_guard<std::mutex> lock(thread_stat_->mu_);
+      auto it = async_req_map_.find(infer_data_.options_->request_id_);
+      if (it != async_req_map_.end()) {
+        it->second.send_end_ns_ = ClientTracer::NowNs();
+      }
+    }
+    if (!thread_stat_->status_.IsOk()) {
+      thread_stat_->num_inflight_requests_--;
+      ReleaseInflightSlot();
+      infer_data_manager_->CompleteRequest(
+          infer_data_, shm_slots, nullptr /* validator */);
     }
-    thread_stat_->idle_timer.Stop();
 
     total_ongoing_requests_++;
   } else {
     std::chrono::time_point<std::chrono::system_clock> start_time_sync,
         end_time_sync;
+    const std::string latency_bucket = LatencyBucket();
+    if (tracer != nullptr) {
+      infer_data_.options_->request_id_ =
+          (trace_id == 0) ? "" : ClientTracer::RequestId(trace_id);
+    }
     thread_stat_->idle_timer.Start();
     start_time_sync = std::chrono::system_clock::now();
-    cb::InferResult* results = nullptr;
-    thread_stat_->status_ = infer_backend_->Infer(
-        &results, *(infer_data_.options_), infer_data_.valid_inputs_,
-        infer_data_.outputs_);
+    const int64_t schedule_lag_ns = TakeScheduleLag();
+    DelaySend();
+    cb::InferResult* result = nullptr;
+    {
+      ClientStageTimer::Scope send_scope(
+          thread_stat_->stage_timer_, CLIENT_STAGE_SEND);
+      ClientTracer::Scope send_span(tracer, trace_id, CLIENT_SPAN_SEND, id_);
+      thread_stat_->status_ = backend->Infer(
+          &result, *(infer_data_.options_), infer_data_.valid_inputs_,
+          infer_data_.outputs_);
+    }
     thread_stat_->idle_timer.Stop();
-    if (results != nullptr) {
+    thread_stat_->num_inflight_requests_--;
+    ReleaseInflightSlot();
+    const bool rejected =
+        IsClassRejection(request_class_, thread_stat_->status_);
+    if (rejected) {
+      std::lock_guard<std::mutex> lock(thread_stat_->mu_);
+      thread_stat_->request_class_stats_[request_class_].rejected_count++;
+      thread_stat_->status_ = cb::Error::Success;
+    }
+    if ((result != nullptr) && !rejected) {
+      // The validator may keep the result until the outputs are compared
+      std::shared_ptr<cb::InferResult> result_ptr(result);
       if (thread_stat_->status_.IsOk()) {
-        thread_stat_->status_ = ValidateOutputs(results);
+        ClientTracer::Scope validation_span(
+            tracer, trace_id, CLIENT_SPAN_VALIDATION, id_);
+        ValidateOutputs(result_ptr);
       }
-      delete results;
     }
-    if (!thread_stat_->status_.IsOk()) {
+    cb::Error complete_status = infer_data_manager_->CompleteRequest(
+        infer_data_, shm_slots,
+        (thread_stat_->status_.IsOk() && !rejected)
+            ? thread_stat_->output_validator_.get()
+            : nullptr);
+    if (thread_stat_->status_.IsOk()) {
+      thread_stat_->status_ = complete_status;
+    }
+    if (!thread_stat_->status_.IsOk() || rejected) {
       return;
     }
     end_time_sync = std::chrono::system_clock::now();
+    // The worker thread is the only producer in sync mode, so the timestamp
+    // can be recorded without holding the lock
+    thread_stat_->request_timestamps_.Push(
+        start_time_sync, end_time_sync, infer_data_.options_->sequence_end_,
+        delayed);
+    if (thread_stat_->completion_counter_ != nullptr) {
+      thread_stat_->completion_counter_->Increment();
+    }
     {
-      // Add the request timestamp to thread Timestamp vector with proper
-      // locking
       std::lock_guard<std::mutex> lock(thread_stat_->mu_);
-      auto total = end_time_sync - start_time_sync;
-      thread_stat_->request_timestamps_.emplace_back(std::make_tuple(
-          start_time_sync, end_time_sync, infer_data_.options_->sequence_end_,
-          delayed));
-      thread_stat_->status_ =
-          infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
+      const uint64_t latency_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              end_time_sync - start_time_sync)
+              .count();
+      if (thread_stat_->record_interval_latencies_) {
+        thread_stat_->interval_latency_histogram_.Record(latency_ns);
+      }
+      if (thread_stat_->record_threshold_latencies_) {
+        thread_stat_->threshold_latency_histogram_.Record(latency_ns);
+      }
+      RecordBucketLatency(latency_bucket, latency_ns);
+      RecordClassLatency(request_class_, latency_ns);
+      RecordEndpointLatency(endpoint_, latency_ns);
+      RecordCorrectedLatency(schedule_lag_ns, latency_ns);
+      if (thread_stat_->slow_requests_.Admits(latency_ns)) {
+        AsyncRequestProperties request;
+        request.start_time_ = start_time_sync;
+        request.first_response_time_ = end_time_sync;
+        request.last_response_time_ = end_time_sync;
+        request.response_count_ = 1;
+        request.schedule_lag_ns_ = schedule_lag_ns;
+        request.endpoint_ = endpoint_;
+        SetRequestIds(&request);
+        RecordSlowRequest(latency_ns, request);
+      }
+      thread_stat_->status_ = UpdateClientStat(endpoint_);
       if (!thread_stat_->status_.IsOk()) {
         return;
       }
@@ -171,19 +449,108 @@ InferContext::SendRequest(const uint64_t request_id, const bool delayed)
   }
 }
 
+cb::Error
+InferContext::UpdateClientStat(size_t endpoint)
+{
+  if ((endpoint == 0) && (thread_stat_->backend_pool_ != nullptr)) {
+    // The requests of the other contexts sharing the backend are counted
+    // here too, but only once across the contexts
+    cb::InferStat previous;
+    cb::InferStat current;
+    cb::Error err = thread_stat_->backend_pool_->ReadClientStat(
+        backend_pool_index_, &previous, &current);
+    thread_stat_->client_stat_.Add(previous, current);
+    return err;
+  }
+  cb::InferStat& context_stat = (endpoint == 0)
+                                    ? thread_stat_->contexts_stat_[id_]
+                                    : endpoint_client_stats_[endpoint - 1];
+  const cb::InferStat previous = context_stat;
+  cb::Error err = EndpointBackend(endpoint)->ClientInferStat(&context_stat);
+  thread_stat_->client_stat_.Add(previous, context_stat);
+  return err;
+}
+
+bool
+InferContext::AdmitRequest(InflightLimiter* limiter)
+{
+  if (limiter->TryAcquire()) {
+    return true;
+  }
+  if ((limiter->Overload() == OVERLOAD_DROP) &&
+      !infer_data_.options_->sequence_end_) {
+    thread_stat_->num_dropped_requests_++;
+    return false;
+  }
+
+  // Yield for a while before backing off to short sleeps, like the workers
+  // waiting for a request to send
+  constexpr size_t max_yields = 64;
+  const auto queued_time = std::chrono::steady_clock::now();
+  bool admitted = false;
+  thread_stat_->idle_timer.Start();
+  for (size_t attempt = 0; execute_ && !early_exit; attempt++) {
+    if (limiter->TryAcquire()) {
+      admitted = true;
+      break;
+    }
+    if (attempt < max_yields) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+  }
+  thread_stat_->idle_timer.Stop();
+  if (admitted) {
+    const uint64_t delay_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - queued_time)
+            .count();
+    std::lock_guard<std::mutex> lock(thread_stat_->schedule_error_mu_);
+    thread_stat_->queue_delay_histogram_.Record(delay_ns);
+  }
+  return admitted;
+}
+
+uint64_t
+InferContext::SampleTrace(uint64_t request_number)
+{
+  ClientTracer* tracer = thread_stat_->tracer_.get();
+  if ((tracer == nullptr) || !tracer->ShouldSample(id_, request_number)) {
+    return 0;
+  }
+  return tracer->NewTraceId();
+}
 
 void
-InferContext::UpdateJsonData()
+InferContext::UpdateJsonData(uint64_t data_stream_id)
 {
-  int step_id = (data_step_id_ * batch_size_) % data_loader_->GetTotalSteps(0);
-  data_step_id_ += GetNumActiveThreads();
-  thread_stat_->status_ =
-      infer_data_manager_->UpdateInferData(0, step_id, infer_data_);
+  ClientStageTimer::Scope data_prep_scope(
+      thread_stat_->stage_timer_, CLIENT_STAGE_DATA_PREP);
+  const size_t total_steps{data_loader_->GetTotalSteps(data_stream_id)};
+  int step_id;
+  if (thread_stat_->input_repeat_ != nullptr) {
+    // Each input is a batch of steps
+    const size_t pool_size{std::max<size_t>(total_steps / batch_size_, 1)};
+    const size_t input{
+        thread_stat_->input_repeat_->Next(input_repeat_rng_, pool_size)};
+    step_id = (input * batch_size_) % total_steps;
+  } else {
+    step_id = (data_step_id_ * batch_size_) % total_steps;
+    data_step_id_ += GetNumActiveThreads();
+  }
+  data_stream_id_ = data_stream_id;
+  infer_data_.options_->data_stream_id_ = data_stream_id;
+  infer_data_.options_->data_step_id_ = step_id;
+  thread_stat_->status_ = infer_data_manager_->UpdateInferData(
+      data_stream_id, step_id, infer_data_);
 }
 
 void
 InferContext::UpdateSeqJsonData(size_t seq_stat_index)
 {
+  ClientStageTimer::Scope data_prep_scope(
+      thread_stat_->stage_timer_, CLIENT_STAGE_DATA_PREP);
   const size_t sequence_length{
       sequence_manager_->GetSequenceLength(seq_stat_index)};
   const size_t remaining_queries{
@@ -192,71 +559,343 @@ InferContext::UpdateSeqJsonData(size_t seq_stat_index)
       sequence_manager_->GetDataStreamID(seq_stat_index)};
   const size_t total_steps{data_loader_->GetTotalSteps(data_stream_id)};
   int step_id = (sequence_length - remaining_queries) % total_steps;
+  data_stream_id_ = data_stream_id;
+  infer_data_.options_->data_stream_id_ = data_stream_id;
+  infer_data_.options_->data_step_id_ = step_id;
   thread_stat_->status_ = infer_data_manager_->UpdateInferData(
       data_stream_id, step_id, infer_data_);
 }
 
-cb::Error
-InferContext::ValidateOutputs(const cb::InferResult* result_ptr)
+void
+InferContext::ValidateOutputs(
+    const std::shared_ptr<cb::InferResult>& result_ptr)
 {
-  // Validate output if set
-  if (!infer_data_.expected_outputs_.empty()) {
-    for (size_t i = 0; i < infer_data_.outputs_.size(); ++i) {
-      const uint8_t* buf = nullptr;
-      size_t byte_size = 0;
-      result_ptr->RawData(infer_data_.outputs_[i]->Name(), &buf, &byte_size);
-      for (const auto& expected : infer_data_.expected_outputs_[i]) {
-        if (byte_size < expected.second) {
-          return cb::Error(
-              "Output size doesn't match expected size", pa::GENERIC_ERROR);
-        } else if (memcmp(buf, expected.first, expected.second) != 0) {
-          return cb::Error(
-              "Output doesn't match expected output", pa::GENERIC_ERROR);
-        } else {
-          buf += expected.second;
-          byte_size -= expected.second;
+  // Outputs in shared memory are not in the result, so they are validated
+  // in place by CompleteRequest()
+  if (infer_data_.outputs_in_shared_memory_ ||
+      infer_data_.expected_outputs_.empty() ||
+      (thread_stat_->output_validator_ == nullptr)) {
+    return;
+  }
+
+  ClientStageTimer::Scope validation_scope(
+      thread_stat_->stage_timer_, CLIENT_STAGE_VALIDATION);
+  const auto& tensors = *(parser_->Outputs());
+  std::vector<OutputValidator::ExpectedOutput> outputs;
+  outputs.reserve(infer_data_.outputs_.size());
+  for (size_t i = 0; i < infer_data_.outputs_.size(); ++i) {
+    outputs.push_back(
+        {&tensors.at(infer_data_.outputs_[i]->Name()),
+         infer_data_.expected_outputs_[i]});
+  }
+  thread_stat_->output_validator_->Submit(result_ptr, std::move(outputs));
+}
+
+std::string
+InferContext::LatencyBucket() const
+{
+  switch (thread_stat_->latency_bucketing_) {
+    case BUCKET_DATA_STREAM:
+      return "stream " + std::to_string(data_stream_id_);
+    case BUCKET_MODEL: {
+      const std::string& version = infer_data_.options_->model_version_;
+      return infer_data_.options_->model_name_ +
+             (version.empty() ? "" : ":" + version);
+    }
+    case BUCKET_INPUT_SHAPE: {
+      // Commas are left out so that the bucket fits in a CSV field
+      std::string bucket;
+      for (const auto input : infer_data_.valid_inputs_) {
+        if (!bucket.empty()) {
+          bucket += ' ';
         }
+        bucket += input->Name() + '[';
+        const auto& shape = input->Shape();
+        for (size_t i = 0; i < shape.size(); i++) {
+          if (i != 0) {
+            bucket += 'x';
+          }
+          bucket += std::to_string(shape[i]);
+        }
+        bucket += ']';
       }
-      if (byte_size != 0) {
-        return cb::Error(
-            "Output size doesn't match expected size", pa::GENERIC_ERROR);
-      }
+      return bucket;
     }
+    default:
+      return "";
   }
-  return cb::Error::Success;
 }
 
 void
-InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
+InferContext::RecordSchedule()
+{
+  const cb::InferOptions& options = *infer_data_.options_;
+  ScheduleRecord record;
+  record.timestamp_ = intended_send_time_.time_since_epoch();
+  record.worker_ = thread_stat_->worker_index_;
+  record.data_stream_id_ = std::max<int64_t>(options.data_stream_id_, 0);
+  record.data_step_id_ = std::max<int64_t>(options.data_step_id_, 0);
+  if (on_sequence_model_) {
+    record.sequence_id_ = options.sequence_id_;
+    record.sequence_start_ = options.sequence_start_;
+    record.sequence_end_ = options.sequence_end_;
+  }
+  thread_stat_->schedule_recorder_->Record(record);
+}
+
+int64_t
+InferContext::TakeScheduleLag()
+{
+  if (!has_intended_send_time_) {
+    return -1;
+  }
+  has_intended_send_time_ = false;
+  const int64_t lag_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - intended_send_time_)
+          .count();
+  // A request sent slightly early is not given a shorter latency
+  return std::max<int64_t>(lag_ns, 0);
+}
+
+void
+InferContext::DelaySend() const
+{
+  if (thread_stat_->send_delay_us_ != 0) {
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(thread_stat_->send_delay_us_));
+  }
+}
+
+void
+InferContext::RecordCorrectedLatency(
+    int64_t schedule_lag_ns, uint64_t latency_ns)
+{
+  if (schedule_lag_ns >= 0) {
+    thread_stat_->corrected_latency_histogram_.Record(
+        latency_ns + static_cast<uint64_t>(schedule_lag_ns));
+  }
+}
+
+void
+InferContext::RecordBucketLatency(
+    const std::string& bucket, uint64_t latency_ns)
+{
+  if (thread_stat_->latency_bucketing_ != BUCKET_NONE) {
+    thread_stat_->bucket_latency_histograms_[bucket].Record(latency_ns);
+  }
+}
+
+void
+InferContext::RecordClassLatency(size_t request_class, uint64_t latency_ns)
+{
+  if (thread_stat_->request_classes_ != nullptr) {
+    thread_stat_->request_class_stats_[request_class].latencies.Record(
+        latency_ns);
+  }
+}
+
+void
+InferContext::RecordEndpointLatency(size_t endpoint, uint64_t latency_ns)
+{
+  if (thread_stat_->endpoints_ != nullptr) {
+    thread_stat_->endpoint_latency_histograms_[endpoint].Record(latency_ns);
+  }
+}
+
+void
+InferContext::RecordSlowRequest(
+    uint64_t latency_ns, const AsyncRequestProperties& request)
+{
+  SlowRequestTracker& slow_requests = thread_stat_->slow_requests_;
+  if (!slow_requests.Admits(latency_ns)) {
+    return;
+  }
+  const auto to_ns =
+      [](const std::chrono::time_point<std::chrono::system_clock>& time) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                time.time_since_epoch())
+                .count());
+      };
+  SlowRequest slow_request;
+  slow_request.latency_ns = latency_ns;
+  slow_request.send_time_ns = to_ns(request.start_time_);
+  slow_request.first_response_time_ns = to_ns(request.first_response_time_);
+  slow_request.end_time_ns = to_ns(request.last_response_time_);
+  slow_request.schedule_lag_ns = request.schedule_lag_ns_;
+  slow_request.response_count = request.response_count_;
+  slow_request.worker = thread_stat_->worker_index_;
+  slow_request.context = id_;
+  slow_request.data_stream_id = request.data_stream_id_;
+  slow_request.data_step_id = request.data_step_id_;
+  slow_request.sequence_id = request.sequence_id_;
+  if (thread_stat_->endpoints_ != nullptr) {
+    slow_request.endpoint =
+        thread_stat_->endpoints_->Entry(request.endpoint_).url;
+  }
+  slow_requests.Record(std::move(slow_request));
+}
+
+void
+InferContext::SetRequestIds(AsyncRequestProperties* request) const
+{
+  const cb::InferOptions& options = *infer_data_.options_;
+  request->data_stream_id_ = std::max<int64_t>(options.data_stream_id_, 0);
+  request->data_step_id_ = std::max<int64_t>(options.data_step_id_, 0);
+  request->sequence_id_ = on_sequence_model_ ? options.sequence_id_ : 0;
+}
+
+bool
+InferContext::IsClassRejection(
+    size_t request_class, const cb::Error& err) const
+{
+  return (thread_stat_->request_classes_ != nullptr) &&
+         (thread_stat_->request_classes_->Entry(request_class)
+              .server_timeout_us != 0) &&
+         IsTimeoutRejection(err);
+}
+
+bool
+InferContext::CompleteRejectedRequest(
+    const std::shared_ptr<cb::InferResult>& result_ptr,
+    const std::string& sent_request_id)
+{
+  std::string request_id = sent_request_id;
+  if (request_id.empty() && !result_ptr->Id(&request_id).IsOk()) {
+    return false;
+  }
+  const auto it = async_req_map_.find(request_id);
+  if ((it == async_req_map_.end()) ||
+      !IsClassRejection(
+          it->second.request_class_, result_ptr->RequestStatus())) {
+    return false;
+  }
+  thread_stat_->request_class_stats_[it->second.request_class_]
+      .rejected_count++;
+  infer_data_manager_->CompleteRequest(
+      infer_data_, it->second.shm_slots_, nullptr /* validator */);
+  async_req_map_.erase(it);
+  return true;
+}
+
+void
+InferContext::AsyncCallbackFuncImpl(
+    cb::InferResult* result, const std::string& sent_request_id)
 {
   std::shared_ptr<cb::InferResult> result_ptr(result);
+  // A request of a decoupled model stays in flight until its final response
+  bool is_final_response = true;
+  if (!result_ptr->IsFinalResponse(&is_final_response).IsOk()) {
+    is_final_response = true;
+  }
+  ClientTracer* tracer = thread_stat_->tracer_.get();
+  const uint64_t callback_start_ns =
+      (tracer == nullptr) ? 0 : ClientTracer::NowNs();
   if (thread_stat_->cb_status_.IsOk()) {
+    // Ends before the finalize function, which may send the next request
+    ClientStageTimer::Scope callback_scope(
+        thread_stat_->stage_timer_, CLIENT_STAGE_CALLBACK);
     // Add the request timestamp to thread Timestamp vector with
     // proper locking
     std::lock_guard<std::mutex> lock(thread_stat_->mu_);
     thread_stat_->cb_status_ = result_ptr->RequestStatus();
-    if (thread_stat_->cb_status_.IsOk()) {
+    if (!thread_stat_->cb_status_.IsOk() &&
+        CompleteRejectedRequest(result_ptr, sent_request_id)) {
+      thread_stat_->cb_status_ = cb::Error::Success;
+      is_final_response = true;
+    } else if (thread_stat_->cb_status_.IsOk()) {
       std::chrono::time_point<std::chrono::system_clock> end_time_async;
       end_time_async = std::chrono::system_clock::now();
       std::string request_id;
       thread_stat_->cb_status_ = result_ptr->Id(&request_id);
       const auto& it = async_req_map_.find(request_id);
       if (it != async_req_map_.end()) {
-        thread_stat_->request_timestamps_.emplace_back(std::make_tuple(
-            it->second.start_time_, end_time_async, it->second.sequence_end_,
-            it->second.delayed_));
-        infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
-        thread_stat_->cb_status_ = ValidateOutputs(result);
-        async_req_map_.erase(request_id);
+        AsyncRequestProperties& request = it->second;
+        const uint64_t trace_id = request.trace_id_;
+        if ((trace_id != 0) && (request.response_count_ == 0) &&
+            (request.send_end_ns_ != 0)) {
+          tracer->Record(
+              {trace_id, CLIENT_SPAN_WAIT, id_, request.send_end_ns_,
+               callback_start_ns});
+        }
+        bool is_null_response = false;
+        result_ptr->IsNullResponse(&is_null_response);
+        if (!is_null_response) {
+          if (request.response_count_ == 0) {
+            request.first_response_time_ = end_time_async;
+            // Only the first response is validated, the outputs expected
+            // for the others are not known
+            ClientTracer::Scope validation_span(
+                tracer, trace_id, CLIENT_SPAN_VALIDATION, id_);
+            ValidateOutputs(result_ptr);
+          }
+          request.last_response_time_ = end_time_async;
+          request.response_count_++;
+        }
+        if (is_final_response) {
+          // The empty final response only marks the completion of the
+          // request, so the request ends with its last actual response
+          if (request.response_count_ == 0) {
+            request.first_response_time_ = end_time_async;
+            request.last_response_time_ = end_time_async;
+          }
+          thread_stat_->request_timestamps_.Push(
+              request.start_time_, request.last_response_time_,
+              request.sequence_end_, request.delayed_,
+              request.first_response_time_, request.response_count_);
+          if (thread_stat_->completion_counter_ != nullptr) {
+            thread_stat_->completion_counter_->Increment();
+          }
+          const uint64_t latency_ns =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  request.last_response_time_ - request.start_time_)
+                  .count();
+          if (thread_stat_->record_interval_latencies_) {
+            thread_stat_->interval_latency_histogram_.Record(latency_ns);
+          }
+          if (thread_stat_->record_threshold_latencies_) {
+            thread_stat_->threshold_latency_histogram_.Record(latency_ns);
+          }
+          RecordBucketLatency(request.latency_bucket_, latency_ns);
+          RecordClassLatency(request.request_class_, latency_ns);
+          RecordEndpointLatency(request.endpoint_, latency_ns);
+          RecordCorrectedLatency(request.schedule_lag_ns_, latency_ns);
+          RecordSlowRequest(latency_ns, request);
+          UpdateClientStat(request.endpoint_);
+          cb::Error complete_status = infer_data_manager_->CompleteRequest(
+              infer_data_, request.shm_slots_,
+              thread_stat_->cb_status_.IsOk()
+                  ? thread_stat_->output_validator_.get()
+                  : nullptr);
+          if (thread_stat_->cb_status_.IsOk()) {
+            thread_stat_->cb_status_ = complete_status;
+          }
+          async_req_map_.erase(request_id);
+        }
+        if (trace_id != 0) {
+          tracer->Record(
+              {trace_id, CLIENT_SPAN_CALLBACK, id_, callback_start_ns,
+               ClientTracer::NowNs()});
+        }
       }
     }
   }
 
-  total_ongoing_requests_--;
+  if (!is_final_response) {
+    return;
+  }
 
+  // Only counted as done once the worker has been told, so that a request
+  // the worker sends from here is never missed by a wait for the requests
+  // in flight to finish
   if (async_callback_finalize_func_ != nullptr) {
     async_callback_finalize_func_(id_);
   }
+
+  total_ongoing_requests_--;
+  thread_stat_->num_inflight_requests_--;
+  ReleaseInflightSlot();
 }
 
 }}  // namespace triton::perfanalyzer
\ No newline at end of file
@@ -26,16 +26,34 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <random>
+#include <string>
 #include <vector>
+#include "atomic_infer_stat.h"
+#include "client_backend_pool.h"
+#include "client_stage_timer.h"
+#include "client_trace.h"
+#include "completion_counter.h"
 #include "data_loader.h"
+#include "endpoint_mix.h"
 #include "idle_timer.h"
 #include "iinfer_data_manager.h"
 #include "infer_data.h"
+#include "inflight_limiter.h"
+#include "input_repeat.h"
+#include "latency_histogram.h"
+#include "output_validator.h"
 #include "perf_utils.h"
+#include "request_class.h"
+#include "request_record_ring.h"
+#include "schedule_recorder.h"
 #include "sequence_manager.h"
+#include "slow_request_tracker.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -50,17 +68,104 @@ struct ThreadStat {
   // TODO REFACTOR TMA-1046 -- This should be in the InferContext class
   // The statistics of the InferContext
   std::vector<cb::InferStat> contexts_stat_;
+  // The sum of contexts_stat_, which the profiler reads without taking mu_
+  AtomicInferStat client_stat_;
 
   // Tracks the amount of time this thread spent sleeping or waiting
   IdleTimer idle_timer;
 
-  // A vector of request timestamps <start_time, end_time>
-  // Request latency will be end_time - start_time
-  TimestampVector request_timestamps_;
-  // A lock to protect thread data
+  // The request timestamps <start_time, end_time> recorded by this thread.
+  // Request latency will be end_time - start_time. Drained by the profiler
+  // without taking mu_.
+  RequestRecordRing request_timestamps_;
+  // A lock to protect thread data. Also serializes the async callbacks that
+  // push into request_timestamps_.
   std::mutex mu_;
   // The number of sent requests by this thread.
   std::atomic<size_t> num_sent_requests_{0};
+  // The number of requests sent by this thread that have not completed yet.
+  std::atomic<size_t> num_inflight_requests_{0};
+  // Whether the latency of every completed request is also recorded in
+  // interval_latency_histogram_. Set before the thread starts.
+  bool record_interval_latencies_{false};
+  // The latencies of the requests completed since they were last collected,
+  // in nanoseconds. Protected by mu_.
+  LatencyHistogram interval_latency_histogram_;
+  // Whether the latency of every completed request is also recorded in
+  // threshold_latency_histogram_. Set before the thread starts.
+  bool record_threshold_latencies_{false};
+  // The latencies of the requests completed since they were last checked
+  // against the latency threshold, in nanoseconds. Protected by mu_.
+  LatencyHistogram threshold_latency_histogram_;
+  // How late each request was sent compared to its scheduled time, in
+  // nanoseconds. Only recorded by workers that follow a schedule.
+  LatencyHistogram schedule_error_histogram_;
+  // How long the requests over the cap of inflight_limiter_ waited for a
+  // slot, in nanoseconds. Protected by schedule_error_mu_.
+  LatencyHistogram queue_delay_histogram_;
+  // A lock to protect schedule_error_histogram_ and queue_delay_histogram_
+  std::mutex schedule_error_mu_;
+  // Caps the requests in flight across the threads, if not null. Set before
+  // the thread starts.
+  std::shared_ptr<InflightLimiter> inflight_limiter_;
+  // The number of requests dropped for being over the cap
+  std::atomic<size_t> num_dropped_requests_{0};
+  // The time spent in each client stage. Enabled before the thread starts.
+  ClientStageTimer stage_timer_;
+  // Samples the requests to trace and records their spans, if not null. Set
+  // before the thread starts.
+  std::shared_ptr<ClientTracer> tracer_;
+  // Counts the requests completed by all the threads, if not null. Set
+  // before the thread starts.
+  std::shared_ptr<CompletionCounter> completion_counter_;
+  // Validates the outputs against the expected outputs, if not null. Set
+  // before the thread starts.
+  std::shared_ptr<OutputValidator> output_validator_;
+  // What the latencies in bucket_latency_histograms_ are broken down by. Set
+  // before the thread starts.
+  LatencyBucketing latency_bucketing_{BUCKET_NONE};
+  // The latencies of the requests completed since they were last collected,
+  // in nanoseconds, by bucket. Protected by mu_.
+  std::map<std::string, LatencyHistogram> bucket_latency_histograms_;
+  // The latencies of the requests completed since they were last collected,
+  // measured from when their schedule meant to send them rather than from
+  // when they were sent, in nanoseconds. Only recorded for the requests that
+  // follow a schedule. Protected by mu_.
+  LatencyHistogram corrected_latency_histogram_;
+  // The request classes that the requests are spread over, if not null. Set
+  // before the thread starts.
+  std::shared_ptr<const RequestClassMix> request_classes_;
+  // What the requests of each request class came to since they were last
+  // collected, one entry per class of request_classes_. Protected by mu_.
+  std::vector<RequestClassStats> request_class_stats_;
+  // The endpoints that the requests are spread over, if not null. Set before
+  // the thread starts.
+  std::shared_ptr<const EndpointMix> endpoints_;
+  // The index of the thread among the worker threads. Set before the thread
+  // starts.
+  size_t worker_index_{0};
+  // The latencies of the requests completed since they were last collected,
+  // in nanoseconds, one entry per endpoint of endpoints_. Protected by mu_.
+  std::vector<LatencyHistogram> endpoint_latency_histograms_;
+  // The slowest requests completed since they were last collected. Its
+  // capacity is set before the thread starts, 0 to keep none. Protected by
+  // mu_.
+  SlowRequestTracker slow_requests_;
+  // Picks the inputs of the requests, if not null. Shared by all the threads
+  // and set before the thread starts.
+  std::shared_ptr<InputRepeat> input_repeat_;
+  // Records every request sent on a schedule, if not null. Shared by all the
+  // threads and set before the thread starts.
+  std::shared_ptr<ScheduleRecorder> schedule_recorder_;
+  // The time every request waits for before it is sent, in microseconds, to
+  // simulate a slow client. Set before the thread starts.
+  uint64_t send_delay_us_{0};
+  // The backends shared by the contexts of all the threads, if not null,
+  // instead of a backend per context. Set before the thread starts.
+  std::shared_ptr<ClientBackendPool> backend_pool_;
+  // Backends already connected, which the next contexts created by the
+  // thread take instead of creating their own. Protected by mu_.
+  std::deque<std::unique_ptr<cb::ClientBackend>> prepared_backends_;
 };
 
 /// The properties of an asynchronous request required in
@@ -69,10 +174,36 @@ struct AsyncRequestProperties {
   AsyncRequestProperties() : sequence_end_(false), delayed_(true) {}
   // The timestamp of when the request was started.
   std::chrono::time_point<std::chrono::system_clock> start_time_;
+  // The timestamps of the first and the last responses received so far.
+  std::chrono::time_point<std::chrono::system_clock> first_response_time_;
+  std::chrono::time_point<std::chrono::system_clock> last_response_time_;
+  // The number of responses received so far. Only the requests of decoupled
+  // models can receive more than one.
+  uint32_t response_count_{0};
   // Whether or not the request is at the end of a sequence.
   bool sequence_end_;
   // Whether or not the request is delayed as per schedule.
   bool delayed_;
+  // The shared memory slots held by the request.
+  SharedMemorySlots shm_slots_;
+  // The bucket the latency of the request is recorded in, if any.
+  std::string latency_bucket_;
+  // The id of the trace of the request, 0 if it is not traced.
+  uint64_t trace_id_{0};
+  // The request class of the request, if there are request classes.
+  size_t request_class_{0};
+  // The endpoint the request was sent to, if there are endpoints.
+  size_t endpoint_{0};
+  // The input data stream, step and sequence the request was sent with.
+  int64_t data_stream_id_{0};
+  int64_t data_step_id_{0};
+  uint64_t sequence_id_{0};
+  // How late the request started compared to when its schedule meant to
+  // send it, in nanoseconds, or -1 if it does not follow a schedule.
+  int64_t schedule_lag_ns_{-1};
+  // When the call that sent a traced request returned, in nanoseconds since
+  // the epoch. 0 until then.
+  uint64_t send_end_ns_{0};
 };
 
 #ifndef DOCTEST_CONFIG_DISABLE
@@ -99,10 +230,35 @@ class InferContext {
         infer_data_manager_(infer_data_manager),
         sequence_manager_(sequence_manager)
   {
-    thread_stat_->status_ = factory_->CreateClientBackend(&infer_backend_);
+    if (thread_stat_->backend_pool_ != nullptr) {
+      thread_stat_->status_ = thread_stat_->backend_pool_->Take(
+          &infer_backend_, &backend_pool_index_);
+    } else {
+      std::unique_ptr<cb::ClientBackend> backend;
+      {
+        std::lock_guard<std::mutex> lock(thread_stat_->mu_);
+        if (!thread_stat_->prepared_backends_.empty()) {
+          backend = std::move(thread_stat_->prepared_backends_.front());
+          thread_stat_->prepared_backends_.pop_front();
+          backend_prepared_ = true;
+        }
+      }
+      if (backend == nullptr) {
+        thread_stat_->status_ = factory_->CreateClientBackend(&backend);
+      }
+      infer_backend_ = std::move(backend);
+    }
     infer_data_.options_.reset(new cb::InferOptions(parser_->ModelName()));
     infer_data_.options_->model_version_ = parser_->ModelVersion();
     infer_data_.options_->model_signature_name_ = parser_->ModelSignatureName();
+    model_mix_ = parser_->GetModelMix();
+    model_mix_rng_.seed(id);
+    // Seeded apart from the model mix so that the class of a request does
+    // not follow its model
+    request_class_rng_.seed(~id);
+    // The contexts of every thread share ids, so the thread is mixed in
+    endpoint_rng_.seed(id + 0x9e3779b9 * (thread_stat_->worker_index_ + 1));
+    input_repeat_rng_.seed(~endpoint_rng_());
 
     thread_stat_->contexts_stat_.emplace_back();
   }
@@ -114,7 +270,7 @@ class InferContext {
   void Init();
 
   // Send a single inference request to the server
-  void SendInferRequest(bool delayed = false);
+  void SendInferRequest(bool delayed = false, uint64_t data_stream_id = 0);
 
   // Send a single sequence inference request to the server
   void SendSequenceInferRequest(uint32_t seq_index, bool delayed = false);
@@ -122,6 +278,9 @@ class InferContext {
   // Finish the active sequence at the given seq_stat_index
   void CompleteOngoingSequence(uint32_t seq_stat_index);
 
+  // Send a request with the input data and the sequence of a recorded one
+  void SendReplayedRequest(const ScheduleRecord& record, bool delayed = false);
+
   // Returns the total number of async requests that have been sent by this
   // object and have not returned
   uint GetNumOngoingRequests() { return total_ongoing_requests_; }
@@ -132,6 +291,19 @@ class InferContext {
     async_callback_finalize_func_ = callback;
   }
 
+  // Set when the schedule meant to send the next request, so that its latency
+  // is also measured from then. A request that is sent late would otherwise
+  // hide the time it spent waiting behind the requests before it.
+  void SetIntendedSendTime(std::chrono::steady_clock::time_point time)
+  {
+    intended_send_time_ = time;
+    has_intended_send_time_ = true;
+  }
+
+  // Stop counting the time spent in asynchronous sends as idle time, for
+  // sends that are made while the worker thread is already counted as idle
+  void DisableSendIdleTime() { track_send_idle_time_ = false; }
+
   // TODO REFACTOR TMA-1043 this should be in memory class
   void SetNumActiveThreads(size_t num_threads)
   {
@@ -145,15 +317,135 @@ class InferContext {
   virtual void SendRequest(const uint64_t request_id, const bool delayed);
 
   /// Update inputs based on custom json data
-  void UpdateJsonData();
+  void UpdateJsonData(uint64_t data_stream_id);
 
   /// Update inputs based on custom json data for the given sequence
   void UpdateSeqJsonData(size_t seq_stat_index);
 
-  cb::Error ValidateOutputs(const cb::InferResult* result_ptr);
+  /// Adds the request about to be sent to the schedule recorder
+  void RecordSchedule();
+
+  /// Points the next request to a model of the model mix, if any. Requests
+  /// of a sequence all go to the same model, whichever context sends them.
+  /// \return The model picked, or null without a model mix.
+  const ModelMixEntry* PickMixModel();
+
+  /// Gives the next request the priority and the server timeout of a
+  /// request class drawn by weight, if there are request classes.
+  void PickRequestClass();
+
+  /// Picks the endpoint of the next request as the policy of the endpoints
+  /// says, if there are endpoints. Requests of a sequence all go to the same
+  /// endpoint, which keeps the state of the sequence, whichever context sends
+  /// them.
+  /// \param request_id The number of requests the context sent before.
+  void PickEndpoint(const uint64_t request_id);
+
+  /// \param endpoint The index of an endpoint.
+  /// \return The backend that sends the requests of the context to the
+  /// endpoint.
+  cb::ClientBackend* EndpointBackend(size_t endpoint) const
+  {
+    return (endpoint == 0) ? infer_backend_.get()
+                           : endpoint_backends_[endpoint - 1].get();
+  }
+
+  /// \return A number in [0, 1) that only depends on the sequence of the
+  /// next request, so that the steps of a sequence draw the same.
+  double SequenceDraw() const;
+
+  /// Hands the outputs of the result to the output validator, which
+  /// compares them with the expected outputs off the worker thread.
+  /// \param result_ptr The result of the request.
+  void ValidateOutputs(const std::shared_ptr<cb::InferResult>& result_ptr);
 
-  // Callback function for handling asynchronous requests
-  void AsyncCallbackFuncImpl(cb::InferResult* result);
+  /// Takes a slot of the inflight limiter for the request about to be sent,
+  /// dropping the request or waiting for a slot when none is free. Requests
+  /// that end a sequence are never dropped, so that the sequence is not left
+  /// open on the server.
+  /// \return Whether the request is to be sent.
+  bool AdmitRequest(InflightLimiter* limiter);
+
+  /// Frees the slot of the inflight limiter held by a request, if any.
+  void ReleaseInflightSlot()
+  {
+    if (thread_stat_->inflight_limiter_ != nullptr) {
+      thread_stat_->inflight_limiter_->Release();
+    }
+  }
+
+  /// Reads the client stats of the context from its backend and adds what
+  /// they grew by to those of the thread. Requires 'thread_stat_->mu_' to be
+  /// held.
+  /// \param endpoint The endpoint of the backend that completed a request.
+  cb::Error UpdateClientStat(size_t endpoint = 0);
+
+  /// \param request_number The number of requests sent by the context so
+  /// far.
+  /// \return The id of the trace of the request about to be sent, or 0 if it
+  /// is not traced.
+  uint64_t SampleTrace(uint64_t request_number);
+
+  /// \return The bucket that the latency of the request about to be sent
+  /// falls in, or an empty string if latencies are not broken down.
+  std::string LatencyBucket() const;
+
+  /// Consumes the intended send time of the request being started.
+  /// \return How late the request is starting compared to its intended send
+  /// time, in nanoseconds, or -1 if none was set.
+  int64_t TakeScheduleLag();
+
+  /// Waits for the simulated send delay of the thread, if any, before the
+  /// request is sent.
+  void DelaySend() const;
+
+  /// Records the latency of a completed request measured from its intended
+  /// send time, if it has one. Requires 'thread_stat_->mu_' to be held.
+  void RecordCorrectedLatency(int64_t schedule_lag_ns, uint64_t latency_ns);
+
+  /// Records the latency of a completed request in its bucket. Requires
+  /// 'thread_stat_->mu_' to be held.
+  void RecordBucketLatency(const std::string& bucket, uint64_t latency_ns);
+
+  /// Records the latency of a completed request in its request class, if
+  /// there are request classes. Requires 'thread_stat_->mu_' to be held.
+  void RecordClassLatency(size_t request_class, uint64_t latency_ns);
+
+  /// Records the latency of a completed request in its endpoint, if there
+  /// are endpoints. Requires 'thread_stat_->mu_' to be held.
+  void RecordEndpointLatency(size_t endpoint, uint64_t latency_ns);
+
+  /// Records a completed request among the slowest ones, if it is slower
+  /// than those kept. Requires 'thread_stat_->mu_' to be held.
+  void RecordSlowRequest(
+      uint64_t latency_ns, const AsyncRequestProperties& request);
+
+  /// Sets the input data stream, step and sequence of 'request' from the
+  /// options of the request being sent.
+  void SetRequestIds(AsyncRequestProperties* request) const;
+
+  /// \param request_class The request class of a failed request.
+  /// \param err The error the request failed with.
+  /// \return Whether the server rejected the request for outliving the
+  /// timeout of its request class, which is measured rather than fatal.
+  bool IsClassRejection(size_t request_class, const cb::Error& err) const;
+
+  /// Counts an asynchronous request that the server rejected for outliving
+  /// the timeout of its request class and releases what it holds. Requires
+  /// 'thread_stat_->mu_' to be held.
+  /// \param result_ptr The result the request failed with.
+  /// \param sent_request_id The id the request was sent with, or an empty
+  /// string to take it from the result.
+  /// \return Whether the request was such a rejection.
+  bool CompleteRejectedRequest(
+      const std::shared_ptr<cb::InferResult>& result_ptr,
+      const std::string& sent_request_id);
+
+  // Callback function for handling asynchronous requests. The error of a
+  // rejected request may not carry the id of the request, so the id it was
+  // sent with can be given.
+  void AsyncCallbackFuncImpl(
+      cb::InferResult* result, const std::string& sent_request_id = "");
 
   const bool async_{false};
   const bool streaming_{false};
@@ -170,11 +462,17 @@ class InferContext {
   uint64_t request_id_ = 0;
   std::map<std::string, AsyncRequestProperties> async_req_map_;
   std::atomic<uint> total_ongoing_requests_{0};
+  bool track_send_idle_time_{true};
   size_t data_step_id_;
+  // The data stream of the inputs of the next request
+  uint64_t data_stream_id_{0};
+  // When the schedule meant to send the next request, if it follows one
+  std::chrono::steady_clock::time_point intended_send_time_;
+  bool has_intended_send_time_{false};
 
   // Function pointer to the async callback function implementation
-  std::function<void(cb::InferResult*)> async_callback_func_ = std::bind(
-      &InferContext::AsyncCallbackFuncImpl, this, std::placeholders::_1);
+  std::function<void(cb::InferResult*)> async_callback_func_ =
+      [this](cb::InferResult* result) { AsyncCallbackFuncImpl(result); };
 
   // Function pointer to registered async callbacks
   std::function<void(uint32_t)> async_callback_finalize_func_ = nullptr;
@@ -186,8 +484,18 @@ class InferContext {
 
   size_t num_active_threads_{0};
 
-  // The backend to communicate with the server
-  std::unique_ptr<cb::ClientBackend> infer_backend_;
+  // The backend to communicate with the server, the first endpoint if there
+  // are endpoints. Shared with other contexts if it was taken from
+  // 'thread_stat_->backend_pool_'.
+  std::shared_ptr<cb::ClientBackend> infer_backend_;
+  // The index of infer_backend_ in 'thread_stat_->backend_pool_'
+  size_t backend_pool_index_{0};
+  // Whether infer_backend_ was taken from 'thread_stat_->prepared_backends_'
+  bool backend_prepared_{false};
+  // The backends of the endpoints after the first, created by Init()
+  std::vector<std::unique_ptr<cb::ClientBackend>> endpoint_backends_;
+  // The client stats of the context read from each of endpoint_backends_
+  std::vector<cb::InferStat> endpoint_client_stats_;
   InferData infer_data_;
 
   // FIXME: update build to use C++17 instead of C++14. This is a workaround
@@ -197,6 +505,19 @@ class InferContext {
 
   std::shared_ptr<SequenceManager> sequence_manager_{nullptr};
 
+  std::shared_ptr<const ModelMix> model_mix_{nullptr};
+  std::mt19937 model_mix_rng_;
+
+  // The request class of the next request
+  size_t request_class_{0};
+  std::mt19937 request_class_rng_;
+
+  // The endpoint of the next request
+  size_t endpoint_{0};
+  std::mt19937 endpoint_rng_;
+
+  std::mt19937 input_repeat_rng_;
+
 #ifndef DOCTEST_CONFIG_DISABLE
   friend MockInferContext;
 
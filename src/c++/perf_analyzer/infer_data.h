@@ -29,6 +29,13 @@
 
 namespace triton { namespace perfanalyzer {
 
+/// The shared memory slots held by one inference request until it
+/// completes, or -1 for none
+struct SharedMemorySlots {
+  int input_slot_{-1};
+  int output_slot_{-1};
+};
+
 /// Holds all the data needed to send an inference request
 struct InferData {
   ~InferData()
@@ -47,6 +54,9 @@ struct InferData {
   // The vector of pointers to InferInput objects to be
   // used for inference request.
   std::vector<cb::InferInput*> valid_inputs_;
+  // With input data streamed from a directory, the buffers that the inputs
+  // point to, kept until the inputs are updated again
+  std::vector<std::shared_ptr<const std::vector<char>>> input_buffers_;
   // The vector of pointers to InferRequestedOutput objects
   // to be used with the inference request.
   std::vector<const cb::InferRequestedOutput*> outputs_;
@@ -55,6 +65,19 @@ struct InferData {
   // The InferOptions object holding the details of the
   // inference.
   std::unique_ptr<cb::InferOptions> options_;
+  // With pre-staged inputs, the ready-made inputs and expected outputs of
+  // every data step, by stream and then step. Moving to a step only copies
+  // its pointers into 'valid_inputs_' and 'expected_outputs_'.
+  std::vector<std::vector<std::unique_ptr<InferData>>> staged_steps_;
+  // With a shared memory region pool, the slot acquired for the step in
+  // 'valid_inputs_' and that step, or -1 if none. Requests sent with these
+  // inputs hold a reference of their own.
+  int shm_pool_slot_{-1};
+  int shm_pool_stream_{-1};
+  int shm_pool_step_{-1};
+  // Whether 'outputs_' are written to shared memory, in which case the
+  // results carry no output data and the InferDataManager validates them
+  bool outputs_in_shared_memory_{false};
 };
 
 
@@ -30,6 +30,49 @@
 
 namespace triton { namespace perfanalyzer {
 
+cb::Error
+InferDataManager::InitInferData(InferData& infer_data)
+{
+  RETURN_IF_ERROR(InferDataManagerBase::InitInferData(infer_data));
+  if (!prestage_inputs_) {
+    return cb::Error::Success;
+  }
+
+  // InferInput objects carry per-request state, so every context stages
+  // its own copy of each step
+  infer_data.staged_steps_.resize(data_loader_->GetDataStreamsCount());
+  for (size_t stream = 0; stream < infer_data.staged_steps_.size();
+       stream++) {
+    auto& staged_stream = infer_data.staged_steps_[stream];
+    staged_stream.resize(data_loader_->GetTotalSteps(stream));
+    for (size_t step = 0; step < staged_stream.size(); step++) {
+      staged_stream[step].reset(new InferData());
+      RETURN_IF_ERROR(InferDataManagerBase::InitInferData(
+          *(staged_stream[step])));
+      RETURN_IF_ERROR(UpdateInputs(stream, step, *(staged_stream[step])));
+      RETURN_IF_ERROR(
+          UpdateValidationOutputs(stream, step, *(staged_stream[step])));
+    }
+  }
+
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManager::UpdateInferData(
+    int stream_index, int step_index, InferData& infer_data)
+{
+  if (infer_data.staged_steps_.empty()) {
+    return InferDataManagerBase::UpdateInferData(
+        stream_index, step_index, infer_data);
+  }
+
+  RETURN_IF_ERROR(data_loader_->ValidateIndexes(stream_index, step_index));
+  const auto& staged = *(infer_data.staged_steps_[stream_index][step_index]);
+  infer_data.valid_inputs_ = staged.valid_inputs_;
+  infer_data.expected_outputs_ = staged.expected_outputs_;
+  return cb::Error::Success;
+}
 
 cb::Error
 InferDataManager::InitInferDataInput(
@@ -54,8 +97,12 @@ InferDataManager::InitInferDataInput(
 
   const uint8_t* data_ptr{nullptr};
   size_t batch1_bytesize;
+  std::shared_ptr<const std::vector<char>> buffer;
   RETURN_IF_ERROR(data_loader_->GetInputData(
-      model_tensor, 0, 0, &data_ptr, &batch1_bytesize));
+      model_tensor, 0, 0, &data_ptr, &batch1_bytesize, &buffer));
+  if (buffer != nullptr) {
+    infer_data.input_buffers_.push_back(std::move(buffer));
+  }
 
   // Add optional input to request if data was found
   if (data_ptr != nullptr) {
@@ -89,6 +136,7 @@ InferDataManager::UpdateInputs(
 {
   // Reset inputs for this inference request
   infer_data.valid_inputs_.clear();
+  infer_data.input_buffers_.clear();
 
   for (const auto& input : infer_data.inputs_) {
     RETURN_IF_ERROR(input->Reset());
@@ -129,10 +177,14 @@ InferDataManager::UpdateInputs(
         }
       }
       data_ptr = nullptr;
+      std::shared_ptr<const std::vector<char>> buffer;
       RETURN_IF_ERROR(data_loader_->GetInputData(
           model_input, stream_index,
           (step_index + i) % data_loader_->GetTotalSteps(0), &data_ptr,
-          &batch1_bytesize));
+          &batch1_bytesize, &buffer));
+      if (buffer != nullptr) {
+        infer_data.input_buffers_.push_back(std::move(buffer));
+      }
 
       // Update number of missing pieces of data for optional inputs to
       // potentially detect error
@@ -39,11 +39,16 @@ namespace triton { namespace perfanalyzer {
 /// inference output from triton server
 class InferDataManager : public InferDataManagerBase {
  public:
+  /// \param prestage_inputs Whether to build the inputs of every data step
+  /// once in InitInferData(), instead of updating the inputs for every
+  /// request.
   InferDataManager(
       const int32_t batch_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
-      : InferDataManagerBase(batch_size, parser, factory, data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const bool prestage_inputs = false)
+      : InferDataManagerBase(batch_size, parser, factory, data_loader),
+        prestage_inputs_(prestage_inputs)
   {
   }
 
@@ -51,6 +56,21 @@ class InferDataManager : public InferDataManagerBase {
   /// \return cb::Error object indicating success or failure.
   cb::Error Init() override { return cb::Error::Success; }
 
+  /// Populate the target InferData object with input and output objects
+  /// according to the model's shape. With pre-staged inputs, also builds
+  /// the inputs of every data step.
+  /// \param infer_data The target InferData object.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitInferData(InferData& infer_data) override;
+
+  /// Updates the input data to use for inference request
+  /// \param stream_index The data stream to use for next data
+  /// \param step_index The step index to use for next data
+  /// \param infer_data The target InferData object
+  /// \return cb::Error object indicating success or failure.
+  cb::Error UpdateInferData(
+      int stream_index, int step_index, InferData& infer_data) override;
+
  protected:
   cb::Error InitInferDataInput(
       const std::string& name, const ModelTensor& model_tensor,
@@ -67,6 +87,8 @@ class InferDataManager : public InferDataManagerBase {
   cb::Error UpdateInputs(
       const int stream_index, const int step_index, InferData& infer_data);
 
+  bool prestage_inputs_{false};
+
 #ifndef DOCTEST_CONFIG_DISABLE
  protected:
   InferDataManager() = default;
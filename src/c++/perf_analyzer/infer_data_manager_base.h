@@ -62,6 +62,31 @@ class InferDataManagerBase : public IInferDataManager {
   cb::Error UpdateInferData(
       int stream_index, int step_index, InferData& infer_data) override;
 
+  /// Prepares the target InferData object for sending a request. Nothing to
+  /// do unless the data is in shared memory.
+  /// \param infer_data The target InferData object
+  /// \param slots Returns the shared memory slots held by the request
+  /// \return cb::Error object indicating success or failure.
+  cb::Error PrepareRequest(
+      InferData& infer_data, SharedMemorySlots* slots) override
+  {
+    return cb::Error::Success;
+  }
+
+  /// Finishes a request sent after PrepareRequest(). Nothing to do unless
+  /// the data is in shared memory.
+  /// \param infer_data The InferData object the request was sent with
+  /// \param slots The shared memory slots of the request
+  /// \param validator The validator of the outputs of the request, nullptr
+  /// to not validate them
+  /// \return cb::Error object indicating success or failure.
+  cb::Error CompleteRequest(
+      const InferData& infer_data, const SharedMemorySlots& slots,
+      OutputValidator* validator) override
+  {
+    return cb::Error::Success;
+  }
+
  protected:
   size_t batch_size_;
   std::shared_ptr<ModelParser> parser_;
@@ -39,15 +39,18 @@ class InferDataManagerFactory {
       const int32_t batch_size, const SharedMemoryType shared_memory_type,
       const size_t output_shm_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const bool prestage_inputs = false, const size_t shm_pool_size = 0,
+      const size_t output_shm_slots = 0,
+      const cb::SharedMemoryOptions& shm_options = cb::SharedMemoryOptions())
   {
     if (shared_memory_type == SharedMemoryType::NO_SHARED_MEMORY) {
       return CreateInferDataManagerNoShm(
-          batch_size, parser, factory, data_loader);
+          batch_size, parser, factory, data_loader, prestage_inputs);
     } else {
       return CreateInferDataManagerShm(
           batch_size, shared_memory_type, output_shm_size, parser, factory,
-          data_loader);
+          data_loader, shm_pool_size, output_shm_slots, shm_options);
     }
   }
 
@@ -55,21 +58,24 @@ class InferDataManagerFactory {
   static std::shared_ptr<IInferDataManager> CreateInferDataManagerNoShm(
       const int32_t batch_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const bool prestage_inputs)
   {
     return std::make_shared<InferDataManager>(
-        batch_size, parser, factory, data_loader);
+        batch_size, parser, factory, data_loader, prestage_inputs);
   }
 
   static std::shared_ptr<IInferDataManager> CreateInferDataManagerShm(
       const int32_t batch_size, const SharedMemoryType shared_memory_type,
       const size_t output_shm_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const size_t shm_pool_size, const size_t output_shm_slots,
+      const cb::SharedMemoryOptions& shm_options)
   {
     return std::make_shared<InferDataManagerShm>(
         batch_size, shared_memory_type, output_shm_size, parser, factory,
-        data_loader);
+        data_loader, shm_pool_size, output_shm_slots, shm_options);
   }
 };
 
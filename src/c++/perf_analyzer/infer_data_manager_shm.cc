@@ -25,19 +25,74 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <thread>
 
 #include "infer_data_manager_shm.h"
 
 namespace triton { namespace perfanalyzer {
 
+namespace {
+
+#ifdef TRITON_ENABLE_GPU
+// With a pool, inputs are staged both by its background thread and by the
+// requests that miss it, so a second lane keeps a miss from waiting behind
+// a prefetch
+constexpr size_t kPoolCudaStagingLanes = 2;
+#endif  // TRITON_ENABLE_GPU
+
+// The most threads the input regions are created and registered by, and the
+// fewest regions worth a thread of their own
+constexpr size_t kMaxInputRegionThreadCount = 16;
+constexpr size_t kMinInputRegionsPerThread = 64;
+
+// FNV-1a over the byte sizes and the data of the batch entries of a region,
+// a word at a time, in hexadecimal
+std::string
+ContentHash(
+    const std::vector<const uint8_t*>& data_ptrs,
+    const std::vector<size_t>& byte_sizes)
+{
+  uint64_t hash = 0xcbf29ce484222325;
+  auto add = [&hash](uint64_t word) { hash = (hash ^ word) * 0x100000001b3; };
+  for (size_t i = 0; i < data_ptrs.size(); i++) {
+    add(byte_sizes[i]);
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= byte_sizes[i];
+         offset += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data_ptrs[i] + offset, sizeof(uint64_t));
+      add(word);
+    }
+    for (; offset < byte_sizes[i]; offset++) {
+      add(data_ptrs[i][offset]);
+    }
+  }
+  std::stringstream hex;
+  hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return hex.str();
+}
+
+}  // namespace
+
 InferDataManagerShm::~InferDataManagerShm()
 {
+  // Stop staging before the regions go away
+  pool_.reset();
+
   cb::Error err;
   if (backend_.get() != nullptr) {
-    err = backend_->UnregisterAllSharedMemory();
-    if (!err.IsOk()) {
-      std::cerr << "Unable to unregister all shared memory regions"
-                << std::endl;
+    // Persistent regions stay registered and in place for the next run,
+    // they are only unmapped
+    if (!shm_options_.persistent) {
+      err = backend_->UnregisterAllSharedMemory();
+      if (!err.IsOk()) {
+        std::cerr << "Unable to unregister all shared memory regions"
+                  << std::endl;
+      }
     }
     if (shared_memory_type_ == SharedMemoryType::SYSTEM_SHARED_MEMORY) {
       for (auto& region : shared_memory_regions_) {
@@ -55,6 +110,9 @@ InferDataManagerShm::~InferDataManagerShm()
                       << shared_memory_regions_[region.first].byte_size_
                       << std::endl;
           }
+          if (shm_options_.persistent) {
+            continue;
+          }
           err = backend_->UnlinkSharedMemoryRegion(region.first);
           if (!err.IsOk()) {
             std::cerr << "Unable to unlink shared memory with key: "
@@ -72,8 +130,21 @@ InferDataManagerShm::Init()
 {
   // TMA-1062 remove the factory from this class and use only the backend
   RETURN_IF_ERROR(factory_->CreateClientBackend(&backend_));
-  // Calling this function for the clean start
-  backend_->UnregisterAllSharedMemory();
+  if (shm_options_.persistent) {
+    // The regions of earlier runs are reused rather than unregistered
+    RETURN_IF_ERROR(backend_->SystemSharedMemoryStatus(&registered_regions_));
+  } else {
+    // Calling this function for the clean start
+    backend_->UnregisterAllSharedMemory();
+  }
+
+#ifdef TRITON_ENABLE_GPU
+  if (shared_memory_type_ == SharedMemoryType::CUDA_SHARED_MEMORY) {
+    cuda_staging_.reset(new CudaStagingPipeline(
+        pool_size_ != 0 ? kPoolCudaStagingLanes : kMaxInputRegionThreadCount));
+    RETURN_IF_ERROR(cuda_staging_->Init());
+  }
+#endif  // TRITON_ENABLE_GPU
 
   // Allocate the shared memory for outputs
   for (const auto& output : *(parser_->Outputs())) {
@@ -85,112 +156,320 @@ InferDataManagerShm::Init()
     }
     uint8_t* output_shm_ptr;
     size_t alloc_size = batch1_bytesize * batch_size_;
-    std::string region_name(TensorToRegionName(name));
-    RETURN_IF_ERROR(CreateMemoryRegion(
-        region_name, shared_memory_type_, alloc_size,
-        reinterpret_cast<void**>(&output_shm_ptr)));
+    if (output_slots_ == 0) {
+      RETURN_IF_ERROR(CreateMemoryRegion(
+          OutputRegionName(name, -1), shared_memory_type_, alloc_size,
+          reinterpret_cast<void**>(&output_shm_ptr)));
+    }
+    for (size_t slot = 0; slot < output_slots_; slot++) {
+      RETURN_IF_ERROR(CreateMemoryRegion(
+          OutputRegionName(name, slot), shared_memory_type_, alloc_size,
+          reinterpret_cast<void**>(&output_shm_ptr)));
+    }
+  }
+  for (size_t slot = 0; slot < output_slots_; slot++) {
+    free_output_slots_.push_back(slot);
+  }
+
+  if (pool_size_ != 0) {
+    return InitPool();
   }
 
+  // The data of every region is gathered first, the regions are then
+  // created, filled and registered by several threads
+  std::vector<InputRegion> regions;
+  std::set<std::string> persistent_names;
   for (const auto& input : *(parser_->Inputs())) {
     const std::string& name = input.first;
     const ModelTensor& tensor = input.second;
     for (int i = 0; i < (int)data_loader_->GetDataStreamsCount(); i++) {
       for (int j = 0; j < (int)data_loader_->GetTotalSteps(i); j += 1) {
         // Extract the data for requested batch size
+        InputRegion region;
+        RETURN_IF_ERROR(GatherInputData(
+            name, tensor, i, j, &region.data_ptrs_, &region.byte_sizes_,
+            &region.alloc_size_));
+        region.is_shape_tensor_ = tensor.is_shape_tensor_;
+
+        // Generate the shared memory region name
+        region.name_ = TensorToRegionName(name) + "_" + std::to_string(i) +
+                       "_" + std::to_string(j);
+        if (shm_options_.persistent) {
+          // Persistent regions are named by their data, which finds the
+          // region of an earlier run with the same data and shares one
+          // region between the steps with the same data
+          const std::string persistent_name(
+              TensorToRegionName(name) + "_" +
+              ContentHash(region.data_ptrs_, region.byte_sizes_));
+          persistent_region_names_[region.name_] = persistent_name;
+          region.name_ = persistent_name;
+          if (!persistent_names.insert(persistent_name).second) {
+            continue;
+          }
+        }
+        regions.push_back(std::move(region));
+      }
+    }
+  }
+  return InitInputRegions(regions);
+}
+
+size_t
+InferDataManagerShm::InputRegionThreadCount(const size_t region_count) const
+{
+  // Only remote servers are worth spreading the registrations over
+  // connections. The backends of the C API share one server, which they
+  // unload when destroyed.
+  if (factory_->Kind() != cb::BackendKind::TRITON) {
+    return 1;
+  }
+  return std::max<size_t>(
+      1, std::min<size_t>(
+             kMaxInputRegionThreadCount,
+             region_count / kMinInputRegionsPerThread));
+}
+
+cb::Error
+InferDataManagerShm::InitInputRegion(
+    InputRegion& region, cb::ClientBackend* backend)
+{
+  uint8_t* input_shm_ptr;
+  if (shm_options_.persistent) {
+    // The data of a registered region is in place, as a region is only
+    // registered once it is filled
+    bool registered;
+    RETURN_IF_ERROR(MapPersistentRegion(
+        region.name_, region.alloc_size_,
+        reinterpret_cast<void**>(&input_shm_ptr), &registered, backend));
+    if (registered) {
+      return cb::Error::Success;
+    }
+    RETURN_IF_ERROR(CopySharedMemory(
+        input_shm_ptr, region.data_ptrs_, region.byte_sizes_,
+        region.is_shape_tensor_, region.name_));
+    return RegisterPersistentRegion(region.name_, region.alloc_size_, backend);
+  }
+
+  RETURN_IF_ERROR(CreateMemoryRegion(
+      region.name_, shared_memory_type_, region.alloc_size_,
+      reinterpret_cast<void**>(&input_shm_ptr), backend));
+  if ((shared_memory_type_ == SharedMemoryType::CUDA_SHARED_MEMORY) &&
+      data_loader_->IsDeferredData(region.data_ptrs_[0])) {
+    return FillGeneratedData(input_shm_ptr, region.alloc_size_, region.name_);
+  }
+  return CopySharedMemory(
+      input_shm_ptr, region.data_ptrs_, region.byte_sizes_,
+      region.is_shape_tensor_, region.name_);
+}
+
+cb::Error
+InferDataManagerShm::InitInputRegions(std::vector<InputRegion>& regions)
+{
+  // Every thread registers its regions through a connection of its own, so
+  // that the round trips to the server overlap
+  const size_t thread_count = InputRegionThreadCount(regions.size());
+  std::vector<std::unique_ptr<cb::ClientBackend>> thread_backends(
+      thread_count - 1);
+  for (auto& thread_backend : thread_backends) {
+    RETURN_IF_ERROR(factory_->CreateClientBackend(&thread_backend));
+  }
+
+  std::vector<cb::Error> errors(thread_count, cb::Error::Success);
+  auto init_range = [&](size_t t) {
+    cb::ClientBackend* backend =
+        (t == 0) ? backend_.get() : thread_backends[t - 1].get();
+    const size_t end = regions.size() * (t + 1) / thread_count;
+    for (size_t r = regions.size() * t / thread_count; r < end; r++) {
+      errors[t] = InitInputRegion(regions[r], backend);
+      if (!errors[t].IsOk()) {
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < thread_count; t++) {
+    threads.emplace_back(init_range, t);
+  }
+  init_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& err : errors) {
+    RETURN_IF_ERROR(err);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManagerShm::InitPool()
+{
+  pool_byte_sizes_.resize(pool_size_);
+  for (const auto& input : *(parser_->Inputs())) {
+    const std::string& name = input.first;
+    const ModelTensor& tensor = input.second;
+
+    // Every step is still validated up front, so that bad data fails here
+    // rather than in the middle of the measurements
+    size_t max_alloc_size = 0;
+    for (int i = 0; i < (int)data_loader_->GetDataStreamsCount(); i++) {
+      for (int j = 0; j < (int)data_loader_->GetTotalSteps(i); j += 1) {
         std::vector<const uint8_t*> data_ptrs;
         std::vector<size_t> byte_size;
         size_t alloc_size = 0;
-        size_t count = 0;
-        size_t max_count = tensor.is_shape_tensor_ ? 1 : batch_size_;
-        std::vector<int64_t> shape;
-        std::vector<int64_t> prev_shape;
-        while (count < max_count) {
-          const uint8_t* data_ptr{nullptr};
-          size_t batch1_bytesize;
-
-          RETURN_IF_ERROR(data_loader_->GetInputShape(
-              tensor, i, (j + count) % data_loader_->GetTotalSteps(i), &shape));
-          if (!shape.empty()) {
-            if (count == 0) {
-              prev_shape = shape;
-            } else {
-              if (!std::equal(shape.begin(), shape.end(), prev_shape.begin())) {
-                return cb::Error(
-                    "can not batch tensors with different shapes together "
-                    "(input '" +
-                        name + "' expected shape " +
-                        ShapeVecToString(prev_shape) + " and received " +
-                        ShapeVecToString(shape),
-                    pa::GENERIC_ERROR);
-              }
-            }
-          }
+        RETURN_IF_ERROR(GatherInputData(
+            name, tensor, i, j, &data_ptrs, &byte_size, &alloc_size));
+        max_alloc_size = std::max(max_alloc_size, alloc_size);
+      }
+    }
 
-          RETURN_IF_ERROR(data_loader_->GetInputData(
-              tensor, i, (j + count) % data_loader_->GetTotalSteps(i),
-              &data_ptr, &batch1_bytesize));
+    for (size_t slot = 0; slot < pool_size_; slot++) {
+      uint8_t* input_shm_ptr;
+      RETURN_IF_ERROR(CreateMemoryRegion(
+          PoolRegionName(name, slot), shared_memory_type_, max_alloc_size,
+          reinterpret_cast<void**>(&input_shm_ptr)));
+      pool_byte_sizes_[slot][name] = 0;
+    }
+  }
 
-          // FIXME: TMA-765 - Shared memory mode does not support optional
-          // inputs, currently, and will be implemented in the associated story.
-          if (data_ptr == nullptr) {
-            return cb::Error(
-                "Shared memory support in Perf Analyzer does not support "
-                "optional inputs at this time");
-          }
+  pool_.reset(new SharedMemoryPool(
+      pool_size_, [this](size_t slot, int stream_index, int step_index) {
+        return StagePoolSlot(slot, stream_index, step_index);
+      }));
+  return cb::Error::Success;
+}
 
-          data_ptrs.push_back(data_ptr);
-          byte_size.push_back(batch1_bytesize);
-          alloc_size += batch1_bytesize;
-          count++;
-        }
+cb::Error
+InferDataManagerShm::StagePoolSlot(
+    size_t slot, int stream_index, int step_index)
+{
+#ifdef TRITON_ENABLE_GPU
+  if (cuda_staging_ != nullptr) {
+    // Queue all the inputs of the slot at once, so that packing one overlaps
+    // with the copy of the previous one
+    std::vector<CudaStagingCopy> copies;
+    std::vector<size_t> alloc_sizes;
+    for (const auto& input : *(parser_->Inputs())) {
+      copies.emplace_back();
+      alloc_sizes.push_back(0);
+      RETURN_IF_ERROR(GatherInputData(
+          input.first, input.second, stream_index, step_index,
+          &copies.back().data_ptrs_, &copies.back().byte_sizes_,
+          &alloc_sizes.back()));
+      copies.back().device_ptr_ =
+          shared_memory_regions_.at(PoolRegionName(input.first, slot))
+              .data_.get();
+    }
+    RETURN_IF_ERROR(cuda_staging_->Stage(copies));
+    size_t i = 0;
+    for (const auto& input : *(parser_->Inputs())) {
+      pool_byte_sizes_[slot][input.first] = alloc_sizes[i++];
+    }
+    return cb::Error::Success;
+  }
+#endif  // TRITON_ENABLE_GPU
 
-        // Validate if the shape tensors specified in the batch are identical.
-        while (count < batch_size_) {
-          const uint8_t* data_ptr{nullptr};
-          size_t batch1_bytesize;
-          RETURN_IF_ERROR(data_loader_->GetInputData(
-              tensor, i, (j + count) % data_loader_->GetTotalSteps(i),
-              &data_ptr, &batch1_bytesize));
-
-          // FIXME: TMA-765 - Shared memory mode does not support optional
-          // inputs, currently, and will be implemented in the associated story.
-          if (data_ptr == nullptr) {
-            return cb::Error(
-                "Shared memory support in Perf Analyzer does not support "
-                "optional inputs at this time");
-          }
+  for (const auto& input : *(parser_->Inputs())) {
+    const std::string& name = input.first;
+    std::vector<const uint8_t*> data_ptrs;
+    std::vector<size_t> byte_size;
+    size_t alloc_size = 0;
+    RETURN_IF_ERROR(GatherInputData(
+        name, input.second, stream_index, step_index, &data_ptrs, &byte_size,
+        &alloc_size));
+
+    std::string region_name(PoolRegionName(name, slot));
+    RETURN_IF_ERROR(CopySharedMemory(
+        shared_memory_regions_.at(region_name).data_.get(), data_ptrs,
+        byte_size, input.second.is_shape_tensor_, region_name));
+    pool_byte_sizes_[slot][name] = alloc_size;
+  }
+  return cb::Error::Success;
+}
 
-          if (batch1_bytesize != byte_size.back()) {
-            return cb::Error(
-                "The shape tensors should be identical in a batch (mismatch "
-                "in size)",
-                pa::GENERIC_ERROR);
-          }
+cb::Error
+InferDataManagerShm::GatherInputData(
+    const std::string& name, const ModelTensor& tensor, int stream_index,
+    int step_index, std::vector<const uint8_t*>* data_ptrs,
+    std::vector<size_t>* byte_size, size_t* alloc_size)
+{
+  const size_t total_steps = data_loader_->GetTotalSteps(stream_index);
+  size_t count = 0;
+  size_t max_count = tensor.is_shape_tensor_ ? 1 : batch_size_;
+  std::vector<int64_t> shape;
+  std::vector<int64_t> prev_shape;
+  while (count < max_count) {
+    const uint8_t* data_ptr{nullptr};
+    size_t batch1_bytesize;
 
-          for (size_t data_idx = 0; data_idx < batch1_bytesize; data_idx++) {
-            if (*(data_ptr + data_idx) != *(data_ptrs.back() + data_idx)) {
-              return cb::Error(
-                  "The shape tensors should be identical in a batch "
-                  "(mismatch in content)",
-                  pa::GENERIC_ERROR);
-            }
-          }
-          count++;
+    RETURN_IF_ERROR(data_loader_->GetInputShape(
+        tensor, stream_index, (step_index + count) % total_steps, &shape));
+    if (!shape.empty()) {
+      if (count == 0) {
+        prev_shape = shape;
+      } else {
+        if (!std::equal(shape.begin(), shape.end(), prev_shape.begin())) {
+          return cb::Error(
+              "can not batch tensors with different shapes together "
+              "(input '" +
+                  name + "' expected shape " +
+                  ShapeVecToString(prev_shape) + " and received " +
+                  ShapeVecToString(shape),
+              pa::GENERIC_ERROR);
         }
+      }
+    }
 
-        // Generate the shared memory region name
-        std::string region_name(
-            TensorToRegionName(name) + "_" + std::to_string(i) + "_" +
-            std::to_string(j));
-        uint8_t* input_shm_ptr;
-        RETURN_IF_ERROR(CreateMemoryRegion(
-            region_name, shared_memory_type_, alloc_size,
-            reinterpret_cast<void**>(&input_shm_ptr)));
-        RETURN_IF_ERROR(CopySharedMemory(
-            input_shm_ptr, data_ptrs, byte_size, tensor.is_shape_tensor_,
-            region_name));
+    RETURN_IF_ERROR(data_loader_->GetInputData(
+        tensor, stream_index, (step_index + count) % total_steps, &data_ptr,
+        &batch1_bytesize));
+
+    // FIXME: TMA-765 - Shared memory mode does not support optional
+    // inputs, currently, and will be implemented in the associated story.
+    if (data_ptr == nullptr) {
+      return cb::Error(
+          "Shared memory support in Perf Analyzer does not support "
+          "optional inputs at this time");
+    }
+
+    data_ptrs->push_back(data_ptr);
+    byte_size->push_back(batch1_bytesize);
+    *alloc_size += batch1_bytesize;
+    count++;
+  }
+
+  // Validate if the shape tensors specified in the batch are identical.
+  while (count < batch_size_) {
+    const uint8_t* data_ptr{nullptr};
+    size_t batch1_bytesize;
+    RETURN_IF_ERROR(data_loader_->GetInputData(
+        tensor, stream_index, (step_index + count) % total_steps, &data_ptr,
+        &batch1_bytesize));
+
+    // FIXME: TMA-765 - Shared memory mode does not support optional
+    // inputs, currently, and will be implemented in the associated story.
+    if (data_ptr == nullptr) {
+      return cb::Error(
+          "Shared memory support in Perf Analyzer does not support "
+          "optional inputs at this time");
+    }
+
+    if (batch1_bytesize != byte_size->back()) {
+      return cb::Error(
+          "The shape tensors should be identical in a batch (mismatch "
+          "in size)",
+          pa::GENERIC_ERROR);
+    }
+
+    for (size_t data_idx = 0; data_idx < batch1_bytesize; data_idx++) {
+      if (*(data_ptr + data_idx) != *(data_ptrs->back() + data_idx)) {
+        return cb::Error(
+            "The shape tensors should be identical in a batch "
+            "(mismatch in content)",
+            pa::GENERIC_ERROR);
       }
     }
+    count++;
   }
   return cb::Error::Success;
 }
@@ -198,40 +477,46 @@ InferDataManagerShm::Init()
 cb::Error
 InferDataManagerShm::CreateMemoryRegion(
     const std::string& shm_region_name, const SharedMemoryType& memory_type,
-    const size_t byte_size, void** ptr)
+    const size_t byte_size, void** ptr, cb::ClientBackend* backend)
 {
+  if (backend == nullptr) {
+    backend = backend_.get();
+  }
+  std::unique_ptr<uint8_t, std::function<void(uint8_t*)>> data;
   if (memory_type == SharedMemoryType::SYSTEM_SHARED_MEMORY) {
     if (factory_->Kind() ==
         triton::perfanalyzer::clientbackend::BackendKind::TRITON_C_API) {
       *ptr = new uint8_t[byte_size];
       RETURN_IF_ERROR(
-          backend_->RegisterSystemMemory(shm_region_name, *ptr, byte_size));
+          backend->RegisterSystemMemory(shm_region_name, *ptr, byte_size));
 
       // Set free as the destructor.
-      shared_memory_regions_.emplace(
-          std::piecewise_construct, std::forward_as_tuple(shm_region_name),
-          std::forward_as_tuple(SharedMemoryData(
-              byte_size,
-              std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-                  reinterpret_cast<uint8_t*>(*ptr),
-                  [](uint8_t* memory) { free(memory); }))));
+      data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
+          reinterpret_cast<uint8_t*>(*ptr),
+          [](uint8_t* memory) { free(memory); });
+    } else if (shm_options_.persistent) {
+      bool registered;
+      RETURN_IF_ERROR(MapPersistentRegion(
+          shm_region_name, byte_size, ptr, &registered, backend));
+      if (!registered) {
+        RETURN_IF_ERROR(
+            RegisterPersistentRegion(shm_region_name, byte_size, backend));
+      }
+      return cb::Error::Success;
     } else {
       std::string shm_key("/" + shm_region_name);
       int shm_fd_op;
       RETURN_IF_ERROR(
-          backend_->CreateSharedMemoryRegion(shm_key, byte_size, &shm_fd_op));
-      RETURN_IF_ERROR(backend_->MapSharedMemory(shm_fd_op, 0, byte_size, ptr));
+          backend->CreateSharedMemoryRegion(shm_key, byte_size, &shm_fd_op));
+      RETURN_IF_ERROR(backend->MapSharedMemory(
+          shm_fd_op, 0, byte_size, shm_options_, ptr));
 
-      RETURN_IF_ERROR(backend_->RegisterSystemSharedMemory(
+      RETURN_IF_ERROR(backend->RegisterSystemSharedMemory(
           shm_region_name, shm_key, byte_size));
 
       // No-op destruction
-      shared_memory_regions_.emplace(
-          std::piecewise_construct, std::forward_as_tuple(shm_region_name),
-          std::forward_as_tuple(SharedMemoryData(
-              byte_size,
-              std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-                  reinterpret_cast<uint8_t*>(*ptr), [](uint8_t* memory) {}))));
+      data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
+          reinterpret_cast<uint8_t*>(*ptr), [](uint8_t* memory) {});
     }
   } else if (memory_type == SharedMemoryType::CUDA_SHARED_MEMORY) {
 #ifdef TRITON_ENABLE_GPU
@@ -247,41 +532,32 @@ InferDataManagerShm::CreateMemoryRegion(
     if (factory_->Kind() ==
         triton::perfanalyzer::clientbackend::BackendKind::TRITON_C_API) {
       RETURN_IF_ERROR(
-          backend_->RegisterCudaMemory(shm_region_name, *ptr, byte_size));
+          backend->RegisterCudaMemory(shm_region_name, *ptr, byte_size));
 
       // Set cudaFree as the destructor
-      shared_memory_regions_.emplace(
-          std::piecewise_construct, std::forward_as_tuple(shm_region_name),
-          std::forward_as_tuple(SharedMemoryData(
-              byte_size,
-              std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-                  reinterpret_cast<uint8_t*>(*ptr),
-                  [shm_region_name, byte_size](uint8_t* memory) {
-                    cudaError_t cuda_err = cudaFree(memory);
-                    if (cuda_err != cudaSuccess) {
-                      std::cerr
-                          << "Unable to free cuda shared memory for "
-                          << shm_region_name
-                          << ": Starting: " << static_cast<void*>(memory)
-                          << ", size: " << byte_size
-                          << " bytes, Details: " << cudaGetErrorString(cuda_err)
-                          << std::endl;
-                    }
-                  }))));
+      data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
+          reinterpret_cast<uint8_t*>(*ptr),
+          [shm_region_name, byte_size](uint8_t* memory) {
+            cudaError_t cuda_err = cudaFree(memory);
+            if (cuda_err != cudaSuccess) {
+              std::cerr << "Unable to free cuda shared memory for "
+                        << shm_region_name
+                        << ": Starting: " << static_cast<void*>(memory)
+                        << ", size: " << byte_size
+                        << " bytes, Details: " << cudaGetErrorString(cuda_err)
+                        << std::endl;
+            }
+          });
     } else {
       cudaIpcMemHandle_t cuda_handle;
       RETURN_IF_ERROR(
           CreateCUDAIPCHandle(&cuda_handle, reinterpret_cast<void*>(*ptr)));
-      RETURN_IF_ERROR(backend_->RegisterCudaSharedMemory(
+      RETURN_IF_ERROR(backend->RegisterCudaSharedMemory(
           shm_region_name, cuda_handle, byte_size));
 
       // No operation required for deleting the memory
-      shared_memory_regions_.emplace(
-          std::piecewise_construct, std::forward_as_tuple(shm_region_name),
-          std::forward_as_tuple(SharedMemoryData(
-              byte_size,
-              std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-                  reinterpret_cast<uint8_t*>(*ptr), [](uint8_t* memory) {}))));
+      data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
+          reinterpret_cast<uint8_t*>(*ptr), [](uint8_t* memory) {});
     }
 #endif  // TRITON_ENABLE_GPU
   } else {
@@ -290,9 +566,56 @@ InferDataManagerShm::CreateMemoryRegion(
         pa::GENERIC_ERROR);
   }
 
+  // The input regions are created by several threads
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  shared_memory_regions_.emplace(
+      std::piecewise_construct, std::forward_as_tuple(shm_region_name),
+      std::forward_as_tuple(SharedMemoryData(byte_size, std::move(data))));
   return cb::Error::Success;
 }
 
+cb::Error
+InferDataManagerShm::MapPersistentRegion(
+    const std::string& shm_region_name, const size_t byte_size, void** ptr,
+    bool* registered, cb::ClientBackend* backend)
+{
+  // Opening the object of an earlier run keeps its data
+  const std::string shm_key("/" + shm_region_name);
+  int shm_fd_op;
+  RETURN_IF_ERROR(
+      backend->CreateSharedMemoryRegion(shm_key, byte_size, &shm_fd_op));
+  RETURN_IF_ERROR(
+      backend->MapSharedMemory(shm_fd_op, 0, byte_size, shm_options_, ptr));
+  RETURN_IF_ERROR(backend->CloseSharedMemory(shm_fd_op));
+
+  const auto it = registered_regions_.find(shm_region_name);
+  *registered = (it != registered_regions_.end()) &&
+                (it->second.key == shm_key) &&
+                (it->second.byte_size == byte_size);
+
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  shared_memory_regions_.emplace(
+      std::piecewise_construct, std::forward_as_tuple(shm_region_name),
+      std::forward_as_tuple(SharedMemoryData(
+          byte_size, std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
+                         reinterpret_cast<uint8_t*>(*ptr),
+                         [](uint8_t* memory) {}))));
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManagerShm::RegisterPersistentRegion(
+    const std::string& shm_region_name, const size_t byte_size,
+    cb::ClientBackend* backend)
+{
+  // A region of an earlier run with the name but another size is replaced
+  if (registered_regions_.find(shm_region_name) != registered_regions_.end()) {
+    RETURN_IF_ERROR(backend->UnregisterSystemSharedMemory(shm_region_name));
+  }
+  return backend->RegisterSystemSharedMemory(
+      shm_region_name, "/" + shm_region_name, byte_size);
+}
+
 cb::Error
 InferDataManagerShm::CopySharedMemory(
     uint8_t* input_shm_ptr, std::vector<const uint8_t*>& data_ptrs,
@@ -312,27 +635,64 @@ InferDataManagerShm::CopySharedMemory(
   } else {
 #ifdef TRITON_ENABLE_GPU
     // Populate the region with data
-    size_t count = 0;
-    size_t offset = 0;
     size_t max_count = is_shape_tensor ? 1 : batch_size_;
-    while (count < max_count) {
-      cudaError_t cuda_err = cudaMemcpy(
-          (void*)(input_shm_ptr + offset), (void*)data_ptrs[count],
-          byte_size[count], cudaMemcpyHostToDevice);
-      if (cuda_err != cudaSuccess) {
-        return cb::Error(
-            "Failed to copy data to cuda shared memory for " + region_name +
-                " : " + std::string(cudaGetErrorString(cuda_err)),
-            pa::GENERIC_ERROR);
-      }
-      offset += byte_size[count];
-      count++;
+    std::vector<CudaStagingCopy> copies(1);
+    copies[0].device_ptr_ = input_shm_ptr;
+    copies[0].data_ptrs_.assign(
+        data_ptrs.begin(), data_ptrs.begin() + max_count);
+    copies[0].byte_sizes_.assign(
+        byte_size.begin(), byte_size.begin() + max_count);
+    cb::Error err = cuda_staging_->Stage(copies);
+    if (!err.IsOk()) {
+      return cb::Error(
+          "Failed to copy data to cuda shared memory for " + region_name +
+              " : " + err.Message(),
+          pa::GENERIC_ERROR);
     }
 #endif  // TRITON_ENABLE_GPU
   }
   return cb::Error::Success;
 }
 
+cb::Error
+InferDataManagerShm::FillGeneratedData(
+    uint8_t* input_shm_ptr, size_t byte_size, const std::string& region_name)
+{
+#ifdef TRITON_ENABLE_GPU
+  // Only the pattern crosses the bus, the copies on the device double the
+  // filled part until it covers the region
+  const std::vector<uint8_t>& pattern = data_loader_->GeneratedPattern();
+  size_t filled = std::min(pattern.size(), byte_size);
+  cudaError_t cuda_err = cudaMemcpy(
+      input_shm_ptr, pattern.data(), filled, cudaMemcpyHostToDevice);
+  while ((cuda_err == cudaSuccess) && (filled < byte_size)) {
+    const size_t count = std::min(filled, byte_size - filled);
+    cuda_err = cudaMemcpy(
+        input_shm_ptr + filled, input_shm_ptr, count,
+        cudaMemcpyDeviceToDevice);
+    filled += count;
+  }
+  if (cuda_err != cudaSuccess) {
+    return cb::Error(
+        "Failed to fill generated data in cuda shared memory for " +
+            region_name + " : " + std::string(cudaGetErrorString(cuda_err)),
+        pa::GENERIC_ERROR);
+  }
+#endif  // TRITON_ENABLE_GPU
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManagerShm::InitInferData(InferData& infer_data)
+{
+  RETURN_IF_ERROR(InferDataManagerBase::InitInferData(infer_data));
+  if (pool_ != nullptr) {
+    // The inputs have no region until they acquire a slot
+    RETURN_IF_ERROR(UpdateInputs(0, 0, infer_data));
+  }
+  return cb::Error::Success;
+}
+
 cb::Error
 InferDataManagerShm::InitInferDataInput(
     const std::string& name, const ModelTensor& model_tensor,
@@ -357,9 +717,11 @@ InferDataManagerShm::InitInferDataInput(
   // currently, and will be implemented in the associated story.
   infer_data.valid_inputs_.push_back(infer_input);
 
-  std::string region_name(
-      TensorToRegionName(name) + "_" + std::to_string(0) + "_" +
-      std::to_string(0));
+  if (pool_ != nullptr) {
+    return cb::Error::Success;
+  }
+
+  std::string region_name(InputRegionName(name, 0, 0));
   RETURN_IF_ERROR(infer_input->SetSharedMemory(
       region_name, shared_memory_regions_[region_name].byte_size_));
 
@@ -374,25 +736,127 @@ InferDataManagerShm::InitInferDataOutput(
   RETURN_IF_ERROR(
       cb::InferRequestedOutput::Create(&requested_output, backend_kind_, name));
   infer_data.outputs_.push_back(requested_output);
+  infer_data.outputs_in_shared_memory_ = true;
 
-  std::string region_name(TensorToRegionName(name));
+  // With output slots, the region is picked for every request
+  if (output_slots_ != 0) {
+    return cb::Error::Success;
+  }
+
+  std::string region_name(OutputRegionName(name, -1));
   RETURN_IF_ERROR(requested_output->SetSharedMemory(
       region_name, shared_memory_regions_[region_name].byte_size_));
 
   return cb::Error::Success;
 }
 
+cb::Error
+InferDataManagerShm::PrepareRequest(
+    InferData& infer_data, SharedMemorySlots* slots)
+{
+  if (infer_data.shm_pool_slot_ >= 0) {
+    pool_->Retain(infer_data.shm_pool_slot_);
+    slots->input_slot_ = infer_data.shm_pool_slot_;
+  }
+
+  if (output_slots_ != 0) {
+    {
+      std::unique_lock<std::mutex> lock(output_slots_mutex_);
+      output_slots_cv_.wait(
+          lock, [this]() { return !free_output_slots_.empty(); });
+      slots->output_slot_ = free_output_slots_.back();
+      free_output_slots_.pop_back();
+    }
+    for (const auto& output : infer_data.outputs_) {
+      std::string region_name(
+          OutputRegionName(output->Name(), slots->output_slot_));
+      RETURN_IF_ERROR(
+          const_cast<cb::InferRequestedOutput*>(output)->SetSharedMemory(
+              region_name, shared_memory_regions_.at(region_name).byte_size_));
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManagerShm::CompleteRequest(
+    const InferData& infer_data, const SharedMemorySlots& slots,
+    OutputValidator* validator)
+{
+  cb::Error err;
+  if ((validator != nullptr) && !infer_data.expected_outputs_.empty()) {
+    for (size_t i = 0; i < infer_data.outputs_.size() && err.IsOk(); ++i) {
+      const std::string& name = infer_data.outputs_[i]->Name();
+      err = ValidateOutputRegion(
+          OutputRegionName(name, slots.output_slot_),
+          {&parser_->Outputs()->at(name), infer_data.expected_outputs_[i]},
+          validator);
+    }
+  }
+
+  if (slots.output_slot_ >= 0) {
+    {
+      std::lock_guard<std::mutex> lock(output_slots_mutex_);
+      free_output_slots_.push_back(slots.output_slot_);
+    }
+    output_slots_cv_.notify_one();
+  }
+  if (slots.input_slot_ >= 0) {
+    pool_->Release(slots.input_slot_);
+  }
+  return err;
+}
+
+cb::Error
+InferDataManagerShm::ValidateOutputRegion(
+    const std::string& region_name,
+    const OutputValidator::ExpectedOutput& output, OutputValidator* validator)
+{
+  const SharedMemoryData& region = shared_memory_regions_.at(region_name);
+  // The region may be larger than the output, the data past the expected
+  // output is not compared unless the expected output does not fit
+  size_t byte_size = 0;
+  for (const auto& batch_output : output.expected_) {
+    byte_size += batch_output.second;
+  }
+  byte_size = std::min(byte_size, region.byte_size_);
+  const uint8_t* actual = region.data_.get();
+#ifdef TRITON_ENABLE_GPU
+  // There is no comparison kernel, so device data is compared through one
+  // reused host buffer per thread
+  thread_local std::vector<uint8_t> host_copy;
+  if (shared_memory_type_ == SharedMemoryType::CUDA_SHARED_MEMORY) {
+    host_copy.resize(byte_size);
+    RETURN_IF_CUDA_ERR(cudaMemcpy(
+        host_copy.data(), actual, byte_size, cudaMemcpyDeviceToHost));
+    actual = host_copy.data();
+  }
+#endif  // TRITON_ENABLE_GPU
+  validator->Validate(output, actual, byte_size);
+  return cb::Error::Success;
+}
+
 cb::Error
 InferDataManagerShm::UpdateInputs(
     const int stream_index, const int step_index, InferData& infer_data)
 {
+  if (pool_ != nullptr) {
+    RETURN_IF_ERROR(AcquirePoolSlot(stream_index, step_index, infer_data));
+  }
+
   for (const auto& input : infer_data.inputs_) {
     RETURN_IF_ERROR(input->Reset());
     const auto& model_input = (*(parser_->Inputs()))[input->Name()];
 
-    std::string region_name(
-        TensorToRegionName(input->Name()) + '_' + std::to_string(stream_index) +
-        "_" + std::to_string(step_index));
+    std::string region_name;
+    size_t byte_size;
+    if (pool_ != nullptr) {
+      region_name = PoolRegionName(input->Name(), infer_data.shm_pool_slot_);
+      byte_size = pool_byte_sizes_[infer_data.shm_pool_slot_][input->Name()];
+    } else {
+      region_name = InputRegionName(input->Name(), stream_index, step_index);
+      byte_size = shared_memory_regions_[region_name].byte_size_;
+    }
 
     std::vector<int64_t> shape;
     RETURN_IF_ERROR(data_loader_->GetInputShape(
@@ -403,8 +867,43 @@ InferDataManagerShm::UpdateInputs(
       }
       input->SetShape(shape);
     }
-    RETURN_IF_ERROR(input->SetSharedMemory(
-        region_name, shared_memory_regions_[region_name].byte_size_));
+    RETURN_IF_ERROR(input->SetSharedMemory(region_name, byte_size));
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+InferDataManagerShm::AcquirePoolSlot(
+    const int stream_index, const int step_index, InferData& infer_data)
+{
+  const int total_steps = data_loader_->GetTotalSteps(stream_index);
+
+  // A context moves through the steps with a fixed stride, so the step
+  // after this one is most likely the same distance ahead
+  int stride = 1;
+  if (infer_data.shm_pool_stream_ == stream_index) {
+    stride = (step_index - infer_data.shm_pool_step_ + total_steps) %
+             total_steps;
+  }
+
+  if ((infer_data.shm_pool_slot_ < 0) ||
+      (infer_data.shm_pool_stream_ != stream_index) ||
+      (infer_data.shm_pool_step_ != step_index)) {
+    // Give the old slot back first. Requests in flight hold references of
+    // their own, and they all finish, so waiting for a slot cannot deadlock.
+    if (infer_data.shm_pool_slot_ >= 0) {
+      pool_->Release(infer_data.shm_pool_slot_);
+      infer_data.shm_pool_slot_ = -1;
+    }
+    size_t slot;
+    RETURN_IF_ERROR(pool_->Acquire(stream_index, step_index, &slot));
+    infer_data.shm_pool_slot_ = slot;
+    infer_data.shm_pool_stream_ = stream_index;
+    infer_data.shm_pool_step_ = step_index;
+  }
+
+  if (stride != 0) {
+    pool_->Prefetch(stream_index, (step_index + stride) % total_steps);
   }
   return cb::Error::Success;
 }
@@ -25,13 +25,17 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include <mutex>
+
 #include "client_backend/client_backend.h"
 #include "constants.h"
+#include "cuda_staging_pipeline.h"
 #include "data_loader.h"
 #include "infer_data.h"
 #include "infer_data_manager_base.h"
 #include "model_parser.h"
 #include "perf_utils.h"
+#include "shared_memory_pool.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -96,10 +100,13 @@ class InferDataManagerShm : public InferDataManagerBase {
       const int32_t batch_size, const SharedMemoryType shared_memory_type,
       const size_t output_shm_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
-      : shared_memory_type_(shared_memory_type),
-        output_shm_size_(output_shm_size),
-        InferDataManagerBase(batch_size, parser, factory, data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const size_t pool_size = 0, const size_t output_slots = 0,
+      const cb::SharedMemoryOptions& shm_options = cb::SharedMemoryOptions())
+      : InferDataManagerBase(batch_size, parser, factory, data_loader),
+        shared_memory_type_(shared_memory_type),
+        output_shm_size_(output_shm_size), pool_size_(pool_size),
+        output_slots_(output_slots), shm_options_(shm_options)
   {
   }
 
@@ -109,12 +116,82 @@ class InferDataManagerShm : public InferDataManagerBase {
   /// \return cb::Error object indicating success or failure.
   cb::Error Init() override;
 
+  /// Populate the target InferData object with input and output objects
+  /// according to the model's shape.
+  /// \param infer_data The target InferData object.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitInferData(InferData& infer_data) override;
+
+  /// Points the outputs of the target InferData object at a free output
+  /// slot, if the output regions are time-sliced, and references the input
+  /// slot it was updated to, if the inputs are pooled.
+  /// \param infer_data The target InferData object
+  /// \param slots Returns the shared memory slots held by the request
+  /// \return cb::Error object indicating success or failure.
+  cb::Error PrepareRequest(
+      InferData& infer_data, SharedMemorySlots* slots) override;
+
+  /// Validates the outputs of a completed request in place, if asked to and
+  /// there are expected outputs, and gives back its slots. The outputs are
+  /// validated before the slots are given back, as the next request
+  /// overwrites them.
+  /// \param infer_data The InferData object the request was sent with
+  /// \param slots The shared memory slots of the request
+  /// \param validator The validator of the outputs of the request, nullptr
+  /// to not validate them
+  /// \return cb::Error object indicating success or failure.
+  cb::Error CompleteRequest(
+      const InferData& infer_data, const SharedMemorySlots& slots,
+      OutputValidator* validator) override;
+
  protected:
-  /// Create a memory region.
+  /// The data of an input region for a data step.
+  struct InputRegion {
+    std::string name_;
+    std::vector<const uint8_t*> data_ptrs_;
+    std::vector<size_t> byte_sizes_;
+    size_t alloc_size_{0};
+    bool is_shape_tensor_{false};
+  };
+
+  /// Create a memory region. Can be called by several threads at once.
+  /// \param backend The backend the region is registered through, backend_
+  /// if null.
   /// \return cb::Error object indicating success or failure.
   cb::Error CreateMemoryRegion(
       const std::string& shm_region_name, const SharedMemoryType& memory_type,
-      const size_t byte_size, void** ptr);
+      const size_t byte_size, void** ptr, cb::ClientBackend* backend = nullptr);
+
+  /// Creates and maps a system shared memory region that is kept after the
+  /// run, or maps the region of an earlier run with the name.
+  /// \param registered Returns whether the region is registered with the
+  /// server by an earlier run, in which case its data is in place.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error MapPersistentRegion(
+      const std::string& shm_region_name, const size_t byte_size, void** ptr,
+      bool* registered, cb::ClientBackend* backend);
+
+  /// Registers a region created by MapPersistentRegion() with the server.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error RegisterPersistentRegion(
+      const std::string& shm_region_name, const size_t byte_size,
+      cb::ClientBackend* backend);
+
+  /// \param region_count The number of input regions to create.
+  /// \return The number of threads to create the input regions with.
+  size_t InputRegionThreadCount(const size_t region_count) const;
+
+  /// Creates, fills and registers an input region.
+  /// \param region The region to create.
+  /// \param backend The backend the region is registered through.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitInputRegion(InputRegion& region, cb::ClientBackend* backend);
+
+  /// Creates, fills and registers the input regions, spread over several
+  /// threads with a connection to the server each when there are many.
+  /// \param regions The regions to create.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitInputRegions(std::vector<InputRegion>& regions);
 
   /// \brief Helper function to handle copying shared memory to the correct
   /// memory region
@@ -129,6 +206,87 @@ class InferDataManagerShm : public InferDataManagerBase {
       std::vector<size_t>& byte_size, bool is_shape_tensor,
       std::string& region_name);
 
+  /// Fills a CUDA shared memory region with deferred generated data by
+  /// repeating its pattern on the device, see
+  /// DataLoader::DeferGeneratedData().
+  /// \param input_shm_ptr Pointer to the region on the device.
+  /// \param byte_size Size of the region.
+  /// \param region_name Name of the shared memory region.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error FillGeneratedData(
+      uint8_t* input_shm_ptr, size_t byte_size,
+      const std::string& region_name);
+
+  /// Creates the slots of the input region pool.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitPool();
+
+  /// Gathers the batch of data of an input for a data step and validates
+  /// that it can be batched.
+  /// \param name The name of the input.
+  /// \param tensor The model tensor of the input.
+  /// \param stream_index The data stream of the step.
+  /// \param step_index The first step of the batch.
+  /// \param data_ptrs Returns the pointers to the data of each batch entry.
+  /// \param byte_size Returns the byte size of each batch entry.
+  /// \param alloc_size Returns the total byte size of the batch.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GatherInputData(
+      const std::string& name, const ModelTensor& tensor, int stream_index,
+      int step_index, std::vector<const uint8_t*>* data_ptrs,
+      std::vector<size_t>* byte_size, size_t* alloc_size);
+
+  /// Fills a slot of the region pool with the data of a step. Called by the
+  /// pool, possibly from its background thread.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error StagePoolSlot(size_t slot, int stream_index, int step_index);
+
+  /// Makes the target InferData object hold the pool slot of a step and
+  /// prefetches the step it is likely to need next.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error AcquirePoolSlot(
+      const int stream_index, const int step_index, InferData& infer_data);
+
+  /// Validates the data an output wrote to shared memory against the
+  /// expected data.
+  /// \param region_name The name of the output region.
+  /// \param output The output and its expected data, in batch order.
+  /// \param validator The validator the result is recorded by.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ValidateOutputRegion(
+      const std::string& region_name,
+      const OutputValidator::ExpectedOutput& output,
+      OutputValidator* validator);
+
+  /// \return The name of the region of an output, for the given slot if
+  /// the output regions are time-sliced.
+  std::string OutputRegionName(const std::string& name, int slot) const
+  {
+    if (slot < 0) {
+      return TensorToRegionName(name);
+    }
+    return TensorToRegionName(name) + "_slot_" + std::to_string(slot);
+  }
+
+  /// \return The name of the region of an input for a data step.
+  std::string InputRegionName(
+      const std::string& name, int stream_index, int step_index) const
+  {
+    std::string region_name(
+        TensorToRegionName(name) + "_" + std::to_string(stream_index) + "_" +
+        std::to_string(step_index));
+    if (shm_options_.persistent) {
+      return persistent_region_names_.at(region_name);
+    }
+    return region_name;
+  }
+
+  /// \return The name of the pool region of an input for a slot.
+  std::string PoolRegionName(const std::string& name, size_t slot) const
+  {
+    return TensorToRegionName(name) + "_pool_" + std::to_string(slot);
+  }
+
   cb::Error InitInferDataInput(
       const std::string& name, const ModelTensor& model_tensor,
       InferData& infer_data) override;
@@ -147,8 +305,35 @@ class InferDataManagerShm : public InferDataManagerBase {
 
   SharedMemoryType shared_memory_type_;
   size_t output_shm_size_;
+  // If not zero, the number of slots of the input region pool. Each slot
+  // holds one region per input, sized for the largest step, instead of
+  // one region per input and step.
+  size_t pool_size_;
   // Map from shared memory key to its starting address and size
   std::unordered_map<std::string, SharedMemoryData> shared_memory_regions_;
+  std::mutex regions_mutex_;
+  // The system shared memory regions registered with the server when the
+  // regions are persistent
+  std::map<std::string, cb::SystemSharedMemoryRegion> registered_regions_;
+  // Map from the name of the region of an input for a data step to the name
+  // of the persistent region with its data
+  std::unordered_map<std::string, std::string> persistent_region_names_;
+  // The byte size of the data staged for each input, by pool slot
+  std::vector<std::unordered_map<std::string, size_t>> pool_byte_sizes_;
+  std::unique_ptr<SharedMemoryPool> pool_;
+  // If not zero, the number of output slots. Each request then writes its
+  // outputs to a slot of its own, which it holds until it completes, instead
+  // of all requests sharing one region per output.
+  size_t output_slots_;
+  std::vector<int> free_output_slots_;
+  std::mutex output_slots_mutex_;
+  std::condition_variable output_slots_cv_;
+  // The placement of the pages of the system shared memory regions
+  cb::SharedMemoryOptions shm_options_;
+#ifdef TRITON_ENABLE_GPU
+  // Stages the inputs of CUDA shared memory regions through pinned memory
+  std::unique_ptr<CudaStagingPipeline> cuda_staging_;
+#endif  // TRITON_ENABLE_GPU
 };
 
 }}  // namespace triton::perfanalyzer
@@ -28,6 +28,8 @@
 
 #include <math.h>
 #include <algorithm>
+#include <cstring>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -36,8 +38,32 @@
 #include <stdexcept>
 #include "client_backend/client_backend.h"
 #include "doctest.h"
+#include "sweep_checkpoint.h"
 
 namespace triton { namespace perfanalyzer {
+namespace {
+
+void
+ReportServerMetrics(const Metrics& metrics)
+{
+  if (!metrics.gauges.empty()) {
+    std::cout << "    Avg Server Gauges:" << std::endl;
+    for (const auto& sample : metrics.gauges) {
+      std::cout << "      " << sample.first << " : " << sample.second
+                << std::endl;
+    }
+  }
+  if (!metrics.counters.empty()) {
+    std::cout << "    Server Counter Increases:" << std::endl;
+    for (const auto& sample : metrics.counters) {
+      std::cout << "      " << sample.first << " : " << sample.second
+                << std::endl;
+    }
+  }
+}
+
+}  // namespace
+
 cb::Error
 ReportPrometheusMetrics(const Metrics& metrics)
 {
@@ -49,6 +75,7 @@ ReportPrometheusMetrics(const Metrics& metrics)
     std::cout << "Too many GPUs on system to print out individual Prometheus "
                  "metrics, use the CSV output feature to see metrics."
               << std::endl;
+    ReportServerMetrics(metrics);
     return cb::Error::Success;
   }
 
@@ -86,11 +113,261 @@ ReportPrometheusMetrics(const Metrics& metrics)
               << std::endl;
   }
 
+  ReportServerMetrics(metrics);
   return cb::Error::Success;
 }
 
+std::vector<cb::ModelIdentifier>
+EnsembleCriticalPath(
+    const std::vector<EnsembleStep>& steps,
+    const std::map<cb::ModelIdentifier, ServerSideStats>& stats,
+    uint64_t* latency_ns)
+{
+  const size_t step_count = steps.size();
+  std::vector<uint64_t> step_latency_ns(step_count, 0);
+  std::vector<std::vector<size_t>> producers(step_count);
+  for (size_t j = 0; j < step_count; j++) {
+    const auto it = stats.find(steps[j].model);
+    if ((it != stats.end()) && (it->second.success_count > 0)) {
+      step_latency_ns[j] = it->second.cumm_time_ns / it->second.success_count;
+    }
+    for (size_t i = 0; i < step_count; i++) {
+      for (const auto& output : steps[i].outputs) {
+        if ((i != j) && steps[j].inputs.count(output)) {
+          producers[j].push_back(i);
+          break;
+        }
+      }
+    }
+  }
+
+  // The steps are not necessarily listed in the order they run, the end
+  // times are relaxed until they settle, which takes at most as many passes
+  // as there are steps in an ensemble without cycles
+  std::vector<uint64_t> end_ns(step_latency_ns);
+  std::vector<size_t> previous(step_count, step_count);
+  for (size_t pass = 0; pass < step_count; pass++) {
+    bool changed = false;
+    for (size_t j = 0; j < step_count; j++) {
+      for (const size_t i : producers[j]) {
+        if (end_ns[i] + step_latency_ns[j] > end_ns[j]) {
+          end_ns[j] = end_ns[i] + step_latency_ns[j];
+          previous[j] = i;
+          changed = true;
+        }
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+
+  std::vector<cb::ModelIdentifier> path;
+  *latency_ns = 0;
+  if (step_count == 0) {
+    return path;
+  }
+  size_t step = std::max_element(end_ns.begin(), end_ns.end()) - end_ns.begin();
+  *latency_ns = end_ns[step];
+  while ((step != step_count) && (path.size() < step_count)) {
+    path.push_back(steps[step].model);
+    step = previous[step];
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void
+CorrelateMetrics(
+    const std::vector<std::reference_wrapper<const Metrics>>& metrics,
+    const double infer_per_sec, MetricsCorrelation* correlation)
+{
+  double power_sum_w = 0;
+  size_t power_count = 0;
+  uint64_t min_headroom_bytes = std::numeric_limits<uint64_t>::max();
+  // Sums of the least squares fit of the memory used against the time, in
+  // seconds from the first scrape
+  double n = 0, sum_t = 0, sum_m = 0, sum_tt = 0, sum_tm = 0;
+  const uint64_t first_ns = metrics.empty() ? 0 : metrics[0].get().timestamp_ns;
+  for (const Metrics& m : metrics) {
+    if (!m.gpu_power_usage_per_gpu.empty()) {
+      for (const auto& gpu : m.gpu_power_usage_per_gpu) {
+        power_sum_w += gpu.second;
+      }
+      power_count++;
+    }
+
+    double used_bytes = 0;
+    for (const auto& gpu : m.gpu_memory_used_bytes_per_gpu) {
+      used_bytes += gpu.second;
+      const auto total_it = m.gpu_memory_total_bytes_per_gpu.find(gpu.first);
+      if ((total_it != m.gpu_memory_total_bytes_per_gpu.end()) &&
+          (total_it->second >= gpu.second)) {
+        min_headroom_bytes =
+            std::min(min_headroom_bytes, total_it->second - gpu.second);
+      }
+    }
+    if ((m.timestamp_ns != 0) && !m.gpu_memory_used_bytes_per_gpu.empty()) {
+      const double t =
+          ((double)m.timestamp_ns - first_ns) / NANOS_PER_SECOND;
+      n++;
+      sum_t += t;
+      sum_m += used_bytes;
+      sum_tt += t * t;
+      sum_tm += t * used_bytes;
+    }
+  }
+
+  const double avg_power_w = (power_count > 0) ? power_sum_w / power_count : 0;
+  correlation->infer_per_sec_per_watt =
+      (avg_power_w > 0) ? infer_per_sec / avg_power_w : 0;
+  correlation->min_gpu_memory_headroom_bytes =
+      (min_headroom_bytes == std::numeric_limits<uint64_t>::max())
+          ? 0
+          : min_headroom_bytes;
+  const double denominator = n * sum_tt - sum_t * sum_t;
+  correlation->gpu_memory_trend_bytes_per_sec =
+      (denominator > 0) ? (n * sum_tm - sum_t * sum_m) / denominator : 0;
+}
+
+uint64_t
+GpuUtilizationAt(
+    const std::vector<Metrics>& metrics, const std::vector<uint64_t>& times_ns,
+    double* utilization)
+{
+  *utilization = 0;
+  if (metrics.empty()) {
+    return 0;
+  }
+
+  double sum = 0;
+  for (const uint64_t time_ns : times_ns) {
+    // The first scrape at or after the time, or the one before if closer
+    auto it = std::lower_bound(
+        metrics.begin(), metrics.end(), time_ns,
+        [](const Metrics& m, uint64_t t) { return m.timestamp_ns < t; });
+    if ((it == metrics.end()) ||
+        ((it != metrics.begin()) && (time_ns - std::prev(it)->timestamp_ns <
+                                     it->timestamp_ns - time_ns))) {
+      it = std::prev(it);
+    }
+    double gpu_sum = 0;
+    for (const auto& gpu : it->gpu_utilization_per_gpu) {
+      gpu_sum += gpu.second;
+    }
+    if (!it->gpu_utilization_per_gpu.empty()) {
+      sum += gpu_sum / it->gpu_utilization_per_gpu.size();
+    }
+  }
+  if (!times_ns.empty()) {
+    *utilization = sum / times_ns.size();
+  }
+  return times_ns.size();
+}
+
 namespace {
 
+// The number of sub-windows a measurement is split into to check convergence
+constexpr size_t kConvergenceSubWindows = 10;
+// The two sided 95% quantile of Student's t distribution with
+// kConvergenceSubWindows - 1 degrees of freedom
+constexpr double kConvergenceTQuantile = 2.262;
+// The fewest requests a sub-window needs for its latency to be meaningful
+constexpr size_t kConvergenceMinSubWindowRequests = 10;
+// The time the ranks of a distributed load get to receive the start of the
+// first measurement window from the coordinator
+constexpr uint64_t kDistributedStartLeadMs = 100;
+// How often the latency of a load level is checked against the latency
+// threshold while it is measured
+constexpr uint64_t kLatencyWatchIntervalMs = 100;
+// The fewest requests a load level needs before it is judged over the
+// latency threshold
+constexpr uint64_t kLatencyWatchMinRequests = 50;
+// The number of standard deviations the latency must be over the threshold
+// by before the load level is stopped
+constexpr double kLatencyWatchZ = 3.0;
+
+// The layout of the measurement windows exchanged by the ranks of a
+// distributed load, followed by the serialized latency histogram
+enum RankWindowField {
+  RANK_WINDOW_OK,
+  RANK_WINDOW_REQUEST_COUNT,
+  RANK_WINDOW_SEQUENCE_COUNT,
+  RANK_WINDOW_DELAYED_REQUEST_COUNT,
+  RANK_WINDOW_OUTLIER_COUNT,
+  RANK_WINDOW_MAX_OUTLIER_LATENCY_NS,
+  RANK_WINDOW_DURATION_NS,
+  RANK_WINDOW_COMPLETED_COUNT,
+  RANK_WINDOW_REQUEST_TIME_NS,
+  RANK_WINDOW_SEND_TIME_NS,
+  RANK_WINDOW_RECEIVE_TIME_NS,
+  RANK_WINDOW_FIRST_BYTE_TIME_NS,
+  RANK_WINDOW_SERIALIZE_TIME_NS,
+  RANK_WINDOW_SEND_QUEUE_TIME_NS,
+  RANK_WINDOW_DESERIALIZE_TIME_NS,
+  RANK_WINDOW_REQUEST_BYTES,
+  RANK_WINDOW_UNCOMPRESSED_REQUEST_BYTES,
+  RANK_WINDOW_RESPONSE_BYTES,
+  RANK_WINDOW_UNCOMPRESSED_RESPONSE_BYTES,
+  RANK_WINDOW_CHUNK_INTERVAL_COUNT,
+  RANK_WINDOW_CHUNK_INTERVAL_NS,
+  RANK_WINDOW_RESPONSE_COUNT,
+  RANK_WINDOW_FIRST_RESPONSE_LATENCY_NS,
+  RANK_WINDOW_RESPONSE_GAP_COUNT,
+  RANK_WINDOW_RESPONSE_GAP_NS,
+  RANK_WINDOW_STAGE_REQUEST_COUNT,
+  RANK_WINDOW_STAGE_DATA_PREP_NS,
+  RANK_WINDOW_STAGE_SEND_NS,
+  RANK_WINDOW_STAGE_CALLBACK_NS,
+  RANK_WINDOW_STAGE_VALIDATION_NS,
+  RANK_WINDOW_INFER_PER_SEC,
+  RANK_WINDOW_SEQUENCE_PER_SEC,
+  RANK_WINDOW_SEND_REQUEST_RATE,
+  RANK_WINDOW_OVERHEAD_PCT,
+  RANK_WINDOW_CONVERGED,
+  RANK_WINDOW_HEADER_LEN
+};
+
+uint64_t
+DoubleBits(const double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double
+BitsDouble(const uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Returns whether the confidence interval of the mean of the samples is
+// narrower than the relative threshold
+bool
+IsMeanConverged(const std::vector<double>& samples, const double threshold)
+{
+  double mean = 0;
+  for (const auto sample : samples) {
+    mean += sample;
+  }
+  mean /= samples.size();
+
+  double squared_deviations = 0;
+  for (const auto sample : samples) {
+    squared_deviations += (sample - mean) * (sample - mean);
+  }
+  const double std_dev = std::sqrt(squared_deviations / (samples.size() - 1));
+  const double half_width =
+      kConvergenceTQuantile * std_dev / std::sqrt(samples.size());
+
+  // Comparable to the max / min rule over stability windows, the whole
+  // interval has to fit in the threshold
+  return (mean > 0) && (2 * half_width <= threshold * mean);
+}
+
 inline uint64_t
 AverageDurationInUs(const uint64_t total_time_in_ns, const uint64_t cnt)
 {
@@ -155,7 +432,6 @@ GetTotalEnsembleDurations(const ServerSideStats& stats)
   return result;
 }
 
-
 size_t
 GetOverheadDuration(size_t total_time, size_t queue_time, size_t compute_time)
 {
@@ -164,9 +440,57 @@ GetOverheadDuration(size_t total_time, size_t queue_time, size_t compute_time)
              : 0;
 }
 
+void
+ReportMetricsCorrelation(const MetricsCorrelation& correlation)
+{
+  std::cout << "    Throughput per Watt: "
+            << correlation.infer_per_sec_per_watt << " infer/sec/watt"
+            << std::endl;
+  if (correlation.tail_request_count > 0) {
+    std::cout << "    Avg GPU Utilization at p99 Latency: "
+              << (correlation.tail_gpu_utilization * 100.0) << "% ("
+              << correlation.tail_request_count << " requests)" << std::endl;
+  }
+  std::cout << "    Min GPU Memory Headroom: "
+            << correlation.min_gpu_memory_headroom_bytes << " bytes"
+            << std::endl;
+  std::cout << "    GPU Memory Usage Trend: "
+            << correlation.gpu_memory_trend_bytes_per_sec << " bytes/sec"
+            << std::endl;
+}
+
+// Reports the load that an ensemble puts on one of its composing models over
+// the measurement
+void
+ReportComposingModelLoad(
+    const ServerSideStats& stats, const uint64_t duration_ns,
+    const std::string& ident)
+{
+  if (duration_ns == 0) {
+    return;
+  }
+  std::cout << ident << "  Throughput: "
+            << (stats.inference_count * NANOS_PER_SECOND / (double)duration_ns)
+            << " infer/sec";
+  // Every request of a batch records the compute time of the whole
+  // execution, so the time the model is busy is approximated by spreading
+  // the compute time over the executions. Can exceed 100% with several model
+  // instances.
+  const uint64_t compute_cnt = stats.compute_input_count;
+  if (compute_cnt > 0) {
+    const double busy_ns = (double)(stats.compute_input_time_ns +
+                                    stats.compute_infer_time_ns +
+                                    stats.compute_output_time_ns) *
+                           stats.execution_count / compute_cnt;
+    std::cout << ", utilization " << (100.0 * busy_ns / duration_ns) << "%";
+  }
+  std::cout << std::endl;
+}
+
 cb::Error
 ReportServerSideStats(
-    const ServerSideStats& stats, const int iteration,
+    const ServerSideStats& stats, const std::string& model_name,
+    const uint64_t duration_ns, const int iteration,
     const std::shared_ptr<ModelParser>& parser)
 {
   const std::string ident = std::string(2 * iteration, ' ');
@@ -315,13 +639,51 @@ ReportServerSideStats(
       const auto& model_identifier = model_stats.first;
       std::cout << ident << model_identifier.first
                 << ", version: " << model_identifier.second << std::endl;
-      ReportServerSideStats(model_stats.second, iteration + 1, parser);
+      ReportComposingModelLoad(
+          model_stats.second, duration_ns,
+          std::string(2 * (iteration + 1), ' '));
+      ReportServerSideStats(
+          model_stats.second, model_identifier.first, duration_ns,
+          iteration + 1, parser);
+    }
+
+    const auto steps_it = parser->GetEnsembleSteps()->find(model_name);
+    if (steps_it != parser->GetEnsembleSteps()->end()) {
+      uint64_t path_latency_ns = 0;
+      const auto path = EnsembleCriticalPath(
+          steps_it->second, stats.composing_models_stat, &path_latency_ns);
+      std::cout << ident << "Critical path: ";
+      for (size_t i = 0; i < path.size(); i++) {
+        std::cout << (i > 0 ? " -> " : "") << path[i].first;
+      }
+      std::cout << " (" << (path_latency_ns / 1000) << " usec)" << std::endl
+                << std::endl;
     }
   }
 
   return cb::Error::Success;
 }
 
+double
+BandwidthMBPerSec(const uint64_t byte_size, const uint64_t duration_ns)
+{
+  if (duration_ns == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(byte_size) * NANOS_PER_SECOND / duration_ns /
+         1000000;
+}
+
+double
+CompressionRatio(
+    const uint64_t uncompressed_byte_size, const uint64_t byte_size)
+{
+  if ((byte_size == 0) || (uncompressed_byte_size == 0)) {
+    return 1.0;
+  }
+  return static_cast<double>(uncompressed_byte_size) / byte_size;
+}
+
 cb::Error
 ReportClientSideStats(
     const ClientSideStats& stats, const int64_t percentile,
@@ -380,6 +742,66 @@ ReportClientSideStats(
     std::cout << "    Delayed Request Count: " << stats.delayed_request_count
               << std::endl;
   }
+  if (stats.outlier_count != 0) {
+    std::cout << "    Latency outliers: " << stats.outlier_count
+              << " requests excluded from the latencies (max "
+              << (stats.max_outlier_latency_ns / 1000) << " usec)"
+              << std::endl;
+  }
+  const LatencyHistogram& schedule_errors = stats.schedule_error_histogram;
+  if (schedule_errors.TotalCount() != 0) {
+    std::cout << "    Schedule error: p50 "
+              << (schedule_errors.ValueAtPercentile(50) / 1000) << " usec, p99 "
+              << (schedule_errors.ValueAtPercentile(99) / 1000)
+              << " usec, max " << (schedule_errors.Max() / 1000) << " usec"
+              << std::endl;
+  }
+  if (stats.dropped_request_count != 0) {
+    std::cout << "    Dropped Request Count: " << stats.dropped_request_count
+              << std::endl;
+  }
+  const ValidationStats& validation = stats.validation_stats;
+  if ((validation.output_count != 0) ||
+      (validation.skipped_output_count != 0)) {
+    std::cout << "    Output validation: " << validation.output_count
+              << " outputs, " << validation.mismatched_output_count
+              << " mismatched (" << validation.mismatched_element_count
+              << " elements, max abs error " << validation.max_abs_error
+              << ")";
+    if (validation.skipped_output_count != 0) {
+      std::cout << ", " << validation.skipped_output_count << " skipped";
+    }
+    std::cout << std::endl;
+  }
+  const LatencyHistogram& queue_delays = stats.queue_delay_histogram;
+  if (queue_delays.TotalCount() != 0) {
+    std::cout << "    Queued requests: " << queue_delays.TotalCount()
+              << ", delay p50 " << (queue_delays.ValueAtPercentile(50) / 1000)
+              << " usec, p99 " << (queue_delays.ValueAtPercentile(99) / 1000)
+              << " usec, max " << (queue_delays.Max() / 1000) << " usec"
+              << std::endl;
+  }
+  const LatencyHistogram& corrected = stats.corrected_latency_histogram;
+  if (corrected.TotalCount() != 0) {
+    std::cout << "    Corrected latency (from schedule): p50 "
+              << (corrected.ValueAtPercentile(50) / 1000) << " usec, p99 "
+              << (corrected.ValueAtPercentile(99) / 1000) << " usec, max "
+              << (corrected.Max() / 1000) << " usec" << std::endl;
+  }
+  const std::pair<const char*, const LatencyHistogram*> server_phases[] = {
+      {"queue", &stats.server_queue_histogram},
+      {"compute input", &stats.server_compute_input_histogram},
+      {"compute infer", &stats.server_compute_infer_histogram},
+      {"compute output", &stats.server_compute_output_histogram}};
+  for (const auto& phase : server_phases) {
+    const LatencyHistogram& times = *phase.second;
+    if (times.TotalCount() != 0) {
+      std::cout << "    Traced server " << phase.first << ": p50 "
+                << (times.ValueAtPercentile(50) / 1000) << " usec, p99 "
+                << (times.ValueAtPercentile(99) / 1000) << " usec, max "
+                << (times.Max() / 1000) << " usec" << std::endl;
+    }
+  }
   if (on_sequence_model) {
     std::cout << "    Sequence count: " << stats.sequence_count << " ("
               << stats.sequence_per_sec << " seq/sec)" << std::endl;
@@ -399,6 +821,18 @@ ReportClientSideStats(
     std::cout << client_overhead.str() << std::endl;
     std::cout << send_rate.str() << std::endl;
   }
+  const ClientStageTimes& stage_times = stats.stage_times;
+  if (stage_times.request_count != 0) {
+    std::cout << "    Avg client stages: data prep "
+              << (stage_times.AvgNs(CLIENT_STAGE_DATA_PREP) / 1000)
+              << " usec + send "
+              << (stage_times.AvgNs(CLIENT_STAGE_SEND) / 1000)
+              << " usec + callback "
+              << (stage_times.AvgNs(CLIENT_STAGE_CALLBACK) / 1000)
+              << " usec (validation "
+              << (stage_times.AvgNs(CLIENT_STAGE_VALIDATION) / 1000) << " usec)"
+              << std::endl;
+  }
 
   if (percentile == -1) {
     std::cout << "    Avg latency: " << avg_latency_us << " usec"
@@ -409,8 +843,159 @@ ReportClientSideStats(
               << " latency: " << (percentile.second / 1000) << " usec"
               << std::endl;
   }
+  if (!stats.bucket_latency_histograms.empty()) {
+    uint64_t bucketed_count = 0;
+    for (const auto& bucket : stats.bucket_latency_histograms) {
+      bucketed_count += bucket.second.TotalCount();
+    }
+    std::cout << "    Latency by bucket:" << std::endl;
+    for (const auto& bucket : stats.bucket_latency_histograms) {
+      const LatencyHistogram& latencies = bucket.second;
+      // The buckets share the throughput in proportion to their requests
+      std::cout << "      " << bucket.first << ": "
+                << (stats.infer_per_sec * latencies.TotalCount() /
+                    bucketed_count)
+                << " infer/sec, avg " << (latencies.Mean() / 1000) << " usec";
+      for (const auto& percentile : stats.percentile_latency_ns) {
+        std::cout << ", p" << percentile.first << " "
+                  << (latencies.ValueAtPercentile(percentile.first) / 1000)
+                  << " usec";
+      }
+      std::cout << std::endl;
+    }
+  }
+  if (!stats.request_class_stats.empty()) {
+    uint64_t class_count = 0;
+    for (const auto& request_class : stats.request_class_stats) {
+      class_count += request_class.second.latencies.TotalCount();
+    }
+    std::cout << "    Request classes:" << std::endl;
+    for (const auto& request_class : stats.request_class_stats) {
+      const LatencyHistogram& latencies = request_class.second.latencies;
+      const uint64_t rejected_count = request_class.second.rejected_count;
+      const uint64_t sent_count = latencies.TotalCount() + rejected_count;
+      // The classes share the throughput in proportion to their requests
+      std::cout << "      " << request_class.first << ": "
+                << ((class_count == 0) ? 0
+                                       : (stats.infer_per_sec *
+                                          latencies.TotalCount() /
+                                          class_count))
+                << " infer/sec, avg " << (latencies.Mean() / 1000) << " usec";
+      for (const auto& percentile : stats.percentile_latency_ns) {
+        std::cout << ", p" << percentile.first << " "
+                  << (latencies.ValueAtPercentile(percentile.first) / 1000)
+                  << " usec";
+      }
+      std::cout << ", " << rejected_count << " rejected ("
+                << ((sent_count == 0) ? 0 : (100 * rejected_count / sent_count))
+                << "%)" << std::endl;
+    }
+  }
+  if (!stats.endpoint_latency_histograms.empty()) {
+    uint64_t endpoint_count = 0;
+    uint64_t max_endpoint_count = 0;
+    for (const auto& endpoint : stats.endpoint_latency_histograms) {
+      endpoint_count += endpoint.second.TotalCount();
+      max_endpoint_count =
+          std::max(max_endpoint_count, endpoint.second.TotalCount());
+    }
+    std::cout << "    Endpoints:" << std::endl;
+    for (const auto& endpoint : stats.endpoint_latency_histograms) {
+      const LatencyHistogram& latencies = endpoint.second;
+      // The endpoints share the throughput in proportion to their requests
+      std::cout << "      " << endpoint.first << ": "
+                << ((endpoint_count == 0) ? 0
+                                          : (stats.infer_per_sec *
+                                             latencies.TotalCount() /
+                                             endpoint_count))
+                << " infer/sec, avg " << (latencies.Mean() / 1000) << " usec";
+      for (const auto& percentile : stats.percentile_latency_ns) {
+        std::cout << ", p" << percentile.first << " "
+                  << (latencies.ValueAtPercentile(percentile.first) / 1000)
+                  << " usec";
+      }
+      std::cout << std::endl;
+    }
+    // How much busier the busiest endpoint is than an even share
+    std::cout << "      Imbalance: "
+              << ((endpoint_count == 0)
+                      ? 1.0
+                      : (static_cast<double>(max_endpoint_count) *
+                         stats.endpoint_latency_histograms.size() /
+                         endpoint_count))
+              << "x the mean share" << std::endl;
+  }
+  if (!stats.slow_requests.Empty()) {
+    std::cout << "    Slowest requests:" << std::endl;
+    for (const auto& request : stats.slow_requests.Slowest()) {
+      std::cout << "      " << (request.latency_ns / 1000)
+                << " usec: worker " << request.worker << " context "
+                << request.context << ", data stream "
+                << request.data_stream_id << " step " << request.data_step_id;
+      if (request.sequence_id != 0) {
+        std::cout << ", sequence " << request.sequence_id;
+      }
+      if (!request.endpoint.empty()) {
+        std::cout << ", endpoint " << request.endpoint;
+      }
+      std::cout << ", first response after "
+                << ((request.first_response_time_ns - request.send_time_ns) /
+                    1000)
+                << " usec";
+      if (request.response_count > 1) {
+        std::cout << " of " << request.response_count;
+      }
+      if (request.schedule_lag_ns > 0) {
+        std::cout << ", sent " << (request.schedule_lag_ns / 1000)
+                  << " usec late";
+      }
+      std::cout << std::endl;
+    }
+  }
+  if (stats.response_count != 0) {
+    std::cout << "    Avg first response latency: "
+              << (stats.avg_first_response_latency_ns / 1000) << " usec"
+              << std::endl;
+    std::cout << "    Avg inter-response latency: "
+              << (stats.avg_response_gap_ns / 1000) << " usec" << std::endl;
+    std::stringstream responses_per_request{""};
+    responses_per_request << std::fixed << std::setprecision(2)
+                          << (static_cast<double>(stats.response_count) /
+                              stats.request_count);
+    std::cout << "    Responses per request: " << responses_per_request.str()
+              << std::endl;
+  }
 
   std::cout << client_library_detail << std::endl;
+  if (include_lib_stats && (stats.avg_first_byte_time_ns != 0)) {
+    std::cout << "    Avg time to first byte: "
+              << (stats.avg_first_byte_time_ns / 1000) << " usec"
+              << std::endl;
+  }
+  if (include_lib_stats && (stats.response_chunk_interval_count != 0)) {
+    std::cout << "    Avg inter-chunk latency: "
+              << (stats.avg_response_chunk_interval_ns / 1000) << " usec ("
+              << stats.response_chunk_interval_count << " intervals)"
+              << std::endl;
+  }
+  if (include_lib_stats &&
+      ((stats.request_byte_size != 0) || (stats.response_byte_size != 0))) {
+    std::stringstream network{""};
+    network << "    Network: sent " << std::fixed << std::setprecision(2)
+            << BandwidthMBPerSec(stats.request_byte_size, stats.duration_ns)
+            << " MB/s (compression ratio "
+            << CompressionRatio(
+                   stats.uncompressed_request_byte_size,
+                   stats.request_byte_size)
+            << "), received "
+            << BandwidthMBPerSec(stats.response_byte_size, stats.duration_ns)
+            << " MB/s (compression ratio "
+            << CompressionRatio(
+                   stats.uncompressed_response_byte_size,
+                   stats.response_byte_size)
+            << ")";
+    std::cout << network.str() << std::endl;
+  }
 
   return cb::Error::Success;
 }
@@ -429,14 +1014,28 @@ Report(
       summary.on_sequence_model, include_lib_stats, summary.overhead_pct,
       summary.send_request_rate);
 
+  if (verbose && (summary.window_end_ns > summary.window_start_ns)) {
+    std::cout << "    Measured from " << summary.window_start_ns << " to "
+              << summary.window_end_ns << " nsec since epoch" << std::endl;
+  }
+
   if (include_server_stats) {
     std::cout << "  Server: " << std::endl;
-    ReportServerSideStats(summary.server_stats, 1, parser);
+    ReportServerSideStats(
+        summary.server_stats, parser->ModelName(),
+        summary.client_stats.duration_ns, 1, parser);
+    for (const auto& endpoint : summary.endpoint_server_stats) {
+      std::cout << "  Server " << endpoint.first << ": " << std::endl;
+      ReportServerSideStats(
+          endpoint.second, parser->ModelName(),
+          summary.client_stats.duration_ns, 1, parser);
+    }
   }
 
   if (should_collect_metrics) {
     std::cout << "  Server Prometheus Metrics: " << std::endl;
     ReportPrometheusMetrics(summary.metrics.front());
+    ReportMetricsCorrelation(summary.metrics_correlation);
   }
 
   if (summary.overhead_pct > overhead_pct_threshold) {
@@ -449,6 +1048,26 @@ Report(
 
 }  // namespace
 
+uint64_t
+WindowClock::NextBoundaryNs(uint64_t local_ns) const
+{
+  const uint64_t reference_ns = ToReferenceNs(local_ns);
+  if (reference_ns <= origin_ns) {
+    return ToLocalNs(origin_ns);
+  }
+  const uint64_t boundaries =
+      (reference_ns - origin_ns + alignment_ns - 1) / alignment_ns;
+  return ToLocalNs(origin_ns + boundaries * alignment_ns);
+}
+
+uint64_t
+WindowClock::AlignedDurationNs(uint64_t duration_ns) const
+{
+  const uint64_t boundaries =
+      std::max<uint64_t>((duration_ns + alignment_ns - 1) / alignment_ns, 1);
+  return boundaries * alignment_ns;
+}
+
 cb::Error
 InferenceProfiler::Create(
     const bool verbose, const double stability_threshold,
@@ -460,14 +1079,24 @@ InferenceProfiler::Create(
     std::unique_ptr<InferenceProfiler>* profiler,
     uint64_t measurement_request_count, MeasurementMode measurement_mode,
     std::shared_ptr<MPIDriver> mpi_driver, const uint64_t metrics_interval_ms,
-    const bool should_collect_metrics, const double overhead_pct_threshold)
+    const bool should_collect_metrics, const double overhead_pct_threshold,
+    const bool early_convergence, const uint64_t settle_window_ms,
+    const WarmupOptions& warmup,
+    std::shared_ptr<DistributedLoad> distributed_load,
+    const WindowClock& window_clock,
+    std::shared_ptr<RequestRecordWriter> request_record_writer,
+    std::shared_ptr<SweepCheckpoint> checkpoint,
+    const std::map<std::string, std::shared_ptr<cb::ClientBackend>>&
+        endpoint_backends)
 {
   std::unique_ptr<InferenceProfiler> local_profiler(new InferenceProfiler(
       verbose, stability_threshold, measurement_window_ms, max_trials,
       (percentile != -1), percentile, latency_threshold_ms_, protocol, parser,
       profile_backend, std::move(manager), measurement_request_count,
       measurement_mode, mpi_driver, metrics_interval_ms, should_collect_metrics,
-      overhead_pct_threshold));
+      overhead_pct_threshold, early_convergence, settle_window_ms, warmup,
+      distributed_load, window_clock, request_record_writer, checkpoint,
+      endpoint_backends));
 
   *profiler = std::move(local_profiler);
   return cb::Error::Success;
@@ -483,16 +1112,28 @@ InferenceProfiler::InferenceProfiler(
     std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
     MeasurementMode measurement_mode, std::shared_ptr<MPIDriver> mpi_driver,
     const uint64_t metrics_interval_ms, const bool should_collect_metrics,
-    const double overhead_pct_threshold)
+    const double overhead_pct_threshold, const bool early_convergence,
+    const uint64_t settle_window_ms, const WarmupOptions& warmup,
+    std::shared_ptr<DistributedLoad> distributed_load,
+    const WindowClock& window_clock,
+    std::shared_ptr<RequestRecordWriter> request_record_writer,
+    std::shared_ptr<SweepCheckpoint> checkpoint,
+    const std::map<std::string, std::shared_ptr<cb::ClientBackend>>&
+        endpoint_backends)
     : verbose_(verbose), measurement_window_ms_(measurement_window_ms),
-      max_trials_(max_trials), extra_percentile_(extra_percentile),
-      percentile_(percentile), latency_threshold_ms_(latency_threshold_ms_),
-      protocol_(protocol), parser_(parser), profile_backend_(profile_backend),
-      manager_(std::move(manager)),
       measurement_request_count_(measurement_request_count),
-      measurement_mode_(measurement_mode), mpi_driver_(mpi_driver),
+      measurement_mode_(measurement_mode), max_trials_(max_trials),
+      extra_percentile_(extra_percentile), percentile_(percentile),
+      latency_threshold_ms_(latency_threshold_ms_), protocol_(protocol),
+      parser_(parser), profile_backend_(profile_backend),
+      manager_(std::move(manager)), mpi_driver_(mpi_driver),
+      endpoint_backends_(endpoint_backends),
       should_collect_metrics_(should_collect_metrics),
-      overhead_pct_threshold_(overhead_pct_threshold)
+      overhead_pct_threshold_(overhead_pct_threshold),
+      early_convergence_(early_convergence),
+      settle_window_ms_(settle_window_ms), warmup_(warmup),
+      distributed_load_(distributed_load), window_clock_(window_clock),
+      request_record_writer_(request_record_writer), checkpoint_(checkpoint)
 {
   load_parameters_.stability_threshold = stability_threshold;
   load_parameters_.stability_window = 3;
@@ -506,6 +1147,10 @@ InferenceProfiler::InferenceProfiler(
     std::set<std::string> extensions;
     profile_backend_->ServerExtensions(&extensions);
     include_server_stats_ = (extensions.find("statistics") != extensions.end());
+    // Only the requests of the in-process server can be traced
+    std::vector<cb::ServerRequestTiming> timings;
+    include_server_request_timings_ =
+        profile_backend_->ServerRequestTimings(&timings).IsOk();
   } else {
     include_lib_stats_ = true;
     include_server_stats_ = false;
@@ -530,8 +1175,23 @@ InferenceProfiler::Profile(
   is_stable = false;
   meets_threshold = true;
 
+  if ((checkpoint_ != nullptr) &&
+      checkpoint_->Find(
+          concurrent_request_count, &perf_status, &meets_threshold,
+          &is_stable)) {
+    std::cout << "Concurrency: " << concurrent_request_count
+              << " resumed from the checkpoint" << std::endl;
+    perf_statuses.push_back(perf_status);
+    return cb::Error::Success;
+  }
+
+  size_t local_request_count = concurrent_request_count;
+  if (distributed_load_ != nullptr) {
+    RETURN_IF_ERROR(distributed_load_->LocalConcurrency(
+        concurrent_request_count, &local_request_count));
+  }
   RETURN_IF_ERROR(dynamic_cast<ConcurrencyManager*>(manager_.get())
-                      ->ChangeConcurrencyLevel(concurrent_request_count));
+                      ->ChangeConcurrencyLevel(local_request_count));
 
   err = ProfileHelper(perf_status, &is_stable);
   if (err.IsOk()) {
@@ -569,6 +1229,10 @@ InferenceProfiler::Profile(
   } else {
     return err;
   }
+  if (checkpoint_ != nullptr) {
+    RETURN_IF_ERROR(
+        checkpoint_->Append(perf_status, meets_threshold, is_stable));
+  }
 
   return cb::Error::Success;
 }
@@ -586,12 +1250,45 @@ InferenceProfiler::Profile(
   is_stable = false;
   meets_threshold = true;
 
-  RETURN_IF_ERROR(dynamic_cast<RequestRateManager*>(manager_.get())
-                      ->ChangeRequestRate(request_rate));
+  if ((checkpoint_ != nullptr) &&
+      checkpoint_->Find(
+          request_rate, &perf_status, &meets_threshold, &is_stable)) {
+    std::cout << "Request Rate: " << request_rate
+              << " resumed from the checkpoint" << std::endl;
+    perf_statuses.push_back(perf_status);
+    return cb::Error::Success;
+  }
+
+  auto rate_manager = dynamic_cast<RequestRateManager*>(manager_.get());
+  RETURN_IF_ERROR(rate_manager->ChangeRequestRate(
+      (distributed_load_ != nullptr)
+          ? distributed_load_->LocalRequestRate(request_rate)
+          : request_rate));
   std::cout << "Request Rate: " << request_rate
             << " inference requests per seconds" << std::endl;
 
   err = ProfileHelper(perf_status, &is_stable);
+  // Measure again with more worker threads while they cannot keep up with
+  // the schedule
+  bool added_threads = false;
+  while (err.IsOk()) {
+    RETURN_IF_ERROR(rate_manager->AdaptWorkerThreads(
+        perf_status.client_stats.request_count,
+        perf_status.client_stats.delayed_request_count, &added_threads));
+    if (!added_threads) {
+      break;
+    }
+    std::cout << "  Requests fell behind schedule, measuring again with "
+              << rate_manager->WorkerThreadCount() << " worker threads"
+              << std::endl;
+    perf_status = PerfStatus();
+    perf_status.request_rate = request_rate;
+    err = ProfileHelper(perf_status, &is_stable);
+  }
+  if (err.IsOk() && rate_manager->AutoThreadsEnabled()) {
+    std::cout << "  Worker threads: " << rate_manager->WorkerThreadCount()
+              << std::endl;
+  }
   if (err.IsOk()) {
     perf_statuses.push_back(perf_status);
     uint64_t stabilizing_latency_ms =
@@ -617,6 +1314,10 @@ InferenceProfiler::Profile(
   } else {
     return err;
   }
+  if (checkpoint_ != nullptr) {
+    RETURN_IF_ERROR(
+        checkpoint_->Append(perf_status, meets_threshold, is_stable));
+  }
 
   return cb::Error::Success;
 }
@@ -678,11 +1379,26 @@ InferenceProfiler::ProfileHelper(
   std::deque<PerfStatus> measurement_perf_statuses;
   all_timestamps_.clear();
   previous_window_end_ns_ = 0;
+  record_load_level_ = (experiment_perf_status.concurrency != 0)
+                           ? experiment_perf_status.concurrency
+                           : experiment_perf_status.request_rate;
+
+  // Let the load settle after the change of level. What completes meanwhile
+  // is discarded along with the requests of the previous level.
+  if (settle_window_ms_ > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(settle_window_ms_));
+  }
 
   // Start with a fresh empty timestamp vector in the manager
   //
-  TimestampVector empty_timestamps;
-  RETURN_IF_ERROR(manager_->SwapTimestamps(empty_timestamps));
+  RETURN_IF_ERROR(DiscardCompletedRequests());
+  RETURN_IF_ERROR(WaitForWarmup());
+  level_latencies_.Reset();
+  breached_latency_ns_ = 0;
+  if (WatchingLatency()) {
+    LatencyHistogram discarded;
+    RETURN_IF_ERROR(manager_->GetAndResetThresholdLatencies(&discarded));
+  }
 
   do {
     PerfStatus measurement_perf_status;
@@ -695,8 +1411,18 @@ InferenceProfiler::ProfileHelper(
       error.push(
           Measure(measurement_perf_status, measurement_request_count_, true));
     }
+    if (distributed_load_ != nullptr) {
+      error.back() =
+          AggregateRankWindows(error.back(), measurement_perf_status);
+    }
     measurement_perf_statuses.push_back(measurement_perf_status);
 
+    if (breached_latency_ns_ != 0) {
+      // More windows can not bring the level back under the threshold
+      *is_stable = false;
+      break;
+    }
+
     if (error.size() > load_parameters_.stability_window) {
       error.pop();
       measurement_perf_statuses.pop_front();
@@ -743,6 +1469,16 @@ InferenceProfiler::ProfileHelper(
     }
 
     *is_stable = DetermineStability(load_status);
+    if (!(*is_stable) && early_convergence_ && error.back().IsOk() &&
+        measurement_perf_status.converged) {
+      // The last window is representative on its own, so the earlier ones
+      // must not be merged into the result
+      *is_stable = true;
+      while (measurement_perf_statuses.size() > 1) {
+        measurement_perf_statuses.pop_front();
+        error.pop();
+      }
+    }
 
     if (IsDoneProfiling(load_status, is_stable)) {
       break;
@@ -755,6 +1491,29 @@ InferenceProfiler::ProfileHelper(
     metrics_manager_->StopQueryingMetrics();
   }
 
+  if (breached_latency_ns_ != 0) {
+    if (verbose_) {
+      std::cout << "  Stopped the load level early, latency of "
+                << (breached_latency_ns_ / 1000)
+                << " usec is over the threshold" << std::endl;
+    }
+    // Report what the last window measured, with a latency that is known to
+    // be over the threshold so that the sweep ends here
+    uint64_t measured_latency_ns = 0;
+    if (error.back().IsOk()) {
+      std::deque<PerfStatus> last_status{measurement_perf_statuses.back()};
+      RETURN_IF_ERROR(
+          MergePerfStatusReports(last_status, experiment_perf_status));
+      measured_latency_ns = experiment_perf_status.stabilizing_latency_ns;
+    }
+    experiment_perf_status.stabilizing_latency_ns =
+        std::max(measured_latency_ns, breached_latency_ns_);
+    if (early_exit) {
+      return cb::Error("Received exit signal.", pa::GENERIC_ERROR);
+    }
+    return cb::Error::Success;
+  }
+
   // return the appropriate error which might have occured in the
   // stability_window for its proper handling.
   while (!error.empty()) {
@@ -777,6 +1536,114 @@ InferenceProfiler::ProfileHelper(
   return cb::Error::Success;
 }
 
+bool
+InferenceProfiler::WatchingLatency() const
+{
+  // The ranks of a distributed load only know the latency of the whole load
+  // at the end of a window
+  return (latency_threshold_ms_ != NO_LIMIT) && !mpi_driver_->IsMPIRun() &&
+         (distributed_load_ == nullptr);
+}
+
+cb::Error
+InferenceProfiler::WatchLatency()
+{
+  LatencyHistogram latencies;
+  RETURN_IF_ERROR(manager_->GetAndResetThresholdLatencies(&latencies));
+  RETURN_IF_ERROR(level_latencies_.Merge(latencies));
+  uint64_t latency_ns = 0;
+  if ((breached_latency_ns_ == 0) &&
+      IsLatencyOverThreshold(level_latencies_, &latency_ns)) {
+    breached_latency_ns_ = latency_ns;
+  }
+  return cb::Error::Success;
+}
+
+bool
+InferenceProfiler::IsLatencyOverThreshold(
+    const LatencyHistogram& latencies, uint64_t* latency_ns) const
+{
+  const uint64_t count = latencies.TotalCount();
+  if ((latency_threshold_ms_ == NO_LIMIT) ||
+      (count < kLatencyWatchMinRequests)) {
+    return false;
+  }
+  const uint64_t threshold_ns = latency_threshold_ms_ * NANOS_PER_MILLIS;
+
+  if (extra_percentile_) {
+    // Under the threshold, each request is over it with a probability of at
+    // most 1 - percentile
+    const double over_probability = 1.0 - percentile_ / 100.0;
+    uint64_t over_count = 0;
+    for (const auto& bucket : latencies.Buckets()) {
+      if (bucket.first > threshold_ns) {
+        over_count += bucket.second;
+      }
+    }
+    const double expected = count * over_probability;
+    const double deviation = std::sqrt(expected * (1.0 - over_probability));
+    *latency_ns = latencies.ValueAtPercentile(percentile_);
+    return (over_count > expected + kLatencyWatchZ * deviation) &&
+           (*latency_ns > threshold_ns);
+  }
+
+  const uint64_t std_us = latencies.StdDevUs();
+  if (std_us == std::numeric_limits<uint64_t>::max()) {
+    return false;
+  }
+  *latency_ns = latencies.Mean();
+  const double margin_ns = kLatencyWatchZ * std_us * 1000.0 / std::sqrt(count);
+  return (*latency_ns - margin_ns) > threshold_ns;
+}
+
+cb::Error
+InferenceProfiler::DiscardCompletedRequests()
+{
+  TimestampVector empty_timestamps;
+  RETURN_IF_ERROR(manager_->SwapTimestamps(empty_timestamps));
+  if (request_record_writer_ != nullptr) {
+    // What completed since the last measurement is not measured, but it is
+    // still part of the run
+    RETURN_IF_ERROR(request_record_writer_->Write(
+        empty_timestamps, record_load_level_, 0.0));
+  }
+  std::map<std::string, LatencyHistogram> discarded_buckets;
+  RETURN_IF_ERROR(manager_->GetAndResetBucketLatencies(&discarded_buckets));
+  std::map<std::string, RequestClassStats> discarded_classes;
+  RETURN_IF_ERROR(manager_->GetAndResetRequestClassStats(&discarded_classes));
+  SlowRequestTracker discarded_slow_requests;
+  manager_->GetAndResetSlowRequests(&discarded_slow_requests);
+  std::map<std::string, LatencyHistogram> discarded_endpoints;
+  return manager_->GetAndResetEndpointLatencies(&discarded_endpoints);
+}
+
+cb::Error
+InferenceProfiler::WaitForWarmup()
+{
+  if (warmup_.request_count == 0) {
+    return cb::Error::Success;
+  }
+
+  // Only the requests completed since the timestamps were discarded count,
+  // so the warmup of a level is not cut short by the previous one
+  const auto start = std::chrono::steady_clock::now();
+  do {
+    if (early_exit) {
+      return cb::Error("Received exit signal.", pa::GENERIC_ERROR);
+    }
+    RETURN_IF_ERROR(manager_->CheckHealth());
+  } while (!manager_->WaitForCollectedRequests(
+      warmup_.request_count, std::chrono::seconds(1)));
+  if (verbose_) {
+    std::cout << "  Warmup: " << warmup_.request_count << " requests in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count()
+              << " msec" << std::endl;
+  }
+  return DiscardCompletedRequests();
+}
+
 bool
 InferenceProfiler::DetermineStability(LoadStatus& load_status)
 {
@@ -978,26 +1845,64 @@ InferenceProfiler::MergePerfStatusReports(
 
   experiment_perf_status.batch_size = perf_status.batch_size;
   experiment_perf_status.on_sequence_model = perf_status.on_sequence_model;
+  experiment_perf_status.window_start_ns = perf_status.window_start_ns;
+  experiment_perf_status.window_end_ns =
+      perf_status_reports.back().window_end_ns;
 
   // Initialize the client stats for the merged report.
   experiment_perf_status.client_stats.request_count = 0;
   experiment_perf_status.client_stats.sequence_count = 0;
   experiment_perf_status.client_stats.delayed_request_count = 0;
+  experiment_perf_status.client_stats.outlier_count = 0;
+  experiment_perf_status.client_stats.max_outlier_latency_ns = 0;
   experiment_perf_status.client_stats.duration_ns = 0;
   experiment_perf_status.client_stats.avg_latency_ns = 0;
   experiment_perf_status.client_stats.percentile_latency_ns.clear();
-  experiment_perf_status.client_stats.latencies.clear();
+  experiment_perf_status.client_stats.latency_histogram.Reset();
+  experiment_perf_status.client_stats.schedule_error_histogram.Reset();
+  experiment_perf_status.client_stats.dropped_request_count = 0;
+  experiment_perf_status.client_stats.validation_stats = ValidationStats();
+  experiment_perf_status.client_stats.queue_delay_histogram.Reset();
+  experiment_perf_status.client_stats.corrected_latency_histogram.Reset();
+  experiment_perf_status.client_stats.server_queue_histogram.Reset();
+  experiment_perf_status.client_stats.server_compute_input_histogram.Reset();
+  experiment_perf_status.client_stats.server_compute_infer_histogram.Reset();
+  experiment_perf_status.client_stats.server_compute_output_histogram.Reset();
+  experiment_perf_status.client_stats.bucket_latency_histograms.clear();
+  experiment_perf_status.client_stats.request_class_stats.clear();
+  experiment_perf_status.client_stats.endpoint_latency_histograms.clear();
+  experiment_perf_status.client_stats.slow_requests = SlowRequestTracker();
   experiment_perf_status.client_stats.std_us = 0;
   experiment_perf_status.client_stats.avg_request_time_ns = 0;
   experiment_perf_status.client_stats.avg_send_time_ns = 0;
   experiment_perf_status.client_stats.avg_receive_time_ns = 0;
+  experiment_perf_status.client_stats.avg_first_byte_time_ns = 0;
+  experiment_perf_status.client_stats.avg_serialize_time_ns = 0;
+  experiment_perf_status.client_stats.avg_send_queue_time_ns = 0;
+  experiment_perf_status.client_stats.avg_deserialize_time_ns = 0;
+  experiment_perf_status.client_stats.request_byte_size = 0;
+  experiment_perf_status.client_stats.uncompressed_request_byte_size = 0;
+  experiment_perf_status.client_stats.response_byte_size = 0;
+  experiment_perf_status.client_stats.uncompressed_response_byte_size = 0;
+  experiment_perf_status.client_stats.response_chunk_interval_count = 0;
+  experiment_perf_status.client_stats.avg_response_chunk_interval_ns = 0;
+  experiment_perf_status.client_stats.response_count = 0;
+  experiment_perf_status.client_stats.avg_first_response_latency_ns = 0;
+  experiment_perf_status.client_stats.response_gap_count = 0;
+  experiment_perf_status.client_stats.avg_response_gap_ns = 0;
+  experiment_perf_status.client_stats.stage_times = ClientStageTimes();
   experiment_perf_status.client_stats.infer_per_sec = 0;
   experiment_perf_status.client_stats.sequence_per_sec = 0;
   experiment_perf_status.client_stats.completed_count = 0;
   experiment_perf_status.stabilizing_latency_ns = 0;
+  experiment_perf_status.client_resources = ClientResourceStats();
+  experiment_perf_status.window_infer_per_sec.clear();
 
   std::vector<ServerSideStats> server_side_stats;
+  std::map<std::string, std::vector<ServerSideStats>> endpoint_server_stats;
   for (auto& perf_status : perf_status_reports) {
+    experiment_perf_status.window_infer_per_sec.push_back(
+        perf_status.client_stats.infer_per_sec);
     // Aggregated Client Stats
     experiment_perf_status.client_stats.request_count +=
         perf_status.client_stats.request_count;
@@ -1005,24 +1910,120 @@ InferenceProfiler::MergePerfStatusReports(
         perf_status.client_stats.sequence_count;
     experiment_perf_status.client_stats.delayed_request_count +=
         perf_status.client_stats.delayed_request_count;
+    experiment_perf_status.client_stats.dropped_request_count +=
+        perf_status.client_stats.dropped_request_count;
+    experiment_perf_status.client_stats.validation_stats.Merge(
+        perf_status.client_stats.validation_stats);
+    experiment_perf_status.client_stats.outlier_count +=
+        perf_status.client_stats.outlier_count;
+    experiment_perf_status.client_stats.max_outlier_latency_ns = std::max(
+        experiment_perf_status.client_stats.max_outlier_latency_ns,
+        perf_status.client_stats.max_outlier_latency_ns);
     experiment_perf_status.client_stats.duration_ns +=
         perf_status.client_stats.duration_ns;
+    experiment_perf_status.client_stats.response_count +=
+        perf_status.client_stats.response_count;
+    experiment_perf_status.client_stats.avg_first_response_latency_ns +=
+        perf_status.client_stats.avg_first_response_latency_ns *
+        perf_status.client_stats.request_count;
+    experiment_perf_status.client_stats.response_gap_count +=
+        perf_status.client_stats.response_gap_count;
+    experiment_perf_status.client_stats.avg_response_gap_ns +=
+        perf_status.client_stats.avg_response_gap_ns *
+        perf_status.client_stats.response_gap_count;
+    experiment_perf_status.client_stats.stage_times.Merge(
+        perf_status.client_stats.stage_times);
 
     server_side_stats.push_back(perf_status.server_stats);
+    for (const auto& endpoint : perf_status.endpoint_server_stats) {
+      endpoint_server_stats[endpoint.first].push_back(endpoint.second);
+    }
 
-    experiment_perf_status.client_stats.latencies.insert(
-        experiment_perf_status.client_stats.latencies.end(),
-        perf_status.client_stats.latencies.begin(),
-        perf_status.client_stats.latencies.end());
+    RETURN_IF_ERROR(experiment_perf_status.client_stats.latency_histogram.Merge(
+        perf_status.client_stats.latency_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.schedule_error_histogram.Merge(
+            perf_status.client_stats.schedule_error_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.queue_delay_histogram.Merge(
+            perf_status.client_stats.queue_delay_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.corrected_latency_histogram.Merge(
+            perf_status.client_stats.corrected_latency_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.server_queue_histogram.Merge(
+            perf_status.client_stats.server_queue_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.server_compute_input_histogram
+            .Merge(perf_status.client_stats.server_compute_input_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.server_compute_infer_histogram
+            .Merge(perf_status.client_stats.server_compute_infer_histogram));
+    RETURN_IF_ERROR(
+        experiment_perf_status.client_stats.server_compute_output_histogram
+            .Merge(perf_status.client_stats.server_compute_output_histogram));
+    for (const auto& bucket :
+         perf_status.client_stats.bucket_latency_histograms) {
+      RETURN_IF_ERROR(experiment_perf_status.client_stats
+                          .bucket_latency_histograms[bucket.first]
+                          .Merge(bucket.second));
+    }
+    for (const auto& request_class :
+         perf_status.client_stats.request_class_stats) {
+      RETURN_IF_ERROR(experiment_perf_status.client_stats
+                          .request_class_stats[request_class.first]
+                          .Merge(request_class.second));
+    }
+    for (const auto& endpoint :
+         perf_status.client_stats.endpoint_latency_histograms) {
+      RETURN_IF_ERROR(experiment_perf_status.client_stats
+                          .endpoint_latency_histograms[endpoint.first]
+                          .Merge(endpoint.second));
+    }
+    experiment_perf_status.client_stats.slow_requests.Merge(
+        perf_status.client_stats.slow_requests);
     // Accumulate the overhead percentage and send rate here to remove extra
     // traversals over the perf_status_reports
     experiment_perf_status.overhead_pct += perf_status.overhead_pct;
     experiment_perf_status.send_request_rate += perf_status.send_request_rate;
+
+    // The CPU usages are averaged over the windows below
+    auto& resources = experiment_perf_status.client_resources;
+    const auto& window_resources = perf_status.client_resources;
+    resources.cpu_user_pct += window_resources.cpu_user_pct;
+    resources.cpu_sys_pct += window_resources.cpu_sys_pct;
+    resources.rss_bytes =
+        std::max(resources.rss_bytes, window_resources.rss_bytes);
+    resources.voluntary_context_switches +=
+        window_resources.voluntary_context_switches;
+    resources.involuntary_context_switches +=
+        window_resources.involuntary_context_switches;
+    for (const auto& thread : window_resources.thread_cpu_pct) {
+      resources.thread_cpu_pct[thread.first] += thread.second;
+    }
+    resources.max_thread_cpu_pct = std::max(
+        resources.max_thread_cpu_pct, window_resources.max_thread_cpu_pct);
+  }
+
+  if (experiment_perf_status.client_stats.request_count != 0) {
+    experiment_perf_status.client_stats.avg_first_response_latency_ns /=
+        experiment_perf_status.client_stats.request_count;
+  }
+  if (experiment_perf_status.client_stats.response_gap_count != 0) {
+    experiment_perf_status.client_stats.avg_response_gap_ns /=
+        experiment_perf_status.client_stats.response_gap_count;
   }
 
   // Calculate the average overhead_pct for the experiment.
   experiment_perf_status.overhead_pct /= perf_status_reports.size();
   experiment_perf_status.send_request_rate /= perf_status_reports.size();
+  experiment_perf_status.client_resources.cpu_user_pct /=
+      perf_status_reports.size();
+  experiment_perf_status.client_resources.cpu_sys_pct /=
+      perf_status_reports.size();
+  for (auto& thread : experiment_perf_status.client_resources.thread_cpu_pct) {
+    thread.second /= perf_status_reports.size();
+  }
 
   if (include_lib_stats_) {
     for (auto& perf_status : perf_status_reports) {
@@ -1040,6 +2041,38 @@ InferenceProfiler::MergePerfStatusReports(
       experiment_perf_status.client_stats.avg_receive_time_ns +=
           perf_status.client_stats.avg_receive_time_ns *
           perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_first_byte_time_ns +=
+          perf_status.client_stats.avg_first_byte_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_serialize_time_ns +=
+          perf_status.client_stats.avg_serialize_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_send_queue_time_ns +=
+          perf_status.client_stats.avg_send_queue_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_deserialize_time_ns +=
+          perf_status.client_stats.avg_deserialize_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.request_byte_size +=
+          perf_status.client_stats.request_byte_size;
+      experiment_perf_status.client_stats.uncompressed_request_byte_size +=
+          perf_status.client_stats.uncompressed_request_byte_size;
+      experiment_perf_status.client_stats.response_byte_size +=
+          perf_status.client_stats.response_byte_size;
+      experiment_perf_status.client_stats.uncompressed_response_byte_size +=
+          perf_status.client_stats.uncompressed_response_byte_size;
+
+      experiment_perf_status.client_stats.response_chunk_interval_count +=
+          perf_status.client_stats.response_chunk_interval_count;
+
+      experiment_perf_status.client_stats.avg_response_chunk_interval_ns +=
+          perf_status.client_stats.avg_response_chunk_interval_ns *
+          perf_status.client_stats.response_chunk_interval_count;
     }
 
     if (experiment_perf_status.client_stats.completed_count != 0) {
@@ -1054,15 +2087,40 @@ InferenceProfiler::MergePerfStatusReports(
       experiment_perf_status.client_stats.avg_receive_time_ns =
           experiment_perf_status.client_stats.avg_receive_time_ns /
           experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_first_byte_time_ns =
+          experiment_perf_status.client_stats.avg_first_byte_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_serialize_time_ns =
+          experiment_perf_status.client_stats.avg_serialize_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_send_queue_time_ns =
+          experiment_perf_status.client_stats.avg_send_queue_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_deserialize_time_ns =
+          experiment_perf_status.client_stats.avg_deserialize_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+    }
+
+    if (experiment_perf_status.client_stats.response_chunk_interval_count !=
+        0) {
+      experiment_perf_status.client_stats.avg_response_chunk_interval_ns =
+          experiment_perf_status.client_stats.avg_response_chunk_interval_ns /
+          experiment_perf_status.client_stats.response_chunk_interval_count;
     }
   }
 
   RETURN_IF_ERROR(MergeServerSideStats(
       server_side_stats, experiment_perf_status.server_stats));
-
-  std::sort(
-      experiment_perf_status.client_stats.latencies.begin(),
-      experiment_perf_status.client_stats.latencies.end());
+  experiment_perf_status.endpoint_server_stats.clear();
+  for (auto& endpoint : endpoint_server_stats) {
+    RETURN_IF_ERROR(MergeServerSideStats(
+        endpoint.second,
+        experiment_perf_status.endpoint_server_stats[endpoint.first]));
+  }
 
   float client_duration_sec =
       (float)experiment_perf_status.client_stats.duration_ns / NANOS_PER_SECOND;
@@ -1073,7 +2131,8 @@ InferenceProfiler::MergePerfStatusReports(
        experiment_perf_status.batch_size) /
       client_duration_sec;
   RETURN_IF_ERROR(SummarizeLatency(
-      experiment_perf_status.client_stats.latencies, experiment_perf_status));
+      experiment_perf_status.client_stats.latency_histogram,
+      experiment_perf_status));
 
   if (should_collect_metrics_) {
     // Put all Metric objects in a flat vector so they're easier to merge
@@ -1089,6 +2148,24 @@ InferenceProfiler::MergePerfStatusReports(
     Metrics merged_metrics{};
     RETURN_IF_ERROR(MergeMetrics(all_metrics, merged_metrics));
     experiment_perf_status.metrics.push_back(std::move(merged_metrics));
+
+    auto& correlation = experiment_perf_status.metrics_correlation;
+    CorrelateMetrics(
+        all_metrics, experiment_perf_status.client_stats.infer_per_sec,
+        &correlation);
+    double tail_utilization_sum = 0;
+    correlation.tail_request_count = 0;
+    for (const auto& perf_status : perf_status_reports) {
+      tail_utilization_sum +=
+          perf_status.metrics_correlation.tail_gpu_utilization *
+          perf_status.metrics_correlation.tail_request_count;
+      correlation.tail_request_count +=
+          perf_status.metrics_correlation.tail_request_count;
+    }
+    correlation.tail_gpu_utilization =
+        (correlation.tail_request_count > 0)
+            ? tail_utilization_sum / correlation.tail_request_count
+            : 0;
   }
 
   return cb::Error::Success;
@@ -1096,25 +2173,128 @@ InferenceProfiler::MergePerfStatusReports(
 
 cb::Error
 InferenceProfiler::GetServerSideStatus(
+    std::map<cb::ModelIdentifier, cb::ModelStatistics>* model_stats,
+    std::map<std::string, std::map<cb::ModelIdentifier, cb::ModelStatistics>>*
+        endpoint_stats)
+{
+  if (endpoint_backends_.empty()) {
+    return GetBackendServerSideStatus(profile_backend_.get(), model_stats);
+  }
+
+  // The servers behind the endpoints share the load, so their statistics add
+  // up to those of the whole
+  model_stats->clear();
+  for (const auto& endpoint : endpoint_backends_) {
+    auto& stats = (*endpoint_stats)[endpoint.first];
+    RETURN_IF_ERROR(GetBackendServerSideStatus(endpoint.second.get(), &stats));
+    for (const auto& stat : stats) {
+      cb::ModelStatistics& sum = (*model_stats)[stat.first];
+      sum.success_count_ += stat.second.success_count_;
+      sum.inference_count_ += stat.second.inference_count_;
+      sum.execution_count_ += stat.second.execution_count_;
+      sum.queue_count_ += stat.second.queue_count_;
+      sum.compute_input_count_ += stat.second.compute_input_count_;
+      sum.compute_infer_count_ += stat.second.compute_infer_count_;
+      sum.compute_output_count_ += stat.second.compute_output_count_;
+      sum.cache_hit_count_ += stat.second.cache_hit_count_;
+      sum.cache_miss_count_ += stat.second.cache_miss_count_;
+      sum.cumm_time_ns_ += stat.second.cumm_time_ns_;
+      sum.queue_time_ns_ += stat.second.queue_time_ns_;
+      sum.compute_input_time_ns_ += stat.second.compute_input_time_ns_;
+      sum.compute_infer_time_ns_ += stat.second.compute_infer_time_ns_;
+      sum.compute_output_time_ns_ += stat.second.compute_output_time_ns_;
+      sum.cache_hit_time_ns_ += stat.second.cache_hit_time_ns_;
+      sum.cache_miss_time_ns_ += stat.second.cache_miss_time_ns_;
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+InferenceProfiler::GetBackendServerSideStatus(
+    cb::ClientBackend* backend,
     std::map<cb::ModelIdentifier, cb::ModelStatistics>* model_stats)
 {
   if ((parser_->SchedulerType() == ModelParser::ENSEMBLE) ||
       (parser_->SchedulerType() == ModelParser::ENSEMBLE_SEQUENCE)) {
-    RETURN_IF_ERROR(profile_backend_->ModelInferenceStatistics(model_stats));
+    // Only the statistics of the models in the ensemble are needed, and
+    // fetching them separately and concurrently is much faster than fetching
+    // those of every model on the server.
+    if (statistics_models_.empty()) {
+      CollectStatisticsModels(
+          std::make_pair(parser_->ModelName(), parser_->ModelVersion()),
+          *parser_->GetComposingModelMap(), &statistics_models_);
+      statistics_models_stats_.resize(statistics_models_.size());
+    }
+
+    std::vector<std::future<cb::Error>> requests;
+    requests.reserve(statistics_models_.size());
+    for (size_t i = 0; i < statistics_models_.size(); i++) {
+      requests.emplace_back(
+          std::async(std::launch::async, [this, backend, i]() {
+            return backend->ModelInferenceStatistics(
+                &statistics_models_stats_[i], statistics_models_[i].first,
+                statistics_models_[i].second);
+          }));
+    }
+    cb::Error err = cb::Error::Success;
+    for (auto& request : requests) {
+      cb::Error request_err = request.get();
+      if (err.IsOk() && !request_err.IsOk()) {
+        err = request_err;
+      }
+    }
+    RETURN_IF_ERROR(err);
+
+    // Update the entries in place, the models do not change between windows
+    size_t num_stats = 0;
+    for (const auto& stats : statistics_models_stats_) {
+      for (const auto& stat : stats) {
+        (*model_stats)[stat.first] = stat.second;
+      }
+      num_stats += stats.size();
+    }
+    if (model_stats->size() > num_stats) {
+      for (auto it = model_stats->begin(); it != model_stats->end();) {
+        bool reported = false;
+        for (const auto& stats : statistics_models_stats_) {
+          reported |= (stats.find(it->first) != stats.end());
+        }
+        it = reported ? std::next(it) : model_stats->erase(it);
+      }
+    }
   } else {
-    RETURN_IF_ERROR(profile_backend_->ModelInferenceStatistics(
+    RETURN_IF_ERROR(backend->ModelInferenceStatistics(
         model_stats, parser_->ModelName(), parser_->ModelVersion()));
   }
   return cb::Error::Success;
 }
 
+void
+InferenceProfiler::CollectStatisticsModels(
+    const cb::ModelIdentifier& model_identifier,
+    const ComposingModelMap& composing_models,
+    std::vector<cb::ModelIdentifier>* models)
+{
+  if (std::find(models->begin(), models->end(), model_identifier) !=
+      models->end()) {
+    return;
+  }
+  models->push_back(model_identifier);
+  const auto it = composing_models.find(model_identifier.first);
+  if (it != composing_models.end()) {
+    for (const auto& composing_model_identifier : it->second) {
+      CollectStatisticsModels(
+          composing_model_identifier, composing_models, models);
+    }
+  }
+}
+
 // Used for measurement
 cb::Error
 InferenceProfiler::Measure(
     PerfStatus& perf_status, uint64_t measurement_window, bool is_count_based)
 {
-  std::map<cb::ModelIdentifier, cb::ModelStatistics> start_status;
-  std::map<cb::ModelIdentifier, cb::ModelStatistics> end_status;
   cb::InferStat start_stat;
   cb::InferStat end_stat;
 
@@ -1124,19 +2304,60 @@ InferenceProfiler::Measure(
   // measurement window, capture start time, server side stats, and client side
   // stats.
   uint64_t window_start_ns = previous_window_end_ns_;
+  const bool first_window = (window_start_ns == 0);
   start_stat = prev_client_side_stats_;
-  start_status = prev_server_side_stats_;
-  if (window_start_ns == 0) {
-    window_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                          std::chrono::system_clock::now().time_since_epoch())
-                          .count();
+  // Fixed windows are planned on the clock rather than ended whenever the
+  // previous one was processed, so that they stay aligned across processes
+  // whatever the time each process takes between them.
+  const bool fixed_windows =
+      (distributed_load_ != nullptr) || window_clock_.IsAligned();
+  if (first_window) {
+    if (distributed_load_ != nullptr) {
+      // All the ranks start on the clock of the coordinator
+      window_start_ns =
+          window_clock_.ToLocalNs(distributed_load_->SharedStartNs(
+              kDistributedStartLeadMs * NANOS_PER_MILLIS));
+    } else {
+      window_start_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now().time_since_epoch())
+              .count();
+    }
+    if (window_clock_.IsAligned()) {
+      window_start_ns = window_clock_.NextBoundaryNs(window_start_ns);
+    }
+    if (fixed_windows) {
+      std::this_thread::sleep_until(std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::nanoseconds(window_start_ns))));
+    }
+  }
+
+  uint64_t window_duration_ns =
+      (uint64_t)(measurement_window_ms_ * 1.2) * NANOS_PER_MILLIS;
+  if (window_clock_.IsAligned()) {
+    window_duration_ns = window_clock_.AlignedDurationNs(window_duration_ns);
+  }
+  if (fixed_windows) {
+    // A window failing on this process still ends with the others
+    previous_window_end_ns_ = window_start_ns + window_duration_ns;
+  }
+
+  if (first_window) {
     if (should_collect_metrics_) {
       metrics_manager_->StartQueryingMetrics();
     }
     if (include_server_stats_) {
-      RETURN_IF_ERROR(GetServerSideStatus(&start_status));
+      RETURN_IF_ERROR(GetServerSideStatus(
+          &prev_server_side_stats_, &prev_endpoint_server_stats_));
+    }
+    if (include_server_request_timings_) {
+      // The requests traced before the window are not part of it
+      std::vector<cb::ServerRequestTiming> discarded;
+      RETURN_IF_ERROR(profile_backend_->ServerRequestTimings(&discarded));
     }
     RETURN_IF_ERROR(manager_->GetAccumulatedClientStat(&start_stat));
+    RETURN_IF_ERROR(SampleProcessResources(&prev_resource_sample_));
   }
 
   if (should_collect_metrics_) {
@@ -1148,25 +2369,60 @@ InferenceProfiler::Measure(
     }
   }
 
-  if (!is_count_based) {
-    // Wait for specified time interval in msec
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds((uint64_t)(measurement_window_ms_ * 1.2)));
+  if (fixed_windows) {
+    std::this_thread::sleep_until(std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(previous_window_end_ns_))));
+  } else if (!is_count_based) {
+    // Wait for specified time interval in msec, unless the load level turns
+    // out to be over the latency threshold before
+    const auto window_end = std::chrono::steady_clock::now() +
+                            std::chrono::nanoseconds(window_duration_ns);
+    if (!WatchingLatency()) {
+      std::this_thread::sleep_until(window_end);
+    }
+    while (WatchingLatency() && (breached_latency_ns_ == 0)) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= window_end) {
+        break;
+      }
+      const auto next_check =
+          now + std::chrono::milliseconds(kLatencyWatchIntervalMs);
+      std::this_thread::sleep_until(std::min(window_end, next_check));
+      RETURN_IF_ERROR(WatchLatency());
+    }
   } else {
+    // The window closes as soon as the last of its requests completes, the
+    // timeout only paces the health checks of the worker threads
+    const std::chrono::nanoseconds timeout =
+        WatchingLatency() ? std::chrono::milliseconds(kLatencyWatchIntervalMs)
+                          : std::chrono::milliseconds(1000);
     do {
-      // Check the health of the worker threads.
       RETURN_IF_ERROR(manager_->CheckHealth());
+      if (WatchingLatency()) {
+        RETURN_IF_ERROR(WatchLatency());
+        if (breached_latency_ns_ != 0) {
+          break;
+        }
+      }
+    } while (!manager_->WaitForCollectedRequests(measurement_window, timeout));
+  }
 
-      // Wait for 1s until enough samples have been collected.
-      std::this_thread::sleep_for(std::chrono::milliseconds((uint64_t)1000));
-    } while (manager_->CountCollectedRequests() < measurement_window);
+  uint64_t window_end_ns = previous_window_end_ns_;
+  if (!fixed_windows) {
+    window_end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+    previous_window_end_ns_ = window_end_ns;
   }
 
-  uint64_t window_end_ns =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(
-          std::chrono::system_clock::now().time_since_epoch())
-          .count();
-  previous_window_end_ns_ = window_end_ns;
+  // Sample before the statistics below are gathered, so that the window
+  // accounts for the load rather than for the profiler
+  ProcessResourceSample resource_sample;
+  RETURN_IF_ERROR(SampleProcessResources(&resource_sample));
+  SummarizeProcessResources(
+      prev_resource_sample_, resource_sample, &perf_status.client_resources);
+  prev_resource_sample_ = std::move(resource_sample);
 
   if (should_collect_metrics_) {
     metrics_manager_->GetLatestMetrics(perf_status.metrics);
@@ -1175,9 +2431,14 @@ InferenceProfiler::Measure(
   // Get server status and then print report on difference between
   // before and after status.
   if (include_server_stats_) {
-    RETURN_IF_ERROR(GetServerSideStatus(&end_status));
-    prev_server_side_stats_ = end_status;
+    RETURN_IF_ERROR(GetServerSideStatus(
+        &next_server_side_stats_, &next_endpoint_server_stats_));
+    prev_server_side_stats_.swap(next_server_side_stats_);
+    prev_endpoint_server_stats_.swap(next_endpoint_server_stats_);
   }
+  // After the swap, the previous statistics are those at the window end
+  const auto& start_status = next_server_side_stats_;
+  const auto& end_status = prev_server_side_stats_;
 
   RETURN_IF_ERROR(manager_->GetAccumulatedClientStat(&end_stat));
   prev_client_side_stats_ = end_stat;
@@ -1191,6 +2452,19 @@ InferenceProfiler::Measure(
   RETURN_IF_ERROR(Summarize(
       start_status, end_status, start_stat, end_stat, perf_status,
       window_start_ns, window_end_ns));
+  perf_status.endpoint_server_stats.clear();
+  if (include_server_stats_) {
+    for (const auto& endpoint : prev_endpoint_server_stats_) {
+      RETURN_IF_ERROR(SummarizeServerStats(
+          next_endpoint_server_stats_[endpoint.first], endpoint.second,
+          &perf_status.endpoint_server_stats[endpoint.first]));
+    }
+  }
+  if (request_record_writer_ != nullptr) {
+    RETURN_IF_ERROR(request_record_writer_->Write(
+        current_timestamps, record_load_level_,
+        perf_status.client_stats.infer_per_sec));
+  }
 
   return cb::Error::Success;
 }
@@ -1209,16 +2483,91 @@ InferenceProfiler::Summarize(
   std::pair<uint64_t, uint64_t> valid_range{window_start_ns, window_end_ns};
   uint64_t window_duration_ns = valid_range.second - valid_range.first;
   std::vector<uint64_t> latencies;
+  std::vector<uint64_t> end_times_ns;
+  const bool keep_end_times = early_convergence_ || should_collect_metrics_;
   ValidLatencyMeasurement(
-      valid_range, valid_sequence_count, delayed_request_count, &latencies);
+      valid_range, valid_sequence_count, delayed_request_count, &latencies,
+      keep_end_times ? &end_times_ns : nullptr,
+      parser_->IsDecoupled() ? &summary.client_stats : nullptr);
+  // Outliers still completed in the window, so they count in the throughput
+  const size_t completed_request_count = latencies.size();
+  TrimLatencyOutliers(
+      latencies, keep_end_times ? &end_times_ns : nullptr,
+      summary.client_stats);
+  if (early_convergence_) {
+    // Check before the percentile selection reorders the latencies
+    summary.converged = IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns);
+  }
+  // The times the slowest requests completed, to look up the GPU metrics at
+  std::vector<uint64_t> tail_end_times_ns;
+  if (should_collect_metrics_ && !latencies.empty()) {
+    std::vector<uint64_t> sorted_latencies(latencies);
+    const auto p99_it =
+        sorted_latencies.begin() + (sorted_latencies.size() - 1) * 99 / 100;
+    std::nth_element(sorted_latencies.begin(), p99_it, sorted_latencies.end());
+    for (size_t i = 0; i < latencies.size(); i++) {
+      if (latencies[i] >= *p99_it) {
+        tail_end_times_ns.push_back(end_times_ns[i]);
+      }
+    }
+  }
 
   RETURN_IF_ERROR(SummarizeLatency(latencies, summary));
   RETURN_IF_ERROR(SummarizeClientStat(
-      start_stat, end_stat, window_duration_ns, latencies.size(),
+      start_stat, end_stat, window_duration_ns, completed_request_count,
       valid_sequence_count, delayed_request_count, summary));
-  summary.client_stats.latencies = std::move(latencies);
+  if (should_collect_metrics_) {
+    CorrelateMetrics(
+        {summary.metrics.begin(), summary.metrics.end()},
+        summary.client_stats.infer_per_sec, &summary.metrics_correlation);
+    summary.metrics_correlation.tail_request_count = GpuUtilizationAt(
+        summary.metrics, tail_end_times_ns,
+        &summary.metrics_correlation.tail_gpu_utilization);
+  }
+  summary.client_stats.latency_histogram.Reset();
+  for (const auto latency : latencies) {
+    summary.client_stats.latency_histogram.Record(latency);
+  }
+
+  RETURN_IF_ERROR(manager_->GetAndResetScheduleErrors(
+      &summary.client_stats.schedule_error_histogram));
+  RETURN_IF_ERROR(manager_->GetAndResetInflightLimitStats(
+      &summary.client_stats.dropped_request_count,
+      &summary.client_stats.queue_delay_histogram));
+  RETURN_IF_ERROR(manager_->GetAndResetValidationStats(
+      &summary.client_stats.validation_stats));
+  RETURN_IF_ERROR(manager_->GetAndResetCorrectedLatencies(
+      &summary.client_stats.corrected_latency_histogram));
+  RETURN_IF_ERROR(manager_->GetAndResetBucketLatencies(
+      &summary.client_stats.bucket_latency_histograms));
+  RETURN_IF_ERROR(manager_->GetAndResetRequestClassStats(
+      &summary.client_stats.request_class_stats));
+  RETURN_IF_ERROR(manager_->GetAndResetEndpointLatencies(
+      &summary.client_stats.endpoint_latency_histograms));
+  manager_->GetAndResetSlowRequests(&summary.client_stats.slow_requests);
+  summary.client_stats.server_queue_histogram.Reset();
+  summary.client_stats.server_compute_input_histogram.Reset();
+  summary.client_stats.server_compute_infer_histogram.Reset();
+  summary.client_stats.server_compute_output_histogram.Reset();
+  if (include_server_request_timings_) {
+    std::vector<cb::ServerRequestTiming> timings;
+    RETURN_IF_ERROR(profile_backend_->ServerRequestTimings(&timings));
+    for (const auto& timing : timings) {
+      summary.client_stats.server_queue_histogram.Record(timing.queue_ns);
+      summary.client_stats.server_compute_input_histogram.Record(
+          timing.compute_input_ns);
+      summary.client_stats.server_compute_infer_histogram.Record(
+          timing.compute_infer_ns);
+      summary.client_stats.server_compute_output_histogram.Record(
+          timing.compute_output_ns);
+    }
+  }
+  manager_->GetAndResetClientStageTimes(&summary.client_stats.stage_times);
 
   SummarizeOverhead(window_duration_ns, manager_->GetIdleTime(), summary);
+  summary.window_start_ns = window_clock_.ToReferenceNs(window_start_ns);
+  summary.window_end_ns = window_clock_.ToReferenceNs(window_end_ns);
 
   double window_duration_s{window_duration_ns /
                            static_cast<double>(NANOS_PER_SECOND)};
@@ -1238,47 +2587,166 @@ void
 InferenceProfiler::ValidLatencyMeasurement(
     const std::pair<uint64_t, uint64_t>& valid_range,
     size_t& valid_sequence_count, size_t& delayed_request_count,
-    std::vector<uint64_t>* valid_latencies)
+    std::vector<uint64_t>* valid_latencies,
+    std::vector<uint64_t>* end_times_ns, ClientSideStats* response_stats)
 {
   valid_latencies->clear();
   valid_sequence_count = 0;
-  std::vector<size_t> erase_indices{};
+  if (end_times_ns != nullptr) {
+    end_times_ns->clear();
+  }
+  uint64_t response_count = 0;
+  uint64_t first_response_latency_ns = 0;
+  uint64_t response_gap_count = 0;
+  uint64_t response_gap_ns = 0;
+
+  // Single pass that extracts the requests that end within the window and
+  // compacts the remaining timestamps to the front of `all_timestamps_`,
+  // preserving their order
+  size_t keep_idx = 0;
   for (size_t i = 0; i < all_timestamps_.size(); i++) {
     const auto& timestamp = all_timestamps_[i];
     uint64_t request_start_ns = CHRONO_TO_NANOS(std::get<0>(timestamp));
     uint64_t request_end_ns = CHRONO_TO_NANOS(std::get<1>(timestamp));
 
-    if (request_start_ns <= request_end_ns) {
-      // Only counting requests that end within the time interval
-      if ((request_end_ns >= valid_range.first) &&
-          (request_end_ns <= valid_range.second)) {
-        valid_latencies->push_back(request_end_ns - request_start_ns);
-        erase_indices.push_back(i);
-        // Just add the sequence_end flag here.
-        if (std::get<2>(timestamp)) {
-          valid_sequence_count++;
-        }
-        if (std::get<3>(timestamp)) {
-          delayed_request_count++;
-        }
+    // Only counting requests that end within the time interval
+    if ((request_start_ns <= request_end_ns) &&
+        (request_end_ns >= valid_range.first) &&
+        (request_end_ns <= valid_range.second)) {
+      valid_latencies->push_back(request_end_ns - request_start_ns);
+      if (end_times_ns != nullptr) {
+        end_times_ns->push_back(request_end_ns);
+      }
+      // Just add the sequence_end flag here.
+      if (std::get<2>(timestamp)) {
+        valid_sequence_count++;
+      }
+      if (std::get<3>(timestamp)) {
+        delayed_request_count++;
+      }
+      // The gaps between the responses add up to the time from the first
+      // response to the last one, which ends the request
+      const uint64_t first_response_ns =
+          CHRONO_TO_NANOS(std::get<4>(timestamp));
+      const uint32_t request_response_count = std::get<5>(timestamp);
+      first_response_latency_ns += first_response_ns - request_start_ns;
+      if (request_response_count != 0) {
+        response_count += request_response_count;
+        response_gap_count += request_response_count - 1;
+        response_gap_ns += request_end_ns - first_response_ns;
+      }
+    } else {
+      if (keep_idx != i) {
+        all_timestamps_[keep_idx] = timestamp;
+      }
+      keep_idx++;
+    }
+  }
+  all_timestamps_.resize(keep_idx);
+
+  if (response_stats != nullptr) {
+    response_stats->response_count = response_count;
+    response_stats->avg_first_response_latency_ns =
+        valid_latencies->empty()
+            ? 0
+            : first_response_latency_ns / valid_latencies->size();
+    response_stats->response_gap_count = response_gap_count;
+    response_stats->avg_response_gap_ns =
+        (response_gap_count == 0) ? 0 : response_gap_ns / response_gap_count;
+  }
+}
+
+bool
+InferenceProfiler::IsWindowConverged(
+    const std::vector<uint64_t>& latencies,
+    const std::vector<uint64_t>& end_times_ns, uint64_t window_start_ns,
+    uint64_t window_end_ns)
+{
+  if ((window_end_ns <= window_start_ns) ||
+      (latencies.size() <
+       kConvergenceSubWindows * kConvergenceMinSubWindowRequests)) {
+    return false;
+  }
+
+  const uint64_t window_duration_ns = window_end_ns - window_start_ns;
+  std::vector<std::vector<uint64_t>> sub_window_latencies(
+      kConvergenceSubWindows);
+  for (size_t i = 0; i < latencies.size(); i++) {
+    size_t sub_window = (end_times_ns[i] - window_start_ns) *
+                        kConvergenceSubWindows / window_duration_ns;
+    sub_window = std::min(sub_window, kConvergenceSubWindows - 1);
+    sub_window_latencies[sub_window].push_back(latencies[i]);
+  }
+
+  const double sub_window_s = window_duration_ns /
+                              static_cast<double>(NANOS_PER_SECOND) /
+                              kConvergenceSubWindows;
+  std::vector<double> throughputs;
+  std::vector<double> stabilizing_latencies;
+  for (auto& sub_window : sub_window_latencies) {
+    if (sub_window.size() < kConvergenceMinSubWindowRequests) {
+      return false;
+    }
+    throughputs.push_back(sub_window.size() / sub_window_s);
+    if (extra_percentile_) {
+      size_t index = (percentile_ / 100.0) * (sub_window.size() - 1) + 0.5;
+      std::nth_element(
+          sub_window.begin(), sub_window.begin() + index, sub_window.end());
+      stabilizing_latencies.push_back(sub_window[index]);
+    } else {
+      double sum = 0;
+      for (const auto latency : sub_window) {
+        sum += latency;
       }
+      stabilizing_latencies.push_back(sum / sub_window.size());
     }
   }
 
-  // Iterate through erase indices backwards so that erases from
-  // `all_timestamps_` happen from the back to the front to avoid using wrong
-  // indices after subsequent erases
-  std::for_each(erase_indices.rbegin(), erase_indices.rend(), [this](size_t i) {
-    this->all_timestamps_.erase(this->all_timestamps_.begin() + i);
-  });
+  const double threshold = load_parameters_.stability_threshold;
+  return IsMeanConverged(throughputs, threshold) &&
+         IsMeanConverged(stabilizing_latencies, threshold);
+}
 
-  // Always sort measured latencies as percentile will be reported as default
-  std::sort(valid_latencies->begin(), valid_latencies->end());
+void
+InferenceProfiler::TrimLatencyOutliers(
+    std::vector<uint64_t>& latencies, std::vector<uint64_t>* end_times_ns,
+    ClientSideStats& stats)
+{
+  stats.outlier_count = 0;
+  stats.max_outlier_latency_ns = 0;
+  if ((warmup_.outlier_factor <= 0) || latencies.empty()) {
+    return;
+  }
+
+  // The median is not moved by the outliers themselves
+  std::vector<uint64_t> selected(latencies);
+  auto median = selected.begin() + selected.size() / 2;
+  std::nth_element(selected.begin(), median, selected.end());
+  const double limit = *median * warmup_.outlier_factor;
+
+  size_t keep_idx = 0;
+  for (size_t i = 0; i < latencies.size(); i++) {
+    if (latencies[i] > limit) {
+      stats.outlier_count++;
+      stats.max_outlier_latency_ns =
+          std::max(stats.max_outlier_latency_ns, latencies[i]);
+      continue;
+    }
+    latencies[keep_idx] = latencies[i];
+    if (end_times_ns != nullptr) {
+      (*end_times_ns)[keep_idx] = (*end_times_ns)[i];
+    }
+    keep_idx++;
+  }
+  latencies.resize(keep_idx);
+  if (end_times_ns != nullptr) {
+    end_times_ns->resize(keep_idx);
+  }
 }
 
 cb::Error
 InferenceProfiler::SummarizeLatency(
-    const std::vector<uint64_t>& latencies, PerfStatus& summary)
+    std::vector<uint64_t>& latencies, PerfStatus& summary)
 {
   if (latencies.size() == 0) {
     return cb::Error(
@@ -1292,15 +2760,53 @@ InferenceProfiler::SummarizeLatency(
 
   // retrieve other interesting percentile
   summary.client_stats.percentile_latency_ns.clear();
-  std::set<size_t> percentiles{50, 90, 95, 99};
-  if (extra_percentile_) {
-    percentiles.emplace(percentile_);
-  }
+  std::set<size_t> percentiles{ReportedPercentiles()};
 
+  // Select each percentile instead of sorting every latency. The percentiles
+  // are visited in increasing order, so each selection only needs to look at
+  // the elements above the previous one.
+  auto search_begin = latencies.begin();
   for (const auto percentile : percentiles) {
     size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
+    auto nth = latencies.begin() + index;
+    std::nth_element(search_begin, nth, latencies.end());
+    summary.client_stats.percentile_latency_ns.emplace(percentile, *nth);
+    search_begin = nth;
+  }
+
+  if (extra_percentile_) {
+    summary.stabilizing_latency_ns =
+        summary.client_stats.percentile_latency_ns.find(percentile_)->second;
+  } else {
+    summary.stabilizing_latency_ns = summary.client_stats.avg_latency_ns;
+  }
+
+  return cb::Error::Success;
+}
+
+cb::Error
+InferenceProfiler::SummarizeLatency(
+    const LatencyHistogram& latencies, PerfStatus& summary)
+{
+  if (latencies.TotalCount() == 0) {
+    return cb::Error(
+        "No valid requests recorded within time interval."
+        " Please use a larger time window.",
+        pa::OPTION_ERROR);
+  }
+
+  summary.client_stats.avg_latency_ns = latencies.Mean();
+  summary.client_stats.std_us = latencies.StdDevUs();
+  if (latencies.TotalCount() == 1) {
+    std::cerr << "WARNING: Pass contained only one request, so sample latency "
+                 "standard deviation will be infinity (UINT64_MAX)."
+              << std::endl;
+  }
+
+  summary.client_stats.percentile_latency_ns.clear();
+  for (const auto percentile : ReportedPercentiles()) {
     summary.client_stats.percentile_latency_ns.emplace(
-        percentile, latencies[index]);
+        percentile, latencies.ValueAtPercentile(percentile));
   }
 
   if (extra_percentile_) {
@@ -1313,6 +2819,16 @@ InferenceProfiler::SummarizeLatency(
   return cb::Error::Success;
 }
 
+std::set<size_t>
+InferenceProfiler::ReportedPercentiles() const
+{
+  std::set<size_t> percentiles{50, 90, 95, 99};
+  if (extra_percentile_) {
+    percentiles.emplace(percentile_);
+  }
+  return percentiles;
+}
+
 std::tuple<uint64_t, uint64_t>
 InferenceProfiler::GetMeanAndStdDev(const std::vector<uint64_t>& latencies)
 {
@@ -1342,7 +2858,6 @@ InferenceProfiler::GetMeanAndStdDev(const std::vector<uint64_t>& latencies)
               << std::endl;
   }
 
-
   return std::make_tuple(avg_latency_ns, std_dev_latency_us);
 }
 
@@ -1384,6 +2899,43 @@ InferenceProfiler::SummarizeClientStat(
       summary.client_stats.avg_send_time_ns = send_time_ns / completed_count;
       summary.client_stats.avg_receive_time_ns =
           receive_time_ns / completed_count;
+      summary.client_stats.avg_first_byte_time_ns =
+          (end_stat.cumulative_first_byte_time_ns -
+           start_stat.cumulative_first_byte_time_ns) /
+          completed_count;
+      summary.client_stats.avg_serialize_time_ns =
+          (end_stat.cumulative_serialize_time_ns -
+           start_stat.cumulative_serialize_time_ns) /
+          completed_count;
+      summary.client_stats.avg_send_queue_time_ns =
+          (end_stat.cumulative_send_queue_time_ns -
+           start_stat.cumulative_send_queue_time_ns) /
+          completed_count;
+      summary.client_stats.avg_deserialize_time_ns =
+          (end_stat.cumulative_deserialize_time_ns -
+           start_stat.cumulative_deserialize_time_ns) /
+          completed_count;
+    }
+    summary.client_stats.request_byte_size =
+        end_stat.cumulative_request_byte_size -
+        start_stat.cumulative_request_byte_size;
+    summary.client_stats.uncompressed_request_byte_size =
+        end_stat.cumulative_uncompressed_request_byte_size -
+        start_stat.cumulative_uncompressed_request_byte_size;
+    summary.client_stats.response_byte_size =
+        end_stat.cumulative_response_byte_size -
+        start_stat.cumulative_response_byte_size;
+    summary.client_stats.uncompressed_response_byte_size =
+        end_stat.cumulative_uncompressed_response_byte_size -
+        start_stat.cumulative_uncompressed_response_byte_size;
+    size_t chunk_interval_count = end_stat.response_chunk_interval_count -
+                                  start_stat.response_chunk_interval_count;
+    summary.client_stats.response_chunk_interval_count = chunk_interval_count;
+    if (chunk_interval_count != 0) {
+      summary.client_stats.avg_response_chunk_interval_ns =
+          (end_stat.cumulative_response_chunk_interval_ns -
+           start_stat.cumulative_response_chunk_interval_ns) /
+          chunk_interval_count;
     }
   }
 
@@ -1590,6 +3142,211 @@ InferenceProfiler::AllMPIRanksAreStable(bool current_rank_stability)
   return all_stable;
 }
 
+cb::Error
+InferenceProfiler::AggregateRankWindows(
+    const cb::Error& err, PerfStatus& summary)
+{
+  const auto rank_windows =
+      distributed_load_->Allgather(PackRankWindow(err, summary));
+  if (!err.IsOk()) {
+    return err;
+  }
+  for (size_t rank = 0; rank < rank_windows.size(); rank++) {
+    if (rank_windows[rank][RANK_WINDOW_OK] == 0) {
+      return cb::Error(
+          "Measurement failed on MPI rank " + std::to_string(rank) + ".",
+          pa::GENERIC_ERROR);
+    }
+  }
+  return MergeRankWindows(rank_windows, summary);
+}
+
+std::vector<uint64_t>
+InferenceProfiler::PackRankWindow(
+    const cb::Error& err, const PerfStatus& summary) const
+{
+  const ClientSideStats& stats = summary.client_stats;
+  std::vector<uint64_t> window(RANK_WINDOW_HEADER_LEN, 0);
+  window[RANK_WINDOW_OK] = err.IsOk();
+  window[RANK_WINDOW_REQUEST_COUNT] = stats.request_count;
+  window[RANK_WINDOW_SEQUENCE_COUNT] = stats.sequence_count;
+  window[RANK_WINDOW_DELAYED_REQUEST_COUNT] = stats.delayed_request_count;
+  window[RANK_WINDOW_OUTLIER_COUNT] = stats.outlier_count;
+  window[RANK_WINDOW_MAX_OUTLIER_LATENCY_NS] = stats.max_outlier_latency_ns;
+  window[RANK_WINDOW_DURATION_NS] = stats.duration_ns;
+  window[RANK_WINDOW_COMPLETED_COUNT] = stats.completed_count;
+  window[RANK_WINDOW_REQUEST_TIME_NS] =
+      stats.avg_request_time_ns * stats.completed_count;
+  window[RANK_WINDOW_SEND_TIME_NS] =
+      stats.avg_send_time_ns * stats.completed_count;
+  window[RANK_WINDOW_RECEIVE_TIME_NS] =
+      stats.avg_receive_time_ns * stats.completed_count;
+  window[RANK_WINDOW_FIRST_BYTE_TIME_NS] =
+      stats.avg_first_byte_time_ns * stats.completed_count;
+  window[RANK_WINDOW_SERIALIZE_TIME_NS] =
+      stats.avg_serialize_time_ns * stats.completed_count;
+  window[RANK_WINDOW_SEND_QUEUE_TIME_NS] =
+      stats.avg_send_queue_time_ns * stats.completed_count;
+  window[RANK_WINDOW_DESERIALIZE_TIME_NS] =
+      stats.avg_deserialize_time_ns * stats.completed_count;
+  window[RANK_WINDOW_REQUEST_BYTES] = stats.request_byte_size;
+  window[RANK_WINDOW_UNCOMPRESSED_REQUEST_BYTES] =
+      stats.uncompressed_request_byte_size;
+  window[RANK_WINDOW_RESPONSE_BYTES] = stats.response_byte_size;
+  window[RANK_WINDOW_UNCOMPRESSED_RESPONSE_BYTES] =
+      stats.uncompressed_response_byte_size;
+  window[RANK_WINDOW_CHUNK_INTERVAL_COUNT] =
+      stats.response_chunk_interval_count;
+  window[RANK_WINDOW_CHUNK_INTERVAL_NS] =
+      stats.avg_response_chunk_interval_ns *
+      stats.response_chunk_interval_count;
+  window[RANK_WINDOW_RESPONSE_COUNT] = stats.response_count;
+  window[RANK_WINDOW_FIRST_RESPONSE_LATENCY_NS] =
+      stats.avg_first_response_latency_ns * stats.request_count;
+  window[RANK_WINDOW_RESPONSE_GAP_COUNT] = stats.response_gap_count;
+  window[RANK_WINDOW_RESPONSE_GAP_NS] =
+      stats.avg_response_gap_ns * stats.response_gap_count;
+  window[RANK_WINDOW_STAGE_REQUEST_COUNT] = stats.stage_times.request_count;
+  window[RANK_WINDOW_STAGE_DATA_PREP_NS] =
+      stats.stage_times.total_ns[CLIENT_STAGE_DATA_PREP];
+  window[RANK_WINDOW_STAGE_SEND_NS] =
+      stats.stage_times.total_ns[CLIENT_STAGE_SEND];
+  window[RANK_WINDOW_STAGE_CALLBACK_NS] =
+      stats.stage_times.total_ns[CLIENT_STAGE_CALLBACK];
+  window[RANK_WINDOW_STAGE_VALIDATION_NS] =
+      stats.stage_times.total_ns[CLIENT_STAGE_VALIDATION];
+  window[RANK_WINDOW_INFER_PER_SEC] = DoubleBits(stats.infer_per_sec);
+  window[RANK_WINDOW_SEQUENCE_PER_SEC] = DoubleBits(stats.sequence_per_sec);
+  window[RANK_WINDOW_SEND_REQUEST_RATE] = DoubleBits(summary.send_request_rate);
+  window[RANK_WINDOW_OVERHEAD_PCT] = DoubleBits(summary.overhead_pct);
+  window[RANK_WINDOW_CONVERGED] = summary.converged;
+
+  // A failed window may not have its histogram, but all the ranks must send
+  // the same number of values
+  const std::vector<uint64_t> latencies =
+      err.IsOk() ? stats.latency_histogram.Serialize()
+                 : LatencyHistogram().Serialize();
+  window.insert(window.end(), latencies.begin(), latencies.end());
+  return window;
+}
+
+cb::Error
+InferenceProfiler::MergeRankWindows(
+    const std::vector<std::vector<uint64_t>>& rank_windows,
+    PerfStatus& summary)
+{
+  ClientSideStats& stats = summary.client_stats;
+  stats.request_count = 0;
+  stats.sequence_count = 0;
+  stats.delayed_request_count = 0;
+  stats.outlier_count = 0;
+  stats.max_outlier_latency_ns = 0;
+  stats.duration_ns = 0;
+  stats.completed_count = 0;
+  stats.request_byte_size = 0;
+  stats.uncompressed_request_byte_size = 0;
+  stats.response_byte_size = 0;
+  stats.uncompressed_response_byte_size = 0;
+  stats.response_chunk_interval_count = 0;
+  stats.response_count = 0;
+  stats.response_gap_count = 0;
+  stats.stage_times = ClientStageTimes();
+  stats.infer_per_sec = 0;
+  stats.sequence_per_sec = 0;
+  stats.latency_histogram.Reset();
+  summary.send_request_rate = 0;
+  summary.overhead_pct = 0;
+  summary.converged = true;
+  uint64_t request_time_ns = 0;
+  uint64_t send_time_ns = 0;
+  uint64_t receive_time_ns = 0;
+  uint64_t first_byte_time_ns = 0;
+  uint64_t serialize_time_ns = 0;
+  uint64_t send_queue_time_ns = 0;
+  uint64_t deserialize_time_ns = 0;
+  uint64_t chunk_interval_ns = 0;
+  uint64_t first_response_latency_ns = 0;
+  uint64_t response_gap_ns = 0;
+
+  for (const auto& window : rank_windows) {
+    stats.request_count += window[RANK_WINDOW_REQUEST_COUNT];
+    stats.sequence_count += window[RANK_WINDOW_SEQUENCE_COUNT];
+    stats.delayed_request_count += window[RANK_WINDOW_DELAYED_REQUEST_COUNT];
+    stats.outlier_count += window[RANK_WINDOW_OUTLIER_COUNT];
+    stats.max_outlier_latency_ns = std::max(
+        stats.max_outlier_latency_ns,
+        window[RANK_WINDOW_MAX_OUTLIER_LATENCY_NS]);
+    stats.duration_ns =
+        std::max(stats.duration_ns, window[RANK_WINDOW_DURATION_NS]);
+    stats.completed_count += window[RANK_WINDOW_COMPLETED_COUNT];
+    request_time_ns += window[RANK_WINDOW_REQUEST_TIME_NS];
+    send_time_ns += window[RANK_WINDOW_SEND_TIME_NS];
+    receive_time_ns += window[RANK_WINDOW_RECEIVE_TIME_NS];
+    first_byte_time_ns += window[RANK_WINDOW_FIRST_BYTE_TIME_NS];
+    serialize_time_ns += window[RANK_WINDOW_SERIALIZE_TIME_NS];
+    send_queue_time_ns += window[RANK_WINDOW_SEND_QUEUE_TIME_NS];
+    deserialize_time_ns += window[RANK_WINDOW_DESERIALIZE_TIME_NS];
+    stats.request_byte_size += window[RANK_WINDOW_REQUEST_BYTES];
+    stats.uncompressed_request_byte_size +=
+        window[RANK_WINDOW_UNCOMPRESSED_REQUEST_BYTES];
+    stats.response_byte_size += window[RANK_WINDOW_RESPONSE_BYTES];
+    stats.uncompressed_response_byte_size +=
+        window[RANK_WINDOW_UNCOMPRESSED_RESPONSE_BYTES];
+    stats.response_chunk_interval_count +=
+        window[RANK_WINDOW_CHUNK_INTERVAL_COUNT];
+    chunk_interval_ns += window[RANK_WINDOW_CHUNK_INTERVAL_NS];
+    stats.response_count += window[RANK_WINDOW_RESPONSE_COUNT];
+    first_response_latency_ns += window[RANK_WINDOW_FIRST_RESPONSE_LATENCY_NS];
+    stats.response_gap_count += window[RANK_WINDOW_RESPONSE_GAP_COUNT];
+    response_gap_ns += window[RANK_WINDOW_RESPONSE_GAP_NS];
+    stats.stage_times.request_count += window[RANK_WINDOW_STAGE_REQUEST_COUNT];
+    stats.stage_times.total_ns[CLIENT_STAGE_DATA_PREP] +=
+        window[RANK_WINDOW_STAGE_DATA_PREP_NS];
+    stats.stage_times.total_ns[CLIENT_STAGE_SEND] +=
+        window[RANK_WINDOW_STAGE_SEND_NS];
+    stats.stage_times.total_ns[CLIENT_STAGE_CALLBACK] +=
+        window[RANK_WINDOW_STAGE_CALLBACK_NS];
+    stats.stage_times.total_ns[CLIENT_STAGE_VALIDATION] +=
+        window[RANK_WINDOW_STAGE_VALIDATION_NS];
+    // The windows are aligned, so the throughputs of the ranks add up
+    stats.infer_per_sec += BitsDouble(window[RANK_WINDOW_INFER_PER_SEC]);
+    stats.sequence_per_sec += BitsDouble(window[RANK_WINDOW_SEQUENCE_PER_SEC]);
+    summary.send_request_rate +=
+        BitsDouble(window[RANK_WINDOW_SEND_REQUEST_RATE]);
+    summary.overhead_pct = std::max(
+        summary.overhead_pct, BitsDouble(window[RANK_WINDOW_OVERHEAD_PCT]));
+    summary.converged &= (window[RANK_WINDOW_CONVERGED] != 0);
+    RETURN_IF_ERROR(stats.latency_histogram.MergeSerialized(
+        std::vector<uint64_t>(
+            window.begin() + RANK_WINDOW_HEADER_LEN, window.end())));
+  }
+
+  if (stats.completed_count != 0) {
+    stats.avg_request_time_ns = request_time_ns / stats.completed_count;
+    stats.avg_send_time_ns = send_time_ns / stats.completed_count;
+    stats.avg_receive_time_ns = receive_time_ns / stats.completed_count;
+    stats.avg_first_byte_time_ns = first_byte_time_ns / stats.completed_count;
+    stats.avg_serialize_time_ns = serialize_time_ns / stats.completed_count;
+    stats.avg_send_queue_time_ns = send_queue_time_ns / stats.completed_count;
+    stats.avg_deserialize_time_ns =
+        deserialize_time_ns / stats.completed_count;
+  }
+  if (stats.response_chunk_interval_count != 0) {
+    stats.avg_response_chunk_interval_ns =
+        chunk_interval_ns / stats.response_chunk_interval_count;
+  }
+  stats.avg_first_response_latency_ns =
+      (stats.request_count == 0)
+          ? 0
+          : first_response_latency_ns / stats.request_count;
+  stats.avg_response_gap_ns =
+      (stats.response_gap_count == 0)
+          ? 0
+          : response_gap_ns / stats.response_gap_count;
+
+  return SummarizeLatency(stats.latency_histogram, summary);
+}
+
 cb::Error
 InferenceProfiler::MergeMetrics(
     const std::vector<std::reference_wrapper<const Metrics>>& all_metrics,
@@ -1611,12 +3368,18 @@ InferenceProfiler::MergeMetrics(
   std::vector<std::reference_wrapper<const std::map<std::string, uint64_t>>>
       gpu_memory_total_bytes_per_gpu_maps{};
 
+  // Maps from each metric collection mapping samples to gauges and counters
+  std::vector<std::reference_wrapper<const std::map<std::string, double>>>
+      gauge_maps{};
+  std::vector<std::reference_wrapper<const std::map<std::string, double>>>
+      counter_maps{};
+
   // Put all metric maps in vector so they're easier to aggregate
   std::for_each(
       all_metrics.begin(), all_metrics.end(),
       [&gpu_utilization_per_gpu_maps, &gpu_power_usage_per_gpu_maps,
        &gpu_memory_used_bytes_per_gpu_maps,
-       &gpu_memory_total_bytes_per_gpu_maps](
+       &gpu_memory_total_bytes_per_gpu_maps, &gauge_maps, &counter_maps](
           const std::reference_wrapper<const Metrics> m) {
         gpu_utilization_per_gpu_maps.push_back(m.get().gpu_utilization_per_gpu);
         gpu_power_usage_per_gpu_maps.push_back(m.get().gpu_power_usage_per_gpu);
@@ -1624,6 +3387,8 @@ InferenceProfiler::MergeMetrics(
             m.get().gpu_memory_used_bytes_per_gpu);
         gpu_memory_total_bytes_per_gpu_maps.push_back(
             m.get().gpu_memory_total_bytes_per_gpu);
+        gauge_maps.push_back(m.get().gauges);
+        counter_maps.push_back(m.get().counters);
       });
 
   GetMetricAveragePerGPU<double>(
@@ -1636,6 +3401,8 @@ InferenceProfiler::MergeMetrics(
   GetMetricFirstPerGPU<uint64_t>(
       gpu_memory_total_bytes_per_gpu_maps,
       merged_metrics.gpu_memory_total_bytes_per_gpu);
+  GetMetricAveragePerGPU<double>(gauge_maps, merged_metrics.gauges);
+  GetMetricIncrease<double>(counter_maps, merged_metrics.counters);
 
   return cb::Error::Success;
 }
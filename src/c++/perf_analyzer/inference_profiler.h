@@ -31,24 +31,36 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <vector>
+#include "capacity_model.h"
+#include "client_stage_timer.h"
 #include "concurrency_manager.h"
 #include "constants.h"
 #include "custom_load_manager.h"
+#include "distributed_load.h"
+#include "latency_histogram.h"
 #include "metrics.h"
 #include "metrics_manager.h"
 #include "model_parser.h"
 #include "mpi_utils.h"
+#include "output_validator.h"
+#include "process_resources.h"
+#include "request_class.h"
 #include "request_rate_manager.h"
+#include "request_record_writer.h"
+#include "slow_request_tracker.h"
 
 namespace triton { namespace perfanalyzer {
 
 #ifndef DOCTEST_CONFIG_DISABLE
 class TestInferenceProfiler;
 #endif
+class SweepCheckpoint;
 
 /// Constant parameters that determine the whether stopping criteria has met
 /// for the current phase of testing
@@ -125,17 +137,89 @@ struct ClientSideStats {
   uint64_t sequence_count;
   // The number of requests that missed their schedule
   uint64_t delayed_request_count;
+  // The requests left out of the latency statistics for being far slower than
+  // the rest of their window, e.g. the first launch of a JIT compiled model,
+  // and the latency of the slowest of them. Still counted in the throughput.
+  uint64_t outlier_count{0};
+  uint64_t max_outlier_latency_ns{0};
   uint64_t duration_ns;
   uint64_t avg_latency_ns;
   // a ordered map of percentiles to be reported (<percentile, value> pair)
   std::map<size_t, uint64_t> percentile_latency_ns;
-  // List of all the valid latencies.
-  std::vector<uint64_t> latencies;
+  // Histogram of all the valid latencies. Uses constant memory regardless of
+  // the number of requests.
+  LatencyHistogram latency_histogram;
+  // Histogram of how late requests were sent compared to their schedule, in
+  // nanoseconds. Empty when the load is not schedule driven.
+  LatencyHistogram schedule_error_histogram;
+  // The requests dropped for being over the cap of requests in flight, and
+  // how long the queued ones waited for a slot, in nanoseconds. Only
+  // recorded with --max-inflight-requests.
+  uint64_t dropped_request_count{0};
+  LatencyHistogram queue_delay_histogram;
+  // How the outputs compared with the expected outputs of the input data.
+  // Empty without expected outputs.
+  ValidationStats validation_stats;
+  // Histogram of the latencies measured from when the schedule meant to send
+  // the requests, which also counts the time a late request waited to be
+  // sent, in nanoseconds. Empty when the load is not schedule driven.
+  LatencyHistogram corrected_latency_histogram;
+  // Histograms of the time the requests spent queued and computing their
+  // inputs, inference and outputs on the server, in nanoseconds, from the
+  // timestamps that the server traced for each of them. Only recorded with
+  // --server-request-trace.
+  LatencyHistogram server_queue_histogram;
+  LatencyHistogram server_compute_input_histogram;
+  LatencyHistogram server_compute_infer_histogram;
+  LatencyHistogram server_compute_output_histogram;
+  // Histograms of the latencies by data stream or input shape, when broken
+  // down. Only holds the requests of the local MPI rank.
+  std::map<std::string, LatencyHistogram> bucket_latency_histograms;
+  // The latencies and timeout rejections of each request class, by name,
+  // when the requests are spread over request classes. Only holds the
+  // requests of the local MPI rank.
+  std::map<std::string, RequestClassStats> request_class_stats;
+  // The latencies of the requests to each endpoint, by url, when the
+  // requests are spread over endpoints. Only holds the requests of the local
+  // MPI rank.
+  std::map<std::string, LatencyHistogram> endpoint_latency_histograms;
+  // The slowest requests, with what identifies them. Only kept with
+  // --slowest-requests and only holds the requests of the local MPI rank.
+  SlowRequestTracker slow_requests;
   // Using usec to avoid square of large number (large in nsec)
   uint64_t std_us;
   uint64_t avg_request_time_ns;
   uint64_t avg_send_time_ns;
   uint64_t avg_receive_time_ns;
+  // Time from the request start to the first byte of the response, and the
+  // latency between the events of streamed responses. Only measured by the
+  // HTTP JSON backend.
+  uint64_t avg_first_byte_time_ns{0};
+  // The phases of the client library: building the request, waiting for the
+  // transport to start sending it, and parsing the response. Only measured
+  // by the Triton backend.
+  uint64_t avg_serialize_time_ns{0};
+  uint64_t avg_send_queue_time_ns{0};
+  uint64_t avg_deserialize_time_ns{0};
+  // The bytes of the request and response bodies of the completed requests,
+  // as sent on the wire and before compression. Only counted by the Triton
+  // backend.
+  uint64_t request_byte_size{0};
+  uint64_t uncompressed_request_byte_size{0};
+  uint64_t response_byte_size{0};
+  uint64_t uncompressed_response_byte_size{0};
+  uint64_t response_chunk_interval_count{0};
+  uint64_t avg_response_chunk_interval_ns{0};
+  // The responses received by the requests of a decoupled model, the time
+  // from the request start to the first response, and the latency between
+  // consecutive responses. Only measured for decoupled models.
+  uint64_t response_count{0};
+  uint64_t avg_first_response_latency_ns{0};
+  uint64_t response_gap_count{0};
+  uint64_t avg_response_gap_ns{0};
+  // The time spent in each client stage of the requests sent. Only measured
+  // with --client-stage-times.
+  ClientStageTimes stage_times;
   // Per sec stat
   double infer_per_sec;
   double sequence_per_sec;
@@ -145,24 +229,125 @@ struct ClientSideStats {
 };
 
 /// The entire statistics record.
+/// The wall clock that the measurement windows follow. Windows can start and
+/// end on fixed boundaries of that clock, so that separate perf_analyzer
+/// instances measure over the same spans of time, and the clock can be the one
+/// of MPI rank 0 rather than the local one.
+struct WindowClock {
+  /// The spacing of the window boundaries in nsec, 0 to not align windows.
+  uint64_t alignment_ns{0};
+  /// A boundary in nsec since the epoch on the reference clock. The
+  /// boundaries before it are not used.
+  uint64_t origin_ns{0};
+  /// How far the local clock runs ahead of the reference clock in nsec.
+  int64_t offset_ns{0};
+
+  bool IsAligned() const { return alignment_ns != 0; }
+
+  /// \return The local time of the first boundary at or after the local time
+  /// 'local_ns'.
+  uint64_t NextBoundaryNs(uint64_t local_ns) const;
+
+  /// \return The 'duration_ns' rounded up to a whole number of boundaries.
+  uint64_t AlignedDurationNs(uint64_t duration_ns) const;
+
+  uint64_t ToLocalNs(uint64_t reference_ns) const
+  {
+    return reference_ns + offset_ns;
+  }
+  uint64_t ToReferenceNs(uint64_t local_ns) const
+  {
+    return local_ns - offset_ns;
+  }
+};
+
+/// How the start-up costs of each load level are kept out of its
+/// measurements.
+struct WarmupOptions {
+  /// The number of requests to let complete after each change of load level
+  /// before measuring.
+  uint64_t request_count{0};
+  /// Requests slower than this multiple of the median latency of their
+  /// window are outliers, 0 to keep all the requests.
+  double outlier_factor{0.0};
+};
+
 struct PerfStatus {
-  uint32_t concurrency;
-  double request_rate;
-  size_t batch_size;
+  uint32_t concurrency{0};
+  double request_rate{0.0};
+  size_t batch_size{0};
   ServerSideStats server_stats;
+  // The server side statistics of each endpoint, by url, when the requests
+  // are spread over endpoints. server_stats is then their sum.
+  std::map<std::string, ServerSideStats> endpoint_server_stats{};
   ClientSideStats client_stats;
   std::vector<Metrics> metrics{};
+  MetricsCorrelation metrics_correlation{};
   double overhead_pct;
   bool on_sequence_model;
 
   // placeholder for the latency value that is used for conditional checking
   uint64_t stabilizing_latency_ns;
+  // Whether the measurement alone pins down throughput and latency within the
+  // stability threshold
+  bool converged{false};
   // Metric for requests sent per second
   double send_request_rate{0.0};
+  // The span of the measurement in nsec since the epoch on the reference
+  // clock of the windows
+  uint64_t window_start_ns{0};
+  uint64_t window_end_ns{0};
+  // The throughput of each measurement window merged into this status
+  std::vector<double> window_infer_per_sec{};
+  // The resources used by this perf_analyzer process during the measurement
+  ClientResourceStats client_resources{};
 };
 
 cb::Error ReportPrometheusMetrics(const Metrics& metrics);
 
+/// \param byte_size The bytes transferred.
+/// \param duration_ns The time they were transferred over in nsec.
+/// \return The bandwidth in MB/s, 0 for an empty duration.
+double BandwidthMBPerSec(const uint64_t byte_size, const uint64_t duration_ns);
+
+/// \param uncompressed_byte_size The bytes before compression.
+/// \param byte_size The bytes after compression.
+/// \return How many times compression shrank the bytes, 1 without bytes.
+double CompressionRatio(
+    const uint64_t uncompressed_byte_size, const uint64_t byte_size);
+
+/// Finds the chain of steps of an ensemble that takes the longest, following
+/// each tensor from the step producing it to the steps consuming it. A step
+/// takes the average server side request latency of its composing model.
+/// \param steps The steps of the ensemble.
+/// \param stats The server side stats of the composing models.
+/// \param latency_ns Returns the latency of the chain in nsec.
+/// \return The composing models along the chain, in order.
+std::vector<cb::ModelIdentifier> EnsembleCriticalPath(
+    const std::vector<EnsembleStep>& steps,
+    const std::map<cb::ModelIdentifier, ServerSideStats>& stats,
+    uint64_t* latency_ns);
+
+/// Fills the throughput per watt, the memory headroom and the memory trend
+/// of a measurement from its timestamped metrics. Leaves the tail
+/// utilization untouched.
+/// \param metrics The metrics scraped during the measurement.
+/// \param infer_per_sec The throughput of the measurement.
+/// \param correlation Returns the correlation.
+void CorrelateMetrics(
+    const std::vector<std::reference_wrapper<const Metrics>>& metrics,
+    const double infer_per_sec, MetricsCorrelation* correlation);
+
+/// Averages the utilization of the GPUs in the metrics scraped closest to
+/// each of the given times.
+/// \param metrics The metrics of a measurement, in the order of scraping.
+/// \param times_ns The times in nsec since the epoch of the system clock.
+/// \param utilization Returns the average utilization.
+/// \return The number of times averaged over, 0 without metrics.
+uint64_t GpuUtilizationAt(
+    const std::vector<Metrics>& metrics, const std::vector<uint64_t>& times_ns,
+    double* utilization);
+
 //==============================================================================
 /// A InferenceProfiler is a helper class that measures and summarizes the
 /// inference statistic under different concurrency level.
@@ -216,6 +401,23 @@ class InferenceProfiler {
   /// should be collected.
   /// \param overhead_pct_threshold User set threshold above which the PA
   /// overhead is too significant to provide useable results.
+  /// \param early_convergence Whether a single measurement can be accepted as
+  /// stable once its sub-window samples converge.
+  /// \param settle_window_ms The time in msec to let the load settle after
+  /// each change of load level. Requests completing in it are not measured.
+  /// \param warmup The requests to let complete after the settle window, and
+  /// which requests are left out of the latency statistics as outliers.
+  /// \param distributed_load If not null, the MPI ranks share the load and
+  /// every measurement window covers all of them.
+  /// \param window_clock The clock the measurement windows follow.
+  /// \param request_record_writer If not null, the records of all the
+  /// completed requests are written to it.
+  /// \param checkpoint If not null, the results of each load level are kept
+  /// in it as the level completes, and the levels it already completed are
+  /// taken from it rather than measured.
+  /// \param endpoint_backends The backend to each endpoint by url, if the
+  /// requests are spread over endpoints. The server side statistics are then
+  /// fetched from every endpoint and summed.
   /// \return cb::Error object indicating success or failure.
   static cb::Error Create(
       const bool verbose, const double stability_threshold,
@@ -227,7 +429,15 @@ class InferenceProfiler {
       std::unique_ptr<InferenceProfiler>* profiler,
       uint64_t measurement_request_count, MeasurementMode measurement_mode,
       std::shared_ptr<MPIDriver> mpi_driver, const uint64_t metrics_interval_ms,
-      const bool should_collect_metrics, const double overhead_pct_threshold);
+      const bool should_collect_metrics, const double overhead_pct_threshold,
+      const bool early_convergence, const uint64_t settle_window_ms,
+      const WarmupOptions& warmup,
+      std::shared_ptr<DistributedLoad> distributed_load,
+      const WindowClock& window_clock,
+      std::shared_ptr<RequestRecordWriter> request_record_writer,
+      std::shared_ptr<SweepCheckpoint> checkpoint,
+      const std::map<std::string, std::shared_ptr<cb::ClientBackend>>&
+          endpoint_backends);
 
   /// Performs the profiling on the given range with the given search algorithm.
   /// For profiling using request rate invoke template with double, otherwise
@@ -235,7 +445,7 @@ class InferenceProfiler {
   /// \param start The starting point of the search range.
   /// \param end The ending point of the search range.
   /// \param step The step size to move along the search range in linear search
-  /// or the precision in binary search.
+  /// or the precision in binary and adaptive search.
   /// \param search_mode The search algorithm to be applied.
   /// \param summary Returns the trace of the measurement along the search
   /// path.
@@ -268,6 +478,10 @@ class InferenceProfiler {
         return cb::Error(
             "Failed to obtain stable measurement.", pa::STABILITY_ERROR);
       }
+    } else if (search_mode == SearchMode::ADAPTIVE) {
+      return AdaptiveSearch(start, end, step, perf_statuses);
+    } else if (search_mode == SearchMode::CAPACITY) {
+      return CapacitySearch(start, end, step, perf_statuses);
     } else {
       err = Profile(start, perf_statuses, meets_threshold, is_stable);
       if (!err.IsOk() || (!meets_threshold)) {
@@ -298,7 +512,168 @@ class InferenceProfiler {
 
   bool IncludeServerStats() { return include_server_stats_; }
 
+  /// \return The load manager that generates the load.
+  const LoadManager& GetLoadManager() const { return *manager_; }
+
  private:
+  /// Searches for the highest load that still meets the latency threshold.
+  /// The load first grows along the latency gradient of the last two
+  /// measurements, at most doubling per step, until the threshold is crossed,
+  /// and the crossing is then bisected down to 'step'. All the measurements
+  /// reuse the same load manager, so the workers created for one load level
+  /// stay warm for the next one.
+  /// \param start The load to start the search from.
+  /// \param end The highest load to try, or NO_LIMIT for no upper bound.
+  /// \param step The precision of the search.
+  /// \param perf_statuses Returns the trace of the measurement along the search
+  /// path.
+  /// \return cb::Error object indicating success or failure.
+  template <typename T>
+  cb::Error AdaptiveSearch(
+      const T start, const T end, const T step,
+      std::vector<PerfStatus>& perf_statuses)
+  {
+    bool meets_threshold, is_stable;
+    RETURN_IF_ERROR(Profile(start, perf_statuses, meets_threshold, is_stable));
+    if (!meets_threshold) {
+      return cb::Error::Success;
+    }
+
+    const uint64_t target_latency_ns = latency_threshold_ms_ * NANOS_PER_MILLIS;
+    T lower = start;
+    uint64_t lower_latency_ns = perf_statuses.back().stabilizing_latency_ns;
+    T previous = start;
+    uint64_t previous_latency_ns = lower_latency_ns;
+    T upper;
+    do {
+      if ((end != static_cast<T>(NO_LIMIT)) && (lower >= end)) {
+        return cb::Error::Success;
+      }
+      upper = NextAdaptiveSearchValue(
+          lower, lower_latency_ns, previous, previous_latency_ns, step, end,
+          target_latency_ns);
+      RETURN_IF_ERROR(
+          Profile(upper, perf_statuses, meets_threshold, is_stable));
+      if (meets_threshold) {
+        previous = lower;
+        previous_latency_ns = lower_latency_ns;
+        lower = upper;
+        lower_latency_ns = perf_statuses.back().stabilizing_latency_ns;
+      }
+    } while (meets_threshold);
+
+    while ((upper - lower) > step) {
+      T current = (upper + lower) / 2;
+      RETURN_IF_ERROR(
+          Profile(current, perf_statuses, meets_threshold, is_stable));
+      if (meets_threshold) {
+        lower = current;
+      } else {
+        upper = current;
+      }
+    }
+    return cb::Error::Success;
+  }
+
+  /// Measures the few load levels that pin down the capacity of the server.
+  /// A queueing model is fitted to the load levels measured so far, see
+  /// CapacityModel, and the next load level is picked from it with
+  /// NextCapacitySearchLoad(). The search stops once the saturation
+  /// throughput of three load levels or more moves by less than 5%, once a
+  /// request rate is more than the server keeps up with, or once the latency
+  /// threshold is crossed.
+  /// \param start The load to start the search from.
+  /// \param end The highest load to try, or NO_LIMIT for no upper bound.
+  /// \param step The smallest increase of the load.
+  /// \param perf_statuses Returns the trace of the measurement along the search
+  /// path.
+  /// \return cb::Error object indicating success or failure.
+  template <typename T>
+  cb::Error CapacitySearch(
+      const T start, const T end, const T step,
+      std::vector<PerfStatus>& perf_statuses)
+  {
+    // The most load levels the search measures
+    constexpr size_t kMaxLevels = 12;
+    const bool closed = std::is_same<T, size_t>::value;
+    bool meets_threshold, is_stable;
+    RETURN_IF_ERROR(Profile(start, perf_statuses, meets_threshold, is_stable));
+    T highest = start;
+    double previous_saturation = 0.0;
+    std::vector<CapacitySample> samples{
+        ToCapacitySample(perf_statuses.back(), closed)};
+    while (meets_threshold && (samples.size() < kMaxLevels)) {
+      if (!closed &&
+          (samples.back().throughput < 0.95 * samples.back().load)) {
+        break;
+      }
+      T next = std::max(static_cast<T>(highest + step), highest * 2);
+      CapacityModel model;
+      if (CapacityModel::Fit(samples, closed, &model).IsOk()) {
+        const double saturation = model.SaturationThroughput();
+        if ((samples.size() >= 3) &&
+            (std::abs(saturation - previous_saturation) <
+             0.05 * previous_saturation)) {
+          break;
+        }
+        previous_saturation = saturation;
+        next = static_cast<T>(NextCapacitySearchLoad(
+            model, static_cast<double>(highest), static_cast<double>(step),
+            static_cast<double>(end)));
+      } else if (end != static_cast<T>(NO_LIMIT)) {
+        next = std::min(next, end);
+      }
+      if (next <= highest) {
+        break;
+      }
+      RETURN_IF_ERROR(Profile(next, perf_statuses, meets_threshold, is_stable));
+      highest = next;
+      samples.push_back(ToCapacitySample(perf_statuses.back(), closed));
+    }
+    return cb::Error::Success;
+  }
+
+  /// Picks the next load to try while the adaptive search is still below the
+  /// latency threshold. The latency is extrapolated linearly from the last two
+  /// measurements to where it reaches the target, and the result is kept
+  /// between one step and double the current load.
+  /// \param current The highest load measured so far.
+  /// \param current_latency_ns The latency measured at 'current'.
+  /// \param previous The load measured before 'current', or 'current' itself
+  /// if there is none.
+  /// \param previous_latency_ns The latency measured at 'previous'.
+  /// \param step The smallest increase of the load.
+  /// \param end The highest load to try, or NO_LIMIT for no upper bound.
+  /// \param target_latency_ns The latency threshold.
+  /// \return The next load to measure.
+  template <typename T>
+  static T NextAdaptiveSearchValue(
+      const T current, const uint64_t current_latency_ns, const T previous,
+      const uint64_t previous_latency_ns, const T step, const T end,
+      const uint64_t target_latency_ns)
+  {
+    const double min_next = static_cast<double>(current + step);
+    const double max_next =
+        std::max(2.0 * static_cast<double>(current), min_next);
+    double next = max_next;
+    if ((current > previous) && (current_latency_ns > previous_latency_ns) &&
+        (target_latency_ns > current_latency_ns)) {
+      const double slope =
+          static_cast<double>(current_latency_ns - previous_latency_ns) /
+          static_cast<double>(current - previous);
+      next = static_cast<double>(current) +
+             static_cast<double>(target_latency_ns - current_latency_ns) /
+                 slope;
+      next = std::min(std::max(next, min_next), max_next);
+    }
+
+    T next_value = static_cast<T>(next);
+    if (end != static_cast<T>(NO_LIMIT)) {
+      next_value = std::min(next_value, end);
+    }
+    return next_value;
+  }
+
   InferenceProfiler(
       const bool verbose, const double stability_threshold,
       const int32_t measurement_window_ms, const size_t max_trials,
@@ -309,7 +684,14 @@ class InferenceProfiler {
       std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
       MeasurementMode measurement_mode, std::shared_ptr<MPIDriver> mpi_driver,
       const uint64_t metrics_interval_ms, const bool should_collect_metrics,
-      const double overhead_pct_threshold);
+      const double overhead_pct_threshold, const bool early_convergence,
+      const uint64_t settle_window_ms, const WarmupOptions& warmup,
+      std::shared_ptr<DistributedLoad> distributed_load,
+      const WindowClock& window_clock,
+      std::shared_ptr<RequestRecordWriter> request_record_writer,
+      std::shared_ptr<SweepCheckpoint> checkpoint,
+      const std::map<std::string, std::shared_ptr<cb::ClientBackend>>&
+          endpoint_backends);
 
   /// Actively measure throughput in every 'measurement_window' msec until the
   /// throughput is stable. Once the throughput is stable, it adds the
@@ -359,6 +741,15 @@ class InferenceProfiler {
   /// \return cb::Error object indicating success or failure.
   cb::Error ProfileHelper(PerfStatus& status_summary, bool* is_stable);
 
+  /// Discards the requests completed so far, after writing their records.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error DiscardCompletedRequests();
+
+  /// Waits until the warmup requests of a new load level have completed, and
+  /// discards them.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error WaitForWarmup();
+
   /// A helper function to determine if profiling is stable
   /// \param load_status Stores the observations of infer_per_sec and latencies
   /// \return Returns if the threshold and latencies are stable.
@@ -409,15 +800,61 @@ class InferenceProfiler {
       PerfStatus& status_summary, uint64_t measurement_window,
       bool is_count_based);
 
-  /// Gets the server side statistics
+  /// \return Whether the latency of the current load level is checked
+  /// against the latency threshold while it is measured.
+  bool WatchingLatency() const;
+
+  /// Adds the latencies completed since the last call to those of the
+  /// current load level, and records in breached_latency_ns_ when the level
+  /// is clearly over the latency threshold.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error WatchLatency();
+
+  /// Checks whether the latencies leave no doubt that the stabilizing
+  /// latency is over the latency threshold. For a percentile, the number of
+  /// requests over the threshold must exceed what the percentile allows by
+  /// several standard deviations of a binomial count. For the average, the
+  /// lower end of its confidence interval must be over the threshold.
+  /// \param latencies The latencies of the requests in nanoseconds.
+  /// \param latency_ns Returns the estimated stabilizing latency if over.
+  /// \return Whether the latency is over the threshold.
+  bool IsLatencyOverThreshold(
+      const LatencyHistogram& latencies, uint64_t* latency_ns) const;
+
+  /// Gets the server side statistics, summed over the endpoints if the
+  /// requests are spread over endpoints
   /// \param model_status Returns the status of the models provided by
   /// the server. If the model being profiled is non-ensemble model,
   /// only its status will be returned. Otherwise, the status of the composing
   /// models will also be returned.
+  /// \param endpoint_status Returns the status of the models provided by
+  /// each endpoint, by url. Left empty without endpoints.
   /// \return cb::Error object indicating success or failure.
   cb::Error GetServerSideStatus(
+      std::map<cb::ModelIdentifier, cb::ModelStatistics>* model_status,
+      std::map<
+          std::string, std::map<cb::ModelIdentifier, cb::ModelStatistics>>*
+          endpoint_status);
+
+  /// Gets the server side statistics from one server
+  /// \param backend The backend to the server.
+  /// \param model_status Returns the status of the models provided by
+  /// the server, as GetServerSideStatus() does.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetBackendServerSideStatus(
+      cb::ClientBackend* backend,
       std::map<cb::ModelIdentifier, cb::ModelStatistics>* model_status);
 
+  /// Collects the models whose statistics are needed to profile a model
+  /// \param model_identifier The model being profiled.
+  /// \param composing_models The composing models of the ensembles.
+  /// \param models Returns the model and, recursively, its composing models
+  /// with each model listed once.
+  static void CollectStatisticsModels(
+      const cb::ModelIdentifier& model_identifier,
+      const ComposingModelMap& composing_models,
+      std::vector<cb::ModelIdentifier>* models);
+
   /// Sumarize the measurement with the provided statistics.
   /// \param start_status The model status at the start of the measurement.
   /// \param end_status The model status at the end of the measurement.
@@ -438,18 +875,60 @@ class InferenceProfiler {
   /// during the measurement. A sequence is a set of correlated requests sent to
   /// sequence model.
   /// \param latencies Returns the vector of request latencies where the
-  /// requests are completed within the measurement window.
+  /// requests are completed within the measurement window. The latencies are
+  /// in the order the requests were recorded, not sorted.
+  /// \param end_times_ns If not null, returns the completion time of each
+  /// request in 'latencies'.
+  /// \param response_stats If not null, returns the statistics of the
+  /// responses of the requests in 'latencies'.
   void ValidLatencyMeasurement(
       const std::pair<uint64_t, uint64_t>& valid_range,
       size_t& valid_sequence_count, size_t& delayed_request_count,
-      std::vector<uint64_t>* latencies);
+      std::vector<uint64_t>* latencies,
+      std::vector<uint64_t>* end_times_ns = nullptr,
+      ClientSideStats* response_stats = nullptr);
+
+  /// Checks whether a single measurement window pins down throughput and
+  /// latency. The window is split into sub-windows, and the confidence
+  /// intervals of the mean throughput and of the mean stabilizing latency
+  /// across them must both be narrower than the stability threshold.
+  /// \param latencies The latencies of the requests completed in the window.
+  /// \param end_times_ns The completion time of each request in 'latencies'.
+  /// \param window_start_ns The start time of the window.
+  /// \param window_end_ns The end time of the window.
+  /// \return Whether the measurement has converged.
+  bool IsWindowConverged(
+      const std::vector<uint64_t>& latencies,
+      const std::vector<uint64_t>& end_times_ns, uint64_t window_start_ns,
+      uint64_t window_end_ns);
+
+  /// Removes the requests slower than the outlier factor times the median
+  /// latency of the window. The remaining latencies keep their order.
+  /// \param latencies The latencies of the requests completed in the window.
+  /// \param end_times_ns If not null, the completion time of each request in
+  /// 'latencies', which is trimmed along with them.
+  /// \param stats Returns the number of outliers and the slowest of them.
+  void TrimLatencyOutliers(
+      std::vector<uint64_t>& latencies, std::vector<uint64_t>* end_times_ns,
+      ClientSideStats& stats);
+
+  /// \param latencies The vector of request latencies collected. The order
+  /// of the elements is changed while selecting the percentiles.
+  /// \param summary Returns the summary that the latency related fields are
+  /// set.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error SummarizeLatency(
+      std::vector<uint64_t>& latencies, PerfStatus& summary);
 
-  /// \param latencies The vector of request latencies collected.
+  /// \param latencies The histogram of request latencies collected.
   /// \param summary Returns the summary that the latency related fields are
   /// set.
   /// \return cb::Error object indicating success or failure.
   cb::Error SummarizeLatency(
-      const std::vector<uint64_t>& latencies, PerfStatus& summary);
+      const LatencyHistogram& latencies, PerfStatus& summary);
+
+  /// \return The percentiles that are reported in the summary.
+  std::set<size_t> ReportedPercentiles() const;
 
   /// \param latencies The vector of request latencies collected.
   /// \return std::tuple object containing:
@@ -536,6 +1015,32 @@ class InferenceProfiler {
   /// \return True if all MPI ranks are stable.
   bool AllMPIRanksAreStable(bool current_rank_stability);
 
+  /// Replaces the client side summary of a measurement window by the one of
+  /// all the ranks of the distributed load together, so that all the ranks
+  /// take the same stability decisions and report the same results.
+  /// Collective.
+  /// \param err The outcome of the measurement on this rank.
+  /// \param summary The summary of this rank, replaced by the merged one.
+  /// \return cb::Error object indicating success or failure. Fails on all the
+  /// ranks if the measurement failed on any of them.
+  cb::Error AggregateRankWindows(const cb::Error& err, PerfStatus& summary);
+
+  /// \return The client side summary of a measurement window, and whether it
+  /// succeeded, as a flat vector whose length only depends on the
+  /// configuration of the latency histogram.
+  std::vector<uint64_t> PackRankWindow(
+      const cb::Error& err, const PerfStatus& summary) const;
+
+  /// Merges the windows packed by PackRankWindow() on all the ranks.
+  /// Throughputs and counts add up and latencies are summarized from the
+  /// merged histogram.
+  /// \param rank_windows The packed window of each rank.
+  /// \param summary Returns the merged summary.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error MergeRankWindows(
+      const std::vector<std::vector<uint64_t>>& rank_windows,
+      PerfStatus& summary);
+
   /// Merge individual perf status reports into a single perf status.  This
   /// function is used to merge the results from multiple Measure runs into a
   /// single report.
@@ -617,6 +1122,33 @@ class InferenceProfiler {
     }
   }
 
+  /// Gets the increase of counters over time ordered samples. A counter that
+  /// goes down was reset, and counts again from 0.
+  template <typename T>
+  void GetMetricIncrease(
+      const std::vector<std::reference_wrapper<const std::map<std::string, T>>>&
+          input_metric_maps,
+      std::map<std::string, T>& output_metric_map)
+  {
+    std::map<std::string, T> previous_metric_map{};
+    for (const auto& input_metric_map : input_metric_maps) {
+      for (const auto& input_metric : input_metric_map.get()) {
+        const auto& key{input_metric.first};
+        const auto& metric{input_metric.second};
+
+        auto previous{previous_metric_map.find(key)};
+        if (previous == previous_metric_map.end()) {
+          output_metric_map[key] = 0;
+          previous_metric_map[key] = metric;
+          continue;
+        }
+        output_metric_map[key] +=
+            (metric >= previous->second) ? (metric - previous->second) : metric;
+        previous->second = metric;
+      }
+    }
+  }
+
   template <typename T>
   void GetMetricFirstPerGPU(
       const std::vector<std::reference_wrapper<const std::map<std::string, T>>>&
@@ -655,6 +1187,8 @@ class InferenceProfiler {
 
   bool include_lib_stats_;
   bool include_server_stats_;
+  // Whether the backend reports the server timings of each request
+  bool include_server_request_timings_{false};
   std::shared_ptr<MPIDriver> mpi_driver_;
 
   /// The timestamps of the requests completed during all measurements
@@ -666,9 +1200,35 @@ class InferenceProfiler {
   /// Server side statistics from the previous measurement window
   std::map<cb::ModelIdentifier, cb::ModelStatistics> prev_server_side_stats_;
 
+  /// Server side statistics of the current measurement window. It is swapped
+  /// with the previous statistics at the end of each window so that the
+  /// entries of both are updated in place rather than rebuilt.
+  std::map<cb::ModelIdentifier, cb::ModelStatistics> next_server_side_stats_;
+
+  /// The backend to each endpoint by url, if the requests are spread over
+  /// endpoints.
+  std::map<std::string, std::shared_ptr<cb::ClientBackend>> endpoint_backends_;
+
+  /// The server side statistics of each endpoint from the previous and the
+  /// current measurement window, swapped like those above.
+  std::map<std::string, std::map<cb::ModelIdentifier, cb::ModelStatistics>>
+      prev_endpoint_server_stats_;
+  std::map<std::string, std::map<cb::ModelIdentifier, cb::ModelStatistics>>
+      next_endpoint_server_stats_;
+
+  /// The models whose server side statistics are fetched for an ensemble
+  std::vector<cb::ModelIdentifier> statistics_models_;
+
+  /// The per model server side statistics of an ensemble
+  std::vector<std::map<cb::ModelIdentifier, cb::ModelStatistics>>
+      statistics_models_stats_;
+
   /// Client side statistics from the previous measurement window
   cb::InferStat prev_client_side_stats_;
 
+  /// The resources used by the process at the end of the previous window
+  ProcessResourceSample prev_resource_sample_;
+
   /// Metrics manager that collects server-side metrics periodically
   std::shared_ptr<MetricsManager> metrics_manager_{nullptr};
 
@@ -679,6 +1239,38 @@ class InferenceProfiler {
   /// provide useable results.
   const double overhead_pct_threshold_{0.0};
 
+  /// Whether a single converged measurement is accepted as stable.
+  bool early_convergence_{false};
+
+  /// The time to let the load settle before measuring a new load level.
+  uint64_t settle_window_ms_{0};
+
+  /// The warmup requests of each load level and the outlier detection.
+  WarmupOptions warmup_;
+
+  /// The share of the MPI ranks in the load, if distributed.
+  std::shared_ptr<DistributedLoad> distributed_load_{nullptr};
+
+  /// The clock the measurement windows follow.
+  WindowClock window_clock_;
+
+  /// Writes the records of the completed requests, if not null.
+  std::shared_ptr<RequestRecordWriter> request_record_writer_{nullptr};
+
+  /// The concurrency or request rate being profiled, for the records.
+  double record_load_level_{0.0};
+
+  /// Keeps the results of the completed load levels, if not null.
+  std::shared_ptr<SweepCheckpoint> checkpoint_{nullptr};
+
+  /// The latencies of the current load level checked against the latency
+  /// threshold so far.
+  LatencyHistogram level_latencies_;
+
+  /// The estimated stabilizing latency once the current load level is known
+  /// to be over the latency threshold, 0 otherwise.
+  uint64_t breached_latency_ns_{0};
+
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestInferenceProfiler;
 
@@ -0,0 +1,76 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Caps the number of requests in flight across all the worker threads,
+/// like the admission control of a gateway in front of the server. What
+/// happens to a request over the cap is up to the caller, which drops or
+/// queues it according to Overload().
+///
+/// Acquiring and releasing a slot are one atomic add each, so the requests
+/// under the cap are not slowed down.
+///
+class InflightLimiter {
+ public:
+  /// \param max_inflight The maximum number of requests in flight.
+  /// \param overload What to do with a request over the cap.
+  InflightLimiter(size_t max_inflight, InflightOverload overload)
+      : max_inflight_(max_inflight), overload_(overload)
+  {
+  }
+
+  /// Takes a slot for a request about to be sent.
+  /// \return Whether a slot was free. Nothing is taken otherwise.
+  bool TryAcquire()
+  {
+    if (inflight_.fetch_add(1, std::memory_order_acq_rel) < max_inflight_) {
+      return true;
+    }
+    inflight_.fetch_sub(1, std::memory_order_acq_rel);
+    return false;
+  }
+
+  /// Frees the slot of a request that completed or failed to be sent.
+  void Release() { inflight_.fetch_sub(1, std::memory_order_acq_rel); }
+
+  /// \return The number of slots taken.
+  size_t Inflight() const { return inflight_.load(std::memory_order_relaxed); }
+
+  InflightOverload Overload() const { return overload_; }
+
+ private:
+  const size_t max_inflight_;
+  const InflightOverload overload_;
+  alignas(64) std::atomic<size_t> inflight_{0};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,335 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "input_corpus.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+constexpr char kCorpusMagic[8] = {'P', 'A', 'C', 'O', 'R', 'P', 'U', 'S'};
+constexpr uint32_t kCorpusVersion = 1;
+
+constexpr uint32_t kEntryPresent = 1;
+constexpr uint32_t kEntryHasShape = 2;
+
+struct CorpusHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t tensor_count;
+  uint64_t stream_count;
+  uint64_t step_count;
+};
+
+uint64_t
+AlignUp(uint64_t offset)
+{
+  return (offset + 7) & ~uint64_t(7);
+}
+
+void
+WriteBytes(std::ofstream& out, const void* data, size_t size, uint64_t* pos)
+{
+  out.write(reinterpret_cast<const char*>(data), size);
+  *pos += size;
+}
+
+void
+WritePadding(std::ofstream& out, uint64_t* pos)
+{
+  static const char kZeros[8] = {};
+  WriteBytes(out, kZeros, AlignUp(*pos) - *pos, pos);
+}
+
+}  // namespace
+
+bool
+InputCorpus::IsCorpusFile(const std::string& path)
+{
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(kCorpusMagic)];
+  if (!in.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return std::memcmp(magic, kCorpusMagic, sizeof(magic)) == 0;
+}
+
+cb::Error
+InputCorpus::Open(
+    const std::string& path, std::shared_ptr<InputCorpus>* corpus)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return cb::Error("failed to open file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+    return cb::Error("failed to stat file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  const cb::Error malformed(
+      "input corpus '" + path + "' is malformed", pa::GENERIC_ERROR);
+  if ((size_t)file_stat.st_size < sizeof(CorpusHeader)) {
+    close(fd);
+    return malformed;
+  }
+
+  std::shared_ptr<InputCorpus> local_corpus(new InputCorpus());
+  local_corpus->length_ = file_stat.st_size;
+  void* data =
+      mmap(nullptr, local_corpus->length_, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return cb::Error("failed to map file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  local_corpus->data_ = static_cast<const uint8_t*>(data);
+
+  const uint8_t* base = local_corpus->data_;
+  const size_t length = local_corpus->length_;
+  CorpusHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, kCorpusMagic, sizeof(kCorpusMagic)) != 0) {
+    return malformed;
+  }
+  if (header.version != kCorpusVersion) {
+    return cb::Error(
+        "input corpus '" + path + "' has unsupported version " +
+            std::to_string(header.version),
+        pa::GENERIC_ERROR);
+  }
+  uint64_t pos = sizeof(header);
+
+  local_corpus->tensor_count_ = header.tensor_count;
+  for (size_t i = 0; i < header.tensor_count; i++) {
+    uint32_t tensor_info[2];
+    if (pos + sizeof(tensor_info) > length) {
+      return malformed;
+    }
+    std::memcpy(tensor_info, base + pos, sizeof(tensor_info));
+    pos += sizeof(tensor_info);
+    if (pos + tensor_info[1] > length) {
+      return malformed;
+    }
+    std::string name(reinterpret_cast<const char*>(base + pos), tensor_info[1]);
+    pos = AlignUp(pos + tensor_info[1]);
+    auto& tensors = tensor_info[0] ? local_corpus->input_tensors_
+                                   : local_corpus->output_tensors_;
+    tensors.emplace(name, i);
+  }
+
+  if (header.stream_count > (length - std::min<uint64_t>(pos, length)) / 16) {
+    return malformed;
+  }
+  uint64_t step_count = 0;
+  for (size_t i = 0; i < header.stream_count; i++) {
+    uint64_t stream_info[2];
+    std::memcpy(stream_info, base + pos, sizeof(stream_info));
+    pos += sizeof(stream_info);
+    if (stream_info[0] != step_count) {
+      return malformed;
+    }
+    step_count += stream_info[1];
+    local_corpus->streams_.emplace_back(stream_info[0], stream_info[1]);
+  }
+  if (step_count != header.step_count) {
+    return malformed;
+  }
+
+  // Only the entry table is validated, which is small next to the data, so
+  // lookups never read outside of the mapping
+  const uint64_t entry_count = step_count * header.tensor_count;
+  if ((header.tensor_count != 0) &&
+      (entry_count / header.tensor_count != step_count)) {
+    return malformed;
+  }
+  if (entry_count > (length - pos) / sizeof(Entry)) {
+    return malformed;
+  }
+  local_corpus->entries_ = reinterpret_cast<const Entry*>(base + pos);
+  for (size_t i = 0; i < entry_count; i++) {
+    const Entry& entry = local_corpus->entries_[i];
+    if ((entry.flags & kEntryPresent) == 0) {
+      continue;
+    }
+    if ((entry.data_offset > length) ||
+        (entry.byte_size > length - entry.data_offset)) {
+      return malformed;
+    }
+    if ((entry.flags & kEntryHasShape) &&
+        ((entry.shape_offset % 8 != 0) || (entry.shape_offset > length) ||
+         (entry.shape_rank > (length - entry.shape_offset) / 8))) {
+      return malformed;
+    }
+  }
+
+  *corpus = std::move(local_corpus);
+  return cb::Error::Success;
+}
+
+cb::Error
+InputCorpus::Write(
+    const std::string& path,
+    const std::vector<std::pair<std::string, bool>>& tensors,
+    const std::vector<size_t>& step_counts, const TensorLookup& lookup)
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return cb::Error(
+        "failed to open file '" + path + "' for writing", pa::GENERIC_ERROR);
+  }
+
+  CorpusHeader header;
+  std::memcpy(header.magic, kCorpusMagic, sizeof(kCorpusMagic));
+  header.version = kCorpusVersion;
+  header.tensor_count = tensors.size();
+  header.stream_count = step_counts.size();
+  header.step_count = 0;
+  for (const auto step_count : step_counts) {
+    header.step_count += step_count;
+  }
+
+  uint64_t pos = 0;
+  WriteBytes(out, &header, sizeof(header), &pos);
+  for (const auto& tensor : tensors) {
+    const uint32_t tensor_info[2] = {
+        tensor.second ? 1u : 0u, (uint32_t)tensor.first.size()};
+    WriteBytes(out, tensor_info, sizeof(tensor_info), &pos);
+    WriteBytes(out, tensor.first.data(), tensor.first.size(), &pos);
+    WritePadding(out, &pos);
+  }
+  uint64_t first_step = 0;
+  for (const auto step_count : step_counts) {
+    const uint64_t stream_info[2] = {first_step, step_count};
+    WriteBytes(out, stream_info, sizeof(stream_info), &pos);
+    first_step += step_count;
+  }
+
+  // The entries are only known once the data is written, so their table is
+  // reserved here and filled in at the end
+  const uint64_t entries_pos = pos;
+  std::vector<Entry> entries(header.step_count * tensors.size(), Entry{});
+  out.seekp(entries.size() * sizeof(Entry), std::ios::cur);
+  pos += entries.size() * sizeof(Entry);
+
+  size_t entry_index = 0;
+  for (size_t stream = 0; stream < step_counts.size(); stream++) {
+    for (size_t step = 0; step < step_counts[stream]; step++) {
+      for (const auto& tensor : tensors) {
+        Entry& entry = entries[entry_index++];
+        const std::vector<char>* data = nullptr;
+        const std::vector<int64_t>* shape = nullptr;
+        if (!lookup(
+                stream, step, tensor.first, tensor.second, &data, &shape)) {
+          continue;
+        }
+        entry.flags = kEntryPresent;
+        if (shape != nullptr) {
+          entry.flags |= kEntryHasShape;
+          entry.shape_offset = pos;
+          entry.shape_rank = shape->size();
+          WriteBytes(out, shape->data(), shape->size() * sizeof(int64_t), &pos);
+        }
+        entry.data_offset = pos;
+        entry.byte_size = data->size();
+        WriteBytes(out, data->data(), data->size(), &pos);
+        WritePadding(out, &pos);
+      }
+    }
+  }
+
+  out.seekp(entries_pos);
+  out.write(
+      reinterpret_cast<const char*>(entries.data()),
+      entries.size() * sizeof(Entry));
+  out.close();
+  if (!out) {
+    return cb::Error(
+        "failed to write input corpus '" + path + "'", pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+InputCorpus::~InputCorpus()
+{
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), length_);
+  }
+}
+
+bool
+InputCorpus::HasTensor(const std::string& name, const bool is_input) const
+{
+  const auto& tensors = is_input ? input_tensors_ : output_tensors_;
+  return tensors.find(name) != tensors.end();
+}
+
+bool
+InputCorpus::Find(
+    const std::string& name, const bool is_input, size_t stream_index,
+    size_t step_index, InputCorpusTensor* tensor) const
+{
+  const auto& tensors = is_input ? input_tensors_ : output_tensors_;
+  auto it = tensors.find(name);
+  if ((it == tensors.end()) || (stream_index >= streams_.size()) ||
+      (step_index >= streams_[stream_index].second)) {
+    return false;
+  }
+  const Entry* entry = GetEntry(it->second, stream_index, step_index);
+  if ((entry->flags & kEntryPresent) == 0) {
+    return false;
+  }
+  tensor->data_ = data_ + entry->data_offset;
+  tensor->byte_size_ = entry->byte_size;
+  tensor->has_shape_ = (entry->flags & kEntryHasShape) != 0;
+  if (tensor->has_shape_) {
+    tensor->shape_ =
+        reinterpret_cast<const int64_t*>(data_ + entry->shape_offset);
+    tensor->shape_rank_ = entry->shape_rank;
+  } else {
+    tensor->shape_ = nullptr;
+    tensor->shape_rank_ = 0;
+  }
+  return true;
+}
+
+const InputCorpus::Entry*
+InputCorpus::GetEntry(
+    size_t tensor_index, size_t stream_index, size_t step_index) const
+{
+  const uint64_t step = streams_[stream_index].first + step_index;
+  return &entries_[step * tensor_count_ + tensor_index];
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,150 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A tensor of one step of an input corpus. The pointers are into the
+/// mapped corpus and stay valid for as long as the corpus is alive.
+struct InputCorpusTensor {
+  const uint8_t* data_{nullptr};
+  size_t byte_size_{0};
+  // Only set if the shape of the tensor was given with its data
+  bool has_shape_{false};
+  const int64_t* shape_{nullptr};
+  size_t shape_rank_{0};
+};
+
+/// A binary, indexed store of input and validation data that is memory
+/// mapped instead of parsed, so that very large corpora load instantly and
+/// their pages are shared by every process reading the same file.
+///
+/// All integers are little-endian and every section is 8-byte aligned:
+///   header:  "PACORPUS", uint32 version, uint32 tensor count,
+///            uint64 stream count, uint64 total step count
+///   tensors: per tensor, uint32 is_input, uint32 name length, the name
+///   streams: per stream, uint64 first step, uint64 step count
+///   entries: per step and tensor, uint64 data offset, uint64 byte size,
+///            uint64 shape offset, uint32 shape rank, uint32 flags
+///   data:    the shapes (int64 each) and raw tensor bytes, in the same
+///            serialization the JSON data uses
+///
+/// The entry of a tensor in a step is found by indexing, so a lookup never
+/// touches anything but the entry and the data it points to.
+///
+class InputCorpus {
+ public:
+  /// Provides the data of a tensor in a step when writing a corpus.
+  /// Arguments are the stream index, step index, tensor name, whether it is
+  /// an input, and the data and shape to return; the shape is left null if
+  /// it was not given. Returns false if the step has no data for the tensor.
+  using TensorLookup = std::function<bool(
+      size_t, size_t, const std::string&, bool, const std::vector<char>**,
+      const std::vector<int64_t>**)>;
+
+  /// \param path The path of a file.
+  /// \return Whether the file starts like an input corpus.
+  static bool IsCorpusFile(const std::string& path);
+
+  /// Map and validate an input corpus.
+  /// \param path The path of the corpus file.
+  /// \param corpus Returns the corpus.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Open(
+      const std::string& path, std::shared_ptr<InputCorpus>* corpus);
+
+  /// Write an input corpus.
+  /// \param path The path of the corpus file to write.
+  /// \param tensors The name of every tensor, paired with whether it is an
+  /// input.
+  /// \param step_counts The number of steps of every stream.
+  /// \param lookup Provides the data of each tensor in each step.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Write(
+      const std::string& path,
+      const std::vector<std::pair<std::string, bool>>& tensors,
+      const std::vector<size_t>& step_counts, const TensorLookup& lookup);
+
+  ~InputCorpus();
+
+  /// \return The number of data streams in the corpus.
+  size_t StreamCount() const { return streams_.size(); }
+
+  /// \return The number of steps of a stream.
+  size_t StepCount(size_t stream_index) const
+  {
+    return streams_[stream_index].second;
+  }
+
+  /// \return Whether any step of the corpus can have data for a tensor.
+  bool HasTensor(const std::string& name, const bool is_input) const;
+
+  /// Look up the data of a tensor in a step.
+  /// \param name The name of the tensor.
+  /// \param is_input Whether the tensor is an input or validation output.
+  /// \param stream_index The stream of the step.
+  /// \param step_index The step within the stream.
+  /// \param tensor Returns the data of the tensor.
+  /// \return Whether the step has data for the tensor.
+  bool Find(
+      const std::string& name, const bool is_input, size_t stream_index,
+      size_t step_index, InputCorpusTensor* tensor) const;
+
+ private:
+  InputCorpus() = default;
+
+  struct Entry {
+    uint64_t data_offset;
+    uint64_t byte_size;
+    uint64_t shape_offset;
+    uint32_t shape_rank;
+    uint32_t flags;
+  };
+
+  const Entry* GetEntry(
+      size_t tensor_index, size_t stream_index, size_t step_index) const;
+
+  const uint8_t* data_{nullptr};
+  size_t length_{0};
+
+  // Tensor index by name, separately for inputs and outputs
+  std::unordered_map<std::string, size_t> input_tensors_;
+  std::unordered_map<std::string, size_t> output_tensors_;
+  size_t tensor_count_{0};
+  // First step and step count of every stream
+  std::vector<std::pair<uint64_t, uint64_t>> streams_;
+  const Entry* entries_{nullptr};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,112 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "input_repeat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// log1p(x) / x, continuous at 0
+double
+Log1pOverX(const double x)
+{
+  return (std::abs(x) > 1e-8) ? std::log1p(x) / x : 1.0 - x / 2.0;
+}
+
+// expm1(x) / x, continuous at 0
+double
+Expm1OverX(const double x)
+{
+  return (std::abs(x) > 1e-8) ? std::expm1(x) / x : 1.0 + x / 2.0;
+}
+
+}  // namespace
+
+size_t
+InputRepeat::Next(std::mt19937& rng, const size_t pool_size)
+{
+  const size_t sent = std::min(new_inputs_.load(), pool_size);
+  if ((sent > 0) &&
+      (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < ratio_)) {
+    return DrawZipf(rng, sent, skew_);
+  }
+
+  const size_t input = new_inputs_.fetch_add(1);
+  if ((input >= pool_size) && !pool_exhausted_.exchange(true)) {
+    std::cerr << "WARNING: all the " << pool_size
+              << " unique inputs of the input data were sent, the requests "
+                 "meant to have a new input repeat one from now on. Provide "
+                 "more unique inputs to keep to the --input-repeat-ratio."
+              << std::endl;
+  }
+  return input % pool_size;
+}
+
+size_t
+InputRepeat::DrawZipf(std::mt19937& rng, const size_t size, double skew)
+{
+  if ((size <= 1) || (skew <= 0.0)) {
+    return (size <= 1)
+               ? 0
+               : std::uniform_int_distribution<size_t>(0, size - 1)(rng);
+  }
+
+  // Rejection-inversion sampling of ranks 1 to size with the hat function
+  // h(x) = x^-skew, after W. Hormann and G. Derflinger, "Rejection-inversion
+  // to generate variates from monotone discrete distributions"
+  auto h = [skew](const double x) { return std::exp(-skew * std::log(x)); };
+  auto h_integral = [skew](const double x) {
+    const double log_x = std::log(x);
+    return Expm1OverX((1.0 - skew) * log_x) * log_x;
+  };
+  auto h_integral_inverse = [skew](const double x) {
+    double t = x * (1.0 - skew);
+    t = std::max(t, -1.0);
+    return std::exp(Log1pOverX(t) * x);
+  };
+
+  const double integral_first = h_integral(1.5) - 1.0;
+  const double integral_last = h_integral(size + 0.5);
+  const double accept = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  while (true) {
+    const double u =
+        integral_last + uniform(rng) * (integral_first - integral_last);
+    const double x = h_integral_inverse(u);
+    double k = std::floor(x + 0.5);
+    k = std::min(std::max(k, 1.0), static_cast<double>(size));
+    if ((k - x <= accept) || (u >= h_integral(k + 0.5) - h(k))) {
+      return static_cast<size_t>(k) - 1;
+    }
+  }
+}
+
+}}  // namespace triton::perfanalyzer
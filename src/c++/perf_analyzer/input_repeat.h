@@ -0,0 +1,80 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <random>
+
+namespace triton { namespace perfanalyzer {
+
+/// Picks the inputs of the requests so that a target share of them repeats
+/// an input sent before, to benchmark a response cache. The inputs form a
+/// pool of unique inputs that are sent for the first time in turn. A repeat
+/// picks one of the inputs sent so far by a Zipf popularity, the first
+/// input sent being the most popular one. Inputs are picked by index, so the
+/// repeats are not copies of the input data.
+class InputRepeat {
+ public:
+  /// \param ratio The share of the requests that repeat an input, in [0, 1).
+  /// \param skew The exponent of the Zipf popularity of the repeated inputs,
+  /// 0 to repeat every input sent so far as often.
+  InputRepeat(const double ratio, const double skew)
+      : ratio_(ratio), skew_(skew)
+  {
+  }
+
+  /// Picks the input of a request. Safe to call from several threads.
+  /// \param rng The random number generator of the caller.
+  /// \param pool_size The number of unique inputs.
+  /// \return The index of the input in [0, pool_size). Once every input of
+  /// the pool was sent, the inputs meant to be new are sent again.
+  size_t Next(std::mt19937& rng, const size_t pool_size);
+
+  /// \return Whether the inputs meant to be new ran out of the pool.
+  bool PoolExhausted() const { return pool_exhausted_; }
+
+  double Ratio() const { return ratio_; }
+
+  double Skew() const { return skew_; }
+
+  /// Draws a rank from a Zipf distribution by rejection-inversion, which
+  /// needs no table so that the number of ranks may change on every draw.
+  /// \param rng The random number generator to draw with.
+  /// \param size The number of ranks.
+  /// \param skew The exponent of the distribution, 0 for uniform.
+  /// \return A rank in [0, size), rank 0 being the most likely one.
+  static size_t DrawZipf(std::mt19937& rng, const size_t size, double skew);
+
+ private:
+  double ratio_;
+  double skew_;
+  // The number of inputs meant to be new that were sent
+  std::atomic<size_t> new_inputs_{0};
+  std::atomic<bool> pool_exhausted_{false};
+};
+
+}}  // namespace triton::perfanalyzer
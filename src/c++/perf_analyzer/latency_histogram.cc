@@ -0,0 +1,278 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Number of leading header words in the serialized form
+constexpr size_t SERIALIZED_HEADER_LEN = 7;
+
+uint32_t
+CountLeadingZeros(uint64_t value)
+{
+  return __builtin_clzll(value);
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram(
+    uint64_t highest_trackable_ns, uint32_t significant_digits)
+    : highest_trackable_ns_(std::max<uint64_t>(highest_trackable_ns, 2)),
+      significant_digits_(significant_digits)
+{
+  if (significant_digits_ < 1 || significant_digits_ > 5) {
+    throw std::runtime_error(
+        "LatencyHistogram significant digits must be between 1 and 5");
+  }
+
+  // Each bucket must hold enough sub-buckets to distinguish values with the
+  // requested number of significant digits.
+  uint64_t largest_single_unit_value = 2;
+  for (uint32_t i = 0; i < significant_digits_; i++) {
+    largest_single_unit_value *= 10;
+  }
+  uint32_t sub_bucket_count_magnitude = static_cast<uint32_t>(
+      std::ceil(std::log2(static_cast<double>(largest_single_unit_value))));
+  sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+  uint64_t sub_bucket_count = uint64_t(1) << sub_bucket_count_magnitude;
+  sub_bucket_half_count_ = sub_bucket_count / 2;
+  sub_bucket_mask_ = sub_bucket_count - 1;
+
+  // Each additional bucket doubles the range covered.
+  uint64_t smallest_untrackable_value = sub_bucket_count;
+  size_t bucket_count = 1;
+  while (smallest_untrackable_value <= highest_trackable_ns_) {
+    if (smallest_untrackable_value > (UINT64_MAX >> 2)) {
+      bucket_count++;
+      break;
+    }
+    smallest_untrackable_value <<= 1;
+    bucket_count++;
+  }
+  counts_len_ = (bucket_count + 1) * sub_bucket_half_count_;
+}
+
+size_t
+LatencyHistogram::CountsIndex(uint64_t value) const
+{
+  const uint32_t pow2_ceiling =
+      64 - CountLeadingZeros(value | sub_bucket_mask_);
+  const uint32_t bucket_index =
+      pow2_ceiling - (sub_bucket_half_count_magnitude_ + 1);
+  const uint64_t sub_bucket_index = value >> bucket_index;
+  return ((static_cast<size_t>(bucket_index) + 1)
+          << sub_bucket_half_count_magnitude_) +
+         (sub_bucket_index - sub_bucket_half_count_);
+}
+
+uint64_t
+LatencyHistogram::HighestEquivalentValue(size_t index) const
+{
+  int64_t bucket_index =
+      static_cast<int64_t>(index >> sub_bucket_half_count_magnitude_) - 1;
+  uint64_t sub_bucket_index =
+      (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+  if (bucket_index < 0) {
+    sub_bucket_index -= sub_bucket_half_count_;
+    bucket_index = 0;
+  }
+  const uint64_t lowest = sub_bucket_index << bucket_index;
+  return lowest + (uint64_t(1) << bucket_index) - 1;
+}
+
+void
+LatencyHistogram::RecordValues(uint64_t latency_ns, uint64_t count)
+{
+  if (count == 0) {
+    return;
+  }
+  if (counts_.empty()) {
+    counts_.resize(counts_len_, 0);
+  }
+  latency_ns = std::min(latency_ns, highest_trackable_ns_);
+
+  counts_[CountsIndex(latency_ns)] += count;
+  total_count_ += count;
+  min_ = std::min(min_, latency_ns);
+  max_ = std::max(max_, latency_ns);
+  sum_ns_ += latency_ns * count;
+  sum_sq_ns_ += static_cast<double>(latency_ns) *
+                static_cast<double>(latency_ns) * static_cast<double>(count);
+}
+
+cb::Error
+LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+  if ((highest_trackable_ns_ != other.highest_trackable_ns_) ||
+      (significant_digits_ != other.significant_digits_)) {
+    return cb::Error(
+        "Unable to merge latency histograms with different configurations",
+        pa::GENERIC_ERROR);
+  }
+  if (other.total_count_ == 0) {
+    return cb::Error::Success;
+  }
+  if (counts_.empty()) {
+    counts_.resize(counts_len_, 0);
+  }
+  for (size_t i = 0; i < counts_len_; i++) {
+    counts_[i] += other.counts_[i];
+  }
+  total_count_ += other.total_count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ns_ += other.sum_ns_;
+  sum_sq_ns_ += other.sum_sq_ns_;
+  return cb::Error::Success;
+}
+
+void
+LatencyHistogram::Reset()
+{
+  std::fill(counts_.begin(), counts_.end(), 0);
+  total_count_ = 0;
+  min_ = UINT64_MAX;
+  max_ = 0;
+  sum_ns_ = 0;
+  sum_sq_ns_ = 0;
+}
+
+uint64_t
+LatencyHistogram::Mean() const
+{
+  if (total_count_ == 0) {
+    return 0;
+  }
+  return sum_ns_ / total_count_;
+}
+
+uint64_t
+LatencyHistogram::StdDevUs() const
+{
+  if (total_count_ < 2) {
+    return UINT64_MAX;
+  }
+  const double n = static_cast<double>(total_count_);
+  const double mean = static_cast<double>(sum_ns_) / n;
+  const double variance =
+      std::max(0.0, (sum_sq_ns_ - n * mean * mean) / (n - 1));
+  return static_cast<uint64_t>(std::sqrt(variance) / 1000);
+}
+
+uint64_t
+LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+  if (total_count_ == 0) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  const uint64_t rank =
+      static_cast<uint64_t>((percentile / 100.0) * (total_count_ - 1) + 0.5) +
+      1;
+
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < counts_len_; i++) {
+    cumulative_count += counts_[i];
+    if (cumulative_count >= rank) {
+      return std::min(std::max(HighestEquivalentValue(i), min_), max_);
+    }
+  }
+  return max_;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>>
+LatencyHistogram::Buckets() const
+{
+  std::vector<std::pair<uint64_t, uint64_t>> buckets;
+  for (size_t i = 0; (i < counts_.size()) && (i < counts_len_); i++) {
+    if (counts_[i] != 0) {
+      buckets.emplace_back(
+          std::min(std::max(HighestEquivalentValue(i), min_), max_),
+          counts_[i]);
+    }
+  }
+  return buckets;
+}
+
+std::vector<uint64_t>
+LatencyHistogram::Serialize() const
+{
+  std::vector<uint64_t> serialized(SERIALIZED_HEADER_LEN + counts_len_, 0);
+  serialized[0] = highest_trackable_ns_;
+  serialized[1] = significant_digits_;
+  serialized[2] = total_count_;
+  serialized[3] = min_;
+  serialized[4] = max_;
+  serialized[5] = sum_ns_;
+  std::memcpy(&serialized[6], &sum_sq_ns_, sizeof(sum_sq_ns_));
+  if (!counts_.empty()) {
+    std::copy(
+        counts_.begin(), counts_.end(),
+        serialized.begin() + SERIALIZED_HEADER_LEN);
+  }
+  return serialized;
+}
+
+cb::Error
+LatencyHistogram::MergeSerialized(const std::vector<uint64_t>& serialized)
+{
+  if ((serialized.size() != SERIALIZED_HEADER_LEN + counts_len_) ||
+      (serialized[0] != highest_trackable_ns_) ||
+      (serialized[1] != significant_digits_)) {
+    return cb::Error(
+        "Unable to merge serialized latency histogram with a different "
+        "configuration",
+        pa::GENERIC_ERROR);
+  }
+  if (serialized[2] == 0) {
+    return cb::Error::Success;
+  }
+  if (counts_.empty()) {
+    counts_.resize(counts_len_, 0);
+  }
+  for (size_t i = 0; i < counts_len_; i++) {
+    counts_[i] += serialized[SERIALIZED_HEADER_LEN + i];
+  }
+  total_count_ += serialized[2];
+  min_ = std::min(min_, serialized[3]);
+  max_ = std::max(max_, serialized[4]);
+  sum_ns_ += serialized[5];
+  double sum_sq_ns;
+  std::memcpy(&sum_sq_ns, &serialized[6], sizeof(sum_sq_ns));
+  sum_sq_ns_ += sum_sq_ns;
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
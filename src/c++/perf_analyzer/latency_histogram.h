@@ -0,0 +1,134 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// High dynamic range histogram of request latencies in nanoseconds.
+///
+/// Values are kept in log-linear buckets so that any recorded value can be
+/// reported with the configured number of significant decimal digits, while
+/// the memory used stays constant no matter how many values are recorded.
+/// Values below 2 * 10^significant_digits are recorded exactly. Histograms
+/// with the same configuration can be merged, either directly or through
+/// their serialized form when they live in different processes (e.g. MPI
+/// ranks).
+///
+/// The mean and standard deviation are computed from the exact running sum
+/// and sum of squares rather than from the buckets.
+///
+class LatencyHistogram {
+ public:
+  static constexpr uint64_t DEFAULT_HIGHEST_TRACKABLE_NS =
+      3600 * NANOS_PER_SECOND;
+  static constexpr uint32_t DEFAULT_SIGNIFICANT_DIGITS = 3;
+
+  /// \param highest_trackable_ns The largest latency that can be recorded.
+  /// Larger latencies are recorded as this value.
+  /// \param significant_digits The number of significant decimal digits
+  /// kept for each recorded value. Must be between 1 and 5.
+  LatencyHistogram(
+      uint64_t highest_trackable_ns = DEFAULT_HIGHEST_TRACKABLE_NS,
+      uint32_t significant_digits = DEFAULT_SIGNIFICANT_DIGITS);
+
+  /// Record a single latency.
+  /// \param latency_ns The latency in nanoseconds.
+  void Record(uint64_t latency_ns) { RecordValues(latency_ns, 1); }
+
+  /// Record the same latency multiple times.
+  /// \param latency_ns The latency in nanoseconds.
+  /// \param count The number of times to record it.
+  void RecordValues(uint64_t latency_ns, uint64_t count);
+
+  /// Add all the values recorded in another histogram to this one.
+  /// \param other The histogram to merge. Must have the same configuration.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Merge(const LatencyHistogram& other);
+
+  /// Clear all recorded values.
+  void Reset();
+
+  /// \return The number of values recorded.
+  uint64_t TotalCount() const { return total_count_; }
+
+  /// \return The smallest value recorded, or 0 if empty.
+  uint64_t Min() const { return total_count_ == 0 ? 0 : min_; }
+
+  /// \return The largest value recorded, or 0 if empty.
+  uint64_t Max() const { return max_; }
+
+  /// \return The mean of the values recorded in nanoseconds, or 0 if empty.
+  uint64_t Mean() const;
+
+  /// \return The sample standard deviation of the values recorded, in
+  /// microseconds. UINT64_MAX if fewer than two values were recorded.
+  uint64_t StdDevUs() const;
+
+  /// \param percentile The percentile to look up, in [0, 100].
+  /// \return The value at the given percentile, using the same nearest rank
+  /// as indexing into a sorted vector of the recorded values. 0 if empty.
+  uint64_t ValueAtPercentile(double percentile) const;
+
+  /// \return The value and count of every non-empty bucket in increasing
+  /// order of value. The values are those ValueAtPercentile() reports.
+  std::vector<std::pair<uint64_t, uint64_t>> Buckets() const;
+
+  /// \return The histogram as a flat vector whose length only depends on the
+  /// configuration, suitable for sending to another process.
+  std::vector<uint64_t> Serialize() const;
+
+  /// Add the values of a histogram produced by Serialize() to this one.
+  /// \param serialized The serialized histogram.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error MergeSerialized(const std::vector<uint64_t>& serialized);
+
+ private:
+  size_t CountsIndex(uint64_t value) const;
+  uint64_t HighestEquivalentValue(size_t index) const;
+
+  uint64_t highest_trackable_ns_;
+  uint32_t significant_digits_;
+  uint32_t sub_bucket_half_count_magnitude_;
+  uint64_t sub_bucket_half_count_;
+  uint64_t sub_bucket_mask_;
+  size_t counts_len_;
+
+  // Allocated on the first recorded value so that empty histograms (e.g. in
+  // default constructed stats) stay cheap to copy
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_{0};
+  uint64_t min_{UINT64_MAX};
+  uint64_t max_{0};
+  uint64_t sum_ns_{0};
+  double sum_sq_ns_{0};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -31,6 +31,7 @@
 #include <algorithm>
 
 #include "client_backend/client_backend.h"
+#include "cpu_affinity.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -63,14 +64,10 @@ cb::Error
 LoadManager::SwapTimestamps(TimestampVector& new_timestamps)
 {
   TimestampVector total_timestamp;
-  // Gather request timestamps with proper locking from all the worker
-  // threads
+  // Drain request timestamps from all the worker threads. The rings are
+  // lock-free on the consumer side so the workers are never blocked here.
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
-    total_timestamp.insert(
-        total_timestamp.end(), thread_stat->request_timestamps_.begin(),
-        thread_stat->request_timestamps_.end());
-    thread_stat->request_timestamps_.clear();
+    thread_stat->request_timestamps_.Drain(&total_timestamp);
   }
   // Swap the results
   total_timestamp.swap(new_timestamps);
@@ -82,12 +79,43 @@ LoadManager::CountCollectedRequests()
 {
   uint64_t num_of_requests = 0;
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
-    num_of_requests += thread_stat->request_timestamps_.size();
+    num_of_requests += thread_stat->request_timestamps_.Size();
   }
   return num_of_requests;
 }
 
+bool
+LoadManager::WaitForCollectedRequests(
+    uint64_t count, std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  if (share_nothing_) {
+    // The threads do not signal a shared counter, so poll their own counts
+    while (CountCollectedRequests() < count) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+  while (true) {
+    // Read the counter first, so that a request completing in between can
+    // only make the target too low, which the next pass catches
+    const uint64_t completed = completion_counter_->Count();
+    const uint64_t collected = CountCollectedRequests();
+    if (collected >= count) {
+      return true;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if ((now >= deadline) ||
+        !completion_counter_->WaitFor(
+            completed + (count - collected), deadline - now)) {
+      return CountCollectedRequests() >= count;
+    }
+  }
+}
+
 cb::Error
 LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
 {
@@ -95,19 +123,16 @@ LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
   contexts_stat->cumulative_receive_time_ns = 0;
   contexts_stat->cumulative_send_time_ns = 0;
   contexts_stat->cumulative_total_request_time_ns = 0;
-
+  contexts_stat->cumulative_first_byte_time_ns = 0;
+  contexts_stat->cumulative_serialize_time_ns = 0;
+  contexts_stat->cumulative_send_queue_time_ns = 0;
+  contexts_stat->cumulative_deserialize_time_ns = 0;
+  contexts_stat->response_chunk_interval_count = 0;
+  contexts_stat->cumulative_response_chunk_interval_ns = 0;
+
+  // The threads keep running, the stats are read without blocking them
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
-    for (auto& context_stat : thread_stat->contexts_stat_) {
-      contexts_stat->completed_request_count +=
-          context_stat.completed_request_count;
-      contexts_stat->cumulative_total_request_time_ns +=
-          context_stat.cumulative_total_request_time_ns;
-      contexts_stat->cumulative_send_time_ns +=
-          context_stat.cumulative_send_time_ns;
-      contexts_stat->cumulative_receive_time_ns +=
-          context_stat.cumulative_receive_time_ns;
-    }
+    thread_stat->client_stat_.AccumulateInto(contexts_stat);
   }
   return cb::Error::Success;
 }
@@ -118,7 +143,6 @@ LoadManager::GetIdleTime()
   uint64_t total{0};
   size_t num_active_threads = 0;
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
     uint64_t idle_time = thread_stat->idle_timer.GetIdleTime();
     if (idle_time) {
       total += idle_time;
@@ -140,7 +164,6 @@ void
 LoadManager::ResetIdleTime()
 {
   for (auto& thread_stat : threads_stat_) {
-    std::lock_guard<std::mutex> lock(thread_stat->mu_);
     thread_stat->idle_timer.Reset();
   }
 }
@@ -151,13 +174,186 @@ LoadManager::GetAndResetNumSentRequests()
   size_t num_sent_requests{0};
 
   for (auto& thread_stat : threads_stat_) {
-    num_sent_requests += thread_stat->num_sent_requests_;
-    thread_stat->num_sent_requests_ = 0;
+    num_sent_requests += thread_stat->num_sent_requests_.exchange(0);
   }
 
   return num_sent_requests;
 }
 
+cb::Error
+LoadManager::GetAndResetScheduleErrors(LatencyHistogram* schedule_errors)
+{
+  schedule_errors->Reset();
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->schedule_error_mu_);
+    RETURN_IF_ERROR(
+        schedule_errors->Merge(thread_stat->schedule_error_histogram_));
+    thread_stat->schedule_error_histogram_.Reset();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetInflightLimitStats(
+    uint64_t* dropped_count, LatencyHistogram* queue_delays)
+{
+  *dropped_count = 0;
+  queue_delays->Reset();
+  for (auto& thread_stat : threads_stat_) {
+    *dropped_count += thread_stat->num_dropped_requests_.exchange(0);
+    std::lock_guard<std::mutex> lock(thread_stat->schedule_error_mu_);
+    RETURN_IF_ERROR(queue_delays->Merge(thread_stat->queue_delay_histogram_));
+    thread_stat->queue_delay_histogram_.Reset();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetValidationStats(ValidationStats* stats)
+{
+  *stats = output_validator_->GetAndResetStats();
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetIntervalLatencies(LatencyHistogram* latencies)
+{
+  latencies->Reset();
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    RETURN_IF_ERROR(latencies->Merge(thread_stat->interval_latency_histogram_));
+    thread_stat->interval_latency_histogram_.Reset();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetThresholdLatencies(LatencyHistogram* latencies)
+{
+  latencies->Reset();
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    RETURN_IF_ERROR(
+        latencies->Merge(thread_stat->threshold_latency_histogram_));
+    thread_stat->threshold_latency_histogram_.Reset();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetCorrectedLatencies(LatencyHistogram* latencies)
+{
+  latencies->Reset();
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    RETURN_IF_ERROR(
+        latencies->Merge(thread_stat->corrected_latency_histogram_));
+    thread_stat->corrected_latency_histogram_.Reset();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetBucketLatencies(
+    std::map<std::string, LatencyHistogram>* buckets)
+{
+  buckets->clear();
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    for (auto& bucket : thread_stat->bucket_latency_histograms_) {
+      RETURN_IF_ERROR((*buckets)[bucket.first].Merge(bucket.second));
+    }
+    thread_stat->bucket_latency_histograms_.clear();
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetRequestClassStats(
+    std::map<std::string, RequestClassStats>* stats)
+{
+  stats->clear();
+  if (request_classes_ == nullptr) {
+    return cb::Error::Success;
+  }
+  for (size_t i = 0; i < request_classes_->Size(); i++) {
+    (*stats)[request_classes_->Entry(i).name] = RequestClassStats();
+  }
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    for (size_t i = 0; i < thread_stat->request_class_stats_.size(); i++) {
+      RequestClassStats& class_stats = thread_stat->request_class_stats_[i];
+      RETURN_IF_ERROR((*stats)[request_classes_->Entry(i).name].Merge(
+          class_stats));
+      class_stats.latencies.Reset();
+      class_stats.rejected_count = 0;
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadManager::GetAndResetEndpointLatencies(
+    std::map<std::string, LatencyHistogram>* latencies)
+{
+  latencies->clear();
+  if (endpoints_ == nullptr) {
+    return cb::Error::Success;
+  }
+  for (size_t i = 0; i < endpoints_->Size(); i++) {
+    (*latencies)[endpoints_->Entry(i).url] = LatencyHistogram();
+  }
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    auto& histograms = thread_stat->endpoint_latency_histograms_;
+    for (size_t i = 0; i < histograms.size(); i++) {
+      RETURN_IF_ERROR(
+          (*latencies)[endpoints_->Entry(i).url].Merge(histograms[i]));
+      histograms[i].Reset();
+    }
+  }
+  return cb::Error::Success;
+}
+
+void
+LoadManager::GetAndResetSlowRequests(SlowRequestTracker* slow_requests)
+{
+  *slow_requests = SlowRequestTracker(slow_request_count_);
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    std::lock_guard<std::mutex> lock(thread_stat->mu_);
+    slow_requests->Merge(thread_stat->slow_requests_);
+    thread_stat->slow_requests_.Reset();
+  }
+}
+
+void
+LoadManager::GetAndResetClientStageTimes(ClientStageTimes* times)
+{
+  *times = ClientStageTimes();
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    thread_stat->stage_timer_.CollectAndReset(times);
+  }
+}
+
+size_t
+LoadManager::GetNumInflightRequests()
+{
+  size_t num_inflight_requests{0};
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  for (auto& thread_stat : threads_stat_) {
+    num_inflight_requests += thread_stat->num_inflight_requests_;
+  }
+  return num_inflight_requests;
+}
+
 LoadManager::LoadManager(
     const bool async, const bool streaming, const int32_t batch_size,
     const size_t max_threads, const SharedMemoryType shared_memory_type,
@@ -165,7 +361,8 @@ LoadManager::LoadManager(
     const std::shared_ptr<cb::ClientBackendFactory>& factory)
     : async_(async), streaming_(streaming), batch_size_(batch_size),
       max_threads_(max_threads), parser_(parser), factory_(factory),
-      using_json_data_(false)
+      using_json_data_(false), shared_memory_type_(shared_memory_type),
+      output_shm_size_(output_shm_size)
 {
   on_sequence_model_ =
       ((parser_->SchedulerType() == ModelParser::SEQUENCE) ||
@@ -178,6 +375,102 @@ LoadManager::LoadManager(
       data_loader_);
 }
 
+void
+LoadManager::EnablePrestagedInputs()
+{
+  prestage_inputs_ = true;
+  ResetInferDataManager();
+}
+
+void
+LoadManager::EnableSharedMemoryPool(const size_t pool_size)
+{
+  shm_pool_size_ = pool_size;
+  ResetInferDataManager();
+}
+
+void
+LoadManager::EnableOutputSharedMemorySlots(const size_t output_slots)
+{
+  output_shm_slots_ = output_slots;
+  ResetInferDataManager();
+}
+
+void
+LoadManager::SetSharedMemoryOptions(const cb::SharedMemoryOptions& options)
+{
+  shm_options_ = options;
+  ResetInferDataManager();
+}
+
+void
+LoadManager::ResetInferDataManager()
+{
+  infer_data_manager_ = InferDataManagerFactory::CreateInferDataManager(
+      batch_size_, shared_memory_type_, output_shm_size_, parser_, factory_,
+      data_loader_, prestage_inputs_, shm_pool_size_, output_shm_slots_,
+      shm_options_);
+}
+
+void
+LoadManager::SetShareNothing()
+{
+  share_nothing_ = true;
+  if (worker_cpus_.empty()) {
+    cb::Error err = ProcessCpus(&worker_cpus_);
+    if (!err.IsOk()) {
+      std::cerr << "WARNING: worker threads are not pinned: " << err.Message()
+                << std::endl;
+    }
+  }
+}
+
+std::shared_ptr<IInferDataManager>
+LoadManager::WorkerInferDataManager()
+{
+  if (!share_nothing_) {
+    return infer_data_manager_;
+  }
+  auto manager = InferDataManagerFactory::CreateInferDataManager(
+      batch_size_, shared_memory_type_, output_shm_size_, parser_, factory_,
+      data_loader_, prestage_inputs_, shm_pool_size_, output_shm_slots_,
+      shm_options_);
+  THROW_IF_ERROR(manager->Init(), "Unable to init infer data manager");
+  return manager;
+}
+
+std::shared_ptr<SequenceManager>
+LoadManager::WorkerSequenceManager()
+{
+  if (!share_nothing_ || !on_sequence_model_ ||
+      (sequence_manager_ == nullptr)) {
+    return sequence_manager_;
+  }
+  const size_t num_statuses = sequence_manager_->GetNumSequenceStatuses();
+  const size_t worker_index = threads_stat_.size() - 1;
+  uint64_t start_sequence_id = start_sequence_id_;
+  uint64_t sequence_id_range = sequence_id_range_;
+  // A range too small for one ID range per status falls back to a counter of
+  // the sequence manager, so give each thread a slice of the range instead
+  if ((sequence_id_range > 0) && (sequence_id_range < num_statuses)) {
+    const uint64_t thread_count = std::max<size_t>(max_threads_, 1);
+    sequence_id_range =
+        std::max<uint64_t>(sequence_id_range_ / thread_count, 1);
+    start_sequence_id +=
+        (worker_index * sequence_id_range) % sequence_id_range_;
+  }
+  auto manager = MakeSequenceManager(
+      start_sequence_id, sequence_id_range, sequence_length_,
+      sequence_length_specified_, sequence_length_variation_, using_json_data_,
+      data_loader_);
+  if (sequence_length_distribution_ != nullptr) {
+    manager->SetLengthDistribution(sequence_length_distribution_);
+  }
+  manager->Seed(worker_index + 1);
+  manager->InitSequenceStatuses(num_statuses);
+  return manager;
+}
+
 void
 LoadManager::InitManager(
     const size_t string_length, const std::string& string_data,
@@ -200,10 +493,18 @@ LoadManager::InitManager(
   THROW_IF_ERROR(
       infer_data_manager_->Init(), "Unable to init infer data manager");
 
+  start_sequence_id_ = start_sequence_id;
+  sequence_id_range_ = sequence_id_range;
+  sequence_length_ = sequence_length;
+  sequence_length_specified_ = sequence_length_specified;
+  sequence_length_variation_ = sequence_length_variation;
   sequence_manager_ = MakeSequenceManager(
       start_sequence_id, sequence_id_range, sequence_length,
       sequence_length_specified, sequence_length_variation, using_json_data_,
       data_loader_);
+  if (sequence_length_distribution_ != nullptr) {
+    sequence_manager_->SetLengthDistribution(sequence_length_distribution_);
+  }
 
   InitManagerFinalize();
 }
@@ -216,15 +517,37 @@ LoadManager::InitManagerInputs(
   RETURN_IF_ERROR(factory_->CreateClientBackend(&backend_));
 
   // Read provided data
-  if (!user_data.empty()) {
+  if (input_data_reused_) {
+    // Read, and sharded, by the load manager it was taken from
+  } else if (!user_data.empty()) {
     if (IsDirectory(user_data[0])) {
       RETURN_IF_ERROR(data_loader_->ReadDataFromDir(
           parser_->Inputs(), parser_->Outputs(), user_data[0]));
+      if (data_loader_->IsStreamed()) {
+        // The steps are sent in turn like those of json data
+        using_json_data_ = true;
+        std::cout << " Indexed " << data_loader_->GetTotalSteps(0)
+                  << " steps in " << user_data[0] << "." << std::endl;
+      }
+    } else if (data_loader_->PrefetchSteps() != 0) {
+      return cb::Error(
+          "--data-prefetch-steps requires --input-data to be a directory",
+          pa::GENERIC_ERROR);
     } else {
       using_json_data_ = true;
-      for (const auto& json_file : user_data) {
-        RETURN_IF_ERROR(data_loader_->ReadDataFromJSON(
-            parser_->Inputs(), parser_->Outputs(), json_file));
+      if (InputCorpus::IsCorpusFile(user_data[0])) {
+        if (user_data.size() > 1) {
+          return cb::Error(
+              "an input corpus can not be combined with other input data",
+              pa::GENERIC_ERROR);
+        }
+        RETURN_IF_ERROR(data_loader_->ReadDataFromCorpus(
+            parser_->Inputs(), parser_->Outputs(), user_data[0]));
+      } else {
+        for (const auto& json_file : user_data) {
+          RETURN_IF_ERROR(data_loader_->ReadDataFromJSON(
+              parser_->Inputs(), parser_->Outputs(), json_file));
+        }
       }
       std::cout << " Successfully read data for "
                 << data_loader_->GetDataStreamsCount() << " stream/streams";
@@ -235,16 +558,84 @@ LoadManager::InitManagerInputs(
       std::cout << "." << std::endl;
     }
   } else {
+    if ((shared_memory_type_ == SharedMemoryType::CUDA_SHARED_MEMORY) &&
+        (shm_pool_size_ == 0)) {
+      // The regions are filled on the device from a small pattern
+      data_loader_->DeferGeneratedData();
+    }
     RETURN_IF_ERROR(data_loader_->GenerateData(
         parser_->Inputs(), zero_input, string_length, string_data));
   }
 
+  if ((input_repeat_ != nullptr) && !using_json_data_) {
+    return cb::Error(
+        "--input-repeat-ratio requires --input-data with the inputs to "
+        "repeat",
+        pa::GENERIC_ERROR);
+  }
+  if ((input_repeat_ != nullptr) && data_loader_->IsStreamed()) {
+    // The prefetched steps are released once the requests are past them
+    return cb::Error(
+        "--input-repeat-ratio can not be used with --data-prefetch-steps",
+        pa::GENERIC_ERROR);
+  }
+
+  // Models of the mix may be given a data stream of their own
+  const auto& model_mix = parser_->GetModelMix();
+  if (!input_data_reused_ && (data_shard_count_ > 1) && using_json_data_ &&
+      !data_loader_->IsStreamed()) {
+    RETURN_IF_ERROR(ShardDataStreams());
+  }
+  for (size_t i = 0; (model_mix != nullptr) && (i < model_mix->Size()); i++) {
+    const ModelMixEntry& entry = model_mix->Entry(i);
+    if ((entry.data_stream >= 0) &&
+        (!using_json_data_ ||
+         ((size_t)entry.data_stream >= data_loader_->GetDataStreamsCount()))) {
+      return cb::Error(
+          "data stream " + std::to_string(entry.data_stream) +
+              " of model '" + entry.model_name +
+              "' of the model mix is not in the --input-data files",
+          pa::GENERIC_ERROR);
+    }
+  }
+
   // Reserve the required vector space
   threads_stat_.reserve(max_threads_);
 
   return cb::Error::Success;
 }
 
+cb::Error
+LoadManager::ShardDataStreams()
+{
+  const size_t stream_count = data_loader_->GetDataStreamsCount();
+  const auto& model_mix = parser_->GetModelMix();
+  bool mix_picks_streams = false;
+  for (size_t i = 0; (model_mix != nullptr) && (i < model_mix->Size()); i++) {
+    mix_picks_streams |= (model_mix->Entry(i).data_stream >= 0);
+  }
+  if (mix_picks_streams) {
+    std::cout << " Sending all " << stream_count
+              << " data streams, as the model mix picks streams."
+              << std::endl;
+    return cb::Error::Success;
+  }
+  if (stream_count < data_shard_count_) {
+    std::cout << " Sending all " << stream_count
+              << " data streams, as there are fewer than the "
+              << data_shard_count_ << " clients sharing the load."
+              << std::endl;
+    return cb::Error::Success;
+  }
+
+  RETURN_IF_ERROR(
+      data_loader_->ShardStreams(data_shard_index_, data_shard_count_));
+  std::cout << " Sending " << data_loader_->GetDataStreamsCount() << " of "
+            << stream_count << " data streams, shard " << data_shard_index_
+            << " of " << data_shard_count_ << "." << std::endl;
+  return cb::Error::Success;
+}
+
 void
 LoadManager::StopWorkerThreads()
 {
@@ -270,6 +661,90 @@ LoadManager::StopWorkerThreads()
   threads_.clear();
 }
 
+void
+LoadManager::AddThreadStat()
+{
+  auto thread_stat = std::make_shared<ThreadStat>();
+  thread_stat->record_interval_latencies_ = record_interval_latencies_;
+  thread_stat->record_threshold_latencies_ = record_threshold_latencies_;
+  if (!share_nothing_) {
+    thread_stat->completion_counter_ = completion_counter_;
+  }
+  thread_stat->latency_bucketing_ = latency_bucketing_;
+  thread_stat->request_classes_ = request_classes_;
+  if (request_classes_ != nullptr) {
+    thread_stat->request_class_stats_.resize(request_classes_->Size());
+  }
+  thread_stat->endpoints_ = endpoints_;
+  thread_stat->input_repeat_ = input_repeat_;
+  if (endpoints_ != nullptr) {
+    thread_stat->endpoint_latency_histograms_.resize(endpoints_->Size());
+  }
+  thread_stat->slow_requests_ = SlowRequestTracker(slow_request_count_);
+  if (record_client_stage_times_) {
+    thread_stat->stage_timer_.Enable();
+  }
+  thread_stat->tracer_ = tracer_;
+  thread_stat->schedule_recorder_ = schedule_recorder_;
+  thread_stat->send_delay_us_ = send_delay_us_;
+  thread_stat->backend_pool_ = backend_pool_;
+  thread_stat->output_validator_ = output_validator_;
+  thread_stat->inflight_limiter_ = inflight_limiter_;
+  std::lock_guard<std::mutex> threads_stat_lock(threads_stat_mutex_);
+  thread_stat->worker_index_ = threads_stat_.size();
+  threads_stat_.push_back(thread_stat);
+}
+
+cb::Error
+LoadManager::PrepareClientBackends(
+    size_t count, std::vector<std::unique_ptr<cb::ClientBackend>>* backends)
+{
+  backends->clear();
+  backends->resize(count);
+  std::vector<cb::Error> errors(count);
+  // Setting up a connection mostly waits on the network, so there is no
+  // need for more threads than the load is sent from
+  const size_t helper_count =
+      std::min(count, std::max<size_t>(max_threads_, 1));
+  std::atomic<size_t> next{0};
+  auto prepare = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      errors[i] = factory_->CreateClientBackend(&(*backends)[i]);
+      if (errors[i].IsOk()) {
+        errors[i] = (*backends)[i]->Warmup(1);
+      }
+    }
+  };
+  std::vector<std::thread> helpers;
+  for (size_t i = 1; i < helper_count; i++) {
+    helpers.emplace_back(prepare);
+  }
+  prepare();
+  for (auto& helper : helpers) {
+    helper.join();
+  }
+  for (const auto& error : errors) {
+    RETURN_IF_ERROR(error);
+  }
+  return cb::Error::Success;
+}
+
+void
+LoadManager::PinNewWorkerThread()
+{
+  // The name groups the worker threads in the client resource usage
+  SetThreadName(threads_.back().native_handle(), "pa_worker");
+  if (worker_cpus_.empty()) {
+    return;
+  }
+  const int cpu = worker_cpus_[(threads_.size() - 1) % worker_cpus_.size()];
+  cb::Error err = SetThreadAffinity(threads_.back().native_handle(), {cpu});
+  if (!err.IsOk()) {
+    std::cerr << "WARNING: unable to pin worker thread " << threads_.size() - 1
+              << " to CPU " << cpu << ": " << err.Message() << std::endl;
+  }
+}
+
 std::shared_ptr<SequenceManager>
 LoadManager::MakeSequenceManager(
     const uint64_t start_sequence_id, const uint64_t sequence_id_range,
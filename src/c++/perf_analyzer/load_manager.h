@@ -26,17 +26,27 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <random>
+#include <string>
 #include <thread>
 
 #include "client_backend/client_backend.h"
+#include "completion_counter.h"
 #include "data_loader.h"
+#include "endpoint_mix.h"
 #include "iinfer_data_manager.h"
+#include "input_repeat.h"
+#include "latency_histogram.h"
 #include "load_worker.h"
+#include "output_validator.h"
 #include "perf_utils.h"
+#include "request_class.h"
 #include "sequence_manager.h"
+#include "slow_request_tracker.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -96,6 +106,333 @@ class LoadManager {
   /// \return The total number of sent requests across all threads.
   const size_t GetAndResetNumSentRequests();
 
+  /// Merges the schedule adherence errors recorded by all threads and resets
+  /// them.
+  /// \param schedule_errors Returns the merged histogram of how late each
+  /// request was sent compared to its schedule, in nanoseconds.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetScheduleErrors(LatencyHistogram* schedule_errors);
+
+  /// Collects what the inflight limit did to the requests over it since the
+  /// last call, and resets it.
+  /// \param dropped_count Returns the number of requests dropped.
+  /// \param queue_delays Returns the merged histogram of how long the queued
+  /// requests waited for a slot, in nanoseconds.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetInflightLimitStats(
+      uint64_t* dropped_count, LatencyHistogram* queue_delays);
+
+  /// Merges the latencies measured from the intended send times of the
+  /// scheduled requests recorded by all threads and resets them.
+  /// \param latencies Returns the merged histogram of the corrected
+  /// latencies, in nanoseconds. Empty when the load is not schedule driven.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetCorrectedLatencies(LatencyHistogram* latencies);
+
+  /// Collects the results of the output validation since the last call, and
+  /// resets them. Outputs still queued for validation are counted by a
+  /// later call.
+  /// \param stats Returns the validation statistics.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetValidationStats(ValidationStats* stats);
+
+  /// Makes the worker threads also record the latency of every completed
+  /// request for GetAndResetIntervalLatencies(). Must be called before the
+  /// load starts.
+  void EnableIntervalLatencies() { record_interval_latencies_ = true; }
+
+  /// Makes the worker threads also record the latency of every completed
+  /// request for GetAndResetThresholdLatencies(). Must be called before the
+  /// load starts.
+  void EnableThresholdLatencies() { record_threshold_latencies_ = true; }
+
+  /// Makes the worker threads and their callbacks time the client stages of
+  /// every request for GetAndResetClientStageTimes(). Must be called before
+  /// the load starts.
+  void EnableClientStageTimes() { record_client_stage_times_ = true; }
+
+  /// Caps the number of requests in flight across the worker threads. Must
+  /// be called before the load starts.
+  /// \param max_inflight The maximum number of requests in flight.
+  /// \param overload Whether the requests over the cap are dropped or wait
+  /// for a slot.
+  void SetInflightLimit(size_t max_inflight, InflightOverload overload)
+  {
+    inflight_limiter_ =
+        std::make_shared<InflightLimiter>(max_inflight, overload);
+  }
+
+  /// Makes the worker threads and their callbacks trace the requests sampled
+  /// by the tracer. Must be called before the load starts.
+  /// \param tracer The tracer the spans are recorded by.
+  void SetClientTracer(const std::shared_ptr<ClientTracer>& tracer)
+  {
+    tracer_ = tracer;
+  }
+
+  /// Makes the worker threads record every request they send on a schedule.
+  /// Must be called before the load starts.
+  /// \param recorder The recorder the requests are recorded by.
+  void SetScheduleRecorder(const std::shared_ptr<ScheduleRecorder>& recorder)
+  {
+    schedule_recorder_ = recorder;
+  }
+
+  /// Makes the worker threads wait before sending every request, to
+  /// simulate slow clients. Must be called before the load starts.
+  /// \param delay_us The time waited for before each request is sent, in
+  /// microseconds.
+  void SetSendDelay(uint64_t delay_us) { send_delay_us_ = delay_us; }
+
+  /// Makes the contexts of all the worker threads share a fixed number of
+  /// client backends in round robin instead of creating one each. Must be
+  /// called before the load starts.
+  /// \param backend_count The number of backends shared.
+  void SetSharedBackends(size_t backend_count)
+  {
+    backend_pool_ =
+        std::make_shared<ClientBackendPool>(factory_, backend_count);
+  }
+
+  /// Sets how the outputs are validated against the expected outputs of the
+  /// input data. Must be called before the load starts.
+  /// \param tolerance The tolerance of floating point elements.
+  /// \param thread_count The number of validation threads, 0 to validate on
+  /// the worker threads.
+  void SetOutputValidation(
+      const OutputTolerance& tolerance, const size_t thread_count)
+  {
+    output_validator_ =
+        std::make_shared<OutputValidator>(tolerance, thread_count);
+  }
+
+  /// Makes the worker threads also record the latency of every completed
+  /// request in a bucket for GetAndResetBucketLatencies(). Must be called
+  /// before the load starts.
+  /// \param bucketing What the latencies are broken down by.
+  void EnableLatencyBuckets(LatencyBucketing bucketing)
+  {
+    latency_bucketing_ = bucketing;
+  }
+
+  /// Makes the worker threads spread their requests over request classes,
+  /// which set the priority and the server timeout of the requests, and
+  /// measure each class for GetAndResetRequestClassStats(). Must be called
+  /// before the load starts.
+  /// \param request_classes The request classes to spread the requests over.
+  void EnableRequestClasses(
+      const std::shared_ptr<const RequestClassMix>& request_classes)
+  {
+    request_classes_ = request_classes;
+  }
+
+  /// Makes the worker threads spread their requests over several endpoints
+  /// and measure each endpoint for GetAndResetEndpointLatencies(). Must be
+  /// called before the load starts.
+  /// \param endpoints The endpoints to spread the requests over.
+  void EnableEndpoints(const std::shared_ptr<const EndpointMix>& endpoints)
+  {
+    endpoints_ = endpoints;
+  }
+
+  /// Makes every worker thread keep its slowest requests for
+  /// GetAndResetSlowRequests(). Must be called before the load starts.
+  /// \param count The number of requests each thread keeps.
+  void SetSlowRequestCount(size_t count) { slow_request_count_ = count; }
+
+  /// Makes every context build the inputs of all the data steps once, so
+  /// sending a request no longer copies the input data. Each context holds
+  /// its own copy of the whole data set. Must be called before the load
+  /// starts.
+  void EnablePrestagedInputs();
+
+  /// Makes the --input-data directory be read as a subdirectory per step,
+  /// the given number of steps ahead of the requests while they are sent.
+  /// Must be called before InitManager().
+  /// \param prefetch_steps The number of steps to read ahead.
+  void SetDataPrefetchSteps(const size_t prefetch_steps)
+  {
+    data_loader_->SetPrefetchSteps(prefetch_steps);
+  }
+
+  /// Makes the shared memory inputs come from a pool of regions registered
+  /// once, which the data steps are staged into ahead of the requests that
+  /// use them, instead of one region per input and step. Must be called
+  /// before InitManager().
+  /// \param pool_size The number of regions per input. Must be larger than
+  /// the maximum number of requests in flight.
+  void EnableSharedMemoryPool(const size_t pool_size);
+
+  /// Makes every request write its shared memory outputs to an output slot
+  /// of its own, held until it completes, instead of all requests sharing
+  /// one region per output. Must be called before InitManager().
+  /// \param output_slots The number of output slots. Requests wait for a
+  /// free slot when they are all in use.
+  void EnableOutputSharedMemorySlots(const size_t output_slots);
+
+  /// Sets the placement of the pages of the system shared memory regions.
+  /// Must be called before InitManager().
+  /// \param options The options of the regions.
+  void SetSharedMemoryOptions(const cb::SharedMemoryOptions& options);
+
+  /// Makes the callback of an asynchronous request send the next request of
+  /// its context, instead of waking up the worker thread to do it. Only the
+  /// concurrency mode makes use of it. Must be called before the load starts.
+  void EnableAsyncContinuations() { async_continuations_ = true; }
+
+  /// Makes the workers add or retire contexts while the others keep sending
+  /// when the load level changes, instead of pausing all of them. Only the
+  /// concurrency mode makes use of it. Must be called before the load starts.
+  void EnableWarmRamp() { warm_ramp_ = true; }
+
+  /// Makes each context drive several sequences, sending a step of each of
+  /// them in turn. The server can then batch the steps of more sequences
+  /// than there are requests in flight. Only the concurrency mode makes use
+  /// of it. Must be called before the load starts.
+  /// \param sequences The number of sequences of each context.
+  void SetSequencesPerContext(const size_t sequences)
+  {
+    sequences_per_context_ = sequences;
+  }
+
+  /// Makes this client send only its share of the data streams of the
+  /// --input-data, when it shares a load with other clients that hold the
+  /// same data. The streams are only split when there are at least as many
+  /// of them as clients and the model mix does not pick them. Must be
+  /// called before InitManager().
+  /// \param shard_index The index of this client among the clients.
+  /// \param shard_count The number of clients sharing the load.
+  void SetDataShard(const size_t shard_index, const size_t shard_count)
+  {
+    data_shard_index_ = shard_index;
+    data_shard_count_ = shard_count;
+  }
+
+  /// Makes the worker threads pick the inputs of their requests so that a
+  /// share of them repeats an input sent before, instead of sending the
+  /// steps of the --input-data in turn. Does not apply to the requests of
+  /// sequences. Must be called before InitManager().
+  /// \param input_repeat Picks the inputs of the requests.
+  void EnableInputRepeat(const std::shared_ptr<InputRepeat>& input_repeat)
+  {
+    input_repeat_ = input_repeat;
+  }
+
+  /// Makes InitManager() take the input data that another load manager read
+  /// instead of reading it again, such as when the load is run again with
+  /// another batch size. The steps are only gathered into batches when the
+  /// requests are built, so the data holds for any batch size. Must be
+  /// called before InitManager(), while the other load manager still exists.
+  /// \param other The load manager whose input data to take.
+  void ReuseInputData(const LoadManager& other)
+  {
+    data_loader_ = other.data_loader_;
+    using_json_data_ = other.using_json_data_;
+    input_data_reused_ = true;
+    ResetInferDataManager();
+  }
+
+  /// Draws the lengths of new sequences from the given distribution, instead
+  /// of varying them uniformly around the sequence length. Must be called
+  /// before InitManager().
+  /// \param distribution The distribution of the sequence lengths.
+  void SetSequenceLengthDistribution(
+      std::shared_ptr<const SequenceDistribution> distribution)
+  {
+    sequence_length_distribution_ = distribution;
+  }
+
+  /// Draws the shapes of the generated inputs from the given distributions,
+  /// instead of sending the same shapes in every request. Must be called
+  /// before InitManager().
+  /// \param distributions The distributions of the dimensions to vary.
+  /// \param shape_count The number of shapes to draw.
+  void SetInputShapeDistributions(
+      const std::vector<std::shared_ptr<const ShapeDistribution>>&
+          distributions,
+      const size_t shape_count)
+  {
+    data_loader_->SetShapeDistributions(distributions, shape_count);
+  }
+
+  /// Makes each context wait between the response to a step of a sequence
+  /// and the next step, like a user thinking before the next turn. Only the
+  /// concurrency mode makes use of it. Must be called before the load starts.
+  /// \param distribution The distribution of the think times, in msec.
+  void SetSequenceThinkTime(
+      std::shared_ptr<const SequenceDistribution> distribution)
+  {
+    sequence_think_time_ = distribution;
+  }
+
+  /// Pins each worker thread to one of the given CPUs, taken in turn. Must be
+  /// called before the load starts.
+  /// \param cpus The CPUs of the worker threads.
+  void SetWorkerCpus(const std::vector<int>& cpus) { worker_cpus_ = cpus; }
+
+  /// Makes each worker thread own its infer data manager and sequence
+  /// manager, and count its completed requests on its own, so that the
+  /// threads share no state while they send requests. Each thread is pinned
+  /// to a CPU of its own, those given to SetWorkerCpus() or else those the
+  /// process may run on. Must be called before InitManager(), after
+  /// SetWorkerCpus().
+  void SetShareNothing();
+
+  /// Merges the latencies recorded by all threads since the last call and
+  /// resets them. Unlike SwapTimestamps(), this does not take the requests
+  /// away from the profiler.
+  /// \param latencies Returns the merged histogram of request latencies in
+  /// nanoseconds.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetIntervalLatencies(LatencyHistogram* latencies);
+
+  /// Merges the latencies recorded by all threads for the latency threshold
+  /// since the last call and resets them. Independent of the interval
+  /// latencies, so both can be collected at their own pace.
+  /// \param latencies Returns the merged histogram of request latencies in
+  /// nanoseconds. Empty unless EnableThresholdLatencies() was called.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetThresholdLatencies(LatencyHistogram* latencies);
+
+  /// Merges the latencies recorded by all threads in each bucket since the
+  /// last call and resets them.
+  /// \param buckets Returns the merged histogram of request latencies in
+  /// nanoseconds of each bucket. Empty unless EnableLatencyBuckets() was
+  /// called.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetBucketLatencies(
+      std::map<std::string, LatencyHistogram>* buckets);
+
+  /// Merges what the requests of each request class came to in all threads
+  /// since the last call and resets it.
+  /// \param stats Returns the stats of each request class by name. Empty
+  /// unless EnableRequestClasses() was called.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetRequestClassStats(
+      std::map<std::string, RequestClassStats>* stats);
+
+  /// Merges the latencies of the requests to each endpoint recorded by all
+  /// threads since the last call and resets them.
+  /// \param latencies Returns the latencies of each endpoint by url. Empty
+  /// unless EnableEndpoints() was called.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error GetAndResetEndpointLatencies(
+      std::map<std::string, LatencyHistogram>* latencies);
+
+  /// Merges the slowest requests kept by all threads since the last call
+  /// and resets them.
+  /// \param slow_requests Returns the slowest of the requests, up to the
+  /// count of SetSlowRequestCount(). Empty unless it was called.
+  void GetAndResetSlowRequests(SlowRequestTracker* slow_requests);
+
+  /// Sums the client stage times recorded by all threads since the last call
+  /// and resets them.
+  /// \param times Returns the time spent in each client stage.
+  void GetAndResetClientStageTimes(ClientStageTimes* times);
+
+  /// \return The number of requests sent that have not completed yet.
+  size_t GetNumInflightRequests();
+
   /// \return the batch size used for the inference requests
   size_t BatchSize() const { return batch_size_; }
 
@@ -111,6 +448,23 @@ class LoadManager {
   /// Count the number of requests collected until now.
   uint64_t CountCollectedRequests();
 
+  /// Wait until at least 'count' requests are collected, without polling.
+  /// \param count The number of requests to wait for.
+  /// \param timeout The longest time to wait.
+  /// \return Whether the requests were collected before the timeout.
+  bool WaitForCollectedRequests(
+      uint64_t count, std::chrono::nanoseconds timeout);
+
+  /// Writes the user provided data read by InitManager() to a binary input
+  /// corpus that can be passed as --input-data to later runs.
+  /// \param path The path of the corpus file to write.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error WriteInputCorpus(const std::string& path)
+  {
+    return data_loader_->WriteCorpus(
+        parser_->Inputs(), parser_->Outputs(), path);
+  }
+
  protected:
   LoadManager(
       const bool async, const bool streaming, const int32_t batch_size,
@@ -133,9 +487,42 @@ class LoadManager {
       const size_t string_length, const std::string& string_data,
       const bool zero_input, std::vector<std::string>& user_data);
 
+  /// Keeps the share of the data streams set by SetDataShard(), when they
+  /// can be split.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error ShardDataStreams();
+
   /// Stops all the worker threads generating the request load.
   void StopWorkerThreads();
 
+  /// Appends the statistics of a new worker thread to threads_stat_.
+  void AddThreadStat();
+
+  /// Names the last thread of threads_ and pins it to its worker CPU, if any
+  /// were given.
+  void PinNewWorkerThread();
+
+  /// Creates client backends and sets up their connections on parallel
+  /// threads, so that the contexts about to be created do not set them up
+  /// one after the other.
+  /// \param count The number of backends to create.
+  /// \param backends Returns the backends created.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error PrepareClientBackends(
+      size_t count, std::vector<std::unique_ptr<cb::ClientBackend>>* backends);
+
+  /// Recreates infer_data_manager_ with the current data options.
+  void ResetInferDataManager();
+
+  /// \return The infer data manager of a new worker thread: one of its own
+  /// if nothing is shared between the threads, otherwise infer_data_manager_.
+  std::shared_ptr<IInferDataManager> WorkerInferDataManager();
+
+  /// \return The sequence manager of a new worker thread: one of its own,
+  /// with the same sequence statuses as sequence_manager_, if nothing is
+  /// shared between the threads, otherwise sequence_manager_.
+  std::shared_ptr<SequenceManager> WorkerSequenceManager();
+
  protected:
   bool async_;
   bool streaming_;
@@ -147,10 +534,30 @@ class LoadManager {
   std::shared_ptr<cb::ClientBackendFactory> factory_;
 
   bool using_json_data_;
+  // Whether data_loader_ was read by another load manager, see
+  // ReuseInputData()
+  bool input_data_reused_{false};
 
   std::shared_ptr<DataLoader> data_loader_;
   std::unique_ptr<cb::ClientBackend> backend_;
   std::shared_ptr<IInferDataManager> infer_data_manager_;
+  SharedMemoryType shared_memory_type_;
+  size_t output_shm_size_;
+  bool prestage_inputs_{false};
+  size_t shm_pool_size_{0};
+  size_t output_shm_slots_{0};
+  cb::SharedMemoryOptions shm_options_;
+  std::vector<int> worker_cpus_;
+  // Whether the worker threads share no state, see SetShareNothing()
+  bool share_nothing_{false};
+  bool async_continuations_{false};
+  bool warm_ramp_{false};
+  size_t sequences_per_context_{1};
+  std::shared_ptr<const SequenceDistribution> sequence_length_distribution_;
+  std::shared_ptr<const SequenceDistribution> sequence_think_time_;
+  // The share of the data streams this client sends, see SetDataShard()
+  size_t data_shard_index_{0};
+  size_t data_shard_count_{1};
 
   // Track the workers so they all go out of scope at the
   // same time
@@ -160,12 +567,55 @@ class LoadManager {
   std::vector<std::thread> threads_;
   // Contains the statistics on the current working threads
   std::vector<std::shared_ptr<ThreadStat>> threads_stat_;
+  // Protects threads_stat_ from growing while it is read by other threads
+  // than the one driving the load
+  std::mutex threads_stat_mutex_;
+  // Whether new threads record their latencies for the time series
+  bool record_interval_latencies_{false};
+  // Whether new threads record their latencies for the latency threshold
+  bool record_threshold_latencies_{false};
+  // Whether new threads time the client stages of their requests
+  bool record_client_stage_times_{false};
+  // Traces the requests of new threads, if not null
+  std::shared_ptr<ClientTracer> tracer_;
+  // Records the scheduled requests of new threads, if not null
+  std::shared_ptr<ScheduleRecorder> schedule_recorder_;
+  // The time new threads wait for before sending each request, in
+  // microseconds
+  uint64_t send_delay_us_{0};
+  // The backends shared by the contexts of new threads, if not null
+  std::shared_ptr<ClientBackendPool> backend_pool_;
+  // Validates the outputs of all the threads
+  std::shared_ptr<OutputValidator> output_validator_{
+      std::make_shared<OutputValidator>(OutputTolerance(), 1)};
+  // Caps the requests in flight of all the threads, if not null
+  std::shared_ptr<InflightLimiter> inflight_limiter_;
+  // What new threads break their latencies down by
+  LatencyBucketing latency_bucketing_{BUCKET_NONE};
+  // The request classes new threads spread their requests over, if not null
+  std::shared_ptr<const RequestClassMix> request_classes_;
+  // The endpoints new threads spread their requests over, if not null
+  std::shared_ptr<const EndpointMix> endpoints_;
+  // The number of slowest requests each new thread keeps
+  size_t slow_request_count_{0};
+  // Picks the inputs of the requests of all the threads, if not null
+  std::shared_ptr<InputRepeat> input_repeat_;
+  // Counts the requests completed by all the threads
+  std::shared_ptr<CompletionCounter> completion_counter_{
+      std::make_shared<CompletionCounter>()};
 
   // Use condition variable to pause/continue worker threads
   std::condition_variable wake_signal_;
   std::mutex wake_mutex_;
 
   std::shared_ptr<SequenceManager> sequence_manager_{nullptr};
+  // The sequence options given to InitManager(), for the sequence managers
+  // of the worker threads
+  uint64_t start_sequence_id_{0};
+  uint64_t sequence_id_range_{0};
+  size_t sequence_length_{0};
+  bool sequence_length_specified_{false};
+  double sequence_length_variation_{0.0};
 
   virtual std::shared_ptr<SequenceManager> MakeSequenceManager(
       const uint64_t start_sequence_id, const uint64_t sequence_id_range,
@@ -71,20 +71,34 @@ class LoadWorker : public IWorker {
   // finished
   uint GetNumOngoingRequests();
 
-  void SendInferRequest(uint32_t ctx_id, bool delayed = false)
+  // The data stream only applies to non-sequence models. Sequences keep the
+  // stream they were started with.
+  void SendInferRequest(
+      uint32_t ctx_id, bool delayed = false, uint64_t data_stream_id = 0)
   {
     if (ShouldExit()) {
       return;
     }
 
     if (on_sequence_model_) {
-      uint32_t seq_stat_index = GetSeqStatIndex(ctx_id);
+      uint32_t seq_stat_index = NextSeqStatIndex(ctx_id);
       ctxs_[ctx_id]->SendSequenceInferRequest(seq_stat_index, delayed);
     } else {
-      ctxs_[ctx_id]->SendInferRequest(delayed);
+      ctxs_[ctx_id]->SendInferRequest(delayed, data_stream_id);
     }
   }
 
+  // Sends a request exactly as it was recorded, bypassing the sequence
+  // manager
+  void SendReplayedRequest(
+      uint32_t ctx_id, bool delayed, const ScheduleRecord& record)
+  {
+    if (ShouldExit()) {
+      return;
+    }
+    ctxs_[ctx_id]->SendReplayedRequest(record, delayed);
+  }
+
   virtual std::shared_ptr<InferContext> CreateInferContext()
   {
     return std::make_shared<InferContext>(
@@ -107,6 +121,12 @@ class LoadWorker : public IWorker {
   bool HandleExitConditions();
 
   virtual uint32_t GetSeqStatIndex(uint32_t ctx_id) = 0;
+
+  // The sequence status that the next request of a context goes to
+  virtual uint32_t NextSeqStatIndex(uint32_t ctx_id)
+  {
+    return GetSeqStatIndex(ctx_id);
+  }
   virtual void CompleteOngoingSequences() = 0;
 
   void WaitForOngoingRequests();
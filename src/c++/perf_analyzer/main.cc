@@ -24,11 +24,63 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "experiment_runner.h"
 #include "perf_analyzer.h"
 #include "perf_analyzer_exception.h"
 
 namespace pa = triton::perfanalyzer;
 
+namespace {
+
+void
+RunExperiment(const std::string& experiment_file, int argc, char* argv[])
+{
+  // The other options of the command line apply to every configuration
+  std::vector<std::string> base_args;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--experiment-file") {
+      i++;
+    } else if (arg.rfind("--experiment-file=", 0) != 0) {
+      base_args.push_back(arg);
+    }
+  }
+
+  std::unique_ptr<pa::ExperimentRunner> runner;
+  FAIL_IF_ERR(
+      pa::ExperimentRunner::Create(experiment_file, base_args, &runner),
+      "failed to read the experiment file");
+  FAIL_IF_ERR(
+      runner->Run([argv](const std::vector<std::string>& args) {
+        std::vector<char*> run_argv{argv[0]};
+        for (const auto& arg : args) {
+          run_argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        // The previous configuration left getopt at its end and early_exit
+        // set by stopping its load
+        optind = 1;
+        pa::early_exit = false;
+
+        pa::CLParser clp;
+        pa::PAParamsPtr params = clp.Parse(run_argv.size(), run_argv.data());
+        if (params->enable_mpi) {
+          // MPI can only be finalized once per process
+          std::cerr << "error: --enable-mpi is not supported with "
+                    << "--experiment-file" << std::endl;
+          throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+        }
+        PerfAnalyzer analyzer(params);
+        analyzer.Run();
+        return !pa::interrupted;
+      }),
+      "failed to run the experiment");
+  FAIL_IF_ERR(
+      runner->ReportParetoFrontier(std::cout),
+      "failed to read the reports of the experiment");
+}
+
+}  // namespace
+
 int
 main(int argc, char* argv[])
 {
@@ -36,6 +88,11 @@ main(int argc, char* argv[])
     triton::perfanalyzer::CLParser clp;
     pa::PAParamsPtr params = clp.Parse(argc, argv);
 
+    if (!params->experiment_file.empty()) {
+      RunExperiment(params->experiment_file, argc, argv);
+      return 0;
+    }
+
     PerfAnalyzer analyzer(params);
     analyzer.Run();
   }
@@ -39,6 +39,30 @@ struct Metrics {
   std::map<std::string, double> gpu_power_usage_per_gpu{};
   std::map<std::string, uint64_t> gpu_memory_used_bytes_per_gpu{};
   std::map<std::string, uint64_t> gpu_memory_total_bytes_per_gpu{};
+  // The samples of the other metric families that are collected, keyed by the
+  // metric name with its labels, such as
+  // 'nv_inference_count{model="m",version="1"}'. Once merged over measurement
+  // windows, gauges are averaged and counters hold their increase.
+  std::map<std::string, double> gauges{};
+  std::map<std::string, double> counters{};
+  // When the metrics were scraped, in nsec since the epoch of the system
+  // clock. 0 once merged over measurement windows.
+  uint64_t timestamp_ns{0};
+};
+
+/// Relates the metrics scraped during a measurement to its load.
+struct MetricsCorrelation {
+  // The throughput for each watt drawn by all the GPUs together on average
+  double infer_per_sec_per_watt{0};
+  // The average utilization of the GPUs when the requests at or above the
+  // 99th percentile latency completed, taken from the closest scrape, and the
+  // number of those requests
+  double tail_gpu_utilization{0};
+  uint64_t tail_request_count{0};
+  // The least free memory of any GPU over the scrapes, and how fast the
+  // memory used by all the GPUs together grew, by a least squares fit
+  uint64_t min_gpu_memory_headroom_bytes{0};
+  double gpu_memory_trend_bytes_per_sec{0};
 };
 
 }}  // namespace triton::perfanalyzer
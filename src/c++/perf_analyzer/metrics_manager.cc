@@ -69,13 +69,19 @@ MetricsManager::QueryMetricsEveryNMilliseconds()
 
     CheckForMissingMetrics(metrics);
 
+    const auto& end{std::chrono::system_clock::now()};
+    const auto& duration{end - start};
+    // The scrape is taken to happen halfway through the query
+    metrics.timestamp_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            (start + duration / 2).time_since_epoch())
+            .count();
+
     {
       std::lock_guard<std::mutex> metrics_lock{metrics_mutex_};
       metrics_.push_back(std::move(metrics));
     }
 
-    const auto& end{std::chrono::system_clock::now()};
-    const auto& duration{end - start};
     const auto& remainder{std::chrono::milliseconds(metrics_interval_ms_) -
                           duration};
 
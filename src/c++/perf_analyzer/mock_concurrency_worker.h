@@ -46,12 +46,17 @@ class NaggyMockConcurrencyWorker : public ConcurrencyWorker {
       std::condition_variable& wake_signal, std::mutex& wake_mutex,
       size_t& active_threads, bool& execute,
       const std::shared_ptr<IInferDataManager>& infer_data_manager,
-      std::shared_ptr<SequenceManager> sequence_manager)
+      std::shared_ptr<SequenceManager> sequence_manager,
+      const bool async_continuations = false, const bool warm_ramp = false,
+      const size_t sequences_per_context = 1,
+      std::shared_ptr<const SequenceDistribution> think_time = nullptr)
       : ConcurrencyWorker(
             id, thread_stat, thread_config, parser, data_loader, factory,
             on_sequence_model, async, max_concurrency, using_json_data,
             streaming, batch_size, threads_config, wake_signal, wake_mutex,
-            active_threads, execute, infer_data_manager, sequence_manager)
+            active_threads, execute, infer_data_manager, sequence_manager,
+            async_continuations, warm_ramp, sequences_per_context,
+            think_time)
   {
     ON_CALL(*this, Infer()).WillByDefault([this]() -> void {
       ConcurrencyWorker::Infer();
@@ -34,6 +34,15 @@ class MockInferContext : public InferContext {
  public:
   MOCK_METHOD(void, SendRequest, (const uint64_t, const bool), (override));
 
+  using InferContext::AdmitRequest;
+  using InferContext::IsClassRejection;
+  using InferContext::PickEndpoint;
+  using InferContext::PickRequestClass;
+  using InferContext::RecordCorrectedLatency;
+  using InferContext::RecordSlowRequest;
+  using InferContext::SetRequestIds;
+  using InferContext::TakeScheduleLag;
+
   std::shared_ptr<SequenceManager>& sequence_manager_{
       InferContext::sequence_manager_};
   std::shared_ptr<DataLoader>& data_loader_{InferContext::data_loader_};
@@ -42,6 +51,9 @@ class MockInferContext : public InferContext {
   std::shared_ptr<ThreadStat>& thread_stat_{InferContext::thread_stat_};
   std::reference_wrapper<const bool>& execute_{InferContext::execute_};
   bool& using_json_data_{InferContext::using_json_data_};
+  InferData& infer_data_{InferContext::infer_data_};
+  std::shared_ptr<const ModelMix>& model_mix_{InferContext::model_mix_};
+  size_t& endpoint_{InferContext::endpoint_};
 };
 
 }}  // namespace triton::perfanalyzer
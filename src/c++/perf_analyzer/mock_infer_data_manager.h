@@ -39,10 +39,11 @@ class MockInferDataManagerShm : public InferDataManagerShm {
       const int32_t batch_size, const SharedMemoryType shared_memory_type,
       const size_t output_shm_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const size_t pool_size = 0, const size_t output_slots = 0)
       : InferDataManagerShm(
             batch_size, shared_memory_type, output_shm_size, parser, factory,
-            data_loader)
+            data_loader, pool_size, output_slots)
   {
   }
 
@@ -85,8 +86,10 @@ class MockInferDataManager : public InferDataManager {
   MockInferDataManager(
       const int32_t batch_size, const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
-      const std::shared_ptr<DataLoader>& data_loader)
-      : InferDataManager(batch_size, parser, factory, data_loader)
+      const std::shared_ptr<DataLoader>& data_loader,
+      const bool prestage_inputs = false)
+      : InferDataManager(
+            batch_size, parser, factory, data_loader, prestage_inputs)
   {
     SetupMocks();
   }
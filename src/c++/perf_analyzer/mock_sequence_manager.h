@@ -84,6 +84,7 @@ class NaggyMockSequenceManager : public SequenceManager {
   std::vector<std::shared_ptr<SequenceStatus>>& sequence_statuses_{
       SequenceManager::sequence_statuses_};
   std::atomic<uint64_t>& curr_seq_id_{SequenceManager::curr_seq_id_};
+  size_t& sequence_id_ranges_{SequenceManager::sequence_id_ranges_};
 };
 
 using MockSequenceManager = testing::NiceMock<NaggyMockSequenceManager>;
@@ -0,0 +1,253 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "model_load_benchmark.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+#include "metrics.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// How often and how long the metadata of an unloaded model is polled
+constexpr std::chrono::milliseconds kUnloadPollInterval{10};
+constexpr std::chrono::minutes kUnloadTimeout{5};
+
+uint64_t
+ElapsedNs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Prints the average, median, 99th percentile and maximum of the values,
+// divided by 'unit'
+template <typename T>
+void
+PrintSummary(
+    const std::string& name, std::vector<T> values, double unit,
+    const std::string& unit_name, std::ostream& out)
+{
+  std::sort(values.begin(), values.end());
+  double sum = 0;
+  for (const auto value : values) {
+    sum += value;
+  }
+  const auto percentile = [&values](size_t p) {
+    const size_t rank = (values.size() * p + 99) / 100;
+    return values[std::max<size_t>(rank, 1) - 1];
+  };
+  out << "  " << name << ": avg " << sum / values.size() / unit << " "
+      << unit_name << ", p50 " << percentile(50) / unit << " " << unit_name
+      << ", p99 " << percentile(99) / unit << " " << unit_name << ", max "
+      << values.back() / unit << " " << unit_name << std::endl;
+}
+
+}  // namespace
+
+ModelLoadBenchmark::ModelLoadBenchmark(
+    cb::ClientBackend* backend, const std::string& model_name,
+    const std::string& config, InferFn infer,
+    std::chrono::milliseconds metrics_interval)
+    : backend_(backend), model_name_(model_name), config_(config),
+      infer_(std::move(infer)), metrics_interval_(metrics_interval)
+{
+}
+
+cb::Error
+ModelLoadBenchmark::Run(
+    size_t iterations, std::vector<ModelLoadSample>* samples)
+{
+  samples->clear();
+  samples->reserve(iterations);
+  for (size_t i = 0; i < iterations; i++) {
+    ModelLoadSample sample;
+
+    auto start = std::chrono::steady_clock::now();
+    RETURN_IF_ERROR(backend_->UnloadModel(model_name_));
+    RETURN_IF_ERROR(WaitForUnload());
+    sample.unload_ns = ElapsedNs(start);
+
+    uint64_t memory_before = 0;
+    if (metrics_interval_.count() != 0) {
+      RETURN_IF_ERROR(GpuMemoryUsed(&memory_before));
+    }
+
+    start = std::chrono::steady_clock::now();
+    RETURN_IF_ERROR(backend_->LoadModel(model_name_, config_));
+    sample.load_ns = ElapsedNs(start);
+    RETURN_IF_ERROR(infer_());
+    sample.first_infer_ns = ElapsedNs(start);
+
+    if (metrics_interval_.count() != 0) {
+      uint64_t memory_after = 0;
+      RETURN_IF_ERROR(GpuMemoryUsed(&memory_after));
+      sample.gpu_memory_delta_bytes =
+          static_cast<int64_t>(memory_after - memory_before);
+    }
+    samples->push_back(sample);
+  }
+  return cb::Error::Success;
+}
+
+void
+ModelLoadBenchmark::Report(
+    const std::vector<ModelLoadSample>& samples, bool with_gpu_memory,
+    std::ostream& out)
+{
+  if (samples.empty()) {
+    return;
+  }
+  std::vector<uint64_t> unload, load, first_infer;
+  std::vector<int64_t> gpu_memory;
+  for (const auto& sample : samples) {
+    unload.push_back(sample.unload_ns);
+    load.push_back(sample.load_ns);
+    first_infer.push_back(sample.first_infer_ns);
+    gpu_memory.push_back(sample.gpu_memory_delta_bytes);
+  }
+  std::ios format(nullptr);
+  format.copyfmt(out);
+  out << "Model load (" << samples.size() << " iterations)" << std::endl;
+  out << std::fixed << std::setprecision(2);
+  PrintSummary("Unload", unload, NANOS_PER_MILLIS, "ms", out);
+  PrintSummary("Load", load, NANOS_PER_MILLIS, "ms", out);
+  PrintSummary(
+      "Time to first inference", first_infer, NANOS_PER_MILLIS, "ms", out);
+  if (with_gpu_memory) {
+    PrintSummary("GPU memory delta", gpu_memory, 1024.0 * 1024.0, "MB", out);
+  }
+  out.copyfmt(format);
+}
+
+cb::Error
+ModelLoadBenchmark::ZeroRequest(
+    cb::ClientBackend* backend, const std::string& model_name,
+    const std::string& model_version, const ModelTensorMap& inputs,
+    bool batching, InferFn* infer)
+{
+  // Owns the inputs for as long as the function is kept
+  struct Request {
+    ~Request()
+    {
+      for (auto input : inputs) {
+        delete input;
+      }
+    }
+    std::vector<cb::InferInput*> inputs;
+    std::vector<std::vector<uint8_t>> data;
+  };
+  auto request = std::make_shared<Request>();
+
+  for (const auto& entry : inputs) {
+    const ModelTensor& tensor = entry.second;
+    if (tensor.is_optional_) {
+      continue;
+    }
+    std::vector<int64_t> shape;
+    if (batching) {
+      shape.push_back(1);
+    }
+    for (const auto dim : tensor.shape_) {
+      shape.push_back(dim < 0 ? 1 : dim);
+    }
+    const int64_t count = ElementCount(shape);
+
+    std::vector<uint8_t> data;
+    if (tensor.type_ == DataType::BYTES) {
+      // Each empty string is its 4 byte length
+      data.resize(count * sizeof(uint32_t));
+    } else if (tensor.is_shape_tensor_ && (tensor.type_ == DataType::INT32)) {
+      const std::vector<int32_t> ones(count, 1);
+      data.resize(count * sizeof(int32_t));
+      std::memcpy(data.data(), ones.data(), data.size());
+    } else if (tensor.is_shape_tensor_ && (tensor.type_ == DataType::INT64)) {
+      const std::vector<int64_t> ones(count, 1);
+      data.resize(count * sizeof(int64_t));
+      std::memcpy(data.data(), ones.data(), data.size());
+    } else {
+      data.resize(count * DataTypeByteSize(tensor.type_));
+    }
+
+    cb::InferInput* input;
+    RETURN_IF_ERROR(cb::InferInput::Create(
+        &input, backend->Kind(), tensor.name_, shape, tensor.datatype_));
+    request->inputs.push_back(input);
+    request->data.push_back(std::move(data));
+    RETURN_IF_ERROR(input->AppendRaw(
+        request->data.back().data(), request->data.back().size()));
+  }
+
+  cb::InferOptions options(model_name);
+  options.model_version_ = model_version;
+  *infer = [backend, options, request]() {
+    cb::InferResult* result = nullptr;
+    RETURN_IF_ERROR(backend->Infer(&result, options, request->inputs, {}));
+    std::unique_ptr<cb::InferResult> result_ptr(result);
+    return result_ptr->RequestStatus();
+  };
+  return cb::Error::Success;
+}
+
+cb::Error
+ModelLoadBenchmark::WaitForUnload()
+{
+  // The server may return before the model is unloaded
+  const auto deadline = std::chrono::steady_clock::now() + kUnloadTimeout;
+  while (true) {
+    rapidjson::Document metadata;
+    if (!backend_->ModelMetadata(&metadata, model_name_, "").IsOk()) {
+      return cb::Error::Success;
+    }
+    if (std::chrono::steady_clock::now() > deadline) {
+      return cb::Error(
+          "model '" + model_name_ + "' is still served after unloading it",
+          pa::GENERIC_ERROR);
+    }
+    std::this_thread::sleep_for(kUnloadPollInterval);
+  }
+}
+
+cb::Error
+ModelLoadBenchmark::GpuMemoryUsed(uint64_t* bytes)
+{
+  // The server only refreshes its metrics once per interval
+  std::this_thread::sleep_for(metrics_interval_);
+  Metrics metrics;
+  RETURN_IF_ERROR(backend_->Metrics(metrics));
+  *bytes = 0;
+  for (const auto& gpu : metrics.gpu_memory_used_bytes_per_gpu) {
+    *bytes += gpu.second;
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
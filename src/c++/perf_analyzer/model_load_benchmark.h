@@ -0,0 +1,117 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "client_backend/client_backend.h"
+#include "model_parser.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// What one unload and load cycle of a model took
+struct ModelLoadSample {
+  // From the unload request until the model stopped being served
+  uint64_t unload_ns{0};
+  // The duration of the load request
+  uint64_t load_ns{0};
+  // From the load request until the response of the first inference
+  uint64_t first_infer_ns{0};
+  // The memory used by all the GPUs together after the first inference less
+  // the memory used before the load, 0 if the metrics are not collected
+  int64_t gpu_memory_delta_bytes{0};
+};
+
+/// Measures the cold start of a model by unloading and loading it over and
+/// over, instead of profiling its inferences. Each iteration unloads the
+/// model and waits until its metadata is no longer served, then loads it and
+/// sends one request, timing both from the start of the load. The model is
+/// left loaded.
+class ModelLoadBenchmark {
+ public:
+  /// Sends one inference request to the model and waits for its response.
+  using InferFn = std::function<cb::Error()>;
+
+  /// \param backend The backend that loads and unloads the model.
+  /// \param model_name The name of the model.
+  /// \param config If not empty, the JSON model config to load the model
+  /// with.
+  /// \param infer Sends the first request after each load.
+  /// \param metrics_interval If not zero, the GPU memory is taken from the
+  /// metrics of the server before each load and after each first inference,
+  /// waiting this long before each scrape so that the server refreshes them.
+  ModelLoadBenchmark(
+      cb::ClientBackend* backend, const std::string& model_name,
+      const std::string& config, InferFn infer,
+      std::chrono::milliseconds metrics_interval);
+
+  /// \param iterations The number of unload and load cycles.
+  /// \param samples Returns what each cycle took.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Run(size_t iterations, std::vector<ModelLoadSample>* samples);
+
+  /// Prints the average, median, 99th percentile and maximum of each
+  /// measurement of the samples.
+  static void Report(
+      const std::vector<ModelLoadSample>& samples, bool with_gpu_memory,
+      std::ostream& out);
+
+  /// Makes a function sending a request of zeros to a model, with batch size
+  /// 1 for models that batch. The dimensions still variable in the shapes of
+  /// the inputs are 1, as are the elements of shape tensors, and optional
+  /// inputs are left out.
+  /// \param backend The backend to send the request with.
+  /// \param model_name The name of the model.
+  /// \param model_version The version of the model, empty for the latest.
+  /// \param inputs The inputs of the model.
+  /// \param batching Whether the model batches requests.
+  /// \param infer Returns the function.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error ZeroRequest(
+      cb::ClientBackend* backend, const std::string& model_name,
+      const std::string& model_version, const ModelTensorMap& inputs,
+      bool batching, InferFn* infer);
+
+ private:
+  // Waits until the metadata of the model is no longer served
+  cb::Error WaitForUnload();
+  // The memory used by all the GPUs together
+  cb::Error GpuMemoryUsed(uint64_t* bytes);
+
+  cb::ClientBackend* backend_;
+  const std::string model_name_;
+  const std::string config_;
+  InferFn infer_;
+  const std::chrono::milliseconds metrics_interval_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,160 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "model_mix.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+cb::Error
+ParseModelMix(const std::string& spec, std::vector<ModelMixEntry>* entries)
+{
+  std::vector<ModelMixEntry> parsed;
+  std::stringstream spec_stream(spec);
+  std::string item;
+  while (std::getline(spec_stream, item, ',')) {
+    ModelMixEntry entry;
+    const size_t stream_start = item.find('@');
+    if (stream_start != std::string::npos) {
+      const std::string stream = item.substr(stream_start + 1);
+      size_t parsed_chars = 0;
+      try {
+        entry.data_stream = std::stoll(stream, &parsed_chars);
+      }
+      catch (const std::exception&) {
+        parsed_chars = 0;
+      }
+      if ((parsed_chars == 0) || (parsed_chars != stream.size()) ||
+          (entry.data_stream < 0)) {
+        return cb::Error(
+            "invalid data stream in model mix: '" + item +
+                "', data streams must be non-negative integers",
+            pa::GENERIC_ERROR);
+      }
+      item = item.substr(0, stream_start);
+    }
+    const size_t weight_start = item.find('=');
+    const std::string model = item.substr(0, weight_start);
+    const size_t version_start = model.find(':');
+    entry.model_name = model.substr(0, version_start);
+    if (version_start != std::string::npos) {
+      entry.model_version = model.substr(version_start + 1);
+      if (entry.model_version.empty()) {
+        return cb::Error(
+            "missing model version in model mix: '" + item + "'",
+            pa::GENERIC_ERROR);
+      }
+    }
+    if (entry.model_name.empty()) {
+      return cb::Error(
+          "missing model name in model mix: '" + item + "'",
+          pa::GENERIC_ERROR);
+    }
+    if (weight_start != std::string::npos) {
+      const std::string weight = item.substr(weight_start + 1);
+      size_t parsed_chars = 0;
+      try {
+        entry.weight = std::stod(weight, &parsed_chars);
+      }
+      catch (const std::exception&) {
+        parsed_chars = 0;
+      }
+      if ((parsed_chars == 0) || (parsed_chars != weight.size()) ||
+          !(entry.weight > 0)) {
+        return cb::Error(
+            "invalid weight in model mix: '" + item +
+                "', weights must be positive numbers",
+            pa::GENERIC_ERROR);
+      }
+    }
+    parsed.push_back(entry);
+  }
+
+  if (parsed.empty()) {
+    return cb::Error("model mix is empty", pa::GENERIC_ERROR);
+  }
+  *entries = std::move(parsed);
+  return cb::Error::Success;
+}
+
+cb::Error
+ReadModelMixFile(const std::string& path, std::vector<ModelMixEntry>* entries)
+{
+  std::ifstream file(path);
+  if (!file) {
+    return cb::Error(
+        "failed to open model mix file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  std::string spec;
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    line.erase(0, line.find_first_not_of(" \t\r"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (line.empty()) {
+      continue;
+    }
+    if (!spec.empty()) {
+      spec += ',';
+    }
+    spec += line;
+  }
+  return ParseModelMix(spec, entries);
+}
+
+ModelMix::ModelMix(const std::vector<ModelMixEntry>& entries)
+    : entries_(entries)
+{
+  double total_weight = 0;
+  for (const auto& entry : entries_) {
+    total_weight += entry.weight;
+  }
+  double cumulative_weight = 0;
+  for (const auto& entry : entries_) {
+    cumulative_weight += entry.weight;
+    cumulative_shares_.push_back(cumulative_weight / total_weight);
+  }
+  // Rounding must not leave draws close to 1 without a model
+  if (!cumulative_shares_.empty()) {
+    cumulative_shares_.back() = 1.0;
+  }
+}
+
+size_t
+ModelMix::Pick(const double draw) const
+{
+  auto it = std::upper_bound(
+      cumulative_shares_.begin(), cumulative_shares_.end(), draw);
+  if (it == cumulative_shares_.end()) {
+    return entries_.size() - 1;
+  }
+  return it - cumulative_shares_.begin();
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,89 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A model that takes part in a model mix
+struct ModelMixEntry {
+  std::string model_name;
+  // Empty for the version that the server picks
+  std::string model_version;
+  double weight{1.0};
+  // The input data stream of the requests to the model, -1 for the one that
+  // the load picks
+  int64_t data_stream{-1};
+};
+
+/// Parses a model mix in the format "name[:version][=weight][@stream],...",
+/// such as "resnet=3,densenet:2@1". The weight defaults to 1.
+/// \param spec The model mix to parse.
+/// \param entries Returns the models of the mix, in the order given. Left
+/// unchanged if the mix is invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseModelMix(
+    const std::string& spec, std::vector<ModelMixEntry>* entries);
+
+/// Reads a model mix from a workload file with one model per line, in the
+/// format of the entries of ParseModelMix(). Blank lines and text after '#'
+/// are ignored.
+/// \param path The workload file to read.
+/// \param entries Returns the models of the mix, in the order given. Left
+/// unchanged if the file is invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadModelMixFile(
+    const std::string& path, std::vector<ModelMixEntry>* entries);
+
+/// Spreads the requests over several models that take the same inputs, each
+/// getting a share of the requests proportional to its weight.
+class ModelMix {
+ public:
+  /// \param entries The models of the mix, with positive weights.
+  explicit ModelMix(const std::vector<ModelMixEntry>& entries);
+
+  /// \param draw A number drawn uniformly from [0, 1).
+  /// \return The index of the model that the draw falls on.
+  size_t Pick(const double draw) const;
+
+  const ModelMixEntry& Entry(const size_t index) const
+  {
+    return entries_[index];
+  }
+
+  size_t Size() const { return entries_.size(); }
+
+ private:
+  std::vector<ModelMixEntry> entries_;
+  // The end of the share of each model, the last one is 1
+  std::vector<double> cumulative_shares_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -26,6 +26,14 @@
 
 #include "model_parser.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace triton { namespace perfanalyzer {
@@ -44,8 +52,10 @@ ModelParser::InitTriton(
   const auto& ensemble_itr = config.FindMember("ensemble_scheduling");
   if (ensemble_itr != config.MemberEnd()) {
     bool is_sequential = false;
+    ModelConfigMap composing_configs;
+    RETURN_IF_ERROR(FetchComposingConfigs(config, backend, &composing_configs));
     RETURN_IF_ERROR(GetEnsembleSchedulerType(
-        config, model_version, backend, &is_sequential));
+        config, model_version, composing_configs, &is_sequential));
     if (is_sequential) {
       scheduler_type_ = ENSEMBLE_SEQUENCE;
     } else {
@@ -84,6 +94,7 @@ ModelParser::InitTriton(
           inputs_->emplace(input["name"].GetString(), ModelTensor()).first;
       it->second.name_ = input["name"].GetString();
       it->second.datatype_ = input["datatype"].GetString();
+      it->second.type_ = ParseDataType(it->second.datatype_);
       bool is_dynamic = false;
       bool skip = (max_batch_size_ > 0);
       for (const auto& dim : input["shape"].GetArray()) {
@@ -145,6 +156,7 @@ ModelParser::InitTriton(
           outputs_->emplace(output["name"].GetString(), ModelTensor()).first;
       it->second.name_ = output["name"].GetString();
       it->second.datatype_ = output["datatype"].GetString();
+      it->second.type_ = ParseDataType(it->second.datatype_);
       bool skip = (max_batch_size_ > 0);
       for (const auto& dim : output["shape"].GetArray()) {
         if (skip) {
@@ -227,6 +239,7 @@ ModelParser::InitTFServe(
       it->second.name_ = json_itr->name.GetString();
       RETURN_IF_ERROR(ConvertDTypeFromTFS(
           json_itr->value["dtype"].GetString(), &it->second.datatype_));
+      it->second.type_ = ParseDataType(it->second.datatype_);
 
       bool is_dynamic = false;
       if (json_itr->value["tensor_shape"]["unknown_rank"].GetBool()) {
@@ -298,16 +311,39 @@ ModelParser::InitTorchServe(
   auto it = inputs_->emplace("TORCHSERVE_INPUT", ModelTensor()).first;
   it->second.name_ = "TORCHSERVE_INPUT";
   it->second.datatype_ = "BYTES";
+  it->second.type_ = DataType::BYTES;
   // Supports only a single input file
   it->second.shape_.push_back(1);
 
   return cb::Error::Success;
 }
 
+cb::Error
+ModelParser::InitHttpJson(
+    const rapidjson::Document& metadata, const std::string& model_name,
+    const std::string& model_version)
+{
+  model_name_ = model_name;
+  model_version_ = model_version;
+  // The requests are rendered one by one
+  max_batch_size_ = 0;
+
+  for (const auto& input : metadata["inputs"].GetArray()) {
+    const std::string name = input["name"].GetString();
+    auto it = inputs_->emplace(name, ModelTensor()).first;
+    it->second.name_ = name;
+    it->second.datatype_ = input["datatype"].GetString();
+    it->second.type_ = ParseDataType(it->second.datatype_);
+    it->second.shape_.push_back(1);
+  }
+
+  return cb::Error::Success;
+}
+
 cb::Error
 ModelParser::GetEnsembleSchedulerType(
     const rapidjson::Document& config, const std::string& model_version,
-    std::unique_ptr<cb::ClientBackend>& backend, bool* is_sequential)
+    const ModelConfigMap& composing_configs, bool* is_sequential)
 {
   const auto& sequence_itr = config.FindMember("sequence_batching");
   if (sequence_itr != config.MemberEnd()) {
@@ -315,24 +351,47 @@ ModelParser::GetEnsembleSchedulerType(
   }
 
   if (std::string(config["platform"].GetString()).compare("ensemble") == 0) {
+    // An ensemble composing another one more than once is visited as many
+    // times, its steps are only recorded the first time
+    const std::string ensemble_name = config["name"].GetString();
+    const bool record_steps =
+        (ensemble_steps_->find(ensemble_name) == ensemble_steps_->end());
     const auto step_itr = config["ensemble_scheduling"].FindMember("step");
     for (const auto& step : step_itr->value.GetArray()) {
-      std::string step_model_version;
-      int64_t model_version_int;
-      RETURN_IF_ERROR(GetInt(step["model_version"], &model_version_int));
-      if (model_version_int == -1) {
-        step_model_version = "";
-      } else {
-        step_model_version = std::to_string(model_version_int);
+      cb::ModelIdentifier step_model;
+      RETURN_IF_ERROR(GetStepModel(step, &step_model));
+      (*composing_models_map_)[ensemble_name].emplace(step_model);
+
+      if (record_steps) {
+        EnsembleStep ensemble_step;
+        ensemble_step.model = step_model;
+        // The maps go from the tensors of the composing model to the ones of
+        // the ensemble
+        const auto input_itr = step.FindMember("input_map");
+        if (input_itr != step.MemberEnd()) {
+          for (const auto& tensor : input_itr->value.GetObject()) {
+            ensemble_step.inputs.insert(tensor.value.GetString());
+          }
+        }
+        const auto output_itr = step.FindMember("output_map");
+        if (output_itr != step.MemberEnd()) {
+          for (const auto& tensor : output_itr->value.GetObject()) {
+            ensemble_step.outputs.insert(tensor.value.GetString());
+          }
+        }
+        (*ensemble_steps_)[ensemble_name].push_back(ensemble_step);
       }
-      (*composing_models_map_)[config["name"].GetString()].emplace(
-          std::string(step["model_name"].GetString()), step_model_version);
 
-      rapidjson::Document model_config;
-      RETURN_IF_ERROR(backend->ModelConfig(
-          &model_config, step["model_name"].GetString(), step_model_version));
+      const auto config_it = composing_configs.find(step_model);
+      if (config_it == composing_configs.end()) {
+        return cb::Error(
+            "missing the config of composing model '" + step_model.first +
+                "'",
+            pa::GENERIC_ERROR);
+      }
+      const rapidjson::Document& model_config = *config_it->second;
       RETURN_IF_ERROR(GetEnsembleSchedulerType(
-          model_config, step_model_version, backend, is_sequential));
+          model_config, step_model.second, composing_configs, is_sequential));
 
       // Check if composing model has response caching enabled.
       const auto cache_itr = model_config.FindMember("response_cache");
@@ -347,6 +406,174 @@ ModelParser::GetEnsembleSchedulerType(
   return cb::Error::Success;
 }
 
+cb::Error
+ModelParser::FetchComposingConfigs(
+    const rapidjson::Document& config,
+    std::unique_ptr<cb::ClientBackend>& backend,
+    ModelConfigMap* composing_configs)
+{
+  // The models of a level are only known once the configs of the ensembles
+  // of the level above are fetched
+  std::vector<const rapidjson::Document*> ensembles{&config};
+  while (!ensembles.empty()) {
+    std::vector<cb::ModelIdentifier> models;
+    for (const auto ensemble : ensembles) {
+      const auto platform_itr = ensemble->FindMember("platform");
+      if ((platform_itr == ensemble->MemberEnd()) ||
+          (std::string(platform_itr->value.GetString()) != "ensemble")) {
+        continue;
+      }
+      const auto step_itr =
+          (*ensemble)["ensemble_scheduling"].FindMember("step");
+      for (const auto& step : step_itr->value.GetArray()) {
+        cb::ModelIdentifier model;
+        RETURN_IF_ERROR(GetStepModel(step, &model));
+        if ((composing_configs->find(model) == composing_configs->end()) &&
+            (std::find(models.begin(), models.end(), model) == models.end())) {
+          models.push_back(model);
+        }
+      }
+    }
+
+    std::vector<std::shared_ptr<rapidjson::Document>> configs;
+    RETURN_IF_ERROR(FetchModelConfigs(models, backend, &configs));
+    ensembles.clear();
+    for (size_t i = 0; i < models.size(); i++) {
+      composing_configs->emplace(models[i], configs[i]);
+      ensembles.push_back(configs[i].get());
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ModelParser::FetchModelConfigs(
+    const std::vector<cb::ModelIdentifier>& models,
+    std::unique_ptr<cb::ClientBackend>& backend,
+    std::vector<std::shared_ptr<rapidjson::Document>>* configs)
+{
+  configs->assign(models.size(), nullptr);
+  std::vector<size_t> missing;
+  for (size_t i = 0; i < models.size(); i++) {
+    const std::string path = CachedConfigPath(models[i]);
+    if (!path.empty() && IsFile(path)) {
+      std::ifstream file(path);
+      std::stringstream contents;
+      contents << file.rdbuf();
+      auto config = std::make_shared<rapidjson::Document>();
+      config->Parse(contents.str().c_str());
+      if (!config->HasParseError() && config->IsObject()) {
+        (*configs)[i] = config;
+        continue;
+      }
+    }
+    missing.push_back(i);
+  }
+
+  // Only remote servers are worth spreading the requests over connections.
+  // The backends of the C API share one server, which they unload when
+  // destroyed.
+  const size_t max_thread_count = 16;
+  size_t thread_count = 1;
+  if ((config_factory_ != nullptr) &&
+      (backend_kind_ == cb::BackendKind::TRITON)) {
+    thread_count = std::max<size_t>(
+        1, std::min<size_t>(max_thread_count, missing.size()));
+  }
+  std::vector<std::unique_ptr<cb::ClientBackend>> thread_backends(
+      thread_count - 1);
+  for (auto& thread_backend : thread_backends) {
+    RETURN_IF_ERROR(config_factory_->CreateClientBackend(&thread_backend));
+  }
+
+  std::vector<cb::Error> errors(thread_count, cb::Error::Success);
+  auto fetch_range = [&](size_t t) {
+    auto& fetch_backend = (t == 0) ? backend : thread_backends[t - 1];
+    const size_t end = missing.size() * (t + 1) / thread_count;
+    for (size_t m = missing.size() * t / thread_count; m < end; m++) {
+      const cb::ModelIdentifier& model = models[missing[m]];
+      auto config = std::make_shared<rapidjson::Document>();
+      errors[t] = fetch_backend->ModelConfig(
+          config.get(), model.first, model.second);
+      if (!errors[t].IsOk()) {
+        return;
+      }
+      (*configs)[missing[m]] = config;
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < thread_count; t++) {
+    threads.emplace_back(fetch_range, t);
+  }
+  fetch_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& err : errors) {
+    RETURN_IF_ERROR(err);
+  }
+
+  // The cache is only an optimization, failing to write to it is ignored.
+  // The configs are written to a temporary file first so that concurrent
+  // runs never read a partial one.
+  if (!config_cache_directory_.empty() && !missing.empty() &&
+      !IsDirectory(config_cache_directory_)) {
+    mkdir(config_cache_directory_.c_str(), 0755);
+  }
+  for (const size_t i : missing) {
+    const std::string path = CachedConfigPath(models[i]);
+    if (path.empty()) {
+      continue;
+    }
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    (*configs)[i]->Accept(writer);
+    const std::string temp_path = path + "." + std::to_string(getpid());
+    std::ofstream file(temp_path);
+    file << buffer.GetString();
+    file.close();
+    if (!file || (std::rename(temp_path.c_str(), path.c_str()) != 0)) {
+      std::remove(temp_path.c_str());
+    }
+  }
+  return cb::Error::Success;
+}
+
+std::string
+ModelParser::CachedConfigPath(const cb::ModelIdentifier& model) const
+{
+  // Without an explicit version the config may change from run to run
+  if (config_cache_directory_.empty() || model.second.empty()) {
+    return "";
+  }
+
+  // FNV-1a over the server and the model
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const std::string& part :
+       {config_server_url_, model.first, model.second}) {
+    for (const char c : part) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    hash = (hash ^ 0) * 0x100000001b3;
+  }
+  std::stringstream path;
+  path << config_cache_directory_ << "/" << std::hex << std::setw(16)
+       << std::setfill('0') << hash << ".json";
+  return path.str();
+}
+
+cb::Error
+ModelParser::GetStepModel(
+    const rapidjson::Value& step, cb::ModelIdentifier* model)
+{
+  int64_t model_version_int;
+  RETURN_IF_ERROR(GetInt(step["model_version"], &model_version_int));
+  model->first = step["model_name"].GetString();
+  model->second =
+      (model_version_int == -1) ? "" : std::to_string(model_version_int);
+  return cb::Error::Success;
+}
+
 cb::Error
 ModelParser::GetInt(const rapidjson::Value& value, int64_t* integer_value)
 {
@@ -27,6 +27,8 @@
 
 #include <unordered_map>
 #include "client_backend/client_backend.h"
+#include "datatype.h"
+#include "model_mix.h"
 #include "perf_utils.h"
 
 namespace triton { namespace perfanalyzer {
@@ -40,6 +42,8 @@ struct ModelTensor {
   ModelTensor() : is_shape_tensor_(false) {}
   std::string name_;
   std::string datatype_;
+  // The datatype resolved from 'datatype_' when the model is parsed
+  DataType type_{DataType::INVALID};
   std::vector<int64_t> shape_;
   // Indicates if this tensor holds shape information for other tensors
   bool is_shape_tensor_;
@@ -49,6 +53,21 @@ struct ModelTensor {
 using ModelTensorMap = std::map<std::string, ModelTensor>;
 using ComposingModelMap = std::map<std::string, std::set<cb::ModelIdentifier>>;
 
+// A step of an ensemble: the composing model that it runs, and the ensemble
+// tensors that it consumes and produces.
+struct EnsembleStep {
+  cb::ModelIdentifier model;
+  std::set<std::string> inputs;
+  std::set<std::string> outputs;
+};
+
+// The steps of each ensemble in the target model, in the order of its config.
+using EnsembleStepMap = std::map<std::string, std::vector<EnsembleStep>>;
+
+// The configs of the composing models of the ensembles in the target model.
+using ModelConfigMap =
+    std::map<cb::ModelIdentifier, std::shared_ptr<rapidjson::Document>>;
+
 //==============================================================================
 /// ModelParser is a helper class to parse the information about the target
 /// model from the metadata and configuration returned by the server.
@@ -67,12 +86,13 @@ class ModelParser {
   };
 
   explicit ModelParser(cb::BackendKind backend_kind)
-      : backend_kind_(backend_kind),
+      : scheduler_type_(NONE), is_decoupled_(false),
+        backend_kind_(backend_kind),
         inputs_(std::make_shared<ModelTensorMap>()),
         outputs_(std::make_shared<ModelTensorMap>()),
         composing_models_map_(std::make_shared<ComposingModelMap>()),
-        scheduler_type_(NONE), max_batch_size_(0), is_decoupled_(false),
-        response_cache_enabled_(false)
+        ensemble_steps_(std::make_shared<EnsembleStepMap>()),
+        max_batch_size_(0), response_cache_enabled_(false)
   {
   }
 
@@ -112,6 +132,17 @@ class ModelParser {
       const std::string& model_name, const std::string& model_version,
       const int32_t batch_size);
 
+  /// Initializes the ModelParser with the metadata built by the HTTP JSON
+  /// backend from its request template. Each placeholder of the template is
+  /// a BYTES input holding a single element.
+  /// \param metadata The metadata of the request template.
+  /// \param model_name The name of target model.
+  /// \param model_version The version of target model.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error InitHttpJson(
+      const rapidjson::Document& metadata, const std::string& model_name,
+      const std::string& model_version);
+
   /// Get the name of the target model
   /// \return Model name as string
   const std::string& ModelName() const { return model_name_; }
@@ -162,6 +193,46 @@ class ModelParser {
     return composing_models_map_;
   }
 
+  /// Get the steps of the ensembles in the target model.
+  /// \return The pointer to the map of ensemble names to their steps.
+  const std::shared_ptr<EnsembleStepMap>& GetEnsembleSteps()
+  {
+    return ensemble_steps_;
+  }
+
+  /// Sets how the configs of the composing models of ensembles are fetched.
+  /// Must be called before InitTriton.
+  /// \param factory Creates a backend for each of the threads fetching the
+  /// configs of a level of the ensembles concurrently. nullptr to fetch them
+  /// one after the other with the backend given to InitTriton.
+  /// \param cache_directory The directory keeping the configs of the models
+  /// with an explicit version across runs, empty to always fetch them.
+  /// \param server_url The server the configs come from, part of the cache
+  /// key.
+  void SetConfigFetching(
+      const std::shared_ptr<cb::ClientBackendFactory>& factory,
+      const std::string& cache_directory, const std::string& server_url)
+  {
+    config_factory_ = factory;
+    config_cache_directory_ = cache_directory;
+    config_server_url_ = server_url;
+  }
+
+  /// Spreads the requests over several models that take the inputs of the
+  /// target model. Must be called before the load starts.
+  /// \param model_mix The models to spread the requests over.
+  void SetModelMix(const std::shared_ptr<const ModelMix>& model_mix)
+  {
+    model_mix_ = model_mix;
+  }
+
+  /// \return The models that the requests are spread over, nullptr if they
+  /// all go to the target model.
+  const std::shared_ptr<const ModelMix>& GetModelMix() const
+  {
+    return model_mix_;
+  }
+
  protected:
   ModelSchedulerType scheduler_type_;
   bool is_decoupled_;
@@ -169,7 +240,37 @@ class ModelParser {
  private:
   cb::Error GetEnsembleSchedulerType(
       const rapidjson::Document& config, const std::string& model_version,
-      std::unique_ptr<cb::ClientBackend>& backend, bool* is_sequential);
+      const ModelConfigMap& composing_configs, bool* is_sequential);
+
+  /// Fetches the configs of all the composing models of an ensemble, nested
+  /// ensembles included, one level of nesting at a time.
+  /// \param config The config of the ensemble.
+  /// \param backend The backend object.
+  /// \param composing_configs Returns the configs of the composing models.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error FetchComposingConfigs(
+      const rapidjson::Document& config,
+      std::unique_ptr<cb::ClientBackend>& backend,
+      ModelConfigMap* composing_configs);
+
+  /// Fetches the configs of models, from the cache when they are in it and
+  /// concurrently when there is a factory.
+  /// \param models The models to fetch the configs of.
+  /// \param backend The backend object.
+  /// \param configs Returns the configs, in the order of the models.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error FetchModelConfigs(
+      const std::vector<cb::ModelIdentifier>& models,
+      std::unique_ptr<cb::ClientBackend>& backend,
+      std::vector<std::shared_ptr<rapidjson::Document>>* configs);
+
+  /// \return The path of the cached config of the model, empty if it is not
+  /// to be cached.
+  std::string CachedConfigPath(const cb::ModelIdentifier& model) const;
+
+  /// Gets the model that a step of an ensemble runs.
+  cb::Error GetStepModel(
+      const rapidjson::Value& step, cb::ModelIdentifier* model);
 
   /// In the json produced by protobuf, int64 and uint64 values are
   /// represented as strings. Protobuf doesn't provide an option to
@@ -185,6 +286,12 @@ class ModelParser {
   std::shared_ptr<ModelTensorMap> inputs_;
   std::shared_ptr<ModelTensorMap> outputs_;
   std::shared_ptr<ComposingModelMap> composing_models_map_;
+  std::shared_ptr<EnsembleStepMap> ensemble_steps_;
+  std::shared_ptr<const ModelMix> model_mix_{nullptr};
+
+  std::shared_ptr<cb::ClientBackendFactory> config_factory_{nullptr};
+  std::string config_cache_directory_;
+  std::string config_server_url_;
 
   std::string model_name_;
   std::string model_version_;
@@ -29,6 +29,7 @@
 #include <dlfcn.h>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
 namespace triton { namespace perfanalyzer {
 
@@ -154,6 +155,48 @@ MPIDriver::MPIBcastIntWorld(void* buffer, int count, int root)
   MPI_Bcast(buffer, count, MPIInt(), root, MPICommWorld());
 }
 
+void
+MPIDriver::MPIBcastDoubleWorld(void* buffer, int count, int root)
+{
+  if (is_enabled_ == false) {
+    return;
+  }
+
+  MPIBcastWorld(buffer, count, MPIDatatype("ompi_mpi_double"), root);
+}
+
+void
+MPIDriver::MPIBcastUint64World(void* buffer, int count, int root)
+{
+  if (is_enabled_ == false) {
+    return;
+  }
+
+  MPIBcastWorld(buffer, count, MPIDatatype("ompi_mpi_uint64_t"), root);
+}
+
+void
+MPIDriver::MPIAllgatherUint64World(
+    const void* send_buffer, int count, void* recv_buffer)
+{
+  if (is_enabled_ == false) {
+    return;
+  }
+
+  int (*MPI_Allgather)(const void*, int, void*, void*, int, void*, void*){
+      (int (*)(const void*, int, void*, void*, int, void*, void*))dlsym(
+          handle_, "MPI_Allgather")};
+  if (MPI_Allgather == nullptr) {
+    throw std::runtime_error(
+        "Unable to obtain address of `MPI_Allgather` symbol.");
+  }
+
+  void* datatype{MPIDatatype("ompi_mpi_uint64_t")};
+  MPI_Allgather(
+      send_buffer, count, datatype, recv_buffer, count, datatype,
+      MPICommWorld());
+}
+
 void
 MPIDriver::MPIFinalize()
 {
@@ -221,6 +264,34 @@ MPIDriver::MPIInt()
   return MPI_INT;
 }
 
+void*
+MPIDriver::MPIDatatype(const char* symbol)
+{
+  if (is_enabled_ == false) {
+    return nullptr;
+  }
+
+  void* datatype{dlsym(handle_, symbol)};
+  if (datatype == nullptr) {
+    throw std::runtime_error(
+        std::string("Unable to obtain address of `") + symbol + "` symbol.");
+  }
+
+  return datatype;
+}
+
+void
+MPIDriver::MPIBcastWorld(void* buffer, int count, void* datatype, int root)
+{
+  int (*MPI_Bcast)(void*, int, void*, int, void*){
+      (int (*)(void*, int, void*, int, void*))dlsym(handle_, "MPI_Bcast")};
+  if (MPI_Bcast == nullptr) {
+    throw std::runtime_error("Unable to obtain address of `MPI_Bcast` symbol.");
+  }
+
+  MPI_Bcast(buffer, count, datatype, root, MPICommWorld());
+}
+
 void
 MPIDriver::CheckMPIImpl()
 {
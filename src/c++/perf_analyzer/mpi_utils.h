@@ -54,6 +54,19 @@ class MPIDriver {
   // communicator.
   void MPIBcastIntWorld(void* buffer, int count, int root);
 
+  // Attempts to call MPI_Bcast API with MPI_DOUBLE data type and
+  // MPI_COMM_WORLD communicator.
+  void MPIBcastDoubleWorld(void* buffer, int count, int root);
+
+  // Attempts to call MPI_Bcast API with MPI_UINT64_T data type and
+  // MPI_COMM_WORLD communicator.
+  void MPIBcastUint64World(void* buffer, int count, int root);
+
+  // Attempts to call MPI_Allgather API with MPI_UINT64_T data type and
+  // MPI_COMM_WORLD communicator. 'recv_buffer' holds 'count' values per rank.
+  void MPIAllgatherUint64World(
+      const void* send_buffer, int count, void* recv_buffer);
+
   // Attempts to call MPI_Finalize API.
   void MPIFinalize();
 
@@ -69,6 +82,14 @@ class MPIDriver {
   // `nullptr`.
   void* MPIInt();
 
+  // Returns the address of the given MPI data type symbol if MPI library is
+  // available, otherwise `nullptr`.
+  void* MPIDatatype(const char* symbol);
+
+  // Attempts to call MPI_Bcast API with the given data type and
+  // MPI_COMM_WORLD communicator.
+  void MPIBcastWorld(void* buffer, int count, void* datatype, int root);
+
   // Attempts to check that Open MPI is installed.
   void CheckMPIImpl();
 
@@ -0,0 +1,295 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "output_validator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Without branches: the exponent and mantissa are moved into place and
+// rebiased by scaling, which also normalizes the subnormals, and the
+// infinities and NaNs get the largest exponent back.
+float
+HalfToFloat(const uint16_t half)
+{
+  uint32_t bits = static_cast<uint32_t>(half & 0x7fff) << 13;
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  value *= 5.192296858534828e+33f;  // 2^112
+  memcpy(&bits, &value, sizeof(bits));
+  bits |= (value >= 65536.0f) ? 0x7f800000 : 0;
+  bits |= static_cast<uint32_t>(half & 0x8000) << 16;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+float
+Bfloat16ToFloat(const uint16_t bfloat16)
+{
+  const uint32_t bits = static_cast<uint32_t>(bfloat16) << 16;
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Compares 'count' elements read by 'load', without branches in the loop so
+// that the compiler can vectorize it. NaN elements match NaN elements. The
+// counter and the largest difference are kept in integers of the width of
+// the elements, the bits of non-negative floats order as integers, as float
+// reductions are only vectorized with relaxed floating point semantics.
+template <typename T, typename Load>
+size_t
+CompareElements(
+    const uint8_t* actual, const uint8_t* expected, const size_t count,
+    const OutputTolerance& tolerance, double* max_abs_error, Load load)
+{
+  using Bits =
+      typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+  const T absolute = static_cast<T>(tolerance.absolute);
+  const T relative = static_cast<T>(tolerance.relative);
+  Bits mismatched = 0;
+  Bits max_error_bits = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const T a = load(actual, i);
+    const T e = load(expected, i);
+    const T error = std::fabs(a - e);
+    const bool both_nan = (a != a) & (e != e);
+    const bool within = error <= (absolute + relative * std::fabs(e));
+    mismatched += (within | both_nan) ? 0 : 1;
+    Bits error_bits;
+    memcpy(&error_bits, &error, sizeof(error_bits));
+    error_bits &= -static_cast<Bits>(error == error);
+    max_error_bits =
+        (error_bits > max_error_bits) ? error_bits : max_error_bits;
+  }
+  T max_error;
+  memcpy(&max_error, &max_error_bits, sizeof(max_error));
+  *max_abs_error = std::max(*max_abs_error, static_cast<double>(max_error));
+  return mismatched;
+}
+
+}  // namespace
+
+void
+ValidationStats::Merge(const ValidationStats& other)
+{
+  output_count += other.output_count;
+  mismatched_output_count += other.mismatched_output_count;
+  mismatched_element_count += other.mismatched_element_count;
+  max_abs_error = std::max(max_abs_error, other.max_abs_error);
+  skipped_output_count += other.skipped_output_count;
+}
+
+size_t
+CompareOutputData(
+    const DataType type, const uint8_t* actual, const uint8_t* expected,
+    const size_t byte_size, const OutputTolerance& tolerance,
+    double* max_abs_error)
+{
+  switch (type) {
+    case DataType::FP32:
+      return CompareElements<float>(
+          actual, expected, byte_size / sizeof(float), tolerance, max_abs_error,
+          [](const uint8_t* data, size_t i) {
+            float value;
+            memcpy(&value, data + i * sizeof(value), sizeof(value));
+            return value;
+          });
+    case DataType::FP64:
+      return CompareElements<double>(
+          actual, expected, byte_size / sizeof(double), tolerance,
+          max_abs_error, [](const uint8_t* data, size_t i) {
+            double value;
+            memcpy(&value, data + i * sizeof(value), sizeof(value));
+            return value;
+          });
+    case DataType::FP16:
+      return CompareElements<float>(
+          actual, expected, byte_size / sizeof(uint16_t), tolerance,
+          max_abs_error, [](const uint8_t* data, size_t i) {
+            uint16_t value;
+            memcpy(&value, data + i * sizeof(value), sizeof(value));
+            return HalfToFloat(value);
+          });
+    case DataType::BF16:
+      return CompareElements<float>(
+          actual, expected, byte_size / sizeof(uint16_t), tolerance,
+          max_abs_error, [](const uint8_t* data, size_t i) {
+            uint16_t value;
+            memcpy(&value, data + i * sizeof(value), sizeof(value));
+            return Bfloat16ToFloat(value);
+          });
+    default:
+      break;
+  }
+
+  if (memcmp(actual, expected, byte_size) == 0) {
+    return 0;
+  }
+  // Only the elements of fixed size types can be told apart
+  const size_t element_size = DataTypeByteSize(type);
+  if (element_size == 0) {
+    return 1;
+  }
+  size_t mismatched = 0;
+  for (size_t offset = 0; offset < byte_size; offset += element_size) {
+    mismatched +=
+        (memcmp(actual + offset, expected + offset, element_size) != 0);
+  }
+  return mismatched;
+}
+
+OutputValidator::OutputValidator(
+    const OutputTolerance& tolerance, const size_t thread_count,
+    const size_t max_queued_count)
+    : tolerance_(tolerance), thread_count_(thread_count),
+      max_queued_count_(max_queued_count)
+{
+}
+
+OutputValidator::~OutputValidator()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void
+OutputValidator::Submit(
+    const std::shared_ptr<cb::InferResult>& result,
+    std::vector<ExpectedOutput>&& outputs)
+{
+  if (thread_count_ == 0) {
+    ValidateJob({result, std::move(outputs)});
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() >= max_queued_count_) {
+      std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+      stats_.skipped_output_count += outputs.size();
+      return;
+    }
+    queue_.push_back({result, std::move(outputs)});
+    while (threads_.size() < thread_count_) {
+      threads_.emplace_back(&OutputValidator::ValidationThread, this);
+    }
+  }
+  queue_cv_.notify_one();
+}
+
+void
+OutputValidator::Validate(
+    const ExpectedOutput& output, const uint8_t* data, const size_t byte_size)
+{
+  ValidationStats stats;
+  ValidateOutput(output, data, byte_size, &stats);
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_.Merge(stats);
+}
+
+ValidationStats
+OutputValidator::GetAndResetStats()
+{
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  ValidationStats stats = stats_;
+  stats_ = ValidationStats();
+  return stats;
+}
+
+void
+OutputValidator::ValidationThread()
+{
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_cv_.wait(lock, [this] { return exiting_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    ValidateJob(job);
+  }
+}
+
+void
+OutputValidator::ValidateJob(const Job& job)
+{
+  ValidationStats stats;
+  for (const auto& output : job.outputs_) {
+    const uint8_t* data = nullptr;
+    size_t byte_size = 0;
+    job.result_->RawData(output.tensor_->name_, &data, &byte_size);
+    ValidateOutput(output, data, byte_size, &stats);
+  }
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_.Merge(stats);
+}
+
+void
+OutputValidator::ValidateOutput(
+    const ExpectedOutput& output, const uint8_t* data, size_t byte_size,
+    ValidationStats* stats) const
+{
+  stats->output_count++;
+  size_t mismatched = 0;
+  for (const auto& expected : output.expected_) {
+    if (byte_size < expected.second) {
+      mismatched++;
+      byte_size = 0;
+      break;
+    }
+    mismatched += CompareOutputData(
+        output.tensor_->type_, data, expected.first, expected.second,
+        tolerance_, &stats->max_abs_error);
+    data += expected.second;
+    byte_size -= expected.second;
+  }
+  if (byte_size != 0) {
+    mismatched++;
+  }
+  if (mismatched != 0) {
+    stats->mismatched_output_count++;
+    stats->mismatched_element_count += mismatched;
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,158 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "client_backend/client_backend.h"
+#include "model_parser.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// How far the elements of floating point outputs may be from the expected
+/// ones: an element matches if |actual - expected| <= absolute + relative *
+/// |expected|. The elements of the other outputs must be identical.
+struct OutputTolerance {
+  double absolute{0.0};
+  double relative{0.0};
+};
+
+/// What the validation of the outputs found since it was last collected
+struct ValidationStats {
+  // The outputs validated, and those of them that did not match
+  uint64_t output_count{0};
+  uint64_t mismatched_output_count{0};
+  // The elements of the mismatched outputs out of tolerance. An output whose
+  // size does not match counts as one element.
+  uint64_t mismatched_element_count{0};
+  // The largest difference between a floating point element and the
+  // expected one
+  double max_abs_error{0.0};
+  // The outputs not validated because the validation fell behind
+  uint64_t skipped_output_count{0};
+
+  void Merge(const ValidationStats& other);
+};
+
+/// Compares the data of an output with the expected data.
+/// \param type The datatype of the output.
+/// \param actual The data of the output.
+/// \param expected The expected data, of the same byte size.
+/// \param byte_size The byte size of the data.
+/// \param tolerance The tolerance of floating point elements.
+/// \param max_abs_error Raised to the largest difference between a floating
+/// point element and the expected one.
+/// \return The number of elements that do not match.
+size_t CompareOutputData(
+    const DataType type, const uint8_t* actual,
+    const uint8_t* expected, const size_t byte_size,
+    const OutputTolerance& tolerance, double* max_abs_error);
+
+/// Validates the outputs of the requests against the expected ones on a pool
+/// of threads, so that the comparison does not delay the thread that
+/// received the response. The outputs that do not match are counted rather
+/// than failing the run. When the queued requests reach a limit the outputs
+/// of the next ones are skipped instead of being queued.
+///
+class OutputValidator {
+ public:
+  /// An output of a request and its expected data, one buffer per batch.
+  struct ExpectedOutput {
+    // The tensor of the model the output is of, which outlives the
+    // validator
+    const ModelTensor* tensor_;
+    std::vector<std::pair<const uint8_t*, size_t>> expected_;
+  };
+
+  /// \param tolerance The tolerance of floating point elements.
+  /// \param thread_count The number of validation threads, which start
+  /// with the first request queued. With 0 the outputs are validated on
+  /// the thread queuing them.
+  /// \param max_queued_count The number of requests queued above which the
+  /// outputs are skipped.
+  OutputValidator(
+      const OutputTolerance& tolerance, const size_t thread_count,
+      const size_t max_queued_count = 4096);
+
+  ~OutputValidator();
+
+  /// Queues the validation of the outputs of a response.
+  /// \param result The response, kept until its outputs are validated.
+  /// \param outputs The outputs to validate.
+  void Submit(
+      const std::shared_ptr<cb::InferResult>& result,
+      std::vector<ExpectedOutput>&& outputs);
+
+  /// Validates an output on the calling thread, for outputs whose data does
+  /// not outlive the call.
+  /// \param output The output and its expected data.
+  /// \param data The data of the output.
+  /// \param byte_size The byte size of the data.
+  void Validate(
+      const ExpectedOutput& output, const uint8_t* data,
+      const size_t byte_size);
+
+  /// \return The statistics since the last call, which are reset.
+  ValidationStats GetAndResetStats();
+
+ private:
+  struct Job {
+    std::shared_ptr<cb::InferResult> result_;
+    std::vector<ExpectedOutput> outputs_;
+  };
+
+  void ValidationThread();
+
+  void ValidateJob(const Job& job);
+
+  /// Validates an output into 'stats'.
+  void ValidateOutput(
+      const ExpectedOutput& output, const uint8_t* data, size_t byte_size,
+      ValidationStats* stats) const;
+
+  const OutputTolerance tolerance_;
+  const size_t thread_count_;
+  const size_t max_queued_count_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<Job> queue_;
+  bool exiting_{false};
+  std::vector<std::thread> threads_;
+
+  std::mutex stats_mutex_;
+  ValidationStats stats_;
+};
+
+}}  // namespace triton::perfanalyzer
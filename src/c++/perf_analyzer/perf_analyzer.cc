@@ -26,15 +26,29 @@
 
 #include "perf_analyzer.h"
 
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "capacity_model.h"
+#include "cpu_affinity.h"
 #include "perf_analyzer_exception.h"
 #include "report_writer.h"
 #include "request_rate_manager.h"
 
 namespace pa = triton::perfanalyzer;
 
+namespace {
+
+// How long a resumed sweep waits for the model to be ready again
+constexpr uint64_t RESUME_READY_TIMEOUT_S = 300;
+
+}  // namespace
+
 namespace triton { namespace perfanalyzer {
 
 volatile bool early_exit = false;
+volatile bool interrupted = false;
 
 void
 SignalHandler(int signum)
@@ -46,6 +60,7 @@ SignalHandler(int signum)
   if (!early_exit) {
     std::cout << "Waiting for in-flight inferences to complete." << std::endl;
     early_exit = true;
+    interrupted = true;
   } else {
     std::cout << "Exiting immediately..." << std::endl;
     exit(0);
@@ -61,10 +76,29 @@ PerfAnalyzer::PerfAnalyzer(pa::PAParamsPtr params) : params_(params)
 void
 PerfAnalyzer::Run()
 {
+  // Only converting the input data, there is nothing to profile
+  if (!params_->input_corpus_file.empty()) {
+    return;
+  }
+  if (model_load_benchmark_ != nullptr) {
+    BenchmarkModelLoad();
+    return;
+  }
   PrerunReport();
   Profile();
   WriteReport();
+  const bool regressed = CompareWithBaseline();
+  // An interrupted sweep resumes from the checkpoint next time
+  if ((checkpoint_ != nullptr) && !pa::early_exit) {
+    cb::Error err = checkpoint_->Remove();
+    if (!err.IsOk()) {
+      std::cerr << "WARNING: " << err.Message() << std::endl;
+    }
+  }
   Finalize();
+  if (regressed) {
+    throw pa::PerfAnalyzerException(pa::REGRESSION_ERROR);
+  }
 }
 
 void
@@ -72,23 +106,61 @@ PerfAnalyzer::CreateAnalyzerObjects()
 {
   // trap SIGINT to allow threads to exit gracefully
   signal(SIGINT, pa::SignalHandler);
-  std::shared_ptr<cb::ClientBackendFactory> factory;
+
+  // Placed before any client is created, so that the transport and callback
+  // threads of the clients inherit the placement
+  std::vector<int> client_cpus(params_->client_cpus);
+  if (params_->numa_node >= 0) {
+    FAIL_IF_ERR(
+        pa::BindMemoryToNumaNode(params_->numa_node),
+        "failed to bind memory to the NUMA node");
+    if (client_cpus.empty()) {
+      FAIL_IF_ERR(
+          pa::NumaNodeCpus(params_->numa_node, &client_cpus),
+          "failed to look up the CPUs of the NUMA node");
+    }
+  }
+  if (!client_cpus.empty()) {
+    FAIL_IF_ERR(
+        pa::SetThreadAffinity(pthread_self(), client_cpus),
+        "failed to set the CPU affinity");
+  }
+
   FAIL_IF_ERR(
       cb::ClientBackendFactory::Create(
           params_->kind, params_->url, params_->protocol, params_->ssl_options,
           params_->trace_options, params_->compression_algorithm,
           params_->http_headers, params_->triton_server_path,
-          params_->model_repository_path, params_->extra_verbose,
-          params_->metrics_url, &factory),
+          params_->model_repository_path, params_->output_memory_policy,
+          params_->lazy_model_load, params_->server_request_trace,
+          params_->extra_verbose, params_->metrics_url,
+          params_->metrics_allowlist, params_->request_template,
+          params_->null_server_options, params_->transfer_rate_limits,
+          params_->tfserving_options, &factory_),
       "failed to create client factory");
 
   FAIL_IF_ERR(
-      factory->CreateClientBackend(&backend_),
+      factory_->CreateClientBackend(&backend_),
       "failed to create triton client backend");
 
+  // The model is profiled as loaded with the given config
+  if (!params_->model_load_config_file.empty() &&
+      (params_->model_load_iterations == 0)) {
+    FAIL_IF_ERR(
+        backend_->LoadModel(params_->model_name, ModelLoadConfig()),
+        "failed to load the model with the given config");
+  }
+
+  // Before the model is queried, which fails if the server is still
+  // restarting
+  if (!params_->checkpoint_file.empty()) {
+    OpenCheckpoint();
+  }
+
   parser_ = std::make_shared<pa::ModelParser>(params_->kind);
   if (params_->kind == cb::BackendKind::TRITON ||
-      params_->kind == cb::BackendKind::TRITON_C_API) {
+      params_->kind == cb::BackendKind::TRITON_C_API ||
+      params_->kind == cb::BackendKind::NULL_SERVER) {
     rapidjson::Document model_metadata;
     FAIL_IF_ERR(
         backend_->ModelMetadata(
@@ -99,11 +171,34 @@ PerfAnalyzer::CreateAnalyzerObjects()
         backend_->ModelConfig(
             &model_config, params_->model_name, params_->model_version),
         "failed to get model config");
+    parser_->SetConfigFetching(
+        factory_, params_->model_config_cache, params_->url);
     FAIL_IF_ERR(
         parser_->InitTriton(
             model_metadata, model_config, params_->model_version,
             params_->input_shapes, backend_),
         "failed to create model parser");
+    if (!params_->model_mix.empty()) {
+      // The target model is part of the mix unless it is given a weight
+      std::vector<pa::ModelMixEntry> entries{
+          {params_->model_name, params_->model_version, 1.0}};
+      for (const auto& entry : params_->model_mix) {
+        if ((entry.model_name == params_->model_name) &&
+            (entry.model_version == params_->model_version)) {
+          entries.front() = entry;
+          continue;
+        }
+        // Also loads the model with the C API
+        rapidjson::Document mix_model_metadata;
+        FAIL_IF_ERR(
+            backend_->ModelMetadata(
+                &mix_model_metadata, entry.model_name, entry.model_version),
+            "failed to get metadata of model '" + entry.model_name +
+                "' of the model mix");
+        entries.push_back(entry);
+      }
+      parser_->SetModelMix(std::make_shared<pa::ModelMix>(entries));
+    }
   } else if (params_->kind == cb::BackendKind::TENSORFLOW_SERVING) {
     rapidjson::Document model_metadata;
     FAIL_IF_ERR(
@@ -121,12 +216,26 @@ PerfAnalyzer::CreateAnalyzerObjects()
         parser_->InitTorchServe(
             params_->model_name, params_->model_version, params_->batch_size),
         "failed to create model parser");
+  } else if (params_->kind == cb::BackendKind::HTTP_JSON) {
+    rapidjson::Document model_metadata;
+    FAIL_IF_ERR(
+        backend_->ModelMetadata(
+            &model_metadata, params_->model_name, params_->model_version),
+        "failed to get the inputs of the request template");
+    FAIL_IF_ERR(
+        parser_->InitHttpJson(
+            model_metadata, params_->model_name, params_->model_version),
+        "failed to create model parser");
   } else {
     std::cerr << "unsupported client backend kind" << std::endl;
     throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
   }
 
-  if ((parser_->MaxBatchSize() == 0) && params_->batch_size > 1) {
+  // Every batch size of a range is checked up front
+  const size_t largest_batch_size = params_->using_batch_size_range
+                                        ? params_->batch_size_range.end
+                                        : params_->batch_size;
+  if ((parser_->MaxBatchSize() == 0) && largest_batch_size > 1) {
     std::cerr << "can not specify batch size > 1 as the model does not support "
                  "batching"
               << std::endl;
@@ -140,7 +249,7 @@ PerfAnalyzer::CreateAnalyzerObjects()
       params_->async = params_->forced_sync ? false : true;
     }
     // Validate the batch_size specification
-    if (params_->batch_size > 1) {
+    if (largest_batch_size > 1) {
       std::cerr << "can not specify batch size > 1 when using a sequence model"
                 << std::endl;
       throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
@@ -155,6 +264,94 @@ PerfAnalyzer::CreateAnalyzerObjects()
     params_->async = true;
   }
 
+  if (params_->model_load_iterations != 0) {
+    CreateModelLoadBenchmark();
+    return;
+  }
+
+  std::unique_ptr<pa::LoadManager> manager = CreateLoadManager();
+  manager->InitManager(
+      params_->string_length, params_->string_data, params_->zero_input,
+      params_->user_data, params_->start_sequence_id,
+      params_->sequence_id_range, params_->sequence_length,
+      params_->sequence_length_specified, params_->sequence_length_variation);
+
+  if (!params_->input_corpus_file.empty()) {
+    FAIL_IF_ERR(
+        manager->WriteInputCorpus(params_->input_corpus_file),
+        "failed to write input corpus");
+    std::cout << "Wrote input corpus " << params_->input_corpus_file
+              << std::endl;
+    return;
+  }
+
+  if (!params_->time_series_file.empty()) {
+    // The samples are taken from another thread, so the server side
+    // statistics need a backend of their own. The C API backend can only
+    // have one server, so it goes without them.
+    std::shared_ptr<cb::ClientBackend> stats_backend;
+    if (params_->kind == cb::BackendKind::TRITON) {
+      std::unique_ptr<cb::ClientBackend> backend;
+      FAIL_IF_ERR(
+          factory_->CreateClientBackend(&backend),
+          "failed to create time series client backend");
+      stats_backend = std::move(backend);
+    }
+    manager->EnableIntervalLatencies();
+    FAIL_IF_ERR(
+        pa::TimeSeriesWriter::Create(
+            params_->time_series_file, params_->time_series_interval_ms,
+            manager.get(), stats_backend, parser_, &time_series_writer_),
+        "failed to create time series writer");
+  }
+  if (!params_->endpoints.empty()) {
+    // The server side statistics are fetched from every endpoint
+    for (const auto& endpoint : params_->endpoints) {
+      std::unique_ptr<cb::ClientBackend> backend;
+      FAIL_IF_ERR(
+          factory_->CreateEndpointClientBackend(endpoint.url, &backend),
+          "failed to create client backend for endpoint " + endpoint.url);
+      endpoint_backends_[endpoint.url] = std::move(backend);
+    }
+  }
+
+  // Read before the request record file is created, which may be the one
+  // of the baseline
+  if (!params_->baseline_file.empty()) {
+    FAIL_IF_ERR(
+        pa::ReadBaseline(params_->baseline_file, &baseline_),
+        "failed to read the baseline");
+  }
+
+  if (!params_->request_record_file.empty()) {
+    FAIL_IF_ERR(
+        pa::RequestRecordWriter::Create(
+            params_->request_record_file, &request_record_writer_),
+        "failed to create request record writer");
+  }
+
+  if (params_->mpi_distributed_load) {
+    distributed_load_ = std::make_shared<pa::DistributedLoad>(
+        params_->mpi_driver, params_->mpi_rank_weights);
+  }
+
+  window_clock_.alignment_ns =
+      params_->window_alignment_ms * pa::NANOS_PER_MILLIS;
+  window_clock_.origin_ns = static_cast<uint64_t>(
+      params_->window_start_time * pa::NANOS_PER_SECOND);
+  if (params_->mpi_driver->IsMPIRun() &&
+      (window_clock_.IsAligned() || params_->mpi_distributed_load)) {
+    // The windows of all the ranks follow the clock of rank 0
+    window_clock_.offset_ns =
+        pa::EstimateClockOffsetNs(*params_->mpi_driver);
+  }
+
+  CreateProfiler(std::move(manager));
+}
+
+std::unique_ptr<pa::LoadManager>
+PerfAnalyzer::CreateLoadManager()
+{
   std::unique_ptr<pa::LoadManager> manager;
 
   if (params_->targeting_concurrency()) {
@@ -203,7 +400,7 @@ PerfAnalyzer::CreateAnalyzerObjects()
             params_->async, params_->streaming, params_->batch_size,
             params_->max_threads, params_->max_concurrency,
             params_->shared_memory_type, params_->output_shm_size, parser_,
-            factory, &manager),
+            factory_, &manager),
         "failed to create concurrency manager");
 
   } else if (params_->using_request_rate_range) {
@@ -219,10 +416,26 @@ PerfAnalyzer::CreateAnalyzerObjects()
         pa::RequestRateManager::Create(
             params_->async, params_->streaming, params_->measurement_window_ms,
             params_->max_trials, params_->request_distribution,
-            params_->batch_size, params_->max_threads,
-            params_->num_of_sequences, params_->shared_memory_type,
-            params_->output_shm_size, parser_, factory, &manager),
+            params_->rate_profile_settings, params_->batch_size,
+            params_->max_threads, params_->num_of_sequences,
+            params_->precise_scheduling, params_->num_dispatcher_threads,
+            params_->shared_memory_type, params_->output_shm_size, parser_,
+            factory_, &manager),
         "failed to create request rate manager");
+    if (params_->auto_max_threads) {
+      dynamic_cast<pa::RequestRateManager*>(manager.get())
+          ->EnableAutoThreads();
+    }
+    if (!params_->schedule_plugin.empty()) {
+      std::shared_ptr<pa::SchedulePlugin> plugin;
+      FAIL_IF_ERR(
+          pa::SchedulePlugin::Load(
+              params_->schedule_plugin, params_->schedule_plugin_config,
+              &plugin),
+          "failed to load schedule plugin");
+      dynamic_cast<pa::RequestRateManager*>(manager.get())
+          ->SetSchedulePlugin(plugin);
+    }
 
   } else {
     if ((params_->sequence_id_range != 0) &&
@@ -237,17 +450,161 @@ PerfAnalyzer::CreateAnalyzerObjects()
         pa::CustomLoadManager::Create(
             params_->async, params_->streaming, params_->measurement_window_ms,
             params_->max_trials, params_->request_intervals_file,
+            params_->request_trace_file, params_->schedule_replay_file,
             params_->batch_size, params_->max_threads,
-            params_->num_of_sequences, params_->shared_memory_type,
-            params_->output_shm_size, parser_, factory, &manager),
+            params_->num_of_sequences, params_->precise_scheduling,
+            params_->num_dispatcher_threads, params_->shared_memory_type,
+            params_->output_shm_size, parser_, factory_, &manager),
         "failed to create custom load manager");
   }
 
-  manager->InitManager(
-      params_->string_length, params_->string_data, params_->zero_input,
-      params_->user_data, params_->start_sequence_id,
-      params_->sequence_id_range, params_->sequence_length,
-      params_->sequence_length_specified, params_->sequence_length_variation);
+  if ((params_->max_inflight_requests != 0) &&
+      !params_->targeting_concurrency()) {
+    manager->SetInflightLimit(
+        params_->max_inflight_requests, params_->inflight_overload);
+  }
+  if (params_->prestage_inputs) {
+    manager->EnablePrestagedInputs();
+  }
+  if (params_->data_prefetch_steps != 0) {
+    manager->SetDataPrefetchSteps(params_->data_prefetch_steps);
+  }
+  manager->SetOutputValidation(
+      {params_->output_tolerance_absolute,
+       params_->output_tolerance_relative},
+      params_->validation_threads);
+  if (params_->shm_pool_size != 0) {
+    manager->EnableSharedMemoryPool(params_->shm_pool_size);
+  }
+  if (params_->output_shm_slots != 0) {
+    manager->EnableOutputSharedMemorySlots(params_->output_shm_slots);
+  }
+  if (params_->shm_huge_pages || params_->shm_prefault ||
+      params_->shm_persist) {
+    cb::SharedMemoryOptions shm_options;
+    shm_options.huge_pages = params_->shm_huge_pages;
+    shm_options.prefault = params_->shm_prefault;
+    shm_options.numa_node = params_->numa_node;
+    shm_options.persistent = params_->shm_persist;
+    manager->SetSharedMemoryOptions(shm_options);
+  }
+  if (!params_->worker_cpus.empty()) {
+    manager->SetWorkerCpus(params_->worker_cpus);
+  }
+  if (params_->share_nothing) {
+    manager->SetShareNothing();
+  }
+  if (params_->async_continuations) {
+    manager->EnableAsyncContinuations();
+  }
+  if (params_->warm_ramp) {
+    manager->EnableWarmRamp();
+  }
+  if (params_->client_stage_times) {
+    manager->EnableClientStageTimes();
+  }
+  if (params_->slowest_request_count > 0) {
+    manager->SetSlowRequestCount(params_->slowest_request_count);
+  }
+  if (params_->latency_threshold_ms != pa::NO_LIMIT) {
+    // Lets the profiler end a load level as soon as it is clearly over
+    manager->EnableThresholdLatencies();
+  }
+  if (!params_->client_trace_file.empty()) {
+    // Keeps the spans of the last few thousand traced requests, of every
+    // batch size
+    if (client_tracer_ == nullptr) {
+      client_tracer_ = std::make_shared<pa::ClientTracer>(
+          params_->client_trace_rate, 1 << 16);
+    }
+    manager->SetClientTracer(client_tracer_);
+  }
+  if (!params_->schedule_record_file.empty()) {
+    if (schedule_recorder_ == nullptr) {
+      schedule_recorder_ = std::make_shared<pa::ScheduleRecorder>();
+    }
+    manager->SetScheduleRecorder(schedule_recorder_);
+  }
+  if (params_->client_send_delay_us > 0) {
+    manager->SetSendDelay(params_->client_send_delay_us);
+  }
+  if (params_->client_connections > 0) {
+    manager->SetSharedBackends(params_->client_connections);
+  }
+  if (params_->sequences_per_context > 1) {
+    manager->SetSequencesPerContext(params_->sequences_per_context);
+  }
+  if (params_->sequence_length_distribution.kind !=
+      pa::SequenceDistributionSettings::UNIFORM) {
+    std::shared_ptr<pa::SequenceDistribution> lengths;
+    FAIL_IF_ERR(
+        pa::MakeSequenceDistribution(
+            params_->sequence_length_distribution, params_->sequence_length,
+            &lengths),
+        "failed to create the sequence length distribution");
+    manager->SetSequenceLengthDistribution(lengths);
+  }
+  if (!params_->input_shape_distributions.empty()) {
+    std::vector<std::shared_ptr<const pa::ShapeDistribution>> distributions;
+    for (const auto& settings : params_->input_shape_distributions) {
+      std::shared_ptr<pa::ShapeDistribution> distribution;
+      FAIL_IF_ERR(
+          pa::ShapeDistribution::Create(settings, &distribution),
+          "failed to create the shape distribution of input '" +
+              settings.input_name + "'");
+      distributions.push_back(distribution);
+    }
+    manager->SetInputShapeDistributions(
+        distributions, params_->input_shape_count);
+  }
+  if (params_->using_sequence_think_time) {
+    std::shared_ptr<pa::SequenceDistribution> think_time;
+    FAIL_IF_ERR(
+        pa::MakeSequenceDistribution(
+            params_->sequence_think_time, 0, &think_time),
+        "failed to create the sequence think time distribution");
+    manager->SetSequenceThinkTime(think_time);
+  }
+  if (params_->mpi_distributed_load) {
+    // The ranks all read the same data, each sends its own streams of it
+    manager->SetDataShard(
+        params_->mpi_driver->MPICommRankWorld(),
+        params_->mpi_driver->MPICommSizeWorld());
+  }
+
+  if (params_->input_repeat_ratio > 0) {
+    manager->EnableInputRepeat(std::make_shared<pa::InputRepeat>(
+        params_->input_repeat_ratio, params_->input_popularity_skew));
+  }
+  if (params_->latency_bucketing != pa::BUCKET_NONE) {
+    manager->EnableLatencyBuckets(params_->latency_bucketing);
+  } else if (!params_->model_mix.empty()) {
+    manager->EnableLatencyBuckets(pa::BUCKET_MODEL);
+  }
+  if (!params_->request_classes.empty()) {
+    manager->EnableRequestClasses(
+        std::make_shared<pa::RequestClassMix>(params_->request_classes));
+  }
+  if (!params_->endpoints.empty()) {
+    manager->EnableEndpoints(std::make_shared<pa::EndpointMix>(
+        params_->endpoints, params_->endpoint_policy));
+  }
+  return manager;
+}
+
+void
+PerfAnalyzer::CreateProfiler(std::unique_ptr<pa::LoadManager> manager)
+{
+  // The profiler of a previous batch size took the first backend
+  if (backend_ == nullptr) {
+    FAIL_IF_ERR(
+        factory_->CreateClientBackend(&backend_),
+        "failed to create triton client backend");
+  }
+
+  pa::WarmupOptions warmup;
+  warmup.request_count = params_->warmup_request_count;
+  warmup.outlier_factor = params_->latency_outlier_factor;
 
   FAIL_IF_ERR(
       pa::InferenceProfiler::Create(
@@ -257,15 +614,109 @@ PerfAnalyzer::CreateAnalyzerObjects()
           parser_, std::move(backend_), std::move(manager), &profiler_,
           params_->measurement_request_count, params_->measurement_mode,
           params_->mpi_driver, params_->metrics_interval_ms,
-          params_->should_collect_metrics, params_->overhead_pct_threshold),
+          params_->should_collect_metrics, params_->overhead_pct_threshold,
+          params_->early_convergence, params_->settle_window_ms, warmup,
+          distributed_load_, window_clock_, request_record_writer_,
+          checkpoint_, endpoint_backends_),
       "failed to create profiler");
 }
 
+void
+PerfAnalyzer::OpenCheckpoint()
+{
+  std::stringstream settings;
+  settings << "model=" << params_->model_name
+           << " version=" << params_->model_version
+           << " batch_size=" << params_->batch_size << " load="
+           << (params_->targeting_concurrency() ? "concurrency"
+                                                : "request_rate");
+  FAIL_IF_ERR(
+      pa::SweepCheckpoint::Create(
+          params_->checkpoint_file, settings.str(), &checkpoint_),
+      "failed to open the checkpoint file");
+  if (checkpoint_->CompletedCount() == 0) {
+    return;
+  }
+
+  std::cout << "Resuming the sweep after the " << checkpoint_->CompletedCount()
+            << " load levels completed in " << params_->checkpoint_file
+            << std::endl;
+  // The server may still be restarting after what stopped the sweep
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(RESUME_READY_TIMEOUT_S);
+  while (true) {
+    bool ready = false;
+    cb::Error err = backend_->ModelReady(
+        &ready, params_->model_name, params_->model_version);
+    if (err.IsOk() && ready) {
+      return;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      std::cerr << "error: the model is not ready to resume the sweep after "
+                << RESUME_READY_TIMEOUT_S << " seconds"
+                << (err.IsOk() ? "" : ": " + err.Message()) << std::endl;
+      throw pa::PerfAnalyzerException(pa::GENERIC_ERROR);
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+void
+PerfAnalyzer::CreateModelLoadBenchmark()
+{
+  pa::ModelLoadBenchmark::InferFn infer;
+  FAIL_IF_ERR(
+      pa::ModelLoadBenchmark::ZeroRequest(
+          backend_.get(), params_->model_name, params_->model_version,
+          *parser_->Inputs(), parser_->MaxBatchSize() != 0, &infer),
+      "failed to create the first request after each load");
+
+  const std::chrono::milliseconds metrics_interval(
+      params_->should_collect_metrics ? params_->metrics_interval_ms : 0);
+  model_load_benchmark_ = std::make_unique<pa::ModelLoadBenchmark>(
+      backend_.get(), params_->model_name, ModelLoadConfig(),
+      std::move(infer), metrics_interval);
+}
+
+std::string
+PerfAnalyzer::ModelLoadConfig()
+{
+  if (params_->model_load_config_file.empty()) {
+    return "";
+  }
+  std::vector<char> contents;
+  FAIL_IF_ERR(
+      pa::ReadFile(params_->model_load_config_file, &contents),
+      "failed to read the model config to load");
+  return std::string(contents.begin(), contents.end());
+}
+
+void
+PerfAnalyzer::BenchmarkModelLoad()
+{
+  std::cout << "*** Measurement Settings ***" << std::endl
+            << "  Unloading and loading model '" << params_->model_name
+            << "' " << params_->model_load_iterations << " times" << std::endl
+            << std::endl;
+
+  std::vector<pa::ModelLoadSample> samples;
+  FAIL_IF_ERR(
+      model_load_benchmark_->Run(params_->model_load_iterations, &samples),
+      "failed to benchmark the model load");
+  pa::ModelLoadBenchmark::Report(
+      samples, params_->should_collect_metrics, std::cout);
+}
+
 void
 PerfAnalyzer::PrerunReport()
 {
   std::cout << "*** Measurement Settings ***" << std::endl;
-  if (params_->kind == cb::BackendKind::TRITON || params_->using_batch_size) {
+  if (params_->using_batch_size_range) {
+    std::cout << "  Batch sizes: " << params_->batch_size_range.start
+              << " to " << params_->batch_size_range.end << " by "
+              << params_->batch_size_range.step << std::endl;
+  } else if (
+      params_->kind == cb::BackendKind::TRITON || params_->using_batch_size) {
     std::cout << "  Batch size: " << params_->batch_size << std::endl;
   }
   if (params_->kind == cb::BackendKind::TRITON_C_API) {
@@ -276,6 +727,10 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Service Kind: TorchServe" << std::endl;
   } else if (params_->kind == cb::BackendKind::TENSORFLOW_SERVING) {
     std::cout << "  Service Kind: TensorFlow Serving" << std::endl;
+  } else if (params_->kind == cb::BackendKind::HTTP_JSON) {
+    std::cout << "  Service Kind: HTTP JSON" << std::endl;
+  } else if (params_->kind == cb::BackendKind::NULL_SERVER) {
+    std::cout << "  Service Kind: Null Server" << std::endl;
   }
 
   if (params_->measurement_mode == pa::MeasurementMode::COUNT_WINDOWS) {
@@ -291,6 +746,24 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Minimum number of samples in each window: "
               << params_->measurement_request_count << std::endl;
   }
+  if (params_->warmup_request_count != 0) {
+    std::cout << "  Warmup requests before each level: "
+              << params_->warmup_request_count << std::endl;
+  }
+  if (params_->latency_outlier_factor != 0) {
+    std::cout << "  Excluding latencies over "
+              << params_->latency_outlier_factor << "x the window median"
+              << std::endl;
+  }
+  if (params_->latency_bucketing == pa::BUCKET_DATA_STREAM) {
+    std::cout << "  Latency breakdown by data stream" << std::endl;
+  } else if (params_->latency_bucketing == pa::BUCKET_INPUT_SHAPE) {
+    std::cout << "  Latency breakdown by input shape" << std::endl;
+  } else if (
+      (params_->latency_bucketing == pa::BUCKET_MODEL) ||
+      !params_->model_mix.empty()) {
+    std::cout << "  Latency breakdown by model" << std::endl;
+  }
   if (params_->concurrency_range.end != 1) {
     std::cout << "  Latency limit: " << params_->latency_threshold_ms << " msec"
               << std::endl;
@@ -325,6 +798,8 @@ PerfAnalyzer::PrerunReport()
   }
   if (params_->search_mode == pa::SearchMode::BINARY) {
     std::cout << "  Using Binary Search algorithm" << std::endl;
+  } else if (params_->search_mode == pa::SearchMode::CAPACITY) {
+    std::cout << "  Using capacity search" << std::endl;
   }
   if (params_->async) {
     std::cout << "  Using asynchronous calls for inference" << std::endl;
@@ -332,11 +807,22 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Using synchronous calls for inference" << std::endl;
   }
   if (parser_->IsDecoupled()) {
-    std::cout << "  Detected decoupled model, using the first response for "
-                 "measuring latency"
+    std::cout << "  Detected decoupled model, measuring latency until the "
+                 "final response of each request"
               << std::endl;
   }
 
+  if (window_clock_.IsAligned()) {
+    std::cout << "  Aligning measurement windows to "
+              << params_->window_alignment_ms << " msec boundaries"
+              << std::endl;
+  }
+  if (params_->mpi_driver->IsMPIRun() &&
+      (window_clock_.IsAligned() || params_->mpi_distributed_load)) {
+    std::cout << "  Clock offset to MPI rank 0: "
+              << window_clock_.offset_ns / 1000 << " usec" << std::endl;
+  }
+
   if (params_->percentile == -1) {
     std::cout << "  Stabilizing using average latency" << std::endl;
   } else {
@@ -351,17 +837,52 @@ PerfAnalyzer::Profile()
 {
   params_->mpi_driver->MPIBarrierWorld();
 
+  if (time_series_writer_ != nullptr) {
+    time_series_writer_->Start();
+  }
+
   cb::Error err;
-  if (params_->targeting_concurrency()) {
-    err = profiler_->Profile<size_t>(
-        params_->concurrency_range.start, params_->concurrency_range.end,
-        params_->concurrency_range.step, params_->search_mode, perf_statuses_);
-  } else {
-    err = profiler_->Profile<double>(
-        params_->request_rate_range[pa::SEARCH_RANGE::kSTART],
-        params_->request_rate_range[pa::SEARCH_RANGE::kEND],
-        params_->request_rate_range[pa::SEARCH_RANGE::kSTEP],
-        params_->search_mode, perf_statuses_);
+  for (size_t batch_size = params_->batch_size;;) {
+    if (params_->using_batch_size_range) {
+      std::cout << "Batch size: " << batch_size << std::endl;
+    }
+    if (params_->targeting_concurrency()) {
+      err = profiler_->Profile<size_t>(
+          params_->concurrency_range.start, params_->concurrency_range.end,
+          params_->concurrency_range.step, params_->search_mode,
+          perf_statuses_);
+    } else {
+      err = profiler_->Profile<double>(
+          params_->request_rate_range[pa::SEARCH_RANGE::kSTART],
+          params_->request_rate_range[pa::SEARCH_RANGE::kEND],
+          params_->request_rate_range[pa::SEARCH_RANGE::kSTEP],
+          params_->search_mode, perf_statuses_);
+    }
+
+    batch_size += params_->batch_size_range.step;
+    if (!params_->using_batch_size_range || !err.IsOk() || pa::early_exit ||
+        (batch_size > params_->batch_size_range.end)) {
+      break;
+    }
+    ChangeBatchSize(batch_size);
+  }
+
+  if (time_series_writer_ != nullptr) {
+    time_series_writer_->Stop();
+  }
+  if (client_tracer_ != nullptr) {
+    cb::Error trace_err =
+        client_tracer_->WriteChromeTrace(params_->client_trace_file);
+    if (!trace_err.IsOk()) {
+      std::cerr << "WARNING: " << trace_err.Message() << std::endl;
+    }
+  }
+  if (schedule_recorder_ != nullptr) {
+    cb::Error schedule_err =
+        schedule_recorder_->Write(params_->schedule_record_file);
+    if (!schedule_err.IsOk()) {
+      std::cerr << "WARNING: " << schedule_err.Message() << std::endl;
+    }
   }
 
   params_->mpi_driver->MPIBarrierWorld();
@@ -376,6 +897,28 @@ PerfAnalyzer::Profile()
   }
 }
 
+void
+PerfAnalyzer::ChangeBatchSize(const size_t batch_size)
+{
+  params_->batch_size = batch_size;
+  std::unique_ptr<pa::LoadManager> manager = CreateLoadManager();
+  // The input data is taken before the load of the previous batch size
+  // stops, and its shared memory regions are released before the new ones
+  // are registered
+  manager->ReuseInputData(profiler_->GetLoadManager());
+  profiler_.reset();
+  // Stopping the load set early_exit, as when a signal is caught
+  if (!pa::interrupted) {
+    pa::early_exit = false;
+  }
+  manager->InitManager(
+      params_->string_length, params_->string_data, params_->zero_input,
+      params_->user_data, params_->start_sequence_id,
+      params_->sequence_id_range, params_->sequence_length,
+      params_->sequence_length_specified, params_->sequence_length_variation);
+  CreateProfiler(std::move(manager));
+}
+
 void
 PerfAnalyzer::WriteReport()
 {
@@ -392,6 +935,9 @@ PerfAnalyzer::WriteReport()
   }
 
   for (pa::PerfStatus& status : perf_statuses_) {
+    if (params_->using_batch_size_range) {
+      std::cout << "Batch size: " << status.batch_size << ", ";
+    }
     if (params_->targeting_concurrency()) {
       std::cout << "Concurrency: " << status.concurrency << ", ";
     } else {
@@ -402,6 +948,16 @@ PerfAnalyzer::WriteReport()
               << (status.stabilizing_latency_ns / 1000) << " usec" << std::endl;
   }
 
+  if (params_->search_mode == pa::SearchMode::CAPACITY) {
+    ReportCapacity();
+  }
+
+  // The ranks of a distributed load all hold the same merged results
+  if (params_->mpi_distributed_load &&
+      (params_->mpi_driver->MPICommRankWorld() != 0)) {
+    return;
+  }
+
   bool should_output_metrics{params_->should_collect_metrics &&
                              params_->verbose_csv};
 
@@ -417,6 +973,51 @@ PerfAnalyzer::WriteReport()
   writer->GenerateReport();
 }
 
+void
+PerfAnalyzer::ReportCapacity()
+{
+  std::map<size_t, std::vector<pa::CapacitySample>> samples;
+  for (const pa::PerfStatus& status : perf_statuses_) {
+    samples[status.batch_size].push_back(
+        pa::ToCapacitySample(status, params_->targeting_concurrency()));
+  }
+  for (const auto& batch_samples : samples) {
+    std::cout << std::endl;
+    if (params_->using_batch_size_range) {
+      std::cout << "Batch size: " << batch_samples.first << ", ";
+    }
+    pa::CapacityModel model;
+    cb::Error err = pa::CapacityModel::Fit(
+        batch_samples.second, params_->targeting_concurrency(), &model);
+    if (!err.IsOk()) {
+      std::cout << "No capacity estimate: " << err.Message() << std::endl;
+      continue;
+    }
+    pa::ReportCapacity(
+        batch_samples.second, model, batch_samples.first, std::cout);
+  }
+}
+
+bool
+PerfAnalyzer::CompareWithBaseline()
+{
+  if (baseline_.empty() || perf_statuses_.empty()) {
+    return false;
+  }
+  const double threshold = params_->regression_threshold / 100;
+  const auto comparisons = pa::CompareWithBaseline(
+      baseline_, perf_statuses_, params_->targeting_concurrency(), threshold);
+  // The ranks of a distributed load all hold the same merged results
+  std::stringstream report;
+  const bool regressed = pa::ReportBaselineComparison(
+      comparisons, params_->targeting_concurrency(), threshold, report);
+  if (!params_->mpi_distributed_load ||
+      (params_->mpi_driver->MPICommRankWorld() == 0)) {
+    std::cout << report.str();
+  }
+  return regressed;
+}
+
 void
 PerfAnalyzer::Finalize()
 {
@@ -28,13 +28,19 @@
 #include <getopt.h>
 #include <signal.h>
 #include <algorithm>
+#include "baseline_comparison.h"
+#include "client_trace.h"
 #include "command_line_parser.h"
 #include "concurrency_manager.h"
 #include "custom_load_manager.h"
 #include "inference_profiler.h"
+#include "model_load_benchmark.h"
 #include "model_parser.h"
 #include "mpi_utils.h"
 #include "perf_utils.h"
+#include "schedule_recorder.h"
+#include "sweep_checkpoint.h"
+#include "time_series_writer.h"
 
 // Perf Analyzer provides various metrics to measure the performance of
 // the inference server. It can either be used to measure the throughput,
@@ -177,9 +183,31 @@ class PerfAnalyzer {
  private:
   pa::PAParamsPtr params_;
   std::unique_ptr<pa::InferenceProfiler> profiler_;
+  // Declared after profiler_ so that it stops before the load manager it
+  // samples is destroyed
+  std::unique_ptr<pa::TimeSeriesWriter> time_series_writer_;
+  // Traces a sample of the requests, if a client trace file is given
+  std::shared_ptr<pa::ClientTracer> client_tracer_;
+  // Records the requests sent on a schedule, if a schedule record file is
+  // given
+  std::shared_ptr<pa::ScheduleRecorder> schedule_recorder_;
   std::unique_ptr<cb::ClientBackend> backend_;
+  std::shared_ptr<cb::ClientBackendFactory> factory_;
   std::shared_ptr<pa::ModelParser> parser_;
+  // Kept across the profilers of a --batch-size-range
+  std::map<std::string, std::shared_ptr<cb::ClientBackend>> endpoint_backends_;
+  std::shared_ptr<pa::RequestRecordWriter> request_record_writer_;
+  std::shared_ptr<pa::DistributedLoad> distributed_load_;
   std::vector<pa::PerfStatus> perf_statuses_;
+  // The clock the measurement windows follow
+  pa::WindowClock window_clock_;
+  // Cycles the model instead of profiling it, if --model-load-iterations is
+  // given
+  std::unique_ptr<pa::ModelLoadBenchmark> model_load_benchmark_;
+  // The results to compare against, if --baseline is given
+  std::vector<pa::BaselineLevel> baseline_;
+  // Keeps the completed load levels, if --checkpoint-file is given
+  std::shared_ptr<pa::SweepCheckpoint> checkpoint_;
 
   //
   // Helper methods
@@ -188,8 +216,23 @@ class PerfAnalyzer {
   // Parse the options out of the command line argument
   //
   void CreateAnalyzerObjects();
+  // Creates the load manager of the load and batch size of params_, which
+  // is yet to be initialized
+  std::unique_ptr<pa::LoadManager> CreateLoadManager();
+  void CreateProfiler(std::unique_ptr<pa::LoadManager> manager);
+  // Replaces the profiler with one whose load has the given batch size,
+  // keeping the model, the input data and the client backends
+  void ChangeBatchSize(const size_t batch_size);
+  void CreateModelLoadBenchmark();
+  void BenchmarkModelLoad();
+  std::string ModelLoadConfig();
+  void OpenCheckpoint();
   void PrerunReport();
   void Profile();
   void WriteReport();
+  // Prints the capacity model fitted to the load levels of each batch size
+  void ReportCapacity();
+  // Returns whether any metric regressed from the baseline
+  bool CompareWithBaseline();
   void Finalize();
 };
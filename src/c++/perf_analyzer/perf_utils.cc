@@ -29,10 +29,14 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
 #include "client_backend/client_backend.h"
 #include "doctest.h"
+#include "tensor_convert.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -163,23 +167,14 @@ IsFile(const std::string& complete_path)
 int64_t
 ByteSize(const std::vector<int64_t>& shape, const std::string& datatype)
 {
-  int one_element_size;
-  if ((datatype.compare("BOOL") == 0) || (datatype.compare("INT8") == 0) ||
-      (datatype.compare("UINT8") == 0)) {
-    one_element_size = 1;
-  } else if (
-      (datatype.compare("INT16") == 0) || (datatype.compare("UINT16") == 0) ||
-      (datatype.compare("FP16") == 0) || (datatype.compare("BF16") == 0)) {
-    one_element_size = 2;
-  } else if (
-      (datatype.compare("INT32") == 0) || (datatype.compare("UINT32") == 0) ||
-      (datatype.compare("FP32") == 0)) {
-    one_element_size = 4;
-  } else if (
-      (datatype.compare("INT64") == 0) || (datatype.compare("UINT64") == 0) ||
-      (datatype.compare("FP64") == 0)) {
-    one_element_size = 8;
-  } else {
+  return ByteSize(shape, ParseDataType(datatype));
+}
+
+int64_t
+ByteSize(const std::vector<int64_t>& shape, DataType type)
+{
+  const int64_t one_element_size = DataTypeByteSize(type);
+  if (one_element_size == 0) {
     return -1;
   }
 
@@ -210,155 +205,347 @@ ElementCount(const std::vector<int64_t>& shape)
   return count;
 }
 
+namespace {
+
+// Appends each string prefixed with its 4 byte length. The buffer is grown
+// once for all of the strings.
+template <typename Strings, typename GetString>
+void
+AppendLengthPrefixed(
+    const Strings& strings, GetString get_string,
+    std::vector<char>* serialized_data)
+{
+  size_t byte_size = 0;
+  for (const auto& s : strings) {
+    byte_size += sizeof(uint32_t) + get_string(s).second;
+  }
+
+  const size_t offset = serialized_data->size();
+  serialized_data->resize(offset + byte_size);
+  char* dst = serialized_data->data() + offset;
+  for (const auto& s : strings) {
+    const auto str = get_string(s);
+    const uint32_t len = str.second;
+    std::memcpy(dst, &len, sizeof(uint32_t));
+    std::memcpy(dst + sizeof(uint32_t), str.first, len);
+    dst += sizeof(uint32_t) + len;
+  }
+}
+
+}  // namespace
+
 void
 SerializeStringTensor(
-    std::vector<std::string> string_tensor, std::vector<char>* serialized_data)
+    const std::vector<std::string>& string_tensor,
+    std::vector<char>* serialized_data)
+{
+  AppendLengthPrefixed(
+      string_tensor,
+      [](const std::string& s) { return std::make_pair(s.data(), s.size()); },
+      serialized_data);
+}
+
+namespace {
+
+// Appends every element of a json array as type T, after checking each one
+// with is_type. The buffer is grown once for the whole array.
+template <typename T, typename IsType, typename GetValue>
+cb::Error
+SerializeNumericTensor(
+    const rapidjson::Value& tensor, const std::string& type_name,
+    IsType is_type, GetValue get_value, std::vector<char>* decoded_data)
 {
-  std::string serialized = "";
-  for (auto s : string_tensor) {
-    uint32_t len = s.size();
-    serialized.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
-    serialized.append(s);
+  const size_t offset = decoded_data->size();
+  decoded_data->resize(offset + tensor.Size() * sizeof(T));
+  char* dst = decoded_data->data() + offset;
+  for (const auto& value : tensor.GetArray()) {
+    if (!is_type(value)) {
+      decoded_data->resize(offset);
+      return cb::Error(
+          "unable to find " + type_name + " data in json", pa::GENERIC_ERROR);
+    }
+    T element(static_cast<T>(get_value(value)));
+    std::memcpy(dst, &element, sizeof(T));
+    dst += sizeof(T);
   }
+  return cb::Error::Success;
+}
 
-  std::copy(
-      serialized.begin(), serialized.end(),
-      std::back_inserter(*serialized_data));
+// Reads a json array of numbers as floats and appends it narrowed to a 16-bit
+// floating point type by the given conversion kernel.
+cb::Error
+SerializeHalfTensor(
+    const rapidjson::Value& tensor, const std::string& type_name,
+    void (*convert)(const float*, size_t, uint16_t*),
+    std::vector<char>* decoded_data)
+{
+  std::vector<float> values;
+  values.reserve(tensor.Size());
+  for (const auto& value : tensor.GetArray()) {
+    if (!value.IsNumber()) {
+      return cb::Error(
+          "unable to find " + type_name + " data in json", pa::GENERIC_ERROR);
+    }
+    values.push_back(value.GetFloat());
+  }
+  std::vector<uint16_t> converted(values.size());
+  convert(values.data(), values.size(), converted.data());
+  const char* src = reinterpret_cast<const char*>(converted.data());
+  decoded_data->insert(
+      decoded_data->end(), src, src + converted.size() * sizeof(uint16_t));
+  return cb::Error::Success;
 }
 
+}  // namespace
+
 cb::Error
 SerializeExplicitTensor(
-    const rapidjson::Value& tensor, const std::string& dt,
+    const rapidjson::Value& tensor, DataType type,
     std::vector<char>* decoded_data)
 {
-  if (dt.compare("BYTES") == 0) {
-    std::string serialized = "";
-    for (const auto& value : tensor.GetArray()) {
-      if (!value.IsString()) {
-        return cb::Error(
-            "unable to find string data in json", pa::GENERIC_ERROR);
-      }
-      std::string element(value.GetString());
-      uint32_t len = element.size();
-      serialized.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
-      serialized.append(element);
-    }
-    std::copy(
-        serialized.begin(), serialized.end(),
-        std::back_inserter(*decoded_data));
-  } else {
-    for (const auto& value : tensor.GetArray()) {
-      if (dt.compare("BOOL") == 0) {
-        if (!value.IsBool()) {
-          return cb::Error(
-              "unable to find bool data in json", pa::GENERIC_ERROR);
-        }
-        bool element(value.GetBool());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(bool));
-      } else if (dt.compare("UINT8") == 0) {
-        if (!value.IsUint()) {
-          return cb::Error(
-              "unable to find uint8_t data in json", pa::GENERIC_ERROR);
-        }
-        uint8_t element(static_cast<uint8_t>(value.GetUint()));
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(uint8_t));
-      } else if (dt.compare("INT8") == 0) {
-        if (!value.IsInt()) {
-          return cb::Error(
-              "unable to find int8_t data in json", pa::GENERIC_ERROR);
-        }
-        int8_t element(static_cast<int8_t>(value.GetInt()));
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(int8_t));
-      } else if (dt.compare("UINT16") == 0) {
-        if (!value.IsUint()) {
-          return cb::Error(
-              "unable to find uint16_t data in json", pa::GENERIC_ERROR);
-        }
-        uint16_t element(static_cast<uint16_t>(value.GetUint()));
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(uint16_t));
-      } else if (dt.compare("INT16") == 0) {
-        if (!value.IsInt()) {
-          return cb::Error(
-              "unable to find int16_t data in json", pa::GENERIC_ERROR);
-        }
-        int16_t element(static_cast<int16_t>(value.GetInt()));
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(int16_t));
-      } else if (dt.compare("FP16") == 0) {
-        return cb::Error(
-            "Can not use explicit tensor description for fp16 datatype",
-            pa::GENERIC_ERROR);
-      } else if (dt.compare("BF16") == 0) {
-        return cb::Error(
-            "Can not use explicit tensor description for bf16 datatype",
-            pa::GENERIC_ERROR);
-      } else if (dt.compare("UINT32") == 0) {
-        if (!value.IsUint()) {
-          return cb::Error(
-              "unable to find uint32_t data in json", pa::GENERIC_ERROR);
-        }
-        uint32_t element(value.GetUint());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(uint32_t));
-      } else if (dt.compare("INT32") == 0) {
-        if (!value.IsInt()) {
-          return cb::Error(
-              "unable to find int32_t data in json", pa::GENERIC_ERROR);
-        }
-        int32_t element(value.GetInt());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(int32_t));
-      } else if (dt.compare("FP32") == 0) {
-        if (!value.IsDouble()) {
-          return cb::Error(
-              "unable to find float data in json", pa::GENERIC_ERROR);
-        }
-        float element(value.GetFloat());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(float));
-      } else if (dt.compare("UINT64") == 0) {
-        if (!value.IsUint64()) {
-          return cb::Error(
-              "unable to find uint64_t data in json", pa::GENERIC_ERROR);
-        }
-        uint64_t element(value.GetUint64());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(uint64_t));
-      } else if (dt.compare("INT64") == 0) {
-        if (!value.IsInt64()) {
-          return cb::Error(
-              "unable to find int64_t data in json", pa::GENERIC_ERROR);
-        }
-        int64_t element(value.GetInt64());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(int64_t));
-      } else if (dt.compare("FP64") == 0) {
-        if (!value.IsDouble()) {
+  using Value = rapidjson::Value;
+  auto is_uint = [](const Value& v) { return v.IsUint(); };
+  auto get_uint = [](const Value& v) { return v.GetUint(); };
+  auto is_int = [](const Value& v) { return v.IsInt(); };
+  auto get_int = [](const Value& v) { return v.GetInt(); };
+
+  switch (type) {
+    case DataType::BYTES:
+      for (const auto& value : tensor.GetArray()) {
+        if (!value.IsString()) {
           return cb::Error(
-              "unable to find fp64 data in json", pa::GENERIC_ERROR);
+              "unable to find string data in json", pa::GENERIC_ERROR);
         }
-        double element(value.GetDouble());
-        const char* src = reinterpret_cast<const char*>(&element);
-        decoded_data->insert(decoded_data->end(), src, src + sizeof(double));
       }
-    }
+      AppendLengthPrefixed(
+          tensor.GetArray(),
+          [](const Value& v) {
+            return std::make_pair(
+                v.GetString(), static_cast<size_t>(v.GetStringLength()));
+          },
+          decoded_data);
+      break;
+    case DataType::BOOL:
+      return SerializeNumericTensor<bool>(
+          tensor, "bool", [](const Value& v) { return v.IsBool(); },
+          [](const Value& v) { return v.GetBool(); }, decoded_data);
+    case DataType::UINT8:
+      return SerializeNumericTensor<uint8_t>(
+          tensor, "uint8_t", is_uint, get_uint, decoded_data);
+    case DataType::INT8:
+      return SerializeNumericTensor<int8_t>(
+          tensor, "int8_t", is_int, get_int, decoded_data);
+    case DataType::UINT16:
+      return SerializeNumericTensor<uint16_t>(
+          tensor, "uint16_t", is_uint, get_uint, decoded_data);
+    case DataType::INT16:
+      return SerializeNumericTensor<int16_t>(
+          tensor, "int16_t", is_int, get_int, decoded_data);
+    case DataType::FP16:
+      return SerializeHalfTensor(
+          tensor, "fp16", triton::client::ConvertFp32ToFp16, decoded_data);
+    case DataType::BF16:
+      return SerializeHalfTensor(
+          tensor, "bf16", triton::client::ConvertFp32ToBf16, decoded_data);
+    case DataType::UINT32:
+      return SerializeNumericTensor<uint32_t>(
+          tensor, "uint32_t", is_uint, get_uint, decoded_data);
+    case DataType::INT32:
+      return SerializeNumericTensor<int32_t>(
+          tensor, "int32_t", is_int, get_int, decoded_data);
+    case DataType::FP32:
+      return SerializeNumericTensor<float>(
+          tensor, "float", [](const Value& v) { return v.IsDouble(); },
+          [](const Value& v) { return v.GetFloat(); }, decoded_data);
+    case DataType::UINT64:
+      return SerializeNumericTensor<uint64_t>(
+          tensor, "uint64_t", [](const Value& v) { return v.IsUint64(); },
+          [](const Value& v) { return v.GetUint64(); }, decoded_data);
+    case DataType::INT64:
+      return SerializeNumericTensor<int64_t>(
+          tensor, "int64_t", [](const Value& v) { return v.IsInt64(); },
+          [](const Value& v) { return v.GetInt64(); }, decoded_data);
+    case DataType::FP64:
+      return SerializeNumericTensor<double>(
+          tensor, "fp64", [](const Value& v) { return v.IsDouble(); },
+          [](const Value& v) { return v.GetDouble(); }, decoded_data);
+    default:
+      break;
   }
   return cb::Error::Success;
 }
 
+void
+DecodeBase64(const char* encoded, size_t length, std::vector<char>* decoded)
+{
+  // Maps each character to its 6 bit value, or to 0xFF if it is not part of
+  // the alphabet. Like libb64, characters outside of the alphabet, padding
+  // included, are skipped.
+  static const std::array<uint8_t, 256> kDecodeTable = [] {
+    std::array<uint8_t, 256> table;
+    table.fill(0xFF);
+    const char* alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (uint8_t i = 0; i < 64; i++) {
+      table[static_cast<uint8_t>(alphabet[i])] = i;
+    }
+    return table;
+  }();
+
+  decoded->resize((length / 4 + 1) * 3);
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(encoded);
+  char* out = decoded->data();
+  uint32_t bits = 0;
+  int bit_count = 0;
+  size_t i = 0;
+  while (i < length) {
+    // Whole quads of alphabet characters, which is all of the input but the
+    // end for well formed data, are decoded without per character branches
+    if ((bit_count == 0) && (i + 4 <= length)) {
+      const uint32_t a = kDecodeTable[in[i]];
+      const uint32_t b = kDecodeTable[in[i + 1]];
+      const uint32_t c = kDecodeTable[in[i + 2]];
+      const uint32_t d = kDecodeTable[in[i + 3]];
+      if (((a | b | c | d) & 0x80) == 0) {
+        const uint32_t value = (a << 18) | (b << 12) | (c << 6) | d;
+        out[0] = static_cast<char>(value >> 16);
+        out[1] = static_cast<char>(value >> 8);
+        out[2] = static_cast<char>(value);
+        out += 3;
+        i += 4;
+        continue;
+      }
+    }
+
+    const uint8_t value = kDecodeTable[in[i++]];
+    if (value & 0x80) {
+      continue;
+    }
+    bits = (bits << 6) | value;
+    bit_count += 6;
+    if (bit_count >= 8) {
+      bit_count -= 8;
+      *out++ = static_cast<char>(bits >> bit_count);
+      bits &= (1u << bit_count) - 1;
+    }
+  }
+  decoded->resize(out - decoded->data());
+}
+
+namespace {
+
+// xoshiro256** by Blackman and Vigna, seeded through splitmix64. Much
+// cheaper to seed and to draw from than std::mt19937_64, and each draw gives
+// 8 bytes.
+class Xoshiro256
+{
+ public:
+  explicit Xoshiro256(uint64_t seed)
+  {
+    for (auto& word : state_) {
+      seed += 0x9e3779b97f4a7c15;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  uint64_t operator()()
+  {
+    const uint64_t result = Rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = Rotl(state_[3], 45);
+    return result;
+  }
+
+ private:
+  static uint64_t Rotl(const uint64_t x, int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t state_[4];
+};
+
+// Buffers are filled in chunks, each from a generator of its own, so that
+// the content only depends on the seed and not on the number of threads
+constexpr size_t kRandomChunkSize = 1 << 20;
+
+// Fills [data, data + size) with random bytes passed through map, spreading
+// the chunks over threads when there are several of them
+template <typename Map>
+void
+FillRandom(uint64_t seed, char* data, size_t size, Map map)
+{
+  const size_t chunk_count = (size + kRandomChunkSize - 1) / kRandomChunkSize;
+  auto fill_chunk = [&](size_t chunk) {
+    Xoshiro256 gen(seed + (static_cast<uint64_t>(chunk) << 32));
+    char* dst = data + chunk * kRandomChunkSize;
+    char* const end = dst + std::min(kRandomChunkSize, size - (dst - data));
+    while (dst < end) {
+      uint64_t bits = gen();
+      const size_t count = std::min<size_t>(sizeof(bits), end - dst);
+      for (size_t i = 0; i < count; i++) {
+        *dst++ = map(static_cast<uint8_t>(bits));
+        bits >>= 8;
+      }
+    }
+  };
+
+  const size_t thread_count = std::max<size_t>(
+      1, std::min<size_t>(std::thread::hardware_concurrency(), chunk_count));
+  auto fill_range = [&](size_t t) {
+    const size_t end = chunk_count * (t + 1) / thread_count;
+    for (size_t chunk = chunk_count * t / thread_count; chunk < end; chunk++) {
+      fill_chunk(chunk);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < thread_count; t++) {
+    threads.emplace_back(fill_range, t);
+  }
+  fill_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+void
+FillRandomBytes(uint64_t seed, char* data, size_t size)
+{
+  FillRandom(seed, data, size, [](uint8_t byte) { return byte; });
+}
+
+void
+FillRandomCharacters(uint64_t seed, char* data, size_t size)
+{
+  // Maps every byte to a character. As 256 is not a multiple of the size of
+  // the set, some characters are slightly more likely than others.
+  static const std::array<char, 256> kCharacterTable = [] {
+    std::array<char, 256> table;
+    for (size_t i = 0; i < table.size(); i++) {
+      table[i] = character_set[i * character_set.size() / table.size()];
+    }
+    return table;
+  }();
+  FillRandom(
+      seed, data, size, [](uint8_t byte) { return kCharacterTable[byte]; });
+}
+
 std::string
 GetRandomString(const int string_length)
 {
-  std::mt19937_64 gen{std::random_device()()};
-  std::uniform_int_distribution<size_t> dist{0, character_set.length() - 1};
-  std::string random_string;
-  std::generate_n(std::back_inserter(random_string), string_length, [&] {
-    return character_set[dist(gen)];
-  });
+  std::string random_string(string_length, '\0');
+  FillRandomCharacters(
+      std::random_device()(), &random_string[0], random_string.size());
   return random_string;
 }
 
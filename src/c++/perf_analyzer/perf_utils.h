@@ -39,6 +39,7 @@
 #include <random>
 
 #include "client_backend/client_backend.h"
+#include "datatype.h"
 
 namespace pa = triton::perfanalyzer;
 namespace cb = triton::perfanalyzer::clientbackend;
@@ -53,9 +54,14 @@ constexpr uint64_t NANOS_PER_MILLIS = 1000000;
 #define CHRONO_TO_MILLIS(TS) (CHRONO_TO_NANOS(TS) / pa::NANOS_PER_MILLIS)
 
 //==============================================================================
+// <start_time, end_time, sequence_end, delayed, first_response_time,
+// response_count> of each completed request. Only the requests of decoupled
+// models can receive more than one response, otherwise the first response
+// is the one that ends the request.
 using TimestampVector = std::vector<std::tuple<
     std::chrono::time_point<std::chrono::system_clock>,
-    std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool>>;
+    std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool,
+    std::chrono::time_point<std::chrono::system_clock>, uint32_t>>;
 
 // Will use the characters specified here to construct random strings
 std::string const character_set =
@@ -63,14 +69,45 @@ std::string const character_set =
 
 // A boolean flag to mark an interrupt and commencement of early exit
 extern volatile bool early_exit;
-
-enum Distribution { POISSON = 0, CONSTANT = 1, CUSTOM = 2 };
-enum SearchMode { LINEAR = 0, BINARY = 1, NONE = 2 };
+// Set on an interrupt only, unlike early_exit which also marks the end of a
+// load
+extern volatile bool interrupted;
+
+enum Distribution {
+  POISSON = 0,
+  CONSTANT = 1,
+  CUSTOM = 2,
+  BURSTY = 3,
+  MMPP = 4,
+  DIURNAL = 5
+};
+enum SearchMode {
+  LINEAR = 0,
+  BINARY = 1,
+  NONE = 2,
+  ADAPTIVE = 3,
+  CAPACITY = 4
+};
 enum SharedMemoryType {
   SYSTEM_SHARED_MEMORY = 0,
   CUDA_SHARED_MEMORY = 1,
   NO_SHARED_MEMORY = 2
 };
+// How the latencies of the requests are broken down besides their totals
+enum LatencyBucketing {
+  BUCKET_NONE = 0,
+  BUCKET_DATA_STREAM = 1,
+  BUCKET_INPUT_SHAPE = 2,
+  BUCKET_MODEL = 3
+};
+// What the request rate modes do with a request scheduled while the maximum
+// number of requests are in flight
+enum InflightOverload {
+  // Skip the request and count it as dropped
+  OVERLOAD_DROP = 0,
+  // Send the request as soon as a request in flight completes
+  OVERLOAD_QUEUE = 1
+};
 
 constexpr uint64_t NO_LIMIT = 0;
 
@@ -122,19 +159,35 @@ bool IsFile(const std::string& complete_path);
 int64_t ByteSize(
     const std::vector<int64_t>& shape, const std::string& datatype);
 
+// Calculates the byte size tensor for given shape and resolved datatype.
+int64_t ByteSize(const std::vector<int64_t>& shape, DataType type);
+
 // Get the number of elements in the tensor for given shape.
 int64_t ElementCount(const std::vector<int64_t>& shape);
 
 // Serializes the string tensor to length prepended bytes.
 void SerializeStringTensor(
-    std::vector<std::string> string_tensor, std::vector<char>* serialized_data);
+    const std::vector<std::string>& string_tensor,
+    std::vector<char>* serialized_data);
 
 // Serializes an explicit tensor read from the data file to the
 // raw bytes.
 cb::Error SerializeExplicitTensor(
-    const rapidjson::Value& tensor, const std::string& dt,
+    const rapidjson::Value& tensor, DataType type,
     std::vector<char>* decoded_data);
 
+// Decodes base64 encoded data, skipping any character that is not part of
+// the base64 alphabet.
+void DecodeBase64(
+    const char* encoded, size_t length, std::vector<char>* decoded);
+
+// Fills the buffer with pseudo random bytes. The same seed always gives the
+// same bytes, and large buffers are filled from several threads.
+void FillRandomBytes(uint64_t seed, char* data, size_t size);
+
+// Same as FillRandomBytes, with characters from character_set.
+void FillRandomCharacters(uint64_t seed, char* data, size_t size);
+
 // Generates a random string of specified length using characters specified in
 // character_set.
 std::string GetRandomString(const int string_length);
@@ -0,0 +1,109 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <errno.h>
+#include <time.h>
+#endif
+
+namespace triton { namespace perfanalyzer {
+
+/// Sleeps until a deadline with much less overshoot than sleep_for().
+///
+/// The bulk of the wait is an absolute-deadline sleep that ends a little
+/// before the deadline, and the remainder is spent spinning on the clock.
+/// The spin window is calibrated from the wake-up overshoot observed on
+/// previous sleeps, so it adapts to the scheduler latency of the host.
+///
+class PreciseSleeper {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Block until \p deadline has been reached.
+  void SleepUntil(Clock::time_point deadline)
+  {
+    const Clock::time_point coarse_deadline = deadline - spin_window_;
+    if (coarse_deadline > Clock::now()) {
+      CoarseSleepUntil(coarse_deadline);
+      Calibrate(Clock::now() - coarse_deadline);
+    }
+    while (Clock::now() < deadline) {
+      CpuRelax();
+    }
+  }
+
+  /// \return The current spin window.
+  std::chrono::nanoseconds SpinWindow() const { return spin_window_; }
+
+ private:
+  static constexpr std::chrono::nanoseconds MIN_SPIN_WINDOW{10000};
+  static constexpr std::chrono::nanoseconds MAX_SPIN_WINDOW{2000000};
+
+  static void CoarseSleepUntil(Clock::time_point deadline)
+  {
+#ifdef __linux__
+    // steady_clock is backed by CLOCK_MONOTONIC on Linux
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        deadline.time_since_epoch())
+                        .count();
+    struct timespec ts;
+    ts.tv_sec = ns / 1000000000;
+    ts.tv_nsec = ns % 1000000000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+  }
+
+  static void CpuRelax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+  // Track the average overshoot and spin for twice that to absorb jitter
+  void Calibrate(std::chrono::nanoseconds overshoot)
+  {
+    avg_overshoot_ += (overshoot - avg_overshoot_) / 8;
+    spin_window_ = std::min(
+        std::max(2 * avg_overshoot_, MIN_SPIN_WINDOW), MAX_SPIN_WINDOW);
+  }
+
+  std::chrono::nanoseconds avg_overshoot_{50000};
+  std::chrono::nanoseconds spin_window_{100000};
+};
+
+}}  // namespace triton::perfanalyzer
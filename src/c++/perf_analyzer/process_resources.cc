@@ -0,0 +1,189 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "process_resources.h"
+
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+uint64_t
+TimevalNs(const struct timeval& time)
+{
+  return static_cast<uint64_t>(time.tv_sec) * NANOS_PER_SECOND +
+         static_cast<uint64_t>(time.tv_usec) * 1000;
+}
+
+double
+PercentOf(const uint64_t used_ns, const uint64_t duration_ns)
+{
+  return (duration_ns == 0) ? 0.0 : 100.0 * used_ns / duration_ns;
+}
+
+uint64_t
+Delta(const uint64_t start, const uint64_t end)
+{
+  return (end > start) ? (end - start) : 0;
+}
+
+// Reads the CPU time of the threads of the process from procfs
+void
+SampleThreads(std::map<int, ThreadCpuTime>* threads)
+{
+  const long ticks_per_second = sysconf(_SC_CLK_TCK);
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr || ticks_per_second <= 0) {
+    if (dir != nullptr) {
+      closedir(dir);
+    }
+    return;
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    // The thread may exit while it is being read
+    std::ifstream file(
+        std::string("/proc/self/task/") + entry->d_name + "/stat");
+    std::string line;
+    std::string name;
+    uint64_t cpu_ticks = 0;
+    if (!file || !std::getline(file, line) ||
+        !ParseThreadStat(line, &name, &cpu_ticks).IsOk()) {
+      continue;
+    }
+    ThreadCpuTime& thread = (*threads)[std::atoi(entry->d_name)];
+    thread.name = std::move(name);
+    thread.cpu_ns = cpu_ticks * NANOS_PER_SECOND / ticks_per_second;
+  }
+  closedir(dir);
+}
+
+}  // namespace
+
+cb::Error
+ParseThreadStat(
+    const std::string& line, std::string* name, uint64_t* cpu_ticks)
+{
+  // The name is in parentheses and may itself contain spaces and parentheses
+  const size_t name_start = line.find('(');
+  const size_t name_end = line.rfind(')');
+  if (name_start == std::string::npos || name_end == std::string::npos ||
+      name_end < name_start) {
+    return cb::Error("invalid thread stat '" + line + "'", pa::GENERIC_ERROR);
+  }
+  // After the name come the state, then utime and stime as the 12th and 13th
+  // fields
+  std::istringstream fields(line.substr(name_end + 1));
+  std::string field;
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  for (int i = 0; i < 11; i++) {
+    fields >> field;
+  }
+  if (!(fields >> utime >> stime)) {
+    return cb::Error("invalid thread stat '" + line + "'", pa::GENERIC_ERROR);
+  }
+  *name = line.substr(name_start + 1, name_end - name_start - 1);
+  *cpu_ticks = utime + stime;
+  return cb::Error::Success;
+}
+
+cb::Error
+SampleProcessResources(ProcessResourceSample* sample)
+{
+  ProcessResourceSample sampled;
+  sampled.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return cb::Error(
+        "unable to get the resource usage of the process: " +
+            std::string(strerror(errno)),
+        pa::GENERIC_ERROR);
+  }
+  sampled.user_cpu_ns = TimevalNs(usage.ru_utime);
+  sampled.sys_cpu_ns = TimevalNs(usage.ru_stime);
+  sampled.voluntary_context_switches = usage.ru_nvcsw;
+  sampled.involuntary_context_switches = usage.ru_nivcsw;
+
+  // The second field is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size_pages = 0;
+  uint64_t resident_pages = 0;
+  if (statm >> size_pages >> resident_pages) {
+    sampled.rss_bytes = resident_pages * sysconf(_SC_PAGESIZE);
+  }
+  SampleThreads(&sampled.threads);
+
+  *sample = std::move(sampled);
+  return cb::Error::Success;
+}
+
+void
+SummarizeProcessResources(
+    const ProcessResourceSample& start, const ProcessResourceSample& end,
+    ClientResourceStats* stats)
+{
+  const uint64_t duration_ns = Delta(start.time_ns, end.time_ns);
+  stats->cpu_user_pct =
+      PercentOf(Delta(start.user_cpu_ns, end.user_cpu_ns), duration_ns);
+  stats->cpu_sys_pct =
+      PercentOf(Delta(start.sys_cpu_ns, end.sys_cpu_ns), duration_ns);
+  stats->rss_bytes = end.rss_bytes;
+  stats->voluntary_context_switches = Delta(
+      start.voluntary_context_switches, end.voluntary_context_switches);
+  stats->involuntary_context_switches = Delta(
+      start.involuntary_context_switches, end.involuntary_context_switches);
+
+  stats->thread_cpu_pct.clear();
+  stats->max_thread_cpu_pct = 0.0;
+  for (const auto& thread : end.threads) {
+    uint64_t start_cpu_ns = 0;
+    const auto it = start.threads.find(thread.first);
+    if (it != start.threads.end()) {
+      start_cpu_ns = it->second.cpu_ns;
+    }
+    const double pct =
+        PercentOf(Delta(start_cpu_ns, thread.second.cpu_ns), duration_ns);
+    stats->thread_cpu_pct[thread.second.name] += pct;
+    stats->max_thread_cpu_pct = std::max(stats->max_thread_cpu_pct, pct);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,97 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// The CPU time used by a thread of the process.
+struct ThreadCpuTime {
+  std::string name;
+  uint64_t cpu_ns{0};
+};
+
+/// The resources used by the process up to the time of the sample.
+struct ProcessResourceSample {
+  /// The time of the sample in nsec on the steady clock.
+  uint64_t time_ns{0};
+  uint64_t user_cpu_ns{0};
+  uint64_t sys_cpu_ns{0};
+  /// The resident set size at the time of the sample, 0 if unknown.
+  uint64_t rss_bytes{0};
+  uint64_t voluntary_context_switches{0};
+  uint64_t involuntary_context_switches{0};
+  /// The CPU time of each thread by thread id, empty where procfs is not
+  /// available.
+  std::map<int, ThreadCpuTime> threads;
+};
+
+/// The resources used by the perf_analyzer process over a measurement window.
+/// The CPU usages are in percent of one CPU, so that a saturated client
+/// thread shows as 100% whatever the number of CPUs.
+struct ClientResourceStats {
+  double cpu_user_pct{0.0};
+  double cpu_sys_pct{0.0};
+  uint64_t rss_bytes{0};
+  uint64_t voluntary_context_switches{0};
+  uint64_t involuntary_context_switches{0};
+  /// The CPU usage of the threads grouped by thread name, such as the worker
+  /// threads of the load manager.
+  std::map<std::string, double> thread_cpu_pct;
+  /// The CPU usage of the busiest thread.
+  double max_thread_cpu_pct{0.0};
+};
+
+/// Parses a line of the Linux /proc/<pid>/task/<tid>/stat files.
+/// \param line The line to parse.
+/// \param name Returns the name of the thread.
+/// \param cpu_ticks Returns the user and system CPU time of the thread in
+/// clock ticks.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseThreadStat(
+    const std::string& line, std::string* name, uint64_t* cpu_ticks);
+
+/// Samples the resources used by the calling process so far.
+/// \param sample Returns the sample.
+/// \return cb::Error object indicating success or failure.
+cb::Error SampleProcessResources(ProcessResourceSample* sample);
+
+/// Computes the resources used between two samples of the process. Threads
+/// created between the samples count from zero, threads that exited are not
+/// counted.
+/// \param start The sample at the start of the window.
+/// \param end The sample at the end of the window.
+/// \param stats Returns the resources used.
+void SummarizeProcessResources(
+    const ProcessResourceSample& start, const ProcessResourceSample& end,
+    ClientResourceStats* stats);
+
+}}  // namespace triton::perfanalyzer
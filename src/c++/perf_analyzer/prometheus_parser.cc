@@ -0,0 +1,295 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "prometheus_parser.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+const char*
+SkipBlanks(const char* begin, const char* end)
+{
+  while ((begin < end) && ((*begin == ' ') || (*begin == '\t'))) {
+    begin++;
+  }
+  return begin;
+}
+
+const char*
+FindBlank(const char* begin, const char* end)
+{
+  while ((begin < end) && (*begin != ' ') && (*begin != '\t')) {
+    begin++;
+  }
+  return begin;
+}
+
+bool
+StartsWith(const char* begin, const char* end, const char* prefix)
+{
+  const size_t length = std::strlen(prefix);
+  return (static_cast<size_t>(end - begin) >= length) &&
+         (std::strncmp(begin, prefix, length) == 0);
+}
+
+bool
+EndsWith(const std::string& name, const char* suffix)
+{
+  const size_t length = std::strlen(suffix);
+  return (name.size() > length) &&
+         (name.compare(name.size() - length, length, suffix) == 0);
+}
+
+/// \return The position of the '}' closing the labels that start at 'begin',
+/// or 'end' if they are not closed.
+const char*
+FindLabelsEnd(const char* begin, const char* end)
+{
+  bool in_quotes = false;
+  for (; begin < end; begin++) {
+    if (in_quotes && (*begin == '\\')) {
+      begin++;
+    } else if (*begin == '"') {
+      in_quotes = !in_quotes;
+    } else if (!in_quotes && (*begin == '}')) {
+      return begin;
+    }
+  }
+  return end;
+}
+
+/// \return Whether the labels hold a 'gpu_uuid' label, with its value in
+/// 'gpu_uuid'.
+bool
+FindGpuUuid(const char* begin, const char* end, std::string* gpu_uuid)
+{
+  static const char* const label = "gpu_uuid=\"";
+  const size_t length = std::strlen(label);
+  for (; (end - begin) > static_cast<ptrdiff_t>(length); begin++) {
+    if (std::strncmp(begin, label, length) == 0) {
+      const char* value = begin + length;
+      const char* value_end =
+          static_cast<const char*>(std::memchr(value, '"', end - value));
+      if (value_end == nullptr) {
+        return false;
+      }
+      gpu_uuid->assign(value, value_end);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+PrometheusParser::PrometheusParser(const std::vector<std::string>& families)
+    : families_(families.begin(), families.end())
+{
+}
+
+void
+PrometheusParser::Start(Metrics* metrics)
+{
+  metrics_ = metrics;
+  family_types_.clear();
+  partial_line_.clear();
+}
+
+void
+PrometheusParser::Feed(const char* data, size_t size)
+{
+  const char* end = data + size;
+  while (data < end) {
+    const char* newline =
+        static_cast<const char*>(std::memchr(data, '\n', end - data));
+    if (newline == nullptr) {
+      partial_line_.append(data, end);
+      return;
+    }
+    if (partial_line_.empty()) {
+      ParseLine(data, newline);
+    } else {
+      // The line began in a previous chunk
+      partial_line_.append(data, newline);
+      ParseLine(
+          partial_line_.data(), partial_line_.data() + partial_line_.size());
+      partial_line_.clear();
+    }
+    data = newline + 1;
+  }
+}
+
+void
+PrometheusParser::Finish()
+{
+  if (!partial_line_.empty()) {
+    ParseLine(
+        partial_line_.data(), partial_line_.data() + partial_line_.size());
+    partial_line_.clear();
+  }
+  metrics_ = nullptr;
+}
+
+void
+PrometheusParser::ParseLine(const char* begin, const char* end)
+{
+  if ((begin < end) && (*(end - 1) == '\r')) {
+    end--;
+  }
+  begin = SkipBlanks(begin, end);
+  if (begin == end) {
+    return;
+  }
+  if (*begin == '#') {
+    if (StartsWith(begin, end, "# TYPE ")) {
+      ParseType(begin + std::strlen("# TYPE "), end);
+    }
+    return;
+  }
+  ParseSample(begin, end);
+}
+
+void
+PrometheusParser::ParseType(const char* begin, const char* end)
+{
+  begin = SkipBlanks(begin, end);
+  const char* name_end = FindBlank(begin, end);
+  const std::string family(begin, name_end);
+  if (families_.find(family) == families_.end()) {
+    return;
+  }
+
+  const char* type = SkipBlanks(name_end, end);
+  const std::string type_name(type, FindBlank(type, end));
+  if (type_name == "counter") {
+    family_types_[family] = COUNTER;
+  } else if (type_name == "gauge") {
+    family_types_[family] = GAUGE;
+  } else if (type_name == "histogram") {
+    family_types_[family] = HISTOGRAM;
+  } else if (type_name == "summary") {
+    family_types_[family] = SUMMARY;
+  }
+}
+
+void
+PrometheusParser::ParseSample(const char* begin, const char* end)
+{
+  const char* name_end = begin;
+  while ((name_end < end) && (*name_end != '{') && (*name_end != ' ') &&
+         (*name_end != '\t')) {
+    name_end++;
+  }
+  const char* labels_end = name_end;
+  if ((name_end < end) && (*name_end == '{')) {
+    labels_end = FindLabelsEnd(name_end, end);
+    if (labels_end == end) {
+      return;
+    }
+    labels_end++;
+  }
+  const char* value = SkipBlanks(labels_end, end);
+  if (value == end) {
+    return;
+  }
+
+  // Most samples are not collected, so only their name is copied, into a
+  // buffer that is reused from line to line
+  name_.assign(begin, name_end);
+  const bool is_gpu_family =
+      (name_ == "nv_gpu_utilization") || (name_ == "nv_gpu_power_usage") ||
+      (name_ == "nv_gpu_memory_used_bytes") ||
+      (name_ == "nv_gpu_memory_total_bytes");
+  const std::string* family = &name_;
+  const char* suffix = "";
+  if (!is_gpu_family && (families_.find(name_) == families_.end())) {
+    for (const char* part : {"_bucket", "_sum", "_count"}) {
+      if (EndsWith(name_, part)) {
+        family_.assign(name_, 0, name_.size() - std::strlen(part));
+        family = &family_;
+        suffix = part;
+        break;
+      }
+    }
+    if ((family == &name_) || (families_.find(family_) == families_.end())) {
+      return;
+    }
+  }
+
+  char* value_end = nullptr;
+  const double sample = std::strtod(value, &value_end);
+  if (value_end == value) {
+    return;
+  }
+
+  if (is_gpu_family) {
+    std::string gpu_uuid;
+    if (!FindGpuUuid(name_end, labels_end, &gpu_uuid)) {
+      return;
+    }
+    if (name_ == "nv_gpu_utilization") {
+      metrics_->gpu_utilization_per_gpu[gpu_uuid] = sample;
+    } else if (name_ == "nv_gpu_power_usage") {
+      metrics_->gpu_power_usage_per_gpu[gpu_uuid] = sample;
+    } else if (name_ == "nv_gpu_memory_used_bytes") {
+      metrics_->gpu_memory_used_bytes_per_gpu[gpu_uuid] =
+          static_cast<uint64_t>(sample);
+    } else {
+      metrics_->gpu_memory_total_bytes_per_gpu[gpu_uuid] =
+          static_cast<uint64_t>(sample);
+    }
+    return;
+  }
+
+  const std::string key(begin, labels_end);
+  if (IsCounter(*family, suffix)) {
+    metrics_->counters[key] = sample;
+  } else {
+    metrics_->gauges[key] = sample;
+  }
+}
+
+bool
+PrometheusParser::IsCounter(
+    const std::string& family, const char* suffix) const
+{
+  const auto type = family_types_.find(family);
+  if (type == family_types_.end()) {
+    return false;
+  }
+  if (type->second == COUNTER) {
+    return true;
+  }
+  // The buckets, sums and counts of histograms and summaries accumulate
+  return ((type->second == HISTOGRAM) || (type->second == SUMMARY)) &&
+         (*suffix != '\0');
+}
+
+}}  // namespace triton::perfanalyzer
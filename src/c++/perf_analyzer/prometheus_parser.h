@@ -0,0 +1,76 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "metrics.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Parses the Prometheus text exposition format as it arrives, keeping only
+/// the samples of the collected metric families. Lines are parsed as soon as
+/// they are complete, so a scrape is read in a single pass and never held in
+/// full. The GPU families of Metrics are always collected.
+class PrometheusParser {
+ public:
+  /// \param families The names of the other metric families to collect.
+  explicit PrometheusParser(const std::vector<std::string>& families);
+
+  /// Starts parsing a new scrape.
+  /// \param metrics Returns the collected samples.
+  void Start(Metrics* metrics);
+
+  /// Parses the next chunk of the scrape.
+  void Feed(const char* data, size_t size);
+
+  /// Parses what remains of the scrape.
+  void Finish();
+
+ private:
+  enum FamilyType { UNTYPED, COUNTER, GAUGE, HISTOGRAM, SUMMARY };
+
+  void ParseLine(const char* begin, const char* end);
+  void ParseType(const char* begin, const char* end);
+  void ParseSample(const char* begin, const char* end);
+
+  /// \return Whether the samples of 'family' with the name suffix 'suffix'
+  /// are counters.
+  bool IsCounter(const std::string& family, const char* suffix) const;
+
+  std::set<std::string> families_;
+  std::map<std::string, FamilyType> family_types_;
+  Metrics* metrics_{nullptr};
+  std::string partial_line_;
+  std::string name_;
+  std::string family_;
+};
+
+}}  // namespace triton::perfanalyzer
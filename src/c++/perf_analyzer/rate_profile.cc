@@ -0,0 +1,129 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "rate_profile.h"
+
+#include <cmath>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::chrono::nanoseconds
+MillisToNanos(double ms)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double, std::milli>(ms));
+}
+
+}  // namespace
+
+OnOffRateProfile::OnOffRateProfile(double on_ms, double off_ms)
+    : on_(MillisToNanos(on_ms)), cycle_(MillisToNanos(on_ms + off_ms)),
+      on_rate_((on_ms + off_ms) / on_ms)
+{
+}
+
+double
+OnOffRateProfile::RelativeRateAt(std::chrono::nanoseconds t)
+{
+  return (t % cycle_) < on_ ? on_rate_ : 0.0;
+}
+
+MarkovModulatedRateProfile::MarkovModulatedRateProfile(
+    double burst_factor, double low_ms, double high_ms, uint32_t seed)
+    : low_dwell_ms_(1.0 / low_ms), high_dwell_ms_(1.0 / high_ms), rng_(seed)
+{
+  // Normalize so that the long run average of the relative rate is 1
+  low_rate_ = (low_ms + high_ms) / (low_ms + burst_factor * high_ms);
+  high_rate_ = burst_factor * low_rate_;
+  next_switch_ = MillisToNanos(low_dwell_ms_(rng_));
+}
+
+double
+MarkovModulatedRateProfile::RelativeRateAt(std::chrono::nanoseconds t)
+{
+  while (t >= next_switch_) {
+    high_ = !high_;
+    next_switch_ += MillisToNanos(
+        high_ ? high_dwell_ms_(rng_) : low_dwell_ms_(rng_));
+  }
+  return high_ ? high_rate_ : low_rate_;
+}
+
+DiurnalRateProfile::DiurnalRateProfile(double period_s, double amplitude)
+    : period_s_(period_s), amplitude_(amplitude)
+{
+}
+
+double
+DiurnalRateProfile::RelativeRateAt(std::chrono::nanoseconds t)
+{
+  const double seconds = std::chrono::duration<double>(t).count();
+  return 1.0 + amplitude_ * std::sin(2.0 * M_PI * seconds / period_s_);
+}
+
+std::shared_ptr<RateProfile>
+MakeRateProfile(Distribution distribution, const RateProfileSettings& settings)
+{
+  switch (distribution) {
+    case Distribution::BURSTY:
+      return std::make_shared<OnOffRateProfile>(
+          settings.burst_on_ms, settings.burst_off_ms);
+    case Distribution::MMPP:
+      return std::make_shared<MarkovModulatedRateProfile>(
+          settings.mmpp_burst_factor, settings.mmpp_low_ms,
+          settings.mmpp_high_ms);
+    case Distribution::DIURNAL:
+      return std::make_shared<DiurnalRateProfile>(
+          settings.diurnal_period_s, settings.diurnal_amplitude);
+    default:
+      return nullptr;
+  }
+}
+
+std::function<std::chrono::nanoseconds(std::mt19937&)>
+ModulatedPoissonDistribution(
+    std::shared_ptr<RateProfile> profile, const double request_rate)
+{
+  const double max_relative_rate = profile->MaxRelativeRate();
+  std::exponential_distribution<> candidate_gap(
+      request_rate * max_relative_rate);
+  std::uniform_real_distribution<> acceptance(0.0, max_relative_rate);
+  std::chrono::nanoseconds now(0);
+
+  return [profile, candidate_gap, acceptance,
+          now](std::mt19937& gen) mutable {
+    const std::chrono::nanoseconds start = now;
+    do {
+      now += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(candidate_gap(gen)));
+    } while (acceptance(gen) >= profile->RelativeRateAt(now));
+    return now - start;
+  };
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,133 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Parameters of the time-varying request distributions. Every profile
+/// averages to the target request rate over time.
+struct RateProfileSettings {
+  // BURSTY: requests only arrive during the first burst_on_ms of every
+  // burst_on_ms + burst_off_ms cycle
+  double burst_on_ms{100};
+  double burst_off_ms{900};
+  // MMPP: the rate switches between a low and a high state, the high rate
+  // being mmpp_burst_factor times the low one. The time spent in each state
+  // is exponentially distributed with the given mean.
+  double mmpp_burst_factor{10};
+  double mmpp_low_ms{900};
+  double mmpp_high_ms{100};
+  // DIURNAL: the rate follows a sine wave with the given period whose
+  // amplitude is a fraction of the target rate
+  double diurnal_period_s{60};
+  double diurnal_amplitude{0.5};
+};
+
+/// Describes how the request rate varies over time, relative to its mean.
+///
+class RateProfile {
+ public:
+  virtual ~RateProfile() = default;
+
+  /// \param t The time since the start of the schedule. Must not decrease
+  /// from one call to the next.
+  /// \return The rate at time t divided by the mean rate.
+  virtual double RelativeRateAt(std::chrono::nanoseconds t) = 0;
+
+  /// \return An upper bound of RelativeRateAt().
+  virtual double MaxRelativeRate() const = 0;
+};
+
+/// Rate that is only non-zero during the on period of a fixed cycle.
+///
+class OnOffRateProfile : public RateProfile {
+ public:
+  OnOffRateProfile(double on_ms, double off_ms);
+  double RelativeRateAt(std::chrono::nanoseconds t) override;
+  double MaxRelativeRate() const override { return on_rate_; }
+
+ private:
+  std::chrono::nanoseconds on_;
+  std::chrono::nanoseconds cycle_;
+  double on_rate_;
+};
+
+/// Rate modulated by a two-state Markov chain (Markov-modulated Poisson
+/// process).
+///
+/// The state path only depends on the seed, so schedules that are given
+/// profiles with the same seed burst at the same time.
+///
+class MarkovModulatedRateProfile : public RateProfile {
+ public:
+  MarkovModulatedRateProfile(
+      double burst_factor, double low_ms, double high_ms, uint32_t seed = 0);
+  double RelativeRateAt(std::chrono::nanoseconds t) override;
+  double MaxRelativeRate() const override { return high_rate_; }
+
+ private:
+  std::exponential_distribution<double> low_dwell_ms_;
+  std::exponential_distribution<double> high_dwell_ms_;
+  std::mt19937 rng_;
+  double low_rate_;
+  double high_rate_;
+  bool high_{false};
+  std::chrono::nanoseconds next_switch_;
+};
+
+/// Rate that follows a sine wave around the mean.
+///
+class DiurnalRateProfile : public RateProfile {
+ public:
+  DiurnalRateProfile(double period_s, double amplitude);
+  double RelativeRateAt(std::chrono::nanoseconds t) override;
+  double MaxRelativeRate() const override { return 1.0 + amplitude_; }
+
+ private:
+  double period_s_;
+  double amplitude_;
+};
+
+/// \return The profile of the given time-varying distribution, or nullptr if
+/// the distribution has a constant rate.
+std::shared_ptr<RateProfile> MakeRateProfile(
+    Distribution distribution, const RateProfileSettings& settings);
+
+/// Returns a generator of the gaps between successive requests of a
+/// non-homogeneous Poisson process whose rate is request_rate times the
+/// relative rate of the profile. Arrivals are drawn by thinning a Poisson
+/// process at the maximum rate of the profile.
+std::function<std::chrono::nanoseconds(std::mt19937&)>
+ModulatedPoissonDistribution(
+    std::shared_ptr<RateProfile> profile, const double request_rate);
+
+}}  // namespace triton::perfanalyzer
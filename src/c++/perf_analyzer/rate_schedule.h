@@ -27,8 +27,13 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <random>
 #include <vector>
+#include "request_trace.h"
+#include "schedule_plugin.h"
+#include "schedule_recorder.h"
 
 namespace triton { namespace perfanalyzer {
 
@@ -38,27 +43,87 @@ using NanoIntervals = std::vector<std::chrono::nanoseconds>;
 /// loop through the provided intervals, and then every time it loops back to
 /// the start add an additional amount equal to the duration
 ///
+/// Alternatively, if a distribution is set, the schedule is generated on
+/// demand by drawing the gap to each timestamp from the distribution with
+/// the schedule's own rng, and the intervals are not used. If a trace is set
+/// instead, the timestamps and the input data stream of each request are
+/// read from it. If replay is set instead, the schedule loops through the
+/// recorded requests in it, which also tell how to send each request. If a
+/// plugin schedule is set instead, the timestamps and the input data stream
+/// of each request come from the plugin.
+///
 struct RateSchedule {
   NanoIntervals intervals;
   std::chrono::nanoseconds duration;
 
+  std::function<std::chrono::nanoseconds(std::mt19937&)> distribution;
+  std::mt19937 rng;
+
+  std::shared_ptr<RequestTrace::Cursor> trace;
+
+  std::vector<ScheduleRecord> replay;
+
+  std::shared_ptr<SchedulePlugin::Schedule> plugin;
+
   /// Returns the next timestamp in the schedule
   ///
   std::chrono::nanoseconds Next()
   {
+    if (distribution) {
+      generated_ += distribution(rng);
+      return generated_;
+    }
+    if (plugin) {
+      PA_ScheduleRequest request = plugin->Next();
+      data_stream_id_ = request.data_stream_id;
+      return std::chrono::nanoseconds(request.timestamp_ns);
+    }
+    if (trace) {
+      RequestTraceRecord record = trace->Next();
+      data_stream_id_ = record.data_stream_id_;
+      return record.timestamp_;
+    }
+    if (!replay.empty()) {
+      replayed_ = replay[index_];
+      replayed_.timestamp_ += duration * rounds_;
+      data_stream_id_ = replayed_.data_stream_id_;
+      Advance(replay.size());
+      return replayed_.timestamp_;
+    }
+
     auto next = intervals[index_] + duration * rounds_;
+    Advance(intervals.size());
+    return next;
+  }
+
+  /// Returns the input data stream to use for the timestamp last returned by
+  /// Next()
+  ///
+  uint64_t DataStreamId() const { return data_stream_id_; }
 
+  /// Returns the recorded request for the timestamp last returned by Next(),
+  /// or null if the schedule is not replayed
+  ///
+  const ScheduleRecord* Replayed() const
+  {
+    return replay.empty() ? nullptr : &replayed_;
+  }
+
+ private:
+  void Advance(size_t size)
+  {
     index_++;
-    if (index_ >= intervals.size()) {
+    if (index_ >= size) {
       rounds_++;
       index_ = 0;
     }
-    return next;
   }
 
- private:
   size_t rounds_ = 0;
   size_t index_ = 0;
+  std::chrono::nanoseconds generated_{0};
+  uint64_t data_stream_id_ = 0;
+  ScheduleRecord replayed_;
 };
 
 using RateSchedulePtr_t = std::shared_ptr<RateSchedule>;
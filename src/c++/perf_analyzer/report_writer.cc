@@ -69,6 +69,24 @@ ReportWriter::GenerateReport()
 {
   if (!filename_.empty()) {
     std::ofstream ofs(filename_, std::ofstream::out);
+    const bool include_stage_times = std::any_of(
+        summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+          return status.client_stats.stage_times.request_count != 0;
+        });
+    const bool include_corrected_latencies = std::any_of(
+        summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+          return status.client_stats.corrected_latency_histogram
+                     .TotalCount() != 0;
+        });
+    // Only when several batch sizes were swept, keep out for backwards
+    // compatibility otherwise
+    const bool include_batch_size = std::any_of(
+        summary_.begin(), summary_.end(), [this](const pa::PerfStatus& status) {
+          return status.batch_size != summary_[0].batch_size;
+        });
+    if (include_batch_size) {
+      ofs << "Batch Size,";
+    }
     if (target_concurrency_) {
       ofs << "Concurrency,";
     } else {
@@ -91,6 +109,21 @@ ReportWriter::GenerateReport()
          summary_[0].client_stats.percentile_latency_ns) {
       ofs << ",p" << percentile.first << " latency";
     }
+    if (parser_->IsDecoupled()) {
+      ofs << ",Avg First Response Latency,Avg Inter-Response Latency,"
+          << "Responses/Request";
+    }
+    if (include_stage_times) {
+      ofs << ",Client Data Prep,Client Send Call,Client Callback,"
+          << "Client Validation";
+    }
+    if (include_corrected_latencies) {
+      for (const auto& percentile :
+           summary_[0].client_stats.percentile_latency_ns) {
+        ofs << ",p" << percentile.first << " corrected latency";
+      }
+      ofs << ",Avg corrected latency";
+    }
     if (verbose_csv_) {
       ofs << ",";
       if (percentile_ == -1) {
@@ -98,23 +131,41 @@ ReportWriter::GenerateReport()
       }
       ofs << "request/response,";
       ofs << "response wait,";
+      ofs << "serialize,send queue,deserialize,";
+      ofs << "Request MB/s,Response MB/s,Request Compression Ratio,"
+          << "Response Compression Ratio,";
+      ofs << "Client CPU User,Client CPU System,Client RSS,"
+          << "Client Voluntary Context Switches,"
+          << "Client Involuntary Context Switches,Client Thread CPU,"
+          << "Client Max Thread CPU,";
       if (should_output_metrics_) {
         ofs << "Avg GPU Utilization,";
         ofs << "Avg GPU Power Usage,";
         ofs << "Max GPU Memory Usage,";
-        ofs << "Total GPU Memory";
+        ofs << "Total GPU Memory,";
+        ofs << "Throughput per Watt,";
+        ofs << "Avg GPU Utilization at p99 Latency,";
+        ofs << "Min GPU Memory Headroom,";
+        ofs << "GPU Memory Usage Trend";
       }
     }
     ofs << std::endl;
 
-    // Sort summary results in order of increasing infer/sec.
+    // Sort summary results in order of increasing infer/sec, within each
+    // batch size.
     std::sort(
         summary_.begin(), summary_.end(),
         [](const pa::PerfStatus& a, const pa::PerfStatus& b) -> bool {
+          if (a.batch_size != b.batch_size) {
+            return a.batch_size < b.batch_size;
+          }
           return a.client_stats.infer_per_sec < b.client_stats.infer_per_sec;
         });
 
     for (pa::PerfStatus& status : summary_) {
+      if (include_batch_size) {
+        ofs << status.batch_size << ",";
+      }
       if (target_concurrency_) {
         ofs << status.concurrency << ",";
       } else {
@@ -201,6 +252,30 @@ ReportWriter::GenerateReport()
       for (const auto& percentile : status.client_stats.percentile_latency_ns) {
         ofs << "," << (percentile.second / 1000);
       }
+      if (parser_->IsDecoupled()) {
+        ofs << "," << (status.client_stats.avg_first_response_latency_ns / 1000)
+            << "," << (status.client_stats.avg_response_gap_ns / 1000) << ","
+            << (status.client_stats.request_count == 0
+                    ? 0.0
+                    : static_cast<double>(status.client_stats.response_count) /
+                          status.client_stats.request_count);
+      }
+      if (include_stage_times) {
+        const ClientStageTimes& stage_times = status.client_stats.stage_times;
+        ofs << "," << (stage_times.AvgNs(CLIENT_STAGE_DATA_PREP) / 1000) << ","
+            << (stage_times.AvgNs(CLIENT_STAGE_SEND) / 1000) << ","
+            << (stage_times.AvgNs(CLIENT_STAGE_CALLBACK) / 1000) << ","
+            << (stage_times.AvgNs(CLIENT_STAGE_VALIDATION) / 1000);
+      }
+      if (include_corrected_latencies) {
+        const LatencyHistogram& corrected =
+            status.client_stats.corrected_latency_histogram;
+        for (const auto& percentile :
+             status.client_stats.percentile_latency_ns) {
+          ofs << "," << (corrected.ValueAtPercentile(percentile.first) / 1000);
+        }
+        ofs << "," << (corrected.Mean() / 1000);
+      }
       if (verbose_csv_) {
         const uint64_t avg_latency_us =
             status.client_stats.avg_latency_ns / 1000;
@@ -218,9 +293,27 @@ ReportWriter::GenerateReport()
         }
         ofs << std::to_string(avg_send_time_us + avg_receive_time_us) << ",";
         ofs << std::to_string(avg_response_wait_time_us) << ",";
+        ofs << (status.client_stats.avg_serialize_time_ns / 1000) << ","
+            << (status.client_stats.avg_send_queue_time_ns / 1000) << ","
+            << (status.client_stats.avg_deserialize_time_ns / 1000) << ",";
+        const ClientSideStats& stats = status.client_stats;
+        ofs << BandwidthMBPerSec(stats.request_byte_size, stats.duration_ns)
+            << ","
+            << BandwidthMBPerSec(stats.response_byte_size, stats.duration_ns)
+            << ","
+            << CompressionRatio(
+                   stats.uncompressed_request_byte_size,
+                   stats.request_byte_size)
+            << ","
+            << CompressionRatio(
+                   stats.uncompressed_response_byte_size,
+                   stats.response_byte_size)
+            << ",";
+        WriteClientResources(ofs, status.client_resources);
         if (should_output_metrics_) {
           if (status.metrics.size() == 1) {
             WriteGpuMetrics(ofs, status.metrics[0]);
+            WriteMetricsCorrelation(ofs, status.metrics_correlation);
           } else {
             throw PerfAnalyzerException(
                 "There should only be one entry in the metrics vector.",
@@ -232,6 +325,11 @@ ReportWriter::GenerateReport()
     }
     ofs.close();
 
+    WriteBucketLatencies();
+    WriteRequestClasses();
+    WriteEndpoints();
+    WriteSlowRequests();
+
     if (include_server_stats_) {
       // Record composing model stat in a separate file.
       if (!summary_.front().server_stats.composing_models_stat.empty()) {
@@ -355,6 +453,241 @@ ReportWriter::GenerateReport()
   }
 }
 
+void
+ReportWriter::WriteBucketLatencies()
+{
+  const bool has_buckets = std::any_of(
+      summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+        return !status.client_stats.bucket_latency_histograms.empty();
+      });
+  if (!has_buckets) {
+    return;
+  }
+
+  std::ofstream ofs(PrefixedFilename("latency_buckets."), std::ofstream::out);
+  if (target_concurrency_) {
+    ofs << "Concurrency,";
+  } else {
+    ofs << "Request Rate,";
+  }
+  ofs << "Bucket,Request Count,Inferences/Second,Avg latency";
+  for (const auto& percentile :
+       summary_[0].client_stats.percentile_latency_ns) {
+    ofs << ",p" << percentile.first << " latency";
+  }
+  ofs << std::endl;
+
+  for (const pa::PerfStatus& status : summary_) {
+    const auto& buckets = status.client_stats.bucket_latency_histograms;
+    uint64_t bucketed_count = 0;
+    for (const auto& bucket : buckets) {
+      bucketed_count += bucket.second.TotalCount();
+    }
+    for (const auto& bucket : buckets) {
+      const LatencyHistogram& latencies = bucket.second;
+      if (target_concurrency_) {
+        ofs << status.concurrency << ",";
+      } else {
+        ofs << status.request_rate << ",";
+      }
+      // The buckets share the throughput in proportion to their requests
+      ofs << bucket.first << "," << latencies.TotalCount() << ","
+          << (status.client_stats.infer_per_sec * latencies.TotalCount() /
+              bucketed_count)
+          << "," << (latencies.Mean() / 1000);
+      for (const auto& percentile : status.client_stats.percentile_latency_ns) {
+        ofs << "," << (latencies.ValueAtPercentile(percentile.first) / 1000);
+      }
+      ofs << std::endl;
+    }
+  }
+  ofs.close();
+}
+
+void
+ReportWriter::WriteRequestClasses()
+{
+  const bool has_classes = std::any_of(
+      summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+        return !status.client_stats.request_class_stats.empty();
+      });
+  if (!has_classes) {
+    return;
+  }
+
+  std::ofstream ofs(PrefixedFilename("request_classes."), std::ofstream::out);
+  if (target_concurrency_) {
+    ofs << "Concurrency,";
+  } else {
+    ofs << "Request Rate,";
+  }
+  ofs << "Request Class,Request Count,Rejected Count,Inferences/Second,"
+      << "Avg latency";
+  for (const auto& percentile :
+       summary_[0].client_stats.percentile_latency_ns) {
+    ofs << ",p" << percentile.first << " latency";
+  }
+  ofs << std::endl;
+
+  for (const pa::PerfStatus& status : summary_) {
+    const auto& request_classes = status.client_stats.request_class_stats;
+    uint64_t class_count = 0;
+    for (const auto& request_class : request_classes) {
+      class_count += request_class.second.latencies.TotalCount();
+    }
+    for (const auto& request_class : request_classes) {
+      const LatencyHistogram& latencies = request_class.second.latencies;
+      if (target_concurrency_) {
+        ofs << status.concurrency << ",";
+      } else {
+        ofs << status.request_rate << ",";
+      }
+      // The classes share the throughput in proportion to their requests
+      ofs << request_class.first << "," << latencies.TotalCount() << ","
+          << request_class.second.rejected_count << ","
+          << ((class_count == 0) ? 0
+                                 : (status.client_stats.infer_per_sec *
+                                    latencies.TotalCount() / class_count))
+          << "," << (latencies.Mean() / 1000);
+      for (const auto& percentile : status.client_stats.percentile_latency_ns) {
+        ofs << "," << (latencies.ValueAtPercentile(percentile.first) / 1000);
+      }
+      ofs << std::endl;
+    }
+  }
+  ofs.close();
+}
+
+void
+ReportWriter::WriteEndpoints()
+{
+  const bool has_endpoints = std::any_of(
+      summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+        return !status.client_stats.endpoint_latency_histograms.empty();
+      });
+  if (!has_endpoints) {
+    return;
+  }
+
+  std::ofstream ofs(PrefixedFilename("endpoints."), std::ofstream::out);
+  if (target_concurrency_) {
+    ofs << "Concurrency,";
+  } else {
+    ofs << "Request Rate,";
+  }
+  ofs << "Endpoint,Request Count,Inferences/Second,Avg latency";
+  for (const auto& percentile :
+       summary_[0].client_stats.percentile_latency_ns) {
+    ofs << ",p" << percentile.first << " latency";
+  }
+  if (include_server_stats_) {
+    ofs << ",Server Inference Count,Server Queue,Server Compute";
+  }
+  ofs << std::endl;
+
+  for (const pa::PerfStatus& status : summary_) {
+    const auto& endpoints = status.client_stats.endpoint_latency_histograms;
+    uint64_t endpoint_count = 0;
+    for (const auto& endpoint : endpoints) {
+      endpoint_count += endpoint.second.TotalCount();
+    }
+    for (const auto& endpoint : endpoints) {
+      const LatencyHistogram& latencies = endpoint.second;
+      if (target_concurrency_) {
+        ofs << status.concurrency << ",";
+      } else {
+        ofs << status.request_rate << ",";
+      }
+      // The endpoints share the throughput in proportion to their requests
+      ofs << endpoint.first << "," << latencies.TotalCount() << ","
+          << ((endpoint_count == 0) ? 0
+                                    : (status.client_stats.infer_per_sec *
+                                       latencies.TotalCount() / endpoint_count))
+          << "," << (latencies.Mean() / 1000);
+      for (const auto& percentile : status.client_stats.percentile_latency_ns) {
+        ofs << "," << (latencies.ValueAtPercentile(percentile.first) / 1000);
+      }
+      if (include_server_stats_) {
+        const auto it = status.endpoint_server_stats.find(endpoint.first);
+        pa::ServerSideStats server_stats{};
+        if (it != status.endpoint_server_stats.end()) {
+          server_stats = it->second;
+        }
+        const uint64_t compute_ns = server_stats.compute_input_time_ns +
+                                    server_stats.compute_infer_time_ns +
+                                    server_stats.compute_output_time_ns;
+        ofs << "," << server_stats.inference_count << ","
+            << ((server_stats.queue_count == 0)
+                    ? 0
+                    : (server_stats.queue_time_ns / 1000 /
+                       server_stats.queue_count))
+            << ","
+            << ((server_stats.compute_input_count == 0)
+                    ? 0
+                    : (compute_ns / 1000 / server_stats.compute_input_count));
+      }
+      ofs << std::endl;
+    }
+  }
+  ofs.close();
+}
+
+void
+ReportWriter::WriteSlowRequests()
+{
+  const bool has_slow_requests = std::any_of(
+      summary_.begin(), summary_.end(), [](const pa::PerfStatus& status) {
+        return !status.client_stats.slow_requests.Empty();
+      });
+  if (!has_slow_requests) {
+    return;
+  }
+
+  std::ofstream ofs(PrefixedFilename("slow_requests."), std::ofstream::out);
+  if (target_concurrency_) {
+    ofs << "Concurrency,";
+  } else {
+    ofs << "Request Rate,";
+  }
+  ofs << "Rank,Latency,First Response Latency,Response Count,Schedule Lag,"
+      << "Worker,Context,Data Stream,Data Step,Sequence ID,Endpoint,"
+      << "Send Time (ns),First Response Time (ns),End Time (ns)" << std::endl;
+
+  for (const pa::PerfStatus& status : summary_) {
+    size_t rank = 0;
+    for (const auto& request : status.client_stats.slow_requests.Slowest()) {
+      if (target_concurrency_) {
+        ofs << status.concurrency << ",";
+      } else {
+        ofs << status.request_rate << ",";
+      }
+      // The schedule lag is left empty for the requests without a schedule
+      ofs << ++rank << "," << (request.latency_ns / 1000) << ","
+          << ((request.first_response_time_ns - request.send_time_ns) / 1000)
+          << "," << request.response_count << ",";
+      if (request.schedule_lag_ns >= 0) {
+        ofs << (request.schedule_lag_ns / 1000);
+      }
+      ofs << "," << request.worker << "," << request.context << ","
+          << request.data_stream_id << "," << request.data_step_id << ","
+          << request.sequence_id << "," << request.endpoint << ","
+          << request.send_time_ns << "," << request.first_response_time_ns
+          << "," << request.end_time_ns << std::endl;
+    }
+  }
+  ofs.close();
+}
+
+std::string
+ReportWriter::PrefixedFilename(const std::string& prefix) const
+{
+  const size_t base = filename_.find_last_of('/');
+  return (base == std::string::npos)
+             ? prefix + filename_
+             : filename_.substr(0, base + 1) + prefix +
+                   filename_.substr(base + 1);
+}
+
 void
 ReportWriter::WriteGpuMetrics(std::ostream& ofs, const Metrics& metric)
 {
@@ -380,4 +713,29 @@ ReportWriter::WriteGpuMetrics(std::ostream& ofs, const Metrics& metric)
   ofs << ",";
 }
 
+void
+ReportWriter::WriteMetricsCorrelation(
+    std::ostream& ofs, const MetricsCorrelation& correlation)
+{
+  ofs << correlation.infer_per_sec_per_watt << ",";
+  if (correlation.tail_request_count > 0) {
+    ofs << correlation.tail_gpu_utilization;
+  }
+  ofs << "," << correlation.min_gpu_memory_headroom_bytes << ","
+      << correlation.gpu_memory_trend_bytes_per_sec << ",";
+}
+
+void
+ReportWriter::WriteClientResources(
+    std::ostream& ofs, const ClientResourceStats& resources)
+{
+  ofs << resources.cpu_user_pct << "," << resources.cpu_sys_pct << ","
+      << resources.rss_bytes << "," << resources.voluntary_context_switches
+      << "," << resources.involuntary_context_switches << ",";
+  for (const auto& thread : resources.thread_cpu_pct) {
+    ofs << thread.first << ":" << thread.second << ";";
+  }
+  ofs << "," << resources.max_thread_cpu_pct << ",";
+}
+
 }}  // namespace triton::perfanalyzer
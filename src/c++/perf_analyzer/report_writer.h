@@ -78,6 +78,20 @@ class ReportWriter {
   /// rate
   void WriteGpuMetrics(std::ostream& ofs, const Metrics& metric);
 
+  /// Output how the metrics relate to the load
+  /// \param ofs A stream to output the csv data
+  /// \param correlation The correlation for a particular concurrency or
+  /// request rate
+  void WriteMetricsCorrelation(
+      std::ostream& ofs, const MetricsCorrelation& correlation);
+
+  /// Output the resources used by the client
+  /// \param ofs A stream to output the csv data
+  /// \param resources The resources used for a particular concurrency or
+  /// request rate
+  void WriteClientResources(
+      std::ostream& ofs, const ClientResourceStats& resources);
+
  private:
   ReportWriter(
       const std::string& filename, const bool target_concurrency,
@@ -86,6 +100,27 @@ class ReportWriter {
       const std::shared_ptr<ModelParser>& parser,
       const bool should_output_metrics);
 
+  /// Write the per bucket latencies, if any, to a 'latency_buckets.'
+  /// prefixed copy of the report file.
+  void WriteBucketLatencies();
+
+  /// Write the latencies and timeout rejections of each request class, if
+  /// any, to a 'request_classes.' prefixed copy of the report file.
+  void WriteRequestClasses();
+
+  /// Write the latencies and the server side statistics of each endpoint, if
+  /// the requests are spread over endpoints, to an 'endpoints.' prefixed copy
+  /// of the report file.
+  void WriteEndpoints();
+
+  /// Write the slowest requests of each load level, if any were kept, to a
+  /// 'slow_requests.' prefixed copy of the report file.
+  void WriteSlowRequests();
+
+  /// \param prefix The prefix of the file.
+  /// \return The name of a copy of the report file with the prefix, which
+  /// is kept next to the report by prefixing its base name only.
+  std::string PrefixedFilename(const std::string& prefix) const;
 
   const std::string& filename_{""};
   const bool target_concurrency_{true};
@@ -0,0 +1,168 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "request_class.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Parses the whole of 'text' as a non-negative integer
+bool
+ParseUnsigned(const std::string& text, uint64_t* value)
+{
+  if (text.empty() || !std::all_of(text.begin(), text.end(), ::isdigit)) {
+    return false;
+  }
+  try {
+    *value = std::stoull(text);
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+cb::Error
+ParseRequestClasses(
+    const std::string& spec, std::vector<RequestClassEntry>* entries)
+{
+  std::vector<RequestClassEntry> parsed;
+  std::stringstream spec_stream(spec);
+  std::string item;
+  while (std::getline(spec_stream, item, ',')) {
+    RequestClassEntry entry;
+    const size_t weight_start = item.find('=');
+    if (weight_start != std::string::npos) {
+      const std::string weight = item.substr(weight_start + 1);
+      size_t parsed_chars = 0;
+      try {
+        entry.weight = std::stod(weight, &parsed_chars);
+      }
+      catch (const std::exception&) {
+        parsed_chars = 0;
+      }
+      if ((parsed_chars == 0) || (parsed_chars != weight.size()) ||
+          !(entry.weight > 0)) {
+        return cb::Error(
+            "invalid weight in request classes: '" + item +
+                "', weights must be positive numbers",
+            pa::GENERIC_ERROR);
+      }
+    }
+    const std::string request_class = item.substr(0, weight_start);
+    const size_t priority_start = request_class.find(':');
+    entry.name = request_class.substr(0, priority_start);
+    if (entry.name.empty()) {
+      return cb::Error(
+          "missing name in request classes: '" + item + "'",
+          pa::GENERIC_ERROR);
+    }
+    if (priority_start != std::string::npos) {
+      const std::string options = request_class.substr(priority_start + 1);
+      const size_t timeout_start = options.find(':');
+      if (!ParseUnsigned(
+              options.substr(0, timeout_start), &entry.priority)) {
+        return cb::Error(
+            "invalid priority in request classes: '" + item +
+                "', priorities must be non-negative integers",
+            pa::GENERIC_ERROR);
+      }
+      if ((timeout_start != std::string::npos) &&
+          !ParseUnsigned(
+              options.substr(timeout_start + 1), &entry.server_timeout_us)) {
+        return cb::Error(
+            "invalid timeout in request classes: '" + item +
+                "', timeouts must be non-negative integers",
+            pa::GENERIC_ERROR);
+      }
+    }
+    for (const auto& other : parsed) {
+      if (other.name == entry.name) {
+        return cb::Error(
+            "duplicate name in request classes: '" + entry.name + "'",
+            pa::GENERIC_ERROR);
+      }
+    }
+    parsed.push_back(entry);
+  }
+
+  if (parsed.empty()) {
+    return cb::Error("request classes are empty", pa::GENERIC_ERROR);
+  }
+  *entries = std::move(parsed);
+  return cb::Error::Success;
+}
+
+bool
+IsTimeoutRejection(const cb::Error& err)
+{
+  if (err.IsOk()) {
+    return false;
+  }
+  // The server only tells the rejection apart by its message, such as
+  // "Request timeout expired"
+  std::string message = err.Message();
+  std::transform(message.begin(), message.end(), message.begin(), ::tolower);
+  return message.find("timeout") != std::string::npos;
+}
+
+RequestClassMix::RequestClassMix(const std::vector<RequestClassEntry>& entries)
+    : entries_(entries)
+{
+  double total_weight = 0;
+  for (const auto& entry : entries_) {
+    total_weight += entry.weight;
+  }
+  double cumulative_weight = 0;
+  for (const auto& entry : entries_) {
+    cumulative_weight += entry.weight;
+    cumulative_shares_.push_back(cumulative_weight / total_weight);
+  }
+  // Rounding must not leave draws close to 1 without a class
+  if (!cumulative_shares_.empty()) {
+    cumulative_shares_.back() = 1.0;
+  }
+}
+
+size_t
+RequestClassMix::Pick(const double draw) const
+{
+  auto it = std::upper_bound(
+      cumulative_shares_.begin(), cumulative_shares_.end(), draw);
+  if (it == cumulative_shares_.end()) {
+    return entries_.size() - 1;
+  }
+  return it - cumulative_shares_.begin();
+}
+
+}}  // namespace triton::perfanalyzer
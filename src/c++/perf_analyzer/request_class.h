@@ -0,0 +1,102 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A class of requests that share a priority and a server timeout
+struct RequestClassEntry {
+  std::string name;
+  double weight{1.0};
+  // 0 for the default priority of the model
+  uint64_t priority{0};
+  // How long the server may queue the requests before rejecting them, in
+  // microseconds. 0 for the default timeout of the model.
+  uint64_t server_timeout_us{0};
+};
+
+/// What the requests of a request class came to in a measurement
+struct RequestClassStats {
+  // The latencies of the completed requests, in nanoseconds
+  LatencyHistogram latencies;
+  // The number of requests that the server rejected for timing out
+  uint64_t rejected_count{0};
+
+  cb::Error Merge(const RequestClassStats& other)
+  {
+    rejected_count += other.rejected_count;
+    return latencies.Merge(other.latencies);
+  }
+};
+
+/// Parses request classes in the format
+/// "name[:priority[:timeout_us]][=weight],...", such as
+/// "premium:1=1,bulk:2:50000=4". The priority and the timeout default to 0,
+/// which leaves them to the model, and the weight defaults to 1.
+/// \param spec The request classes to parse.
+/// \param entries Returns the request classes, in the order given. Left
+/// unchanged if the classes are invalid.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseRequestClasses(
+    const std::string& spec, std::vector<RequestClassEntry>* entries);
+
+/// \param err The error a request failed with.
+/// \return Whether the server rejected the request for waiting longer than
+/// its timeout.
+bool IsTimeoutRejection(const cb::Error& err);
+
+/// Spreads the requests over several request classes, each getting a share
+/// of the requests proportional to its weight.
+class RequestClassMix {
+ public:
+  /// \param entries The request classes, with positive weights.
+  explicit RequestClassMix(const std::vector<RequestClassEntry>& entries);
+
+  /// \param draw A number drawn uniformly from [0, 1).
+  /// \return The index of the request class that the draw falls on.
+  size_t Pick(const double draw) const;
+
+  const RequestClassEntry& Entry(const size_t index) const
+  {
+    return entries_[index];
+  }
+
+  size_t Size() const { return entries_.size(); }
+
+ private:
+  std::vector<RequestClassEntry> entries_;
+  // The end of the share of each class, the last one is 1
+  std::vector<double> cumulative_shares_;
+};
+
+}}  // namespace triton::perfanalyzer
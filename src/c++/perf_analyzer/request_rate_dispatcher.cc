@@ -0,0 +1,104 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "request_rate_dispatcher.h"
+
+#include <thread>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+void
+RequestRateDispatcher::Dispatch()
+{
+  while (!early_exit) {
+    HandleExecuteOff();
+    if (early_exit) {
+      break;
+    }
+
+    SendEvent event;
+    event.scheduled_time_ = start_time_ + schedule_->Next();
+    event.data_stream_id_ = schedule_->DataStreamId();
+    const ScheduleRecord* replayed = schedule_->Replayed();
+    if (replayed != nullptr) {
+      event.replayed_ = true;
+      event.record_ = *replayed;
+    }
+    event.delayed_ = WaitUntil(event.scheduled_time_);
+    PushEvent(event);
+  }
+}
+
+void
+RequestRateDispatcher::SetSchedule(RateSchedulePtr_t schedule)
+{
+  schedule_ = schedule;
+}
+
+void
+RequestRateDispatcher::HandleExecuteOff()
+{
+  if (!execute_) {
+    is_paused_ = true;
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_signal_.wait(lock, [this]() { return early_exit || execute_; });
+  }
+  is_paused_ = false;
+}
+
+bool
+RequestRateDispatcher::WaitUntil(
+    std::chrono::steady_clock::time_point scheduled_time)
+{
+  std::chrono::nanoseconds wait_time =
+      scheduled_time - std::chrono::steady_clock::now();
+  if (wait_time.count() < 0) {
+    return true;
+  }
+  if (precise_scheduling_) {
+    precise_sleeper_.SleepUntil(scheduled_time);
+  } else {
+    std::this_thread::sleep_for(wait_time);
+  }
+  return false;
+}
+
+void
+RequestRateDispatcher::PushEvent(const SendEvent& event)
+{
+  // A full queue means every worker is busy. The event keeps its scheduled
+  // time, so the backlog shows up in the reported schedule error.
+  while (!send_queue_->TryPush(event)) {
+    if (!execute_ || early_exit) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,95 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "ischeduler.h"
+#include "precise_sleeper.h"
+#include "send_event_queue.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Thread that follows a request schedule on behalf of the worker threads
+///
+/// Instead of sending requests itself, the dispatcher pushes a SendEvent
+/// into a queue at each scheduled time. Any idle worker picks the event up
+/// and sends the request, so a slow response only ever delays the worker
+/// that is waiting on it and not the schedule.
+///
+class RequestRateDispatcher : public IScheduler {
+ public:
+  RequestRateDispatcher(
+      std::shared_ptr<SendEventQueue> send_queue,
+      std::condition_variable& wake_signal, std::mutex& wake_mutex,
+      bool& execute, std::chrono::steady_clock::time_point& start_time,
+      const bool precise_scheduling)
+      : send_queue_(send_queue), wake_signal_(wake_signal),
+        wake_mutex_(wake_mutex), execute_(execute), start_time_(start_time),
+        precise_scheduling_(precise_scheduling)
+  {
+  }
+
+  /// Releases send events until exit is requested. Runs on its own thread.
+  ///
+  void Dispatch();
+
+  /// Provides the schedule that should be followed
+  ///
+  void SetSchedule(RateSchedulePtr_t schedule) override;
+
+  /// \return True if the dispatcher is waiting for execution to resume
+  bool IsPaused() const { return is_paused_; }
+
+ private:
+  void HandleExecuteOff();
+
+  // Wait until 'scheduled_time'
+  // Returns true if it had already passed
+  bool WaitUntil(std::chrono::steady_clock::time_point scheduled_time);
+
+  // Push the event, waiting for the workers to make room for it if needed
+  void PushEvent(const SendEvent& event);
+
+  RateSchedulePtr_t schedule_;
+  std::shared_ptr<SendEventQueue> send_queue_;
+
+  std::condition_variable& wake_signal_;
+  std::mutex& wake_mutex_;
+  bool& execute_;
+  std::chrono::steady_clock::time_point& start_time_;
+
+  const bool precise_scheduling_;
+  PreciseSleeper precise_sleeper_;
+
+  std::atomic<bool> is_paused_{false};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -26,6 +26,8 @@
 
 #include "request_rate_manager.h"
 
+#include <algorithm>
+
 namespace triton { namespace perfanalyzer {
 
 RequestRateManager::~RequestRateManager()
@@ -33,24 +35,27 @@ RequestRateManager::~RequestRateManager()
   // The destruction of derived class should wait for all the request generator
   // threads to finish
   StopWorkerThreads();
+  StopDispatcherThreads();
 }
 
 cb::Error
 RequestRateManager::Create(
     const bool async, const bool streaming,
     const uint64_t measurement_window_ms, const size_t max_trials,
-    Distribution request_distribution, const int32_t batch_size,
+    Distribution request_distribution,
+    const RateProfileSettings& rate_profile_settings, const int32_t batch_size,
     const size_t max_threads, const uint32_t num_of_sequences,
+    const bool precise_scheduling, const size_t num_dispatcher_threads,
     const SharedMemoryType shared_memory_type, const size_t output_shm_size,
-
     const std::shared_ptr<ModelParser>& parser,
     const std::shared_ptr<cb::ClientBackendFactory>& factory,
     std::unique_ptr<LoadManager>* manager)
 {
   std::unique_ptr<RequestRateManager> local_manager(new RequestRateManager(
-      async, streaming, request_distribution, batch_size, measurement_window_ms,
-      max_trials, max_threads, num_of_sequences, shared_memory_type,
-      output_shm_size, parser, factory));
+      async, streaming, request_distribution, rate_profile_settings,
+      batch_size, measurement_window_ms, max_trials, max_threads,
+      num_of_sequences, precise_scheduling, num_dispatcher_threads,
+      shared_memory_type, output_shm_size, parser, factory));
 
   *manager = std::move(local_manager);
 
@@ -59,20 +64,22 @@ RequestRateManager::Create(
 
 RequestRateManager::RequestRateManager(
     const bool async, const bool streaming, Distribution request_distribution,
-    int32_t batch_size, const uint64_t measurement_window_ms,
-    const size_t max_trials, const size_t max_threads,
-    const uint32_t num_of_sequences, const SharedMemoryType shared_memory_type,
-    const size_t output_shm_size, const std::shared_ptr<ModelParser>& parser,
+    const RateProfileSettings& rate_profile_settings, int32_t batch_size,
+    const uint64_t measurement_window_ms, const size_t max_trials,
+    const size_t max_threads, const uint32_t num_of_sequences,
+    const bool precise_scheduling, const size_t num_dispatcher_threads,
+    const SharedMemoryType shared_memory_type, const size_t output_shm_size,
+    const std::shared_ptr<ModelParser>& parser,
     const std::shared_ptr<cb::ClientBackendFactory>& factory)
     : LoadManager(
           async, streaming, batch_size, max_threads, shared_memory_type,
           output_shm_size, parser, factory),
-      request_distribution_(request_distribution), execute_(false),
-      num_of_sequences_(num_of_sequences)
+      request_distribution_(request_distribution),
+      rate_profile_settings_(rate_profile_settings), execute_(false),
+      num_of_sequences_(num_of_sequences),
+      precise_scheduling_(precise_scheduling),
+      num_dispatcher_threads_(num_dispatcher_threads)
 {
-  gen_duration_.reset(new std::chrono::nanoseconds(
-      max_trials * measurement_window_ms * NANOS_PER_MILLIS));
-
   threads_config_.reserve(max_threads);
 }
 
@@ -89,12 +96,51 @@ RequestRateManager::ChangeRequestRate(const double request_rate)
 {
   PauseWorkers();
   // Can safely update the schedule
+  request_rate_ = request_rate;
+  delayed_fraction_before_growth_ = -1.0;
   GenerateSchedule(request_rate);
   ResumeWorkers();
 
   return cb::Error::Success;
 }
 
+cb::Error
+RequestRateManager::AdaptWorkerThreads(
+    const size_t request_count, const size_t delayed_request_count,
+    bool* added)
+{
+  *added = false;
+  if (!auto_threads_ || (request_count == 0) ||
+      (max_threads_ >= kAutoThreadsLimit)) {
+    return cb::Error::Success;
+  }
+  const double delayed_fraction =
+      static_cast<double>(delayed_request_count) / request_count;
+  if (delayed_fraction <= kAutoThreadsDelayTolerance) {
+    return cb::Error::Success;
+  }
+  // Doubling the threads should at least cut a tenth of the delays
+  if ((delayed_fraction_before_growth_ >= 0.0) &&
+      (delayed_fraction > 0.9 * delayed_fraction_before_growth_)) {
+    return cb::Error::Success;
+  }
+  delayed_fraction_before_growth_ = delayed_fraction;
+
+  PauseWorkers();
+  max_threads_ = std::min(max_threads_ * 2, kAutoThreadsLimit);
+  for (auto& thread_config : threads_config_) {
+    thread_config->stride_ = max_threads_;
+  }
+  LaunchWorkerThreads();
+  // Wait for the new threads to pause before giving them their schedules
+  PauseWorkers();
+  GenerateSchedule(request_rate_);
+  ResumeWorkers();
+
+  *added = true;
+  return cb::Error::Success;
+}
+
 cb::Error
 RequestRateManager::ResetWorkers()
 {
@@ -110,12 +156,22 @@ RequestRateManager::GenerateSchedule(const double request_rate)
   std::chrono::nanoseconds max_duration;
   std::function<std::chrono::nanoseconds(std::mt19937&)> distribution;
 
-  if (request_distribution_ == Distribution::POISSON) {
-    distribution = ScheduleDistribution<Distribution::POISSON>(request_rate);
-    // Poisson distribution needs to generate a schedule for the maximum
-    // possible duration to make sure that it is as random and as close to the
-    // desired rate as possible
-    max_duration = *gen_duration_;
+  if (schedule_plugin_ != nullptr) {
+    std::vector<RateSchedulePtr_t> worker_schedules;
+    THROW_IF_ERROR(
+        CreatePluginWorkerSchedules(request_rate, &worker_schedules),
+        "Failed to create the schedules of the schedule plugin");
+    GiveSchedulesToWorkers(worker_schedules);
+    return;
+  }
+  if ((request_distribution_ == Distribution::POISSON) ||
+      (request_distribution_ == Distribution::BURSTY) ||
+      (request_distribution_ == Distribution::MMPP) ||
+      (request_distribution_ == Distribution::DIURNAL)) {
+    // Random schedules are generated on demand rather than precomputed for
+    // the whole run
+    GiveSchedulesToWorkers(CreateGeneratedWorkerSchedules(request_rate));
+    return;
   } else if (request_distribution_ == Distribution::CONSTANT) {
     distribution = ScheduleDistribution<Distribution::CONSTANT>(request_rate);
     // Constant distribution only needs one entry per worker -- that one value
@@ -149,7 +205,7 @@ RequestRateManager::CreateWorkerSchedules(
   while (next_timestamp < max_duration || worker_index != 0) {
     next_timestamp = next_timestamp + distribution(schedule_rng);
     worker_schedules[worker_index]->intervals.emplace_back(next_timestamp);
-    worker_index = (worker_index + 1) % workers_.size();
+    worker_index = (worker_index + 1) % worker_schedules.size();
   }
 
   SetScheduleDurations(worker_schedules);
@@ -157,11 +213,58 @@ RequestRateManager::CreateWorkerSchedules(
   return worker_schedules;
 }
 
+std::vector<RateSchedulePtr_t>
+RequestRateManager::CreateGeneratedWorkerSchedules(const double request_rate)
+{
+  std::vector<RateSchedulePtr_t> worker_schedules =
+      CreateEmptyWorkerSchedules();
+
+  // The superposition of independent Poisson processes is a Poisson process
+  // with the summed rate, so each schedule gets an independent stream at an
+  // equal share of the rate. The same holds for modulated processes as long
+  // as they all follow the same rate profile, which is why every schedule
+  // gets an identically seeded profile of its own.
+  const double schedule_rate = request_rate / worker_schedules.size();
+  for (size_t i = 0; i < worker_schedules.size(); i++) {
+    auto profile =
+        MakeRateProfile(request_distribution_, rate_profile_settings_);
+    if (profile != nullptr) {
+      worker_schedules[i]->distribution =
+          ModulatedPoissonDistribution(profile, schedule_rate);
+    } else {
+      worker_schedules[i]->distribution =
+          ScheduleDistribution<Distribution::POISSON>(schedule_rate);
+    }
+    worker_schedules[i]->rng.seed(i);
+  }
+
+  return worker_schedules;
+}
+
+cb::Error
+RequestRateManager::CreatePluginWorkerSchedules(
+    const double request_rate,
+    std::vector<RateSchedulePtr_t>* worker_schedules)
+{
+  *worker_schedules = CreateEmptyWorkerSchedules();
+  const uint32_t count = worker_schedules->size();
+  for (uint32_t i = 0; i < count; i++) {
+    RETURN_IF_ERROR(schedule_plugin_->CreateSchedule(
+        request_rate, i, count, data_loader_->GetDataStreamsCount(),
+        &(*worker_schedules)[i]->plugin));
+  }
+  return cb::Error::Success;
+}
+
 std::vector<RateSchedulePtr_t>
 RequestRateManager::CreateEmptyWorkerSchedules()
 {
+  // With dispatchers, they own the schedules instead of the workers
+  size_t num_schedules =
+      dispatchers_.empty() ? workers_.size() : dispatchers_.size();
+
   std::vector<RateSchedulePtr_t> worker_schedules;
-  for (size_t i = 0; i < workers_.size(); i++) {
+  for (size_t i = 0; i < num_schedules; i++) {
     worker_schedules.push_back(std::make_shared<RateSchedule>());
   }
   return worker_schedules;
@@ -184,6 +287,13 @@ void
 RequestRateManager::GiveSchedulesToWorkers(
     const std::vector<RateSchedulePtr_t>& worker_schedules)
 {
+  if (!dispatchers_.empty()) {
+    for (size_t i = 0; i < dispatchers_.size(); i++) {
+      dispatchers_[i]->SetSchedule(worker_schedules[i]);
+    }
+    return;
+  }
+
   for (size_t i = 0; i < workers_.size(); i++) {
     auto w = std::dynamic_pointer_cast<IScheduler>(workers_[i]);
     w->SetSchedule(worker_schedules[i]);
@@ -197,17 +307,18 @@ RequestRateManager::PauseWorkers()
   execute_ = false;
 
   if (threads_.empty()) {
-    while (threads_.size() < max_threads_) {
-      // Launch new thread for inferencing
-      threads_stat_.emplace_back(new ThreadStat());
-      threads_config_.emplace_back(
-          new RequestRateWorker::ThreadConfig(threads_.size(), max_threads_));
-
-      workers_.push_back(
-          MakeWorker(threads_stat_.back(), threads_config_.back()));
-
-      threads_.emplace_back(&IWorker::Infer, workers_.back());
+    if (num_dispatcher_threads_ > 0) {
+      send_queue_ = std::make_shared<SendEventQueue>();
+      while (dispatchers_.size() < num_dispatcher_threads_) {
+        dispatchers_.push_back(std::make_shared<RequestRateDispatcher>(
+            send_queue_, wake_signal_, wake_mutex_, execute_, start_time_,
+            precise_scheduling_));
+        dispatcher_threads_.emplace_back(
+            &RequestRateDispatcher::Dispatch, dispatchers_.back());
+      }
     }
+
+    LaunchWorkerThreads();
   }
 
   // Wait to see all threads are paused.
@@ -216,6 +327,35 @@ RequestRateManager::PauseWorkers()
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
   }
+  for (auto& dispatcher : dispatchers_) {
+    while (!dispatcher->IsPaused()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  // Events released for the old schedule must not be sent after resuming
+  if (send_queue_ != nullptr) {
+    send_queue_->Clear();
+  }
+}
+
+void
+RequestRateManager::LaunchWorkerThreads()
+{
+  while (threads_.size() < max_threads_) {
+    // Launch new thread for inferencing
+    AddThreadStat();
+    threads_config_.emplace_back(
+        new RequestRateWorker::ThreadConfig(threads_.size(), max_threads_));
+    threads_config_.back()->precise_scheduling_ = precise_scheduling_;
+    threads_config_.back()->send_queue_ = send_queue_;
+
+    workers_.push_back(
+        MakeWorker(threads_stat_.back(), threads_config_.back()));
+
+    threads_.emplace_back(&IWorker::Infer, workers_.back());
+    PinNewWorkerThread();
+  }
 }
 
 void
@@ -229,6 +369,18 @@ RequestRateManager::ResumeWorkers()
   wake_signal_.notify_all();
 }
 
+void
+RequestRateManager::StopDispatcherThreads()
+{
+  early_exit = true;
+  wake_signal_.notify_all();
+
+  for (auto& thread : dispatcher_threads_) {
+    thread.join();
+  }
+  dispatcher_threads_.clear();
+}
+
 std::shared_ptr<IWorker>
 RequestRateManager::MakeWorker(
     std::shared_ptr<ThreadStat> thread_stat,
@@ -239,7 +391,7 @@ RequestRateManager::MakeWorker(
       id, thread_stat, thread_config, parser_, data_loader_, factory_,
       on_sequence_model_, async_, max_threads_, using_json_data_, streaming_,
       batch_size_, wake_signal_, wake_mutex_, execute_, start_time_,
-      infer_data_manager_, sequence_manager_);
+      WorkerInferDataManager(), WorkerSequenceManager());
 }
 
 
@@ -27,6 +27,8 @@
 
 #include <condition_variable>
 #include "load_manager.h"
+#include "rate_profile.h"
+#include "request_rate_dispatcher.h"
 #include "request_rate_worker.h"
 
 namespace triton { namespace perfanalyzer {
@@ -45,16 +47,27 @@ class TestRequestRateManager;
 /// requests per second values and to collect per-request statistic.
 ///
 /// Detail:
-/// Request Rate Manager will try to follow a pre-computed schedule while
-/// issuing requests to the server and maintain a constant request rate. The
+/// Request Rate Manager will try to follow a schedule while issuing requests
+/// to the server and maintain a constant request rate. The
 /// manager will spawn max_threads many worker thread to meet the timeline
 /// imposed by the schedule. The worker threads will record the start time and
 /// end time of each request into a shared vector which will be used to report
 /// the observed latencies in serving requests. Additionally, they will report a
 /// vector of the number of requests missed their schedule.
 ///
+/// Optionally, a few dispatcher threads follow the schedule instead and
+/// release each request into a lock-free queue from which any free worker
+/// sends it. Then a worker blocked on a slow response no longer holds back
+/// the rest of the schedule.
+///
 class RequestRateManager : public LoadManager {
  public:
+  /// The most worker threads the automatic scaling grows to.
+  static constexpr size_t kAutoThreadsLimit = 256;
+  /// The fraction of the requests that may fall behind schedule before the
+  /// automatic scaling adds worker threads.
+  static constexpr double kAutoThreadsDelayTolerance = 0.01;
+
   ~RequestRateManager();
 
   /// Create an object of realistic load manager that is responsible to maintain
@@ -66,10 +79,17 @@ class RequestRateManager : public LoadManager {
   /// \param max_trials The maximum number of windows that will be measured
   /// \param request_distribution The kind of distribution to use for drawing
   /// out intervals between successive requests.
+  /// \param rate_profile_settings The parameters of the time-varying request
+  /// distributions.
   /// \param batch_size The batch size used for each request.
   /// \param max_threads The maximum number of working threads to be spawned.
   /// \param num_of_sequences The number of concurrent sequences that must be
   /// maintained on the server.
+  /// \param precise_scheduling Whether to wait for each scheduled send time
+  /// with a calibrated sleep and spin instead of a plain sleep.
+  /// \param num_dispatcher_threads The number of threads that follow the
+  /// schedule and release requests to whichever worker is free. If 0, each
+  /// worker follows its own share of the schedule.
   /// \param string_length The length of the string to create for input.
   /// \param string_data The data to use for generating string input.
   /// \param zero_input Whether to fill the input tensors with zero.
@@ -86,8 +106,11 @@ class RequestRateManager : public LoadManager {
   static cb::Error Create(
       const bool async, const bool streaming,
       const uint64_t measurement_window_ms, const size_t max_trials,
-      Distribution request_distribution, const int32_t batch_size,
-      const size_t max_threads, const uint32_t num_of_sequences,
+      Distribution request_distribution,
+      const RateProfileSettings& rate_profile_settings,
+      const int32_t batch_size, const size_t max_threads,
+      const uint32_t num_of_sequences,
+      const bool precise_scheduling, const size_t num_dispatcher_threads,
       const SharedMemoryType shared_memory_type, const size_t output_shm_size,
       const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory,
@@ -103,12 +126,44 @@ class RequestRateManager : public LoadManager {
   /// \return cb::Error object indicating success or failure.
   cb::Error ResetWorkers() override;
 
+  /// Lets the worker threads grow, from the max_threads given at creation up
+  /// to kAutoThreadsLimit, while requests fall behind their schedule.
+  void EnableAutoThreads() { auto_threads_ = true; }
+
+  bool AutoThreadsEnabled() const { return auto_threads_; }
+
+  /// Doubles the worker threads if more than kAutoThreadsDelayTolerance of
+  /// the requests of a measurement fell behind schedule. Stops growing at the
+  /// current request rate once adding threads no longer reduces the delays,
+  /// as the client is then limited by something else.
+  /// \param request_count The number of requests of the measurement.
+  /// \param delayed_request_count The number of them that were delayed.
+  /// \param added Returns whether worker threads were added, in which case
+  /// the request rate should be measured again.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error AdaptWorkerThreads(
+      const size_t request_count, const size_t delayed_request_count,
+      bool* added);
+
+  /// \return The number of worker threads.
+  size_t WorkerThreadCount() const { return threads_.size(); }
+
+  /// Makes the schedules come from a plugin instead of the request
+  /// distribution. Must be called before the first request rate is set.
+  /// \param plugin The schedule plugin.
+  void SetSchedulePlugin(std::shared_ptr<SchedulePlugin> plugin)
+  {
+    schedule_plugin_ = plugin;
+  }
+
  protected:
   RequestRateManager(
       const bool async, const bool streaming, Distribution request_distribution,
+      const RateProfileSettings& rate_profile_settings,
       const int32_t batch_size, const uint64_t measurement_window_ms,
       const size_t max_trials, const size_t max_threads,
-      const uint32_t num_of_sequences,
+      const uint32_t num_of_sequences, const bool precise_scheduling,
+      const size_t num_dispatcher_threads,
       const SharedMemoryType shared_memory_type, const size_t output_shm_size,
       const std::shared_ptr<ModelParser>& parser,
       const std::shared_ptr<cb::ClientBackendFactory>& factory);
@@ -123,6 +178,18 @@ class RequestRateManager : public LoadManager {
       std::chrono::nanoseconds duration,
       std::function<std::chrono::nanoseconds(std::mt19937&)> distribution);
 
+  // Creates schedules that draw their timestamps on demand from a Poisson
+  // process, or a modulated one for the time-varying distributions, with one
+  // independent stream per schedule
+  std::vector<RateSchedulePtr_t> CreateGeneratedWorkerSchedules(
+      const double request_rate);
+
+  // Creates schedules that read their requests from the schedule plugin,
+  // each at an equal share of the rate
+  cb::Error CreatePluginWorkerSchedules(
+      const double request_rate,
+      std::vector<RateSchedulePtr_t>* worker_schedules);
+
   std::vector<RateSchedulePtr_t> CreateEmptyWorkerSchedules();
 
   void SetScheduleDurations(std::vector<RateSchedulePtr_t>& schedules);
@@ -130,12 +197,18 @@ class RequestRateManager : public LoadManager {
   void GiveSchedulesToWorkers(
       const std::vector<RateSchedulePtr_t>& worker_schedules);
 
-  // Pauses the worker threads
+  // Pauses the worker threads, launching them on the first call
   void PauseWorkers();
 
+  // Launches worker threads until there are max_threads_ of them
+  void LaunchWorkerThreads();
+
   // Resets the counters and resumes the worker threads
   void ResumeWorkers();
 
+  // Stops and joins the dispatcher threads
+  void StopDispatcherThreads();
+
   // Makes a new worker
   virtual std::shared_ptr<IWorker> MakeWorker(
       std::shared_ptr<ThreadStat>,
@@ -143,11 +216,26 @@ class RequestRateManager : public LoadManager {
 
   std::vector<std::shared_ptr<RequestRateWorker::ThreadConfig>> threads_config_;
 
-  std::shared_ptr<std::chrono::nanoseconds> gen_duration_;
   Distribution request_distribution_;
+  RateProfileSettings rate_profile_settings_;
   std::chrono::steady_clock::time_point start_time_;
   bool execute_;
   const size_t num_of_sequences_{0};
+  bool precise_scheduling_{false};
+  size_t num_dispatcher_threads_{0};
+  // The request rate of the current schedule
+  double request_rate_{0.0};
+  // Makes the schedules instead of the request distribution, if not null
+  std::shared_ptr<SchedulePlugin> schedule_plugin_;
+  bool auto_threads_{false};
+  // The fraction of delayed requests before the last growth of the worker
+  // threads at the current request rate, negative if they have not grown
+  double delayed_fraction_before_growth_{-1.0};
+
+  // Only used when num_dispatcher_threads_ > 0
+  std::shared_ptr<SendEventQueue> send_queue_;
+  std::vector<std::shared_ptr<RequestRateDispatcher>> dispatchers_;
+  std::vector<std::thread> dispatcher_threads_;
 
 #ifndef DOCTEST_CONFIG_DISABLE
   friend TestRequestRateManager;
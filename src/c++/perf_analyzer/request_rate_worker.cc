@@ -43,9 +43,30 @@ RequestRateWorker::Infer()
   do {
     HandleExecuteOff();
 
-    bool is_delayed = SleepIfNecessary();
-    uint32_t ctx_id = GetCtxId();
-    SendInferRequest(ctx_id, is_delayed);
+    if (thread_config_->send_queue_ != nullptr) {
+      SendEvent event;
+      if (WaitForSendEvent(&event)) {
+        RecordScheduleError(event.scheduled_time_);
+        uint32_t ctx_id = GetCtxId();
+        ctxs_[ctx_id]->SetIntendedSendTime(event.scheduled_time_);
+        if (event.replayed_) {
+          SendReplayedRequest(ctx_id, event.delayed_, event.record_);
+        } else {
+          SendInferRequest(ctx_id, event.delayed_, event.data_stream_id_);
+        }
+      }
+    } else {
+      std::chrono::steady_clock::time_point scheduled_time;
+      bool is_delayed = SleepIfNecessary(&scheduled_time);
+      uint32_t ctx_id = GetCtxId();
+      ctxs_[ctx_id]->SetIntendedSendTime(scheduled_time);
+      const ScheduleRecord* replayed = schedule_->Replayed();
+      if (replayed != nullptr) {
+        SendReplayedRequest(ctx_id, is_delayed, *replayed);
+      } else {
+        SendInferRequest(ctx_id, is_delayed, schedule_->DataStreamId());
+      }
+    }
 
     if (HandleExitConditions()) {
       return;
@@ -93,6 +114,10 @@ RequestRateWorker::HandleExecuteOff()
     thread_config_->is_paused_ = true;
     std::unique_lock<std::mutex> lock(wake_mutex_);
     wake_signal_.wait(lock, [this]() { return early_exit || execute_; });
+    // The number of workers may have grown while paused
+    for (auto& ctx : ctxs_) {
+      ctx->SetNumActiveThreads(thread_config_->stride_);
+    }
   }
 
   thread_config_->is_paused_ = false;
@@ -100,22 +125,69 @@ RequestRateWorker::HandleExecuteOff()
 
 
 bool
-RequestRateWorker::SleepIfNecessary()
+RequestRateWorker::SleepIfNecessary(
+    std::chrono::steady_clock::time_point* scheduled_time_out)
 {
   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
   std::chrono::nanoseconds next_timestamp = GetNextTimestamp();
-  std::chrono::nanoseconds current_timestamp = now - start_time_;
-  std::chrono::nanoseconds wait_time = next_timestamp - current_timestamp;
+  std::chrono::steady_clock::time_point scheduled_time =
+      start_time_ + next_timestamp;
+  *scheduled_time_out = scheduled_time;
+  std::chrono::nanoseconds wait_time = scheduled_time - now;
 
   bool delayed = false;
   if (wait_time.count() < 0) {
     delayed = true;
   } else {
     thread_stat_->idle_timer.Start();
-    std::this_thread::sleep_for(wait_time);
+    if (thread_config_->precise_scheduling_) {
+      precise_sleeper_.SleepUntil(scheduled_time);
+    } else {
+      std::this_thread::sleep_for(wait_time);
+    }
     thread_stat_->idle_timer.Stop();
   }
+  RecordScheduleError(scheduled_time);
   return delayed;
 }
 
+bool
+RequestRateWorker::WaitForSendEvent(SendEvent* event)
+{
+  auto& send_queue = thread_config_->send_queue_;
+  if (send_queue->TryPop(event)) {
+    return true;
+  }
+
+  // Yield for a while before backing off to short sleeps, so that a busy
+  // queue is picked up promptly without burning a core when it is quiet
+  constexpr size_t max_yields = 64;
+  bool popped = false;
+  thread_stat_->idle_timer.Start();
+  for (size_t attempt = 0; execute_ && !ShouldExit(); attempt++) {
+    if (send_queue->TryPop(event)) {
+      popped = true;
+      break;
+    }
+    if (attempt < max_yields) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+  }
+  thread_stat_->idle_timer.Stop();
+  return popped;
+}
+
+void
+RequestRateWorker::RecordScheduleError(
+    std::chrono::steady_clock::time_point scheduled_time)
+{
+  std::chrono::nanoseconds error =
+      std::chrono::steady_clock::now() - scheduled_time;
+  std::lock_guard<std::mutex> lock(thread_stat_->schedule_error_mu_);
+  thread_stat_->schedule_error_histogram_.Record(
+      std::max<int64_t>(error.count(), 0));
+}
+
 }}  // namespace triton::perfanalyzer
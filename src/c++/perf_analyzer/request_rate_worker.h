@@ -30,6 +30,8 @@
 #include "ischeduler.h"
 #include "load_worker.h"
 #include "model_parser.h"
+#include "precise_sleeper.h"
+#include "send_event_queue.h"
 #include "sequence_manager.h"
 
 namespace triton { namespace perfanalyzer {
@@ -47,18 +49,27 @@ class TestCustomLoadManager;
 /// to maintain concurrency assigned to worker.
 /// If the model is sequence model, each worker has to use multiples contexts
 /// to maintain (sequence) concurrency assigned to worker.
+/// If a send queue is configured, the worker sends whatever the dispatchers
+/// release into it instead of following a schedule of its own.
 ///
 class RequestRateWorker : public LoadWorker, public IScheduler {
  public:
   struct ThreadConfig {
     ThreadConfig(uint32_t index, uint32_t stride)
-        : id_(index), stride_(stride), is_paused_(false)
+        : id_(index), stride_(stride), is_paused_(false),
+          precise_scheduling_(false)
     {
     }
 
     uint32_t id_;
     uint32_t stride_;
     bool is_paused_;
+    // Whether to wait for scheduled send times with PreciseSleeper instead
+    // of sleep_for()
+    bool precise_scheduling_;
+    // When set, send the requests released into this queue by the
+    // dispatchers instead of following a schedule of this worker's own
+    std::shared_ptr<SendEventQueue> send_queue_;
   };
 
   RequestRateWorker(
@@ -97,6 +108,8 @@ class RequestRateWorker : public LoadWorker, public IScheduler {
 
   std::shared_ptr<ThreadConfig> thread_config_;
 
+  PreciseSleeper precise_sleeper_;
+
   std::chrono::nanoseconds GetNextTimestamp();
 
   // Request Rate Worker only ever has a single context
@@ -111,9 +124,19 @@ class RequestRateWorker : public LoadWorker, public IScheduler {
 
   void HandleExecuteOff();
 
-  // Sleep until it is time for the next part of the schedule
+  // Sleep until it is time for the next part of the schedule, which is
+  // returned in scheduled_time_out
   // Returns true if the request was delayed
-  bool SleepIfNecessary();
+  bool SleepIfNecessary(
+      std::chrono::steady_clock::time_point* scheduled_time_out);
+
+  // Wait for a dispatcher to release the next request
+  // Returns false if execution was paused or stopped before one arrived
+  bool WaitForSendEvent(SendEvent* event);
+
+  // Record how late the request scheduled at 'scheduled_time' is being sent
+  void RecordScheduleError(
+      std::chrono::steady_clock::time_point scheduled_time);
 
   void CreateContextFinalize(std::shared_ptr<InferContext> ctx) override
   {
@@ -0,0 +1,223 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Compact, trivially copyable record of a single completed request.
+///
+struct RequestRecord {
+  static constexpr uint32_t SEQUENCE_END = 1u << 0;
+  static constexpr uint32_t DELAYED = 1u << 1;
+
+  // Start and end of the request in nanoseconds since the system_clock
+  // epoch
+  uint64_t start_ns_;
+  uint64_t end_ns_;
+  // Arrival of the first response in nanoseconds since the system_clock
+  // epoch
+  uint64_t first_response_ns_;
+  // Bitwise OR of SEQUENCE_END and DELAYED
+  uint32_t flags_;
+  // The number of responses received for the request
+  uint32_t response_count_;
+};
+
+/// Single-producer, single-consumer ring buffer of request records.
+///
+/// The worker side calls Push() and the profiler side calls Drain() and
+/// Size(); neither side ever waits on the other. Push() is not safe to call
+/// concurrently with itself, so callers that record from more than one
+/// thread (e.g. several async callback threads sharing one ThreadStat) must
+/// serialize their Push() calls externally.
+///
+/// If the profiler falls far enough behind for the ring to fill up, records
+/// spill into an overflow vector instead of being dropped. Only that rare
+/// path takes a lock, and per-producer ordering is preserved across it.
+///
+class RequestRecordRing {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+  /// \param capacity The number of records the ring holds before spilling.
+  /// Rounded up to a power of two.
+  explicit RequestRecordRing(size_t capacity = DEFAULT_CAPACITY)
+  {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    records_.resize(rounded);
+    mask_ = rounded - 1;
+  }
+
+  RequestRecordRing(const RequestRecordRing&) = delete;
+  RequestRecordRing& operator=(const RequestRecordRing&) = delete;
+
+  /// Record a request. Producer side only.
+  void Push(const RequestRecord& record)
+  {
+    if (spilled_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lk(spill_mu_);
+      // Re-check under the lock as the consumer may have just drained the
+      // overflow vector, in which case the ring is usable again.
+      if (spilled_.load(std::memory_order_relaxed)) {
+        spill_.push_back(record);
+        spill_size_.fetch_add(1, std::memory_order_release);
+        return;
+      }
+    }
+
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_) {
+      std::lock_guard<std::mutex> lk(spill_mu_);
+      spill_.push_back(record);
+      spill_size_.fetch_add(1, std::memory_order_release);
+      spilled_.store(true, std::memory_order_release);
+      return;
+    }
+    records_[head & mask_] = record;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /// Record a request that received a single response. Producer side only.
+  void Push(
+      const std::chrono::time_point<std::chrono::system_clock>& start_time,
+      const std::chrono::time_point<std::chrono::system_clock>& end_time,
+      bool sequence_end, bool delayed)
+  {
+    Push(start_time, end_time, sequence_end, delayed, end_time, 1);
+  }
+
+  /// Record a request of a decoupled model. Producer side only.
+  void Push(
+      const std::chrono::time_point<std::chrono::system_clock>& start_time,
+      const std::chrono::time_point<std::chrono::system_clock>& end_time,
+      bool sequence_end, bool delayed,
+      const std::chrono::time_point<std::chrono::system_clock>&
+          first_response_time,
+      uint32_t response_count)
+  {
+    RequestRecord record;
+    record.start_ns_ = CHRONO_TO_NANOS(start_time);
+    record.end_ns_ = CHRONO_TO_NANOS(end_time);
+    record.first_response_ns_ = CHRONO_TO_NANOS(first_response_time);
+    record.flags_ = (sequence_end ? RequestRecord::SEQUENCE_END : 0) |
+                    (delayed ? RequestRecord::DELAYED : 0);
+    record.response_count_ = response_count;
+    Push(record);
+  }
+
+  /// Record a request given in the TimestampVector representation. Producer
+  /// side only.
+  void Push(const TimestampVector::value_type& timestamp)
+  {
+    Push(
+        std::get<0>(timestamp), std::get<1>(timestamp),
+        std::get<2>(timestamp) != 0, std::get<3>(timestamp),
+        std::get<4>(timestamp), std::get<5>(timestamp));
+  }
+
+  /// \return The number of records currently held. Consumer side only.
+  size_t Size() const
+  {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_relaxed) +
+           spill_size_.load(std::memory_order_acquire);
+  }
+
+  /// Move every record pushed so far to the end of \p timestamps, oldest
+  /// first. Consumer side only.
+  void Drain(TimestampVector* timestamps)
+  {
+    if (!spilled_.load(std::memory_order_acquire)) {
+      DrainRing(timestamps);
+      return;
+    }
+
+    // The producer stops writing to the ring once it has spilled, so
+    // everything left in the ring is older than the overflow records.
+    std::lock_guard<std::mutex> lk(spill_mu_);
+    DrainRing(timestamps);
+    for (const auto& record : spill_) {
+      AppendTimestamp(record, timestamps);
+    }
+    spill_.clear();
+    spill_size_.store(0, std::memory_order_release);
+    spilled_.store(false, std::memory_order_release);
+  }
+
+ private:
+  void DrainRing(TimestampVector* timestamps)
+  {
+    const size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) {
+      AppendTimestamp(records_[tail & mask_], timestamps);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  static void AppendTimestamp(
+      const RequestRecord& record, TimestampVector* timestamps)
+  {
+    using time_point = std::chrono::time_point<std::chrono::system_clock>;
+    using std::chrono::duration_cast;
+    timestamps->emplace_back(
+        time_point(duration_cast<time_point::duration>(
+            std::chrono::nanoseconds(record.start_ns_))),
+        time_point(duration_cast<time_point::duration>(
+            std::chrono::nanoseconds(record.end_ns_))),
+        (record.flags_ & RequestRecord::SEQUENCE_END) ? 1 : 0,
+        (record.flags_ & RequestRecord::DELAYED) != 0,
+        time_point(duration_cast<time_point::duration>(
+            std::chrono::nanoseconds(record.first_response_ns_))),
+        record.response_count_);
+  }
+
+  std::vector<RequestRecord> records_;
+  size_t mask_;
+
+  // Written by the producer, read by the consumer
+  alignas(64) std::atomic<size_t> head_{0};
+  // Written by the consumer, read by the producer
+  alignas(64) std::atomic<size_t> tail_{0};
+
+  // Overflow storage used only while the ring is full
+  alignas(64) std::atomic<bool> spilled_{false};
+  std::atomic<size_t> spill_size_{0};
+  std::mutex spill_mu_;
+  std::vector<RequestRecord> spill_;
+};
+
+}}  // namespace triton::perfanalyzer
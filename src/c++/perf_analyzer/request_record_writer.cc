@@ -0,0 +1,164 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "request_record_writer.h"
+
+#include <cstring>
+
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+constexpr char RequestRecordWriter::kMagic[8];
+
+cb::Error
+RequestRecordWriter::Create(
+    const std::string& path, std::shared_ptr<RequestRecordWriter>* writer)
+{
+  std::shared_ptr<RequestRecordWriter> local_writer(
+      new RequestRecordWriter(path));
+  local_writer->file_.open(path, std::ofstream::out | std::ofstream::binary);
+  if (!local_writer->file_.is_open()) {
+    return cb::Error(
+        "failed to open request record file " + path, pa::GENERIC_ERROR);
+  }
+  local_writer->file_.write(kMagic, sizeof(kMagic));
+  local_writer->file_.write(
+      reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+  if (!local_writer->file_.good()) {
+    return cb::Error(
+        "failed to write to request record file " + path, pa::GENERIC_ERROR);
+  }
+
+  *writer = std::move(local_writer);
+  return cb::Error::Success;
+}
+
+cb::Error
+RequestRecordWriter::Write(
+    const TimestampVector& timestamps, const double load_level,
+    const double infer_per_sec)
+{
+  if (timestamps.empty()) {
+    return cb::Error::Success;
+  }
+
+  send_time_ns_.clear();
+  latency_ns_.clear();
+  first_response_ns_.clear();
+  response_count_.clear();
+  flags_.clear();
+  for (const auto& timestamp : timestamps) {
+    const auto& start = std::get<0>(timestamp);
+    send_time_ns_.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            start.time_since_epoch())
+            .count());
+    latency_ns_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::get<1>(timestamp) - start)
+                              .count());
+    first_response_ns_.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::get<4>(timestamp) - start)
+            .count());
+    response_count_.push_back(std::get<5>(timestamp));
+    flags_.push_back(
+        (std::get<2>(timestamp) ? kSequenceEndFlag : 0) |
+        (std::get<3>(timestamp) ? kDelayedFlag : 0));
+  }
+
+  const uint64_t block_size = timestamps.size();
+  file_.write(reinterpret_cast<const char*>(&block_size), sizeof(block_size));
+  file_.write(reinterpret_cast<const char*>(&load_level), sizeof(load_level));
+  file_.write(
+      reinterpret_cast<const char*>(&infer_per_sec), sizeof(infer_per_sec));
+  WriteColumn(send_time_ns_);
+  WriteColumn(latency_ns_);
+  WriteColumn(first_response_ns_);
+  WriteColumn(response_count_);
+  WriteColumn(flags_);
+  file_.flush();
+  if (!file_.good()) {
+    return cb::Error(
+        "failed to write to request record file " + path_, pa::GENERIC_ERROR);
+  }
+  record_count_ += block_size;
+  return cb::Error::Success;
+}
+
+cb::Error
+ReadRequestRecords(
+    const std::string& path, std::vector<RequestRecordBlock>* blocks)
+{
+  std::ifstream file(path, std::ifstream::binary);
+  if (!file.is_open()) {
+    return cb::Error(
+        "failed to open request record file " + path, pa::GENERIC_ERROR);
+  }
+  char magic[sizeof(RequestRecordWriter::kMagic)];
+  uint32_t version = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!file.good() ||
+      (std::memcmp(magic, RequestRecordWriter::kMagic, sizeof(magic)) != 0)) {
+    return cb::Error(path + " is not a request record file", pa::OPTION_ERROR);
+  }
+  if (version != RequestRecordWriter::kVersion) {
+    return cb::Error(
+        "request record file " + path + " has version " +
+            std::to_string(version) + ", expected version " +
+            std::to_string(RequestRecordWriter::kVersion),
+        pa::OPTION_ERROR);
+  }
+
+  blocks->clear();
+  uint64_t block_size = 0;
+  while (file.read(reinterpret_cast<char*>(&block_size), sizeof(block_size))) {
+    RequestRecordBlock block;
+    block.latency_ns.resize(block_size);
+    file.read(
+        reinterpret_cast<char*>(&block.load_level), sizeof(block.load_level));
+    file.read(
+        reinterpret_cast<char*>(&block.infer_per_sec),
+        sizeof(block.infer_per_sec));
+    // Skip the send times, only the latencies are kept
+    file.seekg(block_size * sizeof(int64_t), std::ifstream::cur);
+    file.read(
+        reinterpret_cast<char*>(block.latency_ns.data()),
+        block_size * sizeof(uint64_t));
+    file.seekg(
+        block_size * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t)),
+        std::ifstream::cur);
+    if (!file.good()) {
+      return cb::Error(
+          "request record file " + path + " ends in the middle of a block",
+          pa::OPTION_ERROR);
+    }
+    blocks->push_back(std::move(block));
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,130 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "client_backend/client_backend.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+//==============================================================================
+/// RequestRecordWriter streams the record of every completed request to a
+/// compact binary file while perf_analyzer runs, so that the tail of the
+/// latency distribution of long runs can be analyzed offline.
+///
+/// The file starts with the 8 byte magic "PAREQREC" and a uint32 format
+/// version, followed by blocks of records. Each block starts with a header
+///   count                uint64  The number N of records in the block
+///   load_level           double  The concurrency or request rate
+///   infer_per_sec        double  The throughput of the measurement window
+///                                of the block, 0 for the requests that
+///                                completed between measurements
+/// followed by the columns of its records, each an array of N values in
+/// this order:
+///   send_time_ns         int64   Send time in nanoseconds since the epoch
+///   latency_ns           uint64  Time until the request completed
+///   first_response_ns    uint64  Time until the first response
+///   response_count       uint32  Responses received, 1 unless decoupled
+///   flags                uint8   Bit 0 the sequence end, bit 1 the request
+///                                was sent late
+/// All values are in the byte order of the host. A block is appended and
+/// flushed for every batch of requests drained from the load manager, so
+/// the file holds what completed up to the last measurement if the run is
+/// interrupted.
+///
+/// Version 1 files have no load level or throughput in the block headers.
+///
+class RequestRecordWriter {
+ public:
+  static constexpr char kMagic[8] = {'P', 'A', 'R', 'E', 'Q', 'R', 'E', 'C'};
+  static constexpr uint32_t kVersion = 2;
+  static constexpr uint8_t kSequenceEndFlag = 0x1;
+  static constexpr uint8_t kDelayedFlag = 0x2;
+
+  /// Create the file and write its header.
+  /// \param path The path of the file to write.
+  /// \param writer Returns a new RequestRecordWriter object.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const std::string& path, std::shared_ptr<RequestRecordWriter>* writer);
+
+  /// Append the records of the given requests as one block.
+  /// \param timestamps The timestamps of the completed requests.
+  /// \param load_level The concurrency or request rate they were sent at.
+  /// \param infer_per_sec The throughput of the measurement window they
+  /// completed in, 0 if they were not measured.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Write(
+      const TimestampVector& timestamps, const double load_level,
+      const double infer_per_sec);
+
+  /// \return The number of records written so far.
+  uint64_t RecordCount() const { return record_count_; }
+
+ private:
+  explicit RequestRecordWriter(const std::string& path) : path_(path) {}
+
+  template <typename T>
+  void WriteColumn(const std::vector<T>& column)
+  {
+    file_.write(
+        reinterpret_cast<const char*>(column.data()),
+        column.size() * sizeof(T));
+  }
+
+  std::string path_;
+  std::ofstream file_;
+  uint64_t record_count_{0};
+
+  // Reused across blocks to avoid reallocating the columns every window
+  std::vector<int64_t> send_time_ns_;
+  std::vector<uint64_t> latency_ns_;
+  std::vector<uint64_t> first_response_ns_;
+  std::vector<uint32_t> response_count_;
+  std::vector<uint8_t> flags_;
+};
+
+/// The records of one block of a request record file, with only the columns
+/// needed to compare runs.
+struct RequestRecordBlock {
+  double load_level{0.0};
+  double infer_per_sec{0.0};
+  std::vector<uint64_t> latency_ns;
+};
+
+/// Read the blocks of a request record file written by RequestRecordWriter.
+/// \param path The path of the file.
+/// \param blocks Returns the blocks of the file.
+/// \return cb::Error object indicating success or failure.
+cb::Error ReadRequestRecords(
+    const std::string& path, std::vector<RequestRecordBlock>* blocks);
+
+}}  // namespace triton::perfanalyzer
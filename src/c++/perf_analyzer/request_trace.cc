@@ -0,0 +1,228 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "request_trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+bool
+IsBlank(char c)
+{
+  return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+bool
+IsDigit(char c)
+{
+  return (c >= '0') && (c <= '9');
+}
+
+}  // namespace
+
+cb::Error
+RequestTrace::Open(
+    const std::string& path, std::shared_ptr<RequestTrace>* trace)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return cb::Error("failed to open file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+    return cb::Error("failed to stat file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  if (file_stat.st_size == 0) {
+    close(fd);
+    return cb::Error("file '" + path + "' is empty", pa::GENERIC_ERROR);
+  }
+
+  std::shared_ptr<RequestTrace> local_trace(new RequestTrace());
+  local_trace->length_ = file_stat.st_size;
+  void* data =
+      mmap(nullptr, local_trace->length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return cb::Error("failed to map file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  madvise(data, local_trace->length_, MADV_SEQUENTIAL);
+  local_trace->data_ = static_cast<const char*>(data);
+
+  // Validate the whole trace up front so that cursors can assume it is well
+  // formed
+  size_t pos = 0;
+  size_t line = 0;
+  uint64_t last_timestamp_us = 0;
+  while (pos < local_trace->length_) {
+    line++;
+    bool has_record;
+    uint64_t timestamp_us, data_stream_id;
+    if (!local_trace->ParseLine(
+            &pos, &has_record, &timestamp_us, &data_stream_id)) {
+      return cb::Error(
+          "malformed request on line " + std::to_string(line) + " of '" +
+              path + "'",
+          pa::GENERIC_ERROR);
+    }
+    if (!has_record) {
+      continue;
+    }
+    if (local_trace->size_ == 0) {
+      local_trace->first_timestamp_us_ = timestamp_us;
+    } else if (timestamp_us < last_timestamp_us) {
+      return cb::Error(
+          "timestamp on line " + std::to_string(line) + " of '" + path +
+              "' is earlier than the previous one",
+          pa::GENERIC_ERROR);
+    }
+    last_timestamp_us = timestamp_us;
+    local_trace->max_data_stream_id_ =
+        std::max(local_trace->max_data_stream_id_, data_stream_id);
+    local_trace->size_++;
+  }
+
+  const uint64_t span_us = last_timestamp_us - local_trace->first_timestamp_us_;
+  if (span_us == 0) {
+    return cb::Error(
+        "requests in '" + path + "' must span a non-zero amount of time",
+        pa::GENERIC_ERROR);
+  }
+  local_trace->duration_ = std::chrono::microseconds(
+      span_us + span_us / (local_trace->size_ - 1));
+
+  *trace = std::move(local_trace);
+  return cb::Error::Success;
+}
+
+RequestTrace::~RequestTrace()
+{
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), length_);
+  }
+}
+
+double
+RequestTrace::RequestRate() const
+{
+  return (size_ * static_cast<double>(NANOS_PER_SECOND)) / duration_.count();
+}
+
+bool
+RequestTrace::ParseLine(
+    size_t* pos, bool* has_record, uint64_t* timestamp_us,
+    uint64_t* data_stream_id) const
+{
+  size_t i = *pos;
+  size_t end = i;
+  while (end < length_ && data_[end] != '\n') {
+    end++;
+  }
+  *pos = end + 1;
+
+  while (i < end && IsBlank(data_[i])) {
+    i++;
+  }
+  *has_record = (i < end) && (data_[i] != '#');
+  if (!*has_record) {
+    return true;
+  }
+
+  if (!IsDigit(data_[i])) {
+    return false;
+  }
+  *timestamp_us = 0;
+  while (i < end && IsDigit(data_[i])) {
+    *timestamp_us = *timestamp_us * 10 + (data_[i] - '0');
+    i++;
+  }
+
+  *data_stream_id = 0;
+  while (i < end && IsBlank(data_[i])) {
+    i++;
+  }
+  if (i < end && IsDigit(data_[i])) {
+    while (i < end && IsDigit(data_[i])) {
+      *data_stream_id = *data_stream_id * 10 + (data_[i] - '0');
+      i++;
+    }
+    while (i < end && IsBlank(data_[i])) {
+      i++;
+    }
+  }
+  return i == end;
+}
+
+RequestTrace::Cursor::Cursor(
+    std::shared_ptr<RequestTrace> trace, size_t first, size_t stride)
+    : trace_(trace), stride_(stride)
+{
+  for (size_t i = 0; i < first; i++) {
+    ReadRecord();
+  }
+}
+
+RequestTraceRecord
+RequestTrace::Cursor::Next()
+{
+  RequestTraceRecord record = ReadRecord();
+  for (size_t i = 1; i < stride_; i++) {
+    ReadRecord();
+  }
+  return record;
+}
+
+RequestTraceRecord
+RequestTrace::Cursor::ReadRecord()
+{
+  bool has_record = false;
+  uint64_t timestamp_us = 0;
+  RequestTraceRecord record;
+  while (!has_record) {
+    if (pos_ >= trace_->length_) {
+      pos_ = 0;
+      rounds_++;
+    }
+    trace_->ParseLine(
+        &pos_, &has_record, &timestamp_us, &record.data_stream_id_);
+  }
+  record.timestamp_ =
+      std::chrono::microseconds(timestamp_us - trace_->first_timestamp_us_) +
+      trace_->duration_ * rounds_;
+  return record;
+}
+
+}}  // namespace triton::perfanalyzer
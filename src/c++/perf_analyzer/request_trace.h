@@ -0,0 +1,117 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// One request of a request trace.
+struct RequestTraceRecord {
+  // When to send the request, relative to the first request of the trace
+  std::chrono::nanoseconds timestamp_{0};
+  // The input data stream to send it with
+  uint64_t data_stream_id_{0};
+};
+
+/// A timestamped request log that is replayed as the request schedule.
+///
+/// Each line of the file holds the time the request was received, in
+/// microseconds, optionally followed by whitespace and the id of the input
+/// data stream to send. Empty lines and lines starting with '#' are ignored,
+/// and timestamps must not decrease. The file is memory mapped and parsed on
+/// demand by cursors, so traces larger than memory can be replayed. The trace
+/// loops when it runs out, after a pause equal to the mean gap between its
+/// requests.
+///
+class RequestTrace {
+ public:
+  /// Reads every stride-th request of a trace, looping forever.
+  class Cursor {
+   public:
+    /// \param trace The trace to read.
+    /// \param first The index of the first request to return.
+    /// \param stride The distance between successive requests returned.
+    Cursor(std::shared_ptr<RequestTrace> trace, size_t first, size_t stride);
+
+    /// \return The next request. Timestamps keep increasing across loops.
+    RequestTraceRecord Next();
+
+   private:
+    // Read the next record in the file, looping at its end
+    RequestTraceRecord ReadRecord();
+
+    std::shared_ptr<RequestTrace> trace_;
+    size_t stride_;
+    size_t pos_{0};
+    uint64_t rounds_{0};
+  };
+
+  /// Map and validate a request trace.
+  /// \param path The path of the trace file.
+  /// \param trace Returns the trace.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Open(
+      const std::string& path, std::shared_ptr<RequestTrace>* trace);
+
+  ~RequestTrace();
+
+  /// \return The number of requests in the trace.
+  size_t Size() const { return size_; }
+
+  /// \return The time after which the trace loops.
+  std::chrono::nanoseconds Duration() const { return duration_; }
+
+  /// \return The largest input data stream id in the trace.
+  uint64_t MaxDataStreamId() const { return max_data_stream_id_; }
+
+  /// \return The mean request rate of the trace, in requests per second.
+  double RequestRate() const;
+
+ private:
+  RequestTrace() = default;
+
+  // Parse the line starting at *pos and advance *pos to the next line.
+  // Returns false if the line is malformed. *has_record is set to whether
+  // the line holds a request.
+  bool ParseLine(
+      size_t* pos, bool* has_record, uint64_t* timestamp_us,
+      uint64_t* data_stream_id) const;
+
+  const char* data_{nullptr};
+  size_t length_{0};
+
+  size_t size_{0};
+  uint64_t first_timestamp_us_{0};
+  std::chrono::nanoseconds duration_{0};
+  uint64_t max_data_stream_id_{0};
+};
+
+}}  // namespace triton::perfanalyzer
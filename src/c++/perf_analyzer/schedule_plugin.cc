@@ -0,0 +1,132 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "schedule_plugin.h"
+
+#include <dlfcn.h>
+
+#include <algorithm>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Looks up a function of the plugin
+template <typename T>
+cb::Error
+GetFunction(
+    void* handle, const std::string& path, const char* name, T* function)
+{
+  dlerror();
+  void* symbol = dlsym(handle, name);
+  const char* error = dlerror();
+  if ((error != nullptr) || (symbol == nullptr)) {
+    return cb::Error(
+        "schedule plugin '" + path + "' does not export " + name,
+        pa::GENERIC_ERROR);
+  }
+  *function = reinterpret_cast<T>(symbol);
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+SchedulePlugin::Schedule::Schedule(
+    std::shared_ptr<const SchedulePlugin> plugin, void* schedule,
+    uint64_t data_stream_count)
+    : plugin_(plugin), schedule_(schedule),
+      data_stream_count_(std::max<uint64_t>(data_stream_count, 1))
+{
+}
+
+SchedulePlugin::Schedule::~Schedule()
+{
+  plugin_->delete_(schedule_);
+}
+
+cb::Error
+SchedulePlugin::Load(
+    const std::string& path, const std::string& config,
+    std::shared_ptr<SchedulePlugin>* plugin)
+{
+  std::shared_ptr<SchedulePlugin> loaded(new SchedulePlugin());
+  loaded->path_ = path;
+  loaded->config_ = config;
+  loaded->handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (loaded->handle_ == nullptr) {
+    return cb::Error(
+        "unable to load schedule plugin '" + path + "': " + dlerror(),
+        pa::GENERIC_ERROR);
+  }
+
+  decltype(&PA_SchedulePluginApiVersion) version = nullptr;
+  RETURN_IF_ERROR(GetFunction(
+      loaded->handle_, path, "PA_SchedulePluginApiVersion", &version));
+  if (version() != PA_SCHEDULE_PLUGIN_API_VERSION) {
+    return cb::Error(
+        "schedule plugin '" + path + "' implements version " +
+            std::to_string(version()) + " of the interface, expected " +
+            std::to_string(PA_SCHEDULE_PLUGIN_API_VERSION),
+        pa::GENERIC_ERROR);
+  }
+  RETURN_IF_ERROR(GetFunction(
+      loaded->handle_, path, "PA_ScheduleCreate", &loaded->create_));
+  RETURN_IF_ERROR(
+      GetFunction(loaded->handle_, path, "PA_ScheduleNext", &loaded->next_));
+  RETURN_IF_ERROR(GetFunction(
+      loaded->handle_, path, "PA_ScheduleDelete", &loaded->delete_));
+
+  *plugin = std::move(loaded);
+  return cb::Error::Success;
+}
+
+SchedulePlugin::~SchedulePlugin()
+{
+  if (handle_ != nullptr) {
+    dlclose(handle_);
+  }
+}
+
+cb::Error
+SchedulePlugin::CreateSchedule(
+    double request_rate, uint32_t index, uint32_t count,
+    uint64_t data_stream_count, std::shared_ptr<Schedule>* schedule) const
+{
+  void* created = nullptr;
+  const char* error =
+      create_(config_.c_str(), request_rate, index, count, &created);
+  if (error != nullptr) {
+    return cb::Error(
+        "schedule plugin '" + path_ + "' failed to create a schedule: " +
+            error,
+        pa::GENERIC_ERROR);
+  }
+  *schedule = std::make_shared<Schedule>(
+      shared_from_this(), created, data_stream_count);
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
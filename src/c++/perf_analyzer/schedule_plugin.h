@@ -0,0 +1,98 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "perf_utils.h"
+#include "schedule_plugin_api.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A load schedule plugin: a shared library that generates the timestamps
+/// and the input data streams of the requests, see schedule_plugin_api.h.
+///
+class SchedulePlugin : public std::enable_shared_from_this<SchedulePlugin> {
+ public:
+  /// A schedule made by the plugin. It keeps the plugin loaded.
+  class Schedule {
+   public:
+    Schedule(
+        std::shared_ptr<const SchedulePlugin> plugin, void* schedule,
+        uint64_t data_stream_count);
+    ~Schedule();
+
+    /// \return The next request, with its data stream within the input data.
+    PA_ScheduleRequest Next()
+    {
+      PA_ScheduleRequest request{0, 0};
+      plugin_->next_(schedule_, &request);
+      request.data_stream_id %= data_stream_count_;
+      return request;
+    }
+
+   private:
+    std::shared_ptr<const SchedulePlugin> plugin_;
+    void* schedule_;
+    uint64_t data_stream_count_;
+  };
+
+  /// Loads a plugin and checks the version of its interface.
+  /// \param path The path of the shared library.
+  /// \param config The configuration passed to each schedule made.
+  /// \param plugin Returns the plugin.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Load(
+      const std::string& path, const std::string& config,
+      std::shared_ptr<SchedulePlugin>* plugin);
+
+  ~SchedulePlugin();
+
+  /// Makes a schedule for a request rate.
+  /// \param request_rate The request rate of all the schedules together.
+  /// \param index The index of the schedule.
+  /// \param count The number of schedules the request rate is spread over.
+  /// \param data_stream_count The number of streams of the input data.
+  /// \param schedule Returns the schedule.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error CreateSchedule(
+      double request_rate, uint32_t index, uint32_t count,
+      uint64_t data_stream_count, std::shared_ptr<Schedule>* schedule) const;
+
+ private:
+  SchedulePlugin() = default;
+
+  std::string path_;
+  std::string config_;
+  void* handle_{nullptr};
+  decltype(&PA_ScheduleCreate) create_{nullptr};
+  decltype(&PA_ScheduleNext) next_{nullptr};
+  decltype(&PA_ScheduleDelete) delete_{nullptr};
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,85 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+// The C interface of the load schedule plugins of perf_analyzer, see
+// --schedule-plugin. A plugin is a shared library that exports the functions
+// below. It makes one schedule per worker thread (or per dispatcher thread)
+// each time the request rate changes, and each schedule is read lazily, one
+// request at a time, by the thread that sends the requests.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The version of this interface, which PA_SchedulePluginApiVersion() must
+/// return for the plugin to be loaded.
+#define PA_SCHEDULE_PLUGIN_API_VERSION 1
+
+/// A request of a schedule.
+typedef struct PA_ScheduleRequest {
+  /// When to send the request, in nanoseconds since the start of the
+  /// schedule. Must not decrease from one request to the next.
+  uint64_t timestamp_ns;
+  /// The input data stream of the request, taken modulo the number of
+  /// streams of the input data.
+  uint64_t data_stream_id;
+} PA_ScheduleRequest;
+
+/// \return PA_SCHEDULE_PLUGIN_API_VERSION.
+uint32_t PA_SchedulePluginApiVersion(void);
+
+/// Creates a schedule. Called from the thread driving the load; the
+/// schedules are then read concurrently, each by one thread.
+/// \param config The string given to --schedule-plugin-config, empty if
+/// none.
+/// \param request_rate The request rate of all the schedules together, in
+/// requests per second.
+/// \param schedule_index The index of the schedule, from 0.
+/// \param schedule_count The number of schedules that the request rate is
+/// spread over.
+/// \param schedule Returns the schedule.
+/// \return NULL on success, otherwise an error message that stays valid
+/// while the plugin is loaded.
+const char* PA_ScheduleCreate(
+    const char* config, double request_rate, uint32_t schedule_index,
+    uint32_t schedule_count, void** schedule);
+
+/// Returns the next request of a schedule. Called on the thread that sends
+/// the request, just before it waits for its timestamp.
+/// \param schedule The schedule.
+/// \param request Returns the next request.
+void PA_ScheduleNext(void* schedule, PA_ScheduleRequest* request);
+
+/// Deletes a schedule. May be called from any thread.
+/// \param schedule The schedule.
+void PA_ScheduleDelete(void* schedule);
+
+#ifdef __cplusplus
+}
+#endif
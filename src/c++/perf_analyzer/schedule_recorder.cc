@@ -0,0 +1,190 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "schedule_recorder.h"
+
+#include <algorithm>
+#include <fstream>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+constexpr char kMagic[] = "PASCHED1";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+
+constexpr uint8_t kSequenceStartFlag = 1;
+constexpr uint8_t kSequenceEndFlag = 2;
+
+void
+WriteVarint(std::ostream& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+bool
+ReadVarint(std::istream& in, uint64_t* value)
+{
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const int c = in.get();
+    if (c == std::char_traits<char>::eof()) {
+      return false;
+    }
+    *value |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if ((c & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void
+ScheduleRecorder::Record(const ScheduleRecord& record)
+{
+  Shard& shard = shards_[record.worker_ % kShards];
+  std::lock_guard<std::mutex> lock(shard.mu_);
+  shard.records_.push_back(record);
+}
+
+std::vector<ScheduleRecord>
+ScheduleRecorder::Records() const
+{
+  std::vector<ScheduleRecord> records;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mu_);
+    records.insert(
+        records.end(), shard.records_.begin(), shard.records_.end());
+  }
+  std::stable_sort(
+      records.begin(), records.end(),
+      [](const ScheduleRecord& a, const ScheduleRecord& b) {
+        return a.timestamp_ < b.timestamp_;
+      });
+  return records;
+}
+
+void
+ScheduleRecorder::Write(std::ostream& out) const
+{
+  const std::vector<ScheduleRecord> records = Records();
+  out.write(kMagic, kMagicSize);
+  WriteVarint(out, records.size());
+  std::chrono::nanoseconds previous =
+      records.empty() ? std::chrono::nanoseconds(0) : records[0].timestamp_;
+  for (const auto& record : records) {
+    WriteVarint(out, (record.timestamp_ - previous).count());
+    previous = record.timestamp_;
+    WriteVarint(out, record.worker_);
+    WriteVarint(out, record.data_stream_id_);
+    WriteVarint(out, record.data_step_id_);
+    WriteVarint(out, record.sequence_id_);
+    out.put(static_cast<char>(
+        (record.sequence_start_ ? kSequenceStartFlag : 0) |
+        (record.sequence_end_ ? kSequenceEndFlag : 0)));
+  }
+}
+
+cb::Error
+ScheduleRecorder::Write(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return cb::Error(
+        "failed to open schedule file " + path, pa::GENERIC_ERROR);
+  }
+  Write(file);
+  if (!file.good()) {
+    return cb::Error(
+        "failed to write to schedule file " + path, pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ScheduleRecorder::Read(std::istream& in, std::vector<ScheduleRecord>* records)
+{
+  char magic[kMagicSize];
+  if (!in.read(magic, kMagicSize) ||
+      !std::equal(magic, magic + kMagicSize, kMagic)) {
+    return cb::Error("not a schedule file", pa::GENERIC_ERROR);
+  }
+  uint64_t count;
+  if (!ReadVarint(in, &count)) {
+    return cb::Error("truncated schedule file", pa::GENERIC_ERROR);
+  }
+
+  records->clear();
+  std::chrono::nanoseconds timestamp(0);
+  for (uint64_t i = 0; i < count; i++) {
+    ScheduleRecord record;
+    uint64_t gap_ns, worker;
+    const bool complete = ReadVarint(in, &gap_ns) &&
+                          ReadVarint(in, &worker) &&
+                          ReadVarint(in, &record.data_stream_id_) &&
+                          ReadVarint(in, &record.data_step_id_) &&
+                          ReadVarint(in, &record.sequence_id_);
+    const int flags = in.get();
+    if (!complete || (flags == std::char_traits<char>::eof())) {
+      return cb::Error(
+          "truncated schedule file, read " + std::to_string(i) + " of " +
+              std::to_string(count) + " requests",
+          pa::GENERIC_ERROR);
+    }
+    timestamp += std::chrono::nanoseconds(gap_ns);
+    record.timestamp_ = timestamp;
+    record.worker_ = static_cast<uint32_t>(worker);
+    record.sequence_start_ = (flags & kSequenceStartFlag) != 0;
+    record.sequence_end_ = (flags & kSequenceEndFlag) != 0;
+    records->push_back(record);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+ScheduleRecorder::Read(
+    const std::string& path, std::vector<ScheduleRecord>* records)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return cb::Error("failed to open file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  cb::Error err = Read(file, records);
+  if (!err.IsOk()) {
+    return cb::Error(
+        "'" + path + "': " + err.Message(), pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
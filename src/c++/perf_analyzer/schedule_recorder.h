@@ -0,0 +1,106 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// One request of a recorded schedule.
+struct ScheduleRecord {
+  // When the request was scheduled to be sent. Relative to the first request
+  // in a schedule file, on the steady clock while recording.
+  std::chrono::nanoseconds timestamp_{0};
+  // The index of the worker thread that sent the request
+  uint32_t worker_{0};
+  // The input data the request was sent with
+  uint64_t data_stream_id_{0};
+  uint64_t data_step_id_{0};
+  // The sequence the request belongs to, 0 for models without sequences
+  uint64_t sequence_id_{0};
+  bool sequence_start_{false};
+  bool sequence_end_{false};
+};
+
+//==============================================================================
+/// ScheduleRecorder keeps every request that was sent on a schedule, so that
+/// a run can be replayed with exactly the same traffic, for example to
+/// compare two builds of a server.
+///
+/// The records are spread over shards by worker so that the worker threads
+/// rarely contend for a lock. They are written sorted by time in a compact
+/// binary format: the magic "PASCHED1", the number of records and then each
+/// record as LEB128 varints of the gap to the previous record in
+/// nanoseconds, the worker, the data stream, the data step and the sequence
+/// id, followed by a byte of sequence start (1) and end (2) flags.
+///
+class ScheduleRecorder {
+ public:
+  void Record(const ScheduleRecord& record);
+
+  /// \return The records kept, sorted by time. The timestamps are left as
+  /// they were recorded.
+  std::vector<ScheduleRecord> Records() const;
+
+  /// Writes the records kept, relative to the first one.
+  void Write(std::ostream& out) const;
+
+  /// \param path The path of the file to write the schedule to.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Write(const std::string& path) const;
+
+  /// Reads a schedule written by Write().
+  /// \param in The stream to read from.
+  /// \param records Returns the records, sorted by time.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Read(std::istream& in, std::vector<ScheduleRecord>* records);
+
+  /// \param path The path of the schedule file.
+  /// \param records Returns the records, sorted by time.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Read(
+      const std::string& path, std::vector<ScheduleRecord>* records);
+
+ private:
+  static constexpr size_t kShards = 64;
+
+  struct Shard {
+    mutable std::mutex mu_;
+    std::vector<ScheduleRecord> records_;
+  };
+
+  std::array<Shard, kShards> shards_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,152 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "schedule_recorder.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// A request that a dispatcher has released for sending.
+struct SendEvent {
+  // When the request was supposed to be sent
+  std::chrono::steady_clock::time_point scheduled_time_;
+  // Whether the dispatcher itself was already late for this request
+  bool delayed_{false};
+  // The input data stream to send the request with
+  uint64_t data_stream_id_{0};
+  // Whether the request is replayed from record_
+  bool replayed_{false};
+  ScheduleRecord record_;
+};
+
+/// Bounded lock-free queue of SendEvents shared between the dispatcher
+/// threads that follow the request schedule and the worker threads that
+/// send the requests.
+///
+/// Any number of threads may push and pop concurrently. Each slot carries a
+/// sequence number that tells producers and consumers whether it is free or
+/// filled for their lap around the ring, so neither side ever blocks.
+///
+class SendEventQueue {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 14;
+
+  /// \param capacity The number of events that can be queued. Rounded up to
+  /// a power of 2.
+  explicit SendEventQueue(size_t capacity = DEFAULT_CAPACITY)
+  {
+    capacity_ = 2;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    mask_ = capacity_ - 1;
+    slots_.reset(new Slot[capacity_]);
+    for (size_t i = 0; i < capacity_; i++) {
+      slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Add an event to the queue.
+  /// \return False if the queue is full.
+  bool TryPush(const SendEvent& event)
+  {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          slot.event_ = event;
+          slot.sequence_.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Take the oldest event from the queue.
+  /// \return False if the queue is empty.
+  bool TryPop(SendEvent* event)
+  {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          *event = slot.event_;
+          slot.sequence_.store(pos + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Discard all queued events.
+  void Clear()
+  {
+    SendEvent event;
+    while (TryPop(&event)) {
+    }
+  }
+
+  /// \return The number of events the queue can hold.
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence_;
+    SendEvent event_;
+  };
+
+  size_t capacity_;
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}}  // namespace triton::perfanalyzer
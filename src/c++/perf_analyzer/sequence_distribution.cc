@@ -0,0 +1,251 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "sequence_distribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+cb::Error
+ParseSetting(const std::string& value, double* result)
+{
+  size_t parsed_chars = 0;
+  try {
+    *result = std::stod(value, &parsed_chars);
+  }
+  catch (const std::exception&) {
+    parsed_chars = 0;
+  }
+  if ((parsed_chars == 0) || (parsed_chars != value.size()) ||
+      !(*result > 0)) {
+    return cb::Error(
+        "'" + value + "' is not a positive number", pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+LoadHistogram(
+    const std::string& path, std::vector<double>* values,
+    std::vector<double>* weights)
+{
+  std::ifstream file(path);
+  if (!file) {
+    return cb::Error(
+        "failed to open histogram file '" + path + "'", pa::GENERIC_ERROR);
+  }
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    line_number++;
+    line = line.substr(0, line.find('#'));
+    std::stringstream line_stream(line);
+    double value, weight;
+    if (!(line_stream >> value)) {
+      // Blank or comment line
+      continue;
+    }
+    std::string rest;
+    if (!(line_stream >> weight) || (line_stream >> rest) || !(value > 0) ||
+        (weight < 0)) {
+      return cb::Error(
+          "invalid histogram entry at " + path + ":" +
+              std::to_string(line_number) +
+              ", expected '<positive value> <weight>'",
+          pa::GENERIC_ERROR);
+    }
+    values->push_back(value);
+    weights->push_back(weight);
+  }
+  double total_weight = 0;
+  for (const double weight : *weights) {
+    total_weight += weight;
+  }
+  if (!(total_weight > 0)) {
+    return cb::Error(
+        "histogram file '" + path + "' has no entry with a positive weight",
+        pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+cb::Error
+ParseSequenceDistribution(
+    const std::string& spec, SequenceDistributionSettings* settings)
+{
+  SequenceDistributionSettings parsed;
+  const size_t settings_start = spec.find(':');
+  const std::string name = spec.substr(0, settings_start);
+  if (name == "uniform") {
+    parsed.kind = SequenceDistributionSettings::UNIFORM;
+  } else if (name == "constant") {
+    parsed.kind = SequenceDistributionSettings::CONSTANT;
+  } else if (name == "exponential") {
+    parsed.kind = SequenceDistributionSettings::EXPONENTIAL;
+  } else if (name == "lognormal") {
+    parsed.kind = SequenceDistributionSettings::LOGNORMAL;
+  } else if (name == "histogram") {
+    parsed.kind = SequenceDistributionSettings::HISTOGRAM;
+  } else {
+    return cb::Error(
+        "unsupported distribution '" + name + "'", pa::GENERIC_ERROR);
+  }
+
+  if (settings_start != std::string::npos) {
+    std::stringstream settings_stream(spec.substr(settings_start + 1));
+    std::string setting;
+    while (std::getline(settings_stream, setting, ',')) {
+      const size_t separator = setting.find('=');
+      const std::string key = setting.substr(0, separator);
+      const std::string value =
+          (separator == std::string::npos) ? "" : setting.substr(separator + 1);
+      cb::Error err = cb::Error::Success;
+      if ((key == "mean") &&
+          (parsed.kind != SequenceDistributionSettings::UNIFORM) &&
+          (parsed.kind != SequenceDistributionSettings::HISTOGRAM)) {
+        err = ParseSetting(value, &parsed.mean);
+      } else if (
+          (key == "sigma") &&
+          (parsed.kind == SequenceDistributionSettings::LOGNORMAL)) {
+        err = ParseSetting(value, &parsed.sigma);
+      } else if (
+          (key == "file") &&
+          (parsed.kind == SequenceDistributionSettings::HISTOGRAM) &&
+          !value.empty()) {
+        parsed.file = value;
+      } else {
+        return cb::Error(
+            "unsupported setting '" + setting + "' for distribution " + name,
+            pa::GENERIC_ERROR);
+      }
+      if (!err.IsOk()) {
+        return cb::Error(
+            "invalid setting '" + setting + "' for distribution " + name +
+                ": " + err.Message(),
+            pa::GENERIC_ERROR);
+      }
+    }
+  }
+
+  if ((parsed.kind == SequenceDistributionSettings::HISTOGRAM) &&
+      parsed.file.empty()) {
+    return cb::Error(
+        "distribution histogram needs a file setting", pa::GENERIC_ERROR);
+  }
+
+  *settings = parsed;
+  return cb::Error::Success;
+}
+
+double
+ExponentialSequenceDistribution::Draw(std::mt19937& rng) const
+{
+  return std::exponential_distribution<double>(1.0 / mean_)(rng);
+}
+
+LognormalSequenceDistribution::LognormalSequenceDistribution(
+    double mean, double sigma)
+    : mu_(std::log(mean) - sigma * sigma / 2), sigma_(sigma)
+{
+}
+
+double
+LognormalSequenceDistribution::Draw(std::mt19937& rng) const
+{
+  // A new distribution each time, the standard one caches state
+  return std::lognormal_distribution<double>(mu_, sigma_)(rng);
+}
+
+HistogramSequenceDistribution::HistogramSequenceDistribution(
+    const std::vector<double>& values, const std::vector<double>& weights)
+    : values_(values)
+{
+  double total_weight = 0;
+  for (const double weight : weights) {
+    total_weight += weight;
+  }
+  double cumulative_weight = 0;
+  for (const double weight : weights) {
+    cumulative_weight += weight;
+    cumulative_shares_.push_back(cumulative_weight / total_weight);
+  }
+  cumulative_shares_.back() = 1;
+}
+
+double
+HistogramSequenceDistribution::Draw(std::mt19937& rng) const
+{
+  const double draw = std::uniform_real_distribution<double>(0, 1)(rng);
+  // Entries of zero weight have an empty share and are never picked
+  const size_t index =
+      std::upper_bound(
+          cumulative_shares_.begin(), cumulative_shares_.end(), draw) -
+      cumulative_shares_.begin();
+  return values_[std::min(index, values_.size() - 1)];
+}
+
+cb::Error
+MakeSequenceDistribution(
+    const SequenceDistributionSettings& settings, const double default_mean,
+    std::shared_ptr<SequenceDistribution>* distribution)
+{
+  const double mean = (settings.mean > 0) ? settings.mean : default_mean;
+  if (settings.kind == SequenceDistributionSettings::UNIFORM) {
+    distribution->reset();
+    return cb::Error::Success;
+  }
+  if (settings.kind == SequenceDistributionSettings::HISTOGRAM) {
+    std::vector<double> values;
+    std::vector<double> weights;
+    RETURN_IF_ERROR(LoadHistogram(settings.file, &values, &weights));
+    *distribution =
+        std::make_shared<HistogramSequenceDistribution>(values, weights);
+    return cb::Error::Success;
+  }
+  if (!(mean > 0)) {
+    return cb::Error(
+        "the distribution needs a positive mean setting", pa::GENERIC_ERROR);
+  }
+  if (settings.kind == SequenceDistributionSettings::CONSTANT) {
+    *distribution = std::make_shared<ConstantSequenceDistribution>(mean);
+  } else if (settings.kind == SequenceDistributionSettings::EXPONENTIAL) {
+    *distribution = std::make_shared<ExponentialSequenceDistribution>(mean);
+  } else {
+    *distribution =
+        std::make_shared<LognormalSequenceDistribution>(mean, settings.sigma);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
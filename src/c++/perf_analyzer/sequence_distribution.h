@@ -0,0 +1,123 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Describes a distribution of sequence lengths or of think times, as given
+/// on the command line in the format "<kind>[:<setting>=<value>,...]".
+struct SequenceDistributionSettings {
+  enum Kind { UNIFORM, CONSTANT, EXPONENTIAL, LOGNORMAL, HISTOGRAM };
+  Kind kind{UNIFORM};
+  // The mean of the distribution, 0 if not given. Sequence lengths default to
+  // --sequence-length.
+  double mean{0};
+  // The standard deviation of the logarithm of lognormal values
+  double sigma{0.5};
+  // HISTOGRAM: file with one "<value> <weight>" pair per line
+  std::string file;
+};
+
+/// Parses a distribution in the format "<kind>[:<setting>=<value>,...]",
+/// such as "lognormal:mean=20,sigma=1" or "histogram:file=lengths.txt".
+/// \param spec The distribution to parse.
+/// \param settings Returns the parsed distribution.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseSequenceDistribution(
+    const std::string& spec, SequenceDistributionSettings* settings);
+
+/// Draws positive values, such as the lengths of sequences or the think times
+/// between their steps. Draw() is safe to call from several threads with
+/// their own generators.
+class SequenceDistribution {
+ public:
+  virtual ~SequenceDistribution() = default;
+  virtual double Draw(std::mt19937& rng) const = 0;
+};
+
+class ConstantSequenceDistribution : public SequenceDistribution {
+ public:
+  explicit ConstantSequenceDistribution(double value) : value_(value) {}
+  double Draw(std::mt19937& rng) const override { return value_; }
+
+ private:
+  double value_;
+};
+
+class ExponentialSequenceDistribution : public SequenceDistribution {
+ public:
+  explicit ExponentialSequenceDistribution(double mean) : mean_(mean) {}
+  double Draw(std::mt19937& rng) const override;
+
+ private:
+  double mean_;
+};
+
+/// Lognormal values with the given mean, most of them below it and a long
+/// tail above.
+class LognormalSequenceDistribution : public SequenceDistribution {
+ public:
+  LognormalSequenceDistribution(double mean, double sigma);
+  double Draw(std::mt19937& rng) const override;
+
+ private:
+  double mu_;
+  double sigma_;
+};
+
+/// The values of an empirical histogram, each drawn with a probability
+/// proportional to its weight.
+class HistogramSequenceDistribution : public SequenceDistribution {
+ public:
+  HistogramSequenceDistribution(
+      const std::vector<double>& values, const std::vector<double>& weights);
+  double Draw(std::mt19937& rng) const override;
+
+ private:
+  std::vector<double> values_;
+  // The end of the share of each value, the last one is 1
+  std::vector<double> cumulative_shares_;
+};
+
+/// Creates the distribution that the settings describe. Uniform
+/// distributions have no object of their own.
+/// \param settings The distribution to create.
+/// \param default_mean The mean if the settings do not give one, 0 if there
+/// is none.
+/// \param distribution Returns the distribution, nullptr for uniform ones.
+/// \return cb::Error object indicating success or failure.
+cb::Error MakeSequenceDistribution(
+    const SequenceDistributionSettings& settings, const double default_mean,
+    std::shared_ptr<SequenceDistribution>* distribution);
+
+}}  // namespace triton::perfanalyzer
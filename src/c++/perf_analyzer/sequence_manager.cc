@@ -26,6 +26,8 @@
 
 #include "sequence_manager.h"
 
+#include <cmath>
+
 namespace triton { namespace perfanalyzer {
 
 SequenceManager::SequenceManager(
@@ -47,10 +49,20 @@ void
 SequenceManager::InitSequenceStatuses(size_t num_sequence_statuses)
 {
   sequence_statuses_.clear();
+  // The statuses point into a single block rather than being scattered over
+  // the heap
+  std::shared_ptr<SequenceStatus> block(
+      new SequenceStatus[num_sequence_statuses],
+      std::default_delete<SequenceStatus[]>());
   for (size_t sequence_status_index{0};
        sequence_status_index < num_sequence_statuses; sequence_status_index++) {
-    sequence_statuses_.push_back(std::make_shared<SequenceStatus>());
+    sequence_statuses_.emplace_back(
+        block, block.get() + sequence_status_index);
   }
+
+  sequence_id_ranges_ = (sequence_id_range_ >= num_sequence_statuses)
+                            ? num_sequence_statuses
+                            : 0;
 }
 
 std::mutex&
@@ -142,6 +154,15 @@ SequenceManager::InitNewSequence(int seq_stat_index)
 uint64_t
 SequenceManager::GetNextSeqId(int seq_stat_index)
 {
+  if (sequence_id_ranges_ != 0) {
+    // Only the status itself uses the IDs of its range, so none of them can
+    // still be in use
+    SequenceStatus& status = *sequence_statuses_[seq_stat_index];
+    const uint64_t ids_per_range = sequence_id_range_ / sequence_id_ranges_;
+    return start_sequence_id_ + seq_stat_index +
+           (status.started_sequences_++ % ids_per_range) * sequence_id_ranges_;
+  }
+
   uint64_t old_seq_id = sequence_statuses_[seq_stat_index]->seq_id_;
   uint64_t next_seq_id =
       curr_seq_id_++ % sequence_id_range_ + start_sequence_id_;
@@ -161,6 +182,11 @@ SequenceManager::GetNextSeqId(int seq_stat_index)
 size_t
 SequenceManager::GetRandomSequenceLength(double offset_ratio)
 {
+  if (length_distribution_ != nullptr) {
+    std::lock_guard<std::mutex> lock(length_mutex_);
+    const double length = std::round(length_distribution_->Draw(length_rng_));
+    return (length < 1) ? 1 : static_cast<size_t>(length);
+  }
   int random_offset = ((2.0 * rand() / double(RAND_MAX)) - 1.0) * offset_ratio /
                       100.0 * sequence_length_;
   if (int(sequence_length_) + random_offset <= 0) {
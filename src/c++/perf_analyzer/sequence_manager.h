@@ -28,11 +28,13 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <vector>
 
 #include "client_backend/client_backend.h"
 #include "data_loader.h"
+#include "sequence_distribution.h"
 #include "sequence_status.h"
 
 namespace triton { namespace perfanalyzer {
@@ -62,12 +64,34 @@ class SequenceManager {
       const double sequence_length_variation, const bool using_json_data,
       std::shared_ptr<DataLoader> data_loader);
 
-  /// Initializes the sequence statuses data structure.
+  /// Initializes the sequence statuses data structure. The statuses are
+  /// allocated in one block, and each of them gets a range of sequence IDs of
+  /// its own when the sequence ID range is large enough.
   /// \param num_sequence_statuses The number of sequence status objects to
   /// create.
   ///
   void InitSequenceStatuses(size_t num_sequence_statuses);
 
+  /// Draws the lengths of new sequences from the given distribution, instead
+  /// of varying them uniformly around the sequence length.
+  /// \param distribution The distribution of the sequence lengths.
+  ///
+  void SetLengthDistribution(
+      std::shared_ptr<const SequenceDistribution> distribution)
+  {
+    length_distribution_ = distribution;
+  }
+
+  /// Seeds the draws of the sequence lengths and data streams, so that the
+  /// sequence managers of different worker threads draw different ones.
+  /// \param seed The seed of the draws.
+  ///
+  void Seed(uint64_t seed)
+  {
+    rng_generator_.seed(seed);
+    length_rng_.seed(seed);
+  }
+
   /// Gets a non-const reference to the mutex for the specified sequence status
   /// object.
   /// \param sequence_status_index The index of the sequence status object.
@@ -155,6 +179,12 @@ class SequenceManager {
   ///
   std::vector<std::shared_ptr<SequenceStatus>> sequence_statuses_{};
 
+  /// The number of sequence ID ranges, one per sequence status, or 0 if the
+  /// statuses share all the IDs. Status i takes the IDs that are i modulo the
+  /// number of ranges, so it never has to check the IDs of the others.
+  ///
+  size_t sequence_id_ranges_{0};
+
   /// Current sequence id (for issuing new sequences)
   ///
   std::atomic<uint64_t> curr_seq_id_{0};
@@ -201,6 +231,14 @@ class SequenceManager {
   ///
   std::default_random_engine rng_generator_{};
 
+  /// The distribution of the lengths of new sequences, if not uniform, and
+  /// the random number generator drawing from it. Sequences start on any
+  /// thread, hence the mutex.
+  ///
+  std::shared_ptr<const SequenceDistribution> length_distribution_{nullptr};
+  std::mt19937 length_rng_{};
+  std::mutex length_mutex_{};
+
 #ifndef DOCTEST_CONFIG_DISABLE
   friend NaggyMockSequenceManager;
 
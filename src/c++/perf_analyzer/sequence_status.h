@@ -30,8 +30,9 @@
 
 namespace triton { namespace perfanalyzer {
 
-// Holds the status of the inflight sequence
-struct SequenceStatus {
+// Holds the status of the inflight sequence. Each status has cache lines of
+// its own, so the threads driving neighbouring statuses do not contend.
+struct alignas(64) SequenceStatus {
   SequenceStatus(uint64_t seq_id = 0)
       : seq_id_(seq_id), data_stream_id_(0), remaining_queries_(0)
   {
@@ -44,6 +45,9 @@ struct SequenceStatus {
   size_t remaining_queries_;
   // The length of the sequence
   size_t sequence_length_{0};
+  // The number of sequences started, which picks the next ID of the range of
+  // the status
+  uint64_t started_sequences_{0};
   // A lock to protect sequence data
   std::mutex mtx_;
 };
@@ -0,0 +1,130 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "shape_distribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+cb::Error
+ParseBound(const std::string& value, int64_t* result)
+{
+  size_t parsed_chars = 0;
+  try {
+    *result = std::stoll(value, &parsed_chars);
+  }
+  catch (const std::exception&) {
+    parsed_chars = 0;
+  }
+  if ((parsed_chars == 0) || (parsed_chars != value.size()) ||
+      (*result < 0)) {
+    return cb::Error(
+        "'" + value + "' is not a valid dimension", pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}  // namespace
+
+cb::Error
+ParseShapeDistribution(
+    const std::string& spec, ShapeDistributionSettings* settings)
+{
+  // The distribution may hold separators of its own, so only the first four
+  // fields are split off
+  std::vector<std::string> fields;
+  size_t start = 0;
+  while (fields.size() < 4) {
+    const size_t end = spec.find(':', start);
+    fields.push_back(spec.substr(start, end - start));
+    if (end == std::string::npos) {
+      start = std::string::npos;
+      break;
+    }
+    start = end + 1;
+  }
+  if ((fields.size() < 4) || fields[0].empty()) {
+    return cb::Error(
+        "expected '<input name>:<dimension>:<min>:<max>[:<distribution>]', "
+        "got '" +
+            spec + "'",
+        pa::GENERIC_ERROR);
+  }
+
+  ShapeDistributionSettings parsed;
+  parsed.input_name = fields[0];
+  int64_t dimension;
+  RETURN_IF_ERROR(ParseBound(fields[1], &dimension));
+  parsed.dimension = dimension;
+  RETURN_IF_ERROR(ParseBound(fields[2], &parsed.min));
+  RETURN_IF_ERROR(ParseBound(fields[3], &parsed.max));
+  if ((parsed.min < 1) || (parsed.max < parsed.min)) {
+    return cb::Error(
+        "the bounds of '" + spec + "' must satisfy 1 <= min <= max",
+        pa::GENERIC_ERROR);
+  }
+  if (start != std::string::npos) {
+    RETURN_IF_ERROR(
+        ParseSequenceDistribution(spec.substr(start), &parsed.distribution));
+  }
+
+  *settings = parsed;
+  return cb::Error::Success;
+}
+
+cb::Error
+ShapeDistribution::Create(
+    const ShapeDistributionSettings& settings,
+    std::shared_ptr<ShapeDistribution>* distribution)
+{
+  std::shared_ptr<ShapeDistribution> local(new ShapeDistribution(settings));
+  RETURN_IF_ERROR(MakeSequenceDistribution(
+      settings.distribution, (settings.min + settings.max) / 2.0,
+      &local->values_));
+  *distribution = std::move(local);
+  return cb::Error::Success;
+}
+
+int64_t
+ShapeDistribution::Draw(std::mt19937& rng) const
+{
+  if (values_ == nullptr) {
+    return std::uniform_int_distribution<int64_t>(
+        settings_.min, settings_.max)(rng);
+  }
+  // Clamped before rounding, as the tail of some distributions is unbounded
+  const double value = std::min(
+      std::max(values_->Draw(rng), (double)settings_.min),
+      (double)settings_.max);
+  return std::llround(value);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,89 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include "perf_utils.h"
+#include "sequence_distribution.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Describes the distribution of one dimension of the shape of a generated
+/// input, as given on the command line in the format
+/// "<input name>:<dimension>:<min>:<max>[:<distribution>]", such as
+/// "INPUT_IDS:1:16:512:lognormal:mean=128".
+struct ShapeDistributionSettings {
+  std::string input_name;
+  // The index of the dimension in the shape of the input, without the batch
+  // dimension
+  size_t dimension{0};
+  int64_t min{1};
+  int64_t max{1};
+  // Drawn values are rounded and clamped to [min, max]. Distributions with
+  // no mean default to the middle of the bounds.
+  SequenceDistributionSettings distribution;
+};
+
+/// Parses a shape distribution, see ShapeDistributionSettings.
+/// \param spec The shape distribution to parse.
+/// \param settings Returns the parsed shape distribution.
+/// \return cb::Error object indicating success or failure.
+cb::Error ParseShapeDistribution(
+    const std::string& spec, ShapeDistributionSettings* settings);
+
+/// Draws the values of one dimension of the shape of an input.
+class ShapeDistribution {
+ public:
+  /// Creates the distribution that the settings describe.
+  /// \param settings The distribution to create.
+  /// \param distribution Returns the distribution.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const ShapeDistributionSettings& settings,
+      std::shared_ptr<ShapeDistribution>* distribution);
+
+  const std::string& InputName() const { return settings_.input_name; }
+
+  size_t Dimension() const { return settings_.dimension; }
+
+  /// \return A value of the dimension, within its bounds.
+  int64_t Draw(std::mt19937& rng) const;
+
+ private:
+  explicit ShapeDistribution(const ShapeDistributionSettings& settings)
+      : settings_(settings)
+  {
+  }
+
+  ShapeDistributionSettings settings_;
+  // Null for uniform distributions
+  std::shared_ptr<SequenceDistribution> values_;
+};
+
+}}  // namespace triton::perfanalyzer
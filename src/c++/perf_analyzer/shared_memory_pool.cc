@@ -0,0 +1,196 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "shared_memory_pool.h"
+
+namespace triton { namespace perfanalyzer {
+
+SharedMemoryPool::SharedMemoryPool(
+    size_t slot_count, StageFunction stage_function)
+    : stage_function_(std::move(stage_function)), slots_(slot_count)
+{
+  stage_thread_ = std::thread(&SharedMemoryPool::StageThread, this);
+}
+
+SharedMemoryPool::~SharedMemoryPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  prefetch_cv_.notify_all();
+  stage_thread_.join();
+}
+
+cb::Error
+SharedMemoryPool::Acquire(int stream_index, int step_index, size_t* slot)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    int found = FindSlot(stream_index, step_index);
+    if (found >= 0) {
+      if (slots_[found].state_ == SlotState::STAGING) {
+        slot_cv_.wait(lock);
+        continue;
+      }
+      slots_[found].users_++;
+      slots_[found].last_used_ = ++clock_;
+      *slot = found;
+      return cb::Error::Success;
+    }
+
+    int victim = FindVictim();
+    if (victim < 0) {
+      slot_cv_.wait(lock);
+      continue;
+    }
+
+    // Fill the slot without holding the lock, so that others can keep
+    // acquiring the slots that are ready
+    Slot& target = slots_[victim];
+    target.stream_index_ = stream_index;
+    target.step_index_ = step_index;
+    target.state_ = SlotState::STAGING;
+    lock.unlock();
+    cb::Error err = stage_function_(victim, stream_index, step_index);
+    lock.lock();
+    if (!err.IsOk()) {
+      target = Slot();
+      slot_cv_.notify_all();
+      return err;
+    }
+    target.state_ = SlotState::READY;
+    target.users_++;
+    target.last_used_ = ++clock_;
+    slot_cv_.notify_all();
+    *slot = victim;
+    return cb::Error::Success;
+  }
+}
+
+void
+SharedMemoryPool::Retain(size_t slot)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  slots_[slot].users_++;
+}
+
+void
+SharedMemoryPool::Release(size_t slot)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_[slot].users_--;
+  }
+  slot_cv_.notify_all();
+}
+
+void
+SharedMemoryPool::Prefetch(int stream_index, int step_index)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FindSlot(stream_index, step_index) >= 0) {
+      return;
+    }
+    // Stale requests are useless, so only keep the latest ones
+    if (prefetch_queue_.size() >= slots_.size()) {
+      prefetch_queue_.pop_front();
+    }
+    prefetch_queue_.emplace_back(stream_index, step_index);
+  }
+  prefetch_cv_.notify_one();
+}
+
+int
+SharedMemoryPool::FindSlot(int stream_index, int step_index) const
+{
+  for (size_t i = 0; i < slots_.size(); i++) {
+    if ((slots_[i].state_ != SlotState::EMPTY) &&
+        (slots_[i].stream_index_ == stream_index) &&
+        (slots_[i].step_index_ == step_index)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int
+SharedMemoryPool::FindVictim() const
+{
+  int victim = -1;
+  for (size_t i = 0; i < slots_.size(); i++) {
+    if ((slots_[i].users_ != 0) ||
+        (slots_[i].state_ == SlotState::STAGING)) {
+      continue;
+    }
+    if ((victim < 0) || (slots_[i].last_used_ < slots_[victim].last_used_)) {
+      victim = i;
+    }
+  }
+  return victim;
+}
+
+void
+SharedMemoryPool::StageThread()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    prefetch_cv_.wait(
+        lock, [this]() { return exiting_ || !prefetch_queue_.empty(); });
+    if (exiting_) {
+      return;
+    }
+
+    const auto step = prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    if (FindSlot(step.first, step.second) >= 0) {
+      continue;
+    }
+    int victim = FindVictim();
+    if (victim < 0) {
+      continue;
+    }
+
+    Slot& target = slots_[victim];
+    target.stream_index_ = step.first;
+    target.step_index_ = step.second;
+    target.state_ = SlotState::STAGING;
+    lock.unlock();
+    cb::Error err = stage_function_(victim, step.first, step.second);
+    lock.lock();
+    // On failure, leave the slot empty so that Acquire() fills it again and
+    // reports the error
+    if (err.IsOk()) {
+      target.state_ = SlotState::READY;
+      target.last_used_ = ++clock_;
+    } else {
+      target = Slot();
+    }
+    slot_cv_.notify_all();
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,128 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+/// Bounded set of slots, each holding the data of one (stream, step) pair.
+///
+/// The caller owns the memory behind the slots and supplies the function
+/// that fills a slot with the data of a step. Acquire() hands out the slot
+/// holding a step, filling the least recently used free slot first if no
+/// slot holds it yet. Prefetch() asks a background thread to fill a slot
+/// with a step ahead of the Acquire() that will want it.
+///
+/// A slot is never refilled while it is acquired, so the number of slots
+/// must be larger than the number of requests that can be in flight at
+/// once, and should be about twice that for the prefetching to stay ahead.
+/// Acquire() blocks until a request gives its slot back otherwise.
+///
+class SharedMemoryPool {
+ public:
+  /// Fills the given slot with the data of the given stream and step.
+  using StageFunction =
+      std::function<cb::Error(size_t slot, int stream_index, int step_index)>;
+
+  /// \param slot_count The number of slots in the pool.
+  /// \param stage_function The function that fills a slot.
+  SharedMemoryPool(size_t slot_count, StageFunction stage_function);
+
+  ~SharedMemoryPool();
+
+  /// Gets the slot holding the given step, filling one if needed. Blocks
+  /// while the step is being filled or while every slot is acquired.
+  /// \param stream_index The data stream of the step.
+  /// \param step_index The step to get.
+  /// \param slot Returns the slot holding the step.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Acquire(int stream_index, int step_index, size_t* slot);
+
+  /// Takes another reference to a slot that is currently acquired, to be
+  /// given back with Release() like the one from Acquire().
+  /// \param slot The slot to reference.
+  void Retain(size_t slot);
+
+  /// Gives back a slot returned by Acquire() or referenced by Retain().
+  /// \param slot The slot to give back.
+  void Release(size_t slot);
+
+  /// Asks for the given step to be filled in the background. Does nothing
+  /// if a slot already holds it. The request is dropped if no slot is free
+  /// by the time the background thread gets to it.
+  /// \param stream_index The data stream of the step.
+  /// \param step_index The step to fill.
+  void Prefetch(int stream_index, int step_index);
+
+  /// \return The number of slots in the pool.
+  size_t SlotCount() const { return slots_.size(); }
+
+ private:
+  enum class SlotState { EMPTY, STAGING, READY };
+
+  struct Slot {
+    int stream_index_{-1};
+    int step_index_{-1};
+    SlotState state_{SlotState::EMPTY};
+    // The number of Acquire() calls not yet released
+    size_t users_{0};
+    // Logical time of the last fill or acquire, for picking the victim
+    uint64_t last_used_{0};
+  };
+
+  /// \return The slot holding or filling the given step, or -1.
+  int FindSlot(int stream_index, int step_index) const;
+
+  /// \return The least recently used slot that is neither acquired nor
+  /// being filled, or -1.
+  int FindVictim() const;
+
+  void StageThread();
+
+  StageFunction stage_function_;
+  std::vector<Slot> slots_;
+  uint64_t clock_{0};
+  std::deque<std::pair<int, int>> prefetch_queue_;
+  bool exiting_{false};
+
+  std::mutex mutex_;
+  // Signalled when a slot is filled or released
+  std::condition_variable slot_cv_;
+  // Signalled when a step is queued for prefetching or on exit
+  std::condition_variable prefetch_cv_;
+  std::thread stage_thread_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,78 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "slow_request_tracker.h"
+
+#include <algorithm>
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+bool
+IsFaster(const SlowRequest& a, const SlowRequest& b)
+{
+  return a.latency_ns > b.latency_ns;
+}
+
+}  // namespace
+
+void
+SlowRequestTracker::Record(SlowRequest&& request)
+{
+  if (!Admits(request.latency_ns)) {
+    return;
+  }
+  if (heap_.size() == capacity_) {
+    std::pop_heap(heap_.begin(), heap_.end(), IsFaster);
+    heap_.pop_back();
+  }
+  heap_.emplace_back(std::move(request));
+  std::push_heap(heap_.begin(), heap_.end(), IsFaster);
+}
+
+void
+SlowRequestTracker::Merge(const SlowRequestTracker& other)
+{
+  capacity_ = std::max(capacity_, other.capacity_);
+  for (const auto& request : other.heap_) {
+    Record(SlowRequest(request));
+  }
+}
+
+std::vector<SlowRequest>
+SlowRequestTracker::Slowest() const
+{
+  std::vector<SlowRequest> requests = heap_;
+  std::sort(
+      requests.begin(), requests.end(),
+      [](const SlowRequest& a, const SlowRequest& b) {
+        return a.latency_ns > b.latency_ns;
+      });
+  return requests;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,109 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace triton { namespace perfanalyzer {
+
+/// A request kept by a SlowRequestTracker, with what identifies it
+struct SlowRequest {
+  // The time from when the request was sent to its last response
+  uint64_t latency_ns{0};
+  // When the request was sent, received its first response and received its
+  // last response, in nanoseconds since the epoch
+  uint64_t send_time_ns{0};
+  uint64_t first_response_time_ns{0};
+  uint64_t end_time_ns{0};
+  // How late the request was sent compared to when its schedule meant to
+  // send it, in nanoseconds, or -1 if it does not follow a schedule
+  int64_t schedule_lag_ns{-1};
+  // The number of responses, more than one only for decoupled models
+  uint32_t response_count{1};
+  // The worker thread and the context of the thread that sent the request
+  size_t worker{0};
+  uint32_t context{0};
+  // The input data stream and step the request was sent with
+  int64_t data_stream_id{0};
+  int64_t data_step_id{0};
+  // The sequence the request belongs to, 0 if the model is not a sequence
+  // model
+  uint64_t sequence_id{0};
+  // The url of the endpoint the request was sent to, empty if the requests
+  // are not spread over endpoints
+  std::string endpoint;
+};
+
+/// Keeps the slowest requests out of all the requests recorded, up to a
+/// fixed number of them, in a min-heap on their latency. A request faster
+/// than all the ones kept is rejected by Admits() before its details are
+/// gathered, so recording costs little once the tracker is full.
+///
+class SlowRequestTracker {
+ public:
+  /// A tracker keeping no request.
+  SlowRequestTracker() = default;
+
+  /// \param capacity The number of requests to keep, 0 to keep none.
+  explicit SlowRequestTracker(size_t capacity) : capacity_(capacity) {}
+
+  size_t Capacity() const { return capacity_; }
+
+  /// \return Whether a request of the given latency would be kept.
+  bool Admits(uint64_t latency_ns) const
+  {
+    return (heap_.size() < capacity_) ||
+           ((capacity_ != 0) && (latency_ns > heap_.front().latency_ns));
+  }
+
+  /// Keep the request if it is among the slowest recorded so far.
+  void Record(SlowRequest&& request);
+
+  /// Keep the slowest of the requests of both trackers, up to the larger of
+  /// the two capacities.
+  void Merge(const SlowRequestTracker& other);
+
+  /// \return The requests kept, slowest first.
+  std::vector<SlowRequest> Slowest() const;
+
+  /// \return The requests kept, in no particular order.
+  const std::vector<SlowRequest>& Requests() const { return heap_; }
+
+  bool Empty() const { return heap_.empty(); }
+
+  /// Drop the requests kept. The capacity is unchanged.
+  void Reset() { heap_.clear(); }
+
+ private:
+  size_t capacity_{0};
+  // Ordered so that the fastest of the requests kept is at the front
+  std::vector<SlowRequest> heap_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,563 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "sweep_checkpoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Each value is written after a space, and read back with operator>>
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+WriteValue(std::ostream& out, const T value)
+{
+  out << ' ' << value;
+}
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+ReadValue(std::istream& in, T& value)
+{
+  in >> value;
+}
+
+void WriteValue(std::ostream& out, const std::string& value);
+void ReadValue(std::istream& in, std::string& value);
+void WriteValue(std::ostream& out, const LatencyHistogram& histogram);
+void ReadValue(std::istream& in, LatencyHistogram& histogram);
+void WriteValue(std::ostream& out, const RequestClassStats& stats);
+void ReadValue(std::istream& in, RequestClassStats& stats);
+void WriteValue(std::ostream& out, const ServerSideStats& stats);
+void ReadValue(std::istream& in, ServerSideStats& stats);
+void WriteValue(std::ostream& out, const SlowRequest& request);
+void ReadValue(std::istream& in, SlowRequest& request);
+void WriteValue(std::ostream& out, const SlowRequestTracker& tracker);
+void ReadValue(std::istream& in, SlowRequestTracker& tracker);
+template <typename T>
+void WriteValue(std::ostream& out, const std::vector<T>& values);
+template <typename T>
+void ReadValue(std::istream& in, std::vector<T>& values);
+template <typename T, size_t N>
+void WriteValue(std::ostream& out, const std::array<T, N>& values);
+template <typename T, size_t N>
+void ReadValue(std::istream& in, std::array<T, N>& values);
+template <typename K, typename V>
+void WriteValue(std::ostream& out, const std::pair<K, V>& value);
+template <typename K, typename V>
+void ReadValue(std::istream& in, std::pair<K, V>& value);
+template <typename K, typename V>
+void WriteValue(std::ostream& out, const std::map<K, V>& values);
+template <typename K, typename V>
+void ReadValue(std::istream& in, std::map<K, V>& values);
+
+void
+WriteValue(std::ostream& out, const std::string& value)
+{
+  out << ' ' << std::quoted(value);
+}
+
+void
+ReadValue(std::istream& in, std::string& value)
+{
+  in >> std::quoted(value);
+}
+
+void
+WriteValue(std::ostream& out, const LatencyHistogram& histogram)
+{
+  // Most of the buckets are empty, only the others are written, each after
+  // its index
+  const auto serialized = histogram.Serialize();
+  const size_t nonzero_count =
+      serialized.size() - std::count(serialized.begin(), serialized.end(), 0);
+  out << ' ' << serialized.size() << ' ' << nonzero_count;
+  for (size_t i = 0; i < serialized.size(); i++) {
+    if (serialized[i] != 0) {
+      out << ' ' << i << ' ' << serialized[i];
+    }
+  }
+}
+
+void
+ReadValue(std::istream& in, LatencyHistogram& histogram)
+{
+  size_t size = 0;
+  size_t nonzero_count = 0;
+  in >> size >> nonzero_count;
+  std::vector<uint64_t> serialized(size, 0);
+  for (size_t i = 0; (i < nonzero_count) && in; i++) {
+    size_t index = 0;
+    in >> index;
+    if (index >= size) {
+      in.setstate(std::ios::failbit);
+      break;
+    }
+    in >> serialized[index];
+  }
+  histogram.Reset();
+  if (in && !histogram.MergeSerialized(serialized).IsOk()) {
+    in.setstate(std::ios::failbit);
+  }
+}
+
+void
+WriteValue(std::ostream& out, const RequestClassStats& stats)
+{
+  WriteValue(out, stats.latencies);
+  WriteValue(out, stats.rejected_count);
+}
+
+void
+ReadValue(std::istream& in, RequestClassStats& stats)
+{
+  ReadValue(in, stats.latencies);
+  ReadValue(in, stats.rejected_count);
+}
+
+// The server stats of the composing models nest, so they are written as one
+// value rather than as fields
+template <typename Stats, typename Fn>
+void
+VisitServerSideStats(Stats& stats, Fn&& fn)
+{
+  fn(stats.inference_count);
+  fn(stats.execution_count);
+  fn(stats.cache_hit_count);
+  fn(stats.cache_miss_count);
+  fn(stats.success_count);
+  fn(stats.queue_count);
+  fn(stats.compute_input_count);
+  fn(stats.compute_infer_count);
+  fn(stats.compute_output_count);
+  fn(stats.cumm_time_ns);
+  fn(stats.queue_time_ns);
+  fn(stats.compute_input_time_ns);
+  fn(stats.compute_infer_time_ns);
+  fn(stats.compute_output_time_ns);
+  fn(stats.cache_hit_time_ns);
+  fn(stats.cache_miss_time_ns);
+  fn(stats.composing_models_stat);
+}
+
+void
+WriteValue(std::ostream& out, const ServerSideStats& stats)
+{
+  VisitServerSideStats(
+      stats, [&out](const auto& value) { WriteValue(out, value); });
+}
+
+void
+ReadValue(std::istream& in, ServerSideStats& stats)
+{
+  VisitServerSideStats(stats, [&in](auto& value) { ReadValue(in, value); });
+}
+
+template <typename Request, typename Fn>
+void
+VisitSlowRequest(Request& request, Fn&& fn)
+{
+  fn(request.latency_ns);
+  fn(request.send_time_ns);
+  fn(request.first_response_time_ns);
+  fn(request.end_time_ns);
+  fn(request.schedule_lag_ns);
+  fn(request.response_count);
+  fn(request.worker);
+  fn(request.context);
+  fn(request.data_stream_id);
+  fn(request.data_step_id);
+  fn(request.sequence_id);
+  fn(request.endpoint);
+}
+
+void
+WriteValue(std::ostream& out, const SlowRequest& request)
+{
+  VisitSlowRequest(
+      request, [&out](const auto& value) { WriteValue(out, value); });
+}
+
+void
+ReadValue(std::istream& in, SlowRequest& request)
+{
+  VisitSlowRequest(request, [&in](auto& value) { ReadValue(in, value); });
+}
+
+void
+WriteValue(std::ostream& out, const SlowRequestTracker& tracker)
+{
+  WriteValue(out, tracker.Capacity());
+  WriteValue(out, tracker.Requests());
+}
+
+void
+ReadValue(std::istream& in, SlowRequestTracker& tracker)
+{
+  size_t capacity = 0;
+  std::vector<SlowRequest> requests;
+  ReadValue(in, capacity);
+  ReadValue(in, requests);
+  tracker = SlowRequestTracker(capacity);
+  for (auto& request : requests) {
+    tracker.Record(std::move(request));
+  }
+}
+
+template <typename T>
+void
+WriteValue(std::ostream& out, const std::vector<T>& values)
+{
+  out << ' ' << values.size();
+  for (const auto& value : values) {
+    WriteValue(out, value);
+  }
+}
+
+template <typename T>
+void
+ReadValue(std::istream& in, std::vector<T>& values)
+{
+  size_t size = 0;
+  in >> size;
+  values.clear();
+  for (size_t i = 0; (i < size) && in; i++) {
+    values.emplace_back();
+    ReadValue(in, values.back());
+  }
+}
+
+template <typename T, size_t N>
+void
+WriteValue(std::ostream& out, const std::array<T, N>& values)
+{
+  for (const auto& value : values) {
+    WriteValue(out, value);
+  }
+}
+
+template <typename T, size_t N>
+void
+ReadValue(std::istream& in, std::array<T, N>& values)
+{
+  for (auto& value : values) {
+    ReadValue(in, value);
+  }
+}
+
+template <typename K, typename V>
+void
+WriteValue(std::ostream& out, const std::pair<K, V>& value)
+{
+  WriteValue(out, value.first);
+  WriteValue(out, value.second);
+}
+
+template <typename K, typename V>
+void
+ReadValue(std::istream& in, std::pair<K, V>& value)
+{
+  ReadValue(in, value.first);
+  ReadValue(in, value.second);
+}
+
+template <typename K, typename V>
+void
+WriteValue(std::ostream& out, const std::map<K, V>& values)
+{
+  out << ' ' << values.size();
+  for (const auto& value : values) {
+    WriteValue(out, value.first);
+    WriteValue(out, value.second);
+  }
+}
+
+template <typename K, typename V>
+void
+ReadValue(std::istream& in, std::map<K, V>& values)
+{
+  size_t size = 0;
+  in >> size;
+  values.clear();
+  for (size_t i = 0; (i < size) && in; i++) {
+    K key{};
+    ReadValue(in, key);
+    ReadValue(in, values[key]);
+  }
+}
+
+// Calls fn with the name and a reference of each field of the results of a
+// level that is kept in the checkpoint
+template <typename Status, typename Fn>
+void
+VisitFields(Status& status, Fn&& fn)
+{
+  fn("concurrency", status.concurrency);
+  fn("request_rate", status.request_rate);
+  fn("batch_size", status.batch_size);
+  fn("server_stats", status.server_stats);
+  fn("endpoint_server_stats", status.endpoint_server_stats);
+  fn("overhead_pct", status.overhead_pct);
+  fn("on_sequence_model", status.on_sequence_model);
+  fn("stabilizing_latency_ns", status.stabilizing_latency_ns);
+  fn("converged", status.converged);
+  fn("send_request_rate", status.send_request_rate);
+  fn("window_start_ns", status.window_start_ns);
+  fn("window_end_ns", status.window_end_ns);
+  fn("window_infer_per_sec", status.window_infer_per_sec);
+  fn("cpu_user_pct", status.client_resources.cpu_user_pct);
+  fn("cpu_sys_pct", status.client_resources.cpu_sys_pct);
+  fn("rss_bytes", status.client_resources.rss_bytes);
+  fn("voluntary_context_switches",
+     status.client_resources.voluntary_context_switches);
+  fn("involuntary_context_switches",
+     status.client_resources.involuntary_context_switches);
+  fn("thread_cpu_pct", status.client_resources.thread_cpu_pct);
+  fn("max_thread_cpu_pct", status.client_resources.max_thread_cpu_pct);
+
+  auto& stats = status.client_stats;
+  fn("request_count", stats.request_count);
+  fn("sequence_count", stats.sequence_count);
+  fn("delayed_request_count", stats.delayed_request_count);
+  fn("outlier_count", stats.outlier_count);
+  fn("max_outlier_latency_ns", stats.max_outlier_latency_ns);
+  fn("duration_ns", stats.duration_ns);
+  fn("avg_latency_ns", stats.avg_latency_ns);
+  fn("percentile_latency_ns", stats.percentile_latency_ns);
+  fn("latency_histogram", stats.latency_histogram);
+  fn("schedule_error_histogram", stats.schedule_error_histogram);
+  fn("dropped_request_count", stats.dropped_request_count);
+  fn("queue_delay_histogram", stats.queue_delay_histogram);
+  fn("validated_output_count", stats.validation_stats.output_count);
+  fn("mismatched_output_count", stats.validation_stats.mismatched_output_count);
+  fn("mismatched_element_count",
+     stats.validation_stats.mismatched_element_count);
+  fn("max_abs_error", stats.validation_stats.max_abs_error);
+  fn("skipped_output_count", stats.validation_stats.skipped_output_count);
+  fn("corrected_latency_histogram", stats.corrected_latency_histogram);
+  fn("server_queue_histogram", stats.server_queue_histogram);
+  fn("server_compute_input_histogram", stats.server_compute_input_histogram);
+  fn("server_compute_infer_histogram", stats.server_compute_infer_histogram);
+  fn("server_compute_output_histogram", stats.server_compute_output_histogram);
+  fn("bucket_latency_histograms", stats.bucket_latency_histograms);
+  fn("request_class_stats", stats.request_class_stats);
+  fn("endpoint_latency_histograms", stats.endpoint_latency_histograms);
+  fn("slow_requests", stats.slow_requests);
+  fn("std_us", stats.std_us);
+  fn("avg_request_time_ns", stats.avg_request_time_ns);
+  fn("avg_send_time_ns", stats.avg_send_time_ns);
+  fn("avg_receive_time_ns", stats.avg_receive_time_ns);
+  fn("avg_first_byte_time_ns", stats.avg_first_byte_time_ns);
+  fn("avg_serialize_time_ns", stats.avg_serialize_time_ns);
+  fn("avg_send_queue_time_ns", stats.avg_send_queue_time_ns);
+  fn("avg_deserialize_time_ns", stats.avg_deserialize_time_ns);
+  fn("request_byte_size", stats.request_byte_size);
+  fn("uncompressed_request_byte_size", stats.uncompressed_request_byte_size);
+  fn("response_byte_size", stats.response_byte_size);
+  fn("uncompressed_response_byte_size", stats.uncompressed_response_byte_size);
+  fn("response_chunk_interval_count", stats.response_chunk_interval_count);
+  fn("avg_response_chunk_interval_ns", stats.avg_response_chunk_interval_ns);
+  fn("response_count", stats.response_count);
+  fn("avg_first_response_latency_ns", stats.avg_first_response_latency_ns);
+  fn("response_gap_count", stats.response_gap_count);
+  fn("avg_response_gap_ns", stats.avg_response_gap_ns);
+  fn("stage_request_count", stats.stage_times.request_count);
+  fn("stage_total_ns", stats.stage_times.total_ns);
+  fn("infer_per_sec", stats.infer_per_sec);
+  fn("sequence_per_sec", stats.sequence_per_sec);
+  fn("completed_count", stats.completed_count);
+}
+
+double
+LoadLevel(const PerfStatus& status)
+{
+  return (status.concurrency != 0) ? status.concurrency : status.request_rate;
+}
+
+}  // namespace
+
+cb::Error
+SweepCheckpoint::Create(
+    const std::string& path, const std::string& settings,
+    std::shared_ptr<SweepCheckpoint>* checkpoint)
+{
+  std::shared_ptr<SweepCheckpoint> local_checkpoint(new SweepCheckpoint(path));
+  RETURN_IF_ERROR(local_checkpoint->Read(settings));
+
+  // Written again from what was read, which drops a level cut short
+  local_checkpoint->file_.open(path, std::ofstream::out | std::ofstream::trunc);
+  if (!local_checkpoint->file_.is_open()) {
+    return cb::Error(
+        "failed to open checkpoint file " + path, pa::GENERIC_ERROR);
+  }
+  // Enough digits for the doubles to read back the same
+  local_checkpoint->file_ << std::setprecision(
+      std::numeric_limits<double>::max_digits10);
+  local_checkpoint->file_ << "settings";
+  WriteValue(local_checkpoint->file_, settings);
+  local_checkpoint->file_ << '\n';
+  for (const auto& level : local_checkpoint->levels_) {
+    local_checkpoint->WriteLevel(level);
+  }
+  local_checkpoint->file_.flush();
+  if (!local_checkpoint->file_.good()) {
+    return cb::Error(
+        "failed to write to checkpoint file " + path, pa::GENERIC_ERROR);
+  }
+
+  *checkpoint = std::move(local_checkpoint);
+  return cb::Error::Success;
+}
+
+cb::Error
+SweepCheckpoint::Read(const std::string& settings)
+{
+  std::ifstream file(path_);
+  std::string line;
+  if (!file.is_open() || !std::getline(file, line)) {
+    // Nothing to resume
+    return cb::Error::Success;
+  }
+  std::stringstream settings_line(line);
+  std::string key;
+  std::string file_settings;
+  settings_line >> key;
+  ReadValue(settings_line, file_settings);
+  if ((key != "settings") || !settings_line) {
+    return cb::Error(
+        path_ + " is not a checkpoint file of perf_analyzer", pa::OPTION_ERROR);
+  }
+  if (file_settings != settings) {
+    return cb::Error(
+        "checkpoint file " + path_ + " was written for '" + file_settings +
+            "' rather than '" + settings +
+            "', remove it to start the sweep over",
+        pa::OPTION_ERROR);
+  }
+
+  // A line that does not parse was being written when the sweep stopped, its
+  // level is measured again
+  Level level;
+  bool in_level = false;
+  while (std::getline(file, line)) {
+    std::stringstream fields(line);
+    if (!(fields >> key)) {
+      continue;
+    }
+    if (key == "level") {
+      level = Level();
+      fields >> level.meets_threshold >> level.is_stable;
+      in_level = true;
+    } else if (key == "end") {
+      if (in_level) {
+        levels_.push_back(level);
+      }
+      in_level = false;
+    } else if (in_level) {
+      // Unknown fields are skipped
+      VisitFields(level.status, [&](const char* name, auto& value) {
+        if (key == name) {
+          ReadValue(fields, value);
+        }
+      });
+    }
+    if (!fields) {
+      in_level = false;
+    }
+  }
+  return cb::Error::Success;
+}
+
+void
+SweepCheckpoint::WriteLevel(const Level& level)
+{
+  file_ << "level " << level.meets_threshold << ' ' << level.is_stable << '\n';
+  VisitFields(level.status, [this](const char* name, const auto& value) {
+    file_ << name;
+    WriteValue(file_, value);
+    file_ << '\n';
+  });
+  file_ << "end\n";
+}
+
+bool
+SweepCheckpoint::Find(
+    const double load_level, PerfStatus* status, bool* meets_threshold,
+    bool* is_stable) const
+{
+  for (const auto& level : levels_) {
+    if (std::abs(LoadLevel(level.status) - load_level) <=
+        1e-9 * std::max(1.0, std::abs(load_level))) {
+      *status = level.status;
+      *meets_threshold = level.meets_threshold;
+      *is_stable = level.is_stable;
+      return true;
+    }
+  }
+  return false;
+}
+
+cb::Error
+SweepCheckpoint::Append(
+    const PerfStatus& status, const bool meets_threshold, const bool is_stable)
+{
+  Level level;
+  level.status = status;
+  level.meets_threshold = meets_threshold;
+  level.is_stable = is_stable;
+  WriteLevel(level);
+  file_.flush();
+  if (!file_.good()) {
+    return cb::Error(
+        "failed to write to checkpoint file " + path_, pa::GENERIC_ERROR);
+  }
+  levels_.push_back(std::move(level));
+  return cb::Error::Success;
+}
+
+cb::Error
+SweepCheckpoint::Remove()
+{
+  file_.close();
+  if (std::remove(path_.c_str()) != 0) {
+    return cb::Error(
+        "failed to remove checkpoint file " + path_, pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,108 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference_profiler.h"
+#include "perf_utils.h"
+
+namespace triton { namespace perfanalyzer {
+
+//==============================================================================
+/// SweepCheckpoint keeps the results of each load level of a sweep in a file
+/// as soon as the level completes, so that a sweep that stops midway, e.g.
+/// because perf_analyzer or the server crashed, resumes after the last
+/// completed level rather than starting over.
+///
+/// The file is text. It starts with a "settings" line describing the sweep,
+/// followed by the completed levels. Each level is a "level" line, one
+/// "name values..." line per field of its results and an "end" line. A level
+/// cut short by a crash has no "end" line and is measured again. The GPU
+/// metrics of the levels are not kept.
+///
+class SweepCheckpoint {
+ public:
+  /// Open the checkpoint file and read the levels that it completed. The
+  /// file is created if it does not exist.
+  /// \param path The path of the file.
+  /// \param settings Describes the settings of the sweep, such as the model.
+  /// A file written with other settings is an error rather than resumed.
+  /// \param checkpoint Returns a new SweepCheckpoint object.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const std::string& path, const std::string& settings,
+      std::shared_ptr<SweepCheckpoint>* checkpoint);
+
+  /// Look up a completed level.
+  /// \param load_level The concurrency or request rate of the level.
+  /// \param status Returns the results of the level.
+  /// \param meets_threshold Returns whether the level met the latency
+  /// threshold, which decides where the sweep goes next.
+  /// \param is_stable Returns whether the measurement of the level was
+  /// stable.
+  /// \return Whether the level was completed.
+  bool Find(
+      const double load_level, PerfStatus* status, bool* meets_threshold,
+      bool* is_stable) const;
+
+  /// Append a completed level to the file.
+  /// \param status The results of the level.
+  /// \param meets_threshold Whether the level met the latency threshold.
+  /// \param is_stable Whether the measurement of the level was stable.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Append(
+      const PerfStatus& status, const bool meets_threshold,
+      const bool is_stable);
+
+  /// Remove the file once the sweep has finished.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error Remove();
+
+  /// \return The number of completed levels.
+  size_t CompletedCount() const { return levels_.size(); }
+
+ private:
+  struct Level {
+    PerfStatus status;
+    bool meets_threshold{false};
+    bool is_stable{false};
+  };
+
+  explicit SweepCheckpoint(const std::string& path) : path_(path) {}
+
+  cb::Error Read(const std::string& settings);
+  void WriteLevel(const Level& level);
+
+  std::string path_;
+  std::ofstream file_;
+  std::vector<Level> levels_;
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,267 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "baseline_comparison.h"
+#include "doctest.h"
+#include "request_record_writer.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+MakeTempPath()
+{
+  char path[] = "/tmp/baseline_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  close(fd);
+  return path;
+}
+
+// A measurement with latencies spread evenly over [low_ns, 2 * low_ns)
+PerfStatus
+MakeStatus(
+    const uint32_t concurrency, const double infer_per_sec,
+    const uint64_t low_ns)
+{
+  PerfStatus status;
+  status.concurrency = concurrency;
+  status.client_stats.infer_per_sec = infer_per_sec;
+  for (int i = 0; i < 3; i++) {
+    status.window_infer_per_sec.push_back(infer_per_sec * (0.99 + 0.01 * i));
+  }
+  for (uint64_t i = 0; i < 2000; i++) {
+    status.client_stats.latency_histogram.Record(low_ns + i * low_ns / 2000);
+  }
+  for (const size_t percentile : {50, 99}) {
+    status.client_stats.percentile_latency_ns[percentile] =
+        status.client_stats.latency_histogram.ValueAtPercentile(percentile);
+  }
+  return status;
+}
+
+BaselineLevel
+MakeBaselineLevel(const PerfStatus& status)
+{
+  BaselineLevel level;
+  level.load_level = status.concurrency;
+  level.window_infer_per_sec = status.window_infer_per_sec;
+  level.latency_histogram = status.client_stats.latency_histogram;
+  return level;
+}
+
+const MetricComparison&
+FindMetric(const LevelComparison& comparison, const std::string& name)
+{
+  for (const auto& metric : comparison.metrics) {
+    if (metric.name == name) {
+      return metric;
+    }
+  }
+  FAIL("missing metric " << name);
+  return comparison.metrics[0];
+}
+
+}  // namespace
+
+TEST_CASE("baseline_comparison: read a CSV report")
+{
+  const std::string path = MakeTempPath();
+  std::ofstream(path)
+      << "Concurrency,Inferences/Second,Client Send,Client Recv,p50 latency,"
+      << "p99 latency,p99 corrected latency" << std::endl
+      << "1,100.5,10,20,900,1500,1600" << std::endl
+      << "2,180,10,20,1100,2500,2600" << std::endl
+      << std::endl
+      << "Server metrics" << std::endl;
+
+  std::vector<BaselineLevel> levels;
+  REQUIRE(ReadBaseline(path, &levels).IsOk());
+  REQUIRE(levels.size() == 2);
+  CHECK(levels[0].load_level == 1);
+  CHECK(levels[0].window_infer_per_sec == std::vector<double>{100.5});
+  CHECK(levels[0].latency_histogram.TotalCount() == 0);
+  CHECK(
+      levels[0].percentile_latency_ns ==
+      std::map<size_t, uint64_t>{{50, 900000}, {99, 1500000}});
+  CHECK(levels[1].load_level == 2);
+  CHECK(levels[1].percentile_latency_ns.at(99) == 2500000);
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("baseline_comparison: read a request record file")
+{
+  const std::string path = MakeTempPath();
+  std::shared_ptr<RequestRecordWriter> writer;
+  REQUIRE(RequestRecordWriter::Create(path, &writer).IsOk());
+  const auto origin = std::chrono::system_clock::now();
+  const auto at = [&origin](uint64_t us) {
+    return origin + std::chrono::microseconds(us);
+  };
+  TimestampVector first{
+      std::make_tuple(at(0), at(100), 0u, false, at(100), 1u),
+      std::make_tuple(at(0), at(300), 0u, false, at(300), 1u)};
+  TimestampVector second{
+      std::make_tuple(at(0), at(200), 0u, false, at(200), 1u)};
+  TimestampVector drained{
+      std::make_tuple(at(0), at(90000), 0u, false, at(90000), 1u)};
+  REQUIRE(writer->Write(drained, 4, 0).IsOk());
+  REQUIRE(writer->Write(first, 4, 200).IsOk());
+  REQUIRE(writer->Write(second, 4, 100).IsOk());
+  REQUIRE(writer->Write(first, 8, 400).IsOk());
+  writer.reset();
+
+  std::vector<BaselineLevel> levels;
+  REQUIRE(ReadBaseline(path, &levels).IsOk());
+  REQUIRE(levels.size() == 2);
+  CHECK(levels[0].load_level == 4);
+  CHECK(levels[0].window_infer_per_sec == std::vector<double>{200, 100});
+  // The requests drained between measurements are left out
+  CHECK(levels[0].latency_histogram.TotalCount() == 3);
+  CHECK(levels[0].latency_histogram.Max() == 300000);
+  CHECK(levels[1].load_level == 8);
+  CHECK(levels[1].window_infer_per_sec == std::vector<double>{400});
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("baseline_comparison: invalid baseline files")
+{
+  std::vector<BaselineLevel> levels;
+  CHECK_FALSE(ReadBaseline("/nonexistent/baseline.csv", &levels).IsOk());
+
+  const std::string path = MakeTempPath();
+  SUBCASE("not a report")
+  {
+    std::ofstream(path) << "Bucket,Request Count" << std::endl;
+    CHECK_FALSE(ReadBaseline(path, &levels).IsOk());
+  }
+  SUBCASE("no measurements")
+  {
+    std::ofstream(path) << "Request Rate,Inferences/Second" << std::endl;
+    CHECK_FALSE(ReadBaseline(path, &levels).IsOk());
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("baseline_comparison: compare with a baseline")
+{
+  const std::vector<BaselineLevel> baseline{
+      MakeBaselineLevel(MakeStatus(1, 1000, 1000000))};
+
+  SUBCASE("same results")
+  {
+    const auto comparisons = CompareWithBaseline(
+        baseline, {MakeStatus(1, 1000, 1000000)}, true, 0.05);
+    REQUIRE(comparisons.size() == 1);
+    CHECK(comparisons[0].has_baseline);
+    REQUIRE(comparisons[0].metrics.size() == 3);
+    for (const auto& metric : comparisons[0].metrics) {
+      CHECK(metric.change_low <= 0.0);
+      CHECK(metric.change_high >= 0.0);
+      CHECK_FALSE(metric.regressed);
+    }
+  }
+  SUBCASE("slower and higher latency")
+  {
+    const auto comparisons = CompareWithBaseline(
+        baseline, {MakeStatus(1, 800, 1200000)}, true, 0.05);
+    REQUIRE(comparisons.size() == 1);
+    const auto& throughput = FindMetric(comparisons[0], "throughput");
+    CHECK(throughput.change == doctest::Approx(-0.2));
+    CHECK(throughput.change_high < -0.05);
+    CHECK(throughput.regressed);
+    const auto& p99 = FindMetric(comparisons[0], "p99 latency");
+    CHECK(p99.change == doctest::Approx(0.2).epsilon(0.01));
+    CHECK(p99.change_low > 0.05);
+    CHECK(p99.regressed);
+
+    std::stringstream out;
+    CHECK(ReportBaselineComparison(comparisons, true, 0.05, out));
+    CHECK(out.str().find("REGRESSION") != std::string::npos);
+  }
+  SUBCASE("change within the threshold")
+  {
+    const auto comparisons = CompareWithBaseline(
+        baseline, {MakeStatus(1, 980, 1020000)}, true, 0.05);
+    REQUIRE(comparisons.size() == 1);
+    for (const auto& metric : comparisons[0].metrics) {
+      CHECK_FALSE(metric.regressed);
+    }
+    std::stringstream out;
+    CHECK_FALSE(ReportBaselineComparison(comparisons, true, 0.05, out));
+  }
+  SUBCASE("faster and lower latency")
+  {
+    const auto comparisons = CompareWithBaseline(
+        baseline, {MakeStatus(1, 1500, 500000)}, true, 0.05);
+    REQUIRE(comparisons.size() == 1);
+    for (const auto& metric : comparisons[0].metrics) {
+      CHECK_FALSE(metric.regressed);
+    }
+  }
+  SUBCASE("load level missing from the baseline")
+  {
+    const auto comparisons = CompareWithBaseline(
+        baseline, {MakeStatus(2, 800, 1200000)}, true, 0.05);
+    REQUIRE(comparisons.size() == 1);
+    CHECK(comparisons[0].load_level == 2);
+    CHECK_FALSE(comparisons[0].has_baseline);
+    std::stringstream out;
+    CHECK_FALSE(ReportBaselineComparison(comparisons, true, 0.05, out));
+  }
+}
+
+TEST_CASE("baseline_comparison: compare with exact CSV values")
+{
+  BaselineLevel level;
+  level.load_level = 10;
+  level.window_infer_per_sec = {1000};
+  level.percentile_latency_ns = {{99, 1000000}};
+  PerfStatus status = MakeStatus(0, 1000, 1000000);
+  status.request_rate = 10;
+
+  const auto comparisons =
+      CompareWithBaseline({level}, {status}, false, 0.05);
+  REQUIRE(comparisons.size() == 1);
+  // Only the percentiles in the report are compared
+  REQUIRE(comparisons[0].metrics.size() == 2);
+  const auto& p99 = FindMetric(comparisons[0], "p99 latency");
+  CHECK(p99.baseline == 1000000);
+  // The latencies of the current run reach 2 msec
+  CHECK(p99.change == doctest::Approx(0.99).epsilon(0.01));
+  CHECK(p99.regressed);
+  CHECK_FALSE(FindMetric(comparisons[0], "throughput").regressed);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,209 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "capacity_model.h"
+#include "doctest.h"
+#include "inference_profiler.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// The measurements of a closed system with a single queueing server of
+// 'service_ns' behind a delay of 'delay_ns', solved with mean value analysis
+std::vector<CapacitySample>
+ClosedSamples(
+    const std::vector<size_t>& concurrencies, const double service_ns,
+    const double delay_ns)
+{
+  std::vector<CapacitySample> samples;
+  for (const size_t concurrency : concurrencies) {
+    double queue_length = 0.0;
+    double residence_ns = service_ns;
+    double requests_per_ns = 0.0;
+    for (size_t n = 1; n <= concurrency; n++) {
+      residence_ns = service_ns * (1.0 + queue_length);
+      requests_per_ns = n / (residence_ns + delay_ns);
+      queue_length = requests_per_ns * residence_ns;
+    }
+    CapacitySample sample;
+    sample.load = concurrency;
+    sample.throughput = requests_per_ns * NANOS_PER_SECOND;
+    sample.latency_ns = residence_ns + delay_ns;
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST_CASE("capacity_model: fits a concurrency sweep")
+{
+  // 4 model instances computing a request in 2 msec, behind 1 msec of
+  // network: a saturation throughput of 2000 requests/sec
+  std::vector<CapacitySample> samples =
+      ClosedSamples({1, 2, 8, 16}, 500000.0, 2500000.0);
+  for (auto& sample : samples) {
+    sample.compute_ns = 2000000.0;
+  }
+
+  CapacityModel model;
+  REQUIRE(CapacityModel::Fit(samples, true, &model).IsOk());
+  CHECK(model.Closed());
+  CHECK(model.SaturationThroughput() == doctest::Approx(2000.0).epsilon(0.02));
+  CHECK(model.BaseLatencyNs() == doctest::Approx(3000000.0).epsilon(0.05));
+  CHECK(model.Parallelism() == doctest::Approx(4.0).epsilon(0.02));
+  CHECK(model.KneeConcurrency() == doctest::Approx(6.0).epsilon(0.05));
+  CHECK(model.FitError() < 0.01);
+
+  // A concurrency that was not measured
+  double throughput, latency_ns;
+  model.Predict(32, &throughput, &latency_ns);
+  const auto expected = ClosedSamples({32}, 500000.0, 2500000.0)[0];
+  CHECK(throughput == doctest::Approx(expected.throughput).epsilon(0.02));
+  CHECK(latency_ns == doctest::Approx(expected.latency_ns).epsilon(0.02));
+}
+
+TEST_CASE("capacity_model: fits a request rate sweep")
+{
+  // A server saturating at 1000 requests/sec behind 1 msec of delay
+  std::vector<CapacitySample> samples;
+  for (const double rate : {200.0, 500.0, 800.0}) {
+    CapacitySample sample;
+    sample.load = rate;
+    sample.throughput = rate;
+    sample.latency_ns = 1000000.0 + 1000000.0 / (1.0 - rate / 1000.0);
+    samples.push_back(sample);
+  }
+
+  CapacityModel model;
+  REQUIRE(CapacityModel::Fit(samples, false, &model).IsOk());
+  CHECK(!model.Closed());
+  CHECK(model.SaturationThroughput() == doctest::Approx(1000.0).epsilon(0.02));
+  CHECK(model.ServiceTimeNs() == 0.0);
+  CHECK(model.Parallelism() == 0.0);
+
+  double throughput, latency_ns;
+  model.Predict(900.0, &throughput, &latency_ns);
+  CHECK(throughput == doctest::Approx(900.0));
+  CHECK(latency_ns == doctest::Approx(11000000.0).epsilon(0.1));
+  model.Predict(1200.0, &throughput, &latency_ns);
+  CHECK(throughput == doctest::Approx(model.SaturationThroughput()));
+  CHECK(std::isinf(latency_ns));
+}
+
+TEST_CASE("capacity_model: needs two load levels with completed requests")
+{
+  std::vector<CapacitySample> samples = ClosedSamples({1}, 1000.0, 1000.0);
+  samples.emplace_back();
+  samples.back().load = 2;
+
+  CapacityModel model;
+  CHECK(!CapacityModel::Fit(samples, true, &model).IsOk());
+}
+
+TEST_CASE("capacity_model: Little's law")
+{
+  CapacitySample sample;
+  sample.load = 4;
+  sample.throughput = 1000.0;
+  sample.latency_ns = 4000000.0;
+  CHECK(LittlesLawDeviation(sample) == doctest::Approx(0.0));
+  sample.latency_ns = 3000000.0;
+  CHECK(LittlesLawDeviation(sample) == doctest::Approx(-0.25));
+}
+
+TEST_CASE("capacity_model: converts a measurement")
+{
+  PerfStatus status;
+  status.concurrency = 8;
+  status.request_rate = 0.0;
+  status.batch_size = 4;
+  status.client_stats.infer_per_sec = 400.0;
+  status.client_stats.avg_latency_ns = 5000;
+  status.server_stats.queue_count = 10;
+  status.server_stats.queue_time_ns = 1000;
+  status.server_stats.compute_infer_count = 10;
+  status.server_stats.compute_input_time_ns = 100;
+  status.server_stats.compute_infer_time_ns = 2000;
+  status.server_stats.compute_output_time_ns = 400;
+
+  const CapacitySample sample = ToCapacitySample(status, true);
+  CHECK(sample.load == 8.0);
+  CHECK(sample.throughput == 100.0);
+  CHECK(sample.latency_ns == 5000.0);
+  CHECK(sample.queue_ns == 100.0);
+  CHECK(sample.compute_ns == 250.0);
+}
+
+TEST_CASE("capacity_model: picks the next load level")
+{
+  CapacityModel model;
+  REQUIRE(CapacityModel::Fit(
+              ClosedSamples({1, 2, 8, 16}, 500000.0, 2500000.0), true, &model)
+              .IsOk());
+  const double knee = std::ceil(2.0 * model.KneeConcurrency());
+
+  // Past the knee, growing at most fourfold
+  CHECK(NextCapacitySearchLoad(model, 1, 1, NO_LIMIT) == 4);
+  CHECK(NextCapacitySearchLoad(model, 8, 1, NO_LIMIT) == knee);
+  CHECK(NextCapacitySearchLoad(model, 8, 1, 10) == 10);
+  // By at least a step
+  CHECK(NextCapacitySearchLoad(model, 16, 2, NO_LIMIT) == 18);
+}
+
+TEST_CASE("capacity_model: reports the estimate")
+{
+  std::vector<CapacitySample> samples =
+      ClosedSamples({1, 2, 8, 16}, 500000.0, 2500000.0);
+  CapacityModel model;
+  REQUIRE(CapacityModel::Fit(samples, true, &model).IsOk());
+
+  SUBCASE("Little's law holds")
+  {
+    std::stringstream out;
+    ReportCapacity(samples, model, 2, out);
+    CHECK(
+        out.str().find("Capacity estimate from 4 load levels") !=
+        std::string::npos);
+    CHECK(out.str().find("Saturation throughput: ") != std::string::npos);
+    CHECK(out.str().find("Predicted at concurrency 32") != std::string::npos);
+    CHECK(out.str().find("Little's law") != std::string::npos);
+    CHECK(out.str().find("WARNING") == std::string::npos);
+  }
+  SUBCASE("Little's law does not hold")
+  {
+    samples[1].latency_ns /= 2;
+    std::stringstream out;
+    ReportCapacity(samples, model, 2, out);
+    CHECK(
+        out.str().find("WARNING: at concurrency 2, throughput x latency is "
+                       "-50.0% off") != std::string::npos);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
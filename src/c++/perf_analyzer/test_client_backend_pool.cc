@@ -0,0 +1,87 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <memory>
+#include <vector>
+#include "client_backend_pool.h"
+#include "doctest.h"
+#include "mock_client_backend.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("client_backend_pool: round robin")
+{
+  auto stats = std::make_shared<cb::MockClientStats>();
+  auto factory = std::make_shared<cb::MockClientBackendFactory>(stats);
+  ClientBackendPool pool(factory, 2);
+  CHECK(pool.Size() == 2);
+
+  std::vector<std::shared_ptr<cb::ClientBackend>> backends(5);
+  std::vector<size_t> indices(5);
+  for (size_t i = 0; i < backends.size(); i++) {
+    REQUIRE(pool.Take(&backends[i], &indices[i]).IsOk());
+    REQUIRE(backends[i] != nullptr);
+    CHECK(indices[i] == i % 2);
+  }
+  CHECK(backends[0] == backends[2]);
+  CHECK(backends[0] == backends[4]);
+  CHECK(backends[1] == backends[3]);
+  CHECK(backends[0] != backends[1]);
+}
+
+TEST_CASE("client_backend_pool: client stats are read once")
+{
+  auto stats = std::make_shared<cb::MockClientStats>();
+  auto factory = std::make_shared<cb::MockClientBackendFactory>(stats);
+  ClientBackendPool pool(factory, 1);
+
+  std::shared_ptr<cb::ClientBackend> first;
+  std::shared_ptr<cb::ClientBackend> second;
+  size_t first_index;
+  size_t second_index;
+  REQUIRE(pool.Take(&first, &first_index).IsOk());
+  REQUIRE(pool.Take(&second, &second_index).IsOk());
+  REQUIRE(first == second);
+
+  // A request of each context sharing the backend
+  cb::InferOptions options("model");
+  cb::InferResult* result = nullptr;
+  REQUIRE(first->Infer(&result, options, {}, {}).IsOk());
+  REQUIRE(second->Infer(&result, options, {}, {}).IsOk());
+
+  cb::InferStat previous;
+  cb::InferStat current;
+  REQUIRE(pool.ReadClientStat(first_index, &previous, &current).IsOk());
+  CHECK(previous.completed_request_count == 0);
+  CHECK(current.completed_request_count == 2);
+
+  // The other context sees no new request
+  REQUIRE(pool.ReadClientStat(second_index, &previous, &current).IsOk());
+  CHECK(previous.completed_request_count == 2);
+  CHECK(current.completed_request_count == 2);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,78 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <thread>
+#include "client_stage_timer.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("client_stage_timer: disabled")
+{
+  ClientStageTimer timer;
+  {
+    ClientStageTimer::Scope scope(timer, CLIENT_STAGE_SEND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  timer.RecordRequest();
+
+  ClientStageTimes times;
+  timer.CollectAndReset(&times);
+  CHECK(times.request_count == 0);
+  CHECK(times.total_ns[CLIENT_STAGE_SEND] == 0);
+}
+
+TEST_CASE("client_stage_timer: collect and reset")
+{
+  ClientStageTimer timer;
+  timer.Enable();
+  timer.RecordRequest();
+  timer.RecordRequest();
+  {
+    ClientStageTimer::Scope scope(timer, CLIENT_STAGE_SEND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  timer.Record(CLIENT_STAGE_DATA_PREP, 3000);
+  timer.Record(CLIENT_STAGE_DATA_PREP, 1000);
+
+  ClientStageTimes times;
+  timer.CollectAndReset(&times);
+  CHECK(times.request_count == 2);
+  CHECK(times.total_ns[CLIENT_STAGE_SEND] >= 1000000);
+  CHECK(times.AvgNs(CLIENT_STAGE_DATA_PREP) == 2000);
+  CHECK(times.AvgNs(CLIENT_STAGE_CALLBACK) == 0);
+
+  ClientStageTimes next_times;
+  timer.CollectAndReset(&next_times);
+  CHECK(next_times.request_count == 0);
+  CHECK(next_times.total_ns[CLIENT_STAGE_DATA_PREP] == 0);
+
+  times.Merge(times);
+  CHECK(times.request_count == 4);
+  CHECK(times.AvgNs(CLIENT_STAGE_DATA_PREP) == 2000);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,99 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "client_trace.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("client_trace: sampling")
+{
+  ClientTracer tracer(4, 16);
+  size_t sampled = 0;
+  for (uint64_t i = 0; i < 40; i++) {
+    sampled += tracer.ShouldSample(1, i) ? 1 : 0;
+  }
+  CHECK(sampled == 10);
+  // The contexts are offset so that they do not trace at the same time
+  CHECK(tracer.ShouldSample(0, 0));
+  CHECK(!tracer.ShouldSample(1, 0));
+  CHECK(tracer.ShouldSample(1, 3));
+
+  const uint64_t first = tracer.NewTraceId();
+  CHECK(first != 0);
+  CHECK(tracer.NewTraceId() == first + 1);
+  CHECK(ClientTracer::RequestId(7) == "pa-trace-7");
+}
+
+TEST_CASE("client_trace: ring buffer keeps the most recent spans")
+{
+  ClientTracer tracer(1, 3);
+  for (uint64_t i = 1; i <= 5; i++) {
+    tracer.Record({i, CLIENT_SPAN_SEND, 0, i * 1000, i * 1000 + 500});
+  }
+  CHECK(tracer.RecordedCount() == 5);
+  const auto spans = tracer.Spans();
+  REQUIRE(spans.size() == 3);
+  CHECK(spans[0].trace_id == 3);
+  CHECK(spans[1].trace_id == 4);
+  CHECK(spans[2].trace_id == 5);
+}
+
+TEST_CASE("client_trace: scope")
+{
+  ClientTracer tracer(1, 8);
+  {
+    ClientTracer::Scope untraced(&tracer, 0, CLIENT_SPAN_DATA_PREP, 2);
+    ClientTracer::Scope no_tracer(nullptr, 1, CLIENT_SPAN_DATA_PREP, 2);
+  }
+  CHECK(tracer.RecordedCount() == 0);
+  {
+    ClientTracer::Scope traced(&tracer, 9, CLIENT_SPAN_VALIDATION, 2);
+  }
+  const auto spans = tracer.Spans();
+  REQUIRE(spans.size() == 1);
+  CHECK(spans[0].trace_id == 9);
+  CHECK(spans[0].kind == CLIENT_SPAN_VALIDATION);
+  CHECK(spans[0].context_id == 2);
+  CHECK(spans[0].end_ns >= spans[0].start_ns);
+}
+
+TEST_CASE("client_trace: chrome trace")
+{
+  ClientTracer tracer(1, 8);
+  tracer.Record({5, CLIENT_SPAN_WAIT, 3, 1000001500, 1000004250});
+  std::stringstream out;
+  tracer.WriteChromeTrace(out);
+  CHECK(
+      out.str() ==
+      "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+      "{\"name\":\"wait\",\"cat\":\"client\",\"ph\":\"X\","
+      "\"ts\":1000001.500,\"dur\":2.750,\"pid\":3,\"tid\":5,"
+      "\"args\":{\"request_id\":\"pa-trace-5\"}}\n]}\n");
+}
+
+}}  // namespace triton::perfanalyzer
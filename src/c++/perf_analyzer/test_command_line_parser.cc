@@ -25,6 +25,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include <getopt.h>
+#include <unistd.h>
 #include <array>
 #include "command_line_parser.h"
 #include "doctest.h"
@@ -59,12 +60,17 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->extra_verbose == exp->extra_verbose);
   CHECK(act->max_threads == exp->max_threads);
   CHECK(act->max_threads_specified == exp->max_threads_specified);
+  CHECK(act->auto_max_threads == exp->auto_max_threads);
   CHECK(act->sequence_length == exp->sequence_length);
   CHECK(act->percentile == exp->percentile);
   REQUIRE(act->user_data.size() == exp->user_data.size());
   for (size_t i = 0; i < act->user_data.size(); i++) {
     CHECK_STRING(act->user_data[i], exp->user_data[i]);
   }
+  CHECK_STRING(act->input_corpus_file, exp->input_corpus_file);
+  CHECK_STRING(act->experiment_file, exp->experiment_file);
+  CHECK(act->model_load_iterations == exp->model_load_iterations);
+  CHECK_STRING(act->model_load_config_file, exp->model_load_config_file);
   CHECK(act->input_shapes.size() == exp->input_shapes.size());
   for (auto act_shape : act->input_shapes) {
     auto exp_shape = exp->input_shapes.find(act_shape.first);
@@ -86,6 +92,42 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->latency_threshold_ms == exp->latency_threshold_ms);
   CHECK(act->stability_threshold == doctest::Approx(act->stability_threshold));
   CHECK(act->max_trials == exp->max_trials);
+  CHECK(act->early_convergence == exp->early_convergence);
+  CHECK_STRING(act->time_series_file, exp->time_series_file);
+  CHECK(act->metrics_allowlist == exp->metrics_allowlist);
+  CHECK_STRING(act->request_template, exp->request_template);
+  CHECK(
+      act->null_server_options.latency_us ==
+      exp->null_server_options.latency_us);
+  CHECK(
+      act->null_server_options.max_batch_size ==
+      exp->null_server_options.max_batch_size);
+  CHECK(
+      act->null_server_options.batch_delay_us ==
+      exp->null_server_options.batch_delay_us);
+  CHECK(
+      act->null_server_options.instance_count ==
+      exp->null_server_options.instance_count);
+  CHECK(
+      act->tfserving_options.completion_queue_count ==
+      exp->tfserving_options.completion_queue_count);
+  CHECK(
+      act->tfserving_options.channel_count ==
+      exp->tfserving_options.channel_count);
+  CHECK(
+      act->transfer_rate_limits.send_bytes_per_sec ==
+      exp->transfer_rate_limits.send_bytes_per_sec);
+  CHECK(
+      act->transfer_rate_limits.recv_bytes_per_sec ==
+      exp->transfer_rate_limits.recv_bytes_per_sec);
+  CHECK(act->client_send_delay_us == exp->client_send_delay_us);
+  CHECK(act->client_connections == exp->client_connections);
+  CHECK(act->slowest_request_count == exp->slowest_request_count);
+  CHECK_STRING(act->http_streaming_endpoint, exp->http_streaming_endpoint);
+  CHECK(act->share_nothing == exp->share_nothing);
+  CHECK(act->time_series_interval_ms == exp->time_series_interval_ms);
+  CHECK_STRING(act->request_record_file, exp->request_record_file);
+  CHECK(act->client_stage_times == exp->client_stage_times);
   CHECK(act->zero_input == exp->zero_input);
   CHECK(act->string_length == exp->string_length);
   CHECK_STRING(act->string_data, exp->string_data);
@@ -106,11 +148,125 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->request_distribution == exp->request_distribution);
   CHECK(act->using_custom_intervals == exp->using_custom_intervals);
   CHECK_STRING(act->request_intervals_file, exp->request_intervals_file);
+  CHECK_STRING(act->request_trace_file, exp->request_trace_file);
+  CHECK_STRING(act->schedule_plugin, exp->schedule_plugin);
+  CHECK_STRING(act->schedule_plugin_config, exp->schedule_plugin_config);
+  CHECK_STRING(act->schedule_record_file, exp->schedule_record_file);
+  CHECK_STRING(act->schedule_replay_file, exp->schedule_replay_file);
+  CHECK(
+      act->rate_profile_settings.burst_on_ms ==
+      doctest::Approx(exp->rate_profile_settings.burst_on_ms));
+  CHECK(
+      act->rate_profile_settings.burst_off_ms ==
+      doctest::Approx(exp->rate_profile_settings.burst_off_ms));
+  CHECK(
+      act->rate_profile_settings.mmpp_burst_factor ==
+      doctest::Approx(exp->rate_profile_settings.mmpp_burst_factor));
+  CHECK(
+      act->rate_profile_settings.mmpp_low_ms ==
+      doctest::Approx(exp->rate_profile_settings.mmpp_low_ms));
+  CHECK(
+      act->rate_profile_settings.mmpp_high_ms ==
+      doctest::Approx(exp->rate_profile_settings.mmpp_high_ms));
+  CHECK(
+      act->rate_profile_settings.diurnal_period_s ==
+      doctest::Approx(exp->rate_profile_settings.diurnal_period_s));
+  CHECK(
+      act->rate_profile_settings.diurnal_amplitude ==
+      doctest::Approx(exp->rate_profile_settings.diurnal_amplitude));
+  CHECK(act->precise_scheduling == exp->precise_scheduling);
+  CHECK(act->num_dispatcher_threads == exp->num_dispatcher_threads);
+  CHECK(act->max_inflight_requests == exp->max_inflight_requests);
+  CHECK(act->inflight_overload == exp->inflight_overload);
   CHECK(act->shared_memory_type == exp->shared_memory_type);
   CHECK(act->output_shm_size == exp->output_shm_size);
+  CHECK(act->prestage_inputs == exp->prestage_inputs);
+  CHECK(act->data_prefetch_steps == exp->data_prefetch_steps);
+  CHECK(act->output_tolerance_absolute == exp->output_tolerance_absolute);
+  CHECK(act->output_tolerance_relative == exp->output_tolerance_relative);
+  CHECK(act->validation_threads == exp->validation_threads);
+  CHECK(act->shm_pool_size == exp->shm_pool_size);
+  CHECK(act->output_shm_slots == exp->output_shm_slots);
+  CHECK(act->shm_huge_pages == exp->shm_huge_pages);
+  CHECK(act->shm_prefault == exp->shm_prefault);
+  CHECK(act->shm_persist == exp->shm_persist);
+  CHECK(act->client_cpus == exp->client_cpus);
+  CHECK(act->worker_cpus == exp->worker_cpus);
+  CHECK(act->numa_node == exp->numa_node);
+  CHECK(act->async_continuations == exp->async_continuations);
+  CHECK(act->warm_ramp == exp->warm_ramp);
+  CHECK(act->sequences_per_context == exp->sequences_per_context);
+  CHECK(
+      act->sequence_length_distribution.kind ==
+      exp->sequence_length_distribution.kind);
+  CHECK(
+      act->sequence_length_distribution.mean ==
+      exp->sequence_length_distribution.mean);
+  CHECK(act->sequence_think_time.kind == exp->sequence_think_time.kind);
+  CHECK(act->sequence_think_time.mean == exp->sequence_think_time.mean);
+  CHECK(act->using_sequence_think_time == exp->using_sequence_think_time);
+  CHECK(act->settle_window_ms == exp->settle_window_ms);
+  CHECK(act->warmup_request_count == exp->warmup_request_count);
+  CHECK(act->latency_outlier_factor == exp->latency_outlier_factor);
+  CHECK(act->latency_bucketing == exp->latency_bucketing);
+  CHECK(act->input_shape_count == exp->input_shape_count);
+  REQUIRE(
+      act->input_shape_distributions.size() ==
+      exp->input_shape_distributions.size());
+  for (size_t i = 0; i < act->input_shape_distributions.size(); i++) {
+    const auto& act_dist = act->input_shape_distributions[i];
+    const auto& exp_dist = exp->input_shape_distributions[i];
+    CHECK(act_dist.input_name == exp_dist.input_name);
+    CHECK(act_dist.dimension == exp_dist.dimension);
+    CHECK(act_dist.min == exp_dist.min);
+    CHECK(act_dist.max == exp_dist.max);
+    CHECK(act_dist.distribution.kind == exp_dist.distribution.kind);
+  }
+  CHECK(act->output_memory_policy.kind == exp->output_memory_policy.kind);
+  CHECK(
+      act->output_memory_policy.device_id ==
+      exp->output_memory_policy.device_id);
+  CHECK(act->lazy_model_load == exp->lazy_model_load);
+  CHECK(act->server_request_trace == exp->server_request_trace);
+  CHECK_STRING(act->model_config_cache, exp->model_config_cache);
+  CHECK_STRING(act->client_trace_file, exp->client_trace_file);
+  CHECK(act->client_trace_rate == exp->client_trace_rate);
+  CHECK(act->model_mix.size() == exp->model_mix.size());
+  for (size_t i = 0;
+       i < std::min(act->model_mix.size(), exp->model_mix.size()); i++) {
+    CHECK(act->model_mix[i].model_name == exp->model_mix[i].model_name);
+    CHECK(act->model_mix[i].model_version == exp->model_mix[i].model_version);
+    CHECK(act->model_mix[i].weight == exp->model_mix[i].weight);
+    CHECK(act->model_mix[i].data_stream == exp->model_mix[i].data_stream);
+  }
+  CHECK(act->request_classes.size() == exp->request_classes.size());
+  for (size_t i = 0; i < std::min(
+                         act->request_classes.size(),
+                         exp->request_classes.size());
+       i++) {
+    const RequestClassEntry& act_class = act->request_classes[i];
+    const RequestClassEntry& exp_class = exp->request_classes[i];
+    CHECK(act_class.name == exp_class.name);
+    CHECK(act_class.weight == exp_class.weight);
+    CHECK(act_class.priority == exp_class.priority);
+    CHECK(act_class.server_timeout_us == exp_class.server_timeout_us);
+  }
+  CHECK_STRING(act->baseline_file, exp->baseline_file);
+  CHECK(act->regression_threshold == exp->regression_threshold);
+  CHECK_STRING(act->checkpoint_file, exp->checkpoint_file);
+  CHECK(act->endpoints.size() == exp->endpoints.size());
+  for (size_t i = 0;
+       i < std::min(act->endpoints.size(), exp->endpoints.size()); i++) {
+    CHECK(act->endpoints[i].url == exp->endpoints[i].url);
+    CHECK(act->endpoints[i].weight == exp->endpoints[i].weight);
+  }
+  CHECK(act->endpoint_policy == exp->endpoint_policy);
+  CHECK(act->input_repeat_ratio == exp->input_repeat_ratio);
+  CHECK(act->input_popularity_skew == exp->input_popularity_skew);
   CHECK(act->kind == exp->kind);
   CHECK_STRING(act->model_signature_name, exp->model_signature_name);
   CHECK(act->using_grpc_compression == exp->using_grpc_compression);
+  CHECK(act->using_http_compression == exp->using_http_compression);
   CHECK(act->compression_algorithm == exp->compression_algorithm);
   CHECK(act->measurement_mode == exp->measurement_mode);
   CHECK(act->measurement_request_count == exp->measurement_request_count);
@@ -151,6 +307,10 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
       exp->ssl_options.ssl_https_verify_peer);
   CHECK(act->verbose_csv == exp->verbose_csv);
   CHECK(act->enable_mpi == exp->enable_mpi);
+  CHECK(act->mpi_distributed_load == exp->mpi_distributed_load);
+  CHECK(act->mpi_rank_weights == exp->mpi_rank_weights);
+  CHECK(act->window_alignment_ms == exp->window_alignment_ms);
+  CHECK(act->window_start_time == doctest::Approx(exp->window_start_time));
   CHECK(act->trace_options.size() == exp->trace_options.size());
   CHECK(act->using_old_options == exp->using_old_options);
   CHECK(act->dynamic_concurrency_mode == exp->dynamic_concurrency_mode);
@@ -160,6 +320,10 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK_STRING(act->model_version, exp->model_version);
   CHECK(act->batch_size == exp->batch_size);
   CHECK(act->using_batch_size == exp->using_batch_size);
+  CHECK(act->using_batch_size_range == exp->using_batch_size_range);
+  CHECK(act->batch_size_range.start == exp->batch_size_range.start);
+  CHECK(act->batch_size_range.end == exp->batch_size_range.end);
+  CHECK(act->batch_size_range.step == exp->batch_size_range.step);
   CHECK(act->concurrent_request_count == exp->concurrent_request_count);
   CHECK(act->protocol == exp->protocol);
   CHECK(act->http_headers->size() == exp->http_headers->size());
@@ -242,6 +406,10 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->sequence_length == 20);
   CHECK(params->percentile == -1);
   CHECK(params->user_data.size() == 0);
+  CHECK_STRING("input_corpus_file", params->input_corpus_file, "");
+  CHECK_STRING("experiment_file", params->experiment_file, "");
+  CHECK(params->model_load_iterations == 0);
+  CHECK_STRING("model_load_config_file", params->model_load_config_file, "");
   CHECK(params->input_shapes.size() == 0);
   CHECK(params->measurement_window_ms == 5000);
   CHECK(params->using_concurrency_range == false);
@@ -251,6 +419,11 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->latency_threshold_ms == NO_LIMIT);
   CHECK(params->stability_threshold == doctest::Approx(0.1));
   CHECK(params->max_trials == 10);
+  CHECK(params->early_convergence == false);
+  CHECK_STRING("time_series_file", params->time_series_file, "");
+  CHECK(params->time_series_interval_ms == 1000);
+  CHECK_STRING("request_record_file", params->request_record_file, "");
+  CHECK(params->client_stage_times == false);
   CHECK(params->zero_input == false);
   CHECK(params->string_length == 128);
   CHECK_STRING("string_data", params->string_data, "");
@@ -265,12 +438,63 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->request_distribution == Distribution::CONSTANT);
   CHECK(params->using_custom_intervals == false);
   CHECK_STRING("request_intervals_file", params->request_intervals_file, "");
+  CHECK_STRING("request_trace_file", params->request_trace_file, "");
+  CHECK_STRING("schedule_record_file", params->schedule_record_file, "");
+  CHECK_STRING("schedule_replay_file", params->schedule_replay_file, "");
   CHECK(params->shared_memory_type == NO_SHARED_MEMORY);
   CHECK(params->output_shm_size == 102400);
+  CHECK(params->prestage_inputs == false);
+  CHECK(params->data_prefetch_steps == 0);
+  CHECK(params->output_tolerance_absolute == 0.0);
+  CHECK(params->output_tolerance_relative == 0.0);
+  CHECK(params->validation_threads == 1);
+  CHECK(params->shm_pool_size == 0);
+  CHECK(params->output_shm_slots == 0);
+  CHECK(params->shm_huge_pages == false);
+  CHECK(params->shm_prefault == false);
+  CHECK(params->shm_persist == false);
+  CHECK(params->client_cpus.empty());
+  CHECK(params->worker_cpus.empty());
+  CHECK(params->numa_node == -1);
+  CHECK(params->max_inflight_requests == 0);
+  CHECK(params->inflight_overload == OVERLOAD_DROP);
+  CHECK(params->async_continuations == false);
+  CHECK(params->warm_ramp == false);
+  CHECK(params->sequences_per_context == 1);
+  CHECK(
+      params->sequence_length_distribution.kind ==
+      SequenceDistributionSettings::UNIFORM);
+  CHECK(params->using_sequence_think_time == false);
+  CHECK(params->mpi_distributed_load == false);
+  CHECK(params->mpi_rank_weights.empty());
+  CHECK(params->window_alignment_ms == 0);
+  CHECK(params->window_start_time == 0);
+  CHECK(params->settle_window_ms == 0);
+  CHECK(params->warmup_request_count == 0);
+  CHECK(params->latency_outlier_factor == 0);
+  CHECK(params->latency_bucketing == BUCKET_NONE);
+  CHECK(params->input_shape_distributions.empty());
+  CHECK(params->input_shape_count == 64);
+  CHECK(params->output_memory_policy.kind == cb::OUTPUT_MEMORY_CPU);
+  CHECK(params->output_memory_policy.device_id == 0);
+  CHECK(params->lazy_model_load == false);
+  CHECK(params->server_request_trace == false);
+  CHECK_STRING("model_config_cache", params->model_config_cache, "");
+  CHECK_STRING("client_trace_file", params->client_trace_file, "");
+  CHECK(params->client_trace_rate == 1000);
+  CHECK(params->model_mix.empty());
+  CHECK_STRING("baseline_file", params->baseline_file, "");
+  CHECK(params->regression_threshold == 5.0);
+  CHECK_STRING("checkpoint_file", params->checkpoint_file, "");
+  CHECK(params->endpoints.empty());
+  CHECK(params->endpoint_policy == ENDPOINT_ROUND_ROBIN);
+  CHECK(params->input_repeat_ratio == 0.0);
+  CHECK(params->input_popularity_skew == 1.0);
   CHECK(params->kind == clientbackend::BackendKind::TRITON);
   CHECK_STRING(
       "model_signature_name", params->model_signature_name, "serving_default");
   CHECK(params->using_grpc_compression == false);
+  CHECK(params->using_http_compression == false);
   CHECK(
       params->compression_algorithm ==
       clientbackend::GrpcCompressionAlgorithm::COMPRESS_NONE);
@@ -319,6 +543,7 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK_STRING("model_version", params->model_version, "");
   CHECK(params->batch_size == 1);
   CHECK(params->using_batch_size == false);
+  CHECK(params->using_batch_size_range == false);
   CHECK(params->concurrent_request_count == 1);
   CHECK(params->protocol == clientbackend::ProtocolType::HTTP);
   CHECK(params->http_headers->size() == 0);
@@ -433,6 +658,30 @@ TEST_CASE("Testing Command Line Parser")
 
       exp->streaming = true;
     }
+
+    SUBCASE("with triton_c_api service kind")
+    {
+      int argc = 10;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--streaming",
+                          "--service-kind",
+                          "triton_c_api",
+                          "--triton-server-directory",
+                          "/opt/tritonserver",
+                          "--model-repository",
+                          "/models"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->streaming = true;
+      exp->kind = cb::BackendKind::TRITON_C_API;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->triton_server_path = "/opt/tritonserver";
+      exp->model_repository_path = "/models";
+    }
   }
 
   SUBCASE("Option : --max-threads")
@@ -461,6 +710,36 @@ TEST_CASE("Testing Command Line Parser")
       exp->max_threads_specified = true;
     }
 
+    SUBCASE("set to auto")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,       "-m",   model_name,
+                          "--max-threads", "auto", "--request-rate-range",
+                          "100"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->auto_max_threads = true;
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->max_threads = 4;
+    }
+
+    SUBCASE("auto without request rate")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--max-threads", "auto"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--max-threads=auto only applies to --request-rate-range.");
+
+      check_params = false;
+    }
+
     SUBCASE("missing value")
     {
       int argc = 4;
@@ -1090,6 +1369,67 @@ TEST_CASE("Testing Command Line Parser")
     CHECK_INT_OPTION("--latency-threshold", exp->latency_threshold_ms);
   }
 
+  SUBCASE("Option : --adaptive-search")
+  {
+    SUBCASE("without an end of the range")
+    {
+      int argc = 8;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--concurrency-range",
+                          "1:0:2",
+                          "--latency-threshold",
+                          "50",
+                          "--adaptive-search"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_concurrency_range = true;
+      exp->concurrency_range.start = 1;
+      exp->concurrency_range.end = 0;
+      exp->concurrency_range.step = 2;
+      exp->latency_threshold_ms = 50;
+      exp->search_mode = SearchMode::ADAPTIVE;
+    }
+
+    SUBCASE("without a latency threshold")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-rate-range",
+                          "100:1000", "--adaptive-search"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "The latency threshold can not be 0 for adaptive search mode.");
+
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->request_rate_range[SEARCH_RANGE::kEND] = 1000;
+      exp->max_threads = 4;
+      exp->search_mode = SearchMode::ADAPTIVE;
+    }
+  }
+
+  SUBCASE("Option : --capacity-search")
+  {
+    int argc = 6;
+    char* argv[argc] = {app_name, "-m", model_name, "--concurrency-range",
+                        "1:0:2", "--capacity-search"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->using_concurrency_range = true;
+    exp->concurrency_range.start = 1;
+    exp->concurrency_range.end = 0;
+    exp->concurrency_range.step = 2;
+    exp->search_mode = SearchMode::CAPACITY;
+  }
+
   SUBCASE("Option : --stability-percentage")
   {
     SUBCASE("valid value")
@@ -1158,75 +1498,2632 @@ TEST_CASE("Testing Command Line Parser")
     CHECK_INT_OPTION("--max-trials", exp->max_trials);
   }
 
-  SUBCASE("Option : --collect-metrics")
+  SUBCASE("Option : --early-convergence")
   {
-    SUBCASE("with --service-kind != triton")
+    int argc = 4;
+    char* argv[argc] = {app_name, "-m", model_name, "--early-convergence"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->early_convergence = true;
+  }
+
+  SUBCASE("Option : --precise-scheduling")
+  {
+    int argc = 6;
+    char* argv[argc] = {app_name, "-m", model_name, "--request-rate-range",
+                        "100", "--precise-scheduling"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->using_request_rate_range = true;
+    exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+    exp->max_threads = 4;
+    exp->precise_scheduling = true;
+  }
+
+  SUBCASE("Option : --dispatcher-threads")
+  {
+    int argc = 7;
+    char* argv[argc] = {app_name, "-m", model_name, "--request-rate-range",
+                        "100", "--dispatcher-threads", "2"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->using_request_rate_range = true;
+    exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+    exp->max_threads = 4;
+    exp->num_dispatcher_threads = 2;
+  }
+
+  SUBCASE("Option : --max-inflight-requests")
+  {
+    SUBCASE("request rate mode")
     {
-      int argc = 8;
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--max-inflight-requests",
+                          "8",
+                          "--inflight-overload",
+                          "queue"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->max_threads = 4;
+      exp->max_inflight_requests = 8;
+      exp->inflight_overload = OVERLOAD_QUEUE;
+    }
+
+    SUBCASE("concurrency mode")
+    {
+      int argc = 5;
       char* argv[argc] = {
-          app_name,         "-m",        model_name, "--collect-metrics",
-          "--service-kind", "tfserving", "-i",       "grpc"};
+          app_name, "-m", model_name, "--max-inflight-requests", "8"};
+
       REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
       CHECK(parser.UsageCalled());
       CHECK_STRING(
           "Usage Message", parser.GetUsageMessage(),
-          "Server-side metric collection is only supported with Triton client "
-          "backend.");
+          "--max-inflight-requests only applies to --request-rate-range and "
+          "--request-intervals.");
 
-      exp->kind = cb::BackendKind::TENSORFLOW_SERVING;
-      exp->url = "localhost:8500";
-      exp->batch_size = 0;
-      exp->protocol = cb::ProtocolType::GRPC;
+      exp->max_inflight_requests = 8;
+    }
+
+    SUBCASE("bad overload")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--inflight-overload", "reject"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--inflight-overload must be 'drop' or 'queue'.");
     }
   }
 
-  SUBCASE("Option : --metrics-url")
+  SUBCASE("Option : --request-distribution")
   {
-    // missing --collect-metrics
-    int argc = 5;
-    char* argv[argc] = {app_name, "-m", model_name, "--metrics-url",
-                        "localhost:8002/metrics"};
+    SUBCASE("poisson")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "poisson"};
 
-    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
-    CHECK(parser.UsageCalled());
-    CHECK_STRING(
-        "Usage Message", parser.GetUsageMessage(),
-        "Must specify --collect-metrics when using the --metrics-url option.");
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::POISSON;
+    }
+
+    SUBCASE("bursty with default settings")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "bursty"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::BURSTY;
+    }
+
+    SUBCASE("bursty with settings")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "bursty:on_ms=50,off_ms=450"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::BURSTY;
+      exp->rate_profile_settings.burst_on_ms = 50;
+      exp->rate_profile_settings.burst_off_ms = 450;
+    }
+
+    SUBCASE("mmpp with settings")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "mmpp:burst_factor=4,high_ms=20"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::MMPP;
+      exp->rate_profile_settings.mmpp_burst_factor = 4;
+      exp->rate_profile_settings.mmpp_high_ms = 20;
+    }
+
+    SUBCASE("diurnal with settings")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "diurnal:period_s=30,amplitude=0.9"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_distribution = Distribution::DIURNAL;
+      exp->rate_profile_settings.diurnal_period_s = 30;
+      exp->rate_profile_settings.diurnal_amplitude = 0.9;
+    }
+
+    SUBCASE("setting of another distribution")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "bursty:period_s=30"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported setting 'period_s=30' for request distribution bursty");
+
+      exp->request_distribution = Distribution::BURSTY;
+    }
+
+    SUBCASE("invalid setting value")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "diurnal:amplitude=2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "invalid settings for request distribution diurnal");
+
+      exp->request_distribution = Distribution::DIURNAL;
+      exp->rate_profile_settings.diurnal_amplitude = 2;
+    }
+
+    SUBCASE("unsupported distribution")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--request-distribution",
+                          "gaussian"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported request distribution provided gaussian");
+    }
   }
 
-  SUBCASE("Option : --metrics-interval")
+  SUBCASE("Option : --request-trace")
   {
-    SUBCASE("missing --collect-metrics")
+    SUBCASE("set")
     {
       int argc = 5;
-      char* argv[argc] = {app_name, "-m", model_name, "--metrics-interval",
-                          "1000"};
+      char* argv[argc] = {app_name, "-m", model_name, "--request-trace",
+                          "trace.txt"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_custom_intervals = true;
+      exp->request_trace_file = "trace.txt";
+      exp->max_threads = 4;
+      exp->search_mode = SearchMode::NONE;
+    }
+
+    SUBCASE("with --request-intervals")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-trace",
+                          "trace.txt",
+                          "--request-intervals",
+                          "intervals.txt"};
 
       REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
       CHECK(parser.UsageCalled());
       CHECK_STRING(
           "Usage Message", parser.GetUsageMessage(),
-          "Must specify --collect-metrics when using the --metrics-interval "
-          "option.");
+          "can not use --request-intervals along with --request-trace");
+
+      exp->using_custom_intervals = true;
+      exp->request_trace_file = "trace.txt";
+      exp->max_threads = 4;
+      exp->request_intervals_file = "intervals.txt";
+      exp->search_mode = SearchMode::NONE;
     }
+  }
 
-    SUBCASE("metrics interval 0")
+  SUBCASE("Option : --schedule-replay-file")
+  {
+    SUBCASE("set")
     {
-      int argc = 6;
-      char* argv[argc] = {
-          app_name, "-m", model_name, "--collect-metrics", "--metrics-interval",
-          "0"};
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--schedule-replay-file",
+                          "schedule.bin",
+                          "--schedule-record-file",
+                          "replayed.bin"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_custom_intervals = true;
+      exp->schedule_replay_file = "schedule.bin";
+      exp->schedule_record_file = "replayed.bin";
+      exp->max_threads = 4;
+      exp->search_mode = SearchMode::NONE;
+    }
+
+    SUBCASE("with --request-trace")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--schedule-replay-file",
+                          "schedule.bin",
+                          "--request-trace",
+                          "trace.txt"};
 
       REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
       CHECK(parser.UsageCalled());
       CHECK_STRING(
           "Usage Message", parser.GetUsageMessage(),
-          "Metrics interval must be larger than 0 milliseconds.");
-
+          "can not use --schedule-replay-file along with --request-intervals "
+          "or --request-trace");
+
+      exp->using_custom_intervals = true;
+      exp->schedule_replay_file = "schedule.bin";
+      exp->request_trace_file = "trace.txt";
+      exp->max_threads = 4;
+      exp->search_mode = SearchMode::NONE;
+    }
+  }
+
+  SUBCASE("Option : --schedule-record-file")
+  {
+    SUBCASE("with --concurrency-range")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name,
+                          "--schedule-record-file", "schedule.bin"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--schedule-record-file only applies to --request-rate-range, "
+          "--request-intervals, --request-trace and --schedule-replay-file.");
+
+      exp->schedule_record_file = "schedule.bin";
+    }
+  }
+
+  SUBCASE("Option : --collect-metrics")
+  {
+    SUBCASE("with --service-kind != triton")
+    {
+      int argc = 8;
+      char* argv[argc] = {
+          app_name,         "-m",        model_name, "--collect-metrics",
+          "--service-kind", "tfserving", "-i",       "grpc"};
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Server-side metric collection is only supported with Triton client "
+          "backend.");
+
+      exp->kind = cb::BackendKind::TENSORFLOW_SERVING;
+      exp->url = "localhost:8500";
+      exp->batch_size = 0;
+      exp->protocol = cb::ProtocolType::GRPC;
+    }
+  }
+
+  SUBCASE("Option : --metrics-url")
+  {
+    // missing --collect-metrics
+    int argc = 5;
+    char* argv[argc] = {app_name, "-m", model_name, "--metrics-url",
+                        "localhost:8002/metrics"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(parser.UsageCalled());
+    CHECK_STRING(
+        "Usage Message", parser.GetUsageMessage(),
+        "Must specify --collect-metrics when using the --metrics-url option.");
+  }
+
+  SUBCASE("Option : --metrics-interval")
+  {
+    SUBCASE("missing --collect-metrics")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--metrics-interval",
+                          "1000"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --collect-metrics when using the --metrics-interval "
+          "option.");
+    }
+
+    SUBCASE("metrics interval 0")
+    {
+      int argc = 6;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--collect-metrics", "--metrics-interval",
+          "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Metrics interval must be larger than 0 milliseconds.");
+
       exp->metrics_interval_ms = 0;
     }
   }
 
+  SUBCASE("Option : --metrics-allowlist")
+  {
+    SUBCASE("set families")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--collect-metrics",
+                          "--metrics-allowlist",
+                          "nv_inference_count,,nv_cpu_utilization"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->should_collect_metrics = true;
+      exp->metrics_allowlist = {"nv_inference_count", "nv_cpu_utilization"};
+      exp->metrics_allowlist_specified = true;
+    }
+
+    SUBCASE("missing --collect-metrics")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--metrics-allowlist",
+          "nv_inference_count"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --collect-metrics when using the --metrics-allowlist "
+          "option.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --request-template")
+  {
+    SUBCASE("with http_json service kind")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "http_json",
+                          "--request-template",
+                          "request.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->kind = cb::BackendKind::HTTP_JSON;
+      exp->request_template = "request.json";
+    }
+
+    SUBCASE("missing with http_json service kind")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--service-kind", "http_json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--request-template should be provided when using "
+          "service-kind=http_json.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --null-server")
+  {
+    SUBCASE("all settings")
+    {
+      int argc = 7;
+      char* argv[argc] = {
+          app_name,
+          "-m",
+          model_name,
+          "--service-kind",
+          "null_server",
+          "--null-server",
+          "latency_us=500,max_batch_size=8,batch_delay_us=100,"
+          "instance_count=2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->kind = cb::BackendKind::NULL_SERVER;
+      exp->null_server_options.latency_us = 500;
+      exp->null_server_options.max_batch_size = 8;
+      exp->null_server_options.batch_delay_us = 100;
+      exp->null_server_options.instance_count = 2;
+    }
+
+    SUBCASE("unknown setting")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,        "-m",
+                          model_name,      "--service-kind",
+                          "null_server",   "--null-server",
+                          "latency_ms=10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported setting 'latency_ms=10' for --null-server");
+
+      check_params = false;
+    }
+
+    SUBCASE("negative value")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,          "-m",
+                          model_name,        "--service-kind",
+                          "null_server",     "--null-server",
+                          "latency_us=-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "invalid value in setting 'latency_us=-1' for --null-server");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --tfserving-client")
+  {
+    SUBCASE("all settings")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "tfserving",
+                          "-i",
+                          "grpc",
+                          "--tfserving-client",
+                          "completion_queues=4,channels=2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->kind = cb::BackendKind::TENSORFLOW_SERVING;
+      exp->url = "localhost:8500";
+      exp->batch_size = 0;
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->tfserving_options.completion_queue_count = 4;
+      exp->tfserving_options.channel_count = 2;
+    }
+
+    SUBCASE("unknown setting")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "tfserving",
+                          "-i",
+                          "grpc",
+                          "--tfserving-client",
+                          "queues=4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported setting 'queues=4' for --tfserving-client");
+
+      check_params = false;
+    }
+
+    SUBCASE("negative value")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--service-kind",
+                          "tfserving",
+                          "-i",
+                          "grpc",
+                          "--tfserving-client",
+                          "channels=-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "invalid value in setting 'channels=-1' for --tfserving-client");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --client-network")
+  {
+    SUBCASE("all settings")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--client-network",
+          "upload_bytes_per_sec=65536,download_bytes_per_sec=32768,"
+          "send_delay_us=200"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->transfer_rate_limits.send_bytes_per_sec = 65536;
+      exp->transfer_rate_limits.recv_bytes_per_sec = 32768;
+      exp->client_send_delay_us = 200;
+    }
+
+    SUBCASE("send delay with gRPC")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,           "-m",   model_name,
+                          "--client-network", "send_delay_us=50",
+                          "-i",               "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+      exp->client_send_delay_us = 50;
+    }
+
+    SUBCASE("rate limit with gRPC")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,           "-m",
+                          model_name,         "--client-network",
+                          "upload_bytes_per_sec=1024",
+                          "-i",               "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "the upload and download rates of --client-network are only "
+          "allowed with the triton service kind and the HTTP protocol");
+
+      check_params = false;
+    }
+
+    SUBCASE("unknown setting")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--client-network",
+                          "upload_kbps=10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported setting 'upload_kbps=10' for --client-network");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --client-connections")
+  {
+    SUBCASE("shared clients")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--client-connections", "4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->client_connections = 4;
+    }
+
+    SUBCASE("zero clients")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--client-connections", "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--client-connections must be > 0");
+
+      check_params = false;
+    }
+
+    SUBCASE("with streaming")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,      "-m",
+                          model_name,    "--streaming",
+                          "--client-connections", "2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--client-connections is not supported with --streaming.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --slowest-requests")
+  {
+    SUBCASE("count")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--slowest-requests", "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->slowest_request_count = 10;
+    }
+
+    SUBCASE("zero count")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--slowest-requests", "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--slowest-requests must be > 0");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --http-streaming-endpoint")
+  {
+    SUBCASE("generate_stream")
+    {
+      int argc = 6;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--streaming",
+          "--http-streaming-endpoint", "generate_stream"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->streaming = true;
+      exp->http_streaming_endpoint = "generate_stream";
+    }
+
+    SUBCASE("unsupported endpoint")
+    {
+      int argc = 6;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--streaming",
+          "--http-streaming-endpoint", "infer"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported --http-streaming-endpoint 'infer', the only "
+          "supported endpoint is generate_stream");
+
+      check_params = false;
+    }
+
+    SUBCASE("without streaming")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--http-streaming-endpoint",
+          "generate_stream"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--http-streaming-endpoint requires --streaming");
+
+      check_params = false;
+    }
+
+    SUBCASE("with grpc")
+    {
+      int argc = 8;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "-i", "grpc", "--streaming",
+          "--http-streaming-endpoint", "generate_stream"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--http-streaming-endpoint only applies to HTTP protocol with "
+          "service-kind=triton");
+
+      check_params = false;
+    }
+
+    SUBCASE("with shared memory")
+    {
+      int argc = 8;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--streaming",
+          "--http-streaming-endpoint", "generate_stream", "--shared-memory",
+          "system"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--http-streaming-endpoint does not support --shared-memory, the "
+          "inputs are sent as JSON values");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --schedule-plugin")
+  {
+    SUBCASE("with config")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--schedule-plugin",
+                          "libtraffic.so",
+                          "--schedule-plugin-config",
+                          "model.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_request_rate_range = true;
+      exp->request_rate_range[SEARCH_RANGE::kSTART] = 100;
+      exp->max_threads = 4;
+      exp->schedule_plugin = "libtraffic.so";
+      exp->schedule_plugin_config = "model.json";
+    }
+
+    SUBCASE("without request rate")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--schedule-plugin",
+                          "libtraffic.so"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--schedule-plugin only applies to --request-rate-range.");
+
+      check_params = false;
+    }
+
+    SUBCASE("config without plugin")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-rate-range",
+                          "100",
+                          "--schedule-plugin-config",
+                          "model.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--schedule-plugin-config requires --schedule-plugin.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --share-nothing")
+  {
+    SUBCASE("a thread per worker CPU")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,        "-m",  model_name,
+                          "--share-nothing", "--worker-cpus", "0-2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->share_nothing = true;
+      exp->worker_cpus = {0, 1, 2};
+      exp->max_threads = 3;
+    }
+
+    SUBCASE("max threads given")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,          "-m", model_name,
+                          "--share-nothing", "--max-threads", "2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->share_nothing = true;
+      exp->max_threads = 2;
+      exp->max_threads_specified = true;
+    }
+
+    SUBCASE("with shared clients")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,          "-m",
+                          model_name,        "--share-nothing",
+                          "--client-connections", "2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--share-nothing is not supported with --client-connections.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --time-series-file")
+  {
+    SUBCASE("set file and interval")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,      "-m",
+                          model_name,    "--time-series-file",
+                          "series.csv",  "--time-series-interval",
+                          "250"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->time_series_file = "series.csv";
+      exp->time_series_interval_ms = 250;
+    }
+
+    SUBCASE("time series interval 0")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,      "-m",
+                          model_name,    "--time-series-file",
+                          "series.csv",  "--time-series-interval",
+                          "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Time series interval must be larger than 0 milliseconds.");
+
+      exp->time_series_file = "series.csv";
+      exp->time_series_interval_ms = 0;
+    }
+  }
+
+  SUBCASE("Option : --request-record-file")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--request-record-file", "records.bin"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->request_record_file = "records.bin";
+  }
+
+  SUBCASE("Option : --client-stage-times")
+  {
+    int argc = 4;
+    char* argv[argc] = {app_name, "-m", model_name, "--client-stage-times"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->client_stage_times = true;
+  }
+
+  SUBCASE("Option : --client-trace-file")
+  {
+    int argc = 7;
+    char* argv[argc] = {app_name,
+                        "-m",
+                        model_name,
+                        "--client-trace-file",
+                        "trace.json",
+                        "--client-trace-rate",
+                        "10"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->client_trace_file = "trace.json";
+    exp->client_trace_rate = 10;
+  }
+
+  SUBCASE("Option : --client-trace-rate")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--client-trace-rate", "0"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(parser.UsageCalled());
+    CHECK_STRING(
+        "Usage Message", parser.GetUsageMessage(),
+        "--client-trace-rate must be greater than 0.");
+
+    exp->client_trace_rate = 0;
+  }
+
+  SUBCASE("Option : --write-input-corpus")
+  {
+    SUBCASE("with input data")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--data-directory",
+                          "/usr/data",
+                          "--write-input-corpus",
+                          "/tmp/corpus.bin"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->user_data.push_back("/usr/data");
+      exp->input_corpus_file = "/tmp/corpus.bin";
+    }
+
+    SUBCASE("without input data")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--write-input-corpus",
+                          "/tmp/corpus.bin"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --input-data with a directory or json file when "
+          "using the --write-input-corpus option.");
+
+      exp->input_corpus_file = "/tmp/corpus.bin";
+    }
+  }
+
+  SUBCASE("Option : --prestage-inputs")
+  {
+    SUBCASE("without shared memory")
+    {
+      int argc = 4;
+      char* argv[argc] = {app_name, "-m", model_name, "--prestage-inputs"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->prestage_inputs = true;
+    }
+
+    SUBCASE("with shared memory")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,          "-m",
+                          model_name,        "--prestage-inputs",
+                          "--shared-memory", "system"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Cannot use --prestage-inputs with --shared-memory.");
+
+      exp->prestage_inputs = true;
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+    }
+  }
+
+  SUBCASE("Option : --data-prefetch-steps")
+  {
+    SUBCASE("with a data directory")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,       "-m",   model_name,
+                          "--input-data", "/tmp", "--data-prefetch-steps",
+                          "64"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->user_data = {"/tmp"};
+      exp->data_prefetch_steps = 64;
+    }
+
+    SUBCASE("without input data")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--data-prefetch-steps", "64"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --input-data with a single directory when using the "
+          "--data-prefetch-steps option.");
+
+      exp->data_prefetch_steps = 64;
+    }
+
+    SUBCASE("with prestaged inputs")
+    {
+      int argc = 8;
+      char* argv[argc] = {app_name,       "-m",
+                          model_name,     "--input-data",
+                          "/tmp",         "--data-prefetch-steps",
+                          "64",           "--prestage-inputs"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Cannot use --data-prefetch-steps with --prestage-inputs.");
+
+      exp->user_data = {"/tmp"};
+      exp->data_prefetch_steps = 64;
+      exp->prestage_inputs = true;
+    }
+  }
+
+  SUBCASE("Option : --output-tolerance")
+  {
+    SUBCASE("absolute")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-tolerance", "0.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->output_tolerance_absolute = 0.5;
+    }
+
+    SUBCASE("absolute and relative")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-tolerance", "0.5,0.25"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->output_tolerance_absolute = 0.5;
+      exp->output_tolerance_relative = 0.25;
+    }
+
+    SUBCASE("negative")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-tolerance", "0,-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--output-tolerance must not be negative.");
+
+      exp->output_tolerance_relative = -1;
+    }
+  }
+
+  SUBCASE("Option : --validation-threads")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--validation-threads", "0"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->validation_threads = 0;
+  }
+
+  SUBCASE("Option : --model-load-iterations")
+  {
+    SUBCASE("with a config")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--model-load-iterations",
+                          "10",
+                          "--model-load-config",
+                          "/tmp/config.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->model_load_iterations = 10;
+      exp->model_load_config_file = "/tmp/config.json";
+    }
+
+    SUBCASE("config without iterations")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--model-load-config",
+          "/tmp/config.json"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->model_load_config_file = "/tmp/config.json";
+    }
+  }
+
+  SUBCASE("Option : --http-compression-algorithm")
+  {
+    SUBCASE("with HTTP")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--http-compression-algorithm", "gzip"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_http_compression = true;
+      exp->compression_algorithm = cb::COMPRESS_GZIP;
+    }
+
+    SUBCASE("with gRPC")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,   "-m",
+                          model_name, "--http-compression-algorithm",
+                          "deflate",  "-i",
+                          "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--http-compression-algorithm is only allowed with the triton "
+          "service kind and the HTTP protocol");
+
+      exp->using_http_compression = true;
+      exp->compression_algorithm = cb::COMPRESS_DEFLATE;
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+    }
+
+    SUBCASE("unsupported algorithm")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--http-compression-algorithm", "zstd"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported --http-compression-algorithm specified");
+
+      exp->using_http_compression = true;
+    }
+  }
+
+  SUBCASE("Option : --shared-memory-pool-size")
+  {
+    SUBCASE("with shared memory")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--shared-memory",
+                          "system",
+                          "--shared-memory-pool-size",
+                          "16"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+      exp->shm_pool_size = 16;
+    }
+
+    SUBCASE("without shared memory")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--shared-memory-pool-size", "16"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --shared-memory when using the "
+          "--shared-memory-pool-size option.");
+
+      exp->shm_pool_size = 16;
+    }
+  }
+
+  SUBCASE("Option : --output-shared-memory-slots")
+  {
+    SUBCASE("with shared memory")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--shared-memory",
+                          "system",
+                          "--output-shared-memory-slots",
+                          "8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+      exp->output_shm_slots = 8;
+    }
+
+    SUBCASE("without shared memory")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-shared-memory-slots", "8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --shared-memory when using the "
+          "--output-shared-memory-slots option.");
+
+      exp->output_shm_slots = 8;
+    }
+  }
+
+  SUBCASE("Option : --shared-memory-huge-pages")
+  {
+    SUBCASE("with system shared memory")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,   "-m",
+                          model_name, "--shared-memory",
+                          "system",   "--shared-memory-huge-pages"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+      exp->shm_huge_pages = true;
+    }
+
+    SUBCASE("without shared memory")
+    {
+      int argc = 4;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--shared-memory-huge-pages"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Must specify --shared-memory system when using the "
+          "--shared-memory-huge-pages or --shared-memory-prefault options.");
+
+      exp->shm_huge_pages = true;
+    }
+  }
+
+  SUBCASE("Option : --shared-memory-prefault")
+  {
+    int argc = 6;
+    char* argv[argc] = {app_name,   "-m",
+                        model_name, "--shared-memory",
+                        "system",   "--shared-memory-prefault"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+    exp->shm_prefault = true;
+  }
+
+  SUBCASE("Option : --shared-memory-persist")
+  {
+    SUBCASE("with system shared memory")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,   "-m",
+                          model_name, "--shared-memory",
+                          "system",   "--shared-memory-persist"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+      exp->shm_persist = true;
+    }
+
+    SUBCASE("with cuda shared memory")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,   "-m",
+                          model_name, "--shared-memory",
+                          "cuda",     "--shared-memory-persist"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--shared-memory-persist only applies to --shared-memory system "
+          "with service-kind=triton.");
+
+      exp->shared_memory_type = CUDA_SHARED_MEMORY;
+      exp->shm_persist = true;
+    }
+
+    SUBCASE("with a shared memory pool")
+    {
+      int argc = 8;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--shared-memory",
+                          "system",
+                          "--shared-memory-pool-size",
+                          "4",
+                          "--shared-memory-persist"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--shared-memory-persist can not be used with "
+          "--shared-memory-pool-size.");
+
+      exp->shared_memory_type = SYSTEM_SHARED_MEMORY;
+      exp->shm_pool_size = 4;
+      exp->shm_persist = true;
+    }
+  }
+
+  SUBCASE("Option : --client-cpus")
+  {
+    SUBCASE("valid list")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--client-cpus", "0-2,8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->client_cpus = {0, 1, 2, 8};
+    }
+
+    SUBCASE("invalid list")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--client-cpus", "2-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --client-cpus: invalid CPU range '2-1' in CPU "
+          "list '2-1'");
+    }
+  }
+
+  SUBCASE("Option : --worker-cpus")
+  {
+    SUBCASE("valid list")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--worker-cpus", "4,5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->worker_cpus = {4, 5};
+    }
+
+    SUBCASE("invalid list")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--worker-cpus", ""};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --worker-cpus: empty CPU list");
+    }
+  }
+
+  SUBCASE("Option : --numa-node")
+  {
+    SUBCASE("valid node")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--numa-node", "1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->numa_node = 1;
+    }
+
+    SUBCASE("negative node")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--numa-node", "-2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--numa-node must be >= 0");
+
+      exp->numa_node = -2;
+    }
+  }
+
+  SUBCASE("Option : --async-continuations")
+  {
+    SUBCASE("concurrency mode")
+    {
+      int argc = 4;
+      char* argv[argc] = {app_name, "-m", model_name, "--async-continuations"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->async_continuations = true;
+    }
+
+    SUBCASE("with sync")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--async-continuations", "--sync"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Cannot use --async-continuations with --sync.");
+
+      exp->async_continuations = true;
+      exp->forced_sync = true;
+    }
+
+    SUBCASE("request rate mode")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--async-continuations",
+                          "--request-rate-range",
+                          "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--async-continuations only applies to --concurrency-range.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --warm-ramp")
+  {
+    SUBCASE("concurrency mode")
+    {
+      int argc = 4;
+      char* argv[argc] = {app_name, "-m", model_name, "--warm-ramp"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->warm_ramp = true;
+    }
+
+    SUBCASE("request rate mode")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,    "-m", model_name,
+                          "--warm-ramp", "--request-rate-range", "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--warm-ramp only applies to --concurrency-range.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --sequences-per-context")
+  {
+    SUBCASE("concurrency mode")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequences-per-context", "8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->sequences_per_context = 8;
+    }
+
+    SUBCASE("zero sequences")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequences-per-context", "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequences-per-context must be > 0");
+
+      check_params = false;
+    }
+
+    SUBCASE("request rate mode")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--sequences-per-context",
+                          "8",
+                          "--request-rate-range",
+                          "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequences-per-context only applies to --concurrency-range.");
+
+      check_params = false;
+    }
+
+    SUBCASE("with --warm-ramp")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,      "-m",
+                          model_name,    "--sequences-per-context",
+                          "8",           "--warm-ramp"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequences-per-context cannot be combined with --warm-ramp.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --sequence-length-distribution")
+  {
+    SUBCASE("lognormal lengths")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequence-length-distribution",
+          "lognormal:mean=30"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->sequence_length_distribution.kind =
+          SequenceDistributionSettings::LOGNORMAL;
+      exp->sequence_length_distribution.mean = 30;
+    }
+
+    SUBCASE("unsupported distribution")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequence-length-distribution",
+          "gamma"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --sequence-length-distribution: unsupported "
+          "distribution 'gamma'");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --mpi-distributed-load")
+  {
+    SUBCASE("without --enable-mpi")
+    {
+      int argc = 4;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--mpi-distributed-load"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--mpi-distributed-load requires --enable-mpi.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --mpi-rank-weights")
+  {
+    SUBCASE("without --mpi-distributed-load")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--mpi-rank-weights", "2,1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--mpi-rank-weights only applies to --mpi-distributed-load.");
+
+      check_params = false;
+    }
+
+    SUBCASE("invalid weights")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--mpi-rank-weights", "2,0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --mpi-rank-weights: invalid rank weight '0', "
+          "weights must be positive numbers");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --window-alignment")
+  {
+    SUBCASE("with a start time")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,           "-m",
+                          model_name,         "--window-alignment",
+                          "1000",             "--window-start-time",
+                          "1700000000.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->window_alignment_ms = 1000;
+      exp->window_start_time = 1700000000.5;
+    }
+
+    SUBCASE("with count windows")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,           "-m",
+                          model_name,         "--window-alignment",
+                          "1000",             "--measurement-mode",
+                          "count_windows"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--window-alignment only supports "
+          "--measurement-mode=time_windows.");
+
+      check_params = false;
+    }
+
+    SUBCASE("start time without alignment")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--window-start-time", "1700000000"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--window-start-time requires --window-alignment.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --sequence-think-time")
+  {
+    SUBCASE("exponential think times")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequence-think-time",
+          "exponential:mean=200"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->sequence_think_time.kind =
+          SequenceDistributionSettings::EXPONENTIAL;
+      exp->sequence_think_time.mean = 200;
+      exp->using_sequence_think_time = true;
+    }
+
+    SUBCASE("uniform think times")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequence-think-time", "uniform"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequence-think-time does not support uniform distributions.");
+
+      check_params = false;
+    }
+
+    SUBCASE("no mean")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--sequence-think-time", "constant"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequence-think-time needs a mean, such as "
+          "\"constant:mean=100\".");
+
+      check_params = false;
+    }
+
+    SUBCASE("request rate mode")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--sequence-think-time",
+                          "constant:mean=100",
+                          "--request-rate-range",
+                          "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequence-think-time only applies to --concurrency-range.");
+
+      check_params = false;
+    }
+
+    SUBCASE("with --async-continuations")
+    {
+      int argc = 6;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--sequence-think-time",
+                          "constant:mean=100",
+                          "--async-continuations"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--sequence-think-time cannot be combined with "
+          "--async-continuations.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --settle-window")
+  {
+    int argc = 5;
+    char* argv[argc] = {app_name, "-m", model_name, "--settle-window", "500"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->settle_window_ms = 500;
+  }
+
+  SUBCASE("Option : --warmup-request-count")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--warmup-request-count", "100"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->warmup_request_count = 100;
+  }
+
+  SUBCASE("Option : --latency-outlier-factor")
+  {
+    SUBCASE("valid factor")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-outlier-factor", "10"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->latency_outlier_factor = 10;
+    }
+
+    SUBCASE("factor not above 1")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-outlier-factor", "0.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--latency-outlier-factor must be 0 or greater than 1.");
+
+      exp->latency_outlier_factor = 0.5;
+    }
+  }
+
+  SUBCASE("Option : --latency-buckets")
+  {
+    SUBCASE("by data stream")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-buckets", "stream"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->latency_bucketing = BUCKET_DATA_STREAM;
+    }
+
+    SUBCASE("by input shape")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-buckets", "shape"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->latency_bucketing = BUCKET_INPUT_SHAPE;
+    }
+
+    SUBCASE("by model")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-buckets", "model"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->latency_bucketing = BUCKET_MODEL;
+    }
+
+    SUBCASE("unknown bucketing")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--latency-buckets", "batch"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--latency-buckets must be 'stream', 'shape' or 'model'.");
+    }
+  }
+
+  SUBCASE("Option : --input-shape-distribution")
+  {
+    SUBCASE("two distributions")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--input-shape-distribution",
+                          "INPUT0:0:16:512:lognormal",
+                          "--input-shape-distribution",
+                          "INPUT1:1:1:4",
+                          "--input-shape-count",
+                          "8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      ShapeDistributionSettings first;
+      first.input_name = "INPUT0";
+      first.dimension = 0;
+      first.min = 16;
+      first.max = 512;
+      first.distribution.kind = SequenceDistributionSettings::LOGNORMAL;
+      ShapeDistributionSettings second;
+      second.input_name = "INPUT1";
+      second.dimension = 1;
+      second.min = 1;
+      second.max = 4;
+      exp->input_shape_distributions = {first, second};
+      exp->input_shape_count = 8;
+    }
+
+    SUBCASE("missing bounds")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--input-shape-distribution",
+          "INPUT0:0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --input-shape-distribution: expected '<input "
+          "name>:<dimension>:<min>:<max>[:<distribution>]', got 'INPUT0:0'");
+
+      ShapeDistributionSettings settings;
+      settings.input_name = "";
+      exp->input_shape_distributions = {settings};
+    }
+
+    SUBCASE("no shapes")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--input-shape-count", "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--input-shape-count must be greater than 0.");
+
+      exp->input_shape_count = 0;
+    }
+  }
+
+  SUBCASE("Option : --experiment-file")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--experiment-file",
+        "/tmp/experiment.json"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->experiment_file = "/tmp/experiment.json";
+  }
+
+  SUBCASE("Option : --output-memory")
+  {
+    SUBCASE("preferred with triton_c_api service kind")
+    {
+      int argc = 11;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--output-memory",
+                          "preferred",
+                          "--service-kind",
+                          "triton_c_api",
+                          "--triton-server-directory",
+                          "/opt/tritonserver",
+                          "--model-repository",
+                          "/models"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->output_memory_policy.kind = cb::OUTPUT_MEMORY_PREFERRED;
+      exp->kind = cb::BackendKind::TRITON_C_API;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->triton_server_path = "/opt/tritonserver";
+      exp->model_repository_path = "/models";
+    }
+
+    SUBCASE("triton service kind")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-memory", "preferred"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--output-memory only applies to service-kind=triton_c_api.");
+
+      check_params = false;
+    }
+
+    SUBCASE("unsupported type")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-memory", "disk"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "unsupported --output-memory type provided: 'disk'. Choices are "
+          "'cpu', 'cpu_pinned', 'gpu[:<device id>]' or 'preferred'.");
+
+      check_params = false;
+    }
+
+    SUBCASE("device id of host memory")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--output-memory", "cpu:1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "only --output-memory=gpu takes a device id: 'cpu:1'.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --model-mix")
+  {
+    SUBCASE("names, versions and weights")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--model-mix", "a=3,b:2,c:1=0.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->model_mix = {{"a", "", 3}, {"b", "2", 1}, {"c", "1", 0.5}};
+    }
+
+    SUBCASE("workload file")
+    {
+      char path[] = "/tmp/model_mix_XXXXXX";
+      int fd = mkstemp(path);
+      REQUIRE(fd != -1);
+      const std::string contents =
+          "# models sharing the GPU\na=3@1\n\n  b:2  # the default weight\n";
+      REQUIRE(
+          write(fd, contents.data(), contents.size()) ==
+          static_cast<ssize_t>(contents.size()));
+      close(fd);
+
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--model-mix", path};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+      unlink(path);
+
+      exp->model_mix = {{"a", "", 3, 1}, {"b", "2", 1}};
+    }
+
+    SUBCASE("invalid weight")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--model-mix", "a=-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --model-mix: invalid weight in model mix: 'a=-1', "
+          "weights must be positive numbers");
+
+      check_params = false;
+    }
+
+    SUBCASE("with --service-kind != triton")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,      "-m",          model_name,
+                          "--model-mix", "a",           "--service-kind",
+                          "tfserving",   "-i",          "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--model-mix only applies to service-kind=triton and "
+          "service-kind=triton_c_api.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --request-classes")
+  {
+    SUBCASE("priorities, timeouts and weights")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-classes",
+          "premium:1=1,bulk:2:50000=4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->request_classes = {{"premium", 1, 1}, {"bulk", 4, 2, 50000}};
+    }
+
+    SUBCASE("invalid timeout")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--request-classes", "a:1:x"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --request-classes: invalid timeout in request "
+          "classes: 'a:1:x', timeouts must be non-negative integers");
+
+      check_params = false;
+    }
+
+    SUBCASE("with --service-kind != triton")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--request-classes",
+                          "a",
+                          "--service-kind",
+                          "tfserving",
+                          "-i",
+                          "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--request-classes only applies to service-kind=triton and "
+          "service-kind=triton_c_api.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --baseline")
+  {
+    SUBCASE("with a regression threshold")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,     "-m",
+                          model_name,   "--baseline",
+                          "before.csv", "--regression-threshold",
+                          "2.5"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->baseline_file = "before.csv";
+      exp->regression_threshold = 2.5;
+    }
+
+    SUBCASE("negative regression threshold")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,     "-m",
+                          model_name,   "--baseline",
+                          "before.csv", "--regression-threshold",
+                          "-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--regression-threshold must not be negative.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --checkpoint-file")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--checkpoint-file", "sweep.ckpt"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->checkpoint_file = "sweep.ckpt";
+  }
+
+  SUBCASE("Option : --endpoints")
+  {
+    SUBCASE("urls, weights and policy")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--endpoints",
+                          "replica-0:8000=2,replica-1:8000",
+                          "--endpoint-policy",
+                          "affinity"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->endpoints = {{"replica-0:8000", 2}, {"replica-1:8000", 1}};
+      exp->endpoint_policy = ENDPOINT_AFFINITY;
+      exp->url_specified = true;
+      exp->url = "replica-0:8000";
+    }
+
+    SUBCASE("with -u")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,     "-m",          model_name,
+                          "-u",         "host:8000",   "--endpoints",
+                          "a:8000,b:8000"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Cannot specify both -u and --endpoints.");
+
+      check_params = false;
+    }
+
+    SUBCASE("invalid weight")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--endpoints", "a:8000=0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "failed to parse --endpoints: invalid weight in endpoints: "
+          "'a:8000=0', weights must be positive numbers");
+
+      check_params = false;
+    }
+
+    SUBCASE("invalid policy")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,      "-m",          model_name,
+                          "--endpoints", "a:8000",      "--endpoint-policy",
+                          "random"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--endpoint-policy must be 'round_robin', 'affinity' or "
+          "'weighted'.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --input-repeat-ratio")
+  {
+    SUBCASE("ratio and skew")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--input-repeat-ratio",
+                          "0.6",
+                          "--input-popularity-skew",
+                          "1.2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->input_repeat_ratio = 0.6;
+      exp->input_popularity_skew = 1.2;
+    }
+
+    SUBCASE("ratio of 1")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--input-repeat-ratio", "1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--input-repeat-ratio must be in [0, 1).");
+
+      check_params = false;
+    }
+
+    SUBCASE("negative skew")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--input-popularity-skew", "-1"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--input-popularity-skew must not be negative.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --batch-size-range")
+  {
+    SUBCASE("start, end and step")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--batch-size-range", "2:16:2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_batch_size_range = true;
+      exp->batch_size_range = {2, 16, 2};
+      exp->batch_size = 2;
+    }
+
+    SUBCASE("default step")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--batch-size-range", "1:4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->using_batch_size_range = true;
+      exp->batch_size_range = {1, 4, 1};
+    }
+
+    SUBCASE("end below start")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--batch-size-range", "8:4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--batch-size-range must have 0 < start <= end and step > 0.");
+
+      check_params = false;
+    }
+
+    SUBCASE("with -b")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name,          "-b",
+                          "4",      "--batch-size-range", "1:8"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Cannot specify both -b and --batch-size-range.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --model-config-cache")
+  {
+    int argc = 5;
+    char* argv[argc] = {
+        app_name, "-m", model_name, "--model-config-cache", "/tmp/configs"};
+
+    REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+    CHECK(!parser.UsageCalled());
+
+    exp->model_config_cache = "/tmp/configs";
+  }
+
+  SUBCASE("Option : --lazy-model-load")
+  {
+    SUBCASE("with triton_c_api service kind")
+    {
+      int argc = 10;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--lazy-model-load",
+                          "--service-kind",
+                          "triton_c_api",
+                          "--triton-server-directory",
+                          "/opt/tritonserver",
+                          "--model-repository",
+                          "/models"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->lazy_model_load = true;
+      exp->kind = cb::BackendKind::TRITON_C_API;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->triton_server_path = "/opt/tritonserver";
+      exp->model_repository_path = "/models";
+    }
+
+    SUBCASE("triton service kind")
+    {
+      int argc = 4;
+      char* argv[argc] = {app_name, "-m", model_name, "--lazy-model-load"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--lazy-model-load only applies to service-kind=triton_c_api.");
+
+      check_params = false;
+    }
+  }
+
+  SUBCASE("Option : --server-request-trace")
+  {
+    SUBCASE("with triton_c_api service kind")
+    {
+      int argc = 10;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "--server-request-trace",
+                          "--service-kind",
+                          "triton_c_api",
+                          "--triton-server-directory",
+                          "/opt/tritonserver",
+                          "--model-repository",
+                          "/models"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->server_request_trace = true;
+      exp->kind = cb::BackendKind::TRITON_C_API;
+      exp->protocol = cb::ProtocolType::UNKNOWN;
+      exp->triton_server_path = "/opt/tritonserver";
+      exp->model_repository_path = "/models";
+    }
+
+    SUBCASE("triton service kind")
+    {
+      int argc = 4;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--server-request-trace"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--server-request-trace only applies to "
+          "service-kind=triton_c_api.");
+
+      check_params = false;
+    }
+  }
+
   if (check_params) {
     CHECK_PARAMS(act, exp);
   }
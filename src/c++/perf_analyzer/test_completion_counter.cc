@@ -0,0 +1,74 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <thread>
+#include <vector>
+#include "completion_counter.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("completion_counter: counts increments")
+{
+  CompletionCounter counter;
+  CHECK(counter.Count() == 0);
+  counter.Increment();
+  counter.Increment();
+  CHECK(counter.Count() == 2);
+}
+
+TEST_CASE("completion_counter: wait")
+{
+  CompletionCounter counter;
+  counter.Increment();
+
+  SUBCASE("target already reached")
+  {
+    CHECK(counter.WaitFor(1, std::chrono::seconds(10)));
+  }
+  SUBCASE("timeout")
+  {
+    CHECK(!counter.WaitFor(2, std::chrono::milliseconds(10)));
+  }
+  SUBCASE("target reached by other threads")
+  {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+      threads.emplace_back([&counter]() {
+        for (size_t i = 0; i < 1000; i++) {
+          counter.Increment();
+        }
+      });
+    }
+    CHECK(counter.WaitFor(4001, std::chrono::seconds(10)));
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(counter.Count() == 4001);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -24,6 +24,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -68,7 +69,9 @@ class TestConcurrencyManager : public TestLoadManagerBase,
         id, thread_stat, thread_config, parser_, data_loader_, factory_,
         on_sequence_model_, async_, max_concurrency_, using_json_data_,
         streaming_, batch_size_, threads_config_, wake_signal_, wake_mutex_,
-        active_threads_, execute_, infer_data_manager_, sequence_manager_);
+        active_threads_, execute_, infer_data_manager_, sequence_manager_,
+        async_continuations_, warm_ramp_, sequences_per_context_,
+        sequence_think_time_);
 
     if (use_mock_infer_) {
       EXPECT_CALL(*worker, Infer())
@@ -80,6 +83,14 @@ class TestConcurrencyManager : public TestLoadManagerBase,
 
   void StopWorkerThreads() { LoadManager::StopWorkerThreads(); }
 
+  cb::Error PrepareContexts(
+      size_t concurrent_request_count,
+      std::vector<std::vector<std::unique_ptr<cb::ClientBackend>>>* backends)
+  {
+    return ConcurrencyManager::PrepareContexts(
+        concurrent_request_count, backends);
+  }
+
   /// Test that the correct Infer function is called in the backend
   ///
   void TestInferType()
@@ -169,6 +180,35 @@ class TestConcurrencyManager : public TestLoadManagerBase,
     CheckSequences(concurrency2);
   }
 
+  /// Test that warm ramps reach each concurrency level without pausing the
+  /// workers
+  ///
+  void TestWarmRamp(const std::vector<size_t>& levels)
+  {
+    stats_->SetDelays({50});
+
+    for (auto level : levels) {
+      ChangeConcurrencyLevel(level);
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+      CheckConcurrency(level);
+      for (auto& thread_config : threads_config_) {
+        CHECK(!thread_config->is_paused_);
+      }
+    }
+
+    StopWorkerThreads();
+    CHECK(stats_->num_active_infer_calls == 0);
+
+    if (on_sequence_model_) {
+      // Retired contexts do not leave their sequences open, and no two
+      // contexts share a sequence
+      auto max_level = *std::max_element(levels.begin(), levels.end());
+      CHECK(stats_->sequence_status.live_seq_ids_to_length.size() == 0);
+      CHECK(stats_->sequence_status.max_live_seq_count == max_level);
+    }
+  }
+
   /// Test that tries to find deadlocks and livelocks
   ///
   void TestTimeouts()
@@ -210,14 +250,16 @@ class TestConcurrencyManager : public TestLoadManagerBase,
  private:
   bool use_mock_infer_{false};
 
-  void CheckConcurrency()
+  void CheckConcurrency() { CheckConcurrency(params_.max_concurrency); }
+
+  void CheckConcurrency(size_t concurrency)
   {
-    if (params_.max_concurrency < 4) {
-      CHECK(stats_->num_active_infer_calls == params_.max_concurrency);
+    if (concurrency < 4) {
+      CHECK(stats_->num_active_infer_calls == concurrency);
     } else {
       CHECK(
           stats_->num_active_infer_calls ==
-          doctest::Approx(params_.max_concurrency).epsilon(0.25));
+          doctest::Approx(concurrency).epsilon(0.25));
     }
   }
 
@@ -386,6 +428,151 @@ TEST_CASE("concurrency_concurrency")
   tcm.TestConcurrency(response_delay, sleep_time);
 }
 
+/// Check that callbacks sending the next request of their context maintain
+/// the concurrency
+///
+TEST_CASE("concurrency_async_continuations")
+{
+  PerfAnalyzerParameters params{};
+  params.async = true;
+  params.streaming = false;
+  params.max_threads = 1;
+
+  SUBCASE("1 concurrency") { params.max_concurrency = 1; }
+  SUBCASE("3 concurrency") { params.max_concurrency = 3; }
+
+  TestConcurrencyManager tcm(params);
+  tcm.EnableAsyncContinuations();
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  // The callbacks keep the concurrency up on their own, and every request
+  // completes
+  const size_t delay_ms = 10;
+  const int sleep_ms = 300;
+  tcm.TestConcurrency(delay_ms, std::chrono::milliseconds(sleep_ms));
+
+  auto stats = cb::InferStat();
+  tcm.GetAccumulatedClientStat(&stats);
+  const size_t expected_count = sleep_ms * params.max_concurrency / delay_ms;
+  CHECK(
+      stats.completed_request_count ==
+      doctest::Approx(expected_count).epsilon(0.20));
+
+  tcm.StopWorkerThreads();
+  CHECK(tcm.stats_->num_active_infer_calls == 0);
+}
+
+/// Check that warm ramps add and retire contexts while the others keep
+/// sending
+///
+TEST_CASE("concurrency_warm_ramp")
+{
+  PerfAnalyzerParameters params{};
+  params.async = true;
+  params.max_threads = 2;
+  params.max_concurrency = 5;
+  bool is_sequence_model{false};
+
+  SUBCASE("non-sequence model") {}
+  SUBCASE("sequence model")
+  {
+    is_sequence_model = true;
+    params.sequence_length = 1000;
+  }
+
+  TestConcurrencyManager tcm(params, is_sequence_model);
+  tcm.EnableWarmRamp();
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  tcm.TestWarmRamp({2, 5, 1, 3});
+}
+
+/// Check that each context sends the steps of several sequences in turn
+///
+TEST_CASE("concurrency_sequences_per_context")
+{
+  PerfAnalyzerParameters params{};
+  params.async = true;
+  params.max_threads = 1;
+  params.max_concurrency = 2;
+  params.sequence_length = 1000;
+  const bool is_sequence_model{true};
+  const size_t sequences_per_context = 3;
+
+  TestConcurrencyManager tcm(params, is_sequence_model);
+  tcm.SetSequencesPerContext(sequences_per_context);
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  // The requests in flight stay at the concurrency while all the sequences
+  // get their steps
+  tcm.TestConcurrency(10, std::chrono::milliseconds(300));
+
+  CHECK(
+      tcm.stats_->sequence_status.max_live_seq_count ==
+      params.max_concurrency * sequences_per_context);
+  CHECK(
+      tcm.stats_->sequence_status.seq_ids_to_count.size() ==
+      params.max_concurrency * sequences_per_context);
+  for (const auto& seq_count : tcm.stats_->sequence_status.seq_ids_to_count) {
+    CHECK(seq_count.second > 1);
+  }
+
+  tcm.StopWorkerThreads();
+}
+
+/// Check that contexts wait for the think time between the steps of a
+/// sequence, but not before the first step
+///
+TEST_CASE("concurrency_sequence_think_time")
+{
+  PerfAnalyzerParameters params{};
+  params.max_threads = 1;
+  params.max_concurrency = 2;
+  params.sequence_length = 1000;
+  const bool is_sequence_model{true};
+  const size_t delay_ms = 10;
+  const size_t think_time_ms = 40;
+  const size_t sleep_ms = 500;
+
+  SUBCASE("async") { params.async = true; }
+  SUBCASE("sync") { params.async = false; }
+
+  TestConcurrencyManager tcm(params, is_sequence_model);
+  tcm.SetSequenceThinkTime(
+      std::make_shared<ConstantSequenceDistribution>(think_time_ms));
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  tcm.stats_->SetDelays({delay_ms});
+  tcm.ChangeConcurrencyLevel(params.max_concurrency);
+  std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+
+  auto stats = cb::InferStat();
+  tcm.GetAccumulatedClientStat(&stats);
+  const size_t expected_count =
+      params.max_concurrency * sleep_ms / (delay_ms + think_time_ms);
+  CHECK(
+      stats.completed_request_count ==
+      doctest::Approx(expected_count).epsilon(0.25));
+
+  tcm.StopWorkerThreads();
+}
+
 /// Check that the inference requests for sequences follow all rules and
 /// parameters
 ///
@@ -578,6 +765,67 @@ TEST_CASE("Concurrency - shared memory infer input calls")
   }
 }
 
+TEST_CASE("Concurrency - prestaged inputs")
+{
+  PerfAnalyzerParameters params{};
+  params.max_concurrency = 1;
+
+  const std::string json_str{R"(
+  {
+    "data": [
+      {
+        "INPUT0": [2000000000]
+      },
+      {
+        "INPUT0": [2000000001]
+      }
+    ]
+  }
+      )"};
+
+  MockInputPipeline mip =
+      TestLoadManagerBase::ProcessCustomJsonData(json_str, false);
+
+  TestConcurrencyManager tcm(params, false);
+
+  tcm.infer_data_manager_ = std::make_shared<MockInferDataManager>(
+      params.batch_size, mip.mock_model_parser_, tcm.factory_,
+      mip.mock_data_loader_, true /* prestage_inputs */);
+
+  std::shared_ptr<ThreadStat> thread_stat{std::make_shared<ThreadStat>()};
+  std::shared_ptr<ConcurrencyWorker::ThreadConfig> thread_config{
+      std::make_shared<ConcurrencyWorker::ThreadConfig>(0)};
+  thread_config->concurrency_ = 1;
+
+  tcm.parser_ = mip.mock_model_parser_;
+  tcm.data_loader_ = mip.mock_data_loader_;
+  tcm.using_json_data_ = true;
+  tcm.execute_ = true;
+  tcm.batch_size_ = 1;
+  tcm.max_threads_ = 1;
+
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  std::shared_ptr<IWorker> worker{tcm.MakeWorker(thread_stat, thread_config)};
+  std::future<void> infer_future{std::async(&IWorker::Infer, worker)};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(18));
+
+  early_exit = true;
+  infer_future.get();
+
+  // Every request sends one of the staged inputs, which were filled once on
+  // creation and once when staging their step. Sending the requests must not
+  // append any more data to them.
+  CHECK(tcm.stats_->num_infer_calls > 2);
+  CHECK(
+      tcm.stats_->num_append_raw_calls == 2 * tcm.stats_->num_infer_calls);
+}
+
 /// Verify Shared Memory api calls
 ///
 TEST_CASE("Concurrency - Shared memory methods")
@@ -669,6 +917,78 @@ TEST_CASE("Concurrency - Shared memory methods")
   }
 }
 
+/// Verify the shared memory pool registers its regions instead of one per
+/// data step
+///
+TEST_CASE("Concurrency - Shared memory pool")
+{
+  PerfAnalyzerParameters params;
+  params.shared_memory_type = SYSTEM_SHARED_MEMORY;
+
+  const std::string json_str{R"(
+  {
+    "data": [
+      {
+        "INPUT0": [2123456789]
+      },
+      {
+        "INPUT0": [2123456790]
+      },
+      {
+        "INPUT0": [2123456791]
+      }
+    ]
+  }
+      )"};
+
+  MockInputPipeline mip = TestLoadManagerBase::ProcessCustomJsonData(json_str);
+
+  TestConcurrencyManager tcm(params);
+
+  tcm.infer_data_manager_ = std::make_shared<MockInferDataManagerShm>(
+      params.batch_size, params.shared_memory_type, params.output_shm_size,
+      mip.mock_model_parser_, tcm.factory_, mip.mock_data_loader_,
+      2 /* pool_size */);
+
+  tcm.parser_ = mip.mock_model_parser_;
+  tcm.data_loader_ = mip.mock_data_loader_;
+  tcm.using_json_data_ = true;
+  tcm.execute_ = true;
+  tcm.batch_size_ = 1;
+  tcm.max_threads_ = 1;
+
+  tcm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+
+  cb::MockClientStats::SharedMemoryStats expected_stats;
+  expected_stats.num_unregister_all_shared_memory_calls = 1;
+  expected_stats.num_register_system_shared_memory_calls = 2;
+  expected_stats.num_create_shared_memory_region_calls = 2;
+  expected_stats.num_map_shared_memory_calls = 2;
+  tcm.CheckSharedMemory(expected_stats);
+
+  // The requests cycle through more steps than there are regions
+  std::shared_ptr<ThreadStat> thread_stat{std::make_shared<ThreadStat>()};
+  std::shared_ptr<ConcurrencyWorker::ThreadConfig> thread_config{
+      std::make_shared<ConcurrencyWorker::ThreadConfig>(0)};
+  thread_config->concurrency_ = 1;
+
+  std::shared_ptr<IWorker> worker{tcm.MakeWorker(thread_stat, thread_config)};
+  std::future<void> infer_future{std::async(&IWorker::Infer, worker)};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(18));
+
+  early_exit = true;
+  infer_future.get();
+
+  CHECK(thread_stat->status_.IsOk());
+  CHECK(tcm.stats_->num_infer_calls > 3);
+  CHECK(tcm.stats_->num_set_shared_memory_calls > 0);
+}
+
 TEST_CASE("concurrency_deadlock")
 {
   PerfAnalyzerParameters params{};
@@ -833,4 +1153,51 @@ TEST_CASE(
   CHECK(num_sent_requests == doctest::Approx(40).epsilon(0.1));
 }
 
+TEST_CASE("concurrency_manager: prepares the backends of missing contexts")
+{
+  PerfAnalyzerParameters params{};
+  params.max_threads = 2;
+  params.max_concurrency = 8;
+
+  using ThreadBackends = std::vector<std::unique_ptr<cb::ClientBackend>>;
+  auto counts = [](const std::vector<ThreadBackends>& backends) {
+    std::vector<size_t> counts;
+    for (const auto& thread_backends : backends) {
+      counts.push_back(thread_backends.size());
+    }
+    return counts;
+  };
+
+  std::vector<ThreadBackends> backends;
+
+  SUBCASE("non-sequence model")
+  {
+    TestConcurrencyManager tcm(params);
+
+    REQUIRE(tcm.PrepareContexts(1, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{1});
+    REQUIRE(tcm.PrepareContexts(5, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{0, 1});
+    REQUIRE(tcm.PrepareContexts(2, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{0, 0});
+  }
+  SUBCASE("sequence model")
+  {
+    TestConcurrencyManager tcm(params, true);
+
+    REQUIRE(tcm.PrepareContexts(3, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{2, 1});
+    REQUIRE(tcm.PrepareContexts(2, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{0, 0});
+    REQUIRE(tcm.PrepareContexts(6, &backends).IsOk());
+    CHECK(counts(backends) == std::vector<size_t>{1, 2});
+  }
+
+  for (const auto& thread_backends : backends) {
+    for (const auto& backend : thread_backends) {
+      CHECK(backend != nullptr);
+    }
+  }
+}
+
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,98 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sched.h>
+
+#include <thread>
+#include <vector>
+#include "cpu_affinity.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("cpu_affinity: parse CPU lists")
+{
+  std::vector<int> cpus;
+
+  SUBCASE("single CPU")
+  {
+    REQUIRE(ParseCpuList("3", &cpus).IsOk());
+    CHECK(cpus == std::vector<int>{3});
+  }
+  SUBCASE("ranges and CPUs")
+  {
+    REQUIRE(ParseCpuList("0-2,8,10-11", &cpus).IsOk());
+    CHECK(cpus == std::vector<int>{0, 1, 2, 8, 10, 11});
+  }
+  SUBCASE("order is kept")
+  {
+    REQUIRE(ParseCpuList("4,1", &cpus).IsOk());
+    CHECK(cpus == std::vector<int>{4, 1});
+  }
+  SUBCASE("invalid lists")
+  {
+    CHECK(!ParseCpuList("", &cpus).IsOk());
+    CHECK(!ParseCpuList("1,,2", &cpus).IsOk());
+    CHECK(!ParseCpuList("3-1", &cpus).IsOk());
+    CHECK(!ParseCpuList("1-", &cpus).IsOk());
+    CHECK(!ParseCpuList("a", &cpus).IsOk());
+    CHECK(!ParseCpuList("1x", &cpus).IsOk());
+    CHECK(!ParseCpuList("-1", &cpus).IsOk());
+
+    cb::Error err = ParseCpuList("0,2-b", &cpus);
+    CHECK(err.Message() == "invalid CPU range '2-b' in CPU list '0,2-b'");
+  }
+}
+
+TEST_CASE("cpu_affinity: pin a thread")
+{
+  cpu_set_t allowed;
+  REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    cpu++;
+  }
+
+  cpu_set_t pinned;
+  std::thread thread([&]() {
+    REQUIRE(SetThreadAffinity(pthread_self(), {cpu}).IsOk());
+    REQUIRE(sched_getaffinity(0, sizeof(pinned), &pinned) == 0);
+  });
+  thread.join();
+  CHECK(CPU_COUNT(&pinned) == 1);
+  CHECK(CPU_ISSET(cpu, &pinned));
+
+  CHECK(!SetThreadAffinity(pthread_self(), {CPU_SETSIZE}).IsOk());
+}
+
+TEST_CASE("cpu_affinity: invalid NUMA node")
+{
+  std::vector<int> cpus;
+  CHECK(!NumaNodeCpus(1 << 20, &cpus).IsOk());
+  CHECK(!BindMemoryToNumaNode(-1).IsOk());
+}
+
+}}  // namespace triton::perfanalyzer
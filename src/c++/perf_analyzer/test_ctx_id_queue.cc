@@ -0,0 +1,148 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "ctx_id_queue.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("ctx_id_queue: fifo order")
+{
+  CtxIdQueue queue(4);
+  uint32_t ctx_id;
+  CHECK(!queue.TryPop(&ctx_id));
+
+  for (uint32_t i = 0; i < 3; i++) {
+    queue.Push(i);
+  }
+  for (uint32_t i = 0; i < 3; i++) {
+    REQUIRE(queue.TryPop(&ctx_id));
+    CHECK(ctx_id == i);
+  }
+  CHECK(!queue.TryPop(&ctx_id));
+}
+
+TEST_CASE("ctx_id_queue: full ring spills instead of dropping")
+{
+  CtxIdQueue queue(3);
+  REQUIRE(queue.Capacity() == 4);
+  for (uint32_t i = 0; i < 4; i++) {
+    REQUIRE(queue.TryPush(i));
+  }
+  CHECK(!queue.TryPush(4));
+  queue.Push(4);
+  queue.Push(5);
+
+  std::vector<uint32_t> popped;
+  uint32_t ctx_id;
+  while (queue.TryPop(&ctx_id)) {
+    popped.push_back(ctx_id);
+  }
+  std::sort(popped.begin(), popped.end());
+  CHECK(popped == std::vector<uint32_t>{0, 1, 2, 3, 4, 5});
+
+  // The ring is usable again once drained
+  REQUIRE(queue.TryPush(6));
+  REQUIRE(queue.TryPop(&ctx_id));
+  CHECK(ctx_id == 6);
+}
+
+TEST_CASE("ctx_id_queue: wait returns once an id is queued or notified")
+{
+  CtxIdQueue queue(4);
+  uint32_t ctx_id;
+
+  SUBCASE("id queued before waiting")
+  {
+    queue.Push(1);
+    queue.Wait();
+    REQUIRE(queue.TryPop(&ctx_id));
+    CHECK(ctx_id == 1);
+  }
+  SUBCASE("notified before waiting")
+  {
+    queue.Notify();
+    queue.Wait();
+    CHECK(!queue.TryPop(&ctx_id));
+  }
+  SUBCASE("id queued while parked")
+  {
+    std::thread pusher([&queue]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      queue.Push(2);
+    });
+    queue.Wait();
+    pusher.join();
+    REQUIRE(queue.TryPop(&ctx_id));
+    CHECK(ctx_id == 2);
+  }
+  SUBCASE("deadline passes")
+  {
+    const auto start = std::chrono::steady_clock::now();
+    queue.WaitUntil(start + std::chrono::milliseconds(20));
+    CHECK(
+        std::chrono::steady_clock::now() - start >=
+        std::chrono::milliseconds(20));
+    CHECK(!queue.TryPop(&ctx_id));
+  }
+}
+
+TEST_CASE("ctx_id_queue: concurrent pushers")
+{
+  const size_t pushers = 4;
+  const uint32_t per_pusher = 20000;
+  // Smaller than the ids in flight so that some of them spill
+  CtxIdQueue queue(64);
+
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < pushers; p++) {
+    threads.emplace_back([&queue, p, per_pusher]() {
+      for (uint32_t i = 0; i < per_pusher; i++) {
+        queue.Push(p * per_pusher + i);
+      }
+    });
+  }
+
+  std::vector<bool> seen(pushers * per_pusher, false);
+  size_t count = 0;
+  uint32_t ctx_id;
+  while (count < seen.size()) {
+    queue.Wait();
+    while (queue.TryPop(&ctx_id)) {
+      REQUIRE(!seen[ctx_id]);
+      seen[ctx_id] = true;
+      count++;
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(!queue.TryPop(&ctx_id));
+}
+
+}}  // namespace triton::perfanalyzer
@@ -51,10 +51,12 @@ class TestCustomLoadManager : public TestLoadManagerBase,
       bool is_decoupled_model = false)
       : TestLoadManagerBase(params, is_sequence_model, is_decoupled_model),
         CustomLoadManager(
-            params.async, params.streaming, "INTERVALS_FILE", params.batch_size,
-            params.measurement_window_ms, params.max_trials, params.max_threads,
-            params.num_of_sequences, params.shared_memory_type,
-            params.output_shm_size, GetParser(), GetFactory())
+            params.async, params.streaming, "INTERVALS_FILE", "", "",
+            params.batch_size, params.measurement_window_ms, params.max_trials,
+            params.max_threads, params.num_of_sequences,
+            params.precise_scheduling, params.num_dispatcher_threads,
+            params.shared_memory_type, params.output_shm_size, GetParser(),
+            GetFactory())
   {
     InitManager(
         params.string_length, params.string_data, params.zero_input,
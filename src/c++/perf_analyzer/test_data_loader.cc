@@ -0,0 +1,388 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstring>
+#include <set>
+#include "doctest.h"
+#include "mock_data_loader.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+ModelTensor
+MakeTensor(
+    const std::string& name, const std::string& datatype,
+    const std::vector<int64_t>& shape, const bool is_optional = false)
+{
+  ModelTensor tensor;
+  tensor.name_ = name;
+  tensor.datatype_ = datatype;
+  tensor.shape_ = shape;
+  tensor.is_optional_ = is_optional;
+  return tensor;
+}
+
+std::vector<int32_t>
+GetInt32Data(
+    DataLoader& data_loader, const ModelTensor& tensor, int stream, int step)
+{
+  const uint8_t* data_ptr{nullptr};
+  size_t byte_size{0};
+  REQUIRE(data_loader.GetInputData(tensor, stream, step, &data_ptr, &byte_size)
+              .IsOk());
+  REQUIRE(data_ptr != nullptr);
+  const int32_t* values = reinterpret_cast<const int32_t*>(data_ptr);
+  return std::vector<int32_t>(values, values + byte_size / sizeof(int32_t));
+}
+
+}  // namespace
+
+TEST_CASE("data_loader: json data is indexed by tensor, stream and step")
+{
+  auto inputs = std::make_shared<ModelTensorMap>();
+  auto outputs = std::make_shared<ModelTensorMap>();
+  (*inputs)["INPUT0"] = MakeTensor("INPUT0", "INT32", {-1});
+  (*inputs)["INPUT1"] = MakeTensor("INPUT1", "INT32", {2}, true);
+  (*outputs)["OUTPUT0"] = MakeTensor("OUTPUT0", "INT32", {2}, true);
+
+  MockDataLoader data_loader;
+
+  SUBCASE("multiple streams")
+  {
+    std::string json = R"({
+      "data": [
+        [{"INPUT0": {"content": [1, 2, 3], "shape": [3]}, "INPUT1": [4, 5]},
+         {"INPUT0": {"content": [6], "shape": [1]}}],
+        [{"INPUT0": {"content": [7, 8], "shape": [2]}}]
+      ],
+      "validation_data": [
+        [{"OUTPUT0": [9, 10]}, {}],
+        [{"OUTPUT0": [11, 12]}]
+      ]
+    })";
+    REQUIRE(data_loader.ReadDataFromStr(json, inputs, outputs).IsOk());
+
+    CHECK(data_loader.GetDataStreamsCount() == 2);
+    CHECK(data_loader.GetTotalSteps(0) == 2);
+    CHECK(data_loader.GetTotalSteps(1) == 1);
+
+    const auto& input0 = (*inputs)["INPUT0"];
+    const auto& input1 = (*inputs)["INPUT1"];
+    CHECK(
+        GetInt32Data(data_loader, input0, 0, 0) ==
+        std::vector<int32_t>{1, 2, 3});
+    CHECK(GetInt32Data(data_loader, input0, 0, 1) == std::vector<int32_t>{6});
+    CHECK(
+        GetInt32Data(data_loader, input0, 1, 0) == std::vector<int32_t>{7, 8});
+    CHECK(
+        GetInt32Data(data_loader, input1, 0, 0) == std::vector<int32_t>{4, 5});
+
+    // Optional input without data
+    const uint8_t* data_ptr{nullptr};
+    size_t byte_size{0};
+    REQUIRE(
+        data_loader.GetInputData(input1, 1, 0, &data_ptr, &byte_size).IsOk());
+    CHECK(data_ptr == nullptr);
+
+    std::vector<int64_t> shape;
+    REQUIRE(data_loader.GetInputShape(input0, 0, 1, &shape).IsOk());
+    CHECK(shape == std::vector<int64_t>{1});
+    REQUIRE(data_loader.GetInputShape(input0, 1, 0, &shape).IsOk());
+    CHECK(shape == std::vector<int64_t>{2});
+    // Falls back to the shape of the model
+    REQUIRE(data_loader.GetInputShape(input1, 0, 0, &shape).IsOk());
+    CHECK(shape == std::vector<int64_t>{2});
+
+    REQUIRE(data_loader.GetOutputData("OUTPUT0", 1, 0, &data_ptr, &byte_size)
+                .IsOk());
+    REQUIRE(byte_size == 2 * sizeof(int32_t));
+    CHECK(reinterpret_cast<const int32_t*>(data_ptr)[1] == 12);
+    REQUIRE(data_loader.GetOutputData("OUTPUT0", 0, 1, &data_ptr, &byte_size)
+                .IsOk());
+    CHECK(data_ptr == nullptr);
+
+    CHECK(!data_loader.GetInputData(input0, 1, 1, &data_ptr, &byte_size)
+               .IsOk());
+    CHECK(!data_loader.GetInputData(input0, 2, 0, &data_ptr, &byte_size)
+               .IsOk());
+  }
+
+  SUBCASE("steps appended from multiple files")
+  {
+    REQUIRE(data_loader
+                .ReadDataFromStr(
+                    R"({"data": [{"INPUT0": {"content": [1], "shape": [1]}}]})",
+                    inputs, outputs)
+                .IsOk());
+    REQUIRE(data_loader
+                .ReadDataFromStr(
+                    R"({"data": [{"INPUT0": {"content": [2], "shape": [1]}},
+                                 {"INPUT0": {"content": {"b64": "AwAAAA=="},
+                                             "shape": [1]},
+                                  "INPUT1": [4, 5]}]})",
+                    inputs, outputs)
+                .IsOk());
+
+    CHECK(data_loader.GetDataStreamsCount() == 1);
+    REQUIRE(data_loader.GetTotalSteps(0) == 3);
+    const auto& input0 = (*inputs)["INPUT0"];
+    CHECK(GetInt32Data(data_loader, input0, 0, 0) == std::vector<int32_t>{1});
+    CHECK(GetInt32Data(data_loader, input0, 0, 1) == std::vector<int32_t>{2});
+    CHECK(GetInt32Data(data_loader, input0, 0, 2) == std::vector<int32_t>{3});
+  }
+
+  SUBCASE("first error in the document is reported")
+  {
+    std::string json = R"({
+      "data": [
+        [{"INPUT0": {"content": [1], "shape": [1]}}],
+        [{"INPUT0": {"content": [1.5], "shape": [1]}}],
+        [{"INPUT1": [1, 2]}]
+      ]
+    })";
+    cb::Error err = data_loader.ReadDataFromStr(json, inputs, outputs);
+    CHECK(!err.IsOk());
+    CHECK(err.Message() == "unable to find int32_t data in json");
+  }
+}
+
+TEST_CASE("data_loader: data streams are sharded")
+{
+  auto inputs = std::make_shared<ModelTensorMap>();
+  auto outputs = std::make_shared<ModelTensorMap>();
+  (*inputs)["INPUT0"] = MakeTensor("INPUT0", "INT32", {-1});
+  (*outputs)["OUTPUT0"] = MakeTensor("OUTPUT0", "INT32", {1}, true);
+  const auto& input0 = (*inputs)["INPUT0"];
+
+  MockDataLoader data_loader;
+  std::string json = R"({
+    "data": [
+      [{"INPUT0": {"content": [0], "shape": [1]}}],
+      [{"INPUT0": {"content": [1], "shape": [1]}},
+       {"INPUT0": {"content": [1, 1], "shape": [2]}}],
+      [{"INPUT0": {"content": [2], "shape": [1]}}],
+      [{"INPUT0": {"content": [3, 3, 3], "shape": [3]}}],
+      [{"INPUT0": {"content": [4], "shape": [1]}}]
+    ],
+    "validation_data": [[{}], [{}, {}], [{}], [{"OUTPUT0": [30]}], [{}]]
+  })";
+  REQUIRE(data_loader.ReadDataFromStr(json, inputs, outputs).IsOk());
+
+  SUBCASE("every shard_count-th stream from the shard index")
+  {
+    REQUIRE(data_loader.ShardStreams(1, 2).IsOk());
+
+    CHECK(data_loader.GetDataStreamsCount() == 2);
+    CHECK(data_loader.GetTotalSteps(0) == 2);
+    CHECK(data_loader.GetTotalSteps(1) == 1);
+    CHECK(GetInt32Data(data_loader, input0, 0, 0) == std::vector<int32_t>{1});
+    CHECK(
+        GetInt32Data(data_loader, input0, 0, 1) == std::vector<int32_t>{1, 1});
+    CHECK(
+        GetInt32Data(data_loader, input0, 1, 0) ==
+        std::vector<int32_t>{3, 3, 3});
+
+    std::vector<int64_t> shape;
+    REQUIRE(data_loader.GetInputShape(input0, 1, 0, &shape).IsOk());
+    CHECK(shape == std::vector<int64_t>{3});
+
+    const uint8_t* data_ptr{nullptr};
+    size_t byte_size{0};
+    REQUIRE(data_loader.GetOutputData("OUTPUT0", 1, 0, &data_ptr, &byte_size)
+                .IsOk());
+    REQUIRE(byte_size == sizeof(int32_t));
+    CHECK(reinterpret_cast<const int32_t*>(data_ptr)[0] == 30);
+
+    CHECK(!data_loader.GetInputData(input0, 2, 0, &data_ptr, &byte_size)
+               .IsOk());
+  }
+  SUBCASE("the first shard takes the remainder")
+  {
+    REQUIRE(data_loader.ShardStreams(0, 2).IsOk());
+
+    CHECK(data_loader.GetDataStreamsCount() == 3);
+    CHECK(GetInt32Data(data_loader, input0, 2, 0) == std::vector<int32_t>{4});
+  }
+  SUBCASE("more shards than streams")
+  {
+    cb::Error err = data_loader.ShardStreams(0, 6);
+    CHECK(!err.IsOk());
+    CHECK(err.Message() == "can not split 5 data streams into 6 shards");
+    CHECK(data_loader.GetDataStreamsCount() == 5);
+  }
+}
+
+TEST_CASE("data_loader: generated data with shape distributions")
+{
+  auto inputs = std::make_shared<ModelTensorMap>();
+  (*inputs)["INPUT0"] = MakeTensor("INPUT0", "INT32", {2, -1});
+  (*inputs)["INPUT1"] = MakeTensor("INPUT1", "INT32", {4});
+
+  const size_t batch_size = 2;
+  MockDataLoader data_loader(batch_size);
+
+  ShapeDistributionSettings settings;
+  REQUIRE(ParseShapeDistribution("INPUT0:1:1:8", &settings).IsOk());
+  std::shared_ptr<ShapeDistribution> distribution;
+  REQUIRE(ShapeDistribution::Create(settings, &distribution).IsOk());
+
+  SUBCASE("shapes vary by step and data shares one buffer")
+  {
+    data_loader.SetShapeDistributions({distribution}, 16);
+    REQUIRE(data_loader.GenerateData(inputs, false, 8, "").IsOk());
+
+    CHECK(data_loader.GetDataStreamsCount() == 1);
+    REQUIRE(data_loader.GetTotalSteps(0) == 16 * batch_size);
+
+    const auto& input0 = (*inputs)["INPUT0"];
+    const auto& input1 = (*inputs)["INPUT1"];
+    const uint8_t* first_data_ptr{nullptr};
+    std::set<int64_t> dims;
+    for (int step = 0; step < 16 * (int)batch_size; step++) {
+      std::vector<int64_t> shape;
+      REQUIRE(data_loader.GetInputShape(input0, 0, step, &shape).IsOk());
+      REQUIRE(shape.size() == 2);
+      CHECK(shape[0] == 2);
+      CHECK(shape[1] >= 1);
+      CHECK(shape[1] <= 8);
+      dims.insert(shape[1]);
+
+      // The steps of a batch have the same shape
+      std::vector<int64_t> batch_shape;
+      REQUIRE(data_loader
+                  .GetInputShape(
+                      input0, 0, step - step % batch_size, &batch_shape)
+                  .IsOk());
+      CHECK(shape == batch_shape);
+
+      const uint8_t* data_ptr{nullptr};
+      size_t byte_size{0};
+      REQUIRE(data_loader.GetInputData(input0, 0, step, &data_ptr, &byte_size)
+                  .IsOk());
+      CHECK(byte_size == 2 * shape[1] * sizeof(int32_t));
+      if (first_data_ptr == nullptr) {
+        first_data_ptr = data_ptr;
+      }
+      CHECK(data_ptr == first_data_ptr);
+
+      // Inputs without a distribution keep their shape
+      REQUIRE(data_loader.GetInputShape(input1, 0, step, &shape).IsOk());
+      CHECK(shape == std::vector<int64_t>{4});
+    }
+    CHECK(dims.size() > 1);
+  }
+
+  SUBCASE("unknown input")
+  {
+    REQUIRE(ParseShapeDistribution("INPUT2:0:1:8", &settings).IsOk());
+    REQUIRE(ShapeDistribution::Create(settings, &distribution).IsOk());
+    data_loader.SetShapeDistributions({distribution}, 16);
+    CHECK(!data_loader.GenerateData(inputs, false, 8, "").IsOk());
+  }
+
+  SUBCASE("dimension out of the shape")
+  {
+    REQUIRE(ParseShapeDistribution("INPUT1:1:1:8", &settings).IsOk());
+    REQUIRE(ShapeDistribution::Create(settings, &distribution).IsOk());
+    data_loader.SetShapeDistributions({distribution}, 16);
+    CHECK(!data_loader.GenerateData(inputs, false, 8, "").IsOk());
+  }
+}
+
+TEST_CASE("data_loader: generated strings")
+{
+  auto inputs = std::make_shared<ModelTensorMap>();
+  (*inputs)["INPUT0"] = MakeTensor("INPUT0", "BYTES", {3});
+
+  auto generate = [&inputs]() {
+    MockDataLoader data_loader;
+    REQUIRE(data_loader.GenerateData(inputs, false, 5, "").IsOk());
+    const uint8_t* data_ptr{nullptr};
+    size_t byte_size{0};
+    REQUIRE(data_loader
+                .GetInputData((*inputs)["INPUT0"], 0, 0, &data_ptr, &byte_size)
+                .IsOk());
+    return std::string(reinterpret_cast<const char*>(data_ptr), byte_size);
+  };
+
+  const std::string serialized = generate();
+  REQUIRE(serialized.size() == 3 * (sizeof(uint32_t) + 5));
+  for (size_t i = 0; i < 3; i++) {
+    uint32_t len;
+    std::memcpy(&len, serialized.data() + i * 9, sizeof(uint32_t));
+    CHECK(len == 5);
+    for (size_t c = 0; c < 5; c++) {
+      CHECK(character_set.find(serialized[i * 9 + 4 + c]) != std::string::npos);
+    }
+  }
+
+  // The generated strings are the same from run to run
+  CHECK(generate() == serialized);
+}
+
+TEST_CASE("data_loader: deferred generated data")
+{
+  auto inputs = std::make_shared<ModelTensorMap>();
+  (*inputs)["INPUT0"] = MakeTensor("INPUT0", "INT32", {1024, 1024});
+  (*inputs)["INPUT1"] = MakeTensor("INPUT1", "INT32", {4});
+
+  MockDataLoader data_loader;
+  data_loader.DeferGeneratedData();
+  REQUIRE(data_loader.GenerateData(inputs, false, 8, "").IsOk());
+
+  // Only the pattern is generated, the data keeps its full size
+  const size_t pattern_size = data_loader.GeneratedPattern().size();
+  CHECK(pattern_size > 0);
+  CHECK(pattern_size < 1024 * 1024 * sizeof(int32_t));
+
+  const uint8_t* data_ptr{nullptr};
+  size_t byte_size{0};
+  REQUIRE(data_loader
+              .GetInputData((*inputs)["INPUT0"], 0, 0, &data_ptr, &byte_size)
+              .IsOk());
+  CHECK(byte_size == 1024 * 1024 * sizeof(int32_t));
+  CHECK(data_loader.IsDeferredData(data_ptr));
+
+  REQUIRE(data_loader
+              .GetInputData((*inputs)["INPUT1"], 0, 0, &data_ptr, &byte_size)
+              .IsOk());
+  CHECK(byte_size == 4 * sizeof(int32_t));
+  CHECK(data_loader.IsDeferredData(data_ptr));
+
+  // Data that is not deferred is generated in full
+  MockDataLoader full_data_loader;
+  REQUIRE(full_data_loader.GenerateData(inputs, false, 8, "").IsOk());
+  CHECK(
+      full_data_loader.GeneratedPattern().size() ==
+      1024 * 1024 * sizeof(int32_t));
+  REQUIRE(full_data_loader
+              .GetInputData((*inputs)["INPUT0"], 0, 0, &data_ptr, &byte_size)
+              .IsOk());
+  CHECK(!full_data_loader.IsDeferredData(data_ptr));
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,162 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include "directory_dataset.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// A directory with a step subdirectory per value, each holding the value as
+// the INT32 data of INPUT0
+std::string
+MakeStepDirectory(const std::vector<int32_t>& values)
+{
+  char path[] = "/tmp/directory_dataset_XXXXXX";
+  REQUIRE(mkdtemp(path) != nullptr);
+  for (size_t i = 0; i < values.size(); i++) {
+    const std::string step = std::string(path) + "/step" + std::to_string(i);
+    REQUIRE(mkdir(step.c_str(), 0700) == 0);
+    std::ofstream(step + "/INPUT0", std::ios::binary)
+        .write(reinterpret_cast<const char*>(&values[i]), sizeof(int32_t));
+  }
+  return path;
+}
+
+void
+RemoveDirectory(const std::string& path)
+{
+  REQUIRE(std::system(("rm -rf " + path).c_str()) == 0);
+}
+
+ModelTensorMap
+Int32Input()
+{
+  ModelTensor input;
+  input.name_ = "INPUT0";
+  input.datatype_ = "INT32";
+  input.shape_ = {1};
+  input.is_optional_ = false;
+  return {{"INPUT0", input}};
+}
+
+int32_t
+Value(const DirectoryDataset::TensorData& data)
+{
+  REQUIRE(data != nullptr);
+  REQUIRE(data->size() == sizeof(int32_t));
+  return *reinterpret_cast<const int32_t*>(data->data());
+}
+
+}  // namespace
+
+TEST_CASE("directory_dataset: steps are read ahead in order")
+{
+  const std::string path = MakeStepDirectory({10, 11, 12, 13, 14, 15});
+  std::shared_ptr<DirectoryDataset> dataset;
+  REQUIRE(DirectoryDataset::Open(path, Int32Input(), 2, 2, &dataset).IsOk());
+  CHECK(dataset->StepCount() == 6);
+
+  DirectoryDataset::TensorData first;
+  REQUIRE(dataset->Get("INPUT0", 0, &first).IsOk());
+  CHECK(Value(first) == 10);
+
+  // Moving on releases the first step, the buffer handed out stays valid
+  for (size_t step = 1; step < 12; step++) {
+    DirectoryDataset::TensorData data;
+    REQUIRE(dataset->Get("INPUT0", step % 6, &data).IsOk());
+    CHECK(Value(data) == 10 + (int32_t)(step % 6));
+  }
+  CHECK(Value(first) == 10);
+
+  // A step far behind is read again
+  DirectoryDataset::TensorData data;
+  REQUIRE(dataset->Get("INPUT0", 2, &data).IsOk());
+  CHECK(Value(data) == 12);
+
+  CHECK(!dataset->Get("INPUT0", 6, &data).IsOk());
+  CHECK(!dataset->Get("INPUT1", 0, &data).IsOk());
+  dataset.reset();
+  RemoveDirectory(path);
+}
+
+TEST_CASE("directory_dataset: malformed steps")
+{
+  const std::string path = MakeStepDirectory({10, 11});
+  std::shared_ptr<DirectoryDataset> dataset;
+  DirectoryDataset::TensorData data;
+
+  SUBCASE("wrong byte size")
+  {
+    std::ofstream(path + "/step1/INPUT0") << "too long";
+    REQUIRE(DirectoryDataset::Open(path, Int32Input(), 1, 1, &dataset).IsOk());
+    CHECK(dataset->Get("INPUT0", 0, &data).IsOk());
+    CHECK(!dataset->Get("INPUT0", 1, &data).IsOk());
+  }
+
+  SUBCASE("missing input")
+  {
+    std::remove((path + "/step1/INPUT0").c_str());
+    REQUIRE(DirectoryDataset::Open(path, Int32Input(), 1, 1, &dataset).IsOk());
+    CHECK(!dataset->Get("INPUT0", 1, &data).IsOk());
+  }
+
+  SUBCASE("missing optional input")
+  {
+    std::remove((path + "/step1/INPUT0").c_str());
+    ModelTensorMap inputs = Int32Input();
+    inputs["INPUT0"].is_optional_ = true;
+    REQUIRE(DirectoryDataset::Open(path, inputs, 1, 1, &dataset).IsOk());
+    REQUIRE(dataset->Get("INPUT0", 1, &data).IsOk());
+    CHECK(data == nullptr);
+  }
+
+  SUBCASE("dynamic shape")
+  {
+    ModelTensorMap inputs = Int32Input();
+    inputs["INPUT0"].shape_ = {-1};
+    CHECK(!DirectoryDataset::Open(path, inputs, 1, 1, &dataset).IsOk());
+  }
+
+  dataset.reset();
+  RemoveDirectory(path);
+}
+
+TEST_CASE("directory_dataset: no steps")
+{
+  const std::string path = MakeStepDirectory({});
+  std::shared_ptr<DirectoryDataset> dataset;
+  CHECK(!DirectoryDataset::Open(path, Int32Input(), 1, 1, &dataset).IsOk());
+  RemoveDirectory(path);
+}
+
+}}  // namespace triton::perfanalyzer
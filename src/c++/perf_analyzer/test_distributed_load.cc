@@ -0,0 +1,97 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include "distributed_load.h"
+#include "doctest.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("distributed_load: parse rank weights")
+{
+  std::vector<double> weights;
+
+  REQUIRE(ParseRankWeights("2,1,0.5", &weights).IsOk());
+  REQUIRE(weights.size() == 3);
+  CHECK(weights[0] == doctest::Approx(2));
+  CHECK(weights[1] == doctest::Approx(1));
+  CHECK(weights[2] == doctest::Approx(0.5));
+
+  std::vector<double> unchanged{weights};
+  CHECK(!ParseRankWeights("", &weights).IsOk());
+  CHECK(!ParseRankWeights("1,,2", &weights).IsOk());
+  CHECK(!ParseRankWeights("1,2,", &weights).IsOk());
+  CHECK(!ParseRankWeights("1,0", &weights).IsOk());
+  CHECK(!ParseRankWeights("1,x", &weights).IsOk());
+  CHECK(weights == unchanged);
+
+  cb::Error err = ParseRankWeights("1,-2", &weights);
+  CHECK(
+      err.Message() ==
+      "invalid rank weight '-2', weights must be positive numbers");
+}
+
+TEST_CASE("distributed_load: split request rates")
+{
+  std::vector<double> rates = SplitRequestRate(100, {1, 1, 2});
+  REQUIRE(rates.size() == 3);
+  CHECK(rates[0] == doctest::Approx(25));
+  CHECK(rates[1] == doctest::Approx(25));
+  CHECK(rates[2] == doctest::Approx(50));
+}
+
+TEST_CASE("distributed_load: split concurrencies")
+{
+  std::vector<size_t> concurrencies;
+
+  SUBCASE("equal weights")
+  {
+    REQUIRE(SplitConcurrency(8, {1, 1, 1}, &concurrencies).IsOk());
+    // The extra request in flight goes to the lower ranks
+    CHECK(concurrencies == std::vector<size_t>{3, 3, 2});
+  }
+  SUBCASE("every rank gets a request in flight")
+  {
+    REQUIRE(SplitConcurrency(4, {10, 1, 1}, &concurrencies).IsOk());
+    CHECK(concurrencies == std::vector<size_t>{2, 1, 1});
+  }
+  SUBCASE("shares follow the weights")
+  {
+    REQUIRE(SplitConcurrency(43, {3, 1}, &concurrencies).IsOk());
+    CHECK(concurrencies == std::vector<size_t>{32, 11});
+  }
+  SUBCASE("concurrency below the number of ranks")
+  {
+    cb::Error err = SplitConcurrency(2, {1, 1, 1}, &concurrencies);
+    CHECK(!err.IsOk());
+    CHECK(
+        err.Message() ==
+        "concurrency 2 is below the number of MPI ranks 3 sharing the load");
+    CHECK(concurrencies.empty());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
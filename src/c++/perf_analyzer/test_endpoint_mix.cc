@@ -0,0 +1,103 @@
+
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <map>
+#include <vector>
+#include "doctest.h"
+#include "endpoint_mix.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("endpoint_mix: parse endpoints")
+{
+  std::vector<EndpointEntry> entries;
+
+  SUBCASE("urls and weights")
+  {
+    REQUIRE(ParseEndpoints(
+                "replica-0:8001=2,http://replica-1:8000/v2,replica-2:8001",
+                &entries)
+                .IsOk());
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].url == "replica-0:8001");
+    CHECK(entries[0].weight == doctest::Approx(2));
+    CHECK(entries[1].url == "http://replica-1:8000/v2");
+    CHECK(entries[1].weight == doctest::Approx(1));
+    CHECK(entries[2].url == "replica-2:8001");
+    CHECK(entries[2].weight == doctest::Approx(1));
+  }
+  SUBCASE("invalid endpoints")
+  {
+    CHECK(!ParseEndpoints("", &entries).IsOk());
+    CHECK(!ParseEndpoints("a:8001,,b:8001", &entries).IsOk());
+    CHECK(!ParseEndpoints("=2", &entries).IsOk());
+    CHECK(!ParseEndpoints("a:8001=0", &entries).IsOk());
+    CHECK(!ParseEndpoints("a:8001=x", &entries).IsOk());
+    CHECK(!ParseEndpoints("a:8001,a:8001=2", &entries).IsOk());
+    CHECK(entries.empty());
+
+    cb::Error err = ParseEndpoints("a:8001,a:8001", &entries);
+    CHECK(err.Message() == "duplicate url in endpoints: 'a:8001'");
+  }
+}
+
+TEST_CASE("endpoint_mix: pick endpoints by weight")
+{
+  EndpointMix mix({{"a", 1}, {"b", 3}}, ENDPOINT_WEIGHTED);
+
+  REQUIRE(mix.Size() == 2);
+  CHECK(mix.Entry(1).url == "b");
+  CHECK(mix.Policy() == ENDPOINT_WEIGHTED);
+
+  CHECK(mix.Pick(0.0) == 0);
+  CHECK(mix.Pick(0.2) == 0);
+  CHECK(mix.Pick(0.25) == 1);
+  CHECK(mix.Pick(0.9999999) == 1);
+}
+
+TEST_CASE("endpoint_mix: bind worker threads by weight")
+{
+  EndpointMix mix({{"a", 1}, {"b", 1}, {"c", 2}}, ENDPOINT_AFFINITY);
+
+  // Any number of first workers is spread close to the weights
+  std::map<size_t, size_t> counts;
+  for (size_t worker = 0; worker < 4; worker++) {
+    counts[mix.WorkerEndpoint(worker)]++;
+  }
+  CHECK(counts[0] == 1);
+  CHECK(counts[1] == 1);
+  CHECK(counts[2] == 2);
+
+  for (size_t worker = 4; worker < 64; worker++) {
+    counts[mix.WorkerEndpoint(worker)]++;
+  }
+  CHECK(counts[0] == 16);
+  CHECK(counts[1] == 16);
+  CHECK(counts[2] == 32);
+}
+
+}}  // namespace triton::perfanalyzer
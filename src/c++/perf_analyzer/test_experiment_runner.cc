@@ -0,0 +1,263 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "doctest.h"
+#include "experiment_runner.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+MakeCacheDirectory()
+{
+  char path[] = "/tmp/experiment_cache_XXXXXX";
+  REQUIRE(mkdtemp(path) != nullptr);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("experiment_runner: expand the matrix")
+{
+  std::unique_ptr<ExperimentRunner> runner;
+  REQUIRE(ExperimentRunner::CreateFromString(
+              R"({
+                "arguments": ["-m", "resnet"],
+                "matrix": [
+                  {"name": "-b", "values": [1, 8]},
+                  {"name": "--async", "values": [true, false]},
+                  {"name": "--shared-memory", "values": ["system"]}
+                ]
+              })",
+              {"-u", "server:8001"}, &runner)
+              .IsOk());
+
+  const auto configurations = runner->Configurations();
+  REQUIRE(configurations.size() == 4);
+  CHECK(
+      configurations[0] ==
+      std::vector<std::string>{
+          "-u", "server:8001", "-m", "resnet", "-b", "1", "--async",
+          "--shared-memory", "system"});
+  CHECK(
+      configurations[1] ==
+      std::vector<std::string>{
+          "-u", "server:8001", "-m", "resnet", "-b", "1", "--shared-memory",
+          "system"});
+  CHECK(
+      configurations[2] ==
+      std::vector<std::string>{
+          "-u", "server:8001", "-m", "resnet", "-b", "8", "--async",
+          "--shared-memory", "system"});
+
+  // The report path only depends on the command line
+  CHECK(runner->ReportPath(configurations[0]) ==
+        runner->ReportPath(configurations[0]));
+  CHECK(runner->ReportPath(configurations[0]) !=
+        runner->ReportPath(configurations[1]));
+  CHECK(runner->ReportPath({"ab"}) != runner->ReportPath({"a", "b"}));
+  CHECK(runner->ReportPath({}).find("perf_analyzer_cache/") == 0);
+}
+
+TEST_CASE("experiment_runner: model config fields")
+{
+  const std::string cache_directory = MakeCacheDirectory();
+  std::unique_ptr<ExperimentRunner> runner;
+  REQUIRE(ExperimentRunner::CreateFromString(
+              R"({
+                "arguments": ["-m", "resnet"],
+                "model_config": {"backend": "onnxruntime",
+                                 "dynamic_batching": {}},
+                "matrix": [
+                  {"config": "max_batch_size", "values": [8, 16]},
+                  {"name": "-b", "values": [4]},
+                  {"config": "dynamic_batching.max_queue_delay_microseconds",
+                   "values": [0, 100]},
+                  {"config": "instance_group", "values": [[{"count": 2}]]}
+                ],
+                "cache_directory": ")" +
+                  cache_directory + R"("
+              })",
+              {}, &runner)
+              .IsOk());
+
+  const auto configurations = runner->Configurations();
+  REQUIRE(configurations.size() == 4);
+  for (const auto& configuration : configurations) {
+    REQUIRE(configuration.size() == 6);
+    CHECK(configuration[4] == "--model-load-config");
+  }
+  // Each config is its own file
+  CHECK(configurations[0][5] != configurations[1][5]);
+  CHECK(configurations[0][5].find(cache_directory + "/") == 0);
+
+  std::vector<std::string> model_configs;
+  auto run = [&model_configs](const std::vector<std::string>& args) {
+    std::ifstream config(args[5]);
+    std::stringstream contents;
+    contents << config.rdbuf();
+    model_configs.push_back(contents.str());
+    std::ofstream(args.back()) << "Concurrency" << std::endl;
+    return true;
+  };
+  REQUIRE(runner->Run(run).IsOk());
+  REQUIRE(model_configs.size() == 4);
+  CHECK(
+      model_configs[1] ==
+      R"({"backend":"onnxruntime","dynamic_batching":)"
+      R"({"max_queue_delay_microseconds":100},"max_batch_size":8,)"
+      R"("instance_group":[{"count":2}]})");
+
+  for (const auto& configuration : configurations) {
+    const std::string path = runner->ReportPath(configuration);
+    std::remove(path.c_str());
+    std::remove((path.substr(0, path.size() - 4) + ".args").c_str());
+    std::remove(configuration[5].c_str());
+  }
+  rmdir(cache_directory.c_str());
+}
+
+TEST_CASE("experiment_runner: Pareto frontier")
+{
+  auto point = [](double throughput, double p99_latency_us) {
+    ExperimentPoint point;
+    point.throughput = throughput;
+    point.p99_latency_us = p99_latency_us;
+    return point;
+  };
+  const auto frontier = ExperimentRunner::ParetoFrontier(
+      {point(100, 50), point(300, 200), point(200, 40), point(300, 150),
+       point(150, 60), point(250, 150)});
+  REQUIRE(frontier.size() == 2);
+  CHECK(frontier[0].throughput == 300);
+  CHECK(frontier[0].p99_latency_us == 150);
+  CHECK(frontier[1].throughput == 200);
+  CHECK(frontier[1].p99_latency_us == 40);
+  CHECK(ExperimentRunner::ParetoFrontier({}).empty());
+}
+
+TEST_CASE("experiment_runner: invalid experiment files")
+{
+  std::unique_ptr<ExperimentRunner> runner;
+  CHECK(!ExperimentRunner::CreateFromString("[]", {}, &runner).IsOk());
+  CHECK(!ExperimentRunner::CreateFromString("{", {}, &runner).IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(
+             R"({"arguments": "-m resnet"})", {}, &runner)
+             .IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(
+             R"({"matrix": [{"name": "-b", "values": []}]})", {}, &runner)
+             .IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(
+             R"({"matrix": [{"name": "-b", "values": [[1]]}]})", {}, &runner)
+             .IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(R"({"matrx": []})", {}, &runner)
+             .IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(
+             R"({"matrix": [{"config": "a..b", "values": [1]}]})", {}, &runner)
+             .IsOk());
+  CHECK(!ExperimentRunner::CreateFromString(
+             R"({"model_config": "config.pbtxt"})", {}, &runner)
+             .IsOk());
+  CHECK(runner == nullptr);
+}
+
+TEST_CASE("experiment_runner: cached configurations are skipped")
+{
+  const std::string cache_directory = MakeCacheDirectory();
+  std::unique_ptr<ExperimentRunner> runner;
+  REQUIRE(ExperimentRunner::CreateFromString(
+              R"({
+                "arguments": ["-m", "resnet"],
+                "matrix": [{"name": "-b", "values": [1, 2, 4]}],
+                "cache_directory": ")" +
+                  cache_directory + R"("
+              })",
+              {}, &runner)
+              .IsOk());
+
+  std::vector<std::vector<std::string>> runs;
+  auto run = [&runs](const std::vector<std::string>& args) {
+    runs.push_back(args);
+    // Writes the report like perf_analyzer does
+    std::ofstream(args.back()) << "Concurrency,Inferences/Second" << std::endl;
+    return true;
+  };
+
+  REQUIRE(runner->Run(run).IsOk());
+  REQUIRE(runs.size() == 3);
+  CHECK(runs[1][runs[1].size() - 2] == "-f");
+  CHECK(runs[1].back() == runner->ReportPath(runner->Configurations()[1]));
+
+  // The measurements of every configuration are read from its report
+  std::ofstream(runner->ReportPath(runner->Configurations()[2]))
+      << "Concurrency,Inferences/Second,Client Send,p50 latency,p99 latency"
+      << std::endl
+      << "1,100.5,10,900,1000" << std::endl
+      << "2,180,10,1500,2500" << std::endl
+      << std::endl
+      << "Bucket,Request Count" << std::endl;
+  std::vector<ExperimentPoint> points;
+  REQUIRE(runner->Points(&points).IsOk());
+  REQUIRE(points.size() == 2);
+  CHECK(points[1].args == runner->Configurations()[2]);
+  CHECK(points[1].load_name == "Concurrency");
+  CHECK(points[1].load == 2);
+  CHECK(points[0].throughput == 100.5);
+  CHECK(points[1].p99_latency_us == 2500);
+
+  // A second run finds every report in the cache
+  runs.clear();
+  REQUIRE(runner->Run(run).IsOk());
+  CHECK(runs.empty());
+
+  // An interrupted configuration is not cached
+  const std::string report = runner->ReportPath(runner->Configurations()[2]);
+  REQUIRE(std::remove(report.c_str()) == 0);
+  auto interrupted_run = [&runs](const std::vector<std::string>& args) {
+    runs.push_back(args);
+    std::ofstream(args.back()) << "Concurrency" << std::endl;
+    return false;
+  };
+  CHECK(!runner->Run(interrupted_run).IsOk());
+  CHECK(runs.size() == 1);
+  CHECK(std::ifstream(report).fail());
+
+  for (const auto& configuration : runner->Configurations()) {
+    const std::string path = runner->ReportPath(configuration);
+    std::remove(path.c_str());
+    std::remove((path.substr(0, path.size() - 4) + ".args").c_str());
+  }
+  rmdir(cache_directory.c_str());
+}
+
+}}  // namespace triton::perfanalyzer
@@ -24,6 +24,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <atomic>
 #include <thread>
 #include "doctest.h"
 #include "idle_timer.h"
@@ -76,6 +77,42 @@ TEST_CASE("idle_timer: reset when active")
   CHECK(timer.GetIdleTime() > 0);
 }
 
+TEST_CASE("idle_timer: read while the owner updates it")
+{
+  IdleTimer timer;
+  std::atomic<bool> done{false};
+  std::thread owner([&timer, &done]() {
+    while (!done) {
+      timer.Start();
+      timer.Stop();
+    }
+  });
+  // The idle time never goes backwards, even when read mid update
+  uint64_t last = 0;
+  for (size_t i = 0; i < 100000; i++) {
+    const uint64_t idle_time = timer.GetIdleTime();
+    CHECK_MESSAGE(idle_time >= last, "idle time went backwards");
+    last = idle_time;
+  }
+  done = true;
+  owner.join();
+}
+
+TEST_CASE("thread_timer: scope")
+{
+  ThreadTimer timer;
+  {
+    ThreadTimer::Scope scope(timer);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const uint64_t time = timer.GetTime();
+  CHECK(time >= 1000000);
+  // Stopped when the scope ended
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CHECK(timer.GetTime() == time);
+  CHECK_NOTHROW(timer.Start());
+}
+
 TEST_CASE("idle_timer: double start")
 {
   IdleTimer timer;
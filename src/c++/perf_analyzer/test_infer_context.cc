@@ -24,6 +24,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <thread>
 #include "doctest.h"
 #include "gmock/gmock.h"
 #include "infer_context.h"
@@ -116,4 +117,271 @@ TEST_CASE("update_seq_json_data: testing the UpdateSeqJsonData function")
   REQUIRE(testing::Test::HasFailure() == false);
 }
 
+TEST_CASE("inflight_limit: requests over the cap are dropped or queued")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  mic->infer_data_.options_.reset(new cb::InferOptions("target"));
+  bool execute = true;
+  mic->execute_ = execute;
+
+  SUBCASE("drop")
+  {
+    InflightLimiter limiter(1, OVERLOAD_DROP);
+    CHECK(mic->AdmitRequest(&limiter));
+    CHECK(!mic->AdmitRequest(&limiter));
+    CHECK(mic->thread_stat_->num_dropped_requests_ == 1);
+    CHECK(limiter.Inflight() == 1);
+    limiter.Release();
+    CHECK(mic->AdmitRequest(&limiter));
+    CHECK(mic->thread_stat_->num_dropped_requests_ == 1);
+  }
+  SUBCASE("queue")
+  {
+    // The end of a sequence waits for a slot even when dropping
+    auto overload = OVERLOAD_QUEUE;
+    SUBCASE("queue policy") {}
+    SUBCASE("sequence end")
+    {
+      overload = OVERLOAD_DROP;
+      mic->infer_data_.options_->sequence_end_ = true;
+    }
+    InflightLimiter limiter(1, overload);
+    CHECK(mic->AdmitRequest(&limiter));
+    std::thread completion([&limiter]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      limiter.Release();
+    });
+    CHECK(mic->AdmitRequest(&limiter));
+    completion.join();
+    CHECK(limiter.Inflight() == 1);
+    CHECK(mic->thread_stat_->num_dropped_requests_ == 0);
+    const LatencyHistogram& delays = mic->thread_stat_->queue_delay_histogram_;
+    CHECK(delays.TotalCount() == 1);
+    CHECK(delays.Max() >= 4000000);
+  }
+  SUBCASE("stopped while queued")
+  {
+    InflightLimiter limiter(1, OVERLOAD_QUEUE);
+    CHECK(mic->AdmitRequest(&limiter));
+    execute = false;
+    CHECK(!mic->AdmitRequest(&limiter));
+    CHECK(mic->thread_stat_->queue_delay_histogram_.TotalCount() == 0);
+  }
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
+TEST_CASE("corrected_latency: latencies also count the schedule lag")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  const LatencyHistogram& corrected =
+      mic->thread_stat_->corrected_latency_histogram_;
+
+  SUBCASE("late request")
+  {
+    mic->SetIntendedSendTime(
+        std::chrono::steady_clock::now() - std::chrono::milliseconds(2));
+    const int64_t lag_ns = mic->TakeScheduleLag();
+    CHECK(lag_ns >= 2000000);
+    mic->RecordCorrectedLatency(lag_ns, 1000);
+    CHECK(corrected.TotalCount() == 1);
+    CHECK(corrected.Max() >= 2001000);
+    // The intended send time only applies to one request
+    CHECK(mic->TakeScheduleLag() == -1);
+  }
+  SUBCASE("early request")
+  {
+    mic->SetIntendedSendTime(
+        std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    CHECK(mic->TakeScheduleLag() == 0);
+  }
+  SUBCASE("unscheduled request")
+  {
+    const int64_t lag_ns = mic->TakeScheduleLag();
+    CHECK(lag_ns == -1);
+    mic->RecordCorrectedLatency(lag_ns, 1000);
+    CHECK(corrected.TotalCount() == 0);
+  }
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
+TEST_CASE("slow_requests: the slowest requests are kept with their ids")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  mic->thread_stat_->worker_index_ = 3;
+  mic->infer_data_.options_.reset(new cb::InferOptions("target"));
+  const SlowRequestTracker& slow_requests = mic->thread_stat_->slow_requests_;
+
+  SUBCASE("tracked")
+  {
+    mic->thread_stat_->slow_requests_ = SlowRequestTracker(1);
+    AsyncRequestProperties request;
+    request.start_time_ = std::chrono::system_clock::now();
+    request.first_response_time_ =
+        request.start_time_ + std::chrono::microseconds(5);
+    request.last_response_time_ =
+        request.start_time_ + std::chrono::microseconds(9);
+    mic->infer_data_.options_->data_stream_id_ = 2;
+    mic->infer_data_.options_->data_step_id_ = 7;
+    mic->SetRequestIds(&request);
+    mic->RecordSlowRequest(9000, request);
+    // Faster than the request kept
+    mic->RecordSlowRequest(8000, AsyncRequestProperties());
+
+    REQUIRE(slow_requests.Requests().size() == 1);
+    const SlowRequest& slow_request = slow_requests.Requests()[0];
+    CHECK(slow_request.latency_ns == 9000);
+    CHECK(slow_request.worker == 3);
+    CHECK(slow_request.data_stream_id == 2);
+    CHECK(slow_request.data_step_id == 7);
+    CHECK(slow_request.sequence_id == 0);
+    CHECK(
+        slow_request.first_response_time_ns - slow_request.send_time_ns ==
+        5000);
+    CHECK(slow_request.end_time_ns - slow_request.send_time_ns == 9000);
+  }
+  SUBCASE("not tracked")
+  {
+    mic->RecordSlowRequest(9000, AsyncRequestProperties());
+    CHECK(slow_requests.Empty());
+  }
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
+TEST_CASE("model_mix: requests are spread over the models of the mix")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  mic->infer_data_.options_.reset(new cb::InferOptions("target"));
+  mic->model_mix_ = std::make_shared<ModelMix>(
+      std::vector<ModelMixEntry>{{"target", "", 1}, {"other", "2", 3}});
+
+  std::map<std::string, size_t> counts;
+  EXPECT_CALL(*mic, SendRequest(testing::_, testing::_))
+      .WillRepeatedly(testing::Invoke([&mic, &counts](uint64_t, bool) {
+        const cb::InferOptions& options = *(mic->infer_data_.options_);
+        counts[options.model_name_]++;
+        if (options.model_name_ == "other") {
+          CHECK(options.model_version_ == "2");
+        } else {
+          CHECK(options.model_version_ == "");
+        }
+      }));
+
+  const size_t num_requests = 4000;
+  for (size_t i = 0; i < num_requests; i++) {
+    mic->SendInferRequest();
+  }
+
+  CHECK(counts.size() == 2);
+  CHECK(counts["target"] + counts["other"] == num_requests);
+  CHECK(counts["other"] == doctest::Approx(3000).epsilon(0.05));
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
+TEST_CASE("request_classes: requests take the priority and timeout of a class")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  mic->infer_data_.options_.reset(new cb::InferOptions("target"));
+
+  SUBCASE("without request classes")
+  {
+    mic->PickRequestClass();
+    CHECK(mic->infer_data_.options_->priority_ == 0);
+    CHECK(mic->infer_data_.options_->server_timeout_ == 0);
+    CHECK_FALSE(mic->IsClassRejection(
+        0, cb::Error("Request timeout expired", pa::GENERIC_ERROR)));
+  }
+  SUBCASE("with request classes")
+  {
+    mic->thread_stat_->request_classes_ = std::make_shared<RequestClassMix>(
+        std::vector<RequestClassEntry>{
+            {"premium", 1, 1}, {"bulk", 3, 2, 50000}});
+
+    std::map<uint64_t, size_t> counts;
+    const size_t num_requests = 4000;
+    for (size_t i = 0; i < num_requests; i++) {
+      mic->PickRequestClass();
+      const cb::InferOptions& options = *(mic->infer_data_.options_);
+      counts[options.priority_]++;
+      CHECK(
+          options.server_timeout_ == ((options.priority_ == 2) ? 50000 : 0));
+    }
+    CHECK(counts.size() == 2);
+    CHECK(counts[2] == doctest::Approx(3000).epsilon(0.05));
+
+    // Only the timeouts of a class with a timeout are rejections
+    const cb::Error timeout("Request timeout expired", pa::GENERIC_ERROR);
+    CHECK_FALSE(mic->IsClassRejection(0, timeout));
+    CHECK(mic->IsClassRejection(1, timeout));
+    CHECK_FALSE(mic->IsClassRejection(
+        1, cb::Error("failed to connect", pa::GENERIC_ERROR)));
+  }
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
+TEST_CASE("endpoints: requests are spread over the endpoints by policy")
+{
+  std::shared_ptr<MockInferContext> mic{std::make_shared<MockInferContext>()};
+  mic->thread_stat_ = std::make_shared<ThreadStat>();
+  mic->infer_data_.options_.reset(new cb::InferOptions("target"));
+  const std::vector<EndpointEntry> endpoints{{"a", 1}, {"b", 1}, {"c", 2}};
+
+  SUBCASE("without endpoints")
+  {
+    mic->PickEndpoint(1);
+    CHECK(mic->endpoint_ == 0);
+  }
+  SUBCASE("round robin")
+  {
+    mic->thread_stat_->endpoints_ =
+        std::make_shared<EndpointMix>(endpoints, ENDPOINT_ROUND_ROBIN);
+    std::vector<size_t> picked;
+    for (uint64_t request_id = 0; request_id < 4; request_id++) {
+      mic->PickEndpoint(request_id);
+      picked.push_back(mic->endpoint_);
+    }
+    CHECK(picked == std::vector<size_t>{0, 1, 2, 0});
+  }
+  SUBCASE("affinity")
+  {
+    mic->thread_stat_->endpoints_ =
+        std::make_shared<EndpointMix>(endpoints, ENDPOINT_AFFINITY);
+    mic->thread_stat_->worker_index_ = 1;
+    for (uint64_t request_id = 0; request_id < 4; request_id++) {
+      mic->PickEndpoint(request_id);
+      CHECK(mic->endpoint_ == 2);
+    }
+  }
+  SUBCASE("weighted")
+  {
+    mic->thread_stat_->endpoints_ =
+        std::make_shared<EndpointMix>(endpoints, ENDPOINT_WEIGHTED);
+    std::map<size_t, size_t> counts;
+    const size_t num_requests = 4000;
+    for (uint64_t request_id = 0; request_id < num_requests; request_id++) {
+      mic->PickEndpoint(request_id);
+      counts[mic->endpoint_]++;
+    }
+    CHECK(counts.size() == 3);
+    CHECK(counts[2] == doctest::Approx(2000).epsilon(0.05));
+  }
+
+  mic.reset();
+  REQUIRE(testing::Test::HasFailure() == false);
+}
+
 }}  // namespace triton::perfanalyzer
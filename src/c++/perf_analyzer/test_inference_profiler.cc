@@ -35,12 +35,42 @@ class TestInferenceProfiler : public InferenceProfiler {
   static void ValidLatencyMeasurement(
       const std::pair<uint64_t, uint64_t>& valid_range,
       size_t& valid_sequence_count, size_t& delayed_request_count,
-      std::vector<uint64_t>* latencies, TimestampVector& all_timestamps)
+      std::vector<uint64_t>* latencies, TimestampVector& all_timestamps,
+      ClientSideStats* response_stats = nullptr)
   {
     InferenceProfiler inference_profiler{};
     inference_profiler.all_timestamps_ = all_timestamps;
     inference_profiler.ValidLatencyMeasurement(
-        valid_range, valid_sequence_count, delayed_request_count, latencies);
+        valid_range, valid_sequence_count, delayed_request_count, latencies,
+        nullptr, response_stats);
+  }
+
+  static cb::Error SummarizeLatency(
+      std::vector<uint64_t>& latencies, size_t extra_percentile,
+      PerfStatus& summary)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.extra_percentile_ = (extra_percentile != 0);
+    inference_profiler.percentile_ = extra_percentile;
+    return inference_profiler.SummarizeLatency(latencies, summary);
+  }
+
+  static void TrimLatencyOutliers(
+      std::vector<uint64_t>& latencies, std::vector<uint64_t>* end_times_ns,
+      double outlier_factor, ClientSideStats& stats)
+  {
+    InferenceProfiler inference_profiler{};
+    inference_profiler.warmup_.outlier_factor = outlier_factor;
+    inference_profiler.TrimLatencyOutliers(latencies, end_times_ns, stats);
+  }
+
+  static void CollectStatisticsModels(
+      const cb::ModelIdentifier& model_identifier,
+      const ComposingModelMap& composing_models,
+      std::vector<cb::ModelIdentifier>* models)
+  {
+    InferenceProfiler::CollectStatisticsModels(
+        model_identifier, composing_models, models);
   }
 
   static std::tuple<uint64_t, uint64_t> GetMeanAndStdDev(
@@ -101,6 +131,43 @@ class TestInferenceProfiler : public InferenceProfiler {
     return ip.IsDoneProfiling(ls, &is_stable);
   };
 
+  static bool IsWindowConverged(
+      const std::vector<uint64_t>& latencies,
+      const std::vector<uint64_t>& end_times_ns, uint64_t window_start_ns,
+      uint64_t window_end_ns, double stability_threshold,
+      size_t extra_percentile = 0)
+  {
+    InferenceProfiler ip;
+    ip.load_parameters_.stability_threshold = stability_threshold;
+    ip.extra_percentile_ = (extra_percentile != 0);
+    ip.percentile_ = extra_percentile;
+    return ip.IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns);
+  }
+
+  static bool IsLatencyOverThreshold(
+      const LatencyHistogram& latencies, uint64_t latency_threshold_ms,
+      size_t extra_percentile = 0)
+  {
+    InferenceProfiler ip;
+    ip.latency_threshold_ms_ = latency_threshold_ms;
+    ip.extra_percentile_ = (extra_percentile != 0);
+    ip.percentile_ = extra_percentile;
+    uint64_t latency_ns = 0;
+    return ip.IsLatencyOverThreshold(latencies, &latency_ns);
+  }
+
+  template <typename T>
+  static T NextAdaptiveSearchValue(
+      const T current, const uint64_t current_latency_ns, const T previous,
+      const uint64_t previous_latency_ns, const T step, const T end,
+      const uint64_t target_latency_ns)
+  {
+    return InferenceProfiler::NextAdaptiveSearchValue(
+        current, current_latency_ns, previous, previous_latency_ns, step, end,
+        target_latency_ns);
+  }
+
   cb::Error MergeMetrics(
       const std::vector<std::reference_wrapper<const Metrics>>& all_metrics,
       Metrics& merged_metrics)
@@ -128,6 +195,16 @@ class TestInferenceProfiler : public InferenceProfiler {
         input_metric_maps, output_metric_map);
   }
 
+  template <typename T>
+  void GetMetricIncrease(
+      const std::vector<std::reference_wrapper<const std::map<std::string, T>>>&
+          input_metric_maps,
+      std::map<std::string, T>& output_metric_map)
+  {
+    InferenceProfiler::GetMetricIncrease<T>(
+        input_metric_maps, output_metric_map);
+  }
+
   template <typename T>
   void GetMetricFirstPerGPU(
       const std::vector<std::reference_wrapper<const std::map<std::string, T>>>&
@@ -144,6 +221,20 @@ class TestInferenceProfiler : public InferenceProfiler {
   {
     InferenceProfiler::SummarizeOverhead(window_duration_ns, idle_ns, summary);
   }
+
+  static cb::Error MergeRankWindows(
+      const std::vector<std::pair<cb::Error, PerfStatus>>& rank_summaries,
+      PerfStatus& summary)
+  {
+    InferenceProfiler ip;
+    ip.extra_percentile_ = false;
+    std::vector<std::vector<uint64_t>> rank_windows;
+    for (const auto& rank_summary : rank_summaries) {
+      rank_windows.push_back(
+          ip.PackRankWindow(rank_summary.first, rank_summary.second));
+    }
+    return ip.MergeRankWindows(rank_windows, summary);
+  }
 };
 
 TEST_CASE("testing the ValidLatencyMeasurement function")
@@ -159,32 +250,41 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
       // request ends before window starts, this should not be possible to exist
       // in the vector of requests, but if it is, we exclude it: not included in
       // current window
-      std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false),
+      std::make_tuple(
+          time_point(ns(1)), time_point(ns(2)), 0, false, time_point(ns(2)),
+          1),
 
       // request starts before window starts and ends inside window: included in
       // current window
-      std::make_tuple(time_point(ns(3)), time_point(ns(5)), 0, false),
+      std::make_tuple(
+          time_point(ns(3)), time_point(ns(5)), 0, false, time_point(ns(5)),
+          1),
 
       // requests start and end inside window: included in current window
-      std::make_tuple(time_point(ns(6)), time_point(ns(9)), 0, false),
-      std::make_tuple(time_point(ns(10)), time_point(ns(14)), 0, false),
+      std::make_tuple(
+          time_point(ns(6)), time_point(ns(9)), 0, false, time_point(ns(9)),
+          1),
+      std::make_tuple(
+          time_point(ns(10)), time_point(ns(14)), 0, false, time_point(ns(14)),
+          1),
 
       // request starts before window ends and ends after window ends: not
       // included in current window
-      std::make_tuple(time_point(ns(15)), time_point(ns(20)), 0, false),
+      std::make_tuple(
+          time_point(ns(15)), time_point(ns(20)), 0, false, time_point(ns(20)),
+          1),
 
       // request starts after window ends: not included in current window
-      std::make_tuple(time_point(ns(21)), time_point(ns(27)), 0, false)};
+      std::make_tuple(
+          time_point(ns(21)), time_point(ns(27)), 0, false, time_point(ns(27)),
+          1)};
 
   TestInferenceProfiler::ValidLatencyMeasurement(
       window, valid_sequence_count, delayed_request_count, &latencies,
       all_timestamps);
 
   const auto& convert_timestamp_to_latency{
-      [](std::tuple<
-          std::chrono::time_point<std::chrono::system_clock>,
-          std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool>
-             t) {
+      [](TimestampVector::value_type t) {
         return CHRONO_TO_NANOS(std::get<1>(t)) -
                CHRONO_TO_NANOS(std::get<0>(t));
       }};
@@ -195,6 +295,180 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
   CHECK(latencies[2] == convert_timestamp_to_latency(all_timestamps[3]));
 }
 
+TEST_CASE("testing the ValidLatencyMeasurement function with responses")
+{
+  size_t valid_sequence_count{};
+  size_t delayed_request_count{};
+  std::vector<uint64_t> latencies{};
+  ClientSideStats response_stats;
+
+  const std::pair<uint64_t, uint64_t> window{0, 100};
+  using time_point = std::chrono::time_point<std::chrono::system_clock>;
+  using ns = std::chrono::nanoseconds;
+  TimestampVector all_timestamps{
+      // 4 responses from 10 to 40
+      std::make_tuple(
+          time_point(ns(0)), time_point(ns(40)), 0, false, time_point(ns(10)),
+          4),
+      // a single response
+      std::make_tuple(
+          time_point(ns(50)), time_point(ns(80)), 0, false, time_point(ns(80)),
+          1),
+      // only the empty final response
+      std::make_tuple(
+          time_point(ns(85)), time_point(ns(90)), 0, false, time_point(ns(90)),
+          0),
+      // ends after the window
+      std::make_tuple(
+          time_point(ns(90)), time_point(ns(120)), 0, false,
+          time_point(ns(95)), 3)};
+
+  TestInferenceProfiler::ValidLatencyMeasurement(
+      window, valid_sequence_count, delayed_request_count, &latencies,
+      all_timestamps, &response_stats);
+
+  CHECK(latencies == std::vector<uint64_t>{40, 30, 5});
+  CHECK(response_stats.response_count == 5);
+  // The request without responses ends with its empty final response
+  CHECK(response_stats.avg_first_response_latency_ns == 15);
+  CHECK(response_stats.response_gap_count == 3);
+  CHECK(response_stats.avg_response_gap_ns == 10);
+}
+
+TEST_CASE("testing the SummarizeLatency function")
+{
+  PerfStatus summary;
+
+  SUBCASE("unsorted latencies")
+  {
+    // 1..100 in a scrambled order
+    std::vector<uint64_t> latencies;
+    for (uint64_t i = 0; i < 100; i++) {
+      latencies.push_back((i * 37) % 100 + 1);
+    }
+    auto err = TestInferenceProfiler::SummarizeLatency(latencies, 0, summary);
+    REQUIRE(err.IsOk());
+
+    const auto& percentiles = summary.client_stats.percentile_latency_ns;
+    CHECK(percentiles.size() == 4);
+    CHECK(percentiles.at(50) == 51);
+    CHECK(percentiles.at(90) == 90);
+    CHECK(percentiles.at(95) == 95);
+    CHECK(percentiles.at(99) == 99);
+    CHECK(summary.client_stats.avg_latency_ns == 50);
+    CHECK(summary.stabilizing_latency_ns == 50);
+  }
+  SUBCASE("extra percentile")
+  {
+    std::vector<uint64_t> latencies{40, 10, 30, 20, 50};
+    auto err = TestInferenceProfiler::SummarizeLatency(latencies, 75, summary);
+    REQUIRE(err.IsOk());
+
+    const auto& percentiles = summary.client_stats.percentile_latency_ns;
+    CHECK(percentiles.size() == 5);
+    CHECK(percentiles.at(50) == 30);
+    CHECK(percentiles.at(75) == 40);
+    CHECK(percentiles.at(99) == 50);
+    CHECK(summary.stabilizing_latency_ns == 40);
+  }
+  SUBCASE("no latencies")
+  {
+    std::vector<uint64_t> latencies;
+    auto err = TestInferenceProfiler::SummarizeLatency(latencies, 0, summary);
+    CHECK(!err.IsOk());
+  }
+}
+
+TEST_CASE("testing the TrimLatencyOutliers function")
+{
+  // A first request that pays for a JIT compilation
+  std::vector<uint64_t> latencies{5000, 12, 10, 11, 9, 40};
+  std::vector<uint64_t> end_times_ns{1, 2, 3, 4, 5, 6};
+  ClientSideStats stats;
+  stats.outlier_count = 7;
+
+  SUBCASE("disabled")
+  {
+    TestInferenceProfiler::TrimLatencyOutliers(
+        latencies, &end_times_ns, 0, stats);
+    CHECK(latencies.size() == 6);
+    CHECK(end_times_ns.size() == 6);
+    CHECK(stats.outlier_count == 0);
+    CHECK(stats.max_outlier_latency_ns == 0);
+  }
+  SUBCASE("factor 10")
+  {
+    // The median is 12, so only the first request is over 120
+    TestInferenceProfiler::TrimLatencyOutliers(
+        latencies, &end_times_ns, 10, stats);
+    CHECK(latencies == std::vector<uint64_t>{12, 10, 11, 9, 40});
+    CHECK(end_times_ns == std::vector<uint64_t>{2, 3, 4, 5, 6});
+    CHECK(stats.outlier_count == 1);
+    CHECK(stats.max_outlier_latency_ns == 5000);
+  }
+  SUBCASE("factor 3")
+  {
+    TestInferenceProfiler::TrimLatencyOutliers(latencies, nullptr, 3, stats);
+    CHECK(latencies == std::vector<uint64_t>{12, 10, 11, 9});
+    CHECK(stats.outlier_count == 2);
+    CHECK(stats.max_outlier_latency_ns == 5000);
+  }
+}
+
+TEST_CASE("testing the MergeRankWindows function")
+{
+  PerfStatus rank0{};
+  rank0.client_stats.request_count = 3;
+  rank0.client_stats.sequence_count = 1;
+  rank0.client_stats.duration_ns = 1000;
+  rank0.client_stats.completed_count = 3;
+  rank0.client_stats.avg_request_time_ns = 20;
+  rank0.client_stats.infer_per_sec = 30.0;
+  rank0.client_stats.sequence_per_sec = 1.0;
+  rank0.send_request_rate = 30.0;
+  rank0.overhead_pct = 10.0;
+  rank0.converged = true;
+  for (const uint64_t latency : {10, 20, 30}) {
+    rank0.client_stats.latency_histogram.Record(latency);
+  }
+
+  PerfStatus rank1{};
+  rank1.client_stats.request_count = 1;
+  rank1.client_stats.sequence_count = 0;
+  rank1.client_stats.duration_ns = 1100;
+  rank1.client_stats.completed_count = 1;
+  rank1.client_stats.avg_request_time_ns = 60;
+  rank1.client_stats.infer_per_sec = 10.0;
+  rank1.client_stats.sequence_per_sec = 0.0;
+  rank1.send_request_rate = 12.0;
+  rank1.overhead_pct = 25.0;
+  rank1.converged = false;
+  rank1.client_stats.latency_histogram.Record(100);
+
+  PerfStatus merged{};
+  REQUIRE(TestInferenceProfiler::MergeRankWindows(
+              {{cb::Error::Success, rank0}, {cb::Error::Success, rank1}},
+              merged)
+              .IsOk());
+
+  const ClientSideStats& stats = merged.client_stats;
+  CHECK(stats.request_count == 4);
+  CHECK(stats.sequence_count == 1);
+  CHECK(stats.duration_ns == 1100);
+  CHECK(stats.completed_count == 4);
+  CHECK(stats.avg_request_time_ns == 30);
+  CHECK(stats.infer_per_sec == doctest::Approx(40.0));
+  CHECK(stats.sequence_per_sec == doctest::Approx(1.0));
+  CHECK(merged.send_request_rate == doctest::Approx(42.0));
+  CHECK(merged.overhead_pct == doctest::Approx(25.0));
+  CHECK(merged.converged == false);
+  CHECK(stats.latency_histogram.TotalCount() == 4);
+  CHECK(stats.avg_latency_ns == 40);
+  CHECK(stats.percentile_latency_ns.at(50) == 30);
+  CHECK(stats.percentile_latency_ns.at(99) == 100);
+  CHECK(merged.stabilizing_latency_ns == 40);
+}
+
 TEST_CASE("test_check_window_for_stability")
 {
   LoadStatus ls;
@@ -374,6 +648,157 @@ TEST_CASE("test_is_done_profiling")
   }
 }
 
+TEST_CASE("test_is_window_converged")
+{
+  const uint64_t window_start_ns = 1000 * NANOS_PER_MILLIS;
+  const uint64_t window_end_ns = window_start_ns + 1000 * NANOS_PER_MILLIS;
+  std::vector<uint64_t> latencies;
+  std::vector<uint64_t> end_times_ns;
+
+  // Adds requests at a steady rate with the given latency over the part of
+  // the window from begin to end, in fractions of the window
+  auto add_requests = [&](double begin, double end, size_t count,
+                          uint64_t latency) {
+    const uint64_t duration_ns = window_end_ns - window_start_ns;
+    for (size_t i = 0; i < count; i++) {
+      double offset = begin + (end - begin) * (i + 0.5) / count;
+      end_times_ns.push_back(window_start_ns + offset * duration_ns);
+      latencies.push_back(latency);
+    }
+  };
+
+  SUBCASE("steady load converges")
+  {
+    add_requests(0, 1, 1000, 5000);
+    CHECK(TestInferenceProfiler::IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns, 0.1));
+    CHECK(TestInferenceProfiler::IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns, 0.1, 99));
+  }
+
+  SUBCASE("throughput ramp does not converge")
+  {
+    add_requests(0, 0.5, 200, 5000);
+    add_requests(0.5, 1, 800, 5000);
+    CHECK_FALSE(TestInferenceProfiler::IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns, 0.1));
+  }
+
+  SUBCASE("latency shift does not converge")
+  {
+    add_requests(0, 0.5, 500, 5000);
+    add_requests(0.5, 1, 500, 10000);
+    CHECK_FALSE(TestInferenceProfiler::IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns, 0.1));
+  }
+
+  SUBCASE("too few requests do not converge")
+  {
+    add_requests(0, 1, 50, 5000);
+    CHECK_FALSE(TestInferenceProfiler::IsWindowConverged(
+        latencies, end_times_ns, window_start_ns, window_end_ns, 0.1));
+  }
+}
+
+TEST_CASE("testing the IsLatencyOverThreshold function")
+{
+  LatencyHistogram latencies;
+
+  SUBCASE("average clearly over")
+  {
+    latencies.RecordValues(12 * NANOS_PER_MILLIS, 50);
+    latencies.RecordValues(14 * NANOS_PER_MILLIS, 50);
+    CHECK(TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10));
+    CHECK_FALSE(TestInferenceProfiler::IsLatencyOverThreshold(latencies, 15));
+    CHECK_FALSE(
+        TestInferenceProfiler::IsLatencyOverThreshold(latencies, NO_LIMIT));
+  }
+
+  SUBCASE("average too uncertain")
+  {
+    latencies.RecordValues(1 * NANOS_PER_MILLIS, 50);
+    latencies.RecordValues(23 * NANOS_PER_MILLIS, 50);
+    CHECK_FALSE(TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10));
+  }
+
+  SUBCASE("too few requests")
+  {
+    latencies.RecordValues(20 * NANOS_PER_MILLIS, 10);
+    CHECK_FALSE(TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10));
+  }
+
+  SUBCASE("percentile")
+  {
+    // 5 of 1000 requests over is within what p99 allows
+    latencies.RecordValues(5 * NANOS_PER_MILLIS, 995);
+    latencies.RecordValues(20 * NANOS_PER_MILLIS, 5);
+    CHECK_FALSE(
+        TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10, 99));
+    CHECK_FALSE(
+        TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10, 50));
+
+    // 50 of 1000 requests over is clearly more than p99 allows
+    latencies.Reset();
+    latencies.RecordValues(5 * NANOS_PER_MILLIS, 950);
+    latencies.RecordValues(20 * NANOS_PER_MILLIS, 50);
+    CHECK(TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10, 99));
+    CHECK_FALSE(
+        TestInferenceProfiler::IsLatencyOverThreshold(latencies, 10, 90));
+  }
+}
+
+TEST_CASE("test_next_adaptive_search_value")
+{
+  const uint64_t ms = NANOS_PER_MILLIS;
+  const size_t no_end = NO_LIMIT;
+
+  SUBCASE("no previous measurement doubles the load")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            4, 10 * ms, 4, 10 * ms, 1, no_end, 30 * ms) == 8);
+  }
+
+  SUBCASE("latency gradient is extrapolated to the target")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            8, 20 * ms, 4, 10 * ms, 1, no_end, 30 * ms) == 12);
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<double>(
+            100.0, 20 * ms, 50.0, 10 * ms, 1.0, NO_LIMIT, 25 * ms) ==
+        doctest::Approx(125.0));
+  }
+
+  SUBCASE("flat latency doubles the load")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            8, 10 * ms, 4, 10 * ms, 1, no_end, 30 * ms) == 16);
+  }
+
+  SUBCASE("growth is capped at double the load")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            8, 11 * ms, 4, 10 * ms, 1, no_end, 100 * ms) == 16);
+  }
+
+  SUBCASE("growth is at least one step")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            8, 29 * ms, 4, 10 * ms, 4, no_end, 30 * ms) == 12);
+  }
+
+  SUBCASE("growth stops at the end of the range")
+  {
+    CHECK(
+        TestInferenceProfiler::NextAdaptiveSearchValue<size_t>(
+            8, 20 * ms, 4, 10 * ms, 1, 10, 30 * ms) == 10);
+  }
+}
+
 TEST_CASE("test mocking")
 {
   using testing::AtLeast;
@@ -480,6 +905,63 @@ TEST_CASE("testing the MergeMetrics function")
         doctest::Approx(0.485));
     CHECK(merged_metrics.gpu_memory_used_bytes_per_gpu["gpu0"] == 12000);
   }
+
+  SUBCASE("server gauges and counters")
+  {
+    metrics_1.gauges["nv_cpu_utilization"] = 0.2;
+    metrics_2.gauges["nv_cpu_utilization"] = 0.4;
+
+    metrics_1.counters["nv_inference_count{model=\"m\"}"] = 100;
+    metrics_2.counters["nv_inference_count{model=\"m\"}"] = 250;
+
+    const std::vector<std::reference_wrapper<const Metrics>> all_metrics{
+        metrics_1, metrics_2};
+
+    tip.MergeMetrics(all_metrics, merged_metrics);
+    CHECK(merged_metrics.gauges.size() == 1);
+    CHECK(merged_metrics.counters.size() == 1);
+    CHECK(
+        merged_metrics.gauges["nv_cpu_utilization"] == doctest::Approx(0.3));
+    CHECK(
+        merged_metrics.counters["nv_inference_count{model=\"m\"}"] ==
+        doctest::Approx(150));
+  }
+}
+
+TEST_CASE("testing the GetMetricIncrease function")
+{
+  TestInferenceProfiler tip{};
+  std::map<std::string, double> metric_increases{};
+
+  SUBCASE("counters going up")
+  {
+    const std::map<std::string, double> metric_1{{"a", 10}, {"b", 5}},
+        metric_2{{"a", 15}}, metric_3{{"a", 40}, {"b", 6}};
+
+    const std::vector<
+        std::reference_wrapper<const std::map<std::string, double>>>
+        all_metrics{metric_1, metric_2, metric_3};
+
+    tip.GetMetricIncrease<double>(all_metrics, metric_increases);
+
+    CHECK(metric_increases.size() == 2);
+    CHECK(metric_increases["a"] == doctest::Approx(30));
+    CHECK(metric_increases["b"] == doctest::Approx(1));
+  }
+
+  SUBCASE("counter reset")
+  {
+    const std::map<std::string, double> metric_1{{"a", 100}},
+        metric_2{{"a", 120}}, metric_3{{"a", 8}};
+
+    const std::vector<
+        std::reference_wrapper<const std::map<std::string, double>>>
+        all_metrics{metric_1, metric_2, metric_3};
+
+    tip.GetMetricIncrease<double>(all_metrics, metric_increases);
+
+    CHECK(metric_increases["a"] == doctest::Approx(28));
+  }
 }
 
 TEST_CASE("testing the GetMetricAveragePerGPU function")
@@ -643,6 +1125,28 @@ TEST_CASE("test the ReportPrometheusMetrics function")
         "      gpu1 : 100000 bytes\n");
   }
 
+  SUBCASE("server gauges and counters")
+  {
+    metrics.gauges["nv_cpu_utilization"] = 0.25;
+    metrics.counters["nv_inference_count{model=\"m\"}"] = 150;
+
+    cb::Error result{ReportPrometheusMetrics(metrics)};
+
+    std::cout.rdbuf(old_cout);
+
+    CHECK(result.Err() == SUCCESS);
+    CHECK(
+        captured_cout.str() ==
+        "    Avg GPU Utilization:\n"
+        "    Avg GPU Power Usage:\n"
+        "    Max GPU Memory Usage:\n"
+        "    Total GPU Memory:\n"
+        "    Avg Server Gauges:\n"
+        "      nv_cpu_utilization : 0.25\n"
+        "    Server Counter Increases:\n"
+        "      nv_inference_count{model=\"m\"} : 150\n");
+  }
+
   SUBCASE("too many GPUs")
   {
     const size_t num_gpus{17};
@@ -724,4 +1228,189 @@ TEST_CASE(
   }
 }
 
+TEST_CASE("InferenceProfiler: Test WindowClock")
+{
+  WindowClock clock;
+  clock.alignment_ns = 1000;
+
+  SUBCASE("epoch aligned boundaries")
+  {
+    CHECK(clock.NextBoundaryNs(0) == 0);
+    CHECK(clock.NextBoundaryNs(1) == 1000);
+    CHECK(clock.NextBoundaryNs(5000) == 5000);
+    CHECK(clock.NextBoundaryNs(5001) == 6000);
+  }
+
+  SUBCASE("boundaries from a start time")
+  {
+    clock.origin_ns = 10250;
+    CHECK(clock.NextBoundaryNs(3000) == 10250);
+    CHECK(clock.NextBoundaryNs(10250) == 10250);
+    CHECK(clock.NextBoundaryNs(10251) == 11250);
+  }
+
+  SUBCASE("local clock ahead of the reference clock")
+  {
+    clock.offset_ns = 300;
+    CHECK(clock.NextBoundaryNs(5000) == 5300);
+    CHECK(clock.NextBoundaryNs(5301) == 6300);
+    CHECK(clock.ToReferenceNs(5300) == 5000);
+  }
+
+  SUBCASE("local clock behind the reference clock")
+  {
+    clock.offset_ns = -300;
+    CHECK(clock.NextBoundaryNs(4600) == 4700);
+    CHECK(clock.NextBoundaryNs(4701) == 5700);
+    CHECK(clock.ToReferenceNs(4700) == 5000);
+  }
+
+  SUBCASE("aligned durations")
+  {
+    CHECK(clock.AlignedDurationNs(0) == 1000);
+    CHECK(clock.AlignedDurationNs(1000) == 1000);
+    CHECK(clock.AlignedDurationNs(1001) == 2000);
+  }
+}
+
+TEST_CASE("InferenceProfiler: Test CollectStatisticsModels")
+{
+  std::vector<cb::ModelIdentifier> models;
+
+  SUBCASE("model without composing models")
+  {
+    TestInferenceProfiler::CollectStatisticsModels(
+        {"model", ""}, ComposingModelMap{}, &models);
+    CHECK(models == std::vector<cb::ModelIdentifier>{{"model", ""}});
+  }
+
+  SUBCASE("nested ensembles sharing a model")
+  {
+    ComposingModelMap composing_models{
+        {"ensemble", {{"inner_ensemble", ""}, {"shared", "1"}}},
+        {"inner_ensemble", {{"shared", "1"}, {"leaf", ""}}}};
+    TestInferenceProfiler::CollectStatisticsModels(
+        {"ensemble", "2"}, composing_models, &models);
+    CHECK(
+        models == std::vector<cb::ModelIdentifier>{
+                      {"ensemble", "2"},
+                      {"inner_ensemble", ""},
+                      {"leaf", ""},
+                      {"shared", "1"}});
+  }
+}
+
+TEST_CASE("InferenceProfiler: Test EnsembleCriticalPath")
+{
+  auto step = [](const std::string& model,
+                 const std::set<std::string>& inputs,
+                 const std::set<std::string>& outputs) {
+    EnsembleStep ensemble_step;
+    ensemble_step.model = {model, ""};
+    ensemble_step.inputs = inputs;
+    ensemble_step.outputs = outputs;
+    return ensemble_step;
+  };
+  auto stats = [](uint64_t avg_latency_ns) {
+    ServerSideStats model_stats{};
+    model_stats.success_count = 10;
+    model_stats.cumm_time_ns = 10 * avg_latency_ns;
+    return model_stats;
+  };
+
+  // decode feeds both resize and detect, which both feed postprocess. The
+  // steps are not listed in the order they run.
+  const std::vector<EnsembleStep> steps{
+      step("postprocess", {"resized", "boxes"}, {"OUTPUT"}),
+      step("resize", {"image"}, {"resized"}),
+      step("detect", {"image"}, {"boxes"}),
+      step("decode", {"INPUT"}, {"image"})};
+  std::map<cb::ModelIdentifier, ServerSideStats> composing_stats{
+      {{"decode", ""}, stats(100)},
+      {{"resize", ""}, stats(50)},
+      {{"detect", ""}, stats(400)},
+      {{"postprocess", ""}, stats(20)}};
+
+  uint64_t latency_ns = 0;
+  CHECK(
+      EnsembleCriticalPath(steps, composing_stats, &latency_ns) ==
+      std::vector<cb::ModelIdentifier>{
+          {"decode", ""}, {"detect", ""}, {"postprocess", ""}});
+  CHECK(latency_ns == 520);
+
+  // The path follows the load, as the slowest branch changes
+  composing_stats[{"resize", ""}] = stats(1000);
+  CHECK(
+      EnsembleCriticalPath(steps, composing_stats, &latency_ns) ==
+      std::vector<cb::ModelIdentifier>{
+          {"decode", ""}, {"resize", ""}, {"postprocess", ""}});
+  CHECK(latency_ns == 1120);
+
+  CHECK(EnsembleCriticalPath({}, composing_stats, &latency_ns).empty());
+  CHECK(latency_ns == 0);
+}
+
+TEST_CASE("InferenceProfiler: Test metrics correlation")
+{
+  auto snapshot = [](uint64_t timestamp_ns, double utilization, double power,
+                     uint64_t used_bytes) {
+    Metrics m{};
+    m.timestamp_ns = timestamp_ns;
+    m.gpu_utilization_per_gpu = {{"a", utilization}, {"b", utilization / 2}};
+    m.gpu_power_usage_per_gpu = {{"a", power}, {"b", power}};
+    m.gpu_memory_used_bytes_per_gpu = {{"a", used_bytes}, {"b", 100}};
+    m.gpu_memory_total_bytes_per_gpu = {{"a", 1000}, {"b", 1000}};
+    return m;
+  };
+  // Scraped every half second, the memory of GPU a growing by 100 bytes
+  // each time
+  const std::vector<Metrics> metrics{
+      snapshot(1000000000, 0.2, 50, 100), snapshot(1500000000, 0.4, 100, 200),
+      snapshot(2000000000, 0.8, 150, 300)};
+
+  SUBCASE("CorrelateMetrics")
+  {
+    MetricsCorrelation correlation{};
+    CorrelateMetrics(
+        {metrics.begin(), metrics.end()}, 400.0, &correlation);
+    // Both GPUs draw 100 watts on average
+    CHECK(correlation.infer_per_sec_per_watt == doctest::Approx(2.0));
+    CHECK(correlation.min_gpu_memory_headroom_bytes == 700);
+    CHECK(correlation.gpu_memory_trend_bytes_per_sec == doctest::Approx(200));
+
+    CorrelateMetrics({}, 400.0, &correlation);
+    CHECK(correlation.infer_per_sec_per_watt == 0);
+    CHECK(correlation.min_gpu_memory_headroom_bytes == 0);
+    CHECK(correlation.gpu_memory_trend_bytes_per_sec == 0);
+  }
+
+  SUBCASE("GpuUtilizationAt")
+  {
+    double utilization = 0;
+    // Closest to the first, second and last scrapes
+    CHECK(
+        GpuUtilizationAt(
+            metrics, {900000000, 1600000000, 5000000000}, &utilization) == 3);
+    CHECK(utilization == doctest::Approx((0.15 + 0.3 + 0.6) / 3));
+
+    CHECK(GpuUtilizationAt({}, {1000000000}, &utilization) == 0);
+    CHECK(utilization == 0);
+  }
+}
+
+TEST_CASE("InferenceProfiler: Test network bandwidth")
+{
+  SUBCASE("bandwidth")
+  {
+    CHECK(BandwidthMBPerSec(4000000, 2000000000) == doctest::Approx(2.0));
+    CHECK(BandwidthMBPerSec(4000000, 0) == 0.0);
+  }
+  SUBCASE("compression ratio")
+  {
+    CHECK(CompressionRatio(1000, 250) == doctest::Approx(4.0));
+    CHECK(CompressionRatio(1000, 1000) == doctest::Approx(1.0));
+    CHECK(CompressionRatio(0, 0) == 1.0);
+  }
+}
+
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,162 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include "doctest.h"
+#include "input_corpus.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+TempPath()
+{
+  char path[] = "/tmp/input_corpus_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("input_corpus: round trip")
+{
+  // stream, step, name, is_input -> data
+  std::map<std::tuple<size_t, size_t, std::string, bool>, std::vector<char>>
+      data;
+  data[std::make_tuple(0, 0, "INPUT0", true)] = {1, 2, 3, 4};
+  data[std::make_tuple(0, 1, "INPUT0", true)] = {5, 6, 7};
+  data[std::make_tuple(1, 0, "INPUT0", true)] = {8};
+  data[std::make_tuple(0, 0, "OUTPUT0", false)] = {9, 10};
+  const std::vector<int64_t> shape{1, 3};
+
+  InputCorpus::TensorLookup lookup =
+      [&](size_t stream, size_t step, const std::string& name, bool is_input,
+          const std::vector<char>** tensor_data,
+          const std::vector<int64_t>** tensor_shape) {
+        auto it = data.find(std::make_tuple(stream, step, name, is_input));
+        if (it == data.end()) {
+          return false;
+        }
+        *tensor_data = &it->second;
+        *tensor_shape = (stream == 0 && step == 1) ? &shape : nullptr;
+        return true;
+      };
+
+  std::string path = TempPath();
+  REQUIRE(InputCorpus::Write(
+              path, {{"INPUT0", true}, {"OUTPUT0", false}}, {2, 1}, lookup)
+              .IsOk());
+  CHECK(InputCorpus::IsCorpusFile(path));
+
+  std::shared_ptr<InputCorpus> corpus;
+  REQUIRE(InputCorpus::Open(path, &corpus).IsOk());
+  std::remove(path.c_str());
+
+  CHECK(corpus->StreamCount() == 2);
+  CHECK(corpus->StepCount(0) == 2);
+  CHECK(corpus->StepCount(1) == 1);
+  CHECK(corpus->HasTensor("INPUT0", true));
+  CHECK(!corpus->HasTensor("INPUT0", false));
+  CHECK(corpus->HasTensor("OUTPUT0", false));
+
+  for (const auto& expected : data) {
+    InputCorpusTensor tensor;
+    REQUIRE(corpus->Find(
+        std::get<2>(expected.first), std::get<3>(expected.first),
+        std::get<0>(expected.first), std::get<1>(expected.first), &tensor));
+    REQUIRE(tensor.byte_size_ == expected.second.size());
+    CHECK(
+        std::vector<char>(tensor.data_, tensor.data_ + tensor.byte_size_) ==
+        expected.second);
+  }
+
+  InputCorpusTensor tensor;
+  REQUIRE(corpus->Find("INPUT0", true, 0, 1, &tensor));
+  REQUIRE(tensor.has_shape_);
+  CHECK(
+      std::vector<int64_t>(tensor.shape_, tensor.shape_ + tensor.shape_rank_) ==
+      shape);
+  REQUIRE(corpus->Find("INPUT0", true, 0, 0, &tensor));
+  CHECK(!tensor.has_shape_);
+
+  // Missing tensors, steps and streams
+  CHECK(!corpus->Find("OUTPUT0", false, 0, 1, &tensor));
+  CHECK(!corpus->Find("INPUT1", true, 0, 0, &tensor));
+  CHECK(!corpus->Find("INPUT0", true, 1, 1, &tensor));
+  CHECK(!corpus->Find("INPUT0", true, 2, 0, &tensor));
+}
+
+TEST_CASE("input_corpus: malformed")
+{
+  std::string path = TempPath();
+  std::shared_ptr<InputCorpus> corpus;
+
+  SUBCASE("not a corpus")
+  {
+    std::ofstream(path) << "{\"data\": []}";
+    CHECK(!InputCorpus::IsCorpusFile(path));
+    CHECK(!InputCorpus::Open(path, &corpus).IsOk());
+  }
+
+  SUBCASE("truncated")
+  {
+    std::vector<char> input(64, 1);
+    REQUIRE(InputCorpus::Write(
+                path, {{"INPUT0", true}}, {1},
+                [&](size_t, size_t, const std::string&, bool,
+                    const std::vector<char>** tensor_data,
+                    const std::vector<int64_t>**) {
+                  *tensor_data = &input;
+                  return true;
+                })
+                .IsOk());
+    REQUIRE(truncate(path.c_str(), 100) == 0);
+    CHECK(InputCorpus::IsCorpusFile(path));
+    cb::Error err = InputCorpus::Open(path, &corpus);
+    CHECK(!err.IsOk());
+    CHECK(err.Message() == "input corpus '" + path + "' is malformed");
+  }
+
+  SUBCASE("missing file")
+  {
+    std::remove(path.c_str());
+    CHECK(!InputCorpus::IsCorpusFile(path));
+    CHECK(!InputCorpus::Open(path, &corpus).IsOk());
+  }
+
+  CHECK(corpus == nullptr);
+  std::remove(path.c_str());
+}
+
+}}  // namespace triton::perfanalyzer
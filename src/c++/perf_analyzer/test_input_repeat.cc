@@ -0,0 +1,102 @@
+
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <random>
+#include <set>
+#include <vector>
+#include "doctest.h"
+#include "input_repeat.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("input_repeat: Zipf ranks")
+{
+  std::mt19937 rng(7);
+  const size_t draws{200000};
+
+  SUBCASE("skewed")
+  {
+    std::vector<size_t> counts(100, 0);
+    for (size_t i = 0; i < draws; i++) {
+      size_t rank = InputRepeat::DrawZipf(rng, counts.size(), 1.0);
+      REQUIRE(rank < counts.size());
+      counts[rank]++;
+    }
+    // P(rank) is proportional to 1 / (rank + 1)
+    CHECK(
+        (double)counts[0] / counts[1] == doctest::Approx(2.0).epsilon(0.05));
+    CHECK(
+        (double)counts[0] / counts[9] == doctest::Approx(10.0).epsilon(0.1));
+  }
+  SUBCASE("uniform")
+  {
+    std::vector<size_t> counts(4, 0);
+    for (size_t i = 0; i < draws; i++) {
+      counts[InputRepeat::DrawZipf(rng, counts.size(), 0.0)]++;
+    }
+    for (size_t count : counts) {
+      CHECK((double)count / draws == doctest::Approx(0.25).epsilon(0.05));
+    }
+  }
+  SUBCASE("single rank")
+  {
+    CHECK(InputRepeat::DrawZipf(rng, 1, 1.2) == 0);
+  }
+}
+
+TEST_CASE("input_repeat: repeat ratio")
+{
+  std::mt19937 rng(11);
+  InputRepeat input_repeat(0.75, 1.1);
+  const size_t pool_size{100000};
+  const size_t requests{40000};
+
+  std::set<size_t> sent;
+  size_t repeats{0};
+  for (size_t i = 0; i < requests; i++) {
+    size_t input = input_repeat.Next(rng, pool_size);
+    REQUIRE(input < pool_size);
+    if (!sent.insert(input).second) {
+      repeats++;
+    }
+  }
+  CHECK((double)repeats / requests == doctest::Approx(0.75).epsilon(0.03));
+  // The new inputs are sent in turn
+  CHECK(*sent.rbegin() == sent.size() - 1);
+  CHECK(!input_repeat.PoolExhausted());
+
+  SUBCASE("exhausted pool")
+  {
+    InputRepeat small_pool(0.0, 1.0);
+    for (size_t i = 0; i < 5; i++) {
+      CHECK(small_pool.Next(rng, 3) == i % 3);
+    }
+    CHECK(small_pool.PoolExhausted());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
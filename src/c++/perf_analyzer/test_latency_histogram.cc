@@ -0,0 +1,167 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <random>
+#include "doctest.h"
+#include "latency_histogram.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("latency_histogram: empty")
+{
+  LatencyHistogram histogram;
+  CHECK(histogram.TotalCount() == 0);
+  CHECK(histogram.Min() == 0);
+  CHECK(histogram.Max() == 0);
+  CHECK(histogram.Mean() == 0);
+  CHECK(histogram.ValueAtPercentile(50) == 0);
+}
+
+TEST_CASE("latency_histogram: small values are exact")
+{
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 100; i++) {
+    histogram.Record(i);
+  }
+  CHECK(histogram.TotalCount() == 100);
+  CHECK(histogram.Min() == 1);
+  CHECK(histogram.Max() == 100);
+  CHECK(histogram.Mean() == 50);
+  CHECK(histogram.ValueAtPercentile(0) == 1);
+  CHECK(histogram.ValueAtPercentile(50) == 51);
+  CHECK(histogram.ValueAtPercentile(90) == 90);
+  CHECK(histogram.ValueAtPercentile(99) == 99);
+  CHECK(histogram.ValueAtPercentile(100) == 100);
+}
+
+TEST_CASE("latency_histogram: matches sorted vector within precision")
+{
+  std::mt19937_64 rng(0);
+  std::lognormal_distribution<double> dist(13.0, 1.0);
+  std::vector<uint64_t> latencies;
+  LatencyHistogram histogram;
+  for (size_t i = 0; i < 100000; i++) {
+    uint64_t latency = static_cast<uint64_t>(dist(rng)) + 1;
+    latencies.push_back(latency);
+    histogram.Record(latency);
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  for (const double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+    size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
+    double expected = static_cast<double>(latencies[index]);
+    double actual =
+        static_cast<double>(histogram.ValueAtPercentile(percentile));
+    CHECK(actual >= expected);
+    CHECK(actual <= expected * 1.001);
+  }
+}
+
+TEST_CASE("latency_histogram: standard deviation")
+{
+  LatencyHistogram histogram;
+  histogram.Record(1000);
+  CHECK(histogram.StdDevUs() == UINT64_MAX);
+  histogram.Record(3000);
+  histogram.Record(5000);
+  // Values in usec are 1, 3, 5 which have a sample standard deviation of 2
+  CHECK(histogram.StdDevUs() == 2);
+}
+
+TEST_CASE("latency_histogram: values above the highest trackable are clamped")
+{
+  LatencyHistogram histogram(1000000);
+  histogram.Record(5000000);
+  CHECK(histogram.Max() == 1000000);
+  CHECK(histogram.ValueAtPercentile(100) == 1000000);
+}
+
+TEST_CASE("latency_histogram: buckets")
+{
+  LatencyHistogram histogram;
+  CHECK(histogram.Buckets().empty());
+
+  histogram.RecordValues(3, 2);
+  histogram.Record(5);
+  histogram.Record(123456789);
+
+  const auto buckets = histogram.Buckets();
+  REQUIRE(buckets.size() == 3);
+  CHECK(buckets[0] == std::make_pair<uint64_t, uint64_t>(3, 2));
+  CHECK(buckets[1] == std::make_pair<uint64_t, uint64_t>(5, 1));
+  // The largest bucket reports the largest value rather than its upper end
+  CHECK(buckets[2] == std::make_pair<uint64_t, uint64_t>(123456789, 1));
+}
+
+TEST_CASE("latency_histogram: merge")
+{
+  LatencyHistogram first;
+  LatencyHistogram second;
+  for (uint64_t i = 1; i <= 50; i++) {
+    first.Record(i);
+  }
+  for (uint64_t i = 51; i <= 100; i++) {
+    second.Record(i);
+  }
+
+  SUBCASE("direct")
+  {
+    REQUIRE(first.Merge(second).IsOk());
+  }
+  SUBCASE("serialized")
+  {
+    REQUIRE(first.MergeSerialized(second.Serialize()).IsOk());
+  }
+
+  CHECK(first.TotalCount() == 100);
+  CHECK(first.Min() == 1);
+  CHECK(first.Max() == 100);
+  CHECK(first.Mean() == 50);
+  CHECK(first.ValueAtPercentile(50) == 51);
+}
+
+TEST_CASE("latency_histogram: merge into empty")
+{
+  LatencyHistogram empty;
+  LatencyHistogram other;
+  other.Record(42);
+  REQUIRE(empty.Merge(other).IsOk());
+  CHECK(empty.TotalCount() == 1);
+  CHECK(empty.ValueAtPercentile(50) == 42);
+}
+
+TEST_CASE("latency_histogram: merge with different configuration fails")
+{
+  LatencyHistogram first(1000000, 3);
+  LatencyHistogram second(1000000, 2);
+  second.Record(10);
+  CHECK(!first.Merge(second).IsOk());
+  CHECK(!first.MergeSerialized(second.Serialize()).IsOk());
+  CHECK(first.TotalCount() == 0);
+}
+
+}}  // namespace triton::perfanalyzer
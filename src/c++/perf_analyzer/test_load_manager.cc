@@ -24,6 +24,8 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <set>
+
 #include "command_line_parser.h"
 #include "doctest.h"
 #include "load_manager.h"
@@ -114,12 +116,12 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
   {
     using time_point = std::chrono::time_point<std::chrono::system_clock>;
     using ns = std::chrono::nanoseconds;
-    auto timestamp1 =
-        std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false);
-    auto timestamp2 =
-        std::make_tuple(time_point(ns(3)), time_point(ns(4)), 0, false);
-    auto timestamp3 =
-        std::make_tuple(time_point(ns(5)), time_point(ns(6)), 0, false);
+    auto timestamp1 = std::make_tuple(
+        time_point(ns(1)), time_point(ns(2)), 0, false, time_point(ns(2)), 1);
+    auto timestamp2 = std::make_tuple(
+        time_point(ns(3)), time_point(ns(4)), 0, false, time_point(ns(4)), 1);
+    auto timestamp3 = std::make_tuple(
+        time_point(ns(5)), time_point(ns(6)), 0, false, time_point(ns(6)), 1);
 
     TimestampVector source_timestamps;
 
@@ -142,14 +144,14 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     SUBCASE("One thread")
     {
       auto stat1 = std::make_shared<ThreadStat>();
-      stat1->request_timestamps_.push_back(timestamp1);
-      stat1->request_timestamps_.push_back(timestamp2);
-      stat1->request_timestamps_.push_back(timestamp3);
+      stat1->request_timestamps_.Push(timestamp1);
+      stat1->request_timestamps_.Push(timestamp2);
+      stat1->request_timestamps_.Push(timestamp3);
       threads_stat_.push_back(stat1);
 
-      CHECK(stat1->request_timestamps_.size() == 3);
+      CHECK(stat1->request_timestamps_.Size() == 3);
       auto ret = SwapTimestamps(source_timestamps);
-      CHECK(stat1->request_timestamps_.size() == 0);
+      CHECK(stat1->request_timestamps_.Size() == 0);
 
       REQUIRE(source_timestamps.size() == 3);
       CHECK(source_timestamps[0] == timestamp1);
@@ -160,20 +162,20 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     SUBCASE("Multiple threads")
     {
       auto stat1 = std::make_shared<ThreadStat>();
-      stat1->request_timestamps_.push_back(timestamp2);
+      stat1->request_timestamps_.Push(timestamp2);
 
       auto stat2 = std::make_shared<ThreadStat>();
-      stat2->request_timestamps_.push_back(timestamp1);
-      stat2->request_timestamps_.push_back(timestamp3);
+      stat2->request_timestamps_.Push(timestamp1);
+      stat2->request_timestamps_.Push(timestamp3);
 
       threads_stat_.push_back(stat1);
       threads_stat_.push_back(stat2);
 
-      CHECK(stat1->request_timestamps_.size() == 1);
-      CHECK(stat2->request_timestamps_.size() == 2);
+      CHECK(stat1->request_timestamps_.Size() == 1);
+      CHECK(stat2->request_timestamps_.Size() == 2);
       auto ret = SwapTimestamps(source_timestamps);
-      CHECK(stat1->request_timestamps_.size() == 0);
-      CHECK(stat2->request_timestamps_.size() == 0);
+      CHECK(stat1->request_timestamps_.Size() == 0);
+      CHECK(stat2->request_timestamps_.Size() == 0);
 
       REQUIRE(source_timestamps.size() == 3);
       CHECK(source_timestamps[0] == timestamp2);
@@ -183,6 +185,15 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     }
   }
 
+  /// Adds the stats of the contexts of a thread the way the contexts do
+  /// after reading them from their backends
+  void PublishContextStats(std::shared_ptr<ThreadStat>& thread_stat)
+  {
+    for (const auto& context_stat : thread_stat->contexts_stat_) {
+      thread_stat->client_stat_.Add(cb::InferStat(), context_stat);
+    }
+  }
+
   /// Test the public function GetAccumulatedClientStat
   ///
   /// It will accumulate all contexts_stat data from all threads_stat
@@ -208,6 +219,7 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
       stat1->contexts_stat_[0].cumulative_total_request_time_ns = 3;
       stat1->contexts_stat_[0].cumulative_send_time_ns = 4;
       stat1->contexts_stat_[0].cumulative_receive_time_ns = 5;
+      PublishContextStats(stat1);
       threads_stat_.push_back(stat1);
 
       auto ret = GetAccumulatedClientStat(&result_stat);
@@ -230,6 +242,7 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
       stat1->contexts_stat_[1].cumulative_total_request_time_ns = 4;
       stat1->contexts_stat_[1].cumulative_send_time_ns = 5;
       stat1->contexts_stat_[1].cumulative_receive_time_ns = 6;
+      PublishContextStats(stat1);
       threads_stat_.push_back(stat1);
 
       auto stat2 = std::make_shared<ThreadStat>();
@@ -243,6 +256,7 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
       stat2->contexts_stat_[1].cumulative_total_request_time_ns = 12;
       stat2->contexts_stat_[1].cumulative_send_time_ns = 13;
       stat2->contexts_stat_[1].cumulative_receive_time_ns = 14;
+      PublishContextStats(stat2);
       threads_stat_.push_back(stat2);
 
       auto ret = GetAccumulatedClientStat(&result_stat);
@@ -261,6 +275,26 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
 
       CHECK(ret.IsOk() == true);
     }
+    SUBCASE("Context stats growing")
+    {
+      // Only what a context stat grew by since it was last read is added
+      auto stat1 = std::make_shared<ThreadStat>();
+      cb::InferStat first;
+      first.completed_request_count = 2;
+      first.cumulative_total_request_time_ns = 30;
+      stat1->client_stat_.Add(cb::InferStat(), first);
+      cb::InferStat second = first;
+      second.completed_request_count = 5;
+      second.cumulative_total_request_time_ns = 70;
+      stat1->client_stat_.Add(first, second);
+      threads_stat_.push_back(stat1);
+
+      auto ret = GetAccumulatedClientStat(&result_stat);
+      CHECK(result_stat.completed_request_count == 5);
+      CHECK(result_stat.cumulative_total_request_time_ns == 70);
+      CHECK(result_stat.cumulative_send_time_ns == 0);
+      CHECK(ret.IsOk() == true);
+    }
   }
 
   /// Test the public function CountCollectedRequests
@@ -272,43 +306,145 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
   {
     using time_point = std::chrono::time_point<std::chrono::system_clock>;
     using ns = std::chrono::nanoseconds;
-    auto timestamp1 =
-        std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false);
-    auto timestamp2 =
-        std::make_tuple(time_point(ns(3)), time_point(ns(4)), 0, false);
-    auto timestamp3 =
-        std::make_tuple(time_point(ns(5)), time_point(ns(6)), 0, false);
+    auto timestamp1 = std::make_tuple(
+        time_point(ns(1)), time_point(ns(2)), 0, false, time_point(ns(2)), 1);
+    auto timestamp2 = std::make_tuple(
+        time_point(ns(3)), time_point(ns(4)), 0, false, time_point(ns(4)), 1);
+    auto timestamp3 = std::make_tuple(
+        time_point(ns(5)), time_point(ns(6)), 0, false, time_point(ns(6)), 1);
 
     SUBCASE("No threads") { CHECK(CountCollectedRequests() == 0); }
     SUBCASE("One thread")
     {
       auto stat1 = std::make_shared<ThreadStat>();
-      stat1->request_timestamps_.push_back(timestamp1);
-      stat1->request_timestamps_.push_back(timestamp2);
-      stat1->request_timestamps_.push_back(timestamp3);
+      stat1->request_timestamps_.Push(timestamp1);
+      stat1->request_timestamps_.Push(timestamp2);
+      stat1->request_timestamps_.Push(timestamp3);
       threads_stat_.push_back(stat1);
 
-      CHECK(stat1->request_timestamps_.size() == 3);
+      CHECK(stat1->request_timestamps_.Size() == 3);
       CHECK(CountCollectedRequests() == 3);
-      CHECK(stat1->request_timestamps_.size() == 3);
+      CHECK(stat1->request_timestamps_.Size() == 3);
     }
     SUBCASE("Multiple threads")
     {
       auto stat1 = std::make_shared<ThreadStat>();
-      stat1->request_timestamps_.push_back(timestamp2);
+      stat1->request_timestamps_.Push(timestamp2);
 
       auto stat2 = std::make_shared<ThreadStat>();
-      stat2->request_timestamps_.push_back(timestamp1);
-      stat2->request_timestamps_.push_back(timestamp3);
+      stat2->request_timestamps_.Push(timestamp1);
+      stat2->request_timestamps_.Push(timestamp3);
 
       threads_stat_.push_back(stat1);
       threads_stat_.push_back(stat2);
 
-      CHECK(stat1->request_timestamps_.size() == 1);
-      CHECK(stat2->request_timestamps_.size() == 2);
+      CHECK(stat1->request_timestamps_.Size() == 1);
+      CHECK(stat2->request_timestamps_.Size() == 2);
       CHECK(CountCollectedRequests() == 3);
-      CHECK(stat1->request_timestamps_.size() == 1);
-      CHECK(stat2->request_timestamps_.size() == 2);
+      CHECK(stat1->request_timestamps_.Size() == 1);
+      CHECK(stat2->request_timestamps_.Size() == 2);
+    }
+  }
+
+  /// Test the public function WaitForCollectedRequests
+  ///
+  /// It returns as soon as the requests are collected, counting the ones
+  /// collected before the call
+  ///
+  void TestWaitForCollectedRequests()
+  {
+    using time_point = std::chrono::time_point<std::chrono::system_clock>;
+    using ns = std::chrono::nanoseconds;
+    auto timestamp = std::make_tuple(
+        time_point(ns(1)), time_point(ns(2)), 0, false, time_point(ns(2)), 1);
+
+    auto stat = std::make_shared<ThreadStat>();
+    stat->completion_counter_ = completion_counter_;
+    threads_stat_.push_back(stat);
+    auto complete = [stat, timestamp]() {
+      stat->request_timestamps_.Push(timestamp);
+      stat->completion_counter_->Increment();
+    };
+    complete();
+
+    SUBCASE("Already collected")
+    {
+      CHECK(WaitForCollectedRequests(1, std::chrono::seconds(10)));
+    }
+    SUBCASE("Timeout")
+    {
+      CHECK(!WaitForCollectedRequests(2, std::chrono::milliseconds(10)));
+    }
+    SUBCASE("Completed while waiting")
+    {
+      std::thread worker([complete]() {
+        for (size_t i = 0; i < 3; i++) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          complete();
+        }
+      });
+      const auto start = std::chrono::steady_clock::now();
+      CHECK(WaitForCollectedRequests(4, std::chrono::seconds(10)));
+      CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+      CHECK(CountCollectedRequests() == 4);
+      worker.join();
+    }
+  }
+
+  /// Test that threads sharing nothing count their completed requests on
+  /// their own and draw sequence IDs apart from each other
+  ///
+  void TestShareNothing()
+  {
+    SetShareNothing();
+
+    SUBCASE("Completed requests are polled")
+    {
+      AddThreadStat();
+      auto stat = threads_stat_.back();
+      CHECK(stat->completion_counter_ == nullptr);
+
+      using time_point = std::chrono::time_point<std::chrono::system_clock>;
+      using ns = std::chrono::nanoseconds;
+      auto timestamp = std::make_tuple(
+          time_point(ns(1)), time_point(ns(2)), 0, false, time_point(ns(2)),
+          1);
+      std::thread worker([stat, timestamp]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        stat->request_timestamps_.Push(timestamp);
+      });
+      CHECK(WaitForCollectedRequests(1, std::chrono::seconds(10)));
+      CHECK(!WaitForCollectedRequests(2, std::chrono::milliseconds(10)));
+      worker.join();
+    }
+
+    SUBCASE("Sequence IDs are sliced between the threads")
+    {
+      // Too few IDs for a range per status, which would otherwise have the
+      // threads share the ID counter of one sequence manager
+      on_sequence_model_ = true;
+      max_threads_ = 2;
+      start_sequence_id_ = 1;
+      sequence_id_range_ = 4;
+      sequence_manager_ = MakeSequenceManager(
+          1, 4, 10, false, 0.0, false, std::make_shared<MockDataLoader>());
+      sequence_manager_->InitSequenceStatuses(6);
+
+      std::set<uint64_t> ids[2];
+      for (uint32_t thread = 0; thread < 2; thread++) {
+        AddThreadStat();
+        auto manager = WorkerSequenceManager();
+        REQUIRE(manager != sequence_manager_);
+        CHECK(manager->GetNumSequenceStatuses() == 6);
+        // Each thread starts sequences on its own statuses, taken in turn
+        for (uint32_t status = thread; status < 4; status += 2) {
+          auto options = std::make_unique<cb::InferOptions>("model");
+          manager->SetInferSequenceOptions(status, options);
+          ids[thread].insert(options->sequence_id_);
+        }
+      }
+      CHECK(ids[0] == std::set<uint64_t>{1, 2});
+      CHECK(ids[1] == std::set<uint64_t>{3, 4});
     }
   }
 
@@ -322,8 +458,8 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     SUBCASE("All active")
     {
       // If multiple threads are active, their idle times are averaged
-      stat1->idle_timer.idle_ns_ = 5;
-      stat2->idle_timer.idle_ns_ = 7;
+      stat1->idle_timer.total_ns_ = 5;
+      stat2->idle_timer.total_ns_ = 7;
       CHECK(GetIdleTime() == 6);
       ResetIdleTime();
       CHECK(GetIdleTime() == 0);
@@ -333,8 +469,8 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
     {
       // If a thread has no idle time, it is considered inactive and not
       // factored in to the average
-      stat1->idle_timer.idle_ns_ = 0;
-      stat2->idle_timer.idle_ns_ = 7;
+      stat1->idle_timer.total_ns_ = 0;
+      stat2->idle_timer.total_ns_ = 7;
       CHECK(GetIdleTime() == 7);
       ResetIdleTime();
       CHECK(GetIdleTime() == 0);
@@ -371,6 +507,22 @@ TEST_CASE(
   tlm.TestCountCollectedRequests();
 }
 
+TEST_CASE(
+    "load_manager_wait_for_collected_requests: Test the public function "
+    "WaitForCollectedRequests()")
+{
+  TestLoadManager tlm(PerfAnalyzerParameters{});
+  tlm.TestWaitForCollectedRequests();
+}
+
+TEST_CASE(
+    "load_manager_share_nothing: Test the threads sharing no state, see "
+    "SetShareNothing()")
+{
+  TestLoadManager tlm(PerfAnalyzerParameters{});
+  tlm.TestShareNothing();
+}
+
 TEST_CASE("load_manager_batch_size: Test the public function BatchSize()")
 {
   PerfAnalyzerParameters params;
@@ -417,4 +569,32 @@ TEST_CASE(
   CHECK(tlm.threads_stat_[1]->num_sent_requests_ == 0);
 }
 
+TEST_CASE(
+    "load_manager: testing the GetAndResetBucketLatencies function merges "
+    "the buckets of all the threads")
+{
+  PerfAnalyzerParameters params{};
+
+  TestLoadManager tlm(params);
+
+  std::shared_ptr<ThreadStat> thread_stat_1{std::make_shared<ThreadStat>()};
+  std::shared_ptr<ThreadStat> thread_stat_2{std::make_shared<ThreadStat>()};
+
+  thread_stat_1->bucket_latency_histograms_["stream 0"].Record(1000);
+  thread_stat_1->bucket_latency_histograms_["stream 1"].Record(2000);
+  thread_stat_2->bucket_latency_histograms_["stream 1"].Record(4000);
+
+  tlm.threads_stat_ = {thread_stat_1, thread_stat_2};
+
+  std::map<std::string, LatencyHistogram> buckets;
+  REQUIRE(tlm.GetAndResetBucketLatencies(&buckets).IsOk());
+
+  REQUIRE(buckets.size() == 2);
+  CHECK(buckets["stream 0"].TotalCount() == 1);
+  CHECK(buckets["stream 1"].TotalCount() == 2);
+  CHECK(buckets["stream 1"].Max() >= 4000);
+  CHECK(tlm.threads_stat_[0]->bucket_latency_histograms_.empty());
+  CHECK(tlm.threads_stat_[1]->bucket_latency_histograms_.empty());
+}
+
 }}  // namespace triton::perfanalyzer
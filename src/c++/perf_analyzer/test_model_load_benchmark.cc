@@ -0,0 +1,132 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "doctest.h"
+#include "model_load_benchmark.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// A server holding one model, which keeps being served for a few polls after
+// it is unloaded and uses GPU memory while it is loaded
+class ModelControlBackend : public cb::ClientBackend {
+ public:
+  cb::Error LoadModel(
+      const std::string& model_name, const std::string& config) override
+  {
+    load_count++;
+    last_config = config;
+    polls_until_unloaded = 0;
+    loaded = true;
+    return cb::Error::Success;
+  }
+
+  cb::Error UnloadModel(const std::string& model_name) override
+  {
+    polls_until_unloaded = 2;
+    return cb::Error::Success;
+  }
+
+  cb::Error ModelMetadata(
+      rapidjson::Document* model_metadata, const std::string& model_name,
+      const std::string& model_version) override
+  {
+    if (loaded && (polls_until_unloaded > 0) &&
+        (--polls_until_unloaded == 0)) {
+      loaded = false;
+    }
+    return loaded ? cb::Error::Success
+                  : cb::Error("model is not ready", pa::GENERIC_ERROR);
+  }
+
+  cb::Error Metrics(triton::perfanalyzer::Metrics& metrics) override
+  {
+    metrics.gpu_memory_used_bytes_per_gpu["GPU-0"] = loaded ? 1100 : 1000;
+    metrics.gpu_memory_used_bytes_per_gpu["GPU-1"] = loaded ? 2050 : 2000;
+    return cb::Error::Success;
+  }
+
+  bool loaded{true};
+  size_t polls_until_unloaded{0};
+  size_t load_count{0};
+  std::string last_config;
+};
+
+}  // namespace
+
+TEST_CASE("model_load_benchmark: cycles the model")
+{
+  ModelControlBackend backend;
+  size_t infer_count = 0;
+  ModelLoadBenchmark benchmark(
+      &backend, "m", R"({"max_batch_size": 8})",
+      [&]() {
+        infer_count++;
+        return backend.loaded
+                   ? cb::Error::Success
+                   : cb::Error("model is not ready", pa::GENERIC_ERROR);
+      },
+      std::chrono::milliseconds(1));
+
+  std::vector<ModelLoadSample> samples;
+  REQUIRE(benchmark.Run(3, &samples).IsOk());
+  REQUIRE(samples.size() == 3);
+  CHECK(backend.load_count == 3);
+  CHECK(backend.last_config == R"({"max_batch_size": 8})");
+  CHECK(infer_count == 3);
+  CHECK(backend.loaded);
+  for (const auto& sample : samples) {
+    CHECK(sample.first_infer_ns >= sample.load_ns);
+    CHECK(sample.gpu_memory_delta_bytes == 150);
+  }
+
+  std::ostringstream report;
+  ModelLoadBenchmark::Report(samples, true, report);
+  CHECK(report.str().find("Model load (3 iterations)") != std::string::npos);
+  CHECK(report.str().find("Time to first inference: avg") != std::string::npos);
+  CHECK(
+      report.str().find("GPU memory delta: avg 0.00 MB") != std::string::npos);
+}
+
+TEST_CASE("model_load_benchmark: stops at the first error")
+{
+  ModelControlBackend backend;
+  ModelLoadBenchmark benchmark(
+      &backend, "m", "",
+      []() { return cb::Error("inference failed", pa::GENERIC_ERROR); },
+      std::chrono::milliseconds(0));
+
+  std::vector<ModelLoadSample> samples;
+  const cb::Error err = benchmark.Run(3, &samples);
+  CHECK(!err.IsOk());
+  CHECK(err.Message() == "inference failed");
+  CHECK(backend.load_count == 1);
+  CHECK(samples.empty());
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,107 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include "doctest.h"
+#include "model_mix.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("model_mix: parse model mixes")
+{
+  std::vector<ModelMixEntry> entries;
+
+  SUBCASE("names, versions and weights")
+  {
+    REQUIRE(ParseModelMix("resnet=3,densenet:2,bert:1=0.5", &entries).IsOk());
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].model_name == "resnet");
+    CHECK(entries[0].model_version == "");
+    CHECK(entries[0].weight == doctest::Approx(3));
+    CHECK(entries[1].model_name == "densenet");
+    CHECK(entries[1].model_version == "2");
+    CHECK(entries[1].weight == doctest::Approx(1));
+    CHECK(entries[2].model_name == "bert");
+    CHECK(entries[2].model_version == "1");
+    CHECK(entries[2].weight == doctest::Approx(0.5));
+    CHECK(entries[2].data_stream == -1);
+  }
+  SUBCASE("data streams")
+  {
+    REQUIRE(ParseModelMix("resnet=3@1,densenet:2@0,bert", &entries).IsOk());
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].weight == doctest::Approx(3));
+    CHECK(entries[0].data_stream == 1);
+    CHECK(entries[1].model_version == "2");
+    CHECK(entries[1].data_stream == 0);
+    CHECK(entries[2].data_stream == -1);
+
+    CHECK(!ParseModelMix("a@", &entries).IsOk());
+    CHECK(!ParseModelMix("a@-1", &entries).IsOk());
+    CHECK(!ParseModelMix("a@1x", &entries).IsOk());
+  }
+  SUBCASE("invalid mixes")
+  {
+    CHECK(!ParseModelMix("", &entries).IsOk());
+    CHECK(!ParseModelMix("a,,b", &entries).IsOk());
+    CHECK(!ParseModelMix("=2", &entries).IsOk());
+    CHECK(!ParseModelMix("a:=2", &entries).IsOk());
+    CHECK(!ParseModelMix("a=0", &entries).IsOk());
+    CHECK(!ParseModelMix("a=-1", &entries).IsOk());
+    CHECK(!ParseModelMix("a=2x", &entries).IsOk());
+    CHECK(entries.empty());
+
+    cb::Error err = ParseModelMix("a=1,b=c", &entries);
+    CHECK(
+        err.Message() ==
+        "invalid weight in model mix: 'b=c', weights must be positive "
+        "numbers");
+  }
+}
+
+TEST_CASE("model_mix: pick models by weight")
+{
+  ModelMix mix({{"a", "", 1}, {"b", "", 3}});
+
+  REQUIRE(mix.Size() == 2);
+  CHECK(mix.Entry(1).model_name == "b");
+
+  CHECK(mix.Pick(0.0) == 0);
+  CHECK(mix.Pick(0.2) == 0);
+  CHECK(mix.Pick(0.25) == 1);
+  CHECK(mix.Pick(0.9) == 1);
+  CHECK(mix.Pick(0.9999999) == 1);
+
+  std::vector<size_t> counts(mix.Size(), 0);
+  const size_t draws = 1000;
+  for (size_t i = 0; i < draws; i++) {
+    counts[mix.Pick((i + 0.5) / draws)]++;
+  }
+  CHECK(counts[0] == 250);
+  CHECK(counts[1] == 750);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -25,7 +25,11 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <rapidjson/document.h>
+#include <unistd.h>
+
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
 #include "client_backend/client_backend.h"
 #include "constants.h"
 #include "doctest.h"
@@ -40,8 +44,75 @@ class TestModelParser {
     ModelParser mp{};
     return mp.GetInt(value, integer_value);
   }
+
+  static cb::Error FetchComposingConfigs(
+      ModelParser& parser, const rapidjson::Document& config,
+      std::unique_ptr<cb::ClientBackend>& backend,
+      ModelConfigMap* composing_configs)
+  {
+    return parser.FetchComposingConfigs(config, backend, composing_configs);
+  }
+
+  static std::string CachedConfigPath(
+      const ModelParser& parser, const cb::ModelIdentifier& model)
+  {
+    return parser.CachedConfigPath(model);
+  }
+};
+
+namespace {
+
+// Serves canned model configs and counts the requests for them
+class ConfigBackend : public cb::ClientBackend {
+ public:
+  ConfigBackend(
+      const std::map<std::string, std::string>& configs,
+      std::atomic<int>* request_count)
+      : configs_(configs), request_count_(request_count)
+  {
+  }
+
+  cb::Error ModelConfig(
+      rapidjson::Document* model_config, const std::string& model_name,
+      const std::string& model_version) override
+  {
+    (*request_count_)++;
+    const auto it = configs_.find(model_name + ":" + model_version);
+    if (it == configs_.end()) {
+      return cb::Error("unknown model " + model_name, GENERIC_ERROR);
+    }
+    model_config->Parse(it->second.c_str());
+    return cb::Error::Success;
+  }
+
+ private:
+  const std::map<std::string, std::string>& configs_;
+  std::atomic<int>* request_count_;
+};
+
+class ConfigBackendFactory : public cb::ClientBackendFactory {
+ public:
+  ConfigBackendFactory(
+      const std::map<std::string, std::string>& configs,
+      std::atomic<int>* request_count)
+      : configs_(configs), request_count_(request_count)
+  {
+  }
+
+  cb::Error CreateClientBackend(
+      std::unique_ptr<cb::ClientBackend>* backend) override
+  {
+    backend->reset(new ConfigBackend(configs_, request_count_));
+    return cb::Error::Success;
+  }
+
+ private:
+  const std::map<std::string, std::string>& configs_;
+  std::atomic<int>* request_count_;
 };
 
+}  // namespace
+
 TEST_CASE("testing the GetInt function")
 {
   int64_t integer_value{0};
@@ -100,4 +171,92 @@ TEST_CASE("testing the GetInt function")
   }
 }
 
+TEST_CASE("testing the FetchComposingConfigs function")
+{
+  // The inner ensemble shares a model with the outer one
+  const std::map<std::string, std::string> configs{
+      {"a:1", R"({"name": "a", "platform": "onnxruntime_onnx"})"},
+      {"b:", R"({"name": "b", "platform": "onnxruntime_onnx"})"},
+      {"c:3", R"({"name": "c", "platform": "onnxruntime_onnx"})"},
+      {"inner:2", R"({"name": "inner", "platform": "ensemble",
+          "ensemble_scheduling": {"step": [
+            {"model_name": "a", "model_version": 1},
+            {"model_name": "c", "model_version": "3"}]}})"}};
+  rapidjson::Document config;
+  config.Parse(R"({"name": "outer", "platform": "ensemble",
+      "ensemble_scheduling": {"step": [
+        {"model_name": "a", "model_version": 1},
+        {"model_name": "b", "model_version": -1},
+        {"model_name": "inner", "model_version": 2}]}})");
+
+  std::atomic<int> request_count{0};
+  std::unique_ptr<cb::ClientBackend> backend(
+      new ConfigBackend(configs, &request_count));
+  auto factory =
+      std::make_shared<ConfigBackendFactory>(configs, &request_count);
+  auto fetch = [&](const std::string& cache_directory) {
+    ModelParser parser(cb::BackendKind::TRITON);
+    parser.SetConfigFetching(factory, cache_directory, "localhost:8001");
+    ModelConfigMap composing_configs;
+    REQUIRE(TestModelParser::FetchComposingConfigs(
+                parser, config, backend, &composing_configs)
+                .IsOk());
+    return composing_configs;
+  };
+
+  SUBCASE("every config is fetched once")
+  {
+    const auto composing_configs = fetch("");
+    CHECK(request_count == 4);
+    REQUIRE(composing_configs.size() == 4);
+    for (const auto& composing_config : composing_configs) {
+      CHECK(
+          (*composing_config.second)["name"].GetString() ==
+          composing_config.first.first);
+    }
+    CHECK(composing_configs.count({"b", ""}) == 1);
+    CHECK(composing_configs.count({"c", "3"}) == 1);
+  }
+
+  SUBCASE("configs with a version are cached")
+  {
+    char path[] = "/tmp/model_config_cache_XXXXXX";
+    REQUIRE(mkdtemp(path) != nullptr);
+    const std::string cache_directory(path);
+
+    fetch(cache_directory);
+    CHECK(request_count == 4);
+
+    // Only the model without a version is fetched again
+    request_count = 0;
+    const auto composing_configs = fetch(cache_directory);
+    CHECK(request_count == 1);
+    REQUIRE(composing_configs.size() == 4);
+    CHECK(
+        std::string((*composing_configs.at({"inner", "2"}))["platform"]
+                        .GetString()) == "ensemble");
+
+    ModelParser parser(cb::BackendKind::TRITON);
+    parser.SetConfigFetching(factory, cache_directory, "localhost:8001");
+    for (const auto& composing_config : composing_configs) {
+      std::remove(
+          TestModelParser::CachedConfigPath(parser, composing_config.first)
+              .c_str());
+    }
+    CHECK(rmdir(path) == 0);
+  }
+
+  SUBCASE("missing composing model")
+  {
+    config.Parse(R"({"name": "outer", "platform": "ensemble",
+        "ensemble_scheduling": {"step": [
+          {"model_name": "d", "model_version": -1}]}})");
+    ModelParser parser(cb::BackendKind::TRITON);
+    ModelConfigMap composing_configs;
+    CHECK(!TestModelParser::FetchComposingConfigs(
+               parser, config, backend, &composing_configs)
+               .IsOk());
+  }
+}
+
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,209 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <thread>
+#include "doctest.h"
+#include "output_validator.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+template <typename T>
+const uint8_t*
+Bytes(const std::vector<T>& values)
+{
+  return reinterpret_cast<const uint8_t*>(values.data());
+}
+
+// A response holding the data of its outputs
+class OutputsInferResult : public cb::InferResult {
+ public:
+  explicit OutputsInferResult(
+      const std::map<std::string, std::vector<float>>& outputs)
+      : outputs_(outputs)
+  {
+  }
+
+  cb::Error Id(std::string* id) const override { return cb::Error::Success; }
+  cb::Error RequestStatus() const override { return cb::Error::Success; }
+  cb::Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    const auto& data = outputs_.at(output_name);
+    *buf = Bytes(data);
+    *byte_size = data.size() * sizeof(float);
+    return cb::Error::Success;
+  }
+
+ private:
+  std::map<std::string, std::vector<float>> outputs_;
+};
+
+}  // namespace
+
+TEST_CASE("output_validator: compare output data")
+{
+  double max_abs_error = 0.0;
+
+  SUBCASE("FP32 within the tolerance")
+  {
+    const std::vector<float> actual{1.0f, 2.05f, 100.5f};
+    const std::vector<float> expected{1.0f, 2.0f, 100.0f};
+    CHECK(
+        CompareOutputData(
+            DataType::FP32, Bytes(actual), Bytes(expected), 12, {0.1, 0.01},
+            &max_abs_error) == 0);
+    CHECK(max_abs_error == doctest::Approx(0.5));
+    CHECK(
+        CompareOutputData(
+            DataType::FP32, Bytes(actual), Bytes(expected), 12, {0.1, 0.0},
+            &max_abs_error) == 1);
+  }
+
+  SUBCASE("FP32 NaN")
+  {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const std::vector<float> actual{nan, nan, 1.0f};
+    const std::vector<float> expected{nan, 1.0f, nan};
+    CHECK(
+        CompareOutputData(
+            DataType::FP32, Bytes(actual), Bytes(expected), 12, {1.0, 0.0},
+            &max_abs_error) == 2);
+  }
+
+  SUBCASE("FP16 and BF16")
+  {
+    // 1.0, 2.0 and 65504 in half precision, 1.0 and 1.0078125 in bfloat16
+    const std::vector<uint16_t> half_actual{0x3c00, 0x4000, 0x7bff};
+    const std::vector<uint16_t> half_expected{0x3c00, 0x4001, 0x7bff};
+    CHECK(
+        CompareOutputData(
+            DataType::FP16, Bytes(half_actual), Bytes(half_expected), 6,
+            {0.0, 0.0}, &max_abs_error) == 1);
+    CHECK(max_abs_error == doctest::Approx(0.001953125));
+    CHECK(
+        CompareOutputData(
+            DataType::FP16, Bytes(half_actual), Bytes(half_expected), 6,
+            {0.002, 0.0}, &max_abs_error) == 0);
+
+    const std::vector<uint16_t> bf16_actual{0x3f80};
+    const std::vector<uint16_t> bf16_expected{0x3f81};
+    CHECK(
+        CompareOutputData(
+            DataType::BF16, Bytes(bf16_actual), Bytes(bf16_expected), 2,
+            {0.0, 0.01}, &max_abs_error) == 0);
+  }
+
+  SUBCASE("other types are compared exactly")
+  {
+    const std::vector<int32_t> actual{1, 2, 3, 4};
+    const std::vector<int32_t> expected{1, 5, 3, 6};
+    CHECK(
+        CompareOutputData(
+            DataType::INT32, Bytes(actual), Bytes(expected), 16, {10.0, 10.0},
+            &max_abs_error) == 2);
+    CHECK(
+        CompareOutputData(
+            DataType::BYTES, Bytes(actual), Bytes(expected), 16, {10.0, 10.0},
+            &max_abs_error) == 1);
+    CHECK(max_abs_error == 0.0);
+  }
+}
+
+TEST_CASE("output_validator: mismatch statistics")
+{
+  ModelTensor tensor;
+  tensor.name_ = "OUTPUT0";
+  tensor.datatype_ = "FP32";
+  tensor.type_ = DataType::FP32;
+  const std::vector<float> expected{1.0f, 2.0f};
+  OutputValidator::ExpectedOutput output{
+      &tensor, {{Bytes(expected), expected.size() * sizeof(float)}}};
+
+  size_t thread_count = 0;
+  SUBCASE("on the calling thread") { thread_count = 0; }
+  SUBCASE("on validation threads") { thread_count = 2; }
+
+  OutputValidator validator({0.0, 0.0}, thread_count);
+  validator.Submit(
+      std::make_shared<OutputsInferResult>(
+          std::map<std::string, std::vector<float>>{{"OUTPUT0", expected}}),
+      {output});
+  validator.Submit(
+      std::make_shared<OutputsInferResult>(
+          std::map<std::string, std::vector<float>>{
+              {"OUTPUT0", {1.0f, 2.5f}}}),
+      {output});
+  validator.Submit(
+      std::make_shared<OutputsInferResult>(
+          std::map<std::string, std::vector<float>>{
+              {"OUTPUT0", {1.0f, 2.0f, 3.0f}}}),
+      {output});
+  const std::vector<float> in_place{0.0f, 2.0f};
+  validator.Validate(output, Bytes(in_place), 8);
+
+  // The queued outputs are validated in the background
+  ValidationStats stats;
+  for (int i = 0; (i < 1000) && (stats.output_count < 4); i++) {
+    stats.Merge(validator.GetAndResetStats());
+    if (stats.output_count < 4) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  CHECK(stats.output_count == 4);
+  CHECK(stats.mismatched_output_count == 3);
+  CHECK(stats.mismatched_element_count == 3);
+  CHECK(stats.max_abs_error == doctest::Approx(1.0));
+  CHECK(stats.skipped_output_count == 0);
+}
+
+TEST_CASE("output_validator: outputs skipped over the queue limit")
+{
+  ModelTensor tensor;
+  tensor.name_ = "OUTPUT0";
+  tensor.datatype_ = "FP32";
+  tensor.type_ = DataType::FP32;
+  const std::vector<float> expected{1.0f};
+  OutputValidator::ExpectedOutput output{&tensor, {{Bytes(expected), 4}}};
+
+  OutputValidator validator({0.0, 0.0}, 1, 0);
+  validator.Submit(
+      std::make_shared<OutputsInferResult>(
+          std::map<std::string, std::vector<float>>{{"OUTPUT0", expected}}),
+      {output, output});
+  const ValidationStats stats = validator.GetAndResetStats();
+  CHECK(stats.output_count == 0);
+  CHECK(stats.skipped_output_count == 2);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -24,6 +24,8 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <cstring>
 #include "doctest.h"
 #include "perf_utils.h"
 #include "test_utils.h"
@@ -104,4 +106,124 @@ TEST_CASE("test_distribution")
   }
 }
 
+TEST_CASE("test_decode_base64")
+{
+  auto decode = [](const std::string& encoded) {
+    std::vector<char> decoded;
+    DecodeBase64(encoded.data(), encoded.size(), &decoded);
+    return std::string(decoded.begin(), decoded.end());
+  };
+
+  CHECK(decode("") == "");
+  CHECK(decode("SGVsbG8sIHdvcmxkIQ==") == "Hello, world!");
+  CHECK(decode("SGVsbG8sIHdvcmxkIQ") == "Hello, world!");
+  CHECK(decode("SGV") == "He");
+  CHECK(decode("AAEC/f7/") == std::string("\x00\x01\x02\xfd\xfe\xff", 6));
+
+  SUBCASE("characters outside of the alphabet are skipped")
+  {
+    CHECK(decode("SGVs\nbG8s\r\nIHdv cmxk\tIQ==") == "Hello, world!");
+    CHECK(decode("S=G-V*s") == "Hel");
+  }
+}
+
+TEST_CASE("test_fill_random")
+{
+  auto fill = [](uint64_t seed, size_t size) {
+    std::vector<char> data(size);
+    FillRandomBytes(seed, data.data(), data.size());
+    return data;
+  };
+
+  // Spans several chunks, the last one partial
+  const size_t size = 3 * (1 << 20) + 5;
+  const std::vector<char> data = fill(1, size);
+  CHECK(fill(1, size) == data);
+  CHECK(fill(2, size) != data);
+
+  // A shorter buffer gets the start of the longer one
+  const std::vector<char> prefix = fill(1, 13);
+  CHECK(std::equal(prefix.begin(), prefix.end(), data.begin()));
+
+  std::string characters(1000, '\0');
+  FillRandomCharacters(1, &characters[0], characters.size());
+  CHECK(characters.find_first_not_of(character_set) == std::string::npos);
+  CHECK(GetRandomString(10).size() == 10);
+}
+
+TEST_CASE("test_serialize_explicit_tensor")
+{
+  auto serialize = [](const std::string& json, const std::string& dt,
+                      std::vector<char>* decoded) {
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    return SerializeExplicitTensor(document, ParseDataType(dt), decoded);
+  };
+  std::vector<char> decoded{'x'};
+
+  SUBCASE("bytes")
+  {
+    REQUIRE(serialize(R"(["ab", "", "c\u0000d"])", "BYTES", &decoded).IsOk());
+    CHECK(
+        std::string(decoded.begin(), decoded.end()) ==
+        std::string("x\x02\0\0\0ab\0\0\0\0\x03\0\0\0c\0d", 18));
+
+    std::vector<char> serialized{'x'};
+    SerializeStringTensor({"ab", "", std::string("c\0d", 3)}, &serialized);
+    CHECK(serialized == decoded);
+  }
+
+  SUBCASE("numbers")
+  {
+    REQUIRE(serialize("[1, -2, 3]", "INT32", &decoded).IsOk());
+    REQUIRE(decoded.size() == 1 + 3 * sizeof(int32_t));
+    int32_t values[3];
+    std::memcpy(values, decoded.data() + 1, sizeof(values));
+    CHECK(values[0] == 1);
+    CHECK(values[1] == -2);
+    CHECK(values[2] == 3);
+  }
+
+  SUBCASE("half precision")
+  {
+    REQUIRE(serialize("[1, -2.5, 65504]", "FP16", &decoded).IsOk());
+    REQUIRE(serialize("[1, -2.5]", "BF16", &decoded).IsOk());
+    REQUIRE(decoded.size() == 1 + 5 * sizeof(uint16_t));
+    uint16_t values[5];
+    std::memcpy(values, decoded.data() + 1, sizeof(values));
+    CHECK(values[0] == 0x3c00);
+    CHECK(values[1] == 0xc100);
+    CHECK(values[2] == 0x7bff);
+    CHECK(values[3] == 0x3f80);
+    CHECK(values[4] == 0xc020);
+  }
+
+  SUBCASE("mismatched types leave the data unchanged")
+  {
+    CHECK(!serialize(R"(["a", 1])", "BYTES", &decoded).IsOk());
+    CHECK(!serialize("[1, 1.5]", "INT32", &decoded).IsOk());
+    CHECK(!serialize(R"([1, "a"])", "FP16", &decoded).IsOk());
+    CHECK(decoded == std::vector<char>{'x'});
+  }
+}
+
+TEST_CASE("test_datatype")
+{
+  for (const char* name : {"BOOL", "UINT8", "UINT16", "UINT32", "UINT64",
+                           "INT8", "INT16", "INT32", "INT64", "FP16", "FP32",
+                           "FP64", "BYTES", "BF16"}) {
+    const DataType type = ParseDataType(name);
+    CHECK(type != DataType::INVALID);
+    CHECK(std::string(DataTypeName(type)) == name);
+  }
+  CHECK(ParseDataType("FP") == DataType::INVALID);
+  CHECK(ParseDataType("fp32") == DataType::INVALID);
+
+  CHECK(ByteSize({2, 3}, DataType::BF16) == 12);
+  CHECK(ByteSize({2, 3}, "INT64") == 48);
+  CHECK(ByteSize({2, -1}, DataType::FP32) == -1);
+  CHECK(ByteSize({2, 3}, DataType::BYTES) == -1);
+  CHECK(ByteSize({2, 3}, "FP8") == -1);
+}
+
 }}  // namespace triton::perfanalyzer
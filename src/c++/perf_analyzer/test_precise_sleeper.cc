@@ -0,0 +1,63 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include "doctest.h"
+#include "precise_sleeper.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("precise_sleeper: never wakes before the deadline")
+{
+  PreciseSleeper sleeper;
+  for (int i = 0; i < 20; i++) {
+    auto deadline =
+        PreciseSleeper::Clock::now() + std::chrono::microseconds(500);
+    sleeper.SleepUntil(deadline);
+    CHECK(PreciseSleeper::Clock::now() >= deadline);
+  }
+}
+
+TEST_CASE("precise_sleeper: past deadline returns immediately")
+{
+  PreciseSleeper sleeper;
+  auto start = PreciseSleeper::Clock::now();
+  sleeper.SleepUntil(start - std::chrono::milliseconds(1));
+  CHECK(PreciseSleeper::Clock::now() - start < std::chrono::milliseconds(1));
+}
+
+TEST_CASE("precise_sleeper: spin window stays within bounds")
+{
+  PreciseSleeper sleeper;
+  for (int i = 0; i < 20; i++) {
+    sleeper.SleepUntil(
+        PreciseSleeper::Clock::now() + std::chrono::milliseconds(1));
+  }
+  CHECK(sleeper.SpinWindow() >= std::chrono::microseconds(10));
+  CHECK(sleeper.SpinWindow() <= std::chrono::milliseconds(2));
+}
+
+}}  // namespace triton::perfanalyzer
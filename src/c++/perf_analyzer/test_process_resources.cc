@@ -0,0 +1,122 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+#include "doctest.h"
+#include "process_resources.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("process_resources: parse thread stat")
+{
+  std::string name;
+  uint64_t cpu_ticks = 0;
+
+  SUBCASE("plain name")
+  {
+    REQUIRE(ParseThreadStat(
+                "1234 (pa_worker) S 1 1234 1234 0 -1 4194560 100 0 0 0 "
+                "250 30 0 0 20 0 8 0 100 0",
+                &name, &cpu_ticks)
+                .IsOk());
+    CHECK(name == "pa_worker");
+    CHECK(cpu_ticks == 280);
+  }
+  SUBCASE("name with spaces and parentheses")
+  {
+    REQUIRE(ParseThreadStat(
+                "7 (a (b) c) R 1 7 7 0 -1 0 0 0 0 0 5 6 0 0", &name,
+                &cpu_ticks)
+                .IsOk());
+    CHECK(name == "a (b) c");
+    CHECK(cpu_ticks == 11);
+  }
+  SUBCASE("invalid lines")
+  {
+    CHECK(!ParseThreadStat("", &name, &cpu_ticks).IsOk());
+    CHECK(!ParseThreadStat("7 name S 1", &name, &cpu_ticks).IsOk());
+    CHECK(!ParseThreadStat("7 (name) S 1 7 7", &name, &cpu_ticks).IsOk());
+  }
+}
+
+TEST_CASE("process_resources: summarize a window")
+{
+  ProcessResourceSample start;
+  start.time_ns = 1000000000;
+  start.user_cpu_ns = 100000000;
+  start.sys_cpu_ns = 50000000;
+  start.voluntary_context_switches = 10;
+  start.involuntary_context_switches = 2;
+  start.threads[1] = ThreadCpuTime{"perf_analyzer", 100000000};
+  start.threads[2] = ThreadCpuTime{"pa_worker", 0};
+  start.threads[3] = ThreadCpuTime{"pa_worker", 50000000};
+
+  ProcessResourceSample end;
+  end.time_ns = 3000000000;
+  end.user_cpu_ns = 1100000000;
+  end.sys_cpu_ns = 550000000;
+  end.rss_bytes = 4096;
+  end.voluntary_context_switches = 30;
+  end.involuntary_context_switches = 3;
+  end.threads[1] = ThreadCpuTime{"perf_analyzer", 300000000};
+  end.threads[2] = ThreadCpuTime{"pa_worker", 1000000000};
+  end.threads[3] = ThreadCpuTime{"pa_worker", 450000000};
+  // Started during the window
+  end.threads[4] = ThreadCpuTime{"pa_worker", 100000000};
+
+  ClientResourceStats stats;
+  SummarizeProcessResources(start, end, &stats);
+  CHECK(stats.cpu_user_pct == doctest::Approx(50.0));
+  CHECK(stats.cpu_sys_pct == doctest::Approx(25.0));
+  CHECK(stats.rss_bytes == 4096);
+  CHECK(stats.voluntary_context_switches == 20);
+  CHECK(stats.involuntary_context_switches == 1);
+  REQUIRE(stats.thread_cpu_pct.size() == 2);
+  CHECK(stats.thread_cpu_pct["perf_analyzer"] == doctest::Approx(10.0));
+  CHECK(stats.thread_cpu_pct["pa_worker"] == doctest::Approx(75.0));
+  CHECK(stats.max_thread_cpu_pct == doctest::Approx(50.0));
+}
+
+TEST_CASE("process_resources: sample the process")
+{
+  ProcessResourceSample first;
+  REQUIRE(SampleProcessResources(&first).IsOk());
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 10000000; i++) {
+    sum += i;
+  }
+  ProcessResourceSample second;
+  REQUIRE(SampleProcessResources(&second).IsOk());
+  CHECK(second.time_ns > first.time_ns);
+  CHECK(second.user_cpu_ns + second.sys_cpu_ns >=
+        first.user_cpu_ns + first.sys_cpu_ns);
+#ifdef __linux__
+  CHECK(second.rss_bytes > 0);
+  CHECK(!second.threads.empty());
+#endif
+}
+
+}}  // namespace triton::perfanalyzer
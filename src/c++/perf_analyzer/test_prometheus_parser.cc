@@ -0,0 +1,138 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <string>
+#include "doctest.h"
+#include "prometheus_parser.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+const std::string kScrape{R"(# HELP nv_inference_count Number of inferences performed
+# TYPE nv_inference_count counter
+nv_inference_count{model="simple",version="1"} 120
+nv_inference_count{model="other",version="1"} 7
+# HELP nv_inference_pending_request_count Instantaneous number of pending requests
+# TYPE nv_inference_pending_request_count gauge
+nv_inference_pending_request_count{model="simple",version="1"} 3
+# HELP nv_inference_queue_summary_us Summary of queue times
+# TYPE nv_inference_queue_summary_us summary
+nv_inference_queue_summary_us_count{model="simple",version="1"} 120
+nv_inference_queue_summary_us_sum{model="simple",version="1"} 4000.5
+nv_inference_queue_summary_us{model="simple",version="1",quantile="0.5"} 30
+# HELP nv_cpu_utilization CPU utilization rate [0.0 - 1.0]
+# TYPE nv_cpu_utilization gauge
+nv_cpu_utilization 0.25
+# HELP nv_gpu_utilization GPU utilization rate [0.0 - 1.0)
+# TYPE nv_gpu_utilization gauge
+nv_gpu_utilization{gpu_uuid="GPU-0"} 0.41
+nv_gpu_utilization{gpu_uuid="GPU-1"} 0.77
+# TYPE nv_gpu_memory_used_bytes gauge
+nv_gpu_memory_used_bytes{gpu_uuid="GPU-0"} 50000000
+)"};
+
+}  // namespace
+
+TEST_CASE("PrometheusParser")
+{
+  PrometheusParser parser(
+      {"nv_inference_count", "nv_inference_pending_request_count",
+       "nv_inference_queue_summary_us"});
+  Metrics metrics;
+
+  SUBCASE("whole scrape")
+  {
+    parser.Start(&metrics);
+    parser.Feed(kScrape.data(), kScrape.size());
+    parser.Finish();
+  }
+
+  SUBCASE("scrape in small chunks")
+  {
+    parser.Start(&metrics);
+    for (size_t i = 0; i < kScrape.size(); i += 7) {
+      parser.Feed(kScrape.data() + i, std::min<size_t>(7, kScrape.size() - i));
+    }
+    parser.Finish();
+  }
+
+  CHECK(metrics.gpu_utilization_per_gpu.size() == 2);
+  CHECK(metrics.gpu_utilization_per_gpu["GPU-0"] == doctest::Approx(0.41));
+  CHECK(metrics.gpu_utilization_per_gpu["GPU-1"] == doctest::Approx(0.77));
+  CHECK(metrics.gpu_memory_used_bytes_per_gpu["GPU-0"] == 50000000);
+  CHECK(metrics.gpu_power_usage_per_gpu.empty());
+
+  CHECK(metrics.counters.size() == 4);
+  CHECK(
+      metrics.counters["nv_inference_count{model=\"simple\",version=\"1\"}"] ==
+      doctest::Approx(120));
+  CHECK(
+      metrics.counters["nv_inference_count{model=\"other\",version=\"1\"}"] ==
+      doctest::Approx(7));
+  CHECK(
+      metrics.counters
+          ["nv_inference_queue_summary_us_sum{model=\"simple\",version=\"1\"}"] ==
+      doctest::Approx(4000.5));
+
+  // Families that are not collected are skipped
+  CHECK(metrics.gauges.size() == 2);
+  CHECK(
+      metrics.gauges
+          ["nv_inference_pending_request_count{model=\"simple\",version="
+           "\"1\"}"] == doctest::Approx(3));
+  CHECK(
+      metrics.gauges
+          ["nv_inference_queue_summary_us{model=\"simple\",version=\"1\","
+           "quantile=\"0.5\"}"] == doctest::Approx(30));
+}
+
+TEST_CASE("PrometheusParser: malformed lines")
+{
+  PrometheusParser parser({"nv_cpu_utilization"});
+  Metrics metrics;
+  const std::string scrape{
+      "nv_cpu_utilization{unclosed=\"}\" 0.5\n"
+      "nv_cpu_utilization\n"
+      "nv_cpu_utilization not_a_number\n"
+      "nv_gpu_utilization{other=\"x\"} 0.5\n"
+      "nv_cpu_utilization{note=\"a \\\"}\\\" b\"} 0.5\r\n"
+      "nv_cpu_utilization 0.75"};
+
+  parser.Start(&metrics);
+  parser.Feed(scrape.data(), scrape.size());
+  parser.Finish();
+
+  CHECK(metrics.gpu_utilization_per_gpu.empty());
+  CHECK(metrics.gauges.size() == 2);
+  CHECK(
+      metrics.gauges["nv_cpu_utilization{note=\"a \\\"}\\\" b\"}"] ==
+      doctest::Approx(0.5));
+  CHECK(metrics.gauges["nv_cpu_utilization"] == doctest::Approx(0.75));
+}
+
+}}  // namespace triton::perfanalyzer
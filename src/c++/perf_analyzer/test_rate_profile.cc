@@ -0,0 +1,126 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include "doctest.h"
+#include "rate_profile.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+// Draws the arrival times of a modulated Poisson process up to 'duration'
+std::vector<std::chrono::nanoseconds>
+DrawArrivals(
+    std::shared_ptr<RateProfile> profile, double request_rate,
+    std::chrono::nanoseconds duration, uint32_t seed = 0)
+{
+  auto distribution = ModulatedPoissonDistribution(profile, request_rate);
+  std::mt19937 rng(seed);
+  std::vector<std::chrono::nanoseconds> arrivals;
+  std::chrono::nanoseconds now(0);
+  while (true) {
+    now += distribution(rng);
+    if (now >= duration) {
+      break;
+    }
+    arrivals.push_back(now);
+  }
+  return arrivals;
+}
+
+}  // namespace
+
+TEST_CASE("rate_profile: on/off bursts")
+{
+  auto profile = std::make_shared<OnOffRateProfile>(100, 900);
+  CHECK(profile->MaxRelativeRate() == doctest::Approx(10));
+
+  auto arrivals = DrawArrivals(profile, 1000, std::chrono::seconds(20));
+  // The mean rate is kept, but every request falls in an on period
+  CHECK(arrivals.size() == doctest::Approx(20000).epsilon(0.05));
+  for (auto arrival : arrivals) {
+    REQUIRE(
+        arrival % std::chrono::milliseconds(1000) <
+        std::chrono::milliseconds(100));
+  }
+}
+
+TEST_CASE("rate_profile: markov modulated")
+{
+  auto profile = std::make_shared<MarkovModulatedRateProfile>(10, 900, 100);
+  double sum = 0;
+  const size_t steps = 1000000;
+  for (size_t i = 0; i < steps; i++) {
+    double rate = profile->RelativeRateAt(std::chrono::milliseconds(i));
+    CHECK(rate <= profile->MaxRelativeRate());
+    sum += rate;
+  }
+  // Averages to the target rate in the long run
+  CHECK(sum / steps == doctest::Approx(1.0).epsilon(0.05));
+
+  // Profiles with the same seed burst at the same time
+  auto first = std::make_shared<MarkovModulatedRateProfile>(10, 900, 100, 7);
+  auto second = std::make_shared<MarkovModulatedRateProfile>(10, 900, 100, 7);
+  for (size_t i = 0; i < 10000; i++) {
+    std::chrono::milliseconds t(i);
+    REQUIRE(first->RelativeRateAt(t) == second->RelativeRateAt(t));
+  }
+}
+
+TEST_CASE("rate_profile: diurnal")
+{
+  auto profile = std::make_shared<DiurnalRateProfile>(10, 0.8);
+  CHECK(
+      profile->RelativeRateAt(std::chrono::seconds(0)) == doctest::Approx(1));
+  CHECK(
+      profile->RelativeRateAt(std::chrono::milliseconds(2500)) ==
+      doctest::Approx(1.8));
+
+  auto arrivals = DrawArrivals(profile, 1000, std::chrono::seconds(20));
+  CHECK(arrivals.size() == doctest::Approx(20000).epsilon(0.05));
+
+  // The first half of every period is busier than the second
+  size_t first_half = 0;
+  for (auto arrival : arrivals) {
+    if (arrival % std::chrono::seconds(10) < std::chrono::seconds(5)) {
+      first_half++;
+    }
+  }
+  CHECK(first_half > 0.7 * arrivals.size());
+}
+
+TEST_CASE("rate_profile: constant rate distributions have no profile")
+{
+  RateProfileSettings settings;
+  CHECK(MakeRateProfile(Distribution::POISSON, settings).get() == nullptr);
+  CHECK(MakeRateProfile(Distribution::CONSTANT, settings).get() == nullptr);
+  CHECK(MakeRateProfile(Distribution::BURSTY, settings).get() != nullptr);
+  CHECK(MakeRateProfile(Distribution::MMPP, settings).get() != nullptr);
+  CHECK(MakeRateProfile(Distribution::DIURNAL, settings).get() != nullptr);
+}
+
+}}  // namespace triton::perfanalyzer
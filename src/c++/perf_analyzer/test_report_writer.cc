@@ -36,8 +36,38 @@ class TestReportWriter : ReportWriter {
   {
     ReportWriter::WriteGpuMetrics(ofs, metrics);
   }
+
+  void WriteMetricsCorrelation(
+      std::ostream& ofs, const MetricsCorrelation& correlation)
+  {
+    ReportWriter::WriteMetricsCorrelation(ofs, correlation);
+  }
 };
 
+TEST_CASE("testing WriteMetricsCorrelation")
+{
+  TestReportWriter trw{};
+  MetricsCorrelation correlation{};
+  correlation.infer_per_sec_per_watt = 2.5;
+  correlation.min_gpu_memory_headroom_bytes = 1024;
+  correlation.gpu_memory_trend_bytes_per_sec = -8;
+  std::ostringstream actual_output{};
+
+  SUBCASE("without tail requests")
+  {
+    trw.WriteMetricsCorrelation(actual_output, correlation);
+    CHECK(actual_output.str() == "2.5,,1024,-8,");
+  }
+
+  SUBCASE("with tail requests")
+  {
+    correlation.tail_gpu_utilization = 0.75;
+    correlation.tail_request_count = 3;
+    trw.WriteMetricsCorrelation(actual_output, correlation);
+    CHECK(actual_output.str() == "2.5,0.75,1024,-8,");
+  }
+}
+
 TEST_CASE("testing WriteGpuMetrics")
 {
   TestReportWriter trw{};
@@ -0,0 +1,116 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include "doctest.h"
+#include "request_class.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("request_class: parse request classes")
+{
+  std::vector<RequestClassEntry> entries;
+
+  SUBCASE("names, priorities, timeouts and weights")
+  {
+    REQUIRE(ParseRequestClasses(
+                "premium:1=1,bulk:2:50000=4,default", &entries)
+                .IsOk());
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].name == "premium");
+    CHECK(entries[0].priority == 1);
+    CHECK(entries[0].server_timeout_us == 0);
+    CHECK(entries[0].weight == doctest::Approx(1));
+    CHECK(entries[1].name == "bulk");
+    CHECK(entries[1].priority == 2);
+    CHECK(entries[1].server_timeout_us == 50000);
+    CHECK(entries[1].weight == doctest::Approx(4));
+    CHECK(entries[2].name == "default");
+    CHECK(entries[2].priority == 0);
+    CHECK(entries[2].server_timeout_us == 0);
+    CHECK(entries[2].weight == doctest::Approx(1));
+  }
+  SUBCASE("invalid request classes")
+  {
+    CHECK(!ParseRequestClasses("", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a,,b", &entries).IsOk());
+    CHECK(!ParseRequestClasses(":1=2", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a:=2", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a:-1", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a:1:", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a:1:10x", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a=0", &entries).IsOk());
+    CHECK(!ParseRequestClasses("a,a:2", &entries).IsOk());
+    CHECK(entries.empty());
+
+    cb::Error err = ParseRequestClasses("a,b:x", &entries);
+    CHECK(
+        err.Message() ==
+        "invalid priority in request classes: 'b:x', priorities must be "
+        "non-negative integers");
+  }
+}
+
+TEST_CASE("request_class: timeout rejections")
+{
+  CHECK(IsTimeoutRejection(
+      cb::Error("Request timeout expired", pa::GENERIC_ERROR)));
+  CHECK(IsTimeoutRejection(cb::Error("request TIMEOUT", pa::GENERIC_ERROR)));
+  CHECK_FALSE(IsTimeoutRejection(
+      cb::Error("failed to connect to the server", pa::GENERIC_ERROR)));
+  CHECK_FALSE(IsTimeoutRejection(cb::Error::Success));
+}
+
+TEST_CASE("request_class: pick request classes by weight")
+{
+  RequestClassMix mix({{"a", 1, 1}, {"b", 3, 2, 100}});
+
+  REQUIRE(mix.Size() == 2);
+  CHECK(mix.Entry(1).name == "b");
+  CHECK(mix.Entry(1).server_timeout_us == 100);
+
+  CHECK(mix.Pick(0.0) == 0);
+  CHECK(mix.Pick(0.2) == 0);
+  CHECK(mix.Pick(0.25) == 1);
+  CHECK(mix.Pick(0.9999999) == 1);
+}
+
+TEST_CASE("request_class: merge request class stats")
+{
+  RequestClassStats stats;
+  stats.latencies.Record(1000);
+  stats.rejected_count = 2;
+
+  RequestClassStats other;
+  other.latencies.Record(3000);
+  other.rejected_count = 1;
+
+  REQUIRE(stats.Merge(other).IsOk());
+  CHECK(stats.latencies.TotalCount() == 2);
+  CHECK(stats.rejected_count == 3);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -24,6 +24,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -58,8 +59,10 @@ class TestRequestRateManager : public TestLoadManagerBase,
         TestLoadManagerBase(params, is_sequence_model, is_decoupled_model),
         RequestRateManager(
             params.async, params.streaming, params.request_distribution,
-            params.batch_size, params.measurement_window_ms, params.max_trials,
+            params.rate_profile_settings, params.batch_size,
+            params.measurement_window_ms, params.max_trials,
             params.max_threads, params.num_of_sequences,
+            params.precise_scheduling, params.num_dispatcher_threads,
             params.shared_memory_type, params.output_shm_size, GetParser(),
             GetFactory())
   {
@@ -113,6 +116,76 @@ class TestRequestRateManager : public TestLoadManagerBase,
     early_exit = true;
   }
 
+  /// Test that generated Poisson schedules merge into a Poisson process at
+  /// the requested rate
+  ///
+  void TestGeneratedSchedule(double rate)
+  {
+    PauseWorkers();
+    GenerateSchedule(rate);
+
+    const nanoseconds max_timestamp{10 * NANOS_PER_SECOND};
+    std::vector<int64_t> timestamps;
+    for (auto worker : workers_) {
+      auto rrworker = std::dynamic_pointer_cast<RequestRateWorker>(worker);
+      REQUIRE(rrworker->schedule_->intervals.empty());
+      nanoseconds previous{0};
+      nanoseconds timestamp{0};
+      while (timestamp < max_timestamp) {
+        timestamp = rrworker->GetNextTimestamp();
+        REQUIRE(timestamp >= previous);
+        previous = timestamp;
+        timestamps.push_back(timestamp.count());
+      }
+    }
+    std::sort(timestamps.begin(), timestamps.end());
+
+    std::vector<int64_t> time_delays;
+    for (size_t i = 1; i < timestamps.size(); i++) {
+      if (timestamps[i] > max_timestamp.count()) {
+        break;
+      }
+      time_delays.push_back(timestamps[i] - timestamps[i - 1]);
+    }
+    double delay_average = CalculateAverage(time_delays);
+    double delay_variance = CalculateVariance(time_delays, delay_average);
+
+    // By definition, variance == average for Poisson.
+    CHECK(
+        delay_average ==
+        doctest::Approx(NANOS_PER_SECOND / rate).epsilon(0.05));
+    CHECK(delay_variance == doctest::Approx(delay_average).epsilon(0.05));
+    early_exit = true;
+  }
+
+  /// Test that bursty schedules only send during the on periods and still
+  /// average out to the requested rate
+  ///
+  void TestBurstySchedule(double rate)
+  {
+    PauseWorkers();
+    GenerateSchedule(rate);
+
+    const auto& settings = params_.rate_profile_settings;
+    const int64_t on_ns = settings.burst_on_ms * NANOS_PER_MILLIS;
+    const int64_t period_ns =
+        (settings.burst_on_ms + settings.burst_off_ms) * NANOS_PER_MILLIS;
+    const nanoseconds max_timestamp{10 * NANOS_PER_SECOND};
+    size_t count = 0;
+    for (auto worker : workers_) {
+      auto rrworker = std::dynamic_pointer_cast<RequestRateWorker>(worker);
+      nanoseconds timestamp = rrworker->GetNextTimestamp();
+      while (timestamp < max_timestamp) {
+        CHECK((timestamp.count() % period_ns) < on_ns);
+        count++;
+        timestamp = rrworker->GetNextTimestamp();
+      }
+    }
+
+    CHECK(count == doctest::Approx(10 * rate).epsilon(0.05));
+    early_exit = true;
+  }
+
   /// Test the public function ResetWorkers()
   ///
   /// ResetWorkers pauses and restarts the workers, but the most important and
@@ -165,6 +238,56 @@ class TestRequestRateManager : public TestLoadManagerBase,
     }
   }
 
+  /// Test that the worker threads double while requests fall behind
+  /// schedule, and only as long as that reduces the delays
+  ///
+  void TestAutoThreads()
+  {
+    bool added = false;
+    ChangeRequestRate(100);
+    REQUIRE(WorkerThreadCount() == 4);
+
+    SUBCASE("disabled")
+    {
+      REQUIRE(AdaptWorkerThreads(1000, 500, &added).IsOk());
+      CHECK(!added);
+      CHECK(WorkerThreadCount() == 4);
+    }
+    SUBCASE("enabled")
+    {
+      EnableAutoThreads();
+
+      // Within the tolerance
+      REQUIRE(AdaptWorkerThreads(1000, 10, &added).IsOk());
+      CHECK(!added);
+      CHECK(WorkerThreadCount() == 4);
+
+      REQUIRE(AdaptWorkerThreads(1000, 200, &added).IsOk());
+      CHECK(added);
+      CHECK(WorkerThreadCount() == 8);
+      CHECK(workers_.size() == 8);
+      for (const auto& thread_config : threads_config_) {
+        CHECK(thread_config->stride_ == 8);
+      }
+
+      REQUIRE(AdaptWorkerThreads(1000, 100, &added).IsOk());
+      CHECK(added);
+      CHECK(WorkerThreadCount() == 16);
+
+      // More threads did not help
+      REQUIRE(AdaptWorkerThreads(1000, 95, &added).IsOk());
+      CHECK(!added);
+      CHECK(WorkerThreadCount() == 16);
+
+      // A new request rate starts over from the current threads
+      ChangeRequestRate(200);
+      REQUIRE(AdaptWorkerThreads(1000, 95, &added).IsOk());
+      CHECK(added);
+      CHECK(WorkerThreadCount() == 32);
+    }
+    StopWorkerThreads();
+  }
+
   /// Test that the correct Infer function is called in the backend
   ///
   void TestInferType()
@@ -655,6 +778,18 @@ TEST_CASE("request_rate_reset_workers: Test the public function ResetWorkers()")
   trrm.TestResetWorkers();
 }
 
+TEST_CASE(
+    "request_rate_auto_threads: Test the public function AdaptWorkerThreads()")
+{
+  PerfAnalyzerParameters params;
+  bool is_sequence = false;
+  bool is_decoupled = false;
+  bool use_mock_infer = true;
+  TestRequestRateManager trrm(
+      params, is_sequence, is_decoupled, use_mock_infer);
+  trrm.TestAutoThreads();
+}
+
 /// Check that the correct inference function calls
 /// are used given different param values for async and stream
 ///
@@ -698,6 +833,46 @@ TEST_CASE("request_rate_infer_type")
   trrm.TestInferType();
 }
 
+/// Check that Poisson schedules are generated on demand with the expected
+/// statistics for different numbers of workers
+///
+TEST_CASE("request_rate_generated_schedule")
+{
+  PerfAnalyzerParameters params;
+  params.request_distribution = POISSON;
+  bool is_sequence = false;
+  bool is_decoupled = false;
+  bool use_mock_infer = true;
+
+  SUBCASE("threads 1") { params.max_threads = 1; }
+  SUBCASE("threads 4") { params.max_threads = 4; }
+  SUBCASE("threads 7") { params.max_threads = 7; }
+
+  TestRequestRateManager trrm(
+      params, is_sequence, is_decoupled, use_mock_infer);
+  trrm.TestGeneratedSchedule(1000);
+}
+
+/// Check that bursty schedules keep every worker inside the same on periods
+///
+TEST_CASE("request_rate_bursty_schedule")
+{
+  PerfAnalyzerParameters params;
+  params.request_distribution = BURSTY;
+  params.rate_profile_settings.burst_on_ms = 100;
+  params.rate_profile_settings.burst_off_ms = 400;
+  bool is_sequence = false;
+  bool is_decoupled = false;
+  bool use_mock_infer = true;
+
+  SUBCASE("threads 1") { params.max_threads = 1; }
+  SUBCASE("threads 4") { params.max_threads = 4; }
+
+  TestRequestRateManager trrm(
+      params, is_sequence, is_decoupled, use_mock_infer);
+  trrm.TestBurstySchedule(1000);
+}
+
 /// Check that the request distribution is correct for
 /// different Distribution types
 ///
@@ -746,6 +921,40 @@ TEST_CASE("request_rate_tiny_window")
   trrm.TestDistribution(request_rate, duration_ms);
 }
 
+/// Check that the request distribution is correct when dispatcher threads
+/// follow the schedule and hand the requests to the workers, including when
+/// responses take much longer than the time between requests
+///
+TEST_CASE("request_rate_dispatchers")
+{
+  PerfAnalyzerParameters params;
+  params.request_distribution = CONSTANT;
+  params.async = false;
+  params.max_threads = 16;
+  uint request_rate = 500;
+  uint duration_ms = 1000;
+  size_t response_delay_ms = 0;
+
+  SUBCASE("one_dispatcher") { params.num_dispatcher_threads = 1; }
+  SUBCASE("two_dispatchers") { params.num_dispatcher_threads = 2; }
+  SUBCASE("slow_responses")
+  {
+    params.num_dispatcher_threads = 1;
+    response_delay_ms = 20;
+  }
+
+  TestRequestRateManager trrm(params);
+  trrm.InitManager(
+      params.string_length, params.string_data, params.zero_input,
+      params.user_data, params.start_sequence_id, params.sequence_id_range,
+      params.sequence_length, params.sequence_length_specified,
+      params.sequence_length_variation);
+  if (response_delay_ms > 0) {
+    trrm.stats_->SetDelays({response_delay_ms});
+  }
+  trrm.TestDistribution(request_rate, duration_ms);
+}
+
 /// Check that the schedule properly handles mid-test
 /// update to the request rate
 ///
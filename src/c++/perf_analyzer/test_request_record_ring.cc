@@ -0,0 +1,142 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <thread>
+#include "doctest.h"
+#include "request_record_ring.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+TimestampVector::value_type
+MakeTimestamp(uint64_t start_ns, uint64_t end_ns, bool seq_end, bool delayed)
+{
+  using time_point = std::chrono::time_point<std::chrono::system_clock>;
+  using ns = std::chrono::nanoseconds;
+  return std::make_tuple(
+      time_point(ns(start_ns)), time_point(ns(end_ns)), seq_end ? 1u : 0u,
+      delayed, time_point(ns(end_ns)), 1u);
+}
+
+}  // namespace
+
+TEST_CASE("request_record_ring: push and drain")
+{
+  RequestRecordRing ring(4);
+  CHECK(ring.Size() == 0);
+
+  ring.Push(MakeTimestamp(1, 2, false, false));
+  ring.Push(MakeTimestamp(3, 4, true, false));
+  ring.Push(MakeTimestamp(5, 6, false, true));
+  CHECK(ring.Size() == 3);
+
+  TimestampVector timestamps;
+  ring.Drain(&timestamps);
+  CHECK(ring.Size() == 0);
+  REQUIRE(timestamps.size() == 3);
+  CHECK(timestamps[0] == MakeTimestamp(1, 2, false, false));
+  CHECK(timestamps[1] == MakeTimestamp(3, 4, true, false));
+  CHECK(timestamps[2] == MakeTimestamp(5, 6, false, true));
+
+  // Draining again appends nothing
+  ring.Drain(&timestamps);
+  CHECK(timestamps.size() == 3);
+}
+
+TEST_CASE("request_record_ring: responses of decoupled requests")
+{
+  using time_point = std::chrono::time_point<std::chrono::system_clock>;
+  using ns = std::chrono::nanoseconds;
+  RequestRecordRing ring(4);
+
+  ring.Push(
+      time_point(ns(1)), time_point(ns(9)), false, false, time_point(ns(3)),
+      4);
+  ring.Push(time_point(ns(10)), time_point(ns(12)), false, false);
+
+  TimestampVector timestamps;
+  ring.Drain(&timestamps);
+  REQUIRE(timestamps.size() == 2);
+  CHECK(CHRONO_TO_NANOS(std::get<4>(timestamps[0])) == 3);
+  CHECK(std::get<5>(timestamps[0]) == 4);
+  // A request with a single response receives it when it ends
+  CHECK(timestamps[1] == MakeTimestamp(10, 12, false, false));
+}
+
+TEST_CASE("request_record_ring: overflow keeps every record in order")
+{
+  RequestRecordRing ring(4);
+  for (uint64_t i = 0; i < 10; i++) {
+    ring.Push(MakeTimestamp(i, i + 1, false, false));
+  }
+  CHECK(ring.Size() == 10);
+
+  TimestampVector timestamps;
+  ring.Drain(&timestamps);
+  CHECK(ring.Size() == 0);
+  REQUIRE(timestamps.size() == 10);
+  for (uint64_t i = 0; i < 10; i++) {
+    CHECK(timestamps[i] == MakeTimestamp(i, i + 1, false, false));
+  }
+
+  // The ring is used again once the overflow has been drained
+  ring.Push(MakeTimestamp(20, 21, false, false));
+  timestamps.clear();
+  ring.Drain(&timestamps);
+  REQUIRE(timestamps.size() == 1);
+  CHECK(timestamps[0] == MakeTimestamp(20, 21, false, false));
+}
+
+TEST_CASE("request_record_ring: concurrent producer and consumer")
+{
+  const uint64_t num_records = 100000;
+  RequestRecordRing ring(64);
+
+  std::thread producer([&ring, num_records]() {
+    for (uint64_t i = 0; i < num_records; i++) {
+      ring.Push(MakeTimestamp(i, i + 1, false, false));
+    }
+  });
+
+  TimestampVector timestamps;
+  while (timestamps.size() < num_records) {
+    ring.Drain(&timestamps);
+  }
+  producer.join();
+
+  REQUIRE(timestamps.size() == num_records);
+  bool in_order = true;
+  for (uint64_t i = 0; i < num_records; i++) {
+    if (timestamps[i] != MakeTimestamp(i, i + 1, false, false)) {
+      in_order = false;
+      break;
+    }
+  }
+  CHECK(in_order);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,179 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "doctest.h"
+#include "request_record_writer.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+MakeTempPath()
+{
+  char path[] = "/tmp/request_records_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  close(fd);
+  return path;
+}
+
+template <typename T>
+T
+ReadValue(std::ifstream& file)
+{
+  T value;
+  file.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+TEST_CASE("request_record_writer: columnar blocks")
+{
+  const std::string path = MakeTempPath();
+  std::shared_ptr<RequestRecordWriter> writer;
+  REQUIRE(RequestRecordWriter::Create(path, &writer).IsOk());
+
+  using std::chrono::nanoseconds;
+  const std::chrono::time_point<std::chrono::system_clock> origin(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          nanoseconds(1000000)));
+  const auto at = [&origin](uint64_t ns) {
+    return origin + std::chrono::duration_cast<
+                        std::chrono::system_clock::duration>(nanoseconds(ns));
+  };
+
+  TimestampVector first_block{
+      std::make_tuple(at(0), at(5000), 0u, false, at(5000), 1u),
+      std::make_tuple(at(1000), at(9000), 1u, true, at(3000), 4u)};
+  TimestampVector second_block{
+      std::make_tuple(at(2000), at(4000), 0u, false, at(4000), 1u)};
+  REQUIRE(writer->Write(first_block, 4, 250.5).IsOk());
+  REQUIRE(writer->Write(TimestampVector{}, 4, 0).IsOk());
+  REQUIRE(writer->Write(second_block, 8, 0).IsOk());
+  CHECK(writer->RecordCount() == 3);
+  writer.reset();
+
+  std::ifstream file(path, std::ifstream::binary);
+  char magic[sizeof(RequestRecordWriter::kMagic)];
+  file.read(magic, sizeof(magic));
+  CHECK(std::memcmp(magic, RequestRecordWriter::kMagic, sizeof(magic)) == 0);
+  CHECK(ReadValue<uint32_t>(file) == RequestRecordWriter::kVersion);
+
+  REQUIRE(ReadValue<uint64_t>(file) == 2);
+  CHECK(ReadValue<double>(file) == 4);
+  CHECK(ReadValue<double>(file) == 250.5);
+  CHECK(ReadValue<int64_t>(file) == 1000000);
+  CHECK(ReadValue<int64_t>(file) == 1001000);
+  CHECK(ReadValue<uint64_t>(file) == 5000);
+  CHECK(ReadValue<uint64_t>(file) == 8000);
+  CHECK(ReadValue<uint64_t>(file) == 5000);
+  CHECK(ReadValue<uint64_t>(file) == 2000);
+  CHECK(ReadValue<uint32_t>(file) == 1);
+  CHECK(ReadValue<uint32_t>(file) == 4);
+  CHECK(ReadValue<uint8_t>(file) == 0);
+  CHECK(
+      ReadValue<uint8_t>(file) ==
+      (RequestRecordWriter::kSequenceEndFlag |
+       RequestRecordWriter::kDelayedFlag));
+
+  // The empty write adds no block
+  REQUIRE(ReadValue<uint64_t>(file) == 1);
+  CHECK(ReadValue<double>(file) == 8);
+  CHECK(ReadValue<double>(file) == 0);
+  CHECK(ReadValue<int64_t>(file) == 1002000);
+  CHECK(ReadValue<uint64_t>(file) == 2000);
+  CHECK(ReadValue<uint64_t>(file) == 2000);
+  CHECK(ReadValue<uint32_t>(file) == 1);
+  CHECK(ReadValue<uint8_t>(file) == 0);
+  file.peek();
+  CHECK(file.eof());
+
+  std::vector<RequestRecordBlock> blocks;
+  REQUIRE(ReadRequestRecords(path, &blocks).IsOk());
+  REQUIRE(blocks.size() == 2);
+  CHECK(blocks[0].load_level == 4);
+  CHECK(blocks[0].infer_per_sec == 250.5);
+  CHECK(blocks[0].latency_ns == std::vector<uint64_t>{5000, 8000});
+  CHECK(blocks[1].load_level == 8);
+  CHECK(blocks[1].infer_per_sec == 0);
+  CHECK(blocks[1].latency_ns == std::vector<uint64_t>{2000});
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("request_record_writer: reading invalid files")
+{
+  const std::string path = MakeTempPath();
+  std::vector<RequestRecordBlock> blocks;
+
+  SUBCASE("not a record file")
+  {
+    std::ofstream(path) << "Concurrency,Inferences/Second" << std::endl;
+    CHECK_FALSE(ReadRequestRecords(path, &blocks).IsOk());
+  }
+  SUBCASE("version 1")
+  {
+    const uint32_t version = 1;
+    std::ofstream file(path, std::ofstream::binary);
+    file.write(
+        RequestRecordWriter::kMagic, sizeof(RequestRecordWriter::kMagic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.close();
+    CHECK_FALSE(ReadRequestRecords(path, &blocks).IsOk());
+  }
+  SUBCASE("truncated block")
+  {
+    const uint64_t block_size = 10;
+    std::ofstream file(path, std::ofstream::binary);
+    file.write(
+        RequestRecordWriter::kMagic, sizeof(RequestRecordWriter::kMagic));
+    file.write(
+        reinterpret_cast<const char*>(&RequestRecordWriter::kVersion),
+        sizeof(RequestRecordWriter::kVersion));
+    file.write(reinterpret_cast<const char*>(&block_size), sizeof(block_size));
+    file.close();
+    CHECK_FALSE(ReadRequestRecords(path, &blocks).IsOk());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("request_record_writer: unwritable path")
+{
+  std::shared_ptr<RequestRecordWriter> writer;
+  CHECK_FALSE(
+      RequestRecordWriter::Create("/nonexistent/dir/records", &writer).IsOk());
+  CHECK(writer == nullptr);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,118 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include "doctest.h"
+#include "request_trace.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+WriteTrace(const std::string& contents)
+{
+  char path[] = "/tmp/request_trace_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  REQUIRE(
+      write(fd, contents.data(), contents.size()) ==
+      static_cast<ssize_t>(contents.size()));
+  close(fd);
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("request_trace: replay")
+{
+  std::string path = WriteTrace(
+      "# timestamp_us stream\n"
+      "1000 0\n"
+      "\n"
+      "1100\t2\n"
+      "1300 1\r\n"
+      "1600\n");
+  std::shared_ptr<RequestTrace> trace;
+  REQUIRE(RequestTrace::Open(path, &trace).IsOk());
+  std::remove(path.c_str());
+
+  CHECK(trace->Size() == 4);
+  CHECK(trace->MaxDataStreamId() == 2);
+  // 600 usec span plus the mean gap of 200 usec
+  CHECK(trace->Duration() == std::chrono::microseconds(800));
+  CHECK(trace->RequestRate() == doctest::Approx(5000));
+
+  SUBCASE("single cursor loops")
+  {
+    RequestTrace::Cursor cursor(trace, 0, 1);
+    const std::vector<int64_t> expected_us{0, 100, 300, 600, 800, 900};
+    const std::vector<uint64_t> expected_streams{0, 2, 1, 0, 0, 2};
+    for (size_t i = 0; i < expected_us.size(); i++) {
+      RequestTraceRecord record = cursor.Next();
+      CHECK(record.timestamp_ == std::chrono::microseconds(expected_us[i]));
+      CHECK(record.data_stream_id_ == expected_streams[i]);
+    }
+  }
+  SUBCASE("strided cursors partition the trace")
+  {
+    RequestTrace::Cursor even(trace, 0, 2);
+    RequestTrace::Cursor odd(trace, 1, 2);
+    CHECK(even.Next().timestamp_ == std::chrono::microseconds(0));
+    CHECK(odd.Next().timestamp_ == std::chrono::microseconds(100));
+    CHECK(even.Next().timestamp_ == std::chrono::microseconds(300));
+    CHECK(odd.Next().timestamp_ == std::chrono::microseconds(600));
+    CHECK(even.Next().timestamp_ == std::chrono::microseconds(800));
+    CHECK(odd.Next().timestamp_ == std::chrono::microseconds(900));
+  }
+}
+
+TEST_CASE("request_trace: invalid traces")
+{
+  std::string contents;
+  SUBCASE("empty") { contents = ""; }
+  SUBCASE("no requests") { contents = "# nothing\n\n"; }
+  SUBCASE("single request") { contents = "10\n"; }
+  SUBCASE("not a number") { contents = "10\nabc\n"; }
+  SUBCASE("trailing garbage") { contents = "10 1 x\n20\n"; }
+  SUBCASE("decreasing") { contents = "20\n10\n"; }
+
+  std::string path = WriteTrace(contents);
+  std::shared_ptr<RequestTrace> trace;
+  CHECK(!RequestTrace::Open(path, &trace).IsOk());
+  std::remove(path.c_str());
+}
+
+TEST_CASE("request_trace: missing file")
+{
+  std::shared_ptr<RequestTrace> trace;
+  CHECK(!RequestTrace::Open("/does/not/exist", &trace).IsOk());
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,58 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "doctest.h"
+#include "schedule_plugin.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("schedule_plugin: missing library")
+{
+  std::shared_ptr<SchedulePlugin> plugin;
+  cb::Error err =
+      SchedulePlugin::Load("/nonexistent/libschedule.so", "", &plugin);
+  CHECK(!err.IsOk());
+  CHECK(
+      err.Message().find(
+          "unable to load schedule plugin '/nonexistent/libschedule.so'") !=
+      std::string::npos);
+  CHECK(plugin == nullptr);
+}
+
+TEST_CASE("schedule_plugin: library without the interface")
+{
+  // Any shared library that is not a plugin will do
+  std::shared_ptr<SchedulePlugin> plugin;
+  cb::Error err = SchedulePlugin::Load("libc.so.6", "", &plugin);
+  CHECK(!err.IsOk());
+  CHECK(
+      err.Message() ==
+      "schedule plugin 'libc.so.6' does not export "
+      "PA_SchedulePluginApiVersion");
+  CHECK(plugin == nullptr);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,149 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "doctest.h"
+#include "rate_schedule.h"
+#include "schedule_recorder.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+ScheduleRecord
+MakeRecord(
+    int64_t timestamp_ns, uint32_t worker, uint64_t data_step_id,
+    uint64_t sequence_id = 0, bool start = false, bool end = false)
+{
+  ScheduleRecord record;
+  record.timestamp_ = std::chrono::nanoseconds(timestamp_ns);
+  record.worker_ = worker;
+  record.data_stream_id_ = worker % 2;
+  record.data_step_id_ = data_step_id;
+  record.sequence_id_ = sequence_id;
+  record.sequence_start_ = start;
+  record.sequence_end_ = end;
+  return record;
+}
+
+}  // namespace
+
+TEST_CASE("schedule_recorder: round trip")
+{
+  ScheduleRecorder recorder;
+  // Recorded out of order by different workers, on an absolute clock
+  recorder.Record(MakeRecord(5000300, 1, 7, 42, false, true));
+  recorder.Record(MakeRecord(5000000, 0, 3, 42, true, false));
+  recorder.Record(MakeRecord(5000100, 65, 1ull << 40));
+  recorder.Record(MakeRecord(5000100, 2, 0));
+
+  std::stringstream file;
+  recorder.Write(file);
+  std::vector<ScheduleRecord> records;
+  REQUIRE(ScheduleRecorder::Read(file, &records).IsOk());
+
+  REQUIRE(records.size() == 4);
+  const std::vector<int64_t> expected_ns{0, 100, 100, 300};
+  const std::vector<uint32_t> expected_workers{0, 65, 2, 1};
+  for (size_t i = 0; i < records.size(); i++) {
+    CHECK(records[i].timestamp_ == std::chrono::nanoseconds(expected_ns[i]));
+    CHECK(records[i].worker_ == expected_workers[i]);
+    CHECK(records[i].data_stream_id_ == expected_workers[i] % 2);
+  }
+  CHECK(records[0].data_step_id_ == 3);
+  CHECK(records[0].sequence_id_ == 42);
+  CHECK(records[0].sequence_start_);
+  CHECK_FALSE(records[0].sequence_end_);
+  CHECK(records[1].data_step_id_ == (1ull << 40));
+  CHECK(records[3].sequence_id_ == 42);
+  CHECK_FALSE(records[3].sequence_start_);
+  CHECK(records[3].sequence_end_);
+}
+
+TEST_CASE("schedule_recorder: compact")
+{
+  ScheduleRecorder recorder;
+  for (int64_t i = 0; i < 1000; i++) {
+    recorder.Record(MakeRecord(i * 1000, i % 4, i % 100));
+  }
+  std::stringstream file;
+  recorder.Write(file);
+  // Gaps under 16 usec take two bytes and the other fields one each
+  CHECK(file.str().size() <= 8 + 2 + 1000 * 7);
+}
+
+TEST_CASE("schedule_recorder: malformed")
+{
+  std::vector<ScheduleRecord> records;
+
+  SUBCASE("not a schedule")
+  {
+    std::stringstream file("1000 0\n1100 2\n");
+    cb::Error err = ScheduleRecorder::Read(file, &records);
+    CHECK_FALSE(err.IsOk());
+    CHECK(err.Message() == "not a schedule file");
+  }
+
+  SUBCASE("truncated")
+  {
+    ScheduleRecorder recorder;
+    recorder.Record(MakeRecord(0, 0, 0));
+    recorder.Record(MakeRecord(100, 1, 1));
+    std::stringstream full;
+    recorder.Write(full);
+    const std::string contents = full.str();
+    std::stringstream file(contents.substr(0, contents.size() - 3));
+    cb::Error err = ScheduleRecorder::Read(file, &records);
+    CHECK_FALSE(err.IsOk());
+    CHECK(
+        err.Message() == "truncated schedule file, read 1 of 2 requests");
+  }
+
+  SUBCASE("missing file")
+  {
+    CHECK_FALSE(
+        ScheduleRecorder::Read("/nonexistent/schedule.bin", &records).IsOk());
+  }
+}
+
+TEST_CASE("schedule_recorder: replayed by a rate schedule")
+{
+  RateSchedule schedule;
+  schedule.replay = {MakeRecord(0, 0, 5), MakeRecord(300, 0, 6)};
+  schedule.duration = std::chrono::nanoseconds(1000);
+  CHECK(schedule.Replayed() != nullptr);
+
+  const std::vector<int64_t> expected_ns{0, 300, 1000, 1300};
+  const std::vector<uint64_t> expected_steps{5, 6, 5, 6};
+  for (size_t i = 0; i < expected_ns.size(); i++) {
+    CHECK(schedule.Next() == std::chrono::nanoseconds(expected_ns[i]));
+    REQUIRE(schedule.Replayed() != nullptr);
+    CHECK(schedule.Replayed()->data_step_id_ == expected_steps[i]);
+    CHECK(schedule.DataStreamId() == 0);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
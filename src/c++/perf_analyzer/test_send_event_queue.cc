@@ -0,0 +1,142 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <thread>
+#include <vector>
+#include "doctest.h"
+#include "send_event_queue.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+SendEvent
+MakeEvent(int64_t ns)
+{
+  SendEvent event;
+  event.scheduled_time_ =
+      std::chrono::steady_clock::time_point(std::chrono::nanoseconds(ns));
+  return event;
+}
+
+int64_t
+EventNs(const SendEvent& event)
+{
+  return event.scheduled_time_.time_since_epoch().count();
+}
+
+}  // namespace
+
+TEST_CASE("send_event_queue: fifo order")
+{
+  SendEventQueue queue(4);
+  SendEvent event;
+  CHECK(!queue.TryPop(&event));
+
+  for (int64_t i = 0; i < 3; i++) {
+    REQUIRE(queue.TryPush(MakeEvent(i)));
+  }
+  for (int64_t i = 0; i < 3; i++) {
+    REQUIRE(queue.TryPop(&event));
+    CHECK(EventNs(event) == i);
+  }
+  CHECK(!queue.TryPop(&event));
+}
+
+TEST_CASE("send_event_queue: full queue rejects pushes")
+{
+  SendEventQueue queue(3);
+  REQUIRE(queue.Capacity() == 4);
+  for (int64_t i = 0; i < 4; i++) {
+    REQUIRE(queue.TryPush(MakeEvent(i)));
+  }
+  CHECK(!queue.TryPush(MakeEvent(4)));
+
+  SendEvent event;
+  REQUIRE(queue.TryPop(&event));
+  CHECK(EventNs(event) == 0);
+  CHECK(queue.TryPush(MakeEvent(4)));
+
+  queue.Clear();
+  CHECK(!queue.TryPop(&event));
+  CHECK(queue.TryPush(MakeEvent(5)));
+}
+
+TEST_CASE("send_event_queue: concurrent producers and consumers")
+{
+  const size_t num_producers = 2;
+  const size_t num_consumers = 4;
+  const int64_t events_per_producer = 100000;
+
+  SendEventQueue queue(64);
+  std::vector<std::vector<int64_t>> popped(num_consumers);
+  std::atomic<int64_t> remaining{num_producers * events_per_producer};
+
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < num_producers; p++) {
+    threads.emplace_back([&, p]() {
+      for (int64_t i = 0; i < events_per_producer; i++) {
+        // Encode the producer so that per-producer order can be checked
+        SendEvent event = MakeEvent(i * num_producers + p);
+        while (!queue.TryPush(event)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (size_t c = 0; c < num_consumers; c++) {
+    threads.emplace_back([&, c]() {
+      SendEvent event;
+      while (remaining > 0) {
+        if (queue.TryPop(&event)) {
+          popped[c].push_back(EventNs(event));
+          remaining--;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<size_t> seen(num_producers * events_per_producer, 0);
+  for (const auto& consumer_events : popped) {
+    std::vector<int64_t> last(num_producers, -1);
+    for (int64_t value : consumer_events) {
+      seen[value]++;
+      // Events from one producer reach each consumer in order
+      CHECK(value > last[value % num_producers]);
+      last[value % num_producers] = value;
+    }
+  }
+  for (size_t count : seen) {
+    REQUIRE(count == 1);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,190 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "doctest.h"
+#include "sequence_distribution.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+WriteHistogram(const std::string& contents)
+{
+  char path[] = "/tmp/sequence_histogram_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  REQUIRE(
+      write(fd, contents.data(), contents.size()) ==
+      static_cast<ssize_t>(contents.size()));
+  close(fd);
+  return path;
+}
+
+double
+MeanOfDraws(const SequenceDistribution& distribution, size_t draws)
+{
+  std::mt19937 rng(0);
+  double total = 0;
+  for (size_t i = 0; i < draws; i++) {
+    total += distribution.Draw(rng);
+  }
+  return total / draws;
+}
+
+}  // namespace
+
+TEST_CASE("sequence_distribution: parse distributions")
+{
+  SequenceDistributionSettings settings;
+
+  SUBCASE("kinds and settings")
+  {
+    REQUIRE(ParseSequenceDistribution("uniform", &settings).IsOk());
+    CHECK(settings.kind == SequenceDistributionSettings::UNIFORM);
+
+    REQUIRE(ParseSequenceDistribution("exponential", &settings).IsOk());
+    CHECK(settings.kind == SequenceDistributionSettings::EXPONENTIAL);
+    CHECK(settings.mean == 0);
+
+    REQUIRE(
+        ParseSequenceDistribution("lognormal:mean=20,sigma=1", &settings)
+            .IsOk());
+    CHECK(settings.kind == SequenceDistributionSettings::LOGNORMAL);
+    CHECK(settings.mean == doctest::Approx(20));
+    CHECK(settings.sigma == doctest::Approx(1));
+
+    REQUIRE(ParseSequenceDistribution("histogram:file=h.txt", &settings)
+                .IsOk());
+    CHECK(settings.kind == SequenceDistributionSettings::HISTOGRAM);
+    CHECK(settings.file == "h.txt");
+  }
+  SUBCASE("invalid distributions")
+  {
+    CHECK(!ParseSequenceDistribution("", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("gamma", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("uniform:mean=2", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("constant:sigma=2", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("constant:mean=0", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("constant:mean=x", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("histogram", &settings).IsOk());
+    CHECK(!ParseSequenceDistribution("histogram:mean=3", &settings).IsOk());
+    CHECK(settings.kind == SequenceDistributionSettings::UNIFORM);
+
+    cb::Error err =
+        ParseSequenceDistribution("lognormal:sigma=-1", &settings);
+    CHECK(
+        err.Message() ==
+        "invalid setting 'sigma=-1' for distribution lognormal: '-1' is not "
+        "a positive number");
+  }
+}
+
+TEST_CASE("sequence_distribution: draw values")
+{
+  SequenceDistributionSettings settings;
+  std::shared_ptr<SequenceDistribution> distribution;
+
+  SUBCASE("uniform has no distribution")
+  {
+    distribution = std::make_shared<ConstantSequenceDistribution>(1);
+    REQUIRE(MakeSequenceDistribution(settings, 20, &distribution).IsOk());
+    CHECK(distribution == nullptr);
+  }
+  SUBCASE("default mean")
+  {
+    settings.kind = SequenceDistributionSettings::CONSTANT;
+    REQUIRE(MakeSequenceDistribution(settings, 20, &distribution).IsOk());
+    CHECK(MeanOfDraws(*distribution, 10) == doctest::Approx(20));
+    CHECK(!MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+  }
+  SUBCASE("exponential and lognormal means")
+  {
+    settings.kind = SequenceDistributionSettings::EXPONENTIAL;
+    settings.mean = 50;
+    REQUIRE(MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+    CHECK(
+        MeanOfDraws(*distribution, 100000) ==
+        doctest::Approx(50).epsilon(0.02));
+
+    settings.kind = SequenceDistributionSettings::LOGNORMAL;
+    settings.sigma = 1;
+    REQUIRE(MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+    CHECK(
+        MeanOfDraws(*distribution, 100000) ==
+        doctest::Approx(50).epsilon(0.05));
+  }
+  SUBCASE("histogram")
+  {
+    std::string path = WriteHistogram(
+        "# length weight\n"
+        "4 3\n"
+        "\n"
+        "16 1  # long ones\n"
+        "8 0\n");
+    settings.kind = SequenceDistributionSettings::HISTOGRAM;
+    settings.file = path;
+    REQUIRE(MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+    std::mt19937 rng(0);
+    size_t short_draws = 0;
+    const size_t draws = 10000;
+    for (size_t i = 0; i < draws; i++) {
+      const double draw = distribution->Draw(rng);
+      REQUIRE((draw == 4 || draw == 16));
+      short_draws += (draw == 4);
+    }
+    CHECK(
+        short_draws / static_cast<double>(draws) ==
+        doctest::Approx(0.75).epsilon(0.03));
+    std::remove(path.c_str());
+  }
+  SUBCASE("invalid histograms")
+  {
+    settings.kind = SequenceDistributionSettings::HISTOGRAM;
+    settings.file = "/nonexistent/histogram.txt";
+    CHECK(!MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+
+    std::string path = WriteHistogram("4 0\n");
+    settings.file = path;
+    CHECK(!MakeSequenceDistribution(settings, 0, &distribution).IsOk());
+    std::remove(path.c_str());
+
+    path = WriteHistogram("4 1\n-2 1\n");
+    settings.file = path;
+    cb::Error err = MakeSequenceDistribution(settings, 0, &distribution);
+    CHECK(
+        err.Message() == "invalid histogram entry at " + path +
+                             ":2, expected '<positive value> <weight>'");
+    std::remove(path.c_str());
+  }
+}
+
+}}  // namespace triton::perfanalyzer
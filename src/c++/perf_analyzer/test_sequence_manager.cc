@@ -254,6 +254,64 @@ TEST_CASE("get_next_seq_id: testing the GetNextSeqId function")
   }
 }
 
+TEST_CASE("init_sequence_statuses: testing the sequence ID ranges")
+{
+  std::uniform_int_distribution<uint64_t> distribution(0, 0);
+  const uint64_t start_sequence_id{1};
+  uint64_t sequence_id_range{10};
+  const size_t sequence_length{20};
+  const bool sequence_length_specified{false};
+  const double sequence_length_variation{0.0};
+  const bool using_json_data{false};
+  std::shared_ptr<MockDataLoader> data_loader{
+      std::make_shared<MockDataLoader>()};
+  const size_t num_sequence_statuses{4};
+
+  SUBCASE("a range per status")
+  {
+    MockSequenceManager msm(
+        start_sequence_id, sequence_id_range, sequence_length,
+        sequence_length_specified, sequence_length_variation, using_json_data,
+        data_loader);
+    msm.InitSequenceStatuses(num_sequence_statuses);
+
+    CHECK(msm.sequence_id_ranges_ == num_sequence_statuses);
+    for (size_t i = 0; i < num_sequence_statuses; i++) {
+      // The statuses are contiguous and on cache lines of their own
+      CHECK(
+          msm.sequence_statuses_[i].get() ==
+          msm.sequence_statuses_[0].get() + i);
+      CHECK(
+          reinterpret_cast<uintptr_t>(msm.sequence_statuses_[i].get()) % 64 ==
+          0);
+    }
+
+    // Status 1 cycles through the two IDs of its range, 10 / 4 per range
+    CHECK(msm.GetNextSeqId(1) == 2);
+    CHECK(msm.GetNextSeqId(1) == 6);
+    CHECK(msm.GetNextSeqId(1) == 2);
+    CHECK(msm.GetNextSeqId(3) == 4);
+    CHECK(msm.GetNextSeqId(3) == 8);
+    CHECK(msm.curr_seq_id_ == 0);
+  }
+
+  SUBCASE("more statuses than sequence IDs")
+  {
+    sequence_id_range = 3;
+
+    MockSequenceManager msm(
+        start_sequence_id, sequence_id_range, sequence_length,
+        sequence_length_specified, sequence_length_variation, using_json_data,
+        data_loader);
+    msm.InitSequenceStatuses(num_sequence_statuses);
+
+    // The statuses share the IDs as before
+    CHECK(msm.sequence_id_ranges_ == 0);
+    CHECK(msm.GetNextSeqId(0) == 1);
+    CHECK(msm.curr_seq_id_ == 1);
+  }
+}
+
 TEST_CASE(
     "get_random_sequence_length: testing the GetRandomSequenceLength function")
 {
@@ -283,4 +341,36 @@ TEST_CASE(
   CHECK(result <= 24);
 }
 
+TEST_CASE(
+    "get_random_sequence_length: testing sequence length distributions")
+{
+  std::shared_ptr<MockDataLoader> data_loader{
+      std::make_shared<MockDataLoader>()};
+  MockSequenceManager msm(0, 0, 20, false, 0.0, false, data_loader);
+
+  SUBCASE("lengths follow the distribution")
+  {
+    msm.SetLengthDistribution(
+        std::make_shared<ConstantSequenceDistribution>(7.4));
+    CHECK(msm.GetRandomSequenceLength(0.2) == 7);
+  }
+  SUBCASE("lengths are at least one")
+  {
+    msm.SetLengthDistribution(
+        std::make_shared<ConstantSequenceDistribution>(0.2));
+    CHECK(msm.GetRandomSequenceLength(0.2) == 1);
+  }
+  SUBCASE("the length variation does not apply")
+  {
+    msm.SetLengthDistribution(
+        std::make_shared<LognormalSequenceDistribution>(20, 1));
+    size_t outside_variation = 0;
+    for (size_t i = 0; i < 100; i++) {
+      const size_t length = msm.GetRandomSequenceLength(0.2);
+      outside_variation += (length < 16) || (length > 24);
+    }
+    CHECK(outside_variation > 50);
+  }
+}
+
 }}  // namespace triton::perfanalyzer
@@ -0,0 +1,97 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <random>
+#include "doctest.h"
+#include "shape_distribution.h"
+
+namespace triton { namespace perfanalyzer {
+
+TEST_CASE("shape_distribution: parse shape distributions")
+{
+  ShapeDistributionSettings settings;
+
+  SUBCASE("uniform by default")
+  {
+    REQUIRE(ParseShapeDistribution("INPUT0:1:16:512", &settings).IsOk());
+    CHECK(settings.input_name == "INPUT0");
+    CHECK(settings.dimension == 1);
+    CHECK(settings.min == 16);
+    CHECK(settings.max == 512);
+    CHECK(settings.distribution.kind == SequenceDistributionSettings::UNIFORM);
+  }
+  SUBCASE("with a distribution")
+  {
+    REQUIRE(ParseShapeDistribution(
+                "INPUT0:0:1:64:lognormal:mean=8,sigma=1", &settings)
+                .IsOk());
+    CHECK(settings.dimension == 0);
+    CHECK(
+        settings.distribution.kind == SequenceDistributionSettings::LOGNORMAL);
+    CHECK(settings.distribution.mean == doctest::Approx(8));
+    CHECK(settings.distribution.sigma == doctest::Approx(1));
+  }
+  SUBCASE("invalid shape distributions")
+  {
+    CHECK_FALSE(ParseShapeDistribution("INPUT0:1:16", &settings).IsOk());
+    CHECK_FALSE(ParseShapeDistribution(":1:16:512", &settings).IsOk());
+    CHECK_FALSE(ParseShapeDistribution("INPUT0:x:16:512", &settings).IsOk());
+    CHECK_FALSE(ParseShapeDistribution("INPUT0:1:0:512", &settings).IsOk());
+    CHECK_FALSE(ParseShapeDistribution("INPUT0:1:64:16", &settings).IsOk());
+    CHECK_FALSE(
+        ParseShapeDistribution("INPUT0:1:16:512:zipf", &settings).IsOk());
+  }
+}
+
+TEST_CASE("shape_distribution: draws stay within the bounds")
+{
+  ShapeDistributionSettings settings;
+  std::string spec;
+  SUBCASE("uniform") { spec = "INPUT0:1:16:32"; }
+  SUBCASE("lognormal") { spec = "INPUT0:1:16:32:lognormal:sigma=2"; }
+  SUBCASE("exponential") { spec = "INPUT0:1:16:32:exponential:mean=100"; }
+  REQUIRE(ParseShapeDistribution(spec, &settings).IsOk());
+
+  std::shared_ptr<ShapeDistribution> distribution;
+  REQUIRE(ShapeDistribution::Create(settings, &distribution).IsOk());
+  CHECK(distribution->InputName() == "INPUT0");
+  CHECK(distribution->Dimension() == 1);
+
+  std::mt19937 rng(0);
+  int64_t lowest = settings.max;
+  int64_t highest = settings.min;
+  for (size_t i = 0; i < 1000; i++) {
+    const int64_t value = distribution->Draw(rng);
+    REQUIRE(value >= settings.min);
+    REQUIRE(value <= settings.max);
+    lowest = std::min(lowest, value);
+    highest = std::max(highest, value);
+  }
+  CHECK(lowest < highest);
+}
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,220 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "doctest.h"
+#include "shared_memory_pool.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+/// Records what the pool stages into each slot.
+struct StageRecorder {
+  explicit StageRecorder(size_t slot_count) : contents_(slot_count) {}
+
+  SharedMemoryPool::StageFunction Function()
+  {
+    return [this](size_t slot, int stream_index, int step_index) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stage_count_++;
+      if (fail_) {
+        return cb::Error("injected stage error", pa::GENERIC_ERROR);
+      }
+      contents_[slot] = std::make_pair(stream_index, step_index);
+      return cb::Error::Success;
+    };
+  }
+
+  size_t StageCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stage_count_;
+  }
+
+  std::pair<int, int> Contents(size_t slot)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return contents_[slot];
+  }
+
+  std::mutex mutex_;
+  std::vector<std::pair<int, int>> contents_;
+  size_t stage_count_{0};
+  bool fail_{false};
+};
+
+}  // namespace
+
+TEST_CASE("shared_memory_pool: acquire stages each step once")
+{
+  StageRecorder recorder(2);
+  SharedMemoryPool pool(2, recorder.Function());
+
+  size_t slot;
+  REQUIRE(pool.Acquire(0, 3, &slot).IsOk());
+  CHECK(recorder.Contents(slot) == std::make_pair(0, 3));
+  pool.Release(slot);
+
+  size_t again;
+  REQUIRE(pool.Acquire(0, 3, &again).IsOk());
+  CHECK(again == slot);
+  pool.Release(again);
+  CHECK(recorder.StageCount() == 1);
+}
+
+TEST_CASE("shared_memory_pool: least recently used free slot is refilled")
+{
+  StageRecorder recorder(2);
+  SharedMemoryPool pool(2, recorder.Function());
+
+  size_t slot0, slot1, slot2;
+  REQUIRE(pool.Acquire(0, 0, &slot0).IsOk());
+  pool.Release(slot0);
+  REQUIRE(pool.Acquire(0, 1, &slot1).IsOk());
+  pool.Release(slot1);
+  CHECK(slot0 != slot1);
+
+  SUBCASE("free slot")
+  {
+    REQUIRE(pool.Acquire(0, 2, &slot2).IsOk());
+    CHECK(slot2 == slot0);
+    pool.Release(slot2);
+  }
+
+  SUBCASE("acquired slot is kept")
+  {
+    size_t held;
+    REQUIRE(pool.Acquire(0, 0, &held).IsOk());
+    REQUIRE(pool.Acquire(0, 2, &slot2).IsOk());
+    CHECK(slot2 == slot1);
+    CHECK(recorder.Contents(held) == std::make_pair(0, 0));
+    pool.Release(slot2);
+    pool.Release(held);
+  }
+  CHECK(recorder.StageCount() == 3);
+}
+
+TEST_CASE("shared_memory_pool: prefetch stages in the background")
+{
+  StageRecorder recorder(2);
+  SharedMemoryPool pool(2, recorder.Function());
+
+  pool.Prefetch(1, 5);
+  for (int i = 0; i < 1000 && recorder.StageCount() == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(recorder.StageCount() == 1);
+
+  size_t slot;
+  REQUIRE(pool.Acquire(1, 5, &slot).IsOk());
+  CHECK(recorder.Contents(slot) == std::make_pair(1, 5));
+  pool.Release(slot);
+  CHECK(recorder.StageCount() == 1);
+
+  // Already staged, so nothing more to do
+  pool.Prefetch(1, 5);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  CHECK(recorder.StageCount() == 1);
+}
+
+TEST_CASE("shared_memory_pool: stage errors are returned and retried")
+{
+  StageRecorder recorder(1);
+  SharedMemoryPool pool(1, recorder.Function());
+
+  size_t slot;
+  recorder.fail_ = true;
+  cb::Error err = pool.Acquire(0, 0, &slot);
+  CHECK(!err.IsOk());
+  CHECK(err.Message() == "injected stage error");
+
+  recorder.fail_ = false;
+  REQUIRE(pool.Acquire(0, 0, &slot).IsOk());
+  CHECK(recorder.Contents(slot) == std::make_pair(0, 0));
+  pool.Release(slot);
+  CHECK(recorder.StageCount() == 2);
+}
+
+TEST_CASE("shared_memory_pool: acquire waits for a free slot")
+{
+  StageRecorder recorder(1);
+  SharedMemoryPool pool(1, recorder.Function());
+
+  size_t held;
+  REQUIRE(pool.Acquire(0, 0, &held).IsOk());
+
+  std::atomic<bool> acquired{false};
+  std::future<void> waiter{std::async(std::launch::async, [&]() {
+    size_t slot;
+    REQUIRE(pool.Acquire(0, 1, &slot).IsOk());
+    acquired = true;
+    pool.Release(slot);
+  })};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  CHECK(!acquired);
+  pool.Release(held);
+  waiter.get();
+  CHECK(acquired);
+  CHECK(recorder.Contents(0) == std::make_pair(0, 1));
+}
+
+TEST_CASE("shared_memory_pool: retained slot is kept until every release")
+{
+  StageRecorder recorder(2);
+  SharedMemoryPool pool(2, recorder.Function());
+
+  size_t slot0;
+  REQUIRE(pool.Acquire(0, 0, &slot0).IsOk());
+  pool.Retain(slot0);
+  pool.Release(slot0);
+
+  // The request still holds slot 0, so the other slot is refilled
+  size_t slot1;
+  REQUIRE(pool.Acquire(0, 1, &slot1).IsOk());
+  CHECK(slot1 != slot0);
+  pool.Release(slot1);
+
+  size_t slot2;
+  REQUIRE(pool.Acquire(0, 2, &slot2).IsOk());
+  CHECK(slot2 == slot1);
+  CHECK(recorder.Contents(slot0) == std::make_pair(0, 0));
+  pool.Release(slot2);
+
+  pool.Release(slot0);
+  REQUIRE(pool.Acquire(0, 3, &slot2).IsOk());
+  CHECK(slot2 == slot0);
+  pool.Release(slot2);
+}
+
+}}  // namespace triton::perfanalyzer
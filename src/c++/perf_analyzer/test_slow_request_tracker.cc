@@ -0,0 +1,106 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+#include "doctest.h"
+#include "slow_request_tracker.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+SlowRequest
+MakeSlowRequest(uint64_t latency_ns, uint32_t context = 0)
+{
+  SlowRequest request;
+  request.latency_ns = latency_ns;
+  request.context = context;
+  return request;
+}
+
+std::vector<uint64_t>
+Latencies(const SlowRequestTracker& tracker)
+{
+  std::vector<uint64_t> latencies;
+  for (const auto& request : tracker.Slowest()) {
+    latencies.push_back(request.latency_ns);
+  }
+  return latencies;
+}
+
+}  // namespace
+
+TEST_CASE("slow_request_tracker: keeps the slowest requests")
+{
+  SlowRequestTracker tracker(3);
+  for (uint64_t latency : {50, 10, 70, 30, 90, 20, 60}) {
+    tracker.Record(MakeSlowRequest(latency));
+  }
+  CHECK(Latencies(tracker) == std::vector<uint64_t>{90, 70, 60});
+  CHECK(tracker.Admits(61));
+  CHECK(!tracker.Admits(60));
+
+  tracker.Reset();
+  CHECK(tracker.Empty());
+  CHECK(tracker.Capacity() == 3);
+  CHECK(tracker.Admits(1));
+}
+
+TEST_CASE("slow_request_tracker: keeps the details of the requests")
+{
+  SlowRequestTracker tracker(1);
+  tracker.Record(MakeSlowRequest(10, 1));
+  tracker.Record(MakeSlowRequest(20, 2));
+  REQUIRE(tracker.Requests().size() == 1);
+  CHECK(tracker.Requests()[0].context == 2);
+}
+
+TEST_CASE("slow_request_tracker: keeps nothing without a capacity")
+{
+  SlowRequestTracker tracker;
+  CHECK(!tracker.Admits(100));
+  tracker.Record(MakeSlowRequest(100));
+  CHECK(tracker.Empty());
+}
+
+TEST_CASE("slow_request_tracker: merges the slowest of both trackers")
+{
+  SlowRequestTracker first(2);
+  first.Record(MakeSlowRequest(40));
+  first.Record(MakeSlowRequest(10));
+  SlowRequestTracker second(3);
+  second.Record(MakeSlowRequest(30));
+  second.Record(MakeSlowRequest(50));
+  second.Record(MakeSlowRequest(20));
+
+  SlowRequestTracker merged;
+  merged.Merge(first);
+  merged.Merge(second);
+  CHECK(merged.Capacity() == 3);
+  CHECK(Latencies(merged) == std::vector<uint64_t>{50, 40, 30});
+}
+
+}}  // namespace triton::perfanalyzer
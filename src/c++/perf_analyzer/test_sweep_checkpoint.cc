@@ -0,0 +1,204 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include "doctest.h"
+#include "sweep_checkpoint.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+std::string
+MakeTempPath()
+{
+  char path[] = "/tmp/sweep_checkpoint_XXXXXX";
+  int fd = mkstemp(path);
+  REQUIRE(fd != -1);
+  close(fd);
+  return path;
+}
+
+PerfStatus
+MakeStatus(const uint32_t concurrency)
+{
+  PerfStatus status;
+  status.concurrency = concurrency;
+  status.batch_size = 2;
+  status.overhead_pct = 1.5;
+  status.on_sequence_model = false;
+  status.stabilizing_latency_ns = 1000 * concurrency;
+  status.window_infer_per_sec = {99.5, 100.25};
+  status.client_resources.thread_cpu_pct = {{"worker thread", 12.5}};
+  status.server_stats = ServerSideStats();
+  status.server_stats.inference_count = 20;
+  status.server_stats.composing_models_stat[{"pre process", ""}] =
+      ServerSideStats();
+  status.server_stats.composing_models_stat[{"pre process", ""}]
+      .queue_time_ns = 7;
+
+  ClientSideStats& stats = status.client_stats;
+  stats = ClientSideStats();
+  stats.request_count = 10 * concurrency;
+  stats.infer_per_sec = 1.0 / 3.0;
+  stats.percentile_latency_ns = {{50, 900}, {99, 1500}};
+  for (uint64_t latency = 100; latency < 200000; latency *= 3) {
+    stats.latency_histogram.Record(latency);
+  }
+  stats.bucket_latency_histograms["stream 0"].Record(1234);
+  stats.request_class_stats["bulk"].rejected_count = 3;
+  stats.request_class_stats["bulk"].latencies.Record(5678);
+  stats.slow_requests = SlowRequestTracker(2);
+  SlowRequest slow_request;
+  slow_request.latency_ns = 9000;
+  slow_request.data_stream_id = 1;
+  slow_request.endpoint = "localhost:8001";
+  stats.slow_requests.Record(std::move(slow_request));
+  stats.stage_times.request_count = 4;
+  stats.stage_times.total_ns[CLIENT_STAGE_SEND] = 40;
+  stats.validation_stats.max_abs_error = 0.125;
+  return status;
+}
+
+}  // namespace
+
+TEST_CASE("sweep_checkpoint: resume the completed levels")
+{
+  const std::string path = MakeTempPath();
+  std::remove(path.c_str());
+
+  std::shared_ptr<SweepCheckpoint> checkpoint;
+  REQUIRE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+  CHECK(checkpoint->CompletedCount() == 0);
+  REQUIRE(checkpoint->Append(MakeStatus(1), true, true).IsOk());
+  REQUIRE(checkpoint->Append(MakeStatus(2), false, true).IsOk());
+  checkpoint.reset();
+
+  SUBCASE("all the fields are kept")
+  {
+    REQUIRE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+    CHECK(checkpoint->CompletedCount() == 2);
+
+    PerfStatus status;
+    bool meets_threshold = false;
+    bool is_stable = false;
+    CHECK_FALSE(
+        checkpoint->Find(3, &status, &meets_threshold, &is_stable));
+    REQUIRE(checkpoint->Find(2, &status, &meets_threshold, &is_stable));
+    CHECK_FALSE(meets_threshold);
+    CHECK(is_stable);
+
+    const PerfStatus expected = MakeStatus(2);
+    CHECK(status.concurrency == 2);
+    CHECK(status.batch_size == 2);
+    CHECK(status.overhead_pct == 1.5);
+    CHECK(status.stabilizing_latency_ns == 2000);
+    CHECK(status.window_infer_per_sec == expected.window_infer_per_sec);
+    CHECK(
+        status.client_resources.thread_cpu_pct ==
+        expected.client_resources.thread_cpu_pct);
+    CHECK(status.server_stats.inference_count == 20);
+    REQUIRE(status.server_stats.composing_models_stat.size() == 1);
+    CHECK(
+        status.server_stats.composing_models_stat.begin()->first ==
+        cb::ModelIdentifier("pre process", ""));
+    CHECK(
+        status.server_stats.composing_models_stat.begin()
+            ->second.queue_time_ns == 7);
+
+    const ClientSideStats& stats = status.client_stats;
+    CHECK(stats.request_count == 20);
+    CHECK(stats.infer_per_sec == expected.client_stats.infer_per_sec);
+    CHECK(
+        stats.percentile_latency_ns ==
+        expected.client_stats.percentile_latency_ns);
+    CHECK(
+        stats.latency_histogram.Serialize() ==
+        expected.client_stats.latency_histogram.Serialize());
+    CHECK(
+        stats.bucket_latency_histograms.at("stream 0").ValueAtPercentile(50) ==
+        1234);
+    CHECK(stats.request_class_stats.at("bulk").rejected_count == 3);
+    CHECK(stats.request_class_stats.at("bulk").latencies.TotalCount() == 1);
+    CHECK(stats.slow_requests.Capacity() == 2);
+    REQUIRE(stats.slow_requests.Requests().size() == 1);
+    CHECK(stats.slow_requests.Requests()[0].latency_ns == 9000);
+    CHECK(stats.slow_requests.Requests()[0].data_stream_id == 1);
+    CHECK(stats.slow_requests.Requests()[0].endpoint == "localhost:8001");
+    CHECK(stats.stage_times.request_count == 4);
+    CHECK(stats.stage_times.total_ns[CLIENT_STAGE_SEND] == 40);
+    CHECK(stats.validation_stats.max_abs_error == 0.125);
+  }
+  SUBCASE("a level cut short is measured again")
+  {
+    std::ifstream in(path);
+    std::string content(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    // Cut in the middle of the last line of the second level
+    std::ofstream(path) << content.substr(0, content.size() - 12);
+
+    REQUIRE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+    CHECK(checkpoint->CompletedCount() == 1);
+    PerfStatus status;
+    bool meets_threshold = false;
+    bool is_stable = false;
+    CHECK(checkpoint->Find(1, &status, &meets_threshold, &is_stable));
+    CHECK_FALSE(checkpoint->Find(2, &status, &meets_threshold, &is_stable));
+
+    // The file no longer has the partial level
+    REQUIRE(checkpoint->Append(MakeStatus(2), true, true).IsOk());
+    checkpoint.reset();
+    REQUIRE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+    CHECK(checkpoint->CompletedCount() == 2);
+  }
+  SUBCASE("other settings")
+  {
+    CHECK_FALSE(SweepCheckpoint::Create(path, "model=b", &checkpoint).IsOk());
+  }
+  SUBCASE("removed once the sweep finished")
+  {
+    REQUIRE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+    REQUIRE(checkpoint->Remove().IsOk());
+    CHECK_FALSE(std::ifstream(path).is_open());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("sweep_checkpoint: not a checkpoint file")
+{
+  const std::string path = MakeTempPath();
+  std::ofstream(path) << "Concurrency,Inferences/Second" << std::endl;
+  std::shared_ptr<SweepCheckpoint> checkpoint;
+  CHECK_FALSE(SweepCheckpoint::Create(path, "model=a", &checkpoint).IsOk());
+  std::remove(path.c_str());
+}
+
+}}  // namespace triton::perfanalyzer
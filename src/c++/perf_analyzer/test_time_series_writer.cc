@@ -0,0 +1,184 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "doctest.h"
+#include "time_series_writer.h"
+
+namespace triton { namespace perfanalyzer {
+
+class TestTimeSeriesWriter {
+ public:
+  static std::string CsvHeader() { return TimeSeriesWriter::CsvHeader(); }
+
+  static std::string FormatCsv(const TimeSeriesSample& sample)
+  {
+    return TimeSeriesWriter::FormatCsv(sample);
+  }
+
+  static std::string FormatPrometheus(
+      const TimeSeriesSample& sample, const std::string& model_name)
+  {
+    return TimeSeriesWriter::FormatPrometheus(sample, model_name);
+  }
+};
+
+namespace {
+
+TimeSeriesSample
+MakeSample()
+{
+  TimeSeriesSample sample;
+  sample.timestamp_ms = 1500;
+  sample.infer_per_sec = 250.5;
+  sample.inflight_requests = 8;
+  sample.avg_latency_us = 1200;
+  sample.p50_latency_us = 1000;
+  sample.p90_latency_us = 1800;
+  sample.p95_latency_us = 2500;
+  sample.p99_latency_us = 4000;
+  return sample;
+}
+
+size_t
+CountColumns(const std::string& line)
+{
+  return std::count(line.begin(), line.end(), ',') + 1;
+}
+
+}  // namespace
+
+TEST_CASE("time_series_writer: csv rows")
+{
+  TimeSeriesSample sample = MakeSample();
+
+  SUBCASE("without server side statistics")
+  {
+    CHECK(
+        TestTimeSeriesWriter::FormatCsv(sample) ==
+        "1500,250.5,8,1200,1000,1800,2500,4000,,,");
+  }
+
+  SUBCASE("with server side statistics")
+  {
+    sample.has_server_stats = true;
+    sample.server_request_count = 250;
+    sample.server_queue_us = 300;
+    sample.server_compute_us = 700;
+    CHECK(
+        TestTimeSeriesWriter::FormatCsv(sample) ==
+        "1500,250.5,8,1200,1000,1800,2500,4000,250,300,700");
+  }
+
+  CHECK(
+      CountColumns(TestTimeSeriesWriter::FormatCsv(sample)) ==
+      CountColumns(TestTimeSeriesWriter::CsvHeader()));
+}
+
+TEST_CASE("time_series_writer: prometheus text")
+{
+  TimeSeriesSample sample = MakeSample();
+
+  SUBCASE("without server side statistics")
+  {
+    std::string text =
+        TestTimeSeriesWriter::FormatPrometheus(sample, "my_model");
+    CHECK(
+        text.find("perf_analyzer_sample_timestamp_seconds{model=\"my_model\"} "
+                  "1.5\n") != std::string::npos);
+    CHECK(
+        text.find("perf_analyzer_throughput_infer_per_sec{model=\"my_model\"} "
+                  "250.5\n") != std::string::npos);
+    CHECK(
+        text.find("perf_analyzer_in_flight_requests{model=\"my_model\"} 8\n") !=
+        std::string::npos);
+    CHECK(
+        text.find("perf_analyzer_latency_us{model=\"my_model\",quantile="
+                  "\"0.99\"} 4000\n") != std::string::npos);
+    CHECK(text.find("perf_analyzer_server_") == std::string::npos);
+  }
+
+  SUBCASE("with server side statistics")
+  {
+    sample.has_server_stats = true;
+    sample.server_queue_us = 300;
+    std::string text =
+        TestTimeSeriesWriter::FormatPrometheus(sample, "my_model");
+    CHECK(
+        text.find("# TYPE perf_analyzer_server_queue_us gauge\n") !=
+        std::string::npos);
+    CHECK(
+        text.find("perf_analyzer_server_queue_us{model=\"my_model\"} 300\n") !=
+        std::string::npos);
+  }
+}
+
+TEST_CASE("time_series_writer: create")
+{
+  std::unique_ptr<TimeSeriesWriter> writer;
+
+  SUBCASE("zero interval")
+  {
+    cb::Error err = TimeSeriesWriter::Create(
+        "time_series.csv", 0, nullptr, nullptr, nullptr, &writer);
+    CHECK(!err.IsOk());
+    CHECK(writer.get() == nullptr);
+  }
+
+  SUBCASE("unwritable csv file")
+  {
+    cb::Error err = TimeSeriesWriter::Create(
+        "/nonexistent/time_series.csv", 1000, nullptr, nullptr, nullptr,
+        &writer);
+    CHECK(!err.IsOk());
+    CHECK(writer.get() == nullptr);
+  }
+
+  SUBCASE("csv header")
+  {
+    char path[] = "/tmp/pa_time_series_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd != -1);
+    close(fd);
+
+    cb::Error err = TimeSeriesWriter::Create(
+        path, 1000, nullptr, nullptr, nullptr, &writer);
+    REQUIRE(err.IsOk());
+    writer.reset();
+
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    CHECK(line == TestTimeSeriesWriter::CsvHeader());
+    std::remove(path);
+  }
+}
+
+}}  // namespace triton::perfanalyzer
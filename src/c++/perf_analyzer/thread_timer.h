@@ -0,0 +1,154 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+namespace triton { namespace perfanalyzer {
+
+/// Accumulates the time a thread spends in one category, such as idle,
+/// sending or waiting on a callback, without any lock.
+///
+/// Start() and Stop() must be called from a single thread, the thread that
+/// owns the timer. Other threads read the timer through a sequence lock, so
+/// that reading never blocks the owner: the owner makes the sequence odd
+/// while it updates the timer, and a read that overlaps an update is
+/// retried.
+///
+class ThreadTimer {
+ public:
+  /// Counts the time for as long as it is in scope.
+  class Scope {
+   public:
+    explicit Scope(ThreadTimer& timer) : timer_(timer) { timer_.Start(); }
+    ~Scope() { timer_.Stop(); }
+
+   private:
+    ThreadTimer& timer_;
+  };
+
+  void Start()
+  {
+    if (is_active_.load(std::memory_order_relaxed)) {
+      throw std::runtime_error("Can't start a timer that is already active\n");
+    }
+
+    BeginUpdate();
+    start_ns_.store(NowNs(), std::memory_order_relaxed);
+    is_active_.store(true, std::memory_order_relaxed);
+    EndUpdate();
+  }
+
+  void Stop()
+  {
+    if (!is_active_.load(std::memory_order_relaxed)) {
+      throw std::runtime_error("Can't stop a timer that isn't active\n");
+    }
+
+    // The time is read within the update, so that a read that completes
+    // before the update never counts more time than the update adds
+    BeginUpdate();
+    const uint64_t duration =
+        NowNs() - start_ns_.load(std::memory_order_relaxed);
+    total_ns_.store(
+        total_ns_.load(std::memory_order_relaxed) + duration,
+        std::memory_order_relaxed);
+    is_active_.store(false, std::memory_order_relaxed);
+    EndUpdate();
+  }
+
+  /// Reset the time counter. If the timer is active, it keeps counting from
+  /// now on. Must be called from the thread that reads the timer.
+  ///
+  void Reset() { reset_ns_ = TotalTime(); }
+
+  /// Returns the number of nanoseconds this timer has counted since it was
+  /// last reset, including the pending time if it is active
+  ///
+  uint64_t GetTime()
+  {
+    const uint64_t total = TotalTime();
+    return (total > reset_ns_) ? total - reset_ns_ : 0;
+  }
+
+ protected:
+  std::atomic<uint64_t> total_ns_{0};
+
+ private:
+  // Odd while the owner updates the timer
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<bool> is_active_{false};
+  std::atomic<uint64_t> start_ns_{0};
+  // The time counted when the timer was last reset. Only used by the
+  // reading thread.
+  uint64_t reset_ns_{0};
+
+  static uint64_t NowNs()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void BeginUpdate()
+  {
+    sequence_.store(
+        sequence_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void EndUpdate()
+  {
+    sequence_.store(
+        sequence_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+  }
+
+  uint64_t TotalTime() const
+  {
+    while (true) {
+      // Read before the sequence, the pending time ends before any update
+      // that the sequence does not show
+      const uint64_t now = NowNs();
+      const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+      const uint64_t total_ns = total_ns_.load(std::memory_order_relaxed);
+      const bool is_active = is_active_.load(std::memory_order_relaxed);
+      const uint64_t start_ns = start_ns_.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (((sequence & 1) == 0) &&
+          (sequence_.load(std::memory_order_relaxed) == sequence)) {
+        return (is_active && (now > start_ns)) ? total_ns + (now - start_ns)
+                                               : total_ns;
+      }
+    }
+  }
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,347 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "time_series_writer.h"
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "constants.h"
+
+namespace triton { namespace perfanalyzer {
+
+namespace {
+
+bool
+EndsWith(const std::string& str, const std::string& suffix)
+{
+  return (str.size() >= suffix.size()) &&
+         (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+uint64_t
+AverageUs(const uint64_t total_ns, const uint64_t count)
+{
+  return (count == 0) ? 0 : total_ns / count / 1000;
+}
+
+}  // namespace
+
+cb::Error
+TimeSeriesWriter::Create(
+    const std::string& path, const uint64_t interval_ms, LoadManager* manager,
+    const std::shared_ptr<cb::ClientBackend>& stats_backend,
+    const std::shared_ptr<ModelParser>& parser,
+    std::unique_ptr<TimeSeriesWriter>* writer)
+{
+  if (interval_ms == 0) {
+    return cb::Error(
+        "time series interval must be greater than 0", pa::GENERIC_ERROR);
+  }
+
+  std::unique_ptr<TimeSeriesWriter> local_writer(
+      new TimeSeriesWriter(path, interval_ms, manager, stats_backend, parser));
+
+  if (!local_writer->prometheus_format_) {
+    local_writer->csv_file_.open(path, std::ofstream::out);
+    if (!local_writer->csv_file_.is_open()) {
+      return cb::Error(
+          "failed to open time series file " + path, pa::GENERIC_ERROR);
+    }
+    local_writer->csv_file_ << CsvHeader() << std::endl;
+  }
+
+  *writer = std::move(local_writer);
+  return cb::Error::Success;
+}
+
+TimeSeriesWriter::TimeSeriesWriter(
+    const std::string& path, const uint64_t interval_ms, LoadManager* manager,
+    const std::shared_ptr<cb::ClientBackend>& stats_backend,
+    const std::shared_ptr<ModelParser>& parser)
+    : path_(path), prometheus_format_(EndsWith(path, ".prom")),
+      interval_ms_(interval_ms), manager_(manager),
+      stats_backend_(stats_backend), parser_(parser)
+{
+}
+
+TimeSeriesWriter::~TimeSeriesWriter()
+{
+  if (sample_loop_future_.valid()) {
+    Stop();
+  }
+}
+
+void
+TimeSeriesWriter::Start()
+{
+  should_keep_sampling_ = true;
+  sample_loop_future_ = std::async(
+      std::launch::async, &TimeSeriesWriter::SampleEveryInterval, this);
+}
+
+void
+TimeSeriesWriter::Stop()
+{
+  {
+    std::lock_guard<std::mutex> sample_loop_lock{sample_loop_mutex_};
+    should_keep_sampling_ = false;
+  }
+  sample_loop_cv_.notify_one();
+  if (sample_loop_future_.valid()) {
+    sample_loop_future_.get();
+  }
+}
+
+void
+TimeSeriesWriter::SampleEveryInterval()
+{
+  // Discard what was recorded before the first interval
+  LatencyHistogram discarded;
+  manager_->GetAndResetIntervalLatencies(&discarded);
+  if (stats_backend_ != nullptr) {
+    TimeSeriesSample sample;
+    TakeServerSample(sample);
+  }
+
+  const auto interval = std::chrono::milliseconds(interval_ms_);
+  auto previous = std::chrono::steady_clock::now();
+  auto next_sample = previous + interval;
+  while (true) {
+    {
+      // Sample on a fixed grid so that slow samples do not make it drift
+      std::unique_lock<std::mutex> sample_loop_lock{sample_loop_mutex_};
+      sample_loop_cv_.wait_until(sample_loop_lock, next_sample, [this] {
+        return !should_keep_sampling_;
+      });
+      if (!should_keep_sampling_) {
+        break;
+      }
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const double interval_s =
+        std::chrono::duration<double>(now - previous).count();
+    previous = now;
+    next_sample += interval;
+
+    TimeSeriesSample sample;
+    cb::Error err = TakeSample(sample, interval_s);
+    if (err.IsOk()) {
+      err = Write(sample);
+    }
+    if (!err.IsOk()) {
+      std::cerr << "WARNING: stopped writing the time series: "
+                << err.Message() << std::endl;
+      break;
+    }
+  }
+}
+
+cb::Error
+TimeSeriesWriter::TakeSample(TimeSeriesSample& sample, const double interval_s)
+{
+  sample.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+
+  LatencyHistogram latencies;
+  RETURN_IF_ERROR(manager_->GetAndResetIntervalLatencies(&latencies));
+  sample.infer_per_sec =
+      latencies.TotalCount() * manager_->BatchSize() / interval_s;
+  sample.inflight_requests = manager_->GetNumInflightRequests();
+  sample.avg_latency_us = latencies.Mean() / 1000;
+  sample.p50_latency_us = latencies.ValueAtPercentile(50) / 1000;
+  sample.p90_latency_us = latencies.ValueAtPercentile(90) / 1000;
+  sample.p95_latency_us = latencies.ValueAtPercentile(95) / 1000;
+  sample.p99_latency_us = latencies.ValueAtPercentile(99) / 1000;
+
+  if (stats_backend_ != nullptr) {
+    cb::Error err = TakeServerSample(sample);
+    if (!err.IsOk()) {
+      // The series is still useful without the server side statistics
+      std::cerr << "WARNING: stopped collecting server side statistics for "
+                   "the time series: "
+                << err.Message() << std::endl;
+      stats_backend_.reset();
+      sample.has_server_stats = false;
+    }
+  }
+  return cb::Error::Success;
+}
+
+cb::Error
+TimeSeriesWriter::TakeServerSample(TimeSeriesSample& sample)
+{
+  std::map<cb::ModelIdentifier, cb::ModelStatistics> model_stats;
+  RETURN_IF_ERROR(stats_backend_->ModelInferenceStatistics(
+      &model_stats, parser_->ModelName(), parser_->ModelVersion()));
+
+  cb::ModelStatistics total{};
+  for (const auto& model_stat : model_stats) {
+    const cb::ModelStatistics& stat = model_stat.second;
+    total.success_count_ += stat.success_count_;
+    total.queue_time_ns_ += stat.queue_time_ns_;
+    total.compute_input_time_ns_ += stat.compute_input_time_ns_;
+    total.compute_infer_time_ns_ += stat.compute_infer_time_ns_;
+    total.compute_output_time_ns_ += stat.compute_output_time_ns_;
+  }
+
+  if (has_prev_server_stat_) {
+    const uint64_t count =
+        total.success_count_ - prev_server_stat_.success_count_;
+    const uint64_t compute_ns =
+        (total.compute_input_time_ns_ + total.compute_infer_time_ns_ +
+         total.compute_output_time_ns_) -
+        (prev_server_stat_.compute_input_time_ns_ +
+         prev_server_stat_.compute_infer_time_ns_ +
+         prev_server_stat_.compute_output_time_ns_);
+    sample.has_server_stats = true;
+    sample.server_request_count = count;
+    sample.server_queue_us = AverageUs(
+        total.queue_time_ns_ - prev_server_stat_.queue_time_ns_, count);
+    sample.server_compute_us = AverageUs(compute_ns, count);
+  }
+  prev_server_stat_ = total;
+  has_prev_server_stat_ = true;
+  return cb::Error::Success;
+}
+
+cb::Error
+TimeSeriesWriter::Write(const TimeSeriesSample& sample)
+{
+  if (!prometheus_format_) {
+    csv_file_ << FormatCsv(sample) << std::endl;
+    if (!csv_file_.good()) {
+      return cb::Error(
+          "failed to write to time series file " + path_, pa::GENERIC_ERROR);
+    }
+    return cb::Error::Success;
+  }
+
+  // Replace the file atomically so the collector never reads a partial one
+  const std::string tmp_path = path_ + ".tmp";
+  {
+    std::ofstream prom_file(tmp_path, std::ofstream::out);
+    prom_file << FormatPrometheus(sample, parser_->ModelName());
+    if (!prom_file.good()) {
+      return cb::Error(
+          "failed to write to time series file " + tmp_path,
+          pa::GENERIC_ERROR);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    return cb::Error(
+        "failed to replace time series file " + path_, pa::GENERIC_ERROR);
+  }
+  return cb::Error::Success;
+}
+
+std::string
+TimeSeriesWriter::CsvHeader()
+{
+  return "Timestamp (ms),Inferences/Second,In Flight Requests,"
+         "Avg Latency (us),p50 Latency (us),p90 Latency (us),"
+         "p95 Latency (us),p99 Latency (us),Server Requests,"
+         "Server Queue (us),Server Compute (us)";
+}
+
+std::string
+TimeSeriesWriter::FormatCsv(const TimeSeriesSample& sample)
+{
+  std::stringstream row;
+  row << sample.timestamp_ms << "," << sample.infer_per_sec << ","
+      << sample.inflight_requests << "," << sample.avg_latency_us << ","
+      << sample.p50_latency_us << "," << sample.p90_latency_us << ","
+      << sample.p95_latency_us << "," << sample.p99_latency_us << ",";
+  // Leave the server side columns empty rather than reporting zeros
+  if (sample.has_server_stats) {
+    row << sample.server_request_count << "," << sample.server_queue_us << ","
+        << sample.server_compute_us;
+  } else {
+    row << ",,";
+  }
+  return row.str();
+}
+
+std::string
+TimeSeriesWriter::FormatPrometheus(
+    const TimeSeriesSample& sample, const std::string& model_name)
+{
+  const std::string labels = "model=\"" + model_name + "\"";
+  std::stringstream text;
+  auto gauge = [&](const std::string& name, const std::string& help) {
+    text << "# HELP " << name << " " << help << "\n";
+    text << "# TYPE " << name << " gauge\n";
+  };
+
+  gauge(
+      "perf_analyzer_sample_timestamp_seconds",
+      "The end of the latest sample interval.");
+  text << "perf_analyzer_sample_timestamp_seconds{" << labels << "} "
+       << sample.timestamp_ms / 1000.0 << "\n";
+  gauge(
+      "perf_analyzer_throughput_infer_per_sec",
+      "Inferences per second completed during the interval.");
+  text << "perf_analyzer_throughput_infer_per_sec{" << labels << "} "
+       << sample.infer_per_sec << "\n";
+  gauge(
+      "perf_analyzer_in_flight_requests",
+      "Requests sent but not completed at the end of the interval.");
+  text << "perf_analyzer_in_flight_requests{" << labels << "} "
+       << sample.inflight_requests << "\n";
+  gauge(
+      "perf_analyzer_latency_us",
+      "Client side latency of the requests completed during the interval.");
+  text << "perf_analyzer_latency_us{" << labels << ",quantile=\"avg\"} "
+       << sample.avg_latency_us << "\n";
+  text << "perf_analyzer_latency_us{" << labels << ",quantile=\"0.5\"} "
+       << sample.p50_latency_us << "\n";
+  text << "perf_analyzer_latency_us{" << labels << ",quantile=\"0.9\"} "
+       << sample.p90_latency_us << "\n";
+  text << "perf_analyzer_latency_us{" << labels << ",quantile=\"0.95\"} "
+       << sample.p95_latency_us << "\n";
+  text << "perf_analyzer_latency_us{" << labels << ",quantile=\"0.99\"} "
+       << sample.p99_latency_us << "\n";
+  if (sample.has_server_stats) {
+    gauge(
+        "perf_analyzer_server_requests",
+        "Requests completed by the server during the interval.");
+    text << "perf_analyzer_server_requests{" << labels << "} "
+         << sample.server_request_count << "\n";
+    gauge(
+        "perf_analyzer_server_queue_us",
+        "Average server queue time during the interval.");
+    text << "perf_analyzer_server_queue_us{" << labels << "} "
+         << sample.server_queue_us << "\n";
+    gauge(
+        "perf_analyzer_server_compute_us",
+        "Average server compute time during the interval.");
+    text << "perf_analyzer_server_compute_us{" << labels << "} "
+         << sample.server_compute_us << "\n";
+  }
+  return text.str();
+}
+
+}}  // namespace triton::perfanalyzer
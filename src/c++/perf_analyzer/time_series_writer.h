@@ -0,0 +1,161 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "client_backend/client_backend.h"
+#include "load_manager.h"
+#include "model_parser.h"
+
+namespace triton { namespace perfanalyzer {
+
+#ifndef DOCTEST_CONFIG_DISABLE
+class TestTimeSeriesWriter;
+#endif
+
+/// The load observed during one interval of the time series
+struct TimeSeriesSample {
+  // The end of the interval in milliseconds since the epoch
+  uint64_t timestamp_ms{0};
+  double infer_per_sec{0.0};
+  // The number of requests sent but not completed at the end of the interval
+  size_t inflight_requests{0};
+  // The latencies of the requests completed during the interval
+  uint64_t avg_latency_us{0};
+  uint64_t p50_latency_us{0};
+  uint64_t p90_latency_us{0};
+  uint64_t p95_latency_us{0};
+  uint64_t p99_latency_us{0};
+  // The server side statistics of the interval, if they were collected
+  bool has_server_stats{false};
+  uint64_t server_request_count{0};
+  uint64_t server_queue_us{0};
+  uint64_t server_compute_us{0};
+};
+
+//==============================================================================
+/// TimeSeriesWriter samples the load in the background while perf_analyzer
+/// runs and writes one sample per interval, independent of the measurement
+/// windows. It is meant for long soak tests and to line up client side
+/// latency spikes with events on the server.
+///
+/// By default the samples are appended to a CSV file. If the path ends in
+/// ".prom", the file is instead replaced with the latest sample in the
+/// Prometheus text format every interval, so that the textfile collector of
+/// the node exporter can scrape it.
+///
+class TimeSeriesWriter {
+ public:
+  /// Create a writer for the given load manager.
+  /// \param path The path of the file to write.
+  /// \param interval_ms The duration of each sample in milliseconds.
+  /// \param manager The load manager to sample. It must outlive the writer
+  /// and have interval latencies enabled.
+  /// \param stats_backend The client backend used to get the server side
+  /// statistics. Not shared with the profiler, since the samples are taken
+  /// from another thread. If null, no server side statistics are written.
+  /// \param parser The ModelParser object to get the model details.
+  /// \param writer Returns a new TimeSeriesWriter object.
+  /// \return cb::Error object indicating success or failure.
+  static cb::Error Create(
+      const std::string& path, const uint64_t interval_ms,
+      LoadManager* manager,
+      const std::shared_ptr<cb::ClientBackend>& stats_backend,
+      const std::shared_ptr<ModelParser>& parser,
+      std::unique_ptr<TimeSeriesWriter>* writer);
+
+  /// Stops the background thread, in case Stop() wasn't called
+  ~TimeSeriesWriter();
+
+  /// Starts the background thread that takes a sample every interval
+  void Start();
+
+  /// Stops the background thread
+  void Stop();
+
+ private:
+  TimeSeriesWriter(
+      const std::string& path, const uint64_t interval_ms,
+      LoadManager* manager,
+      const std::shared_ptr<cb::ClientBackend>& stats_backend,
+      const std::shared_ptr<ModelParser>& parser);
+
+  void SampleEveryInterval();
+
+  /// Collects the client and server side observations since the last sample
+  /// \param sample Returns the sample.
+  /// \param interval_s The duration of the interval in seconds.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error TakeSample(TimeSeriesSample& sample, const double interval_s);
+
+  /// Adds the server side statistics since the last sample.
+  /// \param sample Returns the sample with the server side fields set.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error TakeServerSample(TimeSeriesSample& sample);
+
+  cb::Error Write(const TimeSeriesSample& sample);
+
+  /// \return The CSV header line.
+  static std::string CsvHeader();
+
+  /// \return The sample as a CSV line.
+  static std::string FormatCsv(const TimeSeriesSample& sample);
+
+  /// \param model_name The name of the profiled model, used as label.
+  /// \return The sample in the Prometheus text format.
+  static std::string FormatPrometheus(
+      const TimeSeriesSample& sample, const std::string& model_name);
+
+  std::string path_;
+  bool prometheus_format_{false};
+  uint64_t interval_ms_{1000};
+  LoadManager* manager_{nullptr};
+  std::shared_ptr<cb::ClientBackend> stats_backend_{nullptr};
+  std::shared_ptr<ModelParser> parser_{nullptr};
+  std::ofstream csv_file_;
+
+  // The cumulative server side statistics at the previous sample
+  cb::ModelStatistics prev_server_stat_{};
+  bool has_prev_server_stat_{false};
+
+  bool should_keep_sampling_{false};
+  std::future<void> sample_loop_future_{};
+  std::mutex sample_loop_mutex_{};
+  std::condition_variable sample_loop_cv_{};
+
+#ifndef DOCTEST_CONFIG_DISABLE
+  friend TestTimeSeriesWriter;
+#endif
+};
+
+}}  // namespace triton::perfanalyzer
@@ -0,0 +1,372 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+// A minimal harness for microbenchmarks in the style of Google Benchmark.
+// Each benchmark is a function taking a State, which times the iterations
+// of its 'KeepRunning()' loop. The number of iterations is raised until
+// the loop runs for the minimum time, and the time and CPU time per
+// iteration are reported along with the throughput the benchmark sets.
+
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace triton { namespace client { namespace benchmark {
+
+class State {
+ public:
+  State(const std::vector<int64_t>& args, const uint64_t max_iterations)
+      : args_(args), max_iterations_(max_iterations)
+  {
+  }
+
+  /// Returns the argument at 'index' of the benchmark case.
+  int64_t range(const size_t index) const { return args_.at(index); }
+
+  /// Runs the next iteration, the timer starts on the first call.
+  bool KeepRunning()
+  {
+    if (iterations_ == 0) {
+      ResumeTiming();
+    }
+    if ((iterations_ < max_iterations_) && error_.empty()) {
+      iterations_++;
+      return true;
+    }
+    PauseTiming();
+    return false;
+  }
+
+  /// Stops the timer, for the setup of an iteration.
+  void PauseTiming()
+  {
+    if (running_) {
+      elapsed_ns_ += WallTimeNs() - start_ns_;
+      cpu_ns_ += CpuTimeNs() - cpu_start_ns_;
+      running_ = false;
+    }
+  }
+
+  void ResumeTiming()
+  {
+    if (!running_) {
+      start_ns_ = WallTimeNs();
+      cpu_start_ns_ = CpuTimeNs();
+      running_ = true;
+    }
+  }
+
+  /// Sets the total bytes and items processed by all the iterations, to
+  /// report the throughput.
+  void SetBytesProcessed(const int64_t bytes) { bytes_processed_ = bytes; }
+  void SetItemsProcessed(const int64_t items) { items_processed_ = items; }
+
+  /// Adds a value to the report of the benchmark case.
+  void SetCounter(const std::string& name, const double value)
+  {
+    counters_[name] = value;
+  }
+
+  /// Stops the benchmark case, which is reported as failed.
+  void SkipWithError(const std::string& error) { error_ = error; }
+
+  uint64_t iterations() const { return iterations_; }
+  uint64_t ElapsedNs() const { return elapsed_ns_; }
+  uint64_t CpuNs() const { return cpu_ns_; }
+  int64_t BytesProcessed() const { return bytes_processed_; }
+  int64_t ItemsProcessed() const { return items_processed_; }
+  const std::map<std::string, double>& Counters() const { return counters_; }
+  const std::string& ErrorMessage() const { return error_; }
+
+ private:
+  static uint64_t WallTimeNs()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // The CPU time of all the threads of the process, so that the work of the
+  // worker threads of the clients is accounted for
+  static uint64_t CpuTimeNs()
+  {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  }
+
+  const std::vector<int64_t> args_;
+  const uint64_t max_iterations_;
+  uint64_t iterations_{0};
+  bool running_{false};
+  uint64_t start_ns_{0};
+  uint64_t cpu_start_ns_{0};
+  uint64_t elapsed_ns_{0};
+  uint64_t cpu_ns_{0};
+  int64_t bytes_processed_{0};
+  int64_t items_processed_{0};
+  std::map<std::string, double> counters_;
+  std::string error_;
+};
+
+class Benchmark {
+ public:
+  using Function = std::function<void(State&)>;
+
+  Benchmark(const std::string& name, Function function)
+      : name_(name), function_(function)
+  {
+  }
+
+  /// Adds a case with the given arguments.
+  Benchmark* Args(const std::vector<int64_t>& args)
+  {
+    args_.push_back(args);
+    return this;
+  }
+
+  /// Adds a case for every combination of the given values of each argument.
+  Benchmark* ArgsProduct(const std::vector<std::vector<int64_t>>& values)
+  {
+    std::vector<std::vector<int64_t>> product{{}};
+    for (const auto& arg_values : values) {
+      std::vector<std::vector<int64_t>> next;
+      for (const auto& args : product) {
+        for (const auto value : arg_values) {
+          next.push_back(args);
+          next.back().push_back(value);
+        }
+      }
+      product.swap(next);
+    }
+    args_.insert(args_.end(), product.begin(), product.end());
+    return this;
+  }
+
+  const std::string& Name() const { return name_; }
+  const Function& Func() const { return function_; }
+  const std::vector<std::vector<int64_t>>& ArgsList() const { return args_; }
+
+ private:
+  const std::string name_;
+  const Function function_;
+  std::vector<std::vector<int64_t>> args_;
+};
+
+inline std::vector<std::unique_ptr<Benchmark>>&
+Registry()
+{
+  static std::vector<std::unique_ptr<Benchmark>> registry;
+  return registry;
+}
+
+inline Benchmark*
+Register(const std::string& name, Benchmark::Function function)
+{
+  Registry().emplace_back(new Benchmark(name, function));
+  return Registry().back().get();
+}
+
+namespace detail {
+
+inline std::string
+CaseName(const Benchmark& benchmark, const std::vector<int64_t>& args)
+{
+  std::string name = benchmark.Name();
+  for (const auto arg : args) {
+    name += "/" + std::to_string(arg);
+  }
+  return name;
+}
+
+inline std::string
+FormatRate(const double per_second, const std::string& unit)
+{
+  static const char* prefixes[] = {"", "k", "M", "G", "T"};
+  double value = per_second;
+  size_t prefix = 0;
+  while ((value >= 1000) && (prefix < 4)) {
+    value /= 1000;
+    prefix++;
+  }
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(2) << value << prefixes[prefix] << unit
+     << "/s";
+  return ss.str();
+}
+
+}  // namespace detail
+
+/// Runs the registered benchmarks selected by the command line:
+///   --benchmark_filter=<substring>  only run the cases whose name contains
+///                                   the substring.
+///   --benchmark_min_time=<seconds>  the minimum time each case runs for,
+///                                   0.5 by default.
+///   --benchmark_format=<console|csv>
+/// \return The exit code of the process.
+inline int
+RunBenchmarks(int argc, char** argv)
+{
+  std::string filter;
+  double min_time_s = 0.5;
+  bool csv = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const size_t separator = arg.find('=');
+    const std::string key = arg.substr(0, separator);
+    const std::string value =
+        (separator == std::string::npos) ? "" : arg.substr(separator + 1);
+    if (key == "--benchmark_filter") {
+      filter = value;
+    } else if (key == "--benchmark_min_time") {
+      min_time_s = std::atof(value.c_str());
+    } else if ((key == "--benchmark_format") && (value == "csv")) {
+      csv = true;
+    } else if ((key == "--benchmark_format") && (value == "console")) {
+      csv = false;
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--benchmark_filter=<substring>]"
+                   " [--benchmark_min_time=<seconds>]"
+                   " [--benchmark_format=<console|csv>]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  if (csv) {
+    std::cout << "name,iterations,real_time_ns,cpu_time_ns,bytes_per_second,"
+                 "items_per_second,counters,error"
+              << std::endl;
+  } else {
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+              << std::setw(14) << "Time(ns)" << std::setw(14) << "CPU(ns)"
+              << std::setw(12) << "Iterations" << "  Throughput" << std::endl;
+  }
+
+  int failed = 0;
+  const uint64_t min_time_ns = min_time_s * 1e9;
+  for (const auto& benchmark : Registry()) {
+    auto args_list = benchmark->ArgsList();
+    if (args_list.empty()) {
+      args_list.emplace_back();
+    }
+    for (const auto& args : args_list) {
+      const std::string name = detail::CaseName(*benchmark, args);
+      if (name.find(filter) == std::string::npos) {
+        continue;
+      }
+
+      // Grow the number of iterations until the case runs long enough
+      uint64_t iterations = 1;
+      std::unique_ptr<State> state;
+      while (true) {
+        state.reset(new State(args, iterations));
+        benchmark->Func()(*state);
+        if (!state->ErrorMessage().empty() ||
+            (state->ElapsedNs() >= min_time_ns) ||
+            (iterations >= 1000000000)) {
+          break;
+        }
+        double multiplier = 10;
+        if (state->ElapsedNs() > 0) {
+          multiplier = std::min(
+              10.0, std::max(2.0, 1.4 * min_time_ns / state->ElapsedNs()));
+        }
+        iterations *= multiplier;
+      }
+
+      const double count = std::max<uint64_t>(state->iterations(), 1);
+      const double seconds = state->ElapsedNs() / 1e9;
+      std::string throughput;
+      std::string counters;
+      if ((state->BytesProcessed() > 0) && (seconds > 0)) {
+        throughput += detail::FormatRate(
+                          state->BytesProcessed() / seconds, "B") +
+                      " ";
+      }
+      if ((state->ItemsProcessed() > 0) && (seconds > 0)) {
+        throughput += detail::FormatRate(
+                          state->ItemsProcessed() / seconds, "items") +
+                      " ";
+      }
+      for (const auto& counter : state->Counters()) {
+        std::stringstream ss;
+        ss << counter.first << "=" << counter.second;
+        counters += (counters.empty() ? "" : " ") + ss.str();
+      }
+
+      if (!state->ErrorMessage().empty()) {
+        failed++;
+      }
+      if (csv) {
+        std::cout << name << "," << state->iterations() << ","
+                  << state->ElapsedNs() / count << ","
+                  << state->CpuNs() / count << ","
+                  << ((seconds > 0) ? state->BytesProcessed() / seconds : 0)
+                  << ","
+                  << ((seconds > 0) ? state->ItemsProcessed() / seconds : 0)
+                  << ",\"" << counters << "\",\"" << state->ErrorMessage()
+                  << "\"" << std::endl;
+      } else if (!state->ErrorMessage().empty()) {
+        std::cout << std::left << std::setw(48) << name
+                  << " ERROR: " << state->ErrorMessage() << std::endl;
+      } else {
+        std::cout << std::left << std::setw(48) << name << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(14)
+                  << state->ElapsedNs() / count << std::setw(14)
+                  << state->CpuNs() / count << std::setw(12)
+                  << state->iterations() << "  " << throughput << counters
+                  << std::endl;
+      }
+    }
+  }
+
+  return (failed == 0) ? 0 : 1;
+}
+
+}}}  // namespace triton::client::benchmark
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+/// Registers the function 'fn' as a benchmark, the arguments of its cases
+/// can be set by chaining calls, e.g. BENCHMARK(BM_Foo)->Args({1, 2});
+#define BENCHMARK(fn)                                                 \
+  static triton::client::benchmark::Benchmark* BENCHMARK_CONCAT(      \
+      benchmark_registration_, __LINE__) __attribute__((unused)) =    \
+      triton::client::benchmark::Register(#fn, fn)
@@ -701,6 +701,73 @@ TYPED_TEST_P(ClientTest, InferMultiMismatchOutputs)
   ASSERT_FALSE(err.IsOk()) << "Expect InferMulti() to fail";
 }
 
+TYPED_TEST_P(ClientTest, InferMultiSequence)
+{
+  // Interleave the requests of several sequences of the "simple_sequence"
+  // model in one InferMulti() call. The server rejects a request that arrives
+  // before the start or after the end of its sequence, and the model returns
+  // 'value + 1' only for the start request, so the results verify that the
+  // requests of each sequence reached the server in order.
+  tc::Error err = tc::Error::Success;
+  const std::vector<int32_t> values{11, 7, 5, 3, 2, 0, 1};
+  const size_t sequence_count = 4;
+  std::vector<tc::InferOptions> options;
+  std::vector<std::vector<tc::InferInput*>> inputs;
+  std::vector<std::vector<const tc::InferRequestedOutput*>> outputs;
+  std::vector<int32_t> input_data;
+  std::vector<int32_t> expected_outputs;
+  input_data.reserve(values.size() * sequence_count);
+  for (size_t v = 0; v < values.size(); ++v) {
+    for (size_t s = 0; s < sequence_count; ++s) {
+      options.emplace_back("simple_sequence");
+      if (s % 2 == 0) {
+        options.back().sequence_id_ = 1000 + s;
+      } else {
+        options.back().sequence_id_str_ = "SEQ-" + std::to_string(1000 + s);
+      }
+      options.back().sequence_start_ = (v == 0);
+      options.back().sequence_end_ = (v == values.size() - 1);
+
+      input_data.emplace_back(values[v] + static_cast<int32_t>(s));
+      tc::InferInput* input;
+      err = tc::InferInput::Create(&input, "INPUT", {1, 1}, "INT32");
+      ASSERT_TRUE(err.IsOk())
+          << "failed to create inference input: " << err.Message();
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(&input_data.back()),
+          sizeof(int32_t));
+      ASSERT_TRUE(err.IsOk())
+          << "failed to set inference input: " << err.Message();
+      inputs.push_back({input});
+
+      tc::InferRequestedOutput* output;
+      err = tc::InferRequestedOutput::Create(&output, "OUTPUT");
+      ASSERT_TRUE(err.IsOk())
+          << "failed to create inference output: " << err.Message();
+      outputs.push_back({output});
+
+      expected_outputs.emplace_back(input_data.back() + ((v == 0) ? 1 : 0));
+    }
+  }
+
+  std::vector<tc::InferResult*> results;
+  err = this->client_->InferMulti(&results, options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform multiple inferences: "
+                          << err.Message();
+  ASSERT_EQ(results.size(), expected_outputs.size())
+      << "unexpected number of results";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const uint8_t* buf = nullptr;
+    size_t byte_size = 0;
+    err = results[i]->RawData("OUTPUT", &buf, &byte_size);
+    ASSERT_TRUE(err.IsOk()) << "failed to retrieve output 'OUTPUT' for result "
+                            << i << ": " << err.Message();
+    ASSERT_EQ(byte_size, sizeof(int32_t));
+    EXPECT_EQ(*reinterpret_cast<const int32_t*>(buf), expected_outputs[i])
+        << "unexpected output for result " << i;
+  }
+}
+
 TYPED_TEST_P(ClientTest, AsyncInferMulti)
 {
   tc::Error err = tc::Error::Success;
@@ -1198,6 +1265,57 @@ TYPED_TEST_P(ClientTest, AsyncInferMultiMismatchOutputs)
   ASSERT_FALSE(err.IsOk()) << "Expect AsyncInferMulti() to fail";
 }
 
+TYPED_TEST_P(ClientTest, InferUserBuffer)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  options.model_version_ = "1";
+
+  const auto& input_0 = this->input_data_[0];
+  const auto& input_1 = this->input_data_[1];
+  std::vector<tc::InferInput*> inputs;
+  err = this->PrepareInputs(input_0, input_1, &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // OUTPUT0 is written to a user buffer, OUTPUT1 is returned as usual.
+  std::vector<int32_t> output_0_buffer(16, 0);
+  tc::InferRequestedOutput* output;
+  std::vector<const tc::InferRequestedOutput*> outputs;
+  err = tc::InferRequestedOutput::Create(&output, "OUTPUT0");
+  ASSERT_TRUE(err.IsOk()) << "failed to create inference output: "
+                          << err.Message();
+  err = output->SetUserBuffer(
+      output_0_buffer.data(), output_0_buffer.size() * sizeof(int32_t));
+  ASSERT_TRUE(err.IsOk()) << "failed to set user buffer: " << err.Message();
+  outputs.emplace_back(output);
+  err = tc::InferRequestedOutput::Create(&output, "OUTPUT1");
+  ASSERT_TRUE(err.IsOk()) << "failed to create inference output: "
+                          << err.Message();
+  outputs.emplace_back(output);
+
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(1);
+  for (size_t i = 0; i < 16; ++i) {
+    expected_outputs.back()["OUTPUT0"].emplace_back(input_0[i] + input_1[i]);
+    expected_outputs.back()["OUTPUT1"].emplace_back(input_0[i] - input_1[i]);
+  }
+
+  std::vector<tc::InferResult*> results(1);
+  err = this->client_->Infer(&results.back(), options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform inference: " << err.Message();
+
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+  const uint8_t* buf = nullptr;
+  size_t byte_size = 0;
+  err = results.back()->RawData("OUTPUT0", &buf, &byte_size);
+  ASSERT_TRUE(err.IsOk()) << "failed to retrieve output: " << err.Message();
+  EXPECT_EQ(buf, reinterpret_cast<const uint8_t*>(output_0_buffer.data()));
+  EXPECT_EQ(
+      memcmp(
+          output_0_buffer.data(), expected_outputs.back()["OUTPUT0"].data(),
+          byte_size),
+      0);
+}
+
 TYPED_TEST_P(ClientTest, LoadWithFileOverride)
 {
   std::vector<char> content;
@@ -1613,15 +1731,74 @@ TEST_F(GRPCTraceTest, GRPCClearTraceSettings)
       << std::endl;
 }
 
+// The inputs of a generate_stream request are written as JSON values, the
+// inputs that can't be are rejected before the request is sent so these
+// tests don't need a running server.
+class HTTPStreamTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    auto err =
+        tc::InferenceServerHttpClient::Create(&client_, "localhost:8000");
+    ASSERT_TRUE(err.IsOk())
+        << "failed to create HTTP client: " << err.Message();
+    err = client_->StartStream([](tc::InferResult* result) { delete result; });
+    ASSERT_TRUE(err.IsOk()) << "failed to start stream: " << err.Message();
+  }
+
+  void TearDown() override { client_->StopStream(); }
+
+  std::unique_ptr<tc::InferenceServerHttpClient> client_;
+};
+
+TEST_F(HTTPStreamTest, RejectSharedMemoryInput)
+{
+  tc::InferInput* input;
+  auto err = tc::InferInput::Create(&input, "INPUT0", {1, 16}, "INT32");
+  ASSERT_TRUE(err.IsOk()) << "failed to create input: " << err.Message();
+  std::unique_ptr<tc::InferInput> input_ptr(input);
+  err = input->SetSharedMemory("input_data", 16 * sizeof(int32_t));
+  ASSERT_TRUE(err.IsOk()) << "failed to set shared memory: " << err.Message();
+
+  err = client_->AsyncStreamInfer(tc::InferOptions("simple"), {input});
+  ASSERT_FALSE(err.IsOk()) << "Expect AsyncStreamInfer() to fail";
+  EXPECT_EQ(
+      err.Message(),
+      "input 'INPUT0' in shared memory can't be sent on a stream");
+}
+
+TEST_F(HTTPStreamTest, RejectHalfPrecisionInputs)
+{
+  for (const std::string datatype : {"FP16", "BF16"}) {
+    tc::InferInput* input;
+    auto err = tc::InferInput::Create(&input, "INPUT0", {1, 16}, datatype);
+    ASSERT_TRUE(err.IsOk()) << "failed to create input: " << err.Message();
+    std::unique_ptr<tc::InferInput> input_ptr(input);
+    std::vector<uint16_t> data(16, 0);
+    err = input->AppendRaw(
+        reinterpret_cast<const uint8_t*>(data.data()),
+        data.size() * sizeof(uint16_t));
+    ASSERT_TRUE(err.IsOk()) << "failed to set input data: " << err.Message();
+
+    err = client_->AsyncStreamInfer(tc::InferOptions("simple"), {input});
+    ASSERT_FALSE(err.IsOk())
+        << "Expect AsyncStreamInfer() to fail for " << datatype;
+    EXPECT_EQ(
+        err.Message(),
+        "input 'INPUT0' of datatype " + datatype +
+            " can't be sent on a stream");
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     ClientTest, InferMulti, InferMultiDifferentOutputs,
     InferMultiDifferentOptions, InferMultiOneOption, InferMultiOneOutput,
     InferMultiNoOutput, InferMultiMismatchOptions, InferMultiMismatchOutputs,
-    AsyncInferMulti, AsyncInferMultiDifferentOutputs,
+    InferMultiSequence, AsyncInferMulti, AsyncInferMultiDifferentOutputs,
     AsyncInferMultiDifferentOptions, AsyncInferMultiOneOption,
     AsyncInferMultiOneOutput, AsyncInferMultiNoOutput,
     AsyncInferMultiMismatchOptions, AsyncInferMultiMismatchOutputs,
-    LoadWithFileOverride, LoadWithConfigOverride);
+    InferUserBuffer, LoadWithFileOverride, LoadWithConfigOverride);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GRPC, ClientTest, tc::InferenceServerGrpcClient);
 INSTANTIATE_TYPED_TEST_SUITE_P(HTTP, ClientTest, tc::InferenceServerHttpClient);
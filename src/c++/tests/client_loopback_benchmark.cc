@@ -0,0 +1,645 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// End-to-end throughput benchmark of the HTTP and gRPC transports of the
+// C++ client libraries. A fake KServe v2 endpoint answers every inference
+// request at once with a fixed response, so that the cost of the transport
+// is measured without any model execution. The endpoint runs in a child
+// process, so that the CPU time reported per request is the one of the
+// client alone. See benchmark.h for the command line options.
+//
+// The cases are named <protocol>_<mode>/<concurrency>/<payload bytes>,
+// where the payload is the size of both the input and the output.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <grpcpp/grpcpp.h>
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark.h"
+#include "grpc_client.h"
+#include "grpc_service.grpc.pb.h"
+#include "http_client.h"
+
+namespace tc = triton::client;
+namespace bm = triton::client::benchmark;
+
+namespace {
+
+// The model name of a request carries the size of its output
+const std::string kModelPrefix = "echo_";
+
+size_t
+OutputByteSize(const std::string& model_name)
+{
+  if (model_name.compare(0, kModelPrefix.size(), kModelPrefix) != 0) {
+    return 0;
+  }
+  return std::strtoull(model_name.c_str() + kModelPrefix.size(), nullptr, 10);
+}
+
+//==============================================================================
+// Fake endpoint
+
+// Answers the inference requests over HTTP/1.1, with one thread per
+// connection
+class HttpEndpoint {
+ public:
+  // Returns the port listened on, 0 on failure
+  int Start()
+  {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t addr_len = sizeof(addr);
+    if ((listen_fd_ < 0) ||
+        (bind(listen_fd_, (struct sockaddr*)&addr, sizeof(addr)) != 0) ||
+        (listen(listen_fd_, 1024) != 0) ||
+        (getsockname(listen_fd_, (struct sockaddr*)&addr, &addr_len) != 0)) {
+      return 0;
+    }
+    std::thread(&HttpEndpoint::Accept, this).detach();
+    return ntohs(addr.sin_port);
+  }
+
+ private:
+  void Accept()
+  {
+    while (true) {
+      const int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        continue;
+      }
+      const int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      std::thread(&HttpEndpoint::Serve, this, fd).detach();
+    }
+  }
+
+  void Serve(const int fd)
+  {
+    std::string buffer;
+    std::vector<char> chunk(256 * 1024);
+    while (true) {
+      // Read the headers
+      size_t header_end;
+      while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        const ssize_t received = recv(fd, chunk.data(), chunk.size(), 0);
+        if (received <= 0) {
+          close(fd);
+          return;
+        }
+        buffer.append(chunk.data(), received);
+      }
+
+      const std::string headers = buffer.substr(0, header_end);
+      const size_t path_start = headers.find(' ') + 1;
+      const std::string path = headers.substr(
+          path_start, headers.find(' ', path_start) - path_start);
+      size_t content_length = 0;
+      std::string lower_headers = headers;
+      for (auto& c : lower_headers) {
+        c = tolower(c);
+      }
+      const size_t length_pos = lower_headers.find("content-length:");
+      if (length_pos != std::string::npos) {
+        content_length =
+            std::strtoull(headers.c_str() + length_pos + 15, nullptr, 10);
+      }
+
+      // Read and drop the body
+      const size_t request_size = header_end + 4 + content_length;
+      while (buffer.size() < request_size) {
+        const ssize_t received = recv(fd, chunk.data(), chunk.size(), 0);
+        if (received <= 0) {
+          close(fd);
+          return;
+        }
+        buffer.append(chunk.data(), received);
+      }
+      buffer.erase(0, request_size);
+
+      // The path is /v2/models/<model>[/versions/<version>]/infer
+      const std::string models = "/v2/models/";
+      std::string model_name;
+      if (path.compare(0, models.size(), models) == 0) {
+        model_name = path.substr(
+            models.size(), path.find('/', models.size()) - models.size());
+      }
+      const std::string& response = Response(model_name);
+      if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) {
+        close(fd);
+        return;
+      }
+    }
+  }
+
+  const std::string& Response(const std::string& model_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = responses_.find(model_name);
+    if (it != responses_.end()) {
+      return it->second;
+    }
+
+    const size_t byte_size = OutputByteSize(model_name);
+    std::string response;
+    if (byte_size == 0) {
+      response =
+          "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+    } else {
+      const std::string json =
+          "{\"model_name\":\"" + model_name +
+          "\",\"outputs\":[{\"name\":\"OUTPUT0\",\"datatype\":\"UINT8\","
+          "\"shape\":[" +
+          std::to_string(byte_size) +
+          "],\"parameters\":{\"binary_data_size\":" +
+          std::to_string(byte_size) + "}}]}";
+      response = "HTTP/1.1 200 OK\r\n"
+                 "Content-Type: application/octet-stream\r\n"
+                 "Inference-Header-Content-Length: " +
+                 std::to_string(json.size()) +
+                 "\r\n"
+                 "Content-Length: " +
+                 std::to_string(json.size() + byte_size) + "\r\n\r\n" + json +
+                 std::string(byte_size, '\1');
+    }
+    return responses_.emplace(model_name, std::move(response)).first->second;
+  }
+
+  int listen_fd_{-1};
+  std::mutex mutex_;
+  std::map<std::string, std::string> responses_;
+};
+
+// Answers the inference requests over gRPC, including the streaming ones
+class GrpcEndpoint final : public inference::GRPCInferenceService::Service {
+ public:
+  // Returns the port listened on, 0 on failure
+  int Start()
+  {
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(
+        "127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.SetMaxReceiveMessageSize(INT32_MAX);
+    builder.SetMaxSendMessageSize(INT32_MAX);
+    builder.RegisterService(this);
+    server_ = builder.BuildAndStart();
+    return (server_ == nullptr) ? 0 : port;
+  }
+
+  grpc::Status ModelInfer(
+      grpc::ServerContext* context, const inference::ModelInferRequest* request,
+      inference::ModelInferResponse* response) override
+  {
+    *response = Response(request->model_name());
+    return grpc::Status::OK;
+  }
+
+  grpc::Status ModelStreamInfer(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<
+          inference::ModelStreamInferResponse, inference::ModelInferRequest>*
+          stream) override
+  {
+    inference::ModelInferRequest request;
+    inference::ModelStreamInferResponse response;
+    while (stream->Read(&request)) {
+      *response.mutable_infer_response() = Response(request.model_name());
+      response.mutable_infer_response()->set_id(request.id());
+      if (!stream->Write(response)) {
+        break;
+      }
+    }
+    return grpc::Status::OK;
+  }
+
+ private:
+  const inference::ModelInferResponse& Response(const std::string& model_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = responses_.find(model_name);
+    if (it != responses_.end()) {
+      return it->second;
+    }
+
+    const size_t byte_size = OutputByteSize(model_name);
+    inference::ModelInferResponse response;
+    response.set_model_name(model_name);
+    auto output = response.add_outputs();
+    output->set_name("OUTPUT0");
+    output->set_datatype("UINT8");
+    output->add_shape(byte_size);
+    response.add_raw_output_contents(std::string(byte_size, '\1'));
+    return responses_.emplace(model_name, std::move(response)).first->second;
+  }
+
+  std::unique_ptr<grpc::Server> server_;
+  std::mutex mutex_;
+  std::map<std::string, inference::ModelInferResponse> responses_;
+};
+
+// Runs the endpoints in the child process, writing their ports to
+// 'port_fd', until 'control_fd' is closed by the parent
+void
+RunEndpoints(const int port_fd, const int control_fd)
+{
+  HttpEndpoint http_endpoint;
+  GrpcEndpoint grpc_endpoint;
+  const int ports[2] = {http_endpoint.Start(), grpc_endpoint.Start()};
+  if (write(port_fd, ports, sizeof(ports)) != sizeof(ports)) {
+    _exit(1);
+  }
+  char c;
+  while (read(control_fd, &c, 1) > 0) {
+  }
+  _exit(0);
+}
+
+//==============================================================================
+// Load generation
+
+enum class Protocol { HTTP, GRPC };
+enum class Mode { SYNC, ASYNC, STREAM };
+
+struct Config {
+  Protocol protocol;
+  Mode mode;
+  bool compress;
+};
+
+std::string http_url;
+std::string grpc_url;
+
+// Request of the echo model, with an input of 'byte_size' bytes
+class Request {
+ public:
+  Request(const size_t byte_size)
+      : options_(kModelPrefix + std::to_string(byte_size)), data_(byte_size, 1)
+  {
+    tc::InferInput* input;
+    err_ = tc::InferInput::Create(
+        &input, "INPUT0", {(int64_t)byte_size}, "UINT8");
+    if (err_.IsOk()) {
+      input_.reset(input);
+      inputs_.push_back(input);
+      err_ = input->AppendRaw(data_);
+    }
+  }
+
+  const tc::Error& Err() const { return err_; }
+  const tc::InferOptions& Options() const { return options_; }
+  const std::vector<tc::InferInput*>& Inputs() const { return inputs_; }
+
+ private:
+  tc::Error err_;
+  tc::InferOptions options_;
+  std::vector<uint8_t> data_;
+  std::unique_ptr<tc::InferInput> input_;
+  std::vector<tc::InferInput*> inputs_;
+};
+
+// Keeps 'concurrency' requests in flight until stopped, and hands the
+// completions to the benchmark loop one at a time
+class LoadDriver {
+ public:
+  LoadDriver(const Config& config, const size_t concurrency, size_t byte_size)
+      : config_(config)
+  {
+    for (size_t i = 0; i < concurrency; i++) {
+      requests_.emplace_back(new Request(byte_size));
+      if (!requests_.back()->Err().IsOk()) {
+        error_ = requests_.back()->Err().Message();
+        return;
+      }
+    }
+
+    if (config_.mode == Mode::SYNC) {
+      // A client per thread, as the synchronous API is not thread safe
+      for (size_t i = 0; i < concurrency; i++) {
+        threads_.emplace_back(&LoadDriver::SyncLoop, this, i);
+      }
+      return;
+    }
+
+    tc::Error err;
+    if (config_.protocol == Protocol::HTTP) {
+      err = tc::InferenceServerHttpClient::Create(&http_client_, http_url);
+    } else {
+      err = tc::InferenceServerGrpcClient::Create(&grpc_client_, grpc_url);
+      if (err.IsOk() && (config_.mode == Mode::STREAM)) {
+        err = grpc_client_->StartStream(
+            [this](tc::InferResult* result) { Complete(result, 0); }, false,
+            0, tc::Headers(), Compression());
+      }
+    }
+    if (!err.IsOk()) {
+      error_ = err.Message();
+      return;
+    }
+    for (size_t i = 0; i < concurrency; i++) {
+      free_slots_.push_back(i);
+    }
+    threads_.emplace_back(&LoadDriver::IssueLoop, this);
+  }
+
+  ~LoadDriver()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    issue_cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    // Wait for the requests in flight before the clients are destroyed
+    std::unique_lock<std::mutex> lock(mutex_);
+    complete_cv_.wait(lock, [this] { return in_flight_count_ == 0; });
+    if (grpc_client_ != nullptr) {
+      lock.unlock();
+      grpc_client_->StopStream();
+    }
+  }
+
+  // Waits for the next completion, returns false on error
+  bool WaitForCompletion(std::string* error)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiting_ = true;
+    complete_cv_.wait(lock, [this] {
+      return (completed_count_ > consumed_count_) || !error_.empty();
+    });
+    waiting_ = false;
+    if (!error_.empty()) {
+      *error = error_;
+      return false;
+    }
+    consumed_count_++;
+    return true;
+  }
+
+ private:
+  grpc_compression_algorithm Compression() const
+  {
+    return config_.compress ? GRPC_COMPRESS_GZIP : GRPC_COMPRESS_NONE;
+  }
+
+  tc::InferenceServerHttpClient::CompressionType HttpCompression() const
+  {
+    return config_.compress
+               ? tc::InferenceServerHttpClient::CompressionType::GZIP
+               : tc::InferenceServerHttpClient::CompressionType::NONE;
+  }
+
+  void SyncLoop(const size_t slot)
+  {
+    std::unique_ptr<tc::InferenceServerHttpClient> http_client;
+    std::unique_ptr<tc::InferenceServerGrpcClient> grpc_client;
+    tc::Error err;
+    if (config_.protocol == Protocol::HTTP) {
+      err = tc::InferenceServerHttpClient::Create(&http_client, http_url);
+    } else {
+      err = tc::InferenceServerGrpcClient::Create(&grpc_client, grpc_url);
+    }
+    const Request& request = *requests_[slot];
+    while (err.IsOk()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+          return;
+        }
+        in_flight_count_++;
+      }
+      tc::InferResult* result = nullptr;
+      if (config_.protocol == Protocol::HTTP) {
+        err = http_client->Infer(
+            &result, request.Options(), request.Inputs(), {}, tc::Headers(),
+            tc::Parameters(), HttpCompression());
+      } else {
+        err = grpc_client->Infer(
+            &result, request.Options(), request.Inputs(), {}, tc::Headers(),
+            Compression());
+      }
+      if (err.IsOk()) {
+        Complete(result, slot);
+      } else {
+        Fail(err.Message(), true /* in_flight */);
+      }
+    }
+    Fail(err.Message(), false /* in_flight */);
+  }
+
+  void IssueLoop()
+  {
+    while (true) {
+      size_t slot;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        issue_cv_.wait(
+            lock, [this] { return stopping_ || !free_slots_.empty(); });
+        if (stopping_) {
+          return;
+        }
+        slot = free_slots_.front();
+        free_slots_.pop_front();
+        in_flight_count_++;
+      }
+
+      const Request& request = *requests_[slot];
+      tc::Error err;
+      if (config_.mode == Mode::STREAM) {
+        err = grpc_client_->AsyncStreamInfer(
+            request.Options(), request.Inputs());
+      } else if (config_.protocol == Protocol::HTTP) {
+        err = http_client_->AsyncInfer(
+            [this, slot](tc::InferResult* result) { Complete(result, slot); },
+            request.Options(), request.Inputs(), {}, tc::Headers(),
+            tc::Parameters(), HttpCompression());
+      } else {
+        err = grpc_client_->AsyncInfer(
+            [this, slot](tc::InferResult* result) { Complete(result, slot); },
+            request.Options(), request.Inputs(), {}, tc::Headers(),
+            Compression());
+      }
+      if (!err.IsOk()) {
+        Fail(err.Message(), true /* in_flight */);
+        return;
+      }
+    }
+  }
+
+  void Complete(tc::InferResult* result, const size_t slot)
+  {
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    const tc::Error status = result->RequestStatus();
+    if (!status.IsOk()) {
+      Fail(status.Message(), true /* in_flight */);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_count_--;
+    completed_count_++;
+    if (config_.mode != Mode::SYNC) {
+      // The responses of a stream come back in order, any slot will do
+      free_slots_.push_back(slot);
+      issue_cv_.notify_one();
+    }
+    if (waiting_ || stopping_) {
+      complete_cv_.notify_one();
+    }
+  }
+
+  // Records the first error, 'in_flight' tells whether it ends a request in
+  // flight
+  void Fail(const std::string& error, const bool in_flight)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight) {
+      in_flight_count_--;
+    }
+    if (error_.empty()) {
+      error_ = error;
+    }
+    complete_cv_.notify_all();
+  }
+
+  const Config config_;
+  std::vector<std::unique_ptr<Request>> requests_;
+  std::unique_ptr<tc::InferenceServerHttpClient> http_client_;
+  std::unique_ptr<tc::InferenceServerGrpcClient> grpc_client_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable issue_cv_;
+  std::condition_variable complete_cv_;
+  std::deque<size_t> free_slots_;
+  size_t in_flight_count_{0};
+  uint64_t completed_count_{0};
+  uint64_t consumed_count_{0};
+  bool waiting_{false};
+  bool stopping_{false};
+  std::string error_;
+};
+
+void
+RunLoopback(bm::State& state, const Config& config)
+{
+  const size_t concurrency = state.range(0);
+  const size_t byte_size = state.range(1);
+  std::unique_ptr<LoadDriver> driver(
+      new LoadDriver(config, concurrency, byte_size));
+  std::string error;
+  while (state.KeepRunning()) {
+    if (!driver->WaitForCompletion(&error)) {
+      state.SkipWithError(error);
+      break;
+    }
+  }
+  driver.reset();
+
+  // The payload goes to the endpoint and comes back
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * byte_size * 2);
+}
+
+void
+RegisterLoopback(const std::string& name, const Config& config)
+{
+  bm::Register(name, [config](bm::State& state) {
+    RunLoopback(state, config);
+  })->ArgsProduct({{1, 8, 64}, {1024, 65536, 1048576}});
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  // The endpoints are forked before the clients initialize gRPC
+  int port_pipe[2];
+  int control_pipe[2];
+  if ((pipe(port_pipe) != 0) || (pipe(control_pipe) != 0)) {
+    std::cerr << "error: failed to create pipes" << std::endl;
+    return 1;
+  }
+  const pid_t pid = fork();
+  if (pid < 0) {
+    std::cerr << "error: failed to fork the endpoint" << std::endl;
+    return 1;
+  }
+  if (pid == 0) {
+    close(port_pipe[0]);
+    close(control_pipe[1]);
+    RunEndpoints(port_pipe[1], control_pipe[0]);
+  }
+  close(port_pipe[1]);
+  close(control_pipe[0]);
+
+  int ports[2];
+  if ((read(port_pipe[0], ports, sizeof(ports)) != sizeof(ports)) ||
+      (ports[0] == 0) || (ports[1] == 0)) {
+    std::cerr << "error: failed to start the endpoint" << std::endl;
+    return 1;
+  }
+  http_url = "127.0.0.1:" + std::to_string(ports[0]);
+  grpc_url = "127.0.0.1:" + std::to_string(ports[1]);
+
+  RegisterLoopback("http_sync", Config{Protocol::HTTP, Mode::SYNC, false});
+  RegisterLoopback("http_async", Config{Protocol::HTTP, Mode::ASYNC, false});
+  RegisterLoopback("grpc_sync", Config{Protocol::GRPC, Mode::SYNC, false});
+  RegisterLoopback("grpc_async", Config{Protocol::GRPC, Mode::ASYNC, false});
+  RegisterLoopback("grpc_stream", Config{Protocol::GRPC, Mode::STREAM, false});
+  RegisterLoopback(
+      "http_async_gzip", Config{Protocol::HTTP, Mode::ASYNC, true});
+  RegisterLoopback(
+      "grpc_async_gzip", Config{Protocol::GRPC, Mode::ASYNC, true});
+
+  const int ret = bm::RunBenchmarks(argc, argv);
+
+  close(control_pipe[1]);
+  waitpid(pid, nullptr, 0);
+  return ret;
+}
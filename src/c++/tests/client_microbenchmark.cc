@@ -0,0 +1,277 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmarks of the request and response processing of the C++ client
+// libraries, which run without a server. See benchmark.h for the command
+// line options.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "grpc_client.h"
+#include "http_client.h"
+
+namespace tc = triton::client;
+namespace bm = triton::client::benchmark;
+
+#define SKIP_IF_ERR(STATE, X)               \
+  {                                         \
+    tc::Error err = (X);                    \
+    if (!err.IsOk()) {                      \
+      (STATE).SkipWithError(err.Message()); \
+      return;                               \
+    }                                       \
+  }
+
+namespace {
+
+// The chunks the data of the inputs is appended in
+constexpr size_t kChunkByteSize = 4096;
+
+const std::vector<int64_t> kTensorByteSizes{64, 4096, 262144, 4194304};
+const std::vector<int64_t> kTensorCounts{1, 8};
+
+// FP32 input tensors sharing the same data
+class Inputs {
+ public:
+  Inputs(const size_t input_count, const size_t byte_size)
+      : data_(byte_size, 1)
+  {
+    for (size_t i = 0; i < input_count; i++) {
+      tc::InferInput* input;
+      err_ = tc::InferInput::Create(
+          &input, "INPUT" + std::to_string(i), {(int64_t)byte_size / 4},
+          "FP32");
+      if (!err_.IsOk()) {
+        return;
+      }
+      inputs_.push_back(input);
+      err_ = input->AppendRaw(data_);
+      if (!err_.IsOk()) {
+        return;
+      }
+    }
+  }
+
+  ~Inputs()
+  {
+    for (auto input : inputs_) {
+      delete input;
+    }
+  }
+
+  const tc::Error& Err() const { return err_; }
+  std::vector<tc::InferInput*>& Get() { return inputs_; }
+  const std::vector<uint8_t>& Data() const { return data_; }
+
+ private:
+  tc::Error err_;
+  std::vector<uint8_t> data_;
+  std::vector<tc::InferInput*> inputs_;
+};
+
+// Builds an HTTP response body holding the outputs of 'element_count'
+// elements in binary form
+std::vector<char>
+HttpResponseBody(
+    const std::string& datatype, const size_t element_count,
+    const std::vector<std::string>& outputs, size_t* header_length)
+{
+  std::string header = "{\"model_name\":\"benchmark\",\"outputs\":[";
+  for (size_t i = 0; i < outputs.size(); i++) {
+    if (i != 0) {
+      header += ",";
+    }
+    header += "{\"name\":\"OUTPUT" + std::to_string(i) +
+              "\",\"datatype\":\"" + datatype + "\",\"shape\":[" +
+              std::to_string(element_count) +
+              "],\"parameters\":{\"binary_data_size\":" +
+              std::to_string(outputs[i].size()) + "}}";
+  }
+  header += "]}";
+
+  std::vector<char> body(header.begin(), header.end());
+  for (const auto& output : outputs) {
+    body.insert(body.end(), output.begin(), output.end());
+  }
+  *header_length = header.size();
+  return body;
+}
+
+// Serializes the elements of a BYTES tensor, each prefixed by its length
+std::string
+SerializeBytes(const std::vector<std::string>& elements)
+{
+  std::string serialized;
+  for (const auto& element : elements) {
+    const uint32_t length = element.size();
+    serialized.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    serialized.append(element);
+  }
+  return serialized;
+}
+
+void
+BM_InferInputAppendRaw(bm::State& state)
+{
+  Inputs inputs(state.range(0), state.range(1));
+  SKIP_IF_ERR(state, inputs.Err());
+  const uint8_t* data = inputs.Data().data();
+  const size_t byte_size = inputs.Data().size();
+  while (state.KeepRunning()) {
+    for (auto input : inputs.Get()) {
+      input->Reset();
+      for (size_t offset = 0; offset < byte_size; offset += kChunkByteSize) {
+        input->AppendRaw(
+            data + offset, std::min(kChunkByteSize, byte_size - offset));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InferInputAppendRaw)
+    ->ArgsProduct({kTensorCounts, kTensorByteSizes});
+
+void
+BM_HttpGenerateRequestBody(bm::State& state)
+{
+  Inputs inputs(state.range(0), state.range(1));
+  SKIP_IF_ERR(state, inputs.Err());
+  tc::InferOptions options("benchmark");
+  options.request_id_ = "1";
+  std::vector<char> body;
+  size_t header_length;
+  while (state.KeepRunning()) {
+    SKIP_IF_ERR(
+        state, tc::InferenceServerHttpClient::GenerateRequestBody(
+                   &body, &header_length, options, inputs.Get()));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_HttpGenerateRequestBody)
+    ->ArgsProduct({kTensorCounts, kTensorByteSizes});
+
+void
+BM_HttpParseResponseBody(bm::State& state)
+{
+  const std::vector<std::string> outputs(
+      state.range(0), std::string(state.range(1), '\1'));
+  size_t header_length;
+  const std::vector<char> body =
+      HttpResponseBody("FP32", state.range(1) / 4, outputs, &header_length);
+  while (state.KeepRunning()) {
+    tc::InferResult* result;
+    SKIP_IF_ERR(
+        state, tc::InferenceServerHttpClient::ParseResponseBody(
+                   &result, body, header_length));
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    SKIP_IF_ERR(state, result->RequestStatus());
+    for (size_t i = 0; i < outputs.size(); i++) {
+      const uint8_t* buf;
+      size_t byte_size;
+      SKIP_IF_ERR(
+          state,
+          result->RawData("OUTPUT" + std::to_string(i), &buf, &byte_size));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(BM_HttpParseResponseBody)
+    ->ArgsProduct({kTensorCounts, kTensorByteSizes});
+
+void
+BM_GrpcPrepareInfer(bm::State& state)
+{
+  Inputs inputs(state.range(0), state.range(1));
+  SKIP_IF_ERR(state, inputs.Err());
+  // The channel only connects on the first call, so no server is needed
+  std::unique_ptr<tc::InferenceServerGrpcClient> client;
+  SKIP_IF_ERR(
+      state, tc::InferenceServerGrpcClient::Create(&client, "localhost:8001"));
+  tc::InferOptions options("benchmark");
+  while (state.KeepRunning()) {
+    std::shared_ptr<tc::PreparedInferRequest> prepared;
+    SKIP_IF_ERR(state, client->PrepareInfer(&prepared, options, inputs.Get()));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_GrpcPrepareInfer)->ArgsProduct({kTensorCounts, kTensorByteSizes});
+
+void
+BM_BytesEncode(bm::State& state)
+{
+  const std::vector<std::string> elements(
+      state.range(0), std::string(state.range(1), 'a'));
+  tc::InferInput* input;
+  SKIP_IF_ERR(
+      state,
+      tc::InferInput::Create(&input, "INPUT0", {state.range(0)}, "BYTES"));
+  std::unique_ptr<tc::InferInput> input_ptr(input);
+  while (state.KeepRunning()) {
+    input->Reset();
+    SKIP_IF_ERR(state, input->AppendFromString(elements));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(
+      state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_BytesEncode)->ArgsProduct({{1, 64, 4096}, {16, 1024}});
+
+void
+BM_BytesDecode(bm::State& state)
+{
+  const std::vector<std::string> elements(
+      state.range(0), std::string(state.range(1), 'a'));
+  size_t header_length;
+  const std::vector<char> body =
+      HttpResponseBody(
+      "BYTES", elements.size(), {SerializeBytes(elements)}, &header_length);
+  tc::InferResult* result;
+  SKIP_IF_ERR(
+      state, tc::InferenceServerHttpClient::ParseResponseBody(
+                 &result, body, header_length));
+  std::unique_ptr<tc::InferResult> result_ptr(result);
+  std::vector<std::string> decoded;
+  while (state.KeepRunning()) {
+    SKIP_IF_ERR(state, result->StringData("OUTPUT0", &decoded));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(
+      state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_BytesDecode)->ArgsProduct({{1, 64, 4096}, {16, 1024}});
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  return bm::RunBenchmarks(argc, argv);
+}
@@ -0,0 +1,142 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#include "cuda_memory_pool.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// This test needs a GPU but no running Triton server.
+class CudaMemoryPoolTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    auto err = tc::CudaMemoryPool::Create(&pool_, "pool", 0, 1000, 2);
+    ASSERT_TRUE(err.IsOk()) << "failed to create pool: " << err.Message();
+    // Non-blocking so that the default stream doesn't wait for its work
+    ASSERT_EQ(
+        cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking),
+        cudaSuccess);
+  }
+
+  void TearDown() override
+  {
+    if (stream_ != nullptr) {
+      cudaStreamSynchronize(stream_);
+      cudaStreamDestroy(stream_);
+    }
+  }
+
+  std::unique_ptr<tc::CudaMemoryPool> pool_;
+  cudaStream_t stream_{nullptr};
+};
+
+// Holds the stream it is enqueued on until 'released' is set.
+void CUDART_CB
+BlockStream(void* released)
+{
+  while (!reinterpret_cast<std::atomic<bool>*>(released)->load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST_F(CudaMemoryPoolTest, AcquireAllBlocks)
+{
+  // The block size is rounded up to the alignment of device allocations
+  EXPECT_EQ(pool_->BlockByteSize(), 1024u);
+
+  tc::CudaMemoryPool::Block first;
+  tc::CudaMemoryPool::Block second;
+  auto err = pool_->Acquire(&first);
+  ASSERT_TRUE(err.IsOk()) << "failed to acquire block: " << err.Message();
+  err = pool_->Acquire(&second);
+  ASSERT_TRUE(err.IsOk()) << "failed to acquire block: " << err.Message();
+  EXPECT_NE(first.index, second.index);
+  EXPECT_EQ(first.offset, first.index * pool_->BlockByteSize());
+  EXPECT_EQ(second.offset, second.index * pool_->BlockByteSize());
+  EXPECT_EQ(
+      reinterpret_cast<uint8_t*>(second.addr) -
+          reinterpret_cast<uint8_t*>(first.addr),
+      static_cast<ptrdiff_t>(second.offset) -
+          static_cast<ptrdiff_t>(first.offset));
+
+  tc::CudaMemoryPool::Block third;
+  err = pool_->Acquire(&third);
+  ASSERT_FALSE(err.IsOk()) << "Expect Acquire() to fail on an empty pool";
+  EXPECT_EQ(err.Message(), "no free block in CUDA memory pool 'pool'");
+}
+
+TEST_F(CudaMemoryPoolTest, RecycleBlockOnceStreamCompletes)
+{
+  tc::CudaMemoryPool::Block first;
+  tc::CudaMemoryPool::Block second;
+  ASSERT_TRUE(pool_->Acquire(&first).IsOk());
+  ASSERT_TRUE(pool_->Acquire(&second).IsOk());
+
+  // The first block is given back behind work that hasn't completed yet, so
+  // it must not be handed out again.
+  std::atomic<bool> released{false};
+  ASSERT_EQ(cudaLaunchHostFunc(stream_, BlockStream, &released), cudaSuccess);
+  auto err = pool_->Release(first, stream_);
+  ASSERT_TRUE(err.IsOk()) << "failed to release block: " << err.Message();
+  tc::CudaMemoryPool::Block block;
+  EXPECT_FALSE(pool_->Acquire(&block).IsOk())
+      << "Expect Acquire() to skip a block whose work is pending";
+
+  // The second block is given back with no pending work and is handed out
+  // ahead of the older first block.
+  err = pool_->Release(second, 0);
+  ASSERT_TRUE(err.IsOk()) << "failed to release block: " << err.Message();
+  ASSERT_EQ(cudaStreamSynchronize(0), cudaSuccess);
+  err = pool_->Acquire(&block);
+  ASSERT_TRUE(err.IsOk()) << "failed to acquire block: " << err.Message();
+  EXPECT_EQ(block.index, second.index);
+
+  // Once the work completes the first block is recycled.
+  released = true;
+  ASSERT_EQ(cudaStreamSynchronize(stream_), cudaSuccess);
+  err = pool_->Acquire(&block);
+  ASSERT_TRUE(err.IsOk()) << "failed to acquire block: " << err.Message();
+  EXPECT_EQ(block.index, first.index);
+  EXPECT_EQ(block.addr, first.addr);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
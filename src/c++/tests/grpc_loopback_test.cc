@@ -0,0 +1,325 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Sends inference requests through the C++ gRPC client to an in-process
+// server, to check the requests serialized by the client with
+// 'zero_copy_input_threshold' and the responses parsed by it with
+// 'alias_output_contents'. The server is a generic service, so that it can
+// answer with responses protobuf wouldn't produce.
+
+#include "gtest/gtest.h"
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/grpcpp.h>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "grpc_client.h"
+#include "grpc_service.pb.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// Answers the ModelInfer calls with 'response' followed by the bytes of
+// 'trailer', and records the last request.
+class LoopbackEndpoint final : public grpc::CallbackGenericService {
+ public:
+  grpc::ServerGenericBidiReactor* CreateReactor(
+      grpc::GenericCallbackServerContext* context) override
+  {
+    return new InferReactor(this, context->method());
+  }
+
+  void SetResponse(
+      const inference::ModelInferResponse& response, const std::string& trailer)
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    response.SerializeToString(&response_);
+    response_ += trailer;
+  }
+
+  inference::ModelInferRequest LastRequest()
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return request_;
+  }
+
+ private:
+  class InferReactor : public grpc::ServerGenericBidiReactor {
+   public:
+    InferReactor(LoopbackEndpoint* endpoint, const std::string& method)
+        : endpoint_(endpoint)
+    {
+      if (method != "/inference.GRPCInferenceService/ModelInfer") {
+        Finish(grpc::Status(grpc::StatusCode::UNIMPLEMENTED, method));
+        return;
+      }
+      StartRead(&request_);
+    }
+
+    void OnReadDone(bool ok) override
+    {
+      if (!ok) {
+        Finish(grpc::Status::OK);
+        return;
+      }
+      grpc::Slice slice;
+      if (!request_.DumpToSingleSlice(&slice).ok()) {
+        Finish(grpc::Status(grpc::StatusCode::INTERNAL, "request"));
+        return;
+      }
+      response_ = endpoint_->Answer(slice);
+      StartWriteAndFinish(&response_, grpc::WriteOptions(), grpc::Status::OK);
+    }
+
+    void OnDone() override { delete this; }
+
+   private:
+    LoopbackEndpoint* endpoint_;
+    grpc::ByteBuffer request_;
+    grpc::ByteBuffer response_;
+  };
+
+  grpc::ByteBuffer Answer(const grpc::Slice& request)
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    request_.ParseFromArray(request.begin(), request.size());
+    grpc::Slice response(response_);
+    return grpc::ByteBuffer(&response, 1);
+  }
+
+  std::mutex mtx_;
+  inference::ModelInferRequest request_;
+  std::string response_;
+};
+
+class GrpcLoopbackTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(
+        "127.0.0.1:0", grpc::InsecureServerCredentials(), &port_);
+    builder.RegisterCallbackGenericService(&endpoint_);
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(server_, nullptr);
+
+    inference::ModelInferResponse response;
+    response.set_model_name("model");
+    AddOutput(&response, "OUTPUT0", "xyz");
+    AddOutput(&response, "OUTPUT1", "0123");
+    endpoint_.SetResponse(response, "");
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+    if (server_ != nullptr) {
+      server_->Shutdown();
+    }
+  }
+
+  static void AddOutput(
+      inference::ModelInferResponse* response, const std::string& name,
+      const std::string& data)
+  {
+    auto output = response->add_outputs();
+    output->set_name(name);
+    output->set_datatype("UINT8");
+    output->add_shape(data.size());
+    response->add_raw_output_contents(data);
+  }
+
+  void MakeClient(const tc::GrpcClientOptions& options)
+  {
+    ASSERT_TRUE(tc::InferenceServerGrpcClient::Create(
+                    &client_, "127.0.0.1:" + std::to_string(port_),
+                    false /* verbose */, false /* use_ssl */, tc::SslOptions(),
+                    tc::KeepAliveOptions(), false /* use_cached_channel */,
+                    options)
+                    .IsOk());
+  }
+
+  // Send 'inputs' with AsyncInfer() and wait for the result.
+  std::unique_ptr<tc::InferResult> Infer(
+      const std::vector<tc::InferInput*>& inputs)
+  {
+    std::promise<tc::InferResult*> promise;
+    tc::Error err = client_->AsyncInfer(
+        [&promise](tc::InferResult* result) { promise.set_value(result); },
+        tc::InferOptions("model"), inputs);
+    EXPECT_TRUE(err.IsOk()) << err;
+    if (!err.IsOk()) {
+      return nullptr;
+    }
+    return std::unique_ptr<tc::InferResult>(promise.get_future().get());
+  }
+
+  static std::string RawData(
+      const tc::InferResult& result, const std::string& name)
+  {
+    const uint8_t* buf = nullptr;
+    size_t byte_size = 0;
+    EXPECT_TRUE(result.RawData(name, &buf, &byte_size).IsOk());
+    return std::string(reinterpret_cast<const char*>(buf), byte_size);
+  }
+
+  LoopbackEndpoint endpoint_;
+  int port_{0};
+  std::unique_ptr<grpc::Server> server_;
+  std::unique_ptr<tc::InferenceServerGrpcClient> client_;
+};
+
+TEST_F(GrpcLoopbackTest, SendZeroCopyInputs)
+{
+  tc::GrpcClientOptions options;
+  options.zero_copy_input_threshold = 1;
+  MakeClient(options);
+
+  tc::InferInput* input0;
+  ASSERT_TRUE(tc::InferInput::Create(&input0, "INPUT0", {6}, "UINT8").IsOk());
+  std::unique_ptr<tc::InferInput> input0_ptr(input0);
+  const std::string chunk0 = "abc";
+  const std::string chunk1 = "def";
+  ASSERT_TRUE(input0
+                  ->AppendRaw(
+                      reinterpret_cast<const uint8_t*>(chunk0.data()),
+                      chunk0.size())
+                  .IsOk());
+  ASSERT_TRUE(input0
+                  ->AppendRaw(
+                      reinterpret_cast<const uint8_t*>(chunk1.data()),
+                      chunk1.size())
+                  .IsOk());
+
+  tc::InferInput* input1;
+  ASSERT_TRUE(tc::InferInput::Create(&input1, "INPUT1", {4}, "UINT8").IsOk());
+  std::unique_ptr<tc::InferInput> input1_ptr(input1);
+  std::shared_ptr<uint8_t> shared(
+      new uint8_t[4]{1, 2, 3, 4}, std::default_delete<uint8_t[]>());
+  ASSERT_TRUE(input1->AppendShared(shared, 4).IsOk());
+
+  auto result = Infer({input0, input1});
+  ASSERT_NE(result, nullptr);
+  EXPECT_TRUE(result->RequestStatus().IsOk()) << result->RequestStatus();
+
+  const inference::ModelInferRequest request = endpoint_.LastRequest();
+  EXPECT_EQ(request.model_name(), "model");
+  ASSERT_EQ(request.inputs_size(), 2);
+  EXPECT_EQ(request.inputs(0).name(), "INPUT0");
+  EXPECT_EQ(request.inputs(1).name(), "INPUT1");
+  ASSERT_EQ(request.raw_input_contents_size(), 2);
+  EXPECT_EQ(request.raw_input_contents(0), "abcdef");
+  EXPECT_EQ(request.raw_input_contents(1), std::string("\1\2\3\4", 4));
+}
+
+TEST_F(GrpcLoopbackTest, AliasOutputContents)
+{
+  tc::GrpcClientOptions options;
+  options.alias_output_contents = true;
+  MakeClient(options);
+
+  auto result = Infer({});
+  ASSERT_NE(result, nullptr);
+  ASSERT_TRUE(result->RequestStatus().IsOk()) << result->RequestStatus();
+
+  // The result holds the received response, not the client.
+  client_.reset();
+  std::string model_name;
+  ASSERT_TRUE(result->ModelName(&model_name).IsOk());
+  EXPECT_EQ(model_name, "model");
+  EXPECT_EQ(RawData(*result, "OUTPUT0"), "xyz");
+  EXPECT_EQ(RawData(*result, "OUTPUT1"), "0123");
+}
+
+TEST_F(GrpcLoopbackTest, AliasOutputContentsWithFixedWidthFields)
+{
+  // Unknown fields 100 and 101 with the 64-bit and 32-bit wire types, the
+  // last one ending the message.
+  inference::ModelInferResponse response;
+  response.set_model_name("model");
+  AddOutput(&response, "OUTPUT0", "xyz");
+  endpoint_.SetResponse(
+      response, std::string("\xa1\x06", 2) + std::string(8, '\1') +
+                    std::string("\xad\x06", 2) + std::string(4, '\2'));
+
+  tc::GrpcClientOptions options;
+  options.alias_output_contents = true;
+  MakeClient(options);
+
+  auto result = Infer({});
+  ASSERT_NE(result, nullptr);
+  ASSERT_TRUE(result->RequestStatus().IsOk()) << result->RequestStatus();
+  EXPECT_EQ(RawData(*result, "OUTPUT0"), "xyz");
+}
+
+// Responses whose last field is cut short.
+class GrpcLoopbackTruncatedTest
+    : public GrpcLoopbackTest,
+      public ::testing::WithParamInterface<std::string> {
+};
+
+TEST_P(GrpcLoopbackTruncatedTest, RejectTruncatedResponse)
+{
+  inference::ModelInferResponse response;
+  response.set_model_name("model");
+  AddOutput(&response, "OUTPUT0", "xyz");
+  endpoint_.SetResponse(response, GetParam());
+
+  tc::GrpcClientOptions options;
+  options.alias_output_contents = true;
+  MakeClient(options);
+
+  auto result = Infer({});
+  ASSERT_NE(result, nullptr);
+  EXPECT_FALSE(result->RequestStatus().IsOk());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TruncatedFields, GrpcLoopbackTruncatedTest,
+    ::testing::Values(
+        // A 64-bit field with 3 of its 8 bytes
+        std::string("\xa1\x06\1\1\1", 5),
+        // A 32-bit field with 2 of its 4 bytes
+        std::string("\xad\x06\2\2", 4),
+        // An output of 5 bytes with 2 of them
+        std::string("\x32\x05xy", 4),
+        // A varint without its last byte
+        std::string("\x08\x80", 2)));
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,11 +24,19 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <dirent.h>
+#include <malloc.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include "grpc_client.h"
 #include "http_client.h"
 
@@ -76,7 +84,7 @@ ValidateShapeAndDatatype(
 void
 ValidateResult(
     const std::shared_ptr<tc::InferResult> result,
-    std::vector<int32_t>& input0_data)
+    std::vector<int32_t>& input0_data, bool print_response = true)
 {
   // Validate the results...
   ValidateShapeAndDatatype("OUTPUT0", result);
@@ -102,7 +110,9 @@ ValidateResult(
   }
 
   // Get full response
-  std::cout << result->DebugString() << std::endl;
+  if (print_response) {
+    std::cout << result->DebugString() << std::endl;
+  }
 }
 
 
@@ -172,6 +182,351 @@ RunSynchronousInference(
   }
 }
 
+// The resources of the process sampled during a soak run
+struct ResourceSample {
+  double elapsed_s{0};
+  uint64_t request_count{0};
+  double rss_kb{0};
+  double heap_kb{0};
+  double fd_count{0};
+  double socket_count{0};
+  double thread_count{0};
+  double avg_latency_us{0};
+};
+
+ResourceSample
+SampleResources()
+{
+  ResourceSample sample;
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size_pages = 0, resident_pages = 0;
+  if (statm >> size_pages >> resident_pages) {
+    sample.rss_kb = resident_pages * (sysconf(_SC_PAGESIZE) / 1024.0);
+  }
+#if defined(__GLIBC__) && \
+    ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+  sample.heap_kb = mallinfo2().uordblks / 1024.0;
+#elif defined(__GLIBC__)
+  sample.heap_kb = static_cast<unsigned int>(mallinfo().uordblks) / 1024.0;
+#endif
+
+  // The connections of the curl handles and of the gRPC channels show up as
+  // sockets, and the gRPC completion queues as threads
+  if (DIR* dir = opendir("/proc/self/fd")) {
+    while (struct dirent* entry = readdir(dir)) {
+      if (entry->d_name[0] == '.') {
+        continue;
+      }
+      sample.fd_count++;
+      char target[64];
+      const std::string path = std::string("/proc/self/fd/") + entry->d_name;
+      ssize_t len = readlink(path.c_str(), target, sizeof(target) - 1);
+      if ((len > 0) && (std::string(target, len).rfind("socket:", 0) == 0)) {
+        sample.socket_count++;
+      }
+    }
+    closedir(dir);
+  }
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("Threads:", 0) == 0) {
+      sample.thread_count = std::stod(line.substr(8));
+    }
+  }
+  return sample;
+}
+
+// Issues the requests of a soak run and keeps track of their latencies
+class SoakDriver {
+ public:
+  SoakDriver(
+      tc::InferOptions& options, std::vector<tc::InferInput*>& inputs,
+      std::vector<const tc::InferRequestedOutput*>& outputs,
+      std::vector<int32_t>& input0_data, const std::string& url,
+      const std::string& protocol, bool reuse, bool verbose)
+      : options_(options), inputs_(inputs), outputs_(outputs),
+        input0_data_(input0_data), url_(url), protocol_(protocol),
+        reuse_(reuse), verbose_(verbose)
+  {
+  }
+
+  ~SoakDriver()
+  {
+    if (streaming_) {
+      grpc_client_->StopStream();
+    }
+  }
+
+  // Runs one synchronous request, with a new client unless reused
+  void Sync()
+  {
+    if ((protocol_ == "grpc") && (!reuse_ || (grpc_client_ == nullptr))) {
+      FAIL_IF_ERR(
+          tc::InferenceServerGrpcClient::Create(&grpc_client_, url_, verbose_),
+          "unable to create grpc client");
+    } else if (
+        (protocol_ == "http") && (!reuse_ || (http_client_ == nullptr))) {
+      FAIL_IF_ERR(
+          tc::InferenceServerHttpClient::Create(&http_client_, url_, verbose_),
+          "unable to create http client");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    tc::InferResult* results;
+    if (protocol_ == "grpc") {
+      FAIL_IF_ERR(
+          grpc_client_->Infer(&results, options_, inputs_, outputs_),
+          "unable to run model");
+    } else {
+      FAIL_IF_ERR(
+          http_client_->Infer(&results, options_, inputs_, outputs_),
+          "unable to run model");
+    }
+    Complete(results, start);
+  }
+
+  // Issues an asynchronous request once fewer than 'max_in_flight' are
+  // outstanding, on a client kept for the whole run
+  void Async(size_t max_in_flight, bool streaming)
+  {
+    if ((protocol_ == "grpc") && (grpc_client_ == nullptr)) {
+      FAIL_IF_ERR(
+          tc::InferenceServerGrpcClient::Create(&grpc_client_, url_, verbose_),
+          "unable to create grpc client");
+      if (streaming) {
+        FAIL_IF_ERR(
+            grpc_client_->StartStream([this](tc::InferResult* result) {
+              std::chrono::steady_clock::time_point start;
+              {
+                // The responses of a stream arrive in the order of the
+                // requests
+                std::lock_guard<std::mutex> lock(mutex_);
+                start = stream_starts_.front();
+                stream_starts_.pop_front();
+              }
+              Complete(result, start);
+            }),
+            "unable to start stream");
+        streaming_ = true;
+      }
+    } else if ((protocol_ == "http") && (http_client_ == nullptr)) {
+      FAIL_IF_ERR(
+          tc::InferenceServerHttpClient::Create(&http_client_, url_, verbose_),
+          "unable to create http client");
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return in_flight_ < max_in_flight; });
+      in_flight_++;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto callback = [this, start](tc::InferResult* result) {
+      Complete(result, start);
+    };
+    if (streaming) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stream_starts_.push_back(start);
+      }
+      FAIL_IF_ERR(
+          grpc_client_->AsyncStreamInfer(options_, inputs_, outputs_),
+          "unable to run model");
+    } else if (protocol_ == "grpc") {
+      FAIL_IF_ERR(
+          grpc_client_->AsyncInfer(callback, options_, inputs_, outputs_),
+          "unable to run model");
+    } else {
+      FAIL_IF_ERR(
+          http_client_->AsyncInfer(callback, options_, inputs_, outputs_),
+          "unable to run model");
+    }
+  }
+
+  // Waits for the outstanding asynchronous requests
+  void Drain()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return in_flight_ == 0; });
+  }
+
+  // Returns the number of requests completed and their average latency in
+  // microseconds since the last call
+  void TakeLatencies(uint64_t* count, double* avg_latency_us)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *count = completed_;
+    *avg_latency_us =
+        (completed_ == 0) ? 0 : (latency_sum_ns_ / 1000.0) / completed_;
+    completed_ = 0;
+    latency_sum_ns_ = 0;
+  }
+
+ private:
+  void Complete(
+      tc::InferResult* results, std::chrono::steady_clock::time_point start)
+  {
+    const uint64_t latency_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    std::shared_ptr<tc::InferResult> results_ptr(results);
+    if (results_ptr->RequestStatus().IsOk()) {
+      ValidateResult(results_ptr, input0_data_, false);
+    } else {
+      std::cerr << "error: Inference failed: " << results_ptr->RequestStatus()
+                << std::endl;
+      exit(1);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_++;
+      latency_sum_ns_ += latency_ns;
+      if (in_flight_ > 0) {
+        in_flight_--;
+      }
+    }
+    cv_.notify_all();
+  }
+
+  tc::InferOptions& options_;
+  std::vector<tc::InferInput*>& inputs_;
+  std::vector<const tc::InferRequestedOutput*>& outputs_;
+  std::vector<int32_t>& input0_data_;
+  const std::string url_;
+  const std::string protocol_;
+  const bool reuse_;
+  const bool verbose_;
+  std::unique_ptr<tc::InferenceServerGrpcClient> grpc_client_;
+  std::unique_ptr<tc::InferenceServerHttpClient> http_client_;
+  bool streaming_{false};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t in_flight_{0};
+  uint64_t completed_{0};
+  uint64_t latency_sum_ns_{0};
+  std::deque<std::chrono::steady_clock::time_point> stream_starts_;
+};
+
+// The growth of a resource over the soak run, from the least squares line
+// through its samples, so that a single spike or a slow warmup do not count
+double
+TrendGrowth(
+    const std::vector<ResourceSample>& samples,
+    double ResourceSample::*resource)
+{
+  if (samples.size() < 2) {
+    return 0;
+  }
+  double mean_t = 0, mean_v = 0;
+  for (const auto& sample : samples) {
+    mean_t += sample.elapsed_s;
+    mean_v += sample.*resource;
+  }
+  mean_t /= samples.size();
+  mean_v /= samples.size();
+  double covariance = 0, variance = 0;
+  for (const auto& sample : samples) {
+    covariance += (sample.elapsed_s - mean_t) * (sample.*resource - mean_v);
+    variance += (sample.elapsed_s - mean_t) * (sample.elapsed_s - mean_t);
+  }
+  if (variance == 0) {
+    return 0;
+  }
+  return (covariance / variance) *
+         (samples.back().elapsed_s - samples.front().elapsed_s);
+}
+
+// Drives requests for 'duration_s', samples the resources of the process
+// every 'interval_s', and fails if any of them grows over the run. The first
+// samples are skipped as the warmup of the clients and the allocator.
+int
+RunSoak(
+    std::vector<tc::InferInput*>& inputs,
+    std::vector<const tc::InferRequestedOutput*>& outputs,
+    tc::InferOptions& options, std::vector<int32_t>& input0_data, bool reuse,
+    std::string url, bool verbose, std::string protocol,
+    const std::string& mode, uint64_t duration_s, uint64_t interval_s,
+    size_t max_in_flight, double max_growth_pct)
+{
+  SoakDriver driver(
+      options, inputs, outputs, input0_data, url, protocol, reuse, verbose);
+  std::vector<ResourceSample> samples;
+
+  std::cout << "elapsed_s,requests,rss_kb,heap_kb,fds,sockets,threads,"
+               "avg_latency_us"
+            << std::endl;
+  const auto start = std::chrono::steady_clock::now();
+  const auto end = start + std::chrono::seconds(duration_s);
+  auto next_sample = start + std::chrono::seconds(interval_s);
+  while (true) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= next_sample) {
+      driver.Drain();
+      ResourceSample sample = SampleResources();
+      sample.elapsed_s = std::chrono::duration<double>(now - start).count();
+      driver.TakeLatencies(&sample.request_count, &sample.avg_latency_us);
+      std::cout << std::fixed << std::setprecision(1) << sample.elapsed_s
+                << "," << sample.request_count << "," << sample.rss_kb << ","
+                << sample.heap_kb << "," << sample.fd_count << ","
+                << sample.socket_count << "," << sample.thread_count << ","
+                << sample.avg_latency_us << std::endl;
+      samples.push_back(sample);
+      if (now >= end) {
+        break;
+      }
+      next_sample += std::chrono::seconds(interval_s);
+    }
+    if (mode == "sync") {
+      driver.Sync();
+    } else {
+      driver.Async(max_in_flight, (mode == "stream"));
+    }
+  }
+
+  const size_t warmup_samples = std::max<size_t>(1, samples.size() / 10);
+  if (samples.size() < warmup_samples + 3) {
+    std::cerr << "error: too few samples to find a trend, increase the "
+                 "duration or lower the sample interval"
+              << std::endl;
+    return 1;
+  }
+  samples.erase(samples.begin(), samples.begin() + warmup_samples);
+
+  // The counts may move by a connection or a thread without leaking
+  struct Resource {
+    const char* name;
+    double ResourceSample::*value;
+    double min_growth;
+  };
+  const std::vector<Resource> resources{
+      {"rss_kb", &ResourceSample::rss_kb, 1024},
+      {"heap_kb", &ResourceSample::heap_kb, 1024},
+      {"fds", &ResourceSample::fd_count, 2},
+      {"sockets", &ResourceSample::socket_count, 2},
+      {"threads", &ResourceSample::thread_count, 2},
+      {"avg_latency_us", &ResourceSample::avg_latency_us, 0}};
+  bool failed = false;
+  for (const auto& resource : resources) {
+    const double initial = samples.front().*resource.value;
+    const double growth = TrendGrowth(samples, resource.value);
+    const double limit =
+        std::max(resource.min_growth, initial * max_growth_pct / 100);
+    const bool grew = growth > limit;
+    failed |= grew;
+    std::cout << resource.name << ": " << initial << " -> "
+              << samples.back().*resource.value << ", trend " << std::showpos
+              << growth << std::noshowpos << " (limit " << limit << ")"
+              << (grew ? " GROWING" : "") << std::endl;
+  }
+  if (failed) {
+    std::cerr << "error: resources grew over the soak run" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
 void
 Usage(char** argv, const std::string& msg = std::string())
 {
@@ -186,6 +541,18 @@ Usage(char** argv, const std::string& msg = std::string())
   std::cerr << "\t-t <client timeout in microseconds>" << std::endl;
   std::cerr << "\t-r <number of repetitions for inference> default is 100."
             << std::endl;
+  std::cerr << "\t-R (reuse the client across requests)" << std::endl;
+  std::cerr << "\t-d <soak duration in seconds, replaces -r>" << std::endl;
+  std::cerr << "\t-m <sync/async/stream> mode of the soak run, default is "
+               "sync."
+            << std::endl;
+  std::cerr << "\t-s <soak sample interval in seconds> default is 60."
+            << std::endl;
+  std::cerr << "\t-c <asynchronous requests in flight> default is 4."
+            << std::endl;
+  std::cerr << "\t-g <growth over the soak run to fail at, in percent> "
+               "default is 10."
+            << std::endl;
   std::cerr << std::endl;
 
   exit(1);
@@ -201,10 +568,15 @@ main(int argc, char** argv)
   std::string url;
   bool reuse = false;
   uint32_t repetitions = 100;
+  uint64_t duration_s = 0;
+  std::string mode = "sync";
+  uint64_t interval_s = 60;
+  size_t max_in_flight = 4;
+  double max_growth_pct = 10;
 
   // Parse commandline...
   int opt;
-  while ((opt = getopt(argc, argv, "vi:u:r:R")) != -1) {
+  while ((opt = getopt(argc, argv, "vi:u:r:Rd:m:s:c:g:")) != -1) {
     switch (opt) {
       case 'v':
         verbose = true;
@@ -228,6 +600,21 @@ main(int argc, char** argv)
       case 'R':
         reuse = true;
         break;
+      case 'd':
+        duration_s = std::stoull(optarg);
+        break;
+      case 'm':
+        mode = optarg;
+        break;
+      case 's':
+        interval_s = std::stoull(optarg);
+        break;
+      case 'c':
+        max_in_flight = std::stoul(optarg);
+        break;
+      case 'g':
+        max_growth_pct = std::stod(optarg);
+        break;
       case '?':
         Usage(argv);
         break;
@@ -239,6 +626,15 @@ main(int argc, char** argv)
     std::cerr << "Supports only http and grpc protocols" << std::endl;
     Usage(argv);
   }
+  if ((mode != "sync") && (mode != "async") && (mode != "stream")) {
+    Usage(argv, "-m must be sync, async or stream");
+  }
+  if ((mode == "stream") && (protocol != "grpc")) {
+    Usage(argv, "-m stream is only supported with -i grpc");
+  }
+  if ((interval_s == 0) || (max_in_flight == 0)) {
+    Usage(argv, "-s and -c must be greater than 0");
+  }
 
   std::string model_name = "custom_identity_int32";
   std::string model_version = "";
@@ -292,6 +688,12 @@ main(int argc, char** argv)
   std::vector<tc::InferInput*> inputs = {input0_ptr.get()};
   std::vector<const tc::InferRequestedOutput*> outputs = {output0_ptr.get()};
 
+  if (duration_s != 0) {
+    return RunSoak(
+        inputs, outputs, options, input0_data, reuse, url, verbose, protocol,
+        mode, duration_s, interval_s, max_in_flight, max_growth_pct);
+  }
+
   // Send 'repetitions' number of inference requests to the inference server.
   RunSynchronousInference(
       inputs, outputs, options, input0_data, reuse, url, verbose, protocol,
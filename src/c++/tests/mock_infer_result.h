@@ -0,0 +1,160 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace triton { namespace client {
+
+/// An InferResult whose outputs are set by the test, to exercise the
+/// classes of the client library that wrap the results of a client.
+///
+class MockInferResult : public InferResult {
+ public:
+  MockInferResult() = default;
+  explicit MockInferResult(const Error& status) : status_(status) {}
+
+  void SetOutput(
+      const std::string& name, const std::vector<int64_t>& shape,
+      const std::vector<uint8_t>& data)
+  {
+    shapes_[name] = shape;
+    raw_outputs_[name] = data;
+  }
+
+  void SetStringOutput(
+      const std::string& name, const std::vector<std::string>& strings)
+  {
+    shapes_[name] = {static_cast<int64_t>(strings.size())};
+    string_outputs_[name] = strings;
+  }
+
+  Error ModelName(std::string* name) const override
+  {
+    *name = "mock";
+    return status_;
+  }
+
+  Error ModelVersion(std::string* version) const override
+  {
+    *version = "1";
+    return status_;
+  }
+
+  Error Id(std::string* id) const override
+  {
+    id->clear();
+    return status_;
+  }
+
+  Error Shape(
+      const std::string& output_name,
+      std::vector<int64_t>* shape) const override
+  {
+    auto it = shapes_.find(output_name);
+    if (it == shapes_.end()) {
+      return Error("no output '" + output_name + "'");
+    }
+    *shape = it->second;
+    return status_;
+  }
+
+  Error Datatype(
+      const std::string& output_name, std::string* datatype) const override
+  {
+    *datatype = (string_outputs_.count(output_name) != 0) ? "BYTES" : "UINT8";
+    return status_;
+  }
+
+  Error RawData(
+      const std::string& output_name, const uint8_t** buf,
+      size_t* byte_size) const override
+  {
+    auto it = raw_outputs_.find(output_name);
+    if (it == raw_outputs_.end()) {
+      return Error("no output '" + output_name + "'");
+    }
+    *buf = it->second.data();
+    *byte_size = it->second.size();
+    return status_;
+  }
+
+  Error StringData(
+      const std::string& output_name,
+      std::vector<std::string>* string_result) const override
+  {
+    auto it = string_outputs_.find(output_name);
+    if (it == string_outputs_.end()) {
+      return Error("no output '" + output_name + "'");
+    }
+    *string_result = it->second;
+    return status_;
+  }
+
+  Error StringDataRefs(
+      const std::string& output_name,
+      std::vector<std::pair<const char*, size_t>>* string_result)
+      const override
+  {
+    auto it = string_outputs_.find(output_name);
+    if (it == string_outputs_.end()) {
+      return Error("no output '" + output_name + "'");
+    }
+    string_result->clear();
+    for (const auto& str : it->second) {
+      string_result->emplace_back(str.data(), str.size());
+    }
+    return status_;
+  }
+
+  std::string DebugString() const override { return "mock result"; }
+
+  Error RequestStatus() const override { return status_; }
+
+  Error IsFinalResponse(bool* is_final_response) const override
+  {
+    *is_final_response = true;
+    return Error::Success;
+  }
+
+  Error IsNullResponse(bool* is_null_response) const override
+  {
+    *is_null_response = false;
+    return Error::Success;
+  }
+
+ private:
+  Error status_;
+  std::map<std::string, std::vector<int64_t>> shapes_;
+  std::map<std::string, std::vector<uint8_t>> raw_outputs_;
+  std::map<std::string, std::vector<std::string>> string_outputs_;
+};
+
+}}  // namespace triton::client
@@ -0,0 +1,287 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "mock_infer_result.h"
+#include "request_batcher.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// A client holding the batches it is sent until the test completes them.
+class MockBatchClient {
+ public:
+  struct Request {
+    int64_t batch_size;
+    size_t byte_size;
+    tc::InferenceServerClient::OnCompleteFn callback;
+    std::chrono::steady_clock::time_point sent;
+  };
+
+  tc::Error AsyncInfer(
+      tc::InferenceServerClient::OnCompleteFn callback,
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs,
+      const std::vector<const tc::InferRequestedOutput*>& outputs)
+  {
+    size_t byte_size;
+    tc::Error err = inputs[0]->ByteSize(&byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      requests_.push_back(
+          {inputs[0]->Shape()[0], byte_size, std::move(callback),
+           std::chrono::steady_clock::now()});
+    }
+    cv_.notify_all();
+    return tc::Error::Success;
+  }
+
+  // Wait until 'count' batches have been sent.
+  bool WaitForRequests(const size_t count)
+  {
+    std::unique_lock<std::mutex> lk(mtx_);
+    return cv_.wait_for(lk, std::chrono::seconds(10), [this, count]() {
+      return requests_.size() >= count;
+    });
+  }
+
+  Request GetRequest(const size_t index)
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return requests_[index];
+  }
+
+  size_t RequestCount()
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return requests_.size();
+  }
+
+  // Complete a batch with an output holding the value 'first_value' + i for
+  // the sample i of the batch.
+  void Complete(const size_t index, const uint8_t first_value)
+  {
+    Request request = GetRequest(index);
+    std::vector<uint8_t> data;
+    for (int64_t i = 0; i < request.batch_size; ++i) {
+      data.push_back(first_value + i);
+    }
+    tc::MockInferResult* result = new tc::MockInferResult();
+    result->SetOutput("OUTPUT", {request.batch_size, 1}, data);
+    request.callback(result);
+  }
+
+ private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<Request> requests_;
+};
+
+// Collects the results of the samples, by sample.
+class SampleResults {
+ public:
+  explicit SampleResults(const size_t count) : results_(count) {}
+
+  tc::InferenceServerClient::OnCompleteFn Callback(const size_t sample)
+  {
+    return [this, sample](tc::InferResult* result) {
+      std::lock_guard<std::mutex> lk(mtx_);
+      results_[sample].reset(result);
+    };
+  }
+
+  // The value of the output of a sample, -1 if it has no result.
+  int Value(const size_t sample)
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (results_[sample] == nullptr) {
+      return -1;
+    }
+    const uint8_t* buf;
+    size_t byte_size;
+    std::vector<int64_t> shape;
+    if (!results_[sample]->RawData("OUTPUT", &buf, &byte_size).IsOk() ||
+        !results_[sample]->Shape("OUTPUT", &shape).IsOk() ||
+        (byte_size != 1) || (shape != std::vector<int64_t>{1, 1})) {
+      return -1;
+    }
+    return *buf;
+  }
+
+ private:
+  std::mutex mtx_;
+  std::vector<std::unique_ptr<tc::InferResult>> results_;
+};
+
+using Batcher = tc::InferenceRequestBatcher<MockBatchClient>;
+
+class RequestBatcherTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    tc::InferInput* input;
+    ASSERT_TRUE(
+        tc::InferInput::Create(&input, "INPUT", {1, 2}, "INT32").IsOk());
+    input_.reset(input);
+  }
+
+  MockBatchClient client_;
+  std::unique_ptr<tc::InferInput> input_;
+  std::unique_ptr<Batcher> batcher_;
+  const int32_t data_[2] = {1, 2};
+  const uint8_t* sample_ = reinterpret_cast<const uint8_t*>(data_);
+};
+
+TEST_F(RequestBatcherTest, FlushFullBatch)
+{
+  ASSERT_TRUE(Batcher::Create(
+                  &batcher_, &client_, tc::InferOptions("model"),
+                  {input_.get()}, {}, 4 /* max_batch_size */,
+                  10000000 /* max_delay_us */, 2 /* max_in_flight */)
+                  .IsOk());
+  SampleResults results(5);
+
+  // With no batch in flight the first sample is sent right away
+  ASSERT_TRUE(batcher_->AsyncInfer(results.Callback(0), {sample_}).IsOk());
+  ASSERT_TRUE(client_.WaitForRequests(1));
+  EXPECT_EQ(client_.GetRequest(0).batch_size, 1);
+
+  // The next samples wait for their batch to fill, well before the delay
+  for (size_t i = 1; i < 5; ++i) {
+    ASSERT_TRUE(batcher_->AsyncInfer(results.Callback(i), {sample_}).IsOk());
+  }
+  ASSERT_TRUE(client_.WaitForRequests(2));
+  EXPECT_EQ(client_.GetRequest(1).batch_size, 4);
+  EXPECT_EQ(client_.GetRequest(1).byte_size, 4 * sizeof(data_));
+  EXPECT_EQ(batcher_->BatchCount(), 2u);
+  EXPECT_EQ(batcher_->SampleCount(), 5u);
+
+  // Each sample gets its slice of the result of its batch
+  client_.Complete(0, 10);
+  client_.Complete(1, 20);
+  EXPECT_EQ(results.Value(0), 10);
+  for (size_t i = 1; i < 5; ++i) {
+    EXPECT_EQ(results.Value(i), static_cast<int>(20 + i - 1));
+  }
+  batcher_.reset();
+  EXPECT_EQ(client_.RequestCount(), 2u);
+}
+
+TEST_F(RequestBatcherTest, FlushPartialBatchAfterDelay)
+{
+  const uint64_t max_delay_us = 20000;
+  ASSERT_TRUE(Batcher::Create(
+                  &batcher_, &client_, tc::InferOptions("model"),
+                  {input_.get()}, {}, 8 /* max_batch_size */, max_delay_us,
+                  2 /* max_in_flight */)
+                  .IsOk());
+  SampleResults results(3);
+
+  ASSERT_TRUE(batcher_->AsyncInfer(results.Callback(0), {sample_}).IsOk());
+  ASSERT_TRUE(client_.WaitForRequests(1));
+
+  // A batch is in flight, so the next samples are sent once the first of
+  // them has waited the delay
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(batcher_->AsyncInfer(results.Callback(1), {sample_}).IsOk());
+  ASSERT_TRUE(batcher_->AsyncInfer(results.Callback(2), {sample_}).IsOk());
+  ASSERT_TRUE(client_.WaitForRequests(2));
+  const auto request = client_.GetRequest(1);
+  EXPECT_EQ(request.batch_size, 2);
+  EXPECT_GE(request.sent - start, std::chrono::microseconds(max_delay_us));
+
+  client_.Complete(0, 10);
+  client_.Complete(1, 20);
+  EXPECT_EQ(results.Value(0), 10);
+  EXPECT_EQ(results.Value(1), 20);
+  EXPECT_EQ(results.Value(2), 21);
+}
+
+TEST_F(RequestBatcherTest, NoSampleQueued)
+{
+  ASSERT_TRUE(Batcher::Create(
+                  &batcher_, &client_, tc::InferOptions("model"),
+                  {input_.get()}, {}, 4 /* max_batch_size */,
+                  1000 /* max_delay_us */)
+                  .IsOk());
+  batcher_.reset();
+  EXPECT_EQ(client_.RequestCount(), 0u);
+}
+
+TEST_F(RequestBatcherTest, RejectSampleWithoutData)
+{
+  ASSERT_TRUE(Batcher::Create(
+                  &batcher_, &client_, tc::InferOptions("model"),
+                  {input_.get()}, {}, 4 /* max_batch_size */,
+                  1000 /* max_delay_us */)
+                  .IsOk());
+  SampleResults results(1);
+  tc::Error err = batcher_->AsyncInfer(results.Callback(0), {});
+  ASSERT_FALSE(err.IsOk()) << "Expect AsyncInfer() to fail without data";
+  EXPECT_EQ(err.Message(), "expected data for 1 inputs, got 0");
+  EXPECT_EQ(batcher_->BatchCount(), 0u);
+  batcher_.reset();
+  EXPECT_EQ(client_.RequestCount(), 0u);
+}
+
+TEST_F(RequestBatcherTest, RejectZeroBatchSize)
+{
+  tc::Error err = Batcher::Create(
+      &batcher_, &client_, tc::InferOptions("model"), {input_.get()}, {}, 0,
+      1000);
+  EXPECT_EQ(err.Message(), "max_batch_size must be > 0");
+  EXPECT_EQ(batcher_, nullptr);
+}
+
+TEST_F(RequestBatcherTest, RejectSequence)
+{
+  tc::InferOptions options("model");
+  options.sequence_id_ = 1;
+  tc::Error err = Batcher::Create(
+      &batcher_, &client_, options, {input_.get()}, {}, 4, 1000);
+  EXPECT_EQ(err.Message(), "sequence requests can't be batched");
+  EXPECT_EQ(batcher_, nullptr);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
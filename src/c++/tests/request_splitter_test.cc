@@ -0,0 +1,312 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "mock_infer_result.h"
+#include "request_splitter.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// A client holding the sub-batches it is sent until the test completes
+// them.
+class MockSplitClient {
+ public:
+  using MakeResultFn = std::function<tc::InferResult*(
+      const std::vector<tc::InferInput*>& inputs)>;
+
+  tc::Error AsyncInferMulti(
+      tc::InferenceServerClient::OnMultiCompleteFn callback,
+      const std::vector<tc::InferOptions>& options,
+      const std::vector<std::vector<tc::InferInput*>>& inputs,
+      const std::vector<std::vector<const tc::InferRequestedOutput*>>&
+          outputs)
+  {
+    if (fail_) {
+      return tc::Error("unable to send");
+    }
+    requests_.push_back({inputs, std::move(callback)});
+    return tc::Error::Success;
+  }
+
+  // Complete the sub-batches sent so far, each with the result made by
+  // 'make_result' from its inputs.
+  void Complete(const MakeResultFn& make_result)
+  {
+    for (auto& request : requests_) {
+      std::vector<tc::InferResult*> results;
+      for (const auto& inputs : request.inputs_) {
+        results.push_back(make_result(inputs));
+      }
+      request.callback_(results);
+    }
+    requests_.clear();
+  }
+
+  // The inputs of the sub-batches sent so far.
+  std::vector<std::vector<tc::InferInput*>> SubBatches() const
+  {
+    std::vector<std::vector<tc::InferInput*>> sub_batches;
+    for (const auto& request : requests_) {
+      sub_batches.insert(
+          sub_batches.end(), request.inputs_.begin(), request.inputs_.end());
+    }
+    return sub_batches;
+  }
+
+  bool fail_{false};
+
+ private:
+  struct Request {
+    std::vector<std::vector<tc::InferInput*>> inputs_;
+    tc::InferenceServerClient::OnMultiCompleteFn callback_;
+  };
+  std::vector<Request> requests_;
+};
+
+using Splitter = tc::InferenceRequestSplitter<MockSplitClient>;
+
+class RequestSplitterTest : public ::testing::Test {
+ public:
+  void MakeInput(
+      const std::string& name, const std::vector<int64_t>& shape,
+      const std::string& datatype)
+  {
+    tc::InferInput* input;
+    ASSERT_TRUE(tc::InferInput::Create(&input, name, shape, datatype).IsOk());
+    input_.reset(input);
+  }
+
+  // Send the batch of 'input_', its result is joined to 'joined_'
+  tc::Error Send()
+  {
+    return splitter_->AsyncInfer(
+        [this](tc::InferResult* result) { joined_.reset(result); },
+        tc::InferOptions("model"), {input_.get()});
+  }
+
+  // A result without outputs
+  static tc::InferResult* EmptyResult(
+      const std::vector<tc::InferInput*>& inputs)
+  {
+    return new tc::MockInferResult();
+  }
+
+  std::unique_ptr<tc::InferInput> input_;
+  std::unique_ptr<Splitter> splitter_;
+  std::unique_ptr<tc::InferResult> joined_;
+};
+
+TEST_F(RequestSplitterTest, SplitAndReassembleUnevenBatch)
+{
+  // A batch of 7 samples of 3 INT32 in shared memory, split into
+  // sub-batches of 3, 2 and 2 samples over two clients. The clients echo
+  // the region of the shared memory of each sub-batch as its output.
+  const size_t sample_byte_size = 3 * sizeof(int32_t);
+  const size_t region_offset = 16;
+  std::vector<uint8_t> region(region_offset + 7 * sample_byte_size);
+  std::iota(region.begin(), region.end(), 0);
+  ASSERT_NO_FATAL_FAILURE(MakeInput("INPUT", {7, 3}, "INT32"));
+  ASSERT_TRUE(
+      input_->SetSharedMemory("region", 7 * sample_byte_size, region_offset)
+          .IsOk());
+
+  MockSplitClient client0;
+  MockSplitClient client1;
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client0, &client1}, 3).IsOk());
+  ASSERT_TRUE(Send().IsOk());
+
+  // The sub-batches go to the clients in turn
+  const auto sub_batches0 = client0.SubBatches();
+  const auto sub_batches1 = client1.SubBatches();
+  ASSERT_EQ(sub_batches0.size(), 2u);
+  ASSERT_EQ(sub_batches1.size(), 1u);
+  const std::vector<std::pair<tc::InferInput*, size_t>> expected{
+      {sub_batches0[0][0], 3}, {sub_batches1[0][0], 2},
+      {sub_batches0[1][0], 2}};
+  size_t start = 0;
+  for (const auto& sub_batch : expected) {
+    std::string name;
+    size_t byte_size, offset;
+    ASSERT_TRUE(
+        sub_batch.first->SharedMemoryInfo(&name, &byte_size, &offset).IsOk());
+    EXPECT_EQ(name, "region");
+    const std::vector<int64_t> sub_shape{
+        static_cast<int64_t>(sub_batch.second), 3};
+    EXPECT_EQ(sub_batch.first->Shape(), sub_shape);
+    EXPECT_EQ(byte_size, sub_batch.second * sample_byte_size);
+    EXPECT_EQ(offset, region_offset + start * sample_byte_size);
+    start += sub_batch.second;
+  }
+
+  auto echo = [&region](const std::vector<tc::InferInput*>& inputs) {
+    std::string name;
+    size_t byte_size, offset;
+    inputs[0]->SharedMemoryInfo(&name, &byte_size, &offset);
+    tc::MockInferResult* result = new tc::MockInferResult();
+    result->SetOutput(
+        "OUTPUT", inputs[0]->Shape(),
+        std::vector<uint8_t>(
+            region.begin() + offset, region.begin() + offset + byte_size));
+    return result;
+  };
+
+  // The result is only joined once every sub-batch has completed
+  client0.Complete(echo);
+  EXPECT_EQ(joined_, nullptr);
+  client1.Complete(echo);
+  ASSERT_NE(joined_, nullptr);
+  ASSERT_TRUE(joined_->RequestStatus().IsOk());
+
+  std::vector<int64_t> shape;
+  ASSERT_TRUE(joined_->Shape("OUTPUT", &shape).IsOk());
+  EXPECT_EQ(shape, std::vector<int64_t>({7, 3}));
+  const uint8_t* buf;
+  size_t byte_size;
+  ASSERT_TRUE(joined_->RawData("OUTPUT", &buf, &byte_size).IsOk());
+  EXPECT_EQ(
+      std::vector<uint8_t>(buf, buf + byte_size),
+      std::vector<uint8_t>(region.begin() + region_offset, region.end()));
+}
+
+TEST_F(RequestSplitterTest, UnevenSubBatchSizes)
+{
+  const int32_t data[5][2] = {{0, 1}, {2, 3}, {4, 5}, {6, 7}, {8, 9}};
+  MockSplitClient client;
+  ASSERT_NO_FATAL_FAILURE(MakeInput("INPUT", {5, 2}, "INT32"));
+  ASSERT_TRUE(input_->AppendTyped(&data[0][0], 10).IsOk());
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client}, 2).IsOk());
+  ASSERT_TRUE(Send().IsOk());
+
+  const auto sub_batches = client.SubBatches();
+  ASSERT_EQ(sub_batches.size(), 2u);
+  size_t byte_size;
+  EXPECT_EQ(sub_batches[0][0]->Shape(), std::vector<int64_t>({3, 2}));
+  ASSERT_TRUE(sub_batches[0][0]->ByteSize(&byte_size).IsOk());
+  EXPECT_EQ(byte_size, 3 * sizeof(data[0]));
+  EXPECT_EQ(sub_batches[1][0]->Shape(), std::vector<int64_t>({2, 2}));
+  ASSERT_TRUE(sub_batches[1][0]->ByteSize(&byte_size).IsOk());
+  EXPECT_EQ(byte_size, 2 * sizeof(data[0]));
+
+  client.Complete(EmptyResult);
+  EXPECT_NE(joined_, nullptr);
+}
+
+TEST_F(RequestSplitterTest, BatchSmallerThanSubBatchCount)
+{
+  const int32_t data[2][2] = {{0, 1}, {2, 3}};
+  MockSplitClient client;
+  ASSERT_NO_FATAL_FAILURE(MakeInput("INPUT", {2, 2}, "INT32"));
+  ASSERT_TRUE(input_->AppendTyped(&data[0][0], 4).IsOk());
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client}, 4).IsOk());
+  ASSERT_TRUE(Send().IsOk());
+
+  const auto sub_batches = client.SubBatches();
+  ASSERT_EQ(sub_batches.size(), 2u);
+  EXPECT_EQ(sub_batches[0][0]->Shape(), std::vector<int64_t>({1, 2}));
+  EXPECT_EQ(sub_batches[1][0]->Shape(), std::vector<int64_t>({1, 2}));
+
+  client.Complete(EmptyResult);
+  EXPECT_NE(joined_, nullptr);
+}
+
+TEST_F(RequestSplitterTest, RejectBytesInputs)
+{
+  MockSplitClient client;
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client}, 2).IsOk());
+  ASSERT_NO_FATAL_FAILURE(MakeInput("TEXT", {2, 1}, "BYTES"));
+  ASSERT_TRUE(input_->AppendFromString({"first", "second"}).IsOk());
+  tc::Error err = Send();
+  EXPECT_EQ(err.Message(), "input 'TEXT' has unsupported datatype BYTES");
+  EXPECT_TRUE(client.SubBatches().empty());
+}
+
+TEST_F(RequestSplitterTest, JoinBytesOutputsInOrder)
+{
+  MockSplitClient client;
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client}, 2).IsOk());
+  ASSERT_NO_FATAL_FAILURE(MakeInput("INPUT", {3, 1}, "INT32"));
+  const int32_t data[3] = {0, 1, 2};
+  ASSERT_TRUE(input_->AppendTyped(data, 3).IsOk());
+  ASSERT_TRUE(Send().IsOk());
+
+  size_t sub_batch = 0;
+  client.Complete([&sub_batch](const std::vector<tc::InferInput*>& inputs) {
+    tc::MockInferResult* result = new tc::MockInferResult();
+    std::vector<std::string> strings;
+    for (int64_t i = 0; i < inputs[0]->Shape()[0]; ++i) {
+      strings.push_back(
+          "sub-batch " + std::to_string(sub_batch) + " sample " +
+          std::to_string(i));
+    }
+    result->SetStringOutput("TEXT", strings);
+    sub_batch++;
+    return result;
+  });
+  ASSERT_NE(joined_, nullptr);
+
+  std::vector<std::string> strings;
+  ASSERT_TRUE(joined_->StringData("TEXT", &strings).IsOk());
+  EXPECT_EQ(
+      strings, std::vector<std::string>(
+                   {"sub-batch 0 sample 0", "sub-batch 0 sample 1",
+                    "sub-batch 1 sample 0"}));
+  std::vector<int64_t> shape;
+  ASSERT_TRUE(joined_->Shape("TEXT", &shape).IsOk());
+  EXPECT_EQ(shape, std::vector<int64_t>({3}));
+}
+
+TEST_F(RequestSplitterTest, ClientFailingToSend)
+{
+  MockSplitClient client0;
+  MockSplitClient client1;
+  client1.fail_ = true;
+  ASSERT_TRUE(Splitter::Create(&splitter_, {&client0, &client1}, 2).IsOk());
+  ASSERT_NO_FATAL_FAILURE(MakeInput("INPUT", {2, 1}, "INT32"));
+  const int32_t data[2] = {0, 1};
+  ASSERT_TRUE(input_->AppendTyped(data, 2).IsOk());
+
+  ASSERT_TRUE(Send().IsOk());
+  client0.Complete(EmptyResult);
+  ASSERT_NE(joined_, nullptr);
+  EXPECT_EQ(joined_->RequestStatus().Message(), "unable to send");
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,392 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mock_infer_result.h"
+#include "server_pool.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+// What the servers of the pool do, shared by their connections.
+struct MockServers {
+  // How the requests to a server fail, by url.
+  enum class Failure { NONE, RESULT, SEND };
+  std::map<std::string, Failure> failures;
+  // The url and connection of each request, in order.
+  std::vector<std::pair<std::string, size_t>> requests;
+};
+
+// A connection completing its requests right away.
+class MockPoolClient {
+ public:
+  MockPoolClient(
+      const std::string& url, const size_t connection, MockServers* servers)
+      : url_(url), connection_(connection), servers_(servers)
+  {
+  }
+
+  tc::Error AsyncInfer(
+      tc::InferenceServerClient::OnCompleteFn callback,
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs)
+  {
+    const MockServers::Failure failure = servers_->failures[url_];
+    if (failure == MockServers::Failure::SEND) {
+      return tc::Error("unable to send to " + url_);
+    }
+    servers_->requests.emplace_back(url_, connection_);
+    callback(new tc::MockInferResult(
+        (failure == MockServers::Failure::RESULT)
+            ? tc::Error("failed on " + url_)
+            : tc::Error::Success));
+    return tc::Error::Success;
+  }
+
+ private:
+  const std::string url_;
+  const size_t connection_;
+  MockServers* servers_;
+};
+
+using Pool = tc::InferenceServerPool<MockPoolClient>;
+
+class ServerPoolTest : public ::testing::Test {
+ public:
+  void MakePool(const std::vector<std::string>& urls, const size_t connections)
+  {
+    std::map<std::string, size_t> next_connection;
+    ASSERT_TRUE(Pool::Create(
+                    &pool_, urls,
+                    [this, &next_connection](
+                        const std::string& url,
+                        std::unique_ptr<MockPoolClient>* client) {
+                      client->reset(new MockPoolClient(
+                          url, next_connection[url]++, &servers_));
+                      return tc::Error::Success;
+                    },
+                    connections)
+                    .IsOk());
+  }
+
+  // Send a request through the pool, ignoring its result.
+  tc::Error Send()
+  {
+    return pool_->AsyncInfer(
+        [](tc::InferResult* result) { delete result; },
+        tc::InferOptions("model"), {});
+  }
+
+  size_t RequestCount(const std::string& url)
+  {
+    size_t count = 0;
+    for (const auto& request : servers_.requests) {
+      count += (request.first == url) ? 1 : 0;
+    }
+    return count;
+  }
+
+  MockServers servers_;
+  std::unique_ptr<Pool> pool_;
+};
+
+// The requests held by the connections of a pool until the test completes
+// them, see MockHoldClient.
+class HeldRequests {
+ public:
+  void Add(
+      const std::string& url, tc::InferenceServerClient::OnCompleteFn callback)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      requests_.emplace_back(url, std::move(callback));
+    }
+    cv_.notify_all();
+  }
+
+  // Wait until 'count' requests have been sent, returns their urls.
+  std::vector<std::string> WaitFor(
+      const size_t count, const std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lk(mtx_);
+    cv_.wait_for(
+        lk, timeout, [this, count]() { return requests_.size() >= count; });
+    std::vector<std::string> urls;
+    for (const auto& request : requests_) {
+      urls.push_back(request.first);
+    }
+    return urls;
+  }
+
+  // Complete a request with a result of model version 'version'.
+  void Complete(const size_t index, const std::string& version)
+  {
+    tc::InferenceServerClient::OnCompleteFn callback;
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      callback = requests_[index].second;
+    }
+    tc::MockInferResult* result = new tc::MockInferResult();
+    result->SetOutput("VERSION", {1}, {static_cast<uint8_t>(version[0])});
+    callback(result);
+  }
+
+ private:
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<std::pair<std::string, tc::InferenceServerClient::OnCompleteFn>>
+      requests_;
+};
+
+// A connection holding its requests in a HeldRequests.
+class MockHoldClient {
+ public:
+  MockHoldClient(const std::string& url, HeldRequests* held)
+      : url_(url), held_(held)
+  {
+  }
+
+  tc::Error AsyncInfer(
+      tc::InferenceServerClient::OnCompleteFn callback,
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs)
+  {
+    held_->Add(url_, std::move(callback));
+    return tc::Error::Success;
+  }
+
+ private:
+  const std::string url_;
+  HeldRequests* held_;
+};
+
+using HoldPool = tc::InferenceServerPool<MockHoldClient>;
+
+class ServerPoolHedgingTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    ASSERT_TRUE(HoldPool::Create(
+                    &pool_, {"server0", "server1"},
+                    [this](
+                        const std::string& url,
+                        std::unique_ptr<MockHoldClient>* client) {
+                      client->reset(new MockHoldClient(url, &held_));
+                      return tc::Error::Success;
+                    })
+                    .IsOk());
+    pool_->EnableHedging(10000 /* delay_us */);
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(pool_->Outstanding(0), 0u);
+    EXPECT_EQ(pool_->Outstanding(1), 0u);
+  }
+
+  tc::Error Send()
+  {
+    return pool_->AsyncInfer(
+        [this](tc::InferResult* result) {
+          std::lock_guard<std::mutex> lk(mtx_);
+          result_.reset(result);
+          callback_count_++;
+        },
+        tc::InferOptions("model"), {});
+  }
+
+  // The first byte of the "VERSION" output of the result, 0 for none.
+  char ResultVersion()
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    const uint8_t* buf;
+    size_t byte_size;
+    if ((result_ == nullptr) ||
+        !result_->RawData("VERSION", &buf, &byte_size).IsOk()) {
+      return 0;
+    }
+    return static_cast<char>(*buf);
+  }
+
+  size_t CallbackCount()
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return callback_count_;
+  }
+
+  HeldRequests held_;
+  std::mutex mtx_;
+  std::unique_ptr<tc::InferResult> result_;
+  size_t callback_count_{0};
+  std::unique_ptr<HoldPool> pool_;
+};
+
+class ServerPoolEvictionTest
+    : public ServerPoolTest,
+      public ::testing::WithParamInterface<MockServers::Failure> {
+};
+
+TEST_F(ServerPoolTest, UseConnectionsInTurn)
+{
+  ASSERT_NO_FATAL_FAILURE(MakePool({"server0"}, 3));
+
+  for (size_t i = 0; i < 7; ++i) {
+    ASSERT_TRUE(Send().IsOk());
+  }
+
+  // The connection wraps around once every connection has been used
+  ASSERT_EQ(servers_.requests.size(), 7u);
+  for (size_t i = 0; i < 7; ++i) {
+    EXPECT_EQ(servers_.requests[i].first, "server0");
+    EXPECT_EQ(servers_.requests[i].second, i % 3);
+  }
+  EXPECT_EQ(pool_->Outstanding(0), 0u);
+}
+
+TEST_P(ServerPoolEvictionTest, EvictAndAdmitAgain)
+{
+  ASSERT_NO_FATAL_FAILURE(MakePool({"good", "bad"}, 1));
+  const uint64_t readmit_delay_us = 50000;
+  pool_->EnableEviction(2 /* failure_count */, readmit_delay_us);
+  servers_.failures["bad"] = GetParam();
+
+  // The bad server is evicted once two requests routed to it failed
+  for (size_t i = 0; (i < 1000) && !pool_->Evicted(1); ++i) {
+    Send();
+  }
+  ASSERT_TRUE(pool_->Evicted(1));
+  EXPECT_FALSE(pool_->Evicted(0));
+
+  // While evicted, it gets no request
+  servers_.requests.clear();
+  for (size_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(Send().IsOk());
+  }
+  EXPECT_EQ(RequestCount("good"), 20u);
+  EXPECT_EQ(RequestCount("bad"), 0u);
+
+  // Once the delay has passed, it is routed to again
+  servers_.failures["bad"] = MockServers::Failure::NONE;
+  std::this_thread::sleep_for(
+      std::chrono::microseconds(readmit_delay_us + 10000));
+  EXPECT_FALSE(pool_->Evicted(1));
+  for (size_t i = 0; (i < 1000) && (RequestCount("bad") == 0); ++i) {
+    ASSERT_TRUE(Send().IsOk());
+  }
+  EXPECT_GT(RequestCount("bad"), 0u);
+  EXPECT_FALSE(pool_->Evicted(1));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FailedResultsAndSends, ServerPoolEvictionTest,
+    ::testing::Values(
+        MockServers::Failure::RESULT, MockServers::Failure::SEND));
+
+TEST_F(ServerPoolTest, SingleFailureDoesNotEvict)
+{
+  ASSERT_NO_FATAL_FAILURE(MakePool({"server0", "server1"}, 1));
+  pool_->EnableEviction(2 /* failure_count */, 1000000 /* readmit_delay_us */);
+
+  // The failures of a server are only counted in a row
+  for (size_t i = 0; i < 100; ++i) {
+    servers_.failures["server1"] = (i % 2 == 0) ? MockServers::Failure::RESULT
+                                                : MockServers::Failure::NONE;
+    while (RequestCount("server1") == i) {
+      ASSERT_TRUE(Send().IsOk());
+    }
+  }
+  EXPECT_FALSE(pool_->Evicted(0));
+  EXPECT_FALSE(pool_->Evicted(1));
+}
+
+TEST_F(ServerPoolTest, SpreadRequestsWhenEveryServerIsEvicted)
+{
+  ASSERT_NO_FATAL_FAILURE(MakePool({"server0", "server1"}, 1));
+  pool_->EnableEviction(1 /* failure_count */, 1000000 /* readmit_delay_us */);
+  servers_.failures["server0"] = MockServers::Failure::RESULT;
+  servers_.failures["server1"] = MockServers::Failure::RESULT;
+
+  for (size_t i = 0;
+       (i < 1000) && !(pool_->Evicted(0) && pool_->Evicted(1)); ++i) {
+    ASSERT_TRUE(Send().IsOk());
+  }
+  ASSERT_TRUE(pool_->Evicted(0));
+  ASSERT_TRUE(pool_->Evicted(1));
+
+  servers_.requests.clear();
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(Send().IsOk());
+  }
+  EXPECT_GT(RequestCount("server0"), 0u);
+  EXPECT_GT(RequestCount("server1"), 0u);
+}
+
+TEST_F(ServerPoolHedgingTest, HedgeSlowRequest)
+{
+  ASSERT_TRUE(Send().IsOk());
+  const auto urls = held_.WaitFor(2, std::chrono::seconds(10));
+  ASSERT_EQ(urls.size(), 2u);
+  EXPECT_NE(urls[0], urls[1]);
+  EXPECT_EQ(pool_->HedgedCount(), 1u);
+
+  // The first response wins and the other one is dropped
+  held_.Complete(1, "2");
+  held_.Complete(0, "1");
+  EXPECT_EQ(CallbackCount(), 1u);
+  EXPECT_EQ(ResultVersion(), '2');
+}
+
+TEST_F(ServerPoolHedgingTest, DoNotHedgeFastRequest)
+{
+  ASSERT_TRUE(Send().IsOk());
+  ASSERT_EQ(held_.WaitFor(1, std::chrono::seconds(10)).size(), 1u);
+  held_.Complete(0, "1");
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(held_.WaitFor(1, std::chrono::seconds(0)).size(), 1u);
+  EXPECT_EQ(pool_->HedgedCount(), 0u);
+  EXPECT_EQ(CallbackCount(), 1u);
+  EXPECT_EQ(ResultVersion(), '1');
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
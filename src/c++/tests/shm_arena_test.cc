@@ -0,0 +1,166 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "shm_arena.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+std::string
+ArenaKey(const std::string& suffix)
+{
+  return "/shm_arena_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+// An arena of 2 slices of 64 bytes, both allocated.
+class SharedMemoryArenaReuseTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    ASSERT_TRUE(tc::SharedMemoryArena::Create(
+                    &arena_, "arena", ArenaKey("reuse"), 64, 2)
+                    .IsOk());
+    ASSERT_TRUE(arena_->Allocate(16, &first_).IsOk());
+    ASSERT_TRUE(arena_->Allocate(32, &second_).IsOk());
+    ASSERT_NE(first_.offset, second_.offset);
+  }
+
+  std::unique_ptr<tc::SharedMemoryArena> arena_;
+  tc::SharedMemoryArena::Slice first_;
+  tc::SharedMemoryArena::Slice second_;
+  tc::SharedMemoryArena::Slice slice_;
+};
+
+TEST(SharedMemoryArenaTest, RejectInvalidArguments)
+{
+  std::unique_ptr<tc::SharedMemoryArena> arena;
+  EXPECT_FALSE(
+      tc::SharedMemoryArena::Create(&arena, "arena", ArenaKey("a"), 0, 4)
+          .IsOk());
+  EXPECT_FALSE(
+      tc::SharedMemoryArena::Create(&arena, "arena", ArenaKey("b"), 64, 0)
+          .IsOk());
+  EXPECT_EQ(arena, nullptr);
+}
+
+TEST(SharedMemoryArenaTest, AlignSlices)
+{
+  std::unique_ptr<tc::SharedMemoryArena> arena;
+  ASSERT_TRUE(
+      tc::SharedMemoryArena::Create(&arena, "arena", ArenaKey("align"), 100, 4)
+          .IsOk());
+  EXPECT_EQ(arena->Name(), "arena");
+  EXPECT_EQ(arena->SliceByteSize(), 128u);
+  EXPECT_EQ(arena->SliceCount(), 4u);
+
+  std::vector<tc::SharedMemoryArena::Slice> slices(4);
+  std::set<size_t> offsets;
+  for (auto& slice : slices) {
+    ASSERT_TRUE(arena->Allocate(100, &slice).IsOk());
+    EXPECT_EQ(slice.byte_size, 100u);
+    EXPECT_EQ(slice.offset % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(slice.addr) % 64, 0u);
+    EXPECT_LT(slice.offset, 4u * 128);
+    offsets.insert(slice.offset);
+  }
+  // Every slice is a distinct part of the region
+  EXPECT_EQ(offsets.size(), 4u);
+  const uint8_t* base =
+      reinterpret_cast<const uint8_t*>(slices[0].addr) - slices[0].offset;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    EXPECT_EQ(
+        reinterpret_cast<const uint8_t*>(slices[i].addr),
+        base + slices[i].offset);
+    memset(slices[i].addr, static_cast<int>(i), 128);
+  }
+  for (size_t i = 0; i < slices.size(); ++i) {
+    const uint8_t* addr = reinterpret_cast<const uint8_t*>(slices[i].addr);
+    EXPECT_EQ(addr[0], i);
+    EXPECT_EQ(addr[127], i);
+  }
+
+  // No allocation is larger than a slice
+  for (auto& slice : slices) {
+    arena->Release(slice);
+  }
+  tc::SharedMemoryArena::Slice slice;
+  EXPECT_FALSE(arena->Allocate(129, &slice).IsOk());
+  EXPECT_TRUE(arena->Allocate(128, &slice).IsOk());
+}
+
+TEST_F(SharedMemoryArenaReuseTest, ExhaustedUntilSliceIsReleased)
+{
+  EXPECT_FALSE(arena_->Allocate(1, &slice_).IsOk());
+  arena_->Release(second_);
+  ASSERT_TRUE(arena_->Allocate(8, &slice_).IsOk());
+  EXPECT_EQ(slice_.offset, second_.offset);
+  EXPECT_EQ(slice_.addr, second_.addr);
+  EXPECT_EQ(slice_.byte_size, 8u);
+  EXPECT_FALSE(arena_->Allocate(1, &slice_).IsOk());
+}
+
+TEST_F(SharedMemoryArenaReuseTest, ReuseLastReleasedFirst)
+{
+  arena_->Release(second_);
+  arena_->Release(first_);
+  ASSERT_TRUE(arena_->Allocate(64, &slice_).IsOk());
+  EXPECT_EQ(slice_.offset, first_.offset);
+  ASSERT_TRUE(arena_->Allocate(64, &slice_).IsOk());
+  EXPECT_EQ(slice_.offset, second_.offset);
+}
+
+TEST_F(SharedMemoryArenaReuseTest, TakeEverySliceAgain)
+{
+  for (int round = 0; round < 3; ++round) {
+    arena_->Release(first_);
+    arena_->Release(second_);
+    ASSERT_TRUE(arena_->Allocate(64, &first_).IsOk());
+    ASSERT_TRUE(arena_->Allocate(64, &second_).IsOk());
+    EXPECT_NE(first_.offset, second_.offset);
+    EXPECT_FALSE(arena_->Allocate(1, &slice_).IsOk());
+  }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,288 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shm_ring.h"
+
+namespace tc = triton::client;
+
+namespace {
+
+constexpr size_t kRingByteSize = 256;
+
+std::string
+RingKey(const std::string& suffix)
+{
+  return "/shm_ring_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+// A UINT8 input holding 'byte_size' bytes of the value 'value'.
+class RawInput {
+ public:
+  RawInput(const size_t byte_size, const uint8_t value)
+      : data_(byte_size, value)
+  {
+    tc::InferInput* input;
+    EXPECT_TRUE(tc::InferInput::Create(
+                    &input, "INPUT", {static_cast<int64_t>(byte_size)}, "UINT8")
+                    .IsOk());
+    input_.reset(input);
+    EXPECT_TRUE(input_->AppendRaw(data_).IsOk());
+  }
+
+  tc::InferInput* Get() { return input_.get(); }
+
+  // The offset of the input in the ring once staged
+  size_t Offset() const
+  {
+    std::string name;
+    size_t byte_size = 0;
+    size_t offset = std::numeric_limits<size_t>::max();
+    EXPECT_TRUE(input_->IsSharedMemory());
+    EXPECT_TRUE(input_->SharedMemoryInfo(&name, &byte_size, &offset).IsOk());
+    EXPECT_EQ(name, "ring");
+    EXPECT_EQ(byte_size, data_.size());
+    return offset;
+  }
+
+ private:
+  const std::vector<uint8_t> data_;
+  std::unique_ptr<tc::InferInput> input_;
+};
+
+// A ring of kRingByteSize bytes, with a second mapping of its region to
+// read what was copied to it.
+class SharedMemoryRingTest : public ::testing::Test {
+ public:
+  void SetUp() override
+  {
+    const std::string key = RingKey(
+        ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    ASSERT_TRUE(
+        tc::SharedMemoryRing::Create(&ring_, "ring", key, kRingByteSize)
+            .IsOk());
+    ASSERT_TRUE(
+        tc::CreateSharedMemoryRegion(key, kRingByteSize, &shm_fd_).IsOk());
+    ASSERT_TRUE(
+        tc::MapSharedMemory(shm_fd_, 0, kRingByteSize, &view_addr_).IsOk());
+  }
+
+  void TearDown() override
+  {
+    if (view_addr_ != nullptr) {
+      tc::UnmapSharedMemory(view_addr_, kRingByteSize);
+    }
+    if (shm_fd_ != -1) {
+      tc::CloseSharedMemory(shm_fd_);
+    }
+  }
+
+  // Whether the 'byte_size' bytes at 'offset' of the region all have the
+  // value 'value'
+  bool Holds(const size_t offset, const size_t byte_size, const uint8_t value)
+  {
+    const uint8_t* bytes =
+        reinterpret_cast<const uint8_t*>(view_addr_) + offset;
+    for (size_t i = 0; i < byte_size; ++i) {
+      if (bytes[i] != value) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<tc::SharedMemoryRing> ring_;
+  int shm_fd_{-1};
+  void* view_addr_{nullptr};
+};
+
+TEST(SharedMemoryRingSizeTest, RejectInvalidSize)
+{
+  std::unique_ptr<tc::SharedMemoryRing> ring;
+  EXPECT_FALSE(
+      tc::SharedMemoryRing::Create(&ring, "ring", RingKey("a"), 0).IsOk());
+  EXPECT_FALSE(
+      tc::SharedMemoryRing::Create(&ring, "ring", RingKey("b"), 100).IsOk());
+  EXPECT_EQ(ring, nullptr);
+}
+
+TEST_F(SharedMemoryRingTest, StageNoInputs)
+{
+  tc::SharedMemoryRing::Lease lease;
+  ASSERT_TRUE(ring_->Stage({}, &lease).IsOk());
+  EXPECT_EQ(lease.start, lease.end);
+
+  // Giving back an empty lease leaves the whole ring free
+  ring_->Release(lease);
+  RawInput full(kRingByteSize, 1);
+  ASSERT_TRUE(ring_->Stage({full.Get()}, &lease).IsOk());
+  EXPECT_EQ(full.Offset(), 0u);
+  ring_->Release(lease);
+}
+
+TEST_F(SharedMemoryRingTest, StageInputWithoutData)
+{
+  tc::SharedMemoryRing::Lease lease;
+  RawInput input(0, 0);
+  ASSERT_TRUE(ring_->Stage({input.Get()}, &lease).IsOk());
+  EXPECT_EQ(lease.start, lease.end);
+  EXPECT_FALSE(input.Get()->IsSharedMemory());
+
+  ring_->Release(lease);
+  RawInput full(kRingByteSize, 1);
+  ASSERT_TRUE(ring_->Stage({full.Get()}, &lease).IsOk());
+  EXPECT_EQ(full.Offset(), 0u);
+  ring_->Release(lease);
+}
+
+TEST_F(SharedMemoryRingTest, RejectInputLargerThanRing)
+{
+  tc::SharedMemoryRing::Lease lease;
+  RawInput input(kRingByteSize + 1, 1);
+  EXPECT_FALSE(ring_->Stage({input.Get()}, &lease).IsOk());
+  EXPECT_FALSE(input.Get()->IsSharedMemory());
+}
+
+TEST_F(SharedMemoryRingTest, RejectAlignedInputsLargerThanRing)
+{
+  // 3 inputs of 65 bytes take 128 bytes each once aligned
+  tc::SharedMemoryRing::Lease lease;
+  RawInput a(65, 1);
+  RawInput b(65, 2);
+  EXPECT_FALSE(ring_->Stage({a.Get(), b.Get(), a.Get()}, &lease).IsOk());
+}
+
+TEST_F(SharedMemoryRingTest, CopyInputsToAlignedOffsets)
+{
+  RawInput a(10, 0xa);
+  RawInput b(70, 0xb);
+  RawInput c(64, 0xc);
+  tc::SharedMemoryRing::Lease lease;
+  ASSERT_TRUE(ring_->Stage({a.Get(), b.Get(), c.Get()}, &lease).IsOk());
+  EXPECT_EQ(lease.start, 0u);
+  EXPECT_EQ(lease.end, 256u);
+  EXPECT_EQ(a.Offset(), 0u);
+  EXPECT_EQ(b.Offset(), 64u);
+  EXPECT_EQ(c.Offset(), 192u);
+  EXPECT_TRUE(Holds(0, 10, 0xa));
+  EXPECT_TRUE(Holds(64, 70, 0xb));
+  EXPECT_TRUE(Holds(192, 64, 0xc));
+  ring_->Release(lease);
+}
+
+TEST_F(SharedMemoryRingTest, Wraparound)
+{
+  RawInput first(100, 1);
+  RawInput second(64, 2);
+  tc::SharedMemoryRing::Lease first_lease;
+  tc::SharedMemoryRing::Lease second_lease;
+  ASSERT_TRUE(ring_->Stage({first.Get()}, &first_lease).IsOk());
+  ASSERT_TRUE(ring_->Stage({second.Get()}, &second_lease).IsOk());
+  EXPECT_EQ(first.Offset(), 0u);
+  EXPECT_EQ(second.Offset(), 128u);
+  ring_->Release(first_lease);
+
+  // The 128 bytes needed do not fit in the 64 bytes left before the end of
+  // the region, so they are taken from its start and the end is skipped.
+  RawInput third(100, 3);
+  tc::SharedMemoryRing::Lease third_lease;
+  ASSERT_TRUE(ring_->Stage({third.Get()}, &third_lease).IsOk());
+  EXPECT_EQ(third.Offset(), 0u);
+  EXPECT_EQ(third_lease.start, 192u);
+  EXPECT_EQ(third_lease.end, 384u);
+  EXPECT_TRUE(Holds(0, 100, 3));
+  EXPECT_TRUE(Holds(128, 64, 2));
+
+  // A request fitting before the end of the region is not moved
+  ring_->Release(second_lease);
+  RawInput fourth(64, 4);
+  tc::SharedMemoryRing::Lease fourth_lease;
+  ASSERT_TRUE(ring_->Stage({fourth.Get()}, &fourth_lease).IsOk());
+  EXPECT_EQ(fourth.Offset(), 128u);
+  EXPECT_EQ(fourth_lease.start, 384u);
+  EXPECT_EQ(fourth_lease.end, 448u);
+  EXPECT_TRUE(Holds(128, 64, 4));
+
+  ring_->Release(third_lease);
+  ring_->Release(fourth_lease);
+}
+
+TEST_F(SharedMemoryRingTest, WaitWhileFull)
+{
+  RawInput first(128, 1);
+  RawInput second(128, 2);
+  tc::SharedMemoryRing::Lease first_lease;
+  tc::SharedMemoryRing::Lease second_lease;
+  ASSERT_TRUE(ring_->Stage({first.Get()}, &first_lease).IsOk());
+  ASSERT_TRUE(ring_->Stage({second.Get()}, &second_lease).IsOk());
+
+  RawInput third(64, 3);
+  tc::SharedMemoryRing::Lease third_lease;
+  std::atomic<bool> staged{false};
+  std::thread stage_thread([&]() {
+    EXPECT_TRUE(ring_->Stage({third.Get()}, &third_lease).IsOk());
+    staged = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(staged);
+
+  // The bytes of the newer request are not reused before the older ones
+  // are given back.
+  ring_->Release(second_lease);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(staged);
+
+  ring_->Release(first_lease);
+  stage_thread.join();
+  EXPECT_TRUE(staged);
+  EXPECT_EQ(third.Offset(), 0u);
+  EXPECT_EQ(third_lease.start, 256u);
+  EXPECT_EQ(third_lease.end, 320u);
+  ring_->Release(third_lease);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
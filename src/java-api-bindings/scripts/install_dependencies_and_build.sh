@@ -36,6 +36,9 @@ Installs Maven, Java JDK and builds Tritonserver Java bindings
 -j|--jar-install-path      Path to install the bindings .jar
 --javacpp-branch           Javacpp-presets git path, default https://github.com/bytedeco/javacpp-presets.git
 --javacpp-tag              Javacpp-presets branch tag, default "master"
+
+Also builds the zero-copy memory helpers of src/java-api-bindings over the
+bindings, installed as tritonserver-java-bindings-memory.jar
 "
 
 # Get all options:
@@ -93,6 +96,7 @@ for OPTS; do
         ;;
     esac
 done
+SOURCE_HOME=$(cd "$(dirname "$0")/.." && pwd)
 set -x
 
 # Install jdk and maven
@@ -119,6 +123,12 @@ ${MAVEN_PATH} clean install -f platform --projects ../tritonserver/platform -Dja
 # Copy over the jar to a specific location
 mkdir -p ${JAR_INSTALL_PATH}
 cp ${BUILD_HOME}/javacpp-presets/tritonserver/platform/target/tritonserver-platform-*shaded.jar ${JAR_INSTALL_PATH}/tritonserver-java-bindings.jar
+
+# Build the direct buffer inputs and pooled response allocator over the bindings
+${MAVEN_PATH} -f ${SOURCE_HOME}/pom.xml clean package \
+    -Dbindings.jar=${JAR_INSTALL_PATH}/tritonserver-java-bindings.jar
+cp ${SOURCE_HOME}/target/java-api-bindings-memory-*.jar ${JAR_INSTALL_PATH}/tritonserver-java-bindings-memory.jar
+rm -r ${SOURCE_HOME}/target
 rm -r ${BUILD_HOME}
 rm -r /root/.m2/repository
 
@@ -0,0 +1,116 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+package triton.bindings;
+
+import static org.bytedeco.tritonserver.global.tritonserver.*;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import org.bytedeco.javacpp.BytePointer;
+import org.bytedeco.javacpp.Pointer;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_Error;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_InferenceRequest;
+
+/**
+ * Passes memory that lives outside of the Java heap to the in-process server as it is. Direct buffers and device
+ * pointers are handed over by address, so no tensor data crosses the JNI boundary. The memory must stay valid until
+ * the server releases the request, or the response for outputs.
+ */
+public final class DirectMemory {
+
+    private DirectMemory() {
+    }
+
+    /**
+     * @param address   address of the memory, in host or device address space.
+     * @param byteSize  size of the memory in bytes.
+     * @return a pointer to the memory, which does not own it.
+     */
+    public static Pointer at(final long address, final long byteSize) {
+        return new Pointer() {
+            {
+                this.address = address;
+                this.limit = byteSize;
+                this.capacity = byteSize;
+            }
+        };
+    }
+
+    /**
+     * @param buffer a direct buffer.
+     * @return a pointer to the bytes between the position and the limit of the buffer, which does not own them.
+     */
+    public static Pointer of(ByteBuffer buffer) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("buffer must be direct to be passed without a copy");
+        }
+        return new Pointer(buffer);
+    }
+
+    /**
+     * Adds the data of an input of a request from a direct buffer, without copying it.
+     *
+     * @param request the inference request.
+     * @param name    name of the input.
+     * @param data    the little-endian tensor data between the position and the limit of a direct buffer.
+     * @return null on success, else the error of the server.
+     */
+    public static TRITONSERVER_Error appendInput(TRITONSERVER_InferenceRequest request, String name,
+        ByteBuffer data) {
+        return TRITONSERVER_InferenceRequestAppendInputData(request, name, of(data), data.remaining(),
+            TRITONSERVER_MEMORY_CPU, 0);
+    }
+
+    /**
+     * Adds the data of an input of a request from memory of a GPU, such as a CUDA device pointer.
+     *
+     * @param request  the inference request.
+     * @param name     name of the input.
+     * @param address  device address of the tensor data.
+     * @param byteSize size of the tensor data in bytes.
+     * @param deviceId the GPU the memory is on.
+     * @return null on success, else the error of the server.
+     */
+    public static TRITONSERVER_Error appendDeviceInput(TRITONSERVER_InferenceRequest request, String name,
+        long address, long byteSize, long deviceId) {
+        return TRITONSERVER_InferenceRequestAppendInputData(request, name, at(address, byteSize), byteSize,
+            TRITONSERVER_MEMORY_GPU, deviceId);
+    }
+
+    /**
+     * Views host memory, such as an output of a response, as a little-endian buffer without copying it. The view is
+     * only valid as long as the memory is.
+     *
+     * @param base     the host memory.
+     * @param byteSize size of the memory in bytes.
+     * @return a direct buffer over the memory.
+     */
+    public static ByteBuffer asByteBuffer(Pointer base, long byteSize) {
+        return new BytePointer(base).capacity(byteSize).asByteBuffer().order(ByteOrder.LITTLE_ENDIAN);
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+package triton.bindings;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.bytedeco.javacpp.Pointer;
+
+/**
+ * Keeps the output buffers released by the in-process server for the next responses, in power of two size classes,
+ * so that steady traffic does not allocate. The same scheme as the output buffers of the C API backend of
+ * perf_analyzer.
+ */
+class OutputBufferPool implements AutoCloseable {
+    /**
+     * The smallest size class, smaller outputs share its buffers.
+     */
+    private static final int MIN_CLASS_SHIFT = 6;
+
+    private final DeviceAllocator deviceAllocator;
+    private final long deviceId;
+    private final int maxFreePerClass;
+    private final List<ArrayDeque<Long>> freeBuffers = new ArrayList<>();
+
+    /**
+     * @param deviceAllocator allocator of the GPU memory, or null for host memory.
+     * @param deviceId        the GPU of the memory.
+     * @param maxFreePerClass the number of released buffers kept in each size class, buffers released beyond that are
+     *                        freed.
+     */
+    OutputBufferPool(DeviceAllocator deviceAllocator, long deviceId, int maxFreePerClass) {
+        this.deviceAllocator = deviceAllocator;
+        this.deviceId = deviceId;
+        this.maxFreePerClass = maxFreePerClass;
+    }
+
+    private static int sizeClass(long byteSize) {
+        int sizeClass = 0;
+        while ((1L << (sizeClass + MIN_CLASS_SHIFT)) < byteSize) {
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+
+    /**
+     * @param byteSize size of the buffer, must be non-zero.
+     * @return the address of a buffer of at least byteSize bytes, or 0 if it could not be allocated.
+     */
+    long acquire(long byteSize) {
+        int sizeClass = sizeClass(byteSize);
+        synchronized (this) {
+            if (sizeClass < this.freeBuffers.size() && !this.freeBuffers.get(sizeClass).isEmpty()) {
+                return this.freeBuffers.get(sizeClass).pop();
+            }
+        }
+        return this.allocate(1L << (sizeClass + MIN_CLASS_SHIFT));
+    }
+
+    /**
+     * @param address  address returned by acquire.
+     * @param byteSize size that the buffer was acquired with.
+     */
+    void release(long address, long byteSize) {
+        if (address == 0) {
+            return;
+        }
+        int sizeClass = sizeClass(byteSize);
+        synchronized (this) {
+            while (sizeClass >= this.freeBuffers.size()) {
+                this.freeBuffers.add(new ArrayDeque<>());
+            }
+            if (this.freeBuffers.get(sizeClass).size() < this.maxFreePerClass) {
+                this.freeBuffers.get(sizeClass).push(address);
+                return;
+            }
+        }
+        this.free(address);
+    }
+
+    private long allocate(long byteSize) {
+        if (this.deviceAllocator != null) {
+            return this.deviceAllocator.allocate(byteSize, this.deviceId);
+        }
+        Pointer buffer = Pointer.malloc(byteSize);
+        return buffer == null ? 0 : buffer.address();
+    }
+
+    private void free(long address) {
+        if (this.deviceAllocator != null) {
+            this.deviceAllocator.free(address, this.deviceId);
+        } else {
+            Pointer.free(DirectMemory.at(address, 0));
+        }
+    }
+
+    @Override
+    public synchronized void close() {
+        for (ArrayDeque<Long> sizeClass : this.freeBuffers) {
+            for (long address : sizeClass) {
+                this.free(address);
+            }
+            sizeClass.clear();
+        }
+    }
+}
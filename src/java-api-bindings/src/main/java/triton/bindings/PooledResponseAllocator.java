@@ -0,0 +1,157 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+package triton.bindings;
+
+import static org.bytedeco.tritonserver.global.tritonserver.*;
+
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.bytedeco.javacpp.IntPointer;
+import org.bytedeco.javacpp.LongPointer;
+import org.bytedeco.javacpp.Pointer;
+import org.bytedeco.javacpp.PointerPointer;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_Error;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_ResponseAllocator;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_ResponseAllocatorAllocFn_t;
+import org.bytedeco.tritonserver.tritonserver.TRITONSERVER_ResponseAllocatorReleaseFn_t;
+
+/**
+ * A response allocator of the in-process server that reuses the output buffers of earlier responses rather than
+ * allocating and freeing them for every response. Outputs go to host memory, or to the GPU the server prefers when a
+ * device allocator is given. Host outputs can be read in place with {@link DirectMemory#asByteBuffer}.
+ * <p>
+ * Pass {@link #get()} to TRITONSERVER_InferenceRequestSetResponseCallback, and close the allocator once the server
+ * has released all the responses.
+ */
+public class PooledResponseAllocator implements AutoCloseable {
+    /**
+     * Default number of released buffers kept in each size class.
+     */
+    public static final int DEFAULT_MAX_FREE_PER_CLASS = 256;
+
+    private final DeviceAllocator deviceAllocator;
+    private final int maxFreePerClass;
+    private final OutputBufferPool hostPool;
+    private final ConcurrentHashMap<Long, OutputBufferPool> devicePools = new ConcurrentHashMap<>();
+    private final TRITONSERVER_ResponseAllocator allocator = new TRITONSERVER_ResponseAllocator(null);
+    // The callbacks are referenced for as long as the server may call them.
+    private final AllocFn allocFn = new AllocFn(this);
+    private final ReleaseFn releaseFn = new ReleaseFn(this);
+
+    /**
+     * @param deviceAllocator allocator of the GPU memory, or null to keep all the outputs in host memory.
+     * @param maxFreePerClass the number of released buffers kept in each size class.
+     */
+    public PooledResponseAllocator(DeviceAllocator deviceAllocator, int maxFreePerClass) {
+        this.deviceAllocator = deviceAllocator;
+        this.maxFreePerClass = maxFreePerClass;
+        this.hostPool = new OutputBufferPool(null, 0, maxFreePerClass);
+        TRITONSERVER_Error err = TRITONSERVER_ResponseAllocatorNew(this.allocator, this.allocFn, this.releaseFn, null);
+        if (err != null) {
+            String message = TRITONSERVER_ErrorMessage(err).getString();
+            TRITONSERVER_ErrorDelete(err);
+            throw new IllegalStateException("failed to create the response allocator: " + message);
+        }
+    }
+
+    public PooledResponseAllocator() {
+        this(null, DEFAULT_MAX_FREE_PER_CLASS);
+    }
+
+    /**
+     * @return the allocator to set on the inference requests.
+     */
+    public TRITONSERVER_ResponseAllocator get() {
+        return this.allocator;
+    }
+
+    private OutputBufferPool devicePool(long deviceId) {
+        return this.devicePools.computeIfAbsent(deviceId,
+            id -> new OutputBufferPool(this.deviceAllocator, id, this.maxFreePerClass));
+    }
+
+    private static class AllocFn extends TRITONSERVER_ResponseAllocatorAllocFn_t {
+        private final PooledResponseAllocator owner;
+
+        AllocFn(PooledResponseAllocator owner) {
+            this.owner = owner;
+        }
+
+        @Override
+        public TRITONSERVER_Error call(TRITONSERVER_ResponseAllocator allocator, String tensorName, long byteSize,
+            int preferredMemoryType, long preferredMemoryTypeId, Pointer userp, PointerPointer buffer,
+            PointerPointer bufferUserp, IntPointer actualMemoryType, LongPointer actualMemoryTypeId) {
+            bufferUserp.put(0, (Pointer)null);
+            if (byteSize == 0) {
+                buffer.put(0, (Pointer)null);
+                actualMemoryType.put(0, TRITONSERVER_MEMORY_CPU);
+                actualMemoryTypeId.put(0, 0);
+                return null;
+            }
+            boolean onDevice = preferredMemoryType == TRITONSERVER_MEMORY_GPU && owner.deviceAllocator != null;
+            OutputBufferPool pool = onDevice ? owner.devicePool(preferredMemoryTypeId) : owner.hostPool;
+            long address = pool.acquire(byteSize);
+            if (address == 0) {
+                return TRITONSERVER_ErrorNew(TRITONSERVER_ERROR_INTERNAL,
+                    "failed to allocate " + byteSize + " bytes for output '" + tensorName + "'");
+            }
+            buffer.put(0, DirectMemory.at(address, byteSize));
+            actualMemoryType.put(0, onDevice ? TRITONSERVER_MEMORY_GPU : TRITONSERVER_MEMORY_CPU);
+            actualMemoryTypeId.put(0, onDevice ? preferredMemoryTypeId : 0);
+            return null;
+        }
+    }
+
+    private static class ReleaseFn extends TRITONSERVER_ResponseAllocatorReleaseFn_t {
+        private final PooledResponseAllocator owner;
+
+        ReleaseFn(PooledResponseAllocator owner) {
+            this.owner = owner;
+        }
+
+        @Override
+        public TRITONSERVER_Error call(TRITONSERVER_ResponseAllocator allocator, Pointer buffer, Pointer bufferUserp,
+            long byteSize, int memoryType, long memoryTypeId) {
+            if (buffer == null || buffer.isNull()) {
+                return null;
+            }
+            OutputBufferPool pool =
+                memoryType == TRITONSERVER_MEMORY_GPU ? owner.devicePool(memoryTypeId) : owner.hostPool;
+            pool.release(buffer.address(), byteSize);
+            return null;
+        }
+    }
+
+    @Override
+    public void close() {
+        TRITONSERVER_ResponseAllocatorDelete(this.allocator);
+        this.hostPool.close();
+        for (OutputBufferPool pool : this.devicePools.values()) {
+            pool.close();
+        }
+    }
+}
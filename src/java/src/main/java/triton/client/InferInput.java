@@ -72,6 +72,10 @@ public class InferInput {
      * Binary representation of tensor data of this input tensor if it's in binary format.
      */
     private byte[] binaryData;
+    /**
+     * Binary representation of tensor data of this input tensor if it was given as a buffer.
+     */
+    private ByteBuffer binaryBuffer;
     /**
      * Tensor data of this input tensor if it's in JSON format.
      */
@@ -300,7 +304,27 @@ public class InferInput {
         }
     }
 
+    /**
+     * Set tensor data of any type from its binary representation, which is sent as is without being copied. Fixed
+     * size types are little-endian, and BYTES elements are each prefixed by their 4-byte little-endian length. The
+     * bytes between the position and the limit of the buffer are used, and must not change until the inference
+     * requests using this input have completed. The buffer may be direct.
+     *
+     * @param data tensor data in binary format. It's size must match input shape given in constructor.
+     */
+    public void setData(ByteBuffer data) {
+        if (this.dataType != DataType.BYTES) {
+            Preconditions.checkArgument(data.remaining() == this.numElement * this.dataType.numByte,
+                "Data buffer's size [%s] not consist with shape [%s] of type %s.", data.remaining(), this.numElement,
+                this.dataType);
+        }
+        this.binaryBuffer = data.slice();
+        this.binaryData = null;
+        this.parameters.put(Parameters.KEY_BINARY_DATA_SIZE, this.binaryBuffer.remaining());
+    }
+
     private void updateBinaryDataSize() {
+        this.binaryBuffer = null;
         this.parameters.put(Parameters.KEY_BINARY_DATA_SIZE, this.binaryData.length);
     }
 
@@ -309,7 +333,7 @@ public class InferInput {
     }
 
     IOTensor getTensor() {
-        Preconditions.checkArgument(this.binaryData != null || this.data != null,
+        Preconditions.checkArgument(this.binaryData != null || this.binaryBuffer != null || this.data != null,
             ".setData method not call on InferInput %s", this.name);
         IOTensor tensor = new IOTensor();
         tensor.setName(this.name);
@@ -329,6 +353,19 @@ public class InferInput {
         return binaryData;
     }
 
+    /**
+     * Get binary representation of tensor data of this inference input, whether it was given as an array or as a
+     * buffer, without copying it.
+     *
+     * @return null if this inference input is in JSON format.
+     */
+    ByteBuffer getBinaryBuffer() {
+        if (this.binaryBuffer != null) {
+            return this.binaryBuffer.duplicate();
+        }
+        return this.binaryData == null ? null : ByteBuffer.wrap(this.binaryData);
+    }
+
     Object[] getJSONData() {
         return this.data;
     }
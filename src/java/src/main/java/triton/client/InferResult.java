@@ -269,6 +269,22 @@ public class InferResult {
         return (double[])getOutputImpl(out, double.class, ByteBuffer::getDouble);
     }
 
+    /**
+     * Get the binary representation of the tensor named as by parameter output, as a read-only little-endian view of
+     * the response rather than a copy. BYTES elements are each prefixed by their 4-byte little-endian length.
+     *
+     * @param output name of output tensor.
+     * @return null if output not found or not in binary format.
+     */
+    public ByteBuffer getOutputAsBuffer(String output) {
+        Index idx = this.nameToBinaryIdx.get(output);
+        if (idx == null || this.binaryData == null) {
+            return null;
+        }
+        ByteBuffer buf = ByteBuffer.wrap(this.binaryData, idx.start, idx.length).slice().asReadOnlyBuffer();
+        return buf.order(ByteOrder.LITTLE_ENDIAN);
+    }
+
     private <T> Object getOutputImpl(IOTensor out, Class<T> clazz, Function<ByteBuffer, T> getter) {
         Index idx = this.nameToBinaryIdx.get(out.getName());
         if (idx != null) { // Output in binary format.
@@ -31,9 +31,9 @@ package triton.client;
  * @date 2021/4/13
  */
 
-import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.net.URLEncoder;
+import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Arrays;
@@ -61,7 +61,6 @@ import org.apache.http.impl.nio.client.HttpAsyncClients;
 import org.apache.http.impl.nio.conn.PoolingNHttpClientConnectionManager;
 import org.apache.http.impl.nio.reactor.DefaultConnectingIOReactor;
 import org.apache.http.impl.nio.reactor.IOReactorConfig;
-import org.apache.http.nio.entity.NByteArrayEntity;
 import org.apache.http.nio.reactor.ConnectingIOReactor;
 
 /**
@@ -292,14 +291,15 @@ public class InferenceServerClient implements AutoCloseable {
         throws Exception {
         // Create post body in binary format:
         //    <json body><optional_binary_tensor>...
-        ByteArrayOutputStream bodyBytes = new ByteArrayOutputStream();
+        // The parts are sent one after the other rather than concatenated.
+        List<ByteBuffer> bodyParts = new ArrayList<>(arg.inputs.size() + 1);
         byte[] jsonBytes = Util.toJson(inferReq).getBytes(StandardCharsets.UTF_8);
         boolean hasBinaryInput = false;
-        bodyBytes.write(jsonBytes);
+        bodyParts.add(ByteBuffer.wrap(jsonBytes));
         for (InferInput input : arg.inputs) {
-            byte[] binInput = input.getBinaryData();
+            ByteBuffer binInput = input.getBinaryBuffer();
             if (binInput != null) {
-                bodyBytes.write(binInput);
+                bodyParts.add(binInput);
                 hasBinaryInput = true;
             }
         }
@@ -320,7 +320,7 @@ public class InferenceServerClient implements AutoCloseable {
         // Crete HttpPost, uri, body and headers.
         HttpPost post = new HttpPost(ub.build());
         arg.headers.forEach(post::setHeader);
-        post.setEntity(new NByteArrayEntity(bodyBytes.toByteArray()));
+        post.setEntity(new NByteBufferListEntity(bodyParts));
         return post;
     }
 
@@ -0,0 +1,173 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+package triton.client;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.util.List;
+
+import org.apache.http.entity.AbstractHttpEntity;
+import org.apache.http.entity.ContentType;
+import org.apache.http.nio.ContentEncoder;
+import org.apache.http.nio.IOControl;
+import org.apache.http.nio.entity.HttpAsyncContentProducer;
+
+/**
+ * A request entity sending a list of buffers one after the other, so that the JSON header and the binary tensors of
+ * an inference request are written to the connection where they are rather than concatenated first. The buffers may
+ * be direct, and are not modified.
+ */
+class NByteBufferListEntity extends AbstractHttpEntity implements HttpAsyncContentProducer {
+    /**
+     * Size of the chunks direct buffers are copied through by writeTo.
+     */
+    private static final int COPY_CHUNK_SIZE = 64 * 1024;
+
+    private final ByteBuffer[] buffers;
+    private final long contentLength;
+    /**
+     * Views of buffers being sent, reset by close() so that the request can be retried.
+     */
+    private ByteBuffer[] pending;
+    private int current;
+
+    NByteBufferListEntity(List<ByteBuffer> buffers) {
+        this.buffers = buffers.toArray(new ByteBuffer[0]);
+        long length = 0;
+        for (ByteBuffer buf : this.buffers) {
+            length += buf.remaining();
+        }
+        this.contentLength = length;
+        this.setContentType(ContentType.DEFAULT_BINARY.toString());
+        this.reset();
+    }
+
+    private void reset() {
+        this.pending = new ByteBuffer[this.buffers.length];
+        for (int i = 0; i < this.buffers.length; i++) {
+            this.pending[i] = this.buffers[i].duplicate();
+        }
+        this.current = 0;
+    }
+
+    @Override
+    public void produceContent(ContentEncoder encoder, IOControl ioctrl) throws IOException {
+        while (this.current < this.pending.length) {
+            ByteBuffer buf = this.pending[this.current];
+            if (buf.hasRemaining()) {
+                encoder.write(buf);
+                if (buf.hasRemaining()) {
+                    // The channel is full, the rest is written when it is writable again.
+                    return;
+                }
+            }
+            this.current++;
+        }
+        encoder.complete();
+    }
+
+    @Override
+    public void close() {
+        this.reset();
+    }
+
+    @Override
+    public boolean isRepeatable() {
+        return true;
+    }
+
+    @Override
+    public long getContentLength() {
+        return this.contentLength;
+    }
+
+    @Override
+    public boolean isStreaming() {
+        return false;
+    }
+
+    @Override
+    public InputStream getContent() {
+        final ByteBuffer[] views = new ByteBuffer[this.buffers.length];
+        for (int i = 0; i < this.buffers.length; i++) {
+            views[i] = this.buffers[i].duplicate();
+        }
+        return new InputStream() {
+            private int index = 0;
+
+            private ByteBuffer next() {
+                while (index < views.length && !views[index].hasRemaining()) {
+                    index++;
+                }
+                return index < views.length ? views[index] : null;
+            }
+
+            @Override
+            public int read() {
+                ByteBuffer buf = next();
+                return buf == null ? -1 : buf.get() & 0xff;
+            }
+
+            @Override
+            public int read(byte[] b, int off, int len) {
+                if (len == 0) {
+                    return 0;
+                }
+                ByteBuffer buf = next();
+                if (buf == null) {
+                    return -1;
+                }
+                int n = Math.min(len, buf.remaining());
+                buf.get(b, off, n);
+                return n;
+            }
+        };
+    }
+
+    @Override
+    public void writeTo(OutputStream out) throws IOException {
+        byte[] chunk = null;
+        for (ByteBuffer source : this.buffers) {
+            ByteBuffer buf = source.duplicate();
+            if (buf.hasArray()) {
+                out.write(buf.array(), buf.arrayOffset() + buf.position(), buf.remaining());
+                continue;
+            }
+            if (chunk == null) {
+                chunk = new byte[COPY_CHUNK_SIZE];
+            }
+            while (buf.hasRemaining()) {
+                int n = Math.min(chunk.length, buf.remaining());
+                buf.get(chunk, 0, n);
+                out.write(chunk, 0, n);
+            }
+        }
+        out.flush();
+    }
+}
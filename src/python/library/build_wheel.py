@@ -165,6 +165,12 @@ if __name__ == '__main__':
             'tritonclient/utils/libcshm.so',
             os.path.join(FLAGS.whl_dir,
                          'tritonclient/utils/shared_memory/libcshm.so'))
+        cpdir('tritonclient/utils/serialization',
+              os.path.join(FLAGS.whl_dir, 'tritonclient/utils/serialization'))
+        shutil.copyfile(
+            'tritonclient/utils/libcserialize.so',
+            os.path.join(FLAGS.whl_dir,
+                         'tritonclient/utils/serialization/libcserialize.so'))
         if (os.path.exists('tritonclient/utils/libccudashm.so') and
                 os.path.exists(
                     'tritonclient/utils/cuda_shared_memory/__init__.py')):
@@ -2194,19 +2194,23 @@ class InferResult:
                                 start_index = self._output_name_to_buffer_map[
                                     name]
                                 end_index = start_index + this_data_size
+                                # A view rather than a copy of the output in
+                                # the response body
+                                output_buffer = memoryview(
+                                    self._buffer)[start_index:end_index]
                                 if datatype == 'BYTES':
                                     # String results contain a 4-byte string length
                                     # followed by the actual string characters. Hence,
                                     # need to decode the raw bytes to convert into
                                     # array elements.
                                     np_array = deserialize_bytes_tensor(
-                                        self._buffer[start_index:end_index])
+                                        output_buffer)
                                 elif datatype == "BF16":
                                     np_array = deserialize_bf16_tensor(
-                                        self._buffer[start_index:end_index])
+                                        output_buffer)
                                 else:
                                     np_array = np.frombuffer(
-                                        self._buffer[start_index:end_index],
+                                        output_buffer,
                                         dtype=triton_to_np_dtype(datatype))
                             else:
                                 np_array = np.empty(0)
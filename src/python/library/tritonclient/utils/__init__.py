@@ -27,6 +27,23 @@
 import numpy as np
 import struct
 
+_native_serialization = None
+
+
+def _serialization():
+    """
+    Returns the C++ implementation of the BYTES tensor serialization, or
+    None if the library is not part of this package, as on Windows.
+    """
+    global _native_serialization
+    if _native_serialization is None:
+        try:
+            import tritonclient.utils.serialization as serialization
+            _native_serialization = serialization
+        except (ImportError, OSError):
+            _native_serialization = False
+    return _native_serialization or None
+
 
 def raise_error(msg):
     """
@@ -220,6 +237,20 @@ def serialize_byte_tensor(input_tensor):
                                                np.bytes_):
         raise_error("cannot serialize bytes tensor: invalid datatype")
 
+    serialization = _serialization()
+    if serialization is not None:
+        if input_tensor.dtype == np.object_:
+            elements = [
+                obj if type(obj) == bytes else str(obj).encode('utf-8')
+                for obj in input_tensor.ravel(order='C').tolist()
+            ]
+            flattened = serialization.serialize_elements(elements)
+        else:
+            flattened = serialization.serialize_fixed_elements(input_tensor)
+        if flattened is None:
+            raise_error("cannot serialize bytes tensor: element too large")
+        return np.asarray(flattened, dtype=np.object_)
+
     flattened_ls = []
     # 'C' order is row-major.
     for obj in np.nditer(input_tensor, flags=["refs_ok"], order='C'):
@@ -261,6 +292,13 @@ def deserialize_bytes_tensor(encoded_tensor):
         deserialized bytes in row-major form.
    
     """
+    serialization = _serialization()
+    if serialization is not None:
+        strs = serialization.deserialize_elements(encoded_tensor)
+        if strs is None:
+            raise_error("cannot deserialize bytes tensor: invalid encoding")
+        return (np.array(strs, dtype=np.object_))
+
     strs = list()
     offset = 0
     val_buf = encoded_tensor
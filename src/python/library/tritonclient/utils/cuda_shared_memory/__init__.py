@@ -61,6 +61,26 @@ _ccudashm_shared_memory_region_set.restype = c_int
 _ccudashm_shared_memory_region_set.argtypes = [
     c_void_p, c_uint64, c_uint64, c_void_p
 ]
+_ccudashm_shared_memory_region_set_batch = _ccudashm.CudaSharedMemoryRegionSetBatch
+_ccudashm_shared_memory_region_set_batch.restype = c_int
+_ccudashm_shared_memory_region_set_batch.argtypes = [
+    c_void_p, c_uint64,
+    POINTER(c_uint64),
+    POINTER(c_uint64),
+    POINTER(c_void_p)
+]
+_ccudashm_shared_memory_region_get = _ccudashm.CudaSharedMemoryRegionGet
+_ccudashm_shared_memory_region_get.restype = c_int
+_ccudashm_shared_memory_region_get.argtypes = [
+    c_void_p, c_uint64, c_uint64, c_void_p
+]
+_ccudashm_get_device_pointer = _ccudashm.CudaSharedMemoryGetDevicePointer
+_ccudashm_get_device_pointer.restype = c_int
+_ccudashm_get_device_pointer.argtypes = [
+    c_void_p, POINTER(c_void_p),
+    POINTER(c_uint64),
+    POINTER(c_int)
+]
 _cshm_get_shared_memory_handle_info = _ccudashm.GetCudaSharedMemoryHandleInfo
 _cshm_get_shared_memory_handle_info.restype = c_int
 _cshm_get_shared_memory_handle_info.argtypes = [
@@ -151,6 +171,8 @@ def get_raw_handle(cuda_shm_handle):
 
 def set_shared_memory_region(cuda_shm_handle, input_values):
     """Copy the contents of the numpy array into the cuda shared memory region.
+    The arrays are staged in a pinned host buffer of the region and copied
+    to the device together, waiting once for all of the copies.
 
     Parameters
     ----------
@@ -173,21 +195,32 @@ def set_shared_memory_region(cuda_shm_handle, input_values):
                 "input_values must be specified as a list/tuple of numpy arrays"
             )
 
+    # Keep the flattened values alive until the copies are done
+    values = []
+    offsets = []
+    byte_sizes = []
+    data = []
     offset_current = 0
     for input_value in input_values:
         input_value = np.ascontiguousarray(input_value).flatten()
         if input_value.dtype == np.object_:
             input_value = input_value.item()
             byte_size = np.dtype(np.byte).itemsize * len(input_value)
-            _raise_if_error(
-                c_int(_ccudashm_shared_memory_region_set(cuda_shm_handle, c_uint64(offset_current), \
-                    c_uint64(byte_size), cast(input_value, c_void_p))))
+            data.append(cast(input_value, c_void_p))
         else:
             byte_size = input_value.size * input_value.itemsize
-            _raise_if_error(
-                c_int(_ccudashm_shared_memory_region_set(cuda_shm_handle, c_uint64(offset_current), \
-                    c_uint64(byte_size), input_value.ctypes.data_as(c_void_p))))
+            data.append(input_value.ctypes.data_as(c_void_p))
+        values.append(input_value)
+        offsets.append(offset_current)
+        byte_sizes.append(byte_size)
         offset_current += byte_size
+
+    count = len(values)
+    _raise_if_error(
+        c_int(
+            _ccudashm_shared_memory_region_set_batch(
+                cuda_shm_handle, c_uint64(count), (c_uint64 * count)(*offsets),
+                (c_uint64 * count)(*byte_sizes), (c_void_p * count)(*data))))
     return
 
 
@@ -210,6 +243,24 @@ def get_contents_as_numpy(cuda_shm_handle, datatype, shape):
         The numpy array generated using contents from the specified shared
         memory region.
     """
+    if (datatype != np.object_) and (datatype != np.bytes_):
+        # Only copy the bytes of the array, straight into it
+        _, region_byte_size, _ = get_device_pointer(cuda_shm_handle)
+        requested_byte_size = int(np.prod(shape)) * np.dtype(datatype).itemsize
+        if region_byte_size < requested_byte_size:
+            _raise_error(
+                "The size of the shared memory region is unsufficient to provide numpy array with requested size"
+            )
+        result = np.empty(shape, dtype=datatype)
+        if requested_byte_size != 0:
+            _raise_if_error(
+                c_int(
+                    _ccudashm_shared_memory_region_get(
+                        cuda_shm_handle, c_uint64(0),
+                        c_uint64(requested_byte_size),
+                        result.ctypes.data_as(c_void_p))))
+        return result
+
     offset = c_uint64()
     byte_size = c_uint64()
     shm_addr = c_char_p()
@@ -262,6 +313,87 @@ def get_contents_as_numpy(cuda_shm_handle, datatype, shape):
         return result
 
 
+def get_device_pointer(cuda_shm_handle):
+    """Returns the device address of the cuda shared memory region, so that
+    GPU libraries can read and write it without copies through the host.
+
+    Parameters
+    ----------
+    cuda_shm_handle : c_void_p
+        The handle for the cuda shared memory region.
+
+    Returns
+    -------
+    tuple
+        The device address of the region as an int, its size in bytes and
+        the GPU device ID it is allocated on.
+    """
+    device_addr = c_void_p()
+    byte_size = c_uint64()
+    device_id = c_int()
+    _raise_if_error(
+        c_int(
+            _ccudashm_get_device_pointer(cuda_shm_handle, byref(device_addr),
+                                         byref(byte_size),
+                                         byref(device_id))))
+    return device_addr.value, byte_size.value, device_id.value
+
+
+class _CudaArray(object):
+    """A view of a cuda shared memory region exposing the CUDA Array
+    Interface, which CuPy, Numba and PyTorch can wrap without copies."""
+
+    def __init__(self, cuda_shm_handle, device_addr, datatype, shape):
+        # Keep the handle referenced as long as the view
+        self._cuda_shm_handle = cuda_shm_handle
+        self.__cuda_array_interface__ = {
+            "shape": tuple(shape),
+            "typestr": np.dtype(datatype).str,
+            "data": (device_addr, False),
+            "version": 3,
+            "strides": None,
+            "stream": None
+        }
+
+
+def as_cuda_array(cuda_shm_handle, datatype, shape, offset=0):
+    """Returns a view of the contents of the cuda shared memory region on the
+    device. The view implements the CUDA Array Interface, so that for example
+    torch.as_tensor() or cupy.asarray() can use the region in place.
+
+    Parameters
+    ----------
+    cuda_shm_handle : c_void_p
+        The handle for the cuda shared memory region.
+    datatype : np.dtype
+        The datatype of the array. Must have a fixed size.
+    shape : list
+        The list of int describing the shape of the array.
+    offset : int
+        The offset, in bytes, of the array in the region. The default value
+        is 0.
+
+    Returns
+    -------
+    object
+        An object with the __cuda_array_interface__ attribute.
+
+    Raises
+    ------
+    CudaSharedMemoryException
+        If the array does not fit in the region.
+    """
+    if (datatype == np.object_) or (datatype == np.bytes_):
+        _raise_error("as_cuda_array only supports fixed-size datatypes")
+    device_addr, byte_size, _ = get_device_pointer(cuda_shm_handle)
+    requested_byte_size = int(np.prod(shape)) * np.dtype(datatype).itemsize
+    if byte_size < offset + requested_byte_size:
+        _raise_error(
+            "The size of the shared memory region is unsufficient to provide an array with requested size"
+        )
+    return _CudaArray(cuda_shm_handle, device_addr + offset, datatype, shape)
+
+
 def allocated_shared_memory_regions():
     """Return all cuda shared memory regions that were allocated but not freed.
 
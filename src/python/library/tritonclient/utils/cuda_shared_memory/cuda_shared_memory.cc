@@ -54,9 +54,32 @@ CudaSharedMemoryHandleCreate(
   handle->offset_ = 0;
   handle->shm_key_ = "";
   handle->shm_fd_ = 0;
+  handle->stream_ = nullptr;
+  handle->staging_addr_ = nullptr;
+  handle->staging_byte_size_ = 0;
   return reinterpret_cast<void*>(handle);
 }
 
+// Makes the staging buffer of the handle hold at least 'byte_size' bytes.
+// Must be called with the device of the handle set.
+cudaError_t
+CudaSharedMemoryReserveStaging(SharedMemoryHandle* handle, size_t byte_size)
+{
+  if (handle->staging_byte_size_ >= byte_size) {
+    return cudaSuccess;
+  }
+  if (handle->staging_addr_ != nullptr) {
+    cudaFreeHost(handle->staging_addr_);
+    handle->staging_addr_ = nullptr;
+    handle->staging_byte_size_ = 0;
+  }
+  cudaError_t err = cudaHostAlloc(&handle->staging_addr_, byte_size, 0);
+  if (err == cudaSuccess) {
+    handle->staging_byte_size_ = byte_size;
+  }
+  return err;
+}
+
 }  // namespace
 
 int
@@ -84,10 +107,20 @@ CudaSharedMemoryRegionCreate(
     return -2;
   }
 
+  // The copies of the region do not wait for the work of other streams
+  cudaStream_t stream;
+  err = cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+  if (err != cudaSuccess) {
+    cudaFree(base_addr);
+    cudaSetDevice(previous_device);
+    return -2;
+  }
+
   // create a handle for the shared memory region
   *cuda_shm_handle = CudaSharedMemoryHandleCreate(
       std::string(triton_shm_name), cuda_handle, base_addr, byte_size,
       device_id);
+  reinterpret_cast<SharedMemoryHandle*>(*cuda_shm_handle)->stream_ = stream;
 
   // Set device to previous GPU
   cudaSetDevice(previous_device);
@@ -130,26 +163,52 @@ int
 CudaSharedMemoryRegionSet(
     void* cuda_shm_handle, size_t offset, size_t byte_size, const void* data)
 {
+  return CudaSharedMemoryRegionSetBatch(
+      cuda_shm_handle, 1, &offset, &byte_size, &data);
+}
+
+int
+CudaSharedMemoryRegionSetBatch(
+    void* cuda_shm_handle, size_t count, const size_t* offsets,
+    const size_t* byte_sizes, const void** data)
+{
+  SharedMemoryHandle* handle =
+      reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle);
+
   // remember previous device and set to new device
   int previous_device;
   cudaGetDevice(&previous_device);
-  cudaError_t err = cudaSetDevice(
-      reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle)->device_id_);
+  cudaError_t err = cudaSetDevice(handle->device_id_);
   if (err != cudaSuccess) {
     cudaSetDevice(previous_device);
     return -1;
   }
 
-  // Copy data into cuda shared memory
-  void* base_addr =
-      reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle)->base_addr_;
-  err = cudaMemcpy(
-      reinterpret_cast<uint8_t*>(base_addr) + offset, data, byte_size,
-      cudaMemcpyHostToDevice);
+  // Gather the data in the pinned staging buffer, so that the copies to the
+  // device are asynchronous, and wait for all of them at once.
+  size_t total_byte_size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    total_byte_size += byte_sizes[i];
+  }
+  err = CudaSharedMemoryReserveStaging(handle, total_byte_size);
   if (err != cudaSuccess) {
     cudaSetDevice(previous_device);
     return -3;
   }
+  uint8_t* staging_addr = reinterpret_cast<uint8_t*>(handle->staging_addr_);
+  for (size_t i = 0; (i < count) && (err == cudaSuccess); ++i) {
+    std::memcpy(staging_addr, data[i], byte_sizes[i]);
+    err = cudaMemcpyAsync(
+        reinterpret_cast<uint8_t*>(handle->base_addr_) + offsets[i],
+        staging_addr, byte_sizes[i], cudaMemcpyHostToDevice, handle->stream_);
+    staging_addr += byte_sizes[i];
+  }
+  // The staging buffer must not be reused before the copies complete
+  cudaError_t sync_err = cudaStreamSynchronize(handle->stream_);
+  if ((err != cudaSuccess) || (sync_err != cudaSuccess)) {
+    cudaSetDevice(previous_device);
+    return -3;
+  }
 
   // Set device to previous GPU
   cudaSetDevice(previous_device);
@@ -157,6 +216,58 @@ CudaSharedMemoryRegionSet(
   return 0;
 }
 
+int
+CudaSharedMemoryRegionGet(
+    void* cuda_shm_handle, size_t offset, size_t byte_size, void* data)
+{
+  SharedMemoryHandle* handle =
+      reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle);
+
+  // remember previous device and set to new device
+  int previous_device;
+  cudaGetDevice(&previous_device);
+  cudaError_t err = cudaSetDevice(handle->device_id_);
+  if (err != cudaSuccess) {
+    cudaSetDevice(previous_device);
+    return -1;
+  }
+
+  // Only copy the bytes asked for, through the pinned staging buffer
+  err = CudaSharedMemoryReserveStaging(handle, byte_size);
+  if (err == cudaSuccess) {
+    err = cudaMemcpyAsync(
+        handle->staging_addr_,
+        reinterpret_cast<uint8_t*>(handle->base_addr_) + offset, byte_size,
+        cudaMemcpyDeviceToHost, handle->stream_);
+  }
+  if (err == cudaSuccess) {
+    err = cudaStreamSynchronize(handle->stream_);
+  }
+  if (err != cudaSuccess) {
+    cudaSetDevice(previous_device);
+    return -5;
+  }
+  std::memcpy(data, handle->staging_addr_, byte_size);
+
+  // Set device to previous GPU
+  cudaSetDevice(previous_device);
+
+  return 0;
+}
+
+int
+CudaSharedMemoryGetDevicePointer(
+    void* cuda_shm_handle, void** device_addr, size_t* byte_size,
+    int* device_id)
+{
+  SharedMemoryHandle* handle =
+      reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle);
+  *device_addr = handle->base_addr_;
+  *byte_size = handle->byte_size_;
+  *device_id = handle->device_id_;
+  return 0;
+}
+
 int
 GetCudaSharedMemoryHandleInfo(
     void* shm_handle, char** shm_addr, size_t* offset, size_t* byte_size)
@@ -203,7 +314,16 @@ CudaSharedMemoryRegionDestroy(void* cuda_shm_handle)
   SharedMemoryHandle* shm_hand =
       reinterpret_cast<SharedMemoryHandle*>(cuda_shm_handle);
 
-  // Free GPU device memory
+  // Free the staging buffer and the stream, then GPU device memory
+  if (shm_hand->staging_addr_ != nullptr) {
+    cudaFreeHost(shm_hand->staging_addr_);
+    shm_hand->staging_addr_ = nullptr;
+    shm_hand->staging_byte_size_ = 0;
+  }
+  if (shm_hand->stream_ != nullptr) {
+    cudaStreamDestroy(shm_hand->stream_);
+    shm_hand->stream_ = nullptr;
+  }
   err = cudaFree(shm_hand->base_addr_);
   if (err != cudaSuccess) {
     cudaSetDevice(previous_device);
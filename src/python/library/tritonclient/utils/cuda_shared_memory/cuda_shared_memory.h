@@ -40,6 +40,14 @@ int CudaSharedMemoryGetRawHandle(
     void* cuda_shm_handle, char** serialized_raw_handle);
 int CudaSharedMemoryRegionSet(
     void* cuda_shm_handle, size_t offset, size_t byte_size, const void* data);
+int CudaSharedMemoryRegionSetBatch(
+    void* cuda_shm_handle, size_t count, const size_t* offsets,
+    const size_t* byte_sizes, const void** data);
+int CudaSharedMemoryRegionGet(
+    void* cuda_shm_handle, size_t offset, size_t byte_size, void* data);
+int CudaSharedMemoryGetDevicePointer(
+    void* cuda_shm_handle, void** device_addr, size_t* byte_size,
+    int* device_id);
 int GetCudaSharedMemoryHandleInfo(
     void* shm_handle, char** shm_addr, size_t* offset, size_t* byte_size);
 int CudaSharedMemoryReleaseBuffer(char* ptr);
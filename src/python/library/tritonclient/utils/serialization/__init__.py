@@ -0,0 +1,156 @@
+# Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#  * Neither the name of NVIDIA CORPORATION nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import os
+from ctypes import *
+import numpy as np
+import pkg_resources
+
+_cserialize_lib = "cserialize" if os.name == 'nt' else 'libcserialize.so'
+_cserialize_path = pkg_resources.resource_filename(
+    'tritonclient.utils.serialization', _cserialize_lib)
+_cserialize = cdll.LoadLibrary(_cserialize_path)
+
+_cserialize_bytes_tensor_serialize = _cserialize.BytesTensorSerialize
+_cserialize_bytes_tensor_serialize.restype = c_int
+_cserialize_bytes_tensor_serialize.argtypes = [
+    POINTER(c_char_p), c_void_p, c_size_t, c_void_p, c_size_t
+]
+_cserialize_fixed_bytes_tensor_serialized_size = _cserialize.FixedBytesTensorSerializedSize
+_cserialize_fixed_bytes_tensor_serialized_size.restype = c_int
+_cserialize_fixed_bytes_tensor_serialized_size.argtypes = [
+    c_void_p, c_size_t, c_size_t, POINTER(c_uint64)
+]
+_cserialize_fixed_bytes_tensor_serialize = _cserialize.FixedBytesTensorSerialize
+_cserialize_fixed_bytes_tensor_serialize.restype = c_int
+_cserialize_fixed_bytes_tensor_serialize.argtypes = [
+    c_void_p, c_size_t, c_size_t, c_void_p, c_size_t
+]
+_cserialize_bytes_tensor_element_count = _cserialize.BytesTensorElementCount
+_cserialize_bytes_tensor_element_count.restype = c_int
+_cserialize_bytes_tensor_element_count.argtypes = [
+    c_void_p, c_size_t, POINTER(c_size_t)
+]
+_cserialize_bytes_tensor_element_offsets = _cserialize.BytesTensorElementOffsets
+_cserialize_bytes_tensor_element_offsets.restype = c_int
+_cserialize_bytes_tensor_element_offsets.argtypes = [
+    c_void_p, c_size_t, c_void_p, c_void_p, c_size_t
+]
+
+
+def serialize_elements(elements):
+    """Serializes a list of bytes objects into the BYTES tensor encoding,
+    each element being its 4-byte length followed by its content.
+
+    Parameters
+    ----------
+    elements : list of bytes
+        The elements of the tensor in row-major order.
+
+    Returns
+    -------
+    bytes
+        The serialized tensor, or None if an element is too large.
+    """
+    count = len(elements)
+    byte_sizes = np.fromiter(map(len, elements), dtype=np.uint64, count=count)
+    dest = np.empty(4 * count + int(byte_sizes.sum()), dtype=np.uint8)
+    if _cserialize_bytes_tensor_serialize(
+        (c_char_p * count)(*elements), byte_sizes.ctypes.data, count,
+            dest.ctypes.data, dest.size) != 0:
+        return None
+    return dest.tobytes()
+
+
+def serialize_fixed_elements(input_tensor):
+    """Serializes a np.bytes_ tensor into the BYTES tensor encoding, without
+    the trailing zeros of each element.
+
+    Parameters
+    ----------
+    input_tensor : np.array
+        The np.bytes_ tensor to serialize.
+
+    Returns
+    -------
+    bytes
+        The serialized tensor, or None if an element is too large.
+    """
+    data = np.ascontiguousarray(input_tensor)
+    byte_size = c_uint64()
+    _cserialize_fixed_bytes_tensor_serialized_size(data.ctypes.data,
+                                                   data.itemsize, data.size,
+                                                   byref(byte_size))
+    dest = np.empty(byte_size.value, dtype=np.uint8)
+    if _cserialize_fixed_bytes_tensor_serialize(data.ctypes.data,
+                                                data.itemsize, data.size,
+                                                dest.ctypes.data,
+                                                dest.size) != 0:
+        return None
+    return dest.tobytes()
+
+
+def deserialize_elements(encoded_tensor):
+    """Deserializes a BYTES tensor into its elements, locating them in the
+    serialized tensor in place.
+
+    Parameters
+    ----------
+    encoded_tensor : bytes-like object
+        The serialized tensor.
+
+    Returns
+    -------
+    list of bytes
+        The elements of the tensor in row-major order, or None if the tensor
+        is malformed.
+    """
+    if len(encoded_tensor) == 0:
+        return []
+    # 'src' views the buffer of 'encoded_tensor' without copying it, and
+    # keeps it alive until the elements are copied out of it.
+    src = np.frombuffer(encoded_tensor, dtype=np.uint8)
+    count = c_size_t()
+    if _cserialize_bytes_tensor_element_count(src.ctypes.data, src.size,
+                                              byref(count)) != 0:
+        return None
+    offsets = np.empty(count.value, dtype=np.uint64)
+    byte_sizes = np.empty(count.value, dtype=np.uint64)
+    if _cserialize_bytes_tensor_element_offsets(
+            src.ctypes.data, src.size, offsets.ctypes.data,
+            byte_sizes.ctypes.data, count.value) != 0:
+        return None
+    located = zip(offsets.tolist(), byte_sizes.tolist())
+    if isinstance(encoded_tensor, bytes):
+        return [
+            encoded_tensor[offset:offset + byte_size]
+            for offset, byte_size in located
+        ]
+    view = memoryview(src)
+    return [
+        bytes(view[offset:offset + byte_size])
+        for offset, byte_size in located
+    ]
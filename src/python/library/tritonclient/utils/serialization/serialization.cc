@@ -0,0 +1,166 @@
+// Copyright 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+
+#include "serialization.h"
+
+#include <cstring>
+
+//==============================================================================
+// BYTES tensor serialization
+
+namespace {
+
+constexpr size_t kLengthSize = 4;
+
+void
+WriteLength(uint32_t length, char* dest)
+{
+  // The length is little endian whatever the host
+  for (size_t i = 0; i < kLengthSize; i++) {
+    dest[i] = static_cast<char>((length >> (8 * i)) & 0xff);
+  }
+}
+
+uint32_t
+ReadLength(const char* src)
+{
+  uint32_t length = 0;
+  for (size_t i = 0; i < kLengthSize; i++) {
+    length |= static_cast<uint32_t>(static_cast<unsigned char>(src[i]))
+              << (8 * i);
+  }
+  return length;
+}
+
+// The length of a fixed width element, without the trailing zeros that
+// numpy strips from np.bytes_ values
+size_t
+FixedElementSize(const char* element, size_t item_size)
+{
+  while ((item_size > 0) && (element[item_size - 1] == '\0')) {
+    item_size--;
+  }
+  return item_size;
+}
+
+}  // namespace
+
+int
+BytesTensorSerialize(
+    const char* const* elements, const uint64_t* byte_sizes, size_t count,
+    char* dest, size_t dest_byte_size)
+{
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    if ((byte_sizes[i] > UINT32_MAX) ||
+        (dest_byte_size - offset < kLengthSize + byte_sizes[i])) {
+      return -1;
+    }
+    WriteLength(static_cast<uint32_t>(byte_sizes[i]), dest + offset);
+    offset += kLengthSize;
+    memcpy(dest + offset, elements[i], byte_sizes[i]);
+    offset += byte_sizes[i];
+  }
+  return (offset == dest_byte_size) ? 0 : -1;
+}
+
+int
+FixedBytesTensorSerializedSize(
+    const char* data, size_t item_size, size_t count, uint64_t* byte_size)
+{
+  *byte_size = 0;
+  for (size_t i = 0; i < count; i++) {
+    *byte_size +=
+        kLengthSize + FixedElementSize(data + i * item_size, item_size);
+  }
+  return 0;
+}
+
+int
+FixedBytesTensorSerialize(
+    const char* data, size_t item_size, size_t count, char* dest,
+    size_t dest_byte_size)
+{
+  if (item_size > UINT32_MAX) {
+    return -1;
+  }
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    const char* element = data + i * item_size;
+    const size_t element_size = FixedElementSize(element, item_size);
+    if (dest_byte_size - offset < kLengthSize + element_size) {
+      return -1;
+    }
+    WriteLength(static_cast<uint32_t>(element_size), dest + offset);
+    offset += kLengthSize;
+    memcpy(dest + offset, element, element_size);
+    offset += element_size;
+  }
+  return (offset == dest_byte_size) ? 0 : -1;
+}
+
+int
+BytesTensorElementCount(const char* src, size_t byte_size, size_t* count)
+{
+  *count = 0;
+  size_t offset = 0;
+  while (offset < byte_size) {
+    if (byte_size - offset < kLengthSize) {
+      return -1;
+    }
+    const uint32_t length = ReadLength(src + offset);
+    offset += kLengthSize;
+    if (byte_size - offset < length) {
+      return -1;
+    }
+    offset += length;
+    (*count)++;
+  }
+  return 0;
+}
+
+int
+BytesTensorElementOffsets(
+    const char* src, size_t byte_size, uint64_t* offsets, uint64_t* byte_sizes,
+    size_t count)
+{
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (byte_size - offset < kLengthSize) {
+      return -1;
+    }
+    const uint32_t length = ReadLength(src + offset);
+    offset += kLengthSize;
+    if (byte_size - offset < length) {
+      return -1;
+    }
+    offsets[i] = offset;
+    byte_sizes[i] = length;
+    offset += length;
+  }
+  return (offset == byte_size) ? 0 : -1;
+}
+
+//==============================================================================
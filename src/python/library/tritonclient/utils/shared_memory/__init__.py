@@ -53,6 +53,11 @@ _cshm_shared_memory_region_create.restype = c_int
 _cshm_shared_memory_region_create.argtypes = [
     _utf8, _utf8, c_uint64, POINTER(c_void_p)
 ]
+_cshm_shared_memory_region_create_with_options = _cshm.SharedMemoryRegionCreateWithOptions
+_cshm_shared_memory_region_create_with_options.restype = c_int
+_cshm_shared_memory_region_create_with_options.argtypes = [
+    _utf8, _utf8, c_uint64, c_int, c_int, c_int, POINTER(c_void_p)
+]
 _cshm_shared_memory_region_set = _cshm.SharedMemoryRegionSet
 _cshm_shared_memory_region_set.restype = c_int
 _cshm_shared_memory_region_set.argtypes = [
@@ -91,7 +96,12 @@ def _raise_error(msg):
     raise ex
 
 
-def create_shared_memory_region(triton_shm_name, shm_key, byte_size):
+def create_shared_memory_region(triton_shm_name,
+                                shm_key,
+                                byte_size,
+                                huge_pages=False,
+                                prefault=False,
+                                numa_node=-1):
     """Creates a system shared memory region with the specified name and size.
 
     Parameters
@@ -102,6 +112,16 @@ def create_shared_memory_region(triton_shm_name, shm_key, byte_size):
         The unique key of the shared memory object.
     byte_size : int
         The size in bytes of the shared memory region to be created.
+    huge_pages : bool
+        Whether to back the region with transparent huge pages. Needs the
+        shmem_enabled setting of transparent huge pages to be "advise" or
+        "always". The default value is False.
+    prefault : bool
+        Whether to fault in all the pages of the region when it is created,
+        instead of on first access. The default value is False.
+    numa_node : int
+        The NUMA node to allocate the pages of the region from. The default
+        value is -1, which allocates from any node.
 
     Returns
     -------
@@ -115,10 +135,18 @@ def create_shared_memory_region(triton_shm_name, shm_key, byte_size):
     """
 
     shm_handle = c_void_p()
-    _raise_if_error(
-        c_int(
-            _cshm_shared_memory_region_create(triton_shm_name, shm_key,
-                                              byte_size, byref(shm_handle))))
+    if huge_pages or prefault or numa_node >= 0:
+        _raise_if_error(
+            c_int(
+                _cshm_shared_memory_region_create_with_options(
+                    triton_shm_name, shm_key, byte_size, int(huge_pages),
+                    int(prefault), numa_node, byref(shm_handle))))
+    else:
+        _raise_if_error(
+            c_int(
+                _cshm_shared_memory_region_create(triton_shm_name, shm_key,
+                                                  byte_size,
+                                                  byref(shm_handle))))
     mapped_shm_regions.append(shm_key)
 
     return shm_handle
@@ -235,6 +263,92 @@ def get_contents_as_numpy(shm_handle, datatype, shape, offset=0):
     return result
 
 
+def get_buffer(shm_handle, byte_size=None, offset=0):
+    """Returns a writable buffer over the memory of the system shared memory
+    region, without copying it. The buffer must not be used after the region
+    is destroyed.
+
+    Parameters
+    ----------
+    shm_handle : c_void_p
+        The handle for the system shared memory region.
+    byte_size : int
+        The size in bytes of the buffer. The default value is None, which
+        covers the region from the offset to its end.
+    offset : int
+        The offset, in bytes, of the buffer in the region. The default value
+        is 0.
+
+    Returns
+    -------
+    memoryview
+        The buffer over the region.
+
+    Raises
+    ------
+    SharedMemoryException
+        If the buffer does not fit in the region.
+    """
+    shm_fd = c_int()
+    region_offset = c_uint64()
+    region_byte_size = c_uint64()
+    shm_addr = c_char_p()
+    shm_key = c_char_p()
+    _raise_if_error(
+        c_int(
+            _cshm_get_shared_memory_handle_info(shm_handle, byref(shm_addr),
+                                                byref(shm_key), byref(shm_fd),
+                                                byref(region_offset),
+                                                byref(region_byte_size))))
+    start_pos = region_offset.value + offset
+    if byte_size is None:
+        byte_size = region_byte_size.value - start_pos
+    if (byte_size < 0) or (region_byte_size.value < start_pos + byte_size):
+        _raise_error(
+            "The size of the shared memory region is unsufficient to provide a buffer with requested size"
+        )
+    # The address of the mapping, not the bytes it points to
+    base_addr = cast(shm_addr, c_void_p).value
+    return memoryview((c_byte * byte_size).from_address(base_addr +
+                                                        start_pos)).cast("B")
+
+
+def as_numpy_array(shm_handle, datatype, shape, offset=0):
+    """Returns a numpy array stored in the system shared memory region,
+    without copying it. Writing to the array writes to the region, so inputs
+    can be built in place instead of being copied in with
+    set_shared_memory_region, and outputs can be read in place. The array
+    must not be used after the region is destroyed.
+
+    Parameters
+    ----------
+    shm_handle : c_void_p
+        The handle for the system shared memory region.
+    datatype : np.dtype
+        The datatype of the array. Must have a fixed size.
+    shape : list
+        The list of int describing the shape of the array.
+    offset : int
+        The offset, in bytes, of the array in the region. The default value
+        is 0.
+
+    Returns
+    -------
+    np.array
+        The array viewing the region.
+
+    Raises
+    ------
+    SharedMemoryException
+        If the array does not fit in the region.
+    """
+    if (datatype == np.object_) or (datatype == np.bytes_):
+        _raise_error("as_numpy_array only supports fixed-size datatypes")
+    byte_size = int(np.prod(shape)) * np.dtype(datatype).itemsize
+    buf = get_buffer(shm_handle, byte_size, offset)
+    return np.frombuffer(buf, dtype=datatype).reshape(shape)
+
+
 def mapped_shared_memory_regions():
     """Return all system shared memory regions that were mapped but not unmapped/destoryed.
 
@@ -292,7 +406,8 @@ class SharedMemoryException(Exception):
             -3: "unable to initialize the size",
             -4: "unable to read/mmap the shared memory region",
             -5: "unable to unlink the shared memory region",
-            -6: "unable to munmap the shared memory region"
+            -6: "unable to munmap the shared memory region",
+            -7: "unable to place the pages of the shared memory region"
         }
         self._msg = None
         if type(err) == str:
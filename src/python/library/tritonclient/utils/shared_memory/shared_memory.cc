@@ -29,9 +29,11 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include <cstring>
 #include <iostream>
+#include <vector>
 #include "shared_memory_handle.h"
 
 //==============================================================================
@@ -58,8 +60,10 @@ int
 SharedMemoryRegionMap(
     int shm_fd, size_t offset, size_t byte_size, void** shm_addr)
 {
-  // map shared memory to process address space
-  *shm_addr = mmap(NULL, byte_size, PROT_WRITE, MAP_SHARED, shm_fd, offset);
+  // map shared memory to process address space, readable as well for the
+  // arrays viewing the region in place
+  *shm_addr =
+      mmap(NULL, byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, offset);
   if (*shm_addr == MAP_FAILED) {
     return -1;
   }
@@ -68,6 +72,42 @@ SharedMemoryRegionMap(
   return close(shm_fd);
 }
 
+// From linux/mempolicy.h, which is not always installed
+constexpr int kMpolBind = 2;
+
+int
+SharedMemoryRegionPlace(
+    void* shm_addr, size_t byte_size, bool huge_pages, bool prefault,
+    int numa_node)
+{
+  // The placement of the pages must be set before they are faulted in
+  if (huge_pages && (madvise(shm_addr, byte_size, MADV_HUGEPAGE) != 0)) {
+    return -1;
+  }
+  if (numa_node >= 0) {
+    constexpr size_t kBitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(numa_node / kBitsPerWord + 1, 0);
+    node_mask[numa_node / kBitsPerWord] = 1UL << (numa_node % kBitsPerWord);
+    // The kernel drops the last bit of the mask size it is given
+    if (syscall(
+            SYS_mbind, shm_addr, byte_size, kMpolBind, node_mask.data(),
+            node_mask.size() * kBitsPerWord + 1, 0) != 0) {
+      return -1;
+    }
+  }
+  if (prefault) {
+    // Reading a page of a shared memory object allocates it, without
+    // changing the content other processes may have written.
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const volatile char* bytes =
+        reinterpret_cast<const volatile char*>(shm_addr);
+    for (size_t i = 0; i < byte_size; i += page_size) {
+      (void)bytes[i];
+    }
+  }
+  return 0;
+}
+
 }  // namespace
 
 int
@@ -101,6 +141,30 @@ SharedMemoryRegionCreate(
   return 0;
 }
 
+int
+SharedMemoryRegionCreateWithOptions(
+    const char* triton_shm_name, const char* shm_key, size_t byte_size,
+    int huge_pages, int prefault, int numa_node, void** shm_handle)
+{
+  int err = SharedMemoryRegionCreate(
+      triton_shm_name, shm_key, byte_size, shm_handle);
+  if (err != 0) {
+    return err;
+  }
+
+  SharedMemoryHandle* handle =
+      reinterpret_cast<SharedMemoryHandle*>(*shm_handle);
+  err = SharedMemoryRegionPlace(
+      handle->base_addr_, byte_size, huge_pages != 0, prefault != 0,
+      numa_node);
+  if (err == -1) {
+    SharedMemoryRegionDestroy(*shm_handle);
+    *shm_handle = nullptr;
+    return -7;
+  }
+  return 0;
+}
+
 int
 SharedMemoryRegionSet(
     void* shm_handle, size_t offset, size_t byte_size, const void* data)
@@ -39,6 +39,9 @@ extern "C" {
 int SharedMemoryRegionCreate(
     const char* triton_shm_name, const char* shm_key, size_t byte_size,
     void** shm_handle);
+int SharedMemoryRegionCreateWithOptions(
+    const char* triton_shm_name, const char* shm_key, size_t byte_size,
+    int huge_pages, int prefault, int numa_node, void** shm_handle);
 int SharedMemoryRegionSet(
     void* shm_handle, size_t offset, size_t byte_size, const void* data);
 int GetSharedMemoryHandleInfo(
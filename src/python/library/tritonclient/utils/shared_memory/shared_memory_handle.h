@@ -36,6 +36,11 @@ struct SharedMemoryHandle {
 #ifdef TRITON_ENABLE_GPU
   cudaIpcMemHandle_t cuda_shm_handle_;
   int device_id_;
+  // The stream of the copies to and from the region, and the pinned host
+  // buffer they are staged in
+  cudaStream_t stream_;
+  void* staging_addr_;
+  size_t staging_byte_size_;
 #endif  // TRITON_ENABLE_GPU
   void* base_addr_;
   int shm_fd_;